@@ -6,6 +6,19 @@ namespace NetworkFilters {
 namespace Kafka {
 namespace Broker {
 
+// Request headers carry everything the filter needs, unless the payloads are to be inspected.
+static const RequestParserResolver& requestParserResolver(const BrokerFilterConfig& config) {
+  return config.headerOnlyParsing() ? HeaderOnlyRequestParserResolver::getInstance()
+                                    : RequestParserResolver::getDefaultInstance();
+}
+
+// Rewritten responses are re-encoded, so they need to be fully parsed.
+static const ResponseParserResolver& responseParserResolver(const BrokerFilterConfig& config) {
+  return config.headerOnlyParsing() && !config.needsResponseRewrite()
+             ? HeaderOnlyResponseParserResolver::getInstance()
+             : ResponseParserResolver::getDefaultInstance();
+}
+
 void Forwarder::onMessage(AbstractRequestSharedPtr request) {
   const RequestHeader& header = request->request_header_;
   response_decoder_.expectResponse(header.correlation_id_, header.api_key_, header.api_version_);
@@ -78,8 +91,11 @@ KafkaBrokerFilter::KafkaBrokerFilter(const BrokerFilterConfigSharedPtr& filter_c
                                      const KafkaMetricsFacadeSharedPtr& metrics)
     : metrics_{metrics}, request_handler_{new RequestHandlerImpl(filter_config)},
       response_rewriter_{createRewriter(filter_config)},
-      response_decoder_{new ResponseDecoder({metrics, response_rewriter_})},
+      response_decoder_{new ResponseDecoder(ResponseInitialParserFactory::getDefaultInstance(),
+                                            responseParserResolver(*filter_config),
+                                            {metrics, response_rewriter_})},
       request_decoder_{new RequestDecoder(
+          InitialParserFactory::getDefaultInstance(), requestParserResolver(*filter_config),
           {std::make_shared<Forwarder>(*response_decoder_), metrics, request_handler_})} {};
 
 KafkaBrokerFilter::KafkaBrokerFilter(KafkaMetricsFacadeSharedPtr metrics,
@@ -29,16 +29,19 @@ BrokerFilterConfig::BrokerFilterConfig(const KafkaBrokerProtoConfig& proto_confi
     : BrokerFilterConfig{proto_config.stat_prefix(), proto_config.force_response_rewrite(),
                          extractRewriteRules(proto_config),
                          extractApiKeySet(proto_config.api_keys_allowed()),
-                         extractApiKeySet(proto_config.api_keys_denied())} {}
+                         extractApiKeySet(proto_config.api_keys_denied()),
+                         proto_config.header_only_parsing()} {}
 
 BrokerFilterConfig::BrokerFilterConfig(const std::string& stat_prefix,
                                        const bool force_response_rewrite,
                                        const std::vector<RewriteRule>& broker_address_rewrite_rules,
                                        const absl::flat_hash_set<int16_t>& api_keys_allowed,
-                                       const absl::flat_hash_set<int16_t>& api_keys_denied)
+                                       const absl::flat_hash_set<int16_t>& api_keys_denied,
+                                       const bool header_only_parsing)
     : stat_prefix_{stat_prefix}, force_response_rewrite_{force_response_rewrite},
       broker_address_rewrite_rules_{broker_address_rewrite_rules},
-      api_keys_allowed_{api_keys_allowed}, api_keys_denied_{api_keys_denied} {
+      api_keys_allowed_{api_keys_allowed}, api_keys_denied_{api_keys_denied},
+      header_only_parsing_{header_only_parsing} {
 
   ASSERT(!stat_prefix_.empty());
 };
@@ -66,6 +69,8 @@ absl::flat_hash_set<int16_t> BrokerFilterConfig::apiKeysAllowed() const {
 
 absl::flat_hash_set<int16_t> BrokerFilterConfig::apiKeysDenied() const { return api_keys_denied_; }
 
+bool BrokerFilterConfig::headerOnlyParsing() const { return header_only_parsing_; }
+
 } // namespace Broker
 } // namespace Kafka
 } // namespace NetworkFilters
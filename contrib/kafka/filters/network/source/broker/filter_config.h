@@ -42,7 +42,8 @@ public:
   BrokerFilterConfig(const std::string& stat_prefix, const bool force_response_rewrite,
                      const std::vector<RewriteRule>& broker_address_rewrite_rules,
                      const absl::flat_hash_set<int16_t>& api_keys_allowed,
-                     const absl::flat_hash_set<int16_t>& api_keys_denied);
+                     const absl::flat_hash_set<int16_t>& api_keys_denied,
+                     const bool header_only_parsing);
 
   /**
    * Returns the prefix for stats.
@@ -69,12 +70,18 @@ public:
    */
   virtual absl::flat_hash_set<int16_t> apiKeysDenied() const;
 
+  /**
+   * Whether only the headers of requests and responses should be parsed.
+   */
+  virtual bool headerOnlyParsing() const;
+
 private:
   std::string stat_prefix_;
   bool force_response_rewrite_;
   std::vector<RewriteRule> broker_address_rewrite_rules_;
   absl::flat_hash_set<int16_t> api_keys_allowed_;
   absl::flat_hash_set<int16_t> api_keys_denied_;
+  bool header_only_parsing_;
 };
 
 using BrokerFilterConfigSharedPtr = std::shared_ptr<BrokerFilterConfig>;
@@ -20,6 +20,15 @@ namespace Kafka {
  */
 bool requestUsesTaggedFieldsInHeader(const uint16_t api_key, const uint16_t api_version);
 
+/**
+ * Decides if requests with given api key & version can be parsed.
+ * This method gets implemented in generated code through 'kafka_request_resolver_cc.j2'.
+ * @param api_key Kafka request key.
+ * @param api_version Kafka request's version.
+ * @return Whether there is a parser for this request.
+ */
+bool requestSupported(const uint16_t api_key, const uint16_t api_version);
+
 /**
  * Represents fields that are present in every Kafka request message.
  * @see http://kafka.apache.org/protocol.html#protocol_messages
@@ -172,6 +181,36 @@ public:
   const Data data_;
 };
 
+/**
+ * Request that only carries its header, as its payload has been skipped without being parsed.
+ * Allows processing the requests that only need the header (e.g. for metrics) without deserializing
+ * large payloads, such as the record batches of Produce requests.
+ * As the payload is not kept, the request can not be encoded.
+ */
+class HeaderOnlyRequest : public AbstractRequest {
+public:
+  /**
+   * @param request_header request's header.
+   * @param payload_size size of the skipped payload.
+   */
+  HeaderOnlyRequest(const RequestHeader& request_header, const uint32_t payload_size)
+      : AbstractRequest{request_header}, payload_size_{payload_size} {};
+
+  uint32_t computeSize() const override {
+    const EncodingContext context{request_header_.api_version_};
+    return context.computeSize(request_header_) + payload_size_;
+  }
+
+  uint32_t encode(Buffer::Instance&) const override {
+    throw EnvoyException("header-only request can not be encoded");
+  }
+
+  /**
+   * Size of the skipped payload.
+   */
+  const uint32_t payload_size_;
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -9,6 +9,20 @@ const RequestParserResolver& RequestParserResolver::getDefaultInstance() {
   CONSTRUCT_ON_FIRST_USE(RequestParserResolver);
 }
 
+const RequestParserResolver& HeaderOnlyRequestParserResolver::getInstance() {
+  CONSTRUCT_ON_FIRST_USE(HeaderOnlyRequestParserResolver);
+}
+
+RequestParserSharedPtr
+HeaderOnlyRequestParserResolver::createParser(int16_t api_key, int16_t api_version,
+                                              RequestContextSharedPtr context) const {
+  if (requestSupported(api_key, api_version)) {
+    return std::make_shared<HeaderOnlyRequestParser>(context);
+  } else {
+    return std::make_shared<SentinelParser>(context);
+  }
+}
+
 RequestParseResponse RequestStartParser::parse(absl::string_view& data) {
   request_length_.feed(data);
   if (request_length_.ready()) {
@@ -67,6 +81,19 @@ RequestParseResponse RequestHeaderParser::parse(absl::string_view& data) {
   }
 }
 
+RequestParseResponse HeaderOnlyRequestParser::parse(absl::string_view& data) {
+  const uint32_t min = std::min<uint32_t>(context_->remaining_request_size_, data.size());
+  data = {data.data() + min, data.size() - min};
+  context_->remaining_request_size_ -= min;
+  if (0 == context_->remaining_request_size_) {
+    AbstractRequestSharedPtr msg =
+        std::make_shared<HeaderOnlyRequest>(context_->request_header_, payload_size_);
+    return RequestParseResponse::parsedMessage(msg);
+  } else {
+    return RequestParseResponse::stillWaiting();
+  }
+}
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
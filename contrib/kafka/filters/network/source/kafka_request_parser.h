@@ -72,6 +72,22 @@ public:
   static const RequestParserResolver& getDefaultInstance();
 };
 
+/**
+ * Resolver that does not parse the request payloads, only skipping them.
+ * Supported requests are returned as HeaderOnlyRequest instances, unsupported ones as parse
+ * failures (as with the default resolver). Malformed payloads are not detected.
+ */
+class HeaderOnlyRequestParserResolver : public RequestParserResolver {
+public:
+  RequestParserSharedPtr createParser(int16_t api_key, int16_t api_version,
+                                      RequestContextSharedPtr context) const override;
+
+  /**
+   * Return the resolver instance.
+   */
+  static const RequestParserResolver& getInstance();
+};
+
 /**
  * Request parser responsible for consuming request length and setting up context with this data.
  * @see http://kafka.apache.org/protocol.html#protocol_common
@@ -176,6 +192,23 @@ public:
   }
 };
 
+/**
+ * Parser that skips the request payload without copying it, and then returns a HeaderOnlyRequest.
+ */
+class HeaderOnlyRequestParser : public RequestParser {
+public:
+  HeaderOnlyRequestParser(RequestContextSharedPtr context)
+      : context_{context}, payload_size_{context->remaining_request_size_} {};
+
+  RequestParseResponse parse(absl::string_view& data) override;
+
+  const RequestContextSharedPtr contextForTest() const { return context_; }
+
+private:
+  const RequestContextSharedPtr context_;
+  const uint32_t payload_size_;
+};
+
 /**
  * Request parser uses a single deserializer to construct a request object.
  * This parser is responsible for consuming request-specific data (e.g. topic names) and always
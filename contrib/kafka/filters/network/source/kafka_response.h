@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/common/exception.h"
+
 #include "contrib/kafka/filters/network/source/external/serialization_composite.h"
 #include "contrib/kafka/filters/network/source/serialization.h"
 #include "contrib/kafka/filters/network/source/tagged_fields.h"
@@ -22,6 +24,15 @@ namespace Kafka {
  */
 bool responseUsesTaggedFieldsInHeader(const uint16_t api_key, const uint16_t api_version);
 
+/**
+ * Decides if responses with given api key & version can be parsed.
+ * This method gets implemented in generated code through 'kafka_response_resolver_cc.j2'.
+ * @param api_key Kafka request key.
+ * @param api_version Kafka request's version.
+ * @return Whether there is a parser for this response.
+ */
+bool responseSupported(const uint16_t api_key, const uint16_t api_version);
+
 /**
  * Represents Kafka response metadata: expected api key, version and correlation id.
  * @see http://kafka.apache.org/protocol.html#protocol_messages
@@ -149,6 +160,34 @@ public:
   Data data_;
 };
 
+/**
+ * Response that only carries its metadata, as its payload has been skipped without being parsed.
+ * As the payload is not kept, the response can not be encoded.
+ */
+class HeaderOnlyResponse : public AbstractResponse {
+public:
+  /**
+   * @param metadata response metadata.
+   * @param payload_size size of the skipped payload.
+   */
+  HeaderOnlyResponse(const ResponseMetadata& metadata, const uint32_t payload_size)
+      : AbstractResponse{metadata}, payload_size_{payload_size} {};
+
+  uint32_t computeSize() const override {
+    const EncodingContext context{metadata_.api_version_};
+    return context.computeSize(metadata_) + payload_size_;
+  }
+
+  uint32_t encode(Buffer::Instance&) const override {
+    throw EnvoyException("header-only response can not be encoded");
+  }
+
+  /**
+   * Size of the skipped payload.
+   */
+  const uint32_t payload_size_;
+};
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
@@ -11,6 +11,19 @@ const ResponseParserResolver& ResponseParserResolver::getDefaultInstance() {
   CONSTRUCT_ON_FIRST_USE(ResponseParserResolver);
 }
 
+const ResponseParserResolver& HeaderOnlyResponseParserResolver::getInstance() {
+  CONSTRUCT_ON_FIRST_USE(HeaderOnlyResponseParserResolver);
+}
+
+ResponseParserSharedPtr
+HeaderOnlyResponseParserResolver::createParser(ResponseContextSharedPtr context) const {
+  if (responseSupported(context->api_key_, context->api_version_)) {
+    return std::make_shared<HeaderOnlyResponseParser>(context);
+  } else {
+    return std::make_shared<SentinelResponseParser>(context);
+  }
+}
+
 ResponseParseResponse ResponseHeaderParser::parse(absl::string_view& data) {
   length_deserializer_.feed(data);
   if (!length_deserializer_.ready()) {
@@ -66,6 +79,21 @@ ExpectedResponseSpec ResponseHeaderParser::getResponseSpec(const int32_t correla
   }
 };
 
+ResponseParseResponse HeaderOnlyResponseParser::parse(absl::string_view& data) {
+  const uint32_t min = std::min<uint32_t>(context_->remaining_response_size_, data.size());
+  data = {data.data() + min, data.size() - min};
+  context_->remaining_response_size_ -= min;
+  if (0 == context_->remaining_response_size_) {
+    const ResponseMetadata metadata = {context_->api_key_, context_->api_version_,
+                                       context_->correlation_id_, context_->tagged_fields_};
+    const AbstractResponseSharedPtr response =
+        std::make_shared<HeaderOnlyResponse>(metadata, payload_size_);
+    return ResponseParseResponse::parsedMessage(response);
+  } else {
+    return ResponseParseResponse::stillWaiting();
+  }
+}
+
 } // namespace Kafka
 } // namespace NetworkFilters
 } // namespace Extensions
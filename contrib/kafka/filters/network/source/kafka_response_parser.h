@@ -94,6 +94,21 @@ public:
   static const ResponseParserResolver& getDefaultInstance();
 };
 
+/**
+ * Resolver that does not parse the response payloads, only skipping them.
+ * Supported responses are returned as HeaderOnlyResponse instances, unsupported ones as parse
+ * failures (as with the default resolver). Malformed payloads are not detected.
+ */
+class HeaderOnlyResponseParserResolver : public ResponseParserResolver {
+public:
+  ResponseParserSharedPtr createParser(ResponseContextSharedPtr context) const override;
+
+  /**
+   * Return the resolver instance.
+   */
+  static const ResponseParserResolver& getInstance();
+};
+
 /**
  * Response parser responsible for consuming response header (payload length and correlation id) and
  * setting up context with this data.
@@ -151,6 +166,24 @@ public:
   }
 };
 
+/**
+ * Parser that skips the response payload without copying it, and then returns a
+ * HeaderOnlyResponse.
+ */
+class HeaderOnlyResponseParser : public ResponseParser {
+public:
+  HeaderOnlyResponseParser(ResponseContextSharedPtr context)
+      : context_{context}, payload_size_{context->remaining_response_size_} {};
+
+  ResponseParseResponse parse(absl::string_view& data) override;
+
+  const ResponseContextSharedPtr contextForTest() const { return context_; }
+
+private:
+  const ResponseContextSharedPtr context_;
+  const uint32_t payload_size_;
+};
+
 /**
  * Response parser uses a single deserializer to construct a response object.
  * This parser is responsible for consuming response-specific data (e.g. topic names) and always
@@ -32,13 +32,19 @@ class KafkaBrokerFilterProtocolTest : public testing::Test,
                                       protected RequestB,
                                       protected ResponseB {
 protected:
+  KafkaBrokerFilterProtocolTest() : KafkaBrokerFilterProtocolTest{false} {};
+
+  KafkaBrokerFilterProtocolTest(const bool header_only_parsing)
+      : testee_{scope_, time_source_,
+                std::make_shared<BrokerFilterConfig>(
+                    std::string("prefix"), false, std::vector<RewriteRule>{},
+                    absl::flat_hash_set<int16_t>{}, absl::flat_hash_set<int16_t>{},
+                    header_only_parsing)} {};
+
   Stats::TestUtil::TestStore store_;
   Stats::Scope& scope_{*store_.rootScope()};
   Event::TestRealTimeSystem time_source_;
-  KafkaBrokerFilter testee_{scope_, time_source_,
-                            std::make_shared<BrokerFilterConfig>(
-                                std::string("prefix"), false, std::vector<RewriteRule>{},
-                                absl::flat_hash_set<int16_t>{}, absl::flat_hash_set<int16_t>{})};
+  KafkaBrokerFilter testee_;
 
   Network::FilterStatus consumeRequestFromBuffer() {
     return testee_.onData(RequestB::buffer_, false);
@@ -128,7 +134,42 @@ TEST_F(KafkaBrokerFilterProtocolTest, ShouldAbortOnUnregisteredResponse) {
   ASSERT_EQ(result, Network::FilterStatus::StopIteration);
 }
 
-TEST_F(KafkaBrokerFilterProtocolTest, ShouldProcessMessages) {
+// Parses only the headers of the messages.
+class KafkaBrokerFilterHeaderOnlyProtocolTest : public KafkaBrokerFilterProtocolTest {
+protected:
+  KafkaBrokerFilterHeaderOnlyProtocolTest() : KafkaBrokerFilterProtocolTest{true} {};
+};
+
+TEST_F(KafkaBrokerFilterHeaderOnlyProtocolTest, ShouldSkipResponsePayload) {
+  // given
+
+  const int32_t correlation_id = 42;
+  // The payload of this Produce response v0 is broken, but it is not parsed.
+  ResponseB::putIntoBuffer(static_cast<int32_t>(sizeof(int32_t) + sizeof(int32_t)));
+  ResponseB::putIntoBuffer(correlation_id); // Correlation-id.
+  ResponseB::putIntoBuffer(static_cast<int32_t>(std::numeric_limits<int32_t>::min())); // Array.
+
+  testee_.getResponseDecoderForTest()->expectResponse(correlation_id, 0, 0);
+
+  // when
+  const Network::FilterStatus result = consumeResponseFromBuffer();
+
+  // then
+  ASSERT_EQ(result, Network::FilterStatus::Continue);
+  ASSERT_EQ(testee_.getResponseDecoderForTest()->getCurrentParserForTest(), nullptr);
+  ASSERT_EQ(store_.counter(MessageUtilities::responseMetric(0)).value(), 1);
+}
+
+class KafkaBrokerFilterProtocolParsingTest : public KafkaBrokerFilterProtocolTest,
+                                             public testing::WithParamInterface<bool> {
+protected:
+  KafkaBrokerFilterProtocolParsingTest() : KafkaBrokerFilterProtocolTest{GetParam()} {};
+};
+
+INSTANTIATE_TEST_SUITE_P(HeaderOnlyParsing, KafkaBrokerFilterProtocolParsingTest,
+                         testing::Bool());
+
+TEST_P(KafkaBrokerFilterProtocolParsingTest, ShouldProcessMessages) {
   // given
   // For every request/response type & version, put a corresponding request into the buffer.
   for (const AbstractRequestSharedPtr& message : MessageUtilities::makeAllRequests()) {
@@ -16,7 +16,8 @@ public:
   MOCK_METHOD((absl::optional<HostAndPort>), findBrokerAddressOverride, (const uint32_t), (const));
   MOCK_METHOD((absl::flat_hash_set<int16_t>), apiKeysAllowed, (), (const));
   MOCK_METHOD((absl::flat_hash_set<int16_t>), apiKeysDenied, (), (const));
-  MockBrokerFilterConfig() : BrokerFilterConfig{"prefix", false, {}, {}, {}} {};
+  MOCK_METHOD(bool, headerOnlyParsing, (), (const));
+  MockBrokerFilterConfig() : BrokerFilterConfig{"prefix", false, {}, {}, {}, false} {};
 };
 
 using MockBrokerFilterConfigSharedPtr = std::shared_ptr<MockBrokerFilterConfig>;
@@ -190,6 +190,51 @@ TEST_F(KafkaRequestParserTest, SentinelParserShouldConsumeDataUntilEndOfRequest)
   assertStringViewIncrement(data, orig_data, request_len);
 }
 
+TEST_F(KafkaRequestParserTest, HeaderOnlyParserShouldSkipPayloadAndReturnHeader) {
+  // given
+  const int32_t request_len = 1000;
+  RequestContextSharedPtr context{new RequestContext()};
+  context->remaining_request_size_ = request_len;
+  context->request_header_ = {0, 0, 42, "client-id"};
+  HeaderOnlyRequestParser testee{context};
+
+  const absl::string_view orig_data = putGarbageIntoBuffer(request_len * 2);
+  absl::string_view data = {orig_data.data(), request_len / 2};
+
+  // when - payload is split across two calls.
+  const RequestParseResponse result1 = testee.parse(data);
+  data = {orig_data.data() + request_len / 2, request_len * 2 - request_len / 2};
+  const RequestParseResponse result2 = testee.parse(data);
+
+  // then
+  ASSERT_EQ(result1.hasData(), false);
+  ASSERT_EQ(result2.hasData(), true);
+  ASSERT_EQ(result2.next_parser_, nullptr);
+  ASSERT_EQ(result2.failure_data_, nullptr);
+  const auto request = std::dynamic_pointer_cast<HeaderOnlyRequest>(result2.message_);
+  ASSERT_NE(request, nullptr);
+  ASSERT_EQ(request->request_header_, context->request_header_);
+  ASSERT_EQ(request->payload_size_, request_len);
+
+  ASSERT_EQ(testee.contextForTest()->remaining_request_size_, 0);
+  assertStringViewIncrement(data, orig_data, request_len);
+}
+
+TEST_F(KafkaRequestParserTest, HeaderOnlyResolverShouldReturnSentinelForUnknownRequests) {
+  // given
+  const RequestParserResolver& testee = HeaderOnlyRequestParserResolver::getInstance();
+  RequestContextSharedPtr context{new RequestContext()};
+
+  // when
+  const RequestParserSharedPtr known = testee.createParser(0, 0, context);
+  const RequestParserSharedPtr unknown =
+      testee.createParser(std::numeric_limits<int16_t>::max(), 0, context);
+
+  // then
+  ASSERT_NE(std::dynamic_pointer_cast<HeaderOnlyRequestParser>(known), nullptr);
+  ASSERT_NE(std::dynamic_pointer_cast<SentinelParser>(unknown), nullptr);
+}
+
 } // namespace KafkaRequestParserTest
 } // namespace Kafka
 } // namespace NetworkFilters
@@ -188,6 +188,54 @@ TEST_F(KafkaResponseParserTest, SentinelResponseParserShouldConsumeDataUntilEndO
   assertStringViewIncrement(data, orig_data, response_len);
 }
 
+TEST_F(KafkaResponseParserTest, HeaderOnlyResponseParserShouldSkipPayloadAndReturnMetadata) {
+  // given
+  const int32_t response_len = 1000;
+  ResponseContextSharedPtr context = std::make_shared<ResponseContext>();
+  context->remaining_response_size_ = response_len;
+  context->api_key_ = 0;
+  context->api_version_ = 0;
+  context->correlation_id_ = 42;
+  HeaderOnlyResponseParser testee{context};
+
+  const absl::string_view orig_data = putGarbageIntoBuffer(response_len * 2);
+  absl::string_view data = orig_data;
+
+  // when
+  const ResponseParseResponse result = testee.parse(data);
+
+  // then
+  ASSERT_EQ(result.hasData(), true);
+  ASSERT_EQ(result.next_parser_, nullptr);
+  ASSERT_EQ(result.failure_data_, nullptr);
+  const auto response = std::dynamic_pointer_cast<HeaderOnlyResponse>(result.message_);
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->metadata_, context->asFailureData());
+  ASSERT_EQ(response->payload_size_, response_len);
+
+  ASSERT_EQ(testee.contextForTest()->remaining_response_size_, 0);
+  assertStringViewIncrement(data, orig_data, response_len);
+}
+
+TEST_F(KafkaResponseParserTest, HeaderOnlyResolverShouldReturnSentinelForUnknownResponses) {
+  // given
+  const ResponseParserResolver& testee = HeaderOnlyResponseParserResolver::getInstance();
+  ResponseContextSharedPtr known_context = std::make_shared<ResponseContext>();
+  known_context->api_key_ = 0;
+  known_context->api_version_ = 0;
+  ResponseContextSharedPtr unknown_context = std::make_shared<ResponseContext>();
+  unknown_context->api_key_ = std::numeric_limits<int16_t>::max();
+  unknown_context->api_version_ = 0;
+
+  // when
+  const ResponseParserSharedPtr known = testee.createParser(known_context);
+  const ResponseParserSharedPtr unknown = testee.createParser(unknown_context);
+
+  // then
+  ASSERT_NE(std::dynamic_pointer_cast<HeaderOnlyResponseParser>(known), nullptr);
+  ASSERT_NE(std::dynamic_pointer_cast<SentinelResponseParser>(unknown), nullptr);
+}
+
 } // namespace KafkaResponseParserTest
 } // namespace Kafka
 } // namespace NetworkFilters
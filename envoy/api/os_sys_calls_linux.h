@@ -25,6 +25,18 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see sched_setaffinity (man 2 sched_setaffinity)
+   */
+  virtual SysCallIntResult sched_setaffinity(pid_t pid, size_t cpusetsize,
+                                             const cpu_set_t* mask) PURE;
+
+  /**
+   * @see set_mempolicy (man 2 set_mempolicy)
+   */
+  virtual SysCallIntResult set_mempolicy(int mode, const unsigned long* nodemask,
+                                         unsigned long maxnode) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
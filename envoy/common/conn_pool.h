@@ -1,6 +1,9 @@
 #pragma once
 
+#include <vector>
+
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/event/deferred_deletable.h"
 #include "envoy/upstream/upstream.h"
 
@@ -94,6 +97,21 @@ public:
    * @return true if a connection was preconnected, false otherwise.
    */
   virtual bool maybePreconnect(float preconnect_ratio) PURE;
+
+  /**
+   * Appends the time at which each idle connection of the pool was last used, so that the least
+   * recently used idle connections can be picked across pools.
+   * @param last_used receives one entry per connected connection with no active streams.
+   */
+  virtual void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const PURE;
+
+  /**
+   * Closes idle connections of the pool, least recently used first.
+   * @param last_used_cutoff only connections last used no later than this time are closed.
+   * @param limit the maximum number of connections to close.
+   * @return the number of connections closed.
+   */
+  virtual uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) PURE;
 };
 
 enum class PoolFailureReason {
@@ -2,10 +2,13 @@
 
 #include <functional>
 
+#include "envoy/buffer/buffer.h"
 #include "envoy/common/pure.h"
 #include "envoy/network/address.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -42,9 +45,41 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Returns whether the request completes again after the completion being handled, which is
+   * only the case for multishot requests that have not terminated.
+   */
+  bool hasMoreCompletions() const { return more_completions_; }
+
+  /**
+   * Returns the id of the provided buffer holding the data of the completion being handled, if
+   * any. @see IoUring::takeProvidedBuffer().
+   */
+  absl::optional<uint16_t> providedBuffer() const { return provided_buffer_; }
+
+  /**
+   * Returns whether the completion being handled is the notification that the kernel no longer
+   * references the data of a zero copy send, which follows its result completion.
+   */
+  bool isNotification() const { return notification_; }
+
+  /**
+   * Records the details of the completion being handled. Set by the IoUring before handing the
+   * completion to the callback.
+   */
+  void setCompletionDetails(bool more_completions, absl::optional<uint16_t> provided_buffer,
+                            bool notification = false) {
+    more_completions_ = more_completions;
+    provided_buffer_ = provided_buffer;
+    notification_ = notification;
+  }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  bool more_completions_{false};
+  absl::optional<uint16_t> provided_buffer_;
+  bool notification_{false};
 };
 
 /**
@@ -110,6 +145,40 @@ public:
                                        const Network::Address::InstanceConstSharedPtr& address,
                                        Request* user_data) PURE;
 
+  /**
+   * Registers a ring of buffers the kernel picks from to complete the requests prepared with
+   * prepareRecvMultishot().
+   * @param count the number of buffers, a power of two of at most 32768.
+   * @param size the size of each buffer.
+   * Returns false if the kernel does not support provided buffer rings.
+   */
+  virtual bool setupProvidedBuffers(uint32_t count, uint32_t size) PURE;
+
+  /**
+   * Prepares a multishot recv system call and puts it into the submission queue. The request
+   * completes every time data is received, into a buffer picked from the ring set up with
+   * setupProvidedBuffers(), until it fails, the peer closes the connection or it is canceled. It
+   * completes with -ENOBUFS if the ring runs out of buffers.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) PURE;
+
+  /**
+   * Hands over a provided buffer filled by a completion.
+   * @param buffer_id the buffer, from Request::providedBuffer().
+   * @param length the number of bytes received into the buffer.
+   * @return a fragment which gives the buffer back to the kernel when released. The fragment may
+   *         be released on any thread, and after the destruction of this object.
+   */
+  virtual Buffer::BufferFragment* takeProvidedBuffer(uint16_t buffer_id, uint32_t length) PURE;
+
+  /**
+   * Gives a provided buffer filled by a completion back to the kernel without using its data.
+   * @param buffer_id the buffer, from Request::providedBuffer().
+   */
+  virtual void returnProvidedBuffer(uint16_t buffer_id) PURE;
+
   /**
    * Prepares a readv system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -126,6 +195,22 @@ public:
   virtual IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                       off_t offset, Request* user_data) PURE;
 
+  /**
+   * Returns whether the kernel supports zero copy sendmsg operations.
+   */
+  virtual bool isZeroCopySendSupported() PURE;
+
+  /**
+   * Prepares a zero copy sendmsg system call and puts it into the submission queue. The request
+   * completes with the result of the send, and if that completion has more completions, once more
+   * with a notification when the kernel no longer references the sent data, which must stay
+   * untouched until then.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                               Request* user_data) PURE;
+
   /**
    * Prepares a close system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
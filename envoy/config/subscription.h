@@ -65,6 +65,13 @@ public:
    * @return optional ref<envoy::config::core::v3::Metadata> of a resource.
    */
   virtual const OptRef<const envoy::config::core::v3::Metadata> metadata() const PURE;
+
+  /**
+   * @return the hash of the resource as serialized on the wire, if it is known. Resources of the
+   *         same name with the same hash are unchanged, so their consumers may skip applying them
+   *         again.
+   */
+  virtual absl::optional<uint64_t> contentHash() const { return absl::nullopt; }
 };
 
 using DecodedResourcePtr = std::unique_ptr<DecodedResource>;
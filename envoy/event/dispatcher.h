@@ -51,6 +51,21 @@ struct DispatcherStats {
 
 using DispatcherStatsPtr = std::unique_ptr<DispatcherStats>;
 
+/**
+ * All dispatcher busy poll stats. @see stats_macros.h
+ */
+#define ALL_BUSY_POLL_STATS(COUNTER)                                                               \
+  COUNTER(busy_poll_sleeps)                                                                        \
+  COUNTER(busy_poll_spin_us)                                                                       \
+  COUNTER(busy_poll_wakeups_avoided)
+
+/**
+ * Struct definition for all dispatcher busy poll stats. @see stats_macros.h
+ */
+struct BusyPollStats {
+  ALL_BUSY_POLL_STATS(GENERATE_COUNTER_STRUCT)
+};
+
 /**
  * Callback invoked when a dispatcher post() runs.
  */
@@ -187,6 +202,20 @@ public:
   virtual void initializeStats(Stats::Scope& scope,
                                const absl::optional<std::string>& prefix = absl::nullopt) PURE;
 
+  /**
+   * Enables adaptive busy polling. When run until exit, the event loop polls for events without
+   * blocking for up to max_spin_duration after it last processed events before blocking, trading
+   * CPU for the latency of waking up the thread. The spin duration is halved after each blocking
+   * wait longer than max_spin_duration, and reset when a wait was short enough for a spin to
+   * avoid it. Must be called before the event loop runs.
+   * @param max_spin_duration the maximum time to poll for events before blocking.
+   * @param scope the scope to contain the busy poll stats of the dispatcher.
+   * @param prefix the stats prefix to identify this dispatcher. If empty, the dispatcher will be
+   *               identified by its name.
+   */
+  virtual void enableBusyPoll(std::chrono::microseconds max_spin_duration, Stats::Scope& scope,
+                              const absl::optional<std::string>& prefix = absl::nullopt) PURE;
+
   /**
    * Clears any items in the deferred deletion queue.
    */
@@ -5,11 +5,19 @@
 
 #include "source/common/tracing/null_span_impl.h"
 
+#include "absl/container/inlined_vector.h"
+
 namespace Envoy {
 namespace Formatter {
 
 using AccessLogType = envoy::data::accesslog::v3::AccessLogType;
 
+/**
+ * The lines formatted by the access loggers for an event, with the keys of their formats, so
+ * that the loggers using the same format for the event format its line once.
+ */
+using FormattedLines = absl::InlinedVector<std::pair<uint64_t, std::string>, 2>;
+
 /**
  * Substitution formatter context for access logs or formatters.
  */
@@ -153,6 +161,22 @@ public:
     return makeOptRefFromPtr(typed_extension);
   }
 
+  /**
+   * Set the lines shared by the access loggers logging an event. The lines must only be used for
+   * a single event and must outlive its logging.
+   * @param formatted_lines supplies the lines formatted for the event.
+   */
+  Context& setFormattedLines(FormattedLines& formatted_lines) {
+    formatted_lines_ = formatted_lines;
+    return *this;
+  }
+
+  /**
+   * @return OptRef<FormattedLines> the lines formatted for the logged event, if the access
+   * loggers share them.
+   */
+  OptRef<FormattedLines> formattedLines() const { return formatted_lines_; }
+
 private:
   absl::string_view local_reply_body_;
   OptRef<const Http::RequestHeaderMap> request_headers_;
@@ -160,6 +184,7 @@ private:
   OptRef<const Http::ResponseTrailerMap> response_trailers_;
   OptRef<const Extension> extension_;
   OptRef<const Tracing::Span> active_span_;
+  OptRef<FormattedLines> formatted_lines_;
   AccessLogType log_type_{AccessLogType::NotSet};
 };
 
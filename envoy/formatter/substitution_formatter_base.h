@@ -34,6 +34,33 @@ public:
 using FormatterPtr = std::unique_ptr<Formatter>;
 using FormatterConstSharedPtr = std::shared_ptr<const Formatter>;
 
+/**
+ * Output that formatter providers append their values to with typed operations, so that values
+ * are written into the formatted line without intermediate strings.
+ */
+class FormatterOutput {
+public:
+  virtual ~FormatterOutput() = default;
+
+  /**
+   * Append a string value.
+   * @param value supplies the value.
+   */
+  virtual void addString(absl::string_view value) PURE;
+
+  /**
+   * Append an integer value, such as a status code or a duration count.
+   * @param value supplies the value.
+   */
+  virtual void addInteger(int64_t value) PURE;
+
+  /**
+   * Append an unsigned integer value, such as a byte count.
+   * @param value supplies the value.
+   */
+  virtual void addUnsignedInteger(uint64_t value) PURE;
+};
+
 /**
  * Interface for multiple protocols/modules formatter providers.
  */
@@ -60,6 +87,33 @@ public:
    */
   virtual Protobuf::Value formatValue(const Context& context,
                                       const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value that format() would return to the given output. Providers override this to
+   * write their value without building a string for it first; integers must be appended with the
+   * integer operations of the output, in which case they are rendered as by fmt::format_int().
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the output to append the value to.
+   * @return bool whether there was a value. Nothing is appended if there was none.
+   */
+  virtual bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        FormatterOutput& output) const {
+    const absl::optional<std::string> value = format(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.addString(value.value());
+    return true;
+  }
+
+  /**
+   * @return bool whether formatTo() appends the values returned by formatValue() with their
+   *         type, i.e. string values as strings and number values as integers, and formatValue()
+   *         returns no other types of values than these and null when formatTo() has no value.
+   *         formatTo() may then be used in place of formatValue() for typed output such as JSON.
+   */
+  virtual bool typedFormatTo() const { return false; }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
@@ -587,6 +587,16 @@ public:
    */
   virtual void continueDecoding() PURE;
 
+  /**
+   * Called by a filter which does not need the body and the trailers of the request, typically from
+   * decodeHeaders() once it has looked at the headers. The filter manager then passes the following
+   * body and trailers on to the next filters without calling decodeData() and decodeTrailers() of
+   * this filter, as if they had returned Continue. decodeMetadata() and decodeComplete() are still
+   * called. The filter is still called while its decoding iteration is stopped, so that it can
+   * buffer the body until it calls continueDecoding().
+   */
+  virtual void skipDecodingBodyAndTrailers() PURE;
+
   /**
    * @return const Buffer::Instance* the currently buffered data as buffered by this filter or
    *         previous ones in the filter chain. May be nullptr if nothing has been buffered yet.
@@ -1004,6 +1014,16 @@ public:
    */
   virtual void continueEncoding() PURE;
 
+  /**
+   * Called by a filter which does not need the body and the trailers of the response, typically
+   * from encodeHeaders() once it has looked at the headers. The filter manager then passes the
+   * following body and trailers on to the next filters without calling encodeData() and
+   * encodeTrailers() of this filter, as if they had returned Continue. encodeMetadata() and
+   * encodeComplete() are still called. The filter is still called while its encoding iteration is
+   * stopped, so that it can buffer the body until it calls continueEncoding().
+   */
+  virtual void skipEncodingBodyAndTrailers() PURE;
+
   /**
    * @return const Buffer::Instance* the currently buffered data as buffered by this filter or
    *         previous ones in the filter chain. May be nullptr if nothing has been buffered yet.
@@ -1245,6 +1265,14 @@ class FilterChainFactoryCallbacks {
 public:
   virtual ~FilterChainFactoryCallbacks() = default;
 
+  /**
+   * Reserve room for the filters about to be added, so that the filter chain doesn't grow its
+   * containers one filter at a time.
+   * @param filter_count supplies the number of filter factories about to add filters. A factory
+   * adding a decoder/encoder filter counts as one.
+   */
+  virtual void reserveFilters(uint32_t filter_count) PURE;
+
   /**
    * Add a decoder filter that is used when reading stream data.
    * @param filter supplies the filter to add.
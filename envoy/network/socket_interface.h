@@ -23,9 +23,15 @@ struct SocketCreationOptions {
   // Is only valid for datagram sockets.
   size_t max_addresses_cache_size_{0};
 
+  // Specifies whether the reuse port group of the listen sockets steers connections to the socket
+  // of the worker pinned to the CPU handling the connection's packets. Only valid for Stream
+  // sockets bound with reuse port, and only valid on Linux.
+  bool reuse_port_cpu_steering_{false};
+
   bool operator==(const SocketCreationOptions& rhs) const {
     return mptcp_enabled_ == rhs.mptcp_enabled_ &&
-           max_addresses_cache_size_ == rhs.max_addresses_cache_size_;
+           max_addresses_cache_size_ == rhs.max_addresses_cache_size_ &&
+           reuse_port_cpu_steering_ == rhs.reuse_port_cpu_steering_;
   }
 };
 
@@ -64,6 +64,25 @@ public:
   virtual ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                             Server::Configuration::ServerFactoryContext& context,
                                             bool validate_clusters_default) const PURE;
+
+  /**
+   * Create a config object based on a route configuration which replaces the one of
+   * previous_config. The config may share the parts of previous_config which are unchanged,
+   * rather than building them again. By default, it is the same as createConfig().
+   * @param rc supplies the RouteConfiguration.
+   * @param previous_config supplies the config being replaced, which may be the null config.
+   * @param context supplies the context of the server factory.
+   * @param validate_clusters_default specifies whether the clusters that the route
+   *    table refers to will be validated by the cluster manager.
+   * @throw EnvoyException if the new config can't be applied of.
+   */
+  virtual ConfigConstSharedPtr
+  createUpdatedConfig(const Protobuf::Message& rc, const ConfigConstSharedPtr& previous_config,
+                      Server::Configuration::ServerFactoryContext& context,
+                      bool validate_clusters_default) const {
+    UNREFERENCED_PARAMETER(previous_config);
+    return createConfig(rc, context, validate_clusters_default);
+  }
 };
 
 } // namespace Rds
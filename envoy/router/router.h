@@ -573,6 +573,12 @@ public:
    * @return the literal value to rewrite the host header with, or empty if no rewrite.
    */
   virtual absl::string_view hostRewriteLiteral() const PURE;
+
+  /**
+   * @return true if the mirrored request should be abandoned when it can't keep up, instead of
+   *         pushing back on the downstream.
+   */
+  virtual bool abandonOnBackpressure() const PURE;
 };
 
 using ShadowPolicyPtr = std::shared_ptr<ShadowPolicy>;
@@ -765,6 +771,19 @@ public:
    * will be canceled immediately.
    */
   virtual bool hedgeOnPerTryTimeout() const PURE;
+
+  /**
+   * @return the percentile, in (0, 100], of the recent upstream request latencies of the cluster
+   *         past which a try is hedged, or absl::nullopt if the requests are not hedged on their
+   *         latency.
+   */
+  virtual absl::optional<double> hedgeLatencyPercentile() const PURE;
+
+  /**
+   * @return the maximum ratio, in [0, 1], of the requests to the cluster which are hedged on their
+   *         latency.
+   */
+  virtual double hedgeBudgetRatio() const PURE;
 };
 
 class MetadataMatchCriterion {
@@ -1466,6 +1485,13 @@ public:
   virtual VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                                  const StreamInfo::StreamInfo& stream_info,
                                  uint64_t random_value) const PURE;
+
+  /**
+   * @return whether the result of route() without a callback only depends on the host, the
+   *         x-forwarded-proto header and the path without query string and fragment of the
+   *         request, so that it can be reused for other requests with the same values of these.
+   */
+  virtual bool routeResolutionCacheable() const PURE;
 };
 
 using ConfigConstSharedPtr = std::shared_ptr<const Config>;
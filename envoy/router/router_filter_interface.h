@@ -18,6 +18,8 @@ struct TimeoutData {
   std::chrono::milliseconds global_timeout_{0};
   std::chrono::milliseconds per_try_timeout_{0};
   std::chrono::milliseconds per_try_idle_timeout_{0};
+  // After which a try is hedged on its latency, or 0 if it is not.
+  std::chrono::milliseconds hedge_timeout_{0};
 };
 
 // The interface the UpstreamRequest has to interact with the router filter.
@@ -98,6 +100,12 @@ public:
    */
   virtual void onPerTryIdleTimeout(UpstreamRequest& upstream_request) PURE;
 
+  /*
+   * This will be called if a try takes longer than the hedge timeout.
+   * @param upstream_request inicates which UpstreamRequest to hedge
+   */
+  virtual void onHedgeTimeout(UpstreamRequest& upstream_request) PURE;
+
   /*
    * This will be called if the max stream duration was reached.
    * @param upstream_request inicates which UpstreamRequest which timed out
@@ -27,6 +27,26 @@ class ClusterManager;
 
 namespace Runtime {
 
+/**
+ * A runtime key resolved once by Loader::resolveKey(), typically at configuration time. The
+ * snapshots look up the value of a resolved key by its index rather than by hashing the key.
+ */
+class ResolvedKey {
+public:
+  // The index of a key that is not resolved, whose value is looked up by key.
+  static constexpr uint32_t UnresolvedIndex = std::numeric_limits<uint32_t>::max();
+
+  explicit ResolvedKey(std::string key, uint32_t index = UnresolvedIndex)
+      : key_(std::move(key)), index_(index) {}
+
+  const std::string& key() const { return key_; }
+  uint32_t index() const { return index_; }
+
+private:
+  std::string key_;
+  uint32_t index_;
+};
+
 /**
  * A snapshot of runtime data.
  */
@@ -201,6 +221,24 @@ public:
    */
   virtual bool getBoolean(absl::string_view key, bool default_value) const PURE;
 
+  /**
+   * Variants of the above for a key resolved by Loader::resolveKey(). By default they look up the
+   * key itself.
+   */
+  virtual bool featureEnabled(const ResolvedKey& key,
+                              const envoy::type::v3::FractionalPercent& default_value) const {
+    return featureEnabled(absl::string_view(key.key()), default_value);
+  }
+  virtual uint64_t getInteger(const ResolvedKey& key, uint64_t default_value) const {
+    return getInteger(absl::string_view(key.key()), default_value);
+  }
+  virtual double getDouble(const ResolvedKey& key, double default_value) const {
+    return getDouble(absl::string_view(key.key()), default_value);
+  }
+  virtual bool getBoolean(const ResolvedKey& key, bool default_value) const {
+    return getBoolean(absl::string_view(key.key()), default_value);
+  }
+
   /**
    * Fetch the OverrideLayers that provide values in this snapshot. Layers are ordered from bottom
    * to top; for instance, the second layer's entries override the first layer's entries, and so on.
@@ -268,6 +306,14 @@ public:
    * Updates deprecated feature use stats.
    */
   virtual void countDeprecatedFeatureUse() const PURE;
+
+  /**
+   * Resolves a key, so that the snapshots look its value up by index. The snapshots loaded before
+   * the key was resolved look it up by key. This may be called from any thread.
+   * @param key supplies the key to resolve.
+   * @return ResolvedKey the resolved key.
+   */
+  virtual ResolvedKey resolveKey(absl::string_view key) { return ResolvedKey(std::string(key)); }
 };
 
 using LoaderPtr = std::unique_ptr<Loader>;
@@ -38,6 +38,20 @@ public:
   run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent event,
       const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
       MonotonicTime now) PURE;
+
+  /**
+   * Called when the GuardDog starts watching a thread, before any event about it, e.g. to sample
+   * the thread so that its later events can be diagnosed. Called from the thread creating the
+   * watchdog, so possibly concurrently with run().
+   * @param thread_id the watched thread.
+   */
+  virtual void onWatchStarted(const Thread::ThreadId& /*thread_id*/) {}
+
+  /**
+   * Called when the GuardDog stops watching a thread, from the thread stopping the watch.
+   * @param thread_id the thread no longer watched.
+   */
+  virtual void onWatchStopped(const Thread::ThreadId& /*thread_id*/) {}
 };
 
 using GuardDogActionPtr = std::unique_ptr<GuardDogAction>;
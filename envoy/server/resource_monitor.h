@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "envoy/common/exception.h"
@@ -50,7 +51,14 @@ public:
    * done asynchronously and invoke the callback when finished.
    */
   virtual void updateResourceUsage(ResourceUpdateCallbacks& callbacks) PURE;
-};
+
+  /**
+   * Sets the callback the monitor may invoke on the main thread to have its resource usage updated
+   * right away, e.g. when notified of a change of pressure by the kernel, rather than at the next
+   * refresh interval. The monitors without such notifications only need the periodic updates and
+   * ignore it.
+   */
+  virtual void setRefreshCallback(std::function<void()>) {}
 
 using ResourceMonitorPtr = std::unique_ptr<ResourceMonitor>;
 
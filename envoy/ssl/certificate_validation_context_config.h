@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -100,6 +101,22 @@ public:
    */
   virtual absl::optional<uint32_t> maxVerifyDepth() const PURE;
 
+  struct VerifiedChainCacheConfig {
+    uint32_t max_entries_;
+    std::chrono::milliseconds max_ttl_;
+  };
+
+  /**
+   * @return the configuration of the cache of verified certificate chains, if enabled.
+   */
+  virtual const absl::optional<VerifiedChainCacheConfig>& verifiedChainCache() const PURE;
+
+  /**
+   * @return the number of threads of the pool to offload the trust chain verifications to, or 0
+   * for the number of hardware threads, if enabled.
+   */
+  virtual absl::optional<uint32_t> trustChainVerificationOffloadThreads() const PURE;
+
   /**
    * @return true if the SAN validation rules should be replaced with a rule to validate that the
    * certificate matches the transmitted SNI.
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/extensions/transport_sockets/tls/v3/common.pb.h"
 #include "envoy/ssl/certificate_validation_context_config.h"
 #include "envoy/ssl/handshaker.h"
@@ -119,6 +120,18 @@ public:
    */
   virtual AccessLog::AccessLogManager& accessLogManager() const PURE;
 
+  /**
+   * @return whether the encryption of the written TLS records is offloaded to the kernel once the
+   * handshake is complete.
+   */
+  virtual bool kernelTlsTx() const PURE;
+
+  /**
+   * @return whether the decryption of the read TLS records is offloaded to the kernel once the
+   * handshake is complete.
+   */
+  virtual bool kernelTlsRx() const PURE;
+
   /**
    * @return the compiance policy for the TLS context.
    */
@@ -180,6 +193,13 @@ public:
     std::array<uint8_t, 256 / 8> aes_key_; // AES256 key size, in bytes
   };
 
+  // A schedule of the keys encrypting new session tickets.
+  struct SessionTicketKeyRotation {
+    // The start of the schedule, from which the first key encrypts new tickets for interval_.
+    SystemTime start_time_;
+    std::chrono::milliseconds interval_;
+  };
+
   enum class OcspStaplePolicy {
     LenientStapling,
     StrictStapling,
@@ -204,6 +224,12 @@ public:
    */
   virtual const std::vector<SessionTicketKey>& sessionTicketKeys() const PURE;
 
+  /**
+   * @return the schedule of the session ticket keys encrypting new tickets, if they are rotated
+   * on a schedule rather than the first key always encrypting new tickets.
+   */
+  virtual const absl::optional<SessionTicketKeyRotation>& sessionTicketKeyRotation() const PURE;
+
   /**
    * @return timeout in seconds for the session.
    * Session timeout is used to specify lifetime hint of tls tickets.
@@ -57,6 +57,14 @@ public:
    * @return the time in UTC since epoch when the snapshot was created.
    */
   virtual SystemTime snapshotTime() const PURE;
+
+  /**
+   * @return true if the snapshot only contains the metrics that changed since the previous delta
+   * snapshot: counters and host counters with a non-zero delta, gauges and text readouts that were
+   * updated, and histograms with samples in the last interval. All host gauges are included. If
+   * false, the snapshot contains all sinked metrics.
+   */
+  virtual bool isDelta() const { return false; }
 };
 
 /**
@@ -100,6 +108,14 @@ public:
    */
   virtual void flush(MetricSnapshot& snapshot) PURE;
 
+  /**
+   * Called before each periodic flush. Sinks that only need the metrics that changed since the
+   * previous flush can return false, which lets the flush build a delta snapshot when no sink
+   * needs all metrics. Such sinks can still return true periodically to get the full state.
+   * @return whether the next flush must include all metrics.
+   */
+  virtual bool needsFullSnapshot() { return true; }
+
   /**
    * Flush a single histogram sample. Note: this call is called synchronously as a part of recording
    * the metric, so implementations must be thread-safe.
@@ -107,12 +107,14 @@ public:
    * Flags:
    * Used: used by all stats types to figure out whether they have been used.
    * Logic...: used by gauges to cache how they should be combined with a parent's value.
+   * Changed: used by gauges and text readouts to track updates between delta flushes.
    */
   struct Flags {
     static constexpr uint8_t Used = 0x01;
     static constexpr uint8_t LogicAccumulate = 0x02;
     static constexpr uint8_t NeverImport = 0x04;
     static constexpr uint8_t Hidden = 0x08;
+    static constexpr uint8_t Changed = 0x10;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
@@ -191,6 +193,12 @@ public:
    * @param import_mode the new import mode.
    */
   virtual void mergeImportMode(ImportMode import_mode) PURE;
+
+  /**
+   * @return whether the gauge may have changed since the last call, clearing the indicator. A
+   * newly created gauge counts as changed. Used to build delta snapshots for sinks.
+   */
+  virtual bool latchChanged() PURE;
 };
 
 using GaugeSharedPtr = RefcountPtr<Gauge>;
@@ -218,6 +226,12 @@ public:
    * @return the copy of this TextReadout value.
    */
   virtual std::string value() const PURE;
+
+  /**
+   * @return whether the text readout may have changed since the last call, clearing the indicator.
+   * A newly created text readout counts as changed. Used to build delta snapshots for sinks.
+   */
+  virtual bool latchChanged() PURE;
 };
 
 using TextReadoutSharedPtr = RefcountPtr<TextReadout>;
@@ -175,6 +175,15 @@ public:
    * @return the detected close type from socket.
    */
   virtual StreamInfo::DetectedCloseType detectedCloseType() const PURE;
+
+  /**
+   * Called to return the upstream connection to the connection pool it was obtained from, so
+   * that it can be reused by another downstream connection. After a successful call, no more
+   * callbacks are invoked for the connection and this object must not be used anymore.
+   * @return true if the connection was released, false if it can not be reused (e.g. because it
+   *         is not fully open or is not a pooled TCP connection).
+   */
+  virtual bool releaseConnectionForReuse() PURE;
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
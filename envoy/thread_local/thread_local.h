@@ -209,6 +209,16 @@ private:
 
 template <class T = ThreadLocalObject> using TypedSlotPtr = std::unique_ptr<TypedSlot<T>>;
 
+/**
+ * A batch of thread local updates, delivered when it is destroyed. See Instance::batchUpdates().
+ */
+class UpdateBatch {
+public:
+  virtual ~UpdateBatch() = default;
+};
+
+using UpdateBatchPtr = std::unique_ptr<UpdateBatch>;
+
 /**
  * Interface for getting and setting thread local data as well as registering a thread
  */
@@ -242,6 +252,20 @@ public:
    */
   virtual Event::Dispatcher& dispatcher() PURE;
 
+  /**
+   * Batches the updates of all the slots until the returned batch is destroyed: the main thread
+   * part of runOnAllThreads() still runs immediately, but the worker part is queued and then
+   * delivered to each worker as a single post running the queued updates in order. The completion
+   * callbacks of the batched updates run in order, in a single main thread post, once every worker
+   * ran the batch. Batches may be nested, the updates are delivered with the outermost one.
+   *
+   * Setting a slot flushes the queued updates first, so that the order of the updates of the slots
+   * is preserved on each worker. Work posted directly to the dispatcher of a worker is not ordered
+   * with the queued updates, so a batch should not outlive the bulk update it covers.
+   * Must be called on the main thread.
+   */
+  virtual UpdateBatchPtr batchUpdates() PURE;
+
   /**
    * Returns whether or not global threading has been shutdown.
    *
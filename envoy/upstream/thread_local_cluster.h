@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/common/pure.h"
 #include "envoy/http/async_client.h"
 #include "envoy/tcp/async_tcp_client.h"
@@ -70,6 +72,41 @@ private:
   Tcp::ConnectionPool::Instance* pool_;
 };
 
+/**
+ * The latencies of the recent upstream requests to a cluster of the routes hedging on latency, as
+ * seen by one worker thread, with the budget of their hedged requests.
+ */
+class RequestLatencyTracker {
+public:
+  virtual ~RequestLatencyTracker() = default;
+
+  /**
+   * Counts a request which may be hedged, against which the budget of the hedged requests is
+   * computed.
+   */
+  virtual void onRequest() PURE;
+
+  /**
+   * Records the latency of a try, from its request being sent to its response being complete.
+   */
+  virtual void recordLatency(std::chrono::milliseconds latency) PURE;
+
+  /**
+   * @param percentile supplies the percentile, in [0, 100].
+   * @return an upper bound of the percentile of the recent latencies, or absl::nullopt while too
+   *         few were recorded for it to be meaningful.
+   */
+  virtual absl::optional<std::chrono::milliseconds> latencyPercentile(double percentile) const PURE;
+
+  /**
+   * Takes a hedged request from the budget, if the recent hedged requests are still under a ratio
+   * of the recent requests.
+   * @param budget_ratio supplies the ratio, in [0, 1].
+   * @return whether a request can be hedged.
+   */
+  virtual bool tryHedge(double budget_ratio) PURE;
+};
+
 /**
  * A thread local cluster instance that can be used for direct load balancing and host set
  * interactions. In general, an instance of ThreadLocalCluster can only be safely used in the
@@ -187,6 +224,12 @@ public:
    * Set up the drop_category value for the thread local cluster.
    */
   virtual void setDropCategory(absl::string_view drop_category) PURE;
+
+  /**
+   * @return the tracker of the upstream request latencies to the cluster on this thread, created on
+   *         first use.
+   */
+  virtual RequestLatencyTracker& requestLatencyTracker() PURE;
 };
 
 using ThreadLocalClusterOptRef = absl::optional<std::reference_wrapper<ThreadLocalCluster>>;
@@ -658,6 +658,7 @@ public:
   COUNTER(assignment_timeout_received)                                                             \
   COUNTER(assignment_use_cached)                                                                   \
   COUNTER(update_attempt)                                                                          \
+  COUNTER(update_coalesced)                                                                        \
   COUNTER(update_empty)                                                                            \
   COUNTER(update_failure)                                                                          \
   COUNTER(update_no_rebuild)                                                                       \
@@ -722,6 +723,7 @@ public:
   COUNTER(upstream_cx_none_healthy)                                                                \
   COUNTER(upstream_cx_overflow)                                                                    \
   COUNTER(upstream_cx_pool_overflow)                                                               \
+  COUNTER(upstream_cx_preconnect_adaptive)                                                         \
   COUNTER(upstream_cx_protocol_error)                                                              \
   COUNTER(upstream_cx_rx_bytes_total)                                                              \
   COUNTER(upstream_cx_total)                                                                       \
@@ -1029,6 +1031,12 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return whether connection pools should preconnect for the streams expected to arrive while a
+   * new connection is being established.
+   */
+  virtual bool adaptivePreconnect() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -382,6 +382,22 @@ DEFINE_SET_ARRAY_REGION(Float, jfloatArray, jfloat)
 DEFINE_SET_ARRAY_REGION(Double, jdoubleArray, jdouble)
 DEFINE_SET_ARRAY_REGION(Boolean, jbooleanArray, jboolean)
 
+#define DEFINE_GET_ARRAY_REGION(JAVA_TYPE, JNI_ARRAY_TYPE, JNI_ELEMENT_TYPE)                       \
+  void JniHelper::get##JAVA_TYPE##ArrayRegion(JNI_ARRAY_TYPE array, jsize start, jsize length,     \
+                                              JNI_ELEMENT_TYPE* buffer) {                          \
+    env_->Get##JAVA_TYPE##ArrayRegion(array, start, length, buffer);                               \
+    rethrowException();                                                                            \
+  }
+
+DEFINE_GET_ARRAY_REGION(Byte, jbyteArray, jbyte)
+DEFINE_GET_ARRAY_REGION(Char, jcharArray, jchar)
+DEFINE_GET_ARRAY_REGION(Short, jshortArray, jshort)
+DEFINE_GET_ARRAY_REGION(Int, jintArray, jint)
+DEFINE_GET_ARRAY_REGION(Long, jlongArray, jlong)
+DEFINE_GET_ARRAY_REGION(Float, jfloatArray, jfloat)
+DEFINE_GET_ARRAY_REGION(Double, jdoubleArray, jdouble)
+DEFINE_GET_ARRAY_REGION(Boolean, jbooleanArray, jboolean)
+
 #define DEFINE_CALL_METHOD(JAVA_TYPE, JNI_TYPE)                                                    \
   JNI_TYPE JniHelper::call##JAVA_TYPE##Method(jobject object, jmethodID method_id, ...) {          \
     va_list args;                                                                                  \
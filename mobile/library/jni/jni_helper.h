@@ -429,6 +429,24 @@ public:
   DECLARE_SET_ARRAY_REGION(Double, jdoubleArray, jdouble)
   DECLARE_SET_ARRAY_REGION(Boolean, jbooleanArray, jboolean)
 
+  /**
+   * Copies a region of an `array` with the specified `start` index and `length` into a `buffer`.
+   *
+   * https://docs.oracle.com/en/java/javase/17/docs/specs/jni/functions.html#getprimitivetypearrayregion-routines
+   */
+#define DECLARE_GET_ARRAY_REGION(JAVA_TYPE, JNI_ARRAY_TYPE, JNI_ELEMENT_TYPE)                      \
+  void get##JAVA_TYPE##ArrayRegion(JNI_ARRAY_TYPE array, jsize start, jsize length,                \
+                                   JNI_ELEMENT_TYPE* buffer);
+
+  DECLARE_GET_ARRAY_REGION(Byte, jbyteArray, jbyte)
+  DECLARE_GET_ARRAY_REGION(Char, jcharArray, jchar)
+  DECLARE_GET_ARRAY_REGION(Short, jshortArray, jshort)
+  DECLARE_GET_ARRAY_REGION(Int, jintArray, jint)
+  DECLARE_GET_ARRAY_REGION(Long, jlongArray, jlong)
+  DECLARE_GET_ARRAY_REGION(Float, jfloatArray, jfloat)
+  DECLARE_GET_ARRAY_REGION(Double, jdoubleArray, jdouble)
+  DECLARE_GET_ARRAY_REGION(Boolean, jbooleanArray, jboolean)
+
 /** A macro to create `Call<Type>Method` helper function. */
 #define DECLARE_CALL_METHOD(JAVA_TYPE, JNI_TYPE)                                                   \
   JNI_TYPE call##JAVA_TYPE##Method(jobject object, jmethodID method_id, ...);
@@ -1,5 +1,6 @@
 #include "library/jni/jni_utility.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -657,10 +658,15 @@ Buffer::InstancePtr javaNonDirectByteBufferToCppBufferInstance(JniHelper& jni_he
   auto java_byte_array =
       jni_helper.callObjectMethod<jbyteArray>(java_byte_buffer, java_byte_buffer_array_method_id);
   ASSERT(java_byte_array != nullptr, "The ByteBuffer argument is not a non-direct ByteBuffer.");
-  auto java_byte_array_elements = jni_helper.getByteArrayElements(java_byte_array.get(), nullptr);
   Buffer::InstancePtr cpp_buffer_instance = std::make_unique<Buffer::OwnedImpl>();
-  cpp_buffer_instance->add(static_cast<void*>(java_byte_array_elements.get()),
-                           static_cast<uint64_t>(length));
+  if (length > 0) {
+    // Copies the bytes sent straight into the buffer, rather than the whole array out of the JVM,
+    // into the buffer, and back into the JVM when releasing the elements of the array.
+    auto reservation = cpp_buffer_instance->reserveSingleSlice(static_cast<uint64_t>(length));
+    jni_helper.getByteArrayRegion(java_byte_array.get(), 0, static_cast<jsize>(length),
+                                  static_cast<jbyte*>(reservation.slice().mem_));
+    reservation.commit(static_cast<uint64_t>(length));
+  }
   return cpp_buffer_instance;
 }
 
@@ -670,8 +676,19 @@ LocalRefUniquePtr<jobject> cppBufferInstanceToJavaNonDirectByteBuffer(
   auto java_byte_buffer_wrap_method_id = jni_helper.getStaticMethodIdFromCache(
       java_byte_buffer_class, "wrap", "([B)Ljava/nio/ByteBuffer;");
   auto java_byte_array = jni_helper.newByteArray(static_cast<jsize>(cpp_buffer_instance.length()));
-  auto java_byte_array_elements = jni_helper.getByteArrayElements(java_byte_array.get(), nullptr);
-  cpp_buffer_instance.copyOut(0, length, static_cast<void*>(java_byte_array_elements.get()));
+  // Copies the slices of the buffer straight into the array, rather than into a copy of the
+  // elements of the array copied back into the JVM when releasing them.
+  uint64_t offset = 0;
+  for (const Buffer::RawSlice& slice : cpp_buffer_instance.getRawSlices()) {
+    if (offset >= length) {
+      break;
+    }
+    const uint64_t slice_length = std::min<uint64_t>(slice.len_, length - offset);
+    jni_helper.setByteArrayRegion(java_byte_array.get(), static_cast<jsize>(offset),
+                                  static_cast<jsize>(slice_length),
+                                  static_cast<const jbyte*>(slice.mem_));
+    offset += slice_length;
+  }
   return jni_helper.callStaticObjectMethod(java_byte_buffer_class, java_byte_buffer_wrap_method_id,
                                            java_byte_array.get());
 }
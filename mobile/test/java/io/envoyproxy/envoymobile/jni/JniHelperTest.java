@@ -86,6 +86,7 @@ public class JniHelperTest {
                                                  double[] buffer);
   public static native void setBooleanArrayRegion(boolean[] array, int start, int index,
                                                   boolean[] buffer);
+  public static native byte[] getByteArrayRegion(byte[] array, int start, int length);
   public static native byte callByteMethod(Class<?> clazz, Object instance, String name,
                                            String signature);
   public static native char callCharMethod(Class<?> clazz, Object instance, String name,
@@ -420,6 +421,12 @@ public class JniHelperTest {
     assertThat(array).isEqualTo(new byte[] {1, 2, 3, 4, 5});
   }
 
+  @Test
+  public void testGetByteArrayRegion() {
+    byte[] array = new byte[] {1, 2, 3, 4, 5};
+    assertThat(getByteArrayRegion(array, 1, 3)).isEqualTo(new byte[] {2, 3, 4});
+  }
+
   @Test
   public void testSetCharArrayRegion() {
     char[] array = new char[] {'a', ' ', ' ', ' ', 'e'};
@@ -1,6 +1,7 @@
 #include <jni.h>
 
 #include <iostream>
+#include <vector>
 
 #include "library/jni/jni_helper.h"
 
@@ -305,6 +306,18 @@ DEFINE_JNI_SET_ARRAY_REGION(Float, jfloatArray)
 DEFINE_JNI_SET_ARRAY_REGION(Double, jdoubleArray)
 DEFINE_JNI_SET_ARRAY_REGION(Boolean, jbooleanArray)
 
+extern "C" JNIEXPORT jbyteArray JNICALL
+Java_io_envoyproxy_envoymobile_jni_JniHelperTest_getByteArrayRegion(JNIEnv* env, jclass,
+                                                                    jbyteArray array, jsize start,
+                                                                    jsize length) {
+  Envoy::JNI::JniHelper jni_helper(env);
+  std::vector<jbyte> buffer(length);
+  jni_helper.getByteArrayRegion(array, start, length, buffer.data());
+  auto result = jni_helper.newByteArray(length);
+  jni_helper.setByteArrayRegion(result.get(), 0, length, buffer.data());
+  return result.release();
+}
+
 #define DEFINE_JNI_CALL_METHOD(JAVA_TYPE, JNI_TYPE)                                                \
   extern "C" JNIEXPORT JNI_TYPE JNICALL                                                            \
       Java_io_envoyproxy_envoymobile_jni_JniHelperTest_call##JAVA_TYPE##Method(                    \
@@ -74,26 +74,30 @@ AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatch
 }
 
 void AccessLogFileImpl::reopen() {
-  Thread::LockGuard lock(write_lock_);
+  Thread::LockGuard lock(state_lock_);
   reopen_file_ = true;
   flush_event_.notifyOne();
 }
 
 AccessLogFileImpl::~AccessLogFileImpl() {
+  Thread::Thread* flush_thread;
   {
-    Thread::LockGuard lock(write_lock_);
+    Thread::LockGuard lock(state_lock_);
     flush_thread_exit_ = true;
     flush_event_.notifyOne();
+    flush_thread = flush_thread_.get();
   }
 
-  if (flush_thread_ != nullptr) {
-    flush_thread_->join();
+  if (flush_thread != nullptr) {
+    flush_thread->join();
   }
 
   // Flush any remaining data. If file was not opened for some reason, skip flushing part.
   if (file_->isOpen()) {
-    if (flush_buffer_.length() > 0) {
-      doWrite(flush_buffer_);
+    Thread::LockGuard flush_lock(flush_lock_);
+    moveWriteShards();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
     }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
@@ -138,36 +142,33 @@ void AccessLogFileImpl::flushThreadFunc() {
   bool do_reopen = false;
 
   while (true) {
-    std::unique_lock<Thread::BasicLockable> flush_lock;
-
     {
-      Thread::LockGuard write_lock(write_lock_);
+      Thread::LockGuard state_lock(state_lock_);
 
-      // flush_event_ can be woken up either by large enough flush_buffer or by timer.
-      // In case it was timer, flush_buffer_ can be empty.
+      // flush_event_ can be woken up either by large enough write shards or by timer.
+      // In case it was timer, write_shards_ can be empty.
       //
       // Note: do not stop waiting when only `do_reopen` is true. In this case, we tried to
       // reopen and failed. We don't want to retry this in a tight loop, so wait for the next
       // event (timer or flush).
-      while (flush_buffer_.length() == 0 && !flush_thread_exit_ && !reopen_file_) {
+      while (buffered_bytes_.load() == 0 && !flush_thread_exit_ && !reopen_file_) {
         // CondVar::wait() does not throw, so it's safe to pass the mutex rather than the guard.
-        flush_event_.wait(write_lock_);
+        flush_event_.wait(state_lock_);
       }
 
       if (flush_thread_exit_) {
         return;
       }
 
-      flush_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-      about_to_write_buffer_.move(flush_buffer_);
-      ASSERT(flush_buffer_.length() == 0);
-
       if (reopen_file_) {
         do_reopen = true;
         reopen_file_ = false;
       }
     }
 
+    Thread::LockGuard flush_lock(flush_lock_);
+    moveWriteShards();
+
     if (do_reopen) {
       if (file_->isOpen()) {
         const Api::IoCallBoolResult result = file_->close();
@@ -187,40 +188,56 @@ void AccessLogFileImpl::flushThreadFunc() {
 }
 
 void AccessLogFileImpl::flush() {
-  std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
-
-  {
-    Thread::LockGuard write_lock(write_lock_);
-
-    // flush_lock_ must be held while checking this or else it is
-    // possible that flushThreadFunc() has already moved data from
-    // flush_buffer_ to about_to_write_buffer_, has unlocked write_lock_,
-    // but has not yet completed doWrite(). This would allow flush() to
-    // return before the pending data has actually been written to disk.
-    flush_buffer_lock = std::unique_lock<Thread::BasicLockable>(flush_lock_);
-
-    if (flush_buffer_.length() == 0) {
-      return;
-    }
-
-    about_to_write_buffer_.move(flush_buffer_);
-    ASSERT(flush_buffer_.length() == 0);
+  // flush_lock_ must be held while moving the data or else it is possible that
+  // flushThreadFunc() has already moved data from write_shards_ to about_to_write_buffer_,
+  // but has not yet completed doWrite(). This would allow flush() to return before the
+  // pending data has actually been written to disk.
+  Thread::LockGuard flush_lock(flush_lock_);
+  moveWriteShards();
+  if (about_to_write_buffer_.length() == 0) {
+    return;
   }
 
   doWrite(about_to_write_buffer_);
 }
 
-void AccessLogFileImpl::write(absl::string_view data) {
-  Thread::LockGuard lock(write_lock_);
-
-  if (flush_thread_ == nullptr) {
-    createFlushStructures();
+void AccessLogFileImpl::moveWriteShards() {
+  for (WriteShard& shard : write_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    buffered_bytes_ -= shard.buffer_.length();
+    about_to_write_buffer_.move(shard.buffer_);
   }
+}
+
+void AccessLogFileImpl::write(absl::string_view data) {
+  // The threads are spread over the write shards in the order they first write to a file.
+  static std::atomic<size_t> next_shard{0};
+  static thread_local const size_t shard_index = next_shard++ % WriteShards;
 
   stats_.write_buffered_.inc();
   stats_.write_total_buffered_.add(data.length());
-  flush_buffer_.add(data.data(), data.size());
-  if (flush_buffer_.length() > min_flush_size_) {
+  uint64_t buffered_bytes;
+  {
+    WriteShard& shard = write_shards_[shard_index];
+    Thread::LockGuard lock(shard.lock_);
+    shard.buffer_.add(data.data(), data.size());
+    buffered_bytes = buffered_bytes_ += data.size();
+  }
+
+  // The flush thread is created after the data is buffered, so that it flushes it on its first
+  // loop.
+  if (!flush_thread_created_.load(std::memory_order_acquire)) {
+    Thread::LockGuard lock(state_lock_);
+    if (flush_thread_ == nullptr) {
+      createFlushStructures();
+      flush_thread_created_.store(true, std::memory_order_release);
+    }
+  }
+
+  // Only the write reaching the minimum flush size wakes the flush thread up, which flushes all
+  // the data buffered since then.
+  if (buffered_bytes > min_flush_size_ && buffered_bytes - data.size() <= min_flush_size_) {
+    Thread::LockGuard lock(state_lock_);
     flush_event_.notifyOne();
   }
 }
@@ -2,6 +2,8 @@
 
 #include <sys/types.h>
 
+#include <array>
+#include <atomic>
 #include <string>
 
 #include "envoy/access_log/access_log.h"
@@ -65,6 +67,11 @@ private:
  * This implementation uses a flush thread per file, with the idea there aren't that many
  * files. If this turns out to be a good implementation we can potentially have a single flush
  * thread that flushes all files, but we will start with this.
+ *
+ * The lines are buffered in a few write shards, each with its own lock, so that the workers logging
+ * to the same file do not all contend on a single lock. A thread always writes to the same shard,
+ * which keeps the lines it writes in order. The flush thread writes the shards out one after the
+ * other, so that the lines of different threads may be reordered within a flush.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
@@ -86,16 +93,25 @@ public:
   void flush() override;
 
 private:
+  // A buffer filled by the threads writing to the file.
+  struct WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+  static constexpr size_t WriteShards = 8;
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
-  void createFlushStructures();
+  void createFlushStructures() ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_lock_);
+  // Moves the data of all the write shards to about_to_write_buffer_. flush_lock_ must be held.
+  void moveWriteShards();
 
   Filesystem::FilePtr file_;
 
   // These locks are always acquired in the following order if multiple locks are held:
-  //    1) write_lock_
-  //    2) flush_lock_
-  //    3) file_lock_
+  //    1) flush_lock_
+  //    2) the lock_ of a write shard, or file_lock_
+  // state_lock_ is never held with another lock.
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -105,24 +121,25 @@ private:
                                           // concurrent access to the about_to_write_buffer_, fd_,
                                           // and all other data used during flushing and file
                                           // re-opening.
-  Thread::MutexBasicLockable
-      write_lock_; // The lock is used when filling the flush buffer. It allows
-                   // multiple threads to write to the same file at relatively
-                   // high performance. It is always local to the process.
-  Thread::ThreadPtr flush_thread_;
+  Thread::MutexBasicLockable state_lock_; // This lock protects the state the flush thread waits
+                                          // on. It is only taken by the writing threads when the
+                                          // buffered data reaches the minimum flush size.
+  Thread::ThreadPtr flush_thread_ ABSL_GUARDED_BY(state_lock_);
+  std::atomic<bool> flush_thread_created_{false};
   Thread::CondVar flush_event_;
-  bool flush_thread_exit_ ABSL_GUARDED_BY(write_lock_){false};
-  bool reopen_file_ ABSL_GUARDED_BY(write_lock_){false};
-  Buffer::OwnedImpl
-      flush_buffer_ ABSL_GUARDED_BY(write_lock_); // This buffer is used by multiple threads. It
-                                                  // gets filled and then flushed either when max
-                                                  // size is reached or when a timer fires.
+  bool flush_thread_exit_ ABSL_GUARDED_BY(state_lock_){false};
+  bool reopen_file_ ABSL_GUARDED_BY(state_lock_){false};
+  std::array<WriteShard, WriteShards> write_shards_; // These buffers are used by multiple threads.
+                                                     // They get filled and then flushed either
+                                                     // when min size is reached or when a timer
+                                                     // fires.
+  std::atomic<uint64_t> buffered_bytes_{0};          // The bytes in write_shards_.
   // TODO(jmarantz): this should be ABSL_GUARDED_BY(flush_lock_) but the analysis cannot poke
   // through the std::make_unique assignment. I do not believe it's possible to annotate this
   // properly now due to limitations in the clang thread annotation analysis.
   Buffer::OwnedImpl about_to_write_buffer_; // This buffer is used only by the flush thread. Data
-                                            // is moved from flush_buffer_ under lock, and then
-                                            // the lock is released so that flush_buffer_ can
+                                            // is moved from write_shards_ under lock, and then
+                                            // the lock is released so that write_shards_ can
                                             // continue to fill. This buffer is then used for the
                                             // final write to disk.
   Event::TimerPtr flush_timer_;
@@ -5,6 +5,8 @@
 #include "source/common/api/os_sys_calls_impl_linux.h"
 
 #include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <cerrno>
 
@@ -17,6 +19,19 @@ SysCallIntResult LinuxOsSysCallsImpl::sched_getaffinity(pid_t pid, size_t cpuset
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::sched_setaffinity(pid_t pid, size_t cpusetsize,
+                                                        const cpu_set_t* mask) {
+  const int rc = ::sched_setaffinity(pid, cpusetsize, mask);
+  return {rc, errno};
+}
+
+SysCallIntResult LinuxOsSysCallsImpl::set_mempolicy(int mode, const unsigned long* nodemask,
+                                                    unsigned long maxnode) {
+  // glibc has no wrapper for set_mempolicy, which is provided by libnuma.
+  const int rc = ::syscall(SYS_set_mempolicy, mode, nodemask, maxnode);
+  return {rc, errno};
+}
+
 SysCallIntResult LinuxOsSysCallsImpl::setns(int fd, int nstype) const {
   const int rc = ::setns(fd, nstype);
   return {rc, errno};
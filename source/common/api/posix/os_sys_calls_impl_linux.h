@@ -15,6 +15,9 @@ class LinuxOsSysCallsImpl : public LinuxOsSysCalls {
 public:
   // Api::LinuxOsSysCalls
   SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) override;
+  SysCallIntResult sched_setaffinity(pid_t pid, size_t cpusetsize, const cpu_set_t* mask) override;
+  SysCallIntResult set_mempolicy(int mode, const unsigned long* nodemask,
+                                 unsigned long maxnode) override;
   SysCallIntResult setns(int fd, int nstype) const override;
 };
 
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 
@@ -17,8 +18,41 @@ namespace {
 // TODO(yanavlasov): This may not be optimal for all hardware configurations or traffic patterns and
 // may need to be configurable in the future.
 constexpr uint64_t CopyThreshold = 512;
+
+using SliceStorageFreeListEntries = std::vector<SliceStorageFreeList::StoragePtr>;
+
+SliceStorageFreeListEntries& threadLocalSliceStorageFreeList() {
+  thread_local SliceStorageFreeListEntries free_list;
+  return free_list;
+}
 } // namespace
 
+std::atomic<uint32_t> SliceStorageFreeList::max_entries_{0};
+
+SliceStorageFreeList::StoragePtr SliceStorageFreeList::allocate() {
+  SliceStorageFreeListEntries& free_list = threadLocalSliceStorageFreeList();
+  if (free_list.empty()) {
+    return StoragePtr{new uint8_t[StorageSize]};
+  }
+  StoragePtr storage = std::move(free_list.back());
+  free_list.pop_back();
+  return storage;
+}
+
+void SliceStorageFreeList::release(StoragePtr&& storage) {
+  ASSERT(storage != nullptr);
+  SliceStorageFreeListEntries& free_list = threadLocalSliceStorageFreeList();
+  if (free_list.size() < max_entries_.load(std::memory_order_relaxed)) {
+    free_list.push_back(std::move(storage));
+    return;
+  }
+  storage.reset();
+}
+
+size_t SliceStorageFreeList::sizeForTest() { return threadLocalSliceStorageFreeList().size(); }
+
+void SliceStorageFreeList::clearForTest() { threadLocalSliceStorageFreeList().clear(); }
+
 thread_local absl::InlinedVector<Slice::StoragePtr,
                                  OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
     OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
@@ -272,6 +306,19 @@ SliceDataPtr OwnedImpl::extractMutableFrontSlice() {
   }
 }
 
+void OwnedImpl::makeSlicesMutable() {
+  for (Slice& slice : slices_) {
+    const uint64_t size = slice.dataSize();
+    if (slice.isMutable() || size == 0) {
+      continue;
+    }
+    Slice mutable_slice{size, account_};
+    const uint64_t copy_size = mutable_slice.append(slice.data(), size);
+    ASSERT(copy_size == size);
+    slice = std::move(mutable_slice);
+  }
+}
+
 uint64_t OwnedImpl::length() const {
 #ifndef NDEBUG
   // When running in debug mode, verify that the precomputed length matches the sum
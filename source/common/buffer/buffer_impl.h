@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -19,6 +20,65 @@
 namespace Envoy {
 namespace Buffer {
 
+/**
+ * A thread local free list of fixed size slice storage blocks. When enabled, mutable slices whose
+ * capacity is exactly the default slice size take their backing storage from the free list of the
+ * current thread and return it there on destruction, instead of going through the general purpose
+ * allocator for every buffer growth. Storage released on a different thread than the one that
+ * allocated it is kept by the releasing thread, so the free lists never need synchronization.
+ *
+ * The free list is disabled by default. It is expected to be configured once during server
+ * initialization, before any worker threads are started.
+ */
+class SliceStorageFreeList {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  // Size of the storage blocks managed by the free list. Matches Slice::default_slice_size_.
+  static constexpr uint64_t StorageSize = 16384;
+
+  // Default maximum number of cached blocks per thread (1MiB of storage).
+  static constexpr uint32_t DefaultMaxEntries = 64;
+
+  /**
+   * Set the maximum number of storage blocks cached per thread. Zero disables the free list.
+   * Blocks already cached beyond the new limit are released lazily as threads allocate and free.
+   */
+  static void setMaxEntries(uint32_t max_entries) {
+    max_entries_.store(max_entries, std::memory_order_relaxed);
+  }
+
+  /**
+   * @return whether slice storage should be allocated from and released to the free list.
+   */
+  static bool enabled() { return max_entries_.load(std::memory_order_relaxed) != 0; }
+
+  /**
+   * @return a storage block of StorageSize bytes, recycled from the current thread's free list if
+   * one is available.
+   */
+  static StoragePtr allocate();
+
+  /**
+   * Return a storage block of StorageSize bytes to the current thread's free list. The block is
+   * freed if the free list is full or disabled.
+   */
+  static void release(StoragePtr&& storage);
+
+  /**
+   * @return the number of blocks cached by the current thread.
+   */
+  static size_t sizeForTest();
+
+  /**
+   * Free all blocks cached by the current thread.
+   */
+  static void clearForTest();
+
+private:
+  static std::atomic<uint32_t> max_entries_;
+};
+
 /**
  * A Slice manages a contiguous block of bytes.
  * The block is arranged like this:
@@ -57,7 +117,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(allocateStorage(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +174,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +200,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    releaseStorage();
     if (releasor_) {
       releasor_();
     }
@@ -365,10 +427,33 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {allocateStorage(slice_size), static_cast<size_t>(slice_size)};
   }
 
 protected:
+  /**
+   * Allocate backing storage of exactly `size` bytes. Default sized storage is taken from the
+   * thread local SliceStorageFreeList when it is enabled.
+   */
+  static StoragePtr allocateStorage(uint64_t size) {
+    if (size == default_slice_size_ && SliceStorageFreeList::enabled()) {
+      return SliceStorageFreeList::allocate();
+    }
+    return StoragePtr{new uint8_t[size]};
+  }
+
+  /**
+   * Release the backing storage owned by this slice, if any. Default sized storage is returned to
+   * the thread local SliceStorageFreeList when it is enabled.
+   */
+  void releaseStorage() {
+    if (storage_ != nullptr && capacity_ == default_slice_size_ &&
+        SliceStorageFreeList::enabled()) {
+      SliceStorageFreeList::release(std::move(storage_));
+    }
+    storage_.reset();
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -398,6 +483,9 @@ protected:
   std::function<void()> releasor_;
 };
 
+static_assert(Slice::default_slice_size_ == SliceStorageFreeList::StorageSize,
+              "slice free list storage size must match the default slice size");
+
 class OwnedImpl;
 
 class SliceDataImpl : public SliceData {
@@ -719,6 +807,14 @@ public:
 
   size_t addFragments(absl::Span<const absl::string_view> fragments) override;
 
+  /**
+   * Replaces the slices referencing immutable memory, such as buffer fragments, with copies owned
+   * by the buffer, so that the memory of every raw slice may be written in place. The number and
+   * the sizes of the raw slices are unchanged. The drain trackers of the replaced slices are called,
+   * as their memory is no longer referenced.
+   */
+  void makeSlicesMutable();
+
 protected:
   static constexpr uint64_t default_read_reservation_size_ =
       Reservation::MAX_SLICES_ * Slice::default_slice_size_;
@@ -767,10 +863,13 @@ private:
 
     OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
+      const bool use_slice_free_list = SliceStorageFreeList::enabled();
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
         if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
+          if (use_slice_free_list) {
+            SliceStorageFreeList::release(std::move(r->mem_));
+          } else if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
           }
         }
@@ -781,7 +880,9 @@ private:
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
 
       Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
+      if (SliceStorageFreeList::enabled()) {
+        storage.mem_ = SliceStorageFreeList::allocate();
+      } else if (!free_list_ref_.empty()) {
         storage.mem_ = std::move(free_list_ref_.back());
         free_list_ref_.pop_back();
       } else {
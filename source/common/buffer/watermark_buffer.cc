@@ -1,7 +1,9 @@
 #include "source/common/buffer/watermark_buffer.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 
@@ -221,13 +223,22 @@ uint64_t WatermarkBufferFactory::resetAccountsGivenPressure(float pressure) {
     }
     ++num_buckets_reset;
 
-    auto it = bucket.begin();
-    while (it != bucket.end() && num_streams_reset < kMaxNumberOfStreamsToResetPerInvocation) {
-      auto next = std::next(it);
-      // This will trigger an erase, which avoids rehashing and invalidates the
-      // iterator *it*. *next* is still valid.
-      (*it)->resetDownstream();
-      it = next;
+    // The accounts of a bucket are within a factor of two of each other, but when only part of
+    // them can be reset the heaviest ones go first. Resetting an account erases it from the
+    // bucket, hence the copy.
+    std::vector<BufferMemoryAccountSharedPtr> accounts(bucket.begin(), bucket.end());
+    const size_t streams_to_reset = std::min<size_t>(
+        accounts.size(), kMaxNumberOfStreamsToResetPerInvocation - num_streams_reset);
+    if (streams_to_reset < accounts.size()) {
+      std::partial_sort(accounts.begin(), accounts.begin() + streams_to_reset, accounts.end(),
+                        [](const BufferMemoryAccountSharedPtr& a,
+                           const BufferMemoryAccountSharedPtr& b) {
+                          return static_cast<const BufferMemoryAccountImpl&>(*a).balance() >
+                                 static_cast<const BufferMemoryAccountImpl&>(*b).balance();
+                        });
+    }
+    for (size_t i = 0; i < streams_to_reset; ++i) {
+      accounts[i]->resetDownstream();
       ++num_streams_reset;
     }
   }
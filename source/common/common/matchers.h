@@ -108,6 +108,7 @@ public:
   const std::string& stringRepresentation() const { return exact_; }
 
 private:
+  friend class StringMatcherImpl;
   const std::string exact_;
   const bool ignore_case_;
 };
@@ -272,6 +273,23 @@ public:
     return false;
   }
 
+  /**
+   * Helps applications optimize the case where a matcher is a case-sensitive
+   * exact-match.
+   *
+   * @param exact the returned exact string
+   * @return true if the matcher is a case-sensitive exact-match.
+   */
+  bool getCaseSensitiveExactMatch(std::string& exact) const {
+    if (const ExactStringMatcher* exact_matcher = absl::get_if<ExactStringMatcher>(&matcher_)) {
+      if (!exact_matcher->ignore_case_) {
+        exact = exact_matcher->exact_;
+        return true;
+      }
+    }
+    return false;
+  }
+
   /**
    * Returns a string representation of the matcher (the contents to be
    * matched).
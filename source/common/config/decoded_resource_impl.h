@@ -4,6 +4,7 @@
 #include "envoy/config/subscription.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/protobuf/utility.h"
 
 #include "xds/core/v3/collection_entry.pb.h"
@@ -80,7 +81,39 @@ public:
     return metadata_.has_value() ? makeOptRef(metadata_.value()) : absl::nullopt;
   }
 
+  absl::optional<uint64_t> contentHash() const override { return content_hash_; }
+
+  /**
+   * @return the hash of the serialized form of a resource, as received from the wire. Unlike
+   *         MessageUtil::hash(), it neither decodes nor serializes it again, so is cheap enough to
+   *         compute for every resource of every update.
+   */
+  static uint64_t contentHashOf(const Protobuf::Any& resource) {
+    return HashUtil::xxHash64(resource.value(), HashUtil::xxHash64(resource.type_url()));
+  }
+
+  /**
+   * @return the resource at another version, with the same content hash. The decoded message is
+   *         shared rather than decoded again.
+   */
+  DecodedResourceImplPtr withVersion(const std::string& version) const {
+    return DecodedResourceImplPtr(new DecodedResourceImpl(*this, version, content_hash_));
+  }
+
+  /**
+   * @return the resource at another version, with the hash of its serialized form. The decoded
+   *         message is shared rather than decoded again.
+   */
+  DecodedResourceImplPtr withVersion(const std::string& version, uint64_t content_hash) const {
+    return DecodedResourceImplPtr(new DecodedResourceImpl(*this, version, content_hash));
+  }
+
 private:
+  DecodedResourceImpl(const DecodedResourceImpl& resource, const std::string& version,
+                      absl::optional<uint64_t> content_hash)
+      : resource_(resource.resource_), has_resource_(resource.has_resource_),
+        name_(resource.name_), aliases_(resource.aliases_), version_(version),
+        ttl_(resource.ttl_), metadata_(resource.metadata_), content_hash_(content_hash) {}
   DecodedResourceImpl(OpaqueResourceDecoder& resource_decoder, absl::optional<std::string> name,
                       const Protobuf::RepeatedPtrField<std::string>& aliases,
                       const Protobuf::Any& resource, bool has_resource, const std::string& version,
@@ -89,9 +122,12 @@ private:
       : resource_(resource_decoder.decodeResource(resource)), has_resource_(has_resource),
         name_(name ? *name : resource_decoder.resourceName(*resource_)),
         aliases_(repeatedPtrFieldToVector(aliases)), version_(version), ttl_(ttl),
-        metadata_(metadata) {}
+        metadata_(metadata),
+        content_hash_(has_resource ? absl::make_optional(contentHashOf(resource))
+                                   : absl::nullopt) {}
 
-  const ProtobufTypes::MessagePtr resource_;
+  // Shared by the resources of the versions returned by withVersion().
+  const std::shared_ptr<const Protobuf::Message> resource_;
   const bool has_resource_;
   const std::string name_;
   const std::vector<std::string> aliases_;
@@ -102,6 +138,11 @@ private:
   // This is the metadata info under the Resource wrapper.
   // It is intended to be consumed in the xds_config_tracker extension.
   const absl::optional<envoy::config::core::v3::Metadata> metadata_;
+
+  // The hash of the serialized resource, computed once when it is decoded so that the consumers
+  // can tell an unchanged resource apart without hashing the decoded message again. Not set for
+  // the resources built from an already decoded message.
+  const absl::optional<uint64_t> content_hash_;
 };
 
 struct DecodedResourcesWrapper {
@@ -1,5 +1,7 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <algorithm>
+
 #include "envoy/server/overload/load_shed_point.h"
 
 #include "source/common/common/assert.h"
@@ -60,6 +62,9 @@ ConnPoolImplBase::ConnPoolImplBase(
       upstream_ready_cb_(dispatcher_.createSchedulableCallback([this]() { onUpstreamReady(); })),
       create_new_connection_load_shed_(overload_manager.getLoadShedPoint(
           Server::LoadShedPointName::get().ConnectionPoolNewConnection)) {
+  if (host_->cluster().adaptivePreconnect()) {
+    adaptive_preconnect_ = std::make_unique<AdaptivePreconnectEstimator>();
+  }
   ENVOY_LOG_ONCE_IF(trace, create_new_connection_load_shed_ == nullptr,
                     "LoadShedPoint envoy.load_shed_points.connection_pool_new_connection is not "
                     "found. Is it configured?");
@@ -161,6 +166,46 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+bool ConnPoolImplBase::shouldPreconnectAdaptively() const {
+  if (adaptive_preconnect_ == nullptr ||
+      host_->coarseHealth() != Upstream::Host::Health::Healthy) {
+    return false;
+  }
+  // As with the preconnect ratios, do not anticipate more than twice the current streams, so
+  // that a burst does not open a burst of connections.
+  const size_t streams = pending_streams_.size() + num_active_streams_;
+  const double anticipated =
+      std::min(adaptive_preconnect_->anticipatedStreams(), 2.0 * (streams + 1));
+  return streams + anticipated > connecting_and_connected_stream_capacity_ + num_active_streams_;
+}
+
+void AdaptivePreconnectEstimator::onStream(MonotonicTime now) {
+  if (last_stream_.has_value()) {
+    // Streams arriving within the same microsecond count as one microsecond apart to keep the
+    // rate finite.
+    const double interval_us = std::max<double>(
+        1, std::chrono::duration_cast<std::chrono::microseconds>(now - *last_stream_).count());
+    stream_interval_us_ = stream_interval_us_ == 0
+                              ? interval_us
+                              : stream_interval_us_ + Alpha * (interval_us - stream_interval_us_);
+  }
+  last_stream_ = now;
+}
+
+void AdaptivePreconnectEstimator::onConnected(std::chrono::milliseconds connect_latency) {
+  const double latency_us = std::chrono::microseconds(connect_latency).count();
+  connect_latency_us_ = connect_latency_us_ == 0
+                            ? latency_us
+                            : connect_latency_us_ + Alpha * (latency_us - connect_latency_us_);
+}
+
+double AdaptivePreconnectEstimator::anticipatedStreams() const {
+  if (stream_interval_us_ == 0) {
+    return 0;
+  }
+  return connect_latency_us_ / stream_interval_us_;
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
   // Somewhat arbitrarily cap the number of connections preconnected due to new
@@ -183,8 +228,12 @@ ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
 ConnPoolImplBase::ConnectionResult
 ConnPoolImplBase::tryCreateNewConnection(float global_preconnect_ratio) {
   // There are already enough Connecting connections for the number of queued streams.
+  bool adaptive = false;
   if (!shouldCreateNewConnection(global_preconnect_ratio)) {
-    return ConnectionResult::ShouldNotConnect;
+    if (global_preconnect_ratio != 0 || !shouldPreconnectAdaptively()) {
+      return ConnectionResult::ShouldNotConnect;
+    }
+    adaptive = true;
   }
   ENVOY_LOG(trace, "creating new preconnect connection");
 
@@ -216,6 +265,9 @@ ConnPoolImplBase::tryCreateNewConnection(float global_preconnect_ratio) {
                   static_cast<uint64_t>(client->currentUnusedCapacity()),
               dumpState());
     ASSERT(client->real_host_description_);
+    if (adaptive) {
+      host_->cluster().trafficStats()->upstream_cx_preconnect_adaptive_.inc();
+    }
     // Increase the connecting capacity to reflect the streams this connection can serve.
     incrConnectingAndConnectedStreamCapacity(client->currentUnusedCapacity(), *client);
     LinkedList::moveIntoList(std::move(client), owningList(client->state()));
@@ -286,6 +338,7 @@ void ConnPoolImplBase::onStreamClosed(Envoy::ConnectionPool::ActiveClient& clien
   host_->stats().rq_active_.dec();
   host_->cluster().trafficStats()->upstream_rq_active_.dec();
   host_->cluster().resourceManager(priority_).requests().dec();
+  client.last_used_ = dispatcher_.timeSource().monotonicTime();
   // We don't update the capacity for HTTP/3 as the stream count should only
   // increase when a MAX_STREAMS frame is received.
   if (trackStreamCapacity()) {
@@ -325,6 +378,10 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(!deferred_deleting_, dumpState());
   assertCapacityCountsAreCorrect();
 
+  if (adaptive_preconnect_ != nullptr) {
+    adaptive_preconnect_->onStream(dispatcher_.timeSource().monotonicTime());
+  }
+
   if (!ready_clients_.empty()) {
     ActiveClient& client = *ready_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing fully connected connection", client);
@@ -473,6 +530,42 @@ void ConnPoolImplBase::closeIdleConnectionsForDrainingPool() {
   }
 }
 
+void ConnPoolImplBase::idleConnectionsLastUsedImpl(std::vector<MonotonicTime>& last_used) const {
+  for (const auto& client : ready_clients_) {
+    if (client->numActiveStreams() == 0) {
+      last_used.push_back(client->last_used_);
+    }
+  }
+}
+
+uint32_t ConnPoolImplBase::closeIdleConnectionsImpl(MonotonicTime last_used_cutoff,
+                                                    uint32_t limit) {
+  Common::AutoDebugRecursionChecker assert_not_in(recursion_checker_);
+
+  // Create a separate list of elements to close to avoid mutate-while-iterating problems.
+  std::vector<ActiveClient*> to_close;
+  for (auto& client : ready_clients_) {
+    if (client->numActiveStreams() == 0 && client->last_used_ <= last_used_cutoff) {
+      to_close.push_back(client.get());
+    }
+  }
+  if (to_close.size() > limit) {
+    std::partial_sort(to_close.begin(), to_close.begin() + limit, to_close.end(),
+                      [](const ActiveClient* a, const ActiveClient* b) {
+                        return a->last_used_ < b->last_used_;
+                      });
+    to_close.resize(limit);
+  }
+
+  for (ActiveClient* client : to_close) {
+    ENVOY_LOG_EVENT(debug, "closing_idle_client",
+                    "closing least recently used idle client {} for cluster {}", client->id(),
+                    host_->cluster().name());
+    client->close();
+  }
+  return to_close.size();
+}
+
 void ConnPoolImplBase::drainClients(std::list<ActiveClientPtr>& clients) {
   while (!clients.empty()) {
     ASSERT(clients.front()->numActiveStreams() > 0u, dumpState());
@@ -647,6 +740,9 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ENVOY_BUG(connecting_stream_capacity_ >= client.currentUnusedCapacity(), dumpState());
     connecting_stream_capacity_ -= client.currentUnusedCapacity();
     client.has_handshake_completed_ = true;
+    if (adaptive_preconnect_ != nullptr) {
+      adaptive_preconnect_->onConnected(client.conn_connect_ms_->elapsed());
+    }
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
     if (client.state() == ActiveClient::State::Connecting ||
@@ -845,7 +941,8 @@ ActiveClient::ActiveClient(ConnPoolImplBase& parent, uint32_t lifetime_stream_li
     : parent_(parent), remaining_streams_(translateZeroToUnlimited(lifetime_stream_limit)),
       configured_stream_limit_(translateZeroToUnlimited(effective_concurrent_streams)),
       concurrent_stream_limit_(translateZeroToUnlimited(concurrent_stream_limit)),
-      connect_timer_(parent_.dispatcher().createTimer([this]() { onConnectTimeout(); })) {
+      connect_timer_(parent_.dispatcher().createTimer([this]() { onConnectTimeout(); })),
+      last_used_(parent_.dispatcher().timeSource().monotonicTime()) {
   conn_connect_ms_ = std::make_unique<Stats::HistogramCompletableTimespanImpl>(
       parent_.host()->cluster().trafficStats()->upstream_cx_connect_ms_,
       parent_.dispatcher().timeSource());
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/common/conn_pool.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection.h"
 #include "envoy/server/overload/overload_manager.h"
@@ -141,6 +142,9 @@ public:
   Stats::TimespanPtr conn_length_;
   Event::TimerPtr connect_timer_;
   Event::TimerPtr connection_duration_timer_;
+  // When the client was created or a stream last closed on it, to close the least recently used
+  // idle clients first.
+  MonotonicTime last_used_;
   bool resources_released_{false};
   bool timed_out_{false};
   // TODO(danzh) remove this once http codec exposes the handshake state for h3.
@@ -178,6 +182,30 @@ using PendingStreamPtr = std::unique_ptr<PendingStream>;
 using ActiveClientPtr = std::unique_ptr<ActiveClient>;
 
 // Base class that handles stream queueing logic shared between connection pool implementations.
+// Estimates how many streams a pool receives while a new connection is being established, from
+// exponentially weighted moving averages of the time between streams and of the connect latency.
+// Used by adaptive preconnect to keep enough capacity for the streams expected before a new
+// connection could serve them.
+class AdaptivePreconnectEstimator {
+public:
+  // The weight of each new sample in the moving averages.
+  static constexpr double Alpha = 0.1;
+
+  // Called when a new stream arrives at the pool.
+  void onStream(MonotonicTime now);
+  // Called when a connection of the pool is established.
+  void onConnected(std::chrono::milliseconds connect_latency);
+
+  // @return the number of streams expected to arrive within one connect latency, or 0 until
+  // both averages have samples.
+  double anticipatedStreams() const;
+
+private:
+  absl::optional<MonotonicTime> last_stream_;
+  double stream_interval_us_{};
+  double connect_latency_us_{};
+};
+
 class ConnPoolImplBase : protected Logger::Loggable<Logger::Id::pool> {
 public:
   ConnPoolImplBase(Upstream::HostConstSharedPtr host, Upstream::ResourcePriority priority,
@@ -243,6 +271,11 @@ public:
   // Closes any idle connections as this pool is drained.
   void closeIdleConnectionsForDrainingPool();
 
+  // Envoy::ConnectionPool::Instance helpers to close the least recently used idle connections
+  // across pools.
+  void idleConnectionsLastUsedImpl(std::vector<MonotonicTime>& last_used) const;
+  uint32_t closeIdleConnectionsImpl(MonotonicTime last_used_cutoff, uint32_t limit);
+
   // Changes the state_ of an ActiveClient and moves to the appropriate list.
   void transitionActiveClientState(ActiveClient& client, ActiveClient::State new_state);
 
@@ -347,6 +380,10 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // A helper function which determines if adaptive preconnect wants another connection for the
+  // streams expected to arrive while it is established.
+  bool shouldPreconnectAdaptively() const;
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -418,6 +455,9 @@ private:
 
   Event::SchedulableCallbackPtr upstream_ready_cb_;
   Common::DebugRecursionChecker recursion_checker_;
+
+  // Set if the cluster enables adaptive preconnect.
+  std::unique_ptr<AdaptivePreconnectEstimator> adaptive_preconnect_;
   Server::LoadShedPoint* create_new_connection_load_shed_{nullptr};
 };
 
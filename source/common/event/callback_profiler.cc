@@ -0,0 +1,104 @@
+#include "source/common/event/callback_profiler.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/thread.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+struct Profile {
+  Thread::MutexBasicLockable mutex_;
+  absl::flat_hash_map<std::string, CallbackProfiler::SourceStats> sources_ ABSL_GUARDED_BY(mutex_);
+};
+
+Profile& profile() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Profile); }
+
+MonotonicTime now() {
+  return std::chrono::steady_clock::now(); // NO_CHECK_FORMAT(real_time)
+}
+
+} // namespace
+
+std::atomic<uint32_t> CallbackProfiler::sample_period_{0};
+ABSL_CONST_INIT thread_local CallbackProfiler::Scope* CallbackProfiler::current_ = nullptr;
+ABSL_CONST_INIT thread_local uint32_t CallbackProfiler::countdown_ = 0;
+
+void CallbackProfiler::setSamplePeriod(uint32_t sample_period) {
+  sample_period_.store(sample_period, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<std::string, CallbackProfiler::SourceStats>>
+CallbackProfiler::topSources(size_t limit) {
+  std::vector<std::pair<std::string, SourceStats>> sources;
+  {
+    Profile& p = profile();
+    Thread::LockGuard lock(p.mutex_);
+    sources.assign(p.sources_.begin(), p.sources_.end());
+  }
+  const size_t size = std::min(limit, sources.size());
+  std::partial_sort(sources.begin(), sources.begin() + size, sources.end(),
+                    [](const auto& lhs, const auto& rhs) {
+                      return lhs.second.total_ > rhs.second.total_ ||
+                             (lhs.second.total_ == rhs.second.total_ && lhs.first < rhs.first);
+                    });
+  sources.resize(size);
+  return sources;
+}
+
+void CallbackProfiler::reset() {
+  Profile& p = profile();
+  Thread::LockGuard lock(p.mutex_);
+  p.sources_.clear();
+}
+
+void CallbackProfiler::record(absl::string_view source, std::chrono::nanoseconds duration) {
+  Profile& p = profile();
+  Thread::LockGuard lock(p.mutex_);
+  SourceStats& stats = p.sources_[source];
+  ++stats.samples_;
+  stats.total_ += duration;
+  stats.max_ = std::max(stats.max_, duration);
+}
+
+void CallbackProfiler::Scope::start(absl::string_view source) {
+  source_ = source;
+  parent_ = current_;
+  current_ = this;
+  active_ = true;
+  start_time_ = now();
+}
+
+void CallbackProfiler::Scope::stop() {
+  const std::chrono::nanoseconds elapsed = now() - start_time_;
+  ASSERT(current_ == this);
+  current_ = parent_;
+  if (parent_ != nullptr) {
+    parent_->children_ += elapsed;
+  }
+  record(source_, std::max(elapsed - children_, std::chrono::nanoseconds::zero()));
+}
+
+void CallbackProfiler::CallbackScope::maybeStart(absl::string_view kind) {
+  if (current_ == nullptr) {
+    if (countdown_ > 1) {
+      --countdown_;
+      return;
+    }
+    countdown_ = samplePeriod();
+    if (countdown_ == 0) {
+      // Profiling was disabled.
+      return;
+    }
+  }
+  start(kind);
+}
+
+} // namespace Event
+} // namespace Envoy
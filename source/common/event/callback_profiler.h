@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/time.h"
+
+#include "absl/base/attributes.h"
+#include "absl/base/optimization.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A process wide sampling profiler attributing the time spent in the callbacks run by dispatchers
+ * to their sources, cheap enough to leave enabled in production.
+ *
+ * When enabled, one in every sample period of the timer, file event and schedulable callbacks run
+ * by each thread is timed. The time of a sampled callback is attributed to the innermost source
+ * tagged with a SourceScope running it, such as an HTTP filter, a cluster update or a DNS
+ * resolution, and the rest to the kind of the callback. Each source is only attributed the time
+ * not attributed to the sources it runs. Unsampled callbacks cost a relaxed atomic load, and
+ * sources outside sampled callbacks a thread local load.
+ */
+class CallbackProfiler {
+public:
+  struct SourceStats {
+    uint64_t samples_{};
+    std::chrono::nanoseconds total_{};
+    std::chrono::nanoseconds max_{};
+  };
+
+  /**
+   * Enables profiling, sampling one in every sample_period callbacks, or disables it if 0.
+   */
+  static void setSamplePeriod(uint32_t sample_period);
+
+  /**
+   * @return the sample period, or 0 if profiling is disabled.
+   */
+  static uint32_t samplePeriod() { return sample_period_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return at most limit sources, by decreasing attributed time.
+   */
+  static std::vector<std::pair<std::string, SourceStats>> topSources(size_t limit);
+
+  /**
+   * Clears the attributed times.
+   */
+  static void reset();
+
+  /**
+   * Times the code running in the scope, if it is in a sampled callback.
+   */
+  class Scope {
+  public:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  protected:
+    Scope() = default;
+    ~Scope() {
+      if (ABSL_PREDICT_FALSE(active_)) {
+        stop();
+      }
+    }
+
+    void start(absl::string_view source);
+
+  private:
+    void stop();
+
+    absl::string_view source_;
+    Scope* parent_{};
+    MonotonicTime start_time_;
+    // The time attributed to the sources run in this scope.
+    std::chrono::nanoseconds children_{};
+    bool active_{};
+  };
+
+  /**
+   * A callback run by a dispatcher, sampled at the sample period unless it is run by a sampled
+   * callback, in which case it is timed as a source.
+   */
+  class CallbackScope : public Scope {
+  public:
+    explicit CallbackScope(absl::string_view kind) {
+      if (ABSL_PREDICT_FALSE(samplePeriod() != 0 || current_ != nullptr)) {
+        maybeStart(kind);
+      }
+    }
+
+  private:
+    void maybeStart(absl::string_view kind);
+  };
+
+  /**
+   * A source of work. The name must outlive the scope.
+   */
+  class SourceScope : public Scope {
+  public:
+    explicit SourceScope(absl::string_view source) {
+      if (ABSL_PREDICT_FALSE(current_ != nullptr)) {
+        start(source);
+      }
+    }
+  };
+
+private:
+  static void record(absl::string_view source, std::chrono::nanoseconds duration);
+
+  static std::atomic<uint32_t> sample_period_;
+  // The innermost timed scope of the thread.
+  ABSL_CONST_INIT static thread_local Scope* current_;
+  // The number of callbacks of the thread to skip before sampling one.
+  ABSL_CONST_INIT static thread_local uint32_t countdown_;
+};
+
+} // namespace Event
+} // namespace Envoy
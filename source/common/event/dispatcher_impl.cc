@@ -18,6 +18,7 @@
 #include "source/common/common/lock_guard.h"
 #include "source/common/common/thread.h"
 #include "source/common/config/utility.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/event/file_event_impl.h"
 #include "source/common/event/libevent_scheduler.h"
 #include "source/common/event/scaled_range_timer_manager_impl.h"
@@ -61,13 +62,15 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                      watermark_factory != nullptr
                          ? watermark_factory
                          : std::make_shared<Buffer::WatermarkBufferFactory>(
-                               api.bootstrap().overload_manager().buffer_factory_config())) {}
+                               api.bootstrap().overload_manager().buffer_factory_config()),
+                     api.bootstrap().lock_free_dispatcher_post_queue()) {}
 
 DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                                TimeSource& time_source, Filesystem::Instance& file_system,
                                Event::TimeSystem& time_system,
                                const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                               const Buffer::WatermarkFactorySharedPtr& watermark_factory)
+                               const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                               bool lock_free_post_queue)
     : name_(name), thread_factory_(thread_factory), time_source_(time_source),
       file_system_(file_system), buffer_factory_(watermark_factory),
       scheduler_(time_system.createScheduler(base_scheduler_, base_scheduler_)),
@@ -76,6 +79,7 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
           [this]() -> void { clearDeferredDeleteList(); })),
       post_cb_(base_scheduler_.createSchedulableCallback([this]() -> void { runPostCallbacks(); })),
+      lock_free_post_queue_(lock_free_post_queue ? std::make_unique<LockFreePostQueue>() : nullptr),
       current_to_delete_(&to_delete_1_), scaled_timer_manager_(scaled_timer_factory(*this)) {
   ASSERT(!name_.empty());
   FatalErrorHandler::registerFatalErrorHandler(*this);
@@ -111,6 +115,17 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
   });
 }
 
+void DispatcherImpl::enableBusyPoll(std::chrono::microseconds max_spin_duration,
+                                    Stats::Scope& scope,
+                                    const absl::optional<std::string>& prefix) {
+  ASSERT(run_tid_.isEmpty(), "busy polling must be enabled before the event loop runs");
+  const std::string stats_prefix =
+      absl::StrCat(prefix.has_value() ? *prefix : absl::StrCat(name_, "."), "dispatcher.");
+  busy_poll_stats_ = std::make_unique<BusyPollStats>(
+      BusyPollStats{ALL_BUSY_POLL_STATS(POOL_COUNTER_PREFIX(scope, stats_prefix))});
+  base_scheduler_.enableBusyPoll(max_spin_duration, time_source_, *busy_poll_stats_);
+}
+
 void DispatcherImpl::clearDeferredDeleteList() {
   ASSERT(isThreadSafe());
   std::vector<DeferredDeletablePtr>* to_delete = current_to_delete_;
@@ -131,6 +146,7 @@ void DispatcherImpl::clearDeferredDeleteList() {
   }
 
   touchWatchdog();
+  CallbackProfiler::CallbackScope profiler_scope("dispatcher.deferred_delete");
   deferred_deleting_ = true;
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
@@ -261,6 +277,13 @@ SignalEventPtr DispatcherImpl::listenForSignal(signal_t signal_num, SignalCb cb)
 }
 
 void DispatcherImpl::post(PostCb callback) {
+  if (lock_free_post_queue_ != nullptr) {
+    if (lock_free_post_queue_->push(std::move(callback))) {
+      post_cb_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
+
   bool do_post;
   {
     Thread::LockGuard lock(post_lock_);
@@ -308,8 +331,10 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
-  {
+  size_t post_callbacks_size;
+  if (lock_free_post_queue_ != nullptr) {
+    post_callbacks_size = lock_free_post_queue_->size();
+  } else {
     Thread::LockGuard lock(post_lock_);
     post_callbacks_size = post_callbacks_.size();
   }
@@ -358,6 +383,13 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
+  if (lock_free_post_queue_ != nullptr) {
+    // Callbacks pushed after this transfer re-arm post_cb_ and execute later in the event loop.
+    LockFreePostQueue::Callbacks callbacks = lock_free_post_queue_->takeAll();
+    runCallbacks(callbacks);
+    return;
+  }
+
   std::list<PostCb> callbacks;
   {
     // Take ownership of the callbacks under the post_lock_. The lock must be released before
@@ -370,10 +402,16 @@ void DispatcherImpl::runPostCallbacks() {
   }
   // It is important that the execution and deletion of the callback happen while post_lock_ is not
   // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
+  runCallbacks(callbacks);
+}
+
+template <class Callbacks> void DispatcherImpl::runCallbacks(Callbacks& callbacks) {
   while (!callbacks.empty()) {
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
+    // Post callbacks are sampled individually, unless they are run by a sampled callback.
+    CallbackProfiler::CallbackScope profiler_scope("dispatcher.post_callback");
     // Run the callback.
     callbacks.front()();
     // Pop the front so that the destructor of the callback that just executed runs before the next
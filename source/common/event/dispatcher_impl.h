@@ -18,6 +18,7 @@
 #include "source/common/common/thread.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
+#include "source/common/event/lock_free_post_queue.h"
 #include "source/common/signal/fatal_error_handler.h"
 
 #include "absl/container/inlined_vector.h"
@@ -43,11 +44,16 @@ public:
   DispatcherImpl(const std::string& name, Api::Api& api, Event::TimeSystem& time_system,
                  const ScaledRangeTimerManagerFactory& scaled_timer_factory,
                  const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+  /**
+   * @param lock_free_post_queue whether the callbacks posted from other threads are queued in a
+   *        LockFreePostQueue rather than in a list guarded by a mutex.
+   */
   DispatcherImpl(const std::string& name, Thread::ThreadFactory& thread_factory,
                  TimeSource& time_source, Filesystem::Instance& file_system,
                  Event::TimeSystem& time_system,
                  const ScaledRangeTimerManagerFactory& scaled_timer_factory,
-                 const Buffer::WatermarkFactorySharedPtr& watermark_factory);
+                 const Buffer::WatermarkFactorySharedPtr& watermark_factory,
+                 bool lock_free_post_queue = false);
   ~DispatcherImpl() override;
 
   /**
@@ -61,6 +67,8 @@ public:
                         std::chrono::milliseconds min_touch_interval) override;
   TimeSource& timeSource() override { return time_source_; }
   void initializeStats(Stats::Scope& scope, const absl::optional<std::string>& prefix) override;
+  void enableBusyPoll(std::chrono::microseconds max_spin_duration, Stats::Scope& scope,
+                      const absl::optional<std::string>& prefix) override;
   void clearDeferredDeleteList() override;
   Network::ServerConnectionPtr
   createServerConnection(Network::ConnectionSocketPtr&& socket,
@@ -128,6 +136,7 @@ private:
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
   void runPostCallbacks();
+  template <class Callbacks> void runCallbacks(Callbacks& callbacks);
   void runThreadLocalDelete();
 
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
@@ -146,6 +155,7 @@ private:
   Filesystem::Instance& file_system_;
   std::string stats_prefix_;
   DispatcherStatsPtr stats_;
+  std::unique_ptr<BusyPollStats> busy_poll_stats_;
   Thread::ThreadId run_tid_;
   Buffer::WatermarkFactorySharedPtr buffer_factory_;
   LibeventScheduler base_scheduler_;
@@ -163,6 +173,8 @@ private:
   SchedulableCallbackPtr post_cb_;
   Thread::MutexBasicLockable post_lock_;
   std::list<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  // Replaces post_lock_ and post_callbacks_ if set.
+  const std::unique_ptr<LockFreePostQueue> lock_free_post_queue_;
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
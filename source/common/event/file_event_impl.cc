@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/event/dispatcher_impl.h"
 
 #include "event2/event.h"
@@ -142,6 +143,7 @@ void FileEventImpl::registerEventIfEmulatedEdge(uint32_t event) {
 
 void FileEventImpl::mergeInjectedEventsAndRunCb(uint32_t events) {
   ASSERT(dispatcher_.isThreadSafe());
+  CallbackProfiler::CallbackScope profiler_scope("dispatcher.file_event");
   if (injected_activation_events_ != 0) {
     events |= injected_activation_events_;
     injected_activation_events_ = 0;
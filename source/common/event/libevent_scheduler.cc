@@ -13,6 +13,10 @@ namespace {
 void recordTimeval(Stats::Histogram& histogram, const timeval& tv) {
   histogram.recordValue(tv.tv_sec * 1000000 + tv.tv_usec);
 }
+
+uint64_t toMicroseconds(MonotonicTime::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
 } // namespace
 
 LibeventScheduler::LibeventScheduler() {
@@ -55,12 +59,63 @@ void LibeventScheduler::run(Dispatcher::RunType mode) {
     // http://www.wangafu.net/~nickm/libevent-book/Ref3_eventloop.html
     break;
   case Dispatcher::RunType::RunUntilExit:
+    if (busy_poll_ != nullptr) {
+      runBusyPoll();
+      return;
+    }
     flag = EVLOOP_NO_EXIT_ON_EMPTY;
     break;
   }
   event_base_loop(libevent_.get(), flag);
 }
 
+void LibeventScheduler::runBusyPoll() {
+  event_base* base = libevent_.get();
+  BusyPoll& busy_poll = *busy_poll_;
+  // The start of the current spin, i.e. the end of the last processing of events.
+  MonotonicTime spin_start = busy_poll.time_source_.monotonicTime();
+  // Whether polls without events were made since spin_start.
+  bool spinning = false;
+  while (true) {
+    const MonotonicTime now = busy_poll.time_source_.monotonicTime();
+    if (now - spin_start < busy_poll.spin_duration_) {
+      busy_poll.found_events_ = false;
+      event_base_loop(base, EVLOOP_NONBLOCK | EVLOOP_ONCE);
+      if (event_base_got_exit(base)) {
+        return;
+      }
+      if (!busy_poll.found_events_) {
+        spinning = true;
+        continue;
+      }
+      if (spinning) {
+        // A blocking poll would have put the thread to sleep until these events.
+        busy_poll.stats_.busy_poll_wakeups_avoided_.inc();
+        busy_poll.stats_.busy_poll_spin_us_.add(toMicroseconds(busy_poll.check_time_ - spin_start));
+        spinning = false;
+      }
+    } else {
+      if (spinning) {
+        busy_poll.stats_.busy_poll_spin_us_.add(toMicroseconds(now - spin_start));
+        spinning = false;
+      }
+      busy_poll.stats_.busy_poll_sleeps_.inc();
+      event_base_loop(base, EVLOOP_ONCE | EVLOOP_NO_EXIT_ON_EMPTY);
+      if (event_base_got_exit(base)) {
+        return;
+      }
+      // Spin less while events are sparse, and fully again as soon as a spin would have avoided
+      // blocking.
+      if (busy_poll.check_time_ - now > busy_poll.max_spin_duration_) {
+        busy_poll.spin_duration_ /= 2;
+      } else {
+        busy_poll.spin_duration_ = busy_poll.max_spin_duration_;
+      }
+    }
+    spin_start = busy_poll.time_source_.monotonicTime();
+  }
+}
+
 void LibeventScheduler::loopExit() { event_base_loopexit(libevent_.get(), nullptr); }
 
 void LibeventScheduler::registerOnPrepareCallback(OnPrepareCallback&& callback) {
@@ -86,6 +141,14 @@ void LibeventScheduler::initializeStats(DispatcherStats* stats) {
   evwatch_check_new(libevent_.get(), &onCheckForStats, this);
 }
 
+void LibeventScheduler::enableBusyPoll(std::chrono::microseconds max_spin_duration,
+                                       TimeSource& time_source, BusyPollStats& stats) {
+  ASSERT(busy_poll_ == nullptr);
+  ASSERT(max_spin_duration > std::chrono::microseconds::zero());
+  busy_poll_ = std::make_unique<BusyPoll>(max_spin_duration, time_source, stats);
+  evwatch_check_new(libevent_.get(), &onCheckForBusyPoll, this);
+}
+
 void LibeventScheduler::onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info*, void* arg) {
   // `self` is `this`, passed in from evwatch_prepare_new.
   auto self = static_cast<LibeventScheduler*>(arg);
@@ -142,5 +205,16 @@ void LibeventScheduler::onCheckForStats(evwatch*, const evwatch_check_cb_info*,
   }
 }
 
+void LibeventScheduler::onCheckForBusyPoll(evwatch*, const evwatch_check_cb_info*, void* arg) {
+  // `self` is `this`, passed in from evwatch_check_new.
+  auto self = static_cast<LibeventScheduler*>(arg);
+  BusyPoll& busy_poll = *self->busy_poll_;
+
+  // The events found by the poll are active until they are processed after this callback.
+  busy_poll.check_time_ = busy_poll.time_source_.monotonicTime();
+  busy_poll.found_events_ =
+      event_base_get_num_events(self->libevent_.get(), EVENT_BASE_COUNT_ACTIVE) > 0;
+}
+
 } // namespace Event
 } // namespace Envoy
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
+#include <memory>
 
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/schedulable_cb.h"
 #include "envoy/event/timer.h"
@@ -109,11 +112,38 @@ public:
    */
   void initializeStats(DispatcherStats* stats);
 
+  /**
+   * Busy polls for events before blocking when running until exit. See
+   * Dispatcher::enableBusyPoll.
+   */
+  void enableBusyPoll(std::chrono::microseconds max_spin_duration, TimeSource& time_source,
+                      BusyPollStats& stats);
+
 private:
+  struct BusyPoll {
+    BusyPoll(std::chrono::microseconds max_spin_duration, TimeSource& time_source,
+             BusyPollStats& stats)
+        : max_spin_duration_(max_spin_duration), time_source_(time_source), stats_(stats),
+          spin_duration_(max_spin_duration) {}
+
+    const std::chrono::microseconds max_spin_duration_;
+    TimeSource& time_source_;
+    BusyPollStats& stats_;
+    // The current spin duration, adapted to the waits of the blocking polls.
+    std::chrono::microseconds spin_duration_;
+    // Whether the last poll found events to process.
+    bool found_events_{};
+    // The time of the last poll.
+    MonotonicTime check_time_;
+  };
+
+  void runBusyPoll();
+
   static void onPrepareForCallback(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onCheckForCallback(evwatch*, const evwatch_check_cb_info* info, void* arg);
   static void onPrepareForStats(evwatch*, const evwatch_prepare_cb_info* info, void* arg);
   static void onCheckForStats(evwatch*, const evwatch_check_cb_info*, void* arg);
+  static void onCheckForBusyPoll(evwatch*, const evwatch_check_cb_info*, void* arg);
 
   static constexpr int flagsBasedOnEventType() {
     if constexpr (Event::PlatformDefaultTriggerType == FileTriggerType::Level) {
@@ -133,6 +163,7 @@ private:
   timeval check_time_{};     // timestamp immediately after polling
   OnPrepareCallback prepare_callback_; // callback to be called from onPrepareForCallback()
   OnCheckCallback check_callback_;     // callback to be called from onCheckForCallback()
+  std::unique_ptr<BusyPoll> busy_poll_; // busy poll state, if busy polling is enabled
 };
 
 } // namespace Event
@@ -0,0 +1,42 @@
+#include "source/common/event/lock_free_post_queue.h"
+
+namespace Envoy {
+namespace Event {
+
+LockFreePostQueue::~LockFreePostQueue() { takeAll(); }
+
+bool LockFreePostQueue::push(PostCb callback) {
+  Node* node = new Node{std::move(callback), head_.load(std::memory_order_relaxed)};
+  // The release ordering publishes the callback to the consumer acquiring the head.
+  while (!head_.compare_exchange_weak(node->next_, node, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+  return node->next_ == nullptr;
+}
+
+LockFreePostQueue::Callbacks LockFreePostQueue::takeAll() {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+  // Reverse the stack into push order.
+  Node* head = nullptr;
+  while (node != nullptr) {
+    Node* next = node->next_;
+    node->next_ = head;
+    head = node;
+    node = next;
+  }
+  return Callbacks(head);
+}
+
+size_t LockFreePostQueue::size() const {
+  // Only the consumer frees the nodes, so the ones reachable from the head stay valid while it
+  // walks them.
+  size_t size = 0;
+  for (const Node* node = head_.load(std::memory_order_acquire); node != nullptr;
+       node = node->next_) {
+    ++size;
+  }
+  return size;
+}
+
+} // namespace Event
+} // namespace Envoy
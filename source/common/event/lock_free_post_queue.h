@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "envoy/event/dispatcher.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A lock free queue of the callbacks posted to a dispatcher: any thread pushes, the dispatcher
+ * thread takes all the queued callbacks at once. Producers push with a compare and swap on the
+ * head of a singly linked stack, and the consumer swaps the whole stack out and reverses it, so
+ * that neither contends on a mutex with the others.
+ */
+class LockFreePostQueue : NonCopyable {
+private:
+  struct Node {
+    PostCb callback_;
+    Node* next_;
+  };
+
+public:
+  /**
+   * The callbacks taken from the queue, in push order.
+   */
+  class Callbacks : NonCopyable {
+  public:
+    Callbacks(Callbacks&& other) noexcept : head_(other.head_) { other.head_ = nullptr; }
+    ~Callbacks() {
+      while (!empty()) {
+        pop_front();
+      }
+    }
+
+    bool empty() const { return head_ == nullptr; }
+    PostCb& front() { return head_->callback_; }
+    void pop_front() {
+      Node* node = head_;
+      head_ = node->next_;
+      delete node;
+    }
+
+  private:
+    friend class LockFreePostQueue;
+    explicit Callbacks(Node* head) : head_(head) {}
+
+    Node* head_;
+  };
+
+  ~LockFreePostQueue();
+
+  /**
+   * Queues a callback. Thread safe.
+   * @return true if the queue was empty, in which case the consumer must be woken up. Pushes to a
+   *         non empty queue do not wake up the consumer again.
+   */
+  bool push(PostCb callback);
+
+  /**
+   * Takes all the queued callbacks. Must only be called by the consumer.
+   */
+  Callbacks takeAll();
+
+  /**
+   * @return the number of queued callbacks, which may already be outdated. Must only be called by
+   *         the consumer, as it walks the queue.
+   */
+  size_t size() const;
+
+private:
+  // The most recently pushed callback first.
+  std::atomic<Node*> head_{nullptr};
+};
+
+} // namespace Event
+} // namespace Envoy
@@ -8,6 +8,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/scope_tracker.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Event {
@@ -34,7 +35,7 @@ class ScaledRangeTimerManagerImpl::RangeTimerImpl final : public Timer {
 public:
   RangeTimerImpl(ScaledTimerMinimum minimum, TimerCb callback, ScaledRangeTimerManagerImpl& manager)
       : minimum_(minimum), manager_(manager), callback_(std::move(callback)),
-        min_duration_timer_(manager.dispatcher_.createTimer([this] { onMinTimerComplete(); })) {}
+        min_duration_timer_(manager.createMinDurationTimer([this] { onMinTimerComplete(); })) {}
 
   ~RangeTimerImpl() override { disableTimer(); }
 
@@ -142,7 +143,8 @@ ScaledRangeTimerManagerImpl::ScaledRangeTimerManagerImpl(
     : dispatcher_(dispatcher),
       timer_minimums_(timer_minimums != nullptr ? timer_minimums
                                                 : std::make_shared<ScaledTimerTypeMap>()),
-      scale_factor_(1.0) {}
+      scale_factor_(1.0), use_timer_wheel_(Runtime::runtimeFeatureEnabled(
+                              "envoy.reloadable_features.scaled_timer_wheel")) {}
 
 ScaledRangeTimerManagerImpl::~ScaledRangeTimerManagerImpl() {
   // Scaled timers created by the manager shouldn't outlive it. This is
@@ -163,6 +165,16 @@ TimerPtr ScaledRangeTimerManagerImpl::createTimer(ScaledTimerMinimum minimum, Ti
   return std::make_unique<RangeTimerImpl>(minimum, callback, *this);
 }
 
+TimerPtr ScaledRangeTimerManagerImpl::createMinDurationTimer(TimerCb callback) {
+  if (!use_timer_wheel_) {
+    return dispatcher_.createTimer(std::move(callback));
+  }
+  if (timer_wheel_ == nullptr) {
+    timer_wheel_ = std::make_unique<TimerWheel>(dispatcher_, TimerWheelTick);
+  }
+  return timer_wheel_->createTimer(std::move(callback));
+}
+
 void ScaledRangeTimerManagerImpl::setScaleFactor(UnitFloat scale_factor) {
   const MonotonicTime now = dispatcher_.approximateMonotonicTime();
   scale_factor_ = scale_factor;
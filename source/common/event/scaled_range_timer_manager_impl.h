@@ -7,6 +7,8 @@
 #include "envoy/event/scaled_range_timer_manager.h"
 #include "envoy/event/timer.h"
 
+#include "source/common/event/timer_wheel.h"
+
 #include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
@@ -20,6 +22,10 @@ namespace Event {
  * expectation is that the number of (max - min) values used to enable timers is small, so the
  * number of queues is tightly bounded. The queue-based implementation depends on that expectation
  * for efficient operation.
+ *
+ * If the scaled_timer_wheel runtime feature is enabled, the min durations are tracked by a timer
+ * wheel shared by all the timers of the manager rather than a real Timer per timer, as scaled
+ * timers are coarse grained idle and stream timeouts that are frequently re-enabled.
  */
 class ScaledRangeTimerManagerImpl : public ScaledRangeTimerManager {
 public:
@@ -33,6 +39,9 @@ public:
   TimerPtr createTimer(ScaledTimerType timer_type, TimerCb callback) override;
   void setScaleFactor(UnitFloat scale_factor) override;
 
+  // The tick of the timer wheel tracking min durations.
+  static constexpr std::chrono::milliseconds TimerWheelTick{10};
+
 private:
   class RangeTimerImpl;
 
@@ -122,10 +131,15 @@ private:
 
   void onQueueTimerFired(Queue& queue);
 
+  TimerPtr createMinDurationTimer(TimerCb callback);
+
   Dispatcher& dispatcher_;
   const ScaledTimerTypeMapConstSharedPtr timer_minimums_;
   UnitFloat scale_factor_;
   absl::flat_hash_set<std::unique_ptr<Queue>, Hash, Eq> queues_;
+  const bool use_timer_wheel_;
+  // Created with the first timer, as the manager is created while its dispatcher is constructed.
+  std::unique_ptr<TimerWheel> timer_wheel_;
 };
 
 } // namespace Event
@@ -1,6 +1,7 @@
 #include "source/common/event/schedulable_cb_impl.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/event/callback_profiler.h"
 
 #include "event2/event.h"
 
@@ -15,6 +16,7 @@ SchedulableCallbackImpl::SchedulableCallbackImpl(Libevent::BasePtr& libevent,
       &raw_event_, libevent.get(),
       [](evutil_socket_t, short, void* arg) -> void {
         SchedulableCallbackImpl* cb = static_cast<SchedulableCallbackImpl*>(arg);
+        CallbackProfiler::CallbackScope profiler_scope("dispatcher.schedulable_callback");
         cb->cb_();
       },
       this);
@@ -3,6 +3,7 @@
 #include <chrono>
 
 #include "source/common/common/assert.h"
+#include "source/common/event/callback_profiler.h"
 
 #include "event2/event.h"
 
@@ -16,6 +17,7 @@ TimerImpl::TimerImpl(Libevent::BasePtr& libevent, TimerCb cb, Dispatcher& dispat
       &raw_event_, libevent.get(),
       [](evutil_socket_t, short, void* arg) -> void {
         TimerImpl* timer = static_cast<TimerImpl*>(arg);
+        CallbackProfiler::CallbackScope profiler_scope("dispatcher.timer");
         if (timer->object_ == nullptr) {
           timer->cb_();
           return;
@@ -0,0 +1,226 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+
+static_assert(TimerWheel::SlotsPerLevel == 64, "occupied slots are tracked in 64 bit masks");
+
+/**
+ * Implementation of Timer kept in the slots of a TimerWheel. A timer is enabled while it is in a
+ * slot, or in the expired timers of the tick being processed.
+ */
+class TimerWheel::WheelTimerImpl final : public Timer {
+public:
+  WheelTimerImpl(TimerWheel& wheel, TimerCb cb) : wheel_(wheel), cb_(std::move(cb)) {
+    ASSERT(cb_);
+  }
+
+  ~WheelTimerImpl() override { disableTimer(); }
+
+  // Timer
+  void disableTimer() override {
+    if (slot_ != nullptr) {
+      wheel_.cancel(*this);
+    }
+    scope_ = nullptr;
+  }
+
+  void enableTimer(std::chrono::milliseconds ms, const ScopeTrackedObject* scope) override {
+    disableTimer();
+    scope_ = scope;
+    wheel_.schedule(*this, ms);
+  }
+
+  void enableHRTimer(std::chrono::microseconds us, const ScopeTrackedObject* scope) override {
+    enableTimer(std::chrono::ceil<std::chrono::milliseconds>(us), scope);
+  }
+
+  bool enabled() override { return slot_ != nullptr; }
+
+  void trigger() {
+    ASSERT(slot_ == nullptr);
+    if (scope_ == nullptr) {
+      cb_();
+      return;
+    }
+    ScopeTrackerScopeState scope(scope_, wheel_.dispatcher_);
+    scope_ = nullptr;
+    cb_();
+  }
+
+  TimerWheel& wheel_;
+  const TimerCb cb_;
+  const ScopeTrackedObject* scope_{};
+  uint64_t expiry_tick_{};
+  // The slot holding the timer, or nullptr if the timer is disabled.
+  Slot* slot_{};
+  uint32_t level_{};
+  uint32_t index_{};
+  Slot::iterator iterator_;
+};
+
+TimerWheel::TimerWheel(Dispatcher& dispatcher, std::chrono::milliseconds tick)
+    : dispatcher_(dispatcher), tick_(tick), start_(dispatcher.approximateMonotonicTime()),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })) {
+  ASSERT(tick > std::chrono::milliseconds::zero());
+}
+
+TimerWheel::~TimerWheel() {
+  // Timers created by the wheel shouldn't outlive it.
+  ASSERT(size_ == 0);
+}
+
+TimerPtr TimerWheel::createTimer(TimerCb cb) {
+  return std::make_unique<WheelTimerImpl>(*this, std::move(cb));
+}
+
+void TimerWheel::schedule(WheelTimerImpl& timer, std::chrono::milliseconds delay) {
+  ASSERT(dispatcher_.isThreadSafe());
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  // Round the expiration up to a tick so that the timer doesn't expire early.
+  const MonotonicTime::duration since_start =
+      std::max(now - start_ + delay, MonotonicTime::duration::zero());
+  timer.expiry_tick_ = (since_start + tick_ - MonotonicTime::duration(1)) / tick_;
+  if (size_ == 0) {
+    // Nothing can expire or move down until now, so there is no need to process the past ticks.
+    next_tick_ = std::max<uint64_t>(next_tick_, (now - start_) / tick_);
+  }
+  insert(timer);
+  ++size_;
+  if (!timer_->enabled() || timer.expiry_tick_ < armed_tick_) {
+    armTimer(std::max(timer.expiry_tick_, next_tick_), now);
+  }
+}
+
+void TimerWheel::cancel(WheelTimerImpl& timer) {
+  ASSERT(dispatcher_.isThreadSafe());
+  timer.slot_->erase(timer.iterator_);
+  if (timer.level_ < Levels && timer.slot_->empty()) {
+    occupied_[timer.level_] &= ~(uint64_t(1) << timer.index_);
+  }
+  timer.slot_ = nullptr;
+  if (--size_ == 0) {
+    timer_->disableTimer();
+  }
+}
+
+void TimerWheel::insert(WheelTimerImpl& timer) {
+  const uint64_t expiry = std::max(timer.expiry_tick_, next_tick_);
+  const uint64_t delta = expiry - next_tick_;
+  uint32_t level = 0;
+  while (level < Levels - 1 && delta >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+    ++level;
+  }
+  // Timers out of range wait in the last slot of the highest level, and are inserted again when it
+  // moves down.
+  const uint64_t slot_tick =
+      std::min(expiry, next_tick_ + (uint64_t(1) << (SlotBits * Levels)) - 1);
+  const uint32_t index = (slot_tick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+  Slot& slot = slots_[level][index];
+  timer.slot_ = &slot;
+  timer.level_ = level;
+  timer.index_ = index;
+  timer.iterator_ = slot.insert(slot.end(), &timer);
+  occupied_[level] |= uint64_t(1) << index;
+}
+
+void TimerWheel::processTick() {
+  const uint64_t tick = next_tick_;
+  // Move the timers of the slots starting at this tick down a level, lowest level first so that
+  // the timers moved from a higher level don't land in a slot which was already moved.
+  for (uint32_t level = 1; level < Levels; ++level) {
+    if ((tick & ((uint64_t(1) << (SlotBits * level)) - 1)) != 0) {
+      break;
+    }
+    const uint32_t index = (tick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+    Slot slot;
+    slot.swap(slots_[level][index]);
+    occupied_[level] &= ~(uint64_t(1) << index);
+    for (WheelTimerImpl* timer : slot) {
+      insert(*timer);
+    }
+  }
+
+  const uint32_t index = tick & (SlotsPerLevel - 1);
+  Slot& slot = slots_[0][index];
+  for (WheelTimerImpl* timer : slot) {
+    timer->slot_ = &expired_;
+    timer->level_ = Levels;
+  }
+  expired_.splice(expired_.end(), slot);
+  occupied_[0] &= ~(uint64_t(1) << index);
+  // Timers enabled by the callbacks expire at the next tick at the earliest.
+  next_tick_ = tick + 1;
+
+  // Triggered callbacks may disable other expired timers.
+  while (!expired_.empty()) {
+    WheelTimerImpl& timer = *expired_.front();
+    expired_.pop_front();
+    timer.slot_ = nullptr;
+    --size_;
+    timer.trigger();
+  }
+}
+
+void TimerWheel::onTimer() {
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  const uint64_t now_tick = (now - start_) / tick_;
+  while (next_tick_ <= now_tick && size_ > 0) {
+    // Skip the ticks at which no slot can expire or move down: with only the lowest `level` levels
+    // empty, slots only move down at multiples of the span of a slot of that level.
+    uint32_t level = 0;
+    while (occupied_[level] == 0) {
+      ++level;
+    }
+    const uint64_t span = uint64_t(1) << (SlotBits * level);
+    const uint64_t next_event = (next_tick_ + span - 1) / span * span;
+    if (next_event > now_tick) {
+      next_tick_ = now_tick + 1;
+      break;
+    }
+    next_tick_ = next_event;
+    processTick();
+  }
+  if (size_ == 0) {
+    next_tick_ = std::max(next_tick_, now_tick + 1);
+  } else {
+    armTimer(nextEventTick(), now);
+  }
+}
+
+void TimerWheel::armTimer(uint64_t tick, MonotonicTime now) {
+  armed_tick_ = tick;
+  const MonotonicTime deadline =
+      start_ + static_cast<MonotonicTime::duration::rep>(tick) * tick_;
+  timer_->enableTimer(deadline > now ? std::chrono::ceil<std::chrono::milliseconds>(deadline - now)
+                                     : std::chrono::milliseconds::zero());
+}
+
+uint64_t TimerWheel::nextEventTick() const {
+  uint64_t next = UINT64_MAX;
+  // Level 0 slots hold the timers expiring at the next SlotsPerLevel ticks.
+  if (occupied_[0] != 0) {
+    next = next_tick_ + absl::countr_zero(absl::rotr(occupied_[0], next_tick_ & 63));
+  }
+  // Timers of higher levels don't expire before their slot moves down.
+  for (uint32_t level = 1; level < Levels; ++level) {
+    if (occupied_[level] == 0) {
+      continue;
+    }
+    const uint32_t shift = SlotBits * level;
+    const uint64_t start = (next_tick_ + (uint64_t(1) << shift) - 1) >> shift;
+    const uint64_t offset = absl::countr_zero(absl::rotr(occupied_[level], start & 63));
+    next = std::min(next, (start + offset) << shift);
+  }
+  return next;
+}
+
+} // namespace Event
+} // namespace Envoy
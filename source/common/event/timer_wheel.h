@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <list>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * A hierarchical timer wheel that drives many coarse grained timers, such as idle and stream
+ * timeouts, from a single dispatcher timer. Time is divided in ticks. Level 0 has a slot per tick
+ * for the next SlotsPerLevel ticks, and each slot of a higher level covers all the slots of the
+ * level below it. Timers are kept in the slot of the lowest level covering their expiration tick,
+ * and move down a level when time reaches the start of their slot, so that enabling, disabling and
+ * expiring a timer take constant time.
+ *
+ * Timers expire up to a tick late so that they never expire early. The backing dispatcher timer is
+ * only armed for the earliest slot that can hold expiring timers.
+ */
+class TimerWheel {
+public:
+  static constexpr uint32_t SlotBits = 6;
+  static constexpr uint32_t SlotsPerLevel = 1 << SlotBits;
+  // The levels cover SlotsPerLevel^Levels ticks. Timers expiring later are kept in the last slot of
+  // the highest level until they are in range.
+  static constexpr uint32_t Levels = 4;
+
+  TimerWheel(Dispatcher& dispatcher, std::chrono::milliseconds tick);
+  ~TimerWheel();
+
+  /**
+   * @return a timer driven by the wheel, which must not outlive the wheel.
+   */
+  TimerPtr createTimer(TimerCb cb);
+
+  /**
+   * @return the number of enabled timers.
+   */
+  uint64_t size() const { return size_; }
+
+private:
+  class WheelTimerImpl;
+  using Slot = std::list<WheelTimerImpl*>;
+
+  void schedule(WheelTimerImpl& timer, std::chrono::milliseconds delay);
+  void cancel(WheelTimerImpl& timer);
+  void insert(WheelTimerImpl& timer);
+  void processTick();
+  void onTimer();
+  void armTimer(uint64_t tick, MonotonicTime now);
+  uint64_t nextEventTick() const;
+
+  Dispatcher& dispatcher_;
+  const MonotonicTime::duration tick_;
+  const MonotonicTime start_;
+  const TimerPtr timer_;
+  // The tick the dispatcher timer is armed for, if it is enabled.
+  uint64_t armed_tick_{};
+  // The next tick to process. Timers expiring at earlier ticks have expired.
+  uint64_t next_tick_{};
+  uint64_t size_{};
+  std::array<std::array<Slot, SlotsPerLevel>, Levels> slots_;
+  // A bit per non-empty slot of each level.
+  std::array<uint64_t, Levels> occupied_{};
+  // The timers of the tick being processed, which have not been triggered yet.
+  Slot expired_;
+};
+
+} // namespace Event
+} // namespace Envoy
@@ -82,6 +82,18 @@ Protobuf::Value HeaderFormatter::formatValue(OptRef<const Http::HeaderMap> heade
   return ValueUtil::stringValue(std::string(val));
 }
 
+bool HeaderFormatter::formatTo(OptRef<const Http::HeaderMap> headers,
+                               FormatterOutput& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  output.addString(
+      SubstitutionFormatUtils::truncateStringView(header->value().getStringView(), max_length_));
+  return true;
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(absl::string_view main_header,
                                                  absl::string_view alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -97,6 +109,11 @@ Protobuf::Value ResponseHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                       FormatterOutput& output) const {
+  return HeaderFormatter::formatTo(context.responseHeaders(), output);
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(absl::string_view main_header,
                                                absl::string_view alternative_header,
                                                absl::optional<size_t> max_length)
@@ -112,6 +129,11 @@ Protobuf::Value RequestHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                      FormatterOutput& output) const {
+  return HeaderFormatter::formatTo(context.requestHeaders(), output);
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(absl::string_view main_header,
                                                    absl::string_view alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -127,6 +149,11 @@ Protobuf::Value ResponseTrailerFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                        FormatterOutput& output) const {
+  return HeaderFormatter::formatTo(context.responseTrailers(), output);
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
@@ -55,6 +55,7 @@ public:
 protected:
   absl::optional<std::string> format(OptRef<const Http::HeaderMap> headers) const;
   Protobuf::Value formatValue(OptRef<const Http::HeaderMap> headers) const;
+  bool formatTo(OptRef<const Http::HeaderMap> headers, FormatterOutput& output) const;
 
 private:
   const Http::HeaderEntry* findHeader(OptRef<const Http::HeaderMap> headers) const;
@@ -99,6 +100,9 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override;
+  bool typedFormatTo() const override { return true; }
 };
 
 /**
@@ -114,6 +118,9 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override;
+  bool typedFormatTo() const override { return true; }
 };
 
 /**
@@ -129,6 +136,9 @@ public:
                                      const StreamInfo::StreamInfo& stream_info) const override;
   Protobuf::Value formatValue(const Context& context,
                               const StreamInfo::StreamInfo& stream_info) const override;
+  bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override;
+  bool typedFormatTo() const override { return true; }
 };
 
 /**
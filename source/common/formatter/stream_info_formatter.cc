@@ -517,6 +517,15 @@ Protobuf::Value CommonDurationFormatter::formatValue(const StreamInfo::StreamInf
   }
   return ValueUtil::numberValue(duration.value());
 }
+bool CommonDurationFormatter::formatTo(const Context&, const StreamInfo::StreamInfo& info,
+                                       FormatterOutput& output) const {
+  auto duration = getDurationCount(info);
+  if (!duration.has_value()) {
+    return false;
+  }
+  output.addUnsignedInteger(duration.value());
+  return true;
+}
 
 // A SystemTime formatter that extracts the startTime from StreamInfo. Must be provided
 // an access log command that starts with `START_TIME`.
@@ -735,6 +744,16 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::optionalStringValue(field_extractor_(stream_info));
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override {
+    const absl::optional<std::string> value = field_extractor_(stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.addString(value.value());
+    return true;
+  }
+  bool typedFormatTo() const override { return true; }
 
 private:
   FieldExtractor field_extractor_;
@@ -768,6 +787,16 @@ public:
 
     return ValueUtil::numberValue(millis.value());
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+    output.addInteger(millis.value());
+    return true;
+  }
+  bool typedFormatTo() const override { return true; }
 
 private:
   absl::optional<int64_t> extractMillis(const StreamInfo::StreamInfo& stream_info) const {
@@ -798,6 +827,12 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override {
+    output.addUnsignedInteger(field_extractor_(stream_info));
+    return true;
+  }
+  bool typedFormatTo() const override { return true; }
 
 private:
   FieldExtractor field_extractor_;
@@ -863,6 +898,30 @@ public:
 
     return ValueUtil::stringValue(toString(*address));
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                FormatterOutput& output) const override {
+    Network::Address::InstanceConstSharedPtr address = field_extractor_(stream_info);
+    if (!address) {
+      return false;
+    }
+
+    // Addresses keep their string representations, which needn't be copied.
+    if (extraction_type_ == StreamInfoAddressFieldExtractionType::WithPort) {
+      output.addString(address->asStringView());
+    } else if (extraction_type_ == StreamInfoAddressFieldExtractionType::WithoutPort &&
+               !mask_prefix_len_.has_value()) {
+      output.addString(address->type() == Network::Address::Type::Ip
+                           ? absl::string_view(address->ip()->addressAsString())
+                           : address->asStringView());
+    } else {
+      output.addString(toString(*address));
+    }
+    return true;
+  }
+  // The port is a number value, or null if the address has none.
+  bool typedFormatTo() const override {
+    return extraction_type_ != StreamInfoAddressFieldExtractionType::JustPort;
+  }
 
 private:
   std::string toString(const Network::Address::Instance& address) const {
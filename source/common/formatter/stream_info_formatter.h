@@ -167,6 +167,11 @@ public:
   absl::optional<std::string> format(const StreamInfo::StreamInfo&) const override;
   Protobuf::Value formatValue(const StreamInfo::StreamInfo&) const override;
 
+  // FormatterProvider
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& info,
+                FormatterOutput& output) const override;
+  bool typedFormatTo() const override { return true; }
+
   static const absl::flat_hash_map<absl::string_view, TimePointGetter> KnownTimePointGetters;
 
 private:
@@ -44,6 +44,9 @@ absl::StatusOr<FormatterPtr> SubstitutionFormatStringUtils::fromProtoConfig(
     RETURN_IF_NOT_OK(data_source_or_error.status());
     return FormatterImpl::create(*data_source_or_error, config.omit_empty_values(), *commands);
   }
+  case envoy::config::core::v3::SubstitutionFormatString::FormatCase::kBinaryFormat:
+    return BinaryFormatterImpl::create(config.binary_format(), config.omit_empty_values(),
+                                       *commands);
   case envoy::config::core::v3::SubstitutionFormatString::FormatCase::FORMAT_NOT_SET:
     PANIC_DUE_TO_PROTO_UNSET;
   }
@@ -1,5 +1,10 @@
 #include "source/common/formatter/substitution_formatter.h"
 
+#include "source/common/common/fmt.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Formatter {
 
@@ -107,6 +112,110 @@ protected:
   OutputBufferType output_buffer_;
 };
 
+// FormatterOutput that appends the values to a text line.
+class StringFormatterOutput : public FormatterOutput {
+public:
+  explicit StringFormatterOutput(std::string& output) : output_(output) {}
+
+  // FormatterOutput
+  void addString(absl::string_view value) override { output_.append(value); }
+  void addInteger(int64_t value) override {
+    const fmt::format_int formatted(value);
+    output_.append(formatted.data(), formatted.size());
+  }
+  void addUnsignedInteger(uint64_t value) override {
+    const fmt::format_int formatted(value);
+    output_.append(formatted.data(), formatted.size());
+  }
+
+protected:
+  std::string& output_;
+};
+
+// FormatterOutput that appends the values to the content of a JSON string, i.e. without quotes.
+class JsonStringContentFormatterOutput : public StringFormatterOutput {
+public:
+  JsonStringContentFormatterOutput(std::string& output, std::string& sanitize_buffer)
+      : StringFormatterOutput(output), sanitize_buffer_(sanitize_buffer) {}
+
+  // FormatterOutput
+  void addString(absl::string_view value) override {
+    output_.append(Json::sanitize(sanitize_buffer_, value));
+  }
+
+private:
+  std::string& sanitize_buffer_;
+};
+
+// FormatterOutput that appends the values as typed JSON values, as Json::Utility would serialize
+// them as Protobuf::Value.
+class JsonValueFormatterOutput : public FormatterOutput {
+public:
+  explicit JsonValueFormatterOutput(JsonStringSerializer& serializer) : serializer_(serializer) {}
+
+  // FormatterOutput
+  void addString(absl::string_view value) override { serializer_.addString(value); }
+  void addInteger(int64_t value) override { serializer_.addNumber(static_cast<double>(value)); }
+  void addUnsignedInteger(uint64_t value) override {
+    serializer_.addNumber(static_cast<double>(value));
+  }
+
+private:
+  JsonStringSerializer& serializer_;
+};
+
+namespace {
+
+void appendVarint(std::string& output, uint64_t value) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+// Protobuf wire types of the fields written by the BinaryFormatterImpl.
+constexpr uint32_t WireTypeVarint = 0;
+constexpr uint32_t WireTypeLengthDelimited = 2;
+
+void appendTag(std::string& output, uint32_t field_number, uint32_t wire_type) {
+  appendVarint(output, (static_cast<uint64_t>(field_number) << 3) | wire_type);
+}
+
+void appendLengthDelimited(std::string& output, uint32_t field_number, absl::string_view value) {
+  appendTag(output, field_number, WireTypeLengthDelimited);
+  appendVarint(output, value.size());
+  output.append(value);
+}
+
+// FormatterOutput that writes the value of a typed provider as a protobuf field, with integers
+// encoded as int64 or uint64 varints and strings as length-delimited bytes.
+class BinaryFieldFormatterOutput : public FormatterOutput {
+public:
+  explicit BinaryFieldFormatterOutput(std::string& output) : output_(output) {}
+
+  void setFieldNumber(uint32_t field_number) { field_number_ = field_number; }
+
+  // FormatterOutput
+  void addString(absl::string_view value) override {
+    appendLengthDelimited(output_, field_number_, value);
+  }
+  void addInteger(int64_t value) override {
+    appendTag(output_, field_number_, WireTypeVarint);
+    appendVarint(output_, static_cast<uint64_t>(value));
+  }
+  void addUnsignedInteger(uint64_t value) override {
+    appendTag(output_, field_number_, WireTypeVarint);
+    appendVarint(output_, value);
+  }
+
+private:
+  std::string& output_;
+  uint32_t field_number_{};
+};
+
+} // namespace
+
 // Helper class to parse the Json format configuration. The class will be used to parse
 // the JSON format configuration and convert it to a list of raw JSON pieces and
 // substitution format template strings. See comments below for more details.
@@ -367,14 +476,12 @@ std::string FormatterImpl::format(const Context& context,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
   log_line.reserve(256);
+  StringFormatterOutput output(log_line);
 
   for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->format(context, stream_info);
     // Add the formatted value if there is one. Otherwise add a default value
     // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
+    if (!provider->formatTo(context, stream_info, output) && !omit_empty_values_) {
       log_line += DefaultUnspecifiedValueStringView;
     }
   }
@@ -385,17 +492,15 @@ std::string FormatterImpl::format(const Context& context,
 void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
                           const StreamInfo::StreamInfo& info, std::string& log_line,
                           std::string& sanitize, bool omit_empty_values) {
+  // The values are sanitized as they are added to the buffer. They will not be quoted since we
+  // handle the quoting by ourselves at the outer level.
+  JsonStringContentFormatterOutput output(log_line, sanitize);
   log_line.push_back('"'); // Start the JSON string.
   for (const JsonFormatterImpl::Formatter& formatter : formatters) {
-    const absl::optional<std::string> value = formatter->format(context, info);
-    if (!value.has_value()) {
+    if (!formatter->formatTo(context, info, output)) {
       // Add the empty value. This needn't be sanitized.
       log_line.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
-      continue;
     }
-    // Sanitize the string value and add it to the buffer. The string value will not be quoted
-    // since we handle the quoting by ourselves at the outer level.
-    log_line.append(Json::sanitize(sanitize, value.value()));
   }
   log_line.push_back('"'); // End the JSON string.
 }
@@ -419,6 +524,8 @@ std::string JsonFormatterImpl::format(const Context& context,
   std::string log_line;
   log_line.reserve(2048);
   std::string sanitize; // Helper to serialize the value to log line.
+  JsonStringSerializer serializer(log_line);
+  JsonValueFormatterOutput value_output(serializer);
 
   for (const ParsedFormatElement& element : parsed_elements_) {
     // 1. Handle the raw string element.
@@ -436,8 +543,14 @@ std::string JsonFormatterImpl::format(const Context& context,
     if (formatters.size() != 1) {
       // 2. Handle the formatter element with multiple or zero providers.
       stringValueToLogLine(formatters, context, info, log_line, sanitize, omit_empty_values_);
-    } else {
+    } else if (formatters[0]->typedFormatTo()) {
       // 3. Handle the formatter element with a single provider and value
+      //    type needs to be kept, for a provider that writes its typed value directly.
+      if (!formatters[0]->formatTo(context, info, value_output)) {
+        serializer.addNull();
+      }
+    } else {
+      // 4. Handle the formatter element with a single provider and value
       //    type needs to be kept.
       const auto value = formatters[0]->formatValue(context, info);
       Json::Utility::appendValueToString(value, log_line);
@@ -448,5 +561,72 @@ std::string JsonFormatterImpl::format(const Context& context,
   return log_line;
 }
 
+absl::StatusOr<std::unique_ptr<BinaryFormatterImpl>>
+BinaryFormatterImpl::create(const envoy::config::core::v3::BinaryFormat& binary_format,
+                            bool omit_empty_values, const CommandParsers& command_parsers) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::unique_ptr<BinaryFormatterImpl>(new BinaryFormatterImpl(
+      creation_status, binary_format, omit_empty_values, command_parsers));
+  RETURN_IF_NOT_OK_REF(creation_status);
+  return ret;
+}
+
+BinaryFormatterImpl::BinaryFormatterImpl(absl::Status& creation_status,
+                                         const envoy::config::core::v3::BinaryFormat& binary_format,
+                                         bool omit_empty_values,
+                                         const CommandParsers& command_parsers)
+    : omit_empty_values_(omit_empty_values) {
+  absl::flat_hash_set<uint32_t> numbers;
+  fields_.reserve(binary_format.fields_size());
+  for (const auto& field : binary_format.fields()) {
+    if (!numbers.insert(field.number()).second) {
+      creation_status = absl::InvalidArgumentError(
+          absl::StrCat("Duplicate field number in binary format: ", field.number()));
+      return;
+    }
+    auto providers_or_error = SubstitutionFormatParser::parse(field.format(), command_parsers);
+    SET_AND_RETURN_IF_NOT_OK(providers_or_error.status(), creation_status);
+    fields_.push_back({field.number(), std::move(*providers_or_error)});
+  }
+}
+
+std::string BinaryFormatterImpl::format(const Context& context,
+                                        const StreamInfo::StreamInfo& info) const {
+  std::string message;
+  message.reserve(512);
+  std::string value; // Helper to build the values of the string fields.
+  BinaryFieldFormatterOutput typed_output(message);
+  StringFormatterOutput string_output(value);
+
+  for (const Field& field : fields_) {
+    if (field.providers_.size() == 1 && field.providers_[0]->typedFormatTo()) {
+      // The field is left out if there is no value.
+      typed_output.setFieldNumber(field.number_);
+      field.providers_[0]->formatTo(context, info, typed_output);
+      continue;
+    }
+
+    value.clear();
+    bool has_value = false;
+    for (const FormatterProviderPtr& provider : field.providers_) {
+      if (provider->formatTo(context, info, string_output)) {
+        has_value = true;
+      } else if (!omit_empty_values_) {
+        value.append(DefaultUnspecifiedValueStringView);
+      }
+    }
+    if (field.providers_.size() == 1 && !has_value) {
+      continue;
+    }
+    appendLengthDelimited(message, field.number_, value);
+  }
+
+  std::string entry;
+  entry.reserve(message.size() + 5);
+  appendVarint(entry, message.size());
+  entry.append(message);
+  return entry;
+}
+
 } // namespace Formatter
 } // namespace Envoy
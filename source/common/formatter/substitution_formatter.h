@@ -9,6 +9,7 @@
 
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/base.pb.h"
+#include "envoy/config/core/v3/substitution_format_string.pb.h"
 #include "envoy/formatter/substitution_formatter.h"
 #include "envoy/stream_info/stream_info.h"
 
@@ -39,6 +40,12 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return str_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                FormatterOutput& output) const override {
+    output.addString(str_.string_value());
+    return true;
+  }
+  bool typedFormatTo() const override { return true; }
 
 private:
   Protobuf::Value str_;
@@ -122,5 +129,37 @@ private:
   std::vector<ParsedFormatElement> parsed_elements_;
 };
 
+/**
+ * Formatter writing each log entry as a protobuf wire format message prefixed with its varint
+ * length, so that a stream of entries can be read back with a schema and the field numbers of the
+ * configuration. The value of a field with a single typed provider is written with its type, i.e.
+ * integers as varints, and the values of other fields are written as strings. A field with a
+ * single provider and no value is left out of the message.
+ */
+class BinaryFormatterImpl : public Formatter {
+public:
+  using CommandParsers = std::vector<CommandParserPtr>;
+
+  static absl::StatusOr<std::unique_ptr<BinaryFormatterImpl>>
+  create(const envoy::config::core::v3::BinaryFormat& binary_format, bool omit_empty_values,
+         const CommandParsers& command_parsers = {});
+
+  // Formatter
+  std::string format(const Context& context, const StreamInfo::StreamInfo& info) const override;
+
+private:
+  struct Field {
+    uint32_t number_;
+    std::vector<FormatterProviderPtr> providers_;
+  };
+
+  BinaryFormatterImpl(absl::Status& creation_status,
+                      const envoy::config::core::v3::BinaryFormat& binary_format,
+                      bool omit_empty_values, const CommandParsers& command_parsers);
+
+  const bool omit_empty_values_;
+  std::vector<Field> fields_;
+};
+
 } // namespace Formatter
 } // namespace Envoy
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
 
 #include "absl/container/fixed_array.h"
 
@@ -36,21 +37,41 @@ absl::Status Decoder::decode(Buffer::Instance& input, std::vector<Frame>& output
   decoding_error_ = false;
   is_frame_oversized_ = false;
   output_ = &output;
+  input_slices_ = input.getRawSlices();
+  input_slice_index_ = 0;
+  input_slice_offset_ = 0;
   inspect(input);
   output_ = nullptr;
+  input_slices_.clear();
 
-  if (decoding_error_) {
-    return absl::InternalError("Grpc decoding error");
-  }
-
-  if (is_frame_oversized_) {
-    return absl::ResourceExhaustedError("Grpc frame length exceeds limit");
+  if (decoding_error_ || is_frame_oversized_) {
+    takePendingData(input, false);
+    return decoding_error_ ? absl::InternalError("Grpc decoding error")
+                           : absl::ResourceExhaustedError("Grpc frame length exceeds limit");
   }
 
+  takePendingData(input, true);
   input.drain(input.length());
   return absl::OkStatus();
 }
 
+void Decoder::takePendingData(Buffer::Instance& input, bool move) {
+  uint64_t taken = 0;
+  for (const PendingData& pending : pending_data_) {
+    if (move) {
+      // Drains the frame headers in front of the data.
+      input.drain(pending.offset_ - taken);
+      pending.frame_data_->move(input, pending.length_);
+      taken = pending.offset_ + pending.length_;
+    } else {
+      auto reservation = pending.frame_data_->reserveSingleSlice(pending.length_);
+      input.copyOut(pending.offset_, pending.length_, reservation.slice().mem_);
+      reservation.commit(pending.length_);
+    }
+  }
+  pending_data_.clear();
+}
+
 bool Decoder::frameStart(uint8_t flags) {
   // Unsupported flags.
   if (flags & ~GRPC_FH_COMPRESSED) {
@@ -66,7 +87,25 @@ void Decoder::frameDataStart() {
   frame_.data_ = std::make_unique<Buffer::OwnedImpl>();
 }
 
-void Decoder::frameData(uint8_t* mem, uint64_t length) { frame_.data_->add(mem, length); }
+void Decoder::frameData(uint8_t* mem, uint64_t length) {
+  // The data is inspected in order, so its slice is the current one or a later one.
+  while (mem < static_cast<uint8_t*>(input_slices_[input_slice_index_].mem_) ||
+         mem >= static_cast<uint8_t*>(input_slices_[input_slice_index_].mem_) +
+                    input_slices_[input_slice_index_].len_) {
+    input_slice_offset_ += input_slices_[input_slice_index_].len_;
+    input_slice_index_++;
+    ASSERT(input_slice_index_ < input_slices_.size());
+  }
+  const uint64_t offset =
+      input_slice_offset_ + (mem - static_cast<uint8_t*>(input_slices_[input_slice_index_].mem_));
+  // Data of a frame spanning contiguous slices is taken at once.
+  if (!pending_data_.empty() && pending_data_.back().frame_data_ == frame_.data_.get() &&
+      pending_data_.back().offset_ + pending_data_.back().length_ == offset) {
+    pending_data_.back().length_ += length;
+    return;
+  }
+  pending_data_.push_back({frame_.data_.get(), offset, length});
+}
 
 void Decoder::frameDataEnd() {
   output_->push_back(std::move(frame_));
@@ -126,6 +126,8 @@ public:
   // decoding succeeded (returns true). If the input is not sufficient to make a
   // complete GRPC data frame, it will be buffered in the decoder. If a decoding
   // error happened, the input buffer remains unchanged.
+  // When decoding succeeded, the slices of the input holding only frame data are
+  // moved to the frames rather than copied.
   // @param input supplies the binary octets wrapped in a GRPC data frame.
   // @param output supplies the buffer to store the decoded data.
   // @return absl::status whether the decoding succeeded or not.
@@ -149,9 +151,27 @@ protected:
   void frameDataEnd() override;
 
 private:
+  // Data of a frame found in the input, which is taken out of it once the input is
+  // fully inspected.
+  struct PendingData {
+    Buffer::Instance* frame_data_;
+    uint64_t offset_;
+    uint64_t length_;
+  };
+
+  // Moves the pending data from the input to their frames, or copies it if the input
+  // must remain unchanged.
+  void takePendingData(Buffer::Instance& input, bool move);
+
   Frame frame_;
   std::vector<Frame>* output_{nullptr};
   bool decoding_error_{false};
+  // The slices of the input being inspected, and the offset in the input of the
+  // slice of the last frame data.
+  Buffer::RawSliceVector input_slices_;
+  size_t input_slice_index_{0};
+  uint64_t input_slice_offset_{0};
+  std::vector<PendingData> pending_data_;
 };
 
 } // namespace Grpc
@@ -1,8 +1,17 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
+#include "absl/strings/string_view.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
 
@@ -49,6 +58,37 @@ inline constexpr std::array<uint32_t, 8> kGenericHeaderNameCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// Header value character table.
+// From RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html#section-5.5:
+//
+// SPELLCHECKER(off)
+// header-field   = field-name ":" OWS field-value OWS
+// field-value    = *field-content
+// field-content  = field-vchar
+//                  [ 1*( SP / HTAB / field-vchar ) field-vchar ]
+// field-vchar    = VCHAR / obs-text
+// obs-text       = %x80-FF
+//
+// VCHAR          =  %x21-7E
+//                   ; visible (printing) characters
+// SPELLCHECKER(on)
+inline constexpr std::array<uint32_t, 8> kGenericHeaderValueCharTable = {
+    // control characters
+    0b00000000010000000000000000000000,
+    // !"#$%&'()*+,-./0123456789:;<=>?
+    0b11111111111111111111111111111111,
+    //@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_
+    0b11111111111111111111111111111111,
+    //`abcdefghijklmnopqrstuvwxyz{|}~
+    0b11111111111111111111111111111110,
+    // extended ascii
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+};
+
+
 // A URI query and fragment character table. From RFC 3986:
 // https://datatracker.ietf.org/doc/html/rfc3986#section-3.4
 //
@@ -72,5 +112,183 @@ inline constexpr std::array<uint32_t, 8> kUriQueryAndFragmentCharTable = {
     0b00000000000000000000000000000000,
 };
 
+/**
+ * @return true if every character of `str` is in `table`. This is the scalar reference for the
+ * vectorized validation functions below.
+ */
+inline bool allCharsInTable(const std::array<uint32_t, 8>& table, absl::string_view str) {
+  bool is_valid = true;
+  for (auto iter = str.begin(); iter != str.end() && is_valid; ++iter) {
+    is_valid &= testCharInTable(table, *iter);
+  }
+  return is_valid;
+}
+
+// Number of characters checked per step by the vectorized validation functions. Zero if no
+// vector instructions are available for the target.
+#if defined(__SSE2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+inline constexpr size_t kCharacterValidationVectorWidth = 16;
+#else
+inline constexpr size_t kCharacterValidationVectorWidth = 0;
+#endif
+
+/**
+ * Vectorized equivalent of allCharsInTable(kGenericHeaderValueCharTable, value). Checks 16
+ * characters per step using SSE2 on x86-64 or NEON on AArch64, which are part of the baseline
+ * instruction set of both, and falls back to the table lookup for the remaining tail.
+ * @return true if every character of `value` is valid in a header field value.
+ */
+inline bool headerValueCharsValid(absl::string_view value) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(value.data());
+  const size_t size = value.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  // A character is invalid if it is a control character other than HTAB, or DEL.
+  const __m128i max_control = _mm_set1_epi8(0x1f);
+  const __m128i htab = _mm_set1_epi8(0x09);
+  const __m128i del = _mm_set1_epi8(0x7f);
+  for (; i + kCharacterValidationVectorWidth <= size; i += kCharacterValidationVectorWidth) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // Unsigned (chars <= 0x1f) computed as (min(chars, 0x1f) == chars).
+    const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chars, max_control), chars);
+    const __m128i invalid = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(chars, htab), control),
+                                         _mm_cmpeq_epi8(chars, del));
+    if (_mm_movemask_epi8(invalid) != 0) {
+      return false;
+    }
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t max_control = vdupq_n_u8(0x1f);
+  const uint8x16_t htab = vdupq_n_u8(0x09);
+  const uint8x16_t del = vdupq_n_u8(0x7f);
+  for (; i + kCharacterValidationVectorWidth <= size; i += kCharacterValidationVectorWidth) {
+    const uint8x16_t chars = vld1q_u8(data + i);
+    const uint8x16_t control = vcleq_u8(chars, max_control);
+    const uint8x16_t invalid =
+        vorrq_u8(vbicq_u8(control, vceqq_u8(chars, htab)), vceqq_u8(chars, del));
+    if (vmaxvq_u8(invalid) != 0) {
+      return false;
+    }
+  }
+#endif
+  return allCharsInTable(kGenericHeaderValueCharTable, value.substr(i));
+}
+
+/**
+ * Find the longest prefix of `name`, in multiples of kCharacterValidationVectorWidth characters,
+ * that consists only of lowercase ASCII letters, digits and '-'. These are the characters that
+ * make up virtually all header names seen in practice, and all of them are valid tchar characters,
+ * so callers only need to validate the remaining characters with their own rules.
+ * @return the length of the prefix. Always zero if no vector instructions are available.
+ */
+inline size_t commonHeaderNameCharsPrefix(absl::string_view name) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(name.data());
+  const size_t size = name.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i lower_a = _mm_set1_epi8('a');
+  const __m128i lower_range = _mm_set1_epi8('z' - 'a');
+  const __m128i digit_0 = _mm_set1_epi8('0');
+  const __m128i digit_range = _mm_set1_epi8('9' - '0');
+  const __m128i dash = _mm_set1_epi8('-');
+  for (; i + kCharacterValidationVectorWidth <= size; i += kCharacterValidationVectorWidth) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // Unsigned range checks: (chars - low) <= (high - low).
+    const __m128i letter_offset = _mm_sub_epi8(chars, lower_a);
+    const __m128i letter =
+        _mm_cmpeq_epi8(_mm_min_epu8(letter_offset, lower_range), letter_offset);
+    const __m128i digit_offset = _mm_sub_epi8(chars, digit_0);
+    const __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(digit_offset, digit_range), digit_offset);
+    const __m128i common =
+        _mm_or_si128(_mm_or_si128(letter, digit), _mm_cmpeq_epi8(chars, dash));
+    if (_mm_movemask_epi8(common) != 0xffff) {
+      break;
+    }
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t lower_a = vdupq_n_u8('a');
+  const uint8x16_t lower_range = vdupq_n_u8('z' - 'a');
+  const uint8x16_t digit_0 = vdupq_n_u8('0');
+  const uint8x16_t digit_range = vdupq_n_u8('9' - '0');
+  const uint8x16_t dash = vdupq_n_u8('-');
+  for (; i + kCharacterValidationVectorWidth <= size; i += kCharacterValidationVectorWidth) {
+    const uint8x16_t chars = vld1q_u8(data + i);
+    const uint8x16_t letter = vcleq_u8(vsubq_u8(chars, lower_a), lower_range);
+    const uint8x16_t digit = vcleq_u8(vsubq_u8(chars, digit_0), digit_range);
+    const uint8x16_t common = vorrq_u8(vorrq_u8(letter, digit), vceqq_u8(chars, dash));
+    if (vminvq_u8(common) == 0) {
+      break;
+    }
+  }
+#endif
+  return i;
+}
+
+/**
+ * Vectorized equivalent of allCharsInTable(kGenericHeaderNameCharTable, name).
+ * @return true if every character of `name` is a valid tchar.
+ */
+inline bool headerNameCharsValid(absl::string_view name) {
+  return allCharsInTable(kGenericHeaderNameCharTable,
+                         name.substr(commonHeaderNameCharsPrefix(name)));
+}
+
+/**
+ * Find the first CR or LF character in `str`. Scans 32 characters per step, as two 16 character
+ * vectors, when vector instructions are available.
+ * @return the position of the first CR or LF character, or absl::string_view::npos if there is
+ * none.
+ */
+inline size_t findCrOrLf(absl::string_view str) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(str.data());
+  const size_t size = str.size();
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  const auto delimiter_mask = [&](size_t offset) -> uint32_t {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, cr), _mm_cmpeq_epi8(chars, lf))));
+  };
+  for (; i + 2 * kCharacterValidationVectorWidth <= size;
+       i += 2 * kCharacterValidationVectorWidth) {
+    const uint32_t mask =
+        delimiter_mask(i) | (delimiter_mask(i + kCharacterValidationVectorWidth) << 16);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  if (i + kCharacterValidationVectorWidth <= size) {
+    const uint32_t mask = delimiter_mask(i);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+    i += kCharacterValidationVectorWidth;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t cr = vdupq_n_u8('\r');
+  const uint8x16_t lf = vdupq_n_u8('\n');
+  const auto delimiters = [&](size_t offset) -> uint8x16_t {
+    const uint8x16_t chars = vld1q_u8(data + offset);
+    return vorrq_u8(vceqq_u8(chars, cr), vceqq_u8(chars, lf));
+  };
+  for (; i + 2 * kCharacterValidationVectorWidth <= size;
+       i += 2 * kCharacterValidationVectorWidth) {
+    if (vmaxvq_u8(vorrq_u8(delimiters(i), delimiters(i + kCharacterValidationVectorWidth))) !=
+        0) {
+      // The exact position is found by the scalar loop below.
+      break;
+    }
+  }
+#endif
+  for (; i < size; ++i) {
+    if (data[i] == '\r' || data[i] == '\n') {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
 } // namespace Http
 } // namespace Envoy
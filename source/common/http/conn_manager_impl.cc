@@ -50,6 +50,7 @@
 #include "source/common/router/config_impl.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
+#include "source/common/stats/utility.h"
 #include "source/common/stream_info/utility.h"
 
 #include "absl/strings/escaping.h"
@@ -70,6 +71,9 @@ const absl::string_view ConnectionManagerImpl::MaxRequestsPerIoCycle =
 // Don't attempt to intelligently delay close: https://github.com/envoyproxy/envoy/issues/30010
 const absl::string_view ConnectionManagerImpl::OptionallyDelayClose =
     "http1.optionally_delay_close";
+// Runtime key for the percentage of the streams whose filters are timed. Defaults to none.
+const absl::string_view ConnectionManagerImpl::FilterInstrumentationSampling =
+    "http.filter_instrumentation_sampling";
 
 bool requestWasConnect(const RequestHeaderMapSharedPtr& headers, Protocol protocol) {
   if (!headers) {
@@ -147,7 +151,9 @@ ConnectionManagerImpl::ConnectionManagerImpl(
       allow_upstream_half_close_(Runtime::runtimeFeatureEnabled(
           "envoy.reloadable_features.allow_multiplexed_upstream_half_close")),
       close_connection_on_zombie_stream_complete_(Runtime::runtimeFeatureEnabled(
-          "envoy.reloadable_features.http1_close_connection_on_zombie_stream_complete")) {
+          "envoy.reloadable_features.http1_close_connection_on_zombie_stream_complete")),
+      route_resolution_cache_enabled_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.connection_route_resolution_cache")) {
   ENVOY_LOG_ONCE_IF(
       trace, accept_new_http_stream_ == nullptr,
       "LoadShedPoint envoy.load_shed_points.http_connection_manager_decode_headers is not "
@@ -358,6 +364,7 @@ void ConnectionManagerImpl::doDeferredStreamDestroy(ActiveStream& stream) {
 
   stream.completeRequest();
   stream.filter_manager_.onStreamComplete();
+  recordFilterTimings(stream);
 
   // For HTTP/3, skip access logging here and add deferred logging info
   // to stream info for QuicStatsGatherer to use later.
@@ -391,6 +398,24 @@ void ConnectionManagerImpl::doDeferredStreamDestroy(ActiveStream& stream) {
   maybeDrainDueToPrematureResets();
 }
 
+void ConnectionManagerImpl::recordFilterTimings(ActiveStream& stream) {
+  stream.filter_manager_.forEachFilterTimings(
+      [this](absl::string_view name, bool encoder, const FilterTimings& timings) {
+        const auto record = [&](absl::string_view stat, std::chrono::nanoseconds time) {
+          Stats::Utility::histogramFromElements(
+              stats_.scope_,
+              {stats_.prefixStatName(), Stats::DynamicName("filter"), Stats::DynamicName(name),
+               Stats::DynamicName(stat)},
+              Stats::Histogram::Unit::Microseconds)
+              .recordValue(std::chrono::duration_cast<std::chrono::microseconds>(time).count());
+        };
+        record(encoder ? "encode_callback_time_us" : "decode_callback_time_us",
+               timings.callback_time_);
+        record(encoder ? "encode_stopped_time_us" : "decode_stopped_time_us",
+               timings.stopped_time_);
+      });
+}
+
 RequestDecoderHandlePtr ConnectionManagerImpl::newStreamHandle(ResponseEncoder& response_encoder,
                                                                bool is_internally_created) {
   RequestDecoder& decoder = newStream(response_encoder, is_internally_created);
@@ -905,6 +930,11 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
   filter_manager_.streamInfo().setShouldSchemeMatchUpstream(
       connection_manager.config_->shouldSchemeMatchUpstream());
 
+  if (connection_manager_.runtime_.snapshot().featureEnabled(
+          ConnectionManagerImpl::FilterInstrumentationSampling, 0)) {
+    filter_manager_.instrumentFilters();
+  }
+
   // TODO(chaoqin-li1123): can this be moved to the on demand filter?
   auto factory = Envoy::Config::Utility::getFactoryByName<RouteConfigUpdateRequesterFactory>(
       kRouteFactoryName);
@@ -987,9 +1017,13 @@ ConnectionManagerImpl::ActiveStream::ActiveStream(ConnectionManagerImpl& connect
 }
 
 void ConnectionManagerImpl::ActiveStream::log(AccessLog::AccessLogType type) {
-  const Formatter::Context log_context{
+  Formatter::Context log_context{
       request_headers_.get(), response_headers_.get(), response_trailers_.get(), {}, type,
       active_span_.get()};
+  // The loggers of the filter chain and of the connection manager using the same format share
+  // the line.
+  Formatter::FormattedLines formatted_lines;
+  log_context.setFormattedLines(formatted_lines);
 
   filter_manager_.log(log_context);
 
@@ -1790,7 +1824,15 @@ void ConnectionManagerImpl::ActiveStream::refreshCachedRoute(const Router::Route
       // NOTE: re-select scope as well in case the scope key header has been changed by a filter.
       snapScopedRouteConfig();
     }
-    if (snapped_route_config_ != nullptr) {
+    if (snapped_route_config_ != nullptr && cb == nullptr &&
+        connection_manager_.route_resolution_cache_enabled_) {
+      if (connection_manager_.route_resolution_cache_ == nullptr) {
+        connection_manager_.route_resolution_cache_ =
+            std::make_unique<Router::RouteResolutionCache>();
+      }
+      route_result = connection_manager_.route_resolution_cache_->route(
+          snapped_route_config_, *request_headers_, filter_manager_.streamInfo(), stream_id_);
+    } else if (snapped_route_config_ != nullptr) {
       route_result = snapped_route_config_->route(cb, *request_headers_,
                                                   filter_manager_.streamInfo(), stream_id_);
     }
@@ -46,6 +46,7 @@
 #include "source/common/http/utility.h"
 #include "source/common/local_reply/local_reply.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
+#include "source/common/router/route_resolution_cache.h"
 #include "source/common/stream_info/stream_info_impl.h"
 #include "source/common/tracing/http_tracer_impl.h"
 
@@ -129,6 +130,7 @@ public:
   static const absl::string_view PrematureResetMinStreamLifetimeSecondsKey;
   static const absl::string_view MaxRequestsPerIoCycle;
   static const absl::string_view OptionallyDelayClose;
+  static const absl::string_view FilterInstrumentationSampling;
 
 private:
   struct ActiveStream;
@@ -591,6 +593,8 @@ private:
    * each filter.
    */
   void doDeferredStreamDestroy(ActiveStream& stream);
+  // Records the filter timings of a stream sampled for filter instrumentation in histograms.
+  void recordFilterTimings(ActiveStream& stream);
 
   /**
    * Process a stream that is ending due to upstream response or reset.
@@ -698,6 +702,10 @@ private:
   // This fixes a potential FD leak where connections with zombie streams in draining state
   // would not be properly closed.
   const bool close_connection_on_zombie_stream_complete_{};
+  // Whether routes resolved for the streams of this connection are cached in
+  // route_resolution_cache_, which is created on first use.
+  const bool route_resolution_cache_enabled_{};
+  std::unique_ptr<Router::RouteResolutionCache> route_resolution_cache_;
 
   // Whether the connection manager is drained due to premature resets.
   bool drained_due_to_premature_resets_{false};
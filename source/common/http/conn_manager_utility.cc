@@ -1,5 +1,6 @@
 #include "source/common/http/conn_manager_utility.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <string>
@@ -24,6 +25,7 @@
 #include "source/common/stream_info/utility.h"
 #include "source/common/tracing/http_tracer_impl.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 
@@ -237,8 +239,10 @@ ConnectionManagerUtility::MutateRequestHeadersResult ConnectionManagerUtility::m
   }
 
   if (config.schemeToSet().has_value()) {
-    request_headers.setScheme(config.schemeToSet().value());
-    request_headers.setForwardedProto(config.schemeToSet().value());
+    // Following setReference() is safe because the scheme is constant for the life of the
+    // listener.
+    request_headers.setReferenceScheme(config.schemeToSet().value());
+    request_headers.setReferenceForwardedProto(config.schemeToSet().value());
   }
 
   // If :scheme is not set, sets :scheme based on X-Forwarded-Proto if a valid scheme,
@@ -248,7 +252,11 @@ ConnectionManagerUtility::MutateRequestHeadersResult ConnectionManagerUtility::m
     request_headers.setScheme(
         getScheme(request_headers.getForwardedProtoValue(), connection.ssl() != nullptr));
   }
-  request_headers.setScheme(absl::AsciiStrToLower(request_headers.getSchemeValue()));
+  // The scheme is almost always lower case already, so only copy it when it is not.
+  if (const absl::string_view scheme = request_headers.getSchemeValue();
+      std::any_of(scheme.begin(), scheme.end(), absl::ascii_isupper)) {
+    request_headers.setScheme(absl::AsciiStrToLower(scheme));
+  }
 
   // At this point we can determine whether this is an internal or external request. The
   // determination of internal status uses the following:
@@ -282,11 +290,11 @@ ConnectionManagerUtility::MutateRequestHeadersResult ConnectionManagerUtility::m
   }
 
   if (config.userAgent()) {
-    request_headers.setEnvoyDownstreamServiceCluster(config.userAgent().value());
+    // Following setReference() calls are safe because user agent is constant for the life of the
+    // listener.
+    request_headers.setReferenceEnvoyDownstreamServiceCluster(config.userAgent().value());
     const HeaderEntry* user_agent_header = request_headers.UserAgent();
     if (!user_agent_header || user_agent_header->value().empty()) {
-      // Following setReference() is safe because user agent is constant for the life of the
-      // listener.
       request_headers.setReferenceUserAgent(config.userAgent().value());
     }
 
@@ -78,6 +78,12 @@ public:
                                          Http::ConnectionPool::Callbacks& callbacks,
                                          const Instance::StreamOptions& options) override;
   bool maybePreconnect(float ratio) override { return maybePreconnectImpl(ratio); }
+  void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const override {
+    idleConnectionsLastUsedImpl(last_used);
+  }
+  uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) override {
+    return closeIdleConnectionsImpl(last_used_cutoff, limit);
+  }
   bool hasActiveConnections() const override;
 
   // Creates a new PendingStream and enqueues it into the queue.
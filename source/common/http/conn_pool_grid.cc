@@ -507,8 +507,35 @@ void ConnectivityGrid::drainConnections(Envoy::ConnectionPool::DrainBehavior dra
 
 Upstream::HostDescriptionConstSharedPtr ConnectivityGrid::host() const { return host_; }
 
-bool ConnectivityGrid::maybePreconnect(float) {
-  return false; // Preconnect not yet supported for the grid.
+bool ConnectivityGrid::maybePreconnect(float preconnect_ratio) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.connectivity_grid_preconnect") ||
+      draining_ || deferred_deleting_) {
+    return false;
+  }
+  // Preconnect the pool new streams would be attempted on first. If the HTTP server properties
+  // cache advertises HTTP/3 for the origin, warm QUIC connections: they resume cached sessions
+  // where possible, so they are ready for early data by the time streams arrive.
+  if (shouldAttemptHttp3() && !getHttp3StatusTracker().hasHttp3FailedRecently()) {
+    return getOrCreateHttp3Pool()->maybePreconnect(preconnect_ratio);
+  }
+  return getOrCreateHttp2Pool()->maybePreconnect(preconnect_ratio);
+}
+
+void ConnectivityGrid::idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const {
+  for (const auto& pool : pools_) {
+    pool->idleConnectionsLastUsed(last_used);
+  }
+}
+
+uint32_t ConnectivityGrid::closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) {
+  uint32_t closed = 0;
+  for (auto& pool : pools_) {
+    if (closed == limit) {
+      break;
+    }
+    closed += pool->closeIdleConnections(last_used_cutoff, limit - closed);
+  }
+  return closed;
 }
 
 bool ConnectivityGrid::isPoolHttp3(const ConnectionPool::Instance& pool) {
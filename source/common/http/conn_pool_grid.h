@@ -207,6 +207,8 @@ public:
   void drainConnections(Envoy::ConnectionPool::DrainBehavior drain_behavior) override;
   Upstream::HostDescriptionConstSharedPtr host() const override;
   bool maybePreconnect(float preconnect_ratio) override;
+  void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const override;
+  uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) override;
   absl::string_view protocolDescription() const override { return "connection grid"; }
 
   // Returns true if pool is the grid's HTTP/3 connection pool.
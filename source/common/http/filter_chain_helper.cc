@@ -18,6 +18,7 @@ namespace Http {
 void FilterChainUtility::createFilterChainForFactories(
     Http::FilterChainFactoryCallbacks& callbacks, const FilterFactoriesList& filter_factories) {
   bool added_missing_config_filter = false;
+  callbacks.reserveFilters(filter_factories.size());
 
   for (const auto& filter_config_provider : filter_factories) {
     absl::string_view filter_config_name = filter_config_provider.provider->name();
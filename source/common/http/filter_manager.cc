@@ -8,12 +8,14 @@
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/scope_tracked_object_stack.h"
 #include "source/common/common/scope_tracker.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/http/codes.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/strings/str_join.h"
 #include "matching/data_impl.h"
 
 namespace Envoy {
@@ -56,6 +58,23 @@ void finalizeHeaders(FilterManagerCallbacks& callbacks, StreamInfo::StreamInfo&
   }
 }
 
+// The filter timings of an instrumented stream, e.g. for %FILTER_STATE(envoy.http.filter_timings)%.
+class FilterTimingsObject : public StreamInfo::FilterState::Object {
+public:
+  explicit FilterTimingsObject(std::string timings) : timings_(std::move(timings)) {}
+
+  ProtobufTypes::MessagePtr serializeAsProto() const override {
+    auto message = std::make_unique<Protobuf::StringValue>();
+    message->set_value(timings_);
+    return message;
+  }
+
+  absl::optional<std::string> serializeAsString() const override { return timings_; }
+
+private:
+  const std::string timings_;
+};
+
 } // namespace
 
 void ActiveStreamFilterBase::commonContinue() {
@@ -155,7 +174,7 @@ bool ActiveStreamFilterBase::commonHandleAfter1xxHeadersCallback(Filter1xxHeader
     continued_1xx_headers_ = true;
     return true;
   case Filter1xxHeadersStatus::StopIteration:
-    iteration_state_ = IterationState::StopSingleIteration;
+    stopIteration(IterationState::StopSingleIteration);
     return false;
   }
 
@@ -169,13 +188,13 @@ bool ActiveStreamFilterBase::commonHandleAfterHeadersCallback(FilterHeadersStatu
 
   switch (status) {
   case FilterHeadersStatus::StopIteration:
-    iteration_state_ = IterationState::StopSingleIteration;
+    stopIteration(IterationState::StopSingleIteration);
     break;
   case FilterHeadersStatus::StopAllIterationAndBuffer:
-    iteration_state_ = IterationState::StopAllBuffer;
+    stopIteration(IterationState::StopAllBuffer);
     break;
   case FilterHeadersStatus::StopAllIterationAndWatermark:
-    iteration_state_ = IterationState::StopAllWatermark;
+    stopIteration(IterationState::StopAllWatermark);
     break;
   case FilterHeadersStatus::ContinueAndDontEndStream:
     end_stream = false;
@@ -225,7 +244,7 @@ bool ActiveStreamFilterBase::commonHandleAfterDataCallback(FilterDataStatus stat
       ASSERT(headers_continued_);
     }
   } else {
-    iteration_state_ = IterationState::StopSingleIteration;
+    stopIteration(IterationState::StopSingleIteration);
     if (status == FilterDataStatus::StopIterationAndBuffer ||
         status == FilterDataStatus::StopIterationAndWatermark) {
       buffer_was_streaming = status == FilterDataStatus::StopIterationAndWatermark;
@@ -258,7 +277,7 @@ bool ActiveStreamFilterBase::commonHandleAfterTrailersCallback(FilterTrailersSta
     }
   } else if (status == FilterTrailersStatus::StopIteration) {
     if (canIterate()) {
-      iteration_state_ = IterationState::StopSingleIteration;
+      stopIteration(IterationState::StopSingleIteration);
     }
     return false;
   }
@@ -397,6 +416,11 @@ Buffer::InstancePtr ActiveStreamDecoderFilter::createBuffer() {
       [this]() -> void { this->requestDataTooLarge(); },
       []() -> void { /* TODO(adisuissa): Handle overflow watermark */ });
   buffer->setWatermarks(parent_.buffer_limit_);
+  if (parent_.account_headers_and_buffers_) {
+    // The bodies created by the filters, e.g. when decompressing them, are not charged by the
+    // codec.
+    buffer->bindAccount(parent_.account_);
+  }
   return buffer;
 }
 
@@ -589,6 +613,8 @@ void FilterManager::decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHead
     if ((*entry)->end_stream_) {
       state_.filter_call_state_ |= FilterCallState::EndOfStream;
     }
+    Event::CallbackProfiler::SourceScope profiler_scope((*entry)->filter_context_.config_name);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
     FilterHeadersStatus status = (*entry)->decodeHeaders(headers, (*entry)->end_stream_);
     state_.filter_call_state_ &= ~FilterCallState::DecodeHeaders;
     if ((*entry)->end_stream_) {
@@ -731,6 +757,12 @@ void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instan
     if ((*entry)->end_stream_) {
       return;
     }
+    // The body chunks not ending the stream go straight past the filters skipping the body, which
+    // have nothing to track for them.
+    if (!end_stream && (*entry)->skipBodyAndTrailers()) {
+      recordLatestDataFilter(entry, state_.latest_data_decoding_filter_, decoder_filters_);
+      continue;
+    }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::DecodeData));
 
     // We check the request_trailers_ pointer here in case addDecodedTrailers
@@ -744,7 +776,11 @@ void FilterManager::decodeData(ActiveStreamDecoderFilter* filter, Buffer::Instan
 
     state_.filter_call_state_ |= FilterCallState::DecodeData;
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.requestTrailers();
-    FilterDataStatus status = (*entry)->handle_->decodeData(data, (*entry)->end_stream_);
+    Event::CallbackProfiler::SourceScope profiler_scope((*entry)->filter_context_.config_name);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
+    FilterDataStatus status = (*entry)->skipBodyAndTrailers()
+                                  ? FilterDataStatus::Continue
+                                  : (*entry)->handle_->decodeData(data, (*entry)->end_stream_);
     if ((*entry)->end_stream_) {
       (*entry)->handle_->decodeComplete();
     }
@@ -851,7 +887,10 @@ void FilterManager::decodeTrailers(ActiveStreamDecoderFilter* filter, RequestTra
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::DecodeTrailers));
     state_.filter_call_state_ |= FilterCallState::DecodeTrailers;
-    FilterTrailersStatus status = (*entry)->handle_->decodeTrailers(trailers);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
+    FilterTrailersStatus status = (*entry)->skipBodyAndTrailers()
+                                      ? FilterTrailersStatus::Continue
+                                      : (*entry)->handle_->decodeTrailers(trailers);
     (*entry)->handle_->decodeComplete();
     (*entry)->end_stream_ = true;
     state_.filter_call_state_ &= ~FilterCallState::DecodeTrailers;
@@ -1259,6 +1298,9 @@ void FilterManager::maybeContinueEncoding(StreamEncoderFilters::Iterator continu
 
 void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHeaderMap& headers,
                                   bool end_stream) {
+  if (filter == nullptr) {
+    chargeAccountForHeaders(headers);
+  }
   // See encodeHeaders() comments in envoy/http/filter.h for why the 1xx precondition holds.
   ASSERT(!CodeUtility::is1xx(Utility::getResponseStatus(headers)) ||
          Utility::getResponseStatus(headers) == enumToInt(Http::Code::SwitchingProtocols));
@@ -1278,6 +1320,8 @@ void FilterManager::encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHea
     if ((*entry)->end_stream_) {
       state_.filter_call_state_ |= FilterCallState::EndOfStream;
     }
+    Event::CallbackProfiler::SourceScope profiler_scope((*entry)->filter_context_.config_name);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
     FilterHeadersStatus status = (*entry)->handle_->encodeHeaders(headers, (*entry)->end_stream_);
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace,
@@ -1455,6 +1499,10 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
     if ((*entry)->end_stream_) {
       return;
     }
+    if (!end_stream && (*entry)->skipBodyAndTrailers()) {
+      recordLatestDataFilter(entry, state_.latest_data_encoding_filter_, encoder_filters_);
+      continue;
+    }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::EncodeData));
 
     // We check the response_trailers_ pointer here in case addEncodedTrailers
@@ -1468,7 +1516,11 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
     recordLatestDataFilter(entry, state_.latest_data_encoding_filter_, encoder_filters_);
 
     (*entry)->end_stream_ = end_stream && !filter_manager_callbacks_.responseTrailers();
-    FilterDataStatus status = (*entry)->handle_->encodeData(data, (*entry)->end_stream_);
+    Event::CallbackProfiler::SourceScope profiler_scope((*entry)->filter_context_.config_name);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
+    FilterDataStatus status = (*entry)->skipBodyAndTrailers()
+                                  ? FilterDataStatus::Continue
+                                  : (*entry)->handle_->encodeData(data, (*entry)->end_stream_);
     if (state_.encoder_filter_chain_aborted_) {
       ENVOY_STREAM_LOG(trace, "encodeData filter iteration aborted due to local reply: filter={}",
                        *this, (*entry)->filter_context_.config_name);
@@ -1510,6 +1562,9 @@ void FilterManager::encodeData(ActiveStreamEncoderFilter* filter, Buffer::Instan
 
 void FilterManager::encodeTrailers(ActiveStreamEncoderFilter* filter,
                                    ResponseTrailerMap& trailers) {
+  if (filter == nullptr) {
+    chargeAccountForHeaders(trailers);
+  }
   filter_manager_callbacks_.resetIdleTimer();
 
   // Filter iteration may start at the current filter.
@@ -1523,7 +1578,10 @@ void FilterManager::encodeTrailers(ActiveStreamEncoderFilter* filter,
     }
     ASSERT(!(state_.filter_call_state_ & FilterCallState::EncodeTrailers));
     state_.filter_call_state_ |= FilterCallState::EncodeTrailers;
-    FilterTrailersStatus status = (*entry)->handle_->encodeTrailers(trailers);
+    FilterCallbackTimer::Scope timer_scope((*entry)->timings_.get());
+    FilterTrailersStatus status = (*entry)->skipBodyAndTrailers()
+                                      ? FilterTrailersStatus::Continue
+                                      : (*entry)->handle_->encodeTrailers(trailers);
     (*entry)->handle_->encodeComplete();
     (*entry)->end_stream_ = true;
     state_.filter_call_state_ &= ~FilterCallState::EncodeTrailers;
@@ -1709,8 +1767,6 @@ FilterManager::createFilterChain(const FilterChainFactory& filter_chain_factory)
     }
   });
 
-  // TODO(wbpcode): reserve memory for filters to avoid frequent reallocation.
-
   OptRef<DownstreamStreamFilterCallbacks> downstream_callbacks =
       filter_manager_callbacks_.downstreamCallbacks();
 
@@ -1812,6 +1868,11 @@ Buffer::InstancePtr ActiveStreamEncoderFilter::createBuffer() {
       [this]() -> void { this->responseDataTooLarge(); },
       []() -> void { /* TODO(adisuissa): Handle overflow watermark */ });
   buffer->setWatermarks(parent_.buffer_limit_);
+  if (parent_.account_headers_and_buffers_) {
+    // The bodies created by the filters, e.g. when decompressing them, are not charged by the
+    // codec.
+    buffer->bindAccount(parent_.account_);
+  }
   return buffer;
 }
 Buffer::InstancePtr& ActiveStreamEncoderFilter::bufferedData() {
@@ -1958,6 +2019,65 @@ bool FilterManager::isTerminalDecoderFilter(const ActiveStreamDecoderFilter& fil
   return !decoder_filters_.entries_.empty() && decoder_filters_.entries_.back().get() == &filter;
 }
 
+void FilterManager::chargeAccountForHeaders(const HeaderMap& headers) {
+  if (!account_headers_and_buffers_ || state_.destroyed_) {
+    return;
+  }
+  const uint64_t size = headers.byteSize();
+  account_->charge(size);
+  account_header_bytes_ += size;
+}
+
+void FilterManager::creditAccountForHeaders() {
+  if (account_header_bytes_ > 0) {
+    account_->credit(account_header_bytes_);
+    account_header_bytes_ = 0;
+  }
+}
+
+void FilterManager::forEachFilterTimings(const FilterTimingsCb& cb) const {
+  for (const auto& filter : decoder_filters_.entries_) {
+    if (filter->timings_ != nullptr) {
+      cb(filter->filter_context_.config_name, false, *filter->timings_);
+    }
+  }
+  for (const auto& filter : encoder_filters_.entries_) {
+    if (filter->timings_ != nullptr) {
+      cb(filter->filter_context_.config_name, true, *filter->timings_);
+    }
+  }
+}
+
+void FilterManager::completeFilterTimings() {
+  // The filters still stopping the iteration, e.g. of a reset stream, stopped it until now.
+  const MonotonicTime now = callback_timer_->now();
+  const auto complete = [now](ActiveStreamFilterBase& filter) {
+    if (filter.timings_ != nullptr && filter.timings_->stopped_since_.has_value()) {
+      filter.timings_->stopped_time_ += now - filter.timings_->stopped_since_.value();
+      filter.timings_->stopped_since_.reset();
+    }
+  };
+  for (auto& filter : decoder_filters_.entries_) {
+    complete(*filter);
+  }
+  for (auto& filter : encoder_filters_.entries_) {
+    complete(*filter);
+  }
+
+  std::vector<std::string> entries;
+  forEachFilterTimings([&](absl::string_view name, bool encoder, const FilterTimings& timings) {
+    entries.push_back(absl::StrCat(
+        name, ":", encoder ? "encode" : "decode", ":",
+        std::chrono::duration_cast<std::chrono::microseconds>(timings.callback_time_).count(), ":",
+        std::chrono::duration_cast<std::chrono::microseconds>(timings.stopped_time_).count()));
+  });
+  if (!streamInfo().filterState()->hasDataWithName(FilterTimingsKey)) {
+    streamInfo().filterState()->setData(
+        FilterTimingsKey, std::make_shared<FilterTimingsObject>(absl::StrJoin(entries, ",")),
+        StreamInfo::FilterState::StateType::ReadOnly, StreamInfo::FilterState::LifeSpan::Request);
+  }
+}
+
 void ActiveStreamFilterBase::resetStream(Http::StreamResetReason reset_reason,
                                          absl::string_view transport_failure_reason) {
   parent_.resetStream(reset_reason, transport_failure_reason);
@@ -99,6 +99,81 @@ struct StreamEncoderFilters {
   std::vector<ActiveStreamEncoderFilterPtr> entries_;
 };
 
+class FilterCallbackTimer;
+
+/**
+ * The time spent by a filter of an instrumented stream in its callbacks, and with the iteration of
+ * the filter chain stopped by it.
+ */
+struct FilterTimings {
+  explicit FilterTimings(FilterCallbackTimer& timer) : timer_(timer) {}
+
+  FilterCallbackTimer& timer_;
+  std::chrono::nanoseconds callback_time_{};
+  std::chrono::nanoseconds stopped_time_{};
+  absl::optional<MonotonicTime> stopped_since_;
+  // The timings of the callback running this one, while it runs.
+  FilterTimings* outer_{};
+};
+
+using FilterTimingsPtr = std::unique_ptr<FilterTimings>;
+
+/**
+ * Times the filter callbacks of a stream sampled for filter instrumentation. Like for the
+ * Event::CallbackProfiler, the time of a callback excludes that of the callbacks of the other
+ * filters it runs, e.g. when it sends a local reply.
+ */
+class FilterCallbackTimer {
+public:
+  explicit FilterCallbackTimer(TimeSource& time_source) : time_source_(time_source) {}
+
+  /**
+   * Times the callback of a filter running in the scope, if the filter is instrumented.
+   */
+  class Scope {
+  public:
+    explicit Scope(FilterTimings* timings) : timings_(timings) {
+      if (timings_ != nullptr) {
+        timings_->timer_.start(*timings_);
+      }
+    }
+    ~Scope() {
+      if (timings_ != nullptr) {
+        timings_->timer_.stop();
+      }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    FilterTimings* const timings_;
+  };
+
+  MonotonicTime now() const { return time_source_.monotonicTime(); }
+
+private:
+  void start(FilterTimings& timings) {
+    const MonotonicTime now = this->now();
+    if (current_ != nullptr) {
+      current_->callback_time_ += now - started_;
+    }
+    timings.outer_ = current_;
+    current_ = &timings;
+    started_ = now;
+  }
+
+  void stop() {
+    const MonotonicTime now = this->now();
+    current_->callback_time_ += now - started_;
+    current_ = std::exchange(current_->outer_, nullptr);
+    started_ = now;
+  }
+
+  TimeSource& time_source_;
+  FilterTimings* current_{};
+  MonotonicTime started_;
+};
+
 /**
  * Base class wrapper for both stream encoder and decoder filters.
  *
@@ -173,6 +248,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
 
   // Functions to set or get iteration state.
   bool canIterate() { return iteration_state_ == IterationState::Continue; }
+  // Whether the body and the trailers are passed on without calling the filter.
+  bool skipBodyAndTrailers() { return skip_body_and_trailers_ && canIterate(); }
   bool stoppedAll() {
     return iteration_state_ == IterationState::StopAllBuffer ||
            iteration_state_ == IterationState::StopAllWatermark;
@@ -180,6 +257,10 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   void allowIteration() {
     ASSERT(iteration_state_ != IterationState::Continue);
     iteration_state_ = IterationState::Continue;
+    if (timings_ != nullptr && timings_->stopped_since_.has_value()) {
+      timings_->stopped_time_ += timings_->timer_.now() - timings_->stopped_since_.value();
+      timings_->stopped_since_.reset();
+    }
   }
   MetadataMapVector* getSavedRequestMetadata() {
     if (saved_request_metadata_ == nullptr) {
@@ -216,10 +297,20 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
     StopAllWatermark,    // Iteration has stopped for all frame types, and following data should
                          // be buffered until high watermark is reached.
   };
+  // Stops the iteration, and starts timing the stop if the filter is instrumented.
+  void stopIteration(IterationState state) {
+    iteration_state_ = state;
+    if (timings_ != nullptr && !timings_->stopped_since_.has_value()) {
+      timings_->stopped_since_ = timings_->timer_.now();
+    }
+  }
+
   FilterManager& parent_;
   IterationState iteration_state_{};
 
   const FilterContext filter_context_;
+  // Only set on the streams sampled for filter instrumentation.
+  FilterTimingsPtr timings_;
 
   // If the filter resumes iteration from a StopAllBuffer/Watermark state, the current filter
   // hasn't parsed data and trailers. As a result, the filter iteration should start with the
@@ -232,6 +323,8 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   bool end_stream_{};
   // If true, the filter has processed headers.
   bool processed_headers_{};
+  // If true, the filter does not need the body and the trailers.
+  bool skip_body_and_trailers_{};
 };
 
 /**
@@ -272,6 +365,7 @@ struct ActiveStreamDecoderFilter : public ActiveStreamFilterBase,
   RequestTrailerMap& addDecodedTrailers() override;
   MetadataMapVector& addDecodedMetadata() override;
   void continueDecoding() override;
+  void skipDecodingBodyAndTrailers() override { skip_body_and_trailers_ = true; }
   const Buffer::Instance* decodingBuffer() override;
 
   void modifyDecodingBuffer(std::function<void(Buffer::Instance&)> callback) override;
@@ -363,6 +457,7 @@ struct ActiveStreamEncoderFilter : public ActiveStreamFilterBase,
   void onEncoderFilterAboveWriteBufferHighWatermark() override;
   void onEncoderFilterBelowWriteBufferLowWatermark() override;
   void continueEncoding() override;
+  void skipEncodingBodyAndTrailers() override { skip_body_and_trailers_ = true; }
   const Buffer::Instance* encodingBuffer() override;
   void modifyEncodingBuffer(std::function<void(Buffer::Instance&)> callback) override;
   void sendLocalReply(Code code, absl::string_view body,
@@ -684,7 +779,12 @@ public:
                 uint64_t buffer_limit)
       : filter_manager_callbacks_(filter_manager_callbacks), dispatcher_(dispatcher),
         connection_(connection), stream_id_(stream_id), account_(std::move(account)),
-        proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit) {}
+        proxy_100_continue_(proxy_100_continue),
+        account_headers_and_buffers_(
+            account_ != nullptr &&
+            Runtime::runtimeFeatureEnabled(
+                "envoy.reloadable_features.account_stream_headers_and_filter_buffers")),
+        buffer_limit_(buffer_limit) {}
 
   ~FilterManager() override {
     ASSERT(state_.destroyed_);
@@ -720,14 +820,43 @@ public:
     for (auto filter : filters_) {
       filter->onStreamComplete();
     }
+    if (callback_timer_ != nullptr) {
+      completeFilterTimings();
+    }
   }
 
+  /**
+   * The name of the filter state object holding the filter timings of an instrumented stream once
+   * it completes, as a list of filter_config_name:decode|encode:callback_us:stopped_us entries.
+   */
+  static constexpr absl::string_view FilterTimingsKey = "envoy.http.filter_timings";
+
+  /**
+   * Instruments the filters added from now on, timing their callbacks and how long they stop the
+   * iteration of the filter chains.
+   */
+  void instrumentFilters() {
+    if (callback_timer_ == nullptr) {
+      callback_timer_ = std::make_unique<FilterCallbackTimer>(dispatcher_.timeSource());
+    }
+  }
+
+  using FilterTimingsCb = std::function<void(absl::string_view filter_config_name, bool encoder,
+                                             const FilterTimings& timings)>;
+
+  /**
+   * Calls a callback with the timings of each instrumented decoder and encoder filter, e.g. to
+   * record them once the stream completes.
+   */
+  void forEachFilterTimings(const FilterTimingsCb& cb) const;
+
   void destroyFilters() {
     state_.destroyed_ = true;
 
     for (auto filter : filters_) {
       filter->onDestroy();
     }
+    creditAccountForHeaders();
   }
 
   /**
@@ -737,6 +866,7 @@ public:
    */
   void decodeHeaders(RequestHeaderMap& headers, bool end_stream) {
     state_.observed_decode_end_stream_ = end_stream;
+    chargeAccountForHeaders(headers);
     decodeHeaders(nullptr, headers, end_stream);
   }
 
@@ -756,6 +886,7 @@ public:
    */
   void decodeTrailers(RequestTrailerMap& trailers) {
     state_.observed_decode_end_stream_ = true;
+    chargeAccountForHeaders(trailers);
     decodeTrailers(nullptr, trailers);
   }
 
@@ -983,11 +1114,20 @@ private:
     FilterChainFactoryCallbacksImpl(FilterManager& manager)
         : manager_(manager), route_(manager_.streamInfo().route()) {}
 
+    void reserveFilters(uint32_t filter_count) override {
+      manager_.filters_.reserve(manager_.filters_.size() + filter_count);
+      manager_.decoder_filters_.entries_.reserve(manager_.decoder_filters_.entries_.size() +
+                                                 filter_count);
+      manager_.encoder_filters_.entries_.reserve(manager_.encoder_filters_.entries_.size() +
+                                                 filter_count);
+    }
+
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
       manager_.decoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamDecoderFilter>(
           manager_, std::move(filter), filter_config_name_));
+      manager_.maybeInstrument(*manager_.decoder_filters_.entries_.back());
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
@@ -995,6 +1135,7 @@ private:
 
       manager_.encoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamEncoderFilter>(
           manager_, std::move(filter), filter_config_name_));
+      manager_.maybeInstrument(*manager_.encoder_filters_.entries_.back());
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
@@ -1004,6 +1145,8 @@ private:
           std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, filter_config_name_));
       manager_.encoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamEncoderFilter>(
           manager_, std::move(filter), filter_config_name_));
+      manager_.maybeInstrument(*manager_.decoder_filters_.entries_.back());
+      manager_.maybeInstrument(*manager_.encoder_filters_.entries_.back());
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -1100,6 +1243,19 @@ private:
 
   bool isTerminalDecoderFilter(const ActiveStreamDecoderFilter& filter) const;
 
+  // Charges the buffer memory account of the stream for the size of headers or trailers entering
+  // the filter chains, as measured then, until the filters are destroyed.
+  void chargeAccountForHeaders(const HeaderMap& headers);
+  void creditAccountForHeaders();
+
+  void maybeInstrument(ActiveStreamFilterBase& filter) {
+    if (callback_timer_ != nullptr) {
+      filter.timings_ = std::make_unique<FilterTimings>(*callback_timer_);
+    }
+  }
+  // Ends the times the filters still stop the iteration, and exposes the timings to access logs.
+  void completeFilterTimings();
+
   FilterManagerCallbacks& filter_manager_callbacks_;
   Event::Dispatcher& dispatcher_;
   // This is unset if there is no downstream connection, e.g. for health check or
@@ -1108,6 +1264,10 @@ private:
   const uint64_t stream_id_;
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
+  // Whether the account is also charged for the headers and trailers of the stream, and the
+  // bodies buffered by its filters.
+  const bool account_headers_and_buffers_;
+  uint64_t account_header_bytes_{0};
 
   StreamDecoderFilters decoder_filters_;
   StreamEncoderFilters encoder_filters_;
@@ -1126,6 +1286,8 @@ private:
   Network::Socket::OptionsSharedPtr upstream_options_ =
       std::make_shared<Network::Socket::Options>();
   std::pair<std::string, bool> upstream_override_host_;
+  // Only set on the streams sampled for filter instrumentation.
+  std::unique_ptr<FilterCallbackTimer> callback_timer_;
 
   // TODO(snowp): Once FM has been moved to its own file we'll make these private classes of FM,
   // at which point they no longer need to be friends.
@@ -10,6 +10,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/empty_string.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/singleton/const_singleton.h"
 
 #include "absl/strings/match.h"
@@ -53,6 +54,11 @@ template <> bool HeaderMapImpl::HeaderList::isPseudoHeader(const LowerCaseString
   return key.get().c_str()[0] == ':';
 }
 
+HeaderMapImpl::HeaderList::HeaderList()
+    : arena_(Runtime::runtimeFeatureEnabled("envoy.reloadable_features.header_map_entry_arena")),
+      headers_(HeaderMapArenaAllocator<HeaderEntryImpl>(arena_)),
+      pseudo_headers_end_(headers_.end()) {}
+
 bool HeaderMapImpl::HeaderList::maybeMakeMap() {
   if (lazy_map_.empty()) {
     if (headers_.size() < kMinHeadersForLazyMap) {
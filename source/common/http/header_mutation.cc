@@ -24,7 +24,14 @@ public:
 
   void evaluateHeaders(Http::HeaderMap& headers, const Formatter::Context& context,
                        const StreamInfo::StreamInfo& stream_info) const override {
-    const std::string value = formatter_->format(context, stream_info);
+    // The literal values, e.g. most of the static headers, are added as configured, without
+    // formatting them to a new string for every request.
+    std::string value_buffer;
+    absl::string_view value = original_value_;
+    if (!literal_value_) {
+      value_buffer = formatter_->format(context, stream_info);
+      value = value_buffer;
+    }
 
     if (!value.empty() || add_if_empty_) {
       switch (append_action_) {
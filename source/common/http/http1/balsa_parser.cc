@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -130,11 +131,9 @@ bool isVersionValid(absl::string_view version_input) {
          version_input[1] == '.' && absl::ascii_isdigit(version_input[2]);
 }
 
-bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
-}
+// kValidCharacters is the tchar set, so this is equivalent to a binary search in
+// kValidCharacters per character, but checks common header names a vector at a time.
+bool isHeaderNameValid(absl::string_view name) { return headerNameCharsValid(name); }
 
 } // anonymous namespace
 
@@ -411,15 +410,17 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
     }
 
     // Remove CR and LF characters to match http-parser behavior.
-    auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    size_t delimiter = findCrOrLf(value);
+    if (delimiter != absl::string_view::npos) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
-      for (char c : value) {
-        if (!is_cr_or_lf(c)) {
-          value_without_cr_or_lf.push_back(c);
-        }
+      absl::string_view remaining = value;
+      while (delimiter != absl::string_view::npos) {
+        value_without_cr_or_lf.append(remaining.data(), delimiter);
+        remaining.remove_prefix(delimiter + 1);
+        delimiter = findCrOrLf(remaining);
       }
+      value_without_cr_or_lf.append(remaining.data(), remaining.size());
       status_ = convertResult(connection_->onHeaderValue(value_without_cr_or_lf.data(),
                                                          value_without_cr_or_lf.length()));
     } else {
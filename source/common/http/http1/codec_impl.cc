@@ -102,6 +102,20 @@ static constexpr absl::string_view LAST_CHUNK = "0\r\n";
 static constexpr absl::string_view SPACE = " ";
 static constexpr absl::string_view COLON_SPACE = ": ";
 
+// Appends the chunk size line for a chunk of `length` bytes, formatting the size in place rather
+// than in a temporary string since this runs for every chunk of every chunk encoded body.
+static void addChunkHeader(Buffer::Instance& buffer, uint64_t length) {
+  static constexpr absl::string_view HexDigits = "0123456789abcdef";
+  char hex[2 * sizeof(uint64_t)];
+  char* const end = hex + sizeof(hex);
+  char* begin = end;
+  do {
+    *--begin = HexDigits[length & 0xf];
+    length >>= 4;
+  } while (length != 0);
+  buffer.addFragments({absl::string_view(begin, end - begin), CRLF});
+}
+
 StreamEncoderImpl::StreamEncoderImpl(ConnectionImpl& connection,
                                      StreamInfo::BytesMeterSharedPtr&& bytes_meter)
     : connection_(connection), disable_chunk_encoding_(false), chunk_encoding_(true),
@@ -248,8 +262,7 @@ void StreamEncoderImpl::encodeData(Buffer::Instance& data, bool end_stream) {
   // actually write the zero length buffer out.
   if (data.length() > 0) {
     if (chunk_encoding_) {
-      std::string chunk_header = absl::StrCat(absl::Hex(data.length()), CRLF);
-      connection_.buffer().add(std::move(chunk_header));
+      addChunkHeader(connection_.buffer(), data.length());
     }
 
     connection_.buffer().move(data);
@@ -109,6 +109,26 @@ const StaticHeaderNameLookup& getStaticHeaderNameLookup() {
   CONSTRUCT_ON_FIRST_USE(StaticHeaderNameLookup);
 }
 
+// Returns the payload length of the next DATA frame sent from `data`, given the largest payload the
+// peer currently accepts. SendDataFrame() moves whole slices of `data` into the connection write
+// buffer but has to copy a slice that straddles the end of the frame, so the frame is shortened to
+// end on a slice boundary when that keeps at least half of `max_length`.
+size_t sliceAlignedDataFrameLength(const Buffer::Instance& data, size_t max_length) {
+  if (data.length() <= max_length) {
+    return data.length();
+  }
+  // Slices are usually at least a few KiB, so a handful covers any DATA frame size in practice.
+  constexpr uint64_t MaxSlicesToScan = 16;
+  size_t aligned_length = 0;
+  for (const Buffer::RawSlice& slice : data.getRawSlices(MaxSlicesToScan)) {
+    if (aligned_length + slice.len_ > max_length) {
+      break;
+    }
+    aligned_length += slice.len_;
+  }
+  return aligned_length >= max_length / 2 ? aligned_length : max_length;
+}
+
 } // namespace
 
 // for nghttp2 compatibility.
@@ -983,8 +1003,10 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       per_stream_buffer_limit_(http2_options.initial_stream_window_size().value()),
       stream_error_on_invalid_http_messaging_(
           http2_options.override_stream_error_on_invalid_http_message().value()),
-      protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
-      random_(random_generator),
+      protocol_constraints_(stats, http2_options),
+      align_data_frames_to_slices_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_align_data_frames_to_slices")),
+      dispatching_(false), raised_goaway_(false), random_(random_generator),
       last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
   if (http2_options.has_use_oghttp2_codec()) {
     use_oghttp2_library_ = http2_options.use_oghttp2_codec().value();
@@ -1841,7 +1863,10 @@ ConnectionImpl::Http2Visitor::OnReadyToSendDataForStream(Http2StreamId stream_id
     stream->data_deferred_ = true;
     return {/*payload_length=*/0, /*end_data=*/false, /*end_stream=*/false};
   }
-  const size_t length = std::min<size_t>(max_length, stream->pending_send_data_->length());
+  const size_t length =
+      connection_->align_data_frames_to_slices_
+          ? sliceAlignedDataFrameLength(*stream->pending_send_data_, max_length)
+          : std::min<size_t>(max_length, stream->pending_send_data_->length());
   bool end_data = false;
   bool end_stream = false;
   if (stream->local_end_stream_ && length == stream->pending_send_data_->length()) {
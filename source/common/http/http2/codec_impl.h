@@ -744,6 +744,9 @@ protected:
   // RST_STREAM.
   bool is_outbound_flood_monitored_control_frame_ = 0;
   ProtocolConstraints protocol_constraints_;
+  // Whether DATA frames are shortened to end on a slice boundary of the pending send data so that
+  // their payload is moved rather than copied into the connection write buffer.
+  const bool align_data_frames_to_slices_;
 
   // For the flood mitigation to work the onSend callback must be called once for each outbound
   // frame. This is what the nghttp2 library is doing, however this is not documented. The
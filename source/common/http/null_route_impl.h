@@ -18,6 +18,8 @@ struct NullHedgePolicy : public Router::HedgePolicy {
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return false; }
+  absl::optional<double> hedgeLatencyPercentile() const override { return absl::nullopt; }
+  double hedgeBudgetRatio() const override { return 0; }
 
   const envoy::type::v3::FractionalPercent additional_request_chance_;
 };
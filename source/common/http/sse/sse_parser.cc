@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <cstdint>
 
+#include "source/common/common/assert.h"
+
 #include "absl/strings/ascii.h"
 #include "absl/strings/string_view.h"
 
@@ -73,9 +75,26 @@ SseParser::ParsedEvent SseParser::parseEvent(absl::string_view event) {
 }
 
 SseParser::FindEventEndResult SseParser::findEventEnd(absl::string_view buffer, bool end_stream) {
-  size_t consumed = 0;
-  size_t event_start = 0;
-  absl::string_view remaining = buffer;
+  ScanState scan_state;
+  return findEventEnd(buffer, end_stream, scan_state);
+}
+
+SseParser::FindEventEndResult SseParser::EventFinder::findEventEnd(absl::string_view buffer,
+                                                                   bool end_stream) {
+  ASSERT(scan_state_.consumed <= buffer.size());
+  const FindEventEndResult result = SseParser::findEventEnd(buffer, end_stream, scan_state_);
+  if (result.event_start != absl::string_view::npos) {
+    // The buffer of the next call starts at the next event.
+    reset();
+  }
+  return result;
+}
+
+SseParser::FindEventEndResult SseParser::findEventEnd(absl::string_view buffer, bool end_stream,
+                                                      ScanState& scan_state) {
+  size_t consumed = scan_state.consumed;
+  size_t event_start = scan_state.event_start;
+  absl::string_view remaining = buffer.substr(consumed);
 
   // Per SSE spec: Strip UTF-8 BOM (0xEF 0xBB 0xBF) if present at stream start.
   if (consumed == 0 && remaining.size() >= 3 && static_cast<uint8_t>(remaining[0]) == 0xEF &&
@@ -89,6 +108,8 @@ SseParser::FindEventEndResult SseParser::findEventEnd(absl::string_view buffer,
     auto [line_end, next_line] = findLineEnd(remaining, end_stream);
 
     if (line_end == absl::string_view::npos) {
+      // Resumes from the incomplete line once more data is received.
+      scan_state = {event_start, consumed};
       return {absl::string_view::npos, absl::string_view::npos, absl::string_view::npos};
     }
 
@@ -101,6 +122,8 @@ SseParser::FindEventEndResult SseParser::findEventEnd(absl::string_view buffer,
     remaining = remaining.substr(next_line);
   }
 
+  scan_state = {event_start, consumed};
+
   // Per SSE spec: Once the end of the file is reached, any pending data must be discarded.
   // (i.e., incomplete events without a closing blank line are dropped)
   return {absl::string_view::npos, absl::string_view::npos, absl::string_view::npos};
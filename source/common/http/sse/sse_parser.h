@@ -94,6 +94,43 @@ public:
   static FindEventEndResult findEventEnd(absl::string_view buffer, bool end_stream);
 
 private:
+  // Where the scan of an incomplete event stopped.
+  struct ScanState {
+    // Where the event content begins, as in FindEventEndResult.
+    size_t event_start{};
+    // The size of the complete lines scanned, including the BOM if present.
+    size_t consumed{};
+  };
+
+public:
+  /**
+   * Finds the end of the next SSE event in a buffer growing across calls, without scanning again
+   * the complete lines of an event already scanned by the previous calls. This keeps the cost of
+   * the events received in many chunks linear in their size.
+   *
+   * The buffer of each call must start where the buffer of the previous call starts, or where its
+   * next event starts if it found one. reset() must be called to pass any other buffer.
+   */
+  class EventFinder {
+  public:
+    /**
+     * Same as SseParser::findEventEnd().
+     */
+    FindEventEndResult findEventEnd(absl::string_view buffer, bool end_stream);
+
+    /**
+     * Forgets the lines scanned by the previous calls.
+     */
+    void reset() { scan_state_ = {}; }
+
+  private:
+    ScanState scan_state_;
+  };
+
+private:
+  static FindEventEndResult findEventEnd(absl::string_view buffer, bool end_stream,
+                                         ScanState& scan_state);
+
   /**
    * Parses an SSE field line into {field_name, field_value}.
    * Handles comments (lines starting with ':') and strips leading space from value.
@@ -2,9 +2,69 @@
 
 #include <sys/eventfd.h>
 
+#include <utility>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/lock_guard.h"
+
 namespace Envoy {
 namespace Io {
 
+ProvidedBufferRing::ProvidedBufferRing(struct io_uring_buf_ring* ring, uint32_t count,
+                                       uint32_t size)
+    : ring_(ring), count_(count), size_(size),
+      memory_(std::make_unique<uint8_t[]>(size_t(count) * size)),
+      thread_id_(std::this_thread::get_id()) {
+  for (uint32_t i = 0; i < count_; ++i) {
+    add(i, i);
+  }
+  io_uring_buf_ring_advance(ring_, count_);
+}
+
+void ProvidedBufferRing::add(uint16_t buffer_id, int offset) {
+  io_uring_buf_ring_add(ring_, buffer(buffer_id), size_, buffer_id,
+                        io_uring_buf_ring_mask(count_), offset);
+}
+
+void ProvidedBufferRing::release(uint16_t buffer_id) {
+  if (std::this_thread::get_id() == thread_id_) {
+    // The ring is only freed on its own thread, so there is no race with detach().
+    if (ring_ != nullptr) {
+      add(buffer_id, 0);
+      io_uring_buf_ring_advance(ring_, 1);
+    }
+    return;
+  }
+  Thread::LockGuard lock(mutex_);
+  if (!detached_) {
+    released_.push_back(buffer_id);
+  }
+}
+
+void ProvidedBufferRing::flushReleased() {
+  ASSERT(std::this_thread::get_id() == thread_id_);
+  std::vector<uint16_t> released;
+  {
+    Thread::LockGuard lock(mutex_);
+    released.swap(released_);
+  }
+  if (released.empty()) {
+    return;
+  }
+  for (size_t i = 0; i < released.size(); ++i) {
+    add(released[i], i);
+  }
+  io_uring_buf_ring_advance(ring_, released.size());
+}
+
+struct io_uring_buf_ring* ProvidedBufferRing::detach() {
+  ASSERT(std::this_thread::get_id() == thread_id_);
+  Thread::LockGuard lock(mutex_);
+  detached_ = true;
+  released_.clear();
+  return std::exchange(ring_, nullptr);
+}
+
 bool isIoUringSupported() {
   struct io_uring_params p {};
   struct io_uring ring;
@@ -30,7 +90,13 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  if (provided_buffers_ != nullptr) {
+    io_uring_free_buf_ring(&ring_, provided_buffers_->detach(), provided_buffers_->count(),
+                           ProvidedBufferGroup);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -65,11 +131,24 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
     }
   }
 
+  if (provided_buffers_ != nullptr) {
+    provided_buffers_->flushReleased();
+  }
+
   unsigned count = io_uring_peek_batch_cqe(&ring_, cqes_.data(), cqes_.size());
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    if (req != nullptr) {
+      req->setCompletionDetails((cqe->flags & IORING_CQE_F_MORE) != 0,
+                                (cqe->flags & IORING_CQE_F_BUFFER) != 0
+                                    ? absl::make_optional(static_cast<uint16_t>(
+                                          cqe->flags >> IORING_CQE_BUFFER_SHIFT))
+                                    : absl::nullopt,
+                                (cqe->flags & IORING_CQE_F_NOTIF) != 0);
+    }
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -121,6 +200,53 @@ IoUringResult IoUringImpl::prepareConnect(os_fd_t fd,
   return IoUringResult::Ok;
 }
 
+bool IoUringImpl::setupProvidedBuffers(uint32_t count, uint32_t size) {
+  ASSERT(provided_buffers_ == nullptr);
+  int ret = 0;
+  struct io_uring_buf_ring* ring =
+      io_uring_setup_buf_ring(&ring_, count, ProvidedBufferGroup, 0, &ret);
+  if (ring == nullptr) {
+    ENVOY_LOG(debug, "unable to set up provided buffer ring: {}", errorDetails(-ret));
+    return false;
+  }
+  provided_buffers_ = std::make_shared<ProvidedBufferRing>(ring, count, size);
+  return true;
+}
+
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}", fd);
+  ASSERT(provided_buffers_ != nullptr);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = ProvidedBufferGroup;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
+Buffer::BufferFragment* IoUringImpl::takeProvidedBuffer(uint16_t buffer_id, uint32_t length) {
+  ASSERT(provided_buffers_ != nullptr);
+  ASSERT(length <= provided_buffers_->size());
+  return new Buffer::BufferFragmentImpl(
+      provided_buffers_->buffer(buffer_id), length,
+      [provided_buffers = provided_buffers_, buffer_id](
+          const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+        provided_buffers->release(buffer_id);
+        delete this_fragment;
+      });
+}
+
+void IoUringImpl::returnProvidedBuffer(uint16_t buffer_id) {
+  ASSERT(provided_buffers_ != nullptr);
+  provided_buffers_->release(buffer_id);
+}
+
 IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                         off_t offset, Request* user_data) {
   ENVOY_LOG(trace, "prepare readv for fd = {}", fd);
@@ -151,6 +277,31 @@ IoUringResult IoUringImpl::prepareWritev(os_fd_t fd, const struct iovec* iovecs,
   return IoUringResult::Ok;
 }
 
+bool IoUringImpl::isZeroCopySendSupported() {
+  struct io_uring_probe* probe = io_uring_get_probe_ring(&ring_);
+  if (probe == nullptr) {
+    return false;
+  }
+  const bool supported = io_uring_opcode_supported(probe, IORING_OP_SENDMSG_ZC);
+  io_uring_free_probe(probe);
+  return supported;
+}
+
+IoUringResult IoUringImpl::prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                                  Request* user_data) {
+  ENVOY_LOG(trace, "prepare zero copy sendmsg for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_sendmsg_zc(sqe, fd, msg, MSG_NOSIGNAL);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareClose(os_fd_t fd, Request* user_data) {
   ENVOY_LOG(trace, "prepare close for fd = {}", fd);
   // TODO (soulxu): Handling the case of CQ ring is overflow.
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "envoy/common/io/io_uring.h"
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/thread.h"
+#include "source/common/common/thread_annotations.h"
 
 #include "liburing.h"
 
@@ -21,6 +27,43 @@ struct InjectedCompletion {
   const int32_t result_;
 };
 
+/**
+ * The memory of the buffers of a provided buffer ring, which outlives the ring as long as the
+ * data of one of its buffers is in use. Buffers released on the thread of the ring are given back
+ * to the kernel immediately, others are queued until the ring's next completions are handled.
+ */
+class ProvidedBufferRing {
+public:
+  ProvidedBufferRing(struct io_uring_buf_ring* ring, uint32_t count, uint32_t size);
+
+  uint8_t* buffer(uint16_t buffer_id) { return memory_.get() + size_t(buffer_id) * size_; }
+  uint32_t count() const { return count_; }
+  uint32_t size() const { return size_; }
+
+  // Gives a buffer back to the kernel. May be called on any thread.
+  void release(uint16_t buffer_id);
+  // Gives the buffers released on other threads back to the kernel. Only called on the ring's
+  // thread.
+  void flushReleased();
+  // Called on the ring's thread before the ring is freed. Buffers are not given back anymore.
+  // @return the ring to free.
+  struct io_uring_buf_ring* detach();
+
+private:
+  void add(uint16_t buffer_id, int offset);
+
+  struct io_uring_buf_ring* ring_;
+  const uint32_t count_;
+  const uint32_t size_;
+  const std::unique_ptr<uint8_t[]> memory_;
+  const std::thread::id thread_id_;
+  Thread::MutexBasicLockable mutex_;
+  std::vector<uint16_t> released_ ABSL_GUARDED_BY(mutex_);
+  bool detached_ ABSL_GUARDED_BY(mutex_){false};
+};
+
+using ProvidedBufferRingSharedPtr = std::shared_ptr<ProvidedBufferRing>;
+
 class IoUringImpl : public IoUring,
                     public ThreadLocal::ThreadLocalObject,
                     protected Logger::Loggable<Logger::Id::io> {
@@ -36,10 +79,17 @@ public:
                               Request* user_data) override;
   IoUringResult prepareConnect(os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                                Request* user_data) override;
+  bool setupProvidedBuffers(uint32_t count, uint32_t size) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, Request* user_data) override;
+  Buffer::BufferFragment* takeProvidedBuffer(uint16_t buffer_id, uint32_t length) override;
+  void returnProvidedBuffer(uint16_t buffer_id) override;
   IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                              Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                               off_t offset, Request* user_data) override;
+  bool isZeroCopySendSupported() override;
+  IoUringResult prepareSendmsgZeroCopy(os_fd_t fd, const struct msghdr* msg,
+                                       Request* user_data) override;
   IoUringResult prepareClose(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) override;
   IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) override;
@@ -48,7 +98,11 @@ public:
   void removeInjectedCompletion(os_fd_t fd) override;
 
 private:
+  // The group of the provided buffers, unique to the ring.
+  static constexpr uint16_t ProvidedBufferGroup = 0;
+
   struct io_uring ring_ {};
+  ProvidedBufferRingSharedPtr provided_buffers_;
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
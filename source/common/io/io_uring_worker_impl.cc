@@ -18,6 +18,20 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
   }
 }
 
+ZeroCopyWriteRequest::ZeroCopyWriteRequest(IoUringSocket& socket,
+                                           const Buffer::RawSliceVector& slices,
+                                           Buffer::Instance& data)
+    : WriteRequest(socket, slices) {
+  msg_.msg_iov = iov_.get();
+  msg_.msg_iovlen = slices.size();
+  uint64_t length = 0;
+  for (const Buffer::RawSlice& slice : slices) {
+    length += slice.len_;
+  }
+  // The slices are whole, so they are moved rather than copied.
+  data_.move(data, length);
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
                                        bool enable_close_event)
     : fd_(fd), parent_(parent), enable_close_event_(enable_close_event), cb_(std::move(cb)) {}
@@ -60,14 +74,27 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     Event::Dispatcher& dispatcher,
+                                     uint32_t provided_buffer_count,
+                                     uint32_t zero_copy_send_threshold)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, dispatcher, provided_buffer_count,
+                        zero_copy_send_threshold) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher,
+                                     uint32_t provided_buffer_count,
+                                     uint32_t zero_copy_send_threshold)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
       write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+  // Without provided buffers, e.g. on kernels before 5.19, sockets read with readv requests.
+  multishot_recv_enabled_ =
+      provided_buffer_count > 0 &&
+      io_uring_->setupProvidedBuffers(provided_buffer_count, read_buffer_size_);
+  // Zero copy sendmsg requires kernel 6.1.
+  if (zero_copy_send_threshold > 0 && io_uring_->isZeroCopySendSupported()) {
+    zero_copy_send_threshold_ = zero_copy_send_threshold;
+  }
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -89,8 +116,10 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
     }
   }
 
-  while (!sockets_.empty()) {
-    ENVOY_LOG(trace, "still left {} sockets are not closed", sockets_.size());
+  // The data of zero copy sendmsg requests must outlive the kernel's references to it.
+  while (!sockets_.empty() || pending_zero_copy_notifications_ > 0) {
+    ENVOY_LOG(trace, "still left {} sockets are not closed, {} zero copy sends are not released",
+              sockets_.size(), pending_zero_copy_notifications_);
     for (auto& socket : sockets_) {
       ENVOY_LOG(trace, "the socket fd = {} not closed", socket->fd());
     }
@@ -168,6 +197,33 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitRecvMultishotRequest(IoUringSocket& socket) {
+  ASSERT(multishot_recv_enabled_);
+  Request* req = new Request(Request::RequestType::Read, socket);
+
+  ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareRecvMultishot(socket.fd(), req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+  }
+  submit();
+  return req;
+}
+
+Buffer::BufferFragment* IoUringWorkerImpl::takeProvidedBuffer(uint16_t buffer_id,
+                                                              uint32_t length) {
+  return io_uring_->takeProvidedBuffer(buffer_id, length);
+}
+
+void IoUringWorkerImpl::returnProvidedBuffer(uint16_t buffer_id) {
+  io_uring_->returnProvidedBuffer(buffer_id);
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -185,6 +241,26 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
   return req;
 }
 
+Request* IoUringWorkerImpl::submitZeroCopyWriteRequest(IoUringSocket& socket,
+                                                       const Buffer::RawSliceVector& slices,
+                                                       Buffer::Instance& data) {
+  ASSERT(zero_copy_send_threshold_ > 0);
+  ZeroCopyWriteRequest* req = new ZeroCopyWriteRequest(socket, slices, data);
+
+  ENVOY_LOG(trace, "submit zero copy write request, fd = {}, req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    submit();
+    res = io_uring_->prepareSendmsgZeroCopy(socket.fd(), &req->msg_, req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare zero copy sendmsg");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
   Request* req = new Request(Request::RequestType::Close, socket);
 
@@ -251,11 +327,20 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
-  io_uring_->forEveryCompletion([](Request* req, int32_t result, bool injected) {
+  io_uring_->forEveryCompletion([this](Request* req, int32_t result, bool injected) {
     ENVOY_LOG(trace, "receive request completion, type = {}, req = {}",
               static_cast<uint8_t>(req->type()), fmt::ptr(req));
     ASSERT(req != nullptr);
 
+    // The kernel released the data of a zero copy sendmsg request, whose socket has handled the
+    // result already and may be gone.
+    if (req->isNotification()) {
+      ASSERT(pending_zero_copy_notifications_ > 0);
+      pending_zero_copy_notifications_--;
+      delete req;
+      return;
+    }
+
     switch (req->type()) {
     case Request::RequestType::Accept:
       ENVOY_LOG(trace, "receive accept request completion, fd = {}, req = {}", req->socket().fd(),
@@ -294,7 +379,12 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // Multishot requests are owned by the ring until their last completion.
+    if (!req->hasMoreCompletions()) {
+      delete req;
+    } else if (req->type() == Request::RequestType::Write) {
+      pending_zero_copy_notifications_++;
+    }
   });
   delay_submit_ = false;
   submit();
@@ -338,7 +428,8 @@ void IoUringServerSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
     return;
   }
 
-  if (read_req_ != nullptr) {
+  // The read request may already be canceled by disableRead().
+  if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
     ENVOY_LOG(trace, "cancel the read request, fd = {}", fd_);
     read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
   }
@@ -372,7 +463,16 @@ void IoUringServerSocket::enableRead() {
   submitReadRequest();
 }
 
-void IoUringServerSocket::disableRead() { IoUringSocketEntry::disableRead(); }
+void IoUringServerSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+
+  // A multishot recv request keeps receiving data while the socket is read disabled, cancel it.
+  // The socket then monitors the remote close with a readv request.
+  if (read_multishot_ && read_cancel_req_ == nullptr) {
+    ENVOY_LOG(trace, "cancel the multishot recv request, fd = {}", fd_);
+    read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+  }
+}
 
 void IoUringServerSocket::write(Buffer::Instance& data) {
   ENVOY_LOG(trace, "write, buffer size = {}, fd = {}", data.length(), fd_);
@@ -429,6 +529,11 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  if (req->providedBuffer().has_value()) {
+    read_buf_.addBufferFragment(
+        *parent_.takeProvidedBuffer(req->providedBuffer().value(), data_length));
+    return;
+  }
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -456,15 +561,23 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   ENVOY_LOG(trace,
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
+  const bool multishot = !injected && read_multishot_;
   if (!injected) {
-    read_req_ = nullptr;
+    if (!req->hasMoreCompletions()) {
+      read_req_ = nullptr;
+      read_multishot_ = false;
+    }
     // If the socket is going to close, discard all results.
     if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
         write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
+      } else if (result > 0 && req->providedBuffer().has_value()) {
+        parent_.returnProvidedBuffer(req->providedBuffer().value());
+      }
+      if (read_req_ == nullptr) {
+        closeInternal();
       }
-      closeInternal();
       return;
     }
   }
@@ -472,6 +585,11 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   // Move read data from request to buffer or store the error.
   if (result > 0) {
     moveReadDataToBuffer(req, result);
+  } else if (result == -ENOBUFS && multishot) {
+    // The multishot recv request ran out of provided buffers, since the data received before is
+    // still buffered. Read the next data with a readv request.
+    ENVOY_LOG(trace, "provided buffers exhausted, fd = {}", fd_);
+    provided_buffers_exhausted_ = true;
   } else {
     if (result != -ECANCELED) {
       read_error_ = result;
@@ -561,8 +679,10 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
 
   ENVOY_LOG(trace, "onWrite with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
             injected, static_cast<int>(status_));
+  const bool zero_copy = !injected && write_zero_copy_;
   if (!injected) {
     write_or_shutdown_req_ = nullptr;
+    write_zero_copy_ = false;
   }
 
   // Notify the handler directly since it is an injected request.
@@ -577,7 +697,19 @@ void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
     return;
   }
 
-  if (result > 0) {
+  if (result > 0 && zero_copy) {
+    // The sent data stays with the request until the kernel releases it, only the unsent data
+    // of a short send is copied back.
+    ZeroCopyWriteRequest* write_req = static_cast<ZeroCopyWriteRequest*>(req);
+    const uint64_t unsent_length = write_req->data_.length() - result;
+    if (unsent_length > 0) {
+      std::string unsent(unsent_length, '\0');
+      write_req->data_.copyOut(result, unsent_length, unsent.data());
+      write_buf_.prepend(unsent);
+    }
+    ENVOY_LOG(trace, "zero copy sent size = {}, unsent size = {}, fd = {}", result, unsent_length,
+              fd_);
+  } else if (result > 0) {
     write_buf_.drain(result);
     ENVOY_LOG(trace, "drain write buf, drain size = {}, fd = {}", result, fd_);
   } else {
@@ -622,6 +754,14 @@ void IoUringServerSocket::closeInternal() {
 
 void IoUringServerSocket::submitReadRequest() {
   if (!read_req_) {
+    // Multishot requests are only used while read enabled, as they only end when canceled.
+    if (parent_.multishotRecvEnabled() && status_ == ReadEnabled &&
+        !provided_buffers_exhausted_) {
+      read_req_ = parent_.submitRecvMultishotRequest(*this);
+      read_multishot_ = true;
+      return;
+    }
+    provided_buffers_exhausted_ = false;
     read_req_ = parent_.submitReadRequest(*this);
   }
 }
@@ -632,7 +772,13 @@ void IoUringServerSocket::submitWriteOrShutdownRequest() {
       Buffer::RawSliceVector slices = write_buf_.getRawSlices(IOV_MAX);
       ENVOY_LOG(trace, "submit write request, write_buf size = {}, num_iovecs = {}, fd = {}",
                 write_buf_.length(), slices.size(), fd_);
-      write_or_shutdown_req_ = parent_.submitWriteRequest(*this, slices);
+      if (parent_.zeroCopySendThreshold() > 0 &&
+          write_buf_.length() >= parent_.zeroCopySendThreshold()) {
+        write_or_shutdown_req_ = parent_.submitZeroCopyWriteRequest(*this, slices, write_buf_);
+        write_zero_copy_ = true;
+      } else {
+        write_or_shutdown_req_ = parent_.submitWriteRequest(*this, slices);
+      }
     } else if (shutdown_.has_value() && !shutdown_.value()) {
       write_or_shutdown_req_ = parent_.submitShutdownRequest(*this, SHUT_WR);
     } else if (status_ == Closed && read_req_ == nullptr && read_cancel_req_ == nullptr &&
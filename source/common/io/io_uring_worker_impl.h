@@ -25,6 +25,17 @@ public:
   std::unique_ptr<struct iovec[]> iov_;
 };
 
+class ZeroCopyWriteRequest : public WriteRequest {
+public:
+  // Moves the data of `slices` out of `data`, the slices must be at the front of `data`.
+  ZeroCopyWriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices,
+                       Buffer::Instance& data);
+
+  struct msghdr msg_ {};
+  // The data being sent, which the kernel references until the notification of the request.
+  Buffer::OwnedImpl data_;
+};
+
 class IoUringSocketEntry;
 using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
@@ -32,9 +43,15 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, uint32_t provided_buffer_count = 0,
+                    uint32_t zero_copy_send_threshold = 0);
+  // If `provided_buffer_count` is not zero, sockets read with multishot recv requests into a ring
+  // of that many buffers of `read_buffer_size` bytes, if the kernel supports it.
+  // If `zero_copy_send_threshold` is not zero, sockets send writes of at least that many bytes
+  // with zero copy sendmsg requests, if the kernel supports it.
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, uint32_t provided_buffer_count = 0,
+                    uint32_t zero_copy_send_threshold = 0);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -55,6 +72,22 @@ public:
 
   Event::Dispatcher& dispatcher() override;
 
+  // Whether sockets read with multishot recv requests.
+  bool multishotRecvEnabled() const { return multishot_recv_enabled_; }
+  // Submit a multishot recv request, which completes until it is canceled or fails.
+  Request* submitRecvMultishotRequest(IoUringSocket& socket);
+  // Hand over the data of a completion of a multishot recv request.
+  Buffer::BufferFragment* takeProvidedBuffer(uint16_t buffer_id, uint32_t length);
+  // Give the buffer of a completion of a multishot recv request back without using its data.
+  void returnProvidedBuffer(uint16_t buffer_id);
+
+  // The minimum size of writes sent with zero copy sendmsg requests, or zero if disabled.
+  uint32_t zeroCopySendThreshold() const { return zero_copy_send_threshold_; }
+  // Submit a zero copy sendmsg request, which takes the data of `slices` from `data` until the
+  // kernel no longer references it.
+  Request* submitZeroCopyWriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices,
+                                      Buffer::Instance& data);
+
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
 
@@ -74,6 +107,11 @@ protected:
   IoUringPtr io_uring_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  bool multishot_recv_enabled_{false};
+  uint32_t zero_copy_send_threshold_{0};
+  // The number of zero copy sendmsg requests waiting for their notification. Their sockets may be
+  // gone already.
+  uint32_t pending_zero_copy_notifications_{0};
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
@@ -212,6 +250,14 @@ protected:
   // when enable_close_event_ is set, the remote close read_error_(0) will always be past to the
   // handler.
   Request* read_req_{};
+  // Whether read_req_ is a multishot recv request. Multishot requests are only used while the
+  // socket is read enabled, as they receive data until they are canceled.
+  bool read_multishot_{false};
+  // Set when a multishot recv request ran out of provided buffers, so that the next read uses a
+  // readv request instead.
+  bool provided_buffers_exhausted_{false};
+  // Whether write_or_shutdown_req_ is a zero copy sendmsg request.
+  bool write_zero_copy_{false};
   // TODO (soulxu): Add water mark here.
   Buffer::OwnedImpl read_buf_;
   absl::optional<int32_t> read_error_;
@@ -1,5 +1,7 @@
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
 
+#include <algorithm>
+
 #include "envoy/config/listener/v3/listener_components.pb.h"
 
 #include "source/common/common/cleanup.h"
@@ -14,6 +16,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/server/configuration_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -125,6 +128,9 @@ absl::Status FilterChainManagerImpl::addFilterChains(
   FilterChainsByMatcher filter_chains;
   uint32_t new_filter_chain_size = 0;
   FilterChainsByName filter_chains_by_name;
+  // The filter chains of the origin which are reused, so that the draining ones are found without
+  // hashing their messages again.
+  absl::flat_hash_set<const Network::DrainableFilterChain*> reused_filter_chains;
 
   for (const auto& filter_chain : filter_chain_span) {
     RETURN_IF_NOT_OK(verifyNoDuplicateMatchers(filter_chain_matcher, filter_chains, *filter_chain));
@@ -139,12 +145,15 @@ absl::Status FilterChainManagerImpl::addFilterChains(
       RETURN_IF_NOT_OK(filter_chain_or_error.status());
       filter_chain_impl = filter_chain_or_error.value();
       ++new_filter_chain_size;
+    } else {
+      reused_filter_chains.insert(filter_chain_impl.get());
     }
 
     RETURN_IF_NOT_OK(setupFilterChainMatcher(filter_chain_matcher, filter_chains_by_name,
                                              *filter_chain, filter_chain_impl));
-    fc_contexts_[*filter_chain] = filter_chain_impl;
+    fc_contexts_.insert_or_assign(*filter_chain, filter_chain_impl);
   }
+  shareIdenticalServerNameSubtrees();
   RETURN_IF_NOT_OK(convertIPsToTries());
   RETURN_IF_NOT_OK(copyOrRebuildDefaultFilterChain(default_filter_chain,
                                                    filter_chain_factory_builder, context_creator));
@@ -153,7 +162,7 @@ absl::Status FilterChainManagerImpl::addFilterChains(
   const auto* origin = getOriginFilterChainManager();
   if (origin != nullptr) {
     for (const auto& message_and_filter_chain : origin->fc_contexts_) {
-      if (fc_contexts_.find(message_and_filter_chain.first) == fc_contexts_.end()) {
+      if (!reused_filter_chains.contains(message_and_filter_chain.second.get())) {
         origin->draining_filter_chains_.push_back(message_and_filter_chain.second);
       }
     }
@@ -326,6 +335,17 @@ absl::Status FilterChainManagerImpl::copyOrRebuildDefaultFilterChain(
   return absl::OkStatus();
 }
 
+namespace {
+
+template <class T> T& getOrCreate(std::shared_ptr<T>& ptr) {
+  if (ptr == nullptr) {
+    ptr = std::make_shared<T>();
+  }
+  return *ptr;
+}
+
+} // namespace
+
 absl::Status FilterChainManagerImpl::addFilterChainForDestinationPorts(
     DestinationPortsMap& destination_ports_map, uint16_t destination_port,
     const std::vector<std::string>& destination_ips,
@@ -386,18 +406,19 @@ absl::Status FilterChainManagerImpl::addFilterChainForServerNames(
 
   if (server_names.empty()) {
     RETURN_IF_NOT_OK(addFilterChainForApplicationProtocols(
-        server_names_map[EMPTY_STRING][transport_protocol], application_protocols,
+        getOrCreate(server_names_map[EMPTY_STRING])[transport_protocol], application_protocols,
         direct_source_ips, source_type, source_ips, source_ports, filter_chain));
   } else {
     for (const auto& server_name : server_names) {
       if (isWildcardServerName(server_name)) {
         // Add mapping for the wildcard domain, i.e. ".example.com" for "*.example.com".
         RETURN_IF_NOT_OK(addFilterChainForApplicationProtocols(
-            server_names_map[server_name.substr(1)][transport_protocol], application_protocols,
-            direct_source_ips, source_type, source_ips, source_ports, filter_chain));
+            getOrCreate(server_names_map[server_name.substr(1)])[transport_protocol],
+            application_protocols, direct_source_ips, source_type, source_ips, source_ports,
+            filter_chain));
       } else {
         RETURN_IF_NOT_OK(addFilterChainForApplicationProtocols(
-            server_names_map[server_name][transport_protocol], application_protocols,
+            getOrCreate(server_names_map[server_name])[transport_protocol], application_protocols,
             direct_source_ips, source_type, source_ips, source_ports, filter_chain));
       }
     }
@@ -537,6 +558,49 @@ makeCidrListEntry(const std::string& cidr, const T& data, absl::Status& creation
   return std::make_pair<T, std::vector<Network::Address::CidrRange>>(T(data), std::move(subnets));
 }
 
+// Builds the trie matching addresses against the CIDR ranges of the map. No trie is built if the
+// map is empty, or if it only holds the catch-all range, which matches every address the trie
+// would, as lookups then use the only entry directly.
+template <class T>
+absl::Status buildCidrTrie(const absl::flat_hash_map<std::string, T>& cidr_map,
+                           std::unique_ptr<Network::LcTrie::LcTrie<T>>& trie) {
+  trie.reset();
+  // The catch-all range only covers the supported IP families.
+  if (cidr_map.empty() ||
+      (cidr_map.size() == 1 && cidr_map.begin()->first == EMPTY_STRING &&
+       Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET) &&
+       Network::SocketInterfaceSingleton::get().ipFamilySupported(AF_INET6))) {
+    return absl::OkStatus();
+  }
+  std::vector<std::pair<T, std::vector<Network::Address::CidrRange>>> cidr_list;
+  cidr_list.reserve(cidr_map.size());
+  for (const auto& [cidr, data] : cidr_map) {
+    absl::Status creation_status = absl::OkStatus();
+    cidr_list.push_back(makeCidrListEntry(cidr, data, creation_status));
+    RETURN_IF_NOT_OK(creation_status);
+  }
+  trie = std::make_unique<Network::LcTrie::LcTrie<T>>(cidr_list, true);
+  return absl::OkStatus();
+}
+
+// Appends the entries of a map to a key in the order of their keys.
+template <class Map, class AppendValue>
+void appendSortedEntries(const Map& map, std::string& key, AppendValue append_value) {
+  std::vector<const typename Map::value_type*> entries;
+  entries.reserve(map.size());
+  for (const auto& entry : map) {
+    entries.push_back(&entry);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+  absl::StrAppend(&key, "{");
+  for (const auto* entry : entries) {
+    absl::StrAppend(&key, entry->first.size(), ":", entry->first);
+    append_value(entry->second, key);
+  }
+  absl::StrAppend(&key, "}");
+}
+
 }; // namespace
 
 const Network::FilterChain*
@@ -553,7 +617,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   if (address->type() == Network::Address::Type::Ip) {
     const auto port_match = destination_ports_map_.find(address->ip()->port());
     if (port_match != destination_ports_map_.end()) {
-      best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+      best_match_filter_chain = findFilterChainForDestinationIP(
+          port_match->second.first, port_match->second.second.get(), socket);
       if (best_match_filter_chain != nullptr) {
         return best_match_filter_chain;
       } else {
@@ -566,7 +631,8 @@ FilterChainManagerImpl::findFilterChain(const Network::ConnectionSocket& socket,
   // Match on catch-all port 0 if there is no specific port sub tree.
   const auto port_match = destination_ports_map_.find(0);
   if (port_match != destination_ports_map_.end()) {
-    best_match_filter_chain = findFilterChainForDestinationIP(*port_match->second.second, socket);
+    best_match_filter_chain = findFilterChainForDestinationIP(
+        port_match->second.first, port_match->second.second.get(), socket);
   }
   return best_match_filter_chain != nullptr
              ? best_match_filter_chain
@@ -589,14 +655,19 @@ FilterChainManagerImpl::findFilterChainUsingMatcher(const Network::ConnectionSoc
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinationIP(
-    const DestinationIPsTrie& destination_ips_trie, const Network::ConnectionSocket& socket) const {
+    const DestinationIPsMap& destination_ips_map, const DestinationIPsTrie* destination_ips_trie,
+    const Network::ConnectionSocket& socket) const {
+  if (destination_ips_trie == nullptr) {
+    return findFilterChainForServerName(*destination_ips_map.begin()->second, socket);
+  }
+
   auto address = socket.connectionInfoProvider().localAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
   // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = destination_ips_trie.getData(address);
+  const auto& data = destination_ips_trie->getData(address);
   if (!data.empty()) {
     ASSERT(data.size() == 1);
     return findFilterChainForServerName(*data.back(), socket);
@@ -608,21 +679,20 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDestinatio
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName(
     const ServerNamesMap& server_names_map, const Network::ConnectionSocket& socket) const {
   ASSERT(absl::AsciiStrToLower(socket.requestedServerName()) == socket.requestedServerName());
-  const std::string server_name(socket.requestedServerName());
+  const absl::string_view server_name = socket.requestedServerName();
 
   // Match on exact server name, i.e. "www.example.com" for "www.example.com".
   const auto server_name_exact_match = server_names_map.find(server_name);
   if (server_name_exact_match != server_names_map.end()) {
-    return findFilterChainForTransportProtocol(server_name_exact_match->second, socket);
+    return findFilterChainForTransportProtocol(*server_name_exact_match->second, socket);
   }
 
   // Match on all wildcard domains, i.e. ".example.com" and ".com" for "www.example.com".
   size_t pos = server_name.find('.', 1);
-  while (pos < server_name.size() - 1 && pos != std::string::npos) {
-    const std::string wildcard = server_name.substr(pos);
-    const auto server_name_wildcard_match = server_names_map.find(wildcard);
+  while (pos < server_name.size() - 1 && pos != absl::string_view::npos) {
+    const auto server_name_wildcard_match = server_names_map.find(server_name.substr(pos));
     if (server_name_wildcard_match != server_names_map.end()) {
-      return findFilterChainForTransportProtocol(server_name_wildcard_match->second, socket);
+      return findFilterChainForTransportProtocol(*server_name_wildcard_match->second, socket);
     }
     pos = server_name.find('.', pos + 1);
   }
@@ -630,7 +700,7 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
   // Match on a filter chain without server name requirements.
   const auto server_name_catchall_match = server_names_map.find(EMPTY_STRING);
   if (server_name_catchall_match != server_names_map.end()) {
-    return findFilterChainForTransportProtocol(server_name_catchall_match->second, socket);
+    return findFilterChainForTransportProtocol(*server_name_catchall_match->second, socket);
   }
 
   return nullptr;
@@ -639,10 +709,9 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForServerName
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForTransportProtocol(
     const TransportProtocolsMap& transport_protocols_map,
     const Network::ConnectionSocket& socket) const {
-  const std::string transport_protocol(socket.detectedTransportProtocol());
-
   // Match on exact transport protocol, e.g. "tls".
-  const auto transport_protocol_match = transport_protocols_map.find(transport_protocol);
+  const auto transport_protocol_match =
+      transport_protocols_map.find(socket.detectedTransportProtocol());
   if (transport_protocol_match != transport_protocols_map.end()) {
     return findFilterChainForApplicationProtocols(transport_protocol_match->second, socket);
   }
@@ -663,28 +732,32 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForApplicatio
   for (const auto& application_protocol : socket.requestedApplicationProtocols()) {
     const auto application_protocol_match = application_protocols_map.find(application_protocol);
     if (application_protocol_match != application_protocols_map.end()) {
-      return findFilterChainForDirectSourceIP(*application_protocol_match->second.second, socket);
+      return findFilterChainForDirectSourceIP(application_protocol_match->second, socket);
     }
   }
 
   // Match on a filter chain without application protocol requirements.
   const auto any_protocol_match = application_protocols_map.find(EMPTY_STRING);
   if (any_protocol_match != application_protocols_map.end()) {
-    return findFilterChainForDirectSourceIP(*any_protocol_match->second.second, socket);
+    return findFilterChainForDirectSourceIP(any_protocol_match->second, socket);
   }
 
   return nullptr;
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForDirectSourceIP(
-    const DirectSourceIPsTrie& direct_source_ips_trie,
+    const DirectSourceIPsPair& direct_source_ips_pair,
     const Network::ConnectionSocket& socket) const {
+  if (direct_source_ips_pair.second == nullptr) {
+    return findFilterChainForSourceTypes(*direct_source_ips_pair.first.begin()->second, socket);
+  }
+
   auto address = socket.connectionInfoProvider().directRemoteAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
-  const auto& data = direct_source_ips_trie.getData(address);
+  const auto& data = direct_source_ips_pair.second->getData(address);
   if (!data.empty()) {
     ASSERT(data.size() == 1);
     return findFilterChainForSourceTypes(*data.back(), socket);
@@ -710,38 +783,48 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceType
 
   if (is_local_connection) {
     if (!filter_chain_local.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_local.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_local.first,
+                                               filter_chain_local.second.get(), socket);
     }
   } else {
     if (!filter_chain_external.first.empty()) {
-      return findFilterChainForSourceIpAndPort(*filter_chain_external.second, socket);
+      return findFilterChainForSourceIpAndPort(filter_chain_external.first,
+                                               filter_chain_external.second.get(), socket);
     }
   }
 
   const auto& filter_chain_any = source_types[envoy::config::listener::v3::FilterChainMatch::ANY];
 
   if (!filter_chain_any.first.empty()) {
-    return findFilterChainForSourceIpAndPort(*filter_chain_any.second, socket);
+    return findFilterChainForSourceIpAndPort(filter_chain_any.first, filter_chain_any.second.get(),
+                                             socket);
   } else {
     return nullptr;
   }
 }
 
 const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAndPort(
-    const SourceIPsTrie& source_ips_trie, const Network::ConnectionSocket& socket) const {
+    const SourceIPsMap& source_ips_map, const SourceIPsTrie* source_ips_trie,
+    const Network::ConnectionSocket& socket) const {
   auto address = socket.connectionInfoProvider().remoteAddress();
   if (address->type() != Network::Address::Type::Ip) {
     address = FilterChain::fakeAddress();
   }
 
-  // Match on both: exact IP and wider CIDR ranges using LcTrie.
-  const auto& data = source_ips_trie.getData(address);
-  if (data.empty()) {
-    return nullptr;
+  const SourcePortsMap* source_ports_map_ptr;
+  if (source_ips_trie == nullptr) {
+    source_ports_map_ptr = source_ips_map.begin()->second.get();
+  } else {
+    // Match on both: exact IP and wider CIDR ranges using LcTrie.
+    const auto& data = source_ips_trie->getData(address);
+    if (data.empty()) {
+      return nullptr;
+    }
+    ASSERT(data.size() == 1);
+    source_ports_map_ptr = data.back().get();
   }
 
-  ASSERT(data.size() == 1);
-  const auto& source_ports_map = *data.back();
+  const auto& source_ports_map = *source_ports_map_ptr;
   const uint32_t source_port = address->ip()->port();
   const auto port_match = source_ports_map.find(source_port);
 
@@ -761,65 +844,103 @@ const Network::FilterChain* FilterChainManagerImpl::findFilterChainForSourceIpAn
   return nullptr;
 }
 
+void FilterChainManagerImpl::appendSubtreeKey(const TransportProtocolsMap& transport_protocols_map,
+                                              std::string& key) {
+  // The filter chains are compared by identity, as a filter chain message has a single filter chain
+  // in the whole manager.
+  const auto append_source_ports = [](const SourcePortsMapSharedPtr& source_ports_map,
+                                      std::string& out) {
+    std::vector<std::pair<uint16_t, const Network::FilterChain*>> ports;
+    ports.reserve(source_ports_map->size());
+    for (const auto& [port, filter_chain] : *source_ports_map) {
+      ports.emplace_back(port, filter_chain.get());
+    }
+    std::sort(ports.begin(), ports.end());
+    absl::StrAppend(&out, "{");
+    for (const auto& [port, filter_chain] : ports) {
+      absl::StrAppend(&out, port, "=", absl::Hex(filter_chain), ",");
+    }
+    absl::StrAppend(&out, "}");
+  };
+  const auto append_source_types = [&append_source_ports](
+                                       const SourceTypesArraySharedPtr& source_types_array,
+                                       std::string& out) {
+    for (const auto& [source_ips_map, source_ips_trie] : *source_types_array) {
+      UNREFERENCED_PARAMETER(source_ips_trie);
+      appendSortedEntries(source_ips_map, out, append_source_ports);
+    }
+  };
+  const auto append_direct_source_ips = [&append_source_types](
+                                            const DirectSourceIPsPair& direct_source_ips_pair,
+                                            std::string& out) {
+    appendSortedEntries(direct_source_ips_pair.first, out, append_source_types);
+  };
+  appendSortedEntries(transport_protocols_map, key,
+                      [&append_direct_source_ips](
+                          const ApplicationProtocolsMap& application_protocols_map,
+                          std::string& out) {
+                        appendSortedEntries(application_protocols_map, out,
+                                            append_direct_source_ips);
+                      });
+}
+
+void FilterChainManagerImpl::shareIdenticalServerNameSubtrees() {
+  // Listeners with many server names typically have filter chains matching many of them, whose
+  // subtrees only differ by their server name.
+  absl::flat_hash_map<std::string, TransportProtocolsMapSharedPtr> subtrees;
+  for (auto& [destination_port, destination_ips_pair] : destination_ports_map_) {
+    UNREFERENCED_PARAMETER(destination_port);
+    for (auto& [destination_ip, server_names_map_ptr] : destination_ips_pair.first) {
+      UNREFERENCED_PARAMETER(destination_ip);
+      for (auto& [server_name, transport_protocols_map_ptr] : *server_names_map_ptr) {
+        UNREFERENCED_PARAMETER(server_name);
+        std::string key;
+        appendSubtreeKey(*transport_protocols_map_ptr, key);
+        auto [it, inserted] = subtrees.try_emplace(std::move(key), transport_protocols_map_ptr);
+        if (!inserted) {
+          transport_protocols_map_ptr = it->second;
+        }
+      }
+    }
+  }
+}
+
 absl::Status FilterChainManagerImpl::convertIPsToTries() {
+  // Server names may share their subtree, whose tries are only built once.
+  absl::flat_hash_set<const TransportProtocolsMap*> converted_subtrees;
   for (auto& [destination_port, destination_ips_pair] : destination_ports_map_) {
     UNREFERENCED_PARAMETER(destination_port);
-    // These variables are used as we build up the destination CIDRs used for the trie.
     auto& [destination_ips_map, destination_ips_trie] = destination_ips_pair;
-    std::vector<std::pair<ServerNamesMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-        destination_ips_list;
-    destination_ips_list.reserve(destination_ips_map.size());
+    RETURN_IF_NOT_OK(buildCidrTrie(destination_ips_map, destination_ips_trie));
 
+    // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
+    // We need to get access to all of the source IP strings so that we can convert them into
+    // a trie like we did for the destination IPs above.
     for (const auto& [destination_ip, server_names_map_ptr] : destination_ips_map) {
-      absl::Status creation_status = absl::OkStatus();
-      destination_ips_list.push_back(
-          makeCidrListEntry(destination_ip, server_names_map_ptr, creation_status));
-      RETURN_IF_NOT_OK(creation_status);
-
-      // This hugely nested for loop greatly pains me, but I'm not sure how to make it better.
-      // We need to get access to all of the source IP strings so that we can convert them into
-      // a trie like we did for the destination IPs above.
-      for (auto& [server_name, transport_protocols_map] : *server_names_map_ptr) {
+      UNREFERENCED_PARAMETER(destination_ip);
+      for (auto& [server_name, transport_protocols_map_ptr] : *server_names_map_ptr) {
         UNREFERENCED_PARAMETER(server_name);
-        for (auto& [transport_protocol, application_protocols_map] : transport_protocols_map) {
+        if (!converted_subtrees.insert(transport_protocols_map_ptr.get()).second) {
+          continue;
+        }
+        for (auto& [transport_protocol, application_protocols_map] :
+             *transport_protocols_map_ptr) {
           UNREFERENCED_PARAMETER(transport_protocol);
           for (auto& [application_protocol, direct_source_ips_pair] : application_protocols_map) {
             UNREFERENCED_PARAMETER(application_protocol);
             auto& [direct_source_ips_map, direct_source_ips_trie] = direct_source_ips_pair;
-
-            std::vector<
-                std::pair<SourceTypesArraySharedPtr, std::vector<Network::Address::CidrRange>>>
-                direct_source_ips_list;
-            direct_source_ips_list.reserve(direct_source_ips_map.size());
+            RETURN_IF_NOT_OK(buildCidrTrie(direct_source_ips_map, direct_source_ips_trie));
 
             for (auto& [direct_source_ip, source_arrays_ptr] : direct_source_ips_map) {
-              direct_source_ips_list.push_back(
-                  makeCidrListEntry(direct_source_ip, source_arrays_ptr, creation_status));
-              RETURN_IF_NOT_OK(creation_status);
-
+              UNREFERENCED_PARAMETER(direct_source_ip);
               for (auto& [source_ips_map, source_ips_trie] : *source_arrays_ptr) {
-                std::vector<
-                    std::pair<SourcePortsMapSharedPtr, std::vector<Network::Address::CidrRange>>>
-                    source_ips_list;
-                source_ips_list.reserve(source_ips_map.size());
-
-                for (auto& [source_ip, source_port_map_ptr] : source_ips_map) {
-                  source_ips_list.push_back(
-                      makeCidrListEntry(source_ip, source_port_map_ptr, creation_status));
-                  RETURN_IF_NOT_OK(creation_status);
-                }
-
-                source_ips_trie = std::make_unique<SourceIPsTrie>(source_ips_list, true);
+                RETURN_IF_NOT_OK(buildCidrTrie(source_ips_map, source_ips_trie));
               }
             }
-            direct_source_ips_trie =
-                std::make_unique<DirectSourceIPsTrie>(direct_source_ips_list, true);
           }
         }
       }
     }
-
-    destination_ips_trie = std::make_unique<DestinationIPsTrie>(destination_ips_list, true);
   }
   return absl::OkStatus();
 }
@@ -833,8 +954,6 @@ Network::DrainableFilterChainSharedPtr FilterChainManagerImpl::findExistingFilte
   }
   auto iter = origin->fc_contexts_.find(filter_chain_message);
   if (iter != origin->fc_contexts_.end()) {
-    // copy the context to this filter chain manager.
-    fc_contexts_.emplace(filter_chain_message, iter->second);
     return iter->second;
   }
   return nullptr;
@@ -253,10 +253,13 @@ private:
 
   using ApplicationProtocolsMap = absl::flat_hash_map<std::string, DirectSourceIPsPair>;
   using TransportProtocolsMap = absl::flat_hash_map<std::string, ApplicationProtocolsMap>;
+  // Server names whose subtrees are identical once all the filter chains are added, such as the
+  // server names of a filter chain matching many of them, share a single subtree.
+  using TransportProtocolsMapSharedPtr = std::shared_ptr<TransportProtocolsMap>;
   // Both exact server names and wildcard domains are part of the same map, in which wildcard
   // domains are prefixed with "." (i.e. ".example.com" for "*.example.com") to differentiate
   // between exact and wildcard entries.
-  using ServerNamesMap = absl::flat_hash_map<std::string, TransportProtocolsMap>;
+  using ServerNamesMap = absl::flat_hash_map<std::string, TransportProtocolsMapSharedPtr>;
   using ServerNamesMapSharedPtr = std::shared_ptr<ServerNamesMap>;
   using DestinationIPsMap = absl::flat_hash_map<std::string, ServerNamesMapSharedPtr>;
   using DestinationIPsTrie = Network::LcTrie::LcTrie<ServerNamesMapSharedPtr>;
@@ -333,8 +336,10 @@ private:
                                             uint32_t source_port,
                                             const Network::FilterChainSharedPtr& filter_chain);
 
+  // The tries of the maps only holding the catch-all IP are not built, as it matches every address.
   const Network::FilterChain*
-  findFilterChainForDestinationIP(const DestinationIPsTrie& destination_ips_trie,
+  findFilterChainForDestinationIP(const DestinationIPsMap& destination_ips_map,
+                                  const DestinationIPsTrie* destination_ips_trie,
                                   const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForServerName(const ServerNamesMap& server_names_map,
@@ -346,18 +351,25 @@ private:
   findFilterChainForApplicationProtocols(const ApplicationProtocolsMap& application_protocols_map,
                                          const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
-  findFilterChainForDirectSourceIP(const DirectSourceIPsTrie& direct_source_ips_trie,
+  findFilterChainForDirectSourceIP(const DirectSourceIPsPair& direct_source_ips_pair,
                                    const Network::ConnectionSocket& socket) const;
   const Network::FilterChain*
   findFilterChainForSourceTypes(const SourceTypesArray& source_types,
                                 const Network::ConnectionSocket& socket) const;
 
   const Network::FilterChain*
-  findFilterChainForSourceIpAndPort(const SourceIPsTrie& source_ips_trie,
+  findFilterChainForSourceIpAndPort(const SourceIPsMap& source_ips_map,
+                                    const SourceIPsTrie* source_ips_trie,
                                     const Network::ConnectionSocket& socket) const;
 
+  // Shares the subtrees of the server names which are identical. Called once all the filter
+  // chains are added, before the tries are built.
+  void shareIdenticalServerNameSubtrees();
+  static void appendSubtreeKey(const TransportProtocolsMap& transport_protocols_map,
+                               std::string& key);
+
   const FilterChainManagerImpl* getOriginFilterChainManager() { return origin_.value(); }
-  // Duplicate the inherent factory context if any.
+  // @return the filter chain of the origin built from the same message, if any.
   Network::DrainableFilterChainSharedPtr
   findExistingFilterChain(const envoy::config::listener::v3::FilterChain& filter_chain_message);
 
@@ -49,6 +49,14 @@ absl::Status
 LdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
                            const Protobuf::RepeatedPtrField<std::string>& removed_resources,
                            const std::string& system_version_info) {
+  return applyConfigUpdate(added_resources, removed_resources, system_version_info, nullptr);
+}
+
+absl::Status
+LdsApiImpl::applyConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
+                              const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+                              const std::string& system_version_info,
+                              const absl::node_hash_set<std::string>* existing_listeners) {
   const std::vector<std::string> paused_xds_types{
       Config::getTypeUrl<envoy::config::route::v3::RouteConfiguration>(),
       Config::getTypeUrl<envoy::config::route::v3::ScopedRouteConfiguration>(),
@@ -61,12 +69,26 @@ LdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_
   // We do all listener removals before adding the new listeners. This allows adding a new
   // listener with the same address as a listener that is to be removed. Do not change the order.
   for (const auto& removed_listener : removed_resources) {
+    applied_hashes_.erase(removed_listener);
     if (listener_manager_.removeListener(removed_listener)) {
       ENVOY_LOG(info, "lds: remove listener '{}'", removed_listener);
       any_applied = true;
     }
   }
 
+  // A listener unchanged on the wire since it was last applied would be blocked by the listener
+  // manager, after hashing it again. It is only skipped while the listener still exists.
+  absl::node_hash_set<std::string> listed_listeners;
+  if (existing_listeners == nullptr) {
+    if (!applied_hashes_.empty()) {
+      for (const auto& listener :
+           listener_manager_.listeners(ListenerManager::WARMING | ListenerManager::ACTIVE)) {
+        listed_listeners.insert(listener.get().name());
+      }
+    }
+    existing_listeners = &listed_listeners;
+  }
+
   ListenerManager::FailureStates failure_state;
   absl::node_hash_set<std::string> listener_names;
   std::string message;
@@ -96,12 +118,23 @@ LdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_
         onError(fmt::format("duplicate listener {} found", listener_name));
         continue;
       }
+      const absl::optional<uint64_t> content_hash = resource.get().contentHash();
+      auto it = applied_hashes_.find(listener.name());
+      if (content_hash.has_value() && it != applied_hashes_.end() &&
+          it->second == *content_hash && existing_listeners->contains(listener.name())) {
+        ENVOY_LOG(debug, "lds: add/update listener '{}' skipped", listener_name);
+        continue;
+      }
+      applied_hashes_.erase(listener.name());
       absl::StatusOr<bool> update_or_error =
           listener_manager_.addOrUpdateListener(listener, resource.get().version(), true);
       if (!update_or_error.status().ok()) {
         onError(std::string(update_or_error.status().message()));
         continue;
       }
+      if (content_hash.has_value()) {
+        applied_hashes_[listener.name()] = *content_hash;
+      }
       if (update_or_error.value()) {
         ENVOY_LOG(info, "lds: add/update listener '{}'", listener_name);
         any_applied = true;
@@ -128,11 +161,12 @@ absl::Status LdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourc
                                         const std::string& version_info) {
   // We need to keep track of which listeners need to remove.
   // Specifically, it's [listeners we currently have] - [listeners found in the response].
-  absl::node_hash_set<std::string> listeners_to_remove;
+  absl::node_hash_set<std::string> existing_listeners;
   for (const auto& listener :
        listener_manager_.listeners(ListenerManager::WARMING | ListenerManager::ACTIVE)) {
-    listeners_to_remove.insert(listener.get().name());
+    existing_listeners.insert(listener.get().name());
   }
+  absl::node_hash_set<std::string> listeners_to_remove = existing_listeners;
   for (const auto& resource : resources) {
     // Remove its name from our delta removed pile.
     listeners_to_remove.erase(resource.get().name());
@@ -142,7 +176,8 @@ absl::Status LdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourc
   for (const auto& listener : listeners_to_remove) {
     *to_remove_repeated.Add() = listener;
   }
-  return onConfigUpdate(resources, to_remove_repeated, version_info);
+  // The listeners are only listed once, for their removal and for skipping the unchanged ones.
+  return applyConfigUpdate(resources, to_remove_repeated, version_info, &existing_listeners);
 }
 
 void LdsApiImpl::onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
@@ -16,6 +16,9 @@
 #include "source/common/config/subscription_base.h"
 #include "source/common/init/target_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_set.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -45,8 +48,17 @@ private:
   void onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason reason,
                             const EnvoyException* e) override;
 
+  // Applies an update given the names of the existing listeners, if already known. Otherwise they
+  // are only looked up when a listener could be skipped as unchanged.
+  absl::Status applyConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
+                                 const Protobuf::RepeatedPtrField<std::string>& removed_resources,
+                                 const std::string& system_version_info,
+                                 const absl::node_hash_set<std::string>* existing_listeners);
+
   Config::SubscriptionPtr subscription_;
   std::string system_version_info_;
+  // The content hashes of the listeners last added or updated, by name.
+  absl::flat_hash_map<std::string, uint64_t> applied_hashes_;
   ListenerManager& listener_manager_;
   Stats::ScopeSharedPtr scope_;
   Config::XdsManager& xds_manager_;
@@ -23,6 +23,7 @@
 #include "source/common/listener_manager/listener_manager_impl.h"
 #include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/resolver_impl.h"
+#include "source/common/network/reuse_port_cpu_steering.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/udp_listener_impl.h"
@@ -236,6 +237,12 @@ absl::Status ListenSocketFactoryImpl::doFinalPreWorkerInit() {
     RETURN_IF_NOT_OK(listen_and_apply_options(*iterator, tcp_backlog_size_));
   }
 #endif
+  // The sockets joined the reuse port group in worker order when listening, so the index of the
+  // socket of a worker in the group is the worker index.
+  if (bind_type_ == ListenerComponentFactory::BindType::ReusePort &&
+      socket_creation_options_.reuse_port_cpu_steering_) {
+    RETURN_IF_NOT_OK(Network::ReusePortCpuSteering::attach(*sockets_[0], sockets_.size()));
+  }
   return absl::OkStatus();
 }
 
@@ -290,6 +297,7 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
                        ? Network::Socket::Type::Stream
                        : Network::Utility::protobufAddressSocketType(config.address())),
       bind_to_port_(shouldBindToPort(config)), mptcp_enabled_(config.enable_mptcp()),
+      reuse_port_cpu_steering_(config.reuse_port_cpu_steering()),
       hand_off_restored_destination_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_original_dst, false)),
       per_connection_buffer_limit_bytes_(
@@ -454,6 +462,7 @@ ListenerImpl::ListenerImpl(ListenerImpl& origin,
                            uint64_t hash, absl::Status& creation_status)
     : parent_(parent), addresses_(origin.addresses_), socket_type_(origin.socket_type_),
       bind_to_port_(shouldBindToPort(config)), mptcp_enabled_(config.enable_mptcp()),
+      reuse_port_cpu_steering_(config.reuse_port_cpu_steering()),
       hand_off_restored_destination_connections_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, use_original_dst, false)),
       per_connection_buffer_limit_bytes_(
@@ -546,6 +555,20 @@ absl::Status ListenerImpl::validateConfig() {
           name_));
     }
   }
+  if (reuse_port_cpu_steering_) {
+#ifndef __linux__
+    return absl::InvalidArgumentError(fmt::format(
+        "listener {}: reuse_port_cpu_steering is only supported on Linux", name_));
+#endif
+    if (socket_type_ != Network::Socket::Type::Stream) {
+      return absl::InvalidArgumentError(fmt::format(
+          "listener {}: reuse_port_cpu_steering can only be used with TCP listeners", name_));
+    }
+    if (!reuse_port_) {
+      return absl::InvalidArgumentError(fmt::format(
+          "listener {}: reuse_port_cpu_steering requires enable_reuse_port", name_));
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -567,7 +590,8 @@ ListenerImpl::buildInternalListener(const envoy::config::listener::v3::Listener&
                       name_));
     }
     if ((config.has_connection_balance_config() &&
-         config.connection_balance_config().has_exact_balance()) ||
+         (config.connection_balance_config().has_exact_balance() ||
+          config.connection_balance_config().has_load_aware_balance())) ||
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
@@ -713,6 +737,13 @@ void ListenerImpl::buildListenSocketOptions(
       addListenSocketOptions(listen_socket_options_list_[i],
                              Network::SocketOptionFactory::buildReusePortOptions());
     }
+    if (config.has_busy_poll_duration()) {
+      const std::chrono::microseconds busy_poll_duration(
+          Protobuf::util::TimeUtil::DurationToMicroseconds(config.busy_poll_duration()));
+      addListenSocketOptions(
+          listen_socket_options_list_[i],
+          Network::SocketOptionFactory::buildBusyPollOptions(busy_poll_duration));
+    }
     if (!address_opts_list[i]->empty()) {
       addListenSocketOptions(listen_socket_options_list_[i], address_opts_list[i]);
     }
@@ -849,6 +880,18 @@ ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Listene
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kLoadAwareBalance: {
+        Server::Configuration::ServerFactoryContext& server_context =
+            listener_factory_context_->serverFactoryContext();
+        connection_balancers_.emplace(
+            address.asString(),
+            std::make_shared<Network::LoadAwareConnectionBalancerImpl>(
+                server_context.threadLocal(), server_context.api().randomGenerator(),
+                std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+                    config.connection_balance_config().load_aware_balance(), probe_interval,
+                    100))));
+        break;
+      }
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
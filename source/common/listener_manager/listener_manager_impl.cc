@@ -1278,6 +1278,7 @@ absl::Status ListenerManagerImpl::createListenSocketFactory(ListenerImpl& listen
   TRY_ASSERT_MAIN_THREAD {
     Network::SocketCreationOptions creation_options;
     creation_options.mptcp_enabled_ = listener.mptcpEnabled();
+    creation_options.reuse_port_cpu_steering_ = listener.reusePortCpuSteering();
     for (std::vector<Network::Address::InstanceConstSharedPtr>::size_type i = 0;
          i < listener.addresses().size(); i++) {
       auto factory_or_error = ListenSocketFactoryImpl::create(
@@ -1,12 +1,87 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "envoy/matcher/matcher.h"
 
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Matcher {
 
+/**
+ * The distinct data inputs of the single predicates of a match tree. The inputs used by more than
+ * one predicate get a slot, in which their value is kept for the duration of an evaluation of the
+ * tree, so that they are extracted once.
+ */
+class SharedMatchInputs {
+public:
+  static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+  // Registers a use of an input, identified by its serialized config. Returns its index.
+  uint32_t add(std::string key) {
+    const auto it = indexes_.try_emplace(std::move(key), uses_.size()).first;
+    if (it->second == uses_.size()) {
+      uses_.push_back(0);
+    }
+    uses_[it->second]++;
+    return it->second;
+  }
+
+  // Returns the slot of an input index, or NoSlot if it has a single use.
+  uint32_t slot(uint32_t index) const { return uses_[index] > 1 ? index : NoSlot; }
+
+  bool anyShared() const {
+    return std::any_of(uses_.begin(), uses_.end(), [](uint32_t uses) { return uses > 1; });
+  }
+
+  size_t size() const { return uses_.size(); }
+
+private:
+  absl::flat_hash_map<std::string, uint32_t> indexes_;
+  std::vector<uint32_t> uses_;
+};
+
+using SharedMatchInputsSharedPtr = std::shared_ptr<SharedMatchInputs>;
+using SharedMatchInputsConstSharedPtr = std::shared_ptr<const SharedMatchInputs>;
+
+/**
+ * The values of the shared inputs extracted during an evaluation of a match tree. It is installed
+ * on the thread for the duration of the evaluation.
+ */
+class MatchInputCache : NonCopyable {
+public:
+  explicit MatchInputCache(const SharedMatchInputs& inputs)
+      : inputs_(inputs), previous_(current_), results_(inputs.size()) {
+    current_ = this;
+  }
+  ~MatchInputCache() { current_ = previous_; }
+
+  // Returns the cache of the evaluation in progress on the thread of a tree of the inputs, or
+  // nullptr if there is none.
+  static MatchInputCache* current(const SharedMatchInputs& inputs) {
+    return current_ != nullptr && &current_->inputs_ == &inputs ? current_ : nullptr;
+  }
+
+  absl::optional<DataInputGetResult>& result(uint32_t slot) { return results_[slot]; }
+
+private:
+  const SharedMatchInputs& inputs_;
+  MatchInputCache* const previous_;
+  std::vector<absl::optional<DataInputGetResult>> results_;
+
+  static inline thread_local MatchInputCache* current_ = nullptr;
+};
+
 /**
  * Base class for matching against a single input.
  */
@@ -123,8 +198,11 @@ private:
 template <class DataType>
 class SingleFieldMatcher : public FieldMatcher<DataType>, Logger::Loggable<Logger::Id::matcher> {
 public:
+  // The input is extracted once per evaluation of the tree if it has a slot in the shared inputs.
   static absl::StatusOr<std::unique_ptr<SingleFieldMatcher<DataType>>>
-  create(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher) {
+  create(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher,
+         SharedMatchInputsConstSharedPtr shared_inputs = nullptr,
+         uint32_t input_slot = SharedMatchInputs::NoSlot) {
     auto supported_input_types = input_matcher->supportedDataInputTypes();
     if (supported_input_types.find(data_input->dataInputType()) == supported_input_types.end()) {
       std::string supported_types =
@@ -135,11 +213,21 @@ public:
     }
 
     return std::unique_ptr<SingleFieldMatcher<DataType>>{
-        new SingleFieldMatcher<DataType>(std::move(data_input), std::move(input_matcher))};
+        new SingleFieldMatcher<DataType>(std::move(data_input), std::move(input_matcher),
+                                         std::move(shared_inputs), input_slot)};
   }
 
   MatchResult match(const DataType& data) override {
-    const auto input = data_input_->get(data);
+    MatchInputCache* cache = shared_inputs_ != nullptr && input_slot_ != SharedMatchInputs::NoSlot
+                                 ? MatchInputCache::current(*shared_inputs_)
+                                 : nullptr;
+    absl::optional<DataInputGetResult> uncached;
+    absl::optional<DataInputGetResult>& result =
+        cache != nullptr ? cache->result(input_slot_) : uncached;
+    if (!result.has_value()) {
+      result = data_input_->get(data);
+    }
+    const DataInputGetResult& input = result.value();
 
     if (input.data_availability_ == DataInputGetResult::DataAvailability::NotAvailable) {
       return MatchResult::InsufficientData;
@@ -156,11 +244,15 @@ public:
   }
 
 private:
-  SingleFieldMatcher(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher)
-      : data_input_(std::move(data_input)), input_matcher_(std::move(input_matcher)) {}
+  SingleFieldMatcher(DataInputPtr<DataType>&& data_input, InputMatcherPtr&& input_matcher,
+                     SharedMatchInputsConstSharedPtr shared_inputs, uint32_t input_slot)
+      : data_input_(std::move(data_input)), input_matcher_(std::move(input_matcher)),
+        shared_inputs_(std::move(shared_inputs)), input_slot_(input_slot) {}
 
   const DataInputPtr<DataType> data_input_;
   const InputMatcherPtr input_matcher_;
+  const SharedMatchInputsConstSharedPtr shared_inputs_;
+  const uint32_t input_slot_;
 };
 
 template <class DataType>
@@ -10,6 +10,7 @@
 #include "envoy/matcher/matcher.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/cleanup.h"
 #include "source/common/config/utility.h"
 #include "source/common/matcher/exact_map_matcher.h"
 #include "source/common/matcher/field_matcher.h"
@@ -17,7 +18,9 @@
 #include "source/common/matcher/prefix_map_matcher.h"
 #include "source/common/matcher/validation_visitor.h"
 #include "source/common/matcher/value_input_matcher.h"
+#include "source/common/runtime/runtime_features.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
@@ -62,6 +65,66 @@ public:
   const absl::optional<OnMatch<DataType>> on_no_match_;
 };
 
+/**
+ * The root of a match tree whose predicates share inputs, which are extracted once per evaluation
+ * of the tree.
+ */
+template <class DataType> class SharedInputsMatchTree : public MatchTree<DataType> {
+public:
+  SharedInputsMatchTree(MatchTreePtr<DataType>&& tree,
+                        SharedMatchInputsConstSharedPtr shared_inputs)
+      : tree_(std::move(tree)), shared_inputs_(std::move(shared_inputs)) {}
+
+  ActionMatchResult match(const DataType& data,
+                          SkippedMatchCb skipped_match_cb = nullptr) override {
+    MatchInputCache cache(*shared_inputs_);
+    return tree_->match(data, skipped_match_cb);
+  }
+
+private:
+  const MatchTreePtr<DataType> tree_;
+  const SharedMatchInputsConstSharedPtr shared_inputs_;
+};
+
+/**
+ * An exact map matcher rewritten from a list of exact matches of a single input. As the list does,
+ * it defers the match of an absent input while more data might be available.
+ */
+template <class DataType> class ListExactMapMatcher : public ExactMapMatcher<DataType> {
+public:
+  static absl::StatusOr<std::unique_ptr<ListExactMapMatcher>>
+  create(DataInputPtr<DataType>&& data_input, absl::optional<OnMatch<DataType>> on_no_match) {
+    absl::Status creation_status = absl::OkStatus();
+    auto ret = std::unique_ptr<ListExactMapMatcher<DataType>>(
+        new ListExactMapMatcher<DataType>(std::move(data_input), on_no_match, creation_status));
+    RETURN_IF_NOT_OK_REF(creation_status);
+    return ret;
+  }
+
+  ActionMatchResult match(const DataType& data,
+                          SkippedMatchCb skipped_match_cb = nullptr) override {
+    const auto input = this->data_input_->get(data);
+    if (input.data_availability_ == DataInputGetResult::DataAvailability::NotAvailable) {
+      return ActionMatchResult::insufficientData();
+    }
+    if (absl::holds_alternative<absl::monostate>(input.data_)) {
+      if (input.data_availability_ ==
+          DataInputGetResult::DataAvailability::MoreDataMightBeAvailable) {
+        return ActionMatchResult::insufficientData();
+      }
+      return MatchTree<DataType>::handleRecursionAndSkips(this->on_no_match_, data,
+                                                          skipped_match_cb);
+    }
+    return this->doMatch(data, absl::get<std::string>(input.data_), skipped_match_cb);
+  }
+
+private:
+  ListExactMapMatcher(DataInputPtr<DataType>&& data_input,
+                      absl::optional<OnMatch<DataType>> on_no_match, absl::Status& creation_status)
+      : ExactMapMatcher<DataType>(std::move(data_input), std::move(on_no_match),
+                                  creation_status) {}
+};
+
 /**
  * Constructs a data input function for a data type.
  **/
@@ -141,15 +204,21 @@ public:
 
   // TODO(snowp): Remove this type parameter once we only have one Matcher proto.
   template <class MatcherType> MatchTreeFactoryCb<DataType> create(const MatcherType& config) {
-    switch (config.matcher_type_case()) {
-    case MatcherType::kMatcherTree:
-      return createTreeMatcher(config);
-    case MatcherType::kMatcherList:
-      return createListMatcher(config);
-    case MatcherType::MATCHER_TYPE_NOT_SET:
-      return createAnyMatcher(config);
+    // The root of the tree shares the inputs of all its predicates, including those of its nested
+    // trees.
+    if (depth_ > 0 ||
+        !Runtime::runtimeFeatureEnabled("envoy.reloadable_features.optimize_match_trees")) {
+      return createTree(config);
     }
-    PANIC_DUE_TO_CORRUPT_ENUM;
+    shared_inputs_ = std::make_shared<SharedMatchInputs>();
+    MatchTreeFactoryCb<DataType> tree_factory = createTree(config);
+    return [tree_factory, shared_inputs = std::move(shared_inputs_)]() -> MatchTreePtr<DataType> {
+      MatchTreePtr<DataType> tree = tree_factory();
+      if (!shared_inputs->anyShared()) {
+        return tree;
+      }
+      return std::make_unique<SharedInputsMatchTree<DataType>>(std::move(tree), shared_inputs);
+    };
   }
 
   absl::optional<OnMatchFactoryCb<DataType>>
@@ -163,6 +232,24 @@ public:
   }
 
 private:
+  // The minimum number of exact matches of a list rewritten into a map. Shorter lists are as fast
+  // to scan.
+  static constexpr int MinExactMatchesForMap = 4;
+
+  template <class MatcherType> MatchTreeFactoryCb<DataType> createTree(const MatcherType& config) {
+    depth_++;
+    Cleanup decrement_depth([this]() { depth_--; });
+    switch (config.matcher_type_case()) {
+    case MatcherType::kMatcherTree:
+      return createTreeMatcher(config);
+    case MatcherType::kMatcherList:
+      return createListMatcher(config);
+    case MatcherType::MATCHER_TYPE_NOT_SET:
+      return createAnyMatcher(config);
+    }
+    PANIC_DUE_TO_CORRUPT_ENUM;
+  }
+
   template <class MatcherType>
   MatchTreeFactoryCb<DataType> createAnyMatcher(const MatcherType& config) {
     auto on_no_match = createOnMatch(config.on_no_match());
@@ -174,6 +261,13 @@ private:
   }
   template <class MatcherType>
   MatchTreeFactoryCb<DataType> createListMatcher(const MatcherType& config) {
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.optimize_match_trees")) {
+      absl::optional<MatchTreeFactoryCb<DataType>> map_matcher = createListExactMapMatcher(config);
+      if (map_matcher.has_value()) {
+        return std::move(map_matcher.value());
+      }
+    }
+
     std::vector<std::pair<FieldMatcherFactoryCb<DataType>, OnMatchFactoryCb<DataType>>>
         matcher_factories;
     matcher_factories.reserve(config.matcher_list().matchers().size());
@@ -196,6 +290,48 @@ private:
     };
   }
 
+  // Rewrites a list of exact matches of the same input into a map matcher, which finds the match of
+  // the input in a single lookup. The values must be distinct, as the map has one match per value.
+  // Returns absl::nullopt if the list cannot be rewritten.
+  template <class MatcherType>
+  absl::optional<MatchTreeFactoryCb<DataType>>
+  createListExactMapMatcher(const MatcherType& config) {
+    const auto& matchers = config.matcher_list().matchers();
+    if (matchers.size() < MinExactMatchesForMap) {
+      return absl::nullopt;
+    }
+    absl::flat_hash_set<absl::string_view> values;
+    for (const auto& matcher : matchers) {
+      if (!matcher.predicate().has_single_predicate()) {
+        return absl::nullopt;
+      }
+      const auto& predicate = matcher.predicate().single_predicate();
+      if (!predicate.has_value_match() || !predicate.value_match().has_exact() ||
+          predicate.value_match().ignore_case() ||
+          !Protobuf::util::MessageDifferencer::Equals(
+              predicate.input(), matchers[0].predicate().single_predicate().input()) ||
+          !values.insert(predicate.value_match().exact()).second) {
+        return absl::nullopt;
+      }
+    }
+    auto data_input =
+        match_input_factory_.createDataInput(matchers[0].predicate().single_predicate().input());
+    if (data_input()->dataInputType() != DefaultMatchingDataType) {
+      return absl::nullopt;
+    }
+
+    std::vector<std::pair<std::string, OnMatchFactoryCb<DataType>>> match_children;
+    match_children.reserve(matchers.size());
+    for (const auto& matcher : matchers) {
+      match_children.push_back(
+          std::make_pair(matcher.predicate().single_predicate().value_match().exact(),
+                         *createOnMatch(matcher.on_match())));
+    }
+    auto on_no_match = createOnMatch(config.on_no_match());
+    return createMapMatcherWithChildren(std::move(match_children), data_input, on_no_match,
+                                        &ListExactMapMatcher<DataType>::create);
+  }
+
   template <class MatcherT, class PredicateType, class FieldPredicateType>
   FieldMatcherFactoryCb<DataType> createAggregateFieldMatcherFactoryCb(
       const Protobuf::RepeatedPtrField<FieldPredicateType>& predicates) {
@@ -222,10 +358,20 @@ private:
       auto data_input =
           match_input_factory_.createDataInput(field_predicate.single_predicate().input());
       auto input_matcher = createInputMatcher(field_predicate.single_predicate());
+      if (shared_inputs_ == nullptr) {
+        return [data_input, input_matcher]() {
+          return THROW_OR_RETURN_VALUE(
+              SingleFieldMatcher<DataType>::create(data_input(), input_matcher()),
+              std::unique_ptr<SingleFieldMatcher<DataType>>);
+        };
+      }
 
-      return [data_input, input_matcher]() {
+      const uint32_t input_index =
+          shared_inputs_->add(field_predicate.single_predicate().input().SerializeAsString());
+      return [data_input, input_matcher, shared_inputs = shared_inputs_, input_index]() {
         return THROW_OR_RETURN_VALUE(
-            SingleFieldMatcher<DataType>::create(data_input(), input_matcher()),
+            SingleFieldMatcher<DataType>::create(data_input(), input_matcher(), shared_inputs,
+                                                 shared_inputs->slot(input_index)),
             std::unique_ptr<SingleFieldMatcher<DataType>>);
       };
     }
@@ -293,8 +439,17 @@ private:
       match_children.push_back(
           std::make_pair(children.first, *MatchTreeFactory::createOnMatch(children.second)));
     }
+    return createMapMatcherWithChildren(std::move(match_children), data_input, on_no_match,
+                                        creation_function);
+  }
 
-    return [match_children, data_input, on_no_match, creation_function]() {
+  MatchTreeFactoryCb<DataType> createMapMatcherWithChildren(
+      std::vector<std::pair<std::string, OnMatchFactoryCb<DataType>>>&& match_children,
+      DataInputFactoryCb<DataType> data_input,
+      absl::optional<OnMatchFactoryCb<DataType>>& on_no_match,
+      MapCreationFunction creation_function) {
+    return [match_children = std::move(match_children), data_input, on_no_match,
+            creation_function]() {
       auto matcher_or_error = creation_function(
           data_input(), on_no_match ? absl::make_optional((*on_no_match)()) : absl::nullopt);
       THROW_IF_NOT_OK(matcher_or_error.status());
@@ -363,6 +518,10 @@ private:
   Server::Configuration::ServerFactoryContext& server_factory_context_;
   MatchTreeValidationVisitor<DataType>& on_match_validation_visitor_;
   MatchInputFactory<DataType> match_input_factory_;
+  // The inputs of the tree being created, if they are shared.
+  SharedMatchInputsSharedPtr shared_inputs_;
+  // The depth of the tree being created.
+  uint32_t depth_{0};
 };
 } // namespace Matcher
 } // namespace Envoy
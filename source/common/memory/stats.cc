@@ -1,5 +1,6 @@
 #include "source/common/memory/stats.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "source/common/common/assert.h"
@@ -127,6 +128,10 @@ AllocatorManager::AllocatorManager(
     : bytes_to_release_(config.bytes_to_release()),
       memory_release_interval_msec_(std::chrono::milliseconds(
           PROTOBUF_GET_MS_OR_DEFAULT(config, memory_release_interval, 1000))),
+      adaptive_release_(config.has_adaptive_release()),
+      retained_free_bytes_(config.adaptive_release().retained_free_bytes()),
+      release_percent_(
+          PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(config.adaptive_release(), release_percent, 10)),
       allocator_manager_stats_(MemoryAllocatorManagerStats{
           MEMORY_ALLOCATOR_MANAGER_STATS(POOL_COUNTER_PREFIX(scope, "tcmalloc."))}),
       api_(api) {
@@ -145,26 +150,46 @@ AllocatorManager::~AllocatorManager() {
 #endif
 }
 
+uint64_t AllocatorManager::adaptiveBytesToRelease(uint64_t free_bytes, uint64_t retained_free_bytes,
+                                                  double release_percent,
+                                                  uint64_t max_bytes_to_release) {
+  if (free_bytes <= retained_free_bytes) {
+    return 0;
+  }
+  const uint64_t bytes = static_cast<uint64_t>((free_bytes - retained_free_bytes) *
+                                               std::min(release_percent, 100.0) / 100);
+  return max_bytes_to_release > 0 ? std::min(bytes, max_bytes_to_release) : bytes;
+}
+
 void AllocatorManager::tcmallocRelease() {
 #if defined(TCMALLOC)
-  tcmalloc::MallocExtension::ReleaseMemoryToSystem(bytes_to_release_);
+  uint64_t bytes_to_release = bytes_to_release_;
+  if (adaptive_release_) {
+    bytes_to_release = adaptiveBytesToRelease(Stats::totalPageHeapFree(), retained_free_bytes_,
+                                              release_percent_, bytes_to_release_);
+    if (bytes_to_release == 0) {
+      return;
+    }
+  }
+  tcmalloc::MallocExtension::ReleaseMemoryToSystem(bytes_to_release);
 #endif
 }
 
 /**
  * Configures tcmalloc release rate from the page heap. If `bytes_to_release_`
- * has been initialized to `0`, no heap memory will be released in background.
+ * has been initialized to `0` and the adaptive release is not configured, no heap memory will be
+ * released in background.
  */
 void AllocatorManager::configureBackgroundMemoryRelease() {
 #if defined(GPERFTOOLS_TCMALLOC)
-  if (bytes_to_release_ > 0) {
+  if (bytes_to_release_ > 0 || adaptive_release_) {
     ENVOY_LOG_MISC(error,
                    "Memory releasing is not supported for gperf tcmalloc, no memory releasing "
                    "will be configured.");
   }
 #elif defined(TCMALLOC)
   ENVOY_BUG(!tcmalloc_thread_, "Invalid state, tcmalloc has already been initialised");
-  if (bytes_to_release_ > 0) {
+  if (bytes_to_release_ > 0 || adaptive_release_) {
     tcmalloc_routine_dispatcher_ = api_.allocateDispatcher(std::string(TCMALLOC_ROUTINE_THREAD_ID));
     memory_release_timer_ = tcmalloc_routine_dispatcher_->createTimer([this]() -> void {
       const uint64_t unmapped_bytes_before_release = Stats::totalPageHeapUnmapped();
@@ -186,10 +211,19 @@ void AllocatorManager::configureBackgroundMemoryRelease() {
           tcmalloc_routine_dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
         },
         Thread::Options{std::string(TCMALLOC_ROUTINE_THREAD_ID)});
-    ENVOY_LOG_MISC(
-        info, fmt::format(
-                  "Configured tcmalloc with background release rate: {} bytes per {} milliseconds",
-                  bytes_to_release_, memory_release_interval_msec_.count()));
+    if (adaptive_release_) {
+      ENVOY_LOG_MISC(info,
+                     fmt::format("Configured tcmalloc with adaptive background release: {}% of the "
+                                 "free bytes above {} bytes per {} milliseconds",
+                                 release_percent_, retained_free_bytes_,
+                                 memory_release_interval_msec_.count()));
+    } else {
+      ENVOY_LOG_MISC(
+          info,
+          fmt::format(
+              "Configured tcmalloc with background release rate: {} bytes per {} milliseconds",
+              bytes_to_release_, memory_release_interval_msec_.count()));
+    }
   }
 #endif
 }
@@ -78,9 +78,20 @@ public:
 
   ~AllocatorManager();
 
+  /**
+   * @return the bytes to release from a page heap with the given free bytes under the adaptive
+   *         release policy: the given percent of the free bytes above the retained ones, bounded by
+   *         max_bytes_to_release unless it is 0.
+   */
+  static uint64_t adaptiveBytesToRelease(uint64_t free_bytes, uint64_t retained_free_bytes,
+                                         double release_percent, uint64_t max_bytes_to_release);
+
 private:
   const uint64_t bytes_to_release_;
   const std::chrono::milliseconds memory_release_interval_msec_;
+  const bool adaptive_release_;
+  const uint64_t retained_free_bytes_;
+  const double release_percent_;
   MemoryAllocatorManagerStats allocator_manager_stats_;
   Api::Api& api_;
   Thread::ThreadPtr tcmalloc_thread_;
@@ -1,5 +1,7 @@
 #include "source/common/network/connection_balancer_impl.h"
 
+#include "source/common/common/logger.h"
+
 namespace Envoy {
 namespace Network {
 
@@ -34,5 +36,101 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+LoadAwareConnectionBalancerImpl::LatencyProbe::LatencyProbe(Event::Dispatcher& dispatcher,
+                                                            std::chrono::milliseconds interval)
+    : dispatcher_(dispatcher), interval_(interval),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })),
+      expected_(dispatcher.timeSource().monotonicTime() + interval) {
+  timer_->enableTimer(interval_);
+}
+
+void LoadAwareConnectionBalancerImpl::LatencyProbe::onTimer() {
+  const MonotonicTime now = dispatcher_.timeSource().monotonicTime();
+  const uint64_t sample_us =
+      now > expected_
+          ? std::chrono::duration_cast<std::chrono::microseconds>(now - expected_).count()
+          : 0;
+  // Only this thread writes the latency, so no read-modify-write is needed.
+  const uint64_t latency_us = latency_us_.load(std::memory_order_relaxed);
+  latency_us_.store(latency_us - latency_us / 8 + sample_us / 8, std::memory_order_relaxed);
+  expected_ = now + interval_;
+  timer_->enableTimer(interval_);
+}
+
+uint64_t LoadAwareConnectionBalancerImpl::Handler::load() const {
+  const uint64_t latency_us = probe_ != nullptr ? probe_->latencyUs() : 0;
+  return (handler_.numConnections() + 1) * (latency_us + BaseLatency.count());
+}
+
+LoadAwareConnectionBalancerImpl::LoadAwareConnectionBalancerImpl(
+    ThreadLocal::SlotAllocator& tls, Random::RandomGenerator& random,
+    std::chrono::milliseconds probe_interval)
+    : random_(random), tls_(ThreadLocal::TypedSlot<LatencyProbe>::makeUnique(tls)) {
+  tls_->set([probe_interval](Event::Dispatcher& dispatcher) {
+    return std::make_shared<LatencyProbe>(dispatcher, probe_interval);
+  });
+}
+
+void LoadAwareConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  // Handlers are registered on the thread running them, so the probe of the current thread
+  // measures the latency of the handler's worker.
+  OptRef<LatencyProbe> probe = tls_->get();
+  absl::MutexLock lock(lock_);
+  owned_handlers_.push_back(
+      std::make_unique<Handler>(handler, probe.has_value() ? &probe.ref() : nullptr));
+  Handler* new_handler = owned_handlers_.back().get();
+  const uint32_t num_handlers = num_handlers_.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < num_handlers; ++i) {
+    if (handlers_[i].load(std::memory_order_relaxed) == nullptr) {
+      handlers_[i].store(new_handler, std::memory_order_release);
+      return;
+    }
+  }
+  if (num_handlers == MaxHandlers) {
+    ENVOY_LOG_MISC(warn, "load aware connection balancer has more than {} handlers, a handler will "
+                         "not receive connections from other handlers",
+                   MaxHandlers);
+    return;
+  }
+  handlers_[num_handlers].store(new_handler, std::memory_order_release);
+  num_handlers_.store(num_handlers + 1, std::memory_order_release);
+}
+
+void LoadAwareConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(lock_);
+  const uint32_t num_handlers = num_handlers_.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < num_handlers; ++i) {
+    Handler* registered = handlers_[i].load(std::memory_order_relaxed);
+    if (registered != nullptr && &registered->handler_ == &handler) {
+      handlers_[i].store(nullptr, std::memory_order_release);
+      return;
+    }
+  }
+}
+
+LoadAwareConnectionBalancerImpl::Handler*
+LoadAwareConnectionBalancerImpl::randomHandler(uint32_t num_handlers) {
+  return handlers_[random_.random() % num_handlers].load(std::memory_order_acquire);
+}
+
+BalancedConnectionHandler&
+LoadAwareConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler) {
+  const uint32_t num_handlers = num_handlers_.load(std::memory_order_acquire);
+  if (num_handlers == 0) {
+    current_handler.incNumConnections();
+    return current_handler;
+  }
+  Handler* first = randomHandler(num_handlers);
+  Handler* second = randomHandler(num_handlers);
+  BalancedConnectionHandler* target = &current_handler;
+  if (first != nullptr && second != nullptr) {
+    target = first->load() <= second->load() ? &first->handler_ : &second->handler_;
+  } else if (first != nullptr || second != nullptr) {
+    target = first != nullptr ? &first->handler_ : &second->handler_;
+  }
+  target->incNumConnections();
+  return *target;
+}
+
 } // namespace Network
 } // namespace Envoy
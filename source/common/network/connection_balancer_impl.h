@@ -1,9 +1,19 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
 #include "envoy/config/listener/v3/listener.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
 #include "envoy/server/filter_config.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/protobuf/protobuf.h"
 
@@ -44,6 +54,76 @@ private:
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that balances by load without holding a lock. Each
+ * connection is sent to the less loaded of two randomly chosen handlers ("power of two choices"),
+ * which avoids sending all connections to the same handler between two load updates. The load of a
+ * handler is its number of connections weighted by the event loop latency of the worker running it,
+ * so that workers slowed down by a few busy connections (e.g., long lived gRPC streams) receive
+ * fewer new connections. The event loop latency of a worker is the delay with which it runs a
+ * timer, measured every probe interval.
+ */
+class LoadAwareConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  // Maximum number of handlers that can be picked. Handlers registered beyond the limit keep their
+  // own connections but are not sent connections by other handlers.
+  static constexpr uint32_t MaxHandlers = 1024;
+  // Event loop latency added to the measured one when weighting connection counts, so that the
+  // load of idle workers is driven by their connection counts.
+  static constexpr std::chrono::microseconds BaseLatency{1000};
+
+  LoadAwareConnectionBalancerImpl(ThreadLocal::SlotAllocator& tls,
+                                  Random::RandomGenerator& random,
+                                  std::chrono::milliseconds probe_interval);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+
+private:
+  // Measures the event loop latency of a worker.
+  class LatencyProbe : public ThreadLocal::ThreadLocalObject {
+  public:
+    LatencyProbe(Event::Dispatcher& dispatcher, std::chrono::milliseconds interval);
+
+    // Exponentially weighted moving average of the event loop latency, in microseconds.
+    uint64_t latencyUs() const { return latency_us_.load(std::memory_order_relaxed); }
+
+  private:
+    void onTimer();
+
+    Event::Dispatcher& dispatcher_;
+    const std::chrono::milliseconds interval_;
+    const Event::TimerPtr timer_;
+    MonotonicTime expected_;
+    std::atomic<uint64_t> latency_us_{0};
+  };
+
+  struct Handler {
+    Handler(BalancedConnectionHandler& handler, const LatencyProbe* probe)
+        : handler_(handler), probe_(probe) {}
+
+    uint64_t load() const;
+
+    BalancedConnectionHandler& handler_;
+    // Null if the handler is not run by a thread with a probe.
+    const LatencyProbe* const probe_;
+  };
+
+  Handler* randomHandler(uint32_t num_handlers);
+
+  Random::RandomGenerator& random_;
+  ThreadLocal::TypedSlotPtr<LatencyProbe> tls_;
+  absl::Mutex lock_;
+  // Handlers are only freed with the balancer, so that a handler read from handlers_ stays valid
+  // while unregistered concurrently.
+  std::vector<std::unique_ptr<Handler>> owned_handlers_ ABSL_GUARDED_BY(lock_);
+  // The first num_handlers_ entries are registered handlers, or null for unregistered ones.
+  std::array<std::atomic<Handler*>, MaxHandlers> handlers_{};
+  std::atomic<uint32_t> num_handlers_{0};
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/platform.h"
+#include "envoy/network/address.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/utility.h"
+
+#include "absl/container/node_hash_set.h"
+#include "absl/numeric/bits.h"
+#include "absl/numeric/int128.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Network {
+namespace Poptrie {
+
+/**
+ * Number of leading address bits indexing the direct pointing array of a Poptrie.
+ */
+constexpr uint32_t DirectPointingBits = 16;
+
+/**
+ * Number of address bits consumed by each node below the direct pointing array. Six bits make the
+ * children and leaves bitmaps of a node fit in 64-bit words.
+ */
+constexpr uint32_t Stride = 6;
+
+/**
+ * Poptrie for associating data with CIDR ranges, with the same lookup semantics as LcTrie. Both
+ * IPv4 and IPv6 addresses are supported within this class with no calling pattern changes.
+ *
+ * The algorithm is described in the paper 'Poptrie: A Compressed Trie with Population Count for
+ * Fast and Scalable Software IP Routing Table Lookup' by 'H. Asai' and 'Y. Ohara'. The first
+ * DirectPointingBits of an address index a direct pointing array, and the remaining bits are
+ * consumed Stride at a time by multiway nodes whose children and leaves are stored contiguously
+ * and found with the population count of a bitmap. Runs of identical leaves are compressed into a
+ * single one, so the memory grows with the number of CIDR ranges rather than with their spread.
+ *
+ * Unlike LcTrie, it has no limit on the number of CIDR ranges, and ranges can be added and removed
+ * after construction, which only rebuilds the sub-tries under the direct pointing entries the range
+ * covers. Updates are not thread safe, and must not run concurrently with lookups.
+ */
+template <class T> class Poptrie {
+public:
+  /**
+   * @param data supplies a vector of data and CIDR ranges.
+   * @param exclusive if true then only data for the most specific subnet will be returned
+                      (i.e. data isn't inherited from wider ranges).
+   */
+  Poptrie(const std::vector<std::pair<T, std::vector<Address::CidrRange>>>& data,
+          bool exclusive = false)
+      : ipv4_trie_(exclusive), ipv6_trie_(exclusive) {
+    for (const auto& pair_data : data) {
+      for (const auto& cidr_range : pair_data.second) {
+        if (cidr_range.ip()->version() == Address::IpVersion::v4) {
+          ipv4_trie_.add(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(),
+                         pair_data.first);
+        } else {
+          ipv6_trie_.add(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
+                         cidr_range.length(), pair_data.first);
+        }
+      }
+    }
+    ipv4_trie_.build();
+    ipv6_trie_.build();
+  }
+
+  /**
+   * Retrieve data associated with the CIDR range that contains `ip_address`. Both IPv4 and IPv6
+   * addresses are supported.
+   * @param ip_address supplies an IP address.
+   * @return a vector of data from the CIDR ranges and IP addresses that contains 'ip_address'. An
+   * empty vector is returned if no prefix contains 'ip_address' or there is no data for the IP
+   * version of the ip_address.
+   */
+  std::vector<T> getData(const Network::Address::InstanceConstSharedPtr& ip_address) const {
+    if (ip_address->ip()->version() == Address::IpVersion::v4) {
+      return ipv4_trie_.getData(ntohl(ip_address->ip()->ipv4()->address()));
+    } else {
+      return ipv6_trie_.getData(Utility::Ip6ntohl(ip_address->ip()->ipv6()->address()));
+    }
+  }
+
+  /**
+   * Associates data with a CIDR range.
+   * @param cidr_range supplies the CIDR range.
+   * @param data supplies the data, which is ignored if it is already associated with the range.
+   */
+  void insert(const Address::CidrRange& cidr_range, const T& data) {
+    if (cidr_range.ip()->version() == Address::IpVersion::v4) {
+      ipv4_trie_.insert(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(), data);
+    } else {
+      ipv6_trie_.insert(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()), cidr_range.length(),
+                        data);
+    }
+  }
+
+  /**
+   * Dissociates data from a CIDR range.
+   * @param cidr_range supplies the CIDR range.
+   * @param data supplies the data.
+   * @return whether the data was associated with the range.
+   */
+  bool remove(const Address::CidrRange& cidr_range, const T& data) {
+    if (cidr_range.ip()->version() == Address::IpVersion::v4) {
+      return ipv4_trie_.remove(ntohl(cidr_range.ip()->ipv4()->address()), cidr_range.length(),
+                               data);
+    } else {
+      return ipv6_trie_.remove(Utility::Ip6ntohl(cidr_range.ip()->ipv6()->address()),
+                               cidr_range.length(), data);
+    }
+  }
+
+private:
+  using Ipv4 = uint32_t;
+  using Ipv6 = absl::uint128;
+  using DataSet = absl::node_hash_set<T>;
+
+  /**
+   * The Poptrie of an IP version.
+   * @tparam IpType either Ipv4 or Ipv6.
+   * @tparam address_size the number of bits of an address.
+   */
+  template <class IpType, uint32_t address_size = CHAR_BIT * sizeof(IpType)>
+  class PoptrieInternal {
+  public:
+    explicit PoptrieInternal(bool exclusive) : exclusive_(exclusive) {}
+
+    /**
+     * Associates data with a prefix without updating the lookup structure, see build().
+     */
+    void add(IpType ip, uint32_t length, const T& data) {
+      prefixes_[{mask(ip, length), length}].data_.insert(data);
+    }
+
+    /**
+     * Builds the lookup structure of all the prefixes from scratch.
+     */
+    void build() {
+      direct_.clear();
+      if (prefixes_.empty()) {
+        return;
+      }
+      updateResults(prefixes_.begin(), prefixes_.end(), nullptr);
+      direct_.resize(1u << DirectPointingBits);
+      for (uint32_t i = 0; i < direct_.size(); i++) {
+        buildDirectEntry(i);
+      }
+    }
+
+    void insert(IpType ip, uint32_t length, const T& data) {
+      ip = mask(ip, length);
+      if (prefixes_[{ip, length}].data_.insert(data).second) {
+        update(ip, length);
+      }
+    }
+
+    bool remove(IpType ip, uint32_t length, const T& data) {
+      ip = mask(ip, length);
+      auto it = prefixes_.find({ip, length});
+      if (it == prefixes_.end() || it->second.data_.erase(data) == 0) {
+        return false;
+      }
+      if (it->second.data_.empty()) {
+        prefixes_.erase(it);
+      }
+      update(ip, length);
+      return true;
+    }
+
+    std::vector<T> getData(const IpType& ip_address) const {
+      const Prefix* prefix = lookup(ip_address);
+      return prefix != nullptr ? prefix->result_ : std::vector<T>();
+    }
+
+  private:
+    // A prefix ordered by address then length, so that the prefixes nested in another follow it.
+    using Key = std::pair<IpType, uint32_t>;
+
+    struct Prefix {
+      // The data associated with the prefix.
+      DataSet data_;
+      // The data returned for the addresses whose most specific prefix is this one.
+      std::vector<T> result_;
+    };
+    using PrefixMap = std::map<Key, Prefix>;
+    using PrefixEntry = typename PrefixMap::value_type;
+
+    // A node consuming Stride bits of the address. The chunk of the address it consumes selects
+    // either a child, at base1_ plus the number of children before the chunk, or a leaf, at
+    // base0_ plus the number of distinct leaves before the chunk.
+    struct Node {
+      // The chunks with a child.
+      uint64_t vector_;
+      // The chunks starting a run of leaves with the same prefix.
+      uint64_t leafvec_;
+      uint32_t base0_;
+      uint32_t base1_;
+    };
+
+    // The nodes of the addresses sharing the bits of a direct pointing entry.
+    struct SubTrie {
+      std::vector<Node> nodes_;
+      std::vector<const Prefix*> leaves_;
+    };
+
+    struct DirectEntry {
+      // The most specific prefix of at most DirectPointingBits containing the entry. Only used
+      // when the entry has no sub-trie.
+      const Prefix* prefix_{};
+      std::unique_ptr<SubTrie> trie_;
+    };
+
+    static IpType mask(IpType ip, uint32_t length) {
+      return length == 0 ? IpType(0) : ip >> (address_size - length) << (address_size - length);
+    }
+
+    static IpType hostMask(uint32_t length) {
+      return length == address_size ? IpType(0) : ~IpType(0) >> length;
+    }
+
+    // Extracts n bits of the address starting at bit p, 0 being the most significant bit.
+    static uint32_t extractBits(uint32_t p, uint32_t n, IpType input) {
+      return static_cast<uint32_t>(input << p >> (address_size - n));
+    }
+
+    static uint64_t lowMask(uint32_t n) { return n >= 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1; }
+
+    static bool contains(const Key& outer, const Key& inner) {
+      return outer.second <= inner.second && mask(inner.first, outer.second) == outer.first;
+    }
+
+    // The most specific prefix of at most `length` bits containing the address.
+    const Prefix* ancestor(IpType ip, uint32_t length) const {
+      for (uint32_t l = length + 1; l-- > 0;) {
+        auto it = prefixes_.find({mask(ip, l), l});
+        if (it != prefixes_.end()) {
+          return &it->second;
+        }
+      }
+      return nullptr;
+    }
+
+    // Computes the results of a sorted range of prefixes, all nested in the parent.
+    void updateResults(typename PrefixMap::iterator begin, typename PrefixMap::iterator end,
+                       const Prefix* parent) {
+      std::vector<std::pair<const Key*, const Prefix*>> ancestors;
+      for (auto it = begin; it != end; ++it) {
+        while (!ancestors.empty() && !contains(*ancestors.back().first, it->first)) {
+          ancestors.pop_back();
+        }
+        const Prefix* nearest = ancestors.empty() ? parent : ancestors.back().second;
+        Prefix& prefix = it->second;
+        if (exclusive_ || nearest == nullptr) {
+          prefix.result_.assign(prefix.data_.begin(), prefix.data_.end());
+        } else {
+          DataSet result(prefix.data_);
+          result.insert(nearest->result_.begin(), nearest->result_.end());
+          prefix.result_.assign(result.begin(), result.end());
+        }
+        ancestors.emplace_back(&it->first, &prefix);
+      }
+    }
+
+    // Updates the results and the lookup structure after a change of the data of a prefix.
+    void update(IpType ip, uint32_t length) {
+      if (prefixes_.empty()) {
+        direct_.clear();
+        return;
+      }
+      if (direct_.empty()) {
+        build();
+        return;
+      }
+      updateResults(prefixes_.lower_bound({ip, length}),
+                    prefixes_.upper_bound({ip | hostMask(length), address_size}),
+                    length > 0 ? ancestor(ip, length - 1) : nullptr);
+      const uint32_t first = extractBits(0, DirectPointingBits, ip);
+      const uint32_t count =
+          length >= DirectPointingBits ? 1 : 1u << (DirectPointingBits - length);
+      for (uint32_t i = first; i < first + count; i++) {
+        buildDirectEntry(i);
+      }
+    }
+
+    void buildDirectEntry(uint32_t index) {
+      const IpType low = IpType(index) << (address_size - DirectPointingBits);
+      const IpType high = low | hostMask(DirectPointingBits);
+      DirectEntry& entry = direct_[index];
+      entry.prefix_ = ancestor(low, DirectPointingBits);
+      entry.trie_.reset();
+
+      std::vector<const PrefixEntry*> nested;
+      for (auto it = prefixes_.lower_bound({low, DirectPointingBits + 1});
+           it != prefixes_.end() && it->first.first <= high; ++it) {
+        nested.push_back(&*it);
+      }
+      if (nested.empty()) {
+        return;
+      }
+      entry.trie_ = std::make_unique<SubTrie>();
+      entry.trie_->nodes_.emplace_back();
+      buildNode(*entry.trie_, 0, DirectPointingBits, entry.prefix_, nested);
+    }
+
+    // Builds the node at `index` consuming the bits from `position`, from the sorted prefixes
+    // nested in it which are longer than `position` bits.
+    void buildNode(SubTrie& trie, uint32_t index, uint32_t position, const Prefix* inherited,
+                   absl::Span<const PrefixEntry* const> prefixes) {
+      const uint32_t stride = std::min(Stride, address_size - position);
+      const uint32_t end = position + stride;
+
+      // The prefixes ending in this node cover a run of chunks, the longer overriding the shorter.
+      const Prefix* leaves[1u << Stride];
+      std::fill(leaves, leaves + (1u << stride), inherited);
+      std::vector<const PrefixEntry*> ending;
+      std::vector<const PrefixEntry*> longer;
+      for (const PrefixEntry* prefix : prefixes) {
+        (prefix->first.second <= end ? ending : longer).push_back(prefix);
+      }
+      std::stable_sort(ending.begin(), ending.end(),
+                       [](const PrefixEntry* lhs, const PrefixEntry* rhs) {
+        return lhs->first.second < rhs->first.second;
+      });
+      for (const PrefixEntry* prefix : ending) {
+        const uint32_t first = extractBits(position, stride, prefix->first.first);
+        std::fill(leaves + first, leaves + first + (1u << (end - prefix->first.second)),
+                  &prefix->second);
+      }
+
+      // The longer prefixes are grouped by chunk into the children, contiguous since sorted.
+      std::vector<std::pair<uint32_t, size_t>> children;
+      for (size_t i = 0; i < longer.size(); i++) {
+        const uint32_t chunk = extractBits(position, stride, longer[i]->first.first);
+        if (children.empty() || children.back().first != chunk) {
+          children.emplace_back(chunk, i);
+        }
+      }
+      Node node{0, 0, static_cast<uint32_t>(trie.leaves_.size()),
+                static_cast<uint32_t>(trie.nodes_.size())};
+      for (const auto& child : children) {
+        node.vector_ |= uint64_t(1) << child.first;
+      }
+      for (uint32_t chunk = 0; chunk < (1u << stride); chunk++) {
+        if ((node.vector_ >> chunk) & 1) {
+          continue;
+        }
+        if (node.leafvec_ == 0 || trie.leaves_.back() != leaves[chunk]) {
+          node.leafvec_ |= uint64_t(1) << chunk;
+          trie.leaves_.push_back(leaves[chunk]);
+        }
+      }
+      trie.nodes_[index] = node;
+      trie.nodes_.resize(trie.nodes_.size() + children.size());
+
+      for (size_t i = 0; i < children.size(); i++) {
+        const size_t first = children[i].second;
+        const size_t last = i + 1 < children.size() ? children[i + 1].second : longer.size();
+        buildNode(trie, node.base1_ + i, end, leaves[children[i].first],
+                  absl::MakeConstSpan(longer).subspan(first, last - first));
+      }
+    }
+
+    const Prefix* lookup(const IpType& ip_address) const {
+      if (direct_.empty()) {
+        return nullptr;
+      }
+      const DirectEntry& entry = direct_[extractBits(0, DirectPointingBits, ip_address)];
+      if (entry.trie_ == nullptr) {
+        return entry.prefix_;
+      }
+      const SubTrie& trie = *entry.trie_;
+      const Node* node = &trie.nodes_[0];
+      uint32_t position = DirectPointingBits;
+      while (true) {
+        const uint32_t stride = std::min(Stride, address_size - position);
+        const uint32_t chunk = extractBits(position, stride, ip_address);
+        if (!((node->vector_ >> chunk) & 1)) {
+          return trie.leaves_[node->base0_ + absl::popcount(node->leafvec_ & lowMask(chunk + 1)) -
+                              1];
+        }
+        node = &trie.nodes_[node->base1_ + absl::popcount(node->vector_ & lowMask(chunk))];
+        position += stride;
+      }
+    }
+
+    const bool exclusive_;
+    PrefixMap prefixes_;
+    // Empty while there are no prefixes, otherwise indexed by the first DirectPointingBits.
+    std::vector<DirectEntry> direct_;
+  };
+
+  PoptrieInternal<Ipv4> ipv4_trie_;
+  PoptrieInternal<Ipv6> ipv6_trie_;
+};
+
+} // namespace Poptrie
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,91 @@
+#include "source/common/network/reuse_port_cpu_steering.h"
+
+#include "envoy/common/platform.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+
+#ifdef __linux__
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+#include "fmt/format.h"
+
+namespace Envoy {
+namespace Network {
+
+std::vector<uint32_t> ReusePortCpuSteering::allowedCpus() {
+  std::vector<uint32_t> cpus;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    return cpus;
+  }
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &mask)) {
+      cpus.push_back(cpu);
+    }
+  }
+#endif
+  return cpus;
+}
+
+absl::optional<uint32_t> ReusePortCpuSteering::cpuForWorker(uint32_t worker_index) {
+  const std::vector<uint32_t> cpus = allowedCpus();
+  if (cpus.empty()) {
+    return absl::nullopt;
+  }
+  return cpus[worker_index % cpus.size()];
+}
+
+#ifdef __linux__
+std::vector<sock_filter> ReusePortCpuSteering::buildProgram(const std::vector<uint32_t>& cpus,
+                                                            uint32_t num_sockets) {
+  ASSERT(num_sockets > 0);
+  std::vector<sock_filter> program;
+  program.reserve(2 * cpus.size() + 2);
+  // A = current CPU.
+  program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, SKF_AD_OFF + SKF_AD_CPU));
+  // The socket of the worker of the i-th CPU is the (i % num_sockets)-th socket.
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, cpus[i], 0, 1));
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(i % num_sockets)));
+  }
+  program.push_back(BPF_STMT(BPF_RET | BPF_K, num_sockets));
+  return program;
+}
+#endif
+
+absl::Status ReusePortCpuSteering::attach(Socket& socket, uint32_t num_sockets) {
+#ifdef __linux__
+  const std::vector<uint32_t> cpus = allowedCpus();
+  if (cpus.empty()) {
+    return absl::InvalidArgumentError("cannot steer reuse port connections: unknown CPU set");
+  }
+  std::vector<sock_filter> program = buildProgram(cpus, num_sockets);
+  if (program.size() > BPF_MAXINSNS) {
+    return absl::InvalidArgumentError(fmt::format(
+        "cannot steer reuse port connections: too many CPUs for a program ({})", cpus.size()));
+  }
+  sock_fprog fprog{static_cast<unsigned short>(program.size()), program.data()};
+  const Api::SysCallIntResult result =
+      socket.setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog));
+  if (result.return_value_ != 0) {
+    return absl::InvalidArgumentError(
+        fmt::format("cannot attach reuse port CPU steering program: errno={}", result.errno_));
+  }
+  return absl::OkStatus();
+#else
+  UNREFERENCED_PARAMETER(socket);
+  UNREFERENCED_PARAMETER(num_sockets);
+  return absl::InvalidArgumentError("reuse port CPU steering is only supported on Linux");
+#endif
+}
+
+} // namespace Network
+} // namespace Envoy
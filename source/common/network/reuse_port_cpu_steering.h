@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/network/socket.h"
+
+#include "absl/status/status.h"
+#include "absl/types/optional.h"
+
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Steering of the connections accepted by a reuse port group of listen sockets, one per worker, to
+ * the worker running on the CPU that handles the connection's packets, so that a connection is
+ * processed from the NIC queue to the worker on the same CPU. Worker `i` runs on the `i`th allowed
+ * CPU, modulo the number of allowed CPUs, and its socket must be the `i`th socket of the group.
+ * Only supported on Linux.
+ */
+class ReusePortCpuSteering {
+public:
+  /**
+   * @return the CPUs the process may run on, in increasing order. Empty if they are unknown.
+   */
+  static std::vector<uint32_t> allowedCpus();
+
+  /**
+   * @return the CPU to run the worker with the given index on, or absl::nullopt if the allowed
+   * CPUs are unknown.
+   */
+  static absl::optional<uint32_t> cpuForWorker(uint32_t worker_index);
+
+  /**
+   * Attaches the steering program to the reuse port group of a listen socket. The program applies
+   * to the whole group, so attaching it to one socket of the group is enough.
+   * @param socket a listen socket of the group.
+   * @param num_sockets the number of sockets of the group, i.e. the number of workers.
+   */
+  static absl::Status attach(Socket& socket, uint32_t num_sockets);
+
+#ifdef __linux__
+  /**
+   * @return a classic BPF program returning the index of the socket of the worker running on the
+   * current CPU among `num_sockets` sockets, or an out of range index for CPUs not in `cpus`,
+   * which makes the kernel fall back to hashing.
+   */
+  static std::vector<sock_filter> buildProgram(const std::vector<uint32_t>& cpus,
+                                               uint32_t num_sockets);
+#endif
+};
+
+} // namespace Network
+} // namespace Envoy
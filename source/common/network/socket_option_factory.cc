@@ -166,6 +166,25 @@ std::unique_ptr<Socket::Options> SocketOptionFactory::buildRxQueueOverFlowOption
   return options;
 }
 
+std::unique_ptr<Socket::Options>
+SocketOptionFactory::buildBusyPollOptions(std::chrono::microseconds busy_poll_duration) {
+  std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
+#ifdef SO_BUSY_POLL
+  options->push_back(std::make_shared<Network::SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_PREBIND,
+      ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_BUSY_POLL),
+      static_cast<int>(busy_poll_duration.count())));
+#else
+  UNREFERENCED_PARAMETER(busy_poll_duration);
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+  options->push_back(std::make_shared<Network::SocketOptionImpl>(
+      envoy::config::core::v3::SocketOption::STATE_PREBIND,
+      ENVOY_MAKE_SOCKET_OPTION_NAME(SOL_SOCKET, SO_PREFER_BUSY_POLL), 1));
+#endif
+  return options;
+}
+
 std::unique_ptr<Socket::Options> SocketOptionFactory::buildReusePortOptions() {
   std::unique_ptr<Socket::Options> options = std::make_unique<Socket::Options>();
   options->push_back(std::make_shared<Network::SocketOptionImpl>(
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/common/platform.h"
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/network/socket.h"
@@ -53,6 +55,8 @@ public:
   static std::unique_ptr<Socket::Options> buildZeroSoLingerOptions();
   static std::unique_ptr<Socket::Options> buildIpRecvTosOptions();
   static std::unique_ptr<Socket::Options> buildBindAddressNoPort();
+  static std::unique_ptr<Socket::Options>
+  buildBusyPollOptions(std::chrono::microseconds busy_poll_duration);
   /**
    * @param supports_v4_mapped_v6_addresses true if this option is to be applied to a v6 socket with
    * v4-mapped v6 address(i.e. ::ffff:172.21.0.6) support.
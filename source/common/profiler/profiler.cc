@@ -1,9 +1,14 @@
 #include "source/common/profiler/profiler.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
 
 #include "source/common/common/thread.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/match.h"
+
 #ifdef PROFILER_AVAILABLE
 
 #include "gperftools/heap-profiler.h"
@@ -64,6 +69,7 @@ bool Heap::stopProfiler() { return false; }
 
 #ifdef TCMALLOC
 
+#include "absl/debugging/symbolize.h"
 #include "tcmalloc/malloc_extension.h"
 #include "tcmalloc/profile_marshaler.h"
 
@@ -100,6 +106,47 @@ absl::StatusOr<std::string> TcmallocProfiler::stopAllocationProfile() {
   return result;
 }
 
+absl::StatusOr<std::vector<TcmallocProfiler::SubsystemHeapUsage>>
+TcmallocProfiler::tcmallocHeapBySubsystem() {
+  const auto profile = tcmalloc::MallocExtension::SnapshotCurrent(tcmalloc::ProfileType::kHeap);
+  // The samples share most of their frames, which are only symbolized once.
+  absl::flat_hash_map<const void*, absl::string_view> frame_subsystems;
+  absl::flat_hash_map<absl::string_view, SubsystemHeapUsage> usage;
+  profile.Iterate([&](const tcmalloc::Profile::Sample& sample) {
+    absl::string_view subsystem = "other";
+    for (int i = 0; i < sample.depth; ++i) {
+      auto it = frame_subsystems.find(sample.stack[i]);
+      if (it == frame_subsystems.end()) {
+        char symbol[1024];
+        absl::string_view frame_subsystem;
+        if (absl::Symbolize(sample.stack[i], symbol, sizeof(symbol))) {
+          frame_subsystem = subsystemOfFunction(symbol);
+        }
+        it = frame_subsystems.emplace(sample.stack[i], frame_subsystem).first;
+      }
+      if (!it->second.empty()) {
+        subsystem = it->second;
+        break;
+      }
+    }
+    SubsystemHeapUsage& subsystem_usage = usage[subsystem];
+    subsystem_usage.bytes_ += sample.sum;
+    subsystem_usage.allocations_ += sample.count;
+  });
+
+  std::vector<SubsystemHeapUsage> result;
+  result.reserve(usage.size());
+  for (auto& [subsystem, subsystem_usage] : usage) {
+    subsystem_usage.subsystem_ = std::string(subsystem);
+    result.push_back(std::move(subsystem_usage));
+  }
+  std::sort(result.begin(), result.end(),
+            [](const SubsystemHeapUsage& a, const SubsystemHeapUsage& b) {
+              return a.bytes_ > b.bytes_;
+            });
+  return result;
+}
+
 } // namespace Profiler
 } // namespace Envoy
 
@@ -123,7 +170,38 @@ absl::StatusOr<std::string> TcmallocProfiler::stopAllocationProfile() {
                       "Allocation profile is not implemented in current build");
 }
 
+absl::StatusOr<std::vector<TcmallocProfiler::SubsystemHeapUsage>>
+TcmallocProfiler::tcmallocHeapBySubsystem() {
+  return absl::Status(absl::StatusCode::kUnimplemented,
+                      "Heap profile is not implemented in current build");
+}
+
 } // namespace Profiler
 } // namespace Envoy
 
 #endif // #ifdef TCMALLOC
+
+namespace Envoy {
+namespace Profiler {
+
+absl::string_view TcmallocProfiler::subsystemOfFunction(absl::string_view function) {
+  // The prefixes of the function names of each subsystem.
+  static constexpr std::pair<absl::string_view, absl::string_view> FunctionPrefixes[] = {
+      {"Envoy::Buffer::", "buffers"},
+      {"Envoy::Http::Header", "headers"},
+      {"Envoy::Http::TypedHeaderMapImpl", "headers"},
+      {"Envoy::Stats::", "stats"},
+      {"Envoy::Config::", "config"},
+      {"Envoy::MessageUtil::", "config"},
+      {"google::protobuf::", "config"},
+  };
+  for (const auto& [prefix, subsystem] : FunctionPrefixes) {
+    if (absl::StartsWith(function, prefix)) {
+      return subsystem;
+    }
+  }
+  return {};
+}
+
+} // namespace Profiler
+} // namespace Envoy
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 
 // Profiling support is provided in the release tcmalloc of `gperftools`, but not in the library
 // that supplies the debug tcmalloc. So all the profiling code must be ifdef'd
@@ -70,11 +73,33 @@ public:
  */
 class TcmallocProfiler {
 public:
+  /**
+   * The sampled live heap attributed to a subsystem of Envoy.
+   */
+  struct SubsystemHeapUsage {
+    std::string subsystem_;
+    // The estimated size and number of the allocations.
+    int64_t bytes_{0};
+    int64_t allocations_{0};
+  };
+
   TcmallocProfiler() = default;
 
   static absl::StatusOr<std::string> tcmallocHeapProfile();
   static absl::Status startAllocationProfile();
   static absl::StatusOr<std::string> stopAllocationProfile();
+
+  /**
+   * @return the sampled live heap by subsystem, largest first. Each allocation is attributed to
+   *         the subsystem of the innermost function of its stack that is in one, or to "other".
+   */
+  static absl::StatusOr<std::vector<SubsystemHeapUsage>> tcmallocHeapBySubsystem();
+
+  /**
+   * @return the subsystem of a demangled function name, e.g. "buffers" for the functions of the
+   *         Envoy::Buffer namespace, or an empty view if it is in none.
+   */
+  static absl::string_view subsystemOfFunction(absl::string_view function);
 };
 
 } // namespace Profiler
@@ -229,6 +229,23 @@ uint64_t reflectionHashMessage(const Protobuf::Message& message, uint64_t seed)
 
 uint64_t hash(const Protobuf::Message& message) { return reflectionHashMessage(message, 0); }
 
+uint64_t hashIgnoringField(const Protobuf::Message& message, int field_number) {
+  using Protobuf::FieldDescriptor;
+  const Protobuf::Descriptor* descriptor = message.GetDescriptor();
+  if (descriptor->well_known_type() == Protobuf::Descriptor::WELLKNOWNTYPE_ANY) {
+    return hash(message);
+  }
+  uint64_t seed = HashUtil::xxHash64(descriptor->full_name(), 0);
+  std::vector<const FieldDescriptor*> fields;
+  message.GetReflection()->ListFields(message, &fields);
+  for (const FieldDescriptor* field : fields) {
+    if (field->number() != field_number) {
+      seed = reflectionHashField(message, *field, seed);
+    }
+  }
+  return HashUtil::xxHash64("\x17", seed);
+}
+
 } // namespace DeterministicProtoHash
 } // namespace Envoy
 #endif
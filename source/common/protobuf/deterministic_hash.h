@@ -21,6 +21,10 @@ namespace DeterministicProtoHash {
 // ignore unknown fields, or not to.
 uint64_t hash(const Protobuf::Message& message);
 
+// The same as hash() of the message with the top level field of field_number cleared, without
+// copying the message. This lets a large repeated field be hashed one element at a time instead.
+uint64_t hashIgnoringField(const Protobuf::Message& message, int field_number);
+
 } // namespace DeterministicProtoHash
 } // namespace Envoy
 #endif
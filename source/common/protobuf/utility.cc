@@ -171,6 +171,15 @@ size_t MessageUtil::hash(const Protobuf::Message& message) {
 #endif
 }
 
+size_t MessageUtil::hashIgnoringField(const Protobuf::Message& message, int field_number) {
+#if defined(ENVOY_ENABLE_FULL_PROTOS)
+  return DeterministicProtoHash::hashIgnoringField(message, field_number);
+#else
+  UNREFERENCED_PARAMETER(field_number);
+  return hash(message);
+#endif
+}
+
 #if !defined(ENVOY_ENABLE_FULL_PROTOS)
 // NOLINTNEXTLINE(readability-identifier-naming)
 bool MessageLiteDifferencer::Equals(const Protobuf::Message& message1,
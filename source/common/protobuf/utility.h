@@ -256,6 +256,12 @@ public:
    */
   static std::size_t hash(const Protobuf::Message& message);
 
+  /**
+   * The hash of a message but one of its top level fields, as hash() of the message with the field
+   * cleared. Without full protos, the field is hashed too.
+   */
+  static std::size_t hashIgnoringField(const Protobuf::Message& message, int field_number);
+
 #ifdef ENVOY_ENABLE_YAML
   static void loadFromJson(absl::string_view json, Protobuf::Message& message,
                            ProtobufMessage::ValidationVisitor& validation_visitor);
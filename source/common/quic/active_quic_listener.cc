@@ -231,8 +231,12 @@ void ActiveQuicListener::shutdownListener(const Network::ExtraShutdownListenerOp
 }
 
 uint32_t ActiveQuicListener::destination(const Network::UdpRecvData& data) const {
+  const uint32_t expected_worker_index =
+      select_connection_id_worker_(*data.buffer_, worker_index_);
+  if (expected_worker_index != worker_index_) {
+    udp_stats_.downstream_rx_datagram_misrouted_.inc();
+  }
   if (kernel_worker_routing_) {
-    uint32_t expected_worker_index = select_connection_id_worker_(*data.buffer_, worker_index_);
     if (expected_worker_index != worker_index_) {
       ENVOY_LOG_EVERY_POW_2(error, "Mismatched worker index. expected {}, actual {}",
                             expected_worker_index, worker_index_);
@@ -245,7 +249,7 @@ uint32_t ActiveQuicListener::destination(const Network::UdpRecvData& data) const
 
   // Taking this path is not as performant as it could be. It means most packets are being
   // delivered by the kernel to the wrong worker, and then redirected to the correct worker.
-  return select_connection_id_worker_(*data.buffer_, worker_index_);
+  return expected_worker_index;
 }
 
 size_t ActiveQuicListener::numPacketsExpectedPerEventLoop() const {
@@ -16,8 +16,10 @@
 #include "source/common/quic/envoy_quic_server_connection.h"
 #include "source/common/quic/envoy_quic_server_stream.h"
 #include "source/common/quic/quic_filter_manager_connection_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/types/optional.h"
+#include "openssl/ssl.h"
 #include "quiche/quic/core/quic_config.h"
 #include "quiche/quic/core/quic_error_codes.h"
 #include "quiche/quic/core/quic_stream.h"
@@ -159,6 +161,14 @@ void EnvoyQuicServerSession::OnConnectionClosed(const quic::QuicConnectionCloseF
 
 void EnvoyQuicServerSession::Initialize() {
   quic::QuicServerSessionBase::Initialize();
+  SSL* ssl = GetCryptoStream()->GetSsl();
+  if (ssl != nullptr &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.quic_shed_tls_handshake_config")) {
+    // Free the certificates, keys and other handshake settings of the connection once the handshake
+    // is done, as they aren't used anymore by QUIC connections, which can't renegotiate and don't
+    // expose the local certificate.
+    SSL_set_shed_handshake_config(ssl, 1);
+  }
   initialized_ = true;
   MaybeAddSessionToIdleList();
   quic_connection_->setEnvoyConnection(*this, *this);
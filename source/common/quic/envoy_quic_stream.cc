@@ -1,6 +1,7 @@
 #include "source/common/quic/envoy_quic_stream.h"
 
 #include "source/common/http/utility.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "quiche/quic/core/http/http_encoder.h"
 #include "quiche/quic/core/qpack/qpack_encoder.h"
@@ -9,6 +10,31 @@
 namespace Envoy {
 namespace Quic {
 
+void EnvoyQuicStream::moveToSentBody(Buffer::Instance& data,
+                                     absl::InlinedVector<quiche::QuicheMemSlice, 4>& quic_slices) {
+  if (sent_body_ == nullptr) {
+    sent_body_ = std::make_shared<Buffer::OwnedImpl>();
+  }
+  const uint64_t offset = sent_body_->length();
+  sent_body_->move(data);
+  // The small slices may have been copied into the last slice of the buffer, so the slices of the
+  // moved data are only known after the move.
+  uint64_t skipped = 0;
+  for (const Buffer::RawSlice& slice : sent_body_->getRawSlices()) {
+    if (skipped + slice.len_ <= offset) {
+      skipped += slice.len_;
+      continue;
+    }
+    const uint64_t start = offset > skipped ? offset - skipped : 0;
+    skipped += slice.len_;
+    quic_slices.emplace_back(static_cast<char*>(slice.mem_) + start, slice.len_ - start,
+                             [sent_body = sent_body_](absl::string_view released) {
+                               // The slices are released in the order they are written.
+                               sent_body->drain(released.size());
+                             });
+  }
+}
+
 void EnvoyQuicStream::encodeData(Buffer::Instance& data, bool end_stream) {
   ENVOY_STREAM_LOG(debug, "encodeData (end_stream={}) of {} bytes.", *this, end_stream,
                    data.length());
@@ -32,23 +58,25 @@ void EnvoyQuicStream::encodeData(Buffer::Instance& data, bool end_stream) {
     }
   } else {
 #endif
-    Buffer::RawSliceVector raw_slices = data.getRawSlices();
     absl::InlinedVector<quiche::QuicheMemSlice, 4> quic_slices;
-    quic_slices.reserve(raw_slices.size());
-    for (auto& slice : raw_slices) {
-      ASSERT(slice.len_ != 0);
-      // Move each slice into a stand-alone buffer.
-      // TODO(danzh): investigate the cost of allocating one buffer per slice.
-      // If it turns out to be expensive, add a new function to free data in the middle in buffer
-      // interface and re-design QuicheMemSliceImpl.
-      auto single_slice_buffer = std::make_unique<Buffer::OwnedImpl>();
-      single_slice_buffer->move(data, slice.len_);
-      quic_slices.emplace_back(
-          reinterpret_cast<char*>(slice.mem_), slice.len_,
-          [single_slice_buffer = std::move(single_slice_buffer)](absl::string_view) mutable {
-            // Free this memory explicitly when the callback is invoked.
-            single_slice_buffer = nullptr;
-          });
+    if (Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.quic_send_body_from_shared_buffer")) {
+      moveToSentBody(data, quic_slices);
+    } else {
+      Buffer::RawSliceVector raw_slices = data.getRawSlices();
+      quic_slices.reserve(raw_slices.size());
+      for (auto& slice : raw_slices) {
+        ASSERT(slice.len_ != 0);
+        // Move each slice into a stand-alone buffer.
+        auto single_slice_buffer = std::make_unique<Buffer::OwnedImpl>();
+        single_slice_buffer->move(data, slice.len_);
+        quic_slices.emplace_back(
+            reinterpret_cast<char*>(slice.mem_), slice.len_,
+            [single_slice_buffer = std::move(single_slice_buffer)](absl::string_view) mutable {
+              // Free this memory explicitly when the callback is invoked.
+              single_slice_buffer = nullptr;
+            });
+      }
     }
     quic::QuicConsumedData result{0, false};
     absl::Span<quiche::QuicheMemSlice> span(quic_slices);
@@ -8,6 +8,7 @@
 #include "envoy/event/dispatcher.h"
 #include "envoy/http/codec.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/http/codec_helper.h"
 #include "source/common/quic/envoy_quic_simulated_watermark_buffer.h"
 #include "source/common/quic/envoy_quic_utils.h"
@@ -19,6 +20,8 @@
 #include "source/common/quic/quic_stats_gatherer.h"
 #include "source/common/quic/send_buffer_monitor.h"
 
+#include "absl/container/inlined_vector.h"
+#include "quiche/common/quiche_mem_slice.h"
 #include "quiche/http2/adapter/header_validator.h"
 #include "quiche/quic/core/http/quic_spdy_stream.h"
 
@@ -273,6 +276,10 @@ protected:
   bool saw_regular_headers_{false};
 
 private:
+  // Moves data to sent_body_, and adds the mem slices referencing it to quic_slices.
+  void moveToSentBody(Buffer::Instance& data,
+                      absl::InlinedVector<quiche::QuicheMemSlice, 4>& quic_slices);
+
   // QUIC stream and session that this EnvoyQuicStream wraps.
   quic::QuicSpdyStream& quic_stream_;
   quic::QuicSession& quic_session_;
@@ -300,6 +307,11 @@ private:
   // Track the buffered bytes reported to connection in the
   // most recent call of updateBytesBuffered().
   uint64_t reported_buffered_bytes_{0u};
+  // The body data referenced by the mem slices in the QUIC stream send buffer. The send buffer
+  // releases the slices in the order they were written, once they are acknowledged or when the
+  // stream is destroyed, so that each release drains the front of this buffer. Shared with the
+  // releasors as the send buffer outlives this object.
+  std::shared_ptr<Buffer::OwnedImpl> sent_body_;
 };
 
 // Object used for updating a BytesMeter to track bytes sent on a QuicStream since this object was
@@ -0,0 +1,276 @@
+#include "source/common/quic/udp_sendmmsg_batch_writer.h"
+
+#include <netinet/in.h>
+
+#include <cstring>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+namespace Envoy {
+namespace Quic {
+namespace {
+
+// The control messages of a datagram: its source address and its segment size.
+const size_t ControlSpace = CMSG_SPACE(sizeof(in6_pktinfo)) + CMSG_SPACE(sizeof(uint16_t));
+
+} // namespace
+
+UdpSendmmsgBatchWriter::UdpSendmmsgBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                                               Event::Dispatcher& dispatcher,
+                                               uint32_t max_buffered_packets, bool gso)
+    : io_handle_(io_handle),
+      stats_({UDP_SENDMMSG_BATCH_WRITER_STATS(POOL_COUNTER(scope), POOL_GAUGE(scope),
+                                              POOL_HISTOGRAM(scope))}),
+      max_buffered_packets_(max_buffered_packets),
+      max_segments_(gso ? MaxSegmentsPerDatagram : 1),
+      buffer_size_(static_cast<uint64_t>(max_buffered_packets) *
+                   Network::UdpMaxOutgoingPacketSize),
+      buffer_(new uint8_t[buffer_size_]),
+      send_callback_(dispatcher.createSchedulableCallback([this]() { send(); })) {
+  ASSERT(max_buffered_packets_ > 0);
+  messages_.reserve(max_buffered_packets_);
+}
+
+UdpSendmmsgBatchWriter::~UdpSendmmsgBatchWriter() {
+  // Best effort to not drop the packets of the last loop iteration.
+  if (!messages_.empty() && !write_blocked_) {
+    send();
+  }
+}
+
+Api::IoCallUint64Result
+UdpSendmmsgBatchWriter::writePacket(const Buffer::Instance& buffer,
+                                    const Network::Address::Ip* local_ip,
+                                    const Network::Address::Instance& peer_address) {
+  if (write_blocked_) {
+    return {/*rc=*/0, /*err=*/Network::IoSocketError::getIoSocketEagainError()};
+  }
+  if (peer_address.sockAddr() == nullptr) {
+    // Unlikely to happen unless the wrong peer address is passed.
+    return Network::IoSocketError::ioResultSocketInvalidAddress();
+  }
+  ASSERT(buffer.getRawSlices().size() == 1);
+  const Buffer::RawSlice slice = buffer.frontSlice();
+  if (slice.len_ > Network::UdpMaxOutgoingPacketSize) {
+    return {/*rc=*/0, /*err=*/Network::IoSocketError::create(EMSGSIZE)};
+  }
+
+  if (!hasRoomFor(slice.len_)) {
+    send();
+    if (write_blocked_) {
+      return {/*rc=*/0, /*err=*/Network::IoSocketError::getIoSocketEagainError()};
+    }
+    ASSERT(hasRoomFor(slice.len_));
+  }
+
+  uint8_t* const location = buffer_.get() + buffer_used_;
+  // The packets serialized in the location returned by getNextWriteLocation() are in place.
+  if (slice.mem_ != location) {
+    memcpy(location, slice.mem_, slice.len_);
+  }
+
+  Message* last = messages_.empty() ? nullptr : &messages_.back();
+  if (last != nullptr && !last->closed_ && last->num_segments_ < max_segments_ &&
+      slice.len_ <= last->segment_size_ &&
+      last->length_ + slice.len_ <= MaxSegmentedDatagramSize &&
+      sameEndpoints(*last, local_ip, peer_address)) {
+    last->length_ += slice.len_;
+    last->num_segments_++;
+    last->closed_ = slice.len_ < last->segment_size_;
+  } else {
+    Message& message = messages_.emplace_back();
+    memcpy(&message.peer_address_, peer_address.sockAddr(), peer_address.sockAddrLen());
+    message.peer_address_len_ = peer_address.sockAddrLen();
+    if (local_ip != nullptr) {
+      message.self_ip_version_ = local_ip->version();
+      if (local_ip->version() == Network::Address::IpVersion::v4) {
+        message.self_ipv4_ = local_ip->ipv4()->address();
+      } else {
+        message.self_ipv6_ = local_ip->ipv6()->address();
+      }
+    }
+    message.offset_ = buffer_used_;
+    message.length_ = slice.len_;
+    message.segment_size_ = slice.len_;
+    message.num_segments_ = 1;
+  }
+  buffer_used_ += slice.len_;
+  buffered_packets_++;
+  stats_.internal_buffer_size_.set(buffer_used_);
+
+  // The packets of all the connections written during this loop iteration are sent at its end.
+  send_callback_->scheduleCallbackCurrentIteration();
+  return {/*rc=*/slice.len_, /*err=*/Api::IoError::none()};
+}
+
+bool UdpSendmmsgBatchWriter::sameEndpoints(const Message& message,
+                                           const Network::Address::Ip* local_ip,
+                                           const Network::Address::Instance& peer_address) const {
+  if (message.peer_address_len_ != peer_address.sockAddrLen() ||
+      memcmp(&message.peer_address_, peer_address.sockAddr(), message.peer_address_len_) != 0) {
+    return false;
+  }
+  if (local_ip == nullptr) {
+    return !message.self_ip_version_.has_value();
+  }
+  if (message.self_ip_version_ != local_ip->version()) {
+    return false;
+  }
+  return local_ip->version() == Network::Address::IpVersion::v4
+             ? message.self_ipv4_ == local_ip->ipv4()->address()
+             : message.self_ipv6_ == local_ip->ipv6()->address();
+}
+
+void UdpSendmmsgBatchWriter::setWritable() {
+  write_blocked_ = false;
+  if (!messages_.empty()) {
+    send_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+Network::UdpPacketWriterBuffer UdpSendmmsgBatchWriter::getNextWriteLocation(
+    const Network::Address::Ip*, const Network::Address::Instance&) {
+  if (write_blocked_ || !hasRoomFor(Network::UdpMaxOutgoingPacketSize)) {
+    return {nullptr, 0, nullptr};
+  }
+  return {buffer_.get() + buffer_used_, Network::UdpMaxOutgoingPacketSize, nullptr};
+}
+
+Api::IoCallUint64Result UdpSendmmsgBatchWriter::flush() {
+  // Sending is deferred to the end of the loop iteration, so that the packets of the other
+  // connections are sent by the same calls.
+  if (write_blocked_) {
+    return {/*rc=*/0, /*err=*/Network::IoSocketError::getIoSocketEagainError()};
+  }
+  return Api::ioCallUint64ResultNoError();
+}
+
+Api::IoCallUint64Result UdpSendmmsgBatchWriter::send() {
+  if (messages_.empty()) {
+    return Api::ioCallUint64ResultNoError();
+  }
+  prepareHeaders();
+
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  Api::IoErrorPtr error = Api::IoError::none();
+  uint64_t bytes_sent = 0;
+  size_t sent = 0;
+  while (sent < messages_.size()) {
+    const Api::SysCallIntResult result = os_sys_calls.sendmmsg(
+        io_handle_.fdDoNotUse(), &mmsg_hdrs_[sent], messages_.size() - sent, 0);
+    if (result.return_value_ < 0) {
+      if (result.errno_ == SOCKET_ERROR_AGAIN) {
+        write_blocked_ = true;
+        error = Network::IoSocketError::getIoSocketEagainError();
+        break;
+      }
+      // The first datagram failed, drop it and send the next ones.
+      ENVOY_LOG_EVERY_POW_2(debug, "sendmmsg failed with error {}", result.errno_);
+      stats_.dropped_packets_.add(messages_[sent].num_segments_);
+      error = Network::IoSocketError::create(result.errno_);
+      sent++;
+      continue;
+    }
+    if (result.return_value_ == 0) {
+      break;
+    }
+    const size_t sent_messages = static_cast<size_t>(result.return_value_);
+    stats_.messages_sent_per_sendmmsg_.recordValue(sent_messages);
+    for (size_t i = sent; i < sent + sent_messages; i++) {
+      stats_.pkts_sent_per_batch_.recordValue(messages_[i].num_segments_);
+      bytes_sent += messages_[i].length_;
+    }
+    sent += sent_messages;
+  }
+  stats_.total_bytes_sent_.add(bytes_sent);
+  consume(sent);
+  return {bytes_sent, std::move(error)};
+}
+
+void UdpSendmmsgBatchWriter::prepareHeaders() {
+  mmsg_hdrs_.resize(messages_.size());
+  iovecs_.resize(messages_.size());
+  control_.resize(messages_.size() * ControlSpace);
+  for (size_t i = 0; i < messages_.size(); i++) {
+    Message& message = messages_[i];
+    iovecs_[i].iov_base = buffer_.get() + message.offset_;
+    iovecs_[i].iov_len = message.length_;
+
+    msghdr& hdr = mmsg_hdrs_[i].msg_hdr;
+    memset(&mmsg_hdrs_[i], 0, sizeof(mmsghdr));
+    hdr.msg_name = &message.peer_address_;
+    hdr.msg_namelen = message.peer_address_len_;
+    hdr.msg_iov = &iovecs_[i];
+    hdr.msg_iovlen = 1;
+
+    char* const control = control_.data() + i * ControlSpace;
+    memset(control, 0, ControlSpace);
+    hdr.msg_control = control;
+    hdr.msg_controllen = ControlSpace;
+    size_t control_length = 0;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    if (message.self_ip_version_.has_value()) {
+      if (message.self_ip_version_ == Network::Address::IpVersion::v4) {
+        cmsg->cmsg_level = IPPROTO_IP;
+        cmsg->cmsg_type = IP_PKTINFO;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+        auto pktinfo = reinterpret_cast<in_pktinfo*>(CMSG_DATA(cmsg));
+        pktinfo->ipi_spec_dst.s_addr = message.self_ipv4_;
+        control_length += CMSG_SPACE(sizeof(in_pktinfo));
+      } else {
+        cmsg->cmsg_level = IPPROTO_IPV6;
+        cmsg->cmsg_type = IPV6_PKTINFO;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(in6_pktinfo));
+        auto pktinfo = reinterpret_cast<in6_pktinfo*>(CMSG_DATA(cmsg));
+        memcpy(pktinfo->ipi6_addr.s6_addr, &message.self_ipv6_, sizeof(message.self_ipv6_));
+        control_length += CMSG_SPACE(sizeof(in6_pktinfo));
+      }
+      cmsg = CMSG_NXTHDR(&hdr, cmsg);
+    }
+    if (message.num_segments_ > 1) {
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      const uint16_t segment_size = static_cast<uint16_t>(message.segment_size_);
+      memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+      control_length += CMSG_SPACE(sizeof(uint16_t));
+    }
+    hdr.msg_controllen = control_length;
+    if (control_length == 0) {
+      hdr.msg_control = nullptr;
+    }
+  }
+}
+
+void UdpSendmmsgBatchWriter::consume(size_t sent_messages) {
+  if (sent_messages == messages_.size()) {
+    messages_.clear();
+    buffer_used_ = 0;
+    buffered_packets_ = 0;
+  } else if (sent_messages > 0) {
+    const uint64_t offset = messages_[sent_messages].offset_;
+    memmove(buffer_.get(), buffer_.get() + offset, buffer_used_ - offset);
+    buffer_used_ -= offset;
+    messages_.erase(messages_.begin(), messages_.begin() + sent_messages);
+    buffered_packets_ = 0;
+    for (Message& message : messages_) {
+      message.offset_ -= offset;
+      buffered_packets_ += message.num_segments_;
+    }
+  }
+  stats_.internal_buffer_size_.set(buffer_used_);
+}
+
+Network::UdpPacketWriterPtr UdpSendmmsgBatchWriterFactory::createUdpPacketWriter(
+    Network::IoHandle& io_handle, Stats::Scope& scope, Envoy::Event::Dispatcher& dispatcher,
+    absl::AnyInvocable<void() &&>) {
+  return std::make_unique<UdpSendmmsgBatchWriter>(
+      io_handle, scope, dispatcher, max_buffered_packets_,
+      Api::OsSysCallsSingleton::get().supportsUdpGso());
+}
+
+} // namespace Quic
+} // namespace Envoy
@@ -0,0 +1,158 @@
+#pragma once
+
+#if !defined(__linux__) || defined(__ANDROID_API__)
+#define UDP_SENDMMSG_BATCH_WRITER_COMPILETIME_SUPPORT 0
+#else
+#define UDP_SENDMMSG_BATCH_WRITER_COMPILETIME_SUPPORT 1
+
+#include <sys/socket.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/schedulable_cb.h"
+#include "envoy/network/udp_packet_writer_handler.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/numeric/int128.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Quic {
+
+/**
+ * All the stats of the UdpSendmmsgBatchWriter. @see stats_macros.h
+ *
+ * @total_bytes_sent: the bytes sent on the socket.
+ * @internal_buffer_size: the bytes buffered and not sent yet.
+ * @pkts_sent_per_batch: the packets sent as the segments of a single datagram.
+ * @messages_sent_per_sendmmsg: the datagrams sent by a single sendmmsg call.
+ * @dropped_packets: the packets dropped on a send error other than the socket being blocked.
+ */
+#define UDP_SENDMMSG_BATCH_WRITER_STATS(COUNTER, GAUGE, HISTOGRAM)                                 \
+  COUNTER(total_bytes_sent)                                                                        \
+  COUNTER(dropped_packets)                                                                         \
+  GAUGE(internal_buffer_size, NeverImport)                                                         \
+  HISTOGRAM(pkts_sent_per_batch, Unspecified)                                                      \
+  HISTOGRAM(messages_sent_per_sendmmsg, Unspecified)
+
+/**
+ * Wrapper struct for the udp sendmmsg batch writer stats. @see stats_macros.h
+ */
+struct UdpSendmmsgBatchWriterStats {
+  UDP_SENDMMSG_BATCH_WRITER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                                  GENERATE_HISTOGRAM_STRUCT)
+};
+
+/**
+ * UdpPacketWriter buffering the packets written by all the connections sharing a socket during a
+ * dispatcher loop iteration, and sending them at its end with as few sendmmsg calls as possible.
+ * The consecutive packets of the same size to the same peer, except for the last one which can be
+ * shorter, are sent as the segments of a single datagram when the socket supports generic
+ * segmentation offload (GSO), so that a single call sends the packets of many connections, with
+ * many packets per connection.
+ */
+class UdpSendmmsgBatchWriter : public Network::UdpPacketWriter,
+                               protected Logger::Loggable<Logger::Id::quic> {
+public:
+  /**
+   * @param io_handle the socket to send the packets on.
+   * @param scope the scope of the stats.
+   * @param dispatcher the dispatcher of the socket, which the buffered packets are sent at the end
+   * of the loop iterations of.
+   * @param max_buffered_packets the number of packets buffered before sending them right away.
+   * @param gso whether the socket supports sending many packets as the segments of a datagram.
+   */
+  UdpSendmmsgBatchWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                         Event::Dispatcher& dispatcher, uint32_t max_buffered_packets, bool gso);
+  ~UdpSendmmsgBatchWriter() override;
+
+  // Network::UdpPacketWriter
+  Api::IoCallUint64Result writePacket(const Buffer::Instance& buffer,
+                                      const Network::Address::Ip* local_ip,
+                                      const Network::Address::Instance& peer_address) override;
+  bool isWriteBlocked() const override { return write_blocked_; }
+  void setWritable() override;
+  uint64_t getMaxPacketSize(const Network::Address::Instance&) const override {
+    return Network::UdpMaxOutgoingPacketSize;
+  }
+  bool isBatchMode() const override { return true; }
+  Network::UdpPacketWriterBuffer
+  getNextWriteLocation(const Network::Address::Ip* local_ip,
+                       const Network::Address::Instance& peer_address) override;
+  Api::IoCallUint64Result flush() override;
+
+  // The largest payload of a datagram carrying many segments.
+  static constexpr uint64_t MaxSegmentedDatagramSize = 65507;
+  // The most segments of a datagram the kernels supporting GSO accept.
+  static constexpr uint16_t MaxSegmentsPerDatagram = 64;
+
+private:
+  // A datagram of the next sendmmsg call.
+  struct Message {
+    sockaddr_storage peer_address_;
+    socklen_t peer_address_len_;
+    absl::optional<Network::Address::IpVersion> self_ip_version_;
+    uint32_t self_ipv4_{};
+    absl::uint128 self_ipv6_{};
+    // The payload, in buffer_.
+    uint64_t offset_;
+    uint64_t length_;
+    uint64_t segment_size_;
+    uint16_t num_segments_;
+    // Whether the last segment is shorter than the others, so that no segment can be added.
+    bool closed_{};
+  };
+
+  bool hasRoomFor(uint64_t length) const {
+    return buffered_packets_ < max_buffered_packets_ && buffer_used_ + length <= buffer_size_;
+  }
+  bool sameEndpoints(const Message& message, const Network::Address::Ip* local_ip,
+                     const Network::Address::Instance& peer_address) const;
+  // Sends all the buffered datagrams, until the socket is blocked.
+  Api::IoCallUint64Result send();
+  // Fills mmsg_hdrs_ with the buffered datagrams.
+  void prepareHeaders();
+  // Removes the sent datagrams, moving the datagrams left to the front of the buffer.
+  void consume(size_t sent_messages);
+
+  Network::IoHandle& io_handle_;
+  UdpSendmmsgBatchWriterStats stats_;
+  const uint32_t max_buffered_packets_;
+  const uint16_t max_segments_;
+  const uint64_t buffer_size_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  uint64_t buffer_used_{};
+  uint32_t buffered_packets_{};
+  std::vector<Message> messages_;
+  // Reused by the sendmmsg calls.
+  std::vector<mmsghdr> mmsg_hdrs_;
+  std::vector<iovec> iovecs_;
+  std::vector<char> control_;
+  Event::SchedulableCallbackPtr send_callback_;
+  bool write_blocked_{};
+};
+
+class UdpSendmmsgBatchWriterFactory : public Network::UdpPacketWriterFactory {
+public:
+  explicit UdpSendmmsgBatchWriterFactory(uint32_t max_buffered_packets)
+      : max_buffered_packets_(max_buffered_packets) {}
+
+  Network::UdpPacketWriterPtr
+  createUdpPacketWriter(Network::IoHandle& io_handle, Stats::Scope& scope,
+                        Envoy::Event::Dispatcher& dispatcher,
+                        absl::AnyInvocable<void() &&> on_can_write_cb) override;
+
+private:
+  const uint32_t max_buffered_packets_;
+};
+
+} // namespace Quic
+} // namespace Envoy
+
+#endif // defined(__linux__)
@@ -246,10 +246,20 @@ std::string SslRedirector::newUri(const Http::RequestHeaderMap& headers) const {
 
 HedgePolicyImpl::HedgePolicyImpl(const envoy::config::route::v3::HedgePolicy& hedge_policy)
     : additional_request_chance_(hedge_policy.additional_request_chance()),
+      hedge_latency_percentile_(
+          hedge_policy.has_hedge_on_latency()
+              ? absl::make_optional(hedge_policy.hedge_on_latency().latency_percentile().value())
+              : absl::nullopt),
+      hedge_budget_ratio_(
+          hedge_policy.hedge_on_latency().has_budget_percent()
+              ? hedge_policy.hedge_on_latency().budget_percent().value() / 100.0
+              : DefaultHedgeBudgetRatio),
       initial_requests_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(hedge_policy, initial_requests, 1)),
       hedge_on_per_try_timeout_(hedge_policy.hedge_on_per_try_timeout()) {}
 
-HedgePolicyImpl::HedgePolicyImpl() : initial_requests_(1), hedge_on_per_try_timeout_(false) {}
+HedgePolicyImpl::HedgePolicyImpl()
+    : hedge_budget_ratio_(DefaultHedgeBudgetRatio), initial_requests_(1),
+      hedge_on_per_try_timeout_(false) {}
 
 absl::StatusOr<std::unique_ptr<InternalRedirectPolicyImpl>> InternalRedirectPolicyImpl::create(
     const envoy::config::route::v3::InternalRedirectPolicy& policy_config,
@@ -351,7 +361,8 @@ ShadowPolicyImpl::ShadowPolicyImpl(const RequestMirrorPolicy& config,
                                    absl::Status& creation_status)
     : cluster_(config.cluster()), cluster_header_(config.cluster_header()),
       disable_shadow_host_suffix_append_(config.disable_shadow_host_suffix_append()),
-      host_rewrite_literal_(config.host_rewrite_literal()) {
+      host_rewrite_literal_(config.host_rewrite_literal()),
+      abandon_on_backpressure_(config.abandon_on_backpressure()) {
   SET_AND_RETURN_IF_NOT_OK(validateMirrorClusterSpecifier(config), creation_status);
 
   if (config.has_runtime_fraction()) {
@@ -903,6 +914,23 @@ bool RouteEntryImplBase::matchRoute(const Http::RequestHeaderMap& headers,
   return matches;
 }
 
+bool RouteEntryImplBase::matchesOnPathOnly() const {
+  switch (matchType()) {
+  case PathMatchType::Prefix:
+  case PathMatchType::Exact:
+  case PathMatchType::Regex:
+  case PathMatchType::PathSeparatedPrefix:
+    break;
+  case PathMatchType::None:
+  case PathMatchType::Template:
+    return false;
+  }
+  return runtime_ == nullptr && !match_grpc_ && config_headers_.empty() &&
+         config_query_parameters_.empty() && config_cookies_.empty() &&
+         tls_context_match_criteria_ == nullptr && dynamic_metadata_.empty() &&
+         filter_state_.empty() && cluster_specifier_plugin_ == nullptr;
+}
+
 const std::string& RouteEntryImplBase::clusterName() const { return cluster_name_; }
 
 void RouteEntryImplBase::finalizePathHeaderForRedirect(Http::RequestHeaderMap& headers,
@@ -1470,7 +1498,10 @@ RegexRouteEntryImpl::RegexRouteEntryImpl(
     ProtobufMessage::ValidationVisitor& validator, absl::Status& creation_status)
     : RouteEntryImplBase(vhost, route, factory_context, validator, creation_status),
       path_matcher_(
-          Matchers::PathMatcher::createSafeRegex(route.match().safe_regex(), factory_context)) {
+          Matchers::PathMatcher::createSafeRegex(route.match().safe_regex(), factory_context)),
+      re2_path_regex_(route.match().safe_regex().has_google_re2() ||
+                      dynamic_cast<const Regex::GoogleReEngine*>(
+                          &factory_context.regexEngine()) != nullptr) {
   ASSERT(route.match().path_specifier_case() ==
          envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex);
   // The createSafeRegex function never returns nullptr.
@@ -1785,7 +1816,67 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.vhost_route_path_index")) {
+      buildRoutePathIndex();
+    }
+  }
+}
+
+void VirtualHostImpl::buildRoutePathIndex() {
+  const bool index_regexes =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.vhost_route_regex_set");
+  auto index = std::make_unique<RoutePathIndex>();
+  for (uint32_t i = 0; i < routes_.size(); ++i) {
+    const RouteEntryImplBase& route = *routes_[i];
+    // Case insensitive matchers could be indexed by the lowercase path, but they are rare enough
+    // in large virtual hosts that they are simply evaluated for every request. Regexes ignore the
+    // case_sensitive field.
+    if (route.case_sensitive() && route.matchType() == PathMatchType::Exact) {
+      index->addExact(route.matcher(), i);
+    } else if (route.case_sensitive() && route.matchType() == PathMatchType::Prefix) {
+      index->addPrefix(route.matcher(), i);
+    } else if (!(index_regexes && route.matchType() == PathMatchType::Regex &&
+                 static_cast<const RegexRouteEntryImpl&>(route).re2PathRegex() &&
+                 index->addRegex(route.matcher(), i))) {
+      index->addUnindexed(i);
+    }
+  }
+  index->finalize();
+  if (index->indexedRoutes() >= MinRoutesForPathIndex) {
+    route_path_index_ = std::move(index);
+  }
+}
+
+RouteConstSharedPtr
+VirtualHostImpl::getRouteFromPathIndex(const Http::RequestHeaderMap& headers,
+                                       const StreamInfo::StreamInfo& stream_info,
+                                       uint64_t random_value) const {
+  // Path sanitization only depends on the route configuration, so any route can do it. The path
+  // matchers themselves ignore the query string and fragment.
+  const absl::string_view path = Http::PathUtil::removeQueryAndFragment(
+      routes_.front()->sanitizePathBeforePathMatching(headers.getPathValue()));
+  RoutePathIndex::Candidates candidates;
+  route_path_index_->findCandidates(path, candidates);
+  for (const uint32_t index : candidates) {
+    RouteConstSharedPtr route_entry = routes_[index]->matches(headers, stream_info, random_value);
+    if (route_entry != nullptr) {
+      return route_entry;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
+bool VirtualHostImpl::routeResolutionCacheable() const {
+  // Requests from outside of Envoy are told apart by the x-envoy-internal header.
+  if (matcher_ != nullptr || ssl_requirements_ == SslRequirements::ExternalOnly) {
+    return false;
   }
+  return std::all_of(routes_.begin(), routes_.end(),
+                     [](const RouteEntryImplBaseConstSharedPtr& route) {
+                       return route->matchesOnPathOnly();
+                     });
 }
 
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
@@ -1874,7 +1965,11 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
+  // Check for a route that matches the request. The index is not used when the caller wants to
+  // be consulted about each matching route, as it reports whether more routes follow a match.
+  if (route_path_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromPathIndex(headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
@@ -1903,11 +1998,12 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     bool hash_virtual_hosts, const RouteMatcher* previous) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, hash_virtual_hosts, previous, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -1915,16 +2011,40 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           bool hash_virtual_hosts, const RouteMatcher* previous,
                            absl::Status& creation_status)
-    : vhost_scope_(factory_context.scope().scopeFromStatName(
-          factory_context.routerContext().virtualClusterStatNames().vhost_)),
+    : vhost_scope_(previous != nullptr
+                       ? previous->vhost_scope_
+                       : factory_context.scope().scopeFromStatName(
+                             factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()),
-      vhost_header_(route_config.vhost_header()) {
+      vhost_header_(route_config.vhost_header()),
+      route_resolution_cacheable_(vhost_header_.get().empty()) {
+  if (hash_virtual_hosts) {
+    virtual_hosts_by_hash_.reserve(route_config.virtual_hosts_size());
+  }
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostImplSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostImplSharedPtr virtual_host;
+    uint64_t virtual_host_hash = 0;
+    if (hash_virtual_hosts) {
+      virtual_host_hash = MessageUtil::hash(virtual_host_config);
+      if (previous != nullptr) {
+        auto it = previous->virtual_hosts_by_hash_.find(virtual_host_hash);
+        if (it != previous->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validate_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    if (hash_virtual_hosts) {
+      virtual_hosts_by_hash_.emplace(virtual_host_hash, virtual_host);
+    }
+    route_resolution_cacheable_ &= virtual_host->routeResolutionCacheable();
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -2153,17 +2273,54 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
   return ret;
 }
 
+absl::StatusOr<std::shared_ptr<ConfigImpl>>
+ConfigImpl::createUpdate(const envoy::config::route::v3::RouteConfiguration& config,
+                         const ConfigImpl* previous,
+                         Server::Configuration::ServerFactoryContext& factory_context,
+                         ProtobufMessage::ValidationVisitor& validator,
+                         bool validate_clusters_default) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(config, factory_context, validator,
+                                                        validate_clusters_default, true, previous,
+                                                        creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, absl::Status& creation_status)
+    : ConfigImpl(config, factory_context, validator, validate_clusters_default, false, nullptr,
+                 creation_status) {}
+
+ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+                       Server::Configuration::ServerFactoryContext& factory_context,
+                       ProtobufMessage::ValidationVisitor& validator,
+                       bool validate_clusters_default, bool share_virtual_hosts,
+                       const ConfigImpl* previous, absl::Status& creation_status) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  // A shared virtual host would skip the validation of its clusters against the current ones.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (share_virtual_hosts && !validate_clusters) {
+    // The virtual hosts point to the shared config, so they may only be shared along with it.
+    shared_config_hash_ = MessageUtil::hashIgnoringField(
+        config, envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber);
+    if (previous != nullptr && previous->shared_config_hash_ == shared_config_hash_) {
+      shared_config_ = previous->shared_config_;
+      previous_matcher = previous->route_matcher_.get();
+    }
+  }
+  if (shared_config_ == nullptr) {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
-  auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+  auto matcher_or_error =
+      RouteMatcher::create(config, shared_config_, factory_context, validator, validate_clusters,
+                           shared_config_hash_.has_value(), previous_matcher);
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
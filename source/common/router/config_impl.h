@@ -34,10 +34,12 @@
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
 #include "source/common/router/retry_policy_impl.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
@@ -383,15 +385,33 @@ public:
 
   VirtualHostConstSharedPtr virtualHost() const { return shared_virtual_host_; }
 
+  // Minimum number of routes with an exact path, prefix or RE2 regex match for a virtual host to
+  // build a RoutePathIndex. Below this, walking the route list is as fast as the index lookup.
+  static constexpr uint32_t MinRoutesForPathIndex = 16;
+
+  bool hasRoutePathIndexForTest() const { return route_path_index_ != nullptr; }
+
+  // Whether the route selected by getRouteFromEntries() without a callback only depends on the
+  // request's x-forwarded-proto header and path.
+  bool routeResolutionCacheable() const;
+
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  void buildRoutePathIndex();
+  RouteConstSharedPtr getRouteFromPathIndex(const Http::RequestHeaderMap& headers,
+                                            const StreamInfo::StreamInfo& stream_info,
+                                            uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   absl::InlinedVector<RouteEntryImplBaseConstSharedPtr, 2> routes_;
+  // Narrows down the candidates in routes_ for a request path. Only built for virtual hosts with
+  // at least MinRoutesForPathIndex indexable routes.
+  std::unique_ptr<const RoutePathIndex> route_path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -420,6 +440,7 @@ public:
   }
   const Http::HeaderEvaluator& headerEvaluator() const override;
   absl::string_view hostRewriteLiteral() const override { return host_rewrite_literal_; }
+  bool abandonOnBackpressure() const override { return abandon_on_backpressure_; }
 
 private:
   explicit ShadowPolicyImpl(const RequestMirrorPolicy& config,
@@ -433,6 +454,7 @@ private:
   absl::optional<bool> trace_sampled_;
   const bool disable_shadow_host_suffix_append_;
   const std::string host_rewrite_literal_;
+  const bool abandon_on_backpressure_;
   HeaderMutationsPtr request_headers_mutations_;
 };
 
@@ -451,9 +473,17 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  absl::optional<double> hedgeLatencyPercentile() const override {
+    return hedge_latency_percentile_;
+  }
+  double hedgeBudgetRatio() const override { return hedge_budget_ratio_; }
 
 private:
+  static constexpr double DefaultHedgeBudgetRatio = 0.1;
+
   const envoy::type::v3::FractionalPercent additional_request_chance_;
+  const absl::optional<double> hedge_latency_percentile_;
+  const double hedge_budget_ratio_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const uint32_t initial_requests_;
   const bool hedge_on_per_try_timeout_;
@@ -756,6 +786,10 @@ public:
   // Sanitizes the |path| before passing it to PathMatcher, if configured, this method makes the
   // path matching to ignore the path-parameters.
   absl::string_view sanitizePathBeforePathMatching(const absl::string_view path) const;
+  bool case_sensitive() const { return case_sensitive_; }
+  // Whether the route is selected by the request path alone, with no other match criteria and a
+  // fixed cluster, redirect or direct response.
+  bool matchesOnPathOnly() const;
 
 protected:
   const PathMatcherSharedPtr path_matcher_;
@@ -776,7 +810,6 @@ protected:
 
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    const StreamInfo::StreamInfo& stream_info,
                                    uint64_t random_value) const;
@@ -1042,6 +1075,9 @@ public:
   const std::string& matcher() const override { return path_matcher_->stringRepresentation(); }
   PathMatchType matchType() const override { return PathMatchType::Regex; }
 
+  // Whether the path regex is evaluated by RE2, so that it can be indexed in a RE2::Set.
+  bool re2PathRegex() const { return re2_path_regex_; }
+
   // Router::Matchable
   RouteConstSharedPtr matches(const Http::RequestHeaderMap& headers,
                               const StreamInfo::StreamInfo& stream_info,
@@ -1064,6 +1100,7 @@ private:
                       ProtobufMessage::ValidationVisitor& validator, absl::Status& creation_status);
 
   const Matchers::PathMatcherConstSharedPtr path_matcher_;
+  const bool re2_path_regex_;
 };
 
 /**
@@ -1196,22 +1233,33 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param hash_virtual_hosts whether the virtual hosts are hashed, so that a later matcher may
+   *        share them.
+   * @param previous supplies a matcher of the same global_route_config, whose virtual hosts are
+   *        shared when they are unchanged. May be nullptr.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         bool hash_virtual_hosts = false, const RouteMatcher* previous = nullptr);
 
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
 
   const VirtualHostImpl* findVirtualHost(const Http::RequestHeaderMap& headers) const;
 
+  // See Router::Config::routeResolutionCacheable().
+  bool routeResolutionCacheable() const { return route_resolution_cacheable_; }
+
 private:
   RouteMatcher(const envoy::config::route::v3::RouteConfiguration& config,
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               bool hash_virtual_hosts, const RouteMatcher* previous,
                absl::Status& creation_status);
 
   using WildcardVirtualHosts =
@@ -1222,8 +1270,11 @@ private:
                                                  SubstringFunction substring_function) const;
   bool ignorePortInHostMatching() const { return ignore_port_in_host_matching_; }
 
+  // Shared with the later matchers sharing the virtual hosts, which hold stats of the scope.
   Stats::ScopeSharedPtr vhost_scope_;
   absl::node_hash_map<std::string, VirtualHostImplSharedPtr> virtual_hosts_;
+  // The virtual hosts by the hash of their config, if hashed.
+  absl::flat_hash_map<uint64_t, VirtualHostImplSharedPtr> virtual_hosts_by_hash_;
   // std::greater as a minor optimization to iterate from more to less specific
   //
   // A note on using an unordered_map versus a vector of (string, VirtualHostImplSharedPtr) pairs:
@@ -1239,6 +1290,7 @@ private:
   VirtualHostImplSharedPtr default_virtual_host_;
   const bool ignore_port_in_host_matching_{false};
   const Http::LowerCaseString vhost_header_;
+  bool route_resolution_cacheable_{};
 };
 
 /**
@@ -1323,6 +1375,18 @@ public:
          Server::Configuration::ServerFactoryContext& factory_context,
          ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
 
+  /**
+   * Creates the config of a route configuration which replaces the one of previous, if any. The
+   * virtual hosts which are unchanged are shared with the previous config rather than built again,
+   * as long as the rest of the route configuration is unchanged too and the clusters are not
+   * validated.
+   */
+  static absl::StatusOr<std::shared_ptr<ConfigImpl>>
+  createUpdate(const envoy::config::route::v3::RouteConfiguration& config,
+               const ConfigImpl* previous,
+               Server::Configuration::ServerFactoryContext& factory_context,
+               ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
   }
@@ -1336,6 +1400,9 @@ public:
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info,
                          uint64_t random_value) const override;
+  bool routeResolutionCacheable() const override {
+    return route_matcher_->routeResolutionCacheable();
+  }
   const std::vector<Http::LowerCaseString>& internalOnlyHeaders() const override {
     return shared_config_->internalOnlyHeaders();
   }
@@ -1367,8 +1434,15 @@ protected:
              absl::Status& creation_status);
 
 private:
+  ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
+             Server::Configuration::ServerFactoryContext& factory_context,
+             ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+             bool share_virtual_hosts, const ConfigImpl* previous, absl::Status& creation_status);
+
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // The hash of the route configuration but its virtual hosts, if they may be shared.
+  absl::optional<uint64_t> shared_config_hash_;
 };
 
 /**
@@ -1386,6 +1460,7 @@ public:
                          const StreamInfo::StreamInfo&, uint64_t) const override {
     return {};
   }
+  bool routeResolutionCacheable() const override { return false; }
 
   const std::vector<Http::LowerCaseString>& internalOnlyHeaders() const override {
     return internal_only_headers_;
@@ -21,6 +21,8 @@ namespace Router {
   COUNTER(passthrough_internal_redirect_too_many_redirects)                                        \
   COUNTER(passthrough_internal_redirect_unsafe_scheme)                                             \
   COUNTER(rq_direct_response)                                                                      \
+  COUNTER(rq_hedge_budget_exceeded)                                                                \
+  COUNTER(rq_hedged_on_latency)                                                                    \
   COUNTER(rq_overload_local_reply)                                                                 \
   COUNTER(rq_redirect)                                                                             \
   COUNTER(rq_reset_after_downstream_response_started)                                              \
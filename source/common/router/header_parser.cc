@@ -15,6 +15,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 
@@ -54,6 +55,10 @@ parseHttpHeaderFormatter(const envoy::config::core::v3::HeaderValue& header_valu
   return Envoy::Formatter::FormatterImpl::create(header_value.value(), true, command_parsers);
 }
 
+// Every substitution command, as well as the "%%" escape, contains a '%', so a value without one
+// formats to itself whatever the stream.
+bool isLiteralHeaderValue(absl::string_view value) { return !absl::StrContains(value, '%'); }
+
 } // namespace
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_option,
@@ -80,6 +85,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValueOption& header_value_optio
   auto formatter_or_error = parseHttpHeaderFormatter(header_value_option.header(), command_parsers);
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  literal_value_ = isLiteralHeaderValue(original_value_);
 }
 
 HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
@@ -90,6 +96,7 @@ HeadersToAddEntry::HeadersToAddEntry(const HeaderValue& header_value,
   auto formatter_or_error = parseHttpHeaderFormatter(header_value, command_parsers);
   SET_AND_RETURN_IF_NOT_OK(formatter_or_error.status(), creation_status);
   formatter_ = std::move(formatter_or_error.value());
+  literal_value_ = isLiteralHeaderValue(original_value_);
 }
 
 absl::StatusOr<HeaderParserPtr>
@@ -178,7 +185,7 @@ void HeaderParser::evaluateHeaders(Http::HeaderMap& headers, const Formatter::Co
   std::string value_buffer;
   for (const auto& [key, entry] : headers_to_add_) {
     absl::string_view value;
-    if (stream_info != nullptr) {
+    if (stream_info != nullptr && !entry->literal_value_) {
       value_buffer = entry->formatter_->format(context, *stream_info);
       value = value_buffer;
     } else {
@@ -224,7 +231,9 @@ Http::HeaderTransforms HeaderParser::getHeaderTransforms(const StreamInfo::Strea
 
   for (const auto& [key, entry] : headers_to_add_) {
     if (do_formatting) {
-      const std::string value = entry->formatter_->format({}, stream_info);
+      const std::string value = entry->literal_value_
+                                    ? entry->original_value_
+                                    : entry->formatter_->format({}, stream_info);
       if (!value.empty() || entry->add_if_empty_) {
         switch (entry->append_action_) {
         case HeaderValueOption::APPEND_IF_EXISTS_OR_ADD:
@@ -47,6 +47,9 @@ struct HeadersToAddEntry {
   HeaderAppendAction append_action_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   bool add_if_empty_ = false;
+  // True if the value contains no substitution commands, so formatting it always produces
+  // original_value_ and can be skipped.
+  bool literal_value_ = false;
 
 protected:
   HeadersToAddEntry(const HeaderValue& header_value, HeaderAppendAction append_action,
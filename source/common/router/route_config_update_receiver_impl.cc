@@ -12,6 +12,7 @@
 #include "source/common/config/resource_name.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Router {
@@ -50,6 +51,24 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
       std::shared_ptr<ConfigImpl>);
 }
 
+Rds::ConfigConstSharedPtr
+ConfigTraitsImpl::createUpdatedConfig(const Protobuf::Message& rc,
+                                      const Rds::ConfigConstSharedPtr& previous_config,
+                                      Server::Configuration::ServerFactoryContext& factory_context,
+                                      bool validate_clusters_default) const {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.rds_share_unchanged_virtual_hosts")) {
+    return createConfig(rc, factory_context, validate_clusters_default);
+  }
+  ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
+  return THROW_OR_RETURN_VALUE(
+      ConfigImpl::createUpdate(
+          static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
+          dynamic_cast<const ConfigImpl*>(previous_config.get()), factory_context, validator_,
+          validate_clusters_default),
+      std::shared_ptr<ConfigImpl>);
+}
+
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
                                                 const std::string& version_info) {
   uint64_t new_hash = base_.getHash(rc);
@@ -26,6 +26,12 @@ public:
   Rds::ConfigConstSharedPtr createConfig(const Protobuf::Message& rc,
                                          Server::Configuration::ServerFactoryContext& context,
                                          bool validate_clusters_default) const override;
+  // Shares the unchanged virtual hosts of the previous config.
+  Rds::ConfigConstSharedPtr
+  createUpdatedConfig(const Protobuf::Message& rc,
+                      const Rds::ConfigConstSharedPtr& previous_config,
+                      Server::Configuration::ServerFactoryContext& context,
+                      bool validate_clusters_default) const override;
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
@@ -0,0 +1,91 @@
+#include "source/common/router/route_path_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Router {
+
+void RoutePathIndex::addExact(absl::string_view path, uint32_t index) {
+  exact_paths_[path].push_back(index);
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addPrefix(absl::string_view prefix, uint32_t index) {
+  IndexList* existing = prefixes_.find(prefix);
+  if (existing != nullptr) {
+    existing->push_back(index);
+  } else {
+    prefix_lists_.push_back(std::make_unique<IndexList>(IndexList{index}));
+    prefixes_.add(prefix, prefix_lists_.back().get());
+  }
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addUnindexed(uint32_t index) {
+  ASSERT(unindexed_.empty() || unindexed_.back() < index);
+  unindexed_.push_back(index);
+}
+
+bool RoutePathIndex::addRegex(const std::string& regex, uint32_t index) {
+  ASSERT(regex_routes_.empty() || regex_routes_.back() < index);
+  if (regex_set_ == nullptr) {
+    // The same options as the RE2 regex matchers, which fully match the path.
+    regex_set_ = std::make_unique<re2::RE2::Set>(re2::RE2::Options(re2::RE2::Quiet),
+                                                 re2::RE2::ANCHOR_BOTH);
+  }
+  if (regex_set_->Add(regex, nullptr) < 0) {
+    return false;
+  }
+  regex_routes_.push_back(index);
+  ++indexed_routes_;
+  return true;
+}
+
+void RoutePathIndex::finalize() {
+  if (regex_set_ == nullptr || regex_set_->Compile()) {
+    return;
+  }
+  std::vector<uint32_t> unindexed;
+  unindexed.reserve(unindexed_.size() + regex_routes_.size());
+  std::merge(unindexed_.begin(), unindexed_.end(), regex_routes_.begin(), regex_routes_.end(),
+             std::back_inserter(unindexed));
+  unindexed_ = std::move(unindexed);
+  indexed_routes_ -= regex_routes_.size();
+  regex_routes_.clear();
+  regex_set_.reset();
+}
+
+void RoutePathIndex::findCandidates(absl::string_view path, Candidates& candidates) const {
+  Candidates indexed;
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(path, &matches, &error_info)) {
+      for (const int match : matches) {
+        indexed.push_back(regex_routes_[match]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The set could not be matched, e.g. because the DFA ran out of memory, so every regex
+      // route has to be tried.
+      indexed.insert(indexed.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+  if (auto it = exact_paths_.find(path); it != exact_paths_.end()) {
+    indexed.insert(indexed.end(), it->second.begin(), it->second.end());
+  }
+  for (const IndexList* list : prefixes_.findMatchingPrefixes(path)) {
+    indexed.insert(indexed.end(), list->begin(), list->end());
+  }
+  std::sort(indexed.begin(), indexed.end());
+
+  candidates.clear();
+  candidates.reserve(indexed.size() + unindexed_.size());
+  std::merge(indexed.begin(), indexed.end(), unindexed_.begin(), unindexed_.end(),
+             std::back_inserter(candidates));
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/common/radix_tree.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the ordered routes of a virtual host that narrows down which routes may match a
+ * request path. Routes with a case sensitive exact path or prefix match are indexed by their path
+ * in a hash map and a radix tree respectively, and routes with a RE2 path regex by a single
+ * RE2::Set which finds all the regexes matching a path in one scan. All other routes are
+ * candidates for every path.
+ * Routes are identified by their position in the virtual host's route list, and candidates are
+ * returned in that order, so that evaluating them in turn preserves first match semantics while
+ * skipping routes whose path can not match.
+ */
+class RoutePathIndex {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * Adds a route that matches request paths equal to `path`.
+   * @param index the position of the route. Routes must be added in increasing position order.
+   */
+  void addExact(absl::string_view path, uint32_t index);
+
+  /**
+   * Adds a route that matches request paths starting with `prefix`.
+   * @param index the position of the route. Routes must be added in increasing position order.
+   */
+  void addPrefix(absl::string_view prefix, uint32_t index);
+
+  /**
+   * Adds a route whose path matching can not be indexed, which is a candidate for every path.
+   * @param index the position of the route. Routes must be added in increasing position order.
+   */
+  void addUnindexed(uint32_t index);
+
+  /**
+   * Adds a route that matches request paths fully matched by the RE2 `regex`.
+   * @param index the position of the route. Routes must be added in increasing position order.
+   * @return false if the regex could not be added to the set, in which case the route has to be
+   * added as unindexed instead.
+   */
+  bool addRegex(const std::string& regex, uint32_t index);
+
+  /**
+   * Compiles the regexes added by addRegex(), which must be called before findCandidates() once
+   * all the routes are added. If the set fails to compile, e.g. because it exceeds the RE2 memory
+   * budget, the regex routes become candidates for every path.
+   */
+  void finalize();
+
+  /**
+   * @param path the request path, with the query string and fragment removed.
+   * @param candidates receives the positions of all routes whose path matching may match `path`,
+   * in increasing order.
+   */
+  void findCandidates(absl::string_view path, Candidates& candidates) const;
+
+  /**
+   * @return the number of routes indexed by exact path, prefix or regex.
+   */
+  uint32_t indexedRoutes() const { return indexed_routes_; }
+
+private:
+  using IndexList = absl::InlinedVector<uint32_t, 1>;
+
+  absl::flat_hash_map<std::string, IndexList> exact_paths_;
+  // The radix tree only stores pointers, the lists are owned by prefix_lists_.
+  RadixTree<IndexList*> prefixes_;
+  std::vector<std::unique_ptr<IndexList>> prefix_lists_;
+  std::vector<uint32_t> unindexed_;
+  // The regex routes, by their position in regex_set_.
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  std::vector<uint32_t> regex_routes_;
+  uint32_t indexed_routes_{};
+};
+
+} // namespace Router
+} // namespace Envoy
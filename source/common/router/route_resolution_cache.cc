@@ -0,0 +1,42 @@
+#include "source/common/router/route_resolution_cache.h"
+
+#include "source/common/http/path_utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Router {
+
+VirtualHostRoute RouteResolutionCache::route(const ConfigConstSharedPtr& config,
+                                             const Http::RequestHeaderMap& headers,
+                                             const StreamInfo::StreamInfo& stream_info,
+                                             uint64_t random_value) {
+  if (!config->routeResolutionCacheable() || headers.Host() == nullptr ||
+      headers.Path() == nullptr) {
+    return config->route(nullptr, headers, stream_info, random_value);
+  }
+
+  if (config != config_) {
+    entries_.clear();
+    config_ = config;
+  }
+
+  // Header values can not contain NUL characters, which makes them a safe separator.
+  constexpr absl::string_view separator("\0", 1);
+  key_.clear();
+  absl::StrAppend(&key_, headers.getHostValue(), separator, headers.getForwardedProtoValue(),
+                  separator, Http::PathUtil::removeQueryAndFragment(headers.getPathValue()));
+  if (auto it = entries_.find(key_); it != entries_.end()) {
+    return it->second;
+  }
+
+  VirtualHostRoute result = config->route(nullptr, headers, stream_info, random_value);
+  if (entries_.size() >= max_entries_) {
+    entries_.clear();
+  }
+  entries_.emplace(key_, result);
+  return result;
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "envoy/http/header_map.h"
+#include "envoy/router/router.h"
+#include "envoy/stream_info/stream_info.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Bounded cache of the routes resolved for the requests of a single downstream connection.
+ * Multiplexed connections from API clients tend to send many requests for the same host and path,
+ * which would otherwise walk the virtual host and route tables, including their regexes, for each
+ * request. Results are only cached for route configurations whose route selection depends on
+ * nothing but these request properties, see Config::routeResolutionCacheable().
+ *
+ * The cache is tied to the route configuration it was last used with, and is cleared when a
+ * request is resolved against another one, such as the configuration installed by an RDS or VHDS
+ * update. When full, the cache is cleared rather than tracking the use of its entries.
+ */
+class RouteResolutionCache : NonCopyable {
+public:
+  static constexpr uint32_t DefaultMaxEntries = 64;
+
+  explicit RouteResolutionCache(uint32_t max_entries = DefaultMaxEntries)
+      : max_entries_(max_entries) {}
+
+  /**
+   * Resolves the route of a request with config->route(), or returns the result for an earlier
+   * request with the same host, x-forwarded-proto and path if the configuration allows it.
+   */
+  VirtualHostRoute route(const ConfigConstSharedPtr& config, const Http::RequestHeaderMap& headers,
+                         const StreamInfo::StreamInfo& stream_info, uint64_t random_value);
+
+  /**
+   * @return the number of cached results.
+   */
+  size_t size() const { return entries_.size(); }
+
+private:
+  const uint32_t max_entries_;
+  ConfigConstSharedPtr config_;
+  absl::flat_hash_map<std::string, VirtualHostRoute> entries_;
+  // Reused for building the lookup key of each request.
+  std::string key_;
+};
+
+} // namespace Router
+} // namespace Envoy
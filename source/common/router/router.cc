@@ -616,6 +616,21 @@ Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers,
                                          grpc_request_, hedging_params_.hedge_on_per_try_timeout_,
                                          config_->respect_expected_rq_timeout_);
 
+  // The tries are hedged past a percentile of the recent latencies of the cluster, unless their
+  // per try timeout hits first.
+  const absl::optional<double> hedge_latency_percentile =
+      route_entry_->hedgePolicy().hedgeLatencyPercentile();
+  if (hedge_latency_percentile.has_value()) {
+    Upstream::RequestLatencyTracker& latency_tracker = cluster->requestLatencyTracker();
+    latency_tracker.onRequest();
+    const absl::optional<std::chrono::milliseconds> hedge_timeout =
+        latency_tracker.latencyPercentile(hedge_latency_percentile.value());
+    if (hedge_timeout.has_value() && (timeout_.per_try_timeout_.count() == 0 ||
+                                      hedge_timeout.value() < timeout_.per_try_timeout_)) {
+      timeout_.hedge_timeout_ = hedge_timeout.value();
+    }
+  }
+
   // Set x-envoy-attempt-count before finalizeRequestHeaders so it can be referenced.
   include_attempt_count_in_request_ = route_entry_->includeAttemptCountInRequest();
   if (include_attempt_count_in_request_) {
@@ -885,10 +900,17 @@ bool Filter::continueDecodeHeaders(Upstream::ThreadLocalCluster* cluster,
       Http::AsyncClient::OngoingRequest* shadow_stream = config_->shadowWriter().streamingShadow(
           std::string(shadow_cluster_name.value()), std::move(shadow_headers), options);
       if (shadow_stream != nullptr) {
-        shadow_streams_.insert(shadow_stream);
+        auto& abandoning_callbacks = shadow_streams_[shadow_stream];
+        if (shadow_policy.abandonOnBackpressure()) {
+          abandoning_callbacks = std::make_unique<AbandoningShadowWatermarkCallbacks>();
+        }
         shadow_stream->setDestructorCallback(
             [this, shadow_stream]() { shadow_streams_.erase(shadow_stream); });
-        shadow_stream->setWatermarkCallbacks(watermark_callbacks_);
+        if (abandoning_callbacks != nullptr) {
+          shadow_stream->setWatermarkCallbacks(*abandoning_callbacks);
+        } else {
+          shadow_stream->setWatermarkCallbacks(watermark_callbacks_);
+        }
       }
     }
   }
@@ -1053,7 +1075,8 @@ Http::FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_strea
     request_buffer_overflowed_ = true;
   }
 
-  for (auto* shadow_stream : shadow_streams_) {
+  abandonBackedUpShadowStreams();
+  for (const auto& [shadow_stream, abandoning_callbacks] : shadow_streams_) {
     if (end_stream) {
       shadow_stream->removeDestructorCallback();
       shadow_stream->removeWatermarkCallbacks();
@@ -1116,7 +1139,8 @@ Http::FilterTrailersStatus Filter::decodeTrailers(Http::RequestTrailerMap& trail
   if (!upstream_requests_.empty()) {
     upstream_requests_.front()->acceptTrailersFromRouter(trailers);
   }
-  for (auto* shadow_stream : shadow_streams_) {
+  abandonBackedUpShadowStreams();
+  for (const auto& [shadow_stream, abandoning_callbacks] : shadow_streams_) {
     shadow_stream->removeDestructorCallback();
     shadow_stream->removeWatermarkCallbacks();
     shadow_stream->captureAndSendTrailers(
@@ -1171,6 +1195,24 @@ absl::optional<absl::string_view> Filter::getShadowCluster(const ShadowPolicy& p
   }
 }
 
+void Filter::abandonBackedUpShadowStreams() {
+  for (auto it = shadow_streams_.begin(); it != shadow_streams_.end();) {
+    if (it->second == nullptr || !it->second->above_high_watermark_) {
+      ++it;
+      continue;
+    }
+    // The shadow upstream can't keep up: rather than buffering more of the request for it or
+    // slowing down the downstream, give up on shadowing this request.
+    ENVOY_STREAM_LOG(debug, "abandoning shadow stream above its high watermark", *callbacks_);
+    cluster_->trafficStats()->retry_or_shadow_abandoned_.inc();
+    Http::AsyncClient::OngoingRequest* shadow_stream = it->first;
+    shadow_stream->removeDestructorCallback();
+    shadow_stream->removeWatermarkCallbacks();
+    shadow_stream->cancel();
+    shadow_streams_.erase(it++);
+  }
+}
+
 void Filter::applyShadowPolicyHeaders(const ShadowPolicy& shadow_policy,
                                       Http::RequestHeaderMap& headers) const {
   const Envoy::Formatter::Context formatter_context{&headers};
@@ -1235,7 +1277,7 @@ void Filter::onDestroy() {
   resetAll();
 
   // Unregister from shadow stream notifications and cancel active streams.
-  for (auto* shadow_stream : shadow_streams_) {
+  for (const auto& [shadow_stream, abandoning_callbacks] : shadow_streams_) {
     shadow_stream->removeDestructorCallback();
     shadow_stream->removeWatermarkCallbacks();
     shadow_stream->cancel();
@@ -1328,6 +1370,41 @@ void Filter::onSoftPerTryTimeout(UpstreamRequest& upstream_request) {
   }
 }
 
+void Filter::onHedgeTimeout(UpstreamRequest& upstream_request) {
+  // A request is hedged on its latency at most once.
+  timeout_.hedge_timeout_ = std::chrono::milliseconds(0);
+  if (downstream_response_started_ || !retry_state_ || upstream_request.retried()) {
+    return;
+  }
+  // Clusters can technically get removed by CDS during a request.
+  Upstream::ThreadLocalCluster* cluster =
+      config_->cm_.getThreadLocalCluster(route_entry_->clusterName());
+  if (cluster == nullptr) {
+    return;
+  }
+  if (!cluster->requestLatencyTracker().tryHedge(route_entry_->hedgePolicy().hedgeBudgetRatio())) {
+    stats_.rq_hedge_budget_exceeded_.inc();
+    return;
+  }
+
+  const RetryStatus retry_status = retry_state_->shouldHedgeRetryPerTryTimeout(
+      [this, can_use_http3 = upstream_request.upstreamStreamOptions().can_use_http3_]() -> void {
+        doRetry(/*can_send_early_data*/ false, can_use_http3, TimeoutRetry::Yes);
+      });
+  if (retry_status == RetryStatus::Yes) {
+    stats_.rq_hedged_on_latency_.inc();
+    runRetryOptionsPredicates(upstream_request);
+    pending_retries_++;
+    // Keeps the try in flight, but it is no longer retried on its own.
+    upstream_request.retried(true);
+  } else if (retry_status == RetryStatus::NoOverflow) {
+    callbacks_->streamInfo().setResponseFlag(StreamInfo::CoreResponseFlag::UpstreamOverflow);
+  } else if (retry_status == RetryStatus::NoRetryLimitExceeded) {
+    callbacks_->streamInfo().setResponseFlag(
+        StreamInfo::CoreResponseFlag::UpstreamRetryLimitExceeded);
+  }
+}
+
 void Filter::onPerTryIdleTimeout(UpstreamRequest& upstream_request) {
   onPerTryTimeoutCommon(upstream_request,
                         cluster_->trafficStats()->upstream_rq_per_try_idle_timeout_,
@@ -1364,6 +1441,10 @@ void Filter::onPerTryTimeoutCommon(UpstreamRequest& upstream_request, Stats::Cou
 
   // Remove this upstream request from the list now that we're done with it.
   upstream_request.removeFromList(upstream_requests_);
+  // A try hedged on its latency times out while its hedged request may still see a response.
+  if (numRequestsAwaitingHeaders() > 0 || pending_retries_ > 0) {
+    return;
+  }
   onUpstreamTimeoutAbort(StreamInfo::CoreResponseFlag::UpstreamRequestTimeout,
                          response_code_details);
 }
@@ -1956,6 +2037,18 @@ void Filter::onUpstreamComplete(UpstreamRequest& upstream_request) {
         FilterUtility::percentageOfTimeout(response_time, timeout_.global_timeout_));
   }
 
+  if (route_entry_->hedgePolicy().hedgeLatencyPercentile().has_value()) {
+    // Measured as the hedge timeouts, from the try being created with the request complete.
+    Upstream::ThreadLocalCluster* cluster =
+        config_->cm_.getThreadLocalCluster(route_entry_->clusterName());
+    if (cluster != nullptr) {
+      cluster->requestLatencyTracker().recordLatency(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              dispatcher.timeSource().monotonicTime() -
+              std::max(upstream_request.startTime(), downstream_request_complete_time_)));
+    }
+  }
+
   if (config_->emit_dynamic_stats_ && !callbacks_->streamInfo().healthCheck() &&
       DateUtil::timePointValid(downstream_request_complete_time_)) {
     upstream_request.upstreamHost()->outlierDetector().putResponseTime(response_time);
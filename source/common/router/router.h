@@ -36,6 +36,7 @@
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/upstream_factory_context_impl.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/types/optional.h"
 
 namespace Envoy {
@@ -521,6 +522,7 @@ public:
                               bool pool_success) override;
   void onPerTryTimeout(UpstreamRequest& upstream_request) override;
   void onPerTryIdleTimeout(UpstreamRequest& upstream_request) override;
+  void onHedgeTimeout(UpstreamRequest& upstream_request) override;
   void onStreamMaxDurationReached(UpstreamRequest& upstream_request) override;
   void setupRouteTimeoutForWebsocketUpgrade() override;
   void disableRouteTimeoutForWebsocketUpgrade() override;
@@ -580,6 +582,8 @@ private:
                                                      const Http::HeaderMap& headers) const;
   void applyShadowPolicyHeaders(const ShadowPolicy& shadow_policy,
                                 Http::RequestHeaderMap& headers) const;
+  // Cancels the shadow streams abandoning on backpressure which went over their high watermark.
+  void abandonBackedUpShadowStreams();
   bool maybeRetryReset(Http::StreamResetReason reset_reason, UpstreamRequest& upstream_request,
                        TimeoutRetry is_timeout_retry);
   uint32_t numRequestsAwaitingHeaders();
@@ -667,8 +671,21 @@ private:
 
   Network::TransportSocketOptionsConstSharedPtr transport_socket_options_;
   Network::Socket::OptionsSharedPtr upstream_options_;
-  // Set of ongoing shadow streams which have not yet received end stream.
-  absl::flat_hash_set<Http::AsyncClient::OngoingRequest*> shadow_streams_;
+  // Watermark callbacks of a shadow stream abandoned on backpressure, latching that it went over
+  // its high watermark instead of pushing back on the downstream.
+  struct AbandoningShadowWatermarkCallbacks : public Http::SidestreamWatermarkCallbacks {
+    void onSidestreamAboveHighWatermark() override { above_high_watermark_ = true; }
+    void onSidestreamBelowLowWatermark() override {}
+    void addDownstreamWatermarkCallbacks(Http::DownstreamWatermarkCallbacks&) override {}
+    void removeDownstreamWatermarkCallbacks(Http::DownstreamWatermarkCallbacks&) override {}
+
+    bool above_high_watermark_{false};
+  };
+  // Ongoing shadow streams which have not yet received end stream, with their watermark callbacks
+  // if they are abandoned on backpressure, or nullptr if they push back on the downstream.
+  absl::flat_hash_map<Http::AsyncClient::OngoingRequest*,
+                      std::unique_ptr<AbandoningShadowWatermarkCallbacks>>
+      shadow_streams_;
 
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   uint64_t request_body_buffer_limit_{std::numeric_limits<uint64_t>::max()};
@@ -203,6 +203,10 @@ void UpstreamRequest::cleanUp() {
     per_try_idle_timeout_->disableTimer();
   }
 
+  if (hedge_timeout_ != nullptr) {
+    hedge_timeout_->disableTimer();
+  }
+
   if (max_stream_duration_timer_ != nullptr) {
     max_stream_duration_timer_->disableTimer();
   }
@@ -543,6 +547,13 @@ void UpstreamRequest::setupPerTryTimeout() {
         parent_.callbacks()->dispatcher().createTimer([this]() -> void { onPerTryIdleTimeout(); });
     resetPerTryIdleTimer();
   }
+
+  ASSERT(!hedge_timeout_);
+  if (parent_.timeout().hedge_timeout_.count() > 0) {
+    hedge_timeout_ =
+        parent_.callbacks()->dispatcher().createTimer([this]() -> void { onHedgeTimeout(); });
+    hedge_timeout_->enableTimer(parent_.timeout().hedge_timeout_);
+  }
 }
 
 void UpstreamRequest::onPerTryIdleTimeout() {
@@ -551,6 +562,9 @@ void UpstreamRequest::onPerTryIdleTimeout() {
     // Disable the per try idle timer, so it does not trigger further retries
     per_try_timeout_->disableTimer();
   }
+  if (hedge_timeout_) {
+    hedge_timeout_->disableTimer();
+  }
   stream_info_.setResponseFlag(StreamInfo::CoreResponseFlag::StreamIdleTimeout);
   parent_.onPerTryIdleTimeout(*this);
 }
@@ -575,6 +589,14 @@ void UpstreamRequest::onPerTryTimeout() {
   }
 }
 
+void UpstreamRequest::onHedgeTimeout() {
+  // As with the per try timeout, a try whose response started is not hedged.
+  if (!parent_.downstreamResponseStarted()) {
+    ENVOY_STREAM_LOG(debug, "upstream hedge timeout", *parent_.callbacks());
+    parent_.onHedgeTimeout(*this);
+  }
+}
+
 void UpstreamRequest::recordConnectionPoolCallbackLatency() {
   upstreamTiming().recordConnectionPoolCallbackLatency(
       start_time_, parent_.callbacks()->dispatcher().timeSource());
@@ -866,6 +888,10 @@ void UpstreamRequest::disablePerTryTimeoutForWebsocketUpgrade() {
     per_try_idle_timeout_->disableTimer();
     per_try_idle_timeout_.reset();
   }
+  if (hedge_timeout_ != nullptr) {
+    hedge_timeout_->disableTimer();
+    hedge_timeout_.reset();
+  }
 }
 
 } // namespace Router
@@ -168,6 +168,7 @@ public:
   // Exposes streamInfo for the upstream stream.
   StreamInfo::StreamInfo& streamInfo() { return stream_info_; }
   bool hadUpstream() const { return had_upstream_; }
+  MonotonicTime startTime() const { return start_time_; }
   // Disable per-try timeouts for websocket upgrades after successful handshake
   void disablePerTryTimeoutForWebsocketUpgrade();
 
@@ -189,6 +190,7 @@ private:
   }
   void resetPerTryIdleTimer();
   void onPerTryTimeout();
+  void onHedgeTimeout();
   void onPerTryIdleTimeout();
   void upstreamLog(AccessLog::AccessLogType access_log_type);
   void resetUpstreamLogFlushTimer();
@@ -197,6 +199,7 @@ private:
   std::unique_ptr<GenericConnPool> conn_pool_;
   Event::TimerPtr per_try_timeout_;
   Event::TimerPtr per_try_idle_timeout_;
+  Event::TimerPtr hedge_timeout_;
   std::unique_ptr<GenericUpstream> upstream_;
   absl::optional<Http::StreamResetReason> deferred_reset_reason_;
   Upstream::HostDescriptionConstSharedPtr upstream_host_;
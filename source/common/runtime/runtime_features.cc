@@ -34,12 +34,17 @@
 // If issues are found that require a runtime feature to be disabled, it should be reported
 // ASAP by filing a bug on github. Overriding non-buggy code is strongly discouraged to avoid the
 // problem of the bugs being found after the old code path has been removed.
+RUNTIME_GUARD(envoy_reloadable_features_account_stream_headers_and_filter_buffers);
 RUNTIME_GUARD(envoy_reloadable_features_async_host_selection);
+RUNTIME_GUARD(envoy_reloadable_features_batch_cds_thread_local_updates);
+RUNTIME_GUARD(envoy_reloadable_features_cel_shared_stream_activation);
 RUNTIME_GUARD(envoy_reloadable_features_coalesce_lb_rebuilds_on_batch_update);
 RUNTIME_GUARD(envoy_reloadable_features_codec_client_enable_idle_timer_only_when_connected);
 RUNTIME_GUARD(envoy_reloadable_features_decouple_explicit_drain_pools_and_dns_refresh);
+RUNTIME_GUARD(envoy_reloadable_features_dfp_cluster_batch_host_updates);
 RUNTIME_GUARD(envoy_reloadable_features_dfp_cluster_resolves_hosts);
 RUNTIME_GUARD(envoy_reloadable_features_disallow_quic_client_udp_mmsg);
+RUNTIME_GUARD(envoy_reloadable_features_enable_cel_constant_folding);
 RUNTIME_GUARD(envoy_reloadable_features_enable_cel_regex_precompilation);
 RUNTIME_GUARD(envoy_reloadable_features_enable_cel_response_path_matching);
 RUNTIME_GUARD(envoy_reloadable_features_enable_compression_bomb_protection);
@@ -62,23 +67,29 @@ RUNTIME_GUARD(envoy_reloadable_features_http_async_client_retry_respect_buffer_l
 RUNTIME_GUARD(envoy_reloadable_features_http_reject_path_with_fragment);
 RUNTIME_GUARD(envoy_reloadable_features_mcp_filter_use_new_metadata_namespace);
 RUNTIME_GUARD(envoy_reloadable_features_mobile_use_network_observer_registry);
+RUNTIME_GUARD(envoy_reloadable_features_mongo_proxy_lazy_bson_documents);
 RUNTIME_GUARD(envoy_reloadable_features_no_extension_lookup_by_name);
 RUNTIME_GUARD(envoy_reloadable_features_oauth2_cleanup_cookies);
 RUNTIME_GUARD(envoy_reloadable_features_oauth2_encrypt_tokens);
 RUNTIME_GUARD(envoy_reloadable_features_odcds_over_ads_fix);
 RUNTIME_GUARD(envoy_reloadable_features_on_demand_cluster_no_recreate_stream);
 RUNTIME_GUARD(envoy_reloadable_features_on_demand_track_end_stream);
+RUNTIME_GUARD(envoy_reloadable_features_optimize_match_trees);
 RUNTIME_GUARD(envoy_reloadable_features_original_dst_rely_on_idle_timeout);
 RUNTIME_GUARD(envoy_reloadable_features_prefix_map_matcher_resume_after_subtree_miss);
 RUNTIME_GUARD(envoy_reloadable_features_proxy_protocol_allow_duplicate_tlvs);
 RUNTIME_GUARD(envoy_reloadable_features_quic_defer_logging_to_ack_listener);
 RUNTIME_GUARD(envoy_reloadable_features_quic_fix_defer_logging_miss_for_half_closed_stream);
+RUNTIME_GUARD(envoy_reloadable_features_quic_send_body_from_shared_buffer);
+RUNTIME_GUARD(envoy_reloadable_features_quic_shed_tls_handshake_config);
 // Ignore the automated "remove this flag" issue: we should keep this for 1 year. Confirm with
 // @danzh2010 or @RyanTheOptimist before removing.
 RUNTIME_GUARD(envoy_reloadable_features_quic_send_server_preferred_address_to_all_clients);
 RUNTIME_GUARD(envoy_reloadable_features_quic_signal_headers_only_to_http1_backend);
 RUNTIME_GUARD(envoy_reloadable_features_quic_upstream_reads_fixed_number_packets);
 RUNTIME_GUARD(envoy_reloadable_features_quic_upstream_socket_use_address_cache_for_read);
+RUNTIME_GUARD(envoy_reloadable_features_rbac_shared_matchers);
+RUNTIME_GUARD(envoy_reloadable_features_rds_share_unchanged_virtual_hosts);
 RUNTIME_GUARD(envoy_reloadable_features_reject_empty_trusted_ca_file);
 RUNTIME_GUARD(envoy_reloadable_features_report_load_when_rq_active_is_non_zero);
 RUNTIME_GUARD(envoy_reloadable_features_reset_ignore_upstream_reason);
@@ -88,6 +99,7 @@ RUNTIME_GUARD(envoy_reloadable_features_skip_dns_lookup_for_proxied_requests);
 RUNTIME_GUARD(envoy_reloadable_features_tcp_proxy_odcds_over_ads_fix);
 RUNTIME_GUARD(envoy_reloadable_features_tcp_proxy_set_idle_timer_immediately_on_new_connection);
 RUNTIME_GUARD(envoy_reloadable_features_test_feature_true);
+RUNTIME_GUARD(envoy_reloadable_features_thrift_unframed_payload_passthrough);
 RUNTIME_GUARD(envoy_reloadable_features_trace_refresh_after_route_refresh);
 RUNTIME_GUARD(envoy_reloadable_features_udp_set_do_not_fragment);
 RUNTIME_GUARD(envoy_reloadable_features_uhv_allow_malformed_url_encoding);
@@ -96,11 +108,14 @@ RUNTIME_GUARD(envoy_reloadable_features_use_migration_in_quiche);
 RUNTIME_GUARD(envoy_reloadable_features_use_response_decoder_handle);
 RUNTIME_GUARD(envoy_reloadable_features_validate_connect);
 RUNTIME_GUARD(envoy_reloadable_features_validate_upstream_headers);
+RUNTIME_GUARD(envoy_reloadable_features_vhost_route_path_index);
+RUNTIME_GUARD(envoy_reloadable_features_vhost_route_regex_set);
 RUNTIME_GUARD(envoy_reloadable_features_wasm_use_effective_ctx_for_foreign_functions);
 RUNTIME_GUARD(envoy_reloadable_features_websocket_allow_4xx_5xx_through_filter_chain);
 RUNTIME_GUARD(envoy_reloadable_features_websocket_enable_timeout_on_upgrade_response);
 RUNTIME_GUARD(envoy_reloadable_features_xds_failover_to_primary_enabled);
 RUNTIME_GUARD(envoy_reloadable_features_xds_legacy_delta_skip_subsequent_node);
+RUNTIME_GUARD(envoy_reloadable_features_xds_reuse_unchanged_decoded_resources);
 
 RUNTIME_GUARD(envoy_restart_features_move_locality_schedulers_to_lb);
 RUNTIME_GUARD(envoy_restart_features_raise_file_limits);
@@ -146,6 +161,9 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_dns_cache_set_ip_version_to_remove
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_quic_no_tcp_delay);
 // Adding runtime flag to use balsa_parser for http_inspector.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_inspector_use_balsa_parser);
+// Flag to have the user space io handles of internal connections notify the data written by their
+// peers within the current event loop iteration, rather than the next one.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_user_space_io_handle_current_iteration_events);
 // TODO(danzh) re-enable it when the issue of preferring TCP over v6 rather than QUIC over v4 is
 // fixed.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_http3_happy_eyeballs);
@@ -213,6 +231,60 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_use_oghttp2);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_dynamic_modules_strip_custom_stat_prefix);
 // TODO(haoyuewang): Flip true after prod testing.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_quic_disable_data_read_immediately);
+// Recycles default sized buffer slice storage through a thread local free list. Flip to true after
+// prod testing.
+FALSE_RUNTIME_GUARD(envoy_restart_features_buffer_slice_free_list);
+// Allocates header map entries from a per header map arena. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_header_map_entry_arena);
+// Ends HTTP/2 DATA frames on buffer slice boundaries to avoid copying their payload. Flip to true
+// after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_align_data_frames_to_slices);
+// Caches the routes resolved for the requests of a downstream connection. Flip to true after prod
+// testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_connection_route_resolution_cache);
+// Shards counters by thread, so that increments don't contend between workers. Flip to true after
+// prod testing.
+FALSE_RUNTIME_GUARD(envoy_restart_features_sharded_counters);
+// Spreads the merge of the thread local histograms over the workers on stats flushes. Flip to true
+// after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_parallel_histogram_merge);
+// Rebuilds ring hash and maglev tables on a background thread after the initial build. Flip to true
+// after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_hash_lb_background_table_builds);
+// Stores at most one ORCA load report per host and weight update period in the client side weighted
+// round robin load balancer. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_wrr_coalesce_orca_reports);
+// Chooses the locality for residual zone aware routing with a single random number. Flip to true
+// after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_zone_aware_locality_choice_table);
+// Shares the resolved endpoint addresses of static and EDS clusters across clusters. Flip to true
+// after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_share_endpoint_addresses);
+// Caches upstream TLS sessions per upstream host and SNI. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_tls_host_keyed_session_cache);
+// Runs the health check intervals of each health checker from a single bucketed timer. Flip to
+// true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_health_check_shared_interval_timer);
+// Shares the probes of identical HTTP health checks of the same endpoint across clusters. Flip to
+// true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_health_check_shared_probes);
+// Counts outlier detection success rate requests in per-thread shards. Flip to true after prod
+// testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_outlier_detection_sharded_success_rate);
+// Lets the connectivity grid preconnect to the HTTP/3 or TCP pool. Flip to true after prod
+// testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_connectivity_grid_preconnect);
+// Counts circuit breaker connections and requests per thread. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_sharded_circuit_breakers);
+// Expires idle UDP proxy sessions from a single bucketed timer per filter instead of a timer per
+// session. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_udp_proxy_idle_timer_wheel);
+// Tracks the min durations of scaled timers in a timer wheel per dispatcher instead of a timer per
+// scaled timer. Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_scaled_timer_wheel);
+// Coalesces the redis commands written to an upstream connection within an event loop iteration.
+// Flip to true after prod testing.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_redis_coalesce_upstream_writes);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
@@ -79,6 +79,30 @@ void refreshReloadableFlags(const Snapshot::EntryMap& flag_map) {
   markRuntimeInitialized();
 }
 
+uint64_t integerValue(const Snapshot::Entry* entry, uint64_t default_value) {
+  if (entry == nullptr || !entry->uint_value_) {
+    return default_value;
+  } else {
+    return entry->uint_value_.value();
+  }
+}
+
+double doubleValue(const Snapshot::Entry* entry, double default_value) {
+  if (entry == nullptr || !entry->double_value_) {
+    return default_value;
+  } else {
+    return entry->double_value_.value();
+  }
+}
+
+bool booleanValue(const Snapshot::Entry* entry, bool default_value) {
+  if (entry == nullptr || !entry->bool_value_.has_value()) {
+    return default_value;
+  } else {
+    return entry->bool_value_.value();
+  }
+}
+
 } // namespace
 
 bool SnapshotImpl::deprecatedFeatureEnabled(absl::string_view key, bool default_value) const {
@@ -134,11 +158,11 @@ bool SnapshotImpl::featureEnabled(absl::string_view key, uint64_t default_value,
 
 Snapshot::ConstStringOptRef SnapshotImpl::get(absl::string_view key) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  auto entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end()) {
+  const Entry* entry = findEntry(key);
+  if (entry == nullptr) {
     return absl::nullopt;
   } else {
-    return entry->second.raw_string_value_;
+    return entry->raw_string_value_;
   }
 }
 
@@ -150,22 +174,32 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 bool SnapshotImpl::featureEnabled(absl::string_view key,
                                   const envoy::type::v3::FractionalPercent& default_value,
                                   uint64_t random_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
+  return fractionalPercentEnabled(findEntry(key), key, default_value, random_value);
+}
+
+bool SnapshotImpl::featureEnabled(const ResolvedKey& key,
+                                  const envoy::type::v3::FractionalPercent& default_value) const {
+  return fractionalPercentEnabled(findEntry(key), key.key(), default_value, generator_.random());
+}
+
+bool SnapshotImpl::fractionalPercentEnabled(const Entry* entry, absl::string_view key,
+                                            const envoy::type::v3::FractionalPercent& default_value,
+                                            uint64_t random_value) const {
   envoy::type::v3::FractionalPercent percent;
-  if (entry != values_.end() && entry->second.fractional_percent_value_.has_value()) {
-    percent = entry->second.fractional_percent_value_.value();
-  } else if (entry != values_.end() && entry->second.uint_value_.has_value()) {
+  if (entry != nullptr && entry->fractional_percent_value_.has_value()) {
+    percent = entry->fractional_percent_value_.value();
+  } else if (entry != nullptr && entry->uint_value_.has_value()) {
     // Check for > 100 because the runtime value is assumed to be specified as
     // an integer, and it also ensures that truncating the uint64_t runtime
     // value into a uint32_t percent numerator later is safe
-    if (entry->second.uint_value_.value() > 100) {
+    if (entry->uint_value_.value() > 100) {
       return true;
     }
 
     // The runtime value was specified as an integer rather than a fractional
     // percent proto. To preserve legacy semantics, we treat it as a percentage
     // (i.e. denominator of 100).
-    percent.set_numerator(entry->second.uint_value_.value());
+    percent.set_numerator(entry->uint_value_.value());
     percent.set_denominator(envoy::type::v3::FractionalPercent::HUNDRED);
   } else {
     percent = default_value;
@@ -189,49 +223,82 @@ bool SnapshotImpl::featureEnabled(absl::string_view key,
 
 uint64_t SnapshotImpl::getInteger(absl::string_view key, uint64_t default_value) const {
   ASSERT(!isRuntimeFeature(key));
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.uint_value_) {
-    return default_value;
-  } else {
-    return entry->second.uint_value_.value();
-  }
+  return integerValue(findEntry(key), default_value);
 }
 
 double SnapshotImpl::getDouble(absl::string_view key, double default_value) const {
   ASSERT(!isRuntimeFeature(key)); // Make sure runtime guarding is only used for getBoolean
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.double_value_) {
-    return default_value;
-  } else {
-    return entry->second.double_value_.value();
-  }
+  return doubleValue(findEntry(key), default_value);
 }
 
 bool SnapshotImpl::getBoolean(absl::string_view key, bool default_value) const {
-  const auto& entry = key.empty() ? values_.end() : values_.find(key);
-  if (entry == values_.end() || !entry->second.bool_value_.has_value()) {
-    return default_value;
-  } else {
-    return entry->second.bool_value_.value();
-  }
+  return booleanValue(findEntry(key), default_value);
+}
+
+uint64_t SnapshotImpl::getInteger(const ResolvedKey& key, uint64_t default_value) const {
+  ASSERT(!isRuntimeFeature(key.key()));
+  return integerValue(findEntry(key), default_value);
+}
+
+double SnapshotImpl::getDouble(const ResolvedKey& key, double default_value) const {
+  ASSERT(!isRuntimeFeature(key.key()));
+  return doubleValue(findEntry(key), default_value);
+}
+
+bool SnapshotImpl::getBoolean(const ResolvedKey& key, bool default_value) const {
+  return booleanValue(findEntry(key), default_value);
 }
 
 const std::vector<Snapshot::OverrideLayerConstPtr>& SnapshotImpl::getLayers() const {
-  return layers_;
+  return *layers_;
 }
 
 const Snapshot::EntryMap& SnapshotImpl::values() const { return values_; }
 
+const Snapshot::Entry* SnapshotImpl::findEntry(absl::string_view key) const {
+  if (key.empty()) {
+    return nullptr;
+  }
+  const auto it = values_.find(key);
+  return it == values_.end() ? nullptr : &it->second;
+}
+
+const Snapshot::Entry* SnapshotImpl::findEntry(const ResolvedKey& key) const {
+  if (key.index() < resolved_entries_.size()) {
+    return resolved_entries_[key.index()];
+  }
+  // Resolved after this snapshot was loaded.
+  return findEntry(key.key());
+}
+
 SnapshotImpl::SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& stats,
-                           std::vector<OverrideLayerConstPtr>&& layers)
-    : layers_{std::move(layers)}, generator_{generator}, stats_{stats} {
-  for (const auto& layer : layers_) {
+                           std::vector<OverrideLayerConstPtr>&& layers,
+                           const std::vector<std::string>& resolved_keys)
+    : layers_{std::make_shared<const std::vector<OverrideLayerConstPtr>>(std::move(layers))},
+      generator_{generator}, stats_{stats} {
+  for (const auto& layer : *layers_) {
     for (const auto& kv : layer->values()) {
       values_.erase(kv.first);
       values_.emplace(kv.first, kv.second);
     }
   }
   stats.num_keys_.set(values_.size());
+  resolveKeys(resolved_keys);
+}
+
+SnapshotImpl::SnapshotImpl(const SnapshotImpl& snapshot,
+                           const std::vector<std::string>& resolved_keys)
+    : layers_{snapshot.layers_}, values_{snapshot.values_}, generator_{snapshot.generator_},
+      stats_{snapshot.stats_} {
+  resolveKeys(resolved_keys);
+}
+
+void SnapshotImpl::resolveKeys(const std::vector<std::string>& resolved_keys) {
+  // The values are not modified anymore, so their addresses are stable.
+  resolved_entries_.reserve(resolved_keys.size());
+  for (const std::string& key : resolved_keys) {
+    resolved_entries_.push_back(findEntry(key));
+  }
 }
 
 void parseFractionValue(SnapshotImpl::Entry& entry, const Protobuf::Struct& value) {
@@ -470,13 +537,13 @@ absl::Status ProtoLayer::walkProtoValue(const Protobuf::Value& v, const std::str
   return absl::OkStatus();
 }
 
-LoaderImpl::LoaderImpl(ThreadLocal::SlotAllocator& tls,
+LoaderImpl::LoaderImpl(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls,
                        const envoy::config::bootstrap::v3::LayeredRuntime& config,
                        const LocalInfo::LocalInfo& local_info, Stats::Store& store,
                        Random::RandomGenerator& generator, Api::Api& api)
-    : generator_(generator), stats_(generateStats(store)), tls_(tls.allocateSlot()),
-      config_(config), service_cluster_(local_info.clusterName()), api_(api),
-      init_watcher_("RTDS", [this]() { onRtdsReady(); }), store_(store) {}
+    : dispatcher_(dispatcher), generator_(generator), stats_(generateStats(store)),
+      tls_(tls.allocateSlot()), config_(config), service_cluster_(local_info.clusterName()),
+      api_(api), init_watcher_("RTDS", [this]() { onRtdsReady(); }), store_(store) {}
 
 absl::StatusOr<std::unique_ptr<LoaderImpl>>
 LoaderImpl::create(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls,
@@ -484,8 +551,8 @@ LoaderImpl::create(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tl
                    const LocalInfo::LocalInfo& local_info, Stats::Store& store,
                    Random::RandomGenerator& generator,
                    ProtobufMessage::ValidationVisitor& validation_visitor, Api::Api& api) {
-  auto loader =
-      std::unique_ptr<LoaderImpl>(new LoaderImpl(tls, config, local_info, store, generator, api));
+  auto loader = std::unique_ptr<LoaderImpl>(
+      new LoaderImpl(dispatcher, tls, config, local_info, store, generator, api));
   auto result = loader->initLayers(dispatcher, validation_visitor);
   RETURN_IF_NOT_OK(result);
   return loader;
@@ -649,17 +716,33 @@ absl::Status LoaderImpl::loadNewSnapshot() {
   auto snapshot_or_error = createNewSnapshot();
   RETURN_IF_NOT_OK_REF(snapshot_or_error.status());
   std::shared_ptr<SnapshotImpl> ptr = std::move(snapshot_or_error.value());
-  tls_->set([ptr](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
-    return std::static_pointer_cast<ThreadLocal::ThreadLocalObject>(ptr);
-  });
-
+  setSnapshot(ptr);
   refreshReloadableFlags(ptr->values());
+  return absl::OkStatus();
+}
 
+void LoaderImpl::loadResolvedKeys() {
+  std::shared_ptr<const SnapshotImpl> current;
   {
-    absl::MutexLock lock(snapshot_mutex_);
-    thread_safe_snapshot_ = ptr;
+    absl::ReaderMutexLock lock(snapshot_mutex_);
+    current = std::static_pointer_cast<const SnapshotImpl>(thread_safe_snapshot_);
   }
-  return absl::OkStatus();
+  std::shared_ptr<SnapshotImpl> ptr;
+  {
+    absl::MutexLock lock(resolved_keys_mutex_);
+    resolved_keys_load_pending_ = false;
+    ptr = std::make_shared<SnapshotImpl>(*current, resolved_keys_);
+  }
+  setSnapshot(std::move(ptr));
+}
+
+void LoaderImpl::setSnapshot(std::shared_ptr<SnapshotImpl> snapshot) {
+  tls_->set([snapshot](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
+    return std::static_pointer_cast<ThreadLocal::ThreadLocalObject>(snapshot);
+  });
+
+  absl::MutexLock lock(snapshot_mutex_);
+  thread_safe_snapshot_ = std::move(snapshot);
 }
 
 const Snapshot& LoaderImpl::snapshot() const {
@@ -691,6 +774,30 @@ Stats::Scope& LoaderImpl::getRootScope() { return *store_.rootScope(); }
 
 void LoaderImpl::countDeprecatedFeatureUse() const { countDeprecatedFeatureUseInternal(stats_); }
 
+ResolvedKey LoaderImpl::resolveKey(absl::string_view key) {
+  uint32_t index;
+  bool post_load = false;
+  {
+    absl::MutexLock lock(resolved_keys_mutex_);
+    auto [it, inserted] = resolved_key_indexes_.try_emplace(key, resolved_keys_.size());
+    index = it->second;
+    if (inserted) {
+      resolved_keys_.emplace_back(key);
+      // The keys resolved together, as when loading a configuration, are loaded in one snapshot.
+      post_load = !resolved_keys_load_pending_;
+      resolved_keys_load_pending_ = true;
+    }
+  }
+  if (post_load) {
+    dispatcher_.post([this, still_alive = std::weak_ptr<bool>(still_alive_)]() {
+      if (still_alive.lock()) {
+        loadResolvedKeys();
+      }
+    });
+  }
+  return ResolvedKey(std::string(key), index);
+}
+
 RuntimeStats LoaderImpl::generateStats(Stats::Store& store) {
   std::string prefix = "runtime.";
   RuntimeStats stats{
@@ -767,7 +874,8 @@ absl::StatusOr<SnapshotImplPtr> LoaderImpl::createNewSnapshot() {
   } else {
     stats_.override_dir_not_exists_.inc();
   }
-  return std::make_unique<SnapshotImpl>(generator_, stats_, std::move(layers));
+  absl::MutexLock lock(resolved_keys_mutex_);
+  return std::make_unique<SnapshotImpl>(generator_, stats_, std::move(layers), resolved_keys_);
 }
 
 } // namespace Runtime
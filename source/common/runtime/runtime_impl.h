@@ -29,6 +29,7 @@
 #include "source/common/init/target_impl.h"
 #include "source/common/singleton/threadsafe_singleton.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/status/statusor.h"
 #include "spdlog/spdlog.h"
@@ -65,7 +66,10 @@ struct RuntimeStats {
 class SnapshotImpl : public Snapshot, Logger::Loggable<Logger::Id::runtime> {
 public:
   SnapshotImpl(Random::RandomGenerator& generator, RuntimeStats& stats,
-               std::vector<OverrideLayerConstPtr>&& layers);
+               std::vector<OverrideLayerConstPtr>&& layers,
+               const std::vector<std::string>& resolved_keys = {});
+  // A snapshot sharing the layers and the values of another, with more resolved keys.
+  SnapshotImpl(const SnapshotImpl& snapshot, const std::vector<std::string>& resolved_keys);
 
   // Runtime::Snapshot
   bool deprecatedFeatureEnabled(absl::string_view key, bool default_value) const override;
@@ -84,6 +88,11 @@ public:
   uint64_t getInteger(absl::string_view key, uint64_t default_value) const override;
   double getDouble(absl::string_view key, double default_value) const override;
   bool getBoolean(absl::string_view key, bool value) const override;
+  bool featureEnabled(const ResolvedKey& key,
+                      const envoy::type::v3::FractionalPercent& default_value) const override;
+  uint64_t getInteger(const ResolvedKey& key, uint64_t default_value) const override;
+  double getDouble(const ResolvedKey& key, double default_value) const override;
+  bool getBoolean(const ResolvedKey& key, bool default_value) const override;
   const std::vector<OverrideLayerConstPtr>& getLayers() const override;
 
   const EntryMap& values() const;
@@ -93,8 +102,17 @@ public:
                        const Protobuf::Value& value, absl::string_view raw_string = "");
 
 private:
-  const std::vector<OverrideLayerConstPtr> layers_;
+  const Entry* findEntry(absl::string_view key) const;
+  const Entry* findEntry(const ResolvedKey& key) const;
+  bool fractionalPercentEnabled(const Entry* entry, absl::string_view key,
+                                const envoy::type::v3::FractionalPercent& default_value,
+                                uint64_t random_value) const;
+  void resolveKeys(const std::vector<std::string>& resolved_keys);
+
+  const std::shared_ptr<const std::vector<OverrideLayerConstPtr>> layers_;
   EntryMap values_;
+  // The entries of the resolved keys by index, nullptr for the keys without a value.
+  std::vector<const Entry*> resolved_entries_;
   Random::RandomGenerator& generator_;
   RuntimeStats& stats_;
 };
@@ -228,10 +246,11 @@ public:
   void startRtdsSubscriptions(ReadyCallback on_done) override;
   Stats::Scope& getRootScope() override;
   void countDeprecatedFeatureUse() const override;
+  ResolvedKey resolveKey(absl::string_view key) override;
 
 private:
   friend RtdsSubscription;
-  LoaderImpl(ThreadLocal::SlotAllocator& tls,
+  LoaderImpl(Event::Dispatcher& dispatcher, ThreadLocal::SlotAllocator& tls,
              const envoy::config::bootstrap::v3::LayeredRuntime& config,
              const LocalInfo::LocalInfo& local_info, Stats::Store& store,
              Random::RandomGenerator& generator, Api::Api& api);
@@ -242,9 +261,13 @@ private:
   absl::StatusOr<SnapshotImplPtr> createNewSnapshot();
   // Load a new Snapshot into TLS
   absl::Status loadNewSnapshot();
+  // Load a copy of the current Snapshot with the keys resolved since it was loaded.
+  void loadResolvedKeys();
+  void setSnapshot(std::shared_ptr<SnapshotImpl> snapshot);
   RuntimeStats generateStats(Stats::Store& store);
   void onRtdsReady();
 
+  Event::Dispatcher& dispatcher_;
   Random::RandomGenerator& generator_;
   RuntimeStats stats_;
   AdminLayerPtr admin_layer_;
@@ -262,6 +285,14 @@ private:
 
   absl::Mutex snapshot_mutex_;
   SnapshotConstSharedPtr thread_safe_snapshot_ ABSL_GUARDED_BY(snapshot_mutex_);
+
+  absl::Mutex resolved_keys_mutex_;
+  std::vector<std::string> resolved_keys_ ABSL_GUARDED_BY(resolved_keys_mutex_);
+  absl::flat_hash_map<std::string, uint32_t>
+      resolved_key_indexes_ ABSL_GUARDED_BY(resolved_keys_mutex_);
+  bool resolved_keys_load_pending_ ABSL_GUARDED_BY(resolved_keys_mutex_){false};
+  // Checked by the posted loads of the resolved keys.
+  const std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
 };
 
 } // namespace Runtime
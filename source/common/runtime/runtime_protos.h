@@ -15,10 +15,10 @@ namespace Runtime {
 class UInt32 : Logger::Loggable<Logger::Id::runtime> {
 public:
   UInt32(const envoy::config::core::v3::RuntimeUInt32& uint32_proto, Runtime::Loader& runtime)
-      : runtime_key_(uint32_proto.runtime_key()), default_value_(uint32_proto.default_value()),
-        runtime_(runtime) {}
+      : runtime_key_(runtime.resolveKey(uint32_proto.runtime_key())),
+        default_value_(uint32_proto.default_value()), runtime_(runtime) {}
 
-  const std::string& runtimeKey() const { return runtime_key_; }
+  const std::string& runtimeKey() const { return runtime_key_.key(); }
 
   uint32_t value() const {
     uint64_t raw_value = runtime_.snapshot().getInteger(runtime_key_, default_value_);
@@ -26,14 +26,14 @@ public:
       ENVOY_LOG_EVERY_POW_2(
           warn,
           "parsed runtime value:{} of {} is larger than uint32 max, returning default instead",
-          raw_value, runtime_key_);
+          raw_value, runtime_key_.key());
       return default_value_;
     }
     return static_cast<uint32_t>(raw_value);
   }
 
 private:
-  const std::string runtime_key_;
+  const ResolvedKey runtime_key_;
   const uint32_t default_value_;
   Runtime::Loader& runtime_;
 };
@@ -43,14 +43,14 @@ class FeatureFlag {
 public:
   FeatureFlag(const envoy::config::core::v3::RuntimeFeatureFlag& feature_flag_proto,
               Runtime::Loader& runtime)
-      : runtime_key_(feature_flag_proto.runtime_key()),
+      : runtime_key_(runtime.resolveKey(feature_flag_proto.runtime_key())),
         default_value_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(feature_flag_proto, default_value, true)),
         runtime_(runtime) {}
 
   bool enabled() const { return runtime_.snapshot().getBoolean(runtime_key_, default_value_); }
 
 private:
-  const std::string runtime_key_;
+  const ResolvedKey runtime_key_;
   const bool default_value_;
   Runtime::Loader& runtime_;
 };
@@ -59,20 +59,21 @@ private:
 class Double {
 public:
   Double(const envoy::config::core::v3::RuntimeDouble& double_proto, Runtime::Loader& runtime)
-      : runtime_key_(double_proto.runtime_key()), default_value_(double_proto.default_value()),
+      : runtime_key_(runtime.resolveKey(double_proto.runtime_key())),
+        default_value_(double_proto.default_value()), runtime_(runtime) {}
+  Double(absl::string_view runtime_key, double default_value, Runtime::Loader& runtime)
+      : runtime_key_(runtime.resolveKey(runtime_key)), default_value_(default_value),
         runtime_(runtime) {}
-  Double(std::string runtime_key, double default_value, Runtime::Loader& runtime)
-      : runtime_key_(std::move(runtime_key)), default_value_(default_value), runtime_(runtime) {}
   virtual ~Double() = default;
 
-  const std::string& runtimeKey() const { return runtime_key_; }
+  const std::string& runtimeKey() const { return runtime_key_.key(); }
 
   virtual double value() const {
     return runtime_.snapshot().getDouble(runtime_key_, default_value_);
   }
 
 protected:
-  const std::string runtime_key_;
+  const ResolvedKey runtime_key_;
   const double default_value_;
   Runtime::Loader& runtime_;
 };
@@ -83,13 +84,13 @@ public:
   FractionalPercent(
       const envoy::config::core::v3::RuntimeFractionalPercent& fractional_percent_proto,
       Runtime::Loader& runtime)
-      : runtime_key_(fractional_percent_proto.runtime_key()),
+      : runtime_key_(runtime.resolveKey(fractional_percent_proto.runtime_key())),
         default_value_(fractional_percent_proto.default_value()), runtime_(runtime) {}
 
   bool enabled() const { return runtime_.snapshot().featureEnabled(runtime_key_, default_value_); }
 
 private:
-  const std::string runtime_key_;
+  const ResolvedKey runtime_key_;
   const envoy::type::v3::FractionalPercent default_value_;
   Runtime::Loader& runtime_;
 };
@@ -9,6 +9,7 @@
 #include "source/common/common/fmt.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "spdlog/spdlog.h"
@@ -45,6 +46,17 @@ CertificateValidationContextConfigImpl::CertificateValidationContextConfigImpl(
       max_verify_depth_(config.has_max_verify_depth()
                             ? absl::optional<uint32_t>(config.max_verify_depth().value())
                             : absl::nullopt),
+      verified_chain_cache_(
+          config.has_verified_chain_cache()
+              ? absl::make_optional<VerifiedChainCacheConfig>(VerifiedChainCacheConfig{
+                    config.verified_chain_cache().max_entries(),
+                    std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
+                        config.verified_chain_cache().max_ttl()))})
+              : absl::nullopt),
+      trust_chain_verification_offload_threads_(
+          config.has_trust_chain_verification_offload()
+              ? absl::optional<uint32_t>(config.trust_chain_verification_offload().thread_count())
+              : absl::nullopt),
       auto_sni_san_match_(auto_sni_san_match) {}
 
 absl::StatusOr<std::unique_ptr<CertificateValidationContextConfigImpl>>
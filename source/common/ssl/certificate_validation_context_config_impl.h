@@ -59,6 +59,14 @@ public:
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
 
+  const absl::optional<VerifiedChainCacheConfig>& verifiedChainCache() const override {
+    return verified_chain_cache_;
+  }
+
+  absl::optional<uint32_t> trustChainVerificationOffloadThreads() const override {
+    return trust_chain_verification_offload_threads_;
+  }
+
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
 
 protected:
@@ -87,6 +95,8 @@ private:
   Api::Api& api_;
   const bool only_verify_leaf_cert_crl_;
   absl::optional<uint32_t> max_verify_depth_;
+  const absl::optional<VerifiedChainCacheConfig> verified_chain_cache_;
+  const absl::optional<uint32_t> trust_chain_verification_offload_threads_;
   const bool auto_sni_san_match_;
 };
 
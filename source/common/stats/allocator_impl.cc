@@ -12,6 +12,7 @@
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_annotations.h"
 #include "source/common/common/utility.h"
+#include "source/common/stats/counter_shards.h"
 #include "source/common/stats/metric_impl.h"
 #include "source/common/stats/stat_merger.h"
 #include "source/common/stats/symbol_table.h"
@@ -121,6 +122,19 @@ public:
   virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
 
 protected:
+  // Only writes the flags if any is missing, so that updating a stat that is already marked is a
+  // plain load, and the flags' cache line stays shared between the threads updating the stat.
+  void setFlags(uint16_t flags) {
+    if ((flags_.load(std::memory_order_relaxed) & flags) != flags) {
+      flags_ |= flags;
+    }
+  }
+  void markChanged() { setFlags(Metric::Flags::Changed); }
+  bool latchChangedFlag() {
+    return (flags_.load(std::memory_order_relaxed) & Metric::Flags::Changed) &&
+           (flags_.fetch_and(~Metric::Flags::Changed) & Metric::Flags::Changed);
+  }
+
   AllocatorImpl& alloc_;
 
   // ref_count_ can be incremented as an atomic, without taking a new lock, as
@@ -137,7 +151,7 @@ protected:
   std::atomic<uint16_t> flags_{0};
 };
 
-class CounterImpl : public StatsSharedImpl<Counter> {
+class CounterImpl final : public StatsSharedImpl<Counter> {
 public:
   CounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
               const StatNameTagVector& stat_name_tags)
@@ -151,27 +165,73 @@ public:
 
   // Stats::Counter
   void add(uint64_t amount) override {
-    // Note that a reader may see a new value but an old pending_increment_ or
-    // used(). From a system perspective this should be eventually consistent.
+    // Adding is a single atomic read-modify-write, the increment since the last latch() is derived
+    // from the value. Note that a reader may see a new value but an old used(). From a system
+    // perspective this should be eventually consistent.
     value_ += amount;
-    pending_increment_ += amount;
-    flags_ |= Flags::Used;
+    setFlags(Flags::Used);
   }
   void inc() override { add(1); }
-  uint64_t latch() override { return pending_increment_.exchange(0); }
-  void reset() override { value_ = 0; }
+  uint64_t latch() override {
+    const uint64_t value = value_;
+    return value - latched_value_.exchange(value);
+  }
+  void reset() override {
+    // Lower the latched value by the value discarded, modulo 2^64, so that the next latch() still
+    // returns the increments since the previous one.
+    latched_value_ -= value_.exchange(0);
+  }
   uint64_t value() const override { return value_; }
 
 private:
   std::atomic<uint64_t> value_{0};
-  std::atomic<uint64_t> pending_increment_{0};
+  // The value at the last latch().
+  std::atomic<uint64_t> latched_value_{0};
 };
 
-class GaugeImpl : public StatsSharedImpl<Gauge> {
+// Counter whose increments are written to the incrementing thread's slot in CounterShards, so that
+// counters incremented by all workers don't have their cache line bounce between the workers'
+// cores. Reading the value sums the slots of all threads.
+class ShardedCounterImpl final : public StatsSharedImpl<Counter> {
+public:
+  ShardedCounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                     const StatNameTagVector& stat_name_tags, uint32_t slot)
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags), slot_(slot) {}
+
+  ~ShardedCounterImpl() override { CounterShards::releaseSlot(slot_); }
+
+  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
+    const size_t count = alloc_.counters_.erase(statName());
+    ASSERT(count == 1);
+    alloc_.sinked_counters_.erase(this);
+  }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    CounterShards::add(slot_, amount);
+    setFlags(Flags::Used);
+  }
+  void inc() override { add(1); }
+  uint64_t latch() override {
+    const uint64_t total = CounterShards::sum(slot_);
+    return total - latched_total_.exchange(total);
+  }
+  void reset() override { reset_total_ = CounterShards::sum(slot_); }
+  uint64_t value() const override { return CounterShards::sum(slot_) - reset_total_; }
+
+private:
+  const uint32_t slot_;
+  // Sums of the slots at the last latch() and reset().
+  std::atomic<uint64_t> latched_total_{0};
+  std::atomic<uint64_t> reset_total_{0};
+};
+
+class GaugeImpl final : public StatsSharedImpl<Gauge> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
             const StatNameTagVector& stat_name_tags, ImportMode import_mode)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {
+    flags_ |= Flags::Changed;
     switch (import_mode) {
     case ImportMode::Accumulate:
       flags_ |= Flags::LogicAccumulate;
@@ -201,20 +261,22 @@ public:
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    setFlags(Flags::Used | Flags::Changed);
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    setFlags(Flags::Used | Flags::Changed);
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    markChanged();
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
+  bool latchChanged() override { return latchChangedFlag(); }
 
   // TODO(diazalan): Rename importMode and to more generic name
   ImportMode importMode() const override {
@@ -251,7 +313,7 @@ public:
       // we clear the accumulated value.
       parent_value_ = 0;
       flags_ &= ~Flags::Used;
-      flags_ |= Flags::NeverImport;
+      flags_ |= Flags::NeverImport | Flags::Changed;
       break;
     case ImportMode::HiddenAccumulate:
       ASSERT(current == ImportMode::Uninitialized);
@@ -261,7 +323,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    markChanged();
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -272,7 +337,9 @@ class TextReadoutImpl : public StatsSharedImpl<TextReadout> {
 public:
   TextReadoutImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
                   const StatNameTagVector& stat_name_tags)
-      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
+      : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {
+    flags_ |= Flags::Changed;
+  }
 
   void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
     const size_t count = alloc_.text_readouts_.erase(statName());
@@ -285,12 +352,13 @@ public:
     std::string value_copy(value);
     absl::MutexLock lock(mutex_);
     value_ = std::move(value_copy);
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   std::string value() const override {
     absl::MutexLock lock(mutex_);
     return value_;
   }
+  bool latchChanged() override { return latchChangedFlag(); }
 
 private:
   mutable absl::Mutex mutex_;
@@ -367,6 +435,12 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
+  if (CounterShards::enabled()) {
+    const absl::optional<uint32_t> slot = CounterShards::allocateSlot();
+    if (slot.has_value()) {
+      return new ShardedCounterImpl(name, *this, tag_extracted_name, stat_name_tags, slot.value());
+    }
+  }
   return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
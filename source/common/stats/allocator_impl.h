@@ -70,6 +70,7 @@ protected:
 private:
   template <class BaseClass> friend class StatsSharedImpl;
   friend class CounterImpl;
+  friend class ShardedCounterImpl;
   friend class GaugeImpl;
   friend class TextReadoutImpl;
   friend class NotifyingAllocatorImpl;
@@ -0,0 +1,153 @@
+#include "source/common/stats/counter_shards.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/thread.h"
+#include "source/common/common/thread_annotations.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+// Chunks are cache line aligned so that the tables of different threads never share a line.
+struct alignas(64) Chunk {
+  std::array<std::atomic<uint64_t>, CounterShards::SlotsPerChunk> slots_{};
+};
+
+class Table {
+public:
+  // Only called by the thread that owns the table.
+  std::atomic<uint64_t>& slot(uint32_t slot) {
+    std::atomic<Chunk*>& chunk_ptr = chunks_[slot / CounterShards::SlotsPerChunk];
+    Chunk* chunk = chunk_ptr.load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+      chunk = new Chunk();
+      chunk_ptr.store(chunk, std::memory_order_release);
+    }
+    return chunk->slots_[slot % CounterShards::SlotsPerChunk];
+  }
+
+  uint64_t value(uint32_t slot) const {
+    const Chunk* chunk =
+        chunks_[slot / CounterShards::SlotsPerChunk].load(std::memory_order_acquire);
+    return chunk == nullptr ? 0
+                            : chunk->slots_[slot % CounterShards::SlotsPerChunk].load(
+                                  std::memory_order_relaxed);
+  }
+
+  void clear(uint32_t slot) {
+    Chunk* chunk = chunks_[slot / CounterShards::SlotsPerChunk].load(std::memory_order_acquire);
+    if (chunk != nullptr) {
+      chunk->slots_[slot % CounterShards::SlotsPerChunk].store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  std::array<std::atomic<Chunk*>, CounterShards::MaxChunks> chunks_{};
+};
+
+struct Registry {
+  Thread::MutexBasicLockable mutex_;
+  std::vector<std::unique_ptr<Table>> tables_ ABSL_GUARDED_BY(mutex_);
+  // Tables of exited threads, available to other threads.
+  std::vector<Table*> free_tables_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> free_slots_ ABSL_GUARDED_BY(mutex_);
+  uint32_t next_slot_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+// The registry is never destroyed, so that threads exiting during process shutdown can still
+// return their tables.
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+// The table owned by a thread, returned to the registry when the thread exits.
+class ThreadTable {
+public:
+  ~ThreadTable() {
+    if (table_ != nullptr) {
+      Registry& reg = registry();
+      Thread::LockGuard lock(reg.mutex_);
+      reg.free_tables_.push_back(table_);
+      table_ = nullptr;
+    }
+  }
+
+  Table& get() {
+    if (table_ == nullptr) {
+      Registry& reg = registry();
+      Thread::LockGuard lock(reg.mutex_);
+      if (reg.free_tables_.empty()) {
+        reg.tables_.push_back(std::make_unique<Table>());
+        table_ = reg.tables_.back().get();
+      } else {
+        table_ = reg.free_tables_.back();
+        reg.free_tables_.pop_back();
+      }
+    }
+    return *table_;
+  }
+
+private:
+  Table* table_{};
+};
+
+Table& threadTable() {
+  thread_local ThreadTable table;
+  return table.get();
+}
+
+} // namespace
+
+std::atomic<bool> CounterShards::enabled_{false};
+
+absl::optional<uint32_t> CounterShards::allocateSlot() {
+  Registry& reg = registry();
+  Thread::LockGuard lock(reg.mutex_);
+  if (!reg.free_slots_.empty()) {
+    const uint32_t slot = reg.free_slots_.back();
+    reg.free_slots_.pop_back();
+    return slot;
+  }
+  if (reg.next_slot_ == SlotsPerChunk * MaxChunks) {
+    return absl::nullopt;
+  }
+  return reg.next_slot_++;
+}
+
+void CounterShards::releaseSlot(uint32_t slot) {
+  Registry& reg = registry();
+  Thread::LockGuard lock(reg.mutex_);
+  ASSERT(slot < reg.next_slot_);
+  // Zero the slot before it is reused. No thread can be adding to it as its counter is gone.
+  for (auto& table : reg.tables_) {
+    table->clear(slot);
+  }
+  reg.free_slots_.push_back(slot);
+}
+
+uint64_t CounterShards::add(uint32_t slot, uint64_t amount) {
+  // The current thread is the only writer of its table, so no read-modify-write is needed.
+  std::atomic<uint64_t>& value = threadTable().slot(slot);
+  const uint64_t new_value = value.load(std::memory_order_relaxed) + amount;
+  value.store(new_value, std::memory_order_relaxed);
+  return new_value;
+}
+
+uint64_t CounterShards::local(uint32_t slot) { return threadTable().value(slot); }
+
+uint64_t CounterShards::sum(uint32_t slot) {
+  Registry& reg = registry();
+  Thread::LockGuard lock(reg.mutex_);
+  uint64_t total = 0;
+  for (const auto& table : reg.tables_) {
+    total += table->value(slot);
+  }
+  return total;
+}
+
+} // namespace Stats
+} // namespace Envoy
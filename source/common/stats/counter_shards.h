@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Process wide storage for the values of sharded counters. Every thread that increments sharded
+ * counters owns a table with one slot per counter that no other thread writes to, so that an
+ * increment is a plain load and store to a cache line owned by the incrementing thread rather
+ * than an atomic read-modify-write on a cache line shared by all workers. The value of a counter
+ * is the sum of its slot over all tables, which is computed when the value is read, e.g. by stats
+ * flushes and admin handlers.
+ *
+ * Tables are never freed: the table of an exited thread is handed to the next thread that needs
+ * one, so counts are kept and the number of tables is bounded by the number of threads that
+ * increment counters at the same time.
+ *
+ * Slots can also hold per-thread deltas that their owner folds into a shared value from time to
+ * time, using the value returned by add() and (wrapping) additions of negative amounts.
+ */
+class CounterShards {
+public:
+  // Slots are allocated to tables lazily, in chunks of this many slots.
+  static constexpr uint32_t SlotsPerChunk = 1024;
+  // Maximum number of chunks per table, limiting the number of sharded counters alive at once.
+  // Counters created beyond the limit are not sharded.
+  static constexpr uint32_t MaxChunks = 1024;
+
+  /**
+   * Set whether counters created from now on are sharded. Counters created before keep their
+   * mode for their lifetime.
+   */
+  static void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  /**
+   * @return whether new counters should be sharded.
+   */
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return a slot for a new counter, or absl::nullopt if all slots are in use. The slot is zero
+   * in all tables.
+   */
+  static absl::optional<uint32_t> allocateSlot();
+
+  /**
+   * Release a slot allocated by allocateSlot() once its counter can no longer be incremented.
+   */
+  static void releaseSlot(uint32_t slot);
+
+  /**
+   * Add to a slot in the current thread's table.
+   * @return the new value of the slot in the current thread's table.
+   */
+  static uint64_t add(uint32_t slot, uint64_t amount);
+
+  /**
+   * @return the value of a slot in the current thread's table.
+   */
+  static uint64_t local(uint32_t slot);
+
+  /**
+   * @return the sum of a slot over all tables.
+   */
+  static uint64_t sum(uint32_t slot);
+
+private:
+  static std::atomic<bool> enabled_;
+};
+
+} // namespace Stats
+} // namespace Envoy
@@ -0,0 +1,139 @@
+#include "source/common/stats/exponential_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+// Index of the bucket holding `value` at `scale`, i.e. the bucket i with
+// base^i < value <= base^(i+1).
+int32_t bucketIndex(double value, int32_t scale) {
+  return static_cast<int32_t>(std::ceil(std::log2(value) * std::ldexp(1.0, scale))) - 1;
+}
+
+// The smallest downscale after which the indices lo..hi fit in max_buckets buckets.
+int32_t requiredDownscale(int32_t lo, int32_t hi, uint32_t max_buckets, int32_t scale) {
+  int32_t by = 0;
+  while (scale - by > ExponentialHistogramBuckets::MinScale &&
+         static_cast<int64_t>(hi >> by) - (lo >> by) + 1 > max_buckets) {
+    ++by;
+  }
+  return by;
+}
+
+} // namespace
+
+ExponentialHistogramBuckets ExponentialHistogramBuckets::fromDetailedBuckets(
+    const std::vector<ParentHistogram::Bucket>& buckets, uint32_t max_buckets,
+    double zero_threshold, int32_t max_scale) {
+  ASSERT(max_buckets > 0);
+  ExponentialHistogramBuckets result;
+  result.scale_ = max_scale;
+
+  std::vector<std::pair<int32_t, uint64_t>> indexed;
+  indexed.reserve(buckets.size());
+  for (const ParentHistogram::Bucket& bucket : buckets) {
+    if (bucket.count_ == 0) {
+      continue;
+    }
+    const double midpoint = bucket.lower_bound_ + bucket.width_ / 2;
+    if (midpoint <= zero_threshold) {
+      result.zero_count_ += bucket.count_;
+    } else {
+      indexed.emplace_back(bucketIndex(midpoint, max_scale), bucket.count_);
+    }
+  }
+  if (indexed.empty()) {
+    return result;
+  }
+
+  int32_t lo = indexed.front().first;
+  int32_t hi = lo;
+  for (const auto& [index, count] : indexed) {
+    lo = std::min(lo, index);
+    hi = std::max(hi, index);
+  }
+  const int32_t by = requiredDownscale(lo, hi, max_buckets, max_scale);
+  result.scale_ = max_scale - by;
+  result.offset_ = lo >> by;
+  result.counts_.resize((hi >> by) - result.offset_ + 1);
+  for (const auto& [index, count] : indexed) {
+    result.counts_[(index >> by) - result.offset_] += count;
+  }
+  return result;
+}
+
+void ExponentialHistogramBuckets::merge(const ExponentialHistogramBuckets& other,
+                                        uint32_t max_buckets) {
+  zero_count_ += other.zero_count_;
+  if (other.counts_.empty()) {
+    return;
+  }
+  if (counts_.empty()) {
+    scale_ = other.scale_;
+    offset_ = other.offset_;
+    counts_ = other.counts_;
+    downscale(requiredDownscale(offset_, offset_ + counts_.size() - 1, max_buckets, scale_));
+    return;
+  }
+
+  ExponentialHistogramBuckets adjusted = other;
+  if (adjusted.scale_ > scale_) {
+    adjusted.downscale(adjusted.scale_ - scale_);
+  } else if (scale_ > adjusted.scale_) {
+    downscale(scale_ - adjusted.scale_);
+  }
+  const int32_t lo = std::min(offset_, adjusted.offset_);
+  const int32_t hi = std::max<int32_t>(offset_ + counts_.size() - 1,
+                                       adjusted.offset_ + adjusted.counts_.size() - 1);
+  const int32_t by = requiredDownscale(lo, hi, max_buckets, scale_);
+  downscale(by);
+  adjusted.downscale(by);
+
+  const int32_t new_offset = std::min(offset_, adjusted.offset_);
+  const int32_t new_end = std::max<int32_t>(offset_ + counts_.size(),
+                                            adjusted.offset_ + adjusted.counts_.size());
+  std::vector<uint64_t> merged(new_end - new_offset);
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    merged[offset_ - new_offset + i] += counts_[i];
+  }
+  for (size_t i = 0; i < adjusted.counts_.size(); ++i) {
+    merged[adjusted.offset_ - new_offset + i] += adjusted.counts_[i];
+  }
+  offset_ = new_offset;
+  counts_ = std::move(merged);
+}
+
+uint64_t ExponentialHistogramBuckets::totalCount() const {
+  uint64_t total = zero_count_;
+  for (const uint64_t count : counts_) {
+    total += count;
+  }
+  return total;
+}
+
+void ExponentialHistogramBuckets::downscale(int32_t by) {
+  if (by <= 0) {
+    return;
+  }
+  scale_ -= by;
+  if (counts_.empty()) {
+    return;
+  }
+  const int32_t new_offset = offset_ >> by;
+  const int32_t new_last = (offset_ + static_cast<int32_t>(counts_.size()) - 1) >> by;
+  std::vector<uint64_t> downscaled(new_last - new_offset + 1);
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    downscaled[((offset_ + static_cast<int32_t>(i)) >> by) - new_offset] += counts_[i];
+  }
+  offset_ = new_offset;
+  counts_ = std::move(downscaled);
+}
+
+} // namespace Stats
+} // namespace Envoy
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/stats/histogram.h"
+
+namespace Envoy {
+namespace Stats {
+
+/**
+ * Buckets of a base 2 exponential histogram, as exported by OTLP ``ExponentialHistogram`` data
+ * points. At scale `s` the base is 2^(2^-s), and bucket `i` covers (base^i, base^(i+1)]. Values
+ * at or below the zero threshold are counted in the zero bucket, and negative values are not
+ * supported as Envoy histograms only record non-negative values.
+ */
+struct ExponentialHistogramBuckets {
+  // Scales used when mapping detailed buckets. Scale 4 splits each power of two into 16 buckets,
+  // which is finer than the resolution of the detailed buckets for most of their range.
+  static constexpr int32_t DefaultMaxScale = 4;
+  static constexpr int32_t MinScale = -10;
+
+  /**
+   * Maps detailed histogram buckets to exponential buckets at the highest scale, not above
+   * `max_scale`, at which the non-empty buckets span at most `max_buckets` buckets. Each detailed
+   * bucket is counted in the exponential bucket holding its midpoint, so no quantile estimation or
+   * interpolation is needed.
+   * @param buckets supplies detailed buckets, e.g. from ParentHistogram::detailedTotalBuckets().
+   * @param max_buckets supplies the maximum number of positive buckets.
+   * @param zero_threshold supplies the largest value counted in the zero bucket.
+   */
+  static ExponentialHistogramBuckets
+  fromDetailedBuckets(const std::vector<ParentHistogram::Bucket>& buckets, uint32_t max_buckets,
+                      double zero_threshold, int32_t max_scale = DefaultMaxScale);
+
+  /**
+   * Adds the counts of `other`, lowering the scale of the result as needed so that it spans at
+   * most `max_buckets` buckets.
+   */
+  void merge(const ExponentialHistogramBuckets& other, uint32_t max_buckets);
+
+  /**
+   * @return the number of values in the zero bucket and all positive buckets.
+   */
+  uint64_t totalCount() const;
+
+  int32_t scale_{DefaultMaxScale};
+  uint64_t zero_count_{0};
+  // Index of the bucket counted by counts_[0].
+  int32_t offset_{0};
+  std::vector<uint64_t> counts_;
+
+private:
+  // Lowers the scale by `by`, merging each group of 2^by adjacent buckets into one.
+  void downscale(int32_t by);
+};
+
+} // namespace Stats
+} // namespace Envoy
@@ -25,6 +25,7 @@ public:
 
   void set(absl::string_view) override {}
   std::string value() const override { return {}; }
+  bool latchChanged() override { return false; }
 
   // Metric
   bool used() const override { return false; }
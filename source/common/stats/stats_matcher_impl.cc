@@ -5,6 +5,7 @@
 
 #include "envoy/config/metrics/v3/stats.pb.h"
 
+#include "source/common/common/assert.h"
 #include "source/common/common/utility.h"
 
 #include "absl/strings/match.h"
@@ -46,35 +47,92 @@ StatsMatcherImpl::StatsMatcherImpl(const envoy::config::metrics::v3::StatsConfig
   }
 }
 
+namespace {
+
+// Whether a name splits into non-empty tokens, so that it has the same tokens as its StatName.
+bool hasOnlyNonEmptyTokens(absl::string_view name) {
+  return !name.empty() && !absl::StartsWith(name, ".") && !absl::EndsWith(name, ".") &&
+         !absl::StrContains(name, "..");
+}
+
+} // namespace
+
 // If the last string-matcher added is a case-sensitive prefix match, and the
-// prefix ends in ".", then this drops that match and adds it to a list of
-// prefixes. This is beneficial because token prefixes can be handled more
-// efficiently as a StatName without requiring conversion to a string.
+// prefix ends in ".", or a case-sensitive exact match, then this moves that
+// match into a trie over the symbols of the prefixes and exact names. This is
+// beneficial because they can then be matched together as a StatName without
+// requiring conversion to a string, however many of them there are.
 //
 // In the future, other matcher patterns could be optimized in a similar way,
 // such as:
 //   * suffixes that begin with "."
-//   * exact-matches
 //   * substrings that begin and end with "."
 //
 // These are left unoptimized for the moment to keep the code-change simpler,
 // and because we haven't observed an acute performance need to optimize those
 // other patterns yet.
 void StatsMatcherImpl::optimizeLastMatcher() {
-  std::string prefix;
-  if (matchers_.back().getCaseSensitivePrefixMatch(prefix) && absl::EndsWith(prefix, ".") &&
-      prefix.size() > 1) {
-    prefixes_.push_back(stat_name_pool_->add(prefix.substr(0, prefix.size() - 1)));
-    matchers_.pop_back();
+  std::string str;
+  if (matchers_.back().getCaseSensitivePrefixMatch(str) && absl::EndsWith(str, ".") &&
+      hasOnlyNonEmptyTokens(absl::string_view(str).substr(0, str.size() - 1))) {
+    trie_.addPrefix(stat_name_pool_->add(str.substr(0, str.size() - 1)));
+  } else if (matchers_.back().getCaseSensitiveExactMatch(str) && hasOnlyNonEmptyTokens(str)) {
+    trie_.addExact(stat_name_pool_->add(str));
+  } else {
+    return;
+  }
+  trie_matchers_.push_back(std::move(matchers_.back()));
+  matchers_.pop_back();
+}
+
+StatsMatcherImpl::SymbolTrie::Node& StatsMatcherImpl::SymbolTrie::addNode(StatName stat_name) {
+  Node* node = &root_;
+  for (Symbol symbol : SymbolTable::Encoding::decodeSymbols(stat_name)) {
+    std::unique_ptr<Node>& child = node->children_[symbol];
+    if (child == nullptr) {
+      child = std::make_unique<Node>();
+    }
+    node = child.get();
   }
+  return *node;
+}
+
+StatsMatcherImpl::SymbolTrie::Result
+StatsMatcherImpl::SymbolTrie::lookup(StatName stat_name) const {
+  if (empty()) {
+    return Result::NoMatch;
+  }
+  const Node* node = &root_;
+  bool prefix_matched = false;
+  const SymbolTable::Encoding::WalkResult walk_result = SymbolTable::Encoding::walkSymbols(
+      stat_name, [&node, &prefix_matched](Symbol symbol) -> bool {
+        const auto iter = node->children_.find(symbol);
+        if (iter == node->children_.end()) {
+          return false;
+        }
+        node = iter->second.get();
+        prefix_matched = node->prefix_;
+        return !prefix_matched;
+      });
+  switch (walk_result) {
+  case SymbolTable::Encoding::WalkResult::End:
+    return node->prefix_ || node->exact_ ? Result::Match : Result::NoMatch;
+  case SymbolTable::Encoding::WalkResult::Stopped:
+    return prefix_matched ? Result::Match : Result::NoMatch;
+  case SymbolTable::Encoding::WalkResult::Literal:
+    return Result::Unknown;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
 StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const {
   if (rejectsAll()) {
     return FastResult::Rejects;
   }
-  bool matches = fastRejectMatch(stat_name);
-  if ((is_inclusive_ || matchers_.empty()) && matches == is_inclusive_) {
+  const SymbolTrie::Result trie_result = trie_.lookup(stat_name);
+  const bool matches = trie_result == SymbolTrie::Result::Match;
+  if (trie_result != SymbolTrie::Result::Unknown && (is_inclusive_ || matchers_.empty()) &&
+      matches == is_inclusive_) {
     // We can short-circuit the slow matchers only if they are empty, or if
     // we are in inclusive-mode and we find a match.
     return FastResult::Rejects;
@@ -84,11 +142,6 @@ StatsMatcher::FastResult StatsMatcherImpl::fastRejects(StatName stat_name) const
   return FastResult::NoMatch;
 }
 
-bool StatsMatcherImpl::fastRejectMatch(StatName stat_name) const {
-  return std::any_of(prefixes_.begin(), prefixes_.end(),
-                     [stat_name](StatName prefix) { return stat_name.startsWith(prefix); });
-}
-
 bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) const {
   // Skip slowRejectMatch if we already have a definitive answer from fastRejects.
   if (fast_result != FastResult::NoMatch) {
@@ -109,12 +162,16 @@ bool StatsMatcherImpl::slowRejects(FastResult fast_result, StatName stat_name) c
 }
 
 bool StatsMatcherImpl::slowRejectMatch(StatName stat_name) const {
-  if (matchers_.empty()) {
+  // Names with literal string tokens are matched against the trie's matchers as strings.
+  const bool match_trie_matchers =
+      !trie_matchers_.empty() && trie_.lookup(stat_name) == SymbolTrie::Result::Unknown;
+  if (matchers_.empty() && !match_trie_matchers) {
     return false;
   }
   std::string name = symbol_table_->toString(stat_name);
-  return std::any_of(matchers_.begin(), matchers_.end(),
-                     [&name](auto& matcher) { return matcher.match(name); });
+  const auto match = [&name](auto& matcher) { return matcher.match(name); };
+  return std::any_of(matchers_.begin(), matchers_.end(), match) ||
+         (match_trie_matchers && std::any_of(trie_matchers_.begin(), trie_matchers_.end(), match));
 }
 
 } // namespace Stats
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/common/optref.h"
 #include "envoy/config/metrics/v3/stats.pb.h"
@@ -10,6 +12,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -33,16 +36,42 @@ public:
   }
   FastResult fastRejects(StatName name) const override;
   bool slowRejects(FastResult, StatName name) const override;
-  bool acceptsAll() const override {
-    return is_inclusive_ && matchers_.empty() && prefixes_.empty();
-  }
-  bool rejectsAll() const override {
-    return !is_inclusive_ && matchers_.empty() && prefixes_.empty();
-  }
+  bool acceptsAll() const override { return is_inclusive_ && matchers_.empty() && trie_.empty(); }
+  bool rejectsAll() const override { return !is_inclusive_ && matchers_.empty() && trie_.empty(); }
 
 private:
+  // Trie over the symbols of the token prefixes and exact names taken out of the string
+  // matchers, so that all of them are matched in one walk over a StatName.
+  class SymbolTrie {
+  public:
+    enum class Result {
+      Match,
+      NoMatch,
+      // The StatName has a literal string token where the trie would have to compare symbols,
+      // so it can only be matched as a string.
+      Unknown,
+    };
+
+    void addPrefix(StatName prefix) { addNode(prefix).prefix_ = true; }
+    void addExact(StatName exact) { addNode(exact).exact_ = true; }
+    Result lookup(StatName stat_name) const;
+    bool empty() const { return root_.children_.empty(); }
+
+  private:
+    struct Node {
+      absl::flat_hash_map<Symbol, std::unique_ptr<Node>> children_;
+      // Any StatName starting with the symbols leading to this node matches.
+      bool prefix_{false};
+      // A StatName made of exactly the symbols leading to this node matches.
+      bool exact_{false};
+    };
+
+    Node& addNode(StatName stat_name);
+
+    Node root_;
+  };
+
   void optimizeLastMatcher();
-  bool fastRejectMatch(StatName name) const;
   bool slowRejectMatch(StatName name) const;
 
   // Bool indicating whether or not the StatsMatcher is including or excluding stats by default. See
@@ -53,7 +82,9 @@ private:
   std::unique_ptr<StatNamePool> stat_name_pool_;
 
   std::vector<Matchers::StringMatcherImpl> matchers_;
-  std::vector<StatName> prefixes_;
+  SymbolTrie trie_;
+  // The string matchers compiled into trie_, used only for names the trie can't decide.
+  std::vector<Matchers::StringMatcherImpl> trie_matchers_;
 };
 
 } // namespace Stats
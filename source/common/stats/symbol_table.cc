@@ -232,6 +232,22 @@ void SymbolTable::Encoding::decodeTokens(
   }
 }
 
+SymbolTable::Encoding::WalkResult
+SymbolTable::Encoding::walkSymbols(StatName stat_name,
+                                   const std::function<bool(Symbol)>& symbol_fn) {
+  TokenIter iter(stat_name);
+  TokenIter::TokenType type;
+  while ((type = iter.next()) != TokenIter::TokenType::End) {
+    if (type == TokenIter::TokenType::StringView) {
+      return WalkResult::Literal;
+    }
+    if (!symbol_fn(iter.symbol())) {
+      return WalkResult::Stopped;
+    }
+  }
+  return WalkResult::End;
+}
+
 bool StatName::startsWith(StatName prefix) const {
   using TokenIter = SymbolTable::Encoding::TokenIter;
   TokenIter prefix_iter(prefix);
@@ -261,11 +277,8 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
   Encoding::decodeTokens(
-      stat_name,
-      [this, &strings](Symbol symbol)
-          ABSL_NO_THREAD_SAFETY_ANALYSIS { strings.push_back(fromSymbol(symbol)); },
+      stat_name, [this, &strings](Symbol symbol) { strings.push_back(fromSymbol(symbol)); },
       [&strings](absl::string_view str) { strings.push_back(str); });
   return strings;
 }
@@ -286,6 +299,45 @@ void SymbolTable::Encoding::appendToMemBlock(StatName stat_name,
   }
 }
 
+SymbolTable::DecodeIndex::DecodeIndex() {
+  directories_.push_back(std::make_unique<Directory>(InitialDirectorySize));
+  directory_.store(directories_.back().get(), std::memory_order_relaxed);
+}
+
+SymbolTable::DecodeIndex::~DecodeIndex() = default;
+
+void SymbolTable::DecodeIndex::set(Symbol symbol, const InlineString* str) {
+  Directory* directory = directory_.load(std::memory_order_relaxed);
+  const uint32_t chunk_index = symbol / SymbolsPerChunk;
+  if (chunk_index >= directory->size_) {
+    // Publish a larger copy of the directory. Readers may still be using the
+    // old one, so it is kept until the table is destroyed. Doubling the size
+    // bounds the retired directories to the size of the current one.
+    uint32_t size = directory->size_;
+    while (chunk_index >= size) {
+      size *= 2;
+    }
+    auto grown = std::make_unique<Directory>(size);
+    for (uint32_t i = 0; i < directory->size_; ++i) {
+      grown->chunks_[i].store(directory->chunks_[i].load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+    }
+    directory = grown.get();
+    directories_.push_back(std::move(grown));
+    directory_.store(directory, std::memory_order_release);
+  }
+  Chunk* chunk = directory->chunks_[chunk_index].load(std::memory_order_relaxed);
+  if (chunk == nullptr) {
+    if (str == nullptr) {
+      return;
+    }
+    chunks_.push_back(std::make_unique<Chunk>());
+    chunk = chunks_.back().get();
+    directory->chunks_[chunk_index].store(chunk, std::memory_order_release);
+  }
+  (*chunk)[symbol % SymbolsPerChunk].store(str, std::memory_order_release);
+}
+
 SymbolTable::SymbolTable()
     // Have to be explicitly initialized, if we want to use the ABSL_GUARDED_BY macro.
     : next_symbol_(FirstValidSymbol), monotonic_counter_(FirstValidSymbol) {}
@@ -381,6 +433,7 @@ void SymbolTable::free(const StatName& stat_name) {
     // symbol_table_speed_test.cc, relative to breaking out the decrement into a
     // separate step, likely due to the non-trivial dereferences in EXPR.
     if (--encode_search->second.ref_count_ == 0) {
+      decode_index_.set(symbol, nullptr);
       decode_map_.erase(decode_search);
       encode_map_.erase(encode_search);
       pool_.push(symbol);
@@ -476,6 +529,7 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
     InlineStringPtr str = InlineString::create(sv);
     auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
     ASSERT(encode_insert.second);
+    decode_index_.set(next_symbol_, str.get());
     auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
     ASSERT(decode_insert.second);
 
@@ -490,11 +544,10 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
   return result;
 }
 
-absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  auto search = decode_map_.find(symbol);
-  RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
-  return search->second->toStringView();
+absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const {
+  const InlineString* str = decode_index_.get(symbol);
+  RELEASE_ASSERT(str != nullptr, "no such symbol");
+  return str->toStringView();
 }
 
 void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
@@ -509,15 +562,6 @@ void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
 }
 
 bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
-  // Proactively take the table lock in anticipation that we'll need to
-  // convert at least one symbol to a string_view, and it's easier not to
-  // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
-  return lessThanLockHeld(a, b);
-}
-
-bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -136,6 +138,24 @@ public:
     static void decodeTokens(StatName stat_name, const std::function<void(Symbol)>& symbol_token_fn,
                              const std::function<void(absl::string_view)>& string_view_token_fn);
 
+    // How a walk over the symbols of a StatName ended.
+    enum class WalkResult {
+      End,     // All tokens were symbols, and symbol_fn accepted all of them.
+      Stopped, // symbol_fn returned false.
+      Literal, // A literal string token was reached.
+    };
+
+    /**
+     * Calls symbol_fn for the symbols of a StatName in order, stopping early if symbol_fn
+     * returns false or a literal string token is reached. This allows matching the leading
+     * symbols of a StatName without decoding all of it.
+     *
+     * @param stat_name the StatName to walk.
+     * @param symbol_fn a function called with each symbol, returning false to stop the walk.
+     * @return how the walk ended.
+     */
+    static WalkResult walkSymbols(StatName stat_name, const std::function<bool(Symbol)>& symbol_fn);
+
     /**
      * Returns the number of bytes required to represent StatName as a uint8_t
      * array, including the encoded size.
@@ -324,8 +344,6 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
-
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
         : symbol_table_(symbol_table), getter_(getter) {}
@@ -337,9 +355,8 @@ public:
   };
 
   /**
-   * Sorts a range by StatName. This API is more efficient than
-   * calling std::sort directly as it takes a single lock for the
-   * entire sort, rather than locking on each comparison.
+   * Sorts a range by StatName, comparing the StatNames returned by
+   * get_stat_name for each element.
    *
    * @param begin the beginning of the range to sort
    * @param end the end of the range to sort
@@ -347,9 +364,6 @@ public:
    */
   template <class Obj, class Iter, class GetStatName>
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
-    // Grab the lock once before sorting begins, so we don't have to re-take
-    // it on every comparison.
-    Thread::LockGuard lock(lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -402,7 +416,66 @@ private:
     uint32_t ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
+  /**
+   * Maps symbols to their strings for decoding without taking lock_. Symbols
+   * are allocated densely from a free pool and a monotonic counter, so they
+   * index into an array of fixed size chunks of string pointers. Chunks are
+   * only added while the table is alive, and the directory of chunks is
+   * replaced by a larger copy when it fills up, in read-copy-update fashion:
+   * retired directories are kept until the table is destroyed, so readers
+   * never need to synchronize with the writer.
+   *
+   * Readers may only look up symbols of StatNames they hold, whose entries
+   * can't be cleared concurrently as their reference counts are non-zero.
+   */
+  class DecodeIndex {
+  public:
+    DecodeIndex();
+    ~DecodeIndex();
+
+    /**
+     * Sets the string for a symbol, or clears it if str is nullptr. Must be
+     * called with lock_ held.
+     */
+    void set(Symbol symbol, const InlineString* str);
+
+    /**
+     * @return the string for a symbol, or nullptr if it has none.
+     */
+    const InlineString* get(Symbol symbol) const {
+      const Directory* directory = directory_.load(std::memory_order_acquire);
+      const uint32_t chunk_index = symbol / SymbolsPerChunk;
+      if (chunk_index >= directory->size_) {
+        return nullptr;
+      }
+      const Chunk* chunk = directory->chunks_[chunk_index].load(std::memory_order_acquire);
+      if (chunk == nullptr) {
+        return nullptr;
+      }
+      return (*chunk)[symbol % SymbolsPerChunk].load(std::memory_order_acquire);
+    }
+
+  private:
+    static constexpr uint32_t SymbolsPerChunk = 1024;
+    static constexpr uint32_t InitialDirectorySize = 16;
+
+    using Chunk = std::array<std::atomic<const InlineString*>, SymbolsPerChunk>;
+
+    struct Directory {
+      explicit Directory(uint32_t size) : size_(size), chunks_(size) {}
+
+      const uint32_t size_;
+      absl::FixedArray<std::atomic<Chunk*>> chunks_;
+    };
+
+    std::atomic<Directory*> directory_;
+    // Owned storage, only accessed by the writer.
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<std::unique_ptr<Directory>> directories_;
+  };
+
+  // This must be held during both encode() and free(). Decoding only
+  // needs decode_index_.
   mutable Thread::MutexBasicLockable lock_;
 
   /**
@@ -434,7 +507,7 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const;
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -469,6 +542,8 @@ private:
   using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
   EncodeMap encode_map_ ABSL_GUARDED_BY(lock_);
   DecodeMap decode_map_ ABSL_GUARDED_BY(lock_);
+  // Writes are guarded by lock_, reads are lock free.
+  DecodeIndex decode_index_;
 
   // Free pool of symbols for re-use.
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
@@ -1065,7 +1140,7 @@ template <class GetStatName, class Obj>
 bool SymbolTable::StatNameCompare<GetStatName, Obj>::operator()(const Obj& a, const Obj& b) const {
   StatName a_stat_name = getter_(a);
   StatName b_stat_name = getter_(b);
-  return symbol_table_.lessThanLockHeld(a_stat_name, b_stat_name);
+  return symbol_table_.lessThan(a_stat_name, b_stat_name);
 }
 
 using SymbolTablePtr = std::unique_ptr<SymbolTable>;
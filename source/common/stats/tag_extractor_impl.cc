@@ -1,5 +1,6 @@
 #include "source/common/stats/tag_extractor_impl.h"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -33,6 +34,26 @@ const std::vector<absl::string_view>& TagExtractionContext::tokens() {
   return tokens_;
 }
 
+bool TagExtractionContext::mayMatch(int prefilter_index) {
+  if (prefilter_ == nullptr) {
+    return true;
+  }
+  if (!prefilter_done_) {
+    prefilter_done_ = true;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (!prefilter_->Match(name_, &prefilter_matches_, &error_info) &&
+        error_info.kind != re2::RE2::Set::kNoError) {
+      // The set could not be matched, e.g. because the DFA ran out of memory, so every regex
+      // has to be tried.
+      prefilter_ = nullptr;
+      return true;
+    }
+    std::sort(prefilter_matches_.begin(), prefilter_matches_.end());
+  }
+  return std::binary_search(prefilter_matches_.begin(), prefilter_matches_.end(),
+                            prefilter_index);
+}
+
 namespace {
 
 bool regexStartsWithDot(absl::string_view regex) {
@@ -147,6 +168,12 @@ TagExtractorRe2Impl::TagExtractorRe2Impl(absl::string_view name, absl::string_vi
     : TagExtractorImplBase(name, regex, substr), regex_(std::string(regex)),
       negative_match_(std::string(negative_match)) {}
 
+void TagExtractorRe2Impl::addToPrefilter(re2::RE2::Set& prefilter) {
+  if (regex_.ok()) {
+    prefilter_index_ = prefilter.Add(regex_.pattern(), nullptr);
+  }
+}
+
 bool TagExtractorRe2Impl::extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                                      IntervalSet<size_t>& remove_characters) const {
   PERF_OPERATION(perf);
@@ -157,6 +184,11 @@ bool TagExtractorRe2Impl::extractTag(TagExtractionContext& context, std::vector<
     PERF_TAG_INC(skipped_);
     return false;
   }
+  if (prefilter_index_ >= 0 && !context.mayMatch(prefilter_index_)) {
+    PERF_RECORD(perf, "re2-prefilter-miss", name_);
+    PERF_TAG_INC(missed_);
+    return false;
+  }
 
   // remove_subexpr is the first submatch. It represents the portion of the string to be removed.
   absl::string_view remove_subexpr, value_subexpr;
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <regex>
 #include <string>
+#include <vector>
 
 #ifdef ENVOY_PERF_ANNOTATION
 #include <fmt/core.h>
@@ -14,6 +15,7 @@
 
 #include "absl/strings/string_view.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
@@ -21,14 +23,31 @@ namespace Stats {
 // Carries state across tag extractions.
 class TagExtractionContext {
 public:
-  explicit TagExtractionContext(absl::string_view name) : name_(name) {}
+  /**
+   * @param name the stat name tags are extracted from.
+   * @param prefilter optional set of the RE2 extractor regexes, matched against the name at most
+   *                  once to rule out the extractors that can't match.
+   */
+  explicit TagExtractionContext(absl::string_view name,
+                                const re2::RE2::Set* prefilter = nullptr)
+      : name_(name), prefilter_(prefilter) {}
 
   absl::string_view name() { return name_; }
   const std::vector<absl::string_view>& tokens();
 
+  /**
+   * @param prefilter_index the index of a regex in the prefilter.
+   * @return false if the regex is known not to match the name, true if it may match.
+   */
+  bool mayMatch(int prefilter_index);
+
 private:
   absl::string_view name_;
   std::vector<absl::string_view> tokens_;
+  const re2::RE2::Set* prefilter_;
+  bool prefilter_done_{false};
+  // Sorted indices of the prefilter regexes that match the name.
+  std::vector<int> prefilter_matches_;
 };
 
 // To check if a tag extractor is actually used you can run
@@ -141,9 +160,18 @@ public:
   bool extractTag(TagExtractionContext& context, std::vector<Tag>& tags,
                   IntervalSet<size_t>& remove_characters) const override;
 
+  /**
+   * Adds the regex to a set matched once per stat name, so that extraction can be skipped when
+   * the set shows the regex does not match. The set must be compiled before extracting tags with
+   * a context referencing it.
+   * @param prefilter the set to add the regex to.
+   */
+  void addToPrefilter(re2::RE2::Set& prefilter);
+
 private:
   const re2::RE2 regex_;
   const std::string negative_match_;
+  int prefilter_index_{-1};
 };
 
 /**
@@ -15,8 +15,9 @@ absl::StatusOr<Stats::TagProducerPtr>
 TagProducerImpl::createTagProducer(const envoy::config::metrics::v3::StatsConfig& config,
                                    const Stats::TagVector& cli_tags) {
   absl::Status creation_status;
-  Stats::TagProducerPtr ret(new Stats::TagProducerImpl(config, cli_tags, creation_status));
+  std::unique_ptr<TagProducerImpl> ret(new TagProducerImpl(config, cli_tags, creation_status));
   RETURN_IF_NOT_OK(creation_status);
+  ret->compilePrefilter();
   return ret;
 }
 
@@ -95,6 +96,11 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
     other.get().setOtherExtractorWithSameNameExists(true);
   }
 
+  if (auto* re2_extractor = dynamic_cast<TagExtractorRe2Impl*>(extractor.get());
+      re2_extractor != nullptr && pending_prefilter_ != nullptr) {
+    re2_extractor->addToPrefilter(*pending_prefilter_);
+  }
+
   const absl::string_view prefix = extractor->prefixToken();
   if (prefix.empty()) {
     tag_extractors_without_prefix_.emplace_back(std::move(extractor));
@@ -103,6 +109,16 @@ void TagProducerImpl::addExtractor(TagExtractorPtr extractor) {
   }
 }
 
+void TagProducerImpl::compilePrefilter() {
+  if (pending_prefilter_ == nullptr) {
+    return;
+  }
+  std::unique_ptr<re2::RE2::Set> prefilter = std::move(pending_prefilter_);
+  if (prefilter->Compile()) {
+    prefilter_ = std::move(prefilter);
+  }
+}
+
 void TagProducerImpl::forEachExtractorMatching(
     absl::string_view stat_name, std::function<void(const TagExtractorPtr&)> f) const {
   IntervalSetImpl<size_t> remove_characters;
@@ -124,7 +140,7 @@ void TagProducerImpl::forEachExtractorMatching(
 std::string TagProducerImpl::produceTags(absl::string_view metric_name, TagVector& tags) const {
   // TODO(jmarantz): Skip the creation of string-based tags, creating a StatNameTagVector instead.
   IntervalSetImpl<size_t> remove_characters;
-  TagExtractionContext tag_extraction_context(metric_name);
+  TagExtractionContext tag_extraction_context(metric_name, prefilter_.get());
   std::vector<absl::string_view> tokens;
   absl::flat_hash_set<absl::string_view> dup_set;
   forEachExtractorMatching(metric_name, [&remove_characters, &tags, &tag_extraction_context,
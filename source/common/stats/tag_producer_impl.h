@@ -18,6 +18,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/string_view.h"
+#include "re2/set.h"
 
 namespace Envoy {
 namespace Stats {
@@ -64,6 +65,12 @@ private:
    */
   void addExtractor(TagExtractorPtr extractor);
 
+  /**
+   * Compiles the set of all RE2 extractor regexes added so far. If it can't be compiled,
+   * produceTags tries every candidate regex in turn as it would without the set.
+   */
+  void compilePrefilter();
+
   /**
    * Adds all default extractors matching the specified tag name. In this model,
    * more than one TagExtractor can be used to generate a given tag. The default
@@ -117,6 +124,13 @@ private:
   // send duplicate tag names to Prometheus so this needs to be filtered out.
   absl::flat_hash_map<absl::string_view, std::reference_wrapper<TagExtractor>> extractor_map_;
 
+  // All RE2 extractor regexes, matched against a stat name in a single pass the first time one
+  // of them is tried, so that the extractors whose regex does not match can be skipped. Null
+  // until compiled.
+  std::unique_ptr<re2::RE2::Set> prefilter_;
+  std::unique_ptr<re2::RE2::Set> pending_prefilter_{
+      std::make_unique<re2::RE2::Set>(re2::RE2::DefaultOptions, re2::RE2::UNANCHORED)};
+
   TagVector fixed_tags_;
 };
 
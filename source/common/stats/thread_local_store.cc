@@ -1,10 +1,13 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/stats/allocator.h"
 #include "envoy/stats/histogram.h"
@@ -252,12 +255,80 @@ void ThreadLocalStoreImpl::mergeHistograms(PostMergeCb merge_complete_cb) {
 
 void ThreadLocalStoreImpl::mergeInternal(PostMergeCb merge_complete_cb) {
   if (!shutting_down_) {
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.parallel_histogram_merge")) {
+      mergeInParallel(merge_complete_cb);
+      return;
+    }
     forEachHistogram(nullptr, [](ParentHistogram& histogram) { histogram.merge(); });
     merge_complete_cb();
     merge_in_progress_ = false;
   }
 }
 
+namespace {
+
+// The histograms of a parallel merge, which the threads claim in batches to merge their TLS
+// histograms.
+struct ParallelHistogramMerge {
+  static constexpr size_t BatchSize = 64;
+
+  void mergeBatches() {
+    for (size_t begin = next_.fetch_add(BatchSize); begin < histograms_.size();
+         begin = next_.fetch_add(BatchSize)) {
+      const size_t end = std::min(begin + BatchSize, histograms_.size());
+      for (size_t i = begin; i < end; ++i) {
+        histograms_[i]->mergeTlsHistograms();
+      }
+    }
+  }
+
+  std::vector<ParentHistogramImplSharedPtr> histograms_;
+  std::atomic<size_t> next_{0};
+  std::atomic<bool> started_{false};
+};
+
+} // namespace
+
+void ThreadLocalStoreImpl::mergeInParallel(PostMergeCb merge_complete_cb) {
+  auto merge = std::make_shared<ParallelHistogramMerge>();
+  {
+    Thread::LockGuard lock(hist_mutex_);
+    merge->histograms_.reserve(histogram_set_.size());
+    for (ParentHistogramImpl* histogram : histogram_set_) {
+      merge->histograms_.emplace_back(histogram);
+    }
+  }
+  // The references are dropped outside of hist_mutex_, as dropping the last one takes it.
+  merge->histograms_.erase(std::remove_if(merge->histograms_.begin(), merge->histograms_.end(),
+                                          [](const ParentHistogramImplSharedPtr& histogram) {
+                                            return !histogram->beginParallelMerge();
+                                          }),
+                           merge->histograms_.end());
+
+  tls_cache_->runOnAllThreads(
+      [merge](OptRef<TlsCache>) {
+        if (merge->started_.load(std::memory_order_acquire)) {
+          merge->mergeBatches();
+        }
+      },
+      [this, merge, merge_complete_cb]() -> void {
+        if (!shutting_down_) {
+          // Merge the batches that no worker claimed, which is all of them without workers.
+          merge->mergeBatches();
+          for (const ParentHistogramImplSharedPtr& histogram : merge->histograms_) {
+            histogram->finishParallelMerge();
+          }
+          merge_complete_cb();
+          merge_in_progress_ = false;
+        }
+        // Release the histograms on the main thread rather than on the last worker.
+        merge->histograms_.clear();
+      });
+  // The callback has already run on the main thread, which leaves the batches to the workers
+  // and only merges those left when they are all done.
+  merge->started_.store(true, std::memory_order_release);
+}
+
 ThreadLocalStoreImpl::CentralCacheEntry::~CentralCacheEntry() {
   // Assert that the symbol-table is valid, so we get good test coverage of
   // the validity of the symbol table at the time this destructor runs. This
@@ -853,13 +924,20 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
   hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  has_values_[current_active_] = true;
   used_ = true;
 }
 
-void ThreadLocalHistogramImpl::merge(histogram_t* target) {
-  histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
+bool ThreadLocalHistogramImpl::merge(histogram_t* target) {
+  const uint64_t other_index = otherHistogramIndex();
+  if (!has_values_[other_index]) {
+    return false;
+  }
+  histogram_t** other_histogram = &histograms_[other_index];
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
+  has_values_[other_index] = false;
+  return true;
 }
 
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
@@ -880,6 +958,9 @@ ParentHistogramImpl::~ParentHistogramImpl() {
   MetricImpl::clear(thread_local_store_.symbolTable());
   hist_free(interval_histogram_);
   hist_free(cumulative_histogram_);
+  if (next_interval_histogram_ != nullptr) {
+    hist_free(next_interval_histogram_);
+  }
 }
 
 void ParentHistogramImpl::incRefCount() { ++ref_count_; }
@@ -956,21 +1037,69 @@ bool ParentHistogramImpl::hidden() const { return false; }
 void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
-    hist_clear(interval_histogram_);
+    if (interval_has_values_) {
+      hist_clear(interval_histogram_);
+    }
     // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
     // then release the lock before we do the actual merge. However it is not a big deal
     // because the tls_histogram merge is not that expensive as it is a single histogram
     // merge and adding TLS histograms is rare.
-    for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
-      tls_histogram->merge(interval_histogram_);
-    }
+    const bool has_values = mergeTlsHistogramsLockHeld(interval_histogram_);
     // Since TLS merge is done, we can release the lock here.
     lock.release();
+    finishInterval(has_values);
+  }
+}
+
+bool ParentHistogramImpl::beginParallelMerge() {
+  Thread::LockGuard lock(merge_lock_);
+  if (!merged_ && !usedLockHeld()) {
+    return false;
+  }
+  if (next_interval_histogram_ == nullptr) {
+    next_interval_histogram_ = hist_alloc();
+  }
+  return true;
+}
+
+void ParentHistogramImpl::mergeTlsHistograms() {
+  Thread::LockGuard lock(merge_lock_);
+  next_interval_has_values_ = mergeTlsHistogramsLockHeld(next_interval_histogram_);
+}
+
+void ParentHistogramImpl::finishParallelMerge() {
+  if (next_interval_has_values_) {
+    std::swap(interval_histogram_, next_interval_histogram_);
+    // Clear the previous interval, so that it can collect the next one.
+    if (interval_has_values_) {
+      hist_clear(next_interval_histogram_);
+    }
+  } else if (interval_has_values_) {
+    hist_clear(interval_histogram_);
+  }
+  finishInterval(next_interval_has_values_);
+}
+
+bool ParentHistogramImpl::mergeTlsHistogramsLockHeld(histogram_t* target) {
+  bool has_values = false;
+  for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
+    has_values |= tls_histogram->merge(target);
+  }
+  return has_values;
+}
+
+void ParentHistogramImpl::finishInterval(bool has_values) {
+  // The cumulative histogram only changes, and the interval histogram only needs to be refreshed,
+  // if values were recorded in this or the previous interval.
+  if (has_values) {
     hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
     cumulative_statistics_.refresh(cumulative_histogram_);
+  }
+  if (has_values || interval_has_values_) {
     interval_statistics_.refresh(interval_histogram_);
-    merged_ = true;
   }
+  interval_has_values_ = has_values;
+  merged_ = true;
 }
 
 std::string ParentHistogramImpl::quantileSummary() const {
@@ -38,7 +38,11 @@ public:
                            absl::optional<uint32_t> bins);
   ~ThreadLocalHistogramImpl() override;
 
-  void merge(histogram_t* target);
+  /**
+   * Merges the values recorded before the last beginMerge() into the target histogram.
+   * @return whether any values were merged. Nothing is done if there are none.
+   */
+  bool merge(histogram_t* target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
@@ -69,6 +73,10 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  // Whether values were recorded into each of histograms_ since it was last merged. Like the
+  // histograms, each flag is only accessed by the recording thread while its histogram is active,
+  // and by the merging thread otherwise.
+  bool has_values_[2]{};
   std::atomic<bool> used_;
   const std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -103,6 +111,26 @@ public:
    */
   void merge() override;
 
+  /**
+   * Merges the TLS histograms in three steps, of which the second may run on any thread, so that
+   * the merge of the histograms of a store can be spread over the workers. Called on the main
+   * thread before mergeTlsHistograms().
+   * @return whether the histogram is to be merged, i.e. has been used. If not, the other steps
+   *         must not be called.
+   */
+  bool beginParallelMerge();
+
+  /**
+   * Collects the histogram data of the TLS histograms into the next interval histogram.
+   */
+  void mergeTlsHistograms();
+
+  /**
+   * Called on the main thread once mergeTlsHistograms() has completed. Makes the collected data
+   * the interval histogram and merges it into the cumulative histogram.
+   */
+  void finishParallelMerge();
+
   const HistogramStatistics& intervalStatistics() const override { return interval_statistics_; }
   const HistogramStatistics& cumulativeStatistics() const override {
     return cumulative_statistics_;
@@ -135,6 +163,8 @@ public:
 
 private:
   bool usedLockHeld() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
+  bool mergeTlsHistogramsLockHeld(histogram_t* target) ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
+  void finishInterval(bool has_values);
   std::vector<Stats::ParentHistogram::Bucket>
   detailedlBucketsHelper(const histogram_t& histogram) const;
 
@@ -143,6 +173,12 @@ private:
   ThreadLocalStoreImpl& thread_local_store_;
   histogram_t* interval_histogram_;
   histogram_t* cumulative_histogram_;
+  // The interval histogram being collected by a parallel merge, allocated on first use.
+  histogram_t* next_interval_histogram_{};
+  // Whether interval_histogram_ and next_interval_histogram_ hold any values. Idle histograms
+  // then cost no histogram operations on merge.
+  bool interval_has_values_{false};
+  bool next_interval_has_values_{false};
   HistogramStatisticsImpl interval_statistics_;
   HistogramStatisticsImpl cumulative_statistics_;
   mutable Thread::MutexBasicLockable merge_lock_;
@@ -532,6 +568,7 @@ private:
   void clearHistogramsFromCaches();
   void releaseScopeCrossThread(ScopeImpl* scope);
   void mergeInternal(PostMergeCb merge_cb);
+  void mergeInParallel(PostMergeCb merge_cb);
   bool slowRejects(StatsMatcher::FastResult fast_reject_result, StatName name) const;
   bool rejects(StatName name) const { return stats_matcher_->rejects(name); }
   StatsMatcher::FastResult fastRejects(StatName name) const;
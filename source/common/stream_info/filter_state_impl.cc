@@ -5,6 +5,15 @@
 namespace Envoy {
 namespace StreamInfo {
 
+FilterStateSharedPtr FilterStateImpl::parent() const {
+  if (ancestor_ != nullptr) {
+    parent_ = std::make_shared<FilterStateImpl>(std::move(ancestor_),
+                                                FilterState::LifeSpan(life_span_ + 1));
+    ancestor_ = nullptr;
+  }
+  return parent_;
+}
+
 void FilterStateImpl::maybeCreateParent(FilterStateSharedPtr ancestor) {
   // If we already have a parent, or we're at the top span, we don't need to create
   // a parent.
@@ -40,9 +49,10 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
                    "conflicting life_span on the same data_name.");
       return;
     }
-    // Note if ancestor argument of ctor is not nullptr, parent will be created at the time of
-    // construction directly and this call will be a no-op.
-    // So we only need to consider the case where ancestor is nullptr.
+    // Note if ancestor argument of ctor is not nullptr, parent is either created at the time of
+    // construction directly or by parent() from the ancestor, and maybeCreateParent() will be a
+    // no-op. So it only needs to consider the case where ancestor is nullptr.
+    parent();
     maybeCreateParent(nullptr);
     parent_->setData(data_name, data, state_type, life_span, stream_sharing);
     return;
@@ -79,7 +89,7 @@ void FilterStateImpl::setData(absl::string_view data_name, std::shared_ptr<Objec
 }
 
 bool FilterStateImpl::hasDataWithName(absl::string_view data_name) const {
-  return hasDataWithNameInternally(data_name) || (parent_ && parent_->hasDataWithName(data_name));
+  return hasDataWithNameInternally(data_name) || (next() && next()->hasDataWithName(data_name));
 }
 
 const FilterState::Object*
@@ -87,8 +97,8 @@ FilterStateImpl::getDataReadOnlyGeneric(absl::string_view data_name) const {
   const auto it = data_storage_.find(data_name);
 
   if (it == data_storage_.end()) {
-    if (parent_) {
-      return parent_->getDataReadOnlyGeneric(data_name);
+    if (next()) {
+      return next()->getDataReadOnlyGeneric(data_name);
     }
     return nullptr;
   }
@@ -106,8 +116,8 @@ FilterStateImpl::getDataSharedMutableGeneric(absl::string_view data_name) {
   const auto& it = data_storage_.find(data_name);
 
   if (it == data_storage_.end()) {
-    if (parent_) {
-      return parent_->getDataSharedMutableGeneric(data_name);
+    if (next()) {
+      return next()->getDataSharedMutableGeneric(data_name);
     }
     return nullptr;
   }
@@ -124,14 +134,14 @@ FilterStateImpl::getDataSharedMutableGeneric(absl::string_view data_name) {
 
 bool FilterStateImpl::hasDataAtOrAboveLifeSpan(FilterState::LifeSpan life_span) const {
   if (life_span > life_span_) {
-    return parent_ && parent_->hasDataAtOrAboveLifeSpan(life_span);
+    return next() && next()->hasDataAtOrAboveLifeSpan(life_span);
   }
-  return !data_storage_.empty() || (parent_ && parent_->hasDataAtOrAboveLifeSpan(life_span));
+  return !data_storage_.empty() || (next() && next()->hasDataAtOrAboveLifeSpan(life_span));
 }
 
 FilterState::ObjectsPtr FilterStateImpl::objectsSharedWithUpstreamConnection() const {
-  auto objects = parent_ ? parent_->objectsSharedWithUpstreamConnection()
-                         : std::make_unique<FilterState::Objects>();
+  auto objects = next() ? next()->objectsSharedWithUpstreamConnection()
+                        : std::make_unique<FilterState::Objects>();
   for (const auto& [name, object] : data_storage_) {
     switch (object->stream_sharing_) {
     case StreamSharingMayImpactPooling::SharedWithUpstreamConnection:
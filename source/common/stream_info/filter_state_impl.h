@@ -25,9 +25,14 @@ public:
    */
   FilterStateImpl(FilterStateSharedPtr ancestor, FilterState::LifeSpan life_span)
       : life_span_(life_span) {
-    // If ancestor is nullptr, we will create the parent lazily, otherwise we will create
-    // the parent immediately.
-    if (ancestor != nullptr) {
+    // If ancestor is nullptr, we will create the parent lazily. If the ancestor is further up the
+    // chain than the parent, the parents in between are empty until data is set in them, so that
+    // they are only created then, and the data is looked up in the ancestor meanwhile. Otherwise
+    // we will create the parent immediately.
+    if (ancestor != nullptr && life_span_ < FilterState::LifeSpan::TopSpan &&
+        ancestor->lifeSpan() > FilterState::LifeSpan(life_span_ + 1)) {
+      ancestor_ = std::move(ancestor);
+    } else if (ancestor != nullptr) {
       maybeCreateParent(std::move(ancestor));
     }
   }
@@ -45,14 +50,19 @@ public:
   FilterState::ObjectsPtr objectsSharedWithUpstreamConnection() const override;
 
   FilterState::LifeSpan lifeSpan() const override { return life_span_; }
-  FilterStateSharedPtr parent() const override { return parent_; }
+  FilterStateSharedPtr parent() const override;
 
 private:
   // This only checks the local data_storage_ for data_name existence.
   bool hasDataWithNameInternally(absl::string_view data_name) const;
   void maybeCreateParent(FilterStateSharedPtr ancestor);
+  // The filter state the data not stored here is looked up in.
+  const FilterStateSharedPtr& next() const { return parent_ != nullptr ? parent_ : ancestor_; }
 
-  FilterStateSharedPtr parent_;
+  // At most one of parent_ and ancestor_ is set. The parent is created from the ancestor when
+  // asked for, so that it is mutable.
+  mutable FilterStateSharedPtr parent_;
+  mutable FilterStateSharedPtr ancestor_;
   const FilterState::LifeSpan life_span_;
   absl::flat_hash_map<std::string, std::unique_ptr<FilterObject>> data_storage_;
 };
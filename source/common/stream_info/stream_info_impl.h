@@ -366,6 +366,9 @@ struct StreamInfoImpl : public StreamInfo {
   absl::optional<uint32_t> attemptCount() const override { return attempt_count_; }
 
   const BytesMeterSharedPtr& getUpstreamBytesMeter() const override {
+    if (upstream_bytes_meter_ == nullptr) {
+      upstream_bytes_meter_ = std::make_shared<BytesMeter>();
+    }
     return upstream_bytes_meter_;
   }
 
@@ -374,7 +377,9 @@ struct StreamInfoImpl : public StreamInfo {
   }
 
   void setUpstreamBytesMeter(const BytesMeterSharedPtr& upstream_bytes_meter) override {
-    upstream_bytes_meter->captureExistingBytesMeter(*upstream_bytes_meter_);
+    if (upstream_bytes_meter_ != nullptr) {
+      upstream_bytes_meter->captureExistingBytesMeter(*upstream_bytes_meter_);
+    }
     upstream_bytes_meter_ = upstream_bytes_meter;
   }
 
@@ -536,8 +541,9 @@ private:
   StreamIdProviderSharedPtr stream_id_provider_;
   absl::optional<DownstreamTiming> downstream_timing_;
   absl::optional<Upstream::ClusterInfoConstSharedPtr> upstream_cluster_info_;
-  // Default construct the object because upstream stream is not constructed in some cases.
-  BytesMeterSharedPtr upstream_bytes_meter_{std::make_shared<BytesMeter>()};
+  // Created when first asked for, as the upstream stream usually sets its own, but it is not
+  // constructed in some cases.
+  mutable BytesMeterSharedPtr upstream_bytes_meter_;
   BytesMeterSharedPtr downstream_bytes_meter_;
   std::string downstream_transport_failure_reason_;
   std::string downstream_local_close_reason_;
@@ -167,6 +167,12 @@ public:
   bool maybePreconnect(float preconnect_ratio) override {
     return maybePreconnectImpl(preconnect_ratio);
   }
+  void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const override {
+    idleConnectionsLastUsedImpl(last_used);
+  }
+  uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) override {
+    return closeIdleConnectionsImpl(last_used_cutoff, limit);
+  }
   ConnectionPool::Cancellable* newPendingStream(Envoy::ConnectionPool::AttachContext& context,
                                                 bool can_send_early_data) override;
   Upstream::HostDescriptionConstSharedPtr host() const override {
@@ -218,7 +218,8 @@ Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProx
       upstream_drain_manager_slot_(context.serverFactoryContext().threadLocal().allocateSlot()),
       shared_config_(std::make_shared<SharedConfig>(config, context)),
       random_generator_(context.serverFactoryContext().api().randomGenerator()),
-      regex_engine_(context.serverFactoryContext().regexEngine()) {
+      regex_engine_(context.serverFactoryContext().regexEngine()),
+      reuse_upstream_connections_(config.reuse_upstream_connections()) {
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     ThreadLocal::ThreadLocalObjectSharedPtr drain_manager =
         std::make_shared<UpstreamDrainManager>();
@@ -456,6 +457,18 @@ void Filter::initialize(Network::ReadFilterCallbacks& callbacks, bool set_connec
     }
   }
 
+  // Tunneling streams can not be returned to the TCP connection pool.
+  if (!config_->tunnelingConfigHelper()) {
+    const StreamInfo::BoolAccessor* reuse_upstream_connection =
+        read_callbacks_->connection()
+            .streamInfo()
+            .filterState()
+            ->getDataReadOnly<StreamInfo::BoolAccessor>(ReuseUpstreamConnectionKey);
+    reuse_upstream_connection_ = reuse_upstream_connection != nullptr
+                                     ? reuse_upstream_connection->value()
+                                     : config_->reuseUpstreamConnections();
+  }
+
   // Handle TLS handshake wait mode.
   if (connect_mode_ == UpstreamConnectMode::ON_DOWNSTREAM_TLS_HANDSHAKE) {
     const auto ssl_connection = read_callbacks_->connection().ssl();
@@ -615,12 +628,16 @@ void Filter::UpstreamCallbacks::onUpstreamData(Buffer::Instance& data, bool end_
   }
 }
 
-void Filter::UpstreamCallbacks::onBytesSent() {
-  if (drainer_ == nullptr) {
+bool Filter::UpstreamCallbacks::onBytesSent() {
+  if (parent_ != nullptr) {
     parent_->resetIdleTimer();
-  } else {
+  } else if (drainer_ != nullptr) {
     drainer_->onBytesSent();
+  } else {
+    // The upstream connection was returned to the pool and may be used by another filter.
+    return false;
   }
+  return true;
 }
 
 void Filter::UpstreamCallbacks::onIdleTimeout() {
@@ -637,6 +654,11 @@ void Filter::UpstreamCallbacks::drain(Drainer& drainer) {
   parent_ = nullptr;
 }
 
+void Filter::UpstreamCallbacks::release() {
+  ASSERT(drainer_ == nullptr);
+  parent_ = nullptr;
+}
+
 Network::FilterStatus Filter::establishUpstreamConnection() {
   const std::string& cluster_name = route_ ? route_->clusterName() : EMPTY_STRING;
   ENVOY_CONN_LOG(debug, "establishUpstreamConnection called: cluster_name={}, route_={}",
@@ -1042,6 +1064,9 @@ Network::FilterStatus Filter::onData(Buffer::Instance& data, bool end_stream) {
   getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(data.length());
 
   if (upstream_) {
+    if (end_stream && data.length() == 0 && releaseUpstreamForReuse()) {
+      return Network::FilterStatus::StopIteration;
+    }
     getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(data.length());
     upstream_->encodeData(data, end_stream);
     resetIdleTimer(); // TODO(ggreenway) PERF: do we need to reset timer on both send and receive?
@@ -1224,6 +1249,9 @@ void Filter::onUpstreamData(Buffer::Instance& data, bool end_stream) {
                  read_callbacks_->connection(), data.length(), end_stream);
   getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(data.length());
   getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(data.length());
+  if (end_stream) {
+    upstream_end_stream_ = true;
+  }
   read_callbacks_->connection().write(data, end_stream);
   ASSERT(0 == data.length());
   resetIdleTimer(); // TODO(ggreenway) PERF: do we need to reset timer on both send and receive?
@@ -1334,8 +1362,7 @@ void Filter::onUpstreamConnection() {
     });
     if (upstream_) {
       upstream_->addBytesSentCallback([upstream_callbacks = upstream_callbacks_](uint64_t) -> bool {
-        upstream_callbacks->onBytesSent();
-        return true;
+        return upstream_callbacks->onBytesSent();
       });
     }
   }
@@ -1402,6 +1429,23 @@ void Filter::resetIdleTimer() {
   }
 }
 
+bool Filter::releaseUpstreamForReuse() {
+  // A connection the upstream has half-closed can not carry another session.
+  if (!reuse_upstream_connection_ || upstream_end_stream_ ||
+      !upstream_->releaseConnectionForReuse()) {
+    return false;
+  }
+  ENVOY_CONN_LOG(debug, "downstream half-closed, releasing upstream connection for reuse",
+                 read_callbacks_->connection());
+  config_->stats().upstream_cx_released_for_reuse_.inc();
+  upstream_callbacks_->release();
+  upstream_.reset();
+  disableIdleTimer();
+  // The pending upstream data written downstream is flushed before the close completes.
+  read_callbacks_->connection().close(Network::ConnectionCloseType::FlushWrite);
+  return true;
+}
+
 void Filter::disableIdleTimer() {
   if (idle_timer_ != nullptr) {
     idle_timer_->disableTimer();
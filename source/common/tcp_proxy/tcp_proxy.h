@@ -55,6 +55,15 @@ constexpr absl::string_view PerConnectionIdleTimeoutMs =
  */
 constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_before_connect";
 
+/**
+ * ReuseUpstreamConnectionKey is the key for the reuse_upstream_connection filter state. The
+ * filter state value is a ``StreamInfo::BoolAccessor`` indicating whether the upstream connection
+ * should be returned to the connection pool when the downstream connection half-closes, as if
+ * ``reuse_upstream_connections`` was set in the configuration.
+ */
+constexpr absl::string_view ReuseUpstreamConnectionKey =
+    "envoy.tcp_proxy.reuse_upstream_connection";
+
 /**
  * All tcp proxy stats. @see stats_macros.h
  */
@@ -68,6 +77,7 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
   COUNTER(early_data_received_count_total)                                                         \
   COUNTER(idle_timeout)                                                                            \
   COUNTER(max_downstream_connection_duration)                                                      \
+  COUNTER(upstream_cx_released_for_reuse)                                                          \
   COUNTER(upstream_flush_total)                                                                    \
   GAUGE(downstream_cx_rx_bytes_buffered, Accumulate)                                               \
   GAUGE(downstream_cx_tx_bytes_buffered, Accumulate)                                               \
@@ -378,6 +388,8 @@ public:
 
   const absl::optional<uint32_t>& maxEarlyDataBytes() const { return max_early_data_bytes_; }
 
+  bool reuseUpstreamConnections() const { return reuse_upstream_connections_; }
+
 private:
   struct SimpleRouteImpl : public Route {
     SimpleRouteImpl(const Config& parent, absl::string_view cluster_name);
@@ -433,6 +445,7 @@ private:
   envoy::extensions::filters::network::tcp_proxy::v3::UpstreamConnectMode upstream_connect_mode_{
       envoy::extensions::filters::network::tcp_proxy::v3::IMMEDIATE};
   absl::optional<uint32_t> max_early_data_bytes_;
+  const bool reuse_upstream_connections_;
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -519,9 +532,11 @@ public:
     void onAboveWriteBufferHighWatermark() override;
     void onBelowWriteBufferLowWatermark() override;
 
-    void onBytesSent();
+    // @return false if the callback should be removed from the upstream connection.
+    bool onBytesSent();
     void onIdleTimeout();
     void drain(Drainer& drainer);
+    void release();
 
     // Either parent_ or drainer_ will be non-NULL, but never both. This could be
     // logically be represented as a union, but saving one pointer of memory is
@@ -529,7 +544,8 @@ public:
     //
     // Parent starts out as non-NULL. If the downstream connection is closed while
     // the upstream connection still has buffered data to flush, drainer_ becomes
-    // non-NULL and parent_ is set to NULL.
+    // non-NULL and parent_ is set to NULL. If the upstream connection is returned to
+    // the connection pool for reuse, both are NULL.
     Filter* parent_{};
     Drainer* drainer_{};
 
@@ -570,6 +586,7 @@ public:
       return makeOptRef<const Tracing::Config>(parent_->tracing_config_);
     }
     void continueDecoding() override {}
+    void skipDecodingBodyAndTrailers() override {}
     void addDecodedData(Buffer::Instance&, bool) override {}
     void injectDecodedDataToFilterChain(Buffer::Instance&, bool) override {}
     Http::RequestTrailerMap& addDecodedTrailers() override { return *request_trailer_map_; }
@@ -688,6 +705,7 @@ protected:
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
+  bool releaseUpstreamForReuse();
   void onMaxDownstreamConnectionDuration();
   void onAccessLogFlushInterval();
   void resetAccessLogFlushTimer();
@@ -743,6 +761,10 @@ protected:
   // the upstream connection is established.
   bool receive_before_connect_{false};
   bool early_data_end_stream_{false};
+  // Whether the upstream connection is returned to the connection pool when the downstream
+  // connection half-closes, and whether the upstream connection has half-closed.
+  bool reuse_upstream_connection_{false};
+  bool upstream_end_stream_{false};
   Buffer::OwnedImpl early_data_buffer_{};
   HttpStreamDecoderFilterCallbacks upstream_decoder_filter_callbacks_;
 
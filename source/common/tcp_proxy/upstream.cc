@@ -117,6 +117,17 @@ StreamInfo::DetectedCloseType TcpUpstream::detectedCloseType() const {
   return StreamInfo::DetectedCloseType::Normal;
 }
 
+bool TcpUpstream::releaseConnectionForReuse() {
+  if (upstream_conn_data_ == nullptr ||
+      upstream_conn_data_->connection().state() != Network::Connection::State::Open ||
+      !upstream_conn_data_->connection().readEnabled()) {
+    return false;
+  }
+  // Destroying the connection data returns the connection to the pool.
+  upstream_conn_data_.reset();
+  return true;
+}
+
 Tcp::ConnectionPool::ConnectionData*
 TcpUpstream::onDownstreamEvent(Network::ConnectionEvent event) {
   // TODO(botengyao): propagate RST back to upstream connection if RST is received from downstream.
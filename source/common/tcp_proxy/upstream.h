@@ -179,6 +179,7 @@ public:
   bool startUpstreamSecureTransport() override;
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override;
   StreamInfo::DetectedCloseType detectedCloseType() const override;
+  bool releaseConnectionForReuse() override;
 
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
@@ -220,6 +221,8 @@ public:
   }
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override { return nullptr; }
   StreamInfo::DetectedCloseType detectedCloseType() const override;
+  // Tunneling streams are not pooled.
+  bool releaseConnectionForReuse() override { return false; }
 
 protected:
   void resetEncoder(Network::ConnectionEvent event, bool inform_downstream = true);
@@ -306,6 +309,7 @@ public:
   bool startUpstreamSecureTransport() override { return false; }
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override { return nullptr; }
   StreamInfo::DetectedCloseType detectedCloseType() const override;
+  bool releaseConnectionForReuse() override { return false; }
 
   // Router::RouterFilterInterface
   void onUpstreamHeaders(uint64_t response_code, Http::ResponseHeaderMapPtr&& headers,
@@ -323,6 +327,7 @@ public:
   }
   void onPerTryTimeout(UpstreamRequest&) override {}
   void onPerTryIdleTimeout(UpstreamRequest&) override {}
+  void onHedgeTimeout(UpstreamRequest&) override {}
   void onStreamMaxDurationReached(UpstreamRequest&) override {}
   void setupRouteTimeoutForWebsocketUpgrade() override {}
   void disableRouteTimeoutForWebsocketUpgrade() override {}
@@ -124,6 +124,8 @@ void InstanceImpl::SlotImpl::runOnAllThreads(const UpdateCb& cb) {
 void InstanceImpl::SlotImpl::set(InitializeCb cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!parent_.shutdown_);
+  // The queued updates of other slots must reach the workers before this one.
+  parent_.flushBatchedUpdates();
 
   for (Event::Dispatcher& dispatcher : parent_.registered_threads_) {
     // See the header file comments for still_alive_guard_ for why we capture index_.
@@ -144,6 +146,8 @@ void InstanceImpl::registerThread(Event::Dispatcher& dispatcher, bool main_threa
     thread_local_data_.dispatcher_ = &dispatcher;
   } else {
     ASSERT(!containsReference(registered_threads_, dispatcher));
+    // The updates queued before the thread is registered are not for it.
+    flushBatchedUpdates();
     registered_threads_.push_back(dispatcher);
     dispatcher.post([&dispatcher] { thread_local_data_.dispatcher_ = &dispatcher; });
   }
@@ -180,6 +184,12 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
 
+  if (batch_depth_ > 0) {
+    batched_updates_.push_back(cb);
+    cb();
+    return;
+  }
+
   for (Event::Dispatcher& dispatcher : registered_threads_) {
     dispatcher.post(cb);
   }
@@ -197,6 +207,12 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb,
   // for programming simplicity here.
   cb();
 
+  if (batch_depth_ > 0) {
+    batched_updates_.push_back(std::move(cb));
+    batched_completions_.push_back(std::move(all_threads_complete_cb));
+    return;
+  }
+
   std::shared_ptr<std::function<void()>> cb_guard(
       new std::function<void()>(cb), [this, all_threads_complete_cb](std::function<void()>* cb) {
         main_thread_dispatcher_->post(all_threads_complete_cb);
@@ -208,6 +224,58 @@ void InstanceImpl::runOnAllThreads(std::function<void()> cb,
   }
 }
 
+UpdateBatchPtr InstanceImpl::batchUpdates() {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  return std::make_unique<UpdateBatchImpl>(*this);
+}
+
+InstanceImpl::UpdateBatchImpl::~UpdateBatchImpl() {
+  ASSERT(parent_.batch_depth_ > 0);
+  if (--parent_.batch_depth_ == 0) {
+    parent_.flushBatchedUpdates();
+  }
+}
+
+void InstanceImpl::flushBatchedUpdates() {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  if (shutdown_) {
+    // The workers are gone or about to exit, the updates would not run.
+    batched_updates_.clear();
+    batched_completions_.clear();
+    return;
+  }
+  if (batched_updates_.empty()) {
+    return;
+  }
+
+  auto updates = std::make_shared<const std::vector<std::function<void()>>>(
+      std::move(batched_updates_));
+  batched_updates_.clear();
+  std::shared_ptr<std::vector<std::function<void()>>> completion_guard;
+  if (!batched_completions_.empty()) {
+    // The completions run on the main thread once the last worker released the guard.
+    completion_guard.reset(
+        new std::vector<std::function<void()>>(std::move(batched_completions_)),
+        [this](std::vector<std::function<void()>>* completions) {
+          main_thread_dispatcher_->post([completions = std::move(*completions)]() -> void {
+            for (const std::function<void()>& completion : completions) {
+              completion();
+            }
+          });
+          delete completions;
+        });
+    batched_completions_.clear();
+  }
+
+  for (Event::Dispatcher& dispatcher : registered_threads_) {
+    dispatcher.post([updates, completion_guard]() -> void {
+      for (const std::function<void()>& update : *updates) {
+        update();
+      }
+    });
+  }
+}
+
 void InstanceImpl::setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object) {
   if (thread_local_data_.data_.size() <= index) {
     thread_local_data_.data_.resize(index + 1);
@@ -219,6 +287,7 @@ void InstanceImpl::setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr obj
 void InstanceImpl::shutdownGlobalThreading() {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
   ASSERT(!shutdown_);
+  flushBatchedUpdates();
   shutdown_ = true;
 }
 
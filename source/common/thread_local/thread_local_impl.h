@@ -28,9 +28,19 @@ public:
   void shutdownGlobalThreading() override;
   void shutdownThread() override;
   Event::Dispatcher& dispatcher() override;
+  UpdateBatchPtr batchUpdates() override;
   bool isShutdown() const override { return shutdown_; }
 
 private:
+  class UpdateBatchImpl : public UpdateBatch {
+  public:
+    explicit UpdateBatchImpl(InstanceImpl& parent) : parent_(parent) { ++parent_.batch_depth_; }
+    ~UpdateBatchImpl() override;
+
+  private:
+    InstanceImpl& parent_;
+  };
+
   // On destruction returns the slot index to the deferred delete queue (detaches it). This allows
   // a slot to be destructed on the main thread while controlling the lifetime of the underlying
   // slot as callbacks drain from workers.
@@ -78,6 +88,8 @@ private:
   void runOnAllThreads(std::function<void()> cb);
   void runOnAllThreads(std::function<void()> cb, std::function<void()> main_callback);
   static void setThreadLocal(uint32_t index, ThreadLocalObjectSharedPtr object);
+  // Delivers the updates queued by the open batches to the workers.
+  void flushBatchedUpdates();
 
   static thread_local ThreadLocalData thread_local_data_;
 
@@ -88,6 +100,10 @@ private:
   std::list<std::reference_wrapper<Event::Dispatcher>> registered_threads_;
   Event::Dispatcher* main_thread_dispatcher_{};
   std::atomic<bool> shutdown_{};
+  // The number of open batches, and the worker callbacks and completion callbacks they queued.
+  uint32_t batch_depth_{};
+  std::vector<std::function<void()>> batched_updates_;
+  std::vector<std::function<void()>> batched_completions_;
 
   // Test only.
   friend class ThreadLocalInstanceImplTest;
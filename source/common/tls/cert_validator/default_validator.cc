@@ -10,9 +10,11 @@
 #include <deque>
 #include <functional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "envoy/network/transport_socket.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/context_config.h"
 #include "envoy/ssl/private_key/private_key.h"
@@ -46,6 +48,8 @@ namespace Extensions {
 namespace TransportSockets {
 namespace Tls {
 
+SINGLETON_MANAGER_REGISTRATION(tls_verification_thread_pools);
+
 DefaultCertValidator::DefaultCertValidator(
     const Envoy::Ssl::CertificateValidationContextConfig* config, SslStats& stats,
     Server::Configuration::CommonFactoryContext& context)
@@ -55,6 +59,21 @@ DefaultCertValidator::DefaultCertValidator(
     allow_untrusted_certificate_ = config_->trustChainVerification() ==
                                    envoy::extensions::transport_sockets::tls::v3::
                                        CertificateValidationContext::ACCEPT_UNTRUSTED;
+    if (const auto& cache_config = config_->verifiedChainCache(); cache_config.has_value()) {
+      verified_chain_cache_ = std::make_unique<VerifiedChainCache>(
+          cache_config->max_entries_, cache_config->max_ttl_, context_.timeSource());
+    }
+    if (const absl::optional<uint32_t> threads = config_->trustChainVerificationOffloadThreads();
+        threads.has_value()) {
+      auto pools = context_.singletonManager().getTyped<VerificationThreadPools>(
+          SINGLETON_MANAGER_REGISTERED_NAME(tls_verification_thread_pools),
+          [&context]() {
+            return std::make_shared<VerificationThreadPools>(context.api().threadFactory());
+          },
+          /* pin = */ true);
+      verification_thread_pool_ = pools->getOrCreate(
+          *threads != 0 ? *threads : std::max(1u, std::thread::hardware_concurrency()));
+    }
   }
 };
 
@@ -78,12 +97,8 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
 
   if (config_ != nullptr && !config_->caCert().empty() && !provides_certificates) {
     ca_file_path_ = config_->caCertPath();
-    bssl::UniquePtr<BIO> bio(
-        BIO_new_mem_buf(const_cast<char*>(config_->caCert().data()), config_->caCert().size()));
-    RELEASE_ASSERT(bio != nullptr, "");
-    // Based on BoringSSL's X509_load_cert_crl_file().
-    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
-        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+    bssl::UniquePtr<STACK_OF(X509_INFO)> list =
+        Utility::readPemX509Infos(config_->caCert(), context_.api().threadFactory());
     if (list == nullptr) {
       return absl::InvalidArgumentError(
           absl::StrCat("Failed to load trusted CA certificates from ", config_->caCertPath()));
@@ -103,6 +118,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
         }
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
+          addCrlNextUpdate(item->crl);
           has_crl = true;
         }
       }
@@ -131,14 +147,8 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
   }
 
   if (config_ != nullptr && !config_->certificateRevocationList().empty()) {
-    bssl::UniquePtr<BIO> bio(
-        BIO_new_mem_buf(const_cast<char*>(config_->certificateRevocationList().data()),
-                        config_->certificateRevocationList().size()));
-    RELEASE_ASSERT(bio != nullptr, "");
-
-    // Based on BoringSSL's X509_load_cert_crl_file().
-    bssl::UniquePtr<STACK_OF(X509_INFO)> list(
-        PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+    bssl::UniquePtr<STACK_OF(X509_INFO)> list = Utility::readPemX509Infos(
+        config_->certificateRevocationList(), context_.api().threadFactory());
     if (list == nullptr) {
       return absl::InvalidArgumentError(
           absl::StrCat("Failed to load CRL from ", config_->certificateRevocationListPath()));
@@ -150,6 +160,7 @@ absl::StatusOr<int> DefaultCertValidator::initializeSslContexts(std::vector<SSL_
       for (const X509_INFO* item : list.get()) {
         if (item->crl) {
           X509_STORE_add_crl(store, item->crl);
+          addCrlNextUpdate(item->crl);
         }
       }
       X509_STORE_set_flags(store, config_->onlyVerifyLeafCertificateCrl()
@@ -315,7 +326,7 @@ DefaultCertValidator::verifyCertificate(X509* cert, const std::vector<std::strin
 }
 
 ValidationResults DefaultCertValidator::doVerifyCertChain(
-    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr /*callback*/,
+    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
     const Network::TransportSocketOptionsConstSharedPtr& transport_socket_options, SSL_CTX& ssl_ctx,
     const CertValidator::ExtraValidationContext& context, bool is_server,
     absl::string_view host_name) {
@@ -330,18 +341,27 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
       Envoy::Ssl::ClientValidationStatus::NotValidated;
   X509* leaf_cert = sk_X509_value(&cert_chain, 0);
   ASSERT(leaf_cert);
-  if (verify_trusted_ca_) {
-    X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
-    ASSERT(verify_store);
+  std::string cache_key;
+  bool verified_from_cache = false;
+  if (verify_trusted_ca_ && verified_chain_cache_ != nullptr) {
+    cache_key = VerifiedChainCache::key(cert_chain, is_server);
+    verified_from_cache = verified_chain_cache_->contains(cache_key);
+    if (verified_from_cache) {
+      stats_.verified_chain_cache_hit_.inc();
+    } else {
+      stats_.verified_chain_cache_miss_.inc();
+    }
+  }
+  if (verified_from_cache) {
+    detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+  } else if (verify_trusted_ca_) {
+    if (verification_thread_pool_ != nullptr && callback != nullptr) {
+      return offloadCertChainVerification(cert_chain, std::move(callback),
+                                          transport_socket_options.get(), ssl_ctx, context,
+                                          is_server, host_name, std::move(cache_key));
+    }
     bssl::UniquePtr<X509_STORE_CTX> ctx(X509_STORE_CTX_new());
-    if (!ctx || !X509_STORE_CTX_init(ctx.get(), verify_store, leaf_cert, &cert_chain) ||
-        // We need to inherit the verify parameters. These can be determined by
-        // the context: if it's a server it will verify SSL client certificates or
-        // vice versa.
-        !X509_STORE_CTX_set_default(ctx.get(), is_server ? "ssl_client" : "ssl_server") ||
-        // Anything non-default in "param" should overwrite anything in the ctx.
-        !X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(ctx.get()),
-                                SSL_CTX_get0_param(&ssl_ctx))) {
+    if (!ctx || !initializeStoreContext(*ctx, cert_chain, ssl_ctx, is_server)) {
       OPENSSL_PUT_ERROR(SSL, ERR_R_X509_LIB);
       const char* error = "verify cert failed: init and setup X509_STORE_CTX";
       stats_.fail_verify_error_.inc();
@@ -366,6 +386,9 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
               SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx.get())), error};
     }
     detailed_status = Envoy::Ssl::ClientValidationStatus::Validated;
+    if (verified_chain_cache_ != nullptr) {
+      cacheVerifiedChain(cache_key, *ctx);
+    }
   }
   std::string error_details;
   uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
@@ -378,6 +401,107 @@ ValidationResults DefaultCertValidator::doVerifyCertChain(
                                        tls_alert, error_details};
 }
 
+bool DefaultCertValidator::initializeStoreContext(X509_STORE_CTX& store_ctx,
+                                                  STACK_OF(X509)& cert_chain, SSL_CTX& ssl_ctx,
+                                                  bool is_server) {
+  X509_STORE* verify_store = SSL_CTX_get_cert_store(&ssl_ctx);
+  ASSERT(verify_store);
+  return X509_STORE_CTX_init(&store_ctx, verify_store, sk_X509_value(&cert_chain, 0),
+                             &cert_chain) &&
+         // We need to inherit the verify parameters. These can be determined by
+         // the context: if it's a server it will verify SSL client certificates or
+         // vice versa.
+         X509_STORE_CTX_set_default(&store_ctx, is_server ? "ssl_client" : "ssl_server") &&
+         // Anything non-default in "param" should overwrite anything in the ctx.
+         X509_VERIFY_PARAM_set1(X509_STORE_CTX_get0_param(&store_ctx),
+                                SSL_CTX_get0_param(&ssl_ctx));
+}
+
+ValidationResults DefaultCertValidator::offloadCertChainVerification(
+    STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
+    const Network::TransportSocketOptions* transport_socket_options, SSL_CTX& ssl_ctx,
+    const CertValidator::ExtraValidationContext& validation_context, bool is_server,
+    absl::string_view host_name, std::string cache_key) {
+  // The checks of the leaf certificate can depend on the connection, which may be closed before
+  // the verification of the chain completes, so they are run by the worker before the hand-off.
+  Envoy::Ssl::ClientValidationStatus leaf_status = Envoy::Ssl::ClientValidationStatus::NotValidated;
+  std::string error_details;
+  uint8_t tls_alert = SSL_AD_CERTIFICATE_UNKNOWN;
+  if (!verifyCertAndUpdateStatus(sk_X509_value(&cert_chain, 0), host_name,
+                                 transport_socket_options, validation_context, leaf_status,
+                                 &error_details, &tls_alert)) {
+    return {ValidationResults::ValidationStatus::Failed, leaf_status, tls_alert, error_details};
+  }
+
+  auto verification = std::make_unique<OffloadedVerification>();
+  SSL_CTX_up_ref(&ssl_ctx);
+  verification->ssl_ctx_.reset(&ssl_ctx);
+  verification->cert_chain_.reset(X509_chain_up_ref(&cert_chain));
+  verification->callback_ = std::move(callback);
+  verification->cache_key_ = std::move(cache_key);
+  verification->is_server_ = is_server;
+  verification->leaf_status_ = leaf_status;
+  verification_thread_pool_->post(
+      [this, weak_alive_indicator = std::weak_ptr<size_t>(alive_indicator_),
+       verification = std::move(verification)]() mutable {
+        verification->store_ctx_.reset(X509_STORE_CTX_new());
+        verification->initialized_ =
+            verification->store_ctx_ != nullptr && verification->cert_chain_ != nullptr &&
+            initializeStoreContext(*verification->store_ctx_, *verification->cert_chain_,
+                                   *verification->ssl_ctx_, verification->is_server_);
+        verification->verified_ =
+            verification->initialized_ && X509_verify_cert(verification->store_ctx_.get()) == 1;
+        // The verification is handed back to the worker, which owns the callback.
+        Event::Dispatcher& dispatcher = verification->callback_->dispatcher();
+        dispatcher.post([this, weak_alive_indicator = std::move(weak_alive_indicator),
+                         verification = std::move(verification)]() {
+          if (weak_alive_indicator.expired()) {
+            // The connection is gone with the context of the validator.
+            return;
+          }
+          onCertChainVerified(*verification);
+        });
+      });
+  return {ValidationResults::ValidationStatus::Pending,
+          Envoy::Ssl::ClientValidationStatus::NotValidated, absl::nullopt, absl::nullopt};
+}
+
+void DefaultCertValidator::onCertChainVerified(OffloadedVerification& verification) {
+  Ssl::ValidateResultCallback& callback = *verification.callback_;
+  if (!verification.initialized_) {
+    const char* error = "verify cert failed: init and setup X509_STORE_CTX";
+    stats_.fail_verify_error_.inc();
+    ENVOY_LOG(debug, error);
+    callback.onCertValidationResult(false, Envoy::Ssl::ClientValidationStatus::Failed, error,
+                                    SSL_AD_CERTIFICATE_UNKNOWN);
+    return;
+  }
+  X509_STORE_CTX* ctx = verification.store_ctx_.get();
+  if (!verification.verified_) {
+    const std::string error =
+        absl::StrCat("verify cert failed: ", Utility::getX509VerificationErrorInfo(ctx));
+    stats_.fail_verify_error_.inc();
+    ENVOY_LOG(debug, error);
+    if (allow_untrusted_certificate_) {
+      callback.onCertValidationResult(true, Envoy::Ssl::ClientValidationStatus::Failed, "",
+                                      SSL_AD_CERTIFICATE_UNKNOWN);
+      return;
+    }
+    callback.onCertValidationResult(false, Envoy::Ssl::ClientValidationStatus::Failed, error,
+                                    SSL_alert_from_verify_result(X509_STORE_CTX_get_error(ctx)));
+    return;
+  }
+  if (verified_chain_cache_ != nullptr) {
+    cacheVerifiedChain(verification.cache_key_, *ctx);
+  }
+  callback.onCertValidationResult(
+      true,
+      verification.leaf_status_ != Envoy::Ssl::ClientValidationStatus::NotValidated
+          ? verification.leaf_status_
+          : Envoy::Ssl::ClientValidationStatus::Validated,
+      "", SSL_AD_CERTIFICATE_UNKNOWN);
+}
+
 bool DefaultCertValidator::verifySubjectAltName(X509* cert,
                                                 const std::vector<std::string>& subject_alt_names) {
   bssl::UniquePtr<GENERAL_NAMES> san_names(
@@ -612,6 +736,28 @@ void DefaultCertValidator::initializeCertExpirationStats(Stats::Scope& scope) {
   expiration_gauge.set(Utility::getExpirationUnixTime(ca_cert_.get()).count());
 }
 
+void DefaultCertValidator::addCrlNextUpdate(const X509_CRL* crl) {
+  const ASN1_TIME* next_update = X509_CRL_get0_nextUpdate(crl);
+  int64_t next_update_seconds;
+  if (next_update == nullptr || !ASN1_TIME_to_posix(next_update, &next_update_seconds)) {
+    return;
+  }
+  const SystemTime next_update_time{std::chrono::seconds(next_update_seconds)};
+  if (!crl_next_update_.has_value() || next_update_time < *crl_next_update_) {
+    crl_next_update_ = next_update_time;
+  }
+}
+
+void DefaultCertValidator::cacheVerifiedChain(const std::string& key, X509_STORE_CTX& verified) {
+  // The verification expires with the first certificate from the leaf to the trust anchor to
+  // expire, or when a CRL is due to be updated.
+  SystemTime expires_at = crl_next_update_.value_or(SystemTime::max());
+  for (const X509* cert : X509_STORE_CTX_get0_chain(&verified)) {
+    expires_at = std::min(expires_at, Utility::getExpirationTime(*cert));
+  }
+  verified_chain_cache_->insert(key, expires_at);
+}
+
 absl::optional<uint32_t> DefaultCertValidator::daysUntilFirstCertExpires() const {
   return Utility::getDaysUntilExpiration(ca_cert_.get(), context_.timeSource());
 }
@@ -21,6 +21,8 @@
 #include "source/common/stats/symbol_table.h"
 #include "source/common/tls/cert_validator/cert_validator.h"
 #include "source/common/tls/cert_validator/san_matcher.h"
+#include "source/common/tls/cert_validator/verification_thread_pool.h"
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
 #include "source/common/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -106,6 +108,34 @@ public:
                                   const std::vector<SanMatcherPtr>& subject_alt_name_matchers);
 
 private:
+  // The state of a trust chain verification offloaded to the verification thread pool. The chain
+  // and the context are referenced by the verification, so they are declared first.
+  struct OffloadedVerification {
+    bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+    bssl::UniquePtr<STACK_OF(X509)> cert_chain_;
+    bssl::UniquePtr<X509_STORE_CTX> store_ctx_;
+    Ssl::ValidateResultCallbackPtr callback_;
+    std::string cache_key_;
+    bool is_server_{};
+    // The status of the checks of the leaf certificate already run by the worker.
+    Envoy::Ssl::ClientValidationStatus leaf_status_{};
+    bool initialized_{};
+    bool verified_{};
+  };
+  using OffloadedVerificationPtr = std::unique_ptr<OffloadedVerification>;
+
+  // Initializes the verification of a chain against the trust store of a context.
+  static bool initializeStoreContext(X509_STORE_CTX& store_ctx, STACK_OF(X509)& cert_chain,
+                                     SSL_CTX& ssl_ctx, bool is_server);
+  ValidationResults
+  offloadCertChainVerification(STACK_OF(X509)& cert_chain, Ssl::ValidateResultCallbackPtr callback,
+                               const Network::TransportSocketOptions* transport_socket_options,
+                               SSL_CTX& ssl_ctx,
+                               const CertValidator::ExtraValidationContext& validation_context,
+                               bool is_server, absl::string_view host_name, std::string cache_key);
+  // Completes an offloaded verification on the worker which started it.
+  void onCertChainVerified(OffloadedVerification& verification);
+
   bool verifyCertAndUpdateStatus(X509* leaf_cert, absl::string_view sni,
                                  const Network::TransportSocketOptions* transport_socket_options,
                                  const CertValidator::ExtraValidationContext& validation_context,
@@ -113,6 +143,11 @@ private:
                                  std::string* error_details, uint8_t* out_alert);
 
   void initializeCertExpirationStats(Stats::Scope& scope);
+  // Records the next update of a CRL added to the trust store.
+  void addCrlNextUpdate(const X509_CRL* crl);
+  // Caches the successful verification of a chain, until the expiration of the verified chain.
+  void cacheVerifiedChain(const std::string& key, X509_STORE_CTX& verified);
+
   const Envoy::Ssl::CertificateValidationContextConfig* config_;
   SslStats& stats_;
   Server::Configuration::CommonFactoryContext& context_;
@@ -124,6 +159,13 @@ private:
   bool allow_untrusted_certificate_{false};
   bool verify_trusted_ca_{false};
   const bool auto_sni_san_match_{false};
+  std::unique_ptr<VerifiedChainCache> verified_chain_cache_;
+  // The earliest next update of the CRLs of the trust store.
+  absl::optional<SystemTime> crl_next_update_;
+  VerificationThreadPoolSharedPtr verification_thread_pool_;
+  // Lets the offloaded verifications handed back to the workers detect the destruction of the
+  // validator. Declared last so that it is released first.
+  std::shared_ptr<size_t> alive_indicator_{std::make_shared<size_t>(1)};
 };
 
 DECLARE_FACTORY(DefaultCertValidatorFactory);
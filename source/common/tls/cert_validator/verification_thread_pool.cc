@@ -0,0 +1,72 @@
+#include "source/common/tls/cert_validator/verification_thread_pool.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+VerificationThreadPool::VerificationThreadPool(Thread::ThreadFactory& thread_factory,
+                                               uint32_t thread_count) {
+  ASSERT(thread_count > 0);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.push_back(
+        thread_factory.createThread([this]() { threadRoutine(); }, Thread::Options{"tls_verify"}));
+  }
+}
+
+VerificationThreadPool::~VerificationThreadPool() {
+  {
+    Thread::LockGuard lock(mutex_);
+    shutdown_ = true;
+  }
+  cond_.notifyAll();
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void VerificationThreadPool::post(Task task) {
+  {
+    Thread::LockGuard lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  cond_.notifyOne();
+}
+
+void VerificationThreadPool::threadRoutine() {
+  while (true) {
+    Task task;
+    {
+      Thread::LockGuard lock(mutex_);
+      while (tasks_.empty() && !shutdown_) {
+        cond_.wait(mutex_);
+      }
+      if (shutdown_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+VerificationThreadPoolSharedPtr VerificationThreadPools::getOrCreate(uint32_t thread_count) {
+  Thread::LockGuard lock(mutex_);
+  std::weak_ptr<VerificationThreadPool>& weak_pool = pools_[thread_count];
+  VerificationThreadPoolSharedPtr pool = weak_pool.lock();
+  if (pool == nullptr) {
+    pool = std::make_shared<VerificationThreadPool>(thread_factory_, thread_count);
+    weak_pool = pool;
+  }
+  return pool;
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "envoy/singleton/instance.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/thread.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/any_invocable.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A pool of threads running the trust chain verifications offloaded by the certificate validators
+ * of the workers. Only the validators own the pool, so that it is never destroyed by one of its
+ * threads, and the tasks must hand their results back to the workers.
+ */
+class VerificationThreadPool {
+public:
+  using Task = absl::AnyInvocable<void()>;
+
+  VerificationThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count);
+  ~VerificationThreadPool();
+
+  /**
+   * Runs a task on a thread of the pool. Thread safe. The tasks not run yet when the pool is
+   * destroyed are dropped, as the validators which posted them are gone.
+   */
+  void post(Task task);
+
+private:
+  void threadRoutine();
+
+  Thread::MutexBasicLockable mutex_;
+  Thread::CondVar cond_;
+  std::deque<Task> tasks_ ABSL_GUARDED_BY(mutex_);
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using VerificationThreadPoolSharedPtr = std::shared_ptr<VerificationThreadPool>;
+
+/**
+ * The verification thread pools of the process, so that the validators configured with the same
+ * number of threads share a pool.
+ */
+class VerificationThreadPools : public Singleton::Instance {
+public:
+  explicit VerificationThreadPools(Thread::ThreadFactory& thread_factory)
+      : thread_factory_(thread_factory) {}
+
+  /**
+   * @return the pool with a number of threads, creating it if no validator owns it anymore.
+   */
+  VerificationThreadPoolSharedPtr getOrCreate(uint32_t thread_count);
+
+private:
+  Thread::ThreadFactory& thread_factory_;
+  Thread::MutexBasicLockable mutex_;
+  absl::flat_hash_map<uint32_t, std::weak_ptr<VerificationThreadPool>>
+      pools_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,87 @@
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+#include "openssl/sha.h"
+#include "openssl/x509.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+VerifiedChainCache::VerifiedChainCache(size_t max_entries, std::chrono::milliseconds max_ttl,
+                                       TimeSource& time_source)
+    : max_entries_(max_entries), max_ttl_(max_ttl), time_source_(time_source) {
+  ASSERT(max_entries_ > 0);
+}
+
+std::string VerifiedChainCache::key(STACK_OF(X509)& cert_chain, bool is_server) {
+  SHA256_CTX sha256;
+  SHA256_Init(&sha256);
+  const uint8_t peer_is_client = is_server;
+  SHA256_Update(&sha256, &peer_is_client, sizeof(peer_is_client));
+  for (const X509* cert : &cert_chain) {
+    uint8_t* der = nullptr;
+    const int der_length = i2d_X509(cert, &der);
+    RELEASE_ASSERT(der_length > 0, "");
+    bssl::UniquePtr<uint8_t> der_free(der);
+    // Prefix each certificate with its length so that different chains can't hash the same.
+    const uint32_t length = der_length;
+    SHA256_Update(&sha256, &length, sizeof(length));
+    SHA256_Update(&sha256, der, der_length);
+  }
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256_Final(reinterpret_cast<uint8_t*>(digest.data()), &sha256);
+  return digest;
+}
+
+bool VerifiedChainCache::contains(const std::string& key) {
+  const SystemTime now = time_source_.systemTime();
+  absl::MutexLock lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  if (now >= it->second.expires_at_) {
+    lru_.erase(it->second.lru_position_);
+    entries_.erase(it);
+    return false;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  return true;
+}
+
+void VerifiedChainCache::insert(const std::string& key, SystemTime expires_at) {
+  const SystemTime now = time_source_.systemTime();
+  expires_at = std::min<SystemTime>(expires_at, now + max_ttl_);
+  if (expires_at <= now) {
+    return;
+  }
+  absl::MutexLock lock(mutex_);
+  auto [it, inserted] = entries_.try_emplace(key);
+  if (inserted) {
+    lru_.push_front(key);
+    if (lru_.size() > max_entries_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  } else {
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position_);
+  }
+  // Evicting another entry doesn't invalidate the iterator.
+  it->second.expires_at_ = expires_at;
+  it->second.lru_position_ = lru_.begin();
+}
+
+size_t VerifiedChainCache::size() const {
+  absl::MutexLock lock(mutex_);
+  return entries_.size();
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
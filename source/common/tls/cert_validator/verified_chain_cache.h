@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <string>
+
+#include "envoy/common/time.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * A bounded cache of the peer certificate chains successfully verified against a trust store,
+ * shared by the workers. The trust store isn't part of the key, so a cache must not outlive the
+ * trust store it was filled from.
+ */
+class VerifiedChainCache {
+public:
+  VerifiedChainCache(size_t max_entries, std::chrono::milliseconds max_ttl,
+                     TimeSource& time_source);
+
+  /**
+   * @return the key of a certificate chain presented by a peer, which is the SHA-256 digest of
+   * the DER encoding of its certificates, and of whether the peer is a client.
+   */
+  static std::string key(STACK_OF(X509)& cert_chain, bool is_server);
+
+  /**
+   * @return whether the chain with the key was verified and its verification hasn't expired.
+   */
+  bool contains(const std::string& key);
+
+  /**
+   * Records the verification of a chain, until the earliest of the max TTL and expires_at.
+   * @param key the key of the chain presented by the peer.
+   * @param expires_at when the verification expires, e.g. the expiration of the first certificate
+   * of the verified chain to expire.
+   */
+  void insert(const std::string& key, SystemTime expires_at);
+
+  size_t size() const;
+
+private:
+  struct Entry {
+    SystemTime expires_at_;
+    // Position of the key in lru_.
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  const size_t max_entries_;
+  const std::chrono::milliseconds max_ttl_;
+  TimeSource& time_source_;
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  // Keys of entries_, most recently used first.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -21,6 +21,7 @@
 #include "source/common/common/base64.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/macros.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/protobuf/utility.h"
@@ -65,7 +66,9 @@ ClientContextImpl::ClientContextImpl(
       auto_host_sni_(config.autoHostServerNameIndication()),
       allow_renegotiation_(config.allowRenegotiation()),
       enforce_rsa_key_usage_(config.enforceRsaKeyUsage()),
-      max_session_keys_(config.maxSessionKeys()) {
+      max_session_keys_(config.maxSessionKeys()),
+      host_keyed_sessions_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.tls_host_keyed_session_cache")) {
   if (!creation_status.ok()) {
     return;
   }
@@ -100,7 +103,7 @@ ClientContextImpl::ClientContextImpl(
               static_cast<ContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
           ClientContextImpl* client_context_impl = dynamic_cast<ClientContextImpl*>(context_impl);
           RELEASE_ASSERT(client_context_impl != nullptr, ""); // for Coverity
-          return client_context_impl->newSessionKey(session);
+          return client_context_impl->newSessionKey(ssl, session);
         });
   }
 
@@ -179,26 +182,41 @@ ClientContextImpl::newSsl(const Network::TransportSocketOptionsConstSharedPtr& o
   SSL_set_enforce_rsa_key_usage(ssl_con.get(), enforce_rsa_key_usage_);
 
   if (max_session_keys_ > 0) {
+    std::string session_cache_key;
+    if (host_keyed_sessions_) {
+      session_cache_key = absl::StrCat(
+          host != nullptr && host->address() != nullptr ? host->address()->asStringView() : "",
+          "/", server_name_indication);
+      // Remember the key for newSessionKey(). BoringSSL frees it with the connection.
+      SSL_set_ex_data(ssl_con.get(), sessionCacheKeyIndex(), new std::string(session_cache_key));
+    }
     if (session_keys_single_use_) {
       // Stored single-use session keys, use write/write locks.
       absl::WriterMutexLock l(session_keys_mu_);
-      if (!session_keys_.empty()) {
+      auto it = session_keys_.find(session_cache_key);
+      if (it != session_keys_.end()) {
         // Use the most recently stored session key, since it has the highest
         // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
+        std::deque<bssl::UniquePtr<SSL_SESSION>>& keys = it->second.keys_;
+        SSL_SESSION* session = keys.front().get();
         SSL_set_session(ssl_con.get(), session);
         // Remove single-use session key (TLS 1.3) after first use.
         if (SSL_SESSION_should_be_single_use(session)) {
-          session_keys_.pop_front();
+          keys.pop_front();
+          if (keys.empty()) {
+            session_hosts_lru_.erase(it->second.lru_position_);
+            session_keys_.erase(it);
+          }
         }
       }
     } else {
       // Never stored single-use session keys, use read/write locks.
       absl::ReaderMutexLock l(session_keys_mu_);
-      if (!session_keys_.empty()) {
+      auto it = session_keys_.find(session_cache_key);
+      if (it != session_keys_.end()) {
         // Use the most recently stored session key, since it has the highest
         // probability of still being recognized/accepted by the server.
-        SSL_SESSION* session = session_keys_.front().get();
+        SSL_SESSION* session = it->second.keys_.front().get();
         SSL_set_session(ssl_con.get(), session);
       }
     }
@@ -207,19 +225,49 @@ ClientContextImpl::newSsl(const Network::TransportSocketOptionsConstSharedPtr& o
   return ssl_con;
 }
 
-int ClientContextImpl::newSessionKey(SSL_SESSION* session) {
+int ClientContextImpl::sessionCacheKeyIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, []() -> int {
+    int index = SSL_get_ex_new_index(
+        0, nullptr, nullptr, nullptr,
+        [](void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) { // NOLINT(google-runtime-int)
+          delete static_cast<std::string*>(ptr);
+        });
+    RELEASE_ASSERT(index >= 0, "");
+    return index;
+  }());
+}
+
+int ClientContextImpl::newSessionKey(SSL* ssl, SSL_SESSION* session) {
   // In case we ever store single-use session key (TLS 1.3),
   // we need to switch to using write/write locks.
   if (SSL_SESSION_should_be_single_use(session)) {
     session_keys_single_use_ = true;
   }
+  const auto* key = static_cast<const std::string*>(SSL_get_ex_data(ssl, sessionCacheKeyIndex()));
+  const std::string session_cache_key = key != nullptr ? *key : "";
+
   absl::WriterMutexLock l(session_keys_mu_);
+  auto [it, inserted] = session_keys_.try_emplace(session_cache_key);
+  if (inserted) {
+    session_hosts_lru_.push_front(session_cache_key);
+    if (session_hosts_lru_.size() > MaxSessionCacheHosts) {
+      // Evict the host that stored a session least recently.
+      session_keys_.erase(session_hosts_lru_.back());
+      session_hosts_lru_.pop_back();
+    }
+  } else {
+    session_hosts_lru_.splice(session_hosts_lru_.begin(), session_hosts_lru_,
+                              it->second.lru_position_);
+  }
+  it->second.lru_position_ = session_hosts_lru_.begin();
+
+  std::deque<bssl::UniquePtr<SSL_SESSION>>& keys = it->second.keys_;
   // Evict oldest entries.
-  while (session_keys_.size() >= max_session_keys_) {
-    session_keys_.pop_back();
+  while (keys.size() >= max_session_keys_) {
+    keys.pop_back();
   }
   // Add new session key at the front of the queue, so that it's used first.
-  session_keys_.push_front(bssl::UniquePtr<SSL_SESSION>(session));
+  keys.push_front(bssl::UniquePtr<SSL_SESSION>(session));
   return 1; // Tell BoringSSL that we took ownership of the session.
 }
 
@@ -5,6 +5,7 @@
 #include <array>
 #include <deque>
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "source/common/tls/context_manager_impl.h"
 #include "source/common/tls/stats.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "openssl/ssl.h"
 #include "openssl/x509v3.h"
@@ -54,6 +56,10 @@ public:
 
   int selectTlsContext(SSL*);
 
+  // The maximum number of upstream hosts whose sessions are cached, when sessions are cached per
+  // host. The sessions of the least recently connected host are evicted first.
+  static constexpr size_t MaxSessionCacheHosts = 1024;
+
 protected:
   ClientContextImpl(
       Stats::Scope& scope, const Envoy::Ssl::ClientContextConfig& config,
@@ -62,15 +68,32 @@ protected:
       absl::Status& creation_status);
 
 private:
-  int newSessionKey(SSL_SESSION* session);
+  // The session keys stored for one upstream host.
+  struct HostSessionKeys {
+    std::deque<bssl::UniquePtr<SSL_SESSION>> keys_;
+    // Position of the host in session_hosts_lru_.
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  // The ex_data index of the session cache key of an SSL connection.
+  static int sessionCacheKeyIndex();
+
+  int newSessionKey(SSL* ssl, SSL_SESSION* session);
 
   const std::string server_name_indication_;
   const bool auto_host_sni_;
   const bool allow_renegotiation_;
   const bool enforce_rsa_key_usage_;
   const size_t max_session_keys_;
+  // Whether sessions are cached per upstream host and SNI rather than for the whole context.
+  // Servers only resume sessions they issued, unless they share session ticket keys.
+  const bool host_keyed_sessions_;
   absl::Mutex session_keys_mu_;
-  std::deque<bssl::UniquePtr<SSL_SESSION>> session_keys_ ABSL_GUARDED_BY(session_keys_mu_);
+  // Keyed by the upstream host and SNI, or by the empty string if sessions are not keyed by host.
+  absl::flat_hash_map<std::string, HostSessionKeys>
+      session_keys_ ABSL_GUARDED_BY(session_keys_mu_);
+  // Keys of session_keys_, most recently stored first.
+  std::list<std::string> session_hosts_lru_ ABSL_GUARDED_BY(session_keys_mu_);
   bool session_keys_single_use_{false};
   Ssl::UpstreamTlsCertificateSelectorPtr tls_certificate_selector_;
 };
@@ -61,6 +61,8 @@ public:
   const Network::Address::IpList& tlsKeyLogLocal() const override { return *tls_keylog_local_; };
   const Network::Address::IpList& tlsKeyLogRemote() const override { return *tls_keylog_remote_; };
   const std::string& tlsKeyLogPath() const override { return tls_keylog_path_; };
+  bool kernelTlsTx() const override { return kernel_tls_tx_; }
+  bool kernelTlsRx() const override { return kernel_tls_rx_; }
   AccessLog::AccessLogManager& accessLogManager() const override {
     return factory_context_.serverFactoryContext().accessLogManager();
   }
@@ -133,6 +135,8 @@ private:
   const std::string tls_keylog_path_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_local_;
   std::unique_ptr<Network::Address::IpList> tls_keylog_remote_;
+  const bool kernel_tls_tx_;
+  const bool kernel_tls_rx_;
   const absl::optional<
       envoy::extensions::transport_sockets::tls::v3::TlsParameters::CompliancePolicy>
       compliance_policy_;
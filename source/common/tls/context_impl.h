@@ -94,6 +94,13 @@ public:
 
   SslStats& stats() { return stats_; }
 
+  /**
+   * @return whether the encryption, or decryption, of the TLS records of the connections is
+   * offloaded to the kernel once their handshake is complete.
+   */
+  bool kernelTlsTx() const { return kernel_tls_tx_; }
+  bool kernelTlsRx() const { return kernel_tls_rx_; }
+
   /**
    * The global SSL-library index used for storing a pointer to the SslExtendedSocketInfo
    * class in the SSL instance, for retrieval in callbacks.
@@ -176,6 +183,8 @@ protected:
   const Network::Address::IpList tls_keylog_local_;
   const Network::Address::IpList tls_keylog_remote_;
   AccessLog::AccessLogFileSharedPtr tls_keylog_file_;
+  const bool kernel_tls_tx_;
+  const bool kernel_tls_rx_;
 };
 
 using ContextImplSharedPtr = std::shared_ptr<ContextImpl>;
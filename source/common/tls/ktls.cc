@@ -0,0 +1,289 @@
+#include "source/common/tls/ktls.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "envoy/common/exception.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "openssl/hkdf.h"
+#include "openssl/nid.h"
+
+#if defined(__linux__)
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+
+#define ENVOY_KTLS_SUPPORTED
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace Ktls {
+
+namespace {
+constexpr uint8_t HandshakeTypeNewSessionTicket = 4;
+} // namespace
+
+#ifdef ENVOY_KTLS_SUPPORTED
+namespace {
+
+// The largest plaintext of a TLS record.
+constexpr size_t MaxRecordSize = 16384;
+
+// The keys of a direction of a connection.
+struct KeyMaterial {
+  std::vector<uint8_t> key_;
+  // The fixed part of the AEAD nonce.
+  std::vector<uint8_t> fixed_iv_;
+};
+
+void storeSequence(uint8_t* out, uint64_t sequence) {
+  for (int i = 7; i >= 0; i--) {
+    out[i] = sequence & 0xff;
+    sequence >>= 8;
+  }
+}
+
+// HKDF-Expand-Label of https://www.rfc-editor.org/rfc/rfc8446#section-7.1, with an empty context.
+absl::Status hkdfExpandLabel(const EVP_MD* digest, bssl::Span<const uint8_t> secret,
+                             absl::string_view label, size_t length, std::vector<uint8_t>& out) {
+  const std::string full_label = absl::StrCat("tls13 ", label);
+  std::vector<uint8_t> info;
+  info.reserve(4 + full_label.size());
+  info.push_back(length >> 8);
+  info.push_back(length & 0xff);
+  info.push_back(full_label.size());
+  info.insert(info.end(), full_label.begin(), full_label.end());
+  info.push_back(0);
+  out.resize(length);
+  if (!HKDF_expand(out.data(), out.size(), digest, secret.data(), secret.size(), info.data(),
+                   info.size())) {
+    return absl::InternalError("failed to derive the traffic keys");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status tls13KeyMaterial(SSL* ssl, const SSL_CIPHER* cipher, Direction direction,
+                              size_t key_length, KeyMaterial& material) {
+  bssl::Span<const uint8_t> read_secret;
+  bssl::Span<const uint8_t> write_secret;
+  if (!bssl::SSL_get_traffic_secrets(ssl, &read_secret, &write_secret)) {
+    return absl::InternalError("failed to get the traffic secrets");
+  }
+  const bssl::Span<const uint8_t> secret = direction == Direction::Tx ? write_secret : read_secret;
+  const EVP_MD* digest = SSL_CIPHER_get_handshake_digest(cipher);
+  RETURN_IF_NOT_OK(hkdfExpandLabel(digest, secret, "key", key_length, material.key_));
+  // TLS 1.3 AEAD nonces are 12 bytes.
+  return hkdfExpandLabel(digest, secret, "iv", 12, material.fixed_iv_);
+}
+
+absl::Status tls12KeyMaterial(SSL* ssl, Direction direction, size_t key_length,
+                              KeyMaterial& material) {
+  // The key block of AEAD cipher suites is the client and server write keys, followed by the
+  // client and server fixed IVs.
+  std::vector<uint8_t> key_block(SSL_get_key_block_len(ssl));
+  if (key_block.size() < 2 * key_length ||
+      !SSL_generate_key_block(ssl, key_block.data(), key_block.size())) {
+    return absl::InternalError("failed to generate the key block");
+  }
+  const size_t iv_length = key_block.size() / 2 - key_length;
+  const bool client_write = (SSL_is_server(ssl) == 0) == (direction == Direction::Tx);
+  const uint8_t* key = key_block.data() + (client_write ? 0 : key_length);
+  const uint8_t* iv = key_block.data() + 2 * key_length + (client_write ? 0 : iv_length);
+  material.key_.assign(key, key + key_length);
+  material.fixed_iv_.assign(iv, iv + iv_length);
+  return absl::OkStatus();
+}
+
+template <class CryptoInfo>
+absl::Status setCryptoInfo(Network::IoHandle& io_handle, Direction direction, uint16_t version,
+                           uint16_t cipher_type, const KeyMaterial& material, uint64_t sequence) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = version;
+  info.info.cipher_type = cipher_type;
+  ASSERT(material.key_.size() == sizeof(info.key));
+  memcpy(info.key, material.key_.data(), sizeof(info.key));
+  if (material.fixed_iv_.size() == sizeof(info.salt)) {
+    // TLS 1.2 AES-GCM: the nonce is the fixed IV followed by an explicit part, which is the
+    // sequence number of the record.
+    memcpy(info.salt, material.fixed_iv_.data(), sizeof(info.salt));
+    storeSequence(info.iv, sequence);
+  } else {
+    // The nonce is the fixed IV, split in a salt and an IV, xored with the sequence number.
+    if (material.fixed_iv_.size() != sizeof(info.salt) + sizeof(info.iv)) {
+      return absl::InvalidArgumentError("unexpected IV length");
+    }
+    memcpy(info.salt, material.fixed_iv_.data(), sizeof(info.salt));
+    memcpy(info.iv, material.fixed_iv_.data() + sizeof(info.salt), sizeof(info.iv));
+  }
+  storeSequence(info.rec_seq, sequence);
+
+  const Api::SysCallIntResult result = io_handle.setOption(
+      SOL_TLS, direction == Direction::Tx ? TLS_TX : TLS_RX, &info, sizeof(info));
+  if (result.return_value_ != 0) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("failed to install the traffic keys: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+} // namespace
+
+absl::Status installKeys(SSL* ssl, Network::IoHandle& io_handle, Direction direction) {
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  const uint16_t version = SSL_version(ssl);
+  if (cipher == nullptr || (version != TLS1_2_VERSION && version != TLS1_3_VERSION)) {
+    return absl::InvalidArgumentError("unsupported protocol version");
+  }
+  const int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_length;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    key_length = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+    break;
+  case NID_aes_256_gcm:
+    key_length = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+    break;
+  case NID_chacha20_poly1305:
+    key_length = TLS_CIPHER_CHACHA20_POLY1305_KEY_SIZE;
+    break;
+  default:
+    return absl::InvalidArgumentError(
+        absl::StrCat("unsupported cipher suite ", SSL_CIPHER_get_name(cipher)));
+  }
+
+  KeyMaterial material;
+  RETURN_IF_NOT_OK(version == TLS1_3_VERSION
+                       ? tls13KeyMaterial(ssl, cipher, direction, key_length, material)
+                       : tls12KeyMaterial(ssl, direction, key_length, material));
+  const uint64_t sequence =
+      direction == Direction::Tx ? SSL_get_write_sequence(ssl) : SSL_get_read_sequence(ssl);
+
+  // The upper layer protocol is already enabled if the other direction is offloaded.
+  const Api::SysCallIntResult result =
+      io_handle.setOption(IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls"));
+  if (result.return_value_ != 0 && result.errno_ != EEXIST) {
+    return absl::FailedPreconditionError(absl::StrCat(
+        "failed to enable the TLS upper layer protocol: ", errorDetails(result.errno_)));
+  }
+
+  const uint16_t kernel_version = version == TLS1_3_VERSION ? TLS_1_3_VERSION : TLS_1_2_VERSION;
+  switch (cipher_nid) {
+  case NID_aes_128_gcm:
+    return setCryptoInfo<tls12_crypto_info_aes_gcm_128>(
+        io_handle, direction, kernel_version, TLS_CIPHER_AES_GCM_128, material, sequence);
+  case NID_aes_256_gcm:
+    return setCryptoInfo<tls12_crypto_info_aes_gcm_256>(
+        io_handle, direction, kernel_version, TLS_CIPHER_AES_GCM_256, material, sequence);
+  default:
+    return setCryptoInfo<tls12_crypto_info_chacha20_poly1305>(
+        io_handle, direction, kernel_version, TLS_CIPHER_CHACHA20_POLY1305, material, sequence);
+  }
+}
+
+absl::StatusOr<ControlRecord> readControlRecord(Network::IoHandle& io_handle) {
+  ControlRecord record;
+  record.data_.resize(MaxRecordSize);
+  std::array<char, CMSG_SPACE(sizeof(uint8_t))> control{};
+  iovec iov{record.data_.data(), record.data_.size()};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().recvmsg(io_handle.fdDoNotUse(), &message, 0);
+  if (result.return_value_ < 0) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("failed to read the record: ", errorDetails(result.errno_)));
+  }
+  const cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  if (cmsg == nullptr || cmsg->cmsg_level != SOL_TLS || cmsg->cmsg_type != TLS_GET_RECORD_TYPE) {
+    return absl::FailedPreconditionError("failed to read the record type");
+  }
+  record.type_ = *CMSG_DATA(cmsg);
+  record.data_.resize(result.return_value_);
+  return record;
+}
+
+absl::Status sendAlert(Network::IoHandle& io_handle, uint8_t level, uint8_t description) {
+  std::array<uint8_t, 2> alert{level, description};
+  std::array<char, CMSG_SPACE(sizeof(uint8_t))> control{};
+  iovec iov{alert.data(), alert.size()};
+  msghdr message{};
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control.data();
+  message.msg_controllen = control.size();
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint8_t));
+  *CMSG_DATA(cmsg) = RecordTypeAlert;
+  const Api::SysCallSizeResult result =
+      Api::OsSysCallsSingleton::get().sendmsg(io_handle.fdDoNotUse(), &message, 0);
+  if (result.return_value_ != static_cast<ssize_t>(alert.size())) {
+    return absl::FailedPreconditionError(
+        absl::StrCat("failed to send the alert: ", errorDetails(result.errno_)));
+  }
+  return absl::OkStatus();
+}
+
+#else
+
+absl::Status installKeys(SSL*, Network::IoHandle&, Direction) {
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+}
+
+absl::StatusOr<ControlRecord> readControlRecord(Network::IoHandle&) {
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+}
+
+absl::Status sendAlert(Network::IoHandle&, uint8_t, uint8_t) {
+  return absl::UnimplementedError("kernel TLS is only supported on Linux");
+}
+
+#endif
+
+bool onlySessionTickets(absl::string_view handshake_messages) {
+  // Each handshake message is its type, followed by its 24 bit length and its body.
+  if (handshake_messages.empty()) {
+    return false;
+  }
+  while (!handshake_messages.empty()) {
+    if (handshake_messages.size() < 4 ||
+        static_cast<uint8_t>(handshake_messages[0]) != HandshakeTypeNewSessionTicket) {
+      return false;
+    }
+    const size_t length = (static_cast<uint8_t>(handshake_messages[1]) << 16) |
+                          (static_cast<uint8_t>(handshake_messages[2]) << 8) |
+                          static_cast<uint8_t>(handshake_messages[3]);
+    if (handshake_messages.size() - 4 < length) {
+      return false;
+    }
+    handshake_messages.remove_prefix(4 + length);
+  }
+  return true;
+}
+
+} // namespace Ktls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "envoy/network/io_handle.h"
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace Ktls {
+
+/**
+ * Helpers offloading the record layer of TLS connections to the Linux kernel TLS upper layer
+ * protocol once their handshake is complete. Once a direction is offloaded, the socket reads or
+ * writes the plaintext of the application data records of that direction, and the TLS library
+ * must not read or write records of that direction anymore.
+ */
+
+enum class Direction { Tx, Rx };
+
+// The content types of the TLS records other than application data.
+constexpr uint8_t RecordTypeAlert = 21;
+constexpr uint8_t RecordTypeHandshake = 22;
+
+/**
+ * Installs the current traffic keys and sequence number of a direction of a connection whose
+ * handshake is complete in the kernel, enabling the TLS upper layer protocol of the socket first
+ * if needed.
+ * @param ssl the connection.
+ * @param io_handle the socket of the connection.
+ * @param direction the direction to offload.
+ * @return an error if the platform, the kernel, the protocol version or the cipher suite doesn't
+ * support offloading, in which case the TLS library keeps handling the direction.
+ */
+absl::Status installKeys(SSL* ssl, Network::IoHandle& io_handle, Direction direction);
+
+/**
+ * A TLS record other than application data.
+ */
+struct ControlRecord {
+  uint8_t type_{};
+  std::string data_;
+};
+
+/**
+ * Reads the record other than application data at the head of a socket with offloaded decryption,
+ * which reads of plaintext fail with EIO on.
+ */
+absl::StatusOr<ControlRecord> readControlRecord(Network::IoHandle& io_handle);
+
+/**
+ * Writes an alert record to a socket with offloaded encryption.
+ */
+absl::Status sendAlert(Network::IoHandle& io_handle, uint8_t level, uint8_t description);
+
+/**
+ * @return whether the handshake messages of a record are only TLS 1.3 NewSessionTicket messages,
+ * which a client can ignore at the cost of not resuming the session.
+ */
+bool onlySessionTickets(absl::string_view handshake_messages);
+
+} // namespace Ktls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
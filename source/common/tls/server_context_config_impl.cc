@@ -147,6 +147,8 @@ ServerContextConfigImpl::ServerContextConfigImpl(
       auto keys_or_error = getSessionTicketKeys(*session_ticket_keys_provider_->secret());
       SET_AND_RETURN_IF_NOT_OK(keys_or_error.status(), creation_status);
       session_ticket_keys_ = *keys_or_error;
+      session_ticket_key_rotation_ =
+          getSessionTicketKeyRotation(*session_ticket_keys_provider_->secret());
     }
   }
 
@@ -218,6 +220,8 @@ void ServerContextConfigImpl::setSecretUpdateCallback(std::function<absl::Status
           auto keys_or_error = getSessionTicketKeys(*session_ticket_keys_provider_->secret());
           RETURN_IF_NOT_OK(keys_or_error.status());
           session_ticket_keys_ = *keys_or_error;
+          session_ticket_key_rotation_ =
+              getSessionTicketKeyRotation(*session_ticket_keys_provider_->secret());
           return callback_with_notify();
         });
   }
@@ -237,6 +241,18 @@ ServerContextConfigImpl::getSessionTicketKeys(
   return result;
 }
 
+absl::optional<Ssl::ServerContextConfig::SessionTicketKeyRotation>
+ServerContextConfigImpl::getSessionTicketKeyRotation(
+    const envoy::extensions::transport_sockets::tls::v3::TlsSessionTicketKeys& keys) {
+  if (!keys.has_rotation()) {
+    return absl::nullopt;
+  }
+  return SessionTicketKeyRotation{
+      SystemTime(std::chrono::milliseconds(
+          Protobuf::util::TimeUtil::TimestampToMilliseconds(keys.rotation().start_time()))),
+      std::chrono::milliseconds(DurationUtil::durationToMilliseconds(keys.rotation().interval()))};
+}
+
 // Extracts a SessionTicketKey from raw binary data.
 // Throws if key_data is invalid.
 absl::StatusOr<Ssl::ServerContextConfig::SessionTicketKey>
@@ -23,6 +23,9 @@ public:
   const std::vector<SessionTicketKey>& sessionTicketKeys() const override {
     return session_ticket_keys_;
   }
+  const absl::optional<SessionTicketKeyRotation>& sessionTicketKeyRotation() const override {
+    return session_ticket_key_rotation_;
+  }
   absl::optional<std::chrono::seconds> sessionTimeout() const override { return session_timeout_; }
 
   bool isReady() const override {
@@ -63,6 +66,7 @@ private:
   const bool require_client_certificate_;
   const OcspStaplePolicy ocsp_staple_policy_;
   std::vector<SessionTicketKey> session_ticket_keys_;
+  absl::optional<SessionTicketKeyRotation> session_ticket_key_rotation_;
   const Secret::TlsSessionTicketKeysConfigProviderSharedPtr session_ticket_keys_provider_;
   Envoy::Common::CallbackHandlePtr stk_update_callback_handle_;
   Envoy::Common::CallbackHandlePtr stk_validation_callback_handle_;
@@ -71,6 +75,8 @@ private:
       const envoy::extensions::transport_sockets::tls::v3::TlsSessionTicketKeys& keys);
   absl::StatusOr<ServerContextConfig::SessionTicketKey>
   getSessionTicketKey(const std::string& key_data);
+  static absl::optional<SessionTicketKeyRotation> getSessionTicketKeyRotation(
+      const envoy::extensions::transport_sockets::tls::v3::TlsSessionTicketKeys& keys);
   static OcspStaplePolicy ocspStaplePolicyFromProto(
       const envoy::extensions::transport_sockets::tls::v3::DownstreamTlsContext::OcspStaplePolicy&
           policy);
@@ -32,6 +32,7 @@
 
 #include "absl/container/node_hash_set.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "cert_validator/cert_validator.h"
 #include "openssl/evp.h"
@@ -102,10 +103,19 @@ ServerContextImpl::ServerContextImpl(
     : ContextImpl(scope, config, tls_certificates, factory_context, additional_init,
                   creation_status),
       session_ticket_keys_(config.sessionTicketKeys()),
-      ocsp_staple_policy_(config.ocspStaplePolicy()) {
+      session_ticket_key_rotation_(config.sessionTicketKeyRotation()),
+      time_source_(factory_context.timeSource()), ocsp_staple_policy_(config.ocspStaplePolicy()) {
   if (!creation_status.ok()) {
     return;
   }
+  session_ticket_key_stats_.reserve(session_ticket_keys_.size());
+  for (const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key : session_ticket_keys_) {
+    const std::string prefix =
+        absl::StrCat("ssl.session_ticket_keys.", Hex::encode(key.name_.data(), key.name_.size()));
+    session_ticket_key_stats_.push_back(
+        {scope.counterFromString(absl::StrCat(prefix, ".encrypted")),
+         scope.counterFromString(absl::StrCat(prefix, ".decrypted"))});
+  }
   // If creation failed, do not create the selector.
   if (add_selector) {
     tls_certificate_selector_ = config.tlsCertificateSelectorFactory().create(*this);
@@ -346,7 +356,8 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
     // or if we allow it to be emptied, reconfigure the context so this callback
     // isn't set.
 
-    const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = session_ticket_keys_.front();
+    const size_t key_index = sessionTicketEncryptionKeyIndex();
+    const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = session_ticket_keys_[key_index];
 
     static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
                   "Expected key.name length");
@@ -366,11 +377,12 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
       return -1;
     }
 
+    session_ticket_key_stats_[key_index].encrypted_.inc();
     return 1; // success
   } else {
     // Decrypt
-    bool is_enc_key = true; // first element is the encryption key
-    for (const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key : session_ticket_keys_) {
+    for (size_t i = 0; i < session_ticket_keys_.size(); i++) {
+      const Envoy::Ssl::ServerContextConfig::SessionTicketKey& key = session_ticket_keys_[i];
       static_assert(std::tuple_size<decltype(key.name_)>::value == SSL_TICKET_KEY_NAME_LEN,
                     "Expected key.name length");
       if (std::equal(key.name_.begin(), key.name_.end(), key_name)) {
@@ -383,17 +395,32 @@ int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv
           return -1;
         }
 
+        session_ticket_key_stats_[i].decrypted_.inc();
         // If our current encryption was not the decryption key, renew
-        return is_enc_key ? 1  // success; do not renew
-                          : 2; // success: renew key
+        return i == sessionTicketEncryptionKeyIndex() ? 1  // success; do not renew
+                                                      : 2; // success: renew key
       }
-      is_enc_key = false;
     }
 
+    stats().session_ticket_key_not_found_.inc();
     return 0; // decryption failed
   }
 }
 
+size_t ServerContextImpl::sessionTicketEncryptionKeyIndex() const {
+  if (!session_ticket_key_rotation_.has_value()) {
+    // The first key is the encryption key.
+    return 0;
+  }
+  const SystemTime now = time_source_.systemTime();
+  if (now < session_ticket_key_rotation_->start_time_) {
+    return 0;
+  }
+  const uint64_t index =
+      (now - session_ticket_key_rotation_->start_time_) / session_ticket_key_rotation_->interval_;
+  return std::min<uint64_t>(index, session_ticket_keys_.size() - 1);
+}
+
 // Returns a list of client capabilities for ECDSA curves as NIDs. An empty vector indicates
 // a client that is unable to handle ECDSA.
 Ssl::CurveNIDVector
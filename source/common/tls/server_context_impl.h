@@ -84,12 +84,23 @@ private:
                          unsigned int inlen);
   int sessionTicketProcess(SSL* ssl, uint8_t* key_name, uint8_t* iv, EVP_CIPHER_CTX* ctx,
                            HMAC_CTX* hmac_ctx, int encrypt);
+  // Returns the index of the session ticket key encrypting new tickets.
+  size_t sessionTicketEncryptionKeyIndex() const;
 
   absl::StatusOr<SessionContextID>
   generateHashForSessionContextId(const std::vector<std::string>& server_names);
 
   Ssl::TlsCertificateSelectorPtr tls_certificate_selector_;
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  const absl::optional<Envoy::Ssl::ServerContextConfig::SessionTicketKeyRotation>
+      session_ticket_key_rotation_;
+  // The number of tickets encrypted and decrypted with each session ticket key, by key name.
+  struct SessionTicketKeyStats {
+    Stats::Counter& encrypted_;
+    Stats::Counter& decrypted_;
+  };
+  std::vector<SessionTicketKeyStats> session_ticket_key_stats_;
+  TimeSource& time_source_;
 
 protected:
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
@@ -7,6 +7,7 @@
 #include "source/common/common/hex.h"
 #include "source/common/http/headers.h"
 #include "source/common/tls/io_handle_bio.h"
+#include "source/common/tls/ktls.h"
 #include "source/common/tls/ssl_handshaker.h"
 #include "source/common/tls/utility.h"
 
@@ -117,8 +118,13 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
     }
   }
 
+  if (ktls_rx_) {
+    return doKernelTlsRead(read_buffer);
+  }
+
   bool keep_reading = true;
   bool end_stream = false;
+  bool want_read = false;
   PostIoAction action = PostIoAction::KeepOpen;
   uint64_t bytes_read = 0;
   while (keep_reading) {
@@ -134,6 +140,7 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
                        Utility::getErrorDescription(err));
         switch (err) {
         case SSL_ERROR_WANT_READ:
+          want_read = true;
           break;
         case SSL_ERROR_ZERO_RETURN:
           // Graceful shutdown using close_notify TLS alert.
@@ -169,9 +176,88 @@ Network::IoResult SslSocket::doRead(Buffer::Instance& read_buffer) {
 
   ENVOY_CONN_LOG(trace, "ssl read {} bytes", callbacks_->connection(), bytes_read);
 
+  if (ktls_rx_pending_ && want_read) {
+    offloadKernelTlsRx();
+  }
+
   return {action, bytes_read, end_stream};
 }
 
+Network::IoResult SslSocket::doKernelTlsRead(Buffer::Instance& read_buffer) {
+  PostIoAction action = PostIoAction::KeepOpen;
+  uint64_t bytes_read = 0;
+  bool end_stream = false;
+  while (true) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().read(read_buffer, absl::nullopt);
+    if (result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls read returns: {}", callbacks_->connection(),
+                     result.return_value_);
+      if (result.return_value_ == 0) {
+        // Non-graceful shutdown by closing the underlying socket.
+        end_stream = true;
+        break;
+      }
+      bytes_read += result.return_value_;
+      if (callbacks_->shouldDrainReadBuffer()) {
+        callbacks_->setTransportSocketIsReadable();
+        break;
+      }
+    } else if (result.err_->getSystemErrorCode() == EIO) {
+      // The next record isn't application data.
+      if (!onKernelTlsControlRecord(end_stream)) {
+        action = PostIoAction::Close;
+        break;
+      }
+      if (end_stream) {
+        break;
+      }
+    } else {
+      ENVOY_CONN_LOG(trace, "ktls read error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+        action = PostIoAction::Close;
+      }
+      break;
+    }
+  }
+
+  ENVOY_CONN_LOG(trace, "ktls read {} bytes", callbacks_->connection(), bytes_read);
+
+  return {action, bytes_read, end_stream};
+}
+
+bool SslSocket::onKernelTlsControlRecord(bool& end_stream) {
+  absl::StatusOr<Ktls::ControlRecord> record = Ktls::readControlRecord(callbacks_->ioHandle());
+  std::string error;
+  if (!record.ok()) {
+    error = record.status().message();
+  } else if (record->type_ == Ktls::RecordTypeAlert) {
+    if (record->data_.size() == 2 && record->data_[1] == SSL_AD_CLOSE_NOTIFY) {
+      // Graceful shutdown using close_notify TLS alert.
+      end_stream = true;
+      return true;
+    }
+    error = absl::StrCat(
+        "received alert ",
+        record->data_.size() == 2 ? SSL_alert_desc_string_long(record->data_[1]) : "unknown");
+  } else if (record->type_ == Ktls::RecordTypeHandshake &&
+             SSL_version(rawSsl()) == TLS1_3_VERSION && Ktls::onlySessionTickets(record->data_)) {
+    // The TLS library can't process the tickets anymore, so the session won't be resumed.
+    ENVOY_CONN_LOG(debug, "ignoring session tickets received after kernel TLS offload",
+                   callbacks_->connection());
+    return true;
+  } else {
+    error = absl::StrCat("unsupported record of type ", record->type_);
+  }
+
+  failure_reason_ = absl::StrCat("TLS_error:|kernel TLS:", error, ":TLS_error_end");
+  ENVOY_CONN_LOG(debug, "remote address:{},{}", callbacks_->connection(),
+                 callbacks_->connection().connectionInfoProvider().remoteAddress()->asString(),
+                 failure_reason_);
+  ctx_->stats().connection_error_.inc();
+  return false;
+}
+
 void SslSocket::onPrivateKeyMethodComplete() { resumeHandshake(); }
 
 void SslSocket::resumeHandshake() {
@@ -191,6 +277,10 @@ Network::Connection& SslSocket::connection() const { return callbacks_->connecti
 
 void SslSocket::onSuccess(SSL* ssl) {
   ctx_->logHandshake(ssl);
+  if (ctx_->kernelTlsTx()) {
+    offloadKernelTlsTx();
+  }
+  ktls_rx_pending_ = ctx_->kernelTlsRx();
   if (callbacks_->connection().streamInfo().upstreamInfo()) {
     callbacks_->connection()
         .streamInfo()
@@ -206,6 +296,41 @@ void SslSocket::onSuccess(SSL* ssl) {
 
 void SslSocket::onFailure() { drainErrorQueue(); }
 
+void SslSocket::offloadKernelTlsTx() {
+  const absl::Status status =
+      Ktls::installKeys(rawSsl(), callbacks_->ioHandle(), Ktls::Direction::Tx);
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS tx offload failed: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().ktls_offload_failed_.inc();
+    return;
+  }
+  // The kernel now encrypts everything written to the socket. Make the TLS library fail to write
+  // any record, such as a response to a key update, rather than corrupt the connection.
+  SSL_set0_wbio(rawSsl(), BIO_new_mem_buf(nullptr, 0));
+  ktls_tx_ = true;
+  ctx_->stats().ktls_tx_offloaded_.inc();
+}
+
+void SslSocket::offloadKernelTlsRx() {
+  // The kernel must decrypt from a record boundary, without any record read by the TLS library
+  // left unprocessed.
+  if (SSL_has_pending(rawSsl())) {
+    return;
+  }
+  ktls_rx_pending_ = false;
+  const absl::Status status =
+      Ktls::installKeys(rawSsl(), callbacks_->ioHandle(), Ktls::Direction::Rx);
+  if (!status.ok()) {
+    ENVOY_CONN_LOG(debug, "kernel TLS rx offload failed: {}", callbacks_->connection(),
+                   status.message());
+    ctx_->stats().ktls_offload_failed_.inc();
+    return;
+  }
+  ktls_rx_ = true;
+  ctx_->stats().ktls_rx_offloaded_.inc();
+}
+
 PostIoAction SslSocket::doHandshake() { return info_->doHandshake(); }
 
 void SslSocket::drainErrorQueue() {
@@ -284,6 +409,10 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
     }
   }
 
+  if (ktls_tx_) {
+    return doKernelTlsWrite(write_buffer, end_stream);
+  }
+
   uint64_t bytes_to_write;
   if (bytes_to_retry_) {
     bytes_to_write = bytes_to_retry_;
@@ -334,6 +463,31 @@ Network::IoResult SslSocket::doWrite(Buffer::Instance& write_buffer, bool end_st
   return {PostIoAction::KeepOpen, total_bytes_written, false};
 }
 
+Network::IoResult SslSocket::doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream) {
+  // The kernel frames and encrypts the records, so the slices are written without linearizing.
+  uint64_t total_bytes_written = 0;
+  while (write_buffer.length() > 0) {
+    Api::IoCallUint64Result result = callbacks_->ioHandle().write(write_buffer);
+    if (!result.ok()) {
+      ENVOY_CONN_LOG(trace, "ktls write error: {}", callbacks_->connection(),
+                     result.err_->getErrorDetails());
+      if (result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again) {
+        return {PostIoAction::KeepOpen, total_bytes_written, false};
+      }
+      return {PostIoAction::Close, total_bytes_written, false};
+    }
+    ENVOY_CONN_LOG(trace, "ktls write returns: {}", callbacks_->connection(),
+                   result.return_value_);
+    total_bytes_written += result.return_value_;
+  }
+
+  if (end_stream) {
+    shutdownSsl();
+  }
+
+  return {PostIoAction::KeepOpen, total_bytes_written, false};
+}
+
 void SslSocket::onConnected() { ASSERT(info_->state() == Ssl::SocketState::PreHandshake); }
 
 Ssl::ConnectionInfoConstSharedPtr SslSocket::ssl() const { return info_; }
@@ -342,6 +496,14 @@ void SslSocket::shutdownSsl() {
   ASSERT(info_->state() != Ssl::SocketState::PreHandshake);
   if (info_->state() != Ssl::SocketState::ShutdownSent &&
       callbacks_->connection().state() != Network::Connection::State::Closed) {
+    if (ktls_tx_) {
+      // The TLS library can't write the close_notify alert anymore.
+      const absl::Status status =
+          Ktls::sendAlert(callbacks_->ioHandle(), SSL3_AL_WARNING, SSL_AD_CLOSE_NOTIFY);
+      ENVOY_CONN_LOG(debug, "SSL shutdown: {}", callbacks_->connection(), status.message());
+      info_->setState(Ssl::SocketState::ShutdownSent);
+      return;
+    }
     int rc = SSL_shutdown(rawSsl());
     if constexpr (Event::PlatformDefaultTriggerType == Event::FileTriggerType::EmulatedEdge) {
       // Windows operate under `EmulatedEdge`. These are level events that are artificially
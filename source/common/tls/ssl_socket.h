@@ -94,6 +94,11 @@ private:
   ReadResult sslReadIntoSlice(Buffer::RawSlice& slice);
 
   Network::PostIoAction doHandshake();
+  void offloadKernelTlsTx();
+  void offloadKernelTlsRx();
+  Network::IoResult doKernelTlsRead(Buffer::Instance& read_buffer);
+  Network::IoResult doKernelTlsWrite(Buffer::Instance& write_buffer, bool end_stream);
+  bool onKernelTlsControlRecord(bool& end_stream);
   void drainErrorQueue();
   void shutdownSsl();
   void shutdownBasic();
@@ -104,6 +109,11 @@ private:
   ContextImplSharedPtr ctx_;
   uint64_t bytes_to_retry_{};
   std::string failure_reason_;
+  // Whether the encryption, or decryption, of the records is offloaded to the kernel.
+  bool ktls_tx_{};
+  bool ktls_rx_{};
+  // Whether the decryption is to be offloaded at the next record boundary.
+  bool ktls_rx_pending_{};
 
   SslHandshakerImplSharedPtr info_;
 };
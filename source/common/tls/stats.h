@@ -12,16 +12,22 @@ namespace Tls {
   COUNTER(connection_error)                                                                        \
   COUNTER(handshake)                                                                               \
   COUNTER(session_reused)                                                                          \
+  COUNTER(session_ticket_key_not_found)                                                            \
   COUNTER(no_certificate)                                                                          \
   COUNTER(fail_verify_no_cert)                                                                     \
   COUNTER(fail_verify_error)                                                                       \
   COUNTER(fail_verify_san)                                                                         \
   COUNTER(fail_verify_cert_hash)                                                                   \
+  COUNTER(verified_chain_cache_hit)                                                                \
+  COUNTER(verified_chain_cache_miss)                                                               \
   COUNTER(ocsp_staple_failed)                                                                      \
   COUNTER(ocsp_staple_omitted)                                                                     \
   COUNTER(ocsp_staple_responses)                                                                   \
   COUNTER(ocsp_staple_requests)                                                                    \
-  COUNTER(was_key_usage_invalid)
+  COUNTER(was_key_usage_invalid)                                                                   \
+  COUNTER(ktls_tx_offloaded)                                                                       \
+  COUNTER(ktls_rx_offloaded)                                                                       \
+  COUNTER(ktls_offload_failed)
 
 /**
  * Wrapper struct for SSL stats. @see stats_macros.h
@@ -1,6 +1,8 @@
 #include "source/common/tls/utility.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <thread>
 #include <vector>
 
 #include "source/common/common/assert.h"
@@ -21,6 +23,22 @@ static constexpr int MAX_OID_LENGTH = 256;
 
 static constexpr absl::string_view SSL_ERROR_UNKNOWN_ERROR_MESSAGE = "UNKNOWN_ERROR";
 
+// The PEM bundles from this size are read on several threads.
+static constexpr size_t MIN_PARALLEL_PEM_READ_SIZE = 1024 * 1024;
+static constexpr size_t MAX_PEM_READ_THREADS = 8;
+static constexpr absl::string_view PEM_BLOCK_BEGIN = "-----BEGIN ";
+
+namespace {
+
+bssl::UniquePtr<STACK_OF(X509_INFO)> readPemX509InfosOnThisThread(absl::string_view pem) {
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(pem.data(), pem.size()));
+  RELEASE_ASSERT(bio != nullptr, "");
+  return bssl::UniquePtr<STACK_OF(X509_INFO)>(
+      PEM_X509_INFO_read_bio(bio.get(), nullptr, nullptr, nullptr));
+}
+
+} // namespace
+
 Envoy::Ssl::CertificateDetailsPtr Utility::certificateDetails(X509* cert, const std::string& path,
                                                               TimeSource& time_source) {
   Envoy::Ssl::CertificateDetailsPtr certificate_details =
@@ -522,6 +540,58 @@ absl::optional<std::string> Utility::getLastCryptoError() {
   return absl::nullopt;
 }
 
+bssl::UniquePtr<STACK_OF(X509_INFO)>
+Utility::readPemX509Infos(absl::string_view pem, Thread::ThreadFactory& thread_factory) {
+  const size_t threads =
+      std::min<size_t>({MAX_PEM_READ_THREADS, std::thread::hardware_concurrency(),
+                        pem.size() / (MIN_PARALLEL_PEM_READ_SIZE / 2)});
+  if (threads <= 1) {
+    return readPemX509InfosOnThisThread(pem);
+  }
+
+  // Each part but the last ends right before the beginning of a PEM block, so that no block is
+  // split. The items of a key following a certificate are read apart from it at the boundaries,
+  // but only the certificates and the CRLs of the bundles are used.
+  std::vector<absl::string_view> parts;
+  size_t start = 0;
+  while (start < pem.size()) {
+    size_t end = parts.size() + 1 == threads
+                     ? absl::string_view::npos
+                     : pem.find(PEM_BLOCK_BEGIN, start + pem.size() / threads);
+    if (end == absl::string_view::npos) {
+      end = pem.size();
+    }
+    parts.push_back(pem.substr(start, end - start));
+    start = end;
+  }
+
+  std::vector<bssl::UniquePtr<STACK_OF(X509_INFO)>> part_items(parts.size());
+  std::vector<Thread::ThreadPtr> part_threads;
+  part_threads.reserve(parts.size() - 1);
+  for (size_t i = 1; i < parts.size(); ++i) {
+    part_threads.push_back(thread_factory.createThread(
+        [&parts, &part_items, i]() { part_items[i] = readPemX509InfosOnThisThread(parts[i]); },
+        Thread::Options{"tls_pem_read"}));
+  }
+  part_items[0] = readPemX509InfosOnThisThread(parts[0]);
+  for (Thread::ThreadPtr& thread : part_threads) {
+    thread->join();
+  }
+
+  for (const auto& items : part_items) {
+    if (items == nullptr) {
+      return nullptr;
+    }
+  }
+  bssl::UniquePtr<STACK_OF(X509_INFO)> result = std::move(part_items[0]);
+  for (size_t i = 1; i < part_items.size(); ++i) {
+    while (X509_INFO* item = sk_X509_INFO_shift(part_items[i].get())) {
+      RELEASE_ASSERT(sk_X509_INFO_push(result.get(), item) != 0, "");
+    }
+  }
+  return result;
+}
+
 absl::string_view Utility::getErrorDescription(int err) {
   const char* description = SSL_error_description(err);
   if (description) {
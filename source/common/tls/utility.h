@@ -5,6 +5,7 @@
 
 #include "envoy/ssl/context.h"
 #include "envoy/ssl/parsed_x509_name.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/utility.h"
 
@@ -174,6 +175,18 @@ std::string getX509VerificationErrorInfo(X509_STORE_CTX* ctx);
  */
 std::vector<std::string> getCertificateSansForLogging(X509* cert);
 
+/**
+ * Reads the items of a PEM bundle, as BoringSSL's X509_load_cert_crl_file() does. The large
+ * bundles are split at the boundaries of their PEM blocks and read on temporary threads, so that
+ * loading a bundle of many certificates does not hold the main thread for long. The items keep
+ * the order of the bundle either way.
+ * @param pem the PEM bundle
+ * @param thread_factory creates the temporary threads
+ * @return the items of the bundle, or nullptr if any part of it could not be read.
+ */
+bssl::UniquePtr<STACK_OF(X509_INFO)> readPemX509Infos(absl::string_view pem,
+                                                      Thread::ThreadFactory& thread_factory);
+
 } // namespace Utility
 } // namespace Tls
 } // namespace TransportSockets
@@ -0,0 +1,43 @@
+#include "source/common/upstream/address_pool.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Upstream {
+
+SINGLETON_MANAGER_REGISTRATION(upstream_address_pool);
+
+Network::Address::InstanceConstSharedPtr
+AddressPool::find(const envoy::config::core::v3::Address& config) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = addresses_.find(config.SerializeAsString());
+  return it == addresses_.end() ? nullptr : it->second.lock();
+}
+
+void AddressPool::insert(const envoy::config::core::v3::Address& config,
+                         const Network::Address::InstanceConstSharedPtr& address) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  ASSERT(address != nullptr);
+  addresses_.insert_or_assign(config.SerializeAsString(), address);
+  maybePurge();
+}
+
+void AddressPool::maybePurge() {
+  if (addresses_.size() < purge_threshold_) {
+    return;
+  }
+  absl::erase_if(addresses_, [](const auto& entry) { return entry.second.expired(); });
+  purge_threshold_ = std::max(MinPurgeThreshold, 2 * addresses_.size());
+}
+
+AddressPoolSharedPtr AddressPool::get(Singleton::Manager& manager) {
+  // Pinned, so that addresses are shared by clusters created at different times.
+  return manager.getTyped<AddressPool>(SINGLETON_MANAGER_REGISTERED_NAME(upstream_address_pool),
+                                       [] { return std::make_shared<AddressPool>(); }, true);
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/config/core/v3/address.pb.h"
+#include "envoy/network/address.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Shares the resolved endpoint addresses across clusters, so that clusters targeting the same
+ * endpoints hold a single address object per endpoint and do not resolve it again. Addresses are
+ * keyed by their configuration and held weakly, so that an address is freed with the last host
+ * using it.
+ *
+ * Note: as with ObjectSharedPool, the pool must only be used from the main thread. Addresses
+ * themselves are immutable and may be released from any thread.
+ */
+class AddressPool : public Singleton::Instance, NonCopyable {
+public:
+  // The number of entries the pool may hold before the expired ones are purged.
+  static constexpr size_t MinPurgeThreshold = 1024;
+
+  /**
+   * @return the address previously inserted for `config`, or nullptr if there is none or it has
+   * since been freed.
+   */
+  Network::Address::InstanceConstSharedPtr find(const envoy::config::core::v3::Address& config);
+
+  /**
+   * Adds the address resolved from `config` to the pool.
+   */
+  void insert(const envoy::config::core::v3::Address& config,
+              const Network::Address::InstanceConstSharedPtr& address);
+
+  /**
+   * @return the number of entries in the pool, including those whose address has been freed but
+   * that have not been purged yet.
+   */
+  size_t size() const { return addresses_.size(); }
+
+  /**
+   * Returns the address pool shared by all clusters.
+   * @param manager used to create singleton
+   */
+  static std::shared_ptr<AddressPool> get(Singleton::Manager& manager);
+
+private:
+  // Removes the entries whose address has been freed, once the pool has grown enough since the
+  // last purge that this is amortized over the insertions.
+  void maybePurge();
+
+  absl::flat_hash_map<std::string, std::weak_ptr<const Network::Address::Instance>> addresses_;
+  size_t purge_threshold_{MinPurgeThreshold};
+};
+
+using AddressPoolSharedPtr = std::shared_ptr<AddressPool>;
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/upstream/scheduler.h"
+
+namespace Envoy {
+namespace Upstream {
+
+// Alias Method Scheduler
+// ----------------------
+// This scheduler performs weighted random selection using Vose's alias method. The objects are
+// laid out in a table with one bucket per object, where each bucket holds a probability threshold
+// and the index of an alias object. A pick draws a single random number, whose upper half selects
+// a bucket uniformly and whose lower half is compared to the bucket's threshold to choose between
+// the bucket's own object and its alias. Picks are therefore constant time regardless of the
+// number of objects and of the number of unique weights.
+//
+// Adding an object, a change of an object's weight reported by `calculate_weight`, or the expiry
+// of an object causes the table to be rebuilt on the next pick, which is linear on the number of
+// objects. Adding objects is always constant time.
+//
+// Unlike the EDF scheduler, objects are picked at random in proportion to their weight rather than
+// in a deterministic weighted round robin order, so the pick frequencies only converge to the
+// weights over many picks.
+//
+// NOTE: As with the WRSQ scheduler, this implementation is not meant for circumstances where the
+// object weights change with each pick (like in the least request LB or during slow start), as
+// every change rebuilds the table.
+template <class C> class AliasScheduler : public Scheduler<C> {
+public:
+  AliasScheduler(Random::RandomGenerator& random) : random_(random) {}
+
+  std::shared_ptr<C> peekAgain(std::function<double(const C&)> calculate_weight) override {
+    std::shared_ptr<C> picked{pickAndAddInternal(calculate_weight)};
+    if (picked != nullptr) {
+      prepick_queue_.emplace(picked);
+    }
+    return picked;
+  }
+
+  std::shared_ptr<C> pickAndAdd(std::function<double(const C&)> calculate_weight) override {
+    // Burn through the pre-pick queue.
+    while (!prepick_queue_.empty()) {
+      std::shared_ptr<C> prepicked_obj = prepick_queue_.front().lock();
+      prepick_queue_.pop();
+      if (prepicked_obj != nullptr) {
+        return prepicked_obj;
+      }
+    }
+
+    return pickAndAddInternal(calculate_weight);
+  }
+
+  void add(double weight, std::shared_ptr<C> entry) override {
+    rebuild_table_ = true;
+    entries_.push_back({std::move(entry), weight});
+  }
+
+  bool empty() const override { return entries_.empty(); }
+
+private:
+  struct Entry {
+    std::weak_ptr<C> obj;
+    double weight;
+  };
+
+  struct Bucket {
+    // The bucket's own entry is picked if the lower 32 bits of the random number are below the
+    // threshold, which is in [0, 2^32].
+    uint64_t threshold;
+    uint32_t alias;
+  };
+
+  static constexpr double kThresholdScale = static_cast<double>(uint64_t(1) << 32);
+
+  // Builds the alias table with Vose's algorithm.
+  void maybeRebuildTable() {
+    if (!rebuild_table_) {
+      return;
+    }
+    rebuild_table_ = false;
+
+    const uint32_t size = entries_.size();
+    double weight_sum = 0;
+    for (const Entry& entry : entries_) {
+      weight_sum += std::max(entry.weight, 0.0);
+    }
+
+    buckets_.assign(size, Bucket{uint64_t(1) << 32, 0});
+    if (weight_sum <= 0) {
+      // Without any positive weight, all objects are picked with the same probability.
+      return;
+    }
+
+    // Scale the weights so that their average is 1, and split the buckets into those below and
+    // those above the average.
+    std::vector<double> scaled(size);
+    std::vector<uint32_t> small;
+    std::vector<uint32_t> large;
+    for (uint32_t i = 0; i < size; ++i) {
+      scaled[i] = std::max(entries_[i].weight, 0.0) * size / weight_sum;
+      (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    // Fill each bucket below the average with an entry above it.
+    while (!small.empty() && !large.empty()) {
+      const uint32_t s = small.back();
+      small.pop_back();
+      const uint32_t l = large.back();
+      buckets_[s] = {static_cast<uint64_t>(scaled[s] * kThresholdScale), l};
+      scaled[l] -= 1.0 - scaled[s];
+      if (scaled[l] < 1.0) {
+        large.pop_back();
+        small.push_back(l);
+      }
+    }
+    // The remaining buckets are full, up to floating point error.
+  }
+
+  // Remove the expired entries and rebuild the table.
+  void purgeExpired() {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [](const Entry& entry) { return entry.obj.expired(); }),
+                   entries_.end());
+    rebuild_table_ = true;
+  }
+
+  std::shared_ptr<C> pickAndAddInternal(std::function<double(const C&)> calculate_weight) {
+    while (!entries_.empty()) {
+      maybeRebuildTable();
+
+      const uint64_t rnum = random_.random();
+      const uint32_t bucket = ((rnum >> 32) * buckets_.size()) >> 32;
+      const uint32_t index =
+          (rnum & 0xffffffff) < buckets_[bucket].threshold ? bucket : buckets_[bucket].alias;
+      Entry& entry = entries_[index];
+
+      auto obj = entry.obj.lock();
+      if (obj == nullptr) {
+        purgeExpired();
+        continue;
+      }
+
+      if (calculate_weight) {
+        const double new_weight = calculate_weight(*obj);
+        if (new_weight != entry.weight) {
+          entry.weight = new_weight;
+          rebuild_table_ = true;
+        }
+      }
+
+      return obj;
+    }
+
+    return nullptr;
+  }
+
+  Random::RandomGenerator& random_;
+
+  // Objects already picked via peekAgain().
+  std::queue<std::weak_ptr<C>> prepick_queue_;
+
+  std::vector<Entry> entries_;
+  // One bucket per entry, valid unless `rebuild_table_` is set.
+  std::vector<Bucket> buckets_;
+  bool rebuild_table_{true};
+};
+
+} // namespace Upstream
+} // namespace Envoy
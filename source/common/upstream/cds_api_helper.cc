@@ -49,12 +49,26 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
             fmt::format("{}: duplicate cluster {} found", cluster_name, cluster_name));
         continue;
       }
+      // A cluster unchanged on the wire since it was last applied would be blocked by the cluster
+      // manager, after hashing it again.
+      const absl::optional<uint64_t> content_hash = resource.get().contentHash();
+      auto it = applied_hashes_.find(cluster.name());
+      if (content_hash.has_value() && it != applied_hashes_.end() &&
+          it->second == *content_hash && cm_.hasCluster(cluster.name())) {
+        ENVOY_LOG(debug, "{}: add/update cluster '{}' skipped", name_, cluster_name);
+        ++skipped;
+        continue;
+      }
+      applied_hashes_.erase(cluster.name());
       auto update_or_error = cm_.addOrUpdateCluster(cluster, resource.get().version());
       if (!update_or_error.status().ok()) {
         exception_msgs.push_back(
             fmt::format("{}: {}", cluster_name, update_or_error.status().message()));
         continue;
       }
+      if (content_hash.has_value()) {
+        applied_hashes_[cluster.name()] = *content_hash;
+      }
       if (*update_or_error) {
         any_applied = true;
         ENVOY_LOG(debug, "{}: add/update cluster '{}'", name_, cluster_name);
@@ -71,6 +85,7 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
 
   uint32_t removed = 0;
   for (const auto& resource_name : removed_resources) {
+    applied_hashes_.erase(resource_name);
     if (cm_.removeCluster(resource_name)) {
       any_applied = true;
       ENVOY_LOG(debug, "{}: remove cluster '{}'", name_, resource_name);
@@ -10,6 +10,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -43,6 +45,8 @@ private:
   Config::XdsManager& xds_manager_;
   const std::string name_;
   std::string system_version_info_;
+  // The content hashes of the clusters last added or updated, by name.
+  absl::flat_hash_map<std::string, uint64_t> applied_hashes_;
 };
 
 } // namespace Upstream
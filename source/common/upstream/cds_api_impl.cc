@@ -2,6 +2,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/grpc/common.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "absl/strings/str_join.h"
 
@@ -102,8 +103,17 @@ absl::Status
 CdsApiImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
                            const Protobuf::RepeatedPtrField<std::string>& removed_resources,
                            const std::string& system_version_info) {
-  auto [added_or_updated, exception_msgs] =
-      helper_.onConfigUpdate(added_resources, removed_resources, system_version_info);
+  std::pair<uint32_t, std::vector<std::string>> result;
+  {
+    // The thread local updates of all the clusters reach each worker in a single post.
+    ThreadLocal::UpdateBatchPtr tls_batch;
+    if (Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.batch_cds_thread_local_updates")) {
+      tls_batch = factory_context_.threadLocal().batchUpdates();
+    }
+    result = helper_.onConfigUpdate(added_resources, removed_resources, system_version_info);
+  }
+  const auto& [added_or_updated, exception_msgs] = result;
   runInitializeCallbackIfAny();
   if (!exception_msgs.empty()) {
     return absl::InvalidArgumentError(
@@ -1,5 +1,6 @@
 #include "source/common/upstream/cluster_manager_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -16,6 +17,7 @@
 #include "envoy/grpc/async_client.h"
 #include "envoy/network/dns.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/server/overload/overload_manager.h"
 #include "envoy/stats/scope.h"
 #include "envoy/tcp/async_tcp_client.h"
 #include "envoy/upstream/load_balancer.h"
@@ -28,6 +30,7 @@
 #include "source/common/config/null_grpc_mux_impl.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_resource.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/grpc/async_client_manager_impl.h"
 #include "source/common/http/async_client_impl.h"
 #include "source/common/http/http1/conn_pool.h"
@@ -43,8 +46,11 @@
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/priority_conn_pool_map_impl.h"
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
 #include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/strip.h"
 
 #ifdef ENVOY_ENABLE_QUIC
 #include "source/common/http/conn_pool_grid.h"
@@ -56,6 +62,29 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+// Returns the index of a worker from the name of its dispatcher, which is set by the listener
+// manager.
+absl::optional<uint32_t> workerIndex(absl::string_view dispatcher_name) {
+  uint32_t index;
+  if (absl::ConsumePrefix(&dispatcher_name, "worker_") &&
+      absl::SimpleAtoi(dispatcher_name, &index)) {
+    return index;
+  }
+  return absl::nullopt;
+}
+
+// Returns the number of workers serving each host of a cluster, or 0 if a worker serves all hosts.
+uint32_t workersPerHost(const ClusterInfo& info, absl::optional<uint32_t> worker_index,
+                        uint32_t concurrency) {
+  const uint32_t workers_per_host =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(info.lbConfig(), max_workers_per_host, 0);
+  if (!worker_index.has_value() || worker_index.value() >= concurrency ||
+      workers_per_host >= concurrency) {
+    return 0;
+  }
+  return workers_per_host;
+}
+
 void addOptionsIfNotNull(Network::Socket::OptionsSharedPtr& options,
                          const Network::Socket::OptionsSharedPtr& to_add) {
   if (to_add != nullptr) {
@@ -445,6 +474,19 @@ ClusterManagerImpl::initialize(const envoy::config::bootstrap::v3::Bootstrap& bo
     return std::make_shared<ThreadLocalClusterManagerImpl>(*this, dispatcher, local_cluster_params);
   });
 
+  // Under memory pressure, close the least recently used idle upstream connections on all threads.
+  context_.overloadManager().registerForAction(
+      Server::OverloadActionNames::get().CloseIdleUpstreamConnections, *dispatcher_,
+      [this](Server::OverloadActionState state) {
+        const float fraction = state.value().value();
+        if (shutdown_ || fraction == 0) {
+          return;
+        }
+        tls_.runOnAllThreads([fraction](OptRef<ThreadLocalClusterManagerImpl> cluster_manager) {
+          cluster_manager->closeIdleConnectionsForOverload(fraction);
+        });
+      });
+
   const auto& dyn_resources = bootstrap.dynamic_resources();
   // We can now potentially create the CDS API once the backing cluster exists.
   if (dyn_resources.has_cds_config() || !dyn_resources.cds_resources_locator().empty()) {
@@ -543,7 +585,8 @@ ThreadLocalClusterManagerStats
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::generateStats(Stats::Scope& scope,
                                                                  const std::string& thread_name) {
   const std::string final_prefix = absl::StrCat("thread_local_cluster_manager.", thread_name);
-  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_GAUGE_PREFIX(scope, final_prefix))};
+  return {ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(POOL_COUNTER_PREFIX(scope, final_prefix),
+                                                 POOL_GAUGE_PREFIX(scope, final_prefix))};
 }
 
 absl::Status ClusterManagerImpl::onClusterInit(ClusterManagerCluster& cm_cluster) {
@@ -1195,7 +1238,11 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
                                                         load_balancer_factory, host_map,
                                                         drop_overload, drop_category);
 
-  tls_.runOnAllThreads([info = cm_cluster.cluster().info(), params = std::move(params),
+  // The callback is copied for every worker, so the params are shared rather than captured by
+  // value, which would copy the added and removed hosts once per worker.
+  tls_.runOnAllThreads([info = cm_cluster.cluster().info(),
+                        params = std::make_shared<const ThreadLocalClusterUpdateParams>(
+                            std::move(params)),
                         add_or_update_cluster, load_balancer_factory, map = std::move(host_map),
                         cluster_initialization_object = std::move(cluster_initialization_object),
                         drop_overload, drop_category = std::move(drop_category)](
@@ -1259,7 +1306,7 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
         cluster_manager->thread_local_clusters_[info->name()]->setDropOverload(drop_overload);
         cluster_manager->thread_local_clusters_[info->name()]->setDropCategory(drop_category);
       }
-      for (const auto& per_priority : params.per_priority_update_params_) {
+      for (const auto& per_priority : params->per_priority_update_params_) {
         cluster_manager->updateClusterMembership(
             info->name(), per_priority.priority_, per_priority.update_hosts_params_,
             per_priority.locality_weights_, per_priority.hosts_added_, per_priority.hosts_removed_,
@@ -1505,9 +1552,20 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
     HostMapConstSharedPtr cross_priority_host_map) {
   ENVOY_LOG(debug, "membership update for TLS cluster {} added {} removed {}", name,
             hosts_added.size(), hosts_removed.size());
-  priority_set_.updateHosts(priority, std::move(update_hosts_params), std::move(locality_weights),
-                            hosts_added, hosts_removed, weighted_priority_health,
-                            overprovisioning_factor, std::move(cross_priority_host_map));
+  if (workers_per_host_ > 0) {
+    HostVector worker_hosts_added;
+    HostVector worker_hosts_removed;
+    filterWorkerHosts(priority, update_hosts_params, worker_hosts_added, worker_hosts_removed);
+    priority_set_.updateHosts(priority, std::move(update_hosts_params),
+                              std::move(locality_weights), worker_hosts_added,
+                              worker_hosts_removed, weighted_priority_health,
+                              overprovisioning_factor, std::move(cross_priority_host_map));
+  } else {
+    priority_set_.updateHosts(priority, std::move(update_hosts_params),
+                              std::move(locality_weights), hosts_added, hosts_removed,
+                              weighted_priority_health, overprovisioning_factor,
+                              std::move(cross_priority_host_map));
+  }
   // If an LB is thread aware, create a new worker local LB on membership changes.
   if (lb_factory_ != nullptr && lb_factory_->recreateOnHostChange()) {
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
@@ -1515,6 +1573,49 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
   }
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::filterWorkerHosts(
+    uint32_t priority, PrioritySet::UpdateHostsParams& update_hosts_params,
+    HostVector& hosts_added, HostVector& hosts_removed) {
+  const uint32_t worker_index = parent_.worker_index_.value();
+  const uint32_t concurrency = parent_.concurrency_;
+  const uint32_t workers_per_host = workers_per_host_;
+  auto is_worker_host = [worker_index, concurrency, workers_per_host](const Host& host) {
+    return HostUtility::isWorkerHost(host, worker_index, concurrency, workers_per_host);
+  };
+
+  auto worker_hosts = std::make_shared<HostVector>();
+  for (const HostSharedPtr& host : *update_hosts_params.hosts) {
+    if (is_worker_host(*host)) {
+      worker_hosts->push_back(host);
+    }
+  }
+  auto params = HostSetImpl::partitionHosts(
+      worker_hosts, update_hosts_params.hosts_per_locality->filter({is_worker_host})[0]);
+  // Serve all hosts rather than none, so that small clusters keep working on every worker.
+  if (!worker_hosts->empty() &&
+      (!params.healthy_hosts->get().empty() || update_hosts_params.healthy_hosts->get().empty())) {
+    update_hosts_params = std::move(params);
+  }
+
+  const HostVector& current_hosts = priority_set_.getOrCreateHostSet(priority).hosts();
+  absl::flat_hash_set<const Host*> current(current_hosts.size());
+  for (const HostSharedPtr& host : current_hosts) {
+    current.insert(host.get());
+  }
+  absl::flat_hash_set<const Host*> updated(update_hosts_params.hosts->size());
+  for (const HostSharedPtr& host : *update_hosts_params.hosts) {
+    updated.insert(host.get());
+    if (!current.contains(host.get())) {
+      hosts_added.push_back(host);
+    }
+  }
+  for (const HostSharedPtr& host : current_hosts) {
+    if (!updated.contains(host.get())) {
+      hosts_removed.push_back(host);
+    }
+  }
+}
+
 void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnPools(
     const HostVector& hosts_removed) {
   for (const auto& host : hosts_removed) {
@@ -1750,7 +1851,9 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl
     ClusterManagerImpl& parent, Event::Dispatcher& dispatcher,
     const absl::optional<LocalClusterParams>& local_cluster_params)
     : parent_(parent), thread_local_dispatcher_(dispatcher), cdm_(dispatcher.name(), *this),
-      local_stats_(generateStats(*parent.stats_.rootScope(), dispatcher.name())) {
+      local_stats_(generateStats(*parent.stats_.rootScope(), dispatcher.name())),
+      worker_index_(workerIndex(dispatcher.name())),
+      concurrency_(parent.context_.options().concurrency()) {
   // If local cluster is defined then we need to initialize it first.
   if (local_cluster_params.has_value()) {
     const auto& local_cluster_name = local_cluster_params->info_->name();
@@ -1824,6 +1927,7 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::updateClusterMembership(
     LocalityWeightsConstSharedPtr locality_weights, const HostVector& hosts_added,
     const HostVector& hosts_removed, bool weighted_priority_health,
     uint64_t overprovisioning_factor, HostMapConstSharedPtr cross_priority_host_map) {
+  Event::CallbackProfiler::SourceScope profiler_scope("cluster_manager.cluster_update");
   ASSERT(thread_local_clusters_.find(name) != thread_local_clusters_.end());
   const auto& cluster_entry = thread_local_clusters_[name];
   cluster_entry->updateHosts(name, priority, std::move(update_hosts_params),
@@ -1891,7 +1995,9 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
     ThreadLocalClusterManagerImpl& parent, ClusterInfoConstSharedPtr cluster,
     const LoadBalancerFactorySharedPtr& lb_factory)
     : parent_(parent), cluster_info_(cluster), lb_factory_(lb_factory),
-      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())) {
+      override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())),
+      workers_per_host_(
+          workersPerHost(*cluster_info_, parent_.worker_index_, parent_.concurrency_)) {
   priority_set_.getOrCreateHostSet(0);
 
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
@@ -1946,6 +2052,63 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::drainOrCloseConnPools(
   }
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::closeIdleConnectionsForOverload(
+    float fraction) {
+  std::vector<MonotonicTime> last_used;
+  for (const auto& host_pools : host_http_conn_pool_map_) {
+    host_pools.second.pools_->idleConnectionsLastUsed(last_used);
+  }
+  for (const auto& host_pools : host_tcp_conn_pool_map_) {
+    for (const auto& pool : host_pools.second.pools_) {
+      pool.second->idleConnectionsLastUsed(last_used);
+    }
+  }
+
+  const uint32_t to_close = std::min<uint32_t>(
+      last_used.size(), static_cast<uint32_t>(last_used.size() * static_cast<double>(fraction)));
+  if (to_close == 0) {
+    return;
+  }
+  // Connections last used at or before the cutoff are the `to_close` least recently used ones,
+  // up to ties, which the limit passed to the pools accounts for.
+  std::nth_element(last_used.begin(), last_used.begin() + to_close - 1, last_used.end());
+  const MonotonicTime cutoff = last_used[to_close - 1];
+
+  // Closing connections can cause pool deletion if it becomes idle. Copy the containers and
+  // pools so that we aren't iterating through containers that get mutated by callbacks
+  // deleting from them. Pools themselves are deferred deleted.
+  std::vector<std::pair<HostConstSharedPtr, ConnPoolsContainer*>> http_containers;
+  for (auto& host_pools : host_http_conn_pool_map_) {
+    host_pools.second.do_not_delete_ = true;
+    http_containers.emplace_back(host_pools.first, &host_pools.second);
+  }
+  std::vector<Tcp::ConnectionPool::Instance*> tcp_pools;
+  for (const auto& host_pools : host_tcp_conn_pool_map_) {
+    for (const auto& pool : host_pools.second.pools_) {
+      tcp_pools.push_back(pool.second.get());
+    }
+  }
+
+  uint32_t closed = 0;
+  for (auto& [host, container] : http_containers) {
+    closed += container->pools_->closeIdleConnections(cutoff, to_close - closed);
+  }
+  for (auto* pool : tcp_pools) {
+    closed += pool->closeIdleConnections(cutoff, to_close - closed);
+  }
+
+  for (auto& [host, container] : http_containers) {
+    container->do_not_delete_ = false;
+    if (container->pools_->empty()) {
+      host_http_conn_pool_map_.erase(host);
+    }
+  }
+
+  ENVOY_LOG(debug, "closed {} of {} idle upstream connections under memory pressure", closed,
+            last_used.size());
+  local_stats_.idle_connections_closed_by_overload_.add(closed);
+}
+
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::~ClusterEntry() {
   // We need to drain all connection pools for the cluster being removed. Then we can remove the
   // cluster.
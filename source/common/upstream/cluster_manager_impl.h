@@ -41,6 +41,7 @@
 #include "source/common/upstream/host_utility.h"
 #include "source/common/upstream/load_stats_reporter.h"
 #include "source/common/upstream/priority_conn_pool_map.h"
+#include "source/common/upstream/request_latency_tracker_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 
 namespace Envoy {
@@ -215,13 +216,15 @@ struct ClusterManagerStats {
 /**
  * All thread local cluster manager stats. @see stats_macros.h
  */
-#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GAUGE) GAUGE(clusters_inflated, NeverImport)
+#define ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(COUNTER, GAUGE)                                    \
+  COUNTER(idle_connections_closed_by_overload)                                                     \
+  GAUGE(clusters_inflated, NeverImport)
 
 /**
  * Struct definition for all cluster manager stats. @see stats_macros.h
  */
 struct ThreadLocalClusterManagerStats {
-  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_GAUGE_STRUCT)
+  ALL_THREAD_LOCAL_CLUSTER_MANAGER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
 };
 
 /**
@@ -634,6 +637,12 @@ private:
       void setDropCategory(absl::string_view drop_category) override {
         drop_category_ = drop_category;
       }
+      RequestLatencyTracker& requestLatencyTracker() override {
+        if (request_latency_tracker_ == nullptr) {
+          request_latency_tracker_ = std::make_unique<RequestLatencyTrackerImpl>();
+        }
+        return *request_latency_tracker_;
+      }
 
     private:
       Http::ConnectionPool::Instance*
@@ -647,6 +656,11 @@ private:
 
       HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context);
 
+      // Restricts an update of a priority to the hosts served by this worker, and sets the hosts
+      // added and removed to the difference with the hosts currently served.
+      void filterWorkerHosts(uint32_t priority, PrioritySet::UpdateHostsParams& update_hosts_params,
+                             HostVector& hosts_added, HostVector& hosts_removed);
+
       ThreadLocalClusterManagerImpl& parent_;
       PrioritySetImpl priority_set_;
       UnitFloat drop_overload_{0};
@@ -661,6 +675,8 @@ private:
       // Current active LB.
       LoadBalancerPtr lb_;
       Http::AsyncClientPtr lazy_http_async_client_;
+      // Only created for the clusters of the routes hedging on latency.
+      std::unique_ptr<RequestLatencyTrackerImpl> request_latency_tracker_;
       // Stores QUICHE specific objects which live through out the life time of the cluster and can
       // be shared across its hosts.
       Http::PersistentQuicInfoPtr quic_info_;
@@ -678,6 +694,9 @@ private:
       // If multiple bit fields are set, it is acceptable as long as the status of override host is
       // in any of these statuses.
       const HostUtility::HostStatusSet override_host_statuses_;
+
+      // The number of workers serving each host, or 0 if this worker serves all hosts.
+      const uint32_t workers_per_host_;
     };
 
     using ClusterEntryPtr = std::unique_ptr<ClusterEntry>;
@@ -708,6 +727,9 @@ private:
                                  bool weighted_priority_health, uint64_t overprovisioning_factor,
                                  HostMapConstSharedPtr cross_priority_host_map);
     void onHostHealthFailure(const HostSharedPtr& host);
+    // Closes the least recently used idle connections of all pools of this thread, keeping
+    // (1 - `fraction`) of them.
+    void closeIdleConnectionsForOverload(float fraction);
 
     ConnPoolsContainer* getHttpConnPoolsContainer(const HostConstSharedPtr& host,
                                                   bool allocate = false);
@@ -757,6 +779,10 @@ private:
     bool destroying_{};
     ClusterDiscoveryManager cdm_;
     ThreadLocalClusterManagerStats local_stats_;
+    // The index of this worker, unset on the main thread, and the number of workers. Used to only
+    // serve the hosts of clusters with max_workers_per_host that are assigned to this worker.
+    const absl::optional<uint32_t> worker_index_;
+    const uint32_t concurrency_;
 
   private:
     static ThreadLocalClusterManagerStats generateStats(Stats::Scope& scope,
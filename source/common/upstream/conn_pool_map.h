@@ -69,6 +69,16 @@ public:
    */
   void drainConnections(Envoy::ConnectionPool::DrainBehavior drain_behavior);
 
+  /**
+   * See `Envoy::ConnectionPool::Instance::idleConnectionsLastUsed()`.
+   */
+  void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const;
+
+  /**
+   * See `Envoy::ConnectionPool::Instance::closeIdleConnections()`.
+   */
+  uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit);
+
 private:
   /**
    * Frees the first idle pool in `active_pools_`.
@@ -119,6 +119,35 @@ void ConnPoolMap<KEY_TYPE, POOL_TYPE>::drainConnections(
   }
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+void ConnPoolMap<KEY_TYPE, POOL_TYPE>::idleConnectionsLastUsed(
+    std::vector<MonotonicTime>& last_used) const {
+  for (const auto& pool_pair : active_pools_) {
+    pool_pair.second->idleConnectionsLastUsed(last_used);
+  }
+}
+
+template <typename KEY_TYPE, typename POOL_TYPE>
+uint32_t ConnPoolMap<KEY_TYPE, POOL_TYPE>::closeIdleConnections(MonotonicTime last_used_cutoff,
+                                                                uint32_t limit) {
+  // Copy the `active_pools_` so that it is safe for the call to result
+  // in deletion, and avoid iteration through a mutating container.
+  std::vector<POOL_TYPE*> pools;
+  pools.reserve(active_pools_.size());
+  for (auto& pool_pair : active_pools_) {
+    pools.push_back(pool_pair.second.get());
+  }
+
+  uint32_t closed = 0;
+  for (auto* pool : pools) {
+    if (closed == limit) {
+      break;
+    }
+    closed += pool->closeIdleConnections(last_used_cutoff, limit - closed);
+  }
+  return closed;
+}
+
 template <typename KEY_TYPE, typename POOL_TYPE>
 bool ConnPoolMap<KEY_TYPE, POOL_TYPE>::freeOnePool() {
   // Try to find a pool that isn't doing anything.
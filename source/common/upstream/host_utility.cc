@@ -2,6 +2,7 @@
 
 #include <string>
 
+#include "source/common/common/hash.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -130,6 +131,13 @@ HostUtility::HostStatusSet HostUtility::createOverrideHostStatus(
   return override_host_status;
 }
 
+bool HostUtility::isWorkerHost(const Host& host, uint32_t worker_index, uint32_t concurrency,
+                               uint32_t workers_per_host) {
+  ASSERT(worker_index < concurrency);
+  const uint32_t first_worker = HashUtil::xxHash64(host.address()->asStringView()) % concurrency;
+  return (worker_index + concurrency - first_worker) % concurrency < workers_per_host;
+}
+
 std::pair<HostConstSharedPtr, bool> HostUtility::selectOverrideHost(const HostMap* host_map,
                                                                     HostStatusSet status,
                                                                     LoadBalancerContext* context) {
@@ -35,6 +35,14 @@ public:
   static std::pair<HostConstSharedPtr, bool>
   selectOverrideHost(const HostMap* host_map, HostStatusSet status, LoadBalancerContext* context);
 
+  /**
+   * @return whether a worker serves a host of a cluster whose hosts are each served by
+   * `workers_per_host` of the `concurrency` workers. The workers serving a host are consecutive,
+   * starting at one chosen by a hash of the host address.
+   */
+  static bool isWorkerHost(const Host& host, uint32_t worker_index, uint32_t concurrency,
+                           uint32_t workers_per_host);
+
   // Iterate over all per-endpoint metrics, for clusters with `per_endpoint_stats` enabled.
   static void
   forEachHostMetric(const ClusterManager& cluster_manager,
@@ -18,6 +18,7 @@
 #include "source/common/common/utility.h"
 #include "source/common/http/codes.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -60,6 +61,63 @@ void DetectorHostMonitorImpl::uneject(MonotonicTime unejection_time) {
   last_unejection_time_ = (unejection_time);
 }
 
+namespace {
+
+// Successes are by far the most common result, and all threads report them. Only writing non-zero
+// consecutive failure counters keeps their cache line shared between threads until a failure.
+void resetIfNonZero(std::atomic<uint32_t>& counter) {
+  if (counter.load(std::memory_order_relaxed) != 0) {
+    counter = 0;
+  }
+}
+
+} // namespace
+
+SuccessRateMonitor::SuccessRateMonitor(envoy::data::cluster::v3::OutlierEjectionType ejection_type)
+    : ejection_type_(ejection_type) {
+  if (Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.outlier_detection_sharded_success_rate")) {
+    total_slot_ = Stats::CounterShards::allocateSlot();
+    success_slot_ = Stats::CounterShards::allocateSlot();
+    if (!total_slot_.has_value() || !success_slot_.has_value()) {
+      // All slots are in use, count into the shared buckets instead.
+      if (total_slot_.has_value()) {
+        Stats::CounterShards::releaseSlot(*total_slot_);
+        total_slot_.reset();
+      }
+      if (success_slot_.has_value()) {
+        Stats::CounterShards::releaseSlot(*success_slot_);
+        success_slot_.reset();
+      }
+    }
+  }
+  // Point the success_rate_accumulator_bucket_ pointer to a bucket.
+  updateCurrentSuccessRateBucket();
+}
+
+SuccessRateMonitor::~SuccessRateMonitor() {
+  // The host is gone, so no thread can still be counting into the slots.
+  if (total_slot_.has_value()) {
+    Stats::CounterShards::releaseSlot(*total_slot_);
+    Stats::CounterShards::releaseSlot(*success_slot_);
+  }
+}
+
+void SuccessRateMonitor::updateCurrentSuccessRateBucket() {
+  if (total_slot_.has_value()) {
+    // Merge the counts of all threads since the last swap into the current bucket, which becomes
+    // the bucket success rates are computed from. Threads never write to the buckets themselves.
+    const uint64_t total = Stats::CounterShards::sum(*total_slot_);
+    const uint64_t success = Stats::CounterShards::sum(*success_slot_);
+    SuccessRateAccumulatorBucket* bucket = success_rate_accumulator_bucket_.load();
+    bucket->total_request_counter_ = total - merged_total_;
+    bucket->success_request_counter_ = success - merged_success_;
+    merged_total_ = total;
+    merged_success_ = success;
+  }
+  success_rate_accumulator_bucket_.store(success_rate_accumulator_.updateCurrentWriter());
+}
+
 void DetectorHostMonitorImpl::updateCurrentSuccessRateBucket() {
   external_origin_sr_monitor_.updateCurrentSuccessRateBucket();
   local_origin_sr_monitor_.updateCurrentSuccessRateBucket();
@@ -80,7 +138,7 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
         detector->onConsecutiveGatewayFailure(host_.lock());
       }
     } else {
-      consecutive_gateway_failure_ = 0;
+      resetIfNonZero(consecutive_gateway_failure_);
     }
 
     if (++consecutive_5xx_ == detector->runtime().snapshot().getInteger(
@@ -89,8 +147,8 @@ void DetectorHostMonitorImpl::putHttpResponseCode(uint64_t response_code) {
     }
   } else {
     external_origin_sr_monitor_.incSuccessReqCounter();
-    consecutive_5xx_ = 0;
-    consecutive_gateway_failure_ = 0;
+    resetIfNonZero(consecutive_5xx_);
+    resetIfNonZero(consecutive_gateway_failure_);
   }
 }
 
@@ -204,7 +262,7 @@ void DetectorHostMonitorImpl::localOriginNoFailure() {
   local_origin_sr_monitor_.incTotalReqCounter();
   local_origin_sr_monitor_.incSuccessReqCounter();
 
-  resetConsecutiveLocalOriginFailure();
+  resetIfNonZero(consecutive_local_origin_failure_);
 }
 
 DetectorConfig::DetectorConfig(const envoy::config::cluster::v3::OutlierDetection& config)
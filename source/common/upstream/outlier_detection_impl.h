@@ -21,6 +21,7 @@
 #include "envoy/stats/stats.h"
 #include "envoy/upstream/outlier_detection.h"
 
+#include "source/common/stats/counter_shards.h"
 #include "source/common/upstream/upstream_impl.h"
 
 #include "absl/container/node_hash_map.h"
@@ -87,22 +88,34 @@ private:
   std::unique_ptr<SuccessRateAccumulatorBucket> backup_success_rate_bucket_;
 };
 
+/**
+ * Counts the requests and successes of a host for success rate outlier detection. When sharded,
+ * each thread counts into its own Stats::CounterShards table instead of the shared atomics of the
+ * current bucket, and the counts of all threads are merged into the bucket when it is swapped at
+ * the detector's interval.
+ */
 class SuccessRateMonitor {
 public:
-  SuccessRateMonitor(envoy::data::cluster::v3::OutlierEjectionType ejection_type)
-      : ejection_type_(ejection_type) {
-    // Point the success_rate_accumulator_bucket_ pointer to a bucket.
-    updateCurrentSuccessRateBucket();
-  }
+  SuccessRateMonitor(envoy::data::cluster::v3::OutlierEjectionType ejection_type);
+  ~SuccessRateMonitor();
+
   double getSuccessRate() const { return success_rate_; }
   SuccessRateAccumulator& successRateAccumulator() { return success_rate_accumulator_; }
   void setSuccessRate(double new_success_rate) { success_rate_ = new_success_rate; }
-  void updateCurrentSuccessRateBucket() {
-    success_rate_accumulator_bucket_.store(success_rate_accumulator_.updateCurrentWriter());
+  void updateCurrentSuccessRateBucket();
+  void incTotalReqCounter() {
+    if (total_slot_.has_value()) {
+      Stats::CounterShards::add(*total_slot_, 1);
+    } else {
+      success_rate_accumulator_bucket_.load()->total_request_counter_++;
+    }
   }
-  void incTotalReqCounter() { success_rate_accumulator_bucket_.load()->total_request_counter_++; }
   void incSuccessReqCounter() {
-    success_rate_accumulator_bucket_.load()->success_request_counter_++;
+    if (success_slot_.has_value()) {
+      Stats::CounterShards::add(*success_slot_, 1);
+    } else {
+      success_rate_accumulator_bucket_.load()->success_request_counter_++;
+    }
   }
 
   envoy::data::cluster::v3::OutlierEjectionType getEjectionType() const { return ejection_type_; }
@@ -110,6 +123,12 @@ public:
 private:
   SuccessRateAccumulator success_rate_accumulator_;
   std::atomic<SuccessRateAccumulatorBucket*> success_rate_accumulator_bucket_;
+  // Set when sharded. Both are set or neither is.
+  absl::optional<uint32_t> total_slot_;
+  absl::optional<uint32_t> success_slot_;
+  // The sharded counts merged into the last bucket.
+  uint64_t merged_total_{};
+  uint64_t merged_success_{};
   envoy::data::cluster::v3::OutlierEjectionType ejection_type_;
   double success_rate_{-1};
 };
@@ -72,6 +72,24 @@ void PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::drainConnections(
   }
 }
 
+template <typename KEY_TYPE, typename POOL_TYPE>
+void PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::idleConnectionsLastUsed(
+    std::vector<MonotonicTime>& last_used) const {
+  for (const auto& pool_map : conn_pool_maps_) {
+    pool_map->idleConnectionsLastUsed(last_used);
+  }
+}
+
+template <typename KEY_TYPE, typename POOL_TYPE>
+uint32_t PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::closeIdleConnections(
+    MonotonicTime last_used_cutoff, uint32_t limit) {
+  uint32_t closed = 0;
+  for (auto& pool_map : conn_pool_maps_) {
+    closed += pool_map->closeIdleConnections(last_used_cutoff, limit - closed);
+  }
+  return closed;
+}
+
 template <typename KEY_TYPE, typename POOL_TYPE>
 size_t PriorityConnPoolMap<KEY_TYPE, POOL_TYPE>::getPriorityIndex(ResourcePriority priority) const {
   size_t index = static_cast<size_t>(priority);
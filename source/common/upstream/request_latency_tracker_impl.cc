@@ -0,0 +1,69 @@
+#include "source/common/upstream/request_latency_tracker_impl.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Envoy {
+namespace Upstream {
+
+void RequestLatencyTrackerImpl::onRequest() {
+  ++requests_;
+  if (++requests_since_decay_ >= DecayInterval) {
+    requests_since_decay_ = 0;
+    requests_ /= 2;
+    hedges_ /= 2;
+  }
+}
+
+void RequestLatencyTrackerImpl::recordLatency(std::chrono::milliseconds latency) {
+  ++buckets_[bucketIndex(latency)];
+  ++latencies_;
+  if (++latencies_since_decay_ >= DecayInterval) {
+    latencies_since_decay_ = 0;
+    latencies_ = 0;
+    for (uint64_t& bucket : buckets_) {
+      bucket /= 2;
+      latencies_ += bucket;
+    }
+  }
+}
+
+absl::optional<std::chrono::milliseconds>
+RequestLatencyTrackerImpl::latencyPercentile(double percentile) const {
+  if (latencies_ < MinLatencies) {
+    return absl::nullopt;
+  }
+  const uint64_t rank =
+      std::max<uint64_t>(1, std::ceil(std::clamp(percentile, 0.0, 100.0) / 100 * latencies_));
+  uint64_t count = 0;
+  for (size_t index = 0; index < NumBuckets; ++index) {
+    count += buckets_[index];
+    if (count >= rank) {
+      return bucketUpperBound(index);
+    }
+  }
+  return bucketUpperBound(NumBuckets - 1);
+}
+
+bool RequestLatencyTrackerImpl::tryHedge(double budget_ratio) {
+  if (hedges_ + 1 > budget_ratio * requests_) {
+    return false;
+  }
+  ++hedges_;
+  return true;
+}
+
+size_t RequestLatencyTrackerImpl::bucketIndex(std::chrono::milliseconds latency) {
+  if (latency.count() <= 1) {
+    return 0;
+  }
+  // The bucket of index i holds the latencies in (2^((i - 1) / 4), 2^(i / 4)] milliseconds.
+  return std::min<size_t>(NumBuckets - 1, std::ceil(4 * std::log2(latency.count())));
+}
+
+std::chrono::milliseconds RequestLatencyTrackerImpl::bucketUpperBound(size_t index) {
+  return std::chrono::milliseconds(static_cast<uint64_t>(std::exp2(index / 4.0)));
+}
+
+} // namespace Upstream
+} // namespace Envoy
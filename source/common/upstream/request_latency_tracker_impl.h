@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/upstream/thread_local_cluster.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * A RequestLatencyTracker keeping the latencies in logarithmic buckets, four per power of two
+ * milliseconds, so its percentiles are upper bounds at most 19% above the exact ones. The counts
+ * are halved every DecayInterval latencies or requests, so the percentiles and the budget follow
+ * the recent requests without any timer.
+ */
+class RequestLatencyTrackerImpl : public RequestLatencyTracker {
+public:
+  static constexpr size_t NumBuckets = 64;
+  // The percentiles are only computed once this many latencies were recorded.
+  static constexpr uint64_t MinLatencies = 100;
+  static constexpr uint64_t DecayInterval = 1000;
+
+  // RequestLatencyTracker
+  void onRequest() override;
+  void recordLatency(std::chrono::milliseconds latency) override;
+  absl::optional<std::chrono::milliseconds> latencyPercentile(double percentile) const override;
+  bool tryHedge(double budget_ratio) override;
+
+  static size_t bucketIndex(std::chrono::milliseconds latency);
+  static std::chrono::milliseconds bucketUpperBound(size_t index);
+
+private:
+  std::array<uint64_t, NumBuckets> buckets_{};
+  uint64_t latencies_{};
+  uint64_t latencies_since_decay_{};
+  uint64_t requests_{};
+  uint64_t hedges_{};
+  uint64_t requests_since_decay_{};
+};
+
+} // namespace Upstream
+} // namespace Envoy
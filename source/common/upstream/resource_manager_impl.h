@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <memory>
@@ -12,29 +13,76 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/basic_resource_impl.h"
+#include "source/common/stats/counter_shards.h"
+
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Upstream {
 
+/**
+ * A resource limit with live circuit breaker gauges.
+ *
+ * When sharded, each thread accumulates its increments and decrements in its own
+ * Stats::CounterShards slot and only adds them to the shared count once they reach a batch that
+ * scales with the maximum, which saves the cross-core writes of the shared atomic and of the gauges
+ * for most operations. A thread sees the shared count plus its own pending changes, so the
+ * resource may go above its maximum by up to a batch per other thread, and the gauges lag by as
+ * much. Limits below ShardedBatchDivisor * 2 are effectively exact.
+ */
 struct ManagedResourceImpl : public BasicResourceLimitImpl {
+  // The batch of a thread is the maximum divided by this, bounded by MaxShardedBatch.
+  static constexpr uint64_t ShardedBatchDivisor = 256;
+  static constexpr uint64_t MaxShardedBatch = 64;
+
   ManagedResourceImpl(uint64_t max, Runtime::Loader& runtime, const std::string& runtime_key,
-                      Stats::Gauge& open_gauge, Stats::Gauge& remaining)
+                      Stats::Gauge& open_gauge, Stats::Gauge& remaining, bool sharded = false)
       : BasicResourceLimitImpl(max, runtime, runtime_key), open_gauge_(open_gauge),
         remaining_(remaining) {
     remaining_.set(max);
+    if (sharded) {
+      // Without a free slot the resource is not sharded.
+      slot_ = Stats::CounterShards::allocateSlot();
+    }
+  }
+  ~ManagedResourceImpl() override {
+    if (slot_.has_value()) {
+      Stats::CounterShards::releaseSlot(*slot_);
+    }
   }
 
   // BasicResourceLimitImpl
+  bool canCreate() override {
+    return slot_.has_value() ? count() < max() : BasicResourceLimitImpl::canCreate();
+  }
   void inc() override {
+    if (slot_.has_value()) {
+      maybeFlush(Stats::CounterShards::add(*slot_, 1));
+      return;
+    }
     BasicResourceLimitImpl::inc();
-    updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateGauges();
   }
   void decBy(uint64_t amount) override {
+    if (slot_.has_value()) {
+      maybeFlush(Stats::CounterShards::add(*slot_, negate(amount)));
+      return;
+    }
     BasicResourceLimitImpl::decBy(amount);
-    updateRemaining();
-    open_gauge_.set(BasicResourceLimitImpl::canCreate() ? 0 : 1);
+    updateGauges();
   }
+  uint64_t count() const override {
+    if (!slot_.has_value()) {
+      return BasicResourceLimitImpl::count();
+    }
+    // Both the shared count and the pending changes are signed, as a thread may release resources
+    // acquired by another one.
+    const int64_t total = static_cast<int64_t>(current_.load(std::memory_order_relaxed)) +
+                          static_cast<int64_t>(Stats::CounterShards::local(*slot_));
+    return total > 0 ? total : 0;
+  }
+
+  bool sharded() const { return slot_.has_value(); }
 
   /**
    * We set the gauge instead of incrementing and decrementing because,
@@ -46,10 +94,33 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
      * We cannot use std::max here because max() and current_ are
      * unsigned and subtracting them may overflow.
      */
-    const uint64_t current_copy = current_;
+    const uint64_t current_copy = count();
     remaining_.set(max() > current_copy ? max() - current_copy : 0);
   }
 
+  void updateGauges() {
+    updateRemaining();
+    open_gauge_.set(canCreate() ? 0 : 1);
+  }
+
+  // Adds the pending changes of the current thread to the shared count once they reach a batch.
+  void maybeFlush(uint64_t pending) {
+    const int64_t delta = static_cast<int64_t>(pending);
+    const uint64_t batch = std::clamp<uint64_t>(max() / ShardedBatchDivisor, 1, MaxShardedBatch);
+    if (static_cast<uint64_t>(delta < 0 ? -delta : delta) < batch) {
+      return;
+    }
+    current_.fetch_add(pending, std::memory_order_relaxed);
+    Stats::CounterShards::add(*slot_, negate(pending));
+    updateGauges();
+  }
+
+  // Unsigned wrap around makes adding the result a subtraction.
+  static uint64_t negate(uint64_t value) { return ~value + 1; }
+
+  // Set when sharded.
+  absl::optional<uint32_t> slot_;
+
   /**
    * A gauge to notify the live circuit breaker state. The gauge is set to 0
    * to notify that the circuit breaker is not yet triggered.
@@ -70,6 +141,8 @@ struct ManagedResourceImpl : public BasicResourceLimitImpl {
  *    occur during high contention.
  * 2) Though atomics are used, it is possible for resources to temporarily go above the supplied
  *    maximums. This should not effect overall behavior.
+ * 3) With sharded accounting, connections, pending requests and requests are counted per thread
+ *    and may go above their maximums by a bounded amount, see ManagedResourceImpl.
  */
 class ResourceManagerImpl : public ResourceManager {
 public:
@@ -78,13 +151,13 @@ public:
                       uint64_t max_requests, uint64_t max_retries, uint64_t max_connection_pools,
                       uint64_t max_connections_per_host, ClusterCircuitBreakersStats cb_stats,
                       absl::optional<double> budget_percent,
-                      absl::optional<uint32_t> min_retry_concurrency)
+                      absl::optional<uint32_t> min_retry_concurrency, bool sharded = false)
       : connections_(max_connections, runtime, runtime_key + "max_connections", cb_stats.cx_open_,
-                     cb_stats.remaining_cx_),
+                     cb_stats.remaining_cx_, sharded),
         pending_requests_(max_pending_requests, runtime, runtime_key + "max_pending_requests",
-                          cb_stats.rq_pending_open_, cb_stats.remaining_pending_),
+                          cb_stats.rq_pending_open_, cb_stats.remaining_pending_, sharded),
         requests_(max_requests, runtime, runtime_key + "max_requests", cb_stats.rq_open_,
-                  cb_stats.remaining_rq_),
+                  cb_stats.remaining_rq_, sharded),
         connection_pools_(max_connection_pools, runtime, runtime_key + "max_connection_pools",
                           cb_stats.cx_pool_open_, cb_stats.remaining_cx_pools_),
         max_connections_per_host_(max_connections_per_host),
@@ -57,6 +57,7 @@
 #include "source/common/stats/deferred_creation.h"
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/health_checker_impl.h"
+#include "source/common/upstream/address_pool.h"
 #include "source/common/upstream/locality_pool.h"
 #include "source/server/transport_socket_config_impl.h"
 
@@ -947,6 +948,18 @@ ClusterInfoImpl::generateLoadReportStats(Stats::Scope& scope,
   return {stat_names, scope};
 }
 
+ClusterInfoImpl::LoadReportStats::LoadReportStats(Stats::SymbolTable& symbol_table,
+                                                  const ClusterLoadReportStatNames& stat_names)
+    : store_(symbol_table), stats_(generateLoadReportStats(*store_.rootScope(), stat_names)) {}
+
+ClusterLoadReportStats& ClusterInfoImpl::loadReportStats() const {
+  return load_report_stats_
+      .get([this]() {
+        return new LoadReportStats(stats_scope_->symbolTable(), load_report_stat_names_);
+      })
+      ->stats_;
+}
+
 ClusterTimeoutBudgetStats
 ClusterInfoImpl::generateTimeoutBudgetStats(Stats::Scope& scope,
                                             const ClusterTimeoutBudgetStatNames& stat_names) {
@@ -1110,6 +1123,7 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      adaptive_preconnect_(config.preconnect_policy().adaptive_preconnect()),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(
           stats_scope_, factory_context.serverFactoryContext().clusterManager().clusterStatNames(),
@@ -1122,10 +1136,8 @@ ClusterInfoImpl::ClusterInfoImpl(
       endpoint_stats_(
           factory_context.serverFactoryContext().clusterManager().clusterEndpointStatNames(),
           *stats_scope_),
-      load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(generateLoadReportStats(
-          *load_report_stats_store_.rootScope(),
-          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames())),
+      load_report_stat_names_(
+          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames()),
       optional_cluster_stats_(
           (config.has_track_cluster_stats() || config.track_timeout_budgets())
               ? std::make_unique<OptionalClusterStats>(
@@ -1549,7 +1561,11 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
           cluster_context.serverFactoryContext().mainThreadDispatcher())),
       const_locality_shared_pool_(LocalityPool::getConstLocalitySharedPool(
           cluster_context.serverFactoryContext().singletonManager(),
-          cluster_context.serverFactoryContext().mainThreadDispatcher())) {
+          cluster_context.serverFactoryContext().mainThreadDispatcher())),
+      address_pool_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.share_endpoint_addresses")
+              ? AddressPool::get(cluster_context.serverFactoryContext().singletonManager())
+              : nullptr) {
   auto& server_context = cluster_context.serverFactoryContext();
 
   auto stats_scope = generateStatsScope(cluster, server_context.serverScope().store());
@@ -1880,10 +1896,18 @@ void ClusterImplBase::reloadHealthyHostsHelper(const HostSharedPtr&) {
 
 absl::StatusOr<const Network::Address::InstanceConstSharedPtr>
 ClusterImplBase::resolveProtoAddress(const envoy::config::core::v3::Address& address) {
+  if (address_pool_ != nullptr) {
+    if (auto pooled = address_pool_->find(address); pooled != nullptr) {
+      return pooled;
+    }
+  }
   absl::Status resolve_status;
   TRY_ASSERT_MAIN_THREAD {
     auto address_or_error = Network::Address::resolveProtoAddress(address);
     if (address_or_error.status().ok()) {
+      if (address_pool_ != nullptr) {
+        address_pool_->insert(address, address_or_error.value());
+      }
       return address_or_error.value();
     }
     resolve_status = address_or_error.status();
@@ -2115,7 +2139,8 @@ ClusterInfoImpl::ResourceManagers::load(const envoy::config::cluster::v3::Cluste
       max_connection_pools, max_connections_per_host,
       ClusterInfoImpl::generateCircuitBreakersStats(stats_scope, priority_stat_name,
                                                     track_remaining, circuit_breakers_stat_names_),
-      budget_percent, min_retry_concurrency);
+      budget_percent, min_retry_concurrency,
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.sharded_circuit_breakers"));
 }
 
 PriorityStateManager::PriorityStateManager(ClusterImplBase& cluster,
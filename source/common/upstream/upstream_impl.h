@@ -59,6 +59,7 @@
 #include "source/common/shared_pool/shared_pool.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/common/upstream/load_balancer_context_base.h"
+#include "source/common/upstream/address_pool.h"
 #include "source/common/upstream/locality_pool.h"
 #include "source/common/upstream/resource_manager_impl.h"
 #include "source/common/upstream/transport_socket_match_impl.h"
@@ -851,6 +852,7 @@ public:
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  bool adaptivePreconnect() const override { return adaptive_preconnect_; }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -909,7 +911,7 @@ public:
     return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override;
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
@@ -1034,6 +1036,14 @@ private:
     const ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
   };
 
+  // The load report stats live in their own store, which is only allocated once they are first
+  // used, as most clusters never drop requests or report load.
+  struct LoadReportStats {
+    LoadReportStats(Stats::SymbolTable& symbol_table, const ClusterLoadReportStatNames& stat_names);
+    Stats::IsolatedStoreImpl store_;
+    ClusterLoadReportStats stats_;
+  };
+
 #ifdef ENVOY_ENABLE_UHV
   ::Envoy::Http::HeaderValidatorStats& getHeaderValidatorStats(Http::Protocol protocol) const;
 #endif
@@ -1051,14 +1061,16 @@ private:
   OptionalTimeouts optional_timeouts_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const bool adaptive_preconnect_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
   mutable ClusterConfigUpdateStats config_update_stats_;
   mutable ClusterLbStats lb_stats_;
   mutable ClusterEndpointStats endpoint_stats_;
-  Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  const ClusterLoadReportStatNames& load_report_stat_names_;
+  mutable Thread::AtomicPtr<LoadReportStats, Thread::AtomicPtrAllocMode::DeleteOnDestruct>
+      load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
@@ -1246,6 +1258,8 @@ private:
   const bool local_cluster_;
   Config::ConstMetadataSharedPoolSharedPtr const_metadata_shared_pool_;
   ConstLocalitySharedPoolSharedPtr const_locality_shared_pool_;
+  // Shares resolved endpoint addresses with other clusters, nullptr if disabled.
+  AddressPoolSharedPtr address_pool_;
   Common::CallbackHandlePtr priority_update_cb_;
   UnitFloat drop_overload_{0};
   std::string drop_category_;
@@ -49,6 +49,30 @@ absl::optional<std::vector<uint8_t>> Encoder::encodeFrameHeader(const Frame& fra
   return output;
 }
 
+void unmaskPayload(uint32_t masking_key, uint64_t offset, const uint8_t* input, uint8_t* output,
+                   uint64_t length) {
+  // The masking key bytes, in the order they apply to the payload bytes from offset on, repeated
+  // to unmask 8 bytes at a time.
+  const uint32_t key_bytes = htobe32(masking_key);
+  std::array<uint8_t, 2 * kMaskingKeyLength> mask;
+  for (size_t i = 0; i < mask.size(); ++i) {
+    mask[i] = reinterpret_cast<const uint8_t*>(&key_bytes)[(offset + i) % kMaskingKeyLength];
+  }
+  uint64_t mask_word;
+  memcpy(&mask_word, mask.data(), sizeof(mask_word)); // NOLINT(safe-memcpy)
+
+  uint64_t i = 0;
+  for (; i + sizeof(mask_word) <= length; i += sizeof(mask_word)) {
+    uint64_t word;
+    memcpy(&word, input + i, sizeof(word)); // NOLINT(safe-memcpy)
+    word ^= mask_word;
+    memcpy(output + i, &word, sizeof(word)); // NOLINT(safe-memcpy)
+  }
+  for (; i < length; ++i) {
+    output[i] = input[i] ^ mask[i % sizeof(mask_word)];
+  }
+}
+
 void Decoder::frameDataStart() {
   frame_.payload_length_ = length_;
   if (length_ == 0) {
@@ -64,7 +88,19 @@ void Decoder::frameDataStart() {
 void Decoder::frameData(const uint8_t* mem, uint64_t length) {
   if (max_payload_buffer_length_ > 0) {
     uint64_t allowed_length = max_payload_buffer_length_ - frame_.payload_->length();
-    frame_.payload_->add(mem, length <= allowed_length ? length : allowed_length);
+    const uint64_t copied_length = length <= allowed_length ? length : allowed_length;
+    if (unmask_payload_ && frame_.masking_key_.has_value()) {
+      if (copied_length == 0) {
+        return;
+      }
+      // Unmasks while copying, the copied bytes being a prefix of the payload.
+      auto reservation = frame_.payload_->reserveSingleSlice(copied_length);
+      unmaskPayload(frame_.masking_key_.value(), frame_.payload_->length(), mem,
+                    static_cast<uint8_t*>(reservation.slice().mem_), copied_length);
+      reservation.commit(copied_length);
+    } else {
+      frame_.payload_->add(mem, copied_length);
+    }
   }
 }
 
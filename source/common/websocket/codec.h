@@ -68,6 +68,16 @@ struct Frame {
   Buffer::InstancePtr payload_;
 };
 
+// Unmasks (or masks) payload bytes as described in
+// https://datatracker.ietf.org/doc/html/rfc6455#section-5.3, 8 bytes at a time.
+// @param masking_key supplies the masking key of the frame, as in Frame::masking_key_.
+// @param offset supplies the offset of the bytes in the payload of the frame.
+// @param input supplies the bytes to unmask.
+// @param output supplies where to write the unmasked bytes, which may be input.
+// @param length supplies the number of bytes to unmask.
+void unmaskPayload(uint32_t masking_key, uint64_t offset, const uint8_t* input, uint8_t* output,
+                   uint64_t length);
+
 // Encoder encodes in memory WebSocket frames into frames in the wire format
 class Encoder : public Logger::Loggable<Logger::Id::websocket> {
 public:
@@ -79,11 +89,17 @@ public:
   absl::optional<std::vector<uint8_t>> encodeFrameHeader(const Frame& frame);
 };
 
-// Decoder decodes bytes in input buffer into in-memory WebSocket frames.
+// Decoder decodes bytes in input buffer into in-memory WebSocket frames. With a max_payload_length
+// of 0, only the frame headers are decoded: the payloads are skipped without being copied, so that
+// the frames of a connection can be inspected while its bytes are proxied as they are.
 class Decoder : public Logger::Loggable<Logger::Id::websocket> {
 public:
-  Decoder(uint64_t max_payload_length = 0)
-      : max_payload_buffer_length_{std::min(max_payload_length, kMaxPayloadBufferLength)} {};
+  // @param max_payload_length supplies the maximum number of payload bytes copied per frame.
+  // @param unmask_payload supplies whether the copied payload bytes of the masked frames are
+  //        unmasked, otherwise they are copied masked.
+  Decoder(uint64_t max_payload_length = 0, bool unmask_payload = false)
+      : max_payload_buffer_length_{std::min(max_payload_length, kMaxPayloadBufferLength)},
+        unmask_payload_(unmask_payload) {};
   // Decodes the given buffer into WebSocket frames. If the input is not sufficient to make a
   // complete WebSocket frame, then the decoder saves the state of halfway decoded WebSocket
   // frame until the next decode calls feed rest of the frame data.
@@ -123,6 +139,7 @@ private:
     FrameFinished
   };
   uint64_t max_payload_buffer_length_;
+  const bool unmask_payload_;
   // Current frame that is being decoded.
   Frame frame_;
   State state_ = State::FrameHeaderFlagsAndOpcode;
@@ -1,5 +1,7 @@
 #include "source/extensions/access_loggers/common/file_access_log_impl.h"
 
+#include "source/common/protobuf/utility.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace AccessLoggers {
@@ -7,16 +9,40 @@ namespace File {
 
 FileAccessLog::FileAccessLog(const Filesystem::FilePathAndType& access_log_file_info,
                              AccessLog::FilterPtr&& filter, Formatter::FormatterPtr&& formatter,
-                             AccessLog::AccessLogManager& log_manager)
-    : ImplBase(std::move(filter)), formatter_(std::move(formatter)) {
+                             AccessLog::AccessLogManager& log_manager,
+                             absl::optional<uint64_t> format_key)
+    : ImplBase(std::move(filter)), formatter_(std::move(formatter)), format_key_(format_key) {
   auto file_or_error = log_manager.createAccessLog(access_log_file_info);
   THROW_IF_NOT_OK_REF(file_or_error.status());
   log_file_ = file_or_error.value();
 }
 
+absl::optional<uint64_t> FileAccessLog::formatKey(
+    const envoy::config::core::v3::SubstitutionFormatString& format_config,
+    bool has_command_parsers) {
+  if (has_command_parsers || format_config.text_format_source().specifier_case() ==
+                                 envoy::config::core::v3::DataSource::kFilename) {
+    return absl::nullopt;
+  }
+  return MessageUtil::hash(format_config);
+}
+
 void FileAccessLog::emitLog(const Formatter::Context& context,
                             const StreamInfo::StreamInfo& stream_info) {
-  log_file_->write(formatter_->format(context, stream_info));
+  OptRef<Formatter::FormattedLines> formatted_lines = context.formattedLines();
+  if (!format_key_.has_value() || !formatted_lines.has_value()) {
+    log_file_->write(formatter_->format(context, stream_info));
+    return;
+  }
+
+  for (const auto& [key, line] : *formatted_lines) {
+    if (key == *format_key_) {
+      log_file_->write(line);
+      return;
+    }
+  }
+  formatted_lines->emplace_back(*format_key_, formatter_->format(context, stream_info));
+  log_file_->write(formatted_lines->back().second);
 }
 
 } // namespace File
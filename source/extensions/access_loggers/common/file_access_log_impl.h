@@ -1,5 +1,7 @@
 #pragma once
 
+#include "envoy/config/core/v3/substitution_format_string.pb.h"
+
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/extensions/access_loggers/common/access_log_base.h"
 
@@ -13,9 +15,25 @@ namespace File {
  */
 class FileAccessLog : public Common::ImplBase {
 public:
+  /**
+   * @param format_key supplies the key of the format, shared by the loggers producing the same
+   * lines for an event so that they format them once, or nullopt if the lines are not shared.
+   */
   FileAccessLog(const Filesystem::FilePathAndType& access_log_file_info,
                 AccessLog::FilterPtr&& filter, Formatter::FormatterPtr&& formatter,
-                AccessLog::AccessLogManager& log_manager);
+                AccessLog::AccessLogManager& log_manager,
+                absl::optional<uint64_t> format_key = absl::nullopt);
+
+  /**
+   * @return the key of a format, for the loggers producing the same lines to share them, or
+   * nullopt if the lines depend on more than the configuration of the format, i.e. on command
+   * parsers added by the owner of the logger or on the content of a file.
+   * @param format_config supplies the format, empty for the default one.
+   * @param has_command_parsers supplies whether command parsers are added to the format.
+   */
+  static absl::optional<uint64_t>
+  formatKey(const envoy::config::core::v3::SubstitutionFormatString& format_config,
+            bool has_command_parsers);
 
 private:
   // Common::ImplBase
@@ -24,6 +42,7 @@ private:
 
   AccessLog::AccessLogFileSharedPtr log_file_;
   Formatter::FormatterPtr formatter_;
+  const absl::optional<uint64_t> format_key_;
 };
 
 } // namespace File
@@ -18,7 +18,12 @@ createStreamAccessLogInstance(const Protobuf::Message& config, AccessLog::Filter
   const auto& fal_config =
       MessageUtil::downcastAndValidate<const T&>(config, context.messageValidationVisitor());
   Formatter::FormatterPtr formatter;
+  // The format of the logger, empty for the default one, so that its lines are shared with the
+  // other loggers using it. Whether there are command parsers is checked before they are moved.
+  const bool has_command_parsers = !command_parsers.empty();
+  envoy::config::core::v3::SubstitutionFormatString format_config;
   if (fal_config.access_log_format_case() == T::AccessLogFormatCase::kLogFormat) {
+    format_config = fal_config.log_format();
     formatter =
         THROW_OR_RETURN_VALUE(Formatter::SubstitutionFormatStringUtils::fromProtoConfig(
                                   fal_config.log_format(), context, std::move(command_parsers)),
@@ -32,7 +37,8 @@ createStreamAccessLogInstance(const Protobuf::Message& config, AccessLog::Filter
   Filesystem::FilePathAndType file_info{destination_type, ""};
   return std::make_shared<AccessLoggers::File::FileAccessLog>(
       file_info, std::move(filter), std::move(formatter),
-      context.serverFactoryContext().accessLogManager());
+      context.serverFactoryContext().accessLogManager(),
+      AccessLoggers::File::FileAccessLog::formatKey(format_config, has_command_parsers));
 }
 
 } // namespace AccessLoggers
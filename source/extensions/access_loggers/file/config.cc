@@ -27,6 +27,10 @@ AccessLog::InstanceSharedPtr FileAccessLogFactory::createAccessLogInstance(
       const envoy::extensions::access_loggers::file::v3::FileAccessLog&>(
       config, context.messageValidationVisitor());
   Formatter::FormatterPtr formatter;
+  // The format of the logger, empty for the default one, so that its lines are shared with the
+  // other loggers using it. Whether there are command parsers is checked before they are moved.
+  const bool has_command_parsers = !command_parsers.empty();
+  envoy::config::core::v3::SubstitutionFormatString format_config;
 
   switch (fal_config.access_log_format_case()) {
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::kFormat:
@@ -35,27 +39,27 @@ AccessLog::InstanceSharedPtr FileAccessLogFactory::createAccessLogInstance(
           Formatter::HttpSubstitutionFormatUtils::defaultSubstitutionFormatter(),
           Formatter::FormatterPtr);
     } else {
-      envoy::config::core::v3::SubstitutionFormatString sff_config;
-      sff_config.mutable_text_format_source()->set_inline_string(fal_config.format());
+      format_config.mutable_text_format_source()->set_inline_string(fal_config.format());
       formatter = THROW_OR_RETURN_VALUE(Formatter::SubstitutionFormatStringUtils::fromProtoConfig(
-                                            sff_config, context, std::move(command_parsers)),
+                                            format_config, context, std::move(command_parsers)),
                                         Formatter::FormatterPtr);
     }
     break;
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::kJsonFormat:
+    *format_config.mutable_json_format() = fal_config.json_format();
     formatter = Formatter::SubstitutionFormatStringUtils::createJsonFormatter(
         fal_config.json_format(), false, command_parsers);
     break;
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::
       kTypedJsonFormat: {
-    envoy::config::core::v3::SubstitutionFormatString sff_config;
-    *sff_config.mutable_json_format() = fal_config.typed_json_format();
+    *format_config.mutable_json_format() = fal_config.typed_json_format();
     formatter = THROW_OR_RETURN_VALUE(Formatter::SubstitutionFormatStringUtils::fromProtoConfig(
-                                          sff_config, context, std::move(command_parsers)),
+                                          format_config, context, std::move(command_parsers)),
                                       Formatter::FormatterPtr);
     break;
   }
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::kLogFormat:
+    format_config = fal_config.log_format();
     formatter =
         THROW_OR_RETURN_VALUE(Formatter::SubstitutionFormatStringUtils::fromProtoConfig(
                                   fal_config.log_format(), context, std::move(command_parsers)),
@@ -70,8 +74,10 @@ AccessLog::InstanceSharedPtr FileAccessLogFactory::createAccessLogInstance(
   }
 
   Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, fal_config.path()};
-  return std::make_shared<FileAccessLog>(file_info, std::move(filter), std::move(formatter),
-                                         context.serverFactoryContext().accessLogManager());
+  return std::make_shared<FileAccessLog>(
+      file_info, std::move(filter), std::move(formatter),
+      context.serverFactoryContext().accessLogManager(),
+      FileAccessLog::formatKey(format_config, has_command_parsers));
 }
 
 ProtobufTypes::MessagePtr FileAccessLogFactory::createEmptyConfigProto() {
@@ -64,13 +64,13 @@ void AccessLog::emitLog(const Formatter::Context& log_context,
                                    stream_info.startTime().time_since_epoch())
                                    .count());
 
-  // Unpacks the body "KeyValueList" to "AnyValue".
+  // Unpacks the body "KeyValueList" to "AnyValue". The formatted values are moved into the entry
+  // rather than copied, as they are built for it only.
   if (body_formatter_) {
-    const auto formatted_body = unpackBody(body_formatter_->format(log_context, stream_info));
-    *log_entry.mutable_body() = formatted_body;
+    *log_entry.mutable_body() = unpackBody(body_formatter_->format(log_context, stream_info));
   }
-  const auto formatted_attributes = attributes_formatter_->format(log_context, stream_info);
-  *log_entry.mutable_attributes() = formatted_attributes.values();
+  auto formatted_attributes = attributes_formatter_->format(log_context, stream_info);
+  log_entry.mutable_attributes()->Swap(formatted_attributes.mutable_values());
 
   // Sets trace context (trace_id, span_id) if available.
   const std::string trace_id_hex =
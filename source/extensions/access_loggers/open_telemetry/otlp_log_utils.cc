@@ -41,6 +41,12 @@ unpackBody(const ::opentelemetry::proto::common::v1::KeyValueList& value) {
   return value.values(0).value();
 }
 
+::opentelemetry::proto::common::v1::AnyValue
+unpackBody(::opentelemetry::proto::common::v1::KeyValueList&& value) {
+  ASSERT(value.values().size() == 1 && value.values(0).key() == BodyKey);
+  return std::move(*value.mutable_values(0)->mutable_value());
+}
+
 // User-Agent header follows the OTLP specification:
 // https://github.com/open-telemetry/opentelemetry-specification/blob/v1.52.0/specification/protocol/exporter.md#user-agent
 const std::string& getOtlpUserAgentHeader() {
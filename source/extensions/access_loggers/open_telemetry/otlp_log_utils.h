@@ -61,6 +61,11 @@ packBody(const ::opentelemetry::proto::common::v1::AnyValue& body);
 ::opentelemetry::proto::common::v1::AnyValue
 unpackBody(const ::opentelemetry::proto::common::v1::KeyValueList& value);
 
+// Unpacks the body "AnyValue" from a "KeyValueList" which is no longer needed, moving the value
+// out of it rather than copying it.
+::opentelemetry::proto::common::v1::AnyValue
+unpackBody(::opentelemetry::proto::common::v1::KeyValueList&& value);
+
 // User-Agent header per OTLP specification.
 const std::string& getOtlpUserAgentHeader();
 
@@ -504,14 +504,17 @@ void ReverseConnectionIOHandle::maintainClusterConnections(
             "connections per host",
             cluster_name, cluster_config.reverse_connection_count);
 
-  // Generate a temporary connection key for early failure tracking, to update stats gauges.
-  const std::string temp_connection_key = "temp_" + cluster_name + "_" + std::to_string(rand());
+  // Generate a temporary connection key for early failure tracking, to update stats gauges. Only
+  // generated on failure, the maintenance running periodically for every cluster.
+  const auto temp_connection_key = [&cluster_name]() {
+    return "temp_" + cluster_name + "_" + std::to_string(rand());
+  };
 
   // Get thread local cluster to access resolved hosts.
   auto thread_local_cluster = cluster_manager_.getThreadLocalCluster(cluster_name);
   if (thread_local_cluster == nullptr) {
     ENVOY_LOG(error, "Cluster '{}' not found for reverse tunnel - will retry later", cluster_name);
-    updateConnectionState("", cluster_name, temp_connection_key,
+    updateConnectionState("", cluster_name, temp_connection_key(),
                           ReverseConnectionState::CannotConnect);
     return;
   }
@@ -519,7 +522,7 @@ void ReverseConnectionIOHandle::maintainClusterConnections(
   const auto& host_map_ptr = thread_local_cluster->prioritySet().crossPriorityHostMap();
   if (host_map_ptr == nullptr || host_map_ptr->empty()) {
     ENVOY_LOG(error, "No hosts found in cluster '{}' - will retry later", cluster_name);
-    updateConnectionState("", cluster_name, temp_connection_key,
+    updateConnectionState("", cluster_name, temp_connection_key(),
                           ReverseConnectionState::CannotConnect);
     return;
   }
@@ -566,10 +569,11 @@ void ReverseConnectionIOHandle::maintainClusterConnections(
       continue;
     }
     // Get current number of successful connections to this host.
-    uint32_t current_connections = host_to_conn_info_map_[key].connection_keys.size();
-    uint32_t pending_connections = host_to_conn_info_map_[key].connecting_count;
+    const HostConnectionInfo& host_info = host_to_conn_info_map_[key];
+    uint32_t current_connections = host_info.connection_keys.size();
+    const uint32_t pending_connections = host_info.connecting_count;
 
-    ENVOY_LOG(info,
+    ENVOY_LOG(debug,
               "reverse_tunnel: Number of reverse connections to host {} of cluster {}: "
               "Current: {}, Pending: {}, Required: {}",
               host_address, cluster_name, current_connections, pending_connections,
@@ -610,7 +614,7 @@ void ReverseConnectionIOHandle::maintainClusterConnections(
   }
   // Update metrics based on overall success for the cluster.
   if (total_successful_connections > 0) {
-    ENVOY_LOG(info,
+    ENVOY_LOG(debug,
               "reverse_tunnel: Successfully created {}/{} total reverse connections to "
               "cluster {}",
               total_successful_connections, total_required_connections, cluster_name);
@@ -322,11 +322,51 @@ absl::Status Cluster::onDnsHostAddOrUpdate(
   RETURN_IF_NOT_OK(addOrUpdateHost(host, host_info, hosts_added));
   if (hosts_added != nullptr) {
     ASSERT(!hosts_added->empty());
-    updatePriorityState(*hosts_added, {});
+    queuePriorityStateUpdate(*hosts_added, {});
   }
   return absl::OkStatus();
 }
 
+void Cluster::queuePriorityStateUpdate(const Upstream::HostVector& hosts_added,
+                                       const Upstream::HostVector& hosts_removed) {
+  if (!Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.dfp_cluster_batch_host_updates")) {
+    updatePriorityState(hosts_added, hosts_removed);
+    return;
+  }
+
+  ASSERT(main_thread_dispatcher_.isThreadSafe());
+  pending_hosts_added_.insert(pending_hosts_added_.end(), hosts_added.begin(), hosts_added.end());
+  for (const auto& host : hosts_removed) {
+    // A host added and removed before the update is flushed is not reported at all.
+    const auto it = std::find(pending_hosts_added_.begin(), pending_hosts_added_.end(), host);
+    if (it != pending_hosts_added_.end()) {
+      pending_hosts_added_.erase(it);
+    } else {
+      pending_hosts_removed_.push_back(host);
+    }
+  }
+  if (!priority_state_update_posted_) {
+    priority_state_update_posted_ = true;
+    main_thread_dispatcher_.post([this, still_alive = std::weak_ptr<bool>(still_alive_)]() {
+      if (still_alive.lock()) {
+        flushPriorityStateUpdate();
+      }
+    });
+  }
+}
+
+void Cluster::flushPriorityStateUpdate() {
+  priority_state_update_posted_ = false;
+  const Upstream::HostVector hosts_added = std::move(pending_hosts_added_);
+  const Upstream::HostVector hosts_removed = std::move(pending_hosts_removed_);
+  pending_hosts_added_.clear();
+  pending_hosts_removed_.clear();
+  if (!hosts_added.empty() || !hosts_removed.empty()) {
+    updatePriorityState(hosts_added, hosts_removed);
+  }
+}
+
 void Cluster::updatePriorityState(const Upstream::HostVector& hosts_added,
                                   const Upstream::HostVector& hosts_removed) {
   Upstream::PriorityStateManager priority_state_manager(*this, local_info_, nullptr);
@@ -353,7 +393,7 @@ void Cluster::onDnsHostRemove(const std::string& host) {
     host_map_.erase(host);
     ENVOY_LOG(debug, "removing dfproxy cluster host '{}'", host);
   }
-  updatePriorityState({}, hosts_removed);
+  queuePriorityStateUpdate({}, hosts_removed);
 }
 
 Upstream::HostSelectionResponse
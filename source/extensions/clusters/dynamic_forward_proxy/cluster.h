@@ -216,6 +216,12 @@ private:
                            const Upstream::HostVector& hosts_removed)
       ABSL_LOCKS_EXCLUDED(host_map_lock_);
 
+  // Queues a priority state update, so that the hosts added or removed by the DNS cache in the same
+  // main thread event loop iteration are propagated to the workers with a single update.
+  void queuePriorityStateUpdate(const Upstream::HostVector& hosts_added,
+                                const Upstream::HostVector& hosts_removed);
+  void flushPriorityStateUpdate();
+
   const Extensions::Common::DynamicForwardProxy::DnsCacheManagerSharedPtr dns_cache_manager_;
   const Extensions::Common::DynamicForwardProxy::DnsCacheSharedPtr dns_cache_;
   const Extensions::Common::DynamicForwardProxy::DnsCache::AddUpdateCallbacksHandlePtr
@@ -234,6 +240,12 @@ private:
   mutable absl::Mutex host_map_lock_;
   HostInfoMap host_map_ ABSL_GUARDED_BY(host_map_lock_);
 
+  // The queued priority state update, only accessed from the main thread.
+  Upstream::HostVector pending_hosts_added_;
+  Upstream::HostVector pending_hosts_removed_;
+  bool priority_state_update_posted_{false};
+  const std::shared_ptr<bool> still_alive_{std::make_shared<bool>(true)};
+
   mutable absl::Mutex cluster_map_lock_;
   ClusterInfoMap cluster_map_ ABSL_GUARDED_BY(cluster_map_lock_);
 
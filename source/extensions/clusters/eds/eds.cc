@@ -32,11 +32,16 @@ EdsClusterImpl::EdsClusterImpl(const envoy::config::cluster::v3::Cluster& cluste
       Envoy::Config::SubscriptionBase<envoy::config::endpoint::v3::ClusterLoadAssignment>(
           cluster_context.messageValidationVisitor(), "cluster_name"),
       local_info_(cluster_context.serverFactoryContext().localInfo()),
+      update_coalescing_window_(PROTOBUF_GET_MS_OR_DEFAULT(cluster.eds_cluster_config(),
+                                                           update_coalescing_window, 0)),
       eds_resources_cache_(
           cluster_context.serverFactoryContext().clusterManager().edsResourcesCache()) {
   RETURN_ONLY_IF_NOT_OK_REF(creation_status);
   Event::Dispatcher& dispatcher = cluster_context.serverFactoryContext().mainThreadDispatcher();
   assignment_timeout_ = dispatcher.createTimer([this]() -> void { onAssignmentTimeout(); });
+  if (update_coalescing_window_.count() > 0) {
+    coalescing_timer_ = dispatcher.createTimer([this]() -> void { onCoalescingWindowEnd(); });
+  }
   const auto& eds_config = cluster.eds_cluster_config().eds_config();
   if (Config::SubscriptionFactory::isPathBasedConfigSource(
           eds_config.config_source_specifier_case())) {
@@ -229,6 +234,38 @@ EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& re
     }
   }
 
+  if (coalescing_timer_ != nullptr && coalescing_timer_->enabled()) {
+    // Parse the drop overload config now, so that invalid updates are still rejected rather than
+    // failing when the window ends. It takes effect when the update is applied.
+    const UnitFloat drop_overload = dropOverload();
+    const std::string drop_category = dropCategory();
+    const absl::Status status = parseDropOverloadConfig(cluster_load_assignment);
+    setDropOverload(drop_overload);
+    setDropCategory(drop_category);
+    RETURN_IF_NOT_OK(status);
+    if (pending_cluster_load_assignment_ != nullptr) {
+      info_->configUpdateStats().update_coalesced_.inc();
+    }
+    ENVOY_LOG(debug, "Coalescing ClusterLoadAssignment update for {}", edsServiceName());
+    pending_cluster_load_assignment_ =
+        std::make_unique<envoy::config::endpoint::v3::ClusterLoadAssignment>(
+            std::move(cluster_load_assignment));
+    return absl::OkStatus();
+  }
+  applyConfigUpdate(cluster_load_assignment);
+  return absl::OkStatus();
+}
+
+void EdsClusterImpl::onCoalescingWindowEnd() {
+  if (pending_cluster_load_assignment_ == nullptr) {
+    return;
+  }
+  const auto cluster_load_assignment = std::move(pending_cluster_load_assignment_);
+  applyConfigUpdate(*cluster_load_assignment);
+}
+
+void EdsClusterImpl::applyConfigUpdate(
+    const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment) {
   // Disable timer (if enabled) as we have received new assignment.
   if (assignment_timeout_->enabled()) {
     assignment_timeout_->disableTimer();
@@ -262,7 +299,9 @@ EdsClusterImpl::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& re
     eds_resources_cache_->removeCallback(edsServiceName(), this);
     using_cached_resource_ = false;
   }
-  return absl::OkStatus();
+  if (coalescing_timer_ != nullptr) {
+    coalescing_timer_->enableTimer(update_coalescing_window_);
+  }
 }
 
 void EdsClusterImpl::update(
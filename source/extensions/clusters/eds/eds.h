@@ -72,6 +72,12 @@ private:
   // Updates the internal data structures with a given cluster load assignment.
   void update(const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment);
 
+  // Applies a validated cluster load assignment received from the subscription, and starts the
+  // coalescing window if one is configured.
+  void applyConfigUpdate(
+      const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment);
+  void onCoalescingWindowEnd();
+
   // EdsResourceRemovalCallback
   void onCachedResourceRemoved(absl::string_view resource_name) override;
 
@@ -108,6 +114,12 @@ private:
   const LocalInfo::LocalInfo& local_info_;
   std::vector<LocalityWeightsMap> locality_weights_map_;
   Event::TimerPtr assignment_timeout_;
+  const std::chrono::milliseconds update_coalescing_window_;
+  // Enabled while updates are being coalesced.
+  Event::TimerPtr coalescing_timer_;
+  // The most recent update received during the coalescing window, applied when it ends.
+  std::unique_ptr<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      pending_cluster_load_assignment_;
   InitializePhase initialize_phase_;
   using LedsConfigSet = absl::flat_hash_set<envoy::config::endpoint::v3::LedsClusterLocalityConfig,
                                             MessageUtil, MessageUtil>;
@@ -1,5 +1,7 @@
 #include "source/extensions/clusters/redis/crc16.h"
 
+#include <array>
+
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -14,7 +16,7 @@ namespace Redis {
  * @param key The string to hash.
  * @return The CRC16 hash code.
  */
-static const uint16_t crc16tab[256] = {
+constexpr uint16_t crc16tab[256] = {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7, 0x8108, 0x9129, 0xa14a, 0xb16b,
     0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210, 0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6,
     0x9339, 0x8318, 0xb37b, 0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de, 0x2462, 0x3443, 0x0420, 0x1401,
@@ -38,12 +40,40 @@ static const uint16_t crc16tab[256] = {
     0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36, 0x4e55, 0x5e74,
     0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
 
+using Crc16Tables = std::array<std::array<uint16_t, 256>, 8>;
+
+// The tables of the slicing-by-8 implementation: tables[k][b] is the CRC16 of the byte b followed
+// by k zero bytes.
+constexpr Crc16Tables makeCrc16Tables() {
+  Crc16Tables tables{};
+  for (uint32_t b = 0; b < 256; b++) {
+    tables[0][b] = crc16tab[b];
+  }
+  for (uint32_t k = 1; k < tables.size(); k++) {
+    for (uint32_t b = 0; b < 256; b++) {
+      const uint16_t previous = tables[k - 1][b];
+      tables[k][b] = static_cast<uint16_t>(previous << 8) ^ crc16tab[previous >> 8];
+    }
+  }
+  return tables;
+}
+
+constexpr Crc16Tables crc16_tables = makeCrc16Tables();
+
 uint16_t Crc16::crc16(absl::string_view key) {
-  const char* buf = static_cast<const char*>(key.data());
+  const uint8_t* buf = reinterpret_cast<const uint8_t*>(key.data());
   uint64_t len = key.size();
-  uint64_t counter;
   uint16_t crc = 0;
-  for (counter = 0; counter < len; counter++) {
+  // The CRC being linear, the CRC of 8 bytes is the xor of the CRCs of each byte followed by the
+  // bytes after it, the first two bytes being xored with the CRC of the bytes before them.
+  while (len >= 8) {
+    crc = crc16_tables[7][buf[0] ^ (crc >> 8)] ^ crc16_tables[6][buf[1] ^ (crc & 0x00FF)] ^
+          crc16_tables[5][buf[2]] ^ crc16_tables[4][buf[3]] ^ crc16_tables[3][buf[4]] ^
+          crc16_tables[2][buf[5]] ^ crc16_tables[1][buf[6]] ^ crc16_tables[0][buf[7]];
+    buf += 8;
+    len -= 8;
+  }
+  for (; len > 0; len--) {
     crc = (crc << 8) ^ crc16tab[((crc >> 8) ^ *buf++) & 0x00FF];
   }
   return crc;
@@ -1,11 +1,15 @@
 #include "source/extensions/common/async_files/async_file_context_thread_pool.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/common/async_files/async_file_action.h"
 #include "source/extensions/common/async_files/async_file_context_base.h"
@@ -138,6 +142,57 @@ private:
   const size_t length_;
 };
 
+class ActionMapReadFile : public AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>> {
+public:
+  ActionMapReadFile(AsyncFileHandle handle, off_t offset, size_t length,
+                    absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete)
+      : AsyncFileActionThreadPool<absl::StatusOr<Buffer::InstancePtr>>(handle,
+                                                                       std::move(on_complete)),
+        offset_(offset), length_(length) {}
+
+  absl::StatusOr<Buffer::InstancePtr> executeImpl() override {
+    ASSERT(fileDescriptor() != -1);
+    auto result = std::make_unique<Buffer::OwnedImpl>();
+    // The length is clamped to the size of the file, as touching a mapped page entirely past its
+    // end raises SIGBUS.
+    struct stat stat_result;
+    auto stat_status = posix().fstat(fileDescriptor(), &stat_result);
+    if (stat_status.return_value_ != 0) {
+      return statusAfterFileError(stat_status);
+    }
+    if (offset_ >= stat_result.st_size || length_ == 0) {
+      return result;
+    }
+    const size_t length = std::min<uint64_t>(length_, stat_result.st_size - offset_);
+    // The offset of a mapping must be a multiple of the page size.
+    static const off_t page_size = ::sysconf(_SC_PAGESIZE);
+    const off_t map_offset = offset_ - offset_ % page_size;
+    const size_t map_length = length + (offset_ - map_offset);
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    // Faults the pages in on this thread rather than on the worker which sends them.
+    flags |= MAP_POPULATE;
+#endif
+    auto mapped =
+        posix().mmap(nullptr, map_length, PROT_READ, flags, fileDescriptor(), map_offset);
+    if (mapped.return_value_ == MAP_FAILED) {
+      return statusAfterFileError(mapped);
+    }
+    result->addBufferFragment(*new Buffer::BufferFragmentImpl(
+        static_cast<const char*>(mapped.return_value_) + (offset_ - map_offset), length,
+        [addr = mapped.return_value_, map_length](const void*, size_t,
+                                                  const Buffer::BufferFragmentImpl* fragment) {
+          Api::OsSysCallsSingleton::get().munmap(addr, map_length);
+          delete fragment;
+        }));
+    return result;
+  }
+
+private:
+  const off_t offset_;
+  const size_t length_;
+};
+
 class ActionWriteFile : public AsyncFileActionThreadPool<absl::StatusOr<size_t>> {
 public:
   ActionWriteFile(AsyncFileHandle handle, Buffer::Instance& contents, off_t offset,
@@ -248,6 +303,13 @@ absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::read(
                                                                           std::move(on_complete)));
 }
 
+absl::StatusOr<CancelFunction> AsyncFileContextThreadPool::mapRead(
+    Event::Dispatcher* dispatcher, off_t offset, size_t length,
+    absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) {
+  return checkFileAndEnqueue(dispatcher, std::make_unique<ActionMapReadFile>(
+                                             handle(), offset, length, std::move(on_complete)));
+}
+
 absl::StatusOr<CancelFunction>
 AsyncFileContextThreadPool::write(Event::Dispatcher* dispatcher, Buffer::Instance& contents,
                                   off_t offset,
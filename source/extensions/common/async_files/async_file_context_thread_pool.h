@@ -37,6 +37,9 @@ public:
   read(Event::Dispatcher* dispatcher, off_t offset, size_t length,
        absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
   absl::StatusOr<CancelFunction>
+  mapRead(Event::Dispatcher* dispatcher, off_t offset, size_t length,
+          absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) override;
+  absl::StatusOr<CancelFunction>
   write(Event::Dispatcher* dispatcher, Buffer::Instance& contents, off_t offset,
         absl::AnyInvocable<void(absl::StatusOr<size_t>)> on_complete) override;
   absl::StatusOr<CancelFunction>
@@ -52,6 +52,15 @@ public:
   read(Event::Dispatcher* dispatcher, off_t offset, size_t length,
        absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
 
+  // Like read, but the buffer passed to on_complete references a read-only shared memory mapping
+  // of the file rather than a copy of its contents, the mapping being released when the buffer
+  // drains the data. The mapped range must not be truncated while the buffer is alive, as reading
+  // a page past the end of the file is fatal. There must not already be an action queued for this
+  // handle.
+  virtual absl::StatusOr<CancelFunction>
+  mapRead(Event::Dispatcher* dispatcher, off_t offset, size_t length,
+          absl::AnyInvocable<void(absl::StatusOr<Buffer::InstancePtr>)> on_complete) PURE;
+
   // Enqueues an action to write to the currently open file, at position offset, the bytes contained
   // by contents. It is an error to call write on an AsyncFileContext that does not have a file
   // open.
@@ -123,13 +123,15 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
             is_proxy_lookup ? "proxy mode " : "");
   ThreadLocalHostInfo& tls_host_info = *tls_slot_;
 
-  bool is_overflow = false;
   absl::optional<DnsHostInfoSharedPtr> host_info = absl::nullopt;
   bool ignore_cached_entries = force_refresh;
 
-  {
+  const auto resolved_host = tls_host_info.resolved_hosts_.find(host);
+  if (resolved_host != tls_host_info.resolved_hosts_.end()) {
+    host_info = resolved_host->second;
+  } else {
+    // The host may not have been propagated to this thread yet.
     absl::ReaderMutexLock read_lock{primary_hosts_lock_};
-    is_overflow = primary_hosts_.size() >= max_hosts_;
     auto tls_host = primary_hosts_.find(host);
     if (tls_host != primary_hosts_.end() && tls_host->second->host_info_->firstResolveComplete()) {
       host_info = tls_host->second->host_info_;
@@ -152,7 +154,7 @@ DnsCacheImpl::loadDnsCacheEntryWithForceRefresh(absl::string_view raw_host, uint
       return {LoadDnsCacheEntryStatus::InCache, nullptr, host_info};
     }
   }
-  if (is_overflow) {
+  if (num_primary_hosts_ >= max_hosts_) {
     ENVOY_LOG(debug, "DNS cache overflow for host '{}'", host);
     stats_.host_overflow_.inc();
     return {LoadDnsCacheEntryStatus::Overflow, nullptr, absl::nullopt};
@@ -253,15 +255,18 @@ DnsCacheImpl::PrimaryHostInfo* DnsCacheImpl::createHost(const std::string& host,
   // matter, but we could consider collapsing these down and sharing the underlying DNS resolution.
   {
     absl::WriterMutexLock writer_lock{primary_hosts_lock_};
-    return primary_hosts_
-        // try_emplace() is used here for direct argument forwarding.
-        .try_emplace(host,
-                     std::make_unique<PrimaryHostInfo>(
-                         *this, std::string(host_attributes.host_),
-                         host_attributes.port_.value_or(default_port),
-                         host_attributes.is_ip_address_, [this, host]() { onReResolveAlarm(host); },
-                         [this, host]() { onResolveTimeout(host); }))
-        .first->second.get();
+    auto* primary_host =
+        primary_hosts_
+            // try_emplace() is used here for direct argument forwarding.
+            .try_emplace(host, std::make_unique<PrimaryHostInfo>(
+                                   *this, std::string(host_attributes.host_),
+                                   host_attributes.port_.value_or(default_port),
+                                   host_attributes.is_ip_address_,
+                                   [this, host]() { onReResolveAlarm(host); },
+                                   [this, host]() { onResolveTimeout(host); }))
+            .first->second.get();
+    num_primary_hosts_ = primary_hosts_.size();
+    return primary_host;
   }
 }
 
@@ -321,11 +326,16 @@ void DnsCacheImpl::removeHost(const std::string& host, const PrimaryHostInfo& pr
     ASSERT(host_it != primary_hosts_.end());
     host_to_erase = std::move(host_it->second);
     primary_hosts_.erase(host_it);
+    num_primary_hosts_ = primary_hosts_.size();
   }
   // In the case of force-remove and resolve, don't cancel outstanding resolve
   // callbacks on remove, as a resolve is pending.
   if (update_threads) {
-    notifyThreads(host, primary_host.host_info_);
+    notifyThreads(host, primary_host.host_info_, true);
+  } else {
+    tls_slot_.runOnAllThreads([host](OptRef<ThreadLocalHostInfo> local_host_info) {
+      local_host_info->resolved_hosts_.erase(host);
+    });
   }
 }
 
@@ -594,8 +604,8 @@ void DnsCacheImpl::runRemoveCallbacks(const std::string& host) {
 }
 
 void DnsCacheImpl::notifyThreads(const std::string& host,
-                                 const DnsHostInfoImplSharedPtr& resolved_info) {
-  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info);
+                                 const DnsHostInfoImplSharedPtr& resolved_info, bool removed) {
+  auto shared_info = std::make_shared<HostMapUpdateInfo>(host, resolved_info, removed);
   tls_slot_.runOnAllThreads([shared_info](OptRef<ThreadLocalHostInfo> local_host_info) {
     local_host_info->onHostMapUpdate(shared_info);
   });
@@ -612,6 +622,12 @@ DnsCacheImpl::ThreadLocalHostInfo::~ThreadLocalHostInfo() {
 
 void DnsCacheImpl::ThreadLocalHostInfo::onHostMapUpdate(
     const HostMapUpdateInfoSharedPtr& resolved_host) {
+  if (resolved_host->removed_) {
+    resolved_hosts_.erase(resolved_host->host_);
+  } else {
+    resolved_hosts_.insert_or_assign(resolved_host->host_, resolved_host->info_);
+  }
+
   auto host_it = pending_resolutions_.find(resolved_host->host_);
   if (host_it != pending_resolutions_.end()) {
     // Calling the onLoadDnsCacheComplete may trigger more host resolutions adding more elements
@@ -93,10 +93,12 @@ private:
   using DnsHostInfoImplSharedPtr = std::shared_ptr<DnsHostInfoImpl>;
 
   struct HostMapUpdateInfo {
-    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info)
-        : host_(host), info_(std::move(info)) {}
+    HostMapUpdateInfo(const std::string& host, DnsHostInfoImplSharedPtr info, bool removed)
+        : host_(host), info_(std::move(info)), removed_(removed) {}
     std::string host_;
     DnsHostInfoImplSharedPtr info_;
+    // Whether the host was removed from the cache, rather than resolved.
+    bool removed_;
   };
   using HostMapUpdateInfoSharedPtr = std::shared_ptr<HostMapUpdateInfo>;
 
@@ -106,6 +108,9 @@ private:
     ~ThreadLocalHostInfo() override;
     void onHostMapUpdate(const HostMapUpdateInfoSharedPtr& resolved_info);
     absl::flat_hash_map<std::string, std::list<LoadDnsCacheEntryHandleImpl*>> pending_resolutions_;
+    // The hosts which completed their first resolution, as propagated by notifyThreads(). They are
+    // looked up here first so that the cache hits do not contend on the primary hosts lock.
+    absl::flat_hash_map<std::string, DnsHostInfoImplSharedPtr> resolved_hosts_;
     DnsCacheImpl& parent_;
   };
 
@@ -194,7 +199,8 @@ private:
                                       const DnsHostInfoSharedPtr& host_info,
                                       Network::DnsResolver::ResolutionStatus status);
   void runRemoveCallbacks(const std::string& host);
-  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info);
+  void notifyThreads(const std::string& host, const DnsHostInfoImplSharedPtr& resolved_info,
+                     bool removed = false);
   void onReResolveAlarm(const std::string& host);
   void removeHost(const std::string& host, const PrimaryHostInfo& host_info, bool update_threads);
   void onResolveTimeout(const std::string& host);
@@ -222,6 +228,8 @@ private:
   absl::Mutex primary_hosts_lock_;
   absl::flat_hash_map<std::string, PrimaryHostInfoPtr>
       primary_hosts_ ABSL_GUARDED_BY(primary_hosts_lock_);
+  // The size of primary_hosts_, readable without the lock for the overflow checks.
+  std::atomic<size_t> num_primary_hosts_{0};
   std::unique_ptr<KeyValueStore> key_value_store_;
   DnsCacheResourceManagerImpl resource_manager_;
   const std::chrono::milliseconds refresh_interval_;
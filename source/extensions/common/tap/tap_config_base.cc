@@ -12,6 +12,7 @@
 #include "source/extensions/common/matcher/matcher.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -100,7 +101,8 @@ TapConfigBaseImpl::TapConfigBaseImpl(const envoy::config::tap::v3::TapConfig& pr
     sink_to_use_ = admin_streamer;
     break;
   case ProtoOutputSink::OutputSinkTypeCase::kFilePerTap:
-    sink_ = std::make_unique<FilePerTapSink>(sinks[0].file_per_tap());
+    sink_ = std::make_unique<FilePerTapSink>(
+        sinks[0].file_per_tap(), context.serverFactoryContext().api().threadFactory());
     sink_to_use_ = sink_.get();
     break;
   case ProtoOutputSink::OutputSinkTypeCase::kCustomSink: {
@@ -228,10 +230,96 @@ void TapConfigBaseImpl::PerTapSinkHandleManagerImpl::submitTrace(TraceWrapperPtr
   handle_->submitTrace(std::move(trace), parent_.sink_format_);
 }
 
+FilePerTapSink::FilePerTapSink(const envoy::config::tap::v3::FilePerTapSink& config,
+                               Thread::ThreadFactory& thread_factory)
+    : config_(config),
+      max_pending_traces_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config_, max_pending_traces, 0)) {
+  if (max_pending_traces_ > 0) {
+    writer_thread_ = thread_factory.createThread([this]() { writerThreadRoutine(); },
+                                                 Thread::Options{"TapFileWriter"});
+  }
+}
+
+FilePerTapSink::~FilePerTapSink() {
+  if (writer_thread_ == nullptr) {
+    return;
+  }
+  {
+    absl::MutexLock lock(mutex_);
+    shutting_down_ = true;
+  }
+  // The pending traces are written before the thread exits.
+  writer_thread_->join();
+}
+
+void FilePerTapSink::enqueue(PendingTrace&& pending_trace) {
+  absl::MutexLock lock(mutex_);
+  if (pending_trace.trace_ != nullptr) {
+    if (pending_trace_count_ >= max_pending_traces_) {
+      ENVOY_LOG_EVERY_POW_2_MISC(warn, "Dropping tap trace for [id={}]: {} traces pending",
+                                 pending_trace.trace_id_, pending_trace_count_);
+      return;
+    }
+    ++pending_trace_count_;
+  }
+  pending_traces_.push_back(std::move(pending_trace));
+}
+
+void FilePerTapSink::writerThreadRoutine() {
+  // The files of the taps that have not ended yet, only used by this thread.
+  absl::flat_hash_map<uint64_t, TapFile> files;
+  std::deque<PendingTrace> pending_traces;
+  while (true) {
+    {
+      absl::MutexLock lock(mutex_);
+      auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return shutting_down_ || !pending_traces_.empty();
+      };
+      mutex_.Await(absl::Condition(&condition));
+      if (pending_traces_.empty()) {
+        ASSERT(shutting_down_);
+        break;
+      }
+      // Takes all the pending traces at once, to write them without holding the lock.
+      pending_traces.swap(pending_traces_);
+      pending_trace_count_ = 0;
+    }
+
+    for (PendingTrace& pending_trace : pending_traces) {
+      if (pending_trace.trace_ == nullptr) {
+        files.erase(pending_trace.trace_id_);
+        continue;
+      }
+      files[pending_trace.trace_id_].write(config_.path_prefix(), pending_trace.trace_id_,
+                                           *pending_trace.trace_, pending_trace.format_);
+    }
+    pending_traces.clear();
+  }
+}
+
+FilePerTapSink::FilePerTapSinkHandle::~FilePerTapSinkHandle() {
+  if (parent_.writer_thread_ != nullptr) {
+    // Has the writer thread close the file once the traces submitted before are written.
+    parent_.enqueue({trace_id_, nullptr, envoy::config::tap::v3::OutputSink::JSON_BODY_AS_BYTES});
+  }
+}
+
 void FilePerTapSink::FilePerTapSinkHandle::submitTrace(
     TraceWrapperPtr&& trace, envoy::config::tap::v3::OutputSink::Format format) {
+  if (parent_.writer_thread_ != nullptr) {
+    // The trace is moved rather than serialized, so that the serialization runs on the writer
+    // thread too.
+    parent_.enqueue({trace_id_, std::move(trace), format});
+    return;
+  }
+  file_.write(parent_.config_.path_prefix(), trace_id_, *trace, format);
+}
+
+void FilePerTapSink::TapFile::write(const std::string& path_prefix, uint64_t trace_id,
+                                    const envoy::data::tap::v3::TraceWrapper& trace,
+                                    envoy::config::tap::v3::OutputSink::Format format) {
   if (!output_file_.is_open()) {
-    std::string path = fmt::format("{}_{}", parent_.config_.path_prefix(), trace_id_);
+    std::string path = fmt::format("{}_{}", path_prefix, trace_id);
     switch (format) {
       PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
     case envoy::config::tap::v3::OutputSink::PROTO_BINARY:
@@ -249,32 +337,32 @@ void FilePerTapSink::FilePerTapSinkHandle::submitTrace(
       break;
     }
 
-    ENVOY_LOG_MISC(debug, "Opening tap file for [id={}] to {}", trace_id_, path);
+    ENVOY_LOG_MISC(debug, "Opening tap file for [id={}] to {}", trace_id, path);
     // When reading and writing binary files, we need to be sure std::ios_base::binary
     // is set, otherwise we will not get the expected results on Windows
     output_file_.open(path, std::ios_base::binary);
   }
 
-  ENVOY_LOG_MISC(trace, "Tap for [id={}]: {}", trace_id_, trace->DebugString());
+  ENVOY_LOG_MISC(trace, "Tap for [id={}]: {}", trace_id, trace.DebugString());
 
   switch (format) {
     PANIC_ON_PROTO_ENUM_SENTINEL_VALUES;
   case envoy::config::tap::v3::OutputSink::PROTO_BINARY:
-    trace->SerializeToOstream(&output_file_);
+    trace.SerializeToOstream(&output_file_);
     break;
   case envoy::config::tap::v3::OutputSink::PROTO_BINARY_LENGTH_DELIMITED: {
     Protobuf::io::OstreamOutputStream stream(&output_file_);
     Protobuf::io::CodedOutputStream coded_stream(&stream);
-    coded_stream.WriteVarint32(trace->ByteSize());
-    trace->SerializeWithCachedSizes(&coded_stream);
+    coded_stream.WriteVarint32(trace.ByteSize());
+    trace.SerializeWithCachedSizes(&coded_stream);
     break;
   }
   case envoy::config::tap::v3::OutputSink::PROTO_TEXT:
-    output_file_ << MessageUtil::toTextProto(*trace);
+    output_file_ << MessageUtil::toTextProto(trace);
     break;
   case envoy::config::tap::v3::OutputSink::JSON_BODY_AS_STRING:
   case envoy::config::tap::v3::OutputSink::JSON_BODY_AS_BYTES:
-    output_file_ << MessageUtil::getJsonStringFromMessageOrError(*trace, true, true);
+    output_file_ << MessageUtil::getJsonStringFromMessageOrError(trace, true, true);
     break;
   }
 }
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <deque>
 #include <fstream>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/config/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/common.pb.h"
 #include "envoy/data/tap/v3/wrapper.pb.h"
+#include "envoy/thread/thread.h"
 
 #include "source/extensions/common/matcher/matcher.h"
 #include "source/extensions/common/tap/tap.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Common {
@@ -128,11 +132,14 @@ private:
 };
 
 /**
- * A tap sink that writes each tap trace to a discrete output file.
+ * A tap sink that writes each tap trace to a discrete output file. The traces are written by the
+ * worker thread of the tap, or by a writer thread of the sink if max_pending_traces is set.
  */
 class FilePerTapSink : public Sink {
 public:
-  FilePerTapSink(const envoy::config::tap::v3::FilePerTapSink& config) : config_(config) {}
+  FilePerTapSink(const envoy::config::tap::v3::FilePerTapSink& config,
+                 Thread::ThreadFactory& thread_factory);
+  ~FilePerTapSink() override;
 
   // Sink
   PerTapSinkHandlePtr
@@ -142,9 +149,19 @@ public:
   }
 
 private:
+  // The output file of a tap, opened with its first trace.
+  struct TapFile {
+    void write(const std::string& path_prefix, uint64_t trace_id,
+               const envoy::data::tap::v3::TraceWrapper& trace,
+               envoy::config::tap::v3::OutputSink::Format format);
+
+    std::ofstream output_file_;
+  };
+
   struct FilePerTapSinkHandle : public PerTapSinkHandle {
     FilePerTapSinkHandle(FilePerTapSink& parent, uint64_t trace_id)
         : parent_(parent), trace_id_(trace_id) {}
+    ~FilePerTapSinkHandle() override;
 
     // PerTapSinkHandle
     void submitTrace(TraceWrapperPtr&& trace,
@@ -152,10 +169,28 @@ private:
 
     FilePerTapSink& parent_;
     const uint64_t trace_id_;
-    std::ofstream output_file_;
+    // Only used without a writer thread.
+    TapFile file_;
+  };
+
+  // A trace handed to the writer thread, or the end of a tap if trace_ is nullptr.
+  struct PendingTrace {
+    uint64_t trace_id_;
+    TraceWrapperPtr trace_;
+    envoy::config::tap::v3::OutputSink::Format format_;
   };
 
+  void enqueue(PendingTrace&& pending_trace);
+  void writerThreadRoutine();
+
   const envoy::config::tap::v3::FilePerTapSink config_;
+  const uint32_t max_pending_traces_;
+  absl::Mutex mutex_;
+  std::deque<PendingTrace> pending_traces_ ABSL_GUARDED_BY(mutex_);
+  // The traces in pending_traces_, the ends of the taps not included.
+  uint32_t pending_trace_count_ ABSL_GUARDED_BY(mutex_){};
+  bool shutting_down_ ABSL_GUARDED_BY(mutex_){};
+  Thread::ThreadPtr writer_thread_;
 };
 
 } // namespace Tap
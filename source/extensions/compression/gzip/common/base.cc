@@ -7,8 +7,11 @@ namespace Gzip {
 namespace Common {
 
 Base::Base(uint64_t chunk_size, std::function<void(z_stream*)> zstream_deleter)
-    : chunk_size_{chunk_size}, chunk_char_ptr_(new unsigned char[chunk_size]),
-      zstream_ptr_(new z_stream(), zstream_deleter) {}
+    : Base(chunk_size, ZStreamPtr(new z_stream(), std::move(zstream_deleter))) {}
+
+Base::Base(uint64_t chunk_size, ZStreamPtr zstream)
+    : chunk_size_{chunk_size}, initialized_(zstream->state != Z_NULL),
+      chunk_char_ptr_(new unsigned char[chunk_size]), zstream_ptr_(std::move(zstream)) {}
 
 uint64_t Base::checksum() { return zstream_ptr_->adler; }
 
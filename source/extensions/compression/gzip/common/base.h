@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "envoy/buffer/buffer.h"
@@ -12,12 +13,18 @@ namespace Compression {
 namespace Gzip {
 namespace Common {
 
+using ZStreamPtr = std::unique_ptr<z_stream, std::function<void(z_stream*)>>;
+
 /**
  * Shared code between the compressor and the decompressor.
  */
 class Base {
 public:
   Base(uint64_t chunk_size, std::function<void(z_stream*)> zstream_deleter);
+  /**
+   * Uses a zlib stream which may be initialized already, as reused from a ZStreamPool.
+   */
+  Base(uint64_t chunk_size, ZStreamPtr zstream);
 
   /**
    * It returns the checksum of all output produced so far. Compressor's checksum at the end of
@@ -36,7 +43,7 @@ protected:
   bool initialized_{false};
 
   const std::unique_ptr<unsigned char[]> chunk_char_ptr_;
-  const std::unique_ptr<z_stream, std::function<void(z_stream*)>> zstream_ptr_;
+  const ZStreamPtr zstream_ptr_;
 };
 
 } // namespace Common
@@ -0,0 +1,56 @@
+#include "source/extensions/compression/gzip/common/zstream_pool.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Gzip {
+namespace Common {
+
+ZStreamPool::ThreadLocalPool::~ThreadLocalPool() {
+  for (z_stream* zstream : streams_) {
+    end_(zstream);
+    delete zstream;
+  }
+}
+
+ZStreamPool::ZStreamPool(ThreadLocal::SlotAllocator& tls, uint32_t max_streams_per_worker,
+                         ZStreamFunction reset, ZStreamFunction end)
+    : max_streams_per_worker_(max_streams_per_worker), reset_(reset), end_(end), tls_(tls) {
+  tls_.set([end](Event::Dispatcher&) { return std::make_shared<ThreadLocalPool>(end); });
+}
+
+ZStreamPtr ZStreamPool::acquire() {
+  if (!tls_.currentThreadRegistered()) {
+    return nullptr;
+  }
+  std::vector<z_stream*>& streams = tls_->streams_;
+  if (streams.empty()) {
+    return nullptr;
+  }
+  z_stream* zstream = streams.back();
+  streams.pop_back();
+  return wrap(zstream);
+}
+
+ZStreamPtr ZStreamPool::create() { return wrap(new z_stream()); }
+
+ZStreamPtr ZStreamPool::wrap(z_stream* zstream) {
+  return {zstream, [this](z_stream* zstream) { release(zstream); }};
+}
+
+void ZStreamPool::release(z_stream* zstream) {
+  // A stream which was never initialized, or fails to reset, is not reused.
+  if (zstream->state != Z_NULL && tls_.currentThreadRegistered() &&
+      tls_->streams_.size() < max_streams_per_worker_ && reset_(zstream) == Z_OK) {
+    tls_->streams_.push_back(zstream);
+    return;
+  }
+  end_(zstream);
+  delete zstream;
+}
+
+} // namespace Common
+} // namespace Gzip
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
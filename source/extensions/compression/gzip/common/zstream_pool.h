@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/extensions/compression/gzip/common/base.h"
+
+#include "zlib.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Compression {
+namespace Gzip {
+namespace Common {
+
+/**
+ * Per-worker pools of the zlib streams of a compressor or decompressor factory, so that the
+ * streams of a worker reuse the zlib state left by its earlier streams, reset, rather than each
+ * allocating and initializing its own. All the streams of a pool have the same parameters. The
+ * pool must outlive the streams it makes.
+ */
+class ZStreamPool {
+public:
+  using ZStreamFunction = int (*)(z_stream*);
+
+  /**
+   * @param tls the slot allocator of the per-worker pools.
+   * @param max_streams_per_worker the most streams kept by the pool of a worker.
+   * @param reset resets a stream for its reuse, such as deflateReset.
+   * @param end frees the zlib state of a stream, such as deflateEnd.
+   */
+  ZStreamPool(ThreadLocal::SlotAllocator& tls, uint32_t max_streams_per_worker,
+              ZStreamFunction reset, ZStreamFunction end);
+
+  /**
+   * @return an initialized stream kept by the pool of the calling thread, or nullptr if there is
+   * none, in which case a new stream is made with create().
+   */
+  ZStreamPtr acquire();
+
+  /**
+   * @return a new stream, kept by the pool of the thread destroying it once initialized.
+   */
+  ZStreamPtr create();
+
+private:
+  struct ThreadLocalPool : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalPool(ZStreamFunction end) : end_(end) {}
+    ~ThreadLocalPool() override;
+
+    const ZStreamFunction end_;
+    std::vector<z_stream*> streams_;
+  };
+
+  ZStreamPtr wrap(z_stream* zstream);
+  // Keeps a stream which is done with in the pool of the calling thread, or frees it.
+  void release(z_stream* zstream);
+
+  const uint32_t max_streams_per_worker_;
+  const ZStreamFunction reset_;
+  const ZStreamFunction end_;
+  ThreadLocal::TypedSlot<ThreadLocalPool> tls_;
+};
+
+using ZStreamPoolPtr = std::unique_ptr<ZStreamPool>;
+
+} // namespace Common
+} // namespace Gzip
+} // namespace Compression
+} // namespace Extensions
+} // namespace Envoy
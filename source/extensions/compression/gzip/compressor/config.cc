@@ -7,13 +7,21 @@ namespace Gzip {
 namespace Compressor {
 
 GzipCompressorFactory::GzipCompressorFactory(
-    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip)
+    const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+    ThreadLocal::SlotAllocator& tls)
     : compression_level_(compressionLevelEnum(gzip.compression_level())),
       compression_strategy_(compressionStrategyEnum(gzip.compression_strategy())),
       memory_level_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, memory_level, DefaultMemoryLevel)),
       window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, window_bits, DefaultWindowBits) |
                    GzipHeaderValue),
-      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {}
+      chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)) {
+  const uint32_t max_pooled_streams_per_worker =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_pooled_streams_per_worker, 0);
+  if (max_pooled_streams_per_worker > 0) {
+    zstream_pool_ = std::make_unique<Common::ZStreamPool>(tls, max_pooled_streams_per_worker,
+                                                          deflateReset, deflateEnd);
+  }
+}
 
 ZlibCompressorImpl::CompressionLevel GzipCompressorFactory::compressionLevelEnum(
     envoy::extensions::compression::gzip::compressor::v3::Gzip::CompressionLevel
@@ -60,7 +68,15 @@ ZlibCompressorImpl::CompressionStrategy GzipCompressorFactory::compressionStrate
 }
 
 Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompressor() {
-  auto compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
+  std::unique_ptr<ZlibCompressorImpl> compressor;
+  if (zstream_pool_ == nullptr) {
+    compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_);
+  } else if (Common::ZStreamPtr zstream = zstream_pool_->acquire(); zstream != nullptr) {
+    // Reset with the parameters of this factory already.
+    return std::make_unique<ZlibCompressorImpl>(chunk_size_, std::move(zstream));
+  } else {
+    compressor = std::make_unique<ZlibCompressorImpl>(chunk_size_, zstream_pool_->create());
+  }
   compressor->init(compression_level_, compression_strategy_, window_bits_, memory_level_);
   return compressor;
 }
@@ -68,8 +84,9 @@ Envoy::Compression::Compressor::CompressorPtr GzipCompressorFactory::createCompr
 Envoy::Compression::Compressor::CompressorFactoryPtr
 GzipCompressorLibraryFactory::createCompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::compressor::v3::Gzip& proto_config,
-    Server::Configuration::GenericFactoryContext&) {
-  return std::make_unique<GzipCompressorFactory>(proto_config);
+    Server::Configuration::GenericFactoryContext& context) {
+  return std::make_unique<GzipCompressorFactory>(proto_config,
+                                                 context.serverFactoryContext().threadLocal());
 }
 
 /**
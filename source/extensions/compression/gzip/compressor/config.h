@@ -6,6 +6,7 @@
 
 #include "source/common/http/headers.h"
 #include "source/extensions/compression/common/compressor/factory_base.h"
+#include "source/extensions/compression/gzip/common/zstream_pool.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
 namespace Envoy {
@@ -38,7 +39,8 @@ const std::string& gzipExtensionName() {
 
 class GzipCompressorFactory : public Envoy::Compression::Compressor::CompressorFactory {
 public:
-  GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip);
+  GzipCompressorFactory(const envoy::extensions::compression::gzip::compressor::v3::Gzip& gzip,
+                        ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Compressor::CompressorFactory
   Envoy::Compression::Compressor::CompressorPtr createCompressor() override;
@@ -60,6 +62,8 @@ private:
   const int32_t memory_level_;
   const int32_t window_bits_;
   const uint32_t chunk_size_;
+  // Null unless the zlib streams are pooled.
+  Common::ZStreamPoolPtr zstream_pool_;
 };
 
 class GzipCompressorLibraryFactory
@@ -28,6 +28,13 @@ ZlibCompressorImpl::ZlibCompressorImpl(uint64_t chunk_size)
   zstream_ptr_->next_out = chunk_char_ptr_.get();
 }
 
+ZlibCompressorImpl::ZlibCompressorImpl(uint64_t chunk_size, Common::ZStreamPtr zstream)
+    : Common::Base(chunk_size, std::move(zstream)) {
+  // The allocation functions of a new stream are left null, for zlib to use its defaults.
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+}
+
 void ZlibCompressorImpl::init(CompressionLevel comp_level, CompressionStrategy comp_strategy,
                               int64_t window_bits, uint64_t memory_level = 8) {
   ASSERT(initialized_ == false);
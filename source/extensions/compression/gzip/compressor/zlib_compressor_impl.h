@@ -29,6 +29,14 @@ public:
    */
   ZlibCompressorImpl(uint64_t chunk_size);
 
+  /**
+   * Constructor using a zlib stream of a pool, which is initialized already if reused, in which
+   * case init must not be called.
+   * @param chunk_size amount of memory reserved for the compressor output.
+   * @param zstream the zlib stream.
+   */
+  ZlibCompressorImpl(uint64_t chunk_size, Common::ZStreamPtr zstream);
+
   /**
    * Enum values used to set compression level during initialization.
    * best: gives best compression.
@@ -16,18 +16,36 @@ const uint64_t DefaultMaxInflateRatio = 100;
 } // namespace
 
 GzipDecompressorFactory::GzipDecompressorFactory(
-    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& gzip, Stats::Scope& scope)
+    const envoy::extensions::compression::gzip::decompressor::v3::Gzip& gzip, Stats::Scope& scope,
+    ThreadLocal::SlotAllocator& tls)
     : scope_(scope),
       window_bits_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, window_bits, DefaultWindowBits) |
                    GzipHeaderValue),
       chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, chunk_size, DefaultChunkSize)),
       max_inflate_ratio_(
-          PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_inflate_ratio, DefaultMaxInflateRatio)) {}
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_inflate_ratio, DefaultMaxInflateRatio)) {
+  const uint32_t max_pooled_streams_per_worker =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(gzip, max_pooled_streams_per_worker, 0);
+  if (max_pooled_streams_per_worker > 0) {
+    zstream_pool_ = std::make_unique<Common::ZStreamPool>(tls, max_pooled_streams_per_worker,
+                                                          inflateReset, inflateEnd);
+  }
+}
 
 Envoy::Compression::Decompressor::DecompressorPtr
 GzipDecompressorFactory::createDecompressor(const std::string& stats_prefix) {
-  auto decompressor =
-      std::make_unique<ZlibDecompressorImpl>(scope_, stats_prefix, chunk_size_, max_inflate_ratio_);
+  std::unique_ptr<ZlibDecompressorImpl> decompressor;
+  if (zstream_pool_ == nullptr) {
+    decompressor = std::make_unique<ZlibDecompressorImpl>(scope_, stats_prefix, chunk_size_,
+                                                          max_inflate_ratio_);
+  } else if (Common::ZStreamPtr zstream = zstream_pool_->acquire(); zstream != nullptr) {
+    // Reset with the window bits of this factory already.
+    return std::make_unique<ZlibDecompressorImpl>(scope_, stats_prefix, chunk_size_,
+                                                  max_inflate_ratio_, std::move(zstream));
+  } else {
+    decompressor = std::make_unique<ZlibDecompressorImpl>(
+        scope_, stats_prefix, chunk_size_, max_inflate_ratio_, zstream_pool_->create());
+  }
   decompressor->init(window_bits_);
   return decompressor;
 }
@@ -36,7 +54,8 @@ Envoy::Compression::Decompressor::DecompressorFactoryPtr
 GzipDecompressorLibraryFactory::createDecompressorFactoryFromProtoTyped(
     const envoy::extensions::compression::gzip::decompressor::v3::Gzip& proto_config,
     Server::Configuration::FactoryContext& context) {
-  return std::make_unique<GzipDecompressorFactory>(proto_config, context.scope());
+  return std::make_unique<GzipDecompressorFactory>(proto_config, context.scope(),
+                                                   context.serverFactoryContext().threadLocal());
 }
 
 /**
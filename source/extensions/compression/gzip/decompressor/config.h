@@ -6,6 +6,7 @@
 
 #include "source/common/http/headers.h"
 #include "source/extensions/compression/common/decompressor/factory_base.h"
+#include "source/extensions/compression/gzip/common/zstream_pool.h"
 #include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
 
 namespace Envoy {
@@ -25,7 +26,7 @@ const std::string& gzipExtensionName() {
 class GzipDecompressorFactory : public Envoy::Compression::Decompressor::DecompressorFactory {
 public:
   GzipDecompressorFactory(const envoy::extensions::compression::gzip::decompressor::v3::Gzip& gzip,
-                          Stats::Scope& scope);
+                          Stats::Scope& scope, ThreadLocal::SlotAllocator& tls);
 
   // Envoy::Compression::Decompressor::DecompressorFactory
   Envoy::Compression::Decompressor::DecompressorPtr
@@ -40,6 +41,8 @@ private:
   const int32_t window_bits_;
   const uint32_t chunk_size_;
   const uint64_t max_inflate_ratio_;
+  // Null unless the zlib streams are pooled.
+  Common::ZStreamPoolPtr zstream_pool_;
 };
 
 class GzipDecompressorLibraryFactory
@@ -32,6 +32,16 @@ ZlibDecompressorImpl::ZlibDecompressorImpl(Stats::Scope& scope, const std::strin
   zstream_ptr_->next_out = chunk_char_ptr_.get();
 }
 
+ZlibDecompressorImpl::ZlibDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix,
+                                           uint64_t chunk_size, uint64_t max_inflate_ratio,
+                                           Common::ZStreamPtr zstream)
+    : Common::Base(chunk_size, std::move(zstream)), stats_(generateStats(stats_prefix, scope)),
+      max_inflate_ratio_(max_inflate_ratio) {
+  // The allocation functions of a new stream are left null, for zlib to use its defaults.
+  zstream_ptr_->avail_out = chunk_size_;
+  zstream_ptr_->next_out = chunk_char_ptr_.get();
+}
+
 void ZlibDecompressorImpl::init(int64_t window_bits) {
   ASSERT(initialized_ == false);
   // The inflateInit2 macro from zlib.h contains an old-style cast, so we need to suppress the
@@ -51,6 +51,14 @@ public:
   ZlibDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix, uint64_t chunk_size,
                        uint64_t max_inflate_ratio);
 
+  /**
+   * Constructor using a zlib stream of a pool, which is initialized already if reused, in which
+   * case init must not be called.
+   * @param zstream the zlib stream.
+   */
+  ZlibDecompressorImpl(Stats::Scope& scope, const std::string& stats_prefix, uint64_t chunk_size,
+                       uint64_t max_inflate_ratio, Common::ZStreamPtr zstream);
+
   /**
    * Init must be called in order to initialize the decompressor. Once decompressor is initialized,
    * it cannot be initialized again. Init should run before decompressing any data.
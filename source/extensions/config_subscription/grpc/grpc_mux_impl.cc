@@ -235,6 +235,9 @@ void GrpcMuxImpl::loadConfigFromDelegate(const std::string& type_url,
 
     std::vector<DecodedResourcePtr> decoded_resources;
     OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+    const bool reuse_decoded_resources = Runtime::runtimeFeatureEnabled(
+        "envoy.reloadable_features.xds_reuse_unchanged_decoded_resources");
+    absl::flat_hash_map<uint64_t, DecodedResourceImplPtr> last_decoded_resources;
     std::string version_info;
     for (const auto& resource : resources) {
       if (version_info.empty()) {
@@ -244,8 +247,16 @@ void GrpcMuxImpl::loadConfigFromDelegate(const std::string& type_url,
       }
 
       TRY_ASSERT_MAIN_THREAD {
-        decoded_resources.emplace_back(
-            std::make_unique<DecodedResourceImpl>(resource_decoder, resource));
+        auto decoded_resource = std::make_unique<DecodedResourceImpl>(resource_decoder, resource);
+        if (reuse_decoded_resources) {
+          // Hashed as the resources of the responses, so that the persisted resources which the
+          // xDS server sends again once reachable are neither decoded nor applied again.
+          const uint64_t hash = DecodedResourceImpl::contentHashOf(resource.resource());
+          decoded_resources.emplace_back(decoded_resource->withVersion(version_info));
+          last_decoded_resources[hash] = std::move(decoded_resource);
+        } else {
+          decoded_resources.emplace_back(std::move(decoded_resource));
+        }
       }
       END_TRY
       CATCH(const EnvoyException& e,
@@ -254,6 +265,7 @@ void GrpcMuxImpl::loadConfigFromDelegate(const std::string& type_url,
 
     processDiscoveryResources(decoded_resources, api_state, type_url, version_info,
                               /*call_delegate=*/false);
+    api_state.decoded_resources_ = std::move(last_decoded_resources);
   }
   END_TRY
   CATCH(const EnvoyException& e, {
@@ -407,6 +419,9 @@ void GrpcMuxImpl::onDiscoveryResponse(
   TRY_ASSERT_MAIN_THREAD {
     std::vector<DecodedResourcePtr> resources;
     OpaqueResourceDecoder& resource_decoder = *api_state.watches_.front()->resource_decoder_;
+    const bool reuse_decoded_resources = Runtime::runtimeFeatureEnabled(
+        "envoy.reloadable_features.xds_reuse_unchanged_decoded_resources");
+    absl::flat_hash_map<uint64_t, DecodedResourceImplPtr> decoded_resources;
 
     for (const auto& resource : message->resources()) {
       // TODO(snowp): Check the underlying type when the resource is a Resource.
@@ -417,9 +432,29 @@ void GrpcMuxImpl::onDiscoveryResponse(
                         resource.type_url(), type_url, message->DebugString()));
       }
 
-      auto decoded_resource = THROW_OR_RETURN_VALUE(
-          DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info()),
-          DecodedResourceImplPtr);
+      DecodedResourceImplPtr decoded_resource;
+      if (reuse_decoded_resources) {
+        // Most resources of a state of the world response are unchanged since the last one, so
+        // their decoding and validation is skipped.
+        const uint64_t hash = DecodedResourceImpl::contentHashOf(resource);
+        auto it = api_state.decoded_resources_.find(hash);
+        DecodedResourceImplPtr last_resource;
+        if (it != api_state.decoded_resources_.end()) {
+          last_resource = std::move(it->second);
+          api_state.decoded_resources_.erase(it);
+        } else {
+          last_resource = THROW_OR_RETURN_VALUE(
+              DecodedResourceImpl::fromResource(resource_decoder, resource,
+                                                message->version_info()),
+              DecodedResourceImplPtr);
+        }
+        decoded_resource = last_resource->withVersion(message->version_info());
+        decoded_resources[hash] = std::move(last_resource);
+      } else {
+        decoded_resource = THROW_OR_RETURN_VALUE(
+            DecodedResourceImpl::fromResource(resource_decoder, resource, message->version_info()),
+            DecodedResourceImplPtr);
+      }
 
       if (!isHeartbeatResource(type_url, *decoded_resource)) {
         resources.emplace_back(std::move(decoded_resource));
@@ -428,6 +463,7 @@ void GrpcMuxImpl::onDiscoveryResponse(
 
     processDiscoveryResources(resources, api_state, type_url, message->version_info(),
                               /*call_delegate=*/true);
+    api_state.decoded_resources_ = std::move(decoded_resources);
 
     // Processing point when resources are successfully ingested.
     if (xds_config_tracker_.has_value()) {
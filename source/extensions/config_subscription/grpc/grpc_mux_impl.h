@@ -21,6 +21,7 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/api_version.h"
+#include "source/common/config/decoded_resource_impl.h"
 #include "source/common/config/resource_name.h"
 #include "source/common/config/ttl.h"
 #include "source/common/config/utility.h"
@@ -29,6 +30,7 @@
 #include "source/extensions/config_subscription/grpc/grpc_mux_context.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_failover.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "xds/core/v3/resource_name.pb.h"
 
@@ -261,6 +263,9 @@ private:
     std::string control_plane_identifier_{};
     // If true, xDS resources were previously fetched from an xDS source or an xDS delegate.
     bool previously_fetched_data_{false};
+    // The resources of the last response, by the hash of their serialized form. A resource which
+    // is unchanged in the next response reuses its decoded and validated message.
+    absl::flat_hash_map<uint64_t, DecodedResourceImplPtr> decoded_resources_;
   };
 
   bool isHeartbeatResource(const std::string& type_url, const DecodedResource& resource) {
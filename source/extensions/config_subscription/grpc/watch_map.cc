@@ -8,6 +8,8 @@
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_resource.h"
 
+#include "absl/algorithm/container.h"
+
 namespace Envoy {
 namespace Config {
 
@@ -320,8 +322,10 @@ WatchMap::findAdditions(const absl::flat_hash_set<std::string>& newly_added_to_w
       newly_added_to_subscription.insert(name);
       watch_interest_[name] = {watch};
     } else {
-      // Add this watch to the already-existing set at watch_interest_[name]
-      entry->second.insert(watch);
+      // Add this watch to the already-existing watches at watch_interest_[name]
+      if (!absl::c_linear_search(entry->second, watch)) {
+        entry->second.push_back(watch);
+      }
     }
   }
   return newly_added_to_subscription;
@@ -337,7 +341,9 @@ WatchMap::findRemovals(const absl::flat_hash_set<std::string>& newly_removed_fro
         entry != watch_interest_.end(),
         fmt::format("WatchMap: tried to remove a watch from untracked resource {}", name));
 
-    entry->second.erase(watch);
+    if (auto it = absl::c_find(entry->second, watch); it != entry->second.end()) {
+      entry->second.erase(it);
+    }
     if (entry->second.empty()) {
       watch_interest_.erase(entry);
       newly_removed_from_subscription.insert(name);
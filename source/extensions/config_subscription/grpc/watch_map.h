@@ -15,6 +15,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 
 namespace Envoy {
 namespace Config {
@@ -147,7 +148,9 @@ private:
   // Maps a resource name to the set of watches interested in that resource. Has two purposes:
   // 1) Acts as a reference count; no watches care anymore ==> the resource can be removed.
   // 2) Enables efficient lookup of all interested watches when a resource has been updated.
-  absl::flat_hash_map<std::string, absl::flat_hash_set<Watch*>> watch_interest_;
+  // The resources almost always have a single watch, so the watches are kept inline rather than in
+  // a set of their own, which would be an allocation per resource.
+  absl::flat_hash_map<std::string, absl::InlinedVector<Watch*, 1>> watch_interest_;
 
   const bool use_namespace_matching_;
   const std::string type_url_;
@@ -1573,6 +1573,27 @@ size_t envoy_dynamic_module_callback_http_get_body_chunks_size(
     envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
     envoy_dynamic_module_type_http_body_type body_type);
 
+/**
+ * envoy_dynamic_module_callback_http_get_mutable_body_chunks is the same as
+ * envoy_dynamic_module_callback_http_get_body_chunks, except that the returned buffers can be
+ * modified in place by the module. The chunks of the body that are backed by read-only memory,
+ * such as static fragments, are copied once before being returned. The number of buffers is the
+ * one returned by envoy_dynamic_module_callback_http_get_body_chunks_size.
+ *
+ * @param filter_envoy_ptr is the pointer to the DynamicModuleHttpFilter object of the
+ * corresponding HTTP filter.
+ * @param body_type is the type of the body to get the buffers from (request/response,
+ * received/buffered body).
+ * @param result_buffer_vector is the pointer to the array of envoy_dynamic_module_type_envoy_buffer
+ * where the buffers of the body will be stored. The lifetime of the buffer is guaranteed until the
+ * end of the current event hook unless the setter callback is called.
+ * @return true if the body is available, false otherwise.
+ */
+bool envoy_dynamic_module_callback_http_get_mutable_body_chunks(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_http_body_type body_type,
+    envoy_dynamic_module_type_envoy_buffer* result_buffer_vector);
+
 /**
  * envoy_dynamic_module_callback_http_append_body is called by the module to append
  * the given data to the end of the body.
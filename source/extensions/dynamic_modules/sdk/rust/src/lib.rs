@@ -2534,7 +2534,7 @@ impl EnvoyHttpFilter for EnvoyHttpFilterImpl {
 
     let buffers: Vec<EnvoyMutBuffer> = vec![EnvoyMutBuffer::default(); size];
     let success = unsafe {
-      abi::envoy_dynamic_module_callback_http_get_body_chunks(
+      abi::envoy_dynamic_module_callback_http_get_mutable_body_chunks(
         self.raw_ptr,
         abi::envoy_dynamic_module_type_http_body_type::ReceivedRequestBody,
         buffers.as_ptr() as *mut abi::envoy_dynamic_module_type_envoy_buffer,
@@ -2560,7 +2560,7 @@ impl EnvoyHttpFilter for EnvoyHttpFilterImpl {
 
     let buffers: Vec<EnvoyMutBuffer> = vec![EnvoyMutBuffer::default(); size];
     let success = unsafe {
-      abi::envoy_dynamic_module_callback_http_get_body_chunks(
+      abi::envoy_dynamic_module_callback_http_get_mutable_body_chunks(
         self.raw_ptr,
         abi::envoy_dynamic_module_type_http_body_type::BufferedRequestBody,
         buffers.as_ptr() as *mut abi::envoy_dynamic_module_type_envoy_buffer,
@@ -2644,7 +2644,7 @@ impl EnvoyHttpFilter for EnvoyHttpFilterImpl {
 
     let buffers: Vec<EnvoyMutBuffer> = vec![EnvoyMutBuffer::default(); size];
     let success = unsafe {
-      abi::envoy_dynamic_module_callback_http_get_body_chunks(
+      abi::envoy_dynamic_module_callback_http_get_mutable_body_chunks(
         self.raw_ptr,
         abi::envoy_dynamic_module_type_http_body_type::ReceivedResponseBody,
         buffers.as_ptr() as *mut abi::envoy_dynamic_module_type_envoy_buffer,
@@ -2670,7 +2670,7 @@ impl EnvoyHttpFilter for EnvoyHttpFilterImpl {
 
     let buffers: Vec<EnvoyMutBuffer> = vec![EnvoyMutBuffer::default(); size];
     let success = unsafe {
-      abi::envoy_dynamic_module_callback_http_get_body_chunks(
+      abi::envoy_dynamic_module_callback_http_get_mutable_body_chunks(
         self.raw_ptr,
         abi::envoy_dynamic_module_type_http_body_type::BufferedResponseBody,
         buffers.as_ptr() as *mut abi::envoy_dynamic_module_type_envoy_buffer,
@@ -376,6 +376,7 @@ EXTENSIONS = {
     "envoy.extensions.http.cache.simple":                    "//source/extensions/http/cache/simple_http_cache:config",
     "envoy.extensions.http.cache_v2.file_system_http_cache": "//source/extensions/http/cache_v2/file_system_http_cache:config",
     "envoy.extensions.http.cache_v2.simple":                 "//source/extensions/http/cache_v2/simple_http_cache:config",
+    "envoy.extensions.http.cache_v2.tiered_http_cache":      "//source/extensions/http/cache_v2/tiered_http_cache:config",
 
     #
     # Internal redirect predicates
@@ -398,6 +399,7 @@ EXTENSIONS = {
     #
 
     "envoy.watchdog.profile_action":                    "//source/extensions/watchdog/profile_action:config",
+    "envoy.watchdog.stack_sampler":                     "//source/extensions/watchdog/stack_sampler:config",
 
     #
     # WebAssembly runtimes
@@ -626,10 +628,14 @@ EXTENSIONS = {
     "envoy.tls.certificate_selectors.on_demand_secret":                  "//source/extensions/transport_sockets/tls/cert_selectors/on_demand:config",
 
     # Certificate mappers
+    "envoy.tls.certificate_mappers.server_name_index":              "//source/extensions/transport_sockets/tls/cert_mappers/server_name_index:config",
     "envoy.tls.certificate_mappers.sni":                            "//source/extensions/transport_sockets/tls/cert_mappers/sni:config",
     "envoy.tls.certificate_mappers.static_name":                    "//source/extensions/transport_sockets/tls/cert_mappers/static_name:config",
     "envoy.tls.upstream_certificate_mappers.filter_state_override": "//source/extensions/transport_sockets/tls/cert_mappers/filter_state_override:config",
 
+    # Private key providers
+    "envoy.tls.key_providers.thread_pool":                          "//source/extensions/transport_sockets/tls/private_key_providers/thread_pool:config",
+
     # Local address selectors
     "envoy.upstream.local_address_selector.filter_state_override": "//source/extensions/local_address_selectors/filter_state_override:config",
 }
@@ -1,5 +1,7 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/singleton/manager.h"
 
@@ -37,6 +39,12 @@ const ActivationLookupTable& getActivationTokens() {
 #undef _PAIR
 }
 
+// The size of the arena of a shared activation above which it is replaced, as the values created
+// by the evaluations of a long lived stream accumulate in it.
+constexpr size_t MaxSharedActivationArenaBytes = 64 * 1024;
+
+thread_local std::unique_ptr<SharedStreamActivation> shared_stream_activation;
+
 } // namespace
 
 absl::optional<CelValue> StreamActivation::FindValue(absl::string_view name,
@@ -95,6 +103,39 @@ void StreamActivation::resetActivation() const {
   activation_response_trailers_ = nullptr;
 }
 
+const SharedStreamActivation&
+SharedStreamActivation::get(const LocalInfo::LocalInfo* local_info,
+                            const StreamInfo::StreamInfo& info,
+                            const Http::RequestHeaderMap* request_headers,
+                            const Http::ResponseHeaderMap* response_headers,
+                            const Http::ResponseTrailerMap* response_trailers) {
+  const SharedStreamActivation* activation = shared_stream_activation.get();
+  if (activation == nullptr ||
+      !activation->sameStream(local_info, info, request_headers, response_headers,
+                              response_trailers) ||
+      activation->arena_.SpaceUsed() > MaxSharedActivationArenaBytes) {
+    shared_stream_activation = std::make_unique<SharedStreamActivation>(
+        local_info, info, request_headers, response_headers, response_trailers);
+  }
+  return *shared_stream_activation;
+}
+
+absl::optional<CelValue> SharedStreamActivation::FindValue(absl::string_view name,
+                                                           Protobuf::Arena*) const {
+  const auto it = values_.find(name);
+  if (it != values_.end()) {
+    return it->second;
+  }
+  absl::optional<CelValue> value = StreamActivation::FindValue(name, &arena_);
+  // The wrappers of the stream and its headers are valid for all its evaluations, unlike the
+  // metadata and the filter states, which the stream info may replace.
+  if (value.has_value() && name != Metadata && name != FilterState &&
+      name != UpstreamFilterState) {
+    values_.emplace(name, value.value());
+  }
+  return value;
+}
+
 ActivationPtr createActivation(const LocalInfo::LocalInfo* local_info,
                                const StreamInfo::StreamInfo& info,
                                const Http::RequestHeaderMap* request_headers,
@@ -181,14 +222,49 @@ BuilderInstanceSharedConstPtr BuilderCache::getOrCreateBuilder(
     }
   }
 
-  // Create new builder with the configuration.
-  auto builder = createBuilder(config);
-  auto instance = std::make_shared<BuilderInstance>(std::move(builder), shared_from_this());
+  // Create new builder with the configuration, folding the constants of its expressions into an
+  // arena owned by the instance.
+  std::unique_ptr<Protobuf::Arena> constant_arena;
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.enable_cel_constant_folding")) {
+    constant_arena = std::make_unique<Protobuf::Arena>();
+  }
+  auto builder = createBuilder(config, constant_arena.get());
+  auto instance = std::make_shared<BuilderInstance>(std::move(builder), shared_from_this(),
+                                                    std::move(constant_arena));
   // Store as weak_ptr to allow release after xDS unload.
   builders_[hash] = instance;
   return instance;
 }
 
+absl::StatusOr<CompiledProgramSharedConstPtr>
+BuilderInstance::compile(const cel::expr::Expr& expr) const {
+  std::string key = expr.SerializeAsString();
+  absl::MutexLock lock(programs_mutex_);
+  auto it = programs_.find(key);
+  if (it != programs_.end()) {
+    CompiledProgramSharedConstPtr program = it->second.lock();
+    if (program != nullptr) {
+      return program;
+    }
+  }
+
+  auto program = std::make_shared<CompiledProgram>(expr);
+  std::vector<absl::Status> warnings;
+  auto cel_expression_status = builder_->CreateExpression(
+      &program->source_expr_, &cel::expr::SourceInfo::default_instance(), &warnings);
+  if (!cel_expression_status.ok()) {
+    return cel_expression_status.status();
+  }
+  program->expr_ = std::move(cel_expression_status.value());
+
+  if (programs_.size() >= programs_sweep_size_) {
+    absl::erase_if(programs_, [](const auto& entry) { return entry.second.expired(); });
+    programs_sweep_size_ = std::max<size_t>(16, 2 * programs_.size());
+  }
+  programs_[std::move(key)] = program;
+  return program;
+}
+
 SINGLETON_MANAGER_REGISTRATION(builder_cache);
 
 BuilderInstanceSharedConstPtr
@@ -211,15 +287,11 @@ CompiledExpression::Create(Server::Configuration::CommonFactoryContext& context,
 absl::StatusOr<CompiledExpression>
 CompiledExpression::Create(const BuilderInstanceSharedConstPtr& builder,
                            const cel::expr::Expr& expr) {
-  std::vector<absl::Status> warnings;
-  CompiledExpression out = CompiledExpression(builder, expr);
-  auto cel_expression_status = out.builder_->builder().CreateExpression(
-      &out.source_expr_, &cel::expr::SourceInfo::default_instance(), &warnings);
-  if (!cel_expression_status.ok()) {
-    return cel_expression_status.status();
+  auto program = builder->compile(expr);
+  if (!program.ok()) {
+    return program.status();
   }
-  out.expr_ = std::move(cel_expression_status.value());
-  return out;
+  return CompiledExpression(builder, std::move(program.value()));
 }
 
 absl::StatusOr<CompiledExpression>
@@ -263,9 +335,17 @@ absl::optional<CelValue> CompiledExpression::evaluate(
     const StreamInfo::StreamInfo& info, const ::Envoy::Http::RequestHeaderMap* request_headers,
     const ::Envoy::Http::ResponseHeaderMap* response_headers,
     const ::Envoy::Http::ResponseTrailerMap* response_trailers) const {
-  auto activation =
-      createActivation(local_info, info, request_headers, response_headers, response_trailers);
-  auto eval_status = expr_->Evaluate(*activation, &arena);
+  absl::StatusOr<CelValue> eval_status;
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.cel_shared_stream_activation")) {
+    eval_status = program_->expr_->Evaluate(
+        SharedStreamActivation::get(local_info, info, request_headers, response_headers,
+                                    response_trailers),
+        &arena);
+  } else {
+    const StreamActivation activation(local_info, info, request_headers, response_headers,
+                                      response_trailers);
+    eval_status = program_->expr_->Evaluate(activation, &arena);
+  }
   if (!eval_status.ok()) {
     return {};
   }
@@ -275,7 +355,7 @@ absl::optional<CelValue> CompiledExpression::evaluate(
 
 absl::StatusOr<CelValue> CompiledExpression::evaluate(const Activation& activation,
                                                       Protobuf::Arena* arena) const {
-  return expr_->Evaluate(activation, arena);
+  return program_->expr_->Evaluate(activation, arena);
 }
 
 bool CompiledExpression::matches(const StreamInfo::StreamInfo& info,
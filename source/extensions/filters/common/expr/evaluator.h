@@ -8,6 +8,9 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/common/expr/context.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 // CEL-CPP does not enforce unused parameter checks consistently, so we relax it here.
 
 #if defined(__GNUC__)
@@ -77,6 +80,40 @@ protected:
 using Activation = StreamActivation;
 using ActivationPtr = std::unique_ptr<Activation>;
 
+// An activation shared by the evaluations of the expressions of all the filters of a stream on a
+// worker thread. The wrappers of the attributes are created once, in the arena of the activation,
+// until an expression is evaluated for another stream or other headers on the thread.
+class SharedStreamActivation : public StreamActivation {
+public:
+  // Returns the activation of the stream and headers on the current thread, replacing the one of
+  // any other stream. Only valid until the next call on the thread.
+  static const SharedStreamActivation&
+  get(const ::Envoy::LocalInfo::LocalInfo* local_info, const StreamInfo::StreamInfo& info,
+      const ::Envoy::Http::RequestHeaderMap* request_headers,
+      const ::Envoy::Http::ResponseHeaderMap* response_headers,
+      const ::Envoy::Http::ResponseTrailerMap* response_trailers);
+
+  using StreamActivation::StreamActivation;
+
+  absl::optional<CelValue> FindValue(absl::string_view name, Protobuf::Arena* arena) const override;
+
+private:
+  bool sameStream(const ::Envoy::LocalInfo::LocalInfo* local_info,
+                  const StreamInfo::StreamInfo& info,
+                  const ::Envoy::Http::RequestHeaderMap* request_headers,
+                  const ::Envoy::Http::ResponseHeaderMap* response_headers,
+                  const ::Envoy::Http::ResponseTrailerMap* response_trailers) const {
+    return local_info_ == local_info && activation_info_ == &info &&
+           activation_request_headers_ == request_headers &&
+           activation_response_headers_ == response_headers &&
+           activation_response_trailers_ == response_trailers;
+  }
+
+  // Holds the wrappers, and the values they create.
+  mutable Protobuf::Arena arena_;
+  mutable absl::flat_hash_map<std::string, CelValue> values_;
+};
+
 // Creates an activation providing the common context attributes.
 // The activation lazily creates wrappers during an evaluation using the evaluation arena.
 ActivationPtr createActivation(const ::Envoy::LocalInfo::LocalInfo* local_info,
@@ -92,16 +129,40 @@ class BuilderCache;
 using BuilderInstanceSharedPtr = std::shared_ptr<BuilderInstance>;
 using BuilderInstanceSharedConstPtr = std::shared_ptr<const BuilderInstance>;
 
+// An expression compiled by a builder, shared by the identical expressions it compiles.
+struct CompiledProgram {
+  explicit CompiledProgram(const cel::expr::Expr& expr) : source_expr_(expr) {}
+
+  const cel::expr::Expr source_expr_;
+  ExpressionPtr expr_;
+};
+
+using CompiledProgramSharedConstPtr = std::shared_ptr<const CompiledProgram>;
+
 // Shared expression builder instance.
 class BuilderInstance {
 public:
-  explicit BuilderInstance(BuilderConstPtr builder, std::shared_ptr<BuilderCache> cache = nullptr)
-      : builder_(std::move(builder)), cache_(std::move(cache)) {}
+  // The constant arena holds the constants folded by the builder, if it folds them.
+  explicit BuilderInstance(BuilderConstPtr builder, std::shared_ptr<BuilderCache> cache = nullptr,
+                           std::unique_ptr<Protobuf::Arena> constant_arena = nullptr)
+      : constant_arena_(std::move(constant_arena)), builder_(std::move(builder)),
+        cache_(std::move(cache)) {}
   const Builder& builder() const { return *builder_; }
 
+  // Compiles an expression, or returns the program of an identical expression compiled before and
+  // still in use.
+  absl::StatusOr<CompiledProgramSharedConstPtr> compile(const cel::expr::Expr& expr) const;
+
 private:
+  const std::unique_ptr<Protobuf::Arena> constant_arena_;
   const BuilderConstPtr builder_;
   const std::shared_ptr<BuilderCache> cache_;
+  mutable absl::Mutex programs_mutex_;
+  // The programs by serialized expression.
+  mutable absl::flat_hash_map<std::string, std::weak_ptr<const CompiledProgram>>
+      programs_ ABSL_GUARDED_BY(programs_mutex_);
+  // The number of programs above which the expired ones are erased.
+  mutable size_t programs_sweep_size_ ABSL_GUARDED_BY(programs_mutex_){16};
 };
 
 // Cache to store builders for different configurations.
@@ -134,7 +195,7 @@ getBuilder(Server::Configuration::CommonFactoryContext& context,
            OptRef<const envoy::config::core::v3::CelExpressionConfig> config = {});
 
 // Compiled CEL expression. This class ensures both the builder and the source expression outlive
-// the compiled expression.
+// the compiled expression, which is shared by the identical expressions of the builder.
 class CompiledExpression {
 public:
   // Creates an interpretable expression from the new CEL expr format, making a copy of it.
@@ -170,12 +231,11 @@ public:
   bool matches(const StreamInfo::StreamInfo& info, const Http::RequestHeaderMap& headers) const;
 
 private:
-  explicit CompiledExpression(const BuilderInstanceSharedConstPtr& builder,
-                              const cel::expr::Expr& expr)
-      : builder_(builder), source_expr_(expr) {}
+  CompiledExpression(const BuilderInstanceSharedConstPtr& builder,
+                     CompiledProgramSharedConstPtr program)
+      : builder_(builder), program_(std::move(program)) {}
   const BuilderInstanceSharedConstPtr builder_;
-  const cel::expr::Expr source_expr_;
-  ExpressionPtr expr_;
+  const CompiledProgramSharedConstPtr program_;
 };
 
 // Returns a string for a CelValue.
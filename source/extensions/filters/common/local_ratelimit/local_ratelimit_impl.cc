@@ -6,6 +6,7 @@
 
 #include "envoy/runtime/runtime.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -74,26 +75,79 @@ ShareProviderManagerSharedPtr ShareProviderManager::singleton(Event::Dispatcher&
       });
 }
 
+namespace {
+
+// The index of the calling thread, assigned on its first call. The workers are mapped to the
+// shards of the token buckets by their index.
+uint32_t threadIndex() {
+  static std::atomic<uint32_t> next_index{0};
+  thread_local const uint32_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+} // namespace
+
 RateLimitTokenBucket::RateLimitTokenBucket(uint64_t max_tokens, uint64_t tokens_per_fill,
                                            std::chrono::milliseconds fill_interval,
-                                           TimeSource& time_source, bool shadow_mode)
+                                           TimeSource& time_source, bool shadow_mode,
+                                           const TokenBucketSharding& sharding)
     : token_bucket_(max_tokens, time_source,
                     // Calculate the fill rate in tokens per second.
                     tokens_per_fill / std::chrono::duration<double>(fill_interval).count()),
-      fill_interval_(fill_interval), shadow_mode_(shadow_mode) {}
+      fill_interval_(fill_interval), shadow_mode_(shadow_mode), shards_(sharding.shards_),
+      batch_tokens_(static_cast<double>(sharding.batch_tokens_)) {}
+
 bool RateLimitTokenBucket::consume(double factor, uint64_t to_consume) {
   ASSERT(!(factor <= 0.0 || factor > 1.0));
-  auto cb = [tokens = to_consume / factor](double total) { return total < tokens ? 0.0 : tokens; };
+  const double tokens = to_consume / factor;
+  if (!shards_.empty()) {
+    return consumeFromShard(shards_[threadIndex() % shards_.size()], tokens);
+  }
+  auto cb = [tokens](double total) { return total < tokens ? 0.0 : tokens; };
   return token_bucket_.consume(cb) != 0.0;
 }
 
+bool RateLimitTokenBucket::consumeFromShard(Shard& shard, double tokens) {
+  double shard_tokens = shard.tokens_.load(std::memory_order_relaxed);
+  while (shard_tokens >= tokens) {
+    if (shard.tokens_.compare_exchange_weak(shard_tokens, shard_tokens - tokens,
+                                            std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+
+  // Take a batch from the shared bucket, or everything it has left if that is less but enough for
+  // this request. What this request does not consume is added to the shard.
+  const double batch_tokens = std::max(tokens, batch_tokens_);
+  auto cb = [tokens, batch_tokens](double total) {
+    return total < tokens ? 0.0 : std::min(total, batch_tokens);
+  };
+  const double taken = token_bucket_.consume(cb);
+  if (taken == 0.0) {
+    return false;
+  }
+  shard_tokens = shard.tokens_.load(std::memory_order_relaxed);
+  while (!shard.tokens_.compare_exchange_weak(shard_tokens, shard_tokens + taken - tokens,
+                                              std::memory_order_relaxed)) {
+  }
+  return true;
+}
+
+uint64_t RateLimitTokenBucket::remainingTokens() const {
+  double remaining_tokens = token_bucket_.remainingTokens();
+  for (const Shard& shard : shards_) {
+    remaining_tokens += shard.tokens_.load(std::memory_order_relaxed);
+  }
+  return static_cast<uint64_t>(remaining_tokens);
+}
+
 LocalRateLimiterImpl::LocalRateLimiterImpl(
     const std::chrono::milliseconds fill_interval, const uint64_t max_tokens,
     const uint64_t tokens_per_fill, Event::Dispatcher& dispatcher,
     const Protobuf::RepeatedPtrField<
         envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
     bool always_consume_default_token_bucket, ShareProviderSharedPtr shared_provider,
-    uint32_t lru_size)
+    uint32_t lru_size, const TokenBucketSharding& sharding)
     : time_source_(dispatcher.timeSource()), share_provider_(std::move(shared_provider)),
       always_consume_default_token_bucket_(always_consume_default_token_bucket) {
   // Ignore the default token bucket if fill_interval is 0 because 0 fill_interval means nothing
@@ -103,7 +157,7 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
       throw EnvoyException("local rate limit token bucket fill timer must be >= 50ms");
     }
     default_token_bucket_ = std::make_shared<RateLimitTokenBucket>(
-        max_tokens, tokens_per_fill, fill_interval, time_source_, false);
+        max_tokens, tokens_per_fill, fill_interval, time_source_, false, sharding);
   }
 
   for (const auto& descriptor : descriptors) {
@@ -133,14 +187,14 @@ LocalRateLimiterImpl::LocalRateLimiterImpl(
     if (wildcard_found) {
       DynamicDescriptorSharedPtr dynamic_descriptor = std::make_shared<DynamicDescriptor>(
           per_descriptor_max_tokens, per_descriptor_tokens_per_fill, per_descriptor_fill_interval,
-          lru_size, dispatcher.timeSource(), shadow_mode);
+          lru_size, dispatcher.timeSource(), shadow_mode, sharding);
       dynamic_descriptors_.addDescriptor(std::move(new_descriptor), std::move(dynamic_descriptor));
       continue;
     }
     RateLimitTokenBucketSharedPtr per_descriptor_token_bucket =
         std::make_shared<RateLimitTokenBucket>(
             per_descriptor_max_tokens, per_descriptor_tokens_per_fill, per_descriptor_fill_interval,
-            time_source_, shadow_mode);
+            time_source_, shadow_mode, sharding);
     auto result =
         descriptors_.emplace(std::move(new_descriptor), std::move(per_descriptor_token_bucket));
     if (!result.second) {
@@ -267,25 +321,44 @@ bool DynamicDescriptorMap::matchDescriptorEntries(
   return true;
 }
 
+uint64_t DynamicDescriptorMap::keysHash(const std::vector<RateLimit::DescriptorEntry>& entries) {
+  uint64_t hash = entries.size();
+  for (const RateLimit::DescriptorEntry& entry : entries) {
+    hash = HashUtil::xxHash64(entry.key_, hash);
+  }
+  return hash;
+}
+
 void DynamicDescriptorMap::addDescriptor(const RateLimit::LocalDescriptor& config_descriptor,
                                          DynamicDescriptorSharedPtr dynamic_descriptor) {
-  auto result = config_descriptors_.emplace(config_descriptor, std::move(dynamic_descriptor));
-  if (!result.second) {
-    throw EnvoyException(absl::StrCat("duplicate descriptor in the local rate descriptor: ",
-                                      result.first->first.toString()));
+  std::vector<ConfigDescriptor>& descriptors =
+      config_descriptors_[keysHash(config_descriptor.entries_)];
+  for (const ConfigDescriptor& descriptor : descriptors) {
+    if (descriptor.descriptor_.entries_ == config_descriptor.entries_) {
+      throw EnvoyException(absl::StrCat("duplicate descriptor in the local rate descriptor: ",
+                                        config_descriptor.toString()));
+    }
   }
+  descriptors.push_back({config_descriptor, std::move(dynamic_descriptor)});
 }
 
 RateLimitTokenBucketSharedPtr
-DynamicDescriptorMap::getBucket(const RateLimit::Descriptor request_descriptor) {
-  for (const auto& pair : config_descriptors_) {
-    auto config_descriptor = pair.first;
-    if (!matchDescriptorEntries(request_descriptor.entries_, config_descriptor.entries_)) {
+DynamicDescriptorMap::getBucket(const RateLimit::Descriptor& request_descriptor) {
+  if (config_descriptors_.empty()) {
+    return nullptr;
+  }
+  auto it = config_descriptors_.find(keysHash(request_descriptor.entries_));
+  if (it == config_descriptors_.end()) {
+    return nullptr;
+  }
+  for (const ConfigDescriptor& config_descriptor : it->second) {
+    if (!matchDescriptorEntries(request_descriptor.entries_,
+                                config_descriptor.descriptor_.entries_)) {
       continue;
     }
 
     // here is when a user configured wildcard descriptor matches the request descriptor.
-    return pair.second->addOrGetDescriptor(request_descriptor);
+    return config_descriptor.dynamic_descriptor_->addOrGetDescriptor(request_descriptor);
   }
   return nullptr;
 }
@@ -293,10 +366,11 @@ DynamicDescriptorMap::getBucket(const RateLimit::Descriptor request_descriptor)
 DynamicDescriptor::DynamicDescriptor(uint64_t per_descriptor_max_tokens,
                                      uint64_t per_descriptor_tokens_per_fill,
                                      std::chrono::milliseconds per_descriptor_fill_interval,
-                                     uint32_t lru_size, TimeSource& time_source, bool shadow_mode)
+                                     uint32_t lru_size, TimeSource& time_source, bool shadow_mode,
+                                     const TokenBucketSharding& sharding)
     : max_tokens_(per_descriptor_max_tokens), tokens_per_fill_(per_descriptor_tokens_per_fill),
       fill_interval_(per_descriptor_fill_interval), lru_size_(lru_size), time_source_(time_source),
-      shadow_mode_(shadow_mode) {}
+      shadow_mode_(shadow_mode), sharding_(sharding) {}
 
 RateLimitTokenBucketSharedPtr
 DynamicDescriptor::addOrGetDescriptor(const RateLimit::Descriptor& request_descriptor) {
@@ -314,7 +388,7 @@ DynamicDescriptor::addOrGetDescriptor(const RateLimit::Descriptor& request_descr
   ENVOY_LOG(trace, "max_tokens: {}, tokens_per_fill: {}, fill_interval: {}", max_tokens_,
             tokens_per_fill_, std::chrono::duration<double>(fill_interval_).count());
   per_descriptor_token_bucket = std::make_shared<RateLimitTokenBucket>(
-      max_tokens_, tokens_per_fill_, fill_interval_, time_source_, shadow_mode_);
+      max_tokens_, tokens_per_fill_, fill_interval_, time_source_, shadow_mode_, sharding_);
 
   ENVOY_LOG(trace, "DynamicDescriptor::addorGetDescriptor: adding dynamic descriptor: {}",
             request_descriptor.toString());
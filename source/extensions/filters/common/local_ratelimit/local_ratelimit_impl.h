@@ -1,7 +1,9 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <ratio>
+#include <vector>
 
 #include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
@@ -15,6 +17,8 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/filters/common/local_ratelimit/local_ratelimit.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Filters {
@@ -26,11 +30,26 @@ class RateLimitTokenBucket;
 using RateLimitTokenBucketSharedPtr = std::shared_ptr<RateLimitTokenBucket>;
 using ProtoLocalClusterRateLimit = envoy::extensions::common::ratelimit::v3::LocalClusterRateLimit;
 
+/**
+ * The sharding of the token buckets shared by the workers. Each shard holds an allocation of
+ * tokens, which the workers mapped to it consume without contending on the shared bucket, and
+ * which is replenished from the shared bucket a batch of tokens at a time. The allocations come on
+ * top of the max tokens of the shared bucket, so a burst may exceed them by up to the batch tokens
+ * per shard.
+ */
+struct TokenBucketSharding {
+  // The number of shards, usually the number of workers. Zero disables the sharding.
+  uint32_t shards_{0};
+  // The number of tokens taken at once from the shared bucket.
+  uint64_t batch_tokens_{1};
+};
+
 class DynamicDescriptor : public Logger::Loggable<Logger::Id::rate_limit_quota> {
 public:
   DynamicDescriptor(uint64_t max_tokens, uint64_t tokens_per_fill,
                     std::chrono::milliseconds fill_interval, uint32_t lru_size,
-                    TimeSource& time_source, bool shadow_mode);
+                    TimeSource& time_source, bool shadow_mode,
+                    const TokenBucketSharding& sharding = {});
   // add a new user configured descriptor to the set.
   RateLimitTokenBucketSharedPtr addOrGetDescriptor(const RateLimit::Descriptor& request_descriptor);
 
@@ -48,6 +67,7 @@ private:
   uint32_t lru_size_;
   TimeSource& time_source_;
   const bool shadow_mode_{false};
+  const TokenBucketSharding sharding_;
 };
 
 using DynamicDescriptorSharedPtr = std::shared_ptr<DynamicDescriptor>;
@@ -58,12 +78,22 @@ public:
   void addDescriptor(const RateLimit::LocalDescriptor& descriptor,
                      DynamicDescriptorSharedPtr dynamic_descriptor);
   // pass request_descriptors to the dynamic descriptor set to get the token bucket.
-  RateLimitTokenBucketSharedPtr getBucket(const RateLimit::Descriptor);
+  RateLimitTokenBucketSharedPtr getBucket(const RateLimit::Descriptor& request_descriptor);
 
 private:
+  struct ConfigDescriptor {
+    RateLimit::LocalDescriptor descriptor_;
+    DynamicDescriptorSharedPtr dynamic_descriptor_;
+  };
+
+  // The hash of the keys of descriptor entries, which the wildcard descriptors match exactly.
+  static uint64_t keysHash(const std::vector<RateLimit::DescriptorEntry>& entries);
   bool matchDescriptorEntries(const std::vector<RateLimit::DescriptorEntry>& request_entries,
                               const std::vector<RateLimit::DescriptorEntry>& user_entries);
-  RateLimit::LocalDescriptor::Map<DynamicDescriptorSharedPtr> config_descriptors_;
+
+  // The configured descriptors by the hash of their keys, in configuration order, so that a
+  // request descriptor is only matched against those with the same keys.
+  absl::flat_hash_map<uint64_t, std::vector<ConfigDescriptor>> config_descriptors_;
 };
 
 class ShareProvider {
@@ -107,7 +137,7 @@ class RateLimitTokenBucket : public TokenBucketContext,
 public:
   RateLimitTokenBucket(uint64_t max_tokens, uint64_t tokens_per_fill,
                        std::chrono::milliseconds fill_interval, TimeSource& time_source,
-                       bool shadow_mode);
+                       bool shadow_mode, const TokenBucketSharding& sharding = {});
 
   // RateLimitTokenBucket
   bool consume(double factor = 1.0, uint64_t tokens = 1);
@@ -116,17 +146,24 @@ public:
 
   bool shadowMode() const override { return shadow_mode_; }
   uint64_t maxTokens() const override { return static_cast<uint64_t>(token_bucket_.maxTokens()); }
-  uint64_t remainingTokens() const override {
-    return static_cast<uint64_t>(token_bucket_.remainingTokens());
-  }
+  uint64_t remainingTokens() const override;
   uint64_t resetSeconds() const override {
     return static_cast<uint64_t>(std::ceil(token_bucket_.nextTokenAvailable().count() / 1000));
   }
 
 private:
+  // Aligned to a cache line so that the workers of different shards do not contend.
+  struct alignas(64) Shard {
+    std::atomic<double> tokens_{0};
+  };
+
+  bool consumeFromShard(Shard& shard, double tokens);
+
   AtomicTokenBucketImpl token_bucket_;
   const std::chrono::milliseconds fill_interval_;
   const bool shadow_mode_{false};
+  std::vector<Shard> shards_;
+  const double batch_tokens_;
 };
 using RateLimitTokenBucketSharedPtr = std::shared_ptr<RateLimitTokenBucket>;
 
@@ -139,7 +176,8 @@ public:
       const Protobuf::RepeatedPtrField<
           envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>& descriptors,
       bool always_consume_default_token_bucket = true,
-      ShareProviderSharedPtr shared_provider = nullptr, const uint32_t lru_size = 20);
+      ShareProviderSharedPtr shared_provider = nullptr, const uint32_t lru_size = 20,
+      const TokenBucketSharding& sharding = {});
   ~LocalRateLimiterImpl() override;
 
   LocalRateLimiter::Result
@@ -14,6 +14,19 @@ namespace Filters {
 namespace Common {
 namespace Lua {
 
+namespace {
+
+// Enough for the concurrent requests of a busy worker, while bounding the memory of the idle
+// threads after a burst.
+constexpr size_t MaxPooledCoroutines = 128;
+
+int appendBytecode(lua_State*, const void* data, size_t size, void* bytecode) {
+  static_cast<std::string*>(bytecode)->append(static_cast<const char*>(data), size);
+  return 0;
+}
+
+} // namespace
+
 void LuaLoggable::scriptLog(spdlog::level::level_enum level, absl::string_view message) {
   switch (level) {
   case spdlog::level::trace:
@@ -42,8 +55,41 @@ void LuaLoggable::scriptLog(spdlog::level::level_enum level, absl::string_view m
   }
 }
 
-Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state)
-    : coroutine_state_(new_thread_state, false) {}
+lua_State* CoroutinePool::acquire() {
+  if (refs_.empty()) {
+    return nullptr;
+  }
+  const int ref = refs_.back();
+  refs_.pop_back();
+  lua_rawgeti(state_, LUA_REGISTRYINDEX, ref);
+  luaL_unref(state_, LUA_REGISTRYINDEX, ref);
+  return lua_tothread(state_, -1);
+}
+
+void CoroutinePool::release(lua_State* thread) {
+  if (refs_.size() >= MaxPooledCoroutines) {
+    lua_pop(state_, 1);
+    return;
+  }
+  // Drops the results of the coroutine, and undoes any setfenv(0, ...) of the script.
+  lua_settop(thread, 0);
+  lua_pushvalue(state_, LUA_GLOBALSINDEX);
+  lua_xmove(state_, thread, 1);
+  lua_replace(thread, LUA_GLOBALSINDEX);
+  refs_.push_back(luaL_ref(state_, LUA_REGISTRYINDEX));
+}
+
+Coroutine::Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+                     CoroutinePool* pool)
+    : coroutine_state_(new_thread_state, false), pool_(pool) {}
+
+Coroutine::~Coroutine() {
+  // A thread that yielded or raised an error cannot be resumed from the start again.
+  if (pool_ != nullptr && succeeded_) {
+    coroutine_state_.pushStack();
+    pool_->release(coroutine_state_.get());
+  }
+}
 
 void Coroutine::start(int function_ref, int num_args, const std::function<void()>& yield_callback) {
   ASSERT(state_ == State::NotStarted);
@@ -64,6 +110,7 @@ void Coroutine::resume(int num_args, const std::function<void()>& yield_callback
 
   if (0 == rc) {
     state_ = State::Finished;
+    succeeded_ = true;
     ENVOY_LOG(debug, "coroutine finished");
   } else if (LUA_YIELD == rc) {
     state_ = State::Yielded;
@@ -87,12 +134,25 @@ ThreadLocalState::ThreadLocalState(const std::string& code, ThreadLocal::SlotAll
   RELEASE_ASSERT(state.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state.get());
 
-  if (0 != luaL_dostring(state.get(), code.c_str())) {
+  if (0 != luaL_loadstring(state.get(), code.c_str())) {
+    throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
+  }
+
+  // The script is compiled once here, so that the workers only load its bytecode. Its chunk name is
+  // kept in the bytecode, so that the error messages are the same.
+  std::string bytecode;
+  if (0 != lua_dump(state.get(), appendBytecode, &bytecode)) {
+    bytecode.clear();
+  }
+
+  if (0 != lua_pcall(state.get(), 0, 0, 0)) {
     throw LuaException(fmt::format("script load error: {}", lua_tostring(state.get(), -1)));
   }
 
   // Now initialize on all threads.
-  tls_slot_->set([code](Event::Dispatcher&) { return std::make_shared<LuaThreadLocal>(code); });
+  tls_slot_->set([code, bytecode = std::move(bytecode)](Event::Dispatcher&) {
+    return std::make_shared<LuaThreadLocal>(code, bytecode);
+  });
 }
 
 int ThreadLocalState::getGlobalRef(uint64_t slot) {
@@ -121,16 +181,26 @@ uint64_t ThreadLocalState::registerGlobal(const std::string& global,
 }
 
 CoroutinePtr ThreadLocalState::createCoroutine() {
-  lua_State* state = tlsState().get();
-  return std::make_unique<Coroutine>(std::make_pair(lua_newthread(state), state));
+  LuaThreadLocal& tls = **tls_slot_;
+  lua_State* state = tls.state_.get();
+  lua_State* thread = tls.coroutine_pool_.acquire();
+  if (thread == nullptr) {
+    thread = lua_newthread(state);
+  }
+  return std::make_unique<Coroutine>(std::make_pair(thread, state), &tls.coroutine_pool_);
 }
 
-ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code)
-    : state_(luaL_newstate()) {
+ThreadLocalState::LuaThreadLocal::LuaThreadLocal(const std::string& code,
+                                                 const std::string& bytecode)
+    : state_(luaL_newstate()), coroutine_pool_(state_.get()) {
 
   RELEASE_ASSERT(state_.get() != nullptr, "unable to create new Lua state object");
   luaL_openlibs(state_.get());
-  int rc = luaL_dostring(state_.get(), code.c_str());
+  const std::string& chunk = bytecode.empty() ? code : bytecode;
+  int rc = luaL_loadbuffer(state_.get(), chunk.data(), chunk.size(), code.c_str());
+  if (rc == 0) {
+    rc = lua_pcall(state_.get(), 0, 0, 0);
+  }
   ASSERT(rc == 0);
 }
 
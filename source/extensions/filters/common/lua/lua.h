@@ -423,6 +423,33 @@ public:
   }
 };
 
+/**
+ * The Lua threads of the coroutines that finished successfully, kept referenced so that the next
+ * coroutines of the state reuse them instead of allocating new ones. Not thread safe.
+ */
+class CoroutinePool {
+public:
+  explicit CoroutinePool(lua_State* state) : state_(state) {}
+
+  /**
+   * @return a pooled thread pushed at the top of the stack of the state, or nullptr if the pool is
+   *         empty.
+   */
+  lua_State* acquire();
+
+  /**
+   * Adds a thread to the pool, unless it is full.
+   * @param thread supplies the finished thread, which is at the top of the stack of the state.
+   */
+  void release(lua_State* thread);
+
+  size_t size() const { return refs_.size(); }
+
+private:
+  lua_State* const state_;
+  std::vector<int> refs_;
+};
+
 /**
  * This is a wrapper for a Lua coroutine. Lua intermixes coroutine and "thread." Lua does not have
  * real threads, only cooperatively scheduled coroutines.
@@ -431,7 +458,14 @@ class Coroutine : Logger::Loggable<Logger::Id::lua> {
 public:
   enum class State { NotStarted, Yielded, Finished };
 
-  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state);
+  /**
+   * @param new_thread_state supplies the thread of the coroutine and its parent state.
+   * @param pool supplies the pool the thread is released to if the coroutine finishes
+   *        successfully, if any.
+   */
+  Coroutine(const std::pair<lua_State*, lua_State*>& new_thread_state,
+            CoroutinePool* pool = nullptr);
+  ~Coroutine();
   lua_State* luaState() { return coroutine_state_.get(); }
   State state() { return state_; }
 
@@ -455,7 +489,10 @@ public:
 
 private:
   LuaRef<lua_State> coroutine_state_;
+  CoroutinePool* const pool_;
   State state_{State::NotStarted};
+  // Whether the coroutine returned without error, leaving its thread reusable.
+  bool succeeded_{false};
 };
 
 using CoroutinePtr = std::unique_ptr<Coroutine>;
@@ -472,7 +509,7 @@ public:
   ThreadLocalState(const std::string& code, ThreadLocal::SlotAllocator& tls);
 
   /**
-   * @return CoroutinePtr a new coroutine.
+   * @return CoroutinePtr a new coroutine, running on a pooled thread of the worker if any.
    */
   CoroutinePtr createCoroutine();
 
@@ -516,10 +553,12 @@ public:
 
 private:
   struct LuaThreadLocal : public ThreadLocal::ThreadLocalObject {
-    LuaThreadLocal(const std::string& code);
+    LuaThreadLocal(const std::string& code, const std::string& bytecode);
 
     CSmartPtr<lua_State, lua_close> state_;
     std::vector<int> global_slots_;
+    // Destroyed before the state.
+    CoroutinePool coroutine_pool_;
   };
 
   CSmartPtr<lua_State, lua_close>& tlsState() { return (*tls_slot_)->state_; }
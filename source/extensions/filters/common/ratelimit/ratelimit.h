@@ -60,6 +60,13 @@ public:
                         Http::RequestHeaderMapPtr&& request_headers_to_add,
                         const std::string& response_body,
                         DynamicMetadataPtr&& dynamic_metadata) PURE;
+
+  /**
+   * Called before complete() when the response grants a quota to the descriptor set of the
+   * request, from which the next requests with the same descriptors may be admitted without
+   * querying the rate limit service.
+   */
+  virtual void onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota&) {}
 };
 
 /**
@@ -130,6 +130,9 @@ void GrpcClientImpl::onSuccess(
   // callback, so we release the callback here to make the destructor happy.
   auto call_backs = callbacks_;
   callbacks_ = nullptr;
+  if (response->has_quota()) {
+    call_backs->onQuota(response->quota());
+  }
   call_backs->complete(status, std::move(descriptor_statuses), std::move(response_headers_to_add),
                        std::move(request_headers_to_add), response->raw_body(),
                        std::move(dynamic_metadata));
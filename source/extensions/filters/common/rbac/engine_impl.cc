@@ -4,6 +4,7 @@
 #include "envoy/config/rbac/v3/rbac.pb.validate.h"
 
 #include "source/common/http/header_map_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -58,11 +59,18 @@ RoleBasedAccessControlEngineImpl::RoleBasedAccessControlEngineImpl(
     }
   }
 
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.rbac_shared_matchers")) {
+    shared_matchers_ = std::make_unique<SharedMatchers>();
+  }
   for (const auto& policy : rules.policies()) {
     policies_.emplace(policy.first,
                       std::make_unique<PolicyMatcher>(
                           policy.second, validation_visitor, context,
-                          builder_with_arena_ ? builder_with_arena_->builder_instance_ : nullptr));
+                          builder_with_arena_ ? builder_with_arena_->builder_instance_ : nullptr,
+                          shared_matchers_.get()));
+  }
+  if (shared_matchers_ != nullptr) {
+    shared_matchers_->finalize();
   }
 }
 
@@ -98,6 +106,10 @@ bool RoleBasedAccessControlEngineImpl::checkPolicyMatch(
     const Network::Connection& connection, const StreamInfo::StreamInfo& info,
     const Envoy::Http::RequestHeaderMap& headers, std::string* effective_policy_id) const {
   bool matched = false;
+  absl::optional<SharedMatchers::Evaluation> evaluation;
+  if (shared_matchers_ != nullptr) {
+    evaluation.emplace(*shared_matchers_);
+  }
 
   for (const auto& policy : policies_) {
     if (policy.second->matches(connection, headers, info)) {
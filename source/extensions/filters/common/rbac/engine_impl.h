@@ -92,6 +92,8 @@ private:
   const envoy::config::rbac::v3::RBAC::Action action_;
   const EnforcementMode mode_;
 
+  // The matchers shared by the policies, which outlive them.
+  std::unique_ptr<SharedMatchers> shared_matchers_;
   std::map<std::string, std::unique_ptr<PolicyMatcher>> policies_;
   // Arena-based builder for when cel_config is not used.
   std::unique_ptr<ExprBuilderWithArena> builder_with_arena_;
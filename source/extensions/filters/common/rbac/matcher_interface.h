@@ -13,6 +13,7 @@ namespace RBAC {
 
 class Matcher;
 using MatcherConstPtr = std::unique_ptr<const Matcher>;
+class SharedMatchers;
 
 /**
  *  Matchers describe the rules for matching either a permission action or principal.
@@ -35,18 +36,22 @@ public:
 
   /**
    * Creates an instance of a matcher based off the rules defined in the Permission config
-   * proto message.
+   * proto message. If shared_matchers is set, the matchers of the permission and of its sub-rules
+   * are shared with the identical ones created from it.
    */
   static MatcherConstPtr create(const envoy::config::rbac::v3::Permission& permission,
                                 ProtobufMessage::ValidationVisitor& validation_visitor,
-                                Server::Configuration::CommonFactoryContext& context);
+                                Server::Configuration::CommonFactoryContext& context,
+                                SharedMatchers* shared_matchers = nullptr);
 
   /**
    * Creates an instance of a matcher based off the rules defined in the Principal config
-   * proto message.
+   * proto message. If shared_matchers is set, the matchers of the principal and of its sub-ids
+   * are shared with the identical ones created from it.
    */
   static MatcherConstPtr create(const envoy::config::rbac::v3::Principal& principal,
-                                Server::Configuration::CommonFactoryContext& context);
+                                Server::Configuration::CommonFactoryContext& context,
+                                SharedMatchers* shared_matchers = nullptr);
 };
 
 } // namespace RBAC
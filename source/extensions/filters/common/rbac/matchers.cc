@@ -8,20 +8,30 @@
 #include "source/extensions/filters/common/rbac/matcher_extension.h"
 #include "source/extensions/filters/common/rbac/principal_extension.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Filters {
 namespace Common {
 namespace RBAC {
 
-MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Permission& permission,
-                                ProtobufMessage::ValidationVisitor& validation_visitor,
-                                Server::Configuration::CommonFactoryContext& context) {
+namespace {
+
+// The current evaluation of the shared matchers of the thread.
+thread_local SharedMatchers::Evaluation* current_evaluation = nullptr;
+
+MatcherConstPtr createMatcher(const envoy::config::rbac::v3::Permission& permission,
+                              ProtobufMessage::ValidationVisitor& validation_visitor,
+                              Server::Configuration::CommonFactoryContext& context,
+                              SharedMatchers* shared_matchers) {
   switch (permission.rule_case()) {
   case envoy::config::rbac::v3::Permission::RuleCase::kAndRules:
-    return std::make_unique<const AndMatcher>(permission.and_rules(), validation_visitor, context);
+    return std::make_unique<const AndMatcher>(permission.and_rules(), validation_visitor, context,
+                                              shared_matchers);
   case envoy::config::rbac::v3::Permission::RuleCase::kOrRules:
-    return std::make_unique<const OrMatcher>(permission.or_rules(), validation_visitor, context);
+    return std::make_unique<const OrMatcher>(permission.or_rules(), validation_visitor, context,
+                                             shared_matchers);
   case envoy::config::rbac::v3::Permission::RuleCase::kHeader:
     return std::make_unique<const HeaderMatcher>(permission.header(), context);
   case envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp: {
@@ -45,7 +55,8 @@ MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Permission& permi
         Matchers::MetadataMatcher(permission.sourced_metadata().metadata_matcher(), context),
         permission.sourced_metadata().metadata_source());
   case envoy::config::rbac::v3::Permission::RuleCase::kNotRule:
-    return std::make_unique<const NotMatcher>(permission.not_rule(), validation_visitor, context);
+    return std::make_unique<const NotMatcher>(permission.not_rule(), validation_visitor, context,
+                                              shared_matchers);
   case envoy::config::rbac::v3::Permission::RuleCase::kRequestedServerName:
     return std::make_unique<const RequestedServerNameMatcher>(permission.requested_server_name(),
                                                               context);
@@ -69,13 +80,14 @@ MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Permission& permi
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
-MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Principal& principal,
-                                Server::Configuration::CommonFactoryContext& context) {
+MatcherConstPtr createMatcher(const envoy::config::rbac::v3::Principal& principal,
+                              Server::Configuration::CommonFactoryContext& context,
+                              SharedMatchers* shared_matchers) {
   switch (principal.identifier_case()) {
   case envoy::config::rbac::v3::Principal::IdentifierCase::kAndIds:
-    return std::make_unique<const AndMatcher>(principal.and_ids(), context);
+    return std::make_unique<const AndMatcher>(principal.and_ids(), context, shared_matchers);
   case envoy::config::rbac::v3::Principal::IdentifierCase::kOrIds:
-    return std::make_unique<const OrMatcher>(principal.or_ids(), context);
+    return std::make_unique<const OrMatcher>(principal.or_ids(), context, shared_matchers);
   case envoy::config::rbac::v3::Principal::IdentifierCase::kAuthenticated:
     return std::make_unique<const AuthenticatedMatcher>(principal.authenticated(), context);
   case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp: {
@@ -109,7 +121,7 @@ MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Principal& princi
         Matchers::MetadataMatcher(principal.sourced_metadata().metadata_matcher(), context),
         principal.sourced_metadata().metadata_source());
   case envoy::config::rbac::v3::Principal::IdentifierCase::kNotId:
-    return std::make_unique<const NotMatcher>(principal.not_id(), context);
+    return std::make_unique<const NotMatcher>(principal.not_id(), context, shared_matchers);
   case envoy::config::rbac::v3::Principal::IdentifierCase::kUrlPath:
     return std::make_unique<const PathMatcher>(principal.url_path(), context);
   case envoy::config::rbac::v3::Principal::IdentifierCase::kFilterState:
@@ -123,20 +135,49 @@ MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Principal& princi
   PANIC_DUE_TO_CORRUPT_ENUM;
 }
 
+} // namespace
+
+MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Permission& permission,
+                                ProtobufMessage::ValidationVisitor& validation_visitor,
+                                Server::Configuration::CommonFactoryContext& context,
+                                SharedMatchers* shared_matchers) {
+  if (shared_matchers != nullptr) {
+    MatcherConstPtr matcher = shared_matchers->create(permission, validation_visitor, context);
+    if (matcher != nullptr) {
+      return matcher;
+    }
+  }
+  return createMatcher(permission, validation_visitor, context, shared_matchers);
+}
+
+MatcherConstPtr Matcher::create(const envoy::config::rbac::v3::Principal& principal,
+                                Server::Configuration::CommonFactoryContext& context,
+                                SharedMatchers* shared_matchers) {
+  if (shared_matchers != nullptr) {
+    MatcherConstPtr matcher = shared_matchers->create(principal, context);
+    if (matcher != nullptr) {
+      return matcher;
+    }
+  }
+  return createMatcher(principal, context, shared_matchers);
+}
+
 AndMatcher::AndMatcher(const envoy::config::rbac::v3::Permission::Set& set,
                        ProtobufMessage::ValidationVisitor& validation_visitor,
-                       Server::Configuration::CommonFactoryContext& context) {
+                       Server::Configuration::CommonFactoryContext& context,
+                       SharedMatchers* shared_matchers) {
   matchers_.reserve(set.rules_size());
   for (const auto& rule : set.rules()) {
-    matchers_.emplace_back(Matcher::create(rule, validation_visitor, context));
+    matchers_.emplace_back(Matcher::create(rule, validation_visitor, context, shared_matchers));
   }
 }
 
 AndMatcher::AndMatcher(const envoy::config::rbac::v3::Principal::Set& set,
-                       Server::Configuration::CommonFactoryContext& context) {
+                       Server::Configuration::CommonFactoryContext& context,
+                       SharedMatchers* shared_matchers) {
   matchers_.reserve(set.ids_size());
   for (const auto& id : set.ids()) {
-    matchers_.emplace_back(Matcher::create(id, context));
+    matchers_.emplace_back(Matcher::create(id, context, shared_matchers));
   }
 }
 
@@ -154,18 +195,20 @@ bool AndMatcher::matches(const Network::Connection& connection,
 
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Permission>& rules,
                      ProtobufMessage::ValidationVisitor& validation_visitor,
-                     Server::Configuration::CommonFactoryContext& context) {
+                     Server::Configuration::CommonFactoryContext& context,
+                     SharedMatchers* shared_matchers) {
   matchers_.reserve(rules.size());
   for (const auto& rule : rules) {
-    matchers_.emplace_back(Matcher::create(rule, validation_visitor, context));
+    matchers_.emplace_back(Matcher::create(rule, validation_visitor, context, shared_matchers));
   }
 }
 
 OrMatcher::OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Principal>& ids,
-                     Server::Configuration::CommonFactoryContext& context) {
+                     Server::Configuration::CommonFactoryContext& context,
+                     SharedMatchers* shared_matchers) {
   matchers_.reserve(ids.size());
   for (const auto& id : ids) {
-    matchers_.emplace_back(Matcher::create(id, context));
+    matchers_.emplace_back(Matcher::create(id, context, shared_matchers));
   }
 }
 
@@ -248,9 +291,9 @@ IPMatcher::IPMatcher(std::unique_ptr<Network::LcTrie::LcTrie<bool>> trie, Type t
     : trie_(std::move(trie)), type_(type) {}
 
 const Network::Address::InstanceConstSharedPtr&
-IPMatcher::extractIpAddress(const Network::Connection& connection,
-                            const StreamInfo::StreamInfo& info) const {
-  switch (type_) {
+IPMatcher::extractIpAddress(Type type, const Network::Connection& connection,
+                            const StreamInfo::StreamInfo& info) {
+  switch (type) {
   case ConnectionRemote:
     return connection.connectionInfoProvider().remoteAddress();
   case DownstreamLocal:
@@ -266,7 +309,7 @@ IPMatcher::extractIpAddress(const Network::Connection& connection,
 bool IPMatcher::matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap&,
                         const StreamInfo::StreamInfo& info) const {
   // Extract IP address using reference to avoid shared_ptr copies.
-  const auto& address = extractIpAddress(connection, info);
+  const auto& address = extractIpAddress(type_, connection, info);
   // Guard against non-IP addresses (e.g., pipe) or missing address.
   if (!address) {
     return false;
@@ -389,6 +432,167 @@ bool UriTemplateMatcher::matches(const Network::Connection&,
   return uri_template_matcher_->match(headers.getPathValue());
 }
 
+/**
+ * A use of a shared matcher, memoizing its result in the current evaluation of its engine.
+ */
+class SharedMatchers::EntryMatcher : public Matcher {
+public:
+  EntryMatcher(const SharedMatchers& shared_matchers, const Entry& entry)
+      : shared_matchers_(shared_matchers), entry_(entry) {}
+
+  bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
+               const StreamInfo::StreamInfo& info) const override {
+    Evaluation* evaluation = current_evaluation;
+    if (entry_.slot_ == NoSlot || evaluation == nullptr ||
+        &evaluation->shared_matchers_ != &shared_matchers_) {
+      return entry_.matcher_->matches(connection, headers, info);
+    }
+    Result& result = evaluation->results_[entry_.slot_];
+    if (result == Result::Unknown) {
+      if (entry_.ip_type_.has_value() &&
+          shared_matchers_.ip_indexes_[entry_.ip_type_.value()].trie_ != nullptr) {
+        shared_matchers_.lookupIp(entry_.ip_type_.value(), connection, info, evaluation->results_);
+      } else {
+        result = entry_.matcher_->matches(connection, headers, info) ? Result::Match
+                                                                     : Result::NoMatch;
+      }
+    }
+    return result == Result::Match;
+  }
+
+private:
+  const SharedMatchers& shared_matchers_;
+  const Entry& entry_;
+};
+
+MatcherConstPtr SharedMatchers::create(const envoy::config::rbac::v3::Permission& permission,
+                                       ProtobufMessage::ValidationVisitor& validation_visitor,
+                                       Server::Configuration::CommonFactoryContext& context) {
+  switch (permission.rule_case()) {
+  case envoy::config::rbac::v3::Permission::RuleCase::kAny:
+  case envoy::config::rbac::v3::Permission::RuleCase::kMatcher:
+    return nullptr;
+  default:
+    break;
+  }
+  bool created = false;
+  Entry& shared_entry = entry(
+      permission, [&]() { return createMatcher(permission, validation_visitor, context, this); },
+      created);
+  if (created && permission.rule_case() ==
+                     envoy::config::rbac::v3::Permission::RuleCase::kDestinationIp) {
+    indexIp(shared_entry, permission.destination_ip(), IPMatcher::Type::DownstreamLocal);
+  }
+  return std::make_unique<const EntryMatcher>(*this, shared_entry);
+}
+
+MatcherConstPtr SharedMatchers::create(const envoy::config::rbac::v3::Principal& principal,
+                                       Server::Configuration::CommonFactoryContext& context) {
+  switch (principal.identifier_case()) {
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kAny:
+  case envoy::config::rbac::v3::Principal::IdentifierCase::kCustom:
+    return nullptr;
+  default:
+    break;
+  }
+  bool created = false;
+  Entry& shared_entry =
+      entry(principal, [&]() { return createMatcher(principal, context, this); }, created);
+  if (created) {
+    switch (principal.identifier_case()) {
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kSourceIp:
+      indexIp(shared_entry, principal.source_ip(), IPMatcher::Type::ConnectionRemote);
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kDirectRemoteIp:
+      indexIp(shared_entry, principal.direct_remote_ip(), IPMatcher::Type::DownstreamDirectRemote);
+      break;
+    case envoy::config::rbac::v3::Principal::IdentifierCase::kRemoteIp:
+      indexIp(shared_entry, principal.remote_ip(), IPMatcher::Type::DownstreamRemote);
+      break;
+    default:
+      break;
+    }
+  }
+  return std::make_unique<const EntryMatcher>(*this, shared_entry);
+}
+
+SharedMatchers::Entry& SharedMatchers::entry(const Protobuf::Message& config,
+                                             const std::function<MatcherConstPtr()>& create,
+                                             bool& created) {
+  // Identical configs serialize to the same bytes, and distinct ones to distinct bytes. The maps of
+  // the configs may serialize in different orders, which only misses sharing their matchers.
+  std::string key = absl::StrCat(config.GetTypeName(), ":", config.SerializeAsString());
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    // The matcher is created before its entry is inserted, as the creation of its sub-matchers
+    // inserts their own entries.
+    auto new_entry = std::make_unique<Entry>();
+    new_entry->matcher_ = create();
+    it = entries_.emplace(std::move(key), std::move(new_entry)).first;
+    created = true;
+  }
+  it->second->uses_++;
+  return *it->second;
+}
+
+void SharedMatchers::indexIp(Entry& entry, const envoy::config::core::v3::CidrRange& range,
+                             IPMatcher::Type type) {
+  // The range was validated by the creation of the matcher.
+  auto cidr_result = Network::Address::CidrRange::create(range);
+  if (!cidr_result.ok()) {
+    return;
+  }
+  entry.ip_type_ = type;
+  entry.ip_ranges_.push_back(std::move(cidr_result.value()));
+  ip_indexes_[type].entries_.push_back(&entry);
+}
+
+void SharedMatchers::finalize() {
+  for (IpIndex& index : ip_indexes_) {
+    if (index.entries_.size() < 2) {
+      continue;
+    }
+    std::vector<std::pair<uint32_t, std::vector<Network::Address::CidrRange>>> data;
+    data.reserve(index.entries_.size());
+    for (Entry* entry : index.entries_) {
+      entry->slot_ = slots_++;
+      index.slots_.push_back(entry->slot_);
+      data.emplace_back(entry->slot_, std::move(entry->ip_ranges_));
+    }
+    index.trie_ = std::make_unique<Network::LcTrie::LcTrie<uint32_t>>(data);
+  }
+  for (auto& [key, entry] : entries_) {
+    if (entry->slot_ == NoSlot && entry->uses_ > 1) {
+      entry->slot_ = slots_++;
+    }
+  }
+}
+
+void SharedMatchers::lookupIp(IPMatcher::Type type, const Network::Connection& connection,
+                              const StreamInfo::StreamInfo& info,
+                              std::vector<Result>& results) const {
+  const IpIndex& index = ip_indexes_[type];
+  for (const uint32_t slot : index.slots_) {
+    results[slot] = Result::NoMatch;
+  }
+  const auto& address = IPMatcher::extractIpAddress(type, connection, info);
+  // Guard against non-IP addresses (e.g., pipe) or missing address.
+  if (address == nullptr || address->ip() == nullptr) {
+    return;
+  }
+  for (const uint32_t slot : index.trie_->getData(address)) {
+    results[slot] = Result::Match;
+  }
+}
+
+SharedMatchers::Evaluation::Evaluation(const SharedMatchers& shared_matchers)
+    : shared_matchers_(shared_matchers), previous_(current_evaluation),
+      results_(shared_matchers.slots_, Result::Unknown) {
+  current_evaluation = this;
+}
+
+SharedMatchers::Evaluation::~Evaluation() { current_evaluation = previous_; }
+
 } // namespace RBAC
 } // namespace Common
 } // namespace Filters
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "envoy/config/core/v3/address.pb.h"
 #include "envoy/config/route/v3/route_components.pb.h"
@@ -15,6 +20,7 @@
 #include "source/extensions/filters/common/rbac/matcher_interface.h"
 #include "source/extensions/path/match/uri_template/uri_template_match.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "cel/expr/syntax.pb.h"
 
 namespace Envoy {
@@ -42,9 +48,11 @@ class AndMatcher : public Matcher {
 public:
   AndMatcher(const envoy::config::rbac::v3::Permission::Set& rules,
              ProtobufMessage::ValidationVisitor& validation_visitor,
-             Server::Configuration::CommonFactoryContext& context);
+             Server::Configuration::CommonFactoryContext& context,
+             SharedMatchers* shared_matchers = nullptr);
   AndMatcher(const envoy::config::rbac::v3::Principal::Set& ids,
-             Server::Configuration::CommonFactoryContext& context);
+             Server::Configuration::CommonFactoryContext& context,
+             SharedMatchers* shared_matchers = nullptr);
 
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo&) const override;
@@ -61,16 +69,20 @@ class OrMatcher : public Matcher {
 public:
   OrMatcher(const envoy::config::rbac::v3::Permission::Set& set,
             ProtobufMessage::ValidationVisitor& validation_visitor,
-            Server::Configuration::CommonFactoryContext& context)
-      : OrMatcher(set.rules(), validation_visitor, context) {}
+            Server::Configuration::CommonFactoryContext& context,
+            SharedMatchers* shared_matchers = nullptr)
+      : OrMatcher(set.rules(), validation_visitor, context, shared_matchers) {}
   OrMatcher(const envoy::config::rbac::v3::Principal::Set& set,
-            Server::Configuration::CommonFactoryContext& context)
-      : OrMatcher(set.ids(), context) {}
+            Server::Configuration::CommonFactoryContext& context,
+            SharedMatchers* shared_matchers = nullptr)
+      : OrMatcher(set.ids(), context, shared_matchers) {}
   OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Permission>& rules,
             ProtobufMessage::ValidationVisitor& validation_visitor,
-            Server::Configuration::CommonFactoryContext& context);
+            Server::Configuration::CommonFactoryContext& context,
+            SharedMatchers* shared_matchers = nullptr);
   OrMatcher(const Protobuf::RepeatedPtrField<envoy::config::rbac::v3::Principal>& ids,
-            Server::Configuration::CommonFactoryContext& context);
+            Server::Configuration::CommonFactoryContext& context,
+            SharedMatchers* shared_matchers = nullptr);
 
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo&) const override;
@@ -83,11 +95,13 @@ class NotMatcher : public Matcher {
 public:
   NotMatcher(const envoy::config::rbac::v3::Permission& permission,
              ProtobufMessage::ValidationVisitor& validation_visitor,
-             Server::Configuration::CommonFactoryContext& context)
-      : matcher_(Matcher::create(permission, validation_visitor, context)) {}
+             Server::Configuration::CommonFactoryContext& context,
+             SharedMatchers* shared_matchers = nullptr)
+      : matcher_(Matcher::create(permission, validation_visitor, context, shared_matchers)) {}
   NotMatcher(const envoy::config::rbac::v3::Principal& principal,
-             Server::Configuration::CommonFactoryContext& context)
-      : matcher_(Matcher::create(principal, context)) {}
+             Server::Configuration::CommonFactoryContext& context,
+             SharedMatchers* shared_matchers = nullptr)
+      : matcher_(Matcher::create(principal, context, shared_matchers)) {}
 
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo&) const override;
@@ -133,14 +147,15 @@ public:
   bool matches(const Network::Connection& connection, const Envoy::Http::RequestHeaderMap& headers,
                const StreamInfo::StreamInfo& info) const override;
 
+  // Helper method to extract IP address based on type, returning a reference to avoid copies.
+  static const Network::Address::InstanceConstSharedPtr&
+  extractIpAddress(Type type, const Network::Connection& connection,
+                   const StreamInfo::StreamInfo& info);
+
 private:
   // Private constructor for LC Trie-based matcher.
   IPMatcher(std::unique_ptr<Network::LcTrie::LcTrie<bool>> trie, Type type);
 
-  // Helper method to extract IP address based on type, returning a reference to avoid copies.
-  const Network::Address::InstanceConstSharedPtr&
-  extractIpAddress(const Network::Connection& connection, const StreamInfo::StreamInfo& info) const;
-
   std::unique_ptr<Network::LcTrie::LcTrie<bool>> trie_;
 
   const Type type_;
@@ -201,9 +216,10 @@ public:
   PolicyMatcher(const envoy::config::rbac::v3::Policy& policy,
                 ProtobufMessage::ValidationVisitor& validation_visitor,
                 Server::Configuration::CommonFactoryContext& context,
-                Expr::BuilderInstanceSharedConstPtr arena_builder)
-      : permissions_(policy.permissions(), validation_visitor, context),
-        principals_(policy.principals(), context),
+                Expr::BuilderInstanceSharedConstPtr arena_builder,
+                SharedMatchers* shared_matchers = nullptr)
+      : permissions_(policy.permissions(), validation_visitor, context, shared_matchers),
+        principals_(policy.principals(), context, shared_matchers),
         expr_([&]() -> absl::optional<Expr::CompiledExpression> {
           if (policy.has_condition()) {
             // Use arena-based builder if provided, otherwise use cached builder.
@@ -303,6 +319,97 @@ private:
   const Router::PathMatcherSharedPtr uri_template_matcher_;
 };
 
+/**
+ * The matchers of the identical permissions and principals of the policies of an engine, which are
+ * created once and shared by the policies. While an Evaluation is in scope, the matchers shared by
+ * several policies or composite matchers are evaluated at most once, and the IP matchers of the
+ * same type of address are all evaluated by a single lookup of the address in a trie of their
+ * ranges.
+ */
+class SharedMatchers : NonCopyable {
+public:
+  class Evaluation;
+
+  /**
+   * @return the shared matcher of a permission, or nullptr if its matcher is not shared, as for the
+   *         matcher extensions.
+   */
+  MatcherConstPtr create(const envoy::config::rbac::v3::Permission& permission,
+                         ProtobufMessage::ValidationVisitor& validation_visitor,
+                         Server::Configuration::CommonFactoryContext& context);
+
+  /**
+   * @return the shared matcher of a principal, or nullptr if its matcher is not shared, as for the
+   *         principal extensions.
+   */
+  MatcherConstPtr create(const envoy::config::rbac::v3::Principal& principal,
+                         Server::Configuration::CommonFactoryContext& context);
+
+  /**
+   * Assigns their results in an Evaluation to the matchers shared by several users, and to the IP
+   * matchers of the types of address matched by several of them. To be called once all the
+   * policies are created.
+   */
+  void finalize();
+
+  // The number of distinct shared matchers.
+  size_t size() const { return entries_.size(); }
+
+private:
+  enum class Result : uint8_t { Unknown, NoMatch, Match };
+  static constexpr uint32_t NoSlot = std::numeric_limits<uint32_t>::max();
+
+  struct Entry {
+    MatcherConstPtr matcher_;
+    // The number of policies and composite matchers using the matcher.
+    uint32_t uses_{0};
+    // The index of the result of the matcher in an Evaluation, if it is memoized.
+    uint32_t slot_{NoSlot};
+    // For the IP matchers, the type of address matched, and the range to index.
+    absl::optional<IPMatcher::Type> ip_type_;
+    std::vector<Network::Address::CidrRange> ip_ranges_;
+  };
+
+  // The IP matchers of a type of address.
+  struct IpIndex {
+    std::vector<Entry*> entries_;
+    // The slots of the IP matchers matching each range. Only built for several matchers.
+    std::unique_ptr<Network::LcTrie::LcTrie<uint32_t>> trie_;
+    std::vector<uint32_t> slots_;
+  };
+
+  class EntryMatcher;
+
+  Entry& entry(const Protobuf::Message& config, const std::function<MatcherConstPtr()>& create,
+               bool& created);
+  void indexIp(Entry& entry, const envoy::config::core::v3::CidrRange& range, IPMatcher::Type type);
+  // Sets the results of all the IP matchers of a type of address.
+  void lookupIp(IPMatcher::Type type, const Network::Connection& connection,
+                const StreamInfo::StreamInfo& info, std::vector<Result>& results) const;
+
+  // Keyed by the type and serialized config of the permissions and principals.
+  absl::flat_hash_map<std::string, std::unique_ptr<Entry>> entries_;
+  std::array<IpIndex, 4> ip_indexes_;
+  uint32_t slots_{0};
+};
+
+/**
+ * The memoized results of the shared matchers while the policies of their engine are evaluated for
+ * a connection or request on the current thread.
+ */
+class SharedMatchers::Evaluation : NonCopyable {
+public:
+  explicit Evaluation(const SharedMatchers& shared_matchers);
+  ~Evaluation();
+
+private:
+  friend class SharedMatchers::EntryMatcher;
+
+  const SharedMatchers& shared_matchers_;
+  Evaluation* const previous_;
+  std::vector<Result> results_;
+};
+
 } // namespace RBAC
 } // namespace Common
 } // namespace Filters
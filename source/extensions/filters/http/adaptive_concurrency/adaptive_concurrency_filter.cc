@@ -8,6 +8,7 @@
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/http/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/controller.h"
 
@@ -47,6 +48,13 @@ Http::FilterHeadersStatus AdaptiveConcurrencyFilter::decodeHeaders(Http::Request
     return Http::FilterHeadersStatus::Continue;
   }
 
+  const auto* route_config =
+      Http::Utility::resolveMostSpecificPerFilterConfig<AdaptiveConcurrencyRouteConfig>(
+          decoder_callbacks_);
+  if (route_config != nullptr) {
+    controller_ = route_config->controller();
+  }
+
   if (controller_->forwardingDecision() == Controller::RequestForwardingAction::Block) {
     decoder_callbacks_->sendLocalReply(config_->concurrencyLimitExceededStatus(),
                                        "reached concurrency limit", nullptr, absl::nullopt,
@@ -3,15 +3,74 @@
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.validate.h"
 #include "envoy/registry/registry.h"
+#include "envoy/singleton/manager.h"
 
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/adaptive_concurrency/adaptive_concurrency_filter.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/gradient_controller.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
 namespace AdaptiveConcurrency {
 
+SINGLETON_MANAGER_REGISTRATION(adaptive_concurrency_route_controllers);
+
+namespace {
+
+/**
+ * The controllers of the per-route configurations, shared by the routes with the same stats and
+ * controller configuration, so that their limit and minRTT survive route configuration updates.
+ *
+ * Note: the route configurations, and so the registry, are only created on the main thread.
+ */
+class RouteControllers : public Singleton::Instance {
+public:
+  ConcurrencyControllerSharedPtr
+  getOrCreate(const std::string& key,
+              const std::function<ConcurrencyControllerSharedPtr()>& create_controller) {
+    ConcurrencyControllerSharedPtr controller = controllers_[key].lock();
+    if (controller == nullptr) {
+      // Forget the controllers no longer used by any route.
+      absl::erase_if(controllers_, [](const auto& entry) { return entry.second.expired(); });
+      controller = create_controller();
+      controllers_[key] = controller;
+    }
+    return controller;
+  }
+
+private:
+  absl::flat_hash_map<std::string, std::weak_ptr<Controller::ConcurrencyController>> controllers_;
+};
+
+} // namespace
+
+absl::StatusOr<Router::RouteSpecificFilterConfigConstSharedPtr>
+AdaptiveConcurrencyFilterFactory::createRouteSpecificFilterConfigTyped(
+    const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrencyPerRoute&
+        proto_config,
+    Server::Configuration::ServerFactoryContext& context, ProtobufMessage::ValidationVisitor&) {
+  auto route_controllers = context.singletonManager().getTyped<RouteControllers>(
+      SINGLETON_MANAGER_REGISTERED_NAME(adaptive_concurrency_route_controllers),
+      [] { return std::make_shared<RouteControllers>(); },
+      /* pin = */ true);
+  const std::string key =
+      absl::StrCat(proto_config.stat_prefix(), "_",
+                   MessageUtil::hash(proto_config.gradient_controller_config()));
+  ConcurrencyControllerSharedPtr controller = route_controllers->getOrCreate(key, [&]() {
+    return std::make_shared<Controller::GradientController>(
+        Controller::GradientControllerConfig(proto_config.gradient_controller_config(),
+                                             context.runtime()),
+        context.mainThreadDispatcher(), context.runtime(),
+        absl::StrCat("adaptive_concurrency.", proto_config.stat_prefix(), ".gradient_controller."),
+        context.scope(), context.api().randomGenerator(), context.timeSource());
+  });
+  return std::make_shared<const AdaptiveConcurrencyRouteConfig>(std::move(controller));
+}
+
 Http::FilterFactoryCb AdaptiveConcurrencyFilterFactory::createFilterFactory(
     const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency& config,
     const std::string& stats_prefix, Server::Configuration::ServerFactoryContext& server_context,
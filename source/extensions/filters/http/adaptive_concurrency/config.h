@@ -15,7 +15,8 @@ namespace AdaptiveConcurrency {
  */
 class AdaptiveConcurrencyFilterFactory
     : public Common::FactoryBase<
-          envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency> {
+          envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency,
+          envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrencyPerRoute> {
 public:
   AdaptiveConcurrencyFilterFactory() : FactoryBase("envoy.filters.http.adaptive_concurrency") {}
 
@@ -35,6 +36,13 @@ public:
   }
 
 private:
+  absl::StatusOr<Router::RouteSpecificFilterConfigConstSharedPtr>
+  createRouteSpecificFilterConfigTyped(
+      const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrencyPerRoute&
+          proto_config,
+      Server::Configuration::ServerFactoryContext& context,
+      ProtobufMessage::ValidationVisitor& validator) override;
+
   Http::FilterFactoryCb createFilterFactory(
       const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency&
           proto_config,
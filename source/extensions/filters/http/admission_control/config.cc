@@ -49,8 +49,13 @@ absl::StatusOr<Http::FilterFactoryCb> AdmissionControlFilterFactory::createFilte
   auto sampling_window = std::chrono::seconds(
       PROTOBUF_GET_MS_OR_DEFAULT(config, sampling_window, 1000 * defaultSamplingWindow.count()) /
       1000);
-  tls->set([sampling_window, &context](Event::Dispatcher&) {
-    return std::make_shared<ThreadLocalControllerImpl>(context.timeSource(), sampling_window);
+  WorkerRequestCountsSharedPtr worker_counts;
+  if (config.aggregate_across_workers()) {
+    worker_counts = std::make_shared<WorkerRequestCounts>(sampling_window);
+  }
+  tls->set([sampling_window, worker_counts, &context](Event::Dispatcher&) {
+    return std::make_shared<ThreadLocalControllerImpl>(context.timeSource(), sampling_window,
+                                                       worker_counts);
   });
 
   std::unique_ptr<ResponseEvaluator> response_evaluator;
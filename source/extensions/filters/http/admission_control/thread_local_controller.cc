@@ -13,9 +13,34 @@ namespace AdmissionControl {
 
 static constexpr std::chrono::seconds defaultHistoryGranularity{1};
 
+uint32_t WorkerRequestCounts::addWorker() {
+  absl::MutexLock lock(mutex_);
+  workers_.push_back({MonotonicTime(), RequestData()});
+  return workers_.size() - 1;
+}
+
+WorkerRequestCounts::RequestData WorkerRequestCounts::publish(uint32_t worker, MonotonicTime now,
+                                                              const RequestData& counts) {
+  RequestData other_workers;
+  absl::MutexLock lock(mutex_);
+  workers_[worker] = {now, counts};
+  for (uint32_t i = 0; i < workers_.size(); ++i) {
+    // The workers which stopped publishing, e.g. as they are idle, have no recent requests.
+    if (i == worker || now - workers_[i].published_ >= sampling_window_) {
+      continue;
+    }
+    other_workers.requests += workers_[i].counts_.requests;
+    other_workers.successes += workers_[i].counts_.successes;
+  }
+  return other_workers;
+}
+
 ThreadLocalControllerImpl::ThreadLocalControllerImpl(TimeSource& time_source,
-                                                     std::chrono::seconds sampling_window)
-    : time_source_(time_source), sampling_window_(sampling_window) {}
+                                                     std::chrono::seconds sampling_window,
+                                                     WorkerRequestCountsSharedPtr worker_counts)
+    : time_source_(time_source), sampling_window_(sampling_window),
+      worker_counts_(std::move(worker_counts)),
+      worker_(worker_counts_ != nullptr ? worker_counts_->addWorker() : 0) {}
 
 uint32_t ThreadLocalControllerImpl::averageRps() const {
   if (historical_data_.empty() || global_data_.requests == 0) {
@@ -37,7 +62,12 @@ void ThreadLocalControllerImpl::maybeUpdateHistoricalData() {
   // necessary to add an empty entry. We will also need to roll over into a new entry in the
   // historical data if we've exceeded the time specified by the granularity.
   if (historical_data_.empty() || ageOfNewestSample() >= defaultHistoryGranularity) {
-    historical_data_.emplace_back(time_source_.monotonicTime(), RequestData());
+    const MonotonicTime now = time_source_.monotonicTime();
+    if (worker_counts_ != nullptr) {
+      // Exchange the counts of the whole window with the other workers once per entry.
+      other_workers_data_ = worker_counts_->publish(worker_, now, global_data_);
+    }
+    historical_data_.emplace_back(now, RequestData());
   }
 }
 
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "envoy/common/pure.h"
 #include "envoy/common/time.h"
 #include "envoy/http/codes.h"
 #include "envoy/thread_local/thread_local_object.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -45,6 +52,42 @@ public:
   virtual std::chrono::seconds samplingWindow() const PURE;
 };
 
+/**
+ * The request counts of the sampling windows of all the workers, which their thread-local
+ * controllers publish, and merge with those of the other workers, once per history granularity
+ * rather than for each request.
+ */
+class WorkerRequestCounts {
+public:
+  using RequestData = ThreadLocalController::RequestData;
+
+  explicit WorkerRequestCounts(std::chrono::seconds sampling_window)
+      : sampling_window_(sampling_window) {}
+
+  /**
+   * @return the index of the counts of a new worker.
+   */
+  uint32_t addWorker();
+
+  /**
+   * Publishes the counts of the sampling window of a worker.
+   * @return the sum of the counts last published by the other workers, within the sampling window.
+   */
+  RequestData publish(uint32_t worker, MonotonicTime now, const RequestData& counts);
+
+private:
+  struct Counts {
+    MonotonicTime published_;
+    RequestData counts_;
+  };
+
+  const std::chrono::seconds sampling_window_;
+  absl::Mutex mutex_;
+  std::vector<Counts> workers_ ABSL_GUARDED_BY(mutex_);
+};
+
+using WorkerRequestCountsSharedPtr = std::shared_ptr<WorkerRequestCounts>;
+
 /**
  * Thread-local object to track request counts and successes over a rolling time window. Request
  * data for the time window is kept recent via a circular buffer that phases out old request/success
@@ -59,14 +102,17 @@ public:
 class ThreadLocalControllerImpl : public ThreadLocalController,
                                   public ThreadLocal::ThreadLocalObject {
 public:
-  ThreadLocalControllerImpl(TimeSource& time_source, std::chrono::seconds sampling_window);
+  // If worker_counts is set, the request counts include those of the other workers.
+  ThreadLocalControllerImpl(TimeSource& time_source, std::chrono::seconds sampling_window,
+                            WorkerRequestCountsSharedPtr worker_counts = nullptr);
   ~ThreadLocalControllerImpl() override = default;
   void recordSuccess() override { recordRequest(true); }
   void recordFailure() override { recordRequest(false); }
 
   RequestData requestCounts() override {
     maybeUpdateHistoricalData();
-    return global_data_;
+    return {global_data_.requests + other_workers_data_.requests,
+            global_data_.successes + other_workers_data_.successes};
   }
 
   uint32_t averageRps() const override;
@@ -115,6 +161,13 @@ private:
 
   // The rolling time window size.
   const std::chrono::seconds sampling_window_;
+
+  // The counts shared with the other workers, if any, and the index of those of this worker.
+  const WorkerRequestCountsSharedPtr worker_counts_;
+  const uint32_t worker_{0};
+
+  // Request data of the other workers, as of the last time this worker published its own.
+  RequestData other_workers_data_;
 };
 
 } // namespace AdmissionControl
@@ -1,5 +1,6 @@
 #include "source/extensions/filters/http/bandwidth_limit/bandwidth_limit.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,10 @@ FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
           config, fill_interval, StreamRateLimiter::DefaultFillInterval.count()))),
       enabled_(config.runtime_enabled(), runtime),
       stats_(generateStats(config.stat_prefix(), scope)),
+      tenant_header_(config.tenant_header().empty()
+                         ? absl::nullopt
+                         : absl::make_optional<Http::LowerCaseString>(config.tenant_header())),
+      tenant_limit_kbps_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, tenant_limit_kbps, 0)),
       request_delay_trailer_(
           config.response_trailer_prefix().empty()
               ? DefaultRequestDelayTrailer
@@ -73,6 +78,11 @@ FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
     creation_status = absl::InvalidArgumentError("limit must be set for per route filter config");
     return;
   }
+  if (tenant_header_.has_value() && !config.has_tenant_limit_kbps()) {
+    creation_status =
+        absl::InvalidArgumentError("tenant_limit_kbps must be set with tenant_header");
+    return;
+  }
 
   // The token bucket is configured with a max token count of the number of
   // bytes per second, and refills at the same rate, so that we have a per
@@ -82,6 +92,49 @@ FilterConfig::FilterConfig(const BandwidthLimit& config, Stats::Scope& scope,
       StreamRateLimiter::kiloBytesToBytes(limit_kbps_));
 }
 
+std::shared_ptr<TokenBucket>
+FilterConfig::tokenBucket(const Http::RequestHeaderMap& headers) const {
+  if (!tenant_header_.has_value()) {
+    return token_bucket_;
+  }
+  const auto tenant = headers.get(tenant_header_.value());
+  if (tenant.empty()) {
+    return token_bucket_;
+  }
+
+  const std::string key(tenant[0]->value().getStringView());
+  std::shared_ptr<SharedTokenBucketImpl> tenant_bucket;
+  {
+    absl::MutexLock lock(tenant_buckets_mutex_);
+    tenant_bucket = tenant_buckets_[key].lock();
+    if (tenant_bucket == nullptr) {
+      // Forget the tenants with no stream left.
+      absl::erase_if(tenant_buckets_, [](const auto& entry) { return entry.second.expired(); });
+      const uint64_t max_tokens = StreamRateLimiter::kiloBytesToBytes(tenant_limit_kbps_);
+      tenant_bucket = std::make_shared<SharedTokenBucketImpl>(max_tokens, time_source_, max_tokens);
+      // Like the limiters do for the shared bucket, starts with one fill interval of tokens.
+      tenant_bucket->maybeReset(max_tokens * fill_interval_.count() / 1000);
+      tenant_buckets_[key] = tenant_bucket;
+    }
+  }
+  return std::make_shared<TenantTokenBucket>(std::move(tenant_bucket), token_bucket_);
+}
+
+uint64_t TenantTokenBucket::consume(uint64_t tokens, bool allow_partial) {
+  return shared_bucket_->consume(tenant_bucket_->consume(tokens, allow_partial), allow_partial);
+}
+
+uint64_t TenantTokenBucket::consume(uint64_t tokens, bool allow_partial,
+                                    std::chrono::milliseconds& time_to_next_token) {
+  const uint64_t consumed = consume(tokens, allow_partial);
+  time_to_next_token = nextTokenAvailable();
+  return consumed;
+}
+
+std::chrono::milliseconds TenantTokenBucket::nextTokenAvailable() {
+  return std::max(tenant_bucket_->nextTokenAvailable(), shared_bucket_->nextTokenAvailable());
+}
+
 BandwidthLimitStats FilterConfig::generateStats(const std::string& prefix, Stats::Scope& scope) {
   const std::string final_prefix = prefix + ".http_bandwidth_limit";
   return {ALL_BANDWIDTH_LIMIT_STATS(POOL_COUNTER_PREFIX(scope, final_prefix),
@@ -91,8 +144,9 @@ BandwidthLimitStats FilterConfig::generateStats(const std::string& prefix, Stats
 
 // BandwidthLimiter members
 
-Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap&, bool) {
+Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap& headers, bool) {
   const auto& config = getConfig();
+  token_bucket_ = config.tokenBucket(headers);
 
   if (config.enabled() && (config.enableMode() & BandwidthLimit::REQUEST)) {
     config.stats().request_enabled_.inc();
@@ -119,7 +173,7 @@ Http::FilterHeadersStatus BandwidthLimiter::decodeHeaders(Http::RequestHeaderMap
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), decoder_callbacks_->dispatcher(),
-        decoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        decoder_callbacks_->scope(), token_bucket_, config.fillInterval());
   }
 
   return Http::FilterHeadersStatus::Continue;
@@ -186,7 +240,8 @@ Http::FilterHeadersStatus BandwidthLimiter::encodeHeaders(Http::ResponseHeaderMa
           }
         },
         const_cast<FilterConfig*>(&config)->timeSource(), encoder_callbacks_->dispatcher(),
-        encoder_callbacks_->scope(), config.tokenBucket(), config.fillInterval());
+        encoder_callbacks_->scope(),
+        token_bucket_ != nullptr ? token_bucket_ : config.tokenBucket(), config.fillInterval());
   }
 
   return Http::FilterHeadersStatus::Continue;
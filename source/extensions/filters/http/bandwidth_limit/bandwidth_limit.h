@@ -19,6 +19,7 @@
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/stream_rate_limiter.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 
 namespace Envoy {
@@ -55,6 +56,30 @@ struct BandwidthLimitStats {
                             GENERATE_HISTOGRAM_STRUCT)
 };
 
+/**
+ * The token bucket of a tenant, drawing its tokens from both its own bucket and the bucket of the
+ * route or listener, which is shared by all the tenants. The tokens of the tenant the shared bucket
+ * could not match are lost, which only delays that tenant further.
+ */
+class TenantTokenBucket : public TokenBucket {
+public:
+  TenantTokenBucket(std::shared_ptr<SharedTokenBucketImpl> tenant_bucket,
+                    std::shared_ptr<SharedTokenBucketImpl> shared_bucket)
+      : tenant_bucket_(std::move(tenant_bucket)), shared_bucket_(std::move(shared_bucket)) {}
+
+  // TokenBucket
+  uint64_t consume(uint64_t tokens, bool allow_partial) override;
+  uint64_t consume(uint64_t tokens, bool allow_partial,
+                   std::chrono::milliseconds& time_to_next_token) override;
+  std::chrono::milliseconds nextTokenAvailable() override;
+  // The bucket of the tenant is reset when it is created.
+  void maybeReset(uint64_t num_tokens) override { shared_bucket_->maybeReset(num_tokens); }
+
+private:
+  const std::shared_ptr<SharedTokenBucketImpl> tenant_bucket_;
+  const std::shared_ptr<SharedTokenBucketImpl> shared_bucket_;
+};
+
 /**
  * Configuration for the HTTP bandwidth limit filter.
  */
@@ -77,6 +102,11 @@ public:
   EnableMode enableMode() const { return enable_mode_; };
   const std::shared_ptr<SharedTokenBucketImpl> tokenBucket() const { return token_bucket_; }
   std::chrono::milliseconds fillInterval() const { return fill_interval_; }
+  /**
+   * @return the token bucket limiting the streams of the tenant of a request, or the bucket of the
+   *         filter if the tenants are not limited or the request has no tenant header.
+   */
+  std::shared_ptr<TokenBucket> tokenBucket(const Http::RequestHeaderMap& headers) const;
   const Http::LowerCaseString& requestDelayTrailer() const { return request_delay_trailer_; }
   const Http::LowerCaseString& responseDelayTrailer() const { return response_delay_trailer_; }
   const Http::LowerCaseString& requestFilterDelayTrailer() const {
@@ -105,6 +135,12 @@ private:
   mutable BandwidthLimitStats stats_;
   // Filter chain's shared token bucket
   std::shared_ptr<SharedTokenBucketImpl> token_bucket_;
+  const absl::optional<Http::LowerCaseString> tenant_header_;
+  const uint64_t tenant_limit_kbps_;
+  mutable absl::Mutex tenant_buckets_mutex_;
+  // The buckets of the tenants with streams in progress, on any worker.
+  mutable absl::flat_hash_map<std::string, std::weak_ptr<SharedTokenBucketImpl>>
+      tenant_buckets_ ABSL_GUARDED_BY(tenant_buckets_mutex_);
   const Http::LowerCaseString request_delay_trailer_;
   const Http::LowerCaseString response_delay_trailer_;
   const Http::LowerCaseString request_filter_delay_trailer_;
@@ -163,6 +199,8 @@ private:
   Http::StreamDecoderFilterCallbacks* decoder_callbacks_{};
   Http::StreamEncoderFilterCallbacks* encoder_callbacks_{};
   FilterConfigSharedPtr config_;
+  // The bucket of the tenant of the stream, selected from the request headers.
+  std::shared_ptr<TokenBucket> token_bucket_;
   std::unique_ptr<Envoy::Extensions::HttpFilters::Common::StreamRateLimiter> request_limiter_;
   std::unique_ptr<Envoy::Extensions::HttpFilters::Common::StreamRateLimiter> response_limiter_;
   Stats::TimespanPtr request_latency_;
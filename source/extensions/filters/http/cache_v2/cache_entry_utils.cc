@@ -29,6 +29,10 @@ absl::string_view cacheEntryStatusString(CacheEntryStatus s) {
     return "LookupError";
   case CacheEntryStatus::UpstreamReset:
     return "UpstreamReset";
+  case CacheEntryStatus::FollowerTimeout:
+    return "FollowerTimeout";
+  case CacheEntryStatus::StaleWhileRevalidate:
+    return "StaleWhileRevalidate";
   }
   IS_ENVOY_BUG(absl::StrCat("Unexpected CacheEntryStatus: ", s));
   return "UnexpectedCacheEntryStatus";
@@ -53,6 +53,12 @@ enum class CacheEntryStatus {
   LookupError,
   // The cache attempted to read from upstream for insert, but upstream reset.
   UpstreamReset,
+  // The request waited for longer than max_follower_wait for the response being
+  // fetched by another request, so it went to the upstream by itself.
+  FollowerTimeout,
+  // This entry was stale, and served without waiting for its validation, which was started in
+  // the background as allowed by its stale-while-revalidate directive.
+  StaleWhileRevalidate,
 };
 
 absl::string_view cacheEntryStatusString(CacheEntryStatus s);
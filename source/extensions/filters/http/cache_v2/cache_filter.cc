@@ -6,6 +6,7 @@
 #include "source/common/common/enum_to_int.h"
 #include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache_v2/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache_v2/cacheability_utils.h"
 #include "source/extensions/filters/http/cache_v2/upstream_request_impl.h"
@@ -31,6 +32,19 @@ namespace {
 //
 // And everyone knows 64MB should be enough for anyone.
 static constexpr size_t MaxBytesToFetchFromCachePerRead = 64 * 1024 * 1024;
+
+// The responses varying on accept-encoding are cacheable when their variants are keyed apart.
+Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allowedVaryHeaders(
+    const envoy::extensions::filters::http::cache_v2::v3::CacheV2Config& config) {
+  Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher> allowed =
+      config.allowed_vary_headers();
+  if (!config.content_encoding_variants().empty()) {
+    envoy::type::matcher::v3::StringMatcher* matcher = allowed.Add();
+    matcher->set_exact(Http::CustomHeaders::get().AcceptEncoding.get());
+    matcher->set_ignore_case(true);
+  }
+  return allowed;
+}
 } // namespace
 
 namespace CacheResponseCodeDetails {
@@ -46,8 +60,11 @@ CacheFilterConfig::CacheFilterConfig(
     const envoy::extensions::filters::http::cache_v2::v3::CacheV2Config& config,
     std::shared_ptr<CacheSessions> cache_sessions,
     Server::Configuration::CommonFactoryContext& context)
-    : vary_allow_list_(config.allowed_vary_headers(), context), time_source_(context.timeSource()),
+    : vary_allow_list_(allowedVaryHeaders(config), context), time_source_(context.timeSource()),
       ignore_request_cache_control_header_(config.ignore_request_cache_control_header()),
+      max_follower_wait_(PROTOBUF_GET_MS_OR_DEFAULT(config, max_follower_wait, 0)),
+      content_encoding_variants_(config.content_encoding_variants().begin(),
+                                 config.content_encoding_variants().end()),
       cluster_manager_(context.clusterManager()), cache_sessions_(std::move(cache_sessions)),
       override_upstream_cluster_(config.override_upstream_cluster()) {}
 
@@ -151,7 +168,8 @@ Http::FilterHeadersStatus CacheFilter::decodeHeaders(Http::RequestHeaderMap& hea
   auto lookup_request = std::make_unique<ActiveLookupRequest>(
       headers, std::move(upstream_request_factory), *original_cluster_name,
       decoder_callbacks_->dispatcher(), config_->timeSource().systemTime(), config_, config_,
-      config_->ignoreRequestCacheControlHeader());
+      config_->ignoreRequestCacheControlHeader(), config_->maxFollowerWait(),
+      config_->contentEncodingVariants());
   is_head_request_ = headers.getMethodValue() == Http::Headers::get().MethodValues.Head;
   ENVOY_STREAM_LOG(debug, "CacheFilter::decodeHeaders starting lookup", *decoder_callbacks_);
   config_->cacheSessions().lookup(
@@ -175,9 +193,11 @@ static absl::string_view responseCodeDetailsFromStatus(CacheEntryStatus status)
   case CacheEntryStatus::Validated:
   case CacheEntryStatus::ValidatedFree:
   case CacheEntryStatus::UpstreamReset:
+  case CacheEntryStatus::StaleWhileRevalidate:
     return CacheResponseCodeDetails::ResponseFromCacheFilter;
   case CacheEntryStatus::Uncacheable:
   case CacheEntryStatus::LookupError:
+  case CacheEntryStatus::FollowerTimeout:
     break;
   }
   return StreamInfo::ResponseCodeDetails::get().ViaUpstream;
@@ -34,6 +34,10 @@ public:
   Upstream::ClusterManager& clusterManager() const { return cluster_manager_; }
   const std::string& overrideUpstreamCluster() const { return override_upstream_cluster_; }
   bool ignoreRequestCacheControlHeader() const { return ignore_request_cache_control_header_; }
+  std::chrono::milliseconds maxFollowerWait() const { return max_follower_wait_; }
+  const std::vector<std::string>& contentEncodingVariants() const {
+    return content_encoding_variants_;
+  }
   CacheSessions& cacheSessions() const { return *cache_sessions_; }
   bool hasCache() const { return cache_sessions_ != nullptr; }
   CacheFilterStats& stats() const override { return cache_sessions_->stats(); }
@@ -42,6 +46,8 @@ private:
   const VaryAllowList vary_allow_list_;
   TimeSource& time_source_;
   const bool ignore_request_cache_control_header_;
+  const std::chrono::milliseconds max_follower_wait_;
+  const std::vector<std::string> content_encoding_variants_;
   Upstream::ClusterManager& cluster_manager_;
   Http::AsyncClient::StreamOptions upstream_options_;
   std::shared_ptr<CacheSessions> cache_sessions_;
@@ -16,8 +16,10 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/btree_set.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -111,6 +113,8 @@ ResponseCacheControl::ResponseCacheControl(absl::string_view cache_control_heade
       max_age_ = parseDuration(argument);
     } else if (!max_age_.has_value() && directive == "max-age") {
       max_age_ = parseDuration(argument);
+    } else if (directive == "stale-while-revalidate") {
+      stale_while_revalidate_ = parseDuration(argument);
     }
   }
 }
@@ -125,7 +129,8 @@ bool operator==(const RequestCacheControl& lhs, const RequestCacheControl& rhs)
 bool operator==(const ResponseCacheControl& lhs, const ResponseCacheControl& rhs) {
   return (lhs.must_validate_ == rhs.must_validate_) && (lhs.no_store_ == rhs.no_store_) &&
          (lhs.no_transform_ == rhs.no_transform_) && (lhs.no_stale_ == rhs.no_stale_) &&
-         (lhs.is_public_ == rhs.is_public_) && (lhs.max_age_ == rhs.max_age_);
+         (lhs.is_public_ == rhs.is_public_) && (lhs.max_age_ == rhs.max_age_) &&
+         (lhs.stale_while_revalidate_ == rhs.stale_while_revalidate_);
 }
 
 std::ostream& operator<<(std::ostream& os, const RequestCacheControl& request_cache_control) {
@@ -181,6 +186,10 @@ std::ostream& operator<<(std::ostream& os, const ResponseCacheControl& response_
     fields.push_back(
         absl::StrCat("max-age=", std::to_string(response_cache_control.max_age_->count())));
   }
+  if (response_cache_control.stale_while_revalidate_.has_value()) {
+    fields.push_back(absl::StrCat("stale-while-revalidate=",
+                                  response_cache_control.stale_while_revalidate_->count()));
+  }
 
   return os << "{" << absl::StrJoin(fields, ", ") << "}";
 }
@@ -346,6 +355,49 @@ CacheHeadersUtils::parseCommaDelimitedHeader(const Http::HeaderMap::GetResult& e
   return values;
 }
 
+std::string
+CacheHeadersUtils::negotiateContentEncoding(const Http::RequestHeaderMap& request_headers,
+                                            const std::vector<std::string>& content_codings) {
+  if (content_codings.empty()) {
+    return "";
+  }
+  std::vector<std::pair<absl::string_view, double>> accepted;
+  absl::optional<double> wildcard_q_value;
+  for (absl::string_view value :
+       parseCommaDelimitedHeader(request_headers.get(Http::CustomHeaders::get().AcceptEncoding))) {
+    std::vector<absl::string_view> params = absl::StrSplit(value, ';');
+    const absl::string_view coding = absl::StripAsciiWhitespace(params[0]);
+    double q_value = 1;
+    for (size_t i = 1; i < params.size(); ++i) {
+      absl::string_view param = absl::StripAsciiWhitespace(params[i]);
+      if ((absl::ConsumePrefix(&param, "q=") || absl::ConsumePrefix(&param, "Q=")) &&
+          !absl::SimpleAtod(param, &q_value)) {
+        // A malformed q-value accepts nothing, rather than risking an unwanted coding.
+        q_value = 0;
+      }
+    }
+    if (coding == "*") {
+      wildcard_q_value = q_value;
+    } else {
+      accepted.emplace_back(coding, q_value);
+    }
+  }
+  const std::string* best = nullptr;
+  double best_q_value = 0;
+  for (const std::string& content_coding : content_codings) {
+    auto it = absl::c_find_if(accepted, [&content_coding](const auto& coding) {
+      return absl::EqualsIgnoreCase(coding.first, content_coding);
+    });
+    // The wildcard only stands for the codings not listed explicitly.
+    const double q_value = it != accepted.end() ? it->second : wildcard_q_value.value_or(0);
+    if (q_value > best_q_value) {
+      best = &content_coding;
+      best_q_value = q_value;
+    }
+  }
+  return best == nullptr ? "" : *best;
+}
+
 VaryAllowList::VaryAllowList(
     const Protobuf::RepeatedPtrField<envoy::type::matcher::v3::StringMatcher>& allow_list,
     Server::Configuration::CommonFactoryContext& context) {
@@ -411,6 +463,12 @@ VaryHeaderUtils::getVaryValues(const Http::ResponseHeaderMap& headers) {
   return {values.begin(), values.end()};
 }
 
+bool VaryHeaderUtils::variesOnlyOnAcceptEncoding(const Http::ResponseHeaderMap& headers) {
+  const absl::btree_set<absl::string_view> values = getVaryValues(headers);
+  return values.size() == 1 &&
+         absl::EqualsIgnoreCase(*values.begin(), Http::CustomHeaders::get().AcceptEncoding.get());
+}
+
 namespace {
 // The separator characters are used to create the vary-key, and must be characters that are
 // invalid to be inside values and header names. The chosen characters are invalid per:
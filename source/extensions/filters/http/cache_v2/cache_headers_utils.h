@@ -92,6 +92,12 @@ struct ResponseCacheControl {
   // max_age is set if to 's-maxage' if present, if not it is set to 'max-age' if present.
   // Indicates the maximum time after which this response will be considered stale
   OptionalDuration max_age_;
+
+  // 'stale-while-revalidate' directive, as defined by:
+  // https://httpwg.org/specs/rfc5861.html#n-the-stale-while-revalidate-cache-control-extension
+  // This response may be served stale for this long after it became stale, while it is
+  // validated in the background
+  OptionalDuration stale_while_revalidate_;
 };
 
 bool operator==(const RequestCacheControl& lhs, const RequestCacheControl& rhs);
@@ -135,6 +141,12 @@ void getAllMatchingHeaderNames(const Http::HeaderMap& headers,
 // Parses the values of a comma-delimited list as defined per
 // https://tools.ietf.org/html/rfc7230#section-7.
 std::vector<absl::string_view> parseCommaDelimitedHeader(const Http::HeaderMap::GetResult& entry);
+
+// Returns the first of content_codings which the accept-encoding header of the request accepts
+// with the highest q-value, as per https://httpwg.org/specs/rfc9110.html#field.accept-encoding,
+// or an empty string if it accepts none of them.
+std::string negotiateContentEncoding(const Http::RequestHeaderMap& request_headers,
+                                     const std::vector<std::string>& content_codings);
 } // namespace CacheHeadersUtils
 
 // Helper abstraction for a container that contains a VaryAllowList.
@@ -171,6 +183,9 @@ bool hasVary(const Http::ResponseHeaderMap& headers);
 // map across all vary header entries.
 absl::btree_set<absl::string_view> getVaryValues(const Envoy::Http::ResponseHeaderMap& headers);
 
+// Checks if accept-encoding is the only header named by the Vary header.
+bool variesOnlyOnAcceptEncoding(const Http::ResponseHeaderMap& headers);
+
 // Creates a single string combining the values of the varied headers from
 // entry_headers. Returns an absl::nullopt if no valid vary key can be created
 // and the response should not be cached (eg. when disallowed vary headers are
@@ -2,6 +2,7 @@
 
 #include <limits>
 
+#include "source/common/http/headers.h"
 #include "source/common/http/utility.h"
 #include "source/extensions/filters/http/cache_v2/cache_custom_headers.h"
 #include "source/extensions/filters/http/cache_v2/cache_headers_utils.h"
@@ -11,21 +12,53 @@ namespace Extensions {
 namespace HttpFilters {
 namespace CacheV2 {
 
+namespace {
+
+SystemTime::duration freshnessLifetime(const Http::ResponseHeaderMap& response_headers,
+                                       const ResponseCacheControl& response_cache_control) {
+  // CacheabilityUtils::isCacheableResponse(..) guarantees that any cached response satisfies this.
+  ASSERT(response_cache_control.max_age_.has_value() ||
+             (response_headers.getInline(CacheCustomHeaders::expires()) && response_headers.Date()),
+         "Cache entry does not have valid expiration data.");
+
+  if (response_cache_control.max_age_.has_value()) {
+    return response_cache_control.max_age_.value();
+  }
+  const SystemTime expires_value =
+      CacheHeadersUtils::httpTime(response_headers.getInline(CacheCustomHeaders::expires()));
+  const SystemTime date_value = CacheHeadersUtils::httpTime(response_headers.Date());
+  return expires_value - date_value;
+}
+
+} // namespace
+
 ActiveLookupRequest::ActiveLookupRequest(
     const Http::RequestHeaderMap& request_headers,
     UpstreamRequestFactoryPtr upstream_request_factory, absl::string_view cluster_name,
     Event::Dispatcher& dispatcher, SystemTime timestamp,
     const std::shared_ptr<const CacheableResponseChecker> cacheable_response_checker,
     const std::shared_ptr<const CacheFilterStatsProvider> stats_provider,
-    bool ignore_request_cache_control_header)
+    bool ignore_request_cache_control_header, std::chrono::milliseconds max_follower_wait,
+    const std::vector<std::string>& content_encoding_variants)
     : upstream_request_factory_(std::move(upstream_request_factory)), dispatcher_(dispatcher),
       key_(CacheHeadersUtils::makeKey(request_headers, cluster_name)),
       request_headers_(Http::createHeaderMap<Http::RequestHeaderMapImpl>(request_headers)),
       cacheable_response_checker_(std::move(cacheable_response_checker)),
-      stats_provider_(std::move(stats_provider)), timestamp_(timestamp) {
+      stats_provider_(std::move(stats_provider)), timestamp_(timestamp),
+      max_follower_wait_(max_follower_wait),
+      keyed_by_content_encoding_(!content_encoding_variants.empty()) {
   if (!ignore_request_cache_control_header) {
     initializeRequestCacheControl(request_headers);
   }
+  if (keyed_by_content_encoding_) {
+    // Upstream is only asked for the negotiated coding, so that all the requests negotiating the
+    // same coding can share its response.
+    const std::string content_encoding =
+        CacheHeadersUtils::negotiateContentEncoding(request_headers, content_encoding_variants);
+    request_headers_->setCopy(Http::CustomHeaders::get().AcceptEncoding,
+                              content_encoding.empty() ? "identity" : content_encoding);
+    key_.set_content_encoding(content_encoding);
+  }
 }
 
 absl::optional<std::vector<RawByteRange>> ActiveLookupRequest::parseRange() const {
@@ -73,21 +106,8 @@ bool ActiveLookupRequest::requiresValidation(const Http::ResponseHeaderMap& resp
     return true;
   }
 
-  // CacheabilityUtils::isCacheableResponse(..) guarantees that any cached response satisfies this.
-  ASSERT(response_cache_control.max_age_.has_value() ||
-             (response_headers.getInline(CacheCustomHeaders::expires()) && response_headers.Date()),
-         "Cache entry does not have valid expiration data.");
-
-  SystemTime::duration freshness_lifetime;
-  if (response_cache_control.max_age_.has_value()) {
-    freshness_lifetime = response_cache_control.max_age_.value();
-  } else {
-    const SystemTime expires_value =
-        CacheHeadersUtils::httpTime(response_headers.getInline(CacheCustomHeaders::expires()));
-    const SystemTime date_value = CacheHeadersUtils::httpTime(response_headers.Date());
-    freshness_lifetime = expires_value - date_value;
-  }
-
+  const SystemTime::duration freshness_lifetime =
+      freshnessLifetime(response_headers, response_cache_control);
   if (response_age > freshness_lifetime) {
     // Response is stale, requires validation if
     // the response does not allow being served stale,
@@ -105,6 +125,32 @@ bool ActiveLookupRequest::requiresValidation(const Http::ResponseHeaderMap& resp
   }
 }
 
+bool ActiveLookupRequest::allowsStaleWhileRevalidate(
+    const Http::ResponseHeaderMap& response_headers, SystemTime::duration response_age) const {
+  const absl::string_view cache_control =
+      response_headers.getInlineValue(CacheCustomHeaders::responseCacheControl());
+  const ResponseCacheControl response_cache_control(cache_control);
+  if (!response_cache_control.stale_while_revalidate_.has_value() ||
+      response_cache_control.must_validate_ || response_cache_control.no_stale_ ||
+      request_cache_control_.must_validate_ ||
+      (request_cache_control_.max_age_.has_value() &&
+       request_cache_control_.max_age_.value() < response_age)) {
+    // Only the staleness of the response may be made up for by a background validation, not an
+    // explicit requirement of validation.
+    return false;
+  }
+  const SystemTime::duration staleness =
+      response_age - freshnessLifetime(response_headers, response_cache_control);
+  return staleness > SystemTime::duration::zero() &&
+         staleness <= response_cache_control.stale_while_revalidate_.value();
+}
+
+bool ActiveLookupRequest::keyDistinguishesVariants(
+    const Http::ResponseHeaderMap& response_headers) const {
+  return keyed_by_content_encoding_ &&
+         VaryHeaderUtils::variesOnlyOnAcceptEncoding(response_headers);
+}
+
 } // namespace CacheV2
 } // namespace HttpFilters
 } // namespace Extensions
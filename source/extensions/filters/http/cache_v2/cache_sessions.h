@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 
@@ -23,7 +26,9 @@ public:
       Event::Dispatcher& dispatcher, SystemTime timestamp,
       const std::shared_ptr<const CacheableResponseChecker> cacheable_response_checker_,
       const std::shared_ptr<const CacheFilterStatsProvider> stats_provider_,
-      bool ignore_request_cache_control_header);
+      bool ignore_request_cache_control_header,
+      std::chrono::milliseconds max_follower_wait = std::chrono::milliseconds::zero(),
+      const std::vector<std::string>& content_encoding_variants = {});
 
   // Caches may modify the key according to local needs, though care must be
   // taken to ensure that meaningfully distinct responses have distinct keys.
@@ -45,8 +50,17 @@ public:
   }
   Event::Dispatcher& dispatcher() const { return dispatcher_; }
   SystemTime timestamp() const { return timestamp_; }
+  // How long the request waits for a response fetched by another request, zero if unbounded.
+  std::chrono::milliseconds maxFollowerWait() const { return max_follower_wait_; }
   bool requiresValidation(const Http::ResponseHeaderMap& response_headers,
                           SystemTime::duration age) const;
+  // Whether a response requiring validation is stale by no more than its stale-while-revalidate
+  // directive allows, and so may be served to this request while validated in the background.
+  bool allowsStaleWhileRevalidate(const Http::ResponseHeaderMap& response_headers,
+                                  SystemTime::duration age) const;
+  // Whether the key tells apart the variants of a response with these headers, which is only the
+  // case when they vary on accept-encoding alone and the key holds the negotiated content coding.
+  bool keyDistinguishesVariants(const Http::ResponseHeaderMap& response_headers) const;
   absl::optional<std::vector<RawByteRange>> parseRange() const;
   bool isRangeRequest() const;
 
@@ -62,6 +76,8 @@ private:
   const std::shared_ptr<const CacheFilterStatsProvider> stats_provider_;
   // Time when this LookupRequest was created (in response to an HTTP request).
   SystemTime timestamp_;
+  const std::chrono::milliseconds max_follower_wait_;
+  const bool keyed_by_content_encoding_;
   RequestCacheControl request_cache_control_;
 };
 using ActiveLookupRequestPtr = std::unique_ptr<ActiveLookupRequest>;
@@ -201,6 +201,7 @@ void CacheSession::onHeadersInserted(CacheReaderPtr cache_reader,
     ENVOY_LOG(error, "cache config was deleted while header-insertion was in flight");
     return onCacheWentAway();
   }
+  onEntryReplaced();
   entry_.cache_reader_ = std::move(cache_reader);
   entry_.response_headers_ = std::move(headers);
   entry_.response_metadata_ = cache_sessions->makeMetadata();
@@ -219,10 +220,21 @@ bool CacheSession::requiresValidationFor(const ActiveLookupRequest& lookup) cons
   return lookup.requiresValidation(*entry_.response_headers_, age);
 }
 
+bool CacheSession::canServeWhileRevalidatingFor(const ActiveLookupRequest& lookup) const {
+  mu_.AssertHeld();
+  if (state_ != State::Exists || background_validation_failed_) {
+    return false;
+  }
+  const Seconds age = CacheHeadersUtils::calculateAge(
+      *entry_.response_headers_, entry_.response_metadata_.response_time_, lookup.timestamp());
+  return lookup.allowsStaleWhileRevalidate(*entry_.response_headers_, age);
+}
+
 void CacheSession::sendLookupResponsesAndMaybeValidationRequest(CacheEntryStatus status) {
   mu_.AssertHeld();
   ASSERT(state_ == State::Exists || state_ == State::Inserting);
   auto it = lookup_subscribers_.begin();
+  auto stale_it = it;
   if (status != CacheEntryStatus::Miss) {
     // Reorder subscribers so those who do not require validation are at the end,
     // and 'it' is the first subscriber that does not require validation.
@@ -230,6 +242,18 @@ void CacheSession::sendLookupResponsesAndMaybeValidationRequest(CacheEntryStatus
                         [this](LookupSubscriber& s) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
                           return requiresValidationFor(s.context_->lookup());
                         });
+    // Of those who require validation, the ones who can be served the stale entry while it is
+    // validated in the background go just before 'it', from 'stale_it'.
+    stale_it = std::partition(lookup_subscribers_.begin(), it,
+                              [this](LookupSubscriber& s) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+                                return !canServeWhileRevalidatingFor(s.context_->lookup());
+                              });
+    if (stale_it != it) {
+      performBackgroundValidation(stale_it->context_->lookup());
+    }
+    for (auto recipient = stale_it; recipient != it; recipient++) {
+      sendSuccessfulLookupResultTo(*recipient, CacheEntryStatus::StaleWhileRevalidate);
+    }
   }
   for (auto recipient = it; recipient != lookup_subscribers_.end(); recipient++) {
     sendSuccessfulLookupResultTo(*recipient, status);
@@ -239,13 +263,13 @@ void CacheSession::sendLookupResponsesAndMaybeValidationRequest(CacheEntryStatus
       status = CacheEntryStatus::Follower;
     }
   }
-  if (it != lookup_subscribers_.end()) {
+  if (stale_it != lookup_subscribers_.end()) {
     if (auto cache_sessions = cache_sessions_.lock()) {
       cache_sessions->stats().subCacheSessionsSubscribers(
-          std::distance(it, lookup_subscribers_.end()));
+          std::distance(stale_it, lookup_subscribers_.end()));
     }
   }
-  lookup_subscribers_.erase(it, lookup_subscribers_.end());
+  lookup_subscribers_.erase(stale_it, lookup_subscribers_.end());
   if (!lookup_subscribers_.empty()) {
     // At least one subscriber required validation.
     return performValidation();
@@ -383,6 +407,7 @@ void CacheSession::onCacheError() {
   body_subscribers_.clear();
   trailer_subscribers_.clear();
   state_ = State::New;
+  onEntryReplaced();
 }
 
 void CacheSession::insertComplete() {
@@ -549,7 +574,7 @@ void CacheSession::sendBodyChunkTo(BodySubscriber& subscriber, AdjustedByteRange
   });
 }
 
-CacheSession::~CacheSession() { ASSERT(!upstream_request_); }
+CacheSession::~CacheSession() { ASSERT(!upstream_request_ && !background_validation_); }
 
 void CacheSession::getLookupResult(ActiveLookupRequestPtr lookup, ActiveLookupResultCallback&& cb) {
   ASSERT(lookup->dispatcher().isThreadSafe());
@@ -568,8 +593,7 @@ void CacheSession::getLookupResult(ActiveLookupRequestPtr lookup, ActiveLookupRe
   case State::Validating:
   case State::Pending:
     sub.context_->lookup().stats().incCacheSessionsSubscribers();
-    lookup_subscribers_.push_back(std::move(sub));
-    return;
+    return addFollower(std::move(sub));
   case State::Exists:
   case State::Inserting: {
     CacheEntryStatus status = CacheEntryStatus::Hit;
@@ -583,6 +607,9 @@ void CacheSession::getLookupResult(ActiveLookupRequestPtr lookup, ActiveLookupRe
       if (state_ == State::Inserting) {
         // Skip validation if the cache write is still in progress.
         status = CacheEntryStatus::ValidatedFree;
+      } else if (canServeWhileRevalidatingFor(sub.context_->lookup())) {
+        performBackgroundValidation(sub.context_->lookup());
+        status = CacheEntryStatus::StaleWhileRevalidate;
       } else {
         sub.context_->lookup().stats().incCacheSessionsSubscribers();
         lookup_subscribers_.push_back(std::move(sub));
@@ -631,6 +658,7 @@ void CacheSession::onCacheLookupResult(absl::StatusOr<LookupResult>&& lookup_res
   if (!lookup_result.ok()) {
     return onCacheError();
   }
+  onEntryReplaced();
   entry_ = std::move(lookup_result.value());
   if (!entry_.populated()) {
     performUpstreamRequest();
@@ -670,6 +698,53 @@ void CacheSession::performUpstreamRequest() {
   });
 }
 
+void CacheSession::WaitTimerDeleter::operator()(Event::Timer* timer) const {
+  if (dispatcher_->isThreadSafe()) {
+    delete timer;
+    return;
+  }
+  dispatcher_->post([timer = Event::TimerPtr(timer)]() {});
+}
+
+void CacheSession::addFollower(LookupSubscriber&& sub) {
+  mu_.AssertHeld();
+  const std::chrono::milliseconds max_wait = sub.context_->lookup().maxFollowerWait();
+  if (max_wait.count() > 0) {
+    sub.id_ = next_subscriber_id_++;
+    Event::Dispatcher& dispatcher = sub.dispatcher();
+    sub.wait_timer_ = WaitTimerPtr(
+        dispatcher
+            .createTimer([weak_this = weak_from_this(), id = sub.id_]() {
+              if (auto p = weak_this.lock()) {
+                p->onFollowerWaitTimeout(id);
+              }
+            })
+            .release(),
+        WaitTimerDeleter(&dispatcher));
+    sub.wait_timer_->enableTimer(max_wait);
+  }
+  lookup_subscribers_.push_back(std::move(sub));
+}
+
+void CacheSession::onFollowerWaitTimeout(uint64_t id) {
+  absl::MutexLock lock(mu_);
+  // The first subscriber is the one the response is being fetched or validated for.
+  if (lookup_subscribers_.size() < 2) {
+    return;
+  }
+  auto it = std::find_if(lookup_subscribers_.begin() + 1, lookup_subscribers_.end(),
+                         [id](const LookupSubscriber& sub) { return sub.id_ == id; });
+  if (it == lookup_subscribers_.end()) {
+    return;
+  }
+  ENVOY_LOG(debug, "follower wait timed out for {}, going upstream", key_.path());
+  if (auto cache_sessions = cache_sessions_.lock()) {
+    cache_sessions->stats().subCacheSessionsSubscribers(1);
+  }
+  postUpstreamPassThrough(std::move(*it), CacheEntryStatus::FollowerTimeout);
+  lookup_subscribers_.erase(it);
+}
+
 void CacheSession::onCacheWentAway() {
   mu_.AssertHeld();
   for (LookupSubscriber& sub : lookup_subscribers_) {
@@ -683,7 +758,25 @@ void CacheSession::processSuccessfulValidation(Http::ResponseHeaderMapPtr header
   ENVOY_LOG(debug, "successful validation");
   ASSERT(!lookup_subscribers_.empty(),
          "should be impossible to be validating with no context awaiting validation");
+  state_ = State::Exists;
+  updateValidatedHeaders(std::move(headers), lookup_subscribers_.front().dispatcher());
 
+  CacheEntryStatus status = CacheEntryStatus::Validated;
+  for (LookupSubscriber& recipient : lookup_subscribers_) {
+    sendSuccessfulLookupResultTo(recipient, status);
+    // For requests sharing the same validation upstream, use a distinct status
+    // so it's detectable that we didn't need to do multiple validations.
+    status = CacheEntryStatus::ValidatedFree;
+  }
+  if (auto cache_sessions = cache_sessions_.lock()) {
+    cache_sessions->stats().subCacheSessionsSubscribers(lookup_subscribers_.size());
+  }
+  lookup_subscribers_.clear();
+}
+
+void CacheSession::updateValidatedHeaders(Http::ResponseHeaderMapPtr headers,
+                                          Event::Dispatcher& dispatcher) {
+  mu_.AssertHeld();
   const bool should_update_cached_entry =
       CacheHeadersUtils::shouldUpdateCachedEntry(*headers, *entry_.response_headers_);
   // Replace the 304 status code with the cached status code.
@@ -710,30 +803,17 @@ void CacheSession::processSuccessfulValidation(Http::ResponseHeaderMapPtr header
   });
 
   entry_.response_headers_ = std::move(headers);
-  state_ = State::Exists;
+  background_validation_failed_ = false;
   if (auto cache_sessions = cache_sessions_.lock()) {
     if (should_update_cached_entry) {
       // TODO(yosrym93): else evict, set state to Pending, and treat as insert.
-      LookupSubscriber& sub = lookup_subscribers_.front();
       // Update metadata associated with the cached response. Right now this is only
       // response_time.
       entry_.response_metadata_.response_time_ = cache_sessions->time_source_.systemTime();
-      cache_sessions->cache().updateHeaders(sub.dispatcher(), key_, *entry_.response_headers_,
+      cache_sessions->cache().updateHeaders(dispatcher, key_, *entry_.response_headers_,
                                             entry_.response_metadata_);
     }
   }
-
-  CacheEntryStatus status = CacheEntryStatus::Validated;
-  for (LookupSubscriber& recipient : lookup_subscribers_) {
-    sendSuccessfulLookupResultTo(recipient, status);
-    // For requests sharing the same validation upstream, use a distinct status
-    // so it's detectable that we didn't need to do multiple validations.
-    status = CacheEntryStatus::ValidatedFree;
-  }
-  if (auto cache_sessions = cache_sessions_.lock()) {
-    cache_sessions->stats().subCacheSessionsSubscribers(lookup_subscribers_.size());
-  }
-  lookup_subscribers_.clear();
 }
 
 void CacheSession::onUncacheable(Http::ResponseHeaderMapPtr headers, EndStream end_stream,
@@ -807,6 +887,7 @@ void CacheSession::onUpstreamHeaders(Http::ResponseHeaderMapPtr headers, EndStre
         cache_sessions->cache().evict(dispatcher, key_);
       }
       body_length_available_ = 0;
+      onEntryReplaced();
       entry_ = {};
     }
   } else {
@@ -819,7 +900,8 @@ void CacheSession::onUpstreamHeaders(Http::ResponseHeaderMapPtr headers, EndStre
   if (!lookup_subscribers_.front().context_->lookup().isCacheableResponse(*headers)) {
     return onUncacheable(std::move(headers), end_stream, range_header_was_stripped);
   }
-  if (VaryHeaderUtils::hasVary(*headers)) {
+  if (VaryHeaderUtils::hasVary(*headers) &&
+      !lookup_subscribers_.front().context_->lookup().keyDistinguishesVariants(*headers)) {
     // TODO(ravenblack): implement Vary header support.
     ENVOY_LOG(debug, "Vary header found in upstream response, treating as not cacheable");
     return onUncacheable(std::move(headers), end_stream, range_header_was_stripped);
@@ -884,6 +966,58 @@ void CacheSession::performValidation() {
   });
 }
 
+void CacheSession::performBackgroundValidation(const ActiveLookupRequest& lookup) {
+  mu_.AssertHeld();
+  ASSERT(state_ == State::Exists);
+  if (background_validation_) {
+    return;
+  }
+  ENVOY_LOG(debug, "validating {} in the background", key_.path());
+  Http::RequestHeaderMapPtr req = requestHeadersWithRangeRemoved(lookup.requestHeaders());
+  CacheHeadersUtils::injectValidationHeaders(*req, *entry_.response_headers_);
+  background_validation_ = lookup.createUpstreamRequest();
+  // The upstream request is made on the thread of the request, and so must be destroyed there,
+  // which its own callback does.
+  lookup.dispatcher().post([upstream_request = background_validation_.get(), req = std::move(req),
+                            &dispatcher = lookup.dispatcher(), generation = entry_generation_,
+                            this, p = shared_from_this()]() mutable {
+    upstream_request->sendHeaders(std::move(req));
+    upstream_request->getHeaders([this, p = std::move(p), &dispatcher, generation](
+                                     Http::ResponseHeaderMapPtr headers, EndStream end_stream) {
+      onBackgroundValidationHeaders(dispatcher, generation, std::move(headers), end_stream);
+    });
+  });
+}
+
+void CacheSession::onBackgroundValidationHeaders(Event::Dispatcher& dispatcher,
+                                                 uint64_t entry_generation,
+                                                 Http::ResponseHeaderMapPtr headers,
+                                                 EndStream end_stream) {
+  absl::MutexLock lock(mu_);
+  ASSERT(background_validation_);
+  // Any response body is not wanted, so the upstream request is reset if still streaming.
+  background_validation_ = nullptr;
+  if (entry_generation != entry_generation_ || state_ != State::Exists) {
+    // The entry was replaced, or is being validated again, meanwhile.
+    return;
+  }
+  if (end_stream != EndStream::Reset &&
+      Http::Utility::getResponseStatus(*headers) == enumToInt(Http::Code::NotModified)) {
+    ENVOY_LOG(debug, "successful background validation");
+    return updateValidatedHeaders(std::move(headers), dispatcher);
+  }
+  // Rather than inserting the new response from here, with requests still reading the stale
+  // entry, the next request validates the entry as usual, which then fetches and inserts it.
+  ENVOY_LOG(debug, "background validation of {} failed", key_.path());
+  background_validation_failed_ = true;
+}
+
+void CacheSession::onEntryReplaced() {
+  mu_.AssertHeld();
+  entry_generation_++;
+  background_validation_failed_ = false;
+}
+
 std::shared_ptr<CacheSession> CacheSessionsImpl::getEntry(const Key& key) {
   const SystemTime now = time_source_.systemTime();
   cache().touch(key, now);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
 
 #include "source/common/common/cancel_wrapper.h"
 #include "source/extensions/filters/http/cache_v2/cache_sessions.h"
@@ -90,6 +92,17 @@ public:
         : Subscriber(dispatcher), callback_(std::move(cb)) {}
     GetTrailersCallback callback_;
   };
+  // Deletes a timer on the thread of its dispatcher, as the subscribers can be released by the
+  // thread of another subscriber.
+  class WaitTimerDeleter {
+  public:
+    explicit WaitTimerDeleter(Event::Dispatcher* dispatcher = nullptr) : dispatcher_(dispatcher) {}
+    void operator()(Event::Timer* timer) const;
+
+  private:
+    Event::Dispatcher* dispatcher_;
+  };
+  using WaitTimerPtr = std::unique_ptr<Event::Timer, WaitTimerDeleter>;
   class LookupSubscriber : public Subscriber {
   public:
     LookupSubscriber(std::unique_ptr<ActiveLookupContext> context, ActiveLookupResultCallback&& cb)
@@ -97,6 +110,10 @@ public:
           context_(std::move(context)) {}
     ActiveLookupResultCallback callback_;
     std::unique_ptr<ActiveLookupContext> context_;
+    // Identifies the subscriber to its wait timer.
+    uint64_t id_{0};
+    // Bounds the wait of a follower for the response fetched by another request.
+    WaitTimerPtr wait_timer_;
   };
 
 private:
@@ -151,6 +168,10 @@ private:
 
   bool requiresValidationFor(const ActiveLookupRequest& lookup) const
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Whether the entry, requiring validation for the request, may be served to it right away while
+  // it is validated in the background.
+  bool canServeWhileRevalidatingFor(const ActiveLookupRequest& lookup) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // For each subscriber, either sends a lookup response (if validation passes), or
   // triggers validation *once* for all subscribers for whom validation failed.
@@ -162,6 +183,20 @@ private:
   void performValidation() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   void processSuccessfulValidation(Http::ResponseHeaderMapPtr headers)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Merges the headers of a 304 response into the entry, and updates the cache with them.
+  void updateValidatedHeaders(Http::ResponseHeaderMapPtr headers, Event::Dispatcher& dispatcher)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Sends an upstream validation request for the requests served the stale entry, made like the
+  // request of lookup, unless there is one in flight already.
+  void performBackgroundValidation(const ActiveLookupRequest& lookup)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void onBackgroundValidationHeaders(Event::Dispatcher& dispatcher, uint64_t entry_generation,
+                                     Http::ResponseHeaderMapPtr headers, EndStream end_stream)
+      ABSL_LOCKS_EXCLUDED(mu_);
+  // Called whenever entry_ is replaced, so that a background validation of the previous entry
+  // is ignored.
+  void onEntryReplaced() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // If the headers include vary, update all blocked subscribers with their new keys
   // and returns true. Otherwise returns false.
@@ -230,6 +265,12 @@ private:
   // *entries* can outlive the cache object itself as long as they're in use.
   void onCacheWentAway() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Adds a subscriber waiting for the response fetched or validated by the first one, bounding
+  // its wait if the request asks for it.
+  void addFollower(LookupSubscriber&& sub) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Sends the follower with the id, if it is still waiting, to the upstream by itself.
+  void onFollowerWaitTimeout(uint64_t id) ABSL_LOCKS_EXCLUDED(mu_);
+
   // May change state from New to Pending, or from Written to Validating.
   // When changing state, also makes the corresponding upstream request.
   void mutateStateForHeaderRequest(const LookupRequest& lookup) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
@@ -251,7 +292,14 @@ private:
   std::vector<BodySubscriber> body_subscribers_ ABSL_GUARDED_BY(mu_);
   std::vector<TrailerSubscriber> trailer_subscribers_ ABSL_GUARDED_BY(mu_);
   UpstreamRequestPtr upstream_request_ ABSL_GUARDED_BY(mu_);
+  // The validation of a stale entry which is being served meanwhile, at most one at a time.
+  UpstreamRequestPtr background_validation_ ABSL_GUARDED_BY(mu_);
+  uint64_t entry_generation_ ABSL_GUARDED_BY(mu_) = 0;
+  // Set when a background validation did not confirm the entry, so that it is validated before
+  // being served again.
+  bool background_validation_failed_ ABSL_GUARDED_BY(mu_) = false;
   bool read_action_in_flight_ ABSL_GUARDED_BY(mu_) = false;
+  uint64_t next_subscriber_id_ ABSL_GUARDED_BY(mu_) = 1;
 
   // The following fields and functions are only used by CacheSessions.
   friend class CacheSessionsImpl;
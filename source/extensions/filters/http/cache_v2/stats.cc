@@ -23,6 +23,8 @@ namespace CacheV2 {
   STATNAME(uncacheable)                                                                            \
   STATNAME(upstream_reset)                                                                         \
   STATNAME(lookup_error)                                                                           \
+  STATNAME(follower_timeout)                                                                       \
+  STATNAME(stale_while_revalidate)                                                                 \
   STATNAME(validate)
 
 MAKE_STAT_NAMES_STRUCT(CacheStatNames, CACHE_FILTER_STATS);
@@ -48,6 +50,11 @@ public:
                               {stat_names_.event_type_, stat_names_.upstream_reset_}}),
         tags_lookup_error_({{stat_names_.cache_label_, label_},
                             {stat_names_.event_type_, stat_names_.lookup_error_}}),
+        tags_follower_timeout_({{stat_names_.cache_label_, label_},
+                                {stat_names_.event_type_, stat_names_.follower_timeout_}}),
+        tags_stale_while_revalidate_(
+            {{stat_names_.cache_label_, label_},
+             {stat_names_.event_type_, stat_names_.stale_while_revalidate_}}),
         tags_validate_(
             {{stat_names_.cache_label_, label_}, {stat_names_.event_type_, stat_names_.validate_}}),
         gauge_cache_sessions_entries_(
@@ -69,6 +76,10 @@ public:
             counterFromStatNames(scope, {prefix_, stat_names_.event_}, tags_upstream_reset_)),
         counter_lookup_error_(
             counterFromStatNames(scope, {prefix_, stat_names_.event_}, tags_lookup_error_)),
+        counter_follower_timeout_(
+            counterFromStatNames(scope, {prefix_, stat_names_.event_}, tags_follower_timeout_)),
+        counter_stale_while_revalidate_(counterFromStatNames(
+            scope, {prefix_, stat_names_.event_}, tags_stale_while_revalidate_)),
         counter_validate_(
             counterFromStatNames(scope, {prefix_, stat_names_.event_}, tags_validate_)) {}
   void incForStatus(CacheEntryStatus status) override;
@@ -97,6 +108,8 @@ private:
   const Stats::StatNameTagVector tags_uncacheable_;
   const Stats::StatNameTagVector tags_upstream_reset_;
   const Stats::StatNameTagVector tags_lookup_error_;
+  const Stats::StatNameTagVector tags_follower_timeout_;
+  const Stats::StatNameTagVector tags_stale_while_revalidate_;
   const Stats::StatNameTagVector tags_validate_;
   Stats::Gauge& gauge_cache_sessions_entries_;
   Stats::Gauge& gauge_cache_sessions_subscribers_;
@@ -107,6 +120,8 @@ private:
   Stats::Counter& counter_uncacheable_;
   Stats::Counter& counter_upstream_reset_;
   Stats::Counter& counter_lookup_error_;
+  Stats::Counter& counter_follower_timeout_;
+  Stats::Counter& counter_stale_while_revalidate_;
   Stats::Counter& counter_validate_;
 };
 
@@ -133,6 +148,10 @@ void CacheFilterStatsImpl::incForStatus(CacheEntryStatus status) {
     return counter_uncacheable_.inc();
   case CacheEntryStatus::LookupError:
     return counter_lookup_error_.inc();
+  case CacheEntryStatus::FollowerTimeout:
+    return counter_follower_timeout_.inc();
+  case CacheEntryStatus::StaleWhileRevalidate:
+    return counter_stale_while_revalidate_.inc();
   }
 }
 
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <chrono>
+#include <coroutine>
+#include <utility>
+
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+#include "envoy/http/async_client.h"
+#include "envoy/http/message.h"
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Common {
+
+/**
+ * A coroutine running the asynchronous logic of a filter on the worker thread of its stream,
+ * instead of a hand written state machine of callbacks. It runs as soon as it is called until it
+ * awaits an operation that has not completed yet, and is then resumed from the dispatcher of the
+ * stream, by the completion of that operation. Destroying the task, e.g. in onDestroy(), destroys
+ * its suspended frame and cancels the awaited operation.
+ *
+ * A typical filter starts it in decodeHeaders(), stops the iteration if it suspended, and has it
+ * continue the decoding once done:
+ *
+ *   FilterTask Filter::authorize() {
+ *     auto response = co_await AsyncRequest(client_, std::move(check), options);
+ *     ...
+ *     if (co_await FilterTask::hasSuspended()) {
+ *       decoder_callbacks_->continueDecoding();
+ *     }
+ *   }
+ *
+ *   Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap&, bool) {
+ *     task_ = authorize();
+ *     return task_.done() ? Http::FilterHeadersStatus::Continue
+ *                         : Http::FilterHeadersStatus::StopIteration;
+ *   }
+ */
+class FilterTask {
+public:
+  struct promise_type {
+    FilterTask get_return_object() {
+      return FilterTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    // The frame is kept until the task is destroyed, so that done() can be checked.
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { PANIC("unhandled exception in a filter coroutine"); }
+
+    // Whether the coroutine suspended at least once, so did not complete in the call starting it.
+    bool suspended_{};
+  };
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /**
+   * Awaited by the coroutine to know whether it suspended at least once, i.e. whether the filter
+   * stopped the iteration and has to continue it. Does not suspend.
+   */
+  struct HasSuspended {
+    bool await_ready() const noexcept { return false; }
+    bool await_suspend(Handle handle) noexcept {
+      suspended_ = handle.promise().suspended_;
+      return false;
+    }
+    bool await_resume() const noexcept { return suspended_; }
+
+    bool suspended_{};
+  };
+  static HasSuspended hasSuspended() { return {}; }
+
+  FilterTask() = default;
+  FilterTask(FilterTask&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  FilterTask& operator=(FilterTask&& other) noexcept {
+    if (this != &other) {
+      reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  ~FilterTask() { reset(); }
+
+  /**
+   * @return whether the coroutine ran to completion, or there is none.
+   */
+  bool done() const { return handle_ == nullptr || handle_.done(); }
+
+  /**
+   * Destroys the coroutine, cancelling the operation it awaits if it is suspended.
+   */
+  void reset() {
+    if (handle_ != nullptr) {
+      std::exchange(handle_, nullptr).destroy();
+    }
+  }
+
+private:
+  explicit FilterTask(Handle handle) : handle_(handle) {}
+
+  Handle handle_;
+};
+
+/**
+ * Awaitable suspending a FilterTask for a duration, with a timer of the dispatcher of its stream.
+ */
+class Sleep {
+public:
+  Sleep(Event::Dispatcher& dispatcher, std::chrono::milliseconds duration)
+      : dispatcher_(dispatcher), duration_(duration) {}
+
+  bool await_ready() const noexcept { return duration_.count() <= 0; }
+  void await_suspend(FilterTask::Handle handle) {
+    handle.promise().suspended_ = true;
+    timer_ = dispatcher_.createTimer([handle]() { handle.resume(); });
+    timer_->enableTimer(duration_);
+  }
+  void await_resume() const noexcept {}
+
+private:
+  Event::Dispatcher& dispatcher_;
+  const std::chrono::milliseconds duration_;
+  // Destroyed, so disabled, with the frame of a destroyed task.
+  Event::TimerPtr timer_;
+};
+
+/**
+ * Awaitable sending a request with an async client and resuming the FilterTask with its response,
+ * from the dispatcher the client runs on. The request is cancelled if the task is destroyed first.
+ */
+class AsyncRequest : public Http::AsyncClient::Callbacks {
+public:
+  struct Result {
+    // The response, or nullptr if the request failed.
+    Http::ResponseMessagePtr response_;
+    Http::AsyncClient::FailureReason failure_reason_{Http::AsyncClient::FailureReason::Reset};
+  };
+
+  AsyncRequest(Http::AsyncClient& client, Http::RequestMessagePtr&& message,
+               const Http::AsyncClient::RequestOptions& options)
+      : client_(client), message_(std::move(message)), options_(options) {}
+  ~AsyncRequest() override {
+    if (request_ != nullptr) {
+      request_->cancel();
+    }
+  }
+
+  bool await_ready() {
+    request_ = client_.send(std::move(message_), *this, options_);
+    // The client may have completed the request inline.
+    return request_ == nullptr;
+  }
+  void await_suspend(FilterTask::Handle handle) {
+    handle.promise().suspended_ = true;
+    handle_ = handle;
+  }
+  Result await_resume() { return std::move(result_); }
+
+  // Http::AsyncClient::Callbacks
+  void onSuccess(const Http::AsyncClient::Request&, Http::ResponseMessagePtr&& response) override {
+    result_.response_ = std::move(response);
+    complete();
+  }
+  void onFailure(const Http::AsyncClient::Request&,
+                 Http::AsyncClient::FailureReason reason) override {
+    result_.failure_reason_ = reason;
+    complete();
+  }
+  void onBeforeFinalizeUpstreamSpan(Tracing::Span&, const Http::ResponseHeaderMap*) override {}
+
+private:
+  void complete() {
+    request_ = nullptr;
+    if (handle_ != nullptr) {
+      std::exchange(handle_, nullptr).resume();
+    }
+  }
+
+  Http::AsyncClient& client_;
+  Http::RequestMessagePtr message_;
+  const Http::AsyncClient::RequestOptions options_;
+  Http::AsyncClient::Request* request_{};
+  FilterTask::Handle handle_;
+  Result result_;
+};
+
+} // namespace Common
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
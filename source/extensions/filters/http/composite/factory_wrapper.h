@@ -28,6 +28,7 @@ struct FactoryCallbacksWrapper : public Http::FilterChainFactoryCallbacks {
   FactoryCallbacksWrapper(Filter& filter, Event::Dispatcher& dispatcher, bool filter_chain_mode)
       : filter_(filter), dispatcher_(dispatcher), is_filter_chain_mode_(filter_chain_mode) {}
 
+  void reserveFilters(uint32_t) override {}
   void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override;
   void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override;
   void addStreamFilter(Http::StreamFilterSharedPtr filter) override;
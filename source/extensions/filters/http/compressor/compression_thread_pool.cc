@@ -0,0 +1,148 @@
+#include "source/extensions/filters/http/compressor/compression_thread_pool.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+class CompressionThreadPool::Chunk {
+public:
+  Chunk(Envoy::Compression::Compressor::Compressor& compressor, Buffer::Instance& data,
+        bool end_stream, Event::Dispatcher& dispatcher, CompressedCb on_compressed)
+      : compressor_(compressor), end_stream_(end_stream), dispatcher_(dispatcher),
+        on_compressed_(std::move(on_compressed)) {
+    // Copied rather than moved, so that the drain trackers of the slices of the stream, if any,
+    // run on its worker thread.
+    data_.add(data);
+    data.drain(data.length());
+  }
+
+  // Called by the threads of the pool.
+  void compress(ChunkSharedPtr self) {
+    {
+      absl::MutexLock lock(mu_);
+      if (state_ == State::Cancelled) {
+        return;
+      }
+      state_ = State::Compressing;
+    }
+    compressor_.compress(data_, end_stream_ ? Envoy::Compression::Compressor::State::Finish
+                                            : Envoy::Compression::Compressor::State::Flush);
+    absl::MutexLock lock(mu_);
+    state_ = State::Compressed;
+    // Posted before the wait of a cancellation ends, while the dispatcher is still in use.
+    dispatcher_.post([self = std::move(self)]() { self->complete(); });
+  }
+
+  // Called on the dispatcher of the stream.
+  void cancel() {
+    absl::MutexLock lock(mu_);
+    const auto not_compressing = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      return state_ != State::Compressing;
+    };
+    mu_.Await(absl::Condition(&not_compressing));
+    state_ = State::Cancelled;
+  }
+
+private:
+  enum class State { Queued, Compressing, Compressed, Cancelled };
+
+  void complete() {
+    {
+      absl::MutexLock lock(mu_);
+      if (state_ == State::Cancelled) {
+        return;
+      }
+    }
+    // The callback may destroy the handle, cancelling this chunk, so the lock is not held.
+    on_compressed_(data_, end_stream_);
+  }
+
+  Envoy::Compression::Compressor::Compressor& compressor_;
+  Buffer::OwnedImpl data_;
+  const bool end_stream_;
+  Event::Dispatcher& dispatcher_;
+  const CompressedCb on_compressed_;
+  absl::Mutex mu_;
+  State state_ ABSL_GUARDED_BY(mu_){State::Queued};
+};
+
+class CompressionThreadPool::HandleImpl : public Handle {
+public:
+  explicit HandleImpl(ChunkSharedPtr chunk) : chunk_(std::move(chunk)) {}
+  ~HandleImpl() override { chunk_->cancel(); }
+
+private:
+  const ChunkSharedPtr chunk_;
+};
+
+CompressionThreadPool::CompressionThreadPool(Thread::ThreadFactory& thread_factory,
+                                             uint32_t thread_count, uint32_t max_queued_chunks)
+    : max_queued_chunks_(max_queued_chunks) {
+  threads_.reserve(thread_count);
+  while (threads_.size() < thread_count) {
+    threads_.push_back(
+        thread_factory.createThread([this]() { worker(); }, Thread::Options{"compressor"}));
+  }
+}
+
+CompressionThreadPool::~CompressionThreadPool() {
+  {
+    absl::MutexLock lock(mu_);
+    terminate_ = true;
+  }
+  // Waits for the threads to be done with the chunks still queued, if any, which are skipped once
+  // cancelled.
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+CompressionThreadPool::HandlePtr
+CompressionThreadPool::compress(Envoy::Compression::Compressor::Compressor& compressor,
+                                Buffer::Instance& data, bool end_stream,
+                                Event::Dispatcher& dispatcher, CompressedCb on_compressed) {
+  ASSERT(dispatcher.isThreadSafe());
+  {
+    absl::MutexLock lock(mu_);
+    if (chunks_.size() >= max_queued_chunks_) {
+      return nullptr;
+    }
+  }
+  // The data is copied without holding the lock, so the bound may be exceeded by the chunks
+  // queued concurrently by the other workers.
+  auto chunk = std::make_shared<Chunk>(compressor, data, end_stream, dispatcher,
+                                       std::move(on_compressed));
+  {
+    absl::MutexLock lock(mu_);
+    chunks_.push(chunk);
+  }
+  return std::make_unique<HandleImpl>(std::move(chunk));
+}
+
+void CompressionThreadPool::worker() {
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return !chunks_.empty() || terminate_;
+  };
+  while (true) {
+    ChunkSharedPtr chunk;
+    {
+      absl::MutexLock lock(mu_);
+      mu_.Await(absl::Condition(&condition));
+      if (chunks_.empty()) {
+        return;
+      }
+      chunk = std::move(chunks_.front());
+      chunks_.pop();
+    }
+    chunk->compress(std::move(chunk));
+  }
+}
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
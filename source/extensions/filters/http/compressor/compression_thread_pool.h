@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <vector>
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/compression/compressor/compressor.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/thread/thread.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+
+/**
+ * A pool of threads compressing the chunks of data of the streams off their worker threads, so
+ * that the compression of large chunks does not stall the other streams of the workers. The
+ * chunks are compressed in the order they are queued. The number of queued chunks is bounded.
+ */
+class CompressionThreadPool {
+public:
+  /**
+   * Called on the dispatcher of a stream with a chunk once compressed.
+   */
+  using CompressedCb = std::function<void(Buffer::Instance& data, bool end_stream)>;
+
+  /**
+   * A chunk queued or being compressed. Destroying it cancels the compression of the chunk if
+   * not started yet, or else waits for it to finish, so that the compressor of the chunk can be
+   * destroyed afterwards. The callback of the chunk is not called once it is destroyed.
+   */
+  class Handle {
+  public:
+    virtual ~Handle() = default;
+  };
+  using HandlePtr = std::unique_ptr<Handle>;
+
+  /**
+   * @param thread_factory the factory of the threads of the pool.
+   * @param thread_count the number of threads of the pool.
+   * @param max_queued_chunks the most chunks waiting for a thread of the pool.
+   */
+  CompressionThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                        uint32_t max_queued_chunks);
+  ~CompressionThreadPool();
+
+  /**
+   * Queues a chunk for compression. The compressor must outlive the returned handle, and must not
+   * be used by the caller before the callback is called.
+   * @param compressor the compressor of the stream of the chunk.
+   * @param data the chunk, drained if queued.
+   * @param end_stream whether the chunk ends the stream.
+   * @param dispatcher the dispatcher of the stream, on which on_compressed is called.
+   * @param on_compressed called with the compressed chunk.
+   * @return the handle of the queued chunk, or nullptr if the queue is full, in which case the
+   * data is left as is.
+   */
+  HandlePtr compress(Envoy::Compression::Compressor::Compressor& compressor, Buffer::Instance& data,
+                     bool end_stream, Event::Dispatcher& dispatcher, CompressedCb on_compressed);
+
+private:
+  class Chunk;
+  class HandleImpl;
+  using ChunkSharedPtr = std::shared_ptr<Chunk>;
+
+  void worker();
+
+  const uint32_t max_queued_chunks_;
+  absl::Mutex mu_;
+  std::queue<ChunkSharedPtr> chunks_ ABSL_GUARDED_BY(mu_);
+  bool terminate_ ABSL_GUARDED_BY(mu_){false};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+using CompressionThreadPoolPtr = std::unique_ptr<CompressionThreadPool>;
+
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
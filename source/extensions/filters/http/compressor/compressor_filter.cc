@@ -39,6 +39,9 @@ Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::Respons
 // Default minimum length of an upstream response that allows compression.
 const uint64_t DefaultMinimumContentLength = 30;
 
+// Default size of the chunks of response data compressed in the thread pool.
+const uint32_t DefaultOffloadMinChunkSize = 65536;
+
 // Default content types will be used if any is provided by the user.
 const std::vector<std::string>& defaultContentEncoding() {
   CONSTRUCT_ON_FIRST_USE(std::vector<std::string>, {"text/html",
@@ -94,7 +97,8 @@ CompressorFilterConfig::DirectionConfig::DirectionConfig(
 CompressorFilterConfig::CompressorFilterConfig(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-    Compression::Compressor::CompressorFactoryPtr compressor_factory)
+    Compression::Compressor::CompressorFactoryPtr compressor_factory,
+    CompressionThreadPoolPtr compression_thread_pool)
     : common_stats_prefix_(fmt::format("{}compressor.{}.{}", stats_prefix,
                                        proto_config.compressor_library().name(),
                                        compressor_factory->statsPrefix())),
@@ -102,7 +106,8 @@ CompressorFilterConfig::CompressorFilterConfig(
       response_direction_config_(proto_config, common_stats_prefix_, scope, runtime),
       content_encoding_(compressor_factory->contentEncoding()),
       compressor_factory_(std::move(compressor_factory)),
-      choose_first_(proto_config.choose_first()) {}
+      choose_first_(proto_config.choose_first()),
+      compression_thread_pool_(std::move(compression_thread_pool)) {}
 
 StringUtil::CaseUnorderedSet CompressorFilterConfig::DirectionConfig::contentTypeSet(
     const Protobuf::RepeatedPtrField<std::string>& types) {
@@ -146,6 +151,9 @@ CompressorFilterConfig::ResponseDirectionConfig::ResponseDirectionConfig(
       status_header_enabled_(proto_config.response_direction_config().status_header_enabled()),
       uncompressible_response_codes_(uncompressibleResponseCodesSet(
           proto_config.response_direction_config().uncompressible_response_codes())),
+      offload_min_chunk_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          proto_config.response_direction_config().compression_offload(), min_chunk_size,
+          DefaultOffloadMinChunkSize)),
       response_stats_{generateResponseStats(stats_prefix, scope)} {}
 
 const envoy::extensions::filters::http::compressor::v3::Compressor::CommonDirectionConfig
@@ -452,15 +460,89 @@ Http::FilterHeadersStatus CompressorFilter::encodeHeadersWithStatusHeader(
 }
 
 Http::FilterDataStatus CompressorFilter::encodeData(Buffer::Instance& data, bool end_stream) {
-  if (response_compressor_ != nullptr) {
-    compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
-                           end_stream);
+  if (response_compressor_ == nullptr) {
+    return Http::FilterDataStatus::Continue;
+  }
+  if (offloaded_response_data_ != nullptr) {
+    // Waits for the chunk being compressed, to keep the order of the data.
+    pending_response_data_.move(data);
+    pending_response_end_stream_ = end_stream;
+    const uint64_t buffer_limit = encoder_callbacks_->encoderBufferLimit();
+    if (!above_write_buffer_high_watermark_ && buffer_limit > 0 &&
+        pending_response_data_.length() > buffer_limit) {
+      above_write_buffer_high_watermark_ = true;
+      encoder_callbacks_->onEncoderFilterAboveWriteBufferHighWatermark();
+    }
+    return Http::FilterDataStatus::StopIterationNoBuffer;
+  }
+  if (offloadResponseData(data, end_stream)) {
+    return Http::FilterDataStatus::StopIterationNoBuffer;
   }
+  compressAndUpdateStats(response_compressor_, config_->responseDirectionConfig().stats(), data,
+                         end_stream);
   return Http::FilterDataStatus::Continue;
 }
 
+bool CompressorFilter::offloadResponseData(Buffer::Instance& data, bool end_stream) {
+  CompressionThreadPool* compression_thread_pool = config_->compressionThreadPool();
+  const CompressorFilterConfig::ResponseDirectionConfig& config =
+      config_->responseDirectionConfig();
+  if (compression_thread_pool == nullptr || data.length() < config.offloadMinChunkSize()) {
+    return false;
+  }
+  const uint64_t length = data.length();
+  offloaded_response_data_ = compression_thread_pool->compress(
+      *response_compressor_, data, end_stream, encoder_callbacks_->dispatcher(),
+      [this](Buffer::Instance& data, bool end_stream) {
+        onResponseDataCompressed(data, end_stream);
+      });
+  if (offloaded_response_data_ == nullptr) {
+    config.responseStats().offload_queue_full_.inc();
+    return false;
+  }
+  config.stats().total_uncompressed_bytes_.add(length);
+  config.responseStats().offloaded_chunks_.inc();
+  return true;
+}
+
+void CompressorFilter::onResponseDataCompressed(Buffer::Instance& data, bool end_stream) {
+  const CompressorStats& stats = config_->responseDirectionConfig().stats();
+  offloaded_response_data_.reset();
+  stats.total_compressed_bytes_.add(data.length());
+  encoder_callbacks_->injectEncodedDataToFilterChain(data, end_stream);
+
+  if (pending_response_data_.length() > 0 || pending_response_end_stream_) {
+    Buffer::OwnedImpl pending_data;
+    pending_data.move(pending_response_data_);
+    const bool pending_end_stream = pending_response_end_stream_;
+    pending_response_end_stream_ = false;
+    if (above_write_buffer_high_watermark_) {
+      above_write_buffer_high_watermark_ = false;
+      encoder_callbacks_->onEncoderFilterBelowWriteBufferLowWatermark();
+    }
+    if (offloadResponseData(pending_data, pending_end_stream)) {
+      return;
+    }
+    compressAndUpdateStats(response_compressor_, stats, pending_data, pending_end_stream);
+    encoder_callbacks_->injectEncodedDataToFilterChain(pending_data, pending_end_stream);
+  }
+
+  if (pending_response_trailers_) {
+    pending_response_trailers_ = false;
+    Buffer::OwnedImpl empty_buffer;
+    compressAndUpdateStats(response_compressor_, stats, empty_buffer, true);
+    encoder_callbacks_->injectEncodedDataToFilterChain(empty_buffer, false);
+    encoder_callbacks_->continueEncoding();
+  }
+}
+
 Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTrailerMap&) {
   if (response_compressor_ != nullptr) {
+    if (offloaded_response_data_ != nullptr) {
+      // Ends the compression once the data is compressed.
+      pending_response_trailers_ = true;
+      return Http::FilterTrailersStatus::StopIteration;
+    }
     Buffer::OwnedImpl empty_buffer;
     // The presence of trailers means the stream is ended, but encodeData()
     // is never called with end_stream=true, thus let the compression library know
@@ -472,6 +554,11 @@ Http::FilterTrailersStatus CompressorFilter::encodeTrailers(Http::ResponseTraile
   return Http::FilterTrailersStatus::Continue;
 }
 
+void CompressorFilter::onDestroy() {
+  // Waits for the chunk being compressed, if any, before the compressor is destroyed.
+  offloaded_response_data_.reset();
+}
+
 bool CompressorFilter::hasCacheControlNoTransform(Http::ResponseHeaderMap& headers) const {
   const Http::HeaderEntry* cache_control = headers.getInline(cache_control_handle.handle());
   if (cache_control) {
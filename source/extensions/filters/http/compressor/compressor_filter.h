@@ -5,10 +5,12 @@
 #include "envoy/server/factory_context.h"
 #include "envoy/stats/stats_macros.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
+#include "source/extensions/filters/http/compressor/compression_thread_pool.h"
 
 #include "absl/types/optional.h"
 
@@ -41,6 +43,10 @@ namespace Compressor {
  *
  * "header_gzip" is specific to the gzip filter and is deprecated since it duplicates
  * "header_compressor_used".
+ *
+ * "offloaded_chunks" is a number of response data chunks compressed in the thread pool of the
+ * filter, and "offload_queue_full" a number of chunks compressed on their worker threads instead
+ * as the queue of the pool was full.
  */
 #define RESPONSE_COMPRESSOR_STATS(COUNTER)                                                         \
   COUNTER(no_accept_header)                                                                        \
@@ -49,7 +55,9 @@ namespace Compressor {
   COUNTER(header_compressor_overshadowed)                                                          \
   COUNTER(header_wildcard)                                                                         \
   COUNTER(header_not_valid)                                                                        \
-  COUNTER(not_compressed_etag)
+  COUNTER(not_compressed_etag)                                                                     \
+  COUNTER(offloaded_chunks)                                                                        \
+  COUNTER(offload_queue_full)
 
 /**
  * Struct definitions for compressor stats. @see stats_macros.h
@@ -126,6 +134,8 @@ public:
     bool statusHeaderEnabled() const { return status_header_enabled_; }
     bool areAllResponseCodesCompressible() const;
     bool isResponseCodeCompressible(uint32_t response_code) const;
+    // The size of the chunks of data compressed in the thread pool, if any.
+    uint32_t offloadMinChunkSize() const { return offload_min_chunk_size_; }
 
   private:
     static ResponseCompressorStats generateResponseStats(const std::string& prefix,
@@ -142,6 +152,7 @@ public:
     const bool remove_accept_encoding_header_;
     const bool status_header_enabled_;
     const absl::flat_hash_set<uint32_t> uncompressible_response_codes_;
+    const uint32_t offload_min_chunk_size_;
     const ResponseCompressorStats response_stats_;
   };
 
@@ -149,7 +160,8 @@ public:
   CompressorFilterConfig(
       const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
       const std::string& stats_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory);
+      Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory,
+      CompressionThreadPoolPtr compression_thread_pool = nullptr);
 
   Envoy::Compression::Compressor::CompressorPtr makeCompressor();
 
@@ -160,6 +172,8 @@ public:
   const Envoy::Compression::Compressor::CompressorFactory& compressorFactory() const {
     return *compressor_factory_;
   }
+  // The pool compressing the large chunks of response data, or nullptr if not offloaded.
+  CompressionThreadPool* compressionThreadPool() const { return compression_thread_pool_.get(); }
 
 private:
   const std::string common_stats_prefix_;
@@ -169,6 +183,7 @@ private:
   const std::string content_encoding_;
   const Envoy::Compression::Compressor::CompressorFactoryPtr compressor_factory_;
   const bool choose_first_;
+  const CompressionThreadPoolPtr compression_thread_pool_;
 };
 using CompressorFilterConfigSharedPtr = std::shared_ptr<CompressorFilterConfig>;
 
@@ -222,6 +237,9 @@ public:
   Http::FilterDataStatus encodeData(Buffer::Instance& buffer, bool end_stream) override;
   Http::FilterTrailersStatus encodeTrailers(Http::ResponseTrailerMap&) override;
 
+  // Http::StreamFilterBase
+  void onDestroy() override;
+
   // Grant testing peer access.
   friend class CompressorFilterTestingPeer;
 
@@ -284,12 +302,26 @@ private:
   // Returns the appropriate content encoding for the current route.
   std::string getContentEncoding() const;
 
+  // Queues a chunk of response data for compression in the thread pool of the config, if large
+  // enough. Returns false if the chunk is not queued, in which case it is left as is.
+  bool offloadResponseData(Buffer::Instance& data, bool end_stream);
+  void onResponseDataCompressed(Buffer::Instance& data, bool end_stream);
+
+  // Declared before the compressors, which may refer to the factories it owns.
+  const CompressorFilterConfigSharedPtr config_;
   Envoy::Compression::Compressor::CompressorPtr response_compressor_;
   Envoy::Compression::Compressor::CompressorPtr request_compressor_;
-  const CompressorFilterConfigSharedPtr config_;
   std::unique_ptr<std::string> accept_encoding_;
   // Cached per-route configuration pointer, initialized once per stream.
   const CompressorPerRouteFilterConfig* per_route_config_{};
+  // The chunk of response data being compressed in the thread pool, if any. Declared after the
+  // compressors, as destroying it waits for the compression to finish.
+  CompressionThreadPool::HandlePtr offloaded_response_data_;
+  // The response data following the chunk being compressed.
+  Buffer::OwnedImpl pending_response_data_;
+  bool pending_response_end_stream_{};
+  bool pending_response_trailers_{};
+  bool above_write_buffer_high_watermark_{};
 };
 
 } // namespace Compressor
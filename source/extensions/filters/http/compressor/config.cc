@@ -15,6 +15,14 @@ namespace Extensions {
 namespace HttpFilters {
 namespace Compressor {
 
+namespace {
+
+// Defaults of the thread pool compressing the large chunks of response data.
+const uint32_t DefaultOffloadThreadCount = 1;
+const uint32_t DefaultOffloadMaxQueuedChunks = 256;
+
+} // namespace
+
 absl::StatusOr<Http::FilterFactoryCb> CompressorFilterFactory::createFilterFactoryFromProtoTyped(
     const envoy::extensions::filters::http::compressor::v3::Compressor& proto_config,
     const std::string& stats_prefix, Server::Configuration::FactoryContext& context) {
@@ -32,9 +40,17 @@ absl::StatusOr<Http::FilterFactoryCb> CompressorFilterFactory::createFilterFacto
       *config_factory);
   Compression::Compressor::CompressorFactoryPtr compressor_factory =
       config_factory->createCompressorFactoryFromProto(*message, context);
+  CompressionThreadPoolPtr compression_thread_pool;
+  if (proto_config.response_direction_config().has_compression_offload()) {
+    const auto& offload = proto_config.response_direction_config().compression_offload();
+    compression_thread_pool = std::make_unique<CompressionThreadPool>(
+        context.serverFactoryContext().api().threadFactory(),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(offload, thread_count, DefaultOffloadThreadCount),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(offload, max_queued_chunks, DefaultOffloadMaxQueuedChunks));
+  }
   CompressorFilterConfigSharedPtr config = std::make_shared<CompressorFilterConfig>(
       proto_config, stats_prefix, context.scope(), context.serverFactoryContext().runtime(),
-      std::move(compressor_factory));
+      std::move(compressor_factory), std::move(compression_thread_pool));
   return [config](Http::FilterChainFactoryCallbacks& callbacks) -> void {
     callbacks.addStreamFilter(std::make_shared<CompressorFilter>(config));
   };
@@ -83,6 +83,9 @@ void CorsFilter::initializeCorsPolicies() {
 // This handles the CORS preflight request as described in
 // https://www.w3.org/TR/cors/#resource-preflight-requests
 Http::FilterHeadersStatus CorsFilter::decodeHeaders(Http::RequestHeaderMap& headers, bool) {
+  // Only the headers matter, the body of the requests is never looked at.
+  decoder_callbacks_->skipDecodingBodyAndTrailers();
+
   if (decoder_callbacks_->route() == nullptr ||
       decoder_callbacks_->route()->routeEntry() == nullptr) {
     return Http::FilterHeadersStatus::Continue;
@@ -184,6 +187,8 @@ Http::FilterHeadersStatus CorsFilter::decodeHeaders(Http::RequestHeaderMap& head
 // This handles simple CORS requests as described in
 // https://www.w3.org/TR/cors/#resource-requests
 Http::FilterHeadersStatus CorsFilter::encodeHeaders(Http::ResponseHeaderMap& headers, bool) {
+  encoder_callbacks_->skipEncodingBodyAndTrailers();
+
   if (!is_cors_request_) {
     return Http::FilterHeadersStatus::Continue;
   }
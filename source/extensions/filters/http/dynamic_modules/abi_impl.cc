@@ -170,6 +170,47 @@ const Buffer::Instance* getBufferByType(DynamicModuleHttpFilter* filter,
   }
 }
 
+// Copies the slices of the body that are backed by immutable memory, such as the fragments added
+// by other filters, so that the module can modify them in place.
+void makeBodySlicesMutable(Buffer::Instance& buffer) {
+  auto* owned_buffer = dynamic_cast<Buffer::OwnedImpl*>(&buffer);
+  if (owned_buffer != nullptr) {
+    owned_buffer->makeSlicesMutable();
+  }
+}
+
+bool makeBodyMutable(DynamicModuleHttpFilter* filter,
+                     envoy_dynamic_module_type_http_body_type body_type) {
+  switch (body_type) {
+  case envoy_dynamic_module_type_http_body_type_ReceivedRequestBody:
+    if (filter->current_request_body_ == nullptr) {
+      return false;
+    }
+    makeBodySlicesMutable(*filter->current_request_body_);
+    return true;
+  case envoy_dynamic_module_type_http_body_type_BufferedRequestBody:
+    if (filter->decoder_callbacks_->decodingBuffer() == nullptr) {
+      return false;
+    }
+    filter->decoder_callbacks_->modifyDecodingBuffer(makeBodySlicesMutable);
+    return true;
+  case envoy_dynamic_module_type_http_body_type_ReceivedResponseBody:
+    if (filter->current_response_body_ == nullptr) {
+      return false;
+    }
+    makeBodySlicesMutable(*filter->current_response_body_);
+    return true;
+  case envoy_dynamic_module_type_http_body_type_BufferedResponseBody:
+    if (filter->encoder_callbacks_->encodingBuffer() == nullptr) {
+      return false;
+    }
+    filter->encoder_callbacks_->modifyEncodingBuffer(makeBodySlicesMutable);
+    return true;
+  default:
+    return false;
+  }
+}
+
 bool getSslInfo(
     OptRef<const Network::Connection> connection,
     std::function<OptRef<const std::string>(const Ssl::ConnectionInfoConstSharedPtr)> get_san_func,
@@ -757,6 +798,18 @@ size_t envoy_dynamic_module_callback_http_get_body_chunks_size(
   return buffer->getRawSlices(std::nullopt).size();
 }
 
+bool envoy_dynamic_module_callback_http_get_mutable_body_chunks(
+    envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
+    envoy_dynamic_module_type_http_body_type body_type,
+    envoy_dynamic_module_type_envoy_buffer* result_buffer_vector) {
+  auto filter = static_cast<DynamicModuleHttpFilter*>(filter_envoy_ptr);
+  if (!makeBodyMutable(filter, body_type)) {
+    return false;
+  }
+  bodyBufferToModule(*getBufferByType(filter, body_type), result_buffer_vector);
+  return true;
+}
+
 bool envoy_dynamic_module_callback_http_append_body(
     envoy_dynamic_module_type_http_filter_envoy_ptr filter_envoy_ptr,
     envoy_dynamic_module_type_http_body_type body_type,
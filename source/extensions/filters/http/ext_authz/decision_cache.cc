@@ -0,0 +1,110 @@
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "source/common/http/header_utility.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 10000;
+constexpr uint64_t DefaultAllowedTtlMs = 60000;
+constexpr absl::string_view DefaultTtlMetadataKey = "decision_ttl_seconds";
+
+std::vector<Http::LowerCaseString>
+keyHeaders(const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config) {
+  std::vector<Http::LowerCaseString> key_headers;
+  key_headers.reserve(config.key_headers_size());
+  for (const std::string& name : config.key_headers()) {
+    key_headers.emplace_back(name);
+  }
+  return key_headers;
+}
+
+// Appends a length prefixed value, so that distinct keys never concatenate to the same string.
+void appendToKey(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+DecisionCacheConfig::DecisionCacheConfig(
+    const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config)
+    : key_headers_(keyHeaders(config)),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      allowed_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, allowed_ttl, DefaultAllowedTtlMs)),
+      denied_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, denied_ttl, 0)),
+      ttl_metadata_key_(config.ttl_metadata_key().empty() ? std::string(DefaultTtlMetadataKey)
+                                                          : config.ttl_metadata_key()) {}
+
+absl::optional<std::string> DecisionCacheConfig::key(const Http::RequestHeaderMap& headers,
+                                                     absl::string_view route_name) const {
+  std::string key;
+  appendToKey(key, route_name);
+  for (const Http::LowerCaseString& name : key_headers_) {
+    const auto value = Http::HeaderUtility::getAllOfHeaderAsString(headers, name);
+    if (!value.result().has_value()) {
+      return absl::nullopt;
+    }
+    appendToKey(key, value.result().value());
+  }
+  return key;
+}
+
+std::chrono::milliseconds
+DecisionCacheConfig::ttl(const Filters::Common::ExtAuthz::Response& response) const {
+  using Filters::Common::ExtAuthz::CheckStatus;
+  if (response.status == CheckStatus::Error || response.saw_invalid_append_actions) {
+    return std::chrono::milliseconds(0);
+  }
+  const auto it = response.dynamic_metadata.fields().find(ttl_metadata_key_);
+  if (it != response.dynamic_metadata.fields().end() && it->second.has_number_value()) {
+    return std::chrono::milliseconds(
+        static_cast<int64_t>(std::max(0.0, it->second.number_value()) * 1000));
+  }
+  return response.status == CheckStatus::OK ? allowed_ttl_ : denied_ttl_;
+}
+
+const Filters::Common::ExtAuthz::Response* DecisionCache::lookup(const std::string& key,
+                                                                 MonotonicTime now) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if (it->second->expiry_ <= now) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &it->second->response_;
+}
+
+bool DecisionCache::insert(const std::string& key,
+                           const Filters::Common::ExtAuthz::Response& response,
+                           MonotonicTime expiry) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  bool evicted = false;
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+    evicted = true;
+  }
+  entries_.push_front(Entry{key, response, expiry});
+  index_[key] = entries_.begin();
+  return evicted;
+}
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
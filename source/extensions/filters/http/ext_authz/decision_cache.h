@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+#include "envoy/http/header_map.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/extensions/filters/common/ext_authz/ext_authz.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+
+/**
+ * The keys and the TTLs of the cached decisions of the authorization server.
+ */
+class DecisionCacheConfig {
+public:
+  explicit DecisionCacheConfig(
+      const envoy::extensions::filters::http::ext_authz::v3::DecisionCache& config);
+
+  uint32_t maxEntries() const { return max_entries_; }
+
+  /**
+   * @return the key of the decision for a request of a route, or absl::nullopt if the request
+   *         misses one of the key headers.
+   */
+  absl::optional<std::string> key(const Http::RequestHeaderMap& headers,
+                                  absl::string_view route_name) const;
+
+  /**
+   * @return how long a response of the authorization server is cached. Zero if it is not, as for
+   *         the errors.
+   */
+  std::chrono::milliseconds ttl(const Filters::Common::ExtAuthz::Response& response) const;
+
+private:
+  const std::vector<Http::LowerCaseString> key_headers_;
+  const uint32_t max_entries_;
+  const std::chrono::milliseconds allowed_ttl_;
+  const std::chrono::milliseconds denied_ttl_;
+  const std::string ttl_metadata_key_;
+};
+
+/**
+ * The cached decisions of a worker thread, evicted in least recently used order. Not thread safe.
+ */
+class DecisionCache : public ThreadLocal::ThreadLocalObject {
+public:
+  explicit DecisionCache(uint32_t max_entries) : max_entries_(max_entries) {}
+
+  /**
+   * @return the decision of a key, or nullptr if there is none or it expired. Only valid until the
+   *         next insertion.
+   */
+  const Filters::Common::ExtAuthz::Response* lookup(const std::string& key, MonotonicTime now);
+
+  /**
+   * Inserts the decision of a key, replacing any previous one.
+   * @return whether the least recently used decision was evicted to make room for it.
+   */
+  bool insert(const std::string& key, const Filters::Common::ExtAuthz::Response& response,
+              MonotonicTime expiry);
+
+  size_t size() const { return index_.size(); }
+
+private:
+  struct Entry {
+    const std::string key_;
+    const Filters::Common::ExtAuthz::Response response_;
+    const MonotonicTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  const uint32_t max_entries_;
+  // The most recently used entries first.
+  EntryList entries_;
+  absl::flat_hash_map<std::string, EntryList::iterator> index_;
+};
+
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -136,6 +136,9 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3
       charge_cluster_response_stats_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, charge_cluster_response_stats, true)),
       stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
+      decision_cache_config_(config.has_decision_cache()
+                                 ? absl::make_optional<DecisionCacheConfig>(config.decision_cache())
+                                 : absl::nullopt),
       ext_authz_ok_(pool_.add(createPoolStatName(config.stat_prefix(), "ok"))),
       ext_authz_denied_(pool_.add(createPoolStatName(config.stat_prefix(), "denied"))),
       ext_authz_error_(pool_.add(createPoolStatName(config.stat_prefix(), "error"))),
@@ -177,6 +180,15 @@ FilterConfig::FilterConfig(const envoy::extensions::filters::http::ext_authz::v3
     disallowed_headers_matcher_ = Filters::Common::ExtAuthz::CheckRequestUtils::toRequestMatchers(
         config.disallowed_headers(), false, factory_context);
   }
+
+  if (decision_cache_config_.has_value()) {
+    decision_cache_ =
+        ThreadLocal::TypedSlot<DecisionCache>::makeUnique(factory_context.threadLocal());
+    decision_cache_->set(
+        [max_entries = decision_cache_config_->maxEntries()](Event::Dispatcher&) {
+          return std::make_shared<DecisionCache>(max_entries);
+        });
+  }
 }
 
 void FilterConfigPerRoute::merge(const FilterConfigPerRoute& other) {
@@ -279,6 +291,10 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
     return;
   }
 
+  if (completeWithCachedDecision(headers)) {
+    return;
+  }
+
   // Now that we'll definitely be making the request, add filter state stats if configured to do so.
   const Envoy::StreamInfo::FilterStateSharedPtr& filter_state =
       decoder_callbacks_->streamInfo().filterState();
@@ -397,6 +413,48 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
   initiating_call_ = false;
 }
 
+bool Filter::completeWithCachedDecision(const Http::RequestHeaderMap& headers) {
+  const DecisionCacheConfig* cache_config = config_->decisionCacheConfig();
+  if (cache_config == nullptr) {
+    return false;
+  }
+  decision_cache_key_ = cache_config->key(
+      headers, decoder_callbacks_->route() != nullptr ? decoder_callbacks_->route()->routeName()
+                                                      : EMPTY_STRING);
+  if (!decision_cache_key_.has_value()) {
+    return false;
+  }
+  const Filters::Common::ExtAuthz::Response* decision = config_->decisionCache().lookup(
+      decision_cache_key_.value(), decoder_callbacks_->dispatcher().timeSource().monotonicTime());
+  if (decision == nullptr) {
+    stats_.decision_cache_misses_.inc();
+    return false;
+  }
+  stats_.decision_cache_hits_.inc();
+  ENVOY_STREAM_LOG(trace, "ext_authz filter using a cached decision.", *decoder_callbacks_);
+  decision_cache_key_.reset();
+  state_ = State::Calling;
+  filter_return_ = FilterReturn::StopDecoding;
+  initiating_call_ = true;
+  onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(*decision));
+  initiating_call_ = false;
+  return true;
+}
+
+void Filter::cacheDecision(const Filters::Common::ExtAuthz::Response& response) {
+  if (!decision_cache_key_.has_value()) {
+    return;
+  }
+  const std::chrono::milliseconds ttl = config_->decisionCacheConfig()->ttl(response);
+  if (ttl.count() > 0 &&
+      config_->decisionCache().insert(
+          decision_cache_key_.value(), response,
+          decoder_callbacks_->dispatcher().timeSource().monotonicTime() + ttl)) {
+    stats_.decision_cache_evictions_.inc();
+  }
+  decision_cache_key_.reset();
+}
+
 Http::FilterHeadersStatus Filter::decodeHeaders(Http::RequestHeaderMap& headers, bool end_stream) {
   Router::RouteConstSharedPtr route = decoder_callbacks_->route();
   const auto per_route_flags = getPerRouteFlags(route);
@@ -642,6 +700,9 @@ void Filter::onComplete(Filters::Common::ExtAuthz::ResponsePtr&& response) {
   using Filters::Common::ExtAuthz::CheckStatus;
   Stats::StatName empty_stat_name;
 
+  // Cached before the response is altered below.
+  cacheDecision(*response);
+
   updateLoggingInfo(response->grpc_status);
 
   if (response->saw_invalid_append_actions) {
@@ -13,6 +13,7 @@
 #include "envoy/service/auth/v3/external_auth.pb.h"
 #include "envoy/stats/scope.h"
 #include "envoy/stats/stats_macros.h"
+#include "envoy/thread_local/thread_local.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/common/assert.h"
@@ -29,6 +30,7 @@
 #include "source/extensions/filters/common/ext_authz/ext_authz_http_impl.h"
 #include "source/extensions/filters/common/mutation_rules/mutation_rules.h"
 #include "source/extensions/filters/common/processing_effect/processing_effect.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -50,7 +52,10 @@ namespace ExtAuthz {
   COUNTER(filter_state_name_collision)                                                             \
   COUNTER(omitted_response_headers)                                                                \
   COUNTER(request_header_limits_reached)                                                           \
-  COUNTER(response_header_limits_reached)
+  COUNTER(response_header_limits_reached)                                                          \
+  COUNTER(decision_cache_hits)                                                                     \
+  COUNTER(decision_cache_misses)                                                                   \
+  COUNTER(decision_cache_evictions)
 
 /**
  * Wrapper struct for ext_authz filter stats. @see stats_macros.h
@@ -236,6 +241,14 @@ public:
     return disallowed_headers_matcher_;
   }
 
+  // The config of the decision cache, or nullptr if the decisions are not cached.
+  const DecisionCacheConfig* decisionCacheConfig() const {
+    return decision_cache_config_.has_value() ? &decision_cache_config_.value() : nullptr;
+  }
+
+  // The decision cache of the worker. Only valid if decisionCacheConfig() is set.
+  DecisionCache& decisionCache() { return **decision_cache_; }
+
 private:
   static Http::Code toErrorCode(uint64_t status) {
     const auto code = static_cast<Http::Code>(status);
@@ -303,6 +316,9 @@ private:
   Filters::Common::ExtAuthz::MatcherSharedPtr allowed_headers_matcher_;
   Filters::Common::ExtAuthz::MatcherSharedPtr disallowed_headers_matcher_;
 
+  const absl::optional<DecisionCacheConfig> decision_cache_config_;
+  ThreadLocal::TypedSlotPtr<DecisionCache> decision_cache_;
+
 public:
   // TODO(nezdolik): deprecate cluster scope stats counters in favor of filter scope stats
   // (ExtAuthzFilterStats stats_).
@@ -474,6 +490,11 @@ private:
   absl::optional<MonotonicTime> start_time_;
   void addResponseHeaders(Http::HeaderMap& header_map, const Http::HeaderVector& headers);
   void initiateCall(const Http::RequestHeaderMap& headers);
+  // Completes the check with the cached decision of the request, if any. Otherwise keeps the key of
+  // the request to cache the decision of the authorization server.
+  // @return whether the check completed with a cached decision.
+  bool completeWithCachedDecision(const Http::RequestHeaderMap& headers);
+  void cacheDecision(const Filters::Common::ExtAuthz::Response& response);
   void continueDecoding();
   bool isBufferFull(uint64_t num_bytes_processing) const;
   void updateLoggingInfo(const absl::optional<Grpc::Status::GrpcStatus>& grpc_status);
@@ -524,6 +545,8 @@ private:
   bool buffer_data_{};
   bool skip_check_{false};
   envoy::service::auth::v3::CheckRequest check_request_{};
+  // The key of the decision of the request, if it is to be cached.
+  absl::optional<std::string> decision_cache_key_;
 };
 
 } // namespace ExtAuthz
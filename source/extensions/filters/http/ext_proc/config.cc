@@ -4,6 +4,7 @@
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 #include "source/extensions/filters/http/ext_proc/ext_proc.h"
 #include "source/extensions/filters/http/ext_proc/http_client/http_client_impl.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -67,9 +68,25 @@ absl::Status verifyFilterConfig(
                                       "be set to none-default at the same time.");
   }
 
+  if (config.has_grpc_stream_multiplexing() && !config.has_grpc_service()) {
+    return absl::InvalidArgumentError("grpc_stream_multiplexing requires a grpc_service");
+  }
+
   return verifyProcessingModeConfig(config);
 }
 
+// Creates the client of a filter, starting its gRPC streams over the shared streams of the worker
+// if they are multiplexed.
+ExternalProcessorClientPtr createGrpcClient(FilterConfig& config,
+                                            Grpc::AsyncClientManager& client_manager,
+                                            Stats::Scope& scope) {
+  OptRef<SharedProcessorStreams> shared_streams = config.sharedProcessorStreams();
+  if (shared_streams.has_value()) {
+    return std::make_unique<MultiplexedProcessorClient>(*shared_streams);
+  }
+  return createExternalProcessorClient(client_manager, scope);
+}
+
 } // namespace
 
 absl::StatusOr<Http::FilterFactoryCb>
@@ -94,8 +111,8 @@ ExternalProcessingFilterConfig::createFilterFactoryFromProtoTyped(
   if (proto_config.has_grpc_service()) {
     return [filter_config = std::move(filter_config), &context,
             dual_info](Http::FilterChainFactoryCallbacks& callbacks) {
-      auto client = createExternalProcessorClient(context.clusterManager().grpcAsyncClientManager(),
-                                                  dual_info.scope);
+      auto client = createGrpcClient(
+          *filter_config, context.clusterManager().grpcAsyncClientManager(), dual_info.scope);
       callbacks.addStreamFilter(
           Http::StreamFilterSharedPtr{std::make_shared<Filter>(filter_config, std::move(client))});
     };
@@ -142,8 +159,9 @@ ExternalProcessingFilterConfig::createFilterFactoryFromProtoWithServerContextTyp
   if (proto_config.has_grpc_service()) {
     return [filter_config = std::move(filter_config),
             &server_context](Http::FilterChainFactoryCallbacks& callbacks) {
-      auto client = createExternalProcessorClient(
-          server_context.clusterManager().grpcAsyncClientManager(), server_context.scope());
+      auto client =
+          createGrpcClient(*filter_config, server_context.clusterManager().grpcAsyncClientManager(),
+                           server_context.scope());
       callbacks.addStreamFilter(
           Http::StreamFilterSharedPtr{std::make_shared<Filter>(filter_config, std::move(client))});
     };
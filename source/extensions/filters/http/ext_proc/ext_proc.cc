@@ -270,6 +270,9 @@ FilterConfig::FilterConfig(const ExternalProcessor& config,
       grpc_service_(getFilterGrpcService(config)),
       send_body_without_waiting_for_header_response_(
           config.send_body_without_waiting_for_header_response()),
+      streamed_body_min_bytes_(config.streamed_body_aggregation().min_bytes()),
+      streamed_body_max_delay_(
+          PROTOBUF_GET_MS_OR_DEFAULT(config.streamed_body_aggregation(), max_delay, 0)),
       stats_(generateStats(stats_prefix, config.stat_prefix(), scope)),
       processing_mode_(config.processing_mode()),
       mutation_checker_(config.mutation_rules(), context.regexEngine()),
@@ -313,6 +316,18 @@ FilterConfig::FilterConfig(const ExternalProcessor& config,
 
   thread_local_stream_manager_slot_->set(
       [](Envoy::Event::Dispatcher&) { return std::make_shared<ThreadLocalStreamManager>(); });
+
+  if (grpc_service_.has_value() && config.has_grpc_stream_multiplexing()) {
+    const uint32_t max_shared_streams =
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.grpc_stream_multiplexing(), max_shared_streams, 1);
+    shared_processor_streams_slot_ = context.threadLocal().allocateSlot();
+    shared_processor_streams_slot_->set(
+        [&client_manager = context.clusterManager().grpcAsyncClientManager(), &scope,
+         max_shared_streams](Envoy::Event::Dispatcher&) {
+          return std::make_shared<SharedProcessorStreams>(client_manager, scope,
+                                                          max_shared_streams);
+        });
+  }
 }
 
 void ExtProcLoggingInfo::recordGrpcCall(
@@ -855,6 +870,8 @@ void Filter::onDestroy() {
   processing_complete_ = true;
   decoding_state_.stopMessageTimer();
   encoding_state_.stopMessageTimer();
+  decoding_state_.stopAggregationTimer();
+  encoding_state_.stopAggregationTimer();
 
   if (!config_->grpcService().has_value()) {
     client_->cancel();
@@ -1009,9 +1026,43 @@ FilterDataStatus Filter::handleDataStreamedMode(ProcessorState& state, Buffer::I
   // the ability to modify each chunk, in order. Doing this any other way would have required
   // substantial changes to the filter manager. See
   // https://github.com/envoyproxy/envoy/issues/16760 for a discussion.
+  //
+  // If the chunks are aggregated, the data is held until enough of it is received, or until the
+  // oldest held chunk is delayed long enough, and then sent as a single chunk. The held data was
+  // already prepended to the data of this callback by onData().
+  const uint32_t min_bytes = config_->streamedBodyMinBytes();
+  if (min_bytes > 0 && !end_stream) {
+    const uint32_t buffer_limit = state.bufferLimit();
+    const uint32_t flush_bytes = buffer_limit > 0 ? std::min(min_bytes, buffer_limit) : min_bytes;
+    if (data.length() < flush_bytes) {
+      ENVOY_STREAM_LOG(trace, "Aggregating {} bytes of body", *decoder_callbacks_, data.length());
+      state.aggregatedBody().move(data);
+      state.startAggregationTimer([this, &state] { flushAggregatedBody(state); },
+                                  config_->streamedBodyMaxDelay());
+      return state.getBodyCallbackResultInStreamedMode(false);
+    }
+  }
   return handleDataStreamedModeBase(state, data, end_stream);
 }
 
+void Filter::flushAggregatedBody(ProcessorState& state) {
+  state.stopAggregationTimer();
+  Buffer::OwnedImpl data;
+  data.move(state.aggregatedBody());
+  if (data.length() == 0) {
+    return;
+  }
+  ENVOY_STREAM_LOG(trace, "Flushing {} bytes of aggregated body", *decoder_callbacks_,
+                   data.length());
+  if (!processing_complete_ && state.bodyMode() == ProcessingMode::STREAMED) {
+    handleDataStreamedModeBase(state, data, false);
+  }
+  // Left over if the body is no longer processed, or the stream failed to open.
+  if (data.length() > 0) {
+    state.injectDataToFilterChain(data, false);
+  }
+}
+
 FilterDataStatus Filter::handleDataFullDuplexStreamedMode(ProcessorState& state,
                                                           Buffer::Instance& data, bool end_stream) {
   // FULL_DUPLEX_STREAMED body mode works similar to STREAMED except it does not put the data
@@ -1072,6 +1123,11 @@ FilterDataStatus Filter::onData(ProcessorState& state, Buffer::Instance& data, b
     return sendDataInObservabilityMode(data, state, end_stream);
   }
 
+  if (state.aggregatedBody().length() > 0) {
+    // The aggregated body comes first, whether it is aggregated again or not.
+    state.stopAggregationTimer();
+    data.prepend(state.aggregatedBody());
+  }
   if (end_stream) {
     state.setCompleteBodyAvailable(true);
   }
@@ -1257,6 +1313,10 @@ FilterDataStatus Filter::decodeData(Buffer::Instance& data, bool end_stream) {
 }
 
 FilterTrailersStatus Filter::onTrailers(ProcessorState& state, Http::HeaderMap& trailers) {
+  if (state.aggregatedBody().length() > 0) {
+    // The trailers end the body, so the aggregated one is sent first.
+    flushAggregatedBody(state);
+  }
   if (processing_complete_) {
     ENVOY_STREAM_LOG(trace, "trailers: Continue", *decoder_callbacks_);
     return FilterTrailersStatus::Continue;
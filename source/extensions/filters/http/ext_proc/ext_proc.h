@@ -26,6 +26,7 @@
 #include "source/extensions/filters/http/ext_proc/allowed_override_modes_set.h"
 #include "source/extensions/filters/http/ext_proc/client_impl.h"
 #include "source/extensions/filters/http/ext_proc/matching_utils.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
 #include "source/extensions/filters/http/ext_proc/on_processing_response.h"
 #include "source/extensions/filters/http/ext_proc/processing_request_modifier.h"
 #include "source/extensions/filters/http/ext_proc/processor_state.h"
@@ -254,6 +255,11 @@ public:
     return send_body_without_waiting_for_header_response_;
   }
 
+  // The number of bytes the STREAMED body chunks are aggregated up to, or 0 if each chunk is sent
+  // as it arrives.
+  uint32_t streamedBodyMinBytes() const { return streamed_body_min_bytes_; }
+  const std::chrono::milliseconds& streamedBodyMaxDelay() const { return streamed_body_max_delay_; }
+
   const ExtProcFilterStats& stats() const { return stats_; }
 
   const envoy::extensions::filters::http::ext_proc::v3::ProcessingMode& processingMode() const {
@@ -318,6 +324,14 @@ public:
     return thread_local_stream_manager_slot_->getTyped<ThreadLocalStreamManager>();
   }
 
+  // The shared gRPC streams of the worker, if the gRPC streams are multiplexed.
+  OptRef<SharedProcessorStreams> sharedProcessorStreams() {
+    if (shared_processor_streams_slot_ == nullptr) {
+      return {};
+    }
+    return shared_processor_streams_slot_->getTyped<SharedProcessorStreams>();
+  }
+
   const absl::optional<const envoy::config::core::v3::GrpcService> grpcService() const {
     return grpc_service_;
   }
@@ -365,6 +379,8 @@ private:
   const uint32_t max_message_timeout_ms_;
   const absl::optional<const envoy::config::core::v3::GrpcService> grpc_service_;
   const bool send_body_without_waiting_for_header_response_;
+  const uint32_t streamed_body_min_bytes_;
+  const std::chrono::milliseconds streamed_body_max_delay_;
 
   ExtProcFilterStats stats_;
   const envoy::extensions::filters::http::ext_proc::v3::ProcessingMode processing_mode_;
@@ -395,6 +411,8 @@ private:
   const std::function<std::unique_ptr<OnProcessingResponse>()> on_processing_response_factory_cb_;
 
   ThreadLocal::SlotPtr thread_local_stream_manager_slot_;
+  // Only set if the gRPC streams are multiplexed.
+  ThreadLocal::SlotPtr shared_processor_streams_slot_;
   const std::chrono::milliseconds remote_close_timeout_;
   const Http::Code status_on_error_;
   const bool allow_content_length_header_;
@@ -609,6 +627,9 @@ private:
                                                     bool end_stream);
   Http::FilterDataStatus handleDataStreamedMode(ProcessorState& state, Buffer::Instance& data,
                                                 bool end_stream);
+  // Sends the body chunks aggregated in STREAMED mode, or injects them if they are no longer
+  // processed.
+  void flushAggregatedBody(ProcessorState& state);
   Http::FilterDataStatus handleDataFullDuplexStreamedMode(ProcessorState& state,
                                                           Buffer::Instance& data, bool end_stream);
   Http::FilterDataStatus handleDataBufferedPartialMode(ProcessorState& state,
@@ -0,0 +1,178 @@
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+namespace {
+
+constexpr absl::string_view kExternalMethod = "envoy.service.ext_proc.v3.ExternalProcessor.Process";
+
+} // namespace
+
+SharedProcessorStreamSharedPtr SharedProcessorStream::create(Grpc::RawAsyncClientSharedPtr client) {
+  SharedProcessorStreamSharedPtr stream(new SharedProcessorStream(std::move(client)));
+  const auto* descriptor =
+      Protobuf::DescriptorPool::generated_pool()->FindMethodByName(std::string(kExternalMethod));
+  // The stream outlives the HTTP requests, so it has neither their parent context nor a timeout,
+  // and it does not buffer its messages for retries.
+  stream->stream_ = stream->client_.start(
+      *descriptor, *stream, Http::AsyncClient::StreamOptions().setSampled(absl::nullopt));
+  if (stream->stream_ == nullptr) {
+    return nullptr;
+  }
+  return stream;
+}
+
+SharedProcessorStream::~SharedProcessorStream() {
+  if (!closed_ && stream_ != nullptr) {
+    ENVOY_LOG(debug, "Closing shared gRPC stream");
+    stream_.closeStream();
+    stream_.resetStream();
+  }
+}
+
+uint64_t SharedProcessorStream::add(MultiplexedProcessorStream& stream) {
+  const uint64_t stream_id = next_stream_id_++;
+  streams_[stream_id] = &stream;
+  return stream_id;
+}
+
+void SharedProcessorStream::send(ProcessingRequest&& request) {
+  stream_.sendMessage(std::move(request), false);
+}
+
+void SharedProcessorStream::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) {
+  auto it = streams_.find(response->stream_id());
+  if (it == streams_.end()) {
+    ENVOY_LOG(debug, "Ignoring a response for the unknown stream {}", response->stream_id());
+    return;
+  }
+  it->second->onReceiveMessage(std::move(response));
+}
+
+void SharedProcessorStream::onRemoteClose(Grpc::Status::GrpcStatus status,
+                                          const std::string& message) {
+  ENVOY_LOG(debug, "Shared gRPC stream closed remotely with status {}: {}", status, message);
+  closed_ = true;
+  // The streams are looked up one at a time, as the callbacks of one may close the others.
+  std::vector<uint64_t> stream_ids;
+  stream_ids.reserve(streams_.size());
+  for (const auto& [stream_id, stream] : streams_) {
+    stream_ids.push_back(stream_id);
+  }
+  for (const uint64_t stream_id : stream_ids) {
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      continue;
+    }
+    MultiplexedProcessorStream* stream = it->second;
+    streams_.erase(it);
+    stream->onSharedStreamClose(status, message);
+  }
+}
+
+MultiplexedProcessorStream::MultiplexedProcessorStream(
+    SharedProcessorStreamSharedPtr shared_stream, ExternalProcessorCallbacks& callbacks)
+    : shared_stream_(std::move(shared_stream)), callbacks_(callbacks),
+      stream_id_(shared_stream_->add(*this)) {}
+
+void MultiplexedProcessorStream::onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) {
+  if (!callbacks_.has_value()) {
+    ENVOY_LOG(debug, "Underlying filter object has been destroyed.");
+    return;
+  }
+  callbacks_->onReceiveMessage(std::move(response));
+}
+
+void MultiplexedProcessorStream::onSharedStreamClose(Grpc::Status::GrpcStatus status,
+                                                     const std::string& message) {
+  // Already removed from the shared stream.
+  closed_ = true;
+  if (!callbacks_.has_value()) {
+    ENVOY_LOG(debug, "Underlying filter object has been destroyed.");
+    return;
+  }
+  callbacks_->logStreamInfo();
+  if (status == Grpc::Status::Ok) {
+    callbacks_->onGrpcClose();
+  } else {
+    callbacks_->onGrpcError(status, message);
+  }
+}
+
+void MultiplexedProcessorStream::send(ProcessingRequest&& request, bool) {
+  if (closed_) {
+    return;
+  }
+  request.set_stream_id(stream_id_);
+  shared_stream_->send(std::move(request));
+}
+
+bool MultiplexedProcessorStream::close() {
+  if (closed_) {
+    return false;
+  }
+  closed_ = true;
+  shared_stream_->remove(stream_id_);
+  return true;
+}
+
+SharedProcessorStreamSharedPtr
+SharedProcessorStreams::pick(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key) {
+  std::vector<SharedProcessorStreamSharedPtr>& streams = streams_[config_with_hash_key];
+  streams.erase(std::remove_if(streams.begin(), streams.end(),
+                               [](const SharedProcessorStreamSharedPtr& stream) {
+                                 return stream->closed();
+                               }),
+                streams.end());
+  if (streams.size() >= max_shared_streams_) {
+    return *std::min_element(streams.begin(), streams.end(),
+                             [](const SharedProcessorStreamSharedPtr& a,
+                                const SharedProcessorStreamSharedPtr& b) {
+                               return a->activeStreams() < b->activeStreams();
+                             });
+  }
+  auto client_or_error =
+      client_manager_.getOrCreateRawAsyncClientWithHashKey(config_with_hash_key, scope_, true);
+  if (!client_or_error.status().ok()) {
+    ENVOY_LOG_PERIODIC_MISC(error, std::chrono::seconds(10), "Creating raw asyc client failed {}",
+                            client_or_error.status());
+    return nullptr;
+  }
+  SharedProcessorStreamSharedPtr stream = SharedProcessorStream::create(client_or_error.value());
+  if (stream != nullptr) {
+    streams.push_back(stream);
+  }
+  return stream;
+}
+
+ExternalProcessorStreamPtr
+MultiplexedProcessorClient::start(ExternalProcessorCallbacks& callbacks,
+                                  const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key,
+                                  Http::AsyncClient::StreamOptions&,
+                                  Http::StreamFilterSidestreamWatermarkCallbacks&) {
+  SharedProcessorStreamSharedPtr shared_stream = shared_streams_.pick(config_with_hash_key);
+  if (shared_stream == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<MultiplexedProcessorStream>(std::move(shared_stream), callbacks);
+}
+
+void MultiplexedProcessorClient::sendRequest(ProcessingRequest&& request, bool end_stream,
+                                             const uint64_t,
+                                             CommonExtProc::RequestCallbacks<ProcessingResponse>*,
+                                             CommonExtProc::StreamBase* stream) {
+  auto* grpc_stream = dynamic_cast<ExternalProcessorStream*>(stream);
+  if (grpc_stream != nullptr) {
+    grpc_stream->send(std::move(request), end_stream);
+  }
+}
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
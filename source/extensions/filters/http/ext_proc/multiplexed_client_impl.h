@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/grpc/async_client_manager.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stream_info/stream_info.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/grpc/typed_async_client.h"
+#include "source/extensions/filters/http/ext_proc/client_impl.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+
+class MultiplexedProcessorStream;
+
+/**
+ * A long-lived gRPC stream to an external processing server, shared by the processing of many HTTP
+ * requests of a worker. The messages of each HTTP request are tagged with the stream_id of its
+ * MultiplexedProcessorStream, and the responses are dispatched to the stream of their stream_id.
+ * The closure of the gRPC stream ends all the streams sharing it.
+ */
+class SharedProcessorStream : public Grpc::AsyncStreamCallbacks<ProcessingResponse>,
+                              public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  // @return the stream, or nullptr if the gRPC stream failed to start.
+  static std::shared_ptr<SharedProcessorStream> create(Grpc::RawAsyncClientSharedPtr client);
+  ~SharedProcessorStream() override;
+
+  // Registers a stream, to which the responses of the returned stream_id are dispatched.
+  uint64_t add(MultiplexedProcessorStream& stream);
+  void remove(uint64_t stream_id) { streams_.erase(stream_id); }
+  void send(ProcessingRequest&& request);
+
+  bool closed() const { return closed_; }
+  // The number of streams sharing this one.
+  size_t activeStreams() const { return streams_.size(); }
+  const StreamInfo::StreamInfo& streamInfo() const { return stream_.streamInfo(); }
+  StreamInfo::StreamInfo& streamInfo() { return stream_.streamInfo(); }
+
+  // AsyncStreamCallbacks
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override;
+
+  // RawAsyncStreamCallbacks
+  void onCreateInitialMetadata(Http::RequestHeaderMap&) override {}
+  void onReceiveInitialMetadata(Http::ResponseHeaderMapPtr&&) override {}
+  void onReceiveTrailingMetadata(Http::ResponseTrailerMapPtr&&) override {}
+  void onRemoteClose(Grpc::Status::GrpcStatus status, const std::string& message) override;
+
+private:
+  explicit SharedProcessorStream(Grpc::RawAsyncClientSharedPtr client) : client_(client) {}
+
+  Grpc::AsyncClient<ProcessingRequest, ProcessingResponse> client_;
+  Grpc::AsyncStream<ProcessingRequest> stream_;
+  absl::flat_hash_map<uint64_t, MultiplexedProcessorStream*> streams_;
+  uint64_t next_stream_id_{1};
+  bool closed_{false};
+};
+
+using SharedProcessorStreamSharedPtr = std::shared_ptr<SharedProcessorStream>;
+
+/**
+ * The processing of an HTTP request over a SharedProcessorStream. Closing it only stops the
+ * dispatching of its responses, leaving the shared gRPC stream open for the other HTTP requests.
+ */
+class MultiplexedProcessorStream : public ExternalProcessorStream,
+                                   public Logger::Loggable<Logger::Id::ext_proc> {
+public:
+  MultiplexedProcessorStream(SharedProcessorStreamSharedPtr shared_stream,
+                             ExternalProcessorCallbacks& callbacks);
+  ~MultiplexedProcessorStream() override { close(); }
+
+  uint64_t streamId() const { return stream_id_; }
+
+  // Called by the shared stream.
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response);
+  void onSharedStreamClose(Grpc::Status::GrpcStatus status, const std::string& message);
+
+  // ExternalProcessorStream
+  // The shared stream is never half-closed, so end_stream is ignored.
+  void send(ProcessingRequest&& request, bool end_stream) override;
+  bool close() override;
+  bool halfCloseAndDeleteOnRemoteClose() override { return close(); }
+  const StreamInfo::StreamInfo& streamInfo() const override { return shared_stream_->streamInfo(); }
+  StreamInfo::StreamInfo& streamInfo() override { return shared_stream_->streamInfo(); }
+  void notifyFilterDestroy() override { callbacks_.reset(); }
+
+private:
+  // Keeps the shared stream alive, even when it is no longer picked for new HTTP requests.
+  const SharedProcessorStreamSharedPtr shared_stream_;
+  OptRef<ExternalProcessorCallbacks> callbacks_;
+  const uint64_t stream_id_;
+  bool closed_{false};
+};
+
+/**
+ * The shared gRPC streams of a worker, per gRPC service.
+ */
+class SharedProcessorStreams : public ThreadLocal::ThreadLocalObject {
+public:
+  SharedProcessorStreams(Grpc::AsyncClientManager& client_manager, Stats::Scope& scope,
+                         uint32_t max_shared_streams)
+      : client_manager_(client_manager), scope_(scope), max_shared_streams_(max_shared_streams) {}
+
+  /**
+   * Opens a new shared stream to the service while it has fewer than the max shared streams, or
+   * picks its open stream with the fewest active streams.
+   * @return the shared stream, or nullptr if a new stream failed to start.
+   */
+  SharedProcessorStreamSharedPtr
+  pick(const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key);
+
+private:
+  Grpc::AsyncClientManager& client_manager_;
+  Stats::Scope& scope_;
+  const uint32_t max_shared_streams_;
+  absl::flat_hash_map<Grpc::GrpcServiceConfigWithHashKey,
+                      std::vector<SharedProcessorStreamSharedPtr>>
+      streams_;
+};
+
+/**
+ * A client starting MultiplexedProcessorStreams over the shared streams of the worker.
+ */
+class MultiplexedProcessorClient : public ExternalProcessorClient {
+public:
+  explicit MultiplexedProcessorClient(SharedProcessorStreams& shared_streams)
+      : shared_streams_(shared_streams) {}
+
+  // ExternalProcessorClient
+  // The options and watermark callbacks of the HTTP request are not applied to the shared stream,
+  // which outlives the request.
+  ExternalProcessorStreamPtr start(ExternalProcessorCallbacks& callbacks,
+                                   const Grpc::GrpcServiceConfigWithHashKey& config_with_hash_key,
+                                   Http::AsyncClient::StreamOptions&,
+                                   Http::StreamFilterSidestreamWatermarkCallbacks&) override;
+  void sendRequest(ProcessingRequest&& request, bool end_stream, const uint64_t,
+                   CommonExtProc::RequestCallbacks<ProcessingResponse>*,
+                   CommonExtProc::StreamBase* stream) override;
+  void cancel() override {}
+  const StreamInfo::StreamInfo* getStreamInfo() const override { return nullptr; }
+
+private:
+  SharedProcessorStreams& shared_streams_;
+};
+
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -70,6 +70,22 @@ void ProcessorState::stopMessageTimer() {
   }
 }
 
+void ProcessorState::startAggregationTimer(Event::TimerCb cb,
+                                           std::chrono::milliseconds max_delay) {
+  if (aggregation_timer_ == nullptr) {
+    aggregation_timer_ = filter_callbacks_->dispatcher().createTimer(cb);
+  }
+  if (!aggregation_timer_->enabled()) {
+    aggregation_timer_->enableTimer(max_delay);
+  }
+}
+
+void ProcessorState::stopAggregationTimer() {
+  if (aggregation_timer_) {
+    aggregation_timer_->disableTimer();
+  }
+}
+
 void ProcessorState::logMutation(CallbackState callback_state, Effect processing_effect) {
   ExtProcLoggingInfo* logging_info = filter_.loggingInfo();
   if (logging_info != nullptr) {
@@ -578,6 +594,14 @@ void ProcessorState::clearAsyncState(Grpc::Status::GrpcStatus call_status) {
                      chunkQueue().receivedData().length());
     injectDataToFilterChain(chunkQueue().receivedData(), all_data.end_stream);
   }
+  if (aggregated_body_.length() > 0) {
+    // The end of the body is never aggregated, so more data follows.
+    stopAggregationTimer();
+    ENVOY_STREAM_LOG(trace, "Injecting aggregated body of {} bytes", *filter_callbacks_,
+                     aggregated_body_.length());
+    injectDataToFilterChain(aggregated_body_, false);
+    aggregated_body_.drain(aggregated_body_.length());
+  }
   clearWatermark();
   continueIfNecessary();
 }
@@ -225,6 +225,11 @@ public:
   QueuedChunkPtr dequeueStreamingChunk(Buffer::OwnedImpl& out_data);
   // Consolidate all the chunks on the queue into a single one and return a reference.
   const QueuedChunk& consolidateStreamedChunks() { return chunk_queue_.consolidate(); }
+  // The body chunks held in STREAMED mode until they are aggregated into a single message.
+  Buffer::OwnedImpl& aggregatedBody() { return aggregated_body_; }
+  // Arms the timer flushing the aggregated body, unless it is already armed.
+  void startAggregationTimer(Event::TimerCb cb, std::chrono::milliseconds max_delay);
+  void stopAggregationTimer();
   bool queueOverHighLimit() const { return chunk_queue_.bytesEnqueued() > bufferLimit(); }
   bool queueBelowLowLimit() const { return chunk_queue_.bytesEnqueued() < bufferLimit() / 2; }
   bool shouldRemoveContentLength() const {
@@ -375,6 +380,8 @@ protected:
   // Envoy should receive at most one such message in one particular state.
   bool new_timeout_received_{false};
   ChunkQueue chunk_queue_;
+  Buffer::OwnedImpl aggregated_body_;
+  Event::TimerPtr aggregation_timer_;
   absl::optional<MonotonicTime> call_start_time_ = absl::nullopt;
   const envoy::config::core::v3::TrafficDirection traffic_direction_;
 
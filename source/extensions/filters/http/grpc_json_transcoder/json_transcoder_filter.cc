@@ -243,6 +243,9 @@ JsonTranscoderConfig::JsonTranscoderConfig(
   if (proto_config.has_max_response_body_size()) {
     max_response_body_size_ = proto_config.max_response_body_size().value();
   }
+  if (proto_config.has_unary_response_streaming_window()) {
+    unary_response_streaming_window_ = proto_config.unary_response_streaming_window().value();
+  }
 }
 
 void JsonTranscoderConfig::addFileDescriptor(const Protobuf::FileDescriptorProto& file) {
@@ -766,7 +769,18 @@ Http::FilterDataStatus JsonTranscoderFilter::encodeData(Buffer::Instance& data,
     return Http::FilterDataStatus::StopIterationNoBuffer;
   }
 
-  if (!method_->descriptor_->server_streaming() && !end_stream) {
+  if (!method_->descriptor_->server_streaming() && !end_stream && !unary_response_streamed_) {
+    const absl::optional<uint32_t>& window = per_route_config_->unary_response_streaming_window_;
+    if (window.has_value() && response_data_.length() > window.value()) {
+      ENVOY_STREAM_LOG(debug,
+                       "streaming unary response during encodeData, transcoded data size={}",
+                       *encoder_callbacks_, response_data_.length());
+      // The headers are sent with this data, so the length of the body is unknown.
+      response_headers_->removeContentLength();
+      unary_response_streamed_ = true;
+      data.move(response_data_);
+      return Http::FilterDataStatus::Continue;
+    }
     ENVOY_STREAM_LOG(debug,
                      "internally buffering unary response waiting for end_stream during "
                      "encodeData, transcoded data size={}",
@@ -824,7 +838,7 @@ void JsonTranscoderFilter::doTrailers(Http::ResponseHeaderOrTrailerMap& headers_
   const bool is_trailers_only_response = response_headers_ == &headers_or_trailers;
   const bool is_server_streaming = method_->descriptor_->server_streaming();
 
-  if (is_server_streaming && !is_trailers_only_response) {
+  if ((is_server_streaming || unary_response_streamed_) && !is_trailers_only_response) {
     // Continue if headers were sent already.
     return;
   }
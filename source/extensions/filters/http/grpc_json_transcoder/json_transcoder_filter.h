@@ -105,6 +105,8 @@ public:
 
   absl::optional<uint32_t> max_request_body_size_;
   absl::optional<uint32_t> max_response_body_size_;
+  // The JSON bytes of a non-streaming response buffered before it is streamed, if it may be.
+  absl::optional<uint32_t> unary_response_streaming_window_;
 
   void addBuiltinSymbolDescriptor(const std::string& symbol_name);
 
@@ -225,6 +227,8 @@ private:
 
   bool error_{false};
   bool has_body_{false};
+  // Whether the headers of a non-streaming response were sent with the first part of its body.
+  bool unary_response_streamed_{false};
   bool http_body_response_headers_set_{false};
 
   // Don't buffer unary response data in the `FilterManager` buffer.
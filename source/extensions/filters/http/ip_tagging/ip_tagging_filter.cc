@@ -5,6 +5,7 @@
 
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/protobuf/utility.h"
 
 #include "absl/strings/str_join.h"
 
@@ -13,22 +14,75 @@ namespace Extensions {
 namespace HttpFilters {
 namespace IpTagging {
 
+namespace {
+
+// Loads the IP tags of the YAML or JSON content of a data source.
+absl::StatusOr<std::shared_ptr<IpTags>>
+loadIpTags(absl::string_view content, Stats::SymbolTable& symbol_table,
+           ProtobufMessage::ValidationVisitor& validation_visitor) {
+  envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IPTags ip_tags;
+  TRY_NEEDS_AUDIT {
+    MessageUtil::loadFromYamlAndValidate(std::string(content), ip_tags, validation_visitor);
+  }
+  END_TRY catch (const EnvoyException& e) {
+    return absl::InvalidArgumentError(fmt::format("invalid ip_tags: {}", e.what()));
+  }
+  return IpTags::create(ip_tags.ip_tags(), symbol_table);
+}
+
+} // namespace
+
+absl::StatusOr<std::shared_ptr<IpTags>>
+IpTags::create(const Protobuf::RepeatedPtrField<IPTag>& ip_tags, Stats::SymbolTable& symbol_table) {
+  std::shared_ptr<IpTags> result(new IpTags(symbol_table));
+  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
+  tag_data.reserve(ip_tags.size());
+  size_t num_cidr_ranges = 0;
+  for (const auto& ip_tag : ip_tags) {
+    num_cidr_ranges += ip_tag.ip_list().size();
+    std::vector<Network::Address::CidrRange> cidr_set;
+    cidr_set.reserve(ip_tag.ip_list().size());
+    for (const envoy::config::core::v3::CidrRange& entry : ip_tag.ip_list()) {
+
+      absl::StatusOr<Network::Address::CidrRange> cidr_or_error =
+          Network::Address::CidrRange::create(entry);
+      if (cidr_or_error.status().ok()) {
+        cidr_set.emplace_back(std::move(cidr_or_error.value()));
+      } else {
+        return absl::InvalidArgumentError(
+            fmt::format("invalid ip/mask combo '{}/{}' (format is <ip>/<# mask bits>)",
+                        entry.address_prefix(), entry.prefix_len().value()));
+      }
+    }
+
+    tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
+    result->stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
+  }
+  if (num_cidr_ranges >= PoptrieMinCidrRanges) {
+    result->poptrie_ = std::make_unique<Network::Poptrie::Poptrie<std::string>>(tag_data);
+  } else {
+    result->trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+  }
+  return result;
+}
+
 absl::StatusOr<IpTaggingFilterConfigSharedPtr> IpTaggingFilterConfig::create(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime) {
+    const std::string& stat_prefix, Stats::Scope& scope,
+    Server::Configuration::ServerFactoryContext& context) {
   absl::Status creation_status = absl::OkStatus();
   auto config_ptr = std::shared_ptr<IpTaggingFilterConfig>(
-      new IpTaggingFilterConfig(config, stat_prefix, scope, runtime, creation_status));
+      new IpTaggingFilterConfig(config, stat_prefix, scope, context, creation_status));
   RETURN_IF_NOT_OK(creation_status);
   return config_ptr;
 }
 
 IpTaggingFilterConfig::IpTaggingFilterConfig(
     const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-    const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime,
-    absl::Status& creation_status)
-    : request_type_(requestTypeEnum(config.request_type())), scope_(scope), runtime_(runtime),
-      stat_name_set_(scope.symbolTable().makeSet("IpTagging")),
+    const std::string& stat_prefix, Stats::Scope& scope,
+    Server::Configuration::ServerFactoryContext& context, absl::Status& creation_status)
+    : request_type_(requestTypeEnum(config.request_type())), scope_(scope),
+      runtime_(context.runtime()), stat_name_set_(scope.symbolTable().makeSet("IpTagging")),
       stats_prefix_(stat_name_set_->add(stat_prefix + "ip_tagging")),
       no_hit_(stat_name_set_->add("no_hit")), total_(stat_name_set_->add("total")),
       unknown_tag_(stat_name_set_->add("unknown_tag.hit")),
@@ -37,40 +91,31 @@ IpTaggingFilterConfig::IpTaggingFilterConfig(
                                 ? config.ip_tag_header().action()
                                 : HeaderAction::IPTagging_IpTagHeader_HeaderAction_SANITIZE) {
 
-  // Once loading IP tags from a file system is supported, the restriction on the size
-  // of the set should be removed and observability into what tags are loaded needs
-  // to be implemented.
-  // TODO(ccaraman): Remove size check once file system support is implemented.
-  // Work is tracked by issue https://github.com/envoyproxy/envoy/issues/2695.
-  if (config.ip_tags().empty()) {
-    creation_status =
-        absl::InvalidArgumentError("HTTP IP Tagging Filter requires ip_tags to be specified.");
+  if (config.ip_tags().empty() == !config.has_ip_tags_datasource()) {
+    creation_status = absl::InvalidArgumentError(
+        "HTTP IP Tagging Filter requires one of ip_tags or ip_tags_datasource to be specified.");
     return;
   }
 
-  std::vector<std::pair<std::string, std::vector<Network::Address::CidrRange>>> tag_data;
-  tag_data.reserve(config.ip_tags().size());
-  for (const auto& ip_tag : config.ip_tags()) {
-    std::vector<Network::Address::CidrRange> cidr_set;
-    cidr_set.reserve(ip_tag.ip_list().size());
-    for (const envoy::config::core::v3::CidrRange& entry : ip_tag.ip_list()) {
-
-      absl::StatusOr<Network::Address::CidrRange> cidr_or_error =
-          Network::Address::CidrRange::create(entry);
-      if (cidr_or_error.status().ok()) {
-        cidr_set.emplace_back(std::move(cidr_or_error.value()));
-      } else {
-        creation_status = absl::InvalidArgumentError(
-            fmt::format("invalid ip/mask combo '{}/{}' (format is <ip>/<# mask bits>)",
-                        entry.address_prefix(), entry.prefix_len().value()));
-        return;
-      }
-    }
-
-    tag_data.emplace_back(ip_tag.ip_tag_name(), cidr_set);
-    stat_name_set_->rememberBuiltin(absl::StrCat(ip_tag.ip_tag_name(), ".hit"));
+  if (!config.has_ip_tags_datasource()) {
+    auto ip_tags_or_error = IpTags::create(config.ip_tags(), scope.symbolTable());
+    SET_AND_RETURN_IF_NOT_OK(ip_tags_or_error.status(), creation_status);
+    ip_tags_ = std::move(ip_tags_or_error.value());
+    return;
   }
-  trie_ = std::make_unique<Network::LcTrie::LcTrie<std::string>>(tag_data);
+
+  // The tries of the IP tags of a modified file are built on the main thread, and the workers
+  // keep using the previous ones until they are swapped in.
+  auto provider_or_error = Config::DataSource::DataSourceProvider<IpTags>::create(
+      config.ip_tags_datasource(), context.mainThreadDispatcher(), context.threadLocal(),
+      context.api(),
+      [&symbol_table = scope.symbolTable(),
+       &validation_visitor = context.messageValidationVisitor()](absl::string_view content) {
+        return loadIpTags(content, symbol_table, validation_visitor);
+      },
+      {.modify_watch = true, .hash_content = true});
+  SET_AND_RETURN_IF_NOT_OK(provider_or_error.status(), creation_status);
+  ip_tags_provider_ = std::move(provider_or_error.value());
 }
 
 void IpTaggingFilterConfig::incCounter(Stats::StatName name) {
@@ -95,8 +140,9 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
     return Http::FilterHeadersStatus::Continue;
   }
 
+  const IpTagsSharedPtr ip_tags = config_->ipTags();
   std::vector<std::string> tags =
-      config_->trie().getData(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
+      ip_tags->lookup(callbacks_->streamInfo().downstreamAddressProvider().remoteAddress());
 
   applyTags(headers, tags);
   if (!tags.empty()) {
@@ -104,7 +150,7 @@ Http::FilterHeadersStatus IpTaggingFilter::decodeHeaders(Http::RequestHeaderMap&
     // If there are use cases with a large set of tags, a way to opt into these stats
     // should be exposed and other observability options like logging tags need to be implemented.
     for (const std::string& tag : tags) {
-      config_->incHit(tag);
+      config_->incHit(*ip_tags, tag);
     }
   } else {
     config_->incNoHit();
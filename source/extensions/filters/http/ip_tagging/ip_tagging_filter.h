@@ -11,10 +11,13 @@
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
 #include "envoy/http/filter.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/server/factory_context.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/config/datasource.h"
 #include "source/common/network/cidr_range.h"
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
 #include "source/common/stats/symbol_table.h"
 
 namespace Envoy {
@@ -27,6 +30,50 @@ namespace IpTagging {
  */
 enum class FilterRequestType { INTERNAL, EXTERNAL, BOTH };
 
+/**
+ * Number of CIDR ranges from which the tags are looked up in a Poptrie rather than an LcTrie.
+ */
+constexpr size_t PoptrieMinCidrRanges = 1 << 16;
+
+/**
+ * A set of IP tags: the tries of their CIDR ranges, and the names of their hit stats.
+ */
+class IpTags {
+public:
+  using IPTag = envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IPTag;
+
+  static absl::StatusOr<std::shared_ptr<IpTags>>
+  create(const Protobuf::RepeatedPtrField<IPTag>& ip_tags, Stats::SymbolTable& symbol_table);
+
+  /**
+   * @return the tags of the CIDR ranges containing an address.
+   */
+  std::vector<std::string> lookup(const Network::Address::InstanceConstSharedPtr& address) const {
+    return poptrie_ != nullptr ? poptrie_->getData(address) : trie_->getData(address);
+  }
+
+  /**
+   * @return the name of the hit stat of a tag, or the fallback if the tag is unknown.
+   */
+  Stats::StatName hitStatName(absl::string_view tag, Stats::StatName fallback) const {
+    return stat_name_set_->getBuiltin(absl::StrCat(tag, ".hit"), fallback);
+  }
+
+private:
+  explicit IpTags(Stats::SymbolTable& symbol_table)
+      : stat_name_set_(symbol_table.makeSet("IpTagging")) {}
+
+  // Owned by the set rather than by the config, as the builtins of a StatNameSet can't be added
+  // once the workers use it.
+  Stats::StatNameSetPtr stat_name_set_;
+  // Large sets of CIDR ranges are held in a Poptrie, which has faster lookups than an LcTrie for
+  // them and no limit on their number, the others in an LcTrie.
+  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  std::unique_ptr<Network::Poptrie::Poptrie<std::string>> poptrie_;
+};
+
+using IpTagsSharedPtr = std::shared_ptr<const IpTags>;
+
 /**
  * Configuration for the HTTP IP Tagging filter.
  */
@@ -36,11 +83,18 @@ public:
       envoy::extensions::filters::http::ip_tagging::v3::IPTagging::IpTagHeader::HeaderAction;
   static absl::StatusOr<std::shared_ptr<IpTaggingFilterConfig>>
   create(const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
-         const std::string& stat_prefix, Stats::Scope& scope, Runtime::Loader& runtime);
+         const std::string& stat_prefix, Stats::Scope& scope,
+         Server::Configuration::ServerFactoryContext& context);
 
   Runtime::Loader& runtime() { return runtime_; }
   FilterRequestType requestType() const { return request_type_; }
-  const Network::LcTrie::LcTrie<std::string>& trie() const { return *trie_; }
+
+  /**
+   * @return the current IP tags, replaced on the workers when those of the data source change.
+   */
+  IpTagsSharedPtr ipTags() const {
+    return ip_tags_provider_ != nullptr ? ip_tags_provider_->data() : ip_tags_;
+  }
 
   OptRef<const Http::LowerCaseString> ipTagHeader() const {
     if (ip_tag_header_.get().empty()) {
@@ -50,8 +104,8 @@ public:
   }
   HeaderAction ipTagHeaderAction() const { return ip_tag_header_action_; }
 
-  void incHit(absl::string_view tag) {
-    incCounter(stat_name_set_->getBuiltin(absl::StrCat(tag, ".hit"), unknown_tag_));
+  void incHit(const IpTags& ip_tags, absl::string_view tag) {
+    incCounter(ip_tags.hitStatName(tag, unknown_tag_));
   }
   void incNoHit() { incCounter(no_hit_); }
   void incTotal() { incCounter(total_); }
@@ -59,7 +113,8 @@ public:
 private:
   IpTaggingFilterConfig(const envoy::extensions::filters::http::ip_tagging::v3::IPTagging& config,
                         const std::string& stat_prefix, Stats::Scope& scope,
-                        Runtime::Loader& runtime, absl::Status& creation_status);
+                        Server::Configuration::ServerFactoryContext& context,
+                        absl::Status& creation_status);
 
   static FilterRequestType requestTypeEnum(
       envoy::extensions::filters::http::ip_tagging::v3::IPTagging::RequestType request_type) {
@@ -85,7 +140,9 @@ private:
   const Stats::StatName no_hit_;
   const Stats::StatName total_;
   const Stats::StatName unknown_tag_;
-  std::unique_ptr<Network::LcTrie::LcTrie<std::string>> trie_;
+  // Either the IP tags of the config, or the provider of those of the data source.
+  IpTagsSharedPtr ip_tags_;
+  Config::DataSource::DataSourceProviderPtr<IpTags> ip_tags_provider_;
   const Http::LowerCaseString
       ip_tag_header_; // An empty string indicates that no ip_tag_header is set.
   const HeaderAction ip_tag_header_action_;
@@ -222,6 +222,20 @@ void AuthenticatorImpl::startVerify() {
     return;
   }
 
+  // Without a provider, the cache of the provider of the issuer is only known once the token is
+  // parsed. Its signature is only verified on a miss.
+  if (!provider_) {
+    JwtVerify::Jwt* cached_jwt = jwks_data_->getJwtCache().lookup(curr_token_->token());
+    if (cached_jwt != nullptr) {
+      jwks_cache_.stats().jwt_cache_hit_.inc();
+      use_jwt_cache = true;
+      jwt_ = cached_jwt;
+      owned_jwt_.reset();
+    } else {
+      jwks_cache_.stats().jwt_cache_miss_.inc();
+    }
+  }
+
   // Default is 60 seconds
   uint64_t clock_skew_seconds = JwtVerify::kClockSkewInSecond;
   if (jwks_data_->getJwtProvider().clock_skew_seconds() > 0) {
@@ -421,7 +435,7 @@ void AuthenticatorImpl::handleGoodJwt(bool cache_hit) {
       setPayloadMetadata(jwt_->payload_pb_);
     }
   }
-  if (provider_ && !cache_hit) {
+  if (!cache_hit) {
     // move the ownership of "owned_jwt_" into the function.
     jwks_data_->getJwtCache().insert(curr_token_->token(), std::move(owned_jwt_));
   }
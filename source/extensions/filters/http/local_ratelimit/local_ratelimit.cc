@@ -112,9 +112,20 @@ FilterConfig::FilterConfig(
     share_provider = share_provider_manager_->getShareProvider(config.local_cluster_rate_limit());
   }
 
+  Filters::Common::LocalRateLimit::TokenBucketSharding sharding;
+  if (config.has_worker_token_batch_size()) {
+    if (rate_limit_per_connection_) {
+      throw EnvoyException("worker_token_batch_size is set and "
+                           "local_rate_limit_per_downstream_connection is set to true");
+    }
+    sharding.shards_ = context.options().concurrency();
+    sharding.batch_tokens_ = config.worker_token_batch_size().value();
+  }
+
   rate_limiter_ = std::make_unique<Filters::Common::LocalRateLimit::LocalRateLimiterImpl>(
       fill_interval_, max_tokens_, tokens_per_fill_, dispatcher_, descriptors_,
-      always_consume_default_token_bucket_, std::move(share_provider), max_dynamic_descriptors_);
+      always_consume_default_token_bucket_, std::move(share_provider), max_dynamic_descriptors_,
+      sharding);
 }
 
 Filters::Common::LocalRateLimit::LocalRateLimiter::Result
@@ -107,6 +107,9 @@ struct DelegatingFactoryCallbacks : public Envoy::Http::FilterChainFactoryCallba
       : delegated_callbacks_(delegated_callbacks), match_tree_(match_tree) {}
 
   Event::Dispatcher& dispatcher() override { return delegated_callbacks_.dispatcher(); }
+  void reserveFilters(uint32_t filter_count) override {
+    delegated_callbacks_.reserveFilters(filter_count);
+  }
   void addStreamDecoderFilter(Envoy::Http::StreamDecoderFilterSharedPtr filter) override {
     auto delegating_filter =
         std::make_shared<DelegatingStreamFilter>(match_tree_, std::move(filter), nullptr);
@@ -177,8 +177,7 @@ bool BackendStreamCallbacks::tryParseSseResponse() {
   while (!remaining.empty()) {
     // Look for complete SSE events (terminated by blank line).
     // findEventEnd returns {event_start, event_end, next_event_start}.
-    auto [event_start, event_end, next_start] =
-        Http::Sse::SseParser::findEventEnd(remaining, false);
+    auto [event_start, event_end, next_start] = sse_event_finder_.findEventEnd(remaining, false);
     ENVOY_LOG(debug,
               "tryParseSseResponse: remaining_size={}, event_start={}, event_end={}, next_start={}",
               remaining.size(), event_start, event_end, next_start);
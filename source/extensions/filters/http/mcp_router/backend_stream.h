@@ -10,6 +10,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
+#include "source/common/http/sse/sse_parser.h"
 
 #include "absl/strings/string_view.h"
 
@@ -162,6 +163,8 @@ private:
   bool found_response_{false};             // Cache result to avoid re-parsing
   BackendResponse response_;
   bool completed_{false};
+  // Resumes the scan of the incomplete SSE event at parse_offset_.
+  Http::Sse::SseParser::EventFinder sse_event_finder_;
 };
 
 } // namespace McpRouter
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/http/oauth2/filter.h"
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <memory>
 #include <string>
@@ -24,6 +25,7 @@
 #include "source/common/router/retry_policy_impl.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/hash/hash.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -589,10 +591,40 @@ bool OAuth2CookieValidator::hmacIsValid() const {
   if (!cookie_domain_.empty()) {
     cookie_domain = cookie_domain_;
   }
-  return ((encodeHmacBase64(secret_, cookie_domain, expires_, access_token_, id_token_,
-                            refresh_token_) == hmac_) ||
-          (encodeHmacHexBase64(secret_, cookie_domain, expires_, access_token_, id_token_,
-                               refresh_token_) == hmac_));
+
+  // The cookies with a valid HMAC seen recently, indexed by the hash of their HMAC. A client sends
+  // the same cookies until they are refreshed, so their HMACs are only computed once per worker.
+  // An entry is only used for the same secret, domain and cookie values, the expiry of the cookies
+  // being checked on every request by timestampIsValid().
+  struct ValidatedCookies {
+    std::vector<uint8_t> secret_;
+    std::string domain_;
+    std::string expires_;
+    std::string access_token_;
+    std::string id_token_;
+    std::string refresh_token_;
+    std::string hmac_;
+  };
+  static constexpr size_t CacheSize = 16;
+  thread_local std::array<ValidatedCookies, CacheSize> cache;
+
+  ValidatedCookies& entry = cache[absl::HashOf(hmac_) % CacheSize];
+  if (!hmac_.empty() && entry.hmac_ == hmac_ && entry.expires_ == expires_ &&
+      entry.access_token_ == access_token_ && entry.id_token_ == id_token_ &&
+      entry.refresh_token_ == refresh_token_ && entry.domain_ == cookie_domain &&
+      entry.secret_ == secret_) {
+    return true;
+  }
+
+  const bool valid = (encodeHmacBase64(secret_, cookie_domain, expires_, access_token_, id_token_,
+                                       refresh_token_) == hmac_) ||
+                     (encodeHmacHexBase64(secret_, cookie_domain, expires_, access_token_,
+                                          id_token_, refresh_token_) == hmac_);
+  if (valid) {
+    entry = {secret_, std::string(cookie_domain), expires_, access_token_, id_token_,
+             refresh_token_, hmac_};
+  }
+  return valid;
 }
 
 bool OAuth2CookieValidator::timestampIsValid() const {
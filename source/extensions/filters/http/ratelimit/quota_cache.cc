@@ -0,0 +1,79 @@
+#include "source/extensions/filters/http/ratelimit/quota_cache.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+namespace {
+
+// Appends a length prefixed value, so that distinct keys never concatenate to the same string.
+void appendToKey(std::string& key, absl::string_view value) {
+  absl::StrAppend(&key, value.size(), ":", value);
+}
+
+} // namespace
+
+absl::optional<std::string>
+QuotaCache::key(absl::string_view domain,
+                const std::vector<Envoy::RateLimit::Descriptor>& descriptors) {
+  std::string key;
+  appendToKey(key, domain);
+  for (const Envoy::RateLimit::Descriptor& descriptor : descriptors) {
+    if (descriptor.hits_addend_.has_value()) {
+      return absl::nullopt;
+    }
+    absl::StrAppend(&key, descriptor.entries_.size(), ";");
+    for (const Envoy::RateLimit::DescriptorEntry& entry : descriptor.entries_) {
+      appendToKey(key, entry.key_);
+      appendToKey(key, entry.value_);
+    }
+    if (descriptor.limit_.has_value()) {
+      absl::StrAppend(&key, descriptor.limit_->requests_per_unit_, "/",
+                      static_cast<int>(descriptor.limit_->unit_));
+    }
+    absl::StrAppend(&key, ";");
+  }
+  return key;
+}
+
+absl::optional<Filters::Common::RateLimit::LimitStatus>
+QuotaCache::consume(const std::string& key, uint32_t hits, SystemTime now) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return absl::nullopt;
+  }
+  if (it->second->expiry_ <= now) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  Entry& entry = *it->second;
+  if (entry.requests_ < hits) {
+    return Filters::Common::RateLimit::LimitStatus::OverLimit;
+  }
+  entry.requests_ -= hits;
+  return Filters::Common::RateLimit::LimitStatus::OK;
+}
+
+void QuotaCache::insert(const std::string& key, uint32_t requests, SystemTime expiry) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, requests, expiry});
+  index_[key] = entries_.begin();
+}
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/ratelimit/ratelimit.h"
+#include "envoy/thread_local/thread_local_object.h"
+
+#include "source/extensions/filters/common/ratelimit/ratelimit.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+
+/**
+ * The quotas granted by the rate limit service for the descriptor sets of a worker thread, evicted
+ * in least recently used order. Not thread safe.
+ */
+class QuotaCache : public ThreadLocal::ThreadLocalObject {
+public:
+  explicit QuotaCache(uint32_t max_entries) : max_entries_(max_entries) {}
+
+  /**
+   * @return the key of the quota of the descriptors of a domain, or absl::nullopt if their hits
+   *         are not all counted as those of the request, so that they can not be served from it.
+   */
+  static absl::optional<std::string>
+  key(absl::string_view domain, const std::vector<Envoy::RateLimit::Descriptor>& descriptors);
+
+  /**
+   * Consumes the hits of a request from the quota of a key.
+   * @return OK if the quota had enough hits left, OverLimit if it did not, or absl::nullopt if
+   *         there is no quota for it or it expired, in which case the service must be called.
+   */
+  absl::optional<Filters::Common::RateLimit::LimitStatus> consume(const std::string& key,
+                                                                  uint32_t hits, SystemTime now);
+
+  /**
+   * Inserts the quota of a key, replacing any previous one.
+   * @param requests the number of hits left in the quota.
+   */
+  void insert(const std::string& key, uint32_t requests, SystemTime expiry);
+
+  size_t size() const { return index_.size(); }
+
+private:
+  struct Entry {
+    const std::string key_;
+    uint32_t requests_;
+    const SystemTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  const uint32_t max_entries_;
+  // The most recently used entries first.
+  EntryList entries_;
+  absl::flat_hash_map<std::string, EntryList::iterator> index_;
+};
+
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "envoy/stream_info/stream_info.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/empty_string.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
 #include "source/common/http/codes.h"
@@ -60,6 +61,9 @@ void Filter::initiateCall(const Http::RequestHeaderMap& headers) {
   populateRateLimitDescriptors(descriptors_, headers, false);
   ENVOY_LOG(debug, "rate limit descriptors size: {}", descriptors_.size());
   if (!descriptors_.empty()) {
+    if (completeWithCachedQuota()) {
+      return;
+    }
     state_ = State::Calling;
     initiating_call_ = true;
     client_->limit(*this, getDomain(), descriptors_, callbacks_->activeSpan(),
@@ -123,6 +127,52 @@ void Filter::populateRateLimitDescriptors(std::vector<Envoy::RateLimit::Descript
   }
 }
 
+bool Filter::completeWithCachedQuota() {
+  if (!config_->hasQuotaCache()) {
+    return false;
+  }
+  quota_cache_key_ = QuotaCache::key(getDomain(), descriptors_);
+  if (!quota_cache_key_.has_value()) {
+    return false;
+  }
+  const absl::optional<Filters::Common::RateLimit::LimitStatus> status =
+      config_->quotaCache().consume(quota_cache_key_.value(), quotaHits(),
+                                    callbacks_->dispatcher().timeSource().systemTime());
+  if (!status.has_value()) {
+    return false;
+  }
+  ENVOY_STREAM_LOG(trace, "rate limit filter using a cached quota.", *callbacks_);
+  quota_cache_key_.reset();
+  cluster_->statsScope().counterFromStatName(config_->statNames().quota_cache_hit_).inc();
+  state_ = State::Calling;
+  initiating_call_ = true;
+  complete(status.value(), nullptr, nullptr, nullptr, EMPTY_STRING, nullptr);
+  initiating_call_ = false;
+  return true;
+}
+
+uint32_t Filter::quotaHits() {
+  // The service counts a hit for the requests without a hits addend.
+  const uint32_t hits_addend = static_cast<uint32_t>(getHitAddend());
+  return hits_addend == 0 ? 1 : hits_addend;
+}
+
+void Filter::onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) {
+  if (!quota_cache_key_.has_value()) {
+    return;
+  }
+  // The quotas without an expiration are not cached, as they would limit the requests forever once
+  // they run out.
+  if (quota.requests() > 0 && quota.has_valid_until()) {
+    const uint32_t hits = quotaHits();
+    config_->quotaCache().insert(
+        quota_cache_key_.value(), quota.requests() > hits ? quota.requests() - hits : 0,
+        SystemTime(std::chrono::milliseconds(
+            Protobuf::util::TimeUtil::TimestampToMilliseconds(quota.valid_until()))));
+  }
+  quota_cache_key_.reset();
+}
+
 double Filter::getHitAddend() {
   const StreamInfo::UInt32Accessor* hits_addend_filter_state =
       callbacks_->streamInfo().filterState()->getDataReadOnly<StreamInfo::UInt32Accessor>(
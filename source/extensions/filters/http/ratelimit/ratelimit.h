@@ -12,15 +12,18 @@
 #include "envoy/ratelimit/ratelimit.h"
 #include "envoy/runtime/runtime.h"
 #include "envoy/stats/scope.h"
+#include "envoy/thread_local/thread_local.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/http/header_map_impl.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/header_parser.h"
 #include "source/common/runtime/runtime_protos.h"
 #include "source/extensions/filters/common/ratelimit/ratelimit.h"
 #include "source/extensions/filters/common/ratelimit/stat_names.h"
 #include "source/extensions/filters/common/ratelimit_config/ratelimit_config.h"
+#include "source/extensions/filters/http/ratelimit/quota_cache.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -86,6 +89,13 @@ public:
     response_headers_parser_ = std::move(response_headers_parser_or_.value());
     rate_limit_config_ = std::make_unique<Filters::Common::RateLimit::RateLimitConfig>(
         config.rate_limits(), context, creation_status);
+    if (config.has_quota_cache()) {
+      quota_cache_ = ThreadLocal::TypedSlot<QuotaCache>::makeUnique(context.threadLocal());
+      quota_cache_->set([max_entries = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                             config.quota_cache(), max_entries, 10000)](Event::Dispatcher&) {
+        return std::make_shared<QuotaCache>(max_entries);
+      });
+    }
   }
 
   const std::string& domain() const { return domain_; }
@@ -124,6 +134,8 @@ public:
     rate_limit_config_->populateDescriptors(headers, info, local_info_.clusterName(), descriptors,
                                             on_stream_done);
   }
+  bool hasQuotaCache() const { return quota_cache_ != nullptr; }
+  QuotaCache& quotaCache() { return **quota_cache_; }
 
 private:
   static FilterRequestType stringToType(const std::string& request_type) {
@@ -172,6 +184,7 @@ private:
   const absl::optional<Envoy::Runtime::FractionalPercent> filter_enforced_;
   const absl::optional<Envoy::Runtime::FractionalPercent> failure_mode_deny_percent_;
   std::unique_ptr<RateLimitConfig> rate_limit_config_;
+  ThreadLocal::TypedSlotPtr<QuotaCache> quota_cache_;
 };
 
 using FilterConfigSharedPtr = std::shared_ptr<FilterConfig>;
@@ -256,9 +269,14 @@ public:
                 Http::RequestHeaderMapPtr&& request_headers_to_add,
                 const std::string& response_body,
                 Filters::Common::RateLimit::DynamicMetadataPtr&& dynamic_metadata) override;
+  void onQuota(const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) override;
 
 private:
   void initiateCall(const Http::RequestHeaderMap& headers);
+  // Completes the call with the cached quota of the descriptors, if there is one.
+  bool completeWithCachedQuota();
+  // The hits added by the request to the quota of its descriptors.
+  uint32_t quotaHits();
   void populateRateLimitDescriptors(std::vector<Envoy::RateLimit::Descriptor>& descriptors,
                                     const Http::RequestHeaderMap& headers, bool on_stream_done);
   void populateRateLimitDescriptorsForPolicy(const Router::RateLimitPolicy& rate_limit_policy,
@@ -287,6 +305,8 @@ private:
   Http::ResponseHeaderMapPtr response_headers_to_add_;
   Http::RequestHeaderMap* request_headers_{};
   std::vector<Envoy::RateLimit::Descriptor> descriptors_;
+  // The key of the quota of the descriptors, while calling the service for them.
+  absl::optional<std::string> quota_cache_key_;
 };
 
 /**
@@ -99,7 +99,7 @@ void Filter::processBuffer(bool end_stream) {
   absl::string_view buffer_view(static_cast<const char*>(buffer_.linearize(length)), length);
 
   while (!buffer_view.empty() && !processing_complete_) {
-    auto result = Http::Sse::SseParser::findEventEnd(buffer_view, end_stream);
+    auto result = event_finder_.findEventEnd(buffer_view, end_stream);
 
     if (result.event_start == absl::string_view::npos) {
       // No complete event found. Check if buffer exceeds max size.
@@ -111,6 +111,7 @@ void Filter::processBuffer(bool end_stream) {
             max_size, buffer_view.size());
         config_->stats().event_too_large_.inc();
         buffer_.drain(buffer_.length());
+        event_finder_.reset();
         return;
       }
       break;
@@ -14,6 +14,7 @@
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/sse/sse_parser.h"
 #include "source/extensions/filters/http/common/pass_through_filter.h"
 
 #include "absl/strings/string_view.h"
@@ -112,6 +113,8 @@ private:
   // Set to true when all rules have reached their match limits. Stops further processing.
   bool processing_complete_{false};
   Buffer::OwnedImpl buffer_;
+  // Scans the incomplete event at the start of buffer_ only once across the chunks.
+  Http::Sse::SseParser::EventFinder event_finder_;
 };
 
 } // namespace SseToMetadata
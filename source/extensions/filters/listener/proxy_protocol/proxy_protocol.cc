@@ -307,7 +307,7 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
           Network::ProxyProtocolFilterState::key(),
           std::make_unique<Network::ProxyProtocolFilterState>(Network::ProxyProtocolDataWithVersion{
               {socket.connectionInfoProvider().remoteAddress(),
-               socket.connectionInfoProvider().localAddress(), parsed_tlvs_},
+               socket.connectionInfoProvider().localAddress(), std::move(parsed_tlvs_)},
               absl::make_optional(header_version_)}),
           StreamInfo::FilterState::StateType::Mutable,
           StreamInfo::FilterState::LifeSpan::Connection);
@@ -325,7 +325,7 @@ ReadOrParseState Filter::parseBuffer(Network::ListenerFilterBuffer& buffer) {
           Network::ProxyProtocolFilterState::key(),
           std::make_unique<Network::ProxyProtocolFilterState>(Network::ProxyProtocolDataWithVersion{
               {proxy_protocol_header_.value().remote_address_,
-               proxy_protocol_header_.value().local_address_, parsed_tlvs_},
+               proxy_protocol_header_.value().local_address_, std::move(parsed_tlvs_)},
               absl::make_optional(header_version_)}),
           StreamInfo::FilterState::StateType::Mutable,
           StreamInfo::FilterState::LifeSpan::Connection);
@@ -573,6 +573,11 @@ bool Filter::parseV1Header(const char* buf, size_t len) {
  *        See https://www.haproxy.org/download/2.1/doc/proxy-protocol.txt for details
  */
 bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
+  // The TLVs of the rules, as views into the peeked buffer. They are only stored once all the TLVs
+  // are parsed, to update the metadata or the filter state once per connection instead of once per
+  // TLV.
+  TlvValues rule_tlvs;
+  const bool has_rules = config_->numberOfNeededTlvTypes() > 0;
   size_t idx{0};
   while (idx < len) {
     const uint8_t tlv_type = buf[idx];
@@ -604,64 +609,9 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
 
     // Only save to dynamic metadata if this type of TLV is needed.
     absl::string_view tlv_value(reinterpret_cast<char const*>(buf + idx), tlv_value_length);
-    auto key_value_pair = config_->isTlvTypeNeeded(tlv_type);
+    const KeyValuePair* key_value_pair = has_rules ? config_->isTlvTypeNeeded(tlv_type) : nullptr;
     if (nullptr != key_value_pair) {
-      // Sanitize any non utf8 characters.
-      auto sanitised_tlv_value = MessageUtil::sanitizeUtf8String(tlv_value);
-      std::string sanitised_value(sanitised_tlv_value.data(), sanitised_tlv_value.size());
-
-      if (config_->tlvLocation() ==
-          envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol::FILTER_STATE) {
-        // Store TLV values in a single filter state object.
-        constexpr absl::string_view kFilterStateKey = "envoy.network.proxy_protocol.tlv";
-        TlvFilterStateObject* tlv_filter_state_obj = nullptr;
-        const auto* existing_obj = cb_->filterState().getDataReadOnlyGeneric(kFilterStateKey);
-        if (existing_obj != nullptr) {
-          tlv_filter_state_obj = const_cast<TlvFilterStateObject*>(
-              dynamic_cast<const TlvFilterStateObject*>(existing_obj));
-        }
-        if (tlv_filter_state_obj == nullptr) {
-          auto new_obj = std::make_unique<TlvFilterStateObject>();
-          tlv_filter_state_obj = new_obj.get();
-          cb_->filterState().setData(kFilterStateKey, std::move(new_obj),
-                                     StreamInfo::FilterState::StateType::ReadOnly,
-                                     StreamInfo::FilterState::LifeSpan::Connection);
-          ENVOY_LOG(trace, "proxy_protocol: Created TLV FilterState object");
-        }
-        tlv_filter_state_obj->addTlvValue(key_value_pair->key(), sanitised_value);
-        ENVOY_LOG(trace, "proxy_protocol: Stored TLV type {} value in FilterState with key {}",
-                  tlv_type, key_value_pair->key());
-      } else {
-        // Store in dynamic metadata (default, backwards compatible behavior).
-        std::string metadata_key = key_value_pair->metadata_namespace().empty()
-                                       ? "envoy.filters.listener.proxy_protocol"
-                                       : key_value_pair->metadata_namespace();
-        auto& typed_filter_metadata = (*cb_->dynamicMetadata().mutable_typed_filter_metadata());
-
-        const auto typed_proxy_filter_metadata = typed_filter_metadata.find(metadata_key);
-        envoy::data::core::v3::TlvsMetadata tlvs_metadata;
-        auto status = absl::OkStatus();
-        if (typed_proxy_filter_metadata != typed_filter_metadata.end()) {
-          status = MessageUtil::unpackTo(typed_proxy_filter_metadata->second, tlvs_metadata);
-        }
-        if (!status.ok()) {
-          ENVOY_LOG_PERIODIC(warn, std::chrono::seconds(1),
-                             "proxy_protocol: Failed to unpack typed metadata for TLV type ",
-                             tlv_type);
-        } else {
-          (*tlvs_metadata.mutable_typed_metadata())[key_value_pair->key()] = tlv_value;
-          Protobuf::Any typed_metadata;
-          typed_metadata.PackFrom(tlvs_metadata);
-          cb_->setDynamicTypedMetadata(metadata_key, typed_metadata);
-        }
-        // Always populate untyped metadata for backwards compatibility.
-        Protobuf::Value metadata_value;
-        metadata_value.set_string_value(sanitised_value.data(), sanitised_value.size());
-        Protobuf::Struct metadata(
-            (*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key]);
-        metadata.mutable_fields()->insert({key_value_pair->key(), metadata_value});
-        cb_->setDynamicMetadata(metadata_key, metadata);
-      }
+      rule_tlvs.push_back({tlv_type, key_value_pair, tlv_value});
     } else {
       ENVOY_LOG(trace,
                 "proxy_protocol: Skip TLV of type {} since it's not needed for dynamic metadata",
@@ -677,9 +627,97 @@ bool Filter::parseTlvs(const uint8_t* buf, size_t len) {
     idx += tlv_value_length;
     ASSERT(idx <= len);
   }
+
+  if (!rule_tlvs.empty()) {
+    if (config_->tlvLocation() ==
+        envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol::FILTER_STATE) {
+      storeTlvsInFilterState(rule_tlvs);
+    } else {
+      storeTlvsInDynamicMetadata(rule_tlvs);
+    }
+  }
   return true;
 }
 
+void Filter::storeTlvsInFilterState(const TlvValues& tlvs) {
+  // Store TLV values in a single filter state object.
+  constexpr absl::string_view kFilterStateKey = "envoy.network.proxy_protocol.tlv";
+  TlvFilterStateObject* tlv_filter_state_obj = nullptr;
+  const auto* existing_obj = cb_->filterState().getDataReadOnlyGeneric(kFilterStateKey);
+  if (existing_obj != nullptr) {
+    tlv_filter_state_obj =
+        const_cast<TlvFilterStateObject*>(dynamic_cast<const TlvFilterStateObject*>(existing_obj));
+  }
+  if (tlv_filter_state_obj == nullptr) {
+    auto new_obj = std::make_unique<TlvFilterStateObject>();
+    tlv_filter_state_obj = new_obj.get();
+    cb_->filterState().setData(kFilterStateKey, std::move(new_obj),
+                               StreamInfo::FilterState::StateType::ReadOnly,
+                               StreamInfo::FilterState::LifeSpan::Connection);
+    ENVOY_LOG(trace, "proxy_protocol: Created TLV FilterState object");
+  }
+  for (const TlvValue& tlv : tlvs) {
+    // Sanitize any non utf8 characters.
+    tlv_filter_state_obj->addTlvValue(tlv.key_value_pair_->key(),
+                                      MessageUtil::sanitizeUtf8String(tlv.value_));
+    ENVOY_LOG(trace, "proxy_protocol: Stored TLV type {} value in FilterState with key {}",
+              tlv.type_, tlv.key_value_pair_->key());
+  }
+}
+
+void Filter::storeTlvsInDynamicMetadata(const TlvValues& tlvs) {
+  const auto metadata_key_of = [](const TlvValue& tlv) -> const std::string& {
+    static const std::string DefaultMetadataKey = "envoy.filters.listener.proxy_protocol";
+    return tlv.key_value_pair_->metadata_namespace().empty()
+               ? DefaultMetadataKey
+               : tlv.key_value_pair_->metadata_namespace();
+  };
+  // The metadata of each namespace is updated once, with the TLVs in their order in the header,
+  // e.g. the first of the duplicate TLVs being kept in the untyped metadata.
+  for (auto tlv = tlvs.begin(); tlv != tlvs.end(); ++tlv) {
+    const std::string& metadata_key = metadata_key_of(*tlv);
+    if (std::any_of(tlvs.begin(), tlv, [&](const TlvValue& previous) {
+          return metadata_key_of(previous) == metadata_key;
+        })) {
+      continue;
+    }
+
+    auto& typed_filter_metadata = (*cb_->dynamicMetadata().mutable_typed_filter_metadata());
+    const auto typed_proxy_filter_metadata = typed_filter_metadata.find(metadata_key);
+    envoy::data::core::v3::TlvsMetadata tlvs_metadata;
+    auto status = absl::OkStatus();
+    if (typed_proxy_filter_metadata != typed_filter_metadata.end()) {
+      status = MessageUtil::unpackTo(typed_proxy_filter_metadata->second, tlvs_metadata);
+    }
+    if (!status.ok()) {
+      ENVOY_LOG_PERIODIC(warn, std::chrono::seconds(1),
+                         "proxy_protocol: Failed to unpack typed metadata for TLV type ",
+                         tlv->type_);
+    }
+    // Always populate untyped metadata for backwards compatibility.
+    Protobuf::Struct metadata((*cb_->dynamicMetadata().mutable_filter_metadata())[metadata_key]);
+    for (auto namespace_tlv = tlv; namespace_tlv != tlvs.end(); ++namespace_tlv) {
+      if (metadata_key_of(*namespace_tlv) != metadata_key) {
+        continue;
+      }
+      const std::string& key = namespace_tlv->key_value_pair_->key();
+      if (status.ok()) {
+        (*tlvs_metadata.mutable_typed_metadata())[key] = namespace_tlv->value_;
+      }
+      // Sanitize any non utf8 characters.
+      Protobuf::Value metadata_value;
+      metadata_value.set_string_value(MessageUtil::sanitizeUtf8String(namespace_tlv->value_));
+      metadata.mutable_fields()->insert({key, metadata_value});
+    }
+    if (status.ok()) {
+      Protobuf::Any typed_metadata;
+      typed_metadata.PackFrom(tlvs_metadata);
+      cb_->setDynamicTypedMetadata(metadata_key, typed_metadata);
+    }
+    cb_->setDynamicMetadata(metadata_key, metadata);
+  }
+}
+
 ReadOrParseState Filter::readExtensions(Network::ListenerFilterBuffer& buffer) {
   auto raw_slice = buffer.rawSlice();
   // waiting for more data if there is no enough data for extensions.
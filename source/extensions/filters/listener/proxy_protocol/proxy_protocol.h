@@ -12,6 +12,7 @@
 #include "source/extensions/filters/listener//proxy_protocol/proxy_protocol_header.h"
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 
 using Envoy::Extensions::Common::ProxyProtocol::PROXY_PROTO_V2_ADDR_LEN_UNIX;
 using Envoy::Extensions::Common::ProxyProtocol::PROXY_PROTO_V2_HEADER_LEN;
@@ -194,7 +195,17 @@ private:
    */
   ReadOrParseState readProxyHeader(Network::ListenerFilterBuffer& buffer);
 
+  // A TLV of a rule, viewing into the peeked buffer.
+  struct TlvValue {
+    uint8_t type_;
+    const KeyValuePair* key_value_pair_;
+    absl::string_view value_;
+  };
+  using TlvValues = absl::InlinedVector<TlvValue, 4>;
+
   bool parseTlvs(const uint8_t* buf, size_t len);
+  void storeTlvsInFilterState(const TlvValues& tlvs);
+  void storeTlvsInDynamicMetadata(const TlvValues& tlvs);
   ReadOrParseState readExtensions(Network::ListenerFilterBuffer& buffer);
 
   /**
@@ -0,0 +1,129 @@
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+
+#include <algorithm>
+
+#include "absl/container/inlined_vector.h"
+#include "openssl/bytestring.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+constexpr size_t RecordHeaderSize = 5;
+constexpr size_t HandshakeHeaderSize = 4;
+
+} // namespace
+
+ClientHelloParser::Result ClientHelloParser::parse(absl::Span<const uint8_t> data) {
+  // Checks the headers as soon as they are received, to leave anything else to BoringSSL early.
+  if ((data.size() > 0 && data[0] != SSL3_RT_HANDSHAKE) ||
+      (data.size() > 1 && data[1] != SSL3_VERSION_MAJOR)) {
+    return Result::Unsupported;
+  }
+  if (data.size() < RecordHeaderSize) {
+    return Result::NeedMoreData;
+  }
+  const size_t record_length = (static_cast<size_t>(data[3]) << 8) | data[4];
+  if (record_length > SSL3_RT_MAX_PLAIN_LENGTH ||
+      (data.size() > RecordHeaderSize && data[RecordHeaderSize] != SSL3_MT_CLIENT_HELLO)) {
+    return Result::Unsupported;
+  }
+  if (data.size() >= RecordHeaderSize + HandshakeHeaderSize) {
+    const size_t message_length = (static_cast<size_t>(data[6]) << 16) |
+                                  (static_cast<size_t>(data[7]) << 8) | data[8];
+    // The ClientHellos spanning several records, or sharing theirs, are left to BoringSSL.
+    if (HandshakeHeaderSize + message_length != record_length) {
+      return Result::Unsupported;
+    }
+  }
+  if (data.size() < RecordHeaderSize + record_length) {
+    return Result::NeedMoreData;
+  }
+
+  // The same checks as BoringSSL's ssl_client_hello_init().
+  CBS body, random, session_id, cipher_suites, compression_methods, extensions;
+  CBS_init(&body, data.data() + RecordHeaderSize + HandshakeHeaderSize,
+           record_length - HandshakeHeaderSize);
+  client_hello_ = {};
+  if (!CBS_get_u16(&body, &client_hello_.version) ||
+      !CBS_get_bytes(&body, &random, SSL3_RANDOM_SIZE) ||
+      !CBS_get_u8_length_prefixed(&body, &session_id) ||
+      CBS_len(&session_id) > SSL_MAX_SSL_SESSION_ID_LENGTH ||
+      !CBS_get_u16_length_prefixed(&body, &cipher_suites) || CBS_len(&cipher_suites) < 2 ||
+      CBS_len(&cipher_suites) % 2 != 0 ||
+      !CBS_get_u8_length_prefixed(&body, &compression_methods) ||
+      CBS_len(&compression_methods) < 1) {
+    return Result::Unsupported;
+  }
+  CBS_init(&extensions, nullptr, 0);
+  if (CBS_len(&body) != 0 &&
+      (!CBS_get_u16_length_prefixed(&body, &extensions) || CBS_len(&body) != 0)) {
+    return Result::Unsupported;
+  }
+  client_hello_.random = CBS_data(&random);
+  client_hello_.random_len = CBS_len(&random);
+  client_hello_.session_id = CBS_data(&session_id);
+  client_hello_.session_id_len = CBS_len(&session_id);
+  client_hello_.cipher_suites = CBS_data(&cipher_suites);
+  client_hello_.cipher_suites_len = CBS_len(&cipher_suites);
+  client_hello_.compression_methods = CBS_data(&compression_methods);
+  client_hello_.compression_methods_len = CBS_len(&compression_methods);
+  client_hello_.extensions = CBS_data(&extensions);
+  client_hello_.extensions_len = CBS_len(&extensions);
+  if (!parseExtensions() || !parseServerName()) {
+    return Result::Unsupported;
+  }
+
+  bytes_processed_ = RecordHeaderSize + record_length;
+  return Result::Parsed;
+}
+
+bool ClientHelloParser::parseExtensions() {
+  CBS extensions;
+  CBS_init(&extensions, client_hello_.extensions, client_hello_.extensions_len);
+  absl::InlinedVector<uint16_t, 32> types;
+  while (CBS_len(&extensions) > 0) {
+    uint16_t type;
+    CBS extension;
+    if (!CBS_get_u16(&extensions, &type) || !CBS_get_u16_length_prefixed(&extensions, &extension)) {
+      return false;
+    }
+    types.push_back(type);
+  }
+  // BoringSSL rejects the duplicate extensions.
+  std::sort(types.begin(), types.end());
+  return std::adjacent_find(types.begin(), types.end()) == types.end();
+}
+
+bool ClientHelloParser::parseServerName() {
+  server_name_ = {};
+  const uint8_t* data;
+  size_t len;
+  if (!SSL_early_callback_ctx_extension_get(&client_hello_, TLSEXT_TYPE_server_name, &data,
+                                            &len)) {
+    return true;
+  }
+
+  // The same checks as BoringSSL's extract_sni().
+  CBS extension, server_name_list, host_name;
+  uint8_t name_type;
+  CBS_init(&extension, data, len);
+  if (!CBS_get_u16_length_prefixed(&extension, &server_name_list) ||
+      !CBS_get_u8(&server_name_list, &name_type) ||
+      !CBS_get_u16_length_prefixed(&server_name_list, &host_name) ||
+      CBS_len(&server_name_list) != 0 || CBS_len(&extension) != 0 ||
+      name_type != TLSEXT_NAMETYPE_host_name || CBS_len(&host_name) == 0 ||
+      CBS_len(&host_name) > TLSEXT_MAXLEN_host_name || CBS_contains_zero_byte(&host_name)) {
+    return false;
+  }
+  server_name_ =
+      absl::string_view(reinterpret_cast<const char*>(CBS_data(&host_name)), CBS_len(&host_name));
+  return true;
+}
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
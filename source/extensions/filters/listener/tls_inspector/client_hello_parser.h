@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+
+/**
+ * Parses a TLS ClientHello from the bytes peeked from a connection without a BoringSSL SSL object,
+ * so without allocating one per connection. Only the ClientHellos sent in a single record, which
+ * BoringSSL would accept up to its certificate selection callback, are parsed: everything else,
+ * e.g. plaintext or a malformed ClientHello, is left to BoringSSL so that the outcome and the
+ * errors reported remain those of BoringSSL.
+ */
+class ClientHelloParser {
+public:
+  enum class Result {
+    // The ClientHello was parsed.
+    Parsed,
+    // The bytes are the beginning of a ClientHello record, more are needed.
+    NeedMoreData,
+    // The bytes must be parsed by BoringSSL.
+    Unsupported,
+  };
+
+  /**
+   * @param data all the bytes peeked from the connection so far.
+   * @return the result of the parse. Once parsed, the accessors below refer to data.
+   */
+  Result parse(absl::Span<const uint8_t> data);
+
+  /**
+   * @return the ClientHello, as passed to the BoringSSL callbacks, without an SSL object.
+   */
+  const SSL_CLIENT_HELLO& clientHello() const { return client_hello_; }
+
+  /**
+   * @return the host name of the server name extension, or empty if there is none.
+   */
+  absl::string_view serverName() const { return server_name_; }
+
+  /**
+   * @return the size of the record of the ClientHello, including its header.
+   */
+  size_t bytesProcessed() const { return bytes_processed_; }
+
+private:
+  bool parseExtensions();
+  bool parseServerName();
+
+  SSL_CLIENT_HELLO client_hello_{};
+  absl::string_view server_name_;
+  size_t bytes_processed_{};
+};
+
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -58,6 +58,8 @@ Config::Config(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, enable_ja3_fingerprinting, false)),
       enable_ja4_fingerprinting_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, enable_ja4_fingerprinting, false)),
+      enable_lightweight_client_hello_parser_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          proto_config, enable_lightweight_client_hello_parser, false)),
       close_connection_on_client_hello_parsing_errors_(
           proto_config.close_connection_on_client_hello_parsing_errors()),
       max_client_hello_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_client_hello_size,
@@ -78,18 +80,8 @@ Config::Config(
   SSL_CTX_set_select_certificate_cb(
       ssl_ctx_.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
         Filter* filter = static_cast<Filter*>(SSL_get_app_data(client_hello->ssl));
-        filter->createJA3Hash(client_hello);
-        filter->createJA4Hash(client_hello);
-
-        const uint8_t* data;
-        size_t len;
-        if (SSL_early_callback_ctx_extension_get(
-                client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
-          filter->onALPN(data, len);
-        }
-
         const char* servername = SSL_get_servername(client_hello->ssl, TLSEXT_NAMETYPE_host_name);
-        filter->onServername(absl::NullSafeStringView(servername));
+        filter->onClientHello(client_hello, absl::NullSafeStringView(servername));
         return ssl_select_cert_error;
       });
 }
@@ -97,8 +89,14 @@ Config::Config(
 bssl::UniquePtr<SSL> Config::newSsl() { return bssl::UniquePtr<SSL>{SSL_new(ssl_ctx_.get())}; }
 
 Filter::Filter(const ConfigSharedPtr& config)
-    : config_(config), ssl_(config_->newSsl()),
-      requested_read_bytes_(config->initialReadBufferSize()) {
+    : config_(config), requested_read_bytes_(config->initialReadBufferSize()) {
+  if (!config_->enableLightweightClientHelloParser()) {
+    initSsl();
+  }
+}
+
+void Filter::initSsl() {
+  ssl_ = config_->newSsl();
   SSL_set_app_data(ssl_.get(), this);
   SSL_set_accept_state(ssl_.get());
 }
@@ -110,6 +108,20 @@ Network::FilterStatus Filter::onAccept(Network::ListenerFilterCallbacks& cb) {
   return Network::FilterStatus::StopIteration;
 }
 
+void Filter::onClientHello(const SSL_CLIENT_HELLO* client_hello, absl::string_view servername) {
+  createJA3Hash(client_hello);
+  createJA4Hash(client_hello);
+
+  const uint8_t* data;
+  size_t len;
+  if (SSL_early_callback_ctx_extension_get(
+          client_hello, TLSEXT_TYPE_application_layer_protocol_negotiation, &data, &len)) {
+    onALPN(data, len);
+  }
+
+  onServername(servername);
+}
+
 void Filter::onALPN(const unsigned char* data, unsigned int len) {
   CBS wire, list;
   CBS_init(&wire, reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(len));
@@ -149,11 +161,16 @@ Network::FilterStatus Filter::onData(Network::ListenerFilterBuffer& buffer) {
   // Because we're doing a MSG_PEEK, data we've seen before gets returned every time, so
   // skip over what we've already processed.
   if (static_cast<uint64_t>(raw_slice.len_) > read_) {
-    const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
-    const size_t len = raw_slice.len_ - read_;
-    const uint64_t bytes_already_processed = read_;
-    read_ = raw_slice.len_;
-    ParseState parse_state = parseClientHello(data, len, bytes_already_processed);
+    ParseState parse_state;
+    if (ssl_ == nullptr) {
+      parse_state = parseClientHelloWithoutSsl(raw_slice);
+    } else {
+      const uint8_t* data = static_cast<const uint8_t*>(raw_slice.mem_) + read_;
+      const size_t len = raw_slice.len_ - read_;
+      const uint64_t bytes_already_processed = read_;
+      read_ = raw_slice.len_;
+      parse_state = parseClientHello(data, len, bytes_already_processed);
+    }
     switch (parse_state) {
     case ParseState::Error:
       cb_->socket().ioHandle().close();
@@ -187,21 +204,35 @@ void Filter::setDownstreamTransportFailureReason() {
   cb_->streamInfo().setDownstreamTransportFailureReason(transport_failure);
 }
 
+ParseState Filter::onNeedMoreData() {
+  if (read_ >= maxConfigReadBytes()) {
+    // We've hit the specified size limit. This is an unreasonably large ClientHello;
+    // indicate failure.
+    config_->stats().client_hello_too_large_.inc();
+    setDynamicMetadata(failureReasonClientHelloTooLarge());
+    return ParseState::Error;
+  }
+  if (read_ >= requested_read_bytes_) {
+    // Double requested bytes up to the maximum configured.
+    requested_read_bytes_ = std::min<uint32_t>(2 * read_, maxConfigReadBytes());
+  }
+  return ParseState::Continue;
+}
+
+void Filter::onTlsFound() {
+  config_->stats().tls_found_.inc();
+  if (alpn_found_) {
+    config_->stats().alpn_found_.inc();
+  } else {
+    config_->stats().alpn_not_found_.inc();
+  }
+  cb_->socket().setDetectedTransportProtocol("tls");
+}
+
 ParseState Filter::getParserState(int handshake_status) {
   switch (SSL_get_error(ssl_.get(), handshake_status)) {
   case SSL_ERROR_WANT_READ:
-    if (read_ >= maxConfigReadBytes()) {
-      // We've hit the specified size limit. This is an unreasonably large ClientHello;
-      // indicate failure.
-      config_->stats().client_hello_too_large_.inc();
-      setDynamicMetadata(failureReasonClientHelloTooLarge());
-      return ParseState::Error;
-    }
-    if (read_ >= requested_read_bytes_) {
-      // Double requested bytes up to the maximum configured.
-      requested_read_bytes_ = std::min<uint32_t>(2 * read_, maxConfigReadBytes());
-    }
-    return ParseState::Continue;
+    return onNeedMoreData();
   case SSL_ERROR_SSL:
     // There are 3 possibilities when get here:
     // 1. A valid TLS Client Hello message was parsed (`clienthello_success_` is true)
@@ -212,13 +243,7 @@ ParseState Filter::getParserState(int handshake_status) {
     // In the future it may be possible to add some error checking to make this detection more
     // optimal.
     if (clienthello_success_) {
-      config_->stats().tls_found_.inc();
-      if (alpn_found_) {
-        config_->stats().alpn_found_.inc();
-      } else {
-        config_->stats().alpn_not_found_.inc();
-      }
-      cb_->socket().setDetectedTransportProtocol("tls");
+      onTlsFound();
     } else {
       // Checking max message length should not be done here as it will close all plain text
       // connections that happened to read more than maxConfigReadBytes() in one I/O operation. With
@@ -273,6 +298,26 @@ ParseState Filter::parseClientHello(const void* data, size_t len,
   return state;
 }
 
+ParseState Filter::parseClientHelloWithoutSsl(const Buffer::ConstRawSlice& raw_slice) {
+  const absl::Span<const uint8_t> data(static_cast<const uint8_t*>(raw_slice.mem_), raw_slice.len_);
+  read_ = raw_slice.len_;
+  ClientHelloParser parser;
+  switch (parser.parse(data)) {
+  case ClientHelloParser::Result::Parsed:
+    onClientHello(&parser.clientHello(), parser.serverName());
+    onTlsFound();
+    config_->stats().bytes_processed_.recordValue(parser.bytesProcessed());
+    return ParseState::Done;
+  case ClientHelloParser::Result::NeedMoreData:
+    return onNeedMoreData();
+  case ClientHelloParser::Result::Unsupported:
+    // BoringSSL has not seen any of the data yet.
+    initSsl();
+    return parseClientHello(data.data(), data.size(), 0);
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
 void writeCipherSuites(const SSL_CLIENT_HELLO* ssl_client_hello, std::string& fingerprint) {
   CBS cipher_suites;
   CBS_init(&cipher_suites, ssl_client_hello->cipher_suites, ssl_client_hello->cipher_suites_len);
@@ -9,6 +9,7 @@
 #include "envoy/stats/stats_macros.h"
 
 #include "source/common/common/logger.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
 #include "source/extensions/filters/listener/tls_inspector/ja4_fingerprint.h"
 
 #include "openssl/ssl.h"
@@ -60,6 +61,9 @@ public:
   bssl::UniquePtr<SSL> newSsl();
   bool enableJA3Fingerprinting() const { return enable_ja3_fingerprinting_; }
   bool enableJA4Fingerprinting() const { return enable_ja4_fingerprinting_; }
+  bool enableLightweightClientHelloParser() const {
+    return enable_lightweight_client_hello_parser_;
+  }
   uint32_t maxClientHelloSize() const { return max_client_hello_size_; }
   uint32_t initialReadBufferSize() const { return initial_read_buffer_size_; }
   bool closeConnectionOnTlsHelloParsingErrors() const {
@@ -78,6 +82,7 @@ private:
   bssl::UniquePtr<SSL_CTX> ssl_ctx_;
   const bool enable_ja3_fingerprinting_;
   const bool enable_ja4_fingerprinting_;
+  const bool enable_lightweight_client_hello_parser_;
   const bool close_connection_on_client_hello_parsing_errors_;
   const uint32_t max_client_hello_size_;
   const uint32_t initial_read_buffer_size_;
@@ -103,8 +108,13 @@ public:
   static const std::string& failureReasonClientHelloNotDetected();
 
 private:
+  void initSsl();
   ParseState parseClientHello(const void* data, size_t len, uint64_t bytes_already_processed);
+  ParseState parseClientHelloWithoutSsl(const Buffer::ConstRawSlice& raw_slice);
   ParseState onRead();
+  void onClientHello(const SSL_CLIENT_HELLO* client_hello, absl::string_view servername);
+  ParseState onNeedMoreData();
+  void onTlsFound();
   void onALPN(const unsigned char* data, unsigned int len);
   void onServername(absl::string_view name);
   void createJA3Hash(const SSL_CLIENT_HELLO* ssl_client_hello);
@@ -117,6 +127,7 @@ private:
   ConfigSharedPtr config_;
   Network::ListenerFilterCallbacks* cb_{};
 
+  // Only created once the ClientHello is left to BoringSSL with the lightweight parser.
   bssl::UniquePtr<SSL> ssl_;
   uint64_t read_{0};
   bool alpn_found_{false};
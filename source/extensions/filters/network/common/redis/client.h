@@ -69,6 +69,21 @@ public:
   void onRedirection(Common::Redis::RespValuePtr&&, const std::string&, bool) override {}
 };
 
+/**
+ * Callbacks of the RESP3 pushes of a client connection, such as the invalidations of client
+ * tracking.
+ */
+class PushCallbacks {
+public:
+  virtual ~PushCallbacks() = default;
+
+  /**
+   * Called when a push is received.
+   * @param value supplies the push, as an array, which is now owned by the callee.
+   */
+  virtual void onPush(RespValuePtr&& value) PURE;
+};
+
 /**
  * A single redis client connection.
  */
@@ -107,6 +122,15 @@ public:
    */
   virtual void initialize(const std::string& auth_username, const std::string& auth_password) PURE;
 
+  /**
+   * Switches the connection to RESP3 and turns client tracking on, so that the server pushes the
+   * invalidations of the keys read on the connection from then on.
+   * @param push_callbacks supplies the callbacks of the pushes.
+   * @param callbacks supplies the callbacks of the CLIENT TRACKING response, tracking being on
+   *        once it succeeded.
+   */
+  virtual void enableTracking(PushCallbacks& push_callbacks, ClientCallbacks& callbacks) PURE;
+
   virtual void sendAwsIamAuth(
       const std::string& auth_username,
       const envoy::extensions::filters::network::redis_proxy::v3::AwsIam& aws_iam_config) PURE;
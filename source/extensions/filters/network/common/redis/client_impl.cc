@@ -2,6 +2,7 @@
 
 #include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
 
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/network/common/redis/aws_iam_authenticator_impl.h"
 
 #include "client.h"
@@ -139,6 +140,14 @@ ClientImpl::ClientImpl(
   traffic_stats.upstream_cx_active_.inc();
   host->stats().cx_active_.inc();
   connect_or_op_timer_->enableTimer(host->cluster().connectTimeout());
+
+  // Without a max buffer size, each command was written on its own. The commands of the downstream
+  // clients sent to this connection in the same event loop iteration are written together instead.
+  if (config_->maxBufferSizeBeforeFlush() == 0 &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.redis_coalesce_upstream_writes")) {
+    coalesced_flush_cb_ =
+        dispatcher.createSchedulableCallback([this]() { flushBufferAndResetTimer(); });
+  }
 }
 
 ClientImpl::~ClientImpl() {
@@ -154,6 +163,9 @@ void ClientImpl::flushBufferAndResetTimer() {
   if (flush_timer_->enabled()) {
     flush_timer_->disableTimer();
   }
+  if (coalesced_flush_cb_ != nullptr) {
+    coalesced_flush_cb_->cancel();
+  }
   connection_->write(encoder_buffer_, false);
 }
 
@@ -178,8 +190,13 @@ PoolRequest* ClientImpl::makeRequest(const RespValue& request, ClientCallbacks&
   // If we have enabled queuing (to pause AUTH while credentials are being used), don't flush our
   // buffers
   if (!queue_enabled_) {
-    // If buffer is full, flush. If the buffer was empty before the request, start the timer.
-    if (encoder_buffer_.length() >= config_->maxBufferSizeBeforeFlush()) {
+    // If the writes are coalesced, flush at the end of the event loop iteration. Otherwise if the
+    // buffer is full, flush, and if the buffer was empty before the request, start the timer.
+    if (coalesced_flush_cb_ != nullptr) {
+      if (!coalesced_flush_cb_->enabled()) {
+        coalesced_flush_cb_->scheduleCallbackCurrentIteration();
+      }
+    } else if (encoder_buffer_.length() >= config_->maxBufferSizeBeforeFlush()) {
       flushBufferAndResetTimer();
     } else if (empty_buffer) {
       flush_timer_->enableTimer(std::chrono::milliseconds(config_->bufferFlushTimeoutInMs()));
@@ -275,6 +292,9 @@ void ClientImpl::onEvent(Network::ConnectionEvent event) {
     }
 
     connect_or_op_timer_->disableTimer();
+    if (coalesced_flush_cb_ != nullptr) {
+      coalesced_flush_cb_->cancel();
+    }
   } else if (event == Network::ConnectionEvent::Connected) {
     connected_ = true;
     ASSERT(!pending_requests_.empty());
@@ -287,6 +307,12 @@ void ClientImpl::onEvent(Network::ConnectionEvent event) {
   }
 }
 
+void ClientImpl::onPushValue(RespValuePtr&& value) {
+  if (push_callbacks_ != nullptr) {
+    push_callbacks_->onPush(std::move(value));
+  }
+}
+
 void ClientImpl::onRespValue(RespValuePtr&& value) {
   ASSERT(!pending_requests_.empty());
   PendingRequest& request = pending_requests_.front();
@@ -383,6 +409,14 @@ void ClientImpl::initialize(const std::string& auth_username, const std::string&
   }
 }
 
+void ClientImpl::enableTracking(PushCallbacks& push_callbacks, ClientCallbacks& callbacks) {
+  push_callbacks_ = &push_callbacks;
+  // The responses of the requests sent before are RESP2 values, which RESP3 decodes the same.
+  decoder_->enableResp3();
+  makeRequest(Utility::HelloRequest::instance(), null_pool_callbacks);
+  makeRequest(Utility::ClientTrackingRequest::instance(), callbacks);
+}
+
 ClientFactoryImpl ClientFactoryImpl::instance_;
 
 ClientPtr ClientFactoryImpl::create(
@@ -104,6 +104,7 @@ public:
   bool active() override { return !pending_requests_.empty(); }
   void flushBufferAndResetTimer();
   void initialize(const std::string& auth_username, const std::string& auth_password) override;
+  void enableTracking(PushCallbacks& push_callbacks, ClientCallbacks& callbacks) override;
   void sendAwsIamAuth(
       const std::string& auth_username,
       const envoy::extensions::filters::network::redis_proxy::v3::AwsIam& aws_iam_config) override;
@@ -155,6 +156,7 @@ private:
 
   // DecoderCallbacks
   void onRespValue(RespValuePtr&& value) override;
+  void onPushValue(RespValuePtr&& value) override;
 
   // Network::ConnectionCallbacks
   void onEvent(Network::ConnectionEvent event) override;
@@ -171,11 +173,15 @@ private:
   Event::TimerPtr connect_or_op_timer_;
   bool connected_{};
   Event::TimerPtr flush_timer_;
+  // Flushes the commands of an event loop iteration at its end, when the buffer is not flushed on a
+  // size or a timeout. nullptr if the commands are flushed one at a time.
+  Event::SchedulableCallbackPtr coalesced_flush_cb_;
   Envoy::TimeSource& time_source_;
   const RedisCommandStatsSharedPtr redis_command_stats_;
   Stats::Scope& scope_;
   bool is_transaction_client_;
   bool queue_enabled_{false};
+  PushCallbacks* push_callbacks_{};
   absl::optional<envoy::extensions::filters::network::redis_proxy::v3::AwsIam> aws_iam_config_;
   absl::optional<Common::Redis::AwsIamAuthenticator::AwsIamAuthenticatorSharedPtr>
       aws_iam_authenticator_;
@@ -163,6 +163,13 @@ public:
    * @param value supplies the decoded value that is now owned by the callee.
    */
   virtual void onRespValue(RespValuePtr&& value) PURE;
+
+  /**
+   * Called when a RESP3 push value has been decoded, once RESP3 is enabled on the decoder. Pushes
+   * are out of band, so they are not the response of a request.
+   * @param value supplies the decoded push, as an array, that is now owned by the callee.
+   */
+  virtual void onPushValue(RespValuePtr&&) {}
 };
 
 /**
@@ -178,6 +185,12 @@ public:
    *        ProtocolError will be thrown.
    */
   virtual void decode(Buffer::Instance& data) PURE;
+
+  /**
+   * Decode the RESP3 pushes, maps and nulls from now on, as after a HELLO 3 command. Maps are
+   * decoded as arrays of their keys and values, and nulls as Null values.
+   */
+  virtual void enableResp3() {}
 };
 
 using DecoderPtr = std::unique_ptr<Decoder>;
@@ -208,6 +221,14 @@ public:
    * @param out supplies the buffer to encode to.
    */
   virtual void encode(const RespValue& value, Buffer::Instance& out) PURE;
+
+  /**
+   * Encode a RESP value owned by the caller to a buffer. The large bulk strings of the value may be
+   * moved to the buffer instead of copied.
+   * @param value supplies the value to encode, which is consumed.
+   * @param out supplies the buffer to encode to.
+   */
+  virtual void encodeOwned(RespValuePtr&& value, Buffer::Instance& out) { encode(*value, out); }
 };
 
 using EncoderPtr = std::unique_ptr<Encoder>;
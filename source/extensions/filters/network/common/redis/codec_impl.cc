@@ -7,6 +7,7 @@
 
 #include "envoy/common/platform.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/utility.h"
@@ -19,6 +20,14 @@ namespace NetworkFilters {
 namespace Common {
 namespace Redis {
 
+namespace {
+
+// The bulk strings of owned values from which the encoder moves the string to the buffer instead of
+// copying it. Below, the copy is cheaper than the allocation of the buffer fragment.
+constexpr uint64_t MinMovedBulkStringLength = 16 * 1024;
+
+} // namespace
+
 std::string RespValue::toString() const {
   switch (type_) {
   case RespType::Array: {
@@ -330,7 +339,9 @@ RespValue::CompositeArray::CompositeArrayConstIterator::empty() {
 }
 
 void DecoderImpl::decode(Buffer::Instance& data) {
+  later_slices_length_ = data.length();
   for (const Buffer::RawSlice& slice : data.getRawSlices()) {
+    later_slices_length_ -= slice.len_;
     parseSlice(slice);
   }
 
@@ -387,6 +398,35 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
         pending_value_stack_.front().value_->type(RespType::Integer);
         break;
       }
+      case '%': {
+        if (!resp3_) {
+          throw ProtocolError("invalid value type");
+        }
+        state_ = State::IntegerStart;
+        pending_map_ = true;
+        pending_value_stack_.front().value_->type(RespType::Array);
+        break;
+      }
+      case '>': {
+        if (!resp3_) {
+          throw ProtocolError("invalid value type");
+        }
+        if (pending_value_stack_.front().value_ != pending_value_root_.get()) {
+          throw ProtocolError("nested push");
+        }
+        state_ = State::IntegerStart;
+        pending_push_ = true;
+        pending_value_stack_.front().value_->type(RespType::Array);
+        break;
+      }
+      case '_': {
+        if (!resp3_) {
+          throw ProtocolError("invalid value type");
+        }
+        // The value is already Null.
+        state_ = State::CR;
+        break;
+      }
       default: {
         throw ProtocolError("invalid value type");
       }
@@ -625,6 +665,10 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
 
       PendingValue& current_value = pending_value_stack_.front();
       if (current_value.value_->type() == RespType::Array) {
+        if (pending_map_) {
+          pending_map_ = false;
+          pending_integer_.integer_ *= 2;
+        }
         if (pending_integer_.negative_) {
           // Null array. Convert to null.
           current_value.value_->type(RespType::Null);
@@ -651,7 +695,10 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       } else {
         ASSERT(current_value.value_->type() == RespType::BulkString);
         if (!pending_integer_.negative_) {
-          // TODO(mattklein123): reserve and define max length since we don't stream currently.
+          // Reserves the string up to the received bytes, so that a large string spanning many
+          // slices is copied once, while a bogus length does not allocate more than was received.
+          current_value.value_->asString().reserve(std::min(
+              static_cast<uint64_t>(pending_integer_.integer_), remaining + later_slices_length_));
           state_ = State::BulkStringBody;
         } else {
           // Null bulk string. Switch type to null and move to value complete.
@@ -723,7 +770,12 @@ void DecoderImpl::parseSlice(const Buffer::RawSlice& slice) {
       ASSERT(!pending_value_stack_.empty());
       pending_value_stack_.pop_front();
       if (pending_value_stack_.empty()) {
-        callbacks_.onRespValue(std::move(pending_value_root_));
+        if (pending_push_) {
+          pending_push_ = false;
+          callbacks_.onPushValue(std::move(pending_value_root_));
+        } else {
+          callbacks_.onRespValue(std::move(pending_value_root_));
+        }
         state_ = State::ValueRootStart;
       } else {
         PendingValue& current_value = pending_value_stack_.front();
@@ -774,14 +826,46 @@ void EncoderImpl::encode(const RespValue& value, Buffer::Instance& out) {
   }
 }
 
-void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+void EncoderImpl::encodeOwned(RespValuePtr&& value, Buffer::Instance& out) {
+  encodeOwnedValue(*value, out);
+}
+
+void EncoderImpl::encodeOwnedValue(RespValue& value, Buffer::Instance& out) {
+  if (value.type() == RespType::Array) {
+    encodeHeader('*', value.asArray().size(), out);
+    for (RespValue& element : value.asArray()) {
+      encodeOwnedValue(element, out);
+    }
+    return;
+  }
+  if (value.type() != RespType::BulkString || value.asString().size() < MinMovedBulkStringLength) {
+    encode(value, out);
+    return;
+  }
+
+  encodeHeader('$', value.asString().size(), out);
+  auto* string = new std::string(std::move(value.asString()));
+  out.addBufferFragment(*new Buffer::BufferFragmentImpl(
+      string->data(), string->size(),
+      [string](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) {
+        delete string;
+        delete fragment;
+      }));
+  out.add("\r\n", 2);
+}
+
+void EncoderImpl::encodeHeader(char type, uint64_t length, Buffer::Instance& out) {
   char buffer[32];
   char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, array.size());
+  *current++ = type;
+  current += StringUtil::itoa(current, 21, length);
   *current++ = '\r';
   *current++ = '\n';
   out.add(buffer, current - buffer);
+}
+
+void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out) {
+  encodeHeader('*', array.size(), out);
 
   for (const RespValue& value : array) {
     encode(value, out);
@@ -790,26 +874,14 @@ void EncoderImpl::encodeArray(const std::vector<RespValue>& array, Buffer::Insta
 
 void EncoderImpl::encodeCompositeArray(const RespValue::CompositeArray& composite_array,
                                        Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '*';
-  current += StringUtil::itoa(current, 21, composite_array.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeHeader('*', composite_array.size(), out);
   for (const RespValue& value : composite_array) {
     encode(value, out);
   }
 }
 
 void EncoderImpl::encodeBulkString(const std::string& string, Buffer::Instance& out) {
-  char buffer[32];
-  char* current = buffer;
-  *current++ = '$';
-  current += StringUtil::itoa(current, 21, string.size());
-  *current++ = '\r';
-  *current++ = '\n';
-  out.add(buffer, current - buffer);
+  encodeHeader('$', string.size(), out);
   out.add(string);
   out.add("\r\n", 2);
 }
@@ -25,6 +25,7 @@ public:
 
   // RedisProxy::Decoder
   void decode(Buffer::Instance& data) override;
+  void enableResp3() override { resp3_ = true; }
 
 private:
   enum class State {
@@ -67,6 +68,13 @@ private:
 
   DecoderCallbacks& callbacks_;
   State state_{State::ValueRootStart};
+  // The length of the slices of the data being decoded after the current one.
+  uint64_t later_slices_length_{};
+  bool resp3_{false};
+  // Whether the pending array is a RESP3 map, of twice as many values as its length.
+  bool pending_map_{false};
+  // Whether the pending root value is a RESP3 push.
+  bool pending_push_{false};
   PendingInteger pending_integer_;
   RespValuePtr pending_value_root_;
   std::forward_list<PendingValue> pending_value_stack_;
@@ -90,8 +98,11 @@ class EncoderImpl : public Encoder {
 public:
   // RedisProxy::Encoder
   void encode(const RespValue& value, Buffer::Instance& out) override;
+  void encodeOwned(RespValuePtr&& value, Buffer::Instance& out) override;
 
 private:
+  void encodeOwnedValue(RespValue& value, Buffer::Instance& out);
+  void encodeHeader(char type, uint64_t length, Buffer::Instance& out);
   void encodeArray(const std::vector<RespValue>& array, Buffer::Instance& out);
   void encodeCompositeArray(const RespValue::CompositeArray& array, Buffer::Instance& out);
   void encodeBulkString(const std::string& string, Buffer::Instance& out);
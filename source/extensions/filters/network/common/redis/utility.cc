@@ -51,6 +51,38 @@ const ReadOnlyRequest& ReadOnlyRequest::instance() {
   return *instance;
 }
 
+HelloRequest::HelloRequest() {
+  std::vector<RespValue> values(2);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = "hello";
+  values[1].type(RespType::BulkString);
+  values[1].asString() = "3";
+  type(RespType::Array);
+  asArray().swap(values);
+}
+
+const HelloRequest& HelloRequest::instance() {
+  static const HelloRequest* instance = new HelloRequest{};
+  return *instance;
+}
+
+ClientTrackingRequest::ClientTrackingRequest() {
+  std::vector<RespValue> values(3);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = "client";
+  values[1].type(RespType::BulkString);
+  values[1].asString() = "tracking";
+  values[2].type(RespType::BulkString);
+  values[2].asString() = "on";
+  type(RespType::Array);
+  asArray().swap(values);
+}
+
+const ClientTrackingRequest& ClientTrackingRequest::instance() {
+  static const ClientTrackingRequest* instance = new ClientTrackingRequest{};
+  return *instance;
+}
+
 AskingRequest::AskingRequest() {
   std::vector<RespValue> values(1);
   values[0].type(RespType::BulkString);
@@ -25,6 +25,21 @@ public:
   static const ReadOnlyRequest& instance();
 };
 
+// HELLO 3, switching the connection to RESP3.
+class HelloRequest : public Redis::RespValue {
+public:
+  HelloRequest();
+  static const HelloRequest& instance();
+};
+
+// CLIENT TRACKING ON, so that the server pushes the invalidations of the keys read on the
+// connection.
+class ClientTrackingRequest : public Redis::RespValue {
+public:
+  ClientTrackingRequest();
+  static const ClientTrackingRequest& instance();
+};
+
 class AskingRequest : public Redis::RespValue {
 public:
   AskingRequest();
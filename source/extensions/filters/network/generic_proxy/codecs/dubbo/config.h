@@ -50,6 +50,10 @@ public:
 
   // StreamFrame
   FrameFlags frameFlags() const override { return stream_frame_flags_; }
+  void setStreamId(uint64_t stream_id) override {
+    inner_metadata_->mutableContext().setRequestId(static_cast<int64_t>(stream_id));
+    stream_frame_flags_ = {stream_id, stream_frame_flags_.rawFlags()};
+  }
 
   Common::Dubbo::MessageMetadataSharedPtr inner_metadata_;
 
@@ -79,6 +83,10 @@ public:
 
   // StreamFrame
   FrameFlags frameFlags() const override { return stream_frame_flags_; }
+  void setStreamId(uint64_t stream_id) override {
+    inner_metadata_->mutableContext().setRequestId(static_cast<int64_t>(stream_id));
+    stream_frame_flags_ = {stream_id, stream_frame_flags_.rawFlags()};
+  }
 
   StreamStatus status_;
   Common::Dubbo::MessageMetadataSharedPtr inner_metadata_;
@@ -227,6 +235,8 @@ public:
     return std::make_unique<DubboClientCodec>(
         Common::Dubbo::DubboCodec::codecFromSerializeType(Common::Dubbo::SerializeType::Hessian2));
   }
+  // The request id of the Dubbo messages is their stream id.
+  bool supportsStreamIdRewrite() const override { return true; }
 };
 
 class DubboCodecFactoryConfig : public CodecFactoryConfig {
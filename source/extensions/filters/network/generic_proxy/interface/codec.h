@@ -121,6 +121,13 @@ public:
    * Create a client codec instance.
    */
   virtual ClientCodecPtr createClientCodec() const PURE;
+
+  /**
+   * @return whether the stream ids of the frames could be rewritten by
+   * StreamFrame::setStreamId(). This is required to multiplex the requests of many downstream
+   * connections over same upstream connection, where the stream ids of the requests may conflict.
+   */
+  virtual bool supportsStreamIdRewrite() const { return false; }
 };
 
 using CodecFactoryPtr = std::unique_ptr<CodecFactory>;
@@ -108,6 +108,13 @@ public:
    * @return FrameFlags of the current frame.
    */
   virtual FrameFlags frameFlags() const { return {}; }
+
+  /**
+   * Rewrite the stream id of current frame. The frame MUST then be encoded with the new stream
+   * id by the codec. This is only called if the codec factory supports the stream id rewriting.
+   * @param stream_id the new stream id of the frame.
+   */
+  virtual void setStreamId(uint64_t) {}
 };
 
 /**
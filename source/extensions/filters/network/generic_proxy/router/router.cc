@@ -3,10 +3,12 @@
 #include <cstdint>
 
 #include "envoy/common/conn_pool.h"
+#include "envoy/common/exception.h"
 #include "envoy/network/connection.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/config/well_known_names.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/tracing/tracer_impl.h"
 #include "source/extensions/filters/network/generic_proxy/interface/filter.h"
@@ -39,12 +41,33 @@ ReasonViewAndFlag resetReasonToViewAndFlag(StreamResetReason reason) {
 
 } // namespace
 
+RouterConfig::RouterConfig(
+    const envoy::extensions::filters::network::generic_proxy::router::v3::Router& config,
+    ThreadLocal::SlotAllocator& tls)
+    : bind_upstream_connection_(config.bind_upstream_connection()) {
+  if (!config.has_multiplex_upstream_connections()) {
+    return;
+  }
+  if (bind_upstream_connection_) {
+    throw EnvoyException(
+        "bind_upstream_connection and multiplex_upstream_connections cannot be set together");
+  }
+
+  const uint32_t max_connections_per_host = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+      config.multiplex_upstream_connections(), max_connections_per_host, 1);
+  multiplexed_upstreams_ = ThreadLocal::TypedSlot<MultiplexedGenericUpstreams>::makeUnique(tls);
+  multiplexed_upstreams_->set([max_connections_per_host](Event::Dispatcher&) {
+    return std::make_shared<MultiplexedGenericUpstreams>(max_connections_per_host);
+  });
+}
+
 UpstreamRequest::UpstreamRequest(RouterFilter& parent, FrameFlags header_frame_flags,
                                  GenericUpstreamSharedPtr generic_upstream)
     : parent_(parent), generic_upstream_(std::move(generic_upstream)),
       stream_info_(parent.time_source_, nullptr, StreamInfo::FilterState::LifeSpan::FilterChain),
       upstream_info_(std::make_shared<StreamInfo::UpstreamInfoImpl>()),
       stream_id_(header_frame_flags.streamId()),
+      upstream_stream_id_(generic_upstream_->allocateStreamId()),
       expects_response_(!header_frame_flags.oneWayStream()) {
 
   // Host is known at this point and set the upstream host.
@@ -72,7 +95,7 @@ UpstreamRequest::UpstreamRequest(RouterFilter& parent, FrameFlags header_frame_f
 
 void UpstreamRequest::startStream() {
   connecting_start_time_ = parent_.time_source_.monotonicTime();
-  generic_upstream_->appendUpstreamRequest(stream_id_, this);
+  generic_upstream_->appendUpstreamRequest(upstream_stream_id_.value_or(stream_id_), this);
 }
 
 void UpstreamRequest::resetStream(StreamResetReason reason, absl::string_view reason_detail) {
@@ -86,8 +109,12 @@ void UpstreamRequest::resetStream(StreamResetReason reason, absl::string_view re
 
   ENVOY_LOG(debug, "generic proxy upstream request: reset upstream request");
 
-  generic_upstream_->removeUpstreamRequest(stream_id_);
-  generic_upstream_->cleanUp(true);
+  generic_upstream_->removeUpstreamRequest(upstream_stream_id_.value_or(stream_id_));
+  // The local reset of a request that shares the upstream connection with other downstream
+  // connections, like on timeout, need not close the connection. A later response of the request
+  // will be ignored as its stream id is no longer known.
+  generic_upstream_->cleanUp(!upstream_stream_id_.has_value() ||
+                             reason != StreamResetReason::LocalReset);
 
   if (span_ != nullptr) {
     span_->setTag(Tracing::Tags::get().Error, Tracing::Tags::get().True);
@@ -111,7 +138,7 @@ void UpstreamRequest::clearStream(bool close_connection) {
     Tracing::TracerUtility::finalizeSpan(*span_, stream_info_, tracing_config_.value().get(), true);
   }
 
-  generic_upstream_->removeUpstreamRequest(stream_id_);
+  generic_upstream_->removeUpstreamRequest(upstream_stream_id_.value_or(stream_id_));
   generic_upstream_->cleanUp(close_connection);
 
   // Remove this stream form the parent's list because this upstream request is complete.
@@ -147,11 +174,19 @@ void UpstreamRequest::sendCommonFrameToUpstream() {
   }
 }
 
-bool UpstreamRequest::sendFrameToUpstream(const StreamFrame& frame, bool header_frame) {
+bool UpstreamRequest::sendFrameToUpstream(StreamFrame& frame, bool header_frame) {
   ASSERT(generic_upstream_ != nullptr);
   const bool end_stream = frame.frameFlags().endStream();
 
+  // The frame is encoded with the stream id of the upstream, and then the stream id of the
+  // downstream is restored because the frame is still used by the downstream.
+  if (upstream_stream_id_.has_value()) {
+    frame.setStreamId(upstream_stream_id_.value());
+  }
   const auto result = generic_upstream_->clientCodec().encode(frame, *this);
+  if (upstream_stream_id_.has_value()) {
+    frame.setStreamId(stream_id_);
+  }
   if (!result.ok()) {
     ENVOY_LOG(error, "Generic proxy: request encoding failure: {}", result.status().message());
     // The request encoding failure is treated as a protocol error.
@@ -240,6 +275,10 @@ void UpstreamRequest::onDecodingSuccess(ResponseHeaderFramePtr response_header_f
   }
   response_stream_header_received_ = true;
 
+  if (upstream_stream_id_.has_value()) {
+    response_header_frame->setStreamId(stream_id_);
+  }
+
   if (start_time.has_value()) {
     // Set the start time from the upstream codec.
     upstream_info_->upstreamTiming().first_upstream_rx_byte_received_ =
@@ -270,6 +309,10 @@ void UpstreamRequest::onDecodingSuccess(ResponseCommonFramePtr response_common_f
     return;
   }
 
+  if (upstream_stream_id_.has_value()) {
+    response_common_frame->setStreamId(stream_id_);
+  }
+
   if (response_common_frame->frameFlags().endStream()) {
     onUpstreamResponseComplete(response_common_frame->frameFlags().drainClose());
   }
@@ -439,9 +482,17 @@ void RouterFilter::kickOffNewUpstreamRequest() {
     return;
   }
 
-  GenericUpstreamSharedPtr generic_upstream = generic_upstream_factory_->createGenericUpstream(
-      *thread_local_cluster, this, const_cast<Network::Connection&>(*callbacks_->connection()),
-      callbacks_->codecFactory(), config_->bindUpstreamConnection());
+  GenericUpstreamSharedPtr generic_upstream;
+  // Codecs that cannot rewrite the stream ids fall back to an upstream connection per request.
+  if (config_->multiplexUpstreamConnections() &&
+      callbacks_->codecFactory().supportsStreamIdRewrite()) {
+    generic_upstream = generic_upstream_factory_->createMultiplexedGenericUpstream(
+        *thread_local_cluster, this, callbacks_->codecFactory(), config_->multiplexedUpstreams());
+  } else {
+    generic_upstream = generic_upstream_factory_->createGenericUpstream(
+        *thread_local_cluster, this, const_cast<Network::Connection&>(*callbacks_->connection()),
+        callbacks_->codecFactory(), config_->bindUpstreamConnection());
+  }
   if (generic_upstream == nullptr) {
     completeAndSendLocalReply(Status(StatusCode::kUnavailable, "no_healthy_upstream"), {},
                               StreamInfo::CoreResponseFlag::NoHealthyUpstream);
@@ -6,6 +6,7 @@
 #include "envoy/extensions/filters/network/generic_proxy/router/v3/router.pb.validate.h"
 #include "envoy/network/connection.h"
 #include "envoy/server/factory_context.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
@@ -77,7 +78,7 @@ public:
 
   void sendHeaderFrameToUpstream();
   void sendCommonFrameToUpstream();
-  bool sendFrameToUpstream(const StreamFrame& frame, bool header_frame);
+  bool sendFrameToUpstream(StreamFrame& frame, bool header_frame);
 
   void onUpstreamResponseComplete(bool drain_close);
 
@@ -92,6 +93,9 @@ public:
   absl::optional<MonotonicTime> connecting_start_time_;
 
   const uint64_t stream_id_{};
+  // The stream id that the request is sent to the upstream with, if the upstream rewrites the
+  // stream ids.
+  const absl::optional<uint64_t> upstream_stream_id_;
   const bool expects_response_{};
 
   // One of these flags should be set to true when the request is complete.
@@ -104,13 +108,20 @@ using UpstreamRequestPtr = std::unique_ptr<UpstreamRequest>;
 
 class RouterConfig {
 public:
-  RouterConfig(const envoy::extensions::filters::network::generic_proxy::router::v3::Router& config)
-      : bind_upstream_connection_(config.bind_upstream_connection()) {}
+  RouterConfig(const envoy::extensions::filters::network::generic_proxy::router::v3::Router& config,
+               ThreadLocal::SlotAllocator& tls);
 
   bool bindUpstreamConnection() const { return bind_upstream_connection_; }
+  bool multiplexUpstreamConnections() const { return multiplexed_upstreams_ != nullptr; }
+  // Only valid if multiplexUpstreamConnections() is true.
+  MultiplexedGenericUpstreams& multiplexedUpstreams() {
+    ASSERT(multiplexed_upstreams_ != nullptr);
+    return multiplexed_upstreams_->get().ref();
+  }
 
 private:
   const bool bind_upstream_connection_{};
+  ThreadLocal::TypedSlotPtr<MultiplexedGenericUpstreams> multiplexed_upstreams_;
 };
 using RouterConfigSharedPtr = std::shared_ptr<RouterConfig>;
 
@@ -1,5 +1,9 @@
 #include "source/extensions/filters/network/generic_proxy/router/upstream.h"
 
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -311,6 +315,121 @@ void OwnedGenericUpstream::onUpstreamFailure(ConnectionPool::PoolFailureReason r
   upstream_request->onUpstreamFailure(reason, transport_failure_reason);
 }
 
+void MultiplexedGenericUpstream::appendUpstreamRequest(uint64_t stream_id,
+                                                       UpstreamRequestCallbacks* pending_request) {
+  // The upstream is only picked for new requests while it is available.
+  ASSERT(available());
+
+  if (upstream_conn_ok_.has_value()) {
+    ASSERT(encoder_decoder_ != nullptr);
+    encoder_decoder_->appendUpstreamRequest(stream_id, pending_request);
+    pending_request->onUpstreamSuccess();
+  } else {
+    pending_requests_[stream_id] = pending_request;
+    tryInitialize();
+  }
+}
+
+void MultiplexedGenericUpstream::removeUpstreamRequest(uint64_t stream_id) {
+  pending_requests_.erase(stream_id);
+  if (encoder_decoder_ != nullptr) {
+    encoder_decoder_->removeUpstreamRequest(stream_id);
+  }
+}
+
+void MultiplexedGenericUpstream::cleanUp(bool close_connection) {
+  // The connection is shared by the requests of many downstream connections and is never
+  // released back to the pool. It is only closed after the last of its requests completes.
+  if (close_connection) {
+    draining_ = true;
+  }
+  if (draining_ && activeRequestsSize() == 0) {
+    MultiplexedGenericUpstreamBase::cleanUp(true);
+  }
+}
+
+absl::optional<uint64_t> MultiplexedGenericUpstream::allocateStreamId() {
+  // Skip the stream ids that are still in use after the ids wrap around.
+  uint64_t stream_id = next_stream_id_++;
+  while (pending_requests_.contains(stream_id) ||
+         (encoder_decoder_ != nullptr && encoder_decoder_->containsRequest(stream_id))) {
+    stream_id = next_stream_id_++;
+  }
+  return stream_id;
+}
+
+void MultiplexedGenericUpstream::onConnectionClose(Network::ConnectionEvent) {
+  // The requests waiting for responses are notified by the encoder/decoder.
+  closed_ = true;
+}
+
+void MultiplexedGenericUpstream::onUpstreamSuccess() {
+  ASSERT(!upstream_conn_ok_.has_value());
+  ASSERT(encoder_decoder_ != nullptr);
+  upstream_conn_ok_ = true;
+
+  while (!pending_requests_.empty()) {
+    auto it = pending_requests_.begin();
+    auto cb = it->second;
+
+    // Insert it to the waiting response list and remove it from the waiting upstream list.
+    encoder_decoder_->appendUpstreamRequest(it->first, cb);
+    pending_requests_.erase(it);
+
+    cb->onUpstreamSuccess();
+  }
+}
+
+void MultiplexedGenericUpstream::onUpstreamFailure(ConnectionPool::PoolFailureReason reason,
+                                                   absl::string_view transport_reason) {
+  ASSERT(!upstream_conn_ok_.has_value());
+  upstream_conn_ok_ = false;
+
+  while (!pending_requests_.empty()) {
+    auto it = pending_requests_.begin();
+    auto cb = it->second;
+    pending_requests_.erase(it);
+    cb->onUpstreamFailure(reason, transport_reason);
+  }
+}
+
+GenericUpstreamSharedPtr MultiplexedGenericUpstreams::pick(Upstream::ThreadLocalCluster& cluster,
+                                                          Upstream::LoadBalancerContext* context,
+                                                          const CodecFactory& codec_factory) {
+  auto pool_data = cluster.tcpConnPool(Upstream::ResourcePriority::Default, context);
+  if (!pool_data.has_value()) {
+    return nullptr;
+  }
+
+  std::vector<MultiplexedGenericUpstreamSharedPtr>& upstreams = upstreams_[absl::StrCat(
+      cluster.info()->name(), "/", pool_data->host()->address()->asStringView())];
+  // The unavailable upstreams are kept alive by their remaining requests.
+  upstreams.erase(std::remove_if(upstreams.begin(), upstreams.end(),
+                                 [](const MultiplexedGenericUpstreamSharedPtr& upstream) {
+                                   return !upstream->available();
+                                 }),
+                  upstreams.end());
+
+  if (upstreams.size() >= max_connections_per_host_) {
+    return *std::min_element(upstreams.begin(), upstreams.end(),
+                             [](const MultiplexedGenericUpstreamSharedPtr& a,
+                                const MultiplexedGenericUpstreamSharedPtr& b) {
+                               return a->activeRequestsSize() < b->activeRequestsSize();
+                             });
+  }
+
+  auto upstream =
+      std::make_shared<MultiplexedGenericUpstream>(std::move(pool_data.value()), codec_factory);
+  upstreams.push_back(upstream);
+  return upstream;
+}
+
+GenericUpstreamSharedPtr ProdGenericUpstreamFactory::createMultiplexedGenericUpstream(
+    Upstream::ThreadLocalCluster& cluster, Upstream::LoadBalancerContext* context,
+    const CodecFactory& codec_factory, MultiplexedGenericUpstreams& upstreams) const {
+  return upstreams.pick(cluster, context, codec_factory);
+}
+
 GenericUpstreamSharedPtr ProdGenericUpstreamFactory::createGenericUpstream(
     Upstream::ThreadLocalCluster& cluster, Upstream::LoadBalancerContext* context,
     Network::Connection& downstream_conn, const CodecFactory& codec_factory, bool bound) const {
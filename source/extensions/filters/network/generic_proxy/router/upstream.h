@@ -4,6 +4,7 @@
 #include <functional>
 
 #include "envoy/network/connection.h"
+#include "envoy/thread_local/thread_local_object.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/extensions/filters/network/generic_proxy/interface/codec.h"
@@ -62,10 +63,17 @@ public:
   // Any implementation should ensure that it is safe to call cleanUp() multiple times and
   // ensure it works correctly.
   virtual void cleanUp(bool close_connection) PURE;
+
+  // Return the stream id that a new request should be sent to the upstream with, or
+  // absl::nullopt if the request should be sent with its own stream id. This is called once per
+  // request, before it is inserted into the upstream.
+  virtual absl::optional<uint64_t> allocateStreamId() { return absl::nullopt; }
 };
 
 using GenericUpstreamSharedPtr = std::shared_ptr<GenericUpstream>;
 
+class MultiplexedGenericUpstreams;
+
 class GenericUpstreamFactory {
 public:
   virtual ~GenericUpstreamFactory() = default;
@@ -75,6 +83,14 @@ public:
                                                          Network::Connection& downstream_conn,
                                                          const CodecFactory& codec_factory,
                                                          bool bound) const PURE;
+
+  // Create or pick an upstream that is shared by the requests of all the downstream connections
+  // of the worker. The codec must support the stream id rewriting.
+  virtual GenericUpstreamSharedPtr
+  createMultiplexedGenericUpstream(Upstream::ThreadLocalCluster& cluster,
+                                   Upstream::LoadBalancerContext* context,
+                                   const CodecFactory& codec_factory,
+                                   MultiplexedGenericUpstreams& upstreams) const PURE;
 };
 
 template <class RequestManager>
@@ -417,6 +433,76 @@ private:
   UpstreamRequestCallbacks* upstream_request_{};
 };
 
+using MultiplexedGenericUpstreamBase = UpstreamBase<SharedEncoderDecoder>;
+/**
+ * Upstream connection that is shared by the requests of all the downstream connections of a
+ * worker. The requests are sent with the stream ids allocated by this upstream, which are unique
+ * in the upstream connection, and the responses are dispatched back by these stream ids.
+ */
+class MultiplexedGenericUpstream : public MultiplexedGenericUpstreamBase {
+public:
+  using UpstreamBase::UpstreamBase;
+
+  // Whether new requests could be sent over this upstream.
+  bool available() const { return upstream_conn_ok_.value_or(true) && !closed_ && !draining_; }
+  size_t activeRequestsSize() const {
+    return waitingUpstreamRequestsSize() + waitingResponseRequestsSize();
+  }
+
+  // UpstreamBase
+  void onUpstreamSuccess() override;
+  void onUpstreamFailure(ConnectionPool::PoolFailureReason reason,
+                         absl::string_view transport_failure_reason) override;
+  void onConnectionClose(Network::ConnectionEvent event) override;
+
+  // Upstream
+  void appendUpstreamRequest(uint64_t stream_id,
+                             UpstreamRequestCallbacks* pending_request) override;
+  void removeUpstreamRequest(uint64_t stream_id) override;
+  void cleanUp(bool close_connection) override;
+  absl::optional<uint64_t> allocateStreamId() override;
+
+  size_t waitingUpstreamRequestsSize() const { return pending_requests_.size(); }
+  size_t waitingResponseRequestsSize() const {
+    return encoder_decoder_ ? encoder_decoder_->requestsSize() : 0;
+  }
+
+private:
+  absl::optional<bool> upstream_conn_ok_;
+  // The requests waiting for the upstream connection, in the order in which they were received.
+  quiche::QuicheLinkedHashMap<uint64_t, UpstreamRequestCallbacks*> pending_requests_;
+  uint64_t next_stream_id_{1};
+  // Set once a request wants the connection to be closed. The connection is then closed after
+  // the last of its requests completes, and no new request is sent over it.
+  bool draining_{};
+  bool closed_{};
+};
+
+using MultiplexedGenericUpstreamSharedPtr = std::shared_ptr<MultiplexedGenericUpstream>;
+
+/**
+ * The multiplexed upstream connections of a worker, per cluster and upstream host.
+ */
+class MultiplexedGenericUpstreams : public ThreadLocal::ThreadLocalObject {
+public:
+  explicit MultiplexedGenericUpstreams(uint32_t max_connections_per_host)
+      : max_connections_per_host_(max_connections_per_host) {}
+
+  /**
+   * Pick the available upstream connection to the host selected by the load balancer that has
+   * the fewest active requests, or create a new one if the host has fewer connections than the
+   * max connections per host.
+   * @return the upstream or nullptr if there is no healthy upstream host.
+   */
+  GenericUpstreamSharedPtr pick(Upstream::ThreadLocalCluster& cluster,
+                                Upstream::LoadBalancerContext* context,
+                                const CodecFactory& codec_factory);
+
+private:
+  const uint32_t max_connections_per_host_;
+  absl::flat_hash_map<std::string, std::vector<MultiplexedGenericUpstreamSharedPtr>> upstreams_;
+};
+
 class ProdGenericUpstreamFactory : public GenericUpstreamFactory {
 public:
   GenericUpstreamSharedPtr createGenericUpstream(Upstream::ThreadLocalCluster& cluster,
@@ -424,6 +510,11 @@ public:
                                                  Network::Connection& downstream_conn,
                                                  const CodecFactory& codec_factory,
                                                  bool bound) const override;
+  GenericUpstreamSharedPtr
+  createMultiplexedGenericUpstream(Upstream::ThreadLocalCluster& cluster,
+                                   Upstream::LoadBalancerContext* context,
+                                   const CodecFactory& codec_factory,
+                                   MultiplexedGenericUpstreams& upstreams) const override;
 };
 
 using DefaultGenericUpstreamFactory = ConstSingleton<ProdGenericUpstreamFactory>;
@@ -4,10 +4,12 @@
 #include <sstream>
 #include <string>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/byte_order.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/hex.h"
+#include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
 
 namespace Envoy {
@@ -593,6 +595,198 @@ const Field* DocumentImpl::find(const std::string& name, Field::Type type) const
   return nullptr;
 }
 
+DocumentSharedPtr LazyDocumentImpl::create(Buffer::Instance& data) {
+  // The length, the terminating null byte, and no field.
+  static constexpr int32_t MinDocumentSize = sizeof(int32_t) + 1;
+  const int32_t length = BufferHelper::peekInt32(data);
+  if (length < MinDocumentSize || static_cast<uint64_t>(length) > data.length()) {
+    throw EnvoyException("invalid BSON message length");
+  }
+
+  std::shared_ptr<LazyDocumentImpl> new_doc{new LazyDocumentImpl()};
+  new_doc->bytes_.resize(length);
+  data.copyOut(0, length, new_doc->bytes_.data());
+  data.drain(length);
+  if (new_doc->bytes_.back() != 0) {
+    throw EnvoyException("invalid document");
+  }
+
+  return new_doc;
+}
+
+int32_t LazyDocumentImpl::byteSize() const {
+  return bytes_.empty() ? document_->byteSize() : static_cast<int32_t>(bytes_.size());
+}
+
+void LazyDocumentImpl::encode(Buffer::Instance& output) const {
+  if (bytes_.empty()) {
+    document_->encode(output);
+    return;
+  }
+
+  output.add(bytes_);
+}
+
+const Document& LazyDocumentImpl::document() const {
+  if (document_ == nullptr) {
+    Buffer::OwnedImpl data(bytes_);
+    document_ = DocumentImpl::create(data);
+  }
+
+  return *document_;
+}
+
+Document& LazyDocumentImpl::mutableDocument() {
+  document();
+  // The fields found so far are dropped along with the bytes they were decoded from.
+  bytes_.clear();
+  index_.clear();
+  indexed_ = false;
+  fields_.clear();
+  return *document_;
+}
+
+int32_t LazyDocumentImpl::valueInt32(size_t offset) const {
+  if (offset + sizeof(int32_t) > bytes_.size()) {
+    throw EnvoyException("invalid buffer size");
+  }
+
+  uint32_t val;
+  safeMemcpyUnsafeSrc(&val, bytes_.data() + offset);
+  return static_cast<int32_t>(le32toh(val));
+}
+
+size_t LazyDocumentImpl::valueSize(Field::Type type, absl::string_view key, size_t offset) const {
+  switch (type) {
+  case Field::Type::Double:
+  case Field::Type::Datetime:
+  case Field::Type::Timestamp:
+  case Field::Type::Int64:
+    return sizeof(int64_t);
+
+  case Field::Type::Int32:
+    return sizeof(int32_t);
+
+  case Field::Type::Boolean:
+    return sizeof(uint8_t);
+
+  case Field::Type::NullValue:
+    return 0;
+
+  case Field::Type::ObjectId:
+    return sizeof(Field::ObjectId);
+
+  case Field::Type::String:
+  case Field::Type::Symbol:
+  case Field::Type::Binary: {
+    // The length of the strings includes their null byte, and binaries are followed by a subtype.
+    const int32_t length = valueInt32(offset);
+    if (length < 0) {
+      throw EnvoyException("invalid buffer size");
+    }
+    return sizeof(int32_t) + (type == Field::Type::Binary ? 1 : 0) + length;
+  }
+
+  case Field::Type::Document:
+  case Field::Type::Array: {
+    const int32_t length = valueInt32(offset);
+    if (length < static_cast<int32_t>(sizeof(int32_t))) {
+      throw EnvoyException("invalid BSON message length");
+    }
+    return length;
+  }
+
+  case Field::Type::Regex: {
+    // The pattern and the options C strings.
+    const size_t pattern_end = bytes_.find('\0', offset);
+    const size_t options_end =
+        pattern_end == std::string::npos ? pattern_end : bytes_.find('\0', pattern_end + 1);
+    if (options_end == std::string::npos) {
+      throw EnvoyException("invalid CString");
+    }
+    return options_end + 1 - offset;
+  }
+  }
+
+  throw EnvoyException(
+      fmt::format("invalid BSON element type: {:#x} key: {}", static_cast<uint8_t>(type), key));
+}
+
+void LazyDocumentImpl::buildIndex() const {
+  std::vector<IndexEntry> index;
+  // The fields lie between the length and the terminating null byte.
+  const size_t end = bytes_.size() - 1;
+  const absl::string_view bytes(bytes_);
+  size_t offset = sizeof(int32_t);
+  while (offset < end) {
+    const size_t element_offset = offset;
+    const auto type = static_cast<Field::Type>(bytes[offset++]);
+    const size_t key_end = bytes.find('\0', offset);
+    if (key_end >= end) {
+      throw EnvoyException("invalid CString");
+    }
+
+    const absl::string_view key = bytes.substr(offset, key_end - offset);
+    offset = key_end + 1;
+    offset += valueSize(type, key, offset);
+    if (offset > end) {
+      throw EnvoyException("invalid document");
+    }
+
+    index.push_back({key, type, element_offset, offset - element_offset});
+  }
+
+  index_ = std::move(index);
+  indexed_ = true;
+}
+
+const Field* LazyDocumentImpl::decodeField(size_t index) const {
+  auto it = fields_.find(index);
+  if (it == fields_.end()) {
+    // Decode the element as the only field of a document.
+    const IndexEntry& entry = index_[index];
+    Buffer::OwnedImpl data;
+    BufferHelper::writeInt32(data, static_cast<int32_t>(sizeof(int32_t) + entry.size_ + 1));
+    data.add(absl::string_view(bytes_).substr(entry.offset_, entry.size_));
+    const uint8_t done = 0;
+    data.add(&done, sizeof(done));
+    it = fields_.emplace(index, DocumentImpl::create(data)).first;
+  }
+
+  return it->second->values().front().get();
+}
+
+template <class Predicate> const Field* LazyDocumentImpl::findIf(Predicate predicate) const {
+  if (!indexed_) {
+    buildIndex();
+  }
+
+  for (size_t i = 0; i < index_.size(); i++) {
+    if (predicate(index_[i])) {
+      return decodeField(i);
+    }
+  }
+
+  return nullptr;
+}
+
+const Field* LazyDocumentImpl::find(const std::string& name) const {
+  if (document_ != nullptr) {
+    return document_->find(name);
+  }
+
+  return findIf([&name](const IndexEntry& entry) { return entry.key_ == name; });
+}
+
+const Field* LazyDocumentImpl::find(const std::string& name, Field::Type type) const {
+  if (document_ != nullptr) {
+    return document_->find(name, type);
+  }
+
+  return findIf(
+      [&name, type](const IndexEntry& entry) { return entry.key_ == name && entry.type_ == type; });
+}
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
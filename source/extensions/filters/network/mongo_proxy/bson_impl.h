@@ -3,6 +3,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/exception.h"
@@ -11,6 +12,9 @@
 #include "source/common/common/utility.h"
 #include "source/extensions/filters/network/mongo_proxy/bson.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -271,6 +275,128 @@ private:
   std::list<FieldPtr> fields_;
 };
 
+/**
+ * A document decoded on demand from a copy of its bytes. Its size and encoding need no decoding. A
+ * find() indexes the offsets of the top level fields on its first call and only decodes the fields
+ * found, while the other accessors decode the whole document once. The fields are not validated
+ * until they are decoded. Adding a field decodes the whole document and drops its bytes.
+ */
+class LazyDocumentImpl : public Document, public std::enable_shared_from_this<LazyDocumentImpl> {
+public:
+  static DocumentSharedPtr create(Buffer::Instance& data);
+
+  // Mongo::Document
+  DocumentSharedPtr addDouble(const std::string& key, double value) override {
+    mutableDocument().addDouble(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addString(const std::string& key, std::string&& value) override {
+    mutableDocument().addString(key, std::move(value));
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addSymbol(const std::string& key, std::string&& value) override {
+    mutableDocument().addSymbol(key, std::move(value));
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addDocument(const std::string& key, DocumentSharedPtr value) override {
+    mutableDocument().addDocument(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addArray(const std::string& key, DocumentSharedPtr value) override {
+    mutableDocument().addArray(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addBinary(const std::string& key, std::string&& value) override {
+    mutableDocument().addBinary(key, std::move(value));
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addObjectId(const std::string& key, Field::ObjectId&& value) override {
+    mutableDocument().addObjectId(key, std::move(value));
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addBoolean(const std::string& key, bool value) override {
+    mutableDocument().addBoolean(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addDatetime(const std::string& key, int64_t value) override {
+    mutableDocument().addDatetime(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addNull(const std::string& key) override {
+    mutableDocument().addNull(key);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addRegex(const std::string& key, Field::Regex&& value) override {
+    mutableDocument().addRegex(key, std::move(value));
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addInt32(const std::string& key, int32_t value) override {
+    mutableDocument().addInt32(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addTimestamp(const std::string& key, int64_t value) override {
+    mutableDocument().addTimestamp(key, value);
+    return shared_from_this();
+  }
+
+  DocumentSharedPtr addInt64(const std::string& key, int64_t value) override {
+    mutableDocument().addInt64(key, value);
+    return shared_from_this();
+  }
+
+  bool operator==(const Document& rhs) const override { return document() == rhs; }
+  int32_t byteSize() const override;
+  void encode(Buffer::Instance& output) const override;
+  const Field* find(const std::string& name) const override;
+  const Field* find(const std::string& name, Field::Type type) const override;
+  std::string toString() const override { return document().toString(); }
+  const std::list<FieldPtr>& values() const override { return document().values(); }
+
+  /**
+   * @return whether the whole document was decoded.
+   */
+  bool decoded() const { return document_ != nullptr; }
+
+private:
+  struct IndexEntry {
+    absl::string_view key_;
+    Field::Type type_;
+    // The offset and size of the whole element in the bytes of the document.
+    size_t offset_;
+    size_t size_;
+  };
+
+  LazyDocumentImpl() = default;
+
+  const Document& document() const;
+  Document& mutableDocument();
+  void buildIndex() const;
+  size_t valueSize(Field::Type type, absl::string_view key, size_t offset) const;
+  int32_t valueInt32(size_t offset) const;
+  const Field* decodeField(size_t index) const;
+  template <class Predicate> const Field* findIf(Predicate predicate) const;
+
+  // Empty once the whole document is decoded for a mutation.
+  std::string bytes_;
+  mutable DocumentSharedPtr document_;
+  mutable std::vector<IndexEntry> index_;
+  mutable bool indexed_{false};
+  // The single field documents of the elements found, by element index.
+  mutable absl::flat_hash_map<size_t, DocumentSharedPtr> fields_;
+};
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
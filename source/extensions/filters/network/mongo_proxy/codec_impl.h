@@ -20,15 +20,22 @@ public:
 
   virtual void fromBuffer(uint32_t message_length, Buffer::Instance& data) PURE;
 
+  /**
+   * Sets whether fromBuffer() decodes the documents on demand rather than upfront.
+   */
+  void lazyDocuments(bool lazy_documents) { lazy_documents_ = lazy_documents; }
+
   // Mongo::Message
   int32_t requestId() const override { return request_id_; }
   int32_t responseTo() const override { return response_to_; }
 
 protected:
   std::string documentListToString(const std::list<Bson::DocumentSharedPtr>& documents) const;
+  Bson::DocumentSharedPtr createDocument(Buffer::Instance& data) const;
 
   const int32_t request_id_;
   const int32_t response_to_;
+  bool lazy_documents_{false};
 };
 
 class GetMoreMessageImpl : public MessageImpl,
@@ -271,7 +278,7 @@ private:
 
 class DecoderImpl : public Decoder, Logger::Loggable<Logger::Id::mongo> {
 public:
-  DecoderImpl(DecoderCallbacks& callbacks) : callbacks_(callbacks) {}
+  DecoderImpl(DecoderCallbacks& callbacks);
 
   // Mongo::Decoder
   void onData(Buffer::Instance& data) override;
@@ -280,6 +287,9 @@ private:
   bool decode(Buffer::Instance& data);
 
   DecoderCallbacks& callbacks_;
+  // Whether the documents are decoded on demand, as most of them are only needed for the access
+  // logs.
+  const bool lazy_documents_;
 };
 
 class EncoderImpl : public Encoder, Logger::Loggable<Logger::Id::mongo> {
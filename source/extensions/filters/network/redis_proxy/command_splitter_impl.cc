@@ -196,6 +196,17 @@ SplitRequestPtr SimpleRequest::create(Router& router,
       new SimpleRequest(callbacks, command_stats, time_source, delay_command_latency)};
   const auto route = router.upstreamPool(incoming_request->asArray()[1].asString(), stream_info);
   if (route) {
+    // A cached read is answered right away, and not mirrored.
+    if (!callbacks.transaction().active_) {
+      Common::Redis::RespValuePtr cached_response =
+          route->upstream(incoming_request->asArray()[0].asString())
+              ->cachedRead(incoming_request->asArray()[1].asString(), *incoming_request);
+      if (cached_response != nullptr) {
+        request_ptr->updateStats(true);
+        callbacks.onResponse(std::move(cached_response));
+        return nullptr;
+      }
+    }
     Common::Redis::RespValueSharedPtr base_request = std::move(incoming_request);
     request_ptr->handle_ = makeSingleServerRequest(
         route, base_request->asArray()[0].asString(), base_request->asArray()[1].asString(),
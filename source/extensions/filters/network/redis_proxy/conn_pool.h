@@ -77,6 +77,14 @@ public:
   virtual Common::Redis::Client::PoolRequest*
   makeRequestToShard(uint16_t shard_index, RespVariant&& request, PoolCallbacks& callbacks,
                      Common::Redis::Client::Transaction& transaction) PURE;
+  /**
+   * Looks up the cached response of a read, if the read cache is configured.
+   * @param hash_key supplies the key of the request.
+   * @param request supplies the request.
+   * @return RespValuePtr a copy of the cached response, or nullptr if it is not cached.
+   */
+  virtual Common::Redis::RespValuePtr cachedRead(const std::string& hash_key,
+                                                 const Common::Redis::RespValue& request) PURE;
 };
 
 using InstanceSharedPtr = std::shared_ptr<Instance>;
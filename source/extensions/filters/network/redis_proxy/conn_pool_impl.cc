@@ -59,7 +59,12 @@ InstanceImpl::InstanceImpl(
       stats_scope_(std::move(stats_scope)), redis_command_stats_(redis_command_stats),
       redis_cluster_stats_{REDIS_CLUSTER_STATS(POOL_COUNTER(*stats_scope_))},
       refresh_manager_(std::move(refresh_manager)), dns_cache_(dns_cache),
-      aws_iam_authenticator_(aws_iam_authenticator), aws_iam_config_(aws_iam_config) {}
+      aws_iam_authenticator_(aws_iam_authenticator), aws_iam_config_(aws_iam_config) {
+  // The IAM authentication of a connection is not compatible with its switch to RESP3.
+  if (config.has_read_cache() && !aws_iam_config_.has_value()) {
+    read_cache_config_ = config.read_cache();
+  }
+}
 
 void InstanceImpl::init() {
   // Note: `this` and `cluster_name` have a a lifetime of the filter.
@@ -80,6 +85,14 @@ void InstanceImpl::init() {
 
 uint16_t InstanceImpl::shardSize() { return tls_->getTyped<ThreadLocalPool>().shardSize(); }
 
+Common::Redis::RespValuePtr InstanceImpl::cachedRead(const std::string&,
+                                                     const Common::Redis::RespValue& request) {
+  if (!read_cache_config_.has_value()) {
+    return nullptr;
+  }
+  return tls_->getTyped<ThreadLocalPool>().cachedRead(request);
+}
+
 // This method is always called from a InstanceSharedPtr we don't have to worry about tls_->getTyped
 // failing due to InstanceImpl going away.
 Common::Redis::Client::PoolRequest*
@@ -122,6 +135,10 @@ InstanceImpl::ThreadLocalPool::ThreadLocalPool(
       redis_cluster_stats_(parent->redis_cluster_stats_),
       refresh_manager_(parent->refresh_manager_), aws_iam_authenticator_(aws_iam_authenticator),
       aws_iam_config_(aws_iam_config) {
+  if (parent->read_cache_config_.has_value()) {
+    read_cache_ =
+        std::make_unique<ReadCache>(parent->read_cache_config_.value(), dispatcher.timeSource());
+  }
 
   cluster_update_handle_ = parent->cm_.addThreadLocalClusterUpdateCallbacks(*this);
   Upstream::ThreadLocalCluster* cluster = parent->cm_.getThreadLocalCluster(cluster_name_);
@@ -137,9 +154,16 @@ InstanceImpl::ThreadLocalPool::~ThreadLocalPool() {
   while (!pending_requests_.empty()) {
     pending_requests_.pop_front();
   }
+  closeClients();
+}
+
+void InstanceImpl::ThreadLocalPool::closeClients() {
   while (!client_map_.empty()) {
     client_map_.begin()->second->redis_client_->close();
   }
+  while (!tracking_client_map_.empty()) {
+    tracking_client_map_.begin()->second->redis_client_->close();
+  }
   while (!clients_to_drain_.empty()) {
     (*clients_to_drain_.begin())->redis_client_->close();
   }
@@ -201,11 +225,9 @@ void InstanceImpl::ThreadLocalPool::onClusterRemoval(const std::string& cluster_
   // Treat cluster removal as a removal of all hosts. Close all connections and fail all pending
   // requests.
   host_set_member_update_cb_handle_ = nullptr;
-  while (!client_map_.empty()) {
-    client_map_.begin()->second->redis_client_->close();
-  }
-  while (!clients_to_drain_.empty()) {
-    (*clients_to_drain_.begin())->redis_client_->close();
+  closeClients();
+  if (read_cache_ != nullptr) {
+    read_cache_->clear();
   }
 
   cluster_ = nullptr;
@@ -237,12 +259,15 @@ void InstanceImpl::ThreadLocalPool::onHostsRemoved(
     if (token_bucket != cx_rate_limiter_map_.end()) {
       cx_rate_limiter_map_.erase(token_bucket);
     }
-    auto it = client_map_.find(host);
-    if (it != client_map_.end()) {
+    for (auto* clients : {&client_map_, &tracking_client_map_}) {
+      auto it = clients->find(host);
+      if (it == clients->end()) {
+        continue;
+      }
       if (it->second->redis_client_->active()) {
         // Put the ThreadLocalActiveClient to the side to drain.
         clients_to_drain_.push_back(std::move(it->second));
-        client_map_.erase(it);
+        clients->erase(it);
         if (!drain_timer_->enabled()) {
           drain_timer_->enableTimer(std::chrono::seconds(1));
         }
@@ -271,14 +296,15 @@ void InstanceImpl::ThreadLocalPool::drainClients() {
 }
 
 InstanceImpl::ThreadLocalActiveClientPtr&
-InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstSharedPtr host) {
+InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstSharedPtr host,
+                                                       bool tracking) {
   TokenBucketPtr& rate_limiter = cx_rate_limiter_map_[host];
   if (config_->connectionRateLimitEnabled() && !rate_limiter) {
     rate_limiter = std::make_unique<TokenBucketImpl>(config_->connectionRateLimitPerSec(),
                                                      dispatcher_.timeSource(),
                                                      config_->connectionRateLimitPerSec());
   }
-  ThreadLocalActiveClientPtr& client = client_map_[host];
+  ThreadLocalActiveClientPtr& client = tracking ? tracking_client_map_[host] : client_map_[host];
   if (!client) {
     if (config_->connectionRateLimitEnabled() && rate_limiter->consume(1, false) == 0) {
       redis_cluster_stats_.connection_rate_limited_.inc();
@@ -293,11 +319,29 @@ InstanceImpl::ThreadLocalPool::threadLocalActiveClient(Upstream::HostConstShared
           credentials.password, false, aws_iam_config_, aws_iam_authenticator_);
 
       client->redis_client_->addConnectionCallbacks(*client);
+      if (tracking) {
+        client->tracking_ = true;
+        client->redis_client_->enableTracking(*client, *client);
+      }
     }
   }
   return client;
 }
 
+Common::Redis::RespValuePtr
+InstanceImpl::ThreadLocalPool::cachedRead(const Common::Redis::RespValue& request) {
+  if (read_cache_ == nullptr || !ReadCache::isCacheableRead(request)) {
+    return nullptr;
+  }
+  Common::Redis::RespValuePtr response = read_cache_->lookup(request.asArray()[1].asString());
+  if (response == nullptr) {
+    redis_cluster_stats_.read_cache_miss_.inc();
+  } else {
+    redis_cluster_stats_.read_cache_hit_.inc();
+  }
+  return response;
+}
+
 uint16_t InstanceImpl::ThreadLocalPool::shardSize() {
   if (cluster_ == nullptr) {
     ASSERT(client_map_.empty());
@@ -467,14 +511,21 @@ InstanceImpl::ThreadLocalPool::makeRequestToHost(Upstream::HostConstSharedPtr& h
   PendingRequest& pending_request = pending_requests_.back();
 
   if (!transaction.active_) {
-    ThreadLocalActiveClientPtr& client = this->threadLocalActiveClient(host);
+    // The reads of the read cache are sent on the tracking client of the host, so that their keys
+    // are tracked.
+    const bool tracking = read_cache_ != nullptr &&
+                          ReadCache::isCacheableRead(getRequest(pending_request.incoming_request_));
+    ThreadLocalActiveClientPtr& client = this->threadLocalActiveClient(host, tracking);
     if (!client) {
       ENVOY_LOG(debug, "redis connection is rate limited, erasing empty client");
       pending_request.request_handler_ = nullptr;
       onRequestCompleted();
-      client_map_.erase(host);
+      (tracking ? tracking_client_map_ : client_map_).erase(host);
       return nullptr;
     }
+    if (tracking) {
+      pending_request.tracking_client_ = client.get();
+    }
     pending_request.request_handler_ = client->redis_client_->makeRequest(
         getRequest(pending_request.incoming_request_), pending_request);
   } else {
@@ -503,10 +554,16 @@ void InstanceImpl::ThreadLocalPool::onRequestCompleted() {
 void InstanceImpl::ThreadLocalActiveClient::onEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
-    auto client_to_delete = parent_.client_map_.find(host_);
-    if (client_to_delete != parent_.client_map_.end()) {
+    if (tracking_) {
+      // The invalidations of the keys read on the connection are lost from now on. Its pending
+      // requests already failed.
+      parent_.read_cache_->clear();
+    }
+    auto& clients = tracking_ ? parent_.tracking_client_map_ : parent_.client_map_;
+    auto client_to_delete = clients.find(host_);
+    if (client_to_delete != clients.end() && client_to_delete->second.get() == this) {
       parent_.dispatcher_.deferredDelete(std::move(redis_client_));
-      parent_.client_map_.erase(client_to_delete);
+      clients.erase(client_to_delete);
     } else {
       for (auto it = parent_.clients_to_drain_.begin(); it != parent_.clients_to_drain_.end();
            it++) {
@@ -523,6 +580,21 @@ void InstanceImpl::ThreadLocalActiveClient::onEvent(Network::ConnectionEvent eve
   }
 }
 
+void InstanceImpl::ThreadLocalActiveClient::onPush(Common::Redis::RespValuePtr&& value) {
+  const uint64_t invalidated = parent_.read_cache_->invalidate(*value);
+  parent_.redis_cluster_stats_.read_cache_invalidated_.add(invalidated);
+}
+
+void InstanceImpl::ThreadLocalActiveClient::onResponse(Common::Redis::RespValuePtr&& value) {
+  // Hosts older than Redis 6 answer an error, and nothing is cached from them.
+  tracking_enabled_ =
+      value->type() == Common::Redis::RespType::SimpleString && value->asString() == "OK";
+  if (!tracking_enabled_) {
+    ENVOY_LOG(debug, "redis host {} does not support client tracking: {}",
+              host_->address()->asString(), value->toString());
+  }
+}
+
 InstanceImpl::PendingRequest::PendingRequest(InstanceImpl::ThreadLocalPool& parent,
                                              RespVariant&& incoming_request,
                                              PoolCallbacks& pool_callbacks,
@@ -544,6 +616,9 @@ InstanceImpl::PendingRequest::~PendingRequest() {
 
 void InstanceImpl::PendingRequest::onResponse(Common::Redis::RespValuePtr&& response) {
   request_handler_ = nullptr;
+  if (tracking_client_ != nullptr && tracking_client_->tracking_enabled_) {
+    parent_.read_cache_->insert(getRequest(incoming_request_).asArray()[1].asString(), *response);
+  }
   pool_callbacks_.onResponse(std::move(response));
   parent_.onRequestCompleted();
 }
@@ -558,6 +633,8 @@ void InstanceImpl::PendingRequest::onFailure() {
 void InstanceImpl::PendingRequest::onRedirection(Common::Redis::RespValuePtr&& value,
                                                  const std::string& host_address,
                                                  bool ask_redirection) {
+  // The redirected read is not tracked by the host that answers it.
+  tracking_client_ = nullptr;
   if (!parent_.dns_cache_) {
     doRedirection(std::move(value), host_address, ask_redirection);
     return;
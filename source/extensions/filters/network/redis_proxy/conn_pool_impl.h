@@ -28,6 +28,7 @@
 #include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/utility.h"
 #include "source/extensions/filters/network/redis_proxy/conn_pool.h"
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
 
 #include "absl/container/node_hash_map.h"
 
@@ -43,7 +44,10 @@ namespace ConnPool {
 #define REDIS_CLUSTER_STATS(COUNTER)                                                               \
   COUNTER(upstream_cx_drained)                                                                     \
   COUNTER(max_upstream_unknown_connections_reached)                                                \
-  COUNTER(connection_rate_limited)
+  COUNTER(connection_rate_limited)                                                                 \
+  COUNTER(read_cache_hit)                                                                          \
+  COUNTER(read_cache_miss)                                                                         \
+  COUNTER(read_cache_invalidated)
 
 struct RedisClusterStats {
   REDIS_CLUSTER_STATS(GENERATE_COUNTER_STRUCT)
@@ -77,6 +81,8 @@ public:
   Common::Redis::Client::PoolRequest*
   makeRequestToShard(uint16_t shard_index, RespVariant&& request, PoolCallbacks& callbacks,
                      Common::Redis::Client::Transaction& transaction) override;
+  Common::Redis::RespValuePtr cachedRead(const std::string& key,
+                                         const Common::Redis::RespValue& request) override;
   /**
    * Makes a redis request based on IP address and TCP port of the upstream host (e.g.,
    * moved/ask cluster redirection). This is now only kept mostly for testing.
@@ -98,7 +104,10 @@ public:
 private:
   struct ThreadLocalPool;
 
-  struct ThreadLocalActiveClient : public Network::ConnectionCallbacks {
+  struct ThreadLocalActiveClient : public Network::ConnectionCallbacks,
+                                   public Common::Redis::Client::PushCallbacks,
+                                   public Common::Redis::Client::ClientCallbacks,
+                                   public Logger::Loggable<Logger::Id::redis> {
     ThreadLocalActiveClient(ThreadLocalPool& parent) : parent_(parent) {}
 
     // Network::ConnectionCallbacks
@@ -106,9 +115,21 @@ private:
     void onAboveWriteBufferHighWatermark() override {}
     void onBelowWriteBufferLowWatermark() override {}
 
+    // Common::Redis::Client::PushCallbacks
+    void onPush(Common::Redis::RespValuePtr&& value) override;
+
+    // Common::Redis::Client::ClientCallbacks, of the CLIENT TRACKING request of a tracking client.
+    void onResponse(Common::Redis::RespValuePtr&& value) override;
+    void onFailure() override {}
+    void onRedirection(Common::Redis::RespValuePtr&&, const std::string&, bool) override {}
+
     ThreadLocalPool& parent_;
     Upstream::HostConstSharedPtr host_;
     Common::Redis::Client::ClientPtr redis_client_;
+    // Whether the client only reads the keys of the read cache, with client tracking on.
+    bool tracking_{false};
+    // Whether the host accepted to track the keys read by the client.
+    bool tracking_enabled_{false};
   };
 
   using ThreadLocalActiveClientPtr = std::unique_ptr<ThreadLocalActiveClient>;
@@ -146,6 +167,8 @@ private:
     Upstream::HostConstSharedPtr host_;
     Common::Redis::RespValuePtr resp_value_;
     bool ask_redirection_;
+    // The tracking client of the read cache sending the request, if its response can be cached.
+    ThreadLocalActiveClient* tracking_client_{};
     Extensions::Common::DynamicForwardProxy::DnsCache::LoadDnsCacheEntryHandlePtr
         cache_load_handle_;
   };
@@ -161,8 +184,10 @@ private:
         absl::optional<Common::Redis::AwsIamAuthenticator::AwsIamAuthenticatorSharedPtr>
             aws_iam_authenticator);
     ~ThreadLocalPool() override;
-    ThreadLocalActiveClientPtr& threadLocalActiveClient(Upstream::HostConstSharedPtr host);
+    ThreadLocalActiveClientPtr& threadLocalActiveClient(Upstream::HostConstSharedPtr host,
+                                                        bool tracking = false);
     uint16_t shardSize();
+    Common::Redis::RespValuePtr cachedRead(const Common::Redis::RespValue& request);
     Common::Redis::Client::PoolRequest*
     makeRequest(const std::string& key, RespVariant&& request, PoolCallbacks& callbacks,
                 Common::Redis::Client::Transaction& transaction);
@@ -180,6 +205,7 @@ private:
     void onHostsAdded(const std::vector<Upstream::HostSharedPtr>& hosts_added);
     void onHostsRemoved(const std::vector<Upstream::HostSharedPtr>& hosts_removed);
     void drainClients();
+    void closeClients();
 
     // Upstream::ClusterUpdateCallbacks
     void onClusterAddOrUpdate(absl::string_view cluster_name,
@@ -198,6 +224,10 @@ private:
     Upstream::ClusterUpdateCallbacksHandlePtr cluster_update_handle_;
     Upstream::ThreadLocalCluster* cluster_{};
     absl::node_hash_map<Upstream::HostConstSharedPtr, ThreadLocalActiveClientPtr> client_map_;
+    // The clients reading the keys of the read cache, apart from the others so that only the keys
+    // of GET commands are tracked.
+    absl::node_hash_map<Upstream::HostConstSharedPtr, ThreadLocalActiveClientPtr>
+        tracking_client_map_;
     absl::node_hash_map<Upstream::HostConstSharedPtr, TokenBucketPtr> cx_rate_limiter_map_;
     Envoy::Common::CallbackHandlePtr host_set_member_update_cb_handle_;
     absl::node_hash_map<std::string, Upstream::HostConstSharedPtr> host_address_map_;
@@ -223,6 +253,7 @@ private:
     absl::optional<Common::Redis::AwsIamAuthenticator::AwsIamAuthenticatorSharedPtr>
         aws_iam_authenticator_;
     absl::optional<envoy::extensions::filters::network::redis_proxy::v3::AwsIam> aws_iam_config_;
+    ReadCachePtr read_cache_;
   };
 
   const std::string cluster_name_;
@@ -239,6 +270,8 @@ private:
   absl::optional<Common::Redis::AwsIamAuthenticator::AwsIamAuthenticatorSharedPtr>
       aws_iam_authenticator_;
   absl::optional<envoy::extensions::filters::network::redis_proxy::v3::AwsIam> aws_iam_config_;
+  absl::optional<envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache>
+      read_cache_config_;
 };
 
 } // namespace ConnPool
@@ -0,0 +1,113 @@
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
+
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/match.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace ConnPool {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 10000;
+constexpr uint32_t DefaultMaxValueBytes = 64 * 1024;
+constexpr uint64_t DefaultTtlMs = 60000;
+
+} // namespace
+
+ReadCache::ReadCache(
+    const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache& config,
+    TimeSource& time_source)
+    : time_source_(time_source),
+      max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      max_value_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_value_bytes,
+                                                       DefaultMaxValueBytes)),
+      ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, ttl, DefaultTtlMs)) {}
+
+bool ReadCache::isCacheableRead(const Common::Redis::RespValue& request) {
+  if (request.type() != Common::Redis::RespType::Array || request.asArray().size() != 2) {
+    return false;
+  }
+  for (const Common::Redis::RespValue& value : request.asArray()) {
+    if (value.type() != Common::Redis::RespType::BulkString) {
+      return false;
+    }
+  }
+  return absl::EqualsIgnoreCase(request.asArray()[0].asString(), "get");
+}
+
+Common::Redis::RespValuePtr ReadCache::lookup(const std::string& key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  if (it->second->expiry_ <= time_source_.monotonicTime()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return std::make_unique<Common::Redis::RespValue>(it->second->response_);
+}
+
+void ReadCache::insert(const std::string& key, const Common::Redis::RespValue& response) {
+  // A value read again that is no longer cacheable must not be served stale either.
+  erase(key);
+  if (response.type() != Common::Redis::RespType::BulkString ||
+      response.asString().size() > max_value_bytes_) {
+    return;
+  }
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, response, time_source_.monotonicTime() + ttl_});
+  index_[key] = entries_.begin();
+}
+
+uint64_t ReadCache::invalidate(const Common::Redis::RespValue& push) {
+  if (push.type() != Common::Redis::RespType::Array || push.asArray().size() != 2 ||
+      push.asArray()[0].type() != Common::Redis::RespType::BulkString ||
+      push.asArray()[0].asString() != "invalidate") {
+    return 0;
+  }
+  const Common::Redis::RespValue& keys = push.asArray()[1];
+  if (keys.type() == Common::Redis::RespType::Null) {
+    const uint64_t evicted = index_.size();
+    clear();
+    return evicted;
+  }
+  if (keys.type() != Common::Redis::RespType::Array) {
+    return 0;
+  }
+  uint64_t evicted = 0;
+  for (const Common::Redis::RespValue& key : keys.asArray()) {
+    if (key.type() == Common::Redis::RespType::BulkString && index_.contains(key.asString())) {
+      erase(key.asString());
+      evicted++;
+    }
+  }
+  return evicted;
+}
+
+void ReadCache::clear() {
+  index_.clear();
+  entries_.clear();
+}
+
+void ReadCache::erase(const std::string& key) {
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+} // namespace ConnPool
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+
+#include "source/extensions/filters/network/common/redis/codec.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace ConnPool {
+
+/**
+ * The cached GET responses of a worker thread, evicted in least recently used order, when they
+ * expire, or when their invalidation is pushed by the host tracking them. Not thread safe.
+ */
+class ReadCache {
+public:
+  ReadCache(
+      const envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache& config,
+      TimeSource& time_source);
+
+  /**
+   * @return whether the response of a request can be cached, only that of GET commands.
+   */
+  static bool isCacheableRead(const Common::Redis::RespValue& request);
+
+  /**
+   * @return a copy of the cached response of a key, or nullptr if there is none or it expired.
+   */
+  Common::Redis::RespValuePtr lookup(const std::string& key);
+
+  /**
+   * Caches the response of a key, replacing any previous one. Only the bulk strings of at most the
+   * max value bytes are cached.
+   */
+  void insert(const std::string& key, const Common::Redis::RespValue& response);
+
+  /**
+   * Evicts the keys of a push of invalidation, ["invalidate", [key ...]], or all the keys if its
+   * keys are null, as when the host flushed its databases. The other pushes are ignored.
+   * @return the number of keys evicted.
+   */
+  uint64_t invalidate(const Common::Redis::RespValue& push);
+
+  void clear();
+  size_t size() const { return index_.size(); }
+
+private:
+  struct Entry {
+    const std::string key_;
+    const Common::Redis::RespValue response_;
+    const MonotonicTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  void erase(const std::string& key);
+
+  TimeSource& time_source_;
+  const uint32_t max_entries_;
+  const uint32_t max_value_bytes_;
+  const std::chrono::milliseconds ttl_;
+  // The most recently used entries first.
+  EntryList entries_;
+  absl::flat_hash_map<std::string, EntryList::iterator> index_;
+};
+
+using ReadCachePtr = std::unique_ptr<ReadCache>;
+
+} // namespace ConnPool
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
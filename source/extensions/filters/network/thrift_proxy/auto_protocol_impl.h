@@ -37,6 +37,9 @@ public:
   bool peekReplyPayload(Buffer::Instance& buffer, ReplyType& reply_type) override {
     return protocol_->peekReplyPayload(buffer, reply_type);
   }
+  bool peekStructLength(Buffer::Instance& buffer, uint64_t& length) override {
+    return protocol_->peekStructLength(buffer, length);
+  }
   bool readStructBegin(Buffer::Instance& buffer, std::string& name) override {
     return protocol_->readStructBegin(buffer, name);
   }
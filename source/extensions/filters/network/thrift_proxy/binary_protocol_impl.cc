@@ -17,6 +17,110 @@ namespace ThriftProxy {
 
 const uint16_t BinaryProtocolImpl::Magic = 0x8001;
 
+namespace {
+
+// Advances offset past length bytes, or returns false if they are not all in the buffer.
+bool skipBytes(Buffer::Instance& buffer, uint64_t& offset, uint64_t length) {
+  offset += length;
+  return buffer.length() >= offset;
+}
+
+bool skipBinaryValue(Buffer::Instance& buffer, FieldType field_type, uint64_t& offset,
+                     uint32_t depth);
+
+bool skipBinaryStruct(Buffer::Instance& buffer, uint64_t& offset, uint32_t depth) {
+  while (true) {
+    if (buffer.length() < offset + 1) {
+      return false;
+    }
+    const FieldType field_type = static_cast<FieldType>(buffer.peekInt<int8_t>(offset));
+    offset += 1;
+    if (field_type == FieldType::Stop) {
+      return true;
+    }
+    // Skip the field id.
+    if (!skipBytes(buffer, offset, 2) || !skipBinaryValue(buffer, field_type, offset, depth)) {
+      return false;
+    }
+  }
+}
+
+bool skipBinaryValue(Buffer::Instance& buffer, FieldType field_type, uint64_t& offset,
+                     uint32_t depth) {
+  if (depth >= Protocol::MaxPeekDepth) {
+    throw EnvoyException(
+        fmt::format("binary protocol struct exceeds the nesting limit {}", Protocol::MaxPeekDepth));
+  }
+
+  switch (field_type) {
+  case FieldType::Bool:
+  case FieldType::Byte:
+    return skipBytes(buffer, offset, 1);
+  case FieldType::I16:
+    return skipBytes(buffer, offset, 2);
+  case FieldType::I32:
+    return skipBytes(buffer, offset, 4);
+  case FieldType::I64:
+  case FieldType::Double:
+    return skipBytes(buffer, offset, 8);
+  case FieldType::String: {
+    if (buffer.length() < offset + 4) {
+      return false;
+    }
+    const int32_t str_len = buffer.peekBEInt<int32_t>(offset);
+    if (str_len < 0) {
+      throw EnvoyException(
+          fmt::format("negative binary protocol string/binary length {}", str_len));
+    }
+    return skipBytes(buffer, offset, 4 + static_cast<uint64_t>(str_len));
+  }
+  case FieldType::Struct:
+    return skipBinaryStruct(buffer, offset, depth + 1);
+  case FieldType::Map: {
+    if (buffer.length() < offset + 6) {
+      return false;
+    }
+    const FieldType key_type = static_cast<FieldType>(buffer.peekInt<int8_t>(offset));
+    const FieldType value_type = static_cast<FieldType>(buffer.peekInt<int8_t>(offset + 1));
+    const int32_t size = buffer.peekBEInt<int32_t>(offset + 2);
+    if (size < 0) {
+      throw EnvoyException(absl::StrCat("negative binary protocol map size ", size));
+    }
+    offset += 6;
+    for (int32_t i = 0; i < size; i++) {
+      if (!skipBinaryValue(buffer, key_type, offset, depth + 1) ||
+          !skipBinaryValue(buffer, value_type, offset, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  case FieldType::List:
+  case FieldType::Set: {
+    if (buffer.length() < offset + 5) {
+      return false;
+    }
+    const FieldType elem_type = static_cast<FieldType>(buffer.peekInt<int8_t>(offset));
+    const int32_t size = buffer.peekBEInt<int32_t>(offset + 1);
+    if (size < 0) {
+      throw EnvoyException(fmt::format("negative binary protocol list/set size {}", size));
+    }
+    offset += 5;
+    for (int32_t i = 0; i < size; i++) {
+      if (!skipBinaryValue(buffer, elem_type, offset, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default:
+    throw EnvoyException(
+        fmt::format("unknown binary protocol field type {}", static_cast<int8_t>(field_type)));
+  }
+}
+
+} // namespace
+
 bool BinaryProtocolImpl::readMessageBegin(Buffer::Instance& buffer, MessageMetadata& metadata) {
   if (buffer.length() < MinMessageBeginLength) {
     return false;
@@ -85,6 +189,15 @@ bool BinaryProtocolImpl::peekReplyPayload(Buffer::Instance& buffer, ReplyType& r
   return true;
 }
 
+bool BinaryProtocolImpl::peekStructLength(Buffer::Instance& buffer, uint64_t& length) {
+  uint64_t offset = 0;
+  if (!skipBinaryStruct(buffer, offset, 0)) {
+    return false;
+  }
+  length = offset;
+  return true;
+}
+
 bool BinaryProtocolImpl::readStructBegin(Buffer::Instance& buffer, std::string& name) {
   UNREFERENCED_PARAMETER(buffer);
   name.clear(); // binary protocol does not transmit struct names
@@ -27,6 +27,7 @@ public:
   bool readMessageBegin(Buffer::Instance& buffer, MessageMetadata& metadata) override;
   bool readMessageEnd(Buffer::Instance& buffer) override;
   bool peekReplyPayload(Buffer::Instance& buffer, ReplyType& reply_type) override;
+  bool peekStructLength(Buffer::Instance& buffer, uint64_t& length) override;
   bool readStructBegin(Buffer::Instance& buffer, std::string& name) override;
   bool readStructEnd(Buffer::Instance& buffer) override;
   bool readFieldBegin(Buffer::Instance& buffer, std::string& name, FieldType& field_type,
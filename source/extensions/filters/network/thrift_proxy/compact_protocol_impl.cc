@@ -121,6 +121,172 @@ bool CompactProtocolImpl::peekReplyPayload(Buffer::Instance& buffer, ReplyType&
   return true;
 }
 
+bool CompactProtocolImpl::peekStructLength(Buffer::Instance& buffer, uint64_t& length) {
+  uint64_t offset = 0;
+  if (!skipStruct(buffer, offset, 0)) {
+    return false;
+  }
+  length = offset;
+  return true;
+}
+
+namespace {
+
+// Advances offset past a var int of at most 10 bytes (an int64_t), or returns false if it is not
+// all in the buffer.
+bool skipVarInt(Buffer::Instance& buffer, uint64_t& offset) {
+  for (int i = 0; i < 10; i++) {
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    const uint8_t byte = buffer.peekInt<uint8_t>(offset);
+    offset++;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  throw EnvoyException("invalid compact protocol var int");
+}
+
+} // namespace
+
+bool CompactProtocolImpl::skipStruct(Buffer::Instance& buffer, uint64_t& offset,
+                                     uint32_t depth) {
+  while (true) {
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    const uint8_t delta_and_type = buffer.peekInt<uint8_t>(offset);
+    offset++;
+    const CompactFieldType compact_field_type =
+        static_cast<CompactFieldType>(delta_and_type & 0x0F);
+    if (compact_field_type == CompactFieldType::Stop) {
+      return true;
+    }
+    // A long-form field header is followed by the zig-zag field id.
+    if ((delta_and_type >> 4) == 0 && !skipVarInt(buffer, offset)) {
+      return false;
+    }
+    // The value of a boolean field is its type.
+    if (compact_field_type == CompactFieldType::BoolTrue ||
+        compact_field_type == CompactFieldType::BoolFalse) {
+      continue;
+    }
+    if (!skipValue(buffer, convertCompactFieldType(compact_field_type), offset, depth)) {
+      return false;
+    }
+  }
+}
+
+bool CompactProtocolImpl::skipValue(Buffer::Instance& buffer, FieldType field_type,
+                                    uint64_t& offset, uint32_t depth) {
+  if (depth >= MaxPeekDepth) {
+    throw EnvoyException(
+        fmt::format("compact protocol struct exceeds the nesting limit {}", MaxPeekDepth));
+  }
+
+  switch (field_type) {
+  case FieldType::Bool:
+  case FieldType::Byte:
+    // The booleans of the containers are encoded as a byte.
+    offset += 1;
+    return buffer.length() >= offset;
+  case FieldType::I16:
+  case FieldType::I32:
+  case FieldType::I64:
+    return skipVarInt(buffer, offset);
+  case FieldType::Double:
+    offset += 8;
+    return buffer.length() >= offset;
+  case FieldType::String: {
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    int len_size;
+    const int32_t str_len = BufferHelper::peekVarIntI32(buffer, offset, len_size);
+    if (len_size < 0) {
+      return false;
+    }
+    if (str_len < 0) {
+      throw EnvoyException(
+          fmt::format("negative compact protocol string/binary length {}", str_len));
+    }
+    offset += len_size + static_cast<uint64_t>(str_len);
+    return buffer.length() >= offset;
+  }
+  case FieldType::Struct:
+    return skipStruct(buffer, offset, depth + 1);
+  case FieldType::Map: {
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    int size_size;
+    const int32_t size = BufferHelper::peekVarIntI32(buffer, offset, size_size);
+    if (size_size < 0) {
+      return false;
+    }
+    if (size < 0) {
+      throw EnvoyException(absl::StrCat("negative compact protocol map size ", size));
+    }
+    offset += size_size;
+    if (size == 0) {
+      // Empty map. Compact protocol provides no type information in this case.
+      return true;
+    }
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    const uint8_t types = buffer.peekInt<uint8_t>(offset);
+    offset++;
+    const FieldType key_type = convertCompactFieldType(static_cast<CompactFieldType>(types >> 4));
+    const FieldType value_type =
+        convertCompactFieldType(static_cast<CompactFieldType>(types & 0x0F));
+    for (int32_t i = 0; i < size; i++) {
+      if (!skipValue(buffer, key_type, offset, depth + 1) ||
+          !skipValue(buffer, value_type, offset, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  case FieldType::List:
+  case FieldType::Set: {
+    if (buffer.length() <= offset) {
+      return false;
+    }
+    const uint8_t size_and_type = buffer.peekInt<uint8_t>(offset);
+    offset++;
+    int32_t size = size_and_type >> 4;
+    if (size == 0x0F) {
+      // Long form list header: type byte followed by var int size.
+      if (buffer.length() <= offset) {
+        return false;
+      }
+      int size_size;
+      size = BufferHelper::peekVarIntI32(buffer, offset, size_size);
+      if (size_size < 0) {
+        return false;
+      }
+      if (size < 0) {
+        throw EnvoyException(fmt::format("negative compact protocol list/set size {}", size));
+      }
+      offset += size_size;
+    }
+    const FieldType elem_type =
+        convertCompactFieldType(static_cast<CompactFieldType>(size_and_type & 0x0F));
+    for (int32_t i = 0; i < size; i++) {
+      if (!skipValue(buffer, elem_type, offset, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  default:
+    throw EnvoyException(
+        fmt::format("unknown compact protocol field type {}", static_cast<int8_t>(field_type)));
+  }
+}
+
 bool CompactProtocolImpl::readStructBegin(Buffer::Instance& buffer, std::string& name) {
   UNREFERENCED_PARAMETER(buffer);
   name.clear(); // compact protocol does not transmit struct names
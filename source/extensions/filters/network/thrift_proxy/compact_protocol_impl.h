@@ -30,6 +30,7 @@ public:
   bool readMessageBegin(Buffer::Instance& buffer, MessageMetadata& metadata) override;
   bool readMessageEnd(Buffer::Instance& buffer) override;
   bool peekReplyPayload(Buffer::Instance& buffer, ReplyType& reply_type) override;
+  bool peekStructLength(Buffer::Instance& buffer, uint64_t& length) override;
   bool readStructBegin(Buffer::Instance& buffer, std::string& name) override;
   bool readStructEnd(Buffer::Instance& buffer) override;
   bool readFieldBegin(Buffer::Instance& buffer, std::string& name, FieldType& field_type,
@@ -95,6 +96,10 @@ private:
   FieldType convertCompactFieldType(CompactFieldType compact_field_type);
   CompactFieldType convertFieldType(FieldType field_type);
 
+  // Advance offset past the encoded struct or value, or return false if more data is required.
+  bool skipStruct(Buffer::Instance& buffer, uint64_t& offset, uint32_t depth);
+  bool skipValue(Buffer::Instance& buffer, FieldType field_type, uint64_t& offset, uint32_t depth);
+
   void writeFieldBeginInternal(Buffer::Instance& buffer, FieldType field_type, int16_t field_id,
                                absl::optional<CompactFieldType> field_type_override);
 
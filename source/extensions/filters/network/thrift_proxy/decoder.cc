@@ -16,12 +16,22 @@ namespace ThriftProxy {
 // PassthroughData -> PassthroughData
 // PassthroughData -> MessageEnd (all body bytes received)
 DecoderStateMachine::DecoderStatus DecoderStateMachine::passthroughData(Buffer::Instance& buffer) {
-  if (body_bytes_ > buffer.length()) {
+  if (!body_bytes_.has_value()) {
+    // Without a frame size, as with the unframed transport, the payload is a single struct whose
+    // length is peeked at without decoding it.
+    uint64_t struct_length;
+    if (!proto_.peekStructLength(buffer, struct_length)) {
+      return {ProtocolState::WaitForData};
+    }
+    body_bytes_ = struct_length;
+  }
+
+  if (body_bytes_.value() > buffer.length()) {
     return {ProtocolState::WaitForData};
   }
 
   Buffer::OwnedImpl body;
-  body.move(buffer, body_bytes_);
+  body.move(buffer, body_bytes_.value());
 
   return {ProtocolState::MessageEnd, handler_.passthroughData(body)};
 }
@@ -49,7 +59,10 @@ DecoderStateMachine::DecoderStatus DecoderStateMachine::handleMessageBegin() {
   const auto status = handler_.messageBegin(metadata_);
 
   if (callbacks_.passthroughEnabled()) {
-    body_bytes_ = metadata_->frameSize() - body_start_;
+    body_bytes_.reset();
+    if (metadata_->hasFrameSize()) {
+      body_bytes_ = metadata_->frameSize() - body_start_;
+    }
     return {ProtocolState::PassthroughData, status};
   }
 
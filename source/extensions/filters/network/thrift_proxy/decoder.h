@@ -8,6 +8,8 @@
 #include "source/extensions/filters/network/thrift_proxy/protocol.h"
 #include "source/extensions/filters/network/thrift_proxy/transport.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace NetworkFilters {
@@ -184,7 +186,8 @@ private:
   ProtocolState state_{ProtocolState::MessageBegin};
   std::vector<Frame> stack_;
   uint32_t body_start_{};
-  uint32_t body_bytes_{};
+  // The length of the passthrough data, peeked at from the data when the frame size is unknown.
+  absl::optional<uint64_t> body_bytes_;
 };
 
 using DecoderStateMachinePtr = std::unique_ptr<DecoderStateMachine>;
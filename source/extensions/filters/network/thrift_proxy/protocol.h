@@ -83,6 +83,19 @@ public:
    */
   virtual bool peekReplyPayload(Buffer::Instance& buffer, ReplyType& reply_type) PURE;
 
+  /**
+   * Peeks at the length of the Thrift struct at the start of the buffer, without decoding it nor
+   * draining the buffer. This allows passing through the payload of a message without a frame size.
+   * @param buffer the buffer to peek from
+   * @param length updated with the length of the struct, its stop field included, on success only
+   * @return true if the whole struct is in the buffer, false if more data is required
+   * @throw EnvoyException if the data is not a valid struct
+   */
+  virtual bool peekStructLength(Buffer::Instance& buffer, uint64_t& length) PURE;
+
+  // The maximum nesting of the structs and containers peeked at by peekStructLength.
+  static constexpr uint32_t MaxPeekDepth = 64;
+
   /**
    * Reads the start of a Thrift struct from the buffer and updates the name parameter with the
    * value from the struct header. If successful, the struct header is removed from the buffer.
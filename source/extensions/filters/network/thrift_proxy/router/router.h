@@ -13,6 +13,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/logger.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/filters/network/thrift_proxy/app_exception_impl.h"
 #include "source/extensions/filters/network/thrift_proxy/metadata.h"
 #include "source/extensions/filters/network/thrift_proxy/protocol_converter.h"
@@ -577,10 +578,17 @@ protected:
               absl::nullopt};
     }
 
-    const auto passthrough_supported =
-        (transport == TransportType::Framed || transport == TransportType::Header) &&
-        (final_transport == TransportType::Framed || final_transport == TransportType::Header) &&
-        protocol == final_protocol && final_protocol != ProtocolType::Twitter;
+    // The payload of an unframed message is passed through once its length is peeked at.
+    const bool unframed_passthrough = Runtime::runtimeFeatureEnabled(
+        "envoy.reloadable_features.thrift_unframed_payload_passthrough");
+    const auto passthrough_transport = [unframed_passthrough](TransportType transport_type) {
+      return transport_type == TransportType::Framed || transport_type == TransportType::Header ||
+             (unframed_passthrough && transport_type == TransportType::Unframed);
+    };
+    const auto passthrough_supported = passthrough_transport(transport) &&
+                                       passthrough_transport(final_transport) &&
+                                       protocol == final_protocol &&
+                                       final_protocol != ProtocolType::Twitter;
     UpstreamRequestInfo result = {passthrough_supported, final_transport, final_protocol,
                                   conn_pool_data};
     return {absl::nullopt, result};
@@ -0,0 +1,72 @@
+#include "source/extensions/filters/udp/dns_filter/dns_answer_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace DnsFilter {
+
+namespace {
+
+// The ID is the first field of the DNS header.
+constexpr size_t IdLength = sizeof(uint16_t);
+
+} // namespace
+
+std::string DnsAnswerCache::key(const Buffer::Instance& query) {
+  if (query.length() <= IdLength) {
+    return {};
+  }
+  std::string key(query.length() - IdLength, '\0');
+  query.copyOut(IdLength, key.size(), key.data());
+  return key;
+}
+
+bool DnsAnswerCache::lookup(const std::string& key, uint16_t query_id,
+                            Buffer::Instance& response) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return false;
+  }
+  if (it->second->expiry_ <= time_source_.monotonicTime()) {
+    erase(it);
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+
+  const std::string& cached_response = it->second->response_;
+  response.writeBEInt<uint16_t>(query_id);
+  response.add(cached_response.data() + IdLength, cached_response.size() - IdLength);
+  return true;
+}
+
+void DnsAnswerCache::insert(const std::string& key, const Buffer::Instance& response,
+                            std::chrono::seconds ttl) {
+  if (key.empty() || response.length() <= IdLength) {
+    return;
+  }
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    erase(it);
+  }
+  if (ttl <= std::chrono::seconds::zero()) {
+    return;
+  }
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, response.toString(), time_source_.monotonicTime() + ttl});
+  index_.emplace(entries_.front().key_, entries_.begin());
+}
+
+void DnsAnswerCache::erase(
+    absl::flat_hash_map<absl::string_view, EntryList::iterator>::iterator it) {
+  const EntryList::iterator entry = it->second;
+  index_.erase(it);
+  entries_.erase(entry);
+}
+
+} // namespace DnsFilter
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/buffer/buffer.h"
+#include "envoy/common/time.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace DnsFilter {
+
+/**
+ * A bounded cache of the serialized responses sent by a DNS filter, keyed by the contents of the
+ * queries they answer other than their ID. The responses expire after their TTL and are evicted in
+ * least recently used order. This class is not thread safe, each worker has its own cache.
+ */
+class DnsAnswerCache {
+public:
+  DnsAnswerCache(uint32_t max_entries, TimeSource& time_source)
+      : max_entries_(max_entries), time_source_(time_source) {}
+
+  /**
+   * @return the key of a query in the cache, or an empty string if the query is too short to have
+   *         one.
+   */
+  static std::string key(const Buffer::Instance& query);
+
+  /**
+   * Copies the cached response to a query into a buffer, with the ID of the query.
+   * @param key the key of the query.
+   * @param query_id the ID of the query.
+   * @param response the buffer receiving the response.
+   * @return whether a response was found.
+   */
+  bool lookup(const std::string& key, uint16_t query_id, Buffer::Instance& response);
+
+  /**
+   * Caches the response to a query, replacing any previous one.
+   */
+  void insert(const std::string& key, const Buffer::Instance& response, std::chrono::seconds ttl);
+
+  size_t size() const { return index_.size(); }
+
+private:
+  struct Entry {
+    std::string key_;
+    std::string response_;
+    MonotonicTime expiry_;
+  };
+  using EntryList = std::list<Entry>;
+
+  void erase(absl::flat_hash_map<absl::string_view, EntryList::iterator>::iterator it);
+
+  const uint32_t max_entries_;
+  TimeSource& time_source_;
+  // The most recently used entries first. The index keys point to the keys of the entries.
+  EntryList entries_;
+  absl::flat_hash_map<absl::string_view, EntryList::iterator> index_;
+};
+
+using DnsAnswerCachePtr = std::unique_ptr<DnsAnswerCache>;
+
+} // namespace DnsFilter
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -20,6 +20,8 @@ namespace DnsFilter {
 
 static constexpr std::chrono::milliseconds DEFAULT_RESOLVER_TIMEOUT{500};
 static constexpr std::chrono::seconds DEFAULT_RESOLVER_TTL{300};
+static constexpr uint32_t DEFAULT_ANSWER_CACHE_MAX_ENTRIES{4096};
+static constexpr std::chrono::milliseconds DEFAULT_NEGATIVE_ANSWER_TTL{30000};
 
 DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
     Server::Configuration::ListenerFactoryContext& context,
@@ -206,6 +208,17 @@ DnsFilterEnvoyConfig::DnsFilterEnvoyConfig(
         AccessLog::AccessLogFactory::fromProto(log_config, context, std::move(command_parsers));
     access_logs_.push_back(current_access_log);
   }
+
+  // The cached responses would bypass the access logs.
+  if (config.has_answer_cache() && access_logs_.empty()) {
+    const auto& answer_cache = config.answer_cache();
+    answer_cache_max_entries_ = PROTOBUF_GET_WRAPPED_OR_DEFAULT(answer_cache, max_entries,
+                                                                DEFAULT_ANSWER_CACHE_MAX_ENTRIES);
+    negative_answer_ttl_ =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::milliseconds(
+            PROTOBUF_GET_MS_OR_DEFAULT(answer_cache, negative_ttl,
+                                       DEFAULT_NEGATIVE_ANSWER_TTL.count())));
+  }
 }
 
 void DnsFilterEnvoyConfig::addEndpointToSuffix(const absl::string_view suffix,
@@ -270,6 +283,13 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
       return;
     }
 
+    // Only the responses of the upstream resolvers are cached, not those to the queries which timed
+    // out or could not be sent.
+    if (!context->resolved_upstream_ ||
+        context->resolution_status_ != Network::DnsResolver::ResolutionStatus::Completed) {
+      context->answer_cache_key_.clear();
+    }
+
     config_->stats().externally_resolved_queries_.inc();
     if (iplist.empty()) {
       config_->stats().unanswered_queries_.inc();
@@ -288,12 +308,37 @@ DnsFilter::DnsFilter(Network::UdpReadFilterCallbacks& callbacks,
       resolver_callback_, config->resolverTimeout(), listener_.dispatcher(),
       config->maxPendingLookups(), config->typedDnsResolverConfig(), config->dnsResolverFactory(),
       config->api());
+
+  if (config_->answerCacheMaxEntries() > 0) {
+    answer_cache_ = std::make_unique<DnsAnswerCache>(config_->answerCacheMaxEntries(),
+                                                     listener_.dispatcher().timeSource());
+  }
 }
 
 Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
   config_->stats().downstream_rx_bytes_.recordValue(client_request.buffer_->length());
   config_->stats().downstream_rx_queries_.inc();
 
+  // Send the cached response to the same query if there is one, only patching its ID.
+  std::string answer_cache_key;
+  if (answer_cache_ != nullptr) {
+    answer_cache_key = DnsAnswerCache::key(*client_request.buffer_);
+    if (!answer_cache_key.empty()) {
+      Buffer::OwnedImpl response;
+      if (answer_cache_->lookup(answer_cache_key, client_request.buffer_->peekBEInt<uint16_t>(0),
+                                response)) {
+        config_->stats().answer_cache_hits_.inc();
+        config_->stats().downstream_tx_responses_.inc();
+        config_->stats().downstream_tx_bytes_.recordValue(response.length());
+        Network::UdpSendData response_data{client_request.addresses_.local_->ip(),
+                                           *client_request.addresses_.peer_, response};
+        listener_.send(response_data);
+        return Network::FilterStatus::StopIteration;
+      }
+      config_->stats().answer_cache_misses_.inc();
+    }
+  }
+
   // Setup counters for the parser
   DnsParserCounters parser_counters(
       config_->stats().query_buffer_underflow_, config_->stats().record_name_overflow_,
@@ -303,6 +348,7 @@ Network::FilterStatus DnsFilter::onData(Network::UdpRecvData& client_request) {
   // Parse the query, if it fails return an response to the client
   DnsQueryContextPtr query_context =
       message_parser_.createQueryContext(client_request, parser_counters);
+  query_context->answer_cache_key_ = std::move(answer_cache_key);
   incrementQueryTypeCount(query_context->queries_);
   if (!query_context->parse_status_) {
     config_->stats().downstream_rx_invalid_queries_.inc();
@@ -328,6 +374,7 @@ void DnsFilter::sendDnsResponse(DnsQueryContextPtr query_context) {
   // Serializes the generated response to the parsed query from the client. If there is a
   // parsing error or the incoming query is invalid, we will still generate a valid DNS response
   message_parser_.buildResponseBuffer(query_context, response);
+  cacheResponse(*query_context, response);
   config_->stats().downstream_tx_responses_.inc();
   config_->stats().downstream_tx_bytes_.recordValue(response.length());
 
@@ -339,6 +386,28 @@ void DnsFilter::sendDnsResponse(DnsQueryContextPtr query_context) {
   listener_.send(response_data);
 }
 
+void DnsFilter::cacheResponse(const DnsQueryContext& context, const Buffer::Instance& response) {
+  if (answer_cache_ == nullptr || context.answer_cache_key_.empty() || !context.parse_status_ ||
+      context.queries_.size() != 1) {
+    return;
+  }
+
+  std::chrono::seconds ttl = config_->negativeAnswerTtl();
+  if (!context.answers_.empty()) {
+    ttl = std::chrono::seconds::max();
+    for (const auto& answer : context.answers_) {
+      ttl = std::min(ttl, answer.second->ttl_);
+    }
+    for (const auto& additional : context.additional_) {
+      ttl = std::min(ttl, additional.second->ttl_);
+    }
+  }
+  if (context.resolved_upstream_) {
+    ttl = std::min(ttl, context.upstream_ttl_);
+  }
+  answer_cache_->insert(context.answer_cache_key_, response, ttl);
+}
+
 DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context) {
   /* It appears to be a rare case where we would have more than one query in a single request.
    * It is allowed by the protocol but not widely supported:
@@ -356,6 +425,8 @@ DnsLookupResponseCode DnsFilter::getResponseForQuery(DnsQueryContextPtr& context
     if (isKnownDomain(query->name_) || !forward_queries) {
       // Determine whether the name is a cluster. Move on to the next query if successful
       if (resolveViaClusters(context, *query)) {
+        // The endpoints of the cluster may change at any time.
+        context->answer_cache_key_.clear();
         continue;
       }
 
@@ -13,6 +13,7 @@
 #include "source/common/network/socket_impl.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/extensions/filters/udp/dns_filter/dns_answer_cache.h"
 #include "source/extensions/filters/udp/dns_filter/dns_filter_resolver.h"
 #include "source/extensions/filters/udp/dns_filter/dns_parser.h"
 
@@ -30,6 +31,8 @@ inline constexpr absl::string_view DnsFilterName = "envoy.filters.udp.dns_filter
  */
 #define ALL_DNS_FILTER_STATS(COUNTER, HISTOGRAM)                                                   \
   COUNTER(a_record_queries)                                                                        \
+  COUNTER(answer_cache_hits)                                                                       \
+  COUNTER(answer_cache_misses)                                                                     \
   COUNTER(aaaa_record_queries)                                                                     \
   COUNTER(srv_record_queries)                                                                      \
   COUNTER(cluster_a_record_answers)                                                                \
@@ -105,6 +108,9 @@ public:
   Api::Api& api() const { return api_; }
   const RadixTree<DnsVirtualDomainConfigSharedPtr>& getDnsTrie() const { return dns_lookup_trie_; }
   const AccessLog::InstanceSharedPtrVector& accessLogs() const { return access_logs_; }
+  // The maximum number of responses cached by each filter, or 0 if they are not cached.
+  uint32_t answerCacheMaxEntries() const { return answer_cache_max_entries_; }
+  std::chrono::seconds negativeAnswerTtl() const { return negative_answer_ttl_; }
 
 private:
   static DnsFilterStats generateStats(const std::string& stat_prefix, Stats::Scope& scope) {
@@ -138,6 +144,8 @@ private:
   envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config_;
   Network::DnsResolverFactory* dns_resolver_factory_;
   AccessLog::InstanceSharedPtrVector access_logs_;
+  uint32_t answer_cache_max_entries_{0};
+  std::chrono::seconds negative_answer_ttl_{0};
 };
 
 using DnsFilterEnvoyConfigSharedPtr = std::shared_ptr<const DnsFilterEnvoyConfig>;
@@ -171,6 +179,14 @@ private:
    */
   void sendDnsResponse(DnsQueryContextPtr context);
 
+  /**
+   * Caches the response to a query if it is cacheable, for the lowest TTL of its records.
+   *
+   * @param context the context of the query
+   * @param response the serialized response
+   */
+  void cacheResponse(const DnsQueryContext& context, const Buffer::Instance& response);
+
   /**
    * @brief Encapsulates all of the logic required to find an answer for a DNS query
    *
@@ -392,6 +408,7 @@ private:
   Network::Address::InstanceConstSharedPtr local_;
   Network::Address::InstanceConstSharedPtr peer_;
   DnsFilterResolverCallback resolver_callback_;
+  DnsAnswerCachePtr answer_cache_;
 };
 
 } // namespace DnsFilter
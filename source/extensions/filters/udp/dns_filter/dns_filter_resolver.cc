@@ -86,11 +86,15 @@ void DnsFilterResolver::resolveExternalQuery(DnsQueryContextPtr context,
                        ctx.query_context->resolution_status_ = status;
                        ctx.resolver_status = DnsFilterResolverStatus::Complete;
 
-                       // C-ares doesn't expose the TTL in the data available here.
+                       // The answer records use the configured TTL of the domain, the upstream
+                       // TTLs only bound how long the response may be cached.
                        if (status == Network::DnsResolver::ResolutionStatus::Completed) {
+                         ctx.query_context->resolved_upstream_ = true;
                          ctx.resolved_hosts.reserve(response.size());
                          for (const auto& resp : response) {
                            const auto& addrinfo = resp.addrInfo();
+                           ctx.query_context->upstream_ttl_ =
+                               std::min(ctx.query_context->upstream_ttl_, addrinfo.ttl_);
                            ASSERT(addrinfo.address_ != nullptr);
                            ENVOY_LOG(trace, "Resolved address: {} for {}",
                                      addrinfo.address_->ip()->addressAsString(),
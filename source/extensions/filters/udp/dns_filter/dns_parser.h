@@ -208,6 +208,12 @@ public:
   DnsAnswerMap answers_;
   DnsAnswerMap additional_;
   bool in_callback_;
+  // The key of the query in the answer cache, empty if its response is not to be cached.
+  std::string answer_cache_key_;
+  // Whether the query was answered by an upstream resolver, and the lowest TTL of the records it
+  // returned.
+  bool resolved_upstream_{false};
+  std::chrono::seconds upstream_ttl_{std::chrono::seconds::max()};
 
   /**
    * @param context the query context for which we are querying the response code
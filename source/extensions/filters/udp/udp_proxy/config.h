@@ -157,6 +157,10 @@ public:
     return access_log_flush_interval_;
   }
   Random::RandomGenerator& randomGenerator() const override { return random_generator_; }
+  OptRef<Network::UdpPacketWriterFactory> upstreamPacketWriterFactory() const override {
+    return makeOptRefFromPtr(upstream_packet_writer_factory_.get());
+  }
+  Stats::Scope& scope() const override { return scope_; }
 
   // UdpSessionFilterChainFactory
   bool createFilterChain(Network::UdpSessionFilterChainFactoryCallbacks& callbacks) const override {
@@ -203,6 +207,8 @@ private:
       udp_session_filter_config_provider_manager_;
   UdpSessionFilterFactoriesList filter_factories_;
   Random::RandomGenerator& random_generator_;
+  Network::UdpPacketWriterFactoryPtr upstream_packet_writer_factory_;
+  Stats::Scope& scope_;
 };
 
 /**
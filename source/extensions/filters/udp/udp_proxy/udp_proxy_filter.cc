@@ -4,6 +4,7 @@
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/socket_option_factory.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -17,9 +18,11 @@ const std::string& PerSessionCluster::key() {
 UdpProxyFilter::UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                                const UdpProxyFilterConfigSharedPtr& config)
     : UdpListenerReadFilter(callbacks), config_(config),
-      sessions_(SessionStorageType(
-          1, HeterogeneousActiveSessionHash(config_->usingPerPacketLoadBalancing()),
-          HeterogeneousActiveSessionEqual(config_->usingPerPacketLoadBalancing()))),
+      idle_timer_wheel_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.udp_proxy_idle_timer_wheel")
+              ? std::make_unique<IdleTimerWheel>(callbacks.udpListener().dispatcher(),
+                                                 config_->sessionTimeout())
+              : nullptr),
       cluster_update_callbacks_(
           config->clusterManager().addThreadLocalClusterUpdateCallbacks(*this)) {
   for (const auto& entry : config_->allClusterNames()) {
@@ -34,7 +37,7 @@ UdpProxyFilter::UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
 
 UdpProxyFilter::~UdpProxyFilter() {
   while (!sessions_.empty()) {
-    removeSession(sessions_.begin()->get());
+    removeSession(sessions_.begin()->second.get());
   }
 
   if (!config_->proxyAccessLogs().empty()) {
@@ -83,7 +86,7 @@ void UdpProxyFilter::onClusterRemoval(const std::string& cluster) {
 
 Network::FilterStatus StickySessionUdpProxyFilter::onDataInternal(Network::UdpRecvData& data) {
   bool defer_socket = config_->hasSessionFilters() || config_->tunnelingConfig();
-  const auto active_session_it = sessions_.find(data.addresses_);
+  const auto active_session_it = sessions_.find(SessionKey(data.addresses_, nullptr));
   ActiveSession* active_session;
   if (active_session_it == sessions_.end()) {
     active_session = createSession(std::move(data.addresses_), nullptr, defer_socket);
@@ -92,7 +95,7 @@ Network::FilterStatus StickySessionUdpProxyFilter::onDataInternal(Network::UdpRe
     }
     data.addresses_ = active_session->addresses();
   } else {
-    active_session = active_session_it->get();
+    active_session = active_session_it->second.get();
     // We defer the socket creation when the session includes filters, so the filters can be
     // iterated before choosing the host, to allow dynamically choosing upstream host. Due to this,
     // we can't perform health checks during a session.
@@ -146,8 +149,7 @@ PerPacketLoadBalancingUdpProxyFilter::onDataInternal(Network::UdpRecvData& data)
 
   ENVOY_LOG(debug, "selected {} host as upstream.", host->address()->asStringView());
 
-  LocalPeerHostAddresses key{data.addresses_, *host};
-  const auto active_session_it = sessions_.find(key);
+  const auto active_session_it = sessions_.find(SessionKey(data.addresses_, host.get()));
   ActiveSession* active_session;
   if (active_session_it == sessions_.end()) {
     active_session = createSession(std::move(data.addresses_), host, false);
@@ -156,7 +158,7 @@ PerPacketLoadBalancingUdpProxyFilter::onDataInternal(Network::UdpRecvData& data)
     }
     data.addresses_ = active_session->addresses();
   } else {
-    active_session = active_session_it->get();
+    active_session = active_session_it->second.get();
     ENVOY_LOG(trace, "found already existing session on host {}.",
               active_session->host().value().get().address()->asStringView());
   }
@@ -205,8 +207,102 @@ void UdpProxyFilter::removeSession(ActiveSession* session) {
   session->onSessionComplete();
 
   // Now remove it from the primary map.
-  ASSERT(sessions_.count(session) == 1);
-  sessions_.erase(session);
+  ASSERT(sessions_.count(session->sessionKey()) == 1);
+  sessions_.erase(session->sessionKey());
+}
+
+UdpProxyFilter::SessionKey::SessionKey(const Network::UdpRecvData::LocalPeerAddresses& addresses,
+                                       const Upstream::Host* host)
+    : host_(host) {
+  const Network::Address::Ip* local = addresses.local_->ip();
+  const Network::Address::Ip* peer = addresses.peer_->ip();
+  ASSERT(local != nullptr && peer != nullptr);
+  local_port_ = local->port();
+  peer_port_ = peer->port();
+  versions_ = {local->version(), peer->version()};
+  if (local->version() == Network::Address::IpVersion::v4) {
+    local_address_ = local->ipv4()->address();
+    scope_ids_.first = 0;
+  } else {
+    local_address_ = local->ipv6()->address();
+    scope_ids_.first = local->ipv6()->scopeId();
+  }
+  if (peer->version() == Network::Address::IpVersion::v4) {
+    peer_address_ = peer->ipv4()->address();
+    scope_ids_.second = 0;
+  } else {
+    peer_address_ = peer->ipv6()->address();
+    scope_ids_.second = peer->ipv6()->scopeId();
+  }
+}
+
+UdpProxyFilter::IdleTimerWheel::IdleTimerWheel(Event::Dispatcher& dispatcher,
+                                               std::chrono::milliseconds timeout)
+    : dispatcher_(dispatcher), timeout_(timeout),
+      bucket_width_(std::max(timeout / BucketsPerTimeout, std::chrono::milliseconds(1))),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })) {}
+
+void UdpProxyFilter::IdleTimerWheel::touch(ActiveSession& session) {
+  session.last_active_ = dispatcher_.approximateMonotonicTime();
+  if (!session.idle_position_.has_value()) {
+    schedule(session, session.last_active_ + timeout_);
+    armTimer();
+  }
+}
+
+void UdpProxyFilter::IdleTimerWheel::cancel(ActiveSession& session) {
+  if (!session.idle_position_.has_value()) {
+    return;
+  }
+  auto bucket_it = buckets_.find(session.idle_position_->deadline_);
+  ASSERT(bucket_it != buckets_.end());
+  bucket_it->second.erase(session.idle_position_->iterator_);
+  session.idle_position_.reset();
+}
+
+void UdpProxyFilter::IdleTimerWheel::schedule(ActiveSession& session, MonotonicTime deadline) {
+  // Round the deadline up to the bucket width so that sessions share buckets.
+  const MonotonicTime::duration width = bucket_width_;
+  const MonotonicTime bucket_deadline(
+      (deadline.time_since_epoch() + width - MonotonicTime::duration(1)) / width * width);
+  Bucket& bucket = buckets_[bucket_deadline];
+  session.idle_position_ = Position{bucket_deadline, bucket.insert(bucket.end(), &session)};
+}
+
+void UdpProxyFilter::IdleTimerWheel::armTimer() {
+  // The timer only needs to move when the earliest bucket becomes earlier.
+  const MonotonicTime next = buckets_.begin()->first;
+  if (timer_->enabled() && next >= armed_deadline_) {
+    return;
+  }
+  armed_deadline_ = next;
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  timer_->enableTimer(next > now ? std::chrono::ceil<std::chrono::milliseconds>(next - now)
+                                 : std::chrono::milliseconds(0));
+}
+
+void UdpProxyFilter::IdleTimerWheel::onTimer() {
+  const MonotonicTime now = dispatcher_.approximateMonotonicTime();
+  while (!buckets_.empty() && buckets_.begin()->first <= now) {
+    Bucket& bucket = buckets_.begin()->second;
+    while (!bucket.empty()) {
+      ActiveSession& session = *bucket.front();
+      bucket.pop_front();
+      session.idle_position_.reset();
+      const MonotonicTime deadline = session.last_active_ + timeout_;
+      if (deadline > now) {
+        // The session was active since it was scheduled.
+        schedule(session, deadline);
+      } else {
+        // This may remove the session or cancel other sessions, but not schedule into this bucket.
+        session.onIdleTimer();
+      }
+    }
+    buckets_.erase(buckets_.begin());
+  }
+  if (!buckets_.empty()) {
+    armTimer();
+  }
 }
 
 UdpProxyFilter::ClusterInfo::ClusterInfo(UdpProxyFilter& filter,
@@ -224,8 +320,8 @@ UdpProxyFilter::ClusterInfo::ClusterInfo(UdpProxyFilter& filter,
               if (host_sessions_it != host_to_sessions_.end()) {
                 for (auto& session : host_sessions_it->second) {
                   session->onSessionComplete();
-                  ASSERT(filter_.sessions_.count(session) == 1);
-                  filter_.sessions_.erase(session);
+                  ASSERT(filter_.sessions_.count(session->sessionKey()) == 1);
+                  filter_.sessions_.erase(session->sessionKey());
                   sessions_.erase(session);
                 }
                 host_to_sessions_.erase(host_sessions_it);
@@ -303,7 +399,7 @@ UdpProxyFilter::createSessionWithOptionalHost(Network::UdpRecvData::LocalPeerAdd
 
   if (new_session->onNewSession()) {
     auto new_session_ptr = new_session.get();
-    sessions_.emplace(std::move(new_session));
+    sessions_.emplace(new_session_ptr->sessionKey(), std::move(new_session));
     return new_session_ptr;
   }
 
@@ -326,9 +422,12 @@ UdpProxyFilter::ActiveSession::ActiveSession(UdpProxyFilter& filter,
                                              Network::UdpRecvData::LocalPeerAddresses&& addresses,
                                              const Upstream::HostConstSharedPtr& host)
     : filter_(filter), addresses_(std::move(addresses)), host_(host),
+      key_(addresses_, filter_.config_->usingPerPacketLoadBalancing() ? host_.get() : nullptr),
       session_id_(next_global_session_id_++),
-      idle_timer_(filter_.read_callbacks_->udpListener().dispatcher().createTimer(
-          [this] { onIdleTimer(); })),
+      idle_timer_(filter_.idle_timer_wheel_ == nullptr
+                      ? filter_.read_callbacks_->udpListener().dispatcher().createTimer(
+                            [this] { onIdleTimer(); })
+                      : nullptr),
       udp_session_info_(StreamInfo::StreamInfoImpl(filter_.config_->timeSource(),
                                                    createDownstreamConnectionInfoProvider(),
                                                    StreamInfo::FilterState::LifeSpan::Connection)) {
@@ -343,6 +442,12 @@ UdpProxyFilter::UdpActiveSession::UdpActiveSession(
     : ActiveSession(filter, std::move(addresses), std::move(host)),
       use_original_src_ip_(filter_.config_->usingOriginalSrcIp()) {}
 
+UdpProxyFilter::UdpActiveSession::~UdpActiveSession() {
+  if (upstream_writer_ != nullptr && upstream_writer_->isBatchMode()) {
+    flushUpstream();
+  }
+}
+
 UdpProxyFilter::ActiveSession::~ActiveSession() {
   ENVOY_BUG(on_session_complete_called_, "onSessionComplete() not called");
 }
@@ -354,6 +459,9 @@ void UdpProxyFilter::ActiveSession::onSessionComplete() {
             host_ != nullptr ? host_->address()->asStringView() : "unknown");
 
   filter_.config_->stats().downstream_sess_active_.dec();
+  if (filter_.idle_timer_wheel_ != nullptr) {
+    filter_.idle_timer_wheel_->cancel(*this);
+  }
   if (cluster_connections_inc_) {
     cluster_->cluster_info_->resourceManager(Upstream::ResourcePriority::Default)
         .connections()
@@ -462,6 +570,13 @@ void UdpProxyFilter::UdpActiveSession::onReadReady() {
   filter_.read_callbacks_->udpListener().flush();
 }
 
+void UdpProxyFilter::UdpActiveSession::flushUpstream() {
+  const Api::IoCallUint64Result rc = upstream_writer_->flush();
+  if (!rc.ok() && rc.err_->getErrorCode() != Api::IoError::IoErrorCode::Again) {
+    cluster_->cluster_stats_.sess_tx_errors_.inc();
+  }
+}
+
 bool UdpProxyFilter::ActiveSession::onNewSession() {
   if (filter_.config_->accessLogFlushInterval().has_value() &&
       !filter_.config_->sessionAccessLogs().empty()) {
@@ -560,6 +675,26 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
             host_->address()->asStringView());
 
   const Network::Address::Ip* local_ip = use_original_src_ip_ ? addresses_.peer_->ip() : nullptr;
+  if (upstream_writer_ != nullptr) {
+    if (upstream_writer_->isWriteBlocked()) {
+      // Datagrams are dropped rather than queued when the socket is not writable, like with
+      // direct writes. Let the writer try again for this datagram.
+      upstream_writer_->setWritable();
+    }
+    const Api::IoCallUint64Result rc =
+        upstream_writer_->writePacket(*data.buffer_, local_ip, *host_->address());
+    if (!rc.ok()) {
+      cluster_->cluster_stats_.sess_tx_errors_.inc();
+      return;
+    }
+    cluster_->cluster_stats_.sess_tx_datagrams_.inc();
+    cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(tx_buffer_length);
+    if (upstream_writer_->isBatchMode() && !upstream_flush_cb_->enabled()) {
+      upstream_flush_cb_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
+
   Api::IoCallUint64Result rc = Network::Utility::writeToSocket(
       udp_socket_->ioHandle(), *data.buffer_, local_ip, *host_->address());
 
@@ -645,6 +780,15 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
       },
       Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
 
+  OptRef<Network::UdpPacketWriterFactory> writer_factory =
+      filter_.config_->upstreamPacketWriterFactory();
+  if (writer_factory.has_value()) {
+    Event::Dispatcher& dispatcher = filter_.read_callbacks_->udpListener().dispatcher();
+    upstream_writer_ = writer_factory->createUdpPacketWriter(
+        udp_socket_->ioHandle(), filter_.config_->scope(), dispatcher, []() {});
+    upstream_flush_cb_ = dispatcher.createSchedulableCallback([this]() { flushUpstream(); });
+  }
+
   ENVOY_LOG(debug, "creating new session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host->address()->asStringView());
@@ -727,6 +871,11 @@ void UdpProxyFilter::UdpActiveSession::processPacket(
 }
 
 void UdpProxyFilter::ActiveSession::resetIdleTimer() {
+  if (filter_.idle_timer_wheel_ != nullptr) {
+    filter_.idle_timer_wheel_->touch(*this);
+    return;
+  }
+
   if (idle_timer_ == nullptr) {
     return;
   }
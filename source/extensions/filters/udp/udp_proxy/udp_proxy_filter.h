@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+#include <map>
 #include <queue>
 
 #include "envoy/access_log/access_log.h"
@@ -9,6 +11,7 @@
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/http/header_evaluator.h"
 #include "envoy/network/filter.h"
+#include "envoy/network/udp_packet_writer_handler.h"
 #include "envoy/stream_info/stream_info.h"
 #include "envoy/stream_info/uint32_accessor.h"
 #include "envoy/upstream/cluster_manager.h"
@@ -35,6 +38,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/numeric/int128.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -140,6 +144,8 @@ public:
   virtual bool flushAccessLogOnTunnelConnected() const PURE;
   virtual const absl::optional<std::chrono::milliseconds>& accessLogFlushInterval() const PURE;
   virtual Random::RandomGenerator& randomGenerator() const PURE;
+  virtual OptRef<Network::UdpPacketWriterFactory> upstreamPacketWriterFactory() const PURE;
+  virtual Stats::Scope& scope() const PURE;
 };
 
 using UdpProxyFilterConfigSharedPtr = std::shared_ptr<const UdpProxyFilterConfig>;
@@ -519,6 +525,81 @@ protected:
   class ActiveSession;
   class ClusterInfo;
 
+  /**
+   * The key of a session in the session table: the local and peer addresses of the session, and
+   * its host with per packet load balancing. Addresses are stored inline so that lookups neither
+   * format, hash nor compare address strings. Sessions only have IP addresses.
+   */
+  struct SessionKey {
+    SessionKey(const Network::UdpRecvData::LocalPeerAddresses& addresses,
+               const Upstream::Host* host);
+
+    bool operator==(const SessionKey& rhs) const = default;
+
+    template <typename H> friend H AbslHashValue(H h, const SessionKey& key) {
+      return H::combine(std::move(h), key.local_address_, key.peer_address_, key.local_port_,
+                        key.peer_port_, key.scope_ids_, key.versions_, key.host_);
+    }
+
+    absl::uint128 local_address_;
+    absl::uint128 peer_address_;
+    uint16_t local_port_;
+    uint16_t peer_port_;
+    // The IPv6 scope IDs of the local and peer addresses.
+    std::pair<uint32_t, uint32_t> scope_ids_;
+    // The IP versions of the local and peer addresses.
+    std::pair<Network::Address::IpVersion, Network::Address::IpVersion> versions_;
+    const Upstream::Host* host_;
+  };
+
+  /**
+   * Expires idle sessions from a single timer instead of a timer per session. Sessions record the
+   * time of their last activity and are kept in buckets by the time at which they expire if they
+   * stay idle. When the time of a bucket passes, its idle sessions expire and the others move to
+   * the bucket of their new expiration time. Activity then only updates a time stamp rather than a
+   * timer, and sessions expire up to a bucket width late.
+   */
+  class IdleTimerWheel {
+  public:
+    // Number of buckets the session timeout is divided in.
+    static constexpr uint32_t BucketsPerTimeout = 32;
+
+    using Bucket = std::list<ActiveSession*>;
+
+    // The position of a scheduled session, which allows cancelling it in constant time.
+    struct Position {
+      MonotonicTime deadline_;
+      Bucket::iterator iterator_;
+    };
+
+    IdleTimerWheel(Event::Dispatcher& dispatcher, std::chrono::milliseconds timeout);
+
+    /**
+     * Record the activity of a session, scheduling its expiration if it is not scheduled.
+     */
+    void touch(ActiveSession& session);
+
+    /**
+     * Cancel the expiration of a session, if it is scheduled.
+     */
+    void cancel(ActiveSession& session);
+
+  private:
+    void schedule(ActiveSession& session, MonotonicTime deadline);
+    void armTimer();
+    void onTimer();
+
+    Event::Dispatcher& dispatcher_;
+    const std::chrono::milliseconds timeout_;
+    const std::chrono::milliseconds bucket_width_;
+    const Event::TimerPtr timer_;
+    // The deadline the timer is armed for, if it is enabled.
+    MonotonicTime armed_deadline_;
+    // Buckets by deadline. Buckets emptied by cancel() are only removed when their deadline
+    // passes, so that onTimer() can expire the sessions of a bucket in place.
+    std::map<MonotonicTime, Bucket> buckets_;
+  };
+
   UdpProxyFilter(Network::UdpReadFilterCallbacks& callbacks,
                  const UdpProxyFilterConfigSharedPtr& config);
   ~UdpProxyFilter() override;
@@ -583,6 +664,7 @@ protected:
     ~ActiveSession() override;
 
     const Network::UdpRecvData::LocalPeerAddresses& addresses() const { return addresses_; }
+    const SessionKey& sessionKey() const { return key_; }
     ClusterInfo* cluster() const { return cluster_; }
     absl::optional<std::reference_wrapper<const Upstream::Host>> host() const {
       if (host_) {
@@ -657,14 +739,15 @@ protected:
     UdpProxyFilter& filter_;
     const Network::UdpRecvData::LocalPeerAddresses addresses_;
     Upstream::HostConstSharedPtr host_;
+    const SessionKey key_;
     ClusterInfo* cluster_{nullptr};
     uint64_t session_id_;
-    // TODO(mattklein123): Consider replacing an idle timer for each session with a last used
-    // time stamp and a periodic scan of all sessions to look for timeouts. This solution is simple,
-    // though it might not perform well for high volume traffic. Note that this is how TCP proxy
-    // idle timeouts work so we should consider unifying the implementation if we move to a time
-    // stamp and scan approach.
+    // The idle timer of the session, unless the filter expires idle sessions from its
+    // IdleTimerWheel.
     const Event::TimerPtr idle_timer_;
+    // Used by the IdleTimerWheel of the filter.
+    MonotonicTime last_active_;
+    absl::optional<IdleTimerWheel::Position> idle_position_;
     Event::TimerPtr access_log_flush_timer_;
 
     UdpProxySessionStats session_stats_{};
@@ -681,6 +764,8 @@ protected:
 
     bool cluster_connections_inc_{false};
     bool on_session_complete_called_{false};
+
+    friend class IdleTimerWheel;
   };
 
   using ActiveSessionSharedPtr = std::shared_ptr<ActiveSession>;
@@ -689,7 +774,7 @@ protected:
   public:
     UdpActiveSession(UdpProxyFilter& filter, Network::UdpRecvData::LocalPeerAddresses&& addresses,
                      const Upstream::HostConstSharedPtr& host);
-    ~UdpActiveSession() override = default;
+    ~UdpActiveSession() override;
 
     // ActiveSession
     bool shouldCreateUpstream() override;
@@ -726,11 +811,17 @@ protected:
   private:
     void onReadReady();
     void createUdpSocket(const Upstream::HostConstSharedPtr& host);
+    void flushUpstream();
 
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
     // write to the upstream host.
     Network::SocketPtr udp_socket_;
+    // Writer of the upstream socket if one is configured, otherwise datagrams are written directly
+    // to the socket. Datagrams buffered by a batch writer are flushed at the end of the event loop
+    // iteration by upstream_flush_cb_.
+    Network::UdpPacketWriterPtr upstream_writer_;
+    Event::SchedulableCallbackPtr upstream_flush_cb_;
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
@@ -796,71 +887,6 @@ protected:
     std::queue<BufferedDatagramPtr> datagrams_buffer_;
   };
 
-  struct LocalPeerHostAddresses {
-    const Network::UdpRecvData::LocalPeerAddresses& local_peer_addresses_;
-    absl::optional<std::reference_wrapper<const Upstream::Host>> host_;
-  };
-
-  struct HeterogeneousActiveSessionHash {
-    // Specifying is_transparent indicates to the library infrastructure that
-    // type-conversions should not be applied when calling find(), but instead
-    // pass the actual types of the contained and searched-for objects directly to
-    // these functors. See
-    // https://en.cppreference.com/w/cpp/utility/functional/less_void for an
-    // official reference, and https://abseil.io/tips/144 for a description of
-    // using it in the context of absl.
-    using is_transparent = void; // NOLINT(readability-identifier-naming)
-
-    HeterogeneousActiveSessionHash(const bool consider_host) : consider_host_(consider_host) {}
-
-    size_t operator()(const Network::UdpRecvData::LocalPeerAddresses& value) const {
-      return absl::Hash<const Network::UdpRecvData::LocalPeerAddresses>()(value);
-    }
-    size_t operator()(const LocalPeerHostAddresses& value) const {
-      auto hash = this->operator()(value.local_peer_addresses_);
-      if (consider_host_) {
-        hash = absl::HashOf(hash, value.host_.value().get().address()->asStringView());
-      }
-      return hash;
-    }
-    size_t operator()(const ActiveSession* value) const {
-      LocalPeerHostAddresses key{value->addresses(), value->host()};
-      return this->operator()(key);
-    }
-    size_t operator()(const ActiveSessionSharedPtr& value) const {
-      return this->operator()(value.get());
-    }
-
-  private:
-    const bool consider_host_;
-  };
-
-  struct HeterogeneousActiveSessionEqual {
-    // See description for HeterogeneousActiveSessionHash::is_transparent.
-    using is_transparent = void; // NOLINT(readability-identifier-naming)
-
-    HeterogeneousActiveSessionEqual(const bool consider_host) : consider_host_(consider_host) {}
-
-    bool operator()(const ActiveSessionSharedPtr& lhs,
-                    const Network::UdpRecvData::LocalPeerAddresses& rhs) const {
-      return lhs->addresses() == rhs;
-    }
-    bool operator()(const ActiveSessionSharedPtr& lhs, const LocalPeerHostAddresses& rhs) const {
-      return this->operator()(lhs, rhs.local_peer_addresses_) &&
-             (consider_host_ ? &lhs->host().value().get() == &rhs.host_.value().get() : true);
-    }
-    bool operator()(const ActiveSessionSharedPtr& lhs, const ActiveSession* rhs) const {
-      LocalPeerHostAddresses key{rhs->addresses(), rhs->host()};
-      return this->operator()(lhs, key);
-    }
-    bool operator()(const ActiveSessionSharedPtr& lhs, const ActiveSessionSharedPtr& rhs) const {
-      return this->operator()(lhs, rhs.get());
-    }
-
-  private:
-    const bool consider_host_;
-  };
-
   /**
    * Wraps all cluster specific UDP processing including session tracking, stats, etc. In the future
    * we will very likely support different types of routing to multiple upstream clusters.
@@ -897,12 +923,13 @@ protected:
   };
 
   using ClusterInfoPtr = std::unique_ptr<ClusterInfo>;
-  using SessionStorageType =
-      absl::flat_hash_set<ActiveSessionSharedPtr, HeterogeneousActiveSessionHash,
-                          HeterogeneousActiveSessionEqual>;
+  using SessionStorageType = absl::flat_hash_map<SessionKey, ActiveSessionSharedPtr>;
 
   const UdpProxyFilterConfigSharedPtr config_;
   SessionStorageType sessions_;
+  // Expires idle sessions in place of per session timers. Only set if the
+  // udp_proxy_idle_timer_wheel runtime feature is enabled.
+  std::unique_ptr<IdleTimerWheel> idle_timer_wheel_;
 
 private:
   ActiveSession* createSessionWithOptionalHost(Network::UdpRecvData::LocalPeerAddresses&& addresses,
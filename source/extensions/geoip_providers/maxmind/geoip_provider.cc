@@ -1,7 +1,11 @@
 #include "source/extensions/geoip_providers/maxmind/geoip_provider.h"
 
+#include <unistd.h>
+
 #include "source/common/common/assert.h"
+#include "source/common/network/utility.h"
 #include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
@@ -27,10 +31,25 @@ static constexpr absl::string_view ANON_DB_TYPE = "anon_db";
 static constexpr absl::string_view ASN_DB_TYPE = "asn_db";
 static constexpr absl::string_view COUNTRY_DB_TYPE = "country_db";
 
+static constexpr uint32_t DEFAULT_LOOKUP_CACHE_MAX_ENTRIES = 10000;
+
 // Helper to get optional string from config field, returns nullopt if empty.
 absl::optional<std::string> getOptionalString(const std::string& value) {
   return !value.empty() ? absl::make_optional(value) : absl::nullopt;
 }
+
+// Reads the search tree of a database, which every lookup walks from its root, so that its pages
+// are faulted in when the database is loaded rather than by the first requests.
+void prefaultSearchTree(const MMDB_s& db) {
+  static const size_t page_size = ::sysconf(_SC_PAGESIZE);
+  const size_t tree_size = std::min<size_t>(
+      static_cast<size_t>(db.metadata.node_count) * db.full_record_byte_size, db.file_size);
+  // The reads of a volatile pointer are not optimized away.
+  const volatile uint8_t* content = db.file_content;
+  for (size_t offset = 0; offset < tree_size; offset += page_size) {
+    static_cast<void>(content[offset]);
+  }
+}
 } // namespace
 
 GeoipProviderConfig::GeoipProviderConfig(
@@ -41,6 +60,15 @@ GeoipProviderConfig::GeoipProviderConfig(
       anon_db_path_(getOptionalString(config.anon_db_path())),
       asn_db_path_(getOptionalString(config.asn_db_path())),
       country_db_path_(getOptionalString(config.country_db_path())),
+      lookup_cache_max_entries_(config.has_lookup_cache()
+                                    ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                                          config.lookup_cache(), max_entries,
+                                          DEFAULT_LOOKUP_CACHE_MAX_ENTRIES)
+                                    : 0),
+      lookup_cache_ipv4_prefix_len_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.lookup_cache(), ipv4_prefix_len, 32)),
+      lookup_cache_ipv6_prefix_len_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.lookup_cache(), ipv6_prefix_len, 128)),
       stats_scope_(scope.createScope(absl::StrCat(stat_prefix, "maxmind."))),
       stat_name_set_(stats_scope_->symbolTable().makeSet("Maxmind")) {
   const auto& common_config = config.common_provider_config();
@@ -98,6 +126,9 @@ GeoipProviderConfig::GeoipProviderConfig(
   if (country_db_path_) {
     registerGeoDbStats(COUNTRY_DB_TYPE);
   }
+  if (lookup_cache_max_entries_ > 0) {
+    stat_name_set_->rememberBuiltins({"lookup_cache.hit", "lookup_cache.miss"});
+  }
 };
 
 void GeoipProviderConfig::registerGeoDbStats(const absl::string_view& db_type) {
@@ -121,10 +152,63 @@ void GeoipProviderConfig::setGuage(Stats::StatName name, const uint64_t value) {
   stats_scope_->gaugeFromStatName(name, Stats::Gauge::ImportMode::Accumulate).set(value);
 }
 
+LookupResultCache::Key LookupResultCache::key(const Network::Address::Ip& ip,
+                                              uint32_t ipv4_prefix_len, uint32_t ipv6_prefix_len) {
+  if (ip.version() == Network::Address::IpVersion::v4) {
+    const uint32_t address = ntohl(ip.ipv4()->address());
+    const uint32_t mask = ipv4_prefix_len == 0 ? 0 : ~0U << (32 - ipv4_prefix_len);
+    return {address & mask, false};
+  }
+  const absl::uint128 address = Network::Utility::Ip6ntohl(ip.ipv6()->address());
+  const absl::uint128 mask =
+      ipv6_prefix_len == 0 ? absl::uint128(0) : absl::Uint128Max() << (128 - ipv6_prefix_len);
+  return {address & mask, true};
+}
+
+const Geolocation::LookupResult* LookupResultCache::lookup(const Key& key, uint64_t generation) {
+  maybeClear(generation);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return &it->second->result_;
+}
+
+void LookupResultCache::insert(const Key& key, const Geolocation::LookupResult& result,
+                               uint64_t generation) {
+  maybeClear(generation);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    entries_.erase(it->second);
+    index_.erase(it);
+  }
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  entries_.push_front(Entry{key, result});
+  index_[key] = entries_.begin();
+}
+
+void LookupResultCache::maybeClear(uint64_t generation) {
+  if (generation != generation_) {
+    index_.clear();
+    entries_.clear();
+    generation_ = generation;
+  }
+}
+
 GeoipProvider::GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api,
-                             Singleton::InstanceSharedPtr owner,
+                             ThreadLocal::SlotAllocator& tls, Singleton::InstanceSharedPtr owner,
                              GeoipProviderConfigSharedPtr config)
     : config_(config), owner_(owner) {
+  if (config_->lookupCacheMaxEntries() > 0) {
+    lookup_cache_ = ThreadLocal::TypedSlot<LookupResultCache>::makeUnique(tls);
+    lookup_cache_->set([max_entries = config_->lookupCacheMaxEntries()](Event::Dispatcher&) {
+      return std::make_shared<LookupResultCache>(max_entries);
+    });
+  }
   city_db_ =
       config_->cityDbPath() ? initMaxmindDb(config_->cityDbPath().value(), CITY_DB_TYPE) : nullptr;
   isp_db_ =
@@ -193,12 +277,32 @@ GeoipProvider::~GeoipProvider() {
 void GeoipProvider::lookup(Geolocation::LookupRequest&& request,
                            Geolocation::LookupGeoHeadersCallback&& cb) const {
   auto& remote_address = request.remoteAddress();
+  absl::optional<LookupResultCache::Key> cache_key;
+  uint64_t generation = 0;
+  if (lookup_cache_ != nullptr && remote_address->ip() != nullptr) {
+    cache_key = LookupResultCache::key(*remote_address->ip(), config_->lookupCacheIpv4PrefixLen(),
+                                       config_->lookupCacheIpv6PrefixLen());
+    // Read before the databases, so that the results of a lookup racing with a reload are
+    // dropped by the next one.
+    generation = db_generation_.load();
+    const Geolocation::LookupResult* cached_result =
+        (*lookup_cache_)->lookup(cache_key.value(), generation);
+    if (cached_result != nullptr) {
+      config_->incLookupCacheHit();
+      cb(absl::flat_hash_map<std::string, std::string>(*cached_result));
+      return;
+    }
+    config_->incLookupCacheMiss();
+  }
   auto lookup_result = absl::flat_hash_map<std::string, std::string>{};
   lookupInCountryDb(remote_address, lookup_result);
   lookupInCityDb(remote_address, lookup_result);
   lookupInAsnDb(remote_address, lookup_result);
   lookupInAnonDb(remote_address, lookup_result);
   lookupInIspDb(remote_address, lookup_result);
+  if (cache_key.has_value()) {
+    (*lookup_cache_)->insert(cache_key.value(), lookup_result, generation);
+  }
   cb(std::move(lookup_result));
 }
 
@@ -481,6 +585,7 @@ MaxmindDbSharedPtr GeoipProvider::initMaxmindDb(const std::string& db_path,
   }
 
   config_->setDbBuildEpoch(db_type, maxmind_db.metadata.build_epoch);
+  prefaultSearchTree(maxmind_db);
 
   ENVOY_LOG(info, "Succeeded to reload Maxmind database {} from file {}.", db_type, db_path);
   return std::make_shared<MaxmindDb>(std::move(maxmind_db));
@@ -508,6 +613,7 @@ absl::Status GeoipProvider::mmdbReload(const MaxmindDbSharedPtr reloaded_db,
       ENVOY_LOG(error, "Unsupported maxmind db type {}", db_type);
       return absl::InvalidArgumentError(fmt::format("Unsupported maxmind db type {}", db_type));
     }
+    db_generation_++;
   } else {
     config_->incDbReloadError(db_type);
   }
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+
 #include "envoy/common/platform.h"
 #include "envoy/extensions/geoip_providers/maxmind/v3/maxmind.pb.h"
 #include "envoy/geoip/geoip_provider_driver.h"
+#include "envoy/thread_local/thread_local.h"
 
 #include "source/common/common/logger.h"
 #include "source/common/common/thread_synchronizer.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/numeric/int128.h"
 #include "maxminddb.h"
 
 namespace Envoy {
@@ -48,6 +54,11 @@ public:
     return apple_private_relay_header_;
   }
 
+  // The maximum number of lookup results cached by each worker thread, or 0 if they are not.
+  uint32_t lookupCacheMaxEntries() const { return lookup_cache_max_entries_; }
+  uint32_t lookupCacheIpv4PrefixLen() const { return lookup_cache_ipv4_prefix_len_; }
+  uint32_t lookupCacheIpv6PrefixLen() const { return lookup_cache_ipv6_prefix_len_; }
+
   void incLookupError(absl::string_view maxmind_db_type) {
     incCounter(
         stat_name_set_->getBuiltin(absl::StrCat(maxmind_db_type, ".lookup_error"), unknown_hit_));
@@ -71,6 +82,14 @@ public:
                                           unknown_hit_));
   }
 
+  void incLookupCacheHit() {
+    incCounter(stat_name_set_->getBuiltin("lookup_cache.hit", unknown_hit_));
+  }
+
+  void incLookupCacheMiss() {
+    incCounter(stat_name_set_->getBuiltin("lookup_cache.miss", unknown_hit_));
+  }
+
   void setDbBuildEpoch(absl::string_view maxmind_db_type, const uint64_t value) {
     setGuage(
         stat_name_set_->getBuiltin(absl::StrCat(maxmind_db_type, ".db_build_epoch"), unknown_hit_),
@@ -103,6 +122,10 @@ private:
   absl::optional<std::string> isp_header_;
   absl::optional<std::string> apple_private_relay_header_;
 
+  const uint32_t lookup_cache_max_entries_;
+  const uint32_t lookup_cache_ipv4_prefix_len_;
+  const uint32_t lookup_cache_ipv6_prefix_len_;
+
   Stats::ScopeSharedPtr stats_scope_;
   Stats::StatNameSetPtr stat_name_set_;
   const Stats::StatName unknown_hit_;
@@ -125,12 +148,61 @@ private:
 };
 
 using MaxmindDbSharedPtr = std::shared_ptr<MaxmindDb>;
+
+/**
+ * The lookup results of a worker thread, keyed by the client address truncated to the configured
+ * prefix length and evicted in least recently used order. All of them are dropped whenever the
+ * generation of the databases changes, i.e. one of them is reloaded. Not thread safe.
+ */
+class LookupResultCache : public ThreadLocal::ThreadLocalObject {
+public:
+  // The address, in host byte order, and whether it is an IPv6 one.
+  using Key = std::pair<absl::uint128, bool>;
+
+  explicit LookupResultCache(uint32_t max_entries) : max_entries_(max_entries) {}
+
+  /**
+   * @return the key of the results for an address.
+   */
+  static Key key(const Network::Address::Ip& ip, uint32_t ipv4_prefix_len,
+                 uint32_t ipv6_prefix_len);
+
+  /**
+   * @return the lookup result of a key, or nullptr if there is none for the given generation of
+   *         the databases. Only valid until the next insertion.
+   */
+  const Geolocation::LookupResult* lookup(const Key& key, uint64_t generation);
+
+  /**
+   * Inserts the lookup result of a key, made with the given generation of the databases.
+   */
+  void insert(const Key& key, const Geolocation::LookupResult& result, uint64_t generation);
+
+  size_t size() const { return index_.size(); }
+
+private:
+  struct Entry {
+    const Key key_;
+    const Geolocation::LookupResult result_;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Drops all the results if they were looked up in another generation of the databases.
+  void maybeClear(uint64_t generation);
+
+  const uint32_t max_entries_;
+  uint64_t generation_{0};
+  // The most recently used entries first.
+  EntryList entries_;
+  absl::flat_hash_map<Key, EntryList::iterator> index_;
+};
+
 class GeoipProvider : public Envoy::Geolocation::Driver,
                       public Logger::Loggable<Logger::Id::geolocation> {
 
 public:
-  GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api, Singleton::InstanceSharedPtr owner,
-                GeoipProviderConfigSharedPtr config);
+  GeoipProvider(Event::Dispatcher& dispatcher, Api::Api& api, ThreadLocal::SlotAllocator& tls,
+                Singleton::InstanceSharedPtr owner, GeoipProviderConfigSharedPtr config);
 
   ~GeoipProvider() override;
 
@@ -147,6 +219,9 @@ private:
   MaxmindDbSharedPtr anon_db_ ABSL_GUARDED_BY(mmdb_mutex_);
   MaxmindDbSharedPtr asn_db_ ABSL_GUARDED_BY(mmdb_mutex_);
   MaxmindDbSharedPtr country_db_ ABSL_GUARDED_BY(mmdb_mutex_);
+  // Incremented whenever one of the databases is reloaded, to invalidate the cached results.
+  std::atomic<uint64_t> db_generation_{0};
+  ThreadLocal::TypedSlotPtr<LookupResultCache> lookup_cache_;
   Thread::ThreadPtr mmdb_reload_thread_;
   Event::DispatcherPtr mmdb_reload_dispatcher_;
   Filesystem::WatcherPtr mmdb_watcher_;
@@ -5,12 +5,16 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/thread.h"
 #include "source/common/network/utility.h"
 #include "source/common/router/router.h"
+#include "source/common/runtime/runtime_features.h"
 
 namespace Envoy {
 namespace Upstream {
 
+SINGLETON_MANAGER_REGISTRATION(health_check_shared_probe_registry);
+
 HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
                                              const envoy::config::core::v3::HealthCheck& config,
                                              Event::Dispatcher& dispatcher,
@@ -37,6 +41,10 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, unhealthy_edge_interval, unhealthy_interval_.count())),
       healthy_edge_interval_(
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
+      interval_scheduler_(Runtime::runtimeFeatureEnabled(
+                              "envoy.reloadable_features.health_check_shared_interval_timer")
+                              ? std::make_unique<IntervalScheduler>(dispatcher)
+                              : nullptr),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
@@ -236,10 +244,139 @@ void HealthCheckerImplBase::start() {
   }
 }
 
+HealthCheckerImplBase::IntervalScheduler::IntervalScheduler(Event::Dispatcher& dispatcher)
+    : time_source_(dispatcher.timeSource()),
+      timer_(dispatcher.createTimer([this]() -> void { onTimer(); })) {}
+
+void HealthCheckerImplBase::IntervalScheduler::schedule(ActiveHealthCheckSession& session,
+                                                        std::chrono::milliseconds interval) {
+  ASSERT(!session.scheduled_interval_.has_value());
+  const MonotonicTime now = time_source_.monotonicTime();
+  // Round the deadline up to the end of its bucket.
+  const auto deadline_ms = std::chrono::ceil<std::chrono::milliseconds>(
+      (now + interval).time_since_epoch());
+  const MonotonicTime deadline{
+      ((deadline_ms + BucketWidth - std::chrono::milliseconds(1)) / BucketWidth) * BucketWidth};
+
+  auto [bucket, inserted] = buckets_.try_emplace(deadline);
+  bucket->second.push_back(&session);
+  session.scheduled_interval_ = Position{deadline, std::prev(bucket->second.end())};
+  if (inserted && bucket == buckets_.begin()) {
+    timer_->enableTimer(std::chrono::ceil<std::chrono::milliseconds>(deadline - now));
+  }
+}
+
+void HealthCheckerImplBase::IntervalScheduler::cancel(ActiveHealthCheckSession& session) {
+  if (!session.scheduled_interval_.has_value()) {
+    return;
+  }
+  auto bucket = buckets_.find(session.scheduled_interval_->deadline_);
+  ASSERT(bucket != buckets_.end());
+  bucket->second.erase(session.scheduled_interval_->iterator_);
+  session.scheduled_interval_.reset();
+}
+
+void HealthCheckerImplBase::IntervalScheduler::onTimer() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  while (!buckets_.empty() && buckets_.begin()->first <= now) {
+    // Sessions are rescheduled to later buckets, and cancelled sessions are removed from this one,
+    // so the bucket is stable while its sessions run.
+    Bucket& bucket = buckets_.begin()->second;
+    while (!bucket.empty()) {
+      ActiveHealthCheckSession* session = bucket.front();
+      bucket.pop_front();
+      session->scheduled_interval_.reset();
+      session->onIntervalBase();
+    }
+    buckets_.erase(buckets_.begin());
+  }
+  if (!buckets_.empty()) {
+    timer_->enableTimer(
+        std::chrono::ceil<std::chrono::milliseconds>(buckets_.begin()->first - now));
+  }
+}
+
+bool HealthCheckerImplBase::SharedProbeRegistry::subscribe(const std::string& key,
+                                                          ActiveHealthCheckSession& session) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto [group, inserted] = groups_.try_emplace(key);
+  if (inserted) {
+    group->second.leader_ = &session;
+    return true;
+  }
+  group->second.followers_.insert(&session);
+  return false;
+}
+
+void HealthCheckerImplBase::SharedProbeRegistry::unsubscribe(const std::string& key,
+                                                            ActiveHealthCheckSession& session) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = groups_.find(key);
+  ASSERT(it != groups_.end());
+  Group& group = it->second;
+  if (group.leader_ != &session) {
+    group.followers_.erase(&session);
+    return;
+  }
+  if (group.followers_.empty()) {
+    groups_.erase(it);
+    return;
+  }
+  group.leader_ = *group.followers_.begin();
+  group.followers_.erase(group.followers_.begin());
+  group.leader_->promoteSharedProbeLeader();
+}
+
+void HealthCheckerImplBase::SharedProbeRegistry::publish(
+    const std::string& key, bool healthy, bool degraded,
+    envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = groups_.find(key);
+  if (it == groups_.end()) {
+    return;
+  }
+  const uint64_t sequence =
+      it->second.last_result_.has_value() ? it->second.last_result_->sequence_ + 1 : 1;
+  const SharedProbeResult result{healthy, degraded, type, retriable, sequence};
+  it->second.last_result_ = result;
+
+  // Applying a result runs the callbacks of the follower's health checker, which may remove hosts
+  // of any cluster. Removed sessions leave their group, and are only deferred deleted, so the
+  // membership of each follower is checked again before applying the result.
+  const std::vector<ActiveHealthCheckSession*> followers(it->second.followers_.begin(),
+                                                         it->second.followers_.end());
+  for (ActiveHealthCheckSession* follower : followers) {
+    it = groups_.find(key);
+    if (it == groups_.end()) {
+      return;
+    }
+    if (it->second.followers_.contains(follower)) {
+      follower->applySharedResult(result);
+    }
+  }
+}
+
+const HealthCheckerImplBase::SharedProbeResult*
+HealthCheckerImplBase::SharedProbeRegistry::lastResult(const std::string& key) const {
+  auto it = groups_.find(key);
+  return it == groups_.end() || !it->second.last_result_.has_value()
+             ? nullptr
+             : &it->second.last_result_.value();
+}
+
+std::shared_ptr<HealthCheckerImplBase::SharedProbeRegistry>
+HealthCheckerImplBase::SharedProbeRegistry::get(Singleton::Manager& manager) {
+  return manager.getTyped<SharedProbeRegistry>(
+      SINGLETON_MANAGER_REGISTERED_NAME(health_check_shared_probe_registry),
+      [] { return std::make_shared<SharedProbeRegistry>(); });
+}
+
 HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
     HealthCheckerImplBase& parent, HostSharedPtr host)
     : host_(host), parent_(parent),
-      interval_timer_(parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
+      interval_timer_(parent.interval_scheduler_ != nullptr
+                          ? nullptr
+                          : parent.dispatcher_.createTimer([this]() -> void { onIntervalBase(); })),
       timeout_timer_(parent.dispatcher_.createTimer([this]() -> void { onTimeoutBase(); })),
       time_source_(parent.dispatcher_.timeSource()) {
 
@@ -263,7 +400,15 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   // The session is about to be deferred deleted. Make sure all timers are gone and any
   // implementation specific state is destroyed.
   interval_timer_.reset();
+  if (parent_.interval_scheduler_ != nullptr) {
+    parent_.interval_scheduler_->cancel(*this);
+  }
   timeout_timer_.reset();
+  if (!shared_probe_key_.empty()) {
+    const std::string key = std::move(shared_probe_key_);
+    shared_probe_key_.clear();
+    parent_.shared_probes_->unsubscribe(key, *this);
+  }
   if (!host_->healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
     parent_.decHealthy();
     state = HealthState::Healthy;
@@ -342,7 +487,10 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degrade
   parent_.runCallbacks(host_, changed_state, HealthState::Healthy);
 
   timeout_timer_->disableTimer();
-  interval_timer_->enableTimer(parent_.interval(HealthState::Healthy, changed_state));
+  if (!shared_probe_follower_) {
+    scheduleInterval(parent_.interval(HealthState::Healthy, changed_state));
+    publishSharedResult(true, degraded, envoy::data::core::v3::ACTIVE, false);
+  }
 }
 
 namespace {
@@ -405,12 +553,10 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
     envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
   HealthTransition changed_state = setUnhealthy(type, retriable);
   // It's possible that the previous call caused this session to be deferred deleted.
-  if (timeout_timer_ != nullptr) {
+  if (timeout_timer_ != nullptr && !shared_probe_follower_) {
     timeout_timer_->disableTimer();
-  }
-
-  if (interval_timer_ != nullptr) {
-    interval_timer_->enableTimer(parent_.interval(HealthState::Unhealthy, changed_state));
+    scheduleInterval(parent_.interval(HealthState::Unhealthy, changed_state));
+    publishSharedResult(false, false, type, retriable);
   }
 }
 
@@ -426,7 +572,69 @@ HealthCheckerImplBase::ActiveHealthCheckSession::clearPendingFlag(HealthTransiti
   return changed_state;
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::scheduleInterval(
+    std::chrono::milliseconds interval) {
+  if (parent_.interval_scheduler_ != nullptr) {
+    parent_.interval_scheduler_->cancel(*this);
+    parent_.interval_scheduler_->schedule(*this, interval);
+  } else {
+    interval_timer_->enableTimer(interval);
+  }
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::start() {
+  if (parent_.shared_probes_ != nullptr) {
+    shared_probe_key_ = parent_.sharedProbeKey(host_);
+    if (!shared_probe_key_.empty() &&
+        !parent_.shared_probes_->subscribe(shared_probe_key_, *this)) {
+      shared_probe_follower_ = true;
+      // Apply the last result of the group soon rather than waiting for the leader's next probe.
+      if (parent_.shared_probes_->lastResult(shared_probe_key_) != nullptr) {
+        scheduleInterval(std::chrono::milliseconds(1));
+      }
+      return;
+    }
+  }
+  onInitialInterval();
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::applySharedResult(
+    const SharedProbeResult& result) {
+  ASSERT(shared_probe_follower_);
+  if (result.sequence_ <= shared_probe_sequence_) {
+    return;
+  }
+  shared_probe_sequence_ = result.sequence_;
+  if (result.healthy_) {
+    handleSuccess(result.degraded_);
+  } else {
+    handleFailure(result.type_, result.retriable_);
+  }
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::publishSharedResult(
+    bool healthy, bool degraded, envoy::data::core::v3::HealthCheckFailureType type,
+    bool retriable) {
+  if (!shared_probe_key_.empty()) {
+    parent_.shared_probes_->publish(shared_probe_key_, healthy, degraded, type, retriable);
+  }
+}
+
+void HealthCheckerImplBase::ActiveHealthCheckSession::promoteSharedProbeLeader() {
+  ASSERT(shared_probe_follower_);
+  shared_probe_follower_ = false;
+  scheduleInterval(parent_.intervalWithJitter(0, parent_.initial_jitter_));
+}
+
 void HealthCheckerImplBase::ActiveHealthCheckSession::onIntervalBase() {
+  if (shared_probe_follower_) {
+    // Followers only run their interval to catch up with the last result of their group.
+    if (const SharedProbeResult* result = parent_.shared_probes_->lastResult(shared_probe_key_);
+        result != nullptr) {
+      applySharedResult(*result);
+    }
+    return;
+  }
   onInterval();
   timeout_timer_->enableTimer(parent_.timeout_);
   parent_.stats_.attempt_.inc();
@@ -441,8 +649,7 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onInitialInterval() {
   if (parent_.initial_jitter_.count() == 0) {
     onIntervalBase();
   } else {
-    interval_timer_->enableTimer(
-        std::chrono::milliseconds(parent_.intervalWithJitter(0, parent_.initial_jitter_)));
+    scheduleInterval(parent_.intervalWithJitter(0, parent_.initial_jitter_));
   }
 }
 
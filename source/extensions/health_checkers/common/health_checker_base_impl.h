@@ -1,5 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <list>
+#include <map>
+
 #include "envoy/access_log/access_log.h"
 #include "envoy/common/callback.h"
 #include "envoy/common/random_generator.h"
@@ -7,6 +11,8 @@
 #include "envoy/data/core/v3/health_check_event.pb.h"
 #include "envoy/event/timer.h"
 #include "envoy/runtime/runtime.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
 #include "envoy/stats/scope.h"
 #include "envoy/type/matcher/string.pb.h"
 #include "envoy/upstream/health_checker.h"
@@ -15,6 +21,10 @@
 #include "source/common/common/matchers.h"
 #include "source/common/network/transport_socket_options_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -56,13 +66,115 @@ public:
   }
 
 protected:
+  class ActiveHealthCheckSession;
+
+  /**
+   * Runs the intervals of all sessions of a health checker from a single timer, instead of a timer
+   * per session. Intervals are rounded up to the end of a bucket of BucketWidth, and all sessions
+   * whose interval ends in the same bucket are run from the same timer callback.
+   */
+  class IntervalScheduler {
+  public:
+    static constexpr std::chrono::milliseconds BucketWidth{50};
+
+    using Bucket = std::list<ActiveHealthCheckSession*>;
+
+    // The position of a scheduled session, which allows cancelling it in constant time.
+    struct Position {
+      MonotonicTime deadline_;
+      Bucket::iterator iterator_;
+    };
+
+    IntervalScheduler(Event::Dispatcher& dispatcher);
+
+    /**
+     * Schedule the interval of a session, which must not be scheduled already.
+     */
+    void schedule(ActiveHealthCheckSession& session, std::chrono::milliseconds interval);
+
+    /**
+     * Cancel the interval of a session, if it is scheduled.
+     */
+    void cancel(ActiveHealthCheckSession& session);
+
+  private:
+    void onTimer();
+
+    TimeSource& time_source_;
+    const Event::TimerPtr timer_;
+    // Buckets by deadline. Buckets emptied by cancel() are only removed when their deadline
+    // passes, so that onTimer() can run the sessions of a bucket in place.
+    std::map<MonotonicTime, Bucket> buckets_;
+  };
+
+  // A probe result of the session leading a group of sessions that share probes.
+  struct SharedProbeResult {
+    bool healthy_;
+    bool degraded_;
+    envoy::data::core::v3::HealthCheckFailureType type_;
+    bool retriable_;
+    // Increases with each result of the group.
+    uint64_t sequence_;
+  };
+
+  /**
+   * Deduplicates the probes of health checkers with identical configurations across clusters.
+   * Sessions with the same key, which health checkers derive from the probed address and all the
+   * configuration affecting the probe, form a group. Only the leader of a group probes its host.
+   * The other sessions apply the leader's results, which still count against the thresholds and
+   * update the stats and callbacks of their own health checker.
+   *
+   * Note: the registry must only be used from the main thread.
+   */
+  class SharedProbeRegistry : public Singleton::Instance {
+  public:
+    /**
+     * Add a session to the group of `key`.
+     * @return true if the session leads the group and so probes its host.
+     */
+    bool subscribe(const std::string& key, ActiveHealthCheckSession& session);
+
+    /**
+     * Remove a session from the group of `key`. If the session led the group, another session of
+     * the group is promoted and starts probing.
+     */
+    void unsubscribe(const std::string& key, ActiveHealthCheckSession& session);
+
+    /**
+     * Apply a result of the leader of the group of `key` to the other sessions of the group.
+     */
+    void publish(const std::string& key, bool healthy, bool degraded,
+                 envoy::data::core::v3::HealthCheckFailureType type, bool retriable);
+
+    /**
+     * @return the last result of the group of `key`, or nullptr if its leader has not completed
+     * a probe yet.
+     */
+    const SharedProbeResult* lastResult(const std::string& key) const;
+
+    /**
+     * Returns the registry shared by all health checkers.
+     * @param manager used to create singleton
+     */
+    static std::shared_ptr<SharedProbeRegistry> get(Singleton::Manager& manager);
+
+  private:
+    struct Group {
+      ActiveHealthCheckSession* leader_{};
+      absl::flat_hash_set<ActiveHealthCheckSession*> followers_;
+      absl::optional<SharedProbeResult> last_result_;
+    };
+
+    absl::flat_hash_map<std::string, Group> groups_;
+  };
+
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
   public:
     ~ActiveHealthCheckSession() override;
     HealthTransition setUnhealthy(envoy::data::core::v3::HealthCheckFailureType type,
                                   bool retriable);
     void onDeferredDeleteBase();
-    void start() { onInitialInterval(); }
+    void start();
 
   protected:
     ActiveHealthCheckSession(HealthCheckerImplBase& parent, HostSharedPtr host);
@@ -77,6 +189,11 @@ protected:
     // been health checked.
     // Returns the changed state to use following the flag update.
     HealthTransition clearPendingFlag(HealthTransition changed_state);
+    void scheduleInterval(std::chrono::milliseconds interval);
+    void applySharedResult(const SharedProbeResult& result);
+    void publishSharedResult(bool healthy, bool degraded,
+                             envoy::data::core::v3::HealthCheckFailureType type, bool retriable);
+    void promoteSharedProbeLeader();
     virtual void onInterval() PURE;
     void onIntervalBase();
     virtual void onTimeout() PURE;
@@ -85,12 +202,23 @@ protected:
     void onInitialInterval();
 
     HealthCheckerImplBase& parent_;
+    // Only used without the parent's interval scheduler.
     Event::TimerPtr interval_timer_;
+    absl::optional<IntervalScheduler::Position> scheduled_interval_;
     Event::TimerPtr timeout_timer_;
+    // Set when the session's probes are shared with sessions of other health checkers.
+    std::string shared_probe_key_;
+    // The sequence of the last shared result applied by a follower.
+    uint64_t shared_probe_sequence_{};
     uint32_t num_unhealthy_{};
     uint32_t num_healthy_{};
     bool first_check_{true};
+    // Set when another session probes the host, see SharedProbeRegistry.
+    bool shared_probe_follower_{};
     TimeSource& time_source_;
+
+    friend class IntervalScheduler;
+    friend class SharedProbeRegistry;
   };
 
   using ActiveHealthCheckSessionPtr = std::unique_ptr<ActiveHealthCheckSession>;
@@ -103,6 +231,12 @@ protected:
   virtual ActiveHealthCheckSessionPtr makeSession(HostSharedPtr host) PURE;
   virtual envoy::data::core::v3::HealthCheckerType healthCheckerType() const PURE;
 
+  /**
+   * @return the key under which the probes of `host` may be shared with health checkers of other
+   * clusters, or an empty string if they can not be shared. Only used if shared_probes_ is set.
+   */
+  virtual std::string sharedProbeKey(const HostSharedPtr&) const { return ""; }
+
   const bool always_log_health_check_failures_;
   const bool always_log_health_check_success_;
   const Cluster& cluster_;
@@ -115,6 +249,8 @@ protected:
   Random::RandomGenerator& random_;
   const bool reuse_connection_;
   HealthCheckEventLoggerPtr event_logger_;
+  // Set by health checkers whose probes may be shared across clusters.
+  std::shared_ptr<SharedProbeRegistry> shared_probes_;
 
 private:
   struct HealthCheckHostMonitorImpl : public HealthCheckHostMonitor {
@@ -158,6 +294,8 @@ private:
   const std::chrono::milliseconds unhealthy_interval_;
   const std::chrono::milliseconds unhealthy_edge_interval_;
   const std::chrono::milliseconds healthy_edge_interval_;
+  // Set when the intervals of all sessions share a single timer.
+  const std::unique_ptr<IntervalScheduler> interval_scheduler_;
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
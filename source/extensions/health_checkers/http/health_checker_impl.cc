@@ -22,6 +22,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/socket_impl.h"
 #include "source/common/network/utility.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/router/router.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/upstream/host_utility.h"
@@ -119,6 +120,21 @@ HttpHealthCheckerImpl::HttpHealthCheckerImpl(
           total, response_buffer_size_));
     }
   }
+
+  if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.health_check_shared_probes")) {
+    shared_probes_ = SharedProbeRegistry::get(context.serverFactoryContext().singletonManager());
+    config_hash_ = MessageUtil::hash(config);
+  }
+}
+
+std::string HttpHealthCheckerImpl::sharedProbeKey(const HostSharedPtr& host) const {
+  // Probes over a secure transport depend on the TLS configuration of the cluster, which is not
+  // part of the health check configuration.
+  if (host->transportSocketFactory().implementsSecureTransport()) {
+    return "";
+  }
+  return absl::StrCat(config_hash_, "|", host->healthCheckAddress()->asStringView(), "|",
+                      HealthCheckerFactory::getHostname(host, host_value_, cluster_.info()));
 }
 
 HttpHealthCheckerImpl::HttpStatusChecker::HttpStatusChecker(
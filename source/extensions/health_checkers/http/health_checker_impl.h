@@ -162,6 +162,7 @@ private:
   envoy::data::core::v3::HealthCheckerType healthCheckerType() const override {
     return envoy::data::core::v3::HTTP;
   }
+  std::string sharedProbeKey(const HostSharedPtr& host) const override;
 
   Http::CodecType codecClientType(const envoy::type::v3::CodecClientType& type);
 
@@ -174,6 +175,8 @@ private:
   absl::optional<Matchers::StringMatcherImpl> service_name_matcher_;
   Router::HeaderParserPtr request_headers_parser_;
   const HttpStatusChecker http_status_checker_;
+  // The hash of the health check configuration, set when probes are shared across clusters.
+  uint64_t config_hash_{};
 
 protected:
   const Http::CodecType codec_client_type_;
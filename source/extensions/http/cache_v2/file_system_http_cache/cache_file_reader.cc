@@ -10,22 +10,26 @@ namespace FileSystemHttpCache {
 
 using Common::AsyncFiles::AsyncFileHandle;
 
-CacheFileReader::CacheFileReader(AsyncFileHandle handle) : file_handle_(handle) {}
+CacheFileReader::CacheFileReader(AsyncFileHandle handle, bool map_body_reads)
+    : file_handle_(handle), map_body_reads_(map_body_reads) {}
 
 void CacheFileReader::getBody(Event::Dispatcher& dispatcher, AdjustedByteRange range,
                               GetBodyCallback&& cb) {
-  auto queued = file_handle_->read(
-      &dispatcher, CacheFileFixedBlock::offsetToBody() + range.begin(), range.length(),
-      [len = range.length(),
-       cb = std::move(cb)](absl::StatusOr<Buffer::InstancePtr> read_result) mutable -> void {
-        if (!read_result.ok()) {
-          return cb(nullptr, EndStream::Reset);
-        }
-        if (read_result.value()->length() != len) {
-          return cb(nullptr, EndStream::Reset);
-        }
-        return cb(std::move(read_result.value()), EndStream::More);
-      });
+  auto on_read = [len = range.length(), cb = std::move(cb)](
+                     absl::StatusOr<Buffer::InstancePtr> read_result) mutable -> void {
+    if (!read_result.ok()) {
+      return cb(nullptr, EndStream::Reset);
+    }
+    if (read_result.value()->length() != len) {
+      return cb(nullptr, EndStream::Reset);
+    }
+    return cb(std::move(read_result.value()), EndStream::More);
+  };
+  const off_t offset = CacheFileFixedBlock::offsetToBody() + range.begin();
+  auto queued =
+      map_body_reads_
+          ? file_handle_->mapRead(&dispatcher, offset, range.length(), std::move(on_read))
+          : file_handle_->read(&dispatcher, offset, range.length(), std::move(on_read));
   ASSERT(queued.ok(), queued.status().ToString());
 }
 
@@ -11,13 +11,19 @@ namespace FileSystemHttpCache {
 
 class CacheFileReader : public CacheReader {
 public:
-  CacheFileReader(Common::AsyncFiles::AsyncFileHandle handle);
+  /**
+   * @param handle the open cache file.
+   * @param map_body_reads whether the body is read into memory mappings of the file rather than
+   * copied into buffers.
+   */
+  CacheFileReader(Common::AsyncFiles::AsyncFileHandle handle, bool map_body_reads = false);
   ~CacheFileReader() override;
   // From CacheReader
   void getBody(Event::Dispatcher& dispatcher, AdjustedByteRange range, GetBodyCallback&& cb) final;
 
 private:
   Common::AsyncFiles::AsyncFileHandle file_handle_;
+  const bool map_body_reads_;
 };
 
 } // namespace FileSystemHttpCache
@@ -60,7 +60,7 @@ void FileSystemHttpCache::lookup(LookupRequest&& lookup, LookupCallback&& callba
   std::string filepath = absl::StrCat(cachePath(), generateFilename(lookup.key()));
   async_file_manager_->openExistingFile(
       &lookup.dispatcher(), filepath, Common::AsyncFiles::AsyncFileManager::Mode::ReadOnly,
-      [&dispatcher = lookup.dispatcher(),
+      [&dispatcher = lookup.dispatcher(), map_body_reads = config().map_body_reads(),
        callback = std::move(callback)](absl::StatusOr<AsyncFileHandle> open_result) mutable {
         if (!open_result.ok()) {
           if (open_result.status().code() == absl::StatusCode::kNotFound) {
@@ -69,7 +69,8 @@ void FileSystemHttpCache::lookup(LookupRequest&& lookup, LookupCallback&& callba
           ENVOY_LOG(error, "open file failed: {}", open_result.status());
           return callback(open_result.status());
         }
-        FileLookupContext::begin(dispatcher, std::move(open_result.value()), std::move(callback));
+        FileLookupContext::begin(dispatcher, std::move(open_result.value()), map_body_reads,
+                                 std::move(callback));
       });
 }
 
@@ -13,14 +13,16 @@ namespace CacheV2 {
 namespace FileSystemHttpCache {
 
 FileLookupContext::FileLookupContext(Event::Dispatcher& dispatcher, AsyncFileHandle handle,
-                                     HttpCache::LookupCallback&& callback)
-    : dispatcher_(dispatcher), file_handle_(std::move(handle)), callback_(std::move(callback)) {}
+                                     bool map_body_reads, HttpCache::LookupCallback&& callback)
+    : dispatcher_(dispatcher), file_handle_(std::move(handle)), map_body_reads_(map_body_reads),
+      callback_(std::move(callback)) {}
 
 void FileLookupContext::begin(Event::Dispatcher& dispatcher, AsyncFileHandle handle,
-                              HttpCache::LookupCallback&& callback) {
+                              bool map_body_reads, HttpCache::LookupCallback&& callback) {
   // bare pointer because this object owns itself - it gets captured in
   // lambdas and is deleted when 'done' is eventually called.
-  FileLookupContext* p = new FileLookupContext(dispatcher, std::move(handle), std::move(callback));
+  FileLookupContext* p = new FileLookupContext(dispatcher, std::move(handle), map_body_reads,
+                                               std::move(callback));
   p->getHeaderBlock();
 }
 
@@ -73,8 +75,8 @@ void FileLookupContext::getHeaders() {
                            result_.response_headers_ = headersFromHeaderProto(header_proto);
                            result_.response_metadata_ = metadataFromHeaderProto(header_proto);
                            result_.body_length_ = header_block_.bodySize();
-                           result_.cache_reader_ =
-                               std::make_unique<CacheFileReader>(std::move(file_handle_));
+                           result_.cache_reader_ = std::make_unique<CacheFileReader>(
+                               std::move(file_handle_), map_body_reads_);
                            return done(std::move(result_));
                          });
   ASSERT(queued.ok(), queued.status().ToString());
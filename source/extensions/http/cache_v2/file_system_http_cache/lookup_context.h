@@ -19,11 +19,11 @@ using Envoy::Extensions::Common::AsyncFiles::AsyncFileHandle;
 
 class FileLookupContext {
 public:
-  static void begin(Event::Dispatcher& dispatcher, AsyncFileHandle handle,
+  static void begin(Event::Dispatcher& dispatcher, AsyncFileHandle handle, bool map_body_reads,
                     HttpCache::LookupCallback&& callback);
 
 private:
-  FileLookupContext(Event::Dispatcher& dispatcher, AsyncFileHandle handle,
+  FileLookupContext(Event::Dispatcher& dispatcher, AsyncFileHandle handle, bool map_body_reads,
                     HttpCache::LookupCallback&& callback);
   void getHeaderBlock();
   void getHeaders();
@@ -32,6 +32,7 @@ private:
 
   Event::Dispatcher& dispatcher_;
   AsyncFileHandle file_handle_;
+  const bool map_body_reads_;
   CacheFileFixedBlock header_block_;
   HttpCache::LookupCallback callback_;
   LookupResult result_;
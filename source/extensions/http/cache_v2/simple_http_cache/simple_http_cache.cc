@@ -1,5 +1,7 @@
 #include "source/extensions/http/cache_v2/simple_http_cache/simple_http_cache.h"
 
+#include <algorithm>
+
 #include "envoy/extensions/http/cache_v2/simple_http_cache/v3/config.pb.h"
 #include "envoy/registry/registry.h"
 
@@ -32,6 +34,23 @@ private:
   HttpSourcePtr source_;
 };
 
+// A fragment of a body chunk of an entry, keeping the chunk alive until the buffer is drained.
+class BodyChunkFragment : public Buffer::BufferFragment {
+public:
+  BodyChunkFragment(std::shared_ptr<const std::string> chunk, uint64_t offset, uint64_t length)
+      : chunk_(std::move(chunk)), offset_(offset), length_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return chunk_->data() + offset_; }
+  size_t size() const override { return length_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> chunk_;
+  const uint64_t offset_;
+  const uint64_t length_;
+};
+
 class SimpleHttpCacheReader : public CacheReader {
 public:
   SimpleHttpCacheReader(std::shared_ptr<SimpleHttpCache::Entry> entry) : entry_(std::move(entry)) {}
@@ -109,19 +128,39 @@ void InsertContext::onTrailers(Http::ResponseTrailerMapPtr trailers, EndStream e
 } // namespace
 
 Buffer::InstancePtr SimpleHttpCache::Entry::body(AdjustedByteRange range) const {
+  auto buffer = std::make_unique<Buffer::OwnedImpl>();
   absl::ReaderMutexLock lock(mu_);
-  return std::make_unique<Buffer::OwnedImpl>(
-      absl::string_view{body_}.substr(range.begin(), range.length()));
+  // Starts with the first chunk ending after the beginning of the range.
+  const size_t first_chunk =
+      std::upper_bound(body_chunk_ends_.begin(), body_chunk_ends_.end(), range.begin()) -
+      body_chunk_ends_.begin();
+  for (size_t i = first_chunk; i < body_chunks_.size(); i++) {
+    const uint64_t chunk_begin = i == 0 ? 0 : body_chunk_ends_[i - 1];
+    if (chunk_begin >= range.end()) {
+      break;
+    }
+    const uint64_t begin = std::max(range.begin(), chunk_begin);
+    const uint64_t end = std::min(range.end(), body_chunk_ends_[i]);
+    buffer->addBufferFragment(
+        *new BodyChunkFragment(body_chunks_[i], begin - chunk_begin, end - begin));
+  }
+  return buffer;
 }
 
 void SimpleHttpCache::Entry::appendBody(Buffer::InstancePtr buf) {
+  if (buf->length() == 0) {
+    return;
+  }
+  auto chunk = std::make_shared<const std::string>(buf->toString());
   absl::WriterMutexLock lock(mu_);
-  body_ += buf->toString();
+  body_chunk_ends_.push_back(
+      (body_chunk_ends_.empty() ? 0 : body_chunk_ends_.back()) + chunk->size());
+  body_chunks_.push_back(std::move(chunk));
 }
 
 uint64_t SimpleHttpCache::Entry::bodySize() const {
   absl::ReaderMutexLock lock(mu_);
-  return body_.size();
+  return body_chunk_ends_.empty() ? 0 : body_chunk_ends_.back();
 }
 
 Http::ResponseHeaderMapPtr SimpleHttpCache::Entry::copyHeaders() const {
@@ -168,9 +207,10 @@ CacheInfo SimpleHttpCache::cacheInfo() const {
 void SimpleHttpCache::lookup(LookupRequest&& request, LookupCallback&& callback) {
   LookupResult result;
   {
-    absl::ReaderMutexLock lock(mu_);
-    auto it = entries_.find(request.key());
-    if (it != entries_.end()) {
+    Shard& shard = shardFor(request.key());
+    absl::ReaderMutexLock lock(shard.mu_);
+    auto it = shard.entries_.find(request.key());
+    if (it != shard.entries_.end()) {
       result.cache_reader_ = std::make_unique<SimpleHttpCacheReader>(it->second);
       result.response_headers_ = it->second->copyHeaders();
       result.response_metadata_ = it->second->metadata();
@@ -182,16 +222,18 @@ void SimpleHttpCache::lookup(LookupRequest&& request, LookupCallback&& callback)
 }
 
 void SimpleHttpCache::evict(Event::Dispatcher&, const Key& key) {
-  absl::WriterMutexLock lock(mu_);
-  entries_.erase(key);
+  Shard& shard = shardFor(key);
+  absl::WriterMutexLock lock(shard.mu_);
+  shard.entries_.erase(key);
 }
 
 void SimpleHttpCache::updateHeaders(Event::Dispatcher&, const Key& key,
                                     const Http::ResponseHeaderMap& updated_headers,
                                     const ResponseMetadata& updated_metadata) {
-  absl::WriterMutexLock lock(mu_);
-  auto it = entries_.find(key);
-  if (it == entries_.end()) {
+  Shard& shard = shardFor(key);
+  absl::WriterMutexLock lock(shard.mu_);
+  auto it = shard.entries_.find(key);
+  if (it == shard.entries_.end()) {
     return;
   }
   it->second->updateHeadersAndMetadata(
@@ -204,8 +246,9 @@ void SimpleHttpCache::insert(Event::Dispatcher&, Key key, Http::ResponseHeaderMa
   auto entry = std::make_shared<Entry>(Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*headers),
                                        std::move(metadata));
   {
-    absl::WriterMutexLock lock(mu_);
-    entries_.emplace(key, entry);
+    Shard& shard = shardFor(key);
+    absl::WriterMutexLock lock(shard.mu_);
+    shard.entries_.emplace(key, entry);
   }
   if (source) {
     progress->onHeadersInserted(std::make_unique<SimpleHttpCacheReader>(entry), std::move(headers),
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/filters/http/cache_v2/http_cache.h"
 
@@ -32,8 +37,12 @@ public:
 
   private:
     mutable absl::Mutex mu_;
-    // Body can be being written to while being read from, so mutex guarded.
-    std::string body_ ABSL_GUARDED_BY(mu_);
+    // Body can be being written to while being read from, so mutex guarded. It is kept as the
+    // immutable chunks it was inserted in, which the buffers of the readers reference rather than
+    // copy, so that a hit never copies the body.
+    std::vector<std::shared_ptr<const std::string>> body_chunks_ ABSL_GUARDED_BY(mu_);
+    // The offset in the body of the end of each chunk.
+    std::vector<uint64_t> body_chunk_ends_ ABSL_GUARDED_BY(mu_);
     Http::ResponseHeaderMapPtr response_headers_ ABSL_GUARDED_BY(mu_);
     ResponseMetadata metadata_ ABSL_GUARDED_BY(mu_);
     bool end_stream_after_body_{false};
@@ -53,9 +62,18 @@ public:
               ResponseMetadata metadata, HttpSourcePtr source,
               std::shared_ptr<CacheProgressReceiver> progress) override;
 
-  absl::Mutex mu_;
-  absl::flat_hash_map<Key, std::shared_ptr<Entry>, MessageUtil, MessageUtil>
-      entries_ ABSL_GUARDED_BY(mu_);
+private:
+  // The entries are sharded by key, so that the lookups and insertions of different keys rarely
+  // contend on a lock.
+  static constexpr size_t NumShards = 16;
+  struct Shard {
+    absl::Mutex mu_;
+    absl::flat_hash_map<Key, std::shared_ptr<Entry>, MessageUtil, MessageUtil>
+        entries_ ABSL_GUARDED_BY(mu_);
+  };
+  Shard& shardFor(const Key& key) { return shards_[MessageUtil::hash(key) % NumShards]; }
+
+  std::array<Shard, NumShards> shards_;
 };
 
 } // namespace CacheV2
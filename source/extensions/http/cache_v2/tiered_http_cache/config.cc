@@ -0,0 +1,116 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache_v2/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/extensions/http/cache_v2/tiered_http_cache/v3/tiered_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache_v2/cache_sessions.h"
+#include "source/extensions/filters/http/cache_v2/http_cache.h"
+#include "source/extensions/http/cache_v2/tiered_http_cache/tiered_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace CacheV2 {
+namespace TieredHttpCache {
+namespace {
+
+/**
+ * A singleton that acts as a factory for generating and looking up TieredHttpCaches, so that
+ * the filters configured with equivalent configs share the same memory tier.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  absl::StatusOr<std::shared_ptr<CacheSessions>>
+  get(std::shared_ptr<CacheSingleton> singleton,
+      const envoy::extensions::filters::http::cache_v2::v3::CacheV2Config& filter_config,
+      const ConfigProto& config, Server::Configuration::FactoryContext& context) {
+    const uint64_t key = MessageUtil::hash(config);
+    {
+      absl::MutexLock lock(mu_);
+      std::shared_ptr<CacheSessions> cache = find(key, config);
+      if (cache) {
+        return cache;
+      }
+    }
+    // The next tier is created without holding the lock, as it may be a tiered cache too.
+    const std::string type{TypeUtil::typeUrlToDescriptorFullName(config.next_tier().type_url())};
+    HttpCacheFactory* const next_tier_factory =
+        Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(type);
+    if (next_tier_factory == nullptr) {
+      return absl::InvalidArgumentError(
+          fmt::format("Didn't find a registered implementation for type: '{}'", type));
+    }
+    envoy::extensions::filters::http::cache_v2::v3::CacheV2Config next_tier_config = filter_config;
+    *next_tier_config.mutable_typed_config() = config.next_tier();
+    absl::StatusOr<std::shared_ptr<CacheSessions>> next_tier =
+        next_tier_factory->getCache(next_tier_config, context);
+    if (!next_tier.ok()) {
+      return next_tier.status();
+    }
+    absl::MutexLock lock(mu_);
+    std::shared_ptr<CacheSessions> cache = find(key, config);
+    if (!cache) {
+      cache = CacheSessions::create(
+          context, std::make_unique<TieredHttpCache>(config, std::move(next_tier.value()),
+                                                     std::move(singleton), context.scope(),
+                                                     context.serverFactoryContext().timeSource()));
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  std::shared_ptr<CacheSessions> find(uint64_t key, const ConfigProto& config)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto it = caches_.find(key);
+    if (it == caches_.end()) {
+      return nullptr;
+    }
+    std::shared_ptr<CacheSessions> cache = it->second.lock();
+    if (cache && !Protobuf::util::MessageDifferencer::Equals(
+                     static_cast<TieredHttpCache&>(cache->cache()).config(), config)) {
+      return nullptr;
+    }
+    return cache;
+  }
+
+  absl::Mutex mu_;
+  // We keep weak_ptr here so the caches can be destroyed if the config is updated to stop using
+  // them. The caches each keep a shared_ptr to this singleton.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<CacheSessions>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(tiered_http_cache_v2_singleton);
+
+class TieredHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{TieredHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ConfigProto>();
+  }
+  // From HttpCacheFactory
+  absl::StatusOr<std::shared_ptr<CacheSessions>>
+  getCache(const envoy::extensions::filters::http::cache_v2::v3::CacheV2Config& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    ConfigProto config;
+    RETURN_IF_NOT_OK(MessageUtil::unpackTo(filter_config.typed_config(), config));
+    std::shared_ptr<CacheSingleton> caches =
+        context.serverFactoryContext().singletonManager().getTyped<CacheSingleton>(
+            SINGLETON_MANAGER_REGISTERED_NAME(tiered_http_cache_v2_singleton),
+            [] { return std::make_shared<CacheSingleton>(); });
+    return caches->get(caches, filter_config, config, context);
+  }
+};
+
+static Registry::RegisterFactory<TieredHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace CacheV2
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,489 @@
+#include "source/extensions/http/cache_v2/tiered_http_cache/tiered_http_cache.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace CacheV2 {
+namespace TieredHttpCache {
+namespace {
+
+constexpr uint64_t DefaultMaxMemorySizeBytes = 64 * 1024 * 1024;
+constexpr uint64_t DefaultMaxMemoryEntrySizeBytes = 1024 * 1024;
+constexpr uint32_t DefaultMinLookupsToAdmit = 2;
+// The frequency sketch has a counter per KiB of the memory tier, a byte each, and enough counters
+// for the keys of small memory tiers not to share them all.
+constexpr uint64_t MemoryBytesPerSketchCounter = 1024;
+constexpr uint64_t MinSketchCounters = 256;
+
+Http::ResponseHeaderMapPtr copyHeaders(const Http::ResponseHeaderMap& headers) {
+  return Http::createHeaderMap<Http::ResponseHeaderMapImpl>(headers);
+}
+
+Http::ResponseTrailerMapPtr copyTrailers(const Http::ResponseTrailerMap* trailers) {
+  if (trailers == nullptr) {
+    return nullptr;
+  }
+  return Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*trailers);
+}
+
+// A fragment of the body of an entry, keeping the body alive until the buffer is drained.
+class BodyFragment : public Buffer::BufferFragment {
+public:
+  BodyFragment(std::shared_ptr<const std::string> body, uint64_t offset, uint64_t length)
+      : body_(std::move(body)), offset_(offset), length_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_->data() + offset_; }
+  size_t size() const override { return length_; }
+  void done() override { delete this; }
+
+private:
+  const std::shared_ptr<const std::string> body_;
+  const uint64_t offset_;
+  const uint64_t length_;
+};
+
+class MemoryEntryReader : public CacheReader {
+public:
+  explicit MemoryEntryReader(MemoryEntrySharedPtr entry) : entry_(std::move(entry)) {}
+
+  // CacheReader
+  void getBody(Event::Dispatcher&, AdjustedByteRange range, GetBodyCallback&& cb) override {
+    auto buffer = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      buffer->addBufferFragment(*new BodyFragment(entry_->body_, range.begin(), range.length()));
+    }
+    cb(std::move(buffer), EndStream::More);
+  }
+
+private:
+  const MemoryEntrySharedPtr entry_;
+};
+
+LookupResult lookupResultFromEntry(MemoryEntrySharedPtr entry) {
+  LookupResult result;
+  result.response_headers_ = copyHeaders(*entry->headers_);
+  result.response_trailers_ = copyTrailers(entry->trailers_.get());
+  result.response_metadata_ = entry->metadata_;
+  result.body_length_ = entry->body_->size();
+  result.cache_reader_ = std::make_unique<MemoryEntryReader>(std::move(entry));
+  return result;
+}
+
+// An entry copied into the memory tier as its body is read, from the next tier or from upstream,
+// and inserted in the memory tier once complete. Thread safe, as the body of an entry of the next
+// tier may be read by the requests of many workers.
+class PendingEntry {
+public:
+  PendingEntry(std::shared_ptr<MemoryTier> memory_tier, Key key,
+               Http::ResponseHeaderMapPtr headers, ResponseMetadata metadata,
+               Http::ResponseTrailerMapPtr trailers, absl::optional<uint64_t> body_length,
+               Stats::Counter& inserted)
+      : memory_tier_(std::move(memory_tier)), key_(std::move(key)), headers_(std::move(headers)),
+        metadata_(std::move(metadata)), trailers_(std::move(trailers)), body_length_(body_length),
+        inserted_(inserted) {}
+
+  // Copies a part of the body, which is ignored unless it follows the parts copied so far. The
+  // entry is abandoned if it gets too large, and completed if the body has the expected length.
+  void appendBody(uint64_t offset, const Buffer::Instance& body) {
+    absl::MutexLock lock(mu_);
+    if (done_ || offset != body_.size() || body.length() == 0) {
+      return;
+    }
+    if (!memory_tier_->fits(headers_->byteSize() + body_.size() + body.length())) {
+      abandonLocked();
+      return;
+    }
+    if (body_length_.has_value()) {
+      body_.reserve(body_length_.value());
+    }
+    body_.resize(offset + body.length());
+    body.copyOut(0, body.length(), body_.data() + offset);
+    if (body_length_.has_value() && body_.size() == body_length_.value()) {
+      completeLocked();
+    }
+  }
+
+  // Inserts the entry in the memory tier, unless it was abandoned.
+  void complete(Http::ResponseTrailerMapPtr trailers) {
+    absl::MutexLock lock(mu_);
+    if (done_) {
+      return;
+    }
+    if (trailers != nullptr) {
+      trailers_ = std::move(trailers);
+    }
+    completeLocked();
+  }
+
+  void abandon() {
+    absl::MutexLock lock(mu_);
+    abandonLocked();
+  }
+
+private:
+  void completeLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    done_ = true;
+    memory_tier_->insert(std::make_shared<const MemoryEntry>(
+        std::move(key_), std::move(headers_), std::move(metadata_),
+        std::make_shared<const std::string>(std::move(body_)), std::move(trailers_)));
+    inserted_.inc();
+  }
+
+  void abandonLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    done_ = true;
+    std::string().swap(body_);
+  }
+
+  const std::shared_ptr<MemoryTier> memory_tier_;
+  absl::Mutex mu_;
+  Key key_ ABSL_GUARDED_BY(mu_);
+  Http::ResponseHeaderMapPtr headers_ ABSL_GUARDED_BY(mu_);
+  ResponseMetadata metadata_ ABSL_GUARDED_BY(mu_);
+  Http::ResponseTrailerMapPtr trailers_ ABSL_GUARDED_BY(mu_);
+  std::string body_ ABSL_GUARDED_BY(mu_);
+  bool done_ ABSL_GUARDED_BY(mu_){false};
+  // Known for the entries of the next tier, not for the inserted ones.
+  const absl::optional<uint64_t> body_length_;
+  Stats::Counter& inserted_;
+};
+
+// A reader of an entry of the next tier, promoting the entry to the memory tier once its whole
+// body has been read in order.
+class PromotingReader : public CacheReader {
+public:
+  PromotingReader(CacheReaderPtr reader, std::shared_ptr<PendingEntry> pending)
+      : reader_(std::move(reader)), pending_(std::move(pending)) {}
+
+  // CacheReader
+  void getBody(Event::Dispatcher& dispatcher, AdjustedByteRange range,
+               GetBodyCallback&& cb) override {
+    reader_->getBody(dispatcher, range,
+                     [pending = pending_, offset = range.begin(), cb = std::move(cb)](
+                         Buffer::InstancePtr buffer, EndStream end_stream) mutable {
+                       if (buffer != nullptr && end_stream == EndStream::More) {
+                         pending->appendBody(offset, *buffer);
+                       }
+                       cb(std::move(buffer), end_stream);
+                     });
+  }
+
+private:
+  const CacheReaderPtr reader_;
+  const std::shared_ptr<PendingEntry> pending_;
+};
+
+// The source of an entry inserted in the next tier, copying the entry into the memory tier as
+// the next tier reads it.
+class WriteThroughSource : public HttpSource {
+public:
+  WriteThroughSource(std::shared_ptr<PendingEntry> pending, HttpSourcePtr source)
+      : pending_(std::move(pending)), source_(std::move(source)) {}
+
+  // HttpSource
+  void getHeaders(GetHeadersCallback&& cb) override { source_->getHeaders(std::move(cb)); }
+  void getBody(AdjustedByteRange range, GetBodyCallback&& cb) override {
+    source_->getBody(range, [pending = pending_, offset = range.begin(), cb = std::move(cb)](
+                                Buffer::InstancePtr buffer, EndStream end_stream) mutable {
+      if (end_stream == EndStream::Reset) {
+        pending->abandon();
+      } else {
+        if (buffer != nullptr) {
+          pending->appendBody(offset, *buffer);
+        }
+        // Neither buffer nor EndStream::End means trailers follow.
+        if (end_stream == EndStream::End) {
+          pending->complete(nullptr);
+        }
+      }
+      cb(std::move(buffer), end_stream);
+    });
+  }
+  void getTrailers(GetTrailersCallback&& cb) override {
+    source_->getTrailers([pending = pending_, cb = std::move(cb)](
+                             Http::ResponseTrailerMapPtr trailers, EndStream end_stream) mutable {
+      if (end_stream == EndStream::Reset) {
+        pending->abandon();
+      } else {
+        pending->complete(copyTrailers(trailers.get()));
+      }
+      cb(std::move(trailers), end_stream);
+    });
+  }
+
+private:
+  const std::shared_ptr<PendingEntry> pending_;
+  const HttpSourcePtr source_;
+};
+
+// Makes the reader of an entry found in the next tier promote the entry to the memory tier once
+// read, if admitted.
+void promoteOnRead(const std::shared_ptr<MemoryTier>& memory_tier, Key key, LookupResult& result) {
+  if (!memory_tier->admits(key)) {
+    return;
+  }
+  const uint64_t body_length = result.body_length_.value();
+  const uint64_t size =
+      result.response_headers_->byteSize() + body_length +
+      (result.response_trailers_ != nullptr ? result.response_trailers_->byteSize() : 0);
+  if (!memory_tier->fits(size)) {
+    return;
+  }
+  auto pending = std::make_shared<PendingEntry>(
+      memory_tier, std::move(key), copyHeaders(*result.response_headers_),
+      result.response_metadata_, copyTrailers(result.response_trailers_.get()), body_length,
+      memory_tier->stats().promotions_);
+  if (body_length == 0) {
+    pending->complete(nullptr);
+  } else if (result.cache_reader_ != nullptr) {
+    result.cache_reader_ =
+        std::make_unique<PromotingReader>(std::move(result.cache_reader_), std::move(pending));
+  }
+}
+
+} // namespace
+
+TieredHttpCacheStats generateStats(Stats::Scope& scope) {
+  const std::string prefix = "tiered_http_cache.";
+  return {ALL_TIERED_HTTP_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                      POOL_GAUGE_PREFIX(scope, prefix),
+                                      POOL_HISTOGRAM_PREFIX(scope, prefix))};
+}
+
+FrequencySketch::FrequencySketch(uint64_t num_counters)
+    : counters_(absl::bit_ceil(std::max<uint64_t>(num_counters, 1))), mask_(counters_.size() - 1),
+      sample_size_(10 * counters_.size()) {}
+
+uint64_t FrequencySketch::index(uint64_t hash, uint32_t i) const {
+  // Double hashing, the high half of the hash being made odd to step through all the counters.
+  return (hash + i * ((hash >> 32) | 1)) & mask_;
+}
+
+uint8_t FrequencySketch::estimate(uint64_t hash) const {
+  uint8_t count = std::numeric_limits<uint8_t>::max();
+  for (uint32_t i = 0; i < NumHashes; i++) {
+    count = std::min(count, counters_[index(hash, i)]);
+  }
+  return count;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  const uint8_t count = estimate(hash);
+  if (count == std::numeric_limits<uint8_t>::max()) {
+    return;
+  }
+  // Only incrementing the smallest counters keeps the keys sharing the others from being counted.
+  for (uint32_t i = 0; i < NumHashes; i++) {
+    uint8_t& counter = counters_[index(hash, i)];
+    if (counter == count) {
+      counter++;
+    }
+  }
+  if (++increments_ >= sample_size_) {
+    halve();
+  }
+}
+
+void FrequencySketch::halve() {
+  for (uint8_t& counter : counters_) {
+    counter >>= 1;
+  }
+  increments_ /= 2;
+}
+
+MemoryEntry::MemoryEntry(Key key, Http::ResponseHeaderMapPtr headers, ResponseMetadata metadata,
+                         std::shared_ptr<const std::string> body,
+                         Http::ResponseTrailerMapPtr trailers)
+    : key_(std::move(key)), headers_(std::move(headers)), metadata_(std::move(metadata)),
+      body_(std::move(body)), trailers_(std::move(trailers)),
+      size_(headers_->byteSize() + body_->size() +
+            (trailers_ != nullptr ? trailers_->byteSize() : 0)) {}
+
+MemoryTier::MemoryTier(const ConfigProto& config, Stats::Scope& scope)
+    : stats_(generateStats(scope)),
+      max_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_memory_size_bytes,
+                                                      DefaultMaxMemorySizeBytes)),
+      max_entry_size_bytes_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_memory_entry_size_bytes,
+                                                            DefaultMaxMemoryEntrySizeBytes)),
+      // The counts of the sketch saturate, so the keys looked up more often than that are admitted.
+      min_lookups_to_admit_(std::min<uint32_t>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, min_lookups_to_admit, DefaultMinLookupsToAdmit),
+          std::numeric_limits<uint8_t>::max())),
+      sketch_(std::max(max_size_bytes_ / MemoryBytesPerSketchCounter, MinSketchCounters)) {}
+
+MemoryEntrySharedPtr MemoryTier::lookup(const Key& key) {
+  const uint64_t hash = stableHashKey(key);
+  absl::MutexLock lock(mu_);
+  sketch_.increment(hash);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return *it->second;
+}
+
+bool MemoryTier::admits(const Key& key) const {
+  const uint64_t hash = stableHashKey(key);
+  absl::MutexLock lock(mu_);
+  return sketch_.estimate(hash) >= min_lookups_to_admit_;
+}
+
+void MemoryTier::insert(MemoryEntrySharedPtr entry) {
+  if (!fits(entry->size_)) {
+    return;
+  }
+  absl::MutexLock lock(mu_);
+  auto it = index_.find(entry->key_);
+  if (it != index_.end()) {
+    eraseLocked(it->second);
+  }
+  size_bytes_ += entry->size_;
+  entries_.push_front(std::move(entry));
+  index_.emplace(entries_.front()->key_, entries_.begin());
+  evictLocked();
+  updateGaugesLocked();
+}
+
+void MemoryTier::updateHeaders(const Key& key, const Http::ResponseHeaderMap& headers,
+                               const ResponseMetadata& metadata) {
+  absl::MutexLock lock(mu_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return;
+  }
+  const MemoryEntry& entry = **it->second;
+  auto updated = std::make_shared<const MemoryEntry>(entry.key_, copyHeaders(headers), metadata,
+                                                     entry.body_,
+                                                     copyTrailers(entry.trailers_.get()));
+  size_bytes_ = size_bytes_ - entry.size_ + updated->size_;
+  *it->second = std::move(updated);
+  evictLocked();
+  updateGaugesLocked();
+}
+
+void MemoryTier::erase(const Key& key) {
+  absl::MutexLock lock(mu_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return;
+  }
+  eraseLocked(it->second);
+  updateGaugesLocked();
+}
+
+void MemoryTier::eraseLocked(EntryList::iterator it) {
+  size_bytes_ -= (*it)->size_;
+  index_.erase((*it)->key_);
+  entries_.erase(it);
+}
+
+void MemoryTier::evictLocked() {
+  while (size_bytes_ > max_size_bytes_ && !entries_.empty()) {
+    eraseLocked(std::prev(entries_.end()));
+    stats_.memory_evictions_.inc();
+  }
+}
+
+void MemoryTier::updateGaugesLocked() {
+  stats_.memory_size_bytes_.set(size_bytes_);
+  stats_.memory_entries_.set(entries_.size());
+}
+
+TieredHttpCache::TieredHttpCache(const ConfigProto& config,
+                                 std::shared_ptr<CacheSessions> next_tier,
+                                 std::shared_ptr<Singleton::Instance> owner, Stats::Scope& scope,
+                                 TimeSource& time_source)
+    : config_(config), next_tier_(std::move(next_tier)), owner_(std::move(owner)),
+      time_source_(time_source), memory_tier_(std::make_shared<MemoryTier>(config, scope)) {}
+
+CacheInfo TieredHttpCache::cacheInfo() const {
+  CacheInfo info;
+  info.name_ = name();
+  return info;
+}
+
+void TieredHttpCache::lookup(LookupRequest&& request, LookupCallback&& callback) {
+  const MonotonicTime start = time_source_.monotonicTime();
+  MemoryEntrySharedPtr entry = memory_tier_->lookup(request.key());
+  const MonotonicTime next_tier_start = time_source_.monotonicTime();
+  const TieredHttpCacheStats& stats = memory_tier_->stats();
+  stats.memory_lookup_duration_us_.recordValue(
+      std::chrono::duration_cast<std::chrono::microseconds>(next_tier_start - start).count());
+  if (entry != nullptr) {
+    stats.memory_hits_.inc();
+    return callback(lookupResultFromEntry(std::move(entry)));
+  }
+  Key key = request.key();
+  nextTier().lookup(
+      std::move(request),
+      [memory_tier = memory_tier_, key = std::move(key), &time_source = time_source_,
+       next_tier_start,
+       callback = std::move(callback)](absl::StatusOr<LookupResult>&& result) mutable {
+        const TieredHttpCacheStats& stats = memory_tier->stats();
+        stats.next_tier_lookup_duration_ms_.recordValue(
+            std::chrono::duration_cast<std::chrono::milliseconds>(time_source.monotonicTime() -
+                                                                  next_tier_start)
+                .count());
+        if (result.ok()) {
+          if (result.value().populated()) {
+            stats.next_tier_hits_.inc();
+            promoteOnRead(memory_tier, std::move(key), result.value());
+          } else {
+            stats.next_tier_misses_.inc();
+          }
+        }
+        callback(std::move(result));
+      });
+}
+
+void TieredHttpCache::evict(Event::Dispatcher& dispatcher, const Key& key) {
+  memory_tier_->erase(key);
+  nextTier().evict(dispatcher, key);
+}
+
+void TieredHttpCache::touch(const Key& key, SystemTime timestamp) {
+  nextTier().touch(key, timestamp);
+}
+
+void TieredHttpCache::updateHeaders(Event::Dispatcher& dispatcher, const Key& key,
+                                    const Http::ResponseHeaderMap& updated_headers,
+                                    const ResponseMetadata& updated_metadata) {
+  memory_tier_->updateHeaders(key, updated_headers, updated_metadata);
+  nextTier().updateHeaders(dispatcher, key, updated_headers, updated_metadata);
+}
+
+void TieredHttpCache::insert(Event::Dispatcher& dispatcher, Key key,
+                             Http::ResponseHeaderMapPtr headers, ResponseMetadata metadata,
+                             HttpSourcePtr source,
+                             std::shared_ptr<CacheProgressReceiver> progress) {
+  // The entry being replaced is dropped from memory right away, while the new one is only kept
+  // in memory once complete.
+  memory_tier_->erase(key);
+  if (memory_tier_->admits(key) && memory_tier_->fits(headers->byteSize())) {
+    auto pending = std::make_shared<PendingEntry>(memory_tier_, key, copyHeaders(*headers),
+                                                  metadata, nullptr, absl::nullopt,
+                                                  memory_tier_->stats().write_throughs_);
+    if (source == nullptr) {
+      pending->complete(nullptr);
+    } else {
+      source = std::make_unique<WriteThroughSource>(std::move(pending), std::move(source));
+    }
+  }
+  nextTier().insert(dispatcher, std::move(key), std::move(headers), std::move(metadata),
+                    std::move(source), std::move(progress));
+}
+
+} // namespace TieredHttpCache
+} // namespace CacheV2
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
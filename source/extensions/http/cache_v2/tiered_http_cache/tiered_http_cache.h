@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/http/cache_v2/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache_v2/cache_sessions.h"
+#include "source/extensions/filters/http/cache_v2/http_cache.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace CacheV2 {
+namespace TieredHttpCache {
+
+using ConfigProto =
+    envoy::extensions::http::cache_v2::tiered_http_cache::v3::TieredHttpCacheV2Config;
+
+/**
+ * All the stats of a tiered cache. @see stats_macros.h
+ *
+ * @memory_hits: the lookups served by the memory tier.
+ * @next_tier_hits: the lookups missing the memory tier and served by the next tier.
+ * @next_tier_misses: the lookups missing both tiers.
+ * @promotions: the entries copied into the memory tier after being read from the next tier.
+ * @write_throughs: the entries copied into the memory tier when inserted.
+ * @memory_evictions: the entries dropped from the memory tier to make room for others.
+ * @memory_size_bytes: the bytes of the entries of the memory tier.
+ * @memory_entries: the entries of the memory tier.
+ * @memory_lookup_duration_us: the duration of the lookups in the memory tier.
+ * @next_tier_lookup_duration_ms: the duration of the lookups in the next tier.
+ */
+#define ALL_TIERED_HTTP_CACHE_STATS(COUNTER, GAUGE, HISTOGRAM)                                     \
+  COUNTER(memory_hits)                                                                             \
+  COUNTER(next_tier_hits)                                                                          \
+  COUNTER(next_tier_misses)                                                                        \
+  COUNTER(promotions)                                                                              \
+  COUNTER(write_throughs)                                                                          \
+  COUNTER(memory_evictions)                                                                        \
+  GAUGE(memory_size_bytes, NeverImport)                                                            \
+  GAUGE(memory_entries, NeverImport)                                                               \
+  HISTOGRAM(memory_lookup_duration_us, Microseconds)                                               \
+  HISTOGRAM(next_tier_lookup_duration_ms, Milliseconds)
+
+/**
+ * Wrapper struct for the tiered cache stats. @see stats_macros.h
+ */
+struct TieredHttpCacheStats {
+  ALL_TIERED_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT,
+                              GENERATE_HISTOGRAM_STRUCT)
+};
+
+TieredHttpCacheStats generateStats(Stats::Scope& scope);
+
+/**
+ * Approximate counts of the recent lookups of the keys, in a fixed amount of memory. Each key has
+ * a few counters picked by its hash, of which only the smallest are incremented, and its count is
+ * the smallest of them. All the counters are halved after a number of increments proportional to
+ * their number, so that the counts reflect the recent popularity of the keys. Not thread safe.
+ */
+class FrequencySketch {
+public:
+  // The number of counters is rounded up to a power of two.
+  explicit FrequencySketch(uint64_t num_counters);
+
+  /**
+   * Counts a lookup of a key.
+   * @param hash the hash of the key.
+   */
+  void increment(uint64_t hash);
+
+  /**
+   * @param hash the hash of a key.
+   * @return the approximate count of the recent lookups of the key.
+   */
+  uint8_t estimate(uint64_t hash) const;
+
+private:
+  static constexpr uint32_t NumHashes = 4;
+  uint64_t index(uint64_t hash, uint32_t i) const;
+  void halve();
+
+  std::vector<uint8_t> counters_;
+  const uint64_t mask_;
+  const uint64_t sample_size_;
+  uint64_t increments_{0};
+};
+
+/**
+ * An entry of the memory tier. Immutable, so that the readers can keep serving it when it is
+ * replaced or evicted.
+ */
+struct MemoryEntry {
+  MemoryEntry(Key key, Http::ResponseHeaderMapPtr headers, ResponseMetadata metadata,
+              std::shared_ptr<const std::string> body, Http::ResponseTrailerMapPtr trailers);
+
+  const Key key_;
+  const Http::ResponseHeaderMapPtr headers_;
+  const ResponseMetadata metadata_;
+  const std::shared_ptr<const std::string> body_;
+  const Http::ResponseTrailerMapPtr trailers_;
+  // The bytes of the headers, body and trailers.
+  const uint64_t size_;
+};
+using MemoryEntrySharedPtr = std::shared_ptr<const MemoryEntry>;
+
+/**
+ * The memory tier of a tiered cache: a least recently used list of entries, bounded in bytes,
+ * admitting the entries of the keys looked up often enough. Thread safe. Shared with the readers
+ * and sources of the cache so that they can promote entries after the cache is destroyed.
+ */
+class MemoryTier {
+public:
+  MemoryTier(const ConfigProto& config, Stats::Scope& scope);
+
+  /**
+   * Counts a lookup of a key, and moves its entry in front of the least recently used list.
+   * @return the entry of the key, or nullptr if there is none.
+   */
+  MemoryEntrySharedPtr lookup(const Key& key);
+
+  /**
+   * @return whether an entry of a key would be kept if inserted, as looked up often enough.
+   */
+  bool admits(const Key& key) const;
+
+  /**
+   * @return whether an entry of this size can be kept.
+   */
+  bool fits(uint64_t size) const { return size <= max_entry_size_bytes_; }
+
+  /**
+   * Inserts an entry, replacing the entry of the same key, and evicting the least recently used
+   * entries if the tier is full. Does nothing if the entry is too large.
+   */
+  void insert(MemoryEntrySharedPtr entry);
+
+  /**
+   * Replaces the headers and the metadata of the entry of a key, if any.
+   */
+  void updateHeaders(const Key& key, const Http::ResponseHeaderMap& headers,
+                     const ResponseMetadata& metadata);
+
+  void erase(const Key& key);
+
+  const TieredHttpCacheStats& stats() const { return stats_; }
+
+private:
+  using EntryList = std::list<MemoryEntrySharedPtr>;
+  void eraseLocked(EntryList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Evicts the least recently used entries until the tier is not above its size.
+  void evictLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void updateGaugesLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const TieredHttpCacheStats stats_;
+  const uint64_t max_size_bytes_;
+  const uint64_t max_entry_size_bytes_;
+  const uint32_t min_lookups_to_admit_;
+  mutable absl::Mutex mu_;
+  FrequencySketch sketch_ ABSL_GUARDED_BY(mu_);
+  // The most recently used entries first.
+  EntryList entries_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<Key, EntryList::iterator, MessageUtil, MessageUtil>
+      index_ ABSL_GUARDED_BY(mu_);
+  uint64_t size_bytes_ ABSL_GUARDED_BY(mu_){0};
+};
+
+/**
+ * A cache keeping the popular small entries of another cache, the next tier, in memory. All the
+ * entries are inserted in the next tier, as well as in memory when admitted, so that the entries
+ * evicted from memory are still served by the next tier.
+ */
+class TieredHttpCache : public HttpCache {
+public:
+  /**
+   * @param config the config of the cache.
+   * @param next_tier the cache sessions of the next tier, kept alive by this cache.
+   * @param owner kept alive by this cache, so that it keeps track of this cache.
+   * @param scope the scope of the stats.
+   * @param time_source the time source of the latency stats.
+   */
+  TieredHttpCache(const ConfigProto& config, std::shared_ptr<CacheSessions> next_tier,
+                  std::shared_ptr<Singleton::Instance> owner, Stats::Scope& scope,
+                  TimeSource& time_source);
+
+  static absl::string_view name() { return "envoy.extensions.http.cache_v2.tiered_http_cache"; }
+
+  const ConfigProto& config() const { return config_; }
+  const TieredHttpCacheStats& stats() const { return memory_tier_->stats(); }
+
+  // HttpCache
+  CacheInfo cacheInfo() const override;
+  void lookup(LookupRequest&& request, LookupCallback&& callback) override;
+  void evict(Event::Dispatcher& dispatcher, const Key& key) override;
+  void touch(const Key& key, SystemTime timestamp) override;
+  void updateHeaders(Event::Dispatcher& dispatcher, const Key& key,
+                     const Http::ResponseHeaderMap& updated_headers,
+                     const ResponseMetadata& updated_metadata) override;
+  void insert(Event::Dispatcher& dispatcher, Key key, Http::ResponseHeaderMapPtr headers,
+              ResponseMetadata metadata, HttpSourcePtr source,
+              std::shared_ptr<CacheProgressReceiver> progress) override;
+
+private:
+  HttpCache& nextTier() const { return next_tier_->cache(); }
+
+  const ConfigProto config_;
+  const std::shared_ptr<CacheSessions> next_tier_;
+  const std::shared_ptr<Singleton::Instance> owner_;
+  TimeSource& time_source_;
+  // Shared with the callbacks of the next tier, which may outlive this cache.
+  const std::shared_ptr<MemoryTier> memory_tier_;
+};
+
+} // namespace TieredHttpCache
+} // namespace CacheV2
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
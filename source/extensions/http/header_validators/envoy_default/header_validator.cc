@@ -197,7 +197,9 @@ HeaderValidator::validateGenericHeaderName(const HeaderString& name) {
   bool reject_due_to_underscore = false;
   char c = '\0';
 
-  for (auto iter = key_string_view.begin();
+  // Skip the leading characters that are known to be valid tchars, which never include '_'.
+  const auto common_prefix_length = ::Envoy::Http::commonHeaderNameCharsPrefix(key_string_view);
+  for (auto iter = key_string_view.begin() + common_prefix_length;
        iter != key_string_view.end() && is_valid && !reject_due_to_underscore; ++iter) {
     c = *iter;
     if (c != '_') {
@@ -236,14 +238,7 @@ HeaderValidator::validateGenericHeaderValue(const HeaderString& value) {
   //
   // VCHAR          =  %x21-7E
   //                   ; visible (printing) characters
-  const auto& value_string_view = value.getStringView();
-  bool is_valid = true;
-
-  for (auto iter = value_string_view.begin(); iter != value_string_view.end() && is_valid; ++iter) {
-    is_valid &= testCharInTable(kGenericHeaderValueCharTable, *iter);
-  }
-
-  if (!is_valid) {
+  if (!::Envoy::Http::headerValueCharsValid(value.getStringView())) {
     return {HeaderValueValidationResult::Action::Reject,
             UhvResponseCodeDetail::get().InvalidValueCharacters};
   }
@@ -1,14 +1,52 @@
 #include "source/extensions/http/stateful_session/cookie/cookie.h"
 
+#include <array>
+
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
+#include "absl/hash/hash.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace Http {
 namespace StatefulSession {
 namespace Cookie {
 
+const CookieBasedSessionStateFactory::DecodedCookie&
+CookieBasedSessionStateFactory::decodeCookie(absl::string_view cookie_value) {
+  ASSERT(!cookie_value.empty());
+  // The cookie values decoded recently, indexed by their hash. Decoding does not depend on the
+  // configuration of the factories, so they share the entries.
+  struct Entry {
+    std::string cookie_value_;
+    DecodedCookie cookie_;
+  };
+  static constexpr size_t CacheSize = 16;
+  thread_local std::array<Entry, CacheSize> cache;
+
+  Entry& entry = cache[absl::HashOf(cookie_value) % CacheSize];
+  if (entry.cookie_value_ == cookie_value) {
+    return entry.cookie_;
+  }
+
+  entry.cookie_value_ = std::string(cookie_value);
+  entry.cookie_ = {};
+  const std::string decoded_value = Envoy::Base64::decode(cookie_value);
+  // Try to interpret the cookie as proto payload.
+  // Otherwise treat it as "old" style format, which is ip-address:port.
+  envoy::Cookie cookie;
+  if (cookie.ParseFromString(decoded_value)) {
+    entry.cookie_.address_ = cookie.address();
+    entry.cookie_.expires_ = cookie.expires();
+  } else {
+    ENVOY_LOG_ONCE_MISC(
+        warn, "Non-proto cookie format detected. This format will be rejected in the future.");
+    entry.cookie_.address_ = decoded_value;
+  }
+  return entry.cookie_;
+}
+
 bool CookieBasedSessionStateFactory::SessionStateImpl::onUpdate(
     absl::string_view host_address, Envoy::Http::ResponseHeaderMap& headers) {
   const bool host_changed =
@@ -55,42 +55,42 @@ public:
   }
 
 private:
+  // The address and expiry time carried by a cookie value.
+  struct DecodedCookie {
+    std::string address_;
+    // In seconds of the monotonic clock, or 0 if the cookie does not expire.
+    uint64_t expires_{};
+  };
+
   absl::optional<std::string> parseAddress(const Envoy::Http::RequestHeaderMap& headers) const {
     const std::string cookie_value = Envoy::Http::Utility::parseCookieValue(headers, name_);
     if (cookie_value.empty()) {
       return absl::nullopt;
     }
-    const std::string decoded_value = Envoy::Base64::decode(cookie_value);
-    std::string address;
-
-    // Try to interpret the cookie as proto payload.
-    // Otherwise treat it as "old" style format, which is ip-address:port.
-    envoy::Cookie cookie;
-    if (cookie.ParseFromString(decoded_value)) {
-      address = cookie.address();
-      if (address.empty()) {
-        return absl::nullopt;
-      }
+    const DecodedCookie& cookie = decodeCookie(cookie_value);
+    if (cookie.address_.empty()) {
+      return absl::nullopt;
+    }
 
-      if (cookie.expires() != 0) {
-        const std::chrono::seconds expiry_time(cookie.expires());
-        const auto now = std::chrono::duration_cast<std::chrono::seconds>(
-            (time_source_.monotonicTime()).time_since_epoch());
-        if (now > expiry_time) {
-          // Ignore the address extracted from the cookie. This will cause
-          // upstream cluster to select a new host and new cookie will be generated.
-          return absl::nullopt;
-        }
+    if (cookie.expires_ != 0) {
+      const std::chrono::seconds expiry_time(cookie.expires_);
+      const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+          (time_source_.monotonicTime()).time_since_epoch());
+      if (now > expiry_time) {
+        // Ignore the address extracted from the cookie. This will cause
+        // upstream cluster to select a new host and new cookie will be generated.
+        return absl::nullopt;
       }
-    } else {
-      ENVOY_LOG_ONCE_MISC(
-          warn, "Non-proto cookie format detected. This format will be rejected in the future.");
-      address = decoded_value;
     }
-
-    return address.empty() ? absl::nullopt : absl::make_optional(std::move(address));
+    return cookie.address_;
   }
 
+  // Decodes a non-empty cookie value, or returns it as decoded recently by the calling thread. The
+  // requests of a session, usually sent on the same connection to the same worker, thus decode
+  // its cookie once rather than on every request.
+  // @return the decoded cookie, valid until the next call on the calling thread.
+  static const DecodedCookie& decodeCookie(absl::string_view cookie_value);
+
   std::string makeSetCookie(const std::string& address) const {
     return Envoy::Http::Utility::makeSetCookieValue(name_, address, path_, ttl_, true, attributes_);
   }
@@ -43,7 +43,7 @@ public:
 
 private:
   absl::optional<std::string> parseAddress(const Envoy::Http::RequestHeaderMap& headers) const {
-    auto hdr = headers.get(Envoy::Http::LowerCaseString(name_));
+    auto hdr = headers.get(name_);
     if (hdr.empty()) {
       return absl::nullopt;
     }
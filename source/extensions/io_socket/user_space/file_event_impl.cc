@@ -1,6 +1,7 @@
 #include "source/extensions/io_socket/user_space/file_event_impl.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/io_socket/user_space/io_handle.h"
 
 namespace Envoy {
@@ -11,12 +12,18 @@ namespace UserSpace {
 FileEventImpl::FileEventImpl(Event::Dispatcher& dispatcher, Event::FileReadyCb cb, uint32_t events,
                              IoHandle& io_source)
     : schedulable_(dispatcher.createSchedulableCallback([this, cb]() {
+        consecutive_current_iteration_callbacks_ =
+            std::exchange(scheduled_current_iteration_, false)
+                ? consecutive_current_iteration_callbacks_ + 1
+                : 0;
         auto ephemeral_events = event_listener_.getAndClearEphemeralEvents();
         ENVOY_LOG(trace, "User space event {} invokes callbacks on events = {}",
                   static_cast<void*>(this), ephemeral_events);
         THROW_IF_NOT_OK(cb(ephemeral_events));
       })),
-      io_source_(io_source) {
+      io_source_(io_source),
+      current_iteration_events_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.user_space_io_handle_current_iteration_events")) {
   setEnabled(events);
 }
 
@@ -54,6 +61,7 @@ void FileEventImpl::setEnabled(uint32_t events) {
     activate(events_to_notify);
   } else {
     schedulable_->cancel();
+    scheduled_current_iteration_ = false;
   }
   ENVOY_LOG(
       trace,
@@ -69,7 +77,17 @@ void FileEventImpl::activateIfEnabled(uint32_t events) {
   if (filtered_events == 0) {
     return;
   }
-  activate(filtered_events);
+  if (!current_iteration_events_ ||
+      consecutive_current_iteration_callbacks_ >= MaxConsecutiveCurrentIterationCallbacks ||
+      schedulable_->enabled()) {
+    activate(filtered_events);
+    return;
+  }
+  // The peer is running in the current iteration: its data is handled right after it, without
+  // waiting for the dispatcher to poll again.
+  event_listener_.onEventActivated(filtered_events);
+  scheduled_current_iteration_ = true;
+  schedulable_->scheduleCallbackCurrentIteration();
 }
 } // namespace UserSpace
 } // namespace IoSocket
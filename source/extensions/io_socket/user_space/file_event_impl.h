@@ -31,10 +31,17 @@ public:
   void registerEventIfEmulatedEdge(uint32_t) override {}
 
   // Notify events. Unlike activate() method, this method activates the given events only if the
-  // events are enabled.
+  // events are enabled. Used by the peer of the io source to notify its writes and the drains of
+  // its data, which are delivered in the current event loop iteration if
+  // envoy.reloadable_features.user_space_io_handle_current_iteration_events is enabled.
   void activateIfEnabled(uint32_t events);
 
 private:
+  // The number of consecutive callbacks that may be run in the iteration that scheduled them,
+  // before one is deferred to the next iteration so that the other events of the dispatcher are
+  // not starved, e.g. by two peers writing to each other.
+  static constexpr uint32_t MaxConsecutiveCurrentIterationCallbacks = 8;
+
   // This class maintains the ephemeral events and enabled events.
   class EventListener {
   public:
@@ -70,6 +77,11 @@ private:
 
   // Supplies readable and writable status.
   IoHandle& io_source_;
+
+  const bool current_iteration_events_;
+  // Whether the pending callback was scheduled in the current iteration.
+  bool scheduled_current_iteration_{};
+  uint32_t consecutive_current_iteration_callbacks_{};
 };
 } // namespace UserSpace
 } // namespace IoSocket
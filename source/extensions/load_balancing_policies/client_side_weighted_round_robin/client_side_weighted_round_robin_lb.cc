@@ -12,6 +12,7 @@
 
 #include "source/common/orca/orca_load_metrics.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
 #include "absl/status/status.h"
@@ -71,22 +72,31 @@ ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLb::WorkerLocalLb(
                                  common_config, healthy_panic_threshold, 100, 50),
                              getRoundRobinConfig(common_config, round_robin_config), time_source) {
   if (tls_shim.has_value()) {
-    apply_weights_cb_handle_ = tls_shim->apply_weights_cb_helper_.add([this]() {
-      // Refresh the EDF scheduler on the hosts in priority set of the
-      // worker-local load balancer on the worker thread.
-      for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
-        if (host_set != nullptr) {
-          refresh(host_set->priority());
-        }
-      }
-    });
+    apply_weights_cb_handle_ = tls_shim->apply_weights_cb_helper_.add(
+        [this](const std::vector<uint32_t>& priorities) {
+          // Refresh the EDF scheduler on the hosts of the updated priorities of the
+          // worker-local load balancer on the worker thread.
+          const auto& host_sets = priority_set_.hostSetsPerPriority();
+          for (const uint32_t priority : priorities) {
+            if (priority < host_sets.size() && host_sets[priority] != nullptr) {
+              refresh(priority);
+            }
+          }
+        });
   }
 }
 
 ClientSideWeightedRoundRobinLoadBalancer::OrcaLoadReportHandler::OrcaLoadReportHandler(
     const ClientSideWeightedRoundRobinLbConfig& lb_config, TimeSource& time_source)
     : metric_names_for_computing_utilization_(lb_config.metric_names_for_computing_utilization),
-      error_utilization_penalty_(lb_config.error_utilization_penalty), time_source_(time_source) {}
+      error_utilization_penalty_(lb_config.error_utilization_penalty),
+      // Weights are only read once per update period, so storing more than one report per period
+      // only adds writes to the host data shared by all workers.
+      report_coalescing_period_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.wrr_coalesce_orca_reports")
+              ? lb_config.weight_update_period
+              : std::chrono::milliseconds::zero()),
+      time_source_(time_source) {}
 
 void ClientSideWeightedRoundRobinLoadBalancer::initFromConfig(
     const ClientSideWeightedRoundRobinLbConfig& lb_config) {
@@ -97,14 +107,17 @@ void ClientSideWeightedRoundRobinLoadBalancer::initFromConfig(
 
 void ClientSideWeightedRoundRobinLoadBalancer::updateWeightsOnMainThread() {
   ENVOY_LOG(trace, "updateWeightsOnMainThread");
-  bool updated = false;
+  std::vector<uint32_t> updated_priorities;
   // Update weights on hosts in priority set of the thread aware load balancer
   // on the main thread.
   for (const HostSetPtr& host_set : priority_set_.hostSetsPerPriority()) {
-    updated = updateWeightsOnHosts(host_set->hosts()) || updated;
+    if (updateWeightsOnHosts(host_set->hosts())) {
+      updated_priorities.push_back(host_set->priority());
+    }
   }
-  if (updated) {
-    factory_->applyWeightsToAllWorkers();
+  // Only the schedulers of the priorities with updated weights are rebuilt.
+  if (!updated_priorities.empty()) {
+    factory_->applyWeightsToAllWorkers(std::move(updated_priorities));
   }
 }
 
@@ -252,6 +265,14 @@ ClientSideWeightedRoundRobinLoadBalancer::OrcaLoadReportHandler::calculateWeight
 absl::Status ClientSideWeightedRoundRobinLoadBalancer::OrcaLoadReportHandler::
     updateClientSideDataFromOrcaLoadReport(const OrcaLoadReportProto& orca_load_report,
                                            ClientSideHostLbPolicyData& client_side_data) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (report_coalescing_period_.count() > 0 &&
+      client_side_data.updatedAfter(now - report_coalescing_period_)) {
+    // The weight stored within this period has not been read yet, drop the report without
+    // computing its weight.
+    return absl::OkStatus();
+  }
+
   const absl::StatusOr<uint32_t> weight = calculateWeightFromOrcaReport(
       orca_load_report, metric_names_for_computing_utilization_, error_utilization_penalty_);
   if (!weight.ok()) {
@@ -259,7 +280,7 @@ absl::Status ClientSideWeightedRoundRobinLoadBalancer::OrcaLoadReportHandler::
   }
 
   // Update client side data attached to the host.
-  client_side_data.updateWeightNow(weight.value(), time_source_.monotonicTime());
+  client_side_data.updateWeightNow(weight.value(), now);
   return absl::OkStatus();
 }
 
@@ -276,10 +297,12 @@ ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::createWithCommon
       common_lb_config, round_robin_config_, time_source_, tls_->get());
 }
 
-void ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::applyWeightsToAllWorkers() {
-  tls_->runOnAllThreads([](OptRef<ThreadLocalShim> tls_shim) -> void {
+void ClientSideWeightedRoundRobinLoadBalancer::WorkerLocalLbFactory::applyWeightsToAllWorkers(
+    std::vector<uint32_t> priorities) {
+  auto shared_priorities = std::make_shared<const std::vector<uint32_t>>(std::move(priorities));
+  tls_->runOnAllThreads([shared_priorities](OptRef<ThreadLocalShim> tls_shim) -> void {
     if (tls_shim.has_value()) {
-      tls_shim->apply_weights_cb_helper_.runCallbacks();
+      tls_shim->apply_weights_cb_helper_.runCallbacks(*shared_priorities);
     }
   });
 }
@@ -79,6 +79,11 @@ public:
       }
     }
 
+    // Whether the weight was updated after `time`.
+    bool updatedAfter(MonotonicTime time) const {
+      return last_update_time_.load(std::memory_order_relaxed) > time;
+    }
+
     // Get the weight if it was updated between max_non_empty_since and min_last_update_time,
     // otherwise return nullopt.
     absl::optional<uint32_t> getWeightIfValid(MonotonicTime max_non_empty_since,
@@ -139,13 +144,17 @@ public:
 
     const std::vector<std::string> metric_names_for_computing_utilization_;
     const double error_utilization_penalty_;
+    // Reports received within this period of the last stored weight of a host are dropped. Zero if
+    // every report is stored.
+    const std::chrono::milliseconds report_coalescing_period_;
     TimeSource& time_source_;
   };
 
   // Thread local shim to store callbacks for weight updates of worker local lb.
   class ThreadLocalShim : public Envoy::ThreadLocal::ThreadLocalObject {
   public:
-    Common::CallbackManager<void> apply_weights_cb_helper_;
+    // Invoked with the priorities whose host weights changed.
+    Common::CallbackManager<void, const std::vector<uint32_t>&> apply_weights_cb_helper_;
   };
 
   // This class is used to handle the load balancing on the worker thread.
@@ -182,7 +191,8 @@ public:
     Upstream::LoadBalancerPtr createWithCommonLbConfig(const CommonLbConfig& common_lb_config,
                                                        Upstream::LoadBalancerParams params);
 
-    void applyWeightsToAllWorkers();
+    // Refresh the worker-local load balancers of all workers for the given priorities.
+    void applyWeightsToAllWorkers(std::vector<uint32_t> priorities);
 
     std::unique_ptr<Envoy::ThreadLocal::TypedSlot<ThreadLocalShim>> tls_;
 
@@ -446,7 +446,9 @@ ZoneAwareLoadBalancerBase::ZoneAwareLoadBalancerBase(
                                  ? locality_config->zone_aware_lb_config().fail_traffic_on_panic()
                                  : false),
       locality_weighted_balancing_(locality_config.has_value() &&
-                                   locality_config->has_locality_weighted_lb_config()) {
+                                   locality_config->has_locality_weighted_lb_config()),
+      locality_choice_table_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.zone_aware_locality_choice_table")) {
   ASSERT(!priority_set.hostSetsPerPriority().empty());
   resizePerPriorityState();
   if (locality_weighted_balancing_) {
@@ -608,6 +610,28 @@ void ZoneAwareLoadBalancerBase::regenerateLocalityRoutingStructures() {
       state.residual_capacity_[i] = last_residual_capacity;
     }
   }
+
+  // Fold the choice between the local locality and cross locality routing into the residual
+  // capacity, so that picks need one random number. A locality's weight is the share of requests
+  // routed cross locality times its residual capacity, plus for the local locality the share of
+  // requests routed to it directly times the total residual capacity. In the example above 62.5%
+  // of the requests are routed locally, so the weights are 6250 * 15000, 3750 * 10000 and
+  // 3750 * 5000.
+  state.locality_choice_.clear();
+  const uint64_t total_residual_capacity = state.residual_capacity_.back();
+  if (locality_choice_table_ && total_residual_capacity > 0) {
+    state.locality_choice_.resize(num_upstream_localities);
+    uint64_t last = 0;
+    for (uint64_t i = 0; i < num_upstream_localities; ++i) {
+      const uint64_t residual_capacity =
+          state.residual_capacity_[i] - (i > 0 ? state.residual_capacity_[i - 1] : 0);
+      last += (10000 - state.local_percent_to_route_) * residual_capacity;
+      if (i == 0 && upstreamHostsPerLocality.hasLocalLocality()) {
+        last += state.local_percent_to_route_ * total_residual_capacity;
+      }
+      state.locality_choice_[i] = last;
+    }
+  }
 }
 
 void ZoneAwareLoadBalancerBase::resizePerPriorityState() {
@@ -798,6 +822,20 @@ uint32_t ZoneAwareLoadBalancerBase::tryChooseLocalLocalityHosts(const HostSet& h
   ASSERT(host_set.healthyHostsPerLocality().hasLocalLocality() ||
          state.local_percent_to_route_ == 0);
 
+  if (!state.locality_choice_.empty()) {
+    const uint64_t threshold = random_.random() % state.locality_choice_.back();
+    const uint32_t i =
+        std::upper_bound(state.locality_choice_.begin(), state.locality_choice_.end(), threshold) -
+        state.locality_choice_.begin();
+    // The local locality has no residual capacity, so it is only chosen for direct routing.
+    if (i == 0 && host_set.healthyHostsPerLocality().hasLocalLocality()) {
+      stats_.lb_zone_routing_sampled_.inc();
+    } else {
+      stats_.lb_zone_routing_cross_zone_.inc();
+    }
+    return i;
+  }
+
   // If we cannot route all requests to the same locality, we already calculated how much we can
   // push to the local locality, check if we can push to local locality on current iteration.
   if (random_.random() % 10000 < state.local_percent_to_route_) {
@@ -1061,6 +1099,16 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       return;
     }
 
+    // Hosts in slow start get a new weight with every pick, which would rebuild the alias table on
+    // every pick, so EDF is used while any host is in slow start.
+    if (use_alias_scheduler_ && noHostsAreInSlowStart()) {
+      scheduler.alias_ = std::make_unique<AliasScheduler<Host>>(random_);
+      for (const auto& host : hosts) {
+        scheduler.alias_->add(hostWeight(*host), host);
+      }
+      return;
+    }
+
     // Populate the scheduler with the host list with a randomized starting point.
     // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
     // weighted 1. This is because currently we don't refresh host sets if only weights change.
@@ -1131,7 +1179,9 @@ HostConstSharedPtr EdfLoadBalancerBase::peekAnotherHost(LoadBalancerContext* con
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
   // whether to use EDF or do unweighted (fast) selection. EDF is non-null iff the original
   // weights of 2 or more hosts differ.
-  if (scheduler.edf_ != nullptr) {
+  if (scheduler.alias_ != nullptr) {
+    return scheduler.alias_->peekAgain([this](const Host& host) { return hostWeight(host); });
+  } else if (scheduler.edf_ != nullptr) {
     return scheduler.edf_->peekAgain([this](const Host& host) { return hostWeight(host); });
   } else {
     const HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
@@ -1157,7 +1207,9 @@ HostConstSharedPtr EdfLoadBalancerBase::chooseHostOnce(LoadBalancerContext* cont
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
   // whether to use EDF or do unweighted (fast) selection. EDF is non-null iff the original
   // weights of 2 or more hosts differ.
-  if (scheduler.edf_ != nullptr) {
+  if (scheduler.alias_ != nullptr) {
+    return scheduler.alias_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
+  } else if (scheduler.edf_ != nullptr) {
     auto host = scheduler.edf_->pickAndAdd([this](const Host& host) { return hostWeight(host); });
     return host;
   } else {
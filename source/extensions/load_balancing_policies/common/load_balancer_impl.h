@@ -22,6 +22,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/runtime/runtime_protos.h"
+#include "source/common/upstream/alias_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/extensions/load_balancing_policies/common/locality_wrr.h"
@@ -465,6 +466,11 @@ private:
     // for each of the non-local localities to determine what traffic should be
     // routed where.
     std::vector<uint64_t> residual_capacity_;
+    // When locality_routing_state_ == LocalityResidual and locality_choice_table_ is set, the
+    // cumulative weights of routing to each locality, including the requests routed to the local
+    // locality directly, so that a pick draws a single random number. Empty if there is no
+    // residual capacity.
+    std::vector<uint64_t> locality_choice_;
 
     // Locality Weighted Round Robin config.
     std::unique_ptr<LocalityWrr> locality_wrr_;
@@ -490,6 +496,8 @@ private:
 
   // If locality weight aware routing is enabled.
   const bool locality_weighted_balancing_ : 1;
+  // Whether residual locality routing picks a locality from locality_choice_.
+  const bool locality_choice_table_ : 1;
 
   friend class TestZoneAwareLoadBalancer;
 };
@@ -532,6 +540,8 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<Host>> edf_;
+    // Used instead of edf_ if use_alias_scheduler_ is set and no hosts are in slow start.
+    std::unique_ptr<AliasScheduler<Host>> alias_;
   };
 
   void initialize();
@@ -550,6 +560,10 @@ protected:
   // overload.
   const uint64_t seed_;
 
+  // Whether to pick hosts with an alias table rather than EDF when their weights differ. Must be
+  // set before initialize().
+  bool use_alias_scheduler_{};
+
   double applySlowStartFactor(double host_weight, const Host& host) const;
 
 private:
@@ -121,12 +121,10 @@ std::string generateCookie(LoadBalancerContext* context, absl::string_view name,
 } // namespace
 
 absl::Status ThreadAwareLoadBalancerBase::initialize() {
-  // TODO(mattklein123): In the future, once initialized and the initial LB is built, it would be
-  // better to use a background thread for computing LB updates. This has the substantial benefit
-  // that if the LB computation thread falls behind, host set updates can be trivially collapsed.
-  // I will look into doing this in a follow up. Doing everything using a background thread heavily
-  // complicated initialization as the load balancer would need its own initialized callback. I
-  // think the synchronous/asynchronous split is probably the best option.
+  // Once initialized and the initial LB is built, updates may be computed on a background thread
+  // (see refresh()), which has the benefit that host set updates are trivially collapsed if the
+  // LB computation falls behind. Doing everything using a background thread would heavily
+  // complicate initialization as the load balancer would need its own initialized callback.
   if (Runtime::runtimeFeatureEnabled(
           "envoy.reloadable_features.coalesce_lb_rebuilds_on_batch_update")) {
     member_update_cb_ =
@@ -143,42 +141,145 @@ absl::Status ThreadAwareLoadBalancerBase::initialize() {
   return absl::OkStatus();
 }
 
+ThreadAwareLoadBalancerBase::~ThreadAwareLoadBalancerBase() {
+  ASSERT(builder_thread_ == nullptr, "derived load balancers must call stopBackgroundBuilds()");
+}
+
 void ThreadAwareLoadBalancerBase::refresh() {
-  auto per_priority_state_vector = std::make_shared<std::vector<PerPriorityStatePtr>>(
-      priority_set_.hostSetsPerPriority().size());
-  auto healthy_per_priority_load =
+  BuildInputPtr input = captureBuildInput();
+  // The initial build is always synchronous, so that the load balancer is usable as soon as it
+  // is initialized. Later builds may run in the background while workers keep using the
+  // previously published tables.
+  if (thread_factory_ == nullptr || factory_->generation_.load(std::memory_order_relaxed) == 0 ||
+      !Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.hash_lb_background_table_builds")) {
+    // Make sure a background build started before the feature was disabled does not publish
+    // older tables after this one.
+    stopBackgroundBuilds();
+    build(*input);
+    return;
+  }
+  buildInBackground(std::move(input));
+}
+
+ThreadAwareLoadBalancerBase::BuildInputPtr
+ThreadAwareLoadBalancerBase::captureBuildInput() const {
+  auto input = std::make_unique<BuildInput>();
+  input->per_priority_.resize(priority_set_.hostSetsPerPriority().size());
+  input->healthy_per_priority_load_ =
       std::make_shared<HealthyLoad>(per_priority_load_.healthy_priority_load_);
-  auto degraded_per_priority_load =
+  input->degraded_per_priority_load_ =
       std::make_shared<DegradedLoad>(per_priority_load_.degraded_priority_load_);
 
   for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
     const uint32_t priority = host_set->priority();
-    (*per_priority_state_vector)[priority] = std::make_unique<PerPriorityState>();
-    const auto& per_priority_state = (*per_priority_state_vector)[priority];
+    PerPriorityBuildInput& per_priority_input = input->per_priority_[priority];
     // Copy panic flag from LoadBalancerBase. It is calculated when there is a change
     // in hosts set or hosts' health.
-    per_priority_state->global_panic_ = per_priority_panic_[priority];
+    per_priority_input.global_panic_ = per_priority_panic_[priority];
 
     // Normalize host and locality weights such that the sum of all normalized weights is 1.
-    NormalizedHostWeightVector normalized_host_weights;
-    double min_normalized_weight = 1.0;
-    double max_normalized_weight = 0.0;
-    normalizeWeights(*host_set, per_priority_state->global_panic_, normalized_host_weights,
-                     min_normalized_weight, max_normalized_weight, locality_weighted_balancing_);
-    per_priority_state->current_lb_ = createLoadBalancer(
-        std::move(normalized_host_weights), min_normalized_weight, max_normalized_weight);
+    normalizeWeights(*host_set, per_priority_input.global_panic_,
+                     per_priority_input.normalized_host_weights_,
+                     per_priority_input.min_normalized_weight_,
+                     per_priority_input.max_normalized_weight_, locality_weighted_balancing_);
+  }
+  return input;
+}
+
+void ThreadAwareLoadBalancerBase::build(BuildInput& input) {
+  auto per_priority_state_vector =
+      std::make_shared<std::vector<PerPriorityStatePtr>>(input.per_priority_.size());
+  for (size_t priority = 0; priority < input.per_priority_.size(); ++priority) {
+    PerPriorityBuildInput& per_priority_input = input.per_priority_[priority];
+    auto per_priority_state = std::make_unique<PerPriorityState>();
+    per_priority_state->global_panic_ = per_priority_input.global_panic_;
+    per_priority_state->current_lb_ =
+        createLoadBalancer(std::move(per_priority_input.normalized_host_weights_),
+                           per_priority_input.min_normalized_weight_,
+                           per_priority_input.max_normalized_weight_);
+    (*per_priority_state_vector)[priority] = std::move(per_priority_state);
   }
 
   {
     absl::WriterMutexLock lock(&factory_->mutex_);
-    factory_->healthy_per_priority_load_ = healthy_per_priority_load;
-    factory_->degraded_per_priority_load_ = degraded_per_priority_load;
-    factory_->per_priority_state_ = per_priority_state_vector;
+    factory_->healthy_per_priority_load_ = std::move(input.healthy_per_priority_load_);
+    factory_->degraded_per_priority_load_ = std::move(input.degraded_per_priority_load_);
+    factory_->per_priority_state_ = std::move(per_priority_state_vector);
+    factory_->generation_.fetch_add(1, std::memory_order_release);
   }
 }
 
+void ThreadAwareLoadBalancerBase::buildInBackground(BuildInputPtr input) {
+  bool start_builder = false;
+  {
+    Thread::LockGuard lock(builder_mutex_);
+    // Replace any input not yet picked up by the builder, its build would be outdated.
+    pending_build_ = std::move(input);
+    if (!building_) {
+      building_ = true;
+      start_builder = true;
+    }
+  }
+  if (!start_builder) {
+    return;
+  }
+  // A previous builder has no more work and is exiting.
+  if (builder_thread_ != nullptr) {
+    builder_thread_->join();
+  }
+  builder_thread_ = thread_factory_->createThread([this]() { runBackgroundBuilds(); },
+                                                  Thread::Options{"HashLbBuilder"});
+}
+
+void ThreadAwareLoadBalancerBase::runBackgroundBuilds() {
+  while (true) {
+    BuildInputPtr input;
+    {
+      Thread::LockGuard lock(builder_mutex_);
+      if (pending_build_ == nullptr) {
+        building_ = false;
+        return;
+      }
+      input = std::move(pending_build_);
+    }
+    build(*input);
+  }
+}
+
+void ThreadAwareLoadBalancerBase::stopBackgroundBuilds() {
+  {
+    Thread::LockGuard lock(builder_mutex_);
+    pending_build_.reset();
+  }
+  if (builder_thread_ != nullptr) {
+    builder_thread_->join();
+    builder_thread_.reset();
+  }
+}
+
+ThreadAwareLoadBalancerBase::LoadBalancerImpl::LoadBalancerImpl(
+    std::shared_ptr<LoadBalancerFactoryImpl> factory)
+    : stats_(factory->stats_), random_(factory->random_), hash_policy_(factory->hash_policy_),
+      factory_(std::move(factory)) {}
+
+void ThreadAwareLoadBalancerBase::LoadBalancerImpl::refreshState() {
+  // We must protect current_lb_ via a RW lock since it is accessed and written to by multiple
+  // threads. All complex processing has already been precalculated however.
+  absl::ReaderMutexLock lock(factory_->mutex_);
+  generation_ = factory_->generation_.load(std::memory_order_relaxed);
+  healthy_per_priority_load_ = factory_->healthy_per_priority_load_;
+  degraded_per_priority_load_ = factory_->degraded_per_priority_load_;
+  per_priority_state_ = factory_->per_priority_state_;
+}
+
 HostSelectionResponse
 ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHost(LoadBalancerContext* context) {
+  // Pick up tables published by a background build since this load balancer was created.
+  if (factory_->generation_.load(std::memory_order_acquire) != generation_) {
+    refreshState();
+  }
+
   // Make sure we correctly return nullptr for any early chooseHost() calls.
   if (per_priority_state_ == nullptr) {
     return {nullptr};
@@ -230,14 +331,8 @@ ThreadAwareLoadBalancerBase::LoadBalancerImpl::chooseHost(LoadBalancerContext* c
 }
 
 LoadBalancerPtr ThreadAwareLoadBalancerBase::LoadBalancerFactoryImpl::create(LoadBalancerParams) {
-  auto lb = std::make_unique<LoadBalancerImpl>(stats_, random_, hash_policy_);
-
-  // We must protect current_lb_ via a RW lock since it is accessed and written to by multiple
-  // threads. All complex processing has already been precalculated however.
-  absl::ReaderMutexLock lock(mutex_);
-  lb->healthy_per_priority_load_ = healthy_per_priority_load_;
-  lb->degraded_per_priority_load_ = degraded_per_priority_load_;
-  lb->per_priority_state_ = per_priority_state_;
+  auto lb = std::make_unique<LoadBalancerImpl>(shared_from_this());
+  lb->refreshState();
   return lb;
 }
 
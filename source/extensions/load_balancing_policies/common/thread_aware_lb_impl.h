@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <bitset>
 
 #include "envoy/common/callback.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/thread/thread.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/thread.h"
 #include "source/common/config/metadata.h"
 #include "source/common/config/well_known_names.h"
 #include "source/common/http/hash_policy.h"
@@ -114,10 +117,19 @@ protected:
   ThreadAwareLoadBalancerBase(const PrioritySet& priority_set, ClusterLbStats& stats,
                               Runtime::Loader& runtime, Random::RandomGenerator& random,
                               uint32_t healthy_panic_threshold, bool locality_weighted_balancing,
-                              HashPolicySharedPtr hash_policy)
+                              HashPolicySharedPtr hash_policy,
+                              Thread::ThreadFactory* thread_factory = nullptr)
       : LoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold),
-        factory_(new LoadBalancerFactoryImpl(stats, random, std::move(hash_policy))),
-        locality_weighted_balancing_(locality_weighted_balancing) {}
+        factory_(std::make_shared<LoadBalancerFactoryImpl>(stats, random, std::move(hash_policy))),
+        locality_weighted_balancing_(locality_weighted_balancing),
+        thread_factory_(thread_factory) {}
+  ~ThreadAwareLoadBalancerBase() override;
+
+  /**
+   * Waits for a background build in progress and drops any pending one. Derived classes must
+   * call this in their destructor, as background builds call createLoadBalancer().
+   */
+  void stopBackgroundBuilds();
 
 private:
   struct PerPriorityState {
@@ -126,10 +138,24 @@ private:
   };
   using PerPriorityStatePtr = std::unique_ptr<PerPriorityState>;
 
+  // The inputs of a build, captured on the main thread.
+  struct PerPriorityBuildInput {
+    NormalizedHostWeightVector normalized_host_weights_;
+    double min_normalized_weight_{1.0};
+    double max_normalized_weight_{0.0};
+    bool global_panic_{};
+  };
+  struct BuildInput {
+    std::vector<PerPriorityBuildInput> per_priority_;
+    std::shared_ptr<HealthyLoad> healthy_per_priority_load_;
+    std::shared_ptr<DegradedLoad> degraded_per_priority_load_;
+  };
+  using BuildInputPtr = std::unique_ptr<BuildInput>;
+
+  struct LoadBalancerFactoryImpl;
+
   struct LoadBalancerImpl : public LoadBalancer {
-    LoadBalancerImpl(ClusterLbStats& stats, Random::RandomGenerator& random,
-                     HashPolicySharedPtr hash_policy)
-        : stats_(stats), random_(random), hash_policy_(std::move(hash_policy)) {}
+    explicit LoadBalancerImpl(std::shared_ptr<LoadBalancerFactoryImpl> factory);
 
     // Upstream::LoadBalancer
     HostSelectionResponse chooseHost(LoadBalancerContext* context) override;
@@ -145,16 +171,22 @@ private:
       return {};
     }
 
+    // Picks up the state published by the latest build.
+    void refreshState();
+
     ClusterLbStats& stats_;
     Random::RandomGenerator& random_;
     HashPolicySharedPtr hash_policy_;
+    const std::shared_ptr<LoadBalancerFactoryImpl> factory_;
 
+    uint64_t generation_{};
     std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_;
     std::shared_ptr<HealthyLoad> healthy_per_priority_load_;
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_;
   };
 
-  struct LoadBalancerFactoryImpl : public LoadBalancerFactory {
+  struct LoadBalancerFactoryImpl : public LoadBalancerFactory,
+                                   public std::enable_shared_from_this<LoadBalancerFactoryImpl> {
     LoadBalancerFactoryImpl(ClusterLbStats& stats, Random::RandomGenerator& random,
                             std::shared_ptr<Http::HashPolicy> hash_policy)
         : stats_(stats), random_(random), hash_policy_(std::move(hash_policy)) {}
@@ -167,6 +199,9 @@ private:
     Random::RandomGenerator& random_;
     std::shared_ptr<Http::HashPolicy> hash_policy_;
     absl::Mutex mutex_;
+    // Incremented after each publish, so that worker load balancers notice state published by a
+    // background build without waiting for the next host update to recreate them.
+    std::atomic<uint64_t> generation_{};
     std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_ ABSL_GUARDED_BY(mutex_);
     // This is split out of PerPriorityState so LoadBalancerBase::ChoosePriority can be reused.
     std::shared_ptr<HealthyLoad> healthy_per_priority_load_ ABSL_GUARDED_BY(mutex_);
@@ -177,11 +212,24 @@ private:
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
   void refresh();
+  BuildInputPtr captureBuildInput() const;
+  void build(BuildInput& input);
+  void buildInBackground(BuildInputPtr input);
+  void runBackgroundBuilds();
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
   const bool locality_weighted_balancing_{};
+  Thread::ThreadFactory* const thread_factory_;
   Common::CallbackHandlePtr priority_update_cb_;
   Common::CallbackHandlePtr member_update_cb_;
+
+  // Background builds. Only the latest pending input is kept, so that updates arriving while a
+  // build is running are collapsed into a single build. The builder thread is only accessed on
+  // the main thread.
+  Thread::ThreadPtr builder_thread_;
+  Thread::MutexBasicLockable builder_mutex_;
+  BuildInputPtr pending_build_ ABSL_GUARDED_BY(builder_mutex_);
+  bool building_ ABSL_GUARDED_BY(builder_mutex_){};
 };
 
 class TypedHashLbConfigBase : public LoadBalancerConfig {
@@ -193,6 +241,8 @@ public:
   absl::Status validateEndpoints(const PriorityState& priorities) const override;
 
   HashPolicySharedPtr hash_policy_;
+  // Used to rebuild tables off the main thread, if set.
+  Thread::ThreadFactory* thread_factory_{};
 };
 
 } // namespace Upstream
@@ -27,10 +27,10 @@ double LeastRequestLoadBalancer::hostWeight(const Host& host) const {
   // If the value of active requests is the max value, adding +1 will overflow
   // it and cause a divide by zero. This won't happen in normal cases but stops
   // failing fuzz tests
-  const uint64_t active_request_value =
-      host.stats().rq_active_.value() != std::numeric_limits<uint64_t>::max()
-          ? host.stats().rq_active_.value() + 1
-          : host.stats().rq_active_.value();
+  const uint64_t active_requests = host.stats().rq_active_.value();
+  const uint64_t active_request_value = active_requests != std::numeric_limits<uint64_t>::max()
+                                            ? active_requests + 1
+                                            : active_requests;
 
   if (active_request_bias_ == 1.0) {
     host_weight = static_cast<double>(host.weight()) / active_request_value;
@@ -72,8 +72,12 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector
   return candidate_host;
 }
 
+// The active request counts of hosts are shared by all workers, so the count of each sampled host
+// is loaded once and the count of the current candidate is remembered rather than loaded again
+// for every comparison. The candidate is tracked by reference to avoid reference count updates.
 HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
+  const HostSharedPtr* candidate_host = nullptr;
+  uint64_t candidate_active_rq = 0;
 
   size_t num_hosts_known_tied_for_least = 0;
 
@@ -81,21 +85,21 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
 
   for (size_t i = 0; i < num_hosts; ++i) {
     const HostSharedPtr& sampled_host = hosts_to_use[i];
+    const uint64_t sampled_active_rq = sampled_host->stats().rq_active_.value();
 
     if (candidate_host == nullptr) {
       // Make a first choice to start the comparisons.
       num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
+      candidate_host = &sampled_host;
+      candidate_active_rq = sampled_active_rq;
       continue;
     }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
     if (sampled_active_rq < candidate_active_rq) {
       // Reset the count of known tied hosts.
       num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
+      candidate_host = &sampled_host;
+      candidate_active_rq = sampled_active_rq;
     } else if (sampled_active_rq == candidate_active_rq) {
       ++num_hosts_known_tied_for_least;
 
@@ -108,36 +112,31 @@ HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVec
       // candidate_host returned by this function.
       const size_t random_tied_host_index = random_.random() % num_hosts_known_tied_for_least;
       if (random_tied_host_index == 0) {
-        candidate_host = sampled_host;
+        candidate_host = &sampled_host;
       }
     }
   }
 
-  return candidate_host;
+  return candidate_host != nullptr ? *candidate_host : nullptr;
 }
 
 HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
+  const HostSharedPtr* candidate_host = nullptr;
+  uint64_t candidate_active_rq = 0;
 
   for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
     const int rand_idx = random_.random() % hosts_to_use.size();
     const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
+    const uint64_t sampled_active_rq = sampled_host->stats().rq_active_.value();
 
-    if (candidate_host == nullptr) {
-      // Make a first choice to start the comparisons.
-      candidate_host = sampled_host;
-      continue;
-    }
-
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
-    if (sampled_active_rq < candidate_active_rq) {
-      candidate_host = sampled_host;
+    // The first sample is the initial candidate.
+    if (candidate_host == nullptr || sampled_active_rq < candidate_active_rq) {
+      candidate_host = &sampled_host;
+      candidate_active_rq = sampled_active_rq;
     }
   }
 
-  return candidate_host;
+  return candidate_host != nullptr ? *candidate_host : nullptr;
 }
 
 } // namespace Upstream
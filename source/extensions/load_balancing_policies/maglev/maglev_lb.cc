@@ -258,7 +258,8 @@ void CompactMaglevTable::logMaglevTable(bool use_hostname_for_hashing) const {
 }
 
 MaglevTable::MaglevTable(uint64_t table_size, MaglevLoadBalancerStats& stats)
-    : table_size_(table_size), stats_(stats) {}
+    : table_size_(table_size), table_size_multiplier_(absl::Uint128Max() / table_size + 1),
+      stats_(stats) {}
 
 HostSelectionResponse OriginalMaglevTable::chooseHost(uint64_t hash, uint32_t attempt) const {
   if (table_.empty()) {
@@ -272,7 +273,7 @@ HostSelectionResponse OriginalMaglevTable::chooseHost(uint64_t hash, uint32_t at
     hash ^= ~0ULL - attempt + 1;
   }
 
-  return {table_[hash % table_size_]};
+  return {table_[tableIndex(hash)]};
 }
 
 HostSelectionResponse CompactMaglevTable::chooseHost(uint64_t hash, uint32_t attempt) const {
@@ -287,7 +288,7 @@ HostSelectionResponse CompactMaglevTable::chooseHost(uint64_t hash, uint32_t att
     hash ^= ~0ULL - attempt + 1;
   }
 
-  const uint32_t index = table_.get(hash % table_size_);
+  const uint32_t index = table_.get(tableIndex(hash));
   ASSERT(index < host_table_.size(), "Compact MaglevTable index into host table out of range");
   return {host_table_[index]};
 }
@@ -300,9 +301,11 @@ MaglevLoadBalancer::MaglevLoadBalancer(const PrioritySet& priority_set, ClusterL
                                        Stats::Scope& scope, Runtime::Loader& runtime,
                                        Random::RandomGenerator& random,
                                        uint32_t healthy_panic_threshold,
-                                       const MaglevLbProto& config, HashPolicySharedPtr hash_policy)
+                                       const MaglevLbProto& config, HashPolicySharedPtr hash_policy,
+                                       Thread::ThreadFactory* thread_factory)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
-                                  config.has_locality_weighted_lb_config(), std::move(hash_policy)),
+                                  config.has_locality_weighted_lb_config(), std::move(hash_policy),
+                                  thread_factory),
       scope_(scope.createScope("maglev_lb.")), stats_(generateStats(*scope_)),
       table_size_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, table_size, MaglevTable::DefaultTableSize)),
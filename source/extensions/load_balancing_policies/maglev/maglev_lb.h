@@ -12,6 +12,8 @@
 #include "source/common/common/bit_array.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
+#include "absl/numeric/int128.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -88,6 +90,20 @@ protected:
 
   uint64_t permutation(const TableBuildEntry& entry);
 
+  /**
+   * @return the table index for the given hash, i.e. hash % table_size_. The remainder is computed
+   * from a precomputed multiplier rather than with a 64 bit division, which dominates the cost of a
+   * lookup. See "Faster Remainder by Direct Computation", Lemire et al., 2019. The result is exact
+   * for all hashes as the multiplier has twice the width of the hash.
+   */
+  uint64_t tableIndex(uint64_t hash) const {
+    const absl::uint128 low_bits = table_size_multiplier_ * hash;
+    const absl::uint128 bottom =
+        (absl::uint128(absl::Uint128Low64(low_bits)) * table_size_) >> 64;
+    const absl::uint128 top = absl::uint128(absl::Uint128High64(low_bits)) * table_size_;
+    return absl::Uint128High64(bottom + top);
+  }
+
   /**
    * Template method for constructing the Maglev table.
    */
@@ -95,6 +111,8 @@ protected:
                                     double max_normalized_weight, bool use_hostname_for_hashing);
 
   const uint64_t table_size_;
+  // ceil(2^128 / table_size_), used by tableIndex().
+  const absl::uint128 table_size_multiplier_;
   MaglevLoadBalancerStats& stats_;
 
 private:
@@ -170,7 +188,9 @@ public:
   MaglevLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
                      Runtime::Loader& runtime, Random::RandomGenerator& random,
                      uint32_t healthy_panic_threshold, const MaglevLbProto& config,
-                     HashPolicySharedPtr hash_policy);
+                     HashPolicySharedPtr hash_policy,
+                     Thread::ThreadFactory* thread_factory = nullptr);
+  ~MaglevLoadBalancer() override { stopBackgroundBuilds(); }
 
   const MaglevLoadBalancerStats& stats() const { return stats_; }
   uint64_t tableSize() const { return table_size_; }
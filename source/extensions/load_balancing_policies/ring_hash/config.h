@@ -37,14 +37,17 @@ public:
     auto typed_config = std::make_unique<Upstream::TypedRingHashLbConfig>(
         typed_proto, context.regexEngine(), creation_status);
     RETURN_IF_NOT_OK_REF(creation_status);
+    typed_config->thread_factory_ = &context.api().threadFactory();
     return typed_config;
   }
 
   absl::StatusOr<Upstream::LoadBalancerConfigPtr>
-  loadLegacy(Server::Configuration::ServerFactoryContext&,
+  loadLegacy(Server::Configuration::ServerFactoryContext& context,
              const Upstream::ClusterProto& cluster) override {
-    return std::make_unique<Upstream::TypedRingHashLbConfig>(cluster.common_lb_config(),
-                                                             cluster.ring_hash_lb_config());
+    auto typed_config = std::make_unique<Upstream::TypedRingHashLbConfig>(
+        cluster.common_lb_config(), cluster.ring_hash_lb_config());
+    typed_config->thread_factory_ = &context.api().threadFactory();
+    return typed_config;
   }
 };
 
@@ -46,9 +46,11 @@ RingHashLoadBalancer::RingHashLoadBalancer(const PrioritySet& priority_set, Clus
                                            Random::RandomGenerator& random,
                                            uint32_t healthy_panic_threshold,
                                            const RingHashLbProto& config,
-                                           HashPolicySharedPtr hash_policy)
+                                           HashPolicySharedPtr hash_policy,
+                                           Thread::ThreadFactory* thread_factory)
     : ThreadAwareLoadBalancerBase(priority_set, stats, runtime, random, healthy_panic_threshold,
-                                  config.has_locality_weighted_lb_config(), std::move(hash_policy)),
+                                  config.has_locality_weighted_lb_config(), std::move(hash_policy),
+                                  thread_factory),
       scope_(scope.createScope("ring_hash_lb.")), stats_(generateStats(*scope_)),
       min_ring_size_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, minimum_ring_size, DefaultMinRingSize)),
@@ -64,7 +64,9 @@ public:
   RingHashLoadBalancer(const PrioritySet& priority_set, ClusterLbStats& stats, Stats::Scope& scope,
                        Runtime::Loader& runtime, Random::RandomGenerator& random,
                        uint32_t healthy_panic_threshold, const RingHashLbProto& config,
-                       HashPolicySharedPtr hash_policy);
+                       HashPolicySharedPtr hash_policy,
+                       Thread::ThreadFactory* thread_factory = nullptr);
+  ~RingHashLoadBalancer() override { stopBackgroundBuilds(); }
 
   const RingHashLoadBalancerStats& stats() const { return stats_; }
 
@@ -22,8 +22,8 @@ public:
 };
 
 /**
- * A round robin load balancer. When in weighted mode, EDF scheduling is used. When in not
- * weighted mode, simple RR index selection is used.
+ * A round robin load balancer. When in weighted mode, EDF scheduling or, if configured, alias
+ * table selection is used. When in not weighted mode, simple RR index selection is used.
  */
 class RoundRobinLoadBalancer : public EdfLoadBalancerBase {
 public:
@@ -37,6 +37,7 @@ public:
             priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
             LoadBalancerConfigHelper::localityLbConfigFromProto(round_robin_config),
             LoadBalancerConfigHelper::slowStartConfigFromProto(round_robin_config), time_source) {
+    use_alias_scheduler_ = round_robin_config.weighted_scheduler() == RoundRobinLbProto::ALIAS;
     initialize();
   }
 
@@ -58,6 +58,8 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
                                lb_config_.subsetInfo().defaultSubset().fields().end()),
       subset_selectors_(lb_config_.subsetInfo().subsetSelectors()),
       original_priority_set_(priority_set), original_local_priority_set_(local_priority_set),
+      lazy_subset_idle_timeout_(lb_config_.subsetInfo().lazySubsetIdleTimeout()),
+      last_idle_subset_sweep_(time_source_.monotonicTime()),
       locality_weight_aware_(lb_config_.subsetInfo().localityWeightAware()),
       scale_locality_weight_(lb_config_.subsetInfo().scaleLocalityWeight()),
       list_as_any_(lb_config_.subsetInfo().listAsAny()),
@@ -84,6 +86,13 @@ SubsetLoadBalancer::SubsetLoadBalancer(const SubsetLoadBalancerConfig& lb_config
 
   initSubsetSelectorMap();
 
+  if (lazySubsets()) {
+    for (const auto& subset_selector : subset_selectors_) {
+      const auto& keys = subset_selector->selectorKeys();
+      subset_selector_keys_.insert(keys.begin(), keys.end());
+    }
+  }
+
   // Create filtered default subset (if necessary) and other subsets based on current hosts.
   refreshSubsets();
 
@@ -371,12 +380,16 @@ HostConstSharedPtr SubsetLoadBalancer::tryChooseHostFromContext(LoadBalancerCont
 
   // Route has metadata match criteria defined, see if we have a matching subset.
   LbSubsetEntryPtr entry = findSubset(match_criteria->metadataMatchCriteria());
+  if (lazySubsets() && (entry == nullptr || !entry->initialized())) {
+    entry = createLazySubset(match_criteria->metadataMatchCriteria());
+  }
   if (entry == nullptr || !entry->active()) {
     // No matching subset or subset not active: use fallback policy.
     return {nullptr};
   }
 
   host_chosen = true;
+  entry->used_ = true;
   stats_.lb_subsets_selected_.inc();
   return Upstream::LoadBalancer::onlyAllowSynchronousHostSelection(
       entry->lb_subset_->chooseHost(context));
@@ -524,9 +537,197 @@ void SubsetLoadBalancer::processSubsets(uint32_t priority, const HostVector& all
 // necessary.
 void SubsetLoadBalancer::update(uint32_t priority, const HostVector& all_hosts) {
   updateFallbackSubset(priority, all_hosts);
+  if (lazySubsets()) {
+    updateHostIndex(priority, all_hosts);
+    updateLazySubsets(priority);
+    maybeEvictIdleSubsets();
+    return;
+  }
   processSubsets(priority, all_hosts);
 }
 
+// Indexes the hosts of the given priority by their values for the subset selector keys. As for
+// eagerly created subsets, a list value is indexed by each of its elements if list_as_any is set.
+void SubsetLoadBalancer::updateHostIndex(uint32_t priority, const HostVector& all_hosts) {
+  if (host_index_.size() <= priority) {
+    host_index_.resize(priority + 1);
+  }
+  HostIndex& index = host_index_[priority];
+  index.clear();
+
+  for (const auto& host : all_hosts) {
+    if (!host->metadata()) {
+      continue;
+    }
+    const auto& filter_metadata = host->metadata()->filter_metadata();
+    const auto filter_it = filter_metadata.find(Config::MetadataFilters::get().ENVOY_LB);
+    if (filter_it == filter_metadata.end()) {
+      continue;
+    }
+
+    const auto& fields = filter_it->second.fields();
+    for (const auto& key : subset_selector_keys_) {
+      const auto it = fields.find(key);
+      if (it == fields.end()) {
+        continue;
+      }
+      if (list_as_any_ && it->second.kind_case() == Protobuf::Value::kListValue) {
+        for (const auto& v : it->second.list_value().values()) {
+          index[key][HashedValue(v)].push_back(host);
+        }
+      } else {
+        index[key][HashedValue(it->second)].push_back(host);
+      }
+    }
+  }
+}
+
+// Updates the lazily created subsets with the hosts of the given priority. Subsets left without
+// any hosts are released, they are created again when selected once they have hosts.
+void SubsetLoadBalancer::updateLazySubsets(uint32_t priority) {
+  for (const LazySubset& subset : lazy_subsets_) {
+    for (const auto& host :
+         lazySubsetHosts(subset.kvs_, priority, subset.entry_->single_host_subset_)) {
+      subset.entry_->lb_subset_->pushHost(priority, host);
+    }
+    subset.entry_->lb_subset_->finalize(priority);
+  }
+
+  lazy_subsets_.erase(std::remove_if(lazy_subsets_.begin(), lazy_subsets_.end(),
+                                     [this](const LazySubset& subset) {
+                                       if (subset.entry_->active()) {
+                                         return false;
+                                       }
+                                       releaseLazySubset(*subset.entry_);
+                                       return true;
+                                     }),
+                      lazy_subsets_.end());
+}
+
+HostVector SubsetLoadBalancer::lazySubsetHosts(const SubsetMetadata& kvs, uint32_t priority,
+                                               bool single_host_subset) {
+  HostVector hosts;
+  if (priority >= host_index_.size()) {
+    return hosts;
+  }
+  const HostIndex& index = host_index_[priority];
+
+  // Start from the key whose value has the fewest hosts and check the other keys for each of them.
+  const HostVector* candidates = nullptr;
+  for (const auto& [key, value] : kvs) {
+    const auto key_it = index.find(key);
+    if (key_it == index.end()) {
+      return hosts;
+    }
+    const auto value_it = key_it->second.find(HashedValue(value));
+    if (value_it == key_it->second.end()) {
+      return hosts;
+    }
+    if (candidates == nullptr || value_it->second.size() < candidates->size()) {
+      candidates = &value_it->second;
+    }
+  }
+
+  for (const auto& host : *candidates) {
+    if (kvs.size() > 1 && !hostMatches(kvs, *host)) {
+      continue;
+    }
+    hosts.push_back(host);
+    // As for eagerly created subsets, the first matching host of the priority is used.
+    if (single_host_subset) {
+      break;
+    }
+  }
+  return hosts;
+}
+
+// Creates the subset selected by the given metadata match criteria, if the criteria keys are the
+// keys of a subset selector and any host belongs to the subset.
+SubsetLoadBalancer::LbSubsetEntryPtr SubsetLoadBalancer::createLazySubset(
+    const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& match_criteria) {
+  const SubsetSelector* selector = nullptr;
+  for (const auto& subset_selector : subset_selectors_) {
+    const auto& keys = subset_selector->selectorKeys();
+    if (keys.size() == match_criteria.size() &&
+        std::equal(keys.begin(), keys.end(), match_criteria.begin(),
+                   [](const std::string& key,
+                      const Router::MetadataMatchCriterionConstSharedPtr& criterion) {
+                     return key == criterion->name();
+                   })) {
+      selector = subset_selector.get();
+      break;
+    }
+  }
+  if (selector == nullptr) {
+    return nullptr;
+  }
+
+  maybeEvictIdleSubsets();
+
+  SubsetMetadata kvs;
+  kvs.reserve(match_criteria.size());
+  for (const auto& criterion : match_criteria) {
+    kvs.emplace_back(criterion->name(), criterion->value().value());
+  }
+
+  // Find the hosts first, so that no entry is created for values no host has.
+  std::vector<HostVector> hosts_per_priority(host_index_.size());
+  bool found = false;
+  for (uint32_t priority = 0; priority < host_index_.size(); ++priority) {
+    hosts_per_priority[priority] =
+        lazySubsetHosts(kvs, priority, selector->singleHostPerSubset());
+    found |= !hosts_per_priority[priority].empty();
+  }
+  if (!found) {
+    return nullptr;
+  }
+
+  LbSubsetEntryPtr entry = findOrCreateLbSubsetEntry(subsets_, kvs, 0);
+  ASSERT(!entry->initialized());
+  initLbSubsetEntryOnce(entry, selector->singleHostPerSubset());
+  for (uint32_t priority = 0; priority < hosts_per_priority.size(); ++priority) {
+    for (const auto& host : hosts_per_priority[priority]) {
+      entry->lb_subset_->pushHost(priority, host);
+    }
+    entry->lb_subset_->finalize(priority);
+  }
+  entry->used_ = true;
+  lazy_subsets_.push_back({std::move(kvs), entry});
+  return entry;
+}
+
+void SubsetLoadBalancer::releaseLazySubset(LbSubsetEntry& entry) {
+  ASSERT(entry.initialized());
+  entry.lb_subset_.reset();
+  stats_.lb_subsets_active_.dec();
+  stats_.lb_subsets_removed_.inc();
+}
+
+// Releases the lazily created subsets that have not been selected since the previous sweep, at
+// most once per idle timeout.
+void SubsetLoadBalancer::maybeEvictIdleSubsets() {
+  const MonotonicTime now = time_source_.monotonicTime();
+  if (now - last_idle_subset_sweep_ < lazy_subset_idle_timeout_.value()) {
+    return;
+  }
+  last_idle_subset_sweep_ = now;
+
+  const size_t size_before = lazy_subsets_.size();
+  lazy_subsets_.erase(std::remove_if(lazy_subsets_.begin(), lazy_subsets_.end(),
+                                     [this](const LazySubset& subset) {
+                                       if (subset.entry_->used_) {
+                                         subset.entry_->used_ = false;
+                                         return false;
+                                       }
+                                       releaseLazySubset(*subset.entry_);
+                                       return true;
+                                     }),
+                      lazy_subsets_.end());
+  if (lazy_subsets_.size() != size_before) {
+    purgeEmptySubsets(subsets_);
+  }
+}
+
 bool SubsetLoadBalancer::hostMatches(const SubsetMetadata& kvs, const Host& host) {
   return Config::Metadata::metadataLabelMatch(
       kvs, host.metadata().get(), Config::MetadataFilters::get().ENVOY_LB, list_as_any_);
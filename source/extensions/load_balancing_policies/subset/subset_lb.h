@@ -24,6 +24,7 @@
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/subset/subset_lb_config.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
 
@@ -307,10 +308,33 @@ private:
 
     // Used to quick check if entry is single host subset entry or not.
     bool single_host_subset_{};
+
+    // Set when the subset is selected by a request, used to find idle lazy subsets.
+    bool used_{};
+  };
+
+  // A subset created lazily, when first selected by a request.
+  struct LazySubset {
+    SubsetMetadata kvs_;
+    LbSubsetEntryPtr entry_;
   };
 
+  // Hosts of a priority by metadata key and value, for the keys of the subset selectors.
+  using HostIndex = absl::flat_hash_map<std::string, absl::node_hash_map<HashedValue, HostVector>>;
+
   void initLbSubsetEntryOnce(LbSubsetEntryPtr& entry, bool single_host_subset);
 
+  bool lazySubsets() const { return lazy_subset_idle_timeout_.has_value(); }
+  void updateHostIndex(uint32_t priority, const HostVector& all_hosts);
+  void updateLazySubsets(uint32_t priority);
+  // Returns the hosts of the given priority that belong to the subset with the given metadata.
+  HostVector lazySubsetHosts(const SubsetMetadata& kvs, uint32_t priority,
+                             bool single_host_subset);
+  LbSubsetEntryPtr
+  createLazySubset(const std::vector<Router::MetadataMatchCriterionConstSharedPtr>& match_criteria);
+  void releaseLazySubset(LbSubsetEntry& entry);
+  void maybeEvictIdleSubsets();
+
   // Create filtered default subset (if necessary) and other subsets based on current hosts.
   void refreshSubsets();
   void refreshSubsets(uint32_t priority);
@@ -377,6 +401,13 @@ private:
 
   Stats::Gauge* single_duplicate_stat_{};
 
+  // Only used if subsets are created lazily.
+  const absl::optional<std::chrono::milliseconds> lazy_subset_idle_timeout_;
+  std::set<std::string> subset_selector_keys_;
+  std::vector<HostIndex> host_index_;
+  std::vector<LazySubset> lazy_subsets_;
+  MonotonicTime last_idle_subset_sweep_;
+
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const bool locality_weight_aware_ : 1;
   const bool scale_locality_weight_ : 1;
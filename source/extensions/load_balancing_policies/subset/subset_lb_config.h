@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/extensions/load_balancing_policies/common/v3/common.pb.h"
 #include "envoy/extensions/load_balancing_policies/common/v3/common.pb.validate.h"
@@ -7,6 +9,10 @@
 #include "envoy/extensions/load_balancing_policies/subset/v3/subset.pb.validate.h"
 #include "envoy/upstream/load_balancer.h"
 
+#include "source/common/protobuf/utility.h"
+
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -111,6 +117,12 @@ public:
    * @return bool whether redundant key/value pairs is allowed in the request metadata.
    */
   virtual bool allowRedundantKeys() const PURE;
+
+  /*
+   * @return the idle timeout of subsets if subsets are created lazily when first selected by a
+   * request, absl::nullopt if all subsets are created when hosts are updated.
+   */
+  virtual absl::optional<std::chrono::milliseconds> lazySubsetIdleTimeout() const PURE;
 };
 
 using LoadBalancerSubsetInfoPtr = std::unique_ptr<LoadBalancerSubsetInfo>;
@@ -129,6 +141,11 @@ public:
 
   LoadBalancerSubsetInfoImpl(const SubsetLbConfigProto& subset_config)
       : default_subset_(subset_config.default_subset()),
+        lazy_subset_idle_timeout_(
+            subset_config.has_lazy_subsets()
+                ? absl::make_optional(std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+                      subset_config.lazy_subsets(), idle_timeout, DefaultLazySubsetIdleTimeoutMs)))
+                : absl::nullopt),
         fallback_policy_(static_cast<FallbackPolicy>(subset_config.fallback_policy())),
         metadata_fallback_policy_(
             static_cast<MetadataFallbackPolicy>(subset_config.metadata_fallback_policy())),
@@ -190,10 +207,16 @@ public:
   bool panicModeAny() const override { return panic_mode_any_; }
   bool listAsAny() const override { return list_as_any_; }
   bool allowRedundantKeys() const override { return allow_redundant_keys_; }
+  absl::optional<std::chrono::milliseconds> lazySubsetIdleTimeout() const override {
+    return lazy_subset_idle_timeout_;
+  }
+
+  static constexpr uint64_t DefaultLazySubsetIdleTimeoutMs = 5 * 60 * 1000;
 
 private:
   const Protobuf::Struct default_subset_;
   std::vector<SubsetSelectorPtr> subset_selectors_;
+  const absl::optional<std::chrono::milliseconds> lazy_subset_idle_timeout_;
   // Keep small members (bools and enums) at the end of class, to reduce alignment overhead.
   const FallbackPolicy fallback_policy_;
   const MetadataFallbackPolicy metadata_fallback_policy_;
@@ -16,6 +16,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/common/thread.h"
+#include "source/common/event/callback_profiler.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/resolver_impl.h"
 #include "source/common/network/utility.h"
@@ -63,7 +64,11 @@ DnsResolverImpl::DnsResolverImpl(
               : std::chrono::milliseconds::zero()),
       reinit_channel_on_timeout_(config.reinit_channel_on_timeout()), resolvers_csv_(resolvers_csv),
       filter_unroutable_families_(config.filter_unroutable_families()),
-      scope_(root_scope.createScope("dns.cares.")), stats_(generateCaresDnsResolverStats(*scope_)) {
+      scope_(root_scope.createScope("dns.cares.")), stats_(generateCaresDnsResolverStats(*scope_)),
+      response_cache_(config.has_response_cache()
+                          ? DnsResponseCache::getShared(MessageUtil::hash(config),
+                                                        config.response_cache())
+                          : nullptr) {
   AresOptions options = defaultAresOptions();
   initializeChannel(&options.options_, options.optmask_);
 
@@ -351,28 +356,24 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
                   "dns resolution for {} completed with status {:#06x}: \"{}\"", dns_name_,
                   static_cast<int>(pending_response_.status_), pending_response_.details_);
 
-  if (!cancelled_) {
-    // Use a raw try here because it is used in both main thread and filter.
-    // Can not convert to use status code as there may be unexpected exceptions in server fuzz
-    // tests, which must be handled. Potential exception may come from getAddressWithPort() or
-    // portFromTcpUrl().
-    // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
-    // exception in fuzz tests.
-    TRY_NEEDS_AUDIT {
-      callback_(pending_response_.status_, std::move(pending_response_.details_),
-                std::move(pending_response_.address_list_));
+  if (cache_key_.has_value()) {
+    auto it = parent_.coalescable_resolutions_.find(cache_key_.value());
+    if (it != parent_.coalescable_resolutions_.end() && it->second == this) {
+      parent_.coalescable_resolutions_.erase(it);
     }
-    END_TRY
-    MULTI_CATCH(
-        const EnvoyException& e,
-        {
-          ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
-          dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
-        },
-        {
-          ENVOY_LOG(critical, "Unknown exception in c-ares callback");
-          dispatcher_.post([] { throw EnvoyException("unknown"); });
-        });
+    if (pending_response_.status_ == ResolutionStatus::Completed) {
+      parent_.response_cache_->insert(cache_key_.value(), pending_response_.address_list_,
+                                      dispatcher_.timeSource().monotonicTime());
+    }
+  }
+
+  for (const auto& query : coalesced_queries_) {
+    if (!query->cancelled_) {
+      runCallback(query->callback_, std::list<DnsResponse>(pending_response_.address_list_));
+    }
+  }
+  if (!cancelled_) {
+    runCallback(callback_, std::move(pending_response_.address_list_));
   } else {
     ENVOY_LOG_EVENT(debug, "cares_dns_callback_cancelled",
                     "dns resolution callback for {} not issued. Cancelled with reason={}",
@@ -384,6 +385,31 @@ void DnsResolverImpl::PendingResolution::finishResolve() {
   }
 }
 
+void DnsResolverImpl::PendingResolution::runCallback(const ResolveCb& callback,
+                                                     std::list<DnsResponse>&& response) {
+  // Use a raw try here because it is used in both main thread and filter.
+  // Can not convert to use status code as there may be unexpected exceptions in server fuzz
+  // tests, which must be handled. Potential exception may come from getAddressWithPort() or
+  // portFromTcpUrl().
+  // TODO(chaoqin-li1123): remove try catch pattern here once we figure how to handle unexpected
+  // exception in fuzz tests.
+  TRY_NEEDS_AUDIT {
+    Event::CallbackProfiler::SourceScope profiler_scope("dns.resolution");
+    callback(pending_response_.status_, pending_response_.details_, std::move(response));
+  }
+  END_TRY
+  MULTI_CATCH(
+      const EnvoyException& e,
+      {
+        ENVOY_LOG(critical, "EnvoyException in c-ares callback: {}", e.what());
+        dispatcher_.post([s = std::string(e.what())] { throw EnvoyException(s); });
+      },
+      {
+        ENVOY_LOG(critical, "Unknown exception in c-ares callback");
+        dispatcher_.post([] { throw EnvoyException("unknown"); });
+      });
+}
+
 void DnsResolverImpl::updateAresTimer() {
   // Update the timeout for events.
   timeval timeout;
@@ -476,16 +502,66 @@ void DnsResolverImpl::onUdpChannelRefreshTimer() {
   }
 }
 
+void DnsResolverImpl::resetNetworking() {
+  reinitializeChannel();
+  if (response_cache_ != nullptr) {
+    // The responses for the previous network may no longer be valid.
+    response_cache_->clear();
+  }
+}
+
 ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
                                          DnsLookupFamily dns_lookup_family, ResolveCb callback) {
   ENVOY_LOG_EVENT(trace, "cares_dns_resolution_start", "dns resolution for {} started", dns_name);
 
-  // TODO(hennna): Add DNS caching which will allow testing the edge case of a
-  // failed initial call to getAddrInfo followed by a synchronous IPv4
-  // resolution.
+  if (response_cache_ != nullptr) {
+    DnsResponseCache::Key key{dns_name, dns_lookup_family};
+    absl::optional<DnsResponseCache::Response> cached_response =
+        response_cache_->lookup(key, dispatcher_.timeSource().monotonicTime());
+    if (cached_response.has_value()) {
+      ENVOY_LOG_EVENT(trace, "cares_dns_cache_hit", "dns resolution for {} found in the cache",
+                      dns_name);
+      stats_.cache_hits_.inc();
+      if (cached_response->prefetch_) {
+        prefetch(key);
+      }
+      callback(ResolutionStatus::Completed, "cares_cache_hit",
+               std::move(cached_response->records_));
+      return nullptr;
+    }
+    stats_.cache_misses_.inc();
+
+    auto it = coalescable_resolutions_.find(key);
+    if (it != coalescable_resolutions_.end()) {
+      ENVOY_LOG_EVENT(trace, "cares_dns_resolution_coalesced",
+                      "dns resolution for {} coalesced with a pending one", dns_name);
+      stats_.coalesced_queries_.inc();
+      return it->second->coalesce(std::move(callback));
+    }
+  }
+  return startResolution(dns_name, dns_lookup_family, std::move(callback));
+}
 
+void DnsResolverImpl::prefetch(const DnsResponseCache::Key& key) {
+  if (coalescable_resolutions_.contains(key)) {
+    return;
+  }
+  ENVOY_LOG_EVENT(trace, "cares_dns_cache_prefetch", "refreshing the cached dns response for {}",
+                  key.first);
+  stats_.cache_prefetches_.inc();
+  // The response is cached on completion, nothing else is done with it.
+  startResolution(key.first, key.second,
+                  [](ResolutionStatus, absl::string_view, std::list<DnsResponse>&&) {});
+}
+
+ActiveDnsQuery* DnsResolverImpl::startResolution(const std::string& dns_name,
+                                                 DnsLookupFamily dns_lookup_family,
+                                                 ResolveCb callback) {
   auto pending_resolution = std::make_unique<AddrInfoPendingResolution>(
       *this, callback, dispatcher_, channel_, dns_name, dns_lookup_family);
+  if (response_cache_ != nullptr) {
+    pending_resolution->cache_key_.emplace(dns_name, dns_lookup_family);
+  }
   pending_resolution->startResolution();
   if (pending_resolution->completed_) {
     // Resolution does not need asynchronous behavior or network events. For
@@ -501,6 +577,9 @@ ActiveDnsQuery* DnsResolverImpl::resolve(const std::string& dns_name,
     // if ~DnsResolverImpl() happens via ares_destroy() and subsequent handling of ARES_EDESTRUCTION
     // in DnsResolverImpl::PendingResolution::onAresGetAddrInfoCallback()).
     pending_resolution->owned_ = true;
+    if (pending_resolution->cache_key_.has_value()) {
+      coalescable_resolutions_[pending_resolution->cache_key_.value()] = pending_resolution.get();
+    }
     return pending_resolution.release();
   }
 }
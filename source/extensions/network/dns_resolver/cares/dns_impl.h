@@ -13,7 +13,9 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "ares.h"
 
@@ -29,7 +31,11 @@ namespace Network {
   COUNTER(not_found)                                                                               \
   COUNTER(get_addr_failure)                                                                        \
   COUNTER(timeouts)                                                                                \
-  COUNTER(reinits)
+  COUNTER(reinits)                                                                                 \
+  COUNTER(cache_hits)                                                                              \
+  COUNTER(cache_misses)                                                                            \
+  COUNTER(cache_prefetches)                                                                        \
+  COUNTER(coalesced_queries)
 
 /**
  * Struct definition for all DNS stats. @see stats_macros.h
@@ -60,10 +66,25 @@ public:
   // Network::DnsResolver
   ActiveDnsQuery* resolve(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
                           ResolveCb callback) override;
-  void resetNetworking() override { reinitializeChannel(); }
+  void resetNetworking() override;
 
 private:
   friend class DnsResolverImplPeer;
+
+  // A query answered by the resolution of a concurrent identical one.
+  class CoalescedQuery : public ActiveDnsQuery {
+  public:
+    explicit CoalescedQuery(ResolveCb callback) : callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason) override { cancelled_ = true; }
+    void addTrace(uint8_t) override {}
+    std::string getTraces() override { return {}; }
+
+    const ResolveCb callback_;
+    bool cancelled_ = false;
+  };
+
   class PendingResolution : public ActiveDnsQuery {
   public:
     // Network::ActiveDnsQuery
@@ -82,6 +103,17 @@ private:
     bool owned_ = false;
     // Has the query completed? Only meaningful if !owned_;
     bool completed_ = false;
+    // The key of the response in the cache, if the resolver has one.
+    absl::optional<DnsResponseCache::Key> cache_key_;
+
+    /**
+     * Adds a query answered with the response of this resolution.
+     * @return the handle of the query, valid until its callback or ~DnsResolver().
+     */
+    ActiveDnsQuery* coalesce(ResolveCb callback) {
+      coalesced_queries_.push_back(std::make_unique<CoalescedQuery>(std::move(callback)));
+      return coalesced_queries_.back().get();
+    }
 
   protected:
     // Network::ActiveDnsQuery
@@ -91,6 +123,7 @@ private:
           dns_name_(dns_name) {}
 
     void finishResolve();
+    void runCallback(const ResolveCb& callback, std::list<DnsResponse>&& response);
 
     DnsResolverImpl& parent_;
     // Caller supplied callback to invoke on query completion or error.
@@ -102,6 +135,7 @@ private:
     const ares_channel channel_;
     const std::string dns_name_;
     CancelReason cancel_reason_;
+    std::list<std::unique_ptr<CoalescedQuery>> coalesced_queries_;
 
     // Small wrapping struct to accumulate addresses from firings of the
     // onAresGetAddrInfoCallback callback.
@@ -172,6 +206,11 @@ private:
     int optmask_;
   };
 
+  // Starts the resolution of a name not found in the cache.
+  ActiveDnsQuery* startResolution(const std::string& dns_name, DnsLookupFamily dns_lookup_family,
+                                  ResolveCb callback);
+  // Refreshes a cached response in the background.
+  void prefetch(const DnsResponseCache::Key& key);
   // Callback for events on sockets tracked in events_.
   void onEventCallback(os_fd_t fd, uint32_t events);
   // c-ares callback when a socket state changes, indicating that libevent
@@ -211,6 +250,10 @@ private:
   const bool filter_unroutable_families_;
   Stats::ScopeSharedPtr scope_;
   CaresDnsResolverStats stats_;
+  // Shared with the other resolvers with the same configuration, if they cache responses.
+  const DnsResponseCacheSharedPtr response_cache_;
+  // The asynchronous resolutions the identical queries are coalesced into, if responses are cached.
+  absl::flat_hash_map<DnsResponseCache::Key, PendingResolution*> coalescable_resolutions_;
 };
 
 DECLARE_FACTORY(CaresDnsResolverFactory);
@@ -0,0 +1,123 @@
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
+
+#include <algorithm>
+
+#include "source/common/common/macros.h"
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Network {
+
+namespace {
+
+constexpr uint32_t DefaultMaxEntries = 1024;
+constexpr uint64_t DefaultNegativeTtlMs = 5000;
+
+// A response used in the last tenth of its TTL is refreshed.
+constexpr int PrefetchTtlDivisor = 10;
+
+struct SharedCaches {
+  absl::Mutex mutex_;
+  absl::flat_hash_map<uint64_t, std::weak_ptr<DnsResponseCache>> caches_ ABSL_GUARDED_BY(mutex_);
+};
+
+SharedCaches& sharedCaches() { MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedCaches); }
+
+} // namespace
+
+DnsResponseCache::DnsResponseCache(
+    const envoy::extensions::network::dns_resolver::cares::v3::ResponseCache& config)
+    : max_entries_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DefaultMaxEntries)),
+      negative_ttl_(PROTOBUF_GET_MS_OR_DEFAULT(config, negative_ttl, DefaultNegativeTtlMs)),
+      prefetch_(config.prefetch()) {}
+
+std::shared_ptr<DnsResponseCache> DnsResponseCache::getShared(
+    uint64_t config_hash,
+    const envoy::extensions::network::dns_resolver::cares::v3::ResponseCache& config) {
+  SharedCaches& shared_caches = sharedCaches();
+  absl::MutexLock lock(shared_caches.mutex_);
+  std::shared_ptr<DnsResponseCache> cache = shared_caches.caches_[config_hash].lock();
+  if (cache == nullptr) {
+    // Forget the caches of the configurations no longer used by any resolver.
+    absl::erase_if(shared_caches.caches_, [](const auto& entry) { return entry.second.expired(); });
+    cache = std::make_shared<DnsResponseCache>(config);
+    shared_caches.caches_[config_hash] = cache;
+  }
+  return cache;
+}
+
+absl::optional<DnsResponseCache::Response> DnsResponseCache::lookup(const Key& key,
+                                                                    MonotonicTime now) {
+  absl::MutexLock lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return absl::nullopt;
+  }
+  Entry& entry = *it->second;
+  if (entry.expiry_ <= now) {
+    erase(it);
+    return absl::nullopt;
+  }
+  entries_.splice(entries_.begin(), entries_, it->second);
+
+  Response response{{}, false};
+  const auto ttl = std::chrono::ceil<std::chrono::seconds>(entry.expiry_ - now);
+  for (const DnsResponse& record : entry.records_) {
+    response.records_.emplace_back(record.addrInfo().address_, ttl);
+  }
+  if (entry.prefetch_time_.has_value() && entry.prefetch_time_.value() <= now &&
+      !entry.prefetched_) {
+    entry.prefetched_ = true;
+    response.prefetch_ = true;
+  }
+  return response;
+}
+
+void DnsResponseCache::insert(const Key& key, const std::list<DnsResponse>& records,
+                              MonotonicTime now) {
+  std::chrono::milliseconds ttl = negative_ttl_;
+  if (!records.empty()) {
+    ttl = std::chrono::milliseconds::max();
+    for (const DnsResponse& record : records) {
+      ttl = std::min<std::chrono::milliseconds>(ttl, record.addrInfo().ttl_);
+    }
+  }
+
+  absl::MutexLock lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    erase(it);
+  }
+  if (ttl <= std::chrono::milliseconds::zero()) {
+    return;
+  }
+  if (index_.size() >= max_entries_) {
+    index_.erase(entries_.back().key_);
+    entries_.pop_back();
+  }
+  absl::optional<MonotonicTime> prefetch_time;
+  if (prefetch_ && !records.empty()) {
+    prefetch_time = now + ttl - ttl / PrefetchTtlDivisor;
+  }
+  entries_.push_front(Entry{key, records, now + ttl, prefetch_time});
+  index_[key] = entries_.begin();
+}
+
+void DnsResponseCache::clear() {
+  absl::MutexLock lock(mutex_);
+  index_.clear();
+  entries_.clear();
+}
+
+size_t DnsResponseCache::size() {
+  absl::MutexLock lock(mutex_);
+  return index_.size();
+}
+
+void DnsResponseCache::erase(absl::flat_hash_map<Key, EntryList::iterator>::iterator it) {
+  entries_.erase(it->second);
+  index_.erase(it);
+}
+
+} // namespace Network
+} // namespace Envoy
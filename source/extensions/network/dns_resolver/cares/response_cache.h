@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/network/dns_resolver/cares/v3/cares_dns_resolver.pb.h"
+#include "envoy/network/dns.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * The responses of the c-ares resolvers with the same configuration, cached until their TTL expires
+ * and evicted in least recently used order. Thread safe, as the resolvers sharing it may run on
+ * different dispatchers.
+ */
+class DnsResponseCache {
+public:
+  using Key = std::pair<std::string, DnsLookupFamily>;
+
+  /**
+   * A cached response.
+   */
+  struct Response {
+    // The records, with their TTLs reduced to the remaining time to live of the response. Empty for
+    // the negatively cached names.
+    std::list<DnsResponse> records_;
+    // Whether the caller should refresh the response in the background, as it is about to expire.
+    // Only set for one of the lookups of a response.
+    bool prefetch_;
+  };
+
+  explicit DnsResponseCache(
+      const envoy::extensions::network::dns_resolver::cares::v3::ResponseCache& config);
+
+  /**
+   * @return the cache shared by all the resolvers with the same configuration, identified by its
+   *         hash. The cache is destroyed with the last of these resolvers.
+   */
+  static std::shared_ptr<DnsResponseCache>
+  getShared(uint64_t config_hash,
+            const envoy::extensions::network::dns_resolver::cares::v3::ResponseCache& config);
+
+  /**
+   * @return the cached response of a key, or absl::nullopt if there is none or it expired.
+   */
+  absl::optional<Response> lookup(const Key& key, MonotonicTime now);
+
+  /**
+   * Caches the records of a completed resolution, replacing any previous response. They are cached
+   * for the lowest of their TTLs, or for the negative TTL if there are none, so not at all if it
+   * is 0.
+   */
+  void insert(const Key& key, const std::list<DnsResponse>& records, MonotonicTime now);
+
+  /**
+   * Drops all the cached responses, e.g. when the network changes.
+   */
+  void clear();
+
+  size_t size();
+
+private:
+  struct Entry {
+    const Key key_;
+    const std::list<DnsResponse> records_;
+    const MonotonicTime expiry_;
+    // When the lookups start refreshing the response, if they do.
+    const absl::optional<MonotonicTime> prefetch_time_;
+    bool prefetched_{false};
+  };
+  using EntryList = std::list<Entry>;
+
+  void erase(absl::flat_hash_map<Key, EntryList::iterator>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const uint32_t max_entries_;
+  const std::chrono::milliseconds negative_ttl_;
+  const bool prefetch_;
+  absl::Mutex mutex_;
+  // The most recently used entries first.
+  EntryList entries_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<Key, EntryList::iterator> index_ ABSL_GUARDED_BY(mutex_);
+};
+
+using DnsResponseCacheSharedPtr = std::shared_ptr<DnsResponseCache>;
+
+} // namespace Network
+} // namespace Envoy
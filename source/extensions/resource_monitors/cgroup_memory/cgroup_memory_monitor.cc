@@ -3,7 +3,9 @@
 #include "envoy/common/exception.h"
 
 #include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
+#include "source/extensions/resource_monitors/cgroup_memory/cgroup_memory_paths.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -12,9 +14,26 @@ namespace CgroupMemory {
 
 CgroupMemoryMonitor::CgroupMemoryMonitor(
     const envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig& config,
-    Filesystem::Instance& fs)
+    Filesystem::Instance& fs, Filesystem::WatcherPtr events_watcher)
     : max_memory_bytes_(config.max_memory_bytes()), fs_(fs),
-      stats_reader_(CgroupMemoryStatsReader::create(fs_)) {}
+      stats_reader_(CgroupMemoryStatsReader::create(fs_)),
+      events_watcher_(std::move(events_watcher)) {}
+
+void CgroupMemoryMonitor::setRefreshCallback(std::function<void()> callback) {
+  if (events_watcher_ == nullptr) {
+    return;
+  }
+  const absl::Status status = events_watcher_->addWatch(
+      CgroupPaths::V2::getEventsPath(), Filesystem::Watcher::Events::Modified,
+      [callback = std::move(callback)](uint32_t) {
+        callback();
+        return absl::OkStatus();
+      });
+  if (!status.ok()) {
+    // The pressure is still refreshed periodically.
+    ENVOY_LOG_MISC(warn, "Failed to watch the cgroup memory events: {}", status.message());
+  }
+}
 
 void CgroupMemoryMonitor::updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) {
   uint64_t usage;
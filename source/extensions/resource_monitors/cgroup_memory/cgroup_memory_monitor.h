@@ -2,6 +2,7 @@
 
 #include "envoy/extensions/resource_monitors/cgroup_memory/v3/cgroup_memory.pb.h"
 #include "envoy/filesystem/filesystem.h"
+#include "envoy/filesystem/watcher.h"
 #include "envoy/server/resource_monitor.h"
 
 #include "cgroup_memory_stats_reader.h"
@@ -22,10 +23,12 @@ public:
    * Creates a new monitor with the given configuration.
    * @param config Configuration for the monitor.
    * @param fs Filesystem instance to use for file operations.
+   * @param events_watcher Watcher of the cgroup v2 memory events file, if the monitor is refreshed
+   *        on memory events.
    */
   CgroupMemoryMonitor(
       const envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig& config,
-      Filesystem::Instance& fs);
+      Filesystem::Instance& fs, Filesystem::WatcherPtr events_watcher = nullptr);
 
   /**
    * Updates resource pressure based on current memory usage.
@@ -33,6 +36,11 @@ public:
    */
   void updateResourceUsage(Server::ResourceUpdateCallbacks& callbacks) override;
 
+  /**
+   * Refreshes the resource pressure whenever the memory events file changes, if watched.
+   */
+  void setRefreshCallback(std::function<void()> callback) override;
+
 private:
   // Maximum memory limit in bytes.
   const uint64_t max_memory_bytes_;
@@ -40,6 +48,7 @@ private:
   Filesystem::Instance& fs_;
   // Reader for cgroup memory statistics.
   StatsReaderPtr stats_reader_;
+  Filesystem::WatcherPtr events_watcher_;
 };
 
 } // namespace CgroupMemory
@@ -56,12 +56,18 @@ struct CgroupPaths {
      */
     static std::string getLimitPath() { return absl::StrCat(CGROUP_V2_BASE, LIMIT); }
 
+    /**
+     * @return The full path to the memory events file, modified when its counters change.
+     */
+    static std::string getEventsPath() { return absl::StrCat(CGROUP_V2_BASE, EVENTS); }
+
   private:
     // Base path for cgroup v2 memory subsystem.
     static constexpr const char* const CGROUP_V2_BASE = "/sys/fs/cgroup";
     // File names for memory stats in cgroup v2.
     static constexpr const char* const USAGE = "/memory.current";
     static constexpr const char* const LIMIT = "/memory.max";
+    static constexpr const char* const EVENTS = "/memory.events";
   };
 
   /**
@@ -6,6 +6,7 @@
 
 #include "source/common/protobuf/utility.h"
 #include "source/extensions/resource_monitors/cgroup_memory/cgroup_memory_monitor.h"
+#include "source/extensions/resource_monitors/cgroup_memory/cgroup_memory_paths.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -15,7 +16,12 @@ namespace CgroupMemory {
 Server::ResourceMonitorPtr CgroupMemoryMonitorFactory::createResourceMonitorFromProtoTyped(
     const envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig& config,
     Server::Configuration::ResourceMonitorFactoryContext& context) {
-  return std::make_unique<CgroupMemoryMonitor>(config, context.api().fileSystem());
+  Filesystem::WatcherPtr events_watcher;
+  if (config.refresh_on_memory_events() && CgroupPaths::isV2(context.api().fileSystem())) {
+    events_watcher = context.mainThreadDispatcher().createFilesystemWatcher();
+  }
+  return std::make_unique<CgroupMemoryMonitor>(config, context.api().fileSystem(),
+                                               std::move(events_watcher));
 }
 
 /**
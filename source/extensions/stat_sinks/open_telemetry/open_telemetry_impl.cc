@@ -9,11 +9,20 @@ namespace StatSinks {
 namespace OpenTelemetry {
 
 using ::opentelemetry::proto::metrics::v1::AggregationTemporality;
+using ::opentelemetry::proto::metrics::v1::ExponentialHistogramDataPoint;
 using ::opentelemetry::proto::metrics::v1::HistogramDataPoint;
 using ::opentelemetry::proto::metrics::v1::Metric;
 using ::opentelemetry::proto::metrics::v1::NumberDataPoint;
 using ::opentelemetry::proto::metrics::v1::ResourceMetrics;
 
+namespace {
+
+// Recorded values are integers, so the zero bucket of exponential histograms ends halfway between
+// zero and the smallest positive value.
+constexpr double ExponentialHistogramZeroThreshold = 0.5;
+
+} // namespace
+
 MetricAggregator::AttributesMap MetricAggregator::GetAttributesMap(
     const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>& attrs) {
   AttributesMap map;
@@ -185,6 +194,59 @@ void MetricAggregator::addHistogram(
   data_point->add_bucket_counts(stats.outOfBoundCount());
 }
 
+void MetricAggregator::setExponentialBuckets(ExponentialHistogramDataPoint& data_point,
+                                             const Stats::ExponentialHistogramBuckets& buckets) {
+  data_point.set_count(buckets.totalCount());
+  data_point.set_scale(buckets.scale_);
+  data_point.set_zero_count(buckets.zero_count_);
+  auto* positive = data_point.mutable_positive();
+  positive->set_offset(buckets.offset_);
+  positive->mutable_bucket_counts()->Assign(buckets.counts_.begin(), buckets.counts_.end());
+}
+
+void MetricAggregator::addExponentialHistogram(
+    absl::string_view metric_name, const Stats::ExponentialHistogramBuckets& buckets, double sum,
+    double zero_threshold, uint32_t max_buckets, AggregationTemporality temporality,
+    const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>& attributes) {
+  if (buckets.totalCount() == 0 &&
+      temporality == AggregationTemporality::AGGREGATION_TEMPORALITY_DELTA) {
+    return;
+  }
+  if (!enable_metric_aggregation_) {
+    Metric metric;
+    metric.set_name(metric_name);
+    metric.mutable_exponential_histogram()->set_aggregation_temporality(temporality);
+    ExponentialHistogramDataPoint* data_point =
+        metric.mutable_exponential_histogram()->add_data_points();
+    setCommonDataPoint(*data_point, attributes, temporality);
+    data_point->set_sum(sum);
+    data_point->set_zero_threshold(zero_threshold);
+    setExponentialBuckets(*data_point, buckets);
+    non_aggregated_metrics_.push_back(std::move(metric));
+    return;
+  }
+  MetricData& metric_data = getOrCreateMetric(metric_name);
+
+  DataPointKey key{GetAttributesMap(attributes)};
+  auto it = metric_data.exponential_histogram_points.find(key);
+  if (it != metric_data.exponential_histogram_points.end()) {
+    auto& [data_point, merged] = it->second;
+    merged.merge(buckets, max_buckets);
+    data_point->set_sum(data_point->sum() + sum);
+    setExponentialBuckets(*data_point, merged);
+    return;
+  }
+
+  ExponentialHistogramDataPoint* data_point =
+      metric_data.metric.mutable_exponential_histogram()->add_data_points();
+  metric_data.metric.mutable_exponential_histogram()->set_aggregation_temporality(temporality);
+  metric_data.exponential_histogram_points.emplace(key, std::make_pair(data_point, buckets));
+  setCommonDataPoint(*data_point, attributes, temporality);
+  data_point->set_sum(sum);
+  data_point->set_zero_threshold(zero_threshold);
+  setExponentialBuckets(*data_point, buckets);
+}
+
 Protobuf::RepeatedPtrField<ResourceMetrics> MetricAggregator::getResourceMetrics(
     const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>&
         resource_attributes) const {
@@ -232,6 +294,11 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config,
                          Server::Configuration::ServerFactoryContext& server)
     : report_counters_as_deltas_(sink_config.report_counters_as_deltas()),
       report_histograms_as_deltas_(sink_config.report_histograms_as_deltas()),
+      exponential_histogram_max_buckets_(
+          sink_config.has_exponential_histogram()
+              ? PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config.exponential_histogram(), max_buckets,
+                                                160)
+              : 0),
       emit_tags_as_attributes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
@@ -408,6 +475,24 @@ MetricsExportRequestPtr OtlpMetricsFlusherImpl::flush(Stats::MetricSnapshot& sna
       const std::string metric_name =
           getMetricName(histogram.get(), metric_config.conversion_action);
       auto attributes = getCombinedAttributes(histogram.get(), metric_config.conversion_action);
+      if (config_->reportHistogramsAsExponential()) {
+        // Samples of Percent histograms are scaled by 1/PercentScale, and so is their threshold.
+        const double zero_threshold =
+            histogram.get().unit() == Stats::Histogram::Unit::Percent
+                ? ExponentialHistogramZeroThreshold / Stats::Histogram::PercentScale
+                : ExponentialHistogramZeroThreshold;
+        const auto buckets = Stats::ExponentialHistogramBuckets::fromDetailedBuckets(
+            config_->reportHistogramsAsDeltas() ? histogram.get().detailedIntervalBuckets()
+                                                : histogram.get().detailedTotalBuckets(),
+            config_->exponentialHistogramMaxBuckets(), zero_threshold);
+        const double sum = config_->reportHistogramsAsDeltas()
+                               ? histogram.get().intervalStatistics().sampleSum()
+                               : histogram.get().cumulativeStatistics().sampleSum();
+        aggregator.addExponentialHistogram(metric_name, buckets, sum, zero_threshold,
+                                           config_->exponentialHistogramMaxBuckets(),
+                                           histogram_temporality, attributes);
+        continue;
+      }
       const Stats::HistogramStatistics& histogram_stats =
           config_->reportHistogramsAsDeltas() ? histogram.get().intervalStatistics()
                                               : histogram.get().cumulativeStatistics();
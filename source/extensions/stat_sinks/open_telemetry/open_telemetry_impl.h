@@ -13,6 +13,7 @@
 
 #include "source/common/common/matchers.h"
 #include "source/common/grpc/typed_async_client.h"
+#include "source/common/stats/exponential_histogram.h"
 #include "source/extensions/tracers/opentelemetry/resource_detectors/resource_detector.h"
 
 #include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
@@ -70,6 +71,13 @@ public:
         counter_points;
     absl::flat_hash_map<DataPointKey, ::opentelemetry::proto::metrics::v1::HistogramDataPoint*>
         histogram_points;
+    // Exponential histogram points keep their unencoded buckets, which are merged in full before
+    // being written back to the data point.
+    absl::flat_hash_map<
+        DataPointKey,
+        std::pair<::opentelemetry::proto::metrics::v1::ExponentialHistogramDataPoint*,
+                  Stats::ExponentialHistogramBuckets>>
+        exponential_histogram_points;
   };
 
   // Adds a gauge metric data point. Aggregates by summing if a point with the
@@ -93,6 +101,14 @@ public:
       ::opentelemetry::proto::metrics::v1::AggregationTemporality temporality,
       const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>& attributes);
 
+  // Adds an exponential histogram metric data point. Aggregates by merging buckets, at the scale
+  // at which both fit in max_buckets buckets, if a point with the same attributes exists.
+  void addExponentialHistogram(
+      absl::string_view metric_name, const Stats::ExponentialHistogramBuckets& buckets, double sum,
+      double zero_threshold, uint32_t max_buckets,
+      ::opentelemetry::proto::metrics::v1::AggregationTemporality temporality,
+      const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>& attributes);
+
   // Returns a RepeatedPtrField of ResourceMetrics containing all aggregated
   // metrics.
   Protobuf::RepeatedPtrField<::opentelemetry::proto::metrics::v1::ResourceMetrics>
@@ -104,6 +120,11 @@ private:
   static AttributesMap GetAttributesMap(
       const Protobuf::RepeatedPtrField<opentelemetry::proto::common::v1::KeyValue>& attrs);
 
+  // Writes the count and buckets of an exponential histogram data point.
+  static void setExponentialBuckets(
+      ::opentelemetry::proto::metrics::v1::ExponentialHistogramDataPoint& data_point,
+      const Stats::ExponentialHistogramBuckets& buckets);
+
   // Gets or creates a MetricData object for a given metric name.
   MetricData& getOrCreateMetric(absl::string_view metric_name);
 
@@ -148,6 +169,8 @@ public:
 
   bool reportCountersAsDeltas() { return report_counters_as_deltas_; }
   bool reportHistogramsAsDeltas() { return report_histograms_as_deltas_; }
+  bool reportHistogramsAsExponential() { return exponential_histogram_max_buckets_ > 0; }
+  uint32_t exponentialHistogramMaxBuckets() { return exponential_histogram_max_buckets_; }
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   absl::string_view statPrefix() { return stat_prefix_; }
@@ -164,6 +187,8 @@ public:
 private:
   const bool report_counters_as_deltas_;
   const bool report_histograms_as_deltas_;
+  // Zero if histograms are emitted with explicit bounds.
+  const uint32_t exponential_histogram_max_buckets_;
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
@@ -28,14 +28,6 @@ OpenTelemetryHttpTraceExporter::OpenTelemetryHttpTraceExporter(
 }
 
 bool OpenTelemetryHttpTraceExporter::log(const ExportTraceServiceRequest& request) {
-  std::string request_body;
-
-  const auto ok = request.SerializeToString(&request_body);
-  if (!ok) {
-    ENVOY_LOG(warn, "Error while serializing the binary proto ExportTraceServiceRequest.");
-    return false;
-  }
-
   const auto thread_local_cluster =
       cluster_manager_.getThreadLocalCluster(http_service_.http_uri().cluster());
   if (thread_local_cluster == nullptr) {
@@ -59,7 +51,12 @@ bool OpenTelemetryHttpTraceExporter::log(const ExportTraceServiceRequest& reques
   for (const auto& header_pair : parsed_headers_to_add_) {
     message->headers().setReference(header_pair.first, header_pair.second);
   }
-  message->body().add(request_body);
+
+  // The request is serialized in the body directly, rather than in a string copied to it.
+  const size_t request_size = request.ByteSizeLong();
+  auto reservation = message->body().reserveSingleSlice(request_size);
+  request.SerializeWithCachedSizesToArray(static_cast<uint8_t*>(reservation.slice().mem_));
+  reservation.commit(request_size);
 
   const auto options =
       Http::AsyncClient::RequestOptions()
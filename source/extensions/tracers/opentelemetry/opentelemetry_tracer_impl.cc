@@ -90,9 +90,20 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
   // Create the sampler if configured
   SamplerSharedPtr sampler = tryCreateSamper(opentelemetry_config, context);
 
+  absl::optional<TailSampling> tail_sampling;
+  if (opentelemetry_config.has_tail_sampling()) {
+    const auto& tail_sampling_config = opentelemetry_config.tail_sampling();
+    tail_sampling.emplace();
+    tail_sampling->keep_errors_ = tail_sampling_config.keep_errors();
+    if (tail_sampling_config.has_min_duration()) {
+      tail_sampling->min_duration_ = std::chrono::nanoseconds(
+          Protobuf::util::TimeUtil::DurationToNanoseconds(tail_sampling_config.min_duration()));
+    }
+  }
+
   // Create the tracer in Thread Local Storage.
-  tls_slot_ptr_->set([opentelemetry_config, &factory_context, this, resource_ptr,
-                      sampler](Event::Dispatcher& dispatcher) {
+  tls_slot_ptr_->set([opentelemetry_config, &factory_context, this, resource_ptr, sampler,
+                      tail_sampling](Event::Dispatcher& dispatcher) {
     OpenTelemetryTraceExporterPtr exporter;
     if (opentelemetry_config.has_grpc_service()) {
       auto factory_or_error =
@@ -113,7 +124,8 @@ Driver::Driver(const envoy::config::trace::v3::OpenTelemetryConfig& opentelemetr
     TracerPtr tracer =
         std::make_unique<Tracer>(std::move(exporter), factory_context.timeSource(),
                                  factory_context.api().randomGenerator(), factory_context.runtime(),
-                                 dispatcher, tracing_stats_, resource_ptr, sampler, max_cache_size);
+                                 dispatcher, tracing_stats_, resource_ptr, sampler, max_cache_size,
+                                 tail_sampling);
     return std::make_shared<TlsTracer>(std::move(tracer));
   });
 }
@@ -0,0 +1,116 @@
+#include "source/extensions/tracers/opentelemetry/trace_parent.h"
+
+#include <algorithm>
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+namespace {
+
+constexpr absl::string_view kHexDigits = "0123456789abcdef";
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+// Decodes the hex digits of the header value at an offset into out, returning false if one of them
+// is not an hex digit.
+bool decodeHex(absl::string_view header_value, size_t offset, uint8_t* out, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    const int high = hexValue(header_value[offset + 2 * i]);
+    const int low = hexValue(header_value[offset + 2 * i + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    out[i] = static_cast<uint8_t>((high << 4) | low);
+  }
+  return true;
+}
+
+void encodeHex(const uint8_t* in, size_t size, char* out) {
+  for (size_t i = 0; i < size; i++) {
+    out[2 * i] = kHexDigits[in[i] >> 4];
+    out[2 * i + 1] = kHexDigits[in[i] & 0xf];
+  }
+}
+
+template <size_t N> bool isAllZeros(const std::array<uint8_t, N>& id) {
+  return std::all_of(id.begin(), id.end(), [](uint8_t b) { return b == 0; });
+}
+
+template <size_t N> void copyBytes(absl::string_view bytes, std::array<uint8_t, N>& id) {
+  id.fill(0);
+  std::copy_n(bytes.begin(), std::min(bytes.size(), N), id.begin());
+}
+
+} // namespace
+
+TraceParent TraceParent::fromBytes(uint8_t version, absl::string_view trace_id,
+                                   absl::string_view span_id, uint8_t trace_flags) {
+  TraceParent trace_parent(version, {}, {}, trace_flags);
+  copyBytes(trace_id, trace_parent.trace_id_);
+  copyBytes(span_id, trace_parent.span_id_);
+  return trace_parent;
+}
+
+absl::StatusOr<TraceParent> TraceParent::parse(absl::string_view header_value) {
+  if (header_value.size() != kHeaderSize) {
+    return absl::InvalidArgumentError("Invalid traceparent header length");
+  }
+  if (std::count(header_value.begin(), header_value.end(), '-') != 3) {
+    return absl::InvalidArgumentError("Invalid traceparent hyphenation");
+  }
+  if (header_value[kTraceIdOffset - 1] != '-' || header_value[kSpanIdOffset - 1] != '-' ||
+      header_value[kTraceFlagsOffset - 1] != '-') {
+    return absl::InvalidArgumentError("Invalid traceparent field sizes");
+  }
+  uint8_t version;
+  uint8_t trace_flags;
+  TraceParent trace_parent(0, {}, {}, 0);
+  if (!decodeHex(header_value, kVersionOffset, &version, 1) ||
+      !decodeHex(header_value, kTraceIdOffset, trace_parent.trace_id_.data(),
+                 trace_parent.trace_id_.size()) ||
+      !decodeHex(header_value, kSpanIdOffset, trace_parent.span_id_.data(),
+                 trace_parent.span_id_.size()) ||
+      !decodeHex(header_value, kTraceFlagsOffset, &trace_flags, 1)) {
+    return absl::InvalidArgumentError("Invalid header hex");
+  }
+  // As per the traceparent header definition, if the trace-id or parent-id are all zeros, they are
+  // invalid and must be ignored.
+  if (isAllZeros(trace_parent.trace_id_)) {
+    return absl::InvalidArgumentError("Invalid trace id");
+  }
+  if (isAllZeros(trace_parent.span_id_)) {
+    return absl::InvalidArgumentError("Invalid parent id");
+  }
+  trace_parent.version_ = version;
+  trace_parent.trace_flags_ = trace_flags;
+  return trace_parent;
+}
+
+TraceParent::HeaderValue TraceParent::headerValue() const {
+  HeaderValue header_value;
+  encodeHex(&version_, 1, header_value.data() + kVersionOffset);
+  header_value[kTraceIdOffset - 1] = '-';
+  encodeHex(trace_id_.data(), trace_id_.size(), header_value.data() + kTraceIdOffset);
+  header_value[kSpanIdOffset - 1] = '-';
+  encodeHex(span_id_.data(), span_id_.size(), header_value.data() + kSpanIdOffset);
+  header_value[kTraceFlagsOffset - 1] = '-';
+  encodeHex(&trace_flags_, 1, header_value.data() + kTraceFlagsOffset);
+  return header_value;
+}
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
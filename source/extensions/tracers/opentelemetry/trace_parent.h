@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "source/common/common/statusor.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Tracers {
+namespace OpenTelemetry {
+
+/**
+ * A W3C traceparent header in binary form, parsed from and serialized to the header value in place,
+ * without intermediate strings. See https://www.w3.org/TR/trace-context/#traceparent-header.
+ */
+class TraceParent {
+public:
+  // 2 + 1 + 32 + 1 + 16 + 1 + 2
+  static constexpr size_t kHeaderSize = 55;
+  // The offsets and sizes of the hex fields of the header value.
+  static constexpr size_t kVersionOffset = 0;
+  static constexpr size_t kVersionHexSize = 2;
+  static constexpr size_t kTraceIdOffset = 3;
+  static constexpr size_t kTraceIdHexSize = 32;
+  static constexpr size_t kSpanIdOffset = 36;
+  static constexpr size_t kSpanIdHexSize = 16;
+  static constexpr size_t kTraceFlagsOffset = 53;
+
+  using TraceId = std::array<uint8_t, 16>;
+  using SpanId = std::array<uint8_t, 8>;
+  using HeaderValue = std::array<char, kHeaderSize>;
+
+  TraceParent(uint8_t version, const TraceId& trace_id, const SpanId& span_id, uint8_t trace_flags)
+      : version_(version), trace_id_(trace_id), span_id_(span_id), trace_flags_(trace_flags) {}
+
+  /**
+   * Creates a traceparent from the binary trace and span ids of an OTLP span. The ids shorter than
+   * their fixed size are padded with zeros.
+   */
+  static TraceParent fromBytes(uint8_t version, absl::string_view trace_id,
+                               absl::string_view span_id, uint8_t trace_flags);
+
+  /**
+   * Parses a traceparent header value.
+   * @return the traceparent, or an error if the value is malformed or has an all zeros id.
+   */
+  static absl::StatusOr<TraceParent> parse(absl::string_view header_value);
+
+  /**
+   * @return the header value, in a fixed size buffer.
+   */
+  HeaderValue headerValue() const;
+
+  uint8_t version() const { return version_; }
+  const TraceId& traceId() const { return trace_id_; }
+  const SpanId& spanId() const { return span_id_; }
+  uint8_t traceFlags() const { return trace_flags_; }
+
+  /**
+   * @return the sampled flag. See https://w3c.github.io/trace-context/#trace-flags.
+   */
+  bool sampled() const { return trace_flags_ & 1; }
+
+private:
+  uint8_t version_;
+  TraceId trace_id_;
+  SpanId span_id_;
+  uint8_t trace_flags_;
+};
+
+} // namespace OpenTelemetry
+} // namespace Tracers
+} // namespace Extensions
+} // namespace Envoy
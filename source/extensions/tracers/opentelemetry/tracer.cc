@@ -11,6 +11,7 @@
 #include "source/common/tracing/trace_context_impl.h"
 #include "source/common/version/version.h"
 #include "source/extensions/tracers/opentelemetry/otlp_utils.h"
+#include "source/extensions/tracers/opentelemetry/trace_parent.h"
 
 #include "opentelemetry/proto/collector/trace/v1/trace_service.pb.h"
 #include "opentelemetry/proto/trace/v1/trace.pb.h"
@@ -84,7 +85,7 @@ void Span::finishSpan() {
   // Call into the parent tracer so we can access the shared exporter.
   span_.set_end_time_unix_nano(
       std::chrono::nanoseconds(time_source_.systemTime().time_since_epoch()).count());
-  if (sampled()) {
+  if (sampled() || parent_tracer_.tailSample(span_)) {
     parent_tracer_.sendSpan(span_);
   }
 }
@@ -92,14 +93,13 @@ void Span::finishSpan() {
 void Span::setOperation(absl::string_view operation) { span_.set_name(operation); };
 
 void Span::injectContext(Tracing::TraceContext& trace_context, const Tracing::UpstreamContext&) {
-  std::string trace_id_hex = absl::BytesToHexString(span_.trace_id());
-  std::string span_id_hex = absl::BytesToHexString(span_.span_id());
-  std::vector<uint8_t> trace_flags_vec{sampled()};
-  std::string trace_flags_hex = Hex::encode(trace_flags_vec);
-  std::string traceparent_header_value =
-      absl::StrCat(kDefaultVersion, "-", trace_id_hex, "-", span_id_hex, "-", trace_flags_hex);
+  // Format the traceparent straight from the binary ids of the span.
+  const TraceParent::HeaderValue traceparent_header_value =
+      TraceParent::fromBytes(0, span_.trace_id(), span_.span_id(), sampled()).headerValue();
   // Set the traceparent in the trace_context.
-  traceParentHeader().setRefKey(trace_context, traceparent_header_value);
+  traceParentHeader().setRefKey(
+      trace_context,
+      absl::string_view(traceparent_header_value.data(), traceparent_header_value.size()));
   // Also set the tracestate.
   traceStateHeader().setRefKey(trace_context, span_.trace_state());
 }
@@ -118,14 +118,9 @@ void Span::setAttribute(absl::string_view name, const OTelAttribute& attribute_v
     }
   }
   // If we haven't found an existing match already, we can add a new key/value.
-  opentelemetry::proto::common::v1::KeyValue key_value =
-      opentelemetry::proto::common::v1::KeyValue();
-  opentelemetry::proto::common::v1::AnyValue value_proto =
-      opentelemetry::proto::common::v1::AnyValue();
-  OtlpUtils::populateAnyValue(value_proto, attribute_value);
-  key_value.set_key(std::string{name});
-  *key_value.mutable_value() = value_proto;
-  *span_.add_attributes() = key_value;
+  opentelemetry::proto::common::v1::KeyValue* key_value = span_.add_attributes();
+  key_value->set_key(name);
+  OtlpUtils::populateAnyValue(*key_value->mutable_value(), attribute_value);
 }
 
 ::opentelemetry::proto::trace::v1::Status_StatusCode
@@ -188,22 +183,38 @@ void Span::log(SystemTime timestamp, const std::string& event) {
     return;
   }
 
-  ::opentelemetry::proto::trace::v1::Span::Event span_event =
-      ::opentelemetry::proto::trace::v1::Span::Event();
-  span_event.set_time_unix_nano(std::chrono::nanoseconds(timestamp.time_since_epoch()).count());
-  span_event.set_name(std::string{event});
-
-  *span_.add_events() = span_event;
+  ::opentelemetry::proto::trace::v1::Span::Event* span_event = span_.add_events();
+  span_event->set_time_unix_nano(std::chrono::nanoseconds(timestamp.time_since_epoch()).count());
+  span_event->set_name(event);
 }
 
 Tracer::Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_source,
                Random::RandomGenerator& random, Runtime::Loader& runtime,
                Event::Dispatcher& dispatcher, OpenTelemetryTracerStats tracing_stats,
                const ResourceConstSharedPtr resource, SamplerSharedPtr sampler,
-               uint64_t max_cache_size)
+               uint64_t max_cache_size, absl::optional<TailSampling> tail_sampling)
     : exporter_(std::move(exporter)), time_source_(time_source), random_(random), runtime_(runtime),
       tracing_stats_(tracing_stats), resource_(resource), sampler_(sampler),
-      max_cache_size_(max_cache_size) {
+      max_cache_size_(max_cache_size), tail_sampling_(tail_sampling) {
+  // The resource and the instrumentation scope are the same for all the exported spans, so they
+  // are encoded in the request once, and the spans are added to the request as they finish.
+  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request_.add_resource_spans();
+  resource_span->set_schema_url(resource_->schema_url_);
+
+  // add resource attributes
+  for (auto const& att : resource_->attributes_) {
+    opentelemetry::proto::common::v1::KeyValue* key_value =
+        resource_span->mutable_resource()->add_attributes();
+    key_value->set_key(att.first);
+    key_value->mutable_value()->set_string_value(att.second);
+  }
+
+  scope_span_ = resource_span->add_scope_spans();
+
+  // set the instrumentation scope name and version
+  scope_span_->mutable_scope()->set_name("envoy");
+  scope_span_->mutable_scope()->set_version(Envoy::VersionInfo::version());
+
   flush_timer_ = dispatcher.createTimer([this]() -> void {
     tracing_stats_.timer_flushed_.inc();
     flushSpans();
@@ -219,66 +230,58 @@ void Tracer::enableTimer() {
 }
 
 void Tracer::flushSpans() {
-  if (span_buffer_.empty()) {
+  if (scope_span_->spans().empty()) {
     return;
   }
 
-  ExportTraceServiceRequest request;
-  // A request consists of ResourceSpans.
-  ::opentelemetry::proto::trace::v1::ResourceSpans* resource_span = request.add_resource_spans();
-  resource_span->set_schema_url(resource_->schema_url_);
-
-  // add resource attributes
-  for (auto const& att : resource_->attributes_) {
-    opentelemetry::proto::common::v1::KeyValue key_value =
-        opentelemetry::proto::common::v1::KeyValue();
-    opentelemetry::proto::common::v1::AnyValue value_proto =
-        opentelemetry::proto::common::v1::AnyValue();
-    value_proto.set_string_value(std::string{att.second});
-    key_value.set_key(std::string{att.first});
-    *key_value.mutable_value() = value_proto;
-    (*resource_span->mutable_resource()->add_attributes()) = key_value;
-  }
-
-  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span = resource_span->add_scope_spans();
-
-  // set the instrumentation scope name and version
-  *scope_span->mutable_scope()->mutable_name() = "envoy";
-  *scope_span->mutable_scope()->mutable_version() = Envoy::VersionInfo::version();
-
-  for (const auto& pending_span : span_buffer_) {
-    (*scope_span->add_spans()) = pending_span;
-  }
   if (exporter_) {
-    tracing_stats_.spans_sent_.add(span_buffer_.size());
-    if (!exporter_->log(request)) {
+    tracing_stats_.spans_sent_.add(scope_span_->spans_size());
+    if (!exporter_->log(request_)) {
       // TODO: should there be any sort of retry or reporting here?
       ENVOY_LOG(trace, "Unsuccessful log request to OpenTelemetry trace collector.");
     }
   } else {
     ENVOY_LOG(info, "Skipping log request to OpenTelemetry: no exporter configured");
   }
-  span_buffer_.clear();
+  // The cleared spans are kept by the request, so that the next spans reuse their allocations.
+  scope_span_->clear_spans();
 }
 
-void Tracer::sendSpan(::opentelemetry::proto::trace::v1::Span& span) {
-  if (span_buffer_.size() >= max_cache_size_) {
+void Tracer::sendSpan(const ::opentelemetry::proto::trace::v1::Span& span) {
+  const uint64_t buffered_spans = scope_span_->spans_size();
+  if (buffered_spans >= max_cache_size_) {
     ENVOY_LOG_EVERY_POW_2(
         warn,
         "Span buffer size exceeded maximum limit. Discarding span. Current size: {}, Max size: {}",
-        span_buffer_.size(), max_cache_size_);
+        buffered_spans, max_cache_size_);
     tracing_stats_.spans_dropped_.inc();
     flushSpans();
     return;
   }
-  span_buffer_.push_back(span);
+  *scope_span_->add_spans() = span;
   const uint64_t min_flush_spans =
       runtime_.snapshot().getInteger("tracing.opentelemetry.min_flush_spans", 5U);
-  if (span_buffer_.size() >= min_flush_spans) {
+  if (buffered_spans + 1 >= min_flush_spans) {
     flushSpans();
   }
 }
 
+bool Tracer::tailSample(const ::opentelemetry::proto::trace::v1::Span& span) {
+  if (!tail_sampling_.has_value()) {
+    return false;
+  }
+  const bool keep =
+      (tail_sampling_->keep_errors_ &&
+       span.status().code() == ::opentelemetry::proto::trace::v1::Status::STATUS_CODE_ERROR) ||
+      (tail_sampling_->min_duration_.has_value() &&
+       span.end_time_unix_nano() - span.start_time_unix_nano() >=
+           static_cast<uint64_t>(tail_sampling_->min_duration_->count()));
+  if (keep) {
+    tracing_stats_.spans_tail_sampled_.inc();
+  }
+  return keep;
+}
+
 Tracing::SpanPtr Tracer::startSpan(const std::string& operation_name,
                                    const StreamInfo::StreamInfo& stream_info, SystemTime start_time,
                                    Tracing::Decision tracing_decision,
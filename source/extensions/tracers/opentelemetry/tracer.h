@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 
 #include "envoy/api/api.h"
@@ -17,6 +18,7 @@
 #include "source/extensions/tracers/opentelemetry/span_context.h"
 
 #include "absl/strings/escaping.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -26,12 +28,23 @@ namespace OpenTelemetry {
 #define OPENTELEMETRY_TRACER_STATS(COUNTER)                                                        \
   COUNTER(spans_sent)                                                                              \
   COUNTER(timer_flushed)                                                                           \
-  COUNTER(spans_dropped)
+  COUNTER(spans_dropped)                                                                           \
+  COUNTER(spans_tail_sampled)
 
 struct OpenTelemetryTracerStats {
   OPENTELEMETRY_TRACER_STATS(GENERATE_COUNTER_STRUCT)
 };
 
+/**
+ * The spans exported when they finish although they were not sampled when they started.
+ */
+struct TailSampling {
+  // Whether the spans finishing with an error status are exported.
+  bool keep_errors_{};
+  // The duration from which the spans are exported, if set.
+  absl::optional<std::chrono::nanoseconds> min_duration_;
+};
+
 /**
  * OpenTelemetry Tracer. It is stored in TLS and contains the exporter.
  */
@@ -40,9 +53,16 @@ public:
   Tracer(OpenTelemetryTraceExporterPtr exporter, Envoy::TimeSource& time_source,
          Random::RandomGenerator& random, Runtime::Loader& runtime, Event::Dispatcher& dispatcher,
          OpenTelemetryTracerStats tracing_stats, const ResourceConstSharedPtr resource,
-         SamplerSharedPtr sampler, uint64_t max_cache_size);
+         SamplerSharedPtr sampler, uint64_t max_cache_size,
+         absl::optional<TailSampling> tail_sampling = absl::nullopt);
 
-  void sendSpan(::opentelemetry::proto::trace::v1::Span& span);
+  void sendSpan(const ::opentelemetry::proto::trace::v1::Span& span);
+
+  /**
+   * @return whether a finished span which was not sampled is exported anyway, for its final
+   * status or duration.
+   */
+  bool tailSample(const ::opentelemetry::proto::trace::v1::Span& span);
 
   Tracing::SpanPtr startSpan(const std::string& operation_name,
                              const StreamInfo::StreamInfo& stream_info, SystemTime start_time,
@@ -69,13 +89,16 @@ private:
   OpenTelemetryTraceExporterPtr exporter_;
   Envoy::TimeSource& time_source_;
   Random::RandomGenerator& random_;
-  std::vector<::opentelemetry::proto::trace::v1::Span> span_buffer_;
+  // The request exporting the buffered spans, which are the spans of scope_span_.
+  ExportTraceServiceRequest request_;
+  ::opentelemetry::proto::trace::v1::ScopeSpans* scope_span_;
   Runtime::Loader& runtime_;
   Event::TimerPtr flush_timer_;
   OpenTelemetryTracerStats tracing_stats_;
   const ResourceConstSharedPtr resource_;
   SamplerSharedPtr sampler_;
   uint64_t max_cache_size_;
+  const absl::optional<TailSampling> tail_sampling_;
 };
 
 /**
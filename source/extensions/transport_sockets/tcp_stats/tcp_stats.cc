@@ -25,7 +25,11 @@ namespace TcpStats {
 Config::Config(const envoy::extensions::transport_sockets::tcp_stats::v3::Config& config_proto,
                Stats::Scope& scope)
     : stats_(generateStats(scope)),
-      update_period_(PROTOBUF_GET_OPTIONAL_MS(config_proto, update_period)) {}
+      update_period_(PROTOBUF_GET_OPTIONAL_MS(config_proto, update_period)),
+      max_connections_per_update_(
+          config_proto.has_max_connections_per_update()
+              ? absl::make_optional(config_proto.max_connections_per_update().value())
+              : absl::nullopt) {}
 
 TcpStats Config::generateStats(Stats::Scope& scope) {
   const std::string prefix("tcp_stats");
@@ -34,17 +38,63 @@ TcpStats Config::generateStats(Stats::Scope& scope) {
                                 POOL_HISTOGRAM_PREFIX(scope, prefix))};
 }
 
+WorkerSamplerSharedPtr Config::workerSampler(Event::Dispatcher& dispatcher) const {
+  ASSERT(update_period_.has_value() && max_connections_per_update_.has_value());
+  absl::MutexLock lock(samplers_mutex_);
+  WorkerSamplerSharedPtr sampler = samplers_[&dispatcher].lock();
+  if (sampler == nullptr) {
+    // Forget the samplers of the workers with no connection left.
+    absl::erase_if(samplers_, [](const auto& entry) { return entry.second.expired(); });
+    sampler = std::make_shared<WorkerSampler>(dispatcher, update_period_.value(),
+                                              max_connections_per_update_.value());
+    samplers_[&dispatcher] = sampler;
+  }
+  return sampler;
+}
+
+WorkerSampler::WorkerSampler(Event::Dispatcher& dispatcher,
+                             std::chrono::milliseconds update_period,
+                             uint32_t max_connections_per_update)
+    : update_period_(update_period), max_connections_per_update_(max_connections_per_update),
+      timer_(dispatcher.createTimer([this]() { onTimer(); })) {}
+
+WorkerSampler::Entry WorkerSampler::add(TcpStatsSocket& socket) {
+  if (!timer_->enabled()) {
+    timer_->enableTimer(update_period_);
+  }
+  return sockets_.insert(sockets_.end(), &socket);
+}
+
+void WorkerSampler::remove(Entry entry) { sockets_.erase(entry); }
+
+void WorkerSampler::onTimer() {
+  for (uint32_t i = 0; i < max_connections_per_update_ && i < sockets_.size(); ++i) {
+    TcpStatsSocket* socket = sockets_.front();
+    // Moved to the back, so that the entry of the connection remains valid.
+    sockets_.splice(sockets_.end(), sockets_, sockets_.begin());
+    socket->recordStats();
+  }
+  if (!sockets_.empty()) {
+    timer_->enableTimer(update_period_);
+  }
+}
+
 TcpStatsSocket::TcpStatsSocket(ConfigConstSharedPtr config,
                                Network::TransportSocketPtr inner_socket)
     : PassthroughSocket(std::move(inner_socket)), config_(std::move(config)) {}
 
+TcpStatsSocket::~TcpStatsSocket() { removeFromSampler(); }
+
 void TcpStatsSocket::setTransportSocketCallbacks(Network::TransportSocketCallbacks& callbacks) {
   callbacks_ = &callbacks;
   transport_socket_->setTransportSocketCallbacks(callbacks);
 }
 
 void TcpStatsSocket::onConnected() {
-  if (config_->update_period_.has_value()) {
+  if (config_->update_period_.has_value() && config_->max_connections_per_update_.has_value()) {
+    sampler_ = config_->workerSampler(callbacks_->connection().dispatcher());
+    sampler_entry_ = sampler_->add(*this);
+  } else if (config_->update_period_.has_value()) {
     timer_ = callbacks_->connection().dispatcher().createTimer([this]() {
       recordStats();
       timer_->enableTimer(config_->update_period_.value());
@@ -70,10 +120,18 @@ void TcpStatsSocket::closeSocket(Network::ConnectionEvent event) {
   if (timer_ != nullptr) {
     timer_->disableTimer();
   }
+  removeFromSampler();
 
   transport_socket_->closeSocket(event);
 }
 
+void TcpStatsSocket::removeFromSampler() {
+  if (sampler_ != nullptr) {
+    sampler_->remove(sampler_entry_);
+    sampler_.reset();
+  }
+}
+
 absl::optional<struct tcp_info> TcpStatsSocket::querySocketInfo() {
   struct tcp_info info;
   memset(&info, 0, sizeof(info));
@@ -2,6 +2,9 @@
 
 #if defined(__linux__)
 
+#include <list>
+
+#include "envoy/event/dispatcher.h"
 #include "envoy/event/timer.h"
 #include "envoy/extensions/transport_sockets/tcp_stats/v3/tcp_stats.pb.h"
 #include "envoy/network/connection.h"
@@ -12,6 +15,9 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/transport_sockets/common/passthrough.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
 // Defined in /usr/include/linux/tcp.h.
 struct tcp_info;
 
@@ -38,16 +44,59 @@ struct TcpStats {
   ALL_TCP_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
+class TcpStatsSocket;
+
+/**
+ * Updates the stats of the connections of a worker with a single timer, querying at most
+ * max_connections_per_update of them every update period, in turn.
+ */
+class WorkerSampler {
+public:
+  using Entry = std::list<TcpStatsSocket*>::iterator;
+
+  WorkerSampler(Event::Dispatcher& dispatcher, std::chrono::milliseconds update_period,
+                uint32_t max_connections_per_update);
+
+  /**
+   * Adds a connection, to be updated after the ones already added.
+   * @return the entry to remove it with.
+   */
+  Entry add(TcpStatsSocket& socket);
+  void remove(Entry entry);
+
+private:
+  void onTimer();
+
+  const std::chrono::milliseconds update_period_;
+  const uint32_t max_connections_per_update_;
+  // The connections to update next first.
+  std::list<TcpStatsSocket*> sockets_;
+  const Event::TimerPtr timer_;
+};
+
+using WorkerSamplerSharedPtr = std::shared_ptr<WorkerSampler>;
+
 class Config {
 public:
   Config(const envoy::extensions::transport_sockets::tcp_stats::v3::Config& config_proto,
          Stats::Scope& scope);
 
+  /**
+   * @return the sampler of the connections on a dispatcher, shared by all of them and destroyed
+   *         with the last one. Only used with max_connections_per_update_.
+   */
+  WorkerSamplerSharedPtr workerSampler(Event::Dispatcher& dispatcher) const;
+
   TcpStats stats_;
   const absl::optional<std::chrono::milliseconds> update_period_;
+  const absl::optional<uint32_t> max_connections_per_update_;
 
 private:
   TcpStats generateStats(Stats::Scope& scope);
+
+  mutable absl::Mutex samplers_mutex_;
+  mutable absl::flat_hash_map<const Event::Dispatcher*, std::weak_ptr<WorkerSampler>>
+      samplers_ ABSL_GUARDED_BY(samplers_mutex_);
 };
 
 using ConfigConstSharedPtr = std::shared_ptr<const Config>;
@@ -56,6 +105,7 @@ class TcpStatsSocket : public TransportSockets::PassthroughSocket,
                        Logger::Loggable<Logger::Id::connection> {
 public:
   TcpStatsSocket(ConfigConstSharedPtr config, Network::TransportSocketPtr inner_socket);
+  ~TcpStatsSocket() override;
 
   // Network::TransportSocket
   void setTransportSocketCallbacks(Network::TransportSocketCallbacks& callbacks) override;
@@ -63,12 +113,17 @@ public:
   void closeSocket(Network::ConnectionEvent event) override;
 
 private:
+  friend class WorkerSampler;
+
   absl::optional<struct tcp_info> querySocketInfo();
   void recordStats();
+  void removeFromSampler();
 
   const ConfigConstSharedPtr config_;
   Network::TransportSocketCallbacks* callbacks_{};
   Event::TimerPtr timer_;
+  WorkerSamplerSharedPtr sampler_;
+  WorkerSampler::Entry sampler_entry_;
 
   uint32_t last_cx_tx_segments_{};
   uint32_t last_cx_rx_segments_{};
@@ -0,0 +1,123 @@
+#include "source/extensions/transport_sockets/tls/cert_mappers/server_name_index/config.h"
+
+#include "source/common/common/fmt.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace CertificateMappers {
+namespace ServerNameIndex {
+
+absl::Status ServerNameTrie::add(absl::string_view server_name, absl::string_view secret_name) {
+  const std::string lowercase_name = absl::AsciiStrToLower(server_name);
+  absl::string_view name = lowercase_name;
+  const bool wildcard = absl::ConsumePrefix(&name, "*.");
+  const std::vector<absl::string_view> labels = absl::StrSplit(name, '.');
+  Node* node = &root_;
+  for (auto label = labels.rbegin(); label != labels.rend(); ++label) {
+    if (label->empty() || absl::StrContains(*label, '*')) {
+      return absl::InvalidArgumentError(fmt::format("Invalid server name '{}'", server_name));
+    }
+    std::unique_ptr<Node>& child = node->children_[*label];
+    if (child == nullptr) {
+      child = std::make_unique<Node>();
+    }
+    node = child.get();
+  }
+
+  const auto [secret, inserted] = secret_indexes_.try_emplace(secret_name, secret_names_.size());
+  if (inserted) {
+    secret_names_.emplace_back(secret_name);
+  }
+  uint32_t& index = wildcard ? node->wildcard_ : node->exact_;
+  if (index != NoSecret && index != secret->second) {
+    return absl::InvalidArgumentError(
+        fmt::format("Server name '{}' is served by both secrets '{}' and '{}'", server_name,
+                    secret_names_[index], secret_name));
+  }
+  index = secret->second;
+  return absl::OkStatus();
+}
+
+const std::string* ServerNameTrie::find(absl::string_view server_name) const {
+  const Node* node = &root_;
+  absl::string_view remaining = server_name;
+  while (true) {
+    const size_t pos = remaining.rfind('.');
+    if (pos == absl::string_view::npos) {
+      break;
+    }
+    const auto child = node->children_.find(remaining.substr(pos + 1));
+    if (child == node->children_.end()) {
+      return nullptr;
+    }
+    node = child->second.get();
+    remaining = remaining.substr(0, pos);
+  }
+  if (remaining.empty()) {
+    return nullptr;
+  }
+  // The leftmost label matches either an exact server name, or the wildcard domain name of the
+  // parent domain.
+  const auto child = node->children_.find(remaining);
+  if (child != node->children_.end() && child->second->exact_ != NoSecret) {
+    return &secret_names_[child->second->exact_];
+  }
+  if (node->wildcard_ != NoSecret) {
+    return &secret_names_[node->wildcard_];
+  }
+  return nullptr;
+}
+
+namespace {
+class ServerNameIndexMapper : public Ssl::TlsCertificateMapper {
+public:
+  ServerNameIndexMapper(ServerNameTrieConstSharedPtr trie, const std::string& default_value)
+      : trie_(std::move(trie)), default_value_(default_value) {}
+  std::string deriveFromClientHello(const SSL_CLIENT_HELLO& ssl_client_hello) override {
+    const absl::string_view sni = absl::NullSafeStringView(
+        SSL_get_servername(ssl_client_hello.ssl, TLSEXT_NAMETYPE_host_name));
+    const std::string* secret_name = trie_->find(absl::AsciiStrToLower(sni));
+    return secret_name != nullptr ? *secret_name : default_value_;
+  }
+
+private:
+  const ServerNameTrieConstSharedPtr trie_;
+  const std::string default_value_;
+};
+} // namespace
+
+absl::StatusOr<Ssl::TlsCertificateMapperFactory>
+ServerNameIndexMapperFactory::createTlsCertificateMapperFactory(
+    const Protobuf::Message& proto_config,
+    Server::Configuration::GenericFactoryContext& factory_context) {
+  const ServerNameIndexConfigProto& config =
+      MessageUtil::downcastAndValidate<const ServerNameIndexConfigProto&>(
+          proto_config, factory_context.messageValidationVisitor());
+  auto trie = std::make_shared<ServerNameTrie>();
+  for (const auto& certificate : config.certificates()) {
+    for (const std::string& server_name : certificate.server_names()) {
+      RETURN_IF_NOT_OK(trie->add(server_name, certificate.secret_name()));
+    }
+  }
+  return [trie = ServerNameTrieConstSharedPtr(std::move(trie)),
+          default_value = config.default_value()]() {
+    return std::make_unique<ServerNameIndexMapper>(trie, default_value);
+  };
+}
+
+REGISTER_FACTORY(ServerNameIndexMapperFactory, Ssl::TlsCertificateMapperConfigFactory);
+
+} // namespace ServerNameIndex
+} // namespace CertificateMappers
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
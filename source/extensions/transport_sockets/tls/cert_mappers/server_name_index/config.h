@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/transport_sockets/tls/cert_mappers/server_name_index/v3/config.pb.h"
+#include "envoy/extensions/transport_sockets/tls/cert_mappers/server_name_index/v3/config.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/ssl/handshaker.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace CertificateMappers {
+namespace ServerNameIndex {
+
+/**
+ * An index of exact server names and wildcard domain names, as a trie of their labels in reverse
+ * order, e.g. "com", "example", "www" for "www.example.com".
+ */
+class ServerNameTrie {
+public:
+  /**
+   * Adds a server name served by a secret.
+   * @param server_name an exact server name, or a wildcard domain name such as "*.example.com".
+   * @param secret_name the name of the secret serving it.
+   * @return an error if the server name is invalid or already served by another secret.
+   */
+  absl::Status add(absl::string_view server_name, absl::string_view secret_name);
+
+  /**
+   * @param server_name a lowercase server name.
+   * @return the secret serving the server name exactly, or else the secret serving the wildcard
+   * domain name matching it, or nullptr if there are none.
+   */
+  const std::string* find(absl::string_view server_name) const;
+
+private:
+  static constexpr uint32_t NoSecret = UINT32_MAX;
+
+  struct Node {
+    absl::flat_hash_map<std::string, std::unique_ptr<Node>> children_;
+    // The indexes in secret_names_ of the secrets serving the name of the node, and the wildcard
+    // domain name of the node.
+    uint32_t exact_{NoSecret};
+    uint32_t wildcard_{NoSecret};
+  };
+
+  Node root_;
+  // The names of the secrets, stored once however many server names they serve.
+  std::vector<std::string> secret_names_;
+  absl::flat_hash_map<std::string, uint32_t> secret_indexes_;
+};
+
+using ServerNameTrieConstSharedPtr = std::shared_ptr<const ServerNameTrie>;
+
+using ServerNameIndexConfigProto = envoy::extensions::transport_sockets::tls::cert_mappers::
+    server_name_index::v3::ServerNameIndex;
+
+class ServerNameIndexMapperFactory : public Ssl::TlsCertificateMapperConfigFactory {
+public:
+  absl::StatusOr<Ssl::TlsCertificateMapperFactory> createTlsCertificateMapperFactory(
+      const Protobuf::Message& proto_config,
+      Server::Configuration::GenericFactoryContext& factory_context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<ServerNameIndexConfigProto>();
+  }
+
+  std::string name() const override { return "envoy.tls.certificate_mappers.server_name_index"; }
+};
+
+DECLARE_FACTORY(ServerNameIndexMapperFactory);
+
+} // namespace ServerNameIndex
+} // namespace CertificateMappers
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
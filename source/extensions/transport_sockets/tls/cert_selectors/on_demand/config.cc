@@ -47,6 +47,7 @@ void Handle::notify(AsyncContextConstSharedPtr cert_ctx) {
   ASSERT(cb_);
   bool staple = false;
   if (cert_ctx) {
+    cert_ctx->markUsed();
     active_context_ = cert_ctx;
     staple =
         (ocspStapleAction(active_context_->tlsContext(), client_ocsp_capable_,
@@ -73,6 +74,7 @@ SecretManager::SecretManager(const ConfigProto& config,
       stats_(generateCertSelectionStats(*stats_scope_)),
       factory_context_(factory_context.serverFactoryContext()),
       config_source_(config.config_source()), context_factory_(std::move(context_factory)),
+      max_active_certificates_(config.max_active_certificates()),
       cert_contexts_(factory_context_.threadLocal()) {
   cert_contexts_.set([](Event::Dispatcher&) { return std::make_shared<ThreadLocalCerts>(); });
   for (const auto& name : config.prefetch_secret_names()) {
@@ -83,7 +85,13 @@ SecretManager::SecretManager(const ConfigProto& config,
 void SecretManager::addCertificateConfig(absl::string_view secret_name, HandleSharedPtr handle,
                                          OptRef<Init::Manager> init_manager) {
   ASSERT_IS_MAIN_OR_TEST_THREAD();
+  if (!cache_.contains(secret_name)) {
+    evictCertificates();
+  }
   CacheEntry& entry = cache_[secret_name];
+  if (entry.cert_config_ != nullptr) {
+    lru_.splice(lru_.begin(), lru_, entry.lru_position_);
+  }
   if (handle) {
     if (entry.cert_context_) {
       handle->notify(entry.cert_context_);
@@ -102,6 +110,8 @@ void SecretManager::addCertificateConfig(absl::string_view secret_name, HandleSh
         [this](absl::string_view secret_name) -> absl::Status {
           return removeCertificateConfig(secret_name);
         });
+    lru_.emplace_front(secret_name);
+    entry.lru_position_ = lru_.begin();
     stats_->cert_requested_.inc();
     stats_->cert_active_.inc();
   }
@@ -174,6 +184,7 @@ void SecretManager::doRemoveCertificateConfig(absl::string_view secret_name) {
       notify_count++;
     }
   }
+  lru_.erase(it->second.lru_position_);
   cache_.erase(it);
   setContext(secret_name, nullptr);
   stats_->cert_active_.dec();
@@ -181,6 +192,29 @@ void SecretManager::doRemoveCertificateConfig(absl::string_view secret_name) {
             secret_name, notify_count);
 }
 
+void SecretManager::evictCertificates() {
+  if (max_active_certificates_ == 0) {
+    return;
+  }
+  // Every secret is moved at most once before its used bit is cleared, which bounds the scan when
+  // all the secrets are in use by pending handshakes.
+  for (size_t budget = 2 * lru_.size(); cache_.size() >= max_active_certificates_ && budget > 0;
+       budget--) {
+    const std::string& secret_name = lru_.back();
+    const CacheEntry& entry = cache_.at(secret_name);
+    if (!entry.callbacks_.empty() ||
+        (entry.cert_context_ != nullptr && entry.cert_context_->clearUsed())) {
+      // Give the secret a second chance.
+      lru_.splice(lru_.begin(), lru_, entry.lru_position_);
+      continue;
+    }
+    ENVOY_LOG(debug, "Unloading the least recently used certificate '{}'", secret_name);
+    stats_->cert_evicted_.inc();
+    // Copy the name because removing the secret destroys its LRU list node.
+    doRemoveCertificateConfig(std::string(secret_name));
+  }
+}
+
 HandleSharedPtr SecretManager::fetchCertificate(absl::string_view secret_name,
                                                 Ssl::CertificateSelectionCallbackPtr&& cb,
                                                 bool client_ocsp_capable) {
@@ -232,6 +266,7 @@ BaseAsyncSelector::doSelectTlsContext(const std::string& name, const bool client
   auto current_context = secret_manager_->getContext(name);
   if (current_context) {
     ENVOY_LOG(trace, "Using an existing certificate '{}'", name);
+    current_context.value()->markUsed();
     const Ssl::TlsContext* tls_context = &current_context.value()->tlsContext();
     const auto staple_action = ocspStapleAction(*tls_context, client_ocsp_capable,
                                                 current_context.value()->ocspStaplePolicy());
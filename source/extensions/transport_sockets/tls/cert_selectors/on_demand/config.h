@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <list>
+
 #include "envoy/extensions/transport_sockets/tls/cert_selectors/on_demand_secret/v3/config.pb.h"
 #include "envoy/extensions/transport_sockets/tls/cert_selectors/on_demand_secret/v3/config.pb.validate.h"
 #include "envoy/registry/registry.h"
@@ -21,6 +24,7 @@ namespace OnDemand {
 #define ALL_CERT_SELECTION_STATS(COUNTER, GAUGE, HISTOGRAM)                                        \
   COUNTER(cert_requested)                                                                          \
   COUNTER(cert_updated)                                                                            \
+  COUNTER(cert_evicted)                                                                            \
   GAUGE(cert_active, Accumulate)
 
 struct CertSelectionStats {
@@ -83,8 +87,24 @@ public:
    */
   Stats::Scope& certScope() const { return *scope_; }
 
+  /**
+   * Records that the context was selected by a handshake. May be called on any thread.
+   */
+  void markUsed() const {
+    // Avoid writing to the cache line shared by the workers once it is set.
+    if (!used_.load(std::memory_order_relaxed)) {
+      used_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @return whether the context was selected since the last call.
+   */
+  bool clearUsed() const { return used_.exchange(false, std::memory_order_relaxed); }
+
 private:
   Stats::ScopeSharedPtr scope_;
+  mutable std::atomic<bool> used_{false};
 };
 
 class ServerAsyncContext : public AsyncContext,
@@ -211,19 +231,27 @@ public:
 
 private:
   void doRemoveCertificateConfig(absl::string_view);
+  // Unloads the least recently used secrets until a secret can be added within the limit.
+  void evictCertificates();
   const Stats::ScopeSharedPtr stats_scope_;
   CertSelectionStatsSharedPtr stats_;
   Server::Configuration::ServerFactoryContext& factory_context_;
   const envoy::config::core::v3::ConfigSource config_source_;
   AsyncContextFactory context_factory_;
+  const uint32_t max_active_certificates_;
 
   // Main-thread accessible context config subscriptions and callbacks.
   struct CacheEntry {
     AsyncContextConfigConstPtr cert_config_;
     AsyncContextConstSharedPtr cert_context_;
     std::vector<std::weak_ptr<Handle>> callbacks_;
+    std::list<std::string>::iterator lru_position_;
   };
   absl::flat_hash_map<std::string, CacheEntry> cache_;
+  // The names of the secrets in the cache, from the most to the least recently requested. Whether
+  // they were used since is checked when they reach the end, CLOCK style, so that certificates
+  // selected on the workers don't need to notify the main thread.
+  std::list<std::string> lru_;
 
   // Lock-free map to retrieve ready TLS contexts by name.
   struct ThreadLocalCerts : public ThreadLocal::ThreadLocalObject {
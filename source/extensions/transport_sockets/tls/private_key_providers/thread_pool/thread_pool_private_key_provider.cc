@@ -0,0 +1,404 @@
+#include "source/extensions/transport_sockets/tls/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "envoy/extensions/transport_sockets/tls/private_key_providers/thread_pool/v3/thread_pool.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/transport_socket_config.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/config/datasource.h"
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/ec.h"
+#include "openssl/ec_key.h"
+#include "openssl/err.h"
+#include "openssl/evp.h"
+#include "openssl/nid.h"
+#include "openssl/pem.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+namespace {
+
+constexpr uint32_t DefaultMaxBatchSize = 8;
+
+ThreadPoolPrivateKeyConnection* getConnection(SSL* ssl) {
+  return static_cast<ThreadPoolPrivateKeyConnection*>(
+      SSL_get_ex_data(ssl, ThreadPoolPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t startOperation(ThreadPoolPrivateKeyConnection* ops,
+                                        OperationSharedPtr operation, const uint8_t* in,
+                                        size_t in_len) {
+  operation->in_.assign(in, in + in_len);
+  ops->operation_ = operation;
+  ops->queue_.add(std::move(operation));
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t max_out,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr || ops->operation_ != nullptr ||
+      SSL_get_signature_algorithm_key_type(signature_algorithm) != ops->key_type_) {
+    return ssl_private_key_failure;
+  }
+  auto operation = std::make_shared<Operation>(Operation::Type::Sign, ops->cb_, max_out);
+  operation->signature_algorithm_ = signature_algorithm;
+  return startOperation(ops, std::move(operation), in, in_len);
+}
+
+ssl_private_key_result_t privateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t max_out,
+                                           const uint8_t* in, size_t in_len) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr || ops->operation_ != nullptr || ops->key_type_ != EVP_PKEY_RSA) {
+    return ssl_private_key_failure;
+  }
+  return startOperation(
+      ops, std::make_shared<Operation>(Operation::Type::Decrypt, ops->cb_, max_out), in, in_len);
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  if (ops == nullptr || ops->operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  if (!ops->operation_->done_) {
+    return ssl_private_key_retry;
+  }
+  const OperationSharedPtr operation = std::move(ops->operation_);
+  if (!operation->success_ || operation->out_.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  memcpy(out, operation->out_.data(), operation->out_.size()); // NOLINT(safe-memcpy)
+  *out_len = operation->out_.size();
+  return ssl_private_key_success;
+}
+
+bool sign(EVP_PKEY* pkey, uint16_t signature_algorithm, const std::vector<uint8_t>& in,
+          std::vector<uint8_t>& out) {
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pctx;
+  // The digest is null for Ed25519, which signs the message directly.
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm);
+  if (!EVP_DigestSignInit(ctx.get(), &pctx, md, nullptr, pkey)) {
+    return false;
+  }
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pctx, -1 /* salt length is the digest length */))) {
+    return false;
+  }
+  size_t out_len = out.size();
+  if (!EVP_DigestSign(ctx.get(), out.data(), &out_len, in.data(), in.size())) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+bool decrypt(EVP_PKEY* pkey, const std::vector<uint8_t>& in, std::vector<uint8_t>& out) {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey);
+  size_t out_len;
+  if (rsa == nullptr ||
+      !RSA_decrypt(rsa, &out_len, out.data(), out.size(), in.data(), in.size(), RSA_NO_PADDING)) {
+    return false;
+  }
+  out.resize(out_len);
+  return true;
+}
+
+} // namespace
+
+void Operation::run(EVP_PKEY* pkey) {
+  out_.resize(max_out_);
+  switch (type_) {
+  case Type::Sign:
+    success_ = sign(pkey, signature_algorithm_, in_, out_);
+    break;
+  case Type::Decrypt:
+    success_ = decrypt(pkey, in_, out_);
+    break;
+  }
+  if (!success_) {
+    // The errors are reported to the connection by the worker, not through the error queue of
+    // the thread of the pool.
+    ERR_clear_error();
+  }
+}
+
+CryptoThreadPool::CryptoThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                                   bssl::UniquePtr<EVP_PKEY> pkey)
+    : pkey_(std::move(pkey)) {
+  ASSERT(thread_count > 0);
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; i++) {
+    threads_.push_back(
+        thread_factory.createThread([this]() { threadRoutine(); }, Thread::Options{"tls_key"}));
+  }
+}
+
+CryptoThreadPool::~CryptoThreadPool() {
+  {
+    Thread::LockGuard lock(mutex_);
+    shutdown_ = true;
+  }
+  cond_.notifyAll();
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void CryptoThreadPool::submit(WorkerQueueSharedPtr queue, std::vector<OperationSharedPtr> batch) {
+  {
+    Thread::LockGuard lock(mutex_);
+    batches_.push_back(Batch{std::move(queue), std::move(batch)});
+  }
+  cond_.notifyOne();
+}
+
+void CryptoThreadPool::threadRoutine() {
+  while (true) {
+    Batch batch;
+    {
+      Thread::LockGuard lock(mutex_);
+      while (batches_.empty() && !shutdown_) {
+        cond_.wait(mutex_);
+      }
+      if (shutdown_) {
+        // The remaining batches belong to connections which are gone with the provider.
+        return;
+      }
+      batch = std::move(batches_.front());
+      batches_.pop_front();
+    }
+    for (const OperationSharedPtr& operation : batch.operations_) {
+      if (!operation->canceled_.load(std::memory_order_relaxed)) {
+        operation->run(pkey_.get());
+      }
+    }
+    batch.queue_->onBatchComplete(std::move(batch.operations_));
+  }
+}
+
+WorkerQueue::WorkerQueue(Event::Dispatcher& dispatcher, std::weak_ptr<CryptoThreadPool> pool,
+                         uint32_t max_batch_size, const ThreadPoolPrivateKeyStats& stats)
+    : dispatcher_(dispatcher), pool_(std::move(pool)), max_batch_size_(max_batch_size),
+      stats_(stats), flush_callback_(dispatcher.createSchedulableCallback([this]() { flush(); })) {
+  pending_.reserve(max_batch_size_);
+}
+
+void WorkerQueue::add(OperationSharedPtr operation) {
+  stats_.operations_.inc();
+  pending_.push_back(std::move(operation));
+  if (pending_.size() >= max_batch_size_) {
+    flush_callback_->cancel();
+    flush();
+  } else if (!flush_callback_->enabled()) {
+    // Batch the operations of the other connections handled during this loop iteration.
+    flush_callback_->scheduleCallbackCurrentIteration();
+  }
+}
+
+void WorkerQueue::flush() {
+  std::vector<OperationSharedPtr> batch;
+  batch.reserve(max_batch_size_);
+  for (OperationSharedPtr& operation : pending_) {
+    if (operation->canceled_) {
+      stats_.canceled_operations_.inc();
+    } else {
+      batch.push_back(std::move(operation));
+    }
+  }
+  pending_.clear();
+  std::shared_ptr<CryptoThreadPool> pool = pool_.lock();
+  if (batch.empty() || pool == nullptr) {
+    return;
+  }
+  ENVOY_LOG(debug, "thread pool private key provider: handing {} operations to the pool",
+            batch.size());
+  stats_.batch_size_.recordValue(batch.size());
+  pool->submit(shared_from_this(), std::move(batch));
+}
+
+void WorkerQueue::onBatchComplete(std::vector<OperationSharedPtr> batch) {
+  Thread::LockGuard lock(mutex_);
+  if (detached_) {
+    return;
+  }
+  const bool wake_up = completed_.empty();
+  std::move(batch.begin(), batch.end(), std::back_inserter(completed_));
+  if (wake_up) {
+    // The worker isn't destroyed before detaching the queue, which needs the lock.
+    dispatcher_.post([weak_this = weak_from_this()]() {
+      if (WorkerQueueSharedPtr queue = weak_this.lock()) {
+        queue->deliverCompleted();
+      }
+    });
+  }
+}
+
+void WorkerQueue::deliverCompleted() {
+  std::vector<OperationSharedPtr> completed;
+  {
+    Thread::LockGuard lock(mutex_);
+    if (detached_) {
+      return;
+    }
+    completed.swap(completed_);
+  }
+  for (const OperationSharedPtr& operation : completed) {
+    // A callback can close the connections of the following operations.
+    if (operation->canceled_) {
+      stats_.canceled_operations_.inc();
+      continue;
+    }
+    if (!operation->success_) {
+      stats_.failed_operations_.inc();
+    }
+    operation->done_ = true;
+    operation->cb_.onPrivateKeyMethodComplete();
+  }
+}
+
+void WorkerQueue::detach() {
+  ASSERT(dispatcher_.isThreadSafe());
+  {
+    Thread::LockGuard lock(mutex_);
+    detached_ = true;
+    completed_.clear();
+  }
+  flush_callback_.reset();
+  pending_.clear();
+}
+
+ThreadPoolPrivateKeyConnection::~ThreadPoolPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->canceled_ = true;
+  }
+}
+
+ThreadPoolPrivateKeyMethodProvider::ThreadPoolPrivateKeyMethodProvider(
+    const envoy::extensions::transport_sockets::tls::private_key_providers::thread_pool::v3::
+        ThreadPoolPrivateKeyMethodConfig& config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context)
+    : stats_{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+          POOL_COUNTER_PREFIX(factory_context.statsScope(), "thread_pool_private_key"),
+          POOL_HISTOGRAM_PREFIX(factory_context.statsScope(), "thread_pool_private_key"))},
+      tls_(ThreadLocal::TypedSlot<ThreadLocalData>::makeUnique(
+          factory_context.serverFactoryContext().threadLocal())) {
+  Api::Api& api = factory_context.serverFactoryContext().api();
+  const std::string private_key = THROW_OR_RETURN_VALUE(
+      Config::DataSource::read(config.private_key(), false, api), std::string);
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey_ == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+  const int key_type = EVP_PKEY_id(pkey_.get());
+  if (key_type != EVP_PKEY_RSA && key_type != EVP_PKEY_EC && key_type != EVP_PKEY_ED25519) {
+    throw EnvoyException("Not supported key type, only RSA, EC and Ed25519 are supported.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->decrypt = privateKeyDecrypt;
+  method_->complete = privateKeyComplete;
+
+  uint32_t thread_count = config.thread_count();
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+  pool_ = std::make_shared<CryptoThreadPool>(api.threadFactory(), thread_count,
+                                             bssl::UpRef(pkey_));
+
+  const uint32_t max_batch_size =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_batch_size, DefaultMaxBatchSize);
+  // Create a single queue for every worker thread to avoid locking on the request path.
+  tls_->set([pool = std::weak_ptr<CryptoThreadPool>(pool_), max_batch_size,
+             stats = stats_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalData>(
+        std::make_shared<WorkerQueue>(dispatcher, pool, max_batch_size, stats));
+  });
+}
+
+void ThreadPoolPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher&) {
+  if (getConnection(ssl) != nullptr) {
+    throw EnvoyException("Not registering the thread pool provider twice for same context");
+  }
+  ASSERT(tls_->currentThreadRegistered(), "Current thread needs to be registered.");
+  SSL_set_ex_data(
+      ssl, connectionIndex(),
+      new ThreadPoolPrivateKeyConnection(cb, *tls_->get()->queue_, EVP_PKEY_id(pkey_.get())));
+}
+
+void ThreadPoolPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  ThreadPoolPrivateKeyConnection* ops = getConnection(ssl);
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool ThreadPoolPrivateKeyMethodProvider::checkFips() {
+  // The operations are run by the TLS library, so the key is compliant if the library would accept
+  // it in FIPS mode.
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA: {
+    const unsigned bits = RSA_bits(EVP_PKEY_get0_RSA(pkey_.get()));
+    return bits == 2048 || bits == 3072 || bits == 4096;
+  }
+  case EVP_PKEY_EC: {
+    const int curve =
+        EC_GROUP_get_curve_name(EC_KEY_get0_group(EVP_PKEY_get0_EC_KEY(pkey_.get())));
+    return curve == NID_X9_62_prime256v1 || curve == NID_secp384r1;
+  }
+  default:
+    return false;
+  }
+}
+
+namespace {
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+} // namespace
+
+int ThreadPoolPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+ThreadPoolPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& proto_config,
+    Server::Configuration::TransportSocketFactoryContext& factory_context) {
+  envoy::extensions::transport_sockets::tls::private_key_providers::thread_pool::v3::
+      ThreadPoolPrivateKeyMethodConfig config;
+  THROW_IF_NOT_OK(Config::Utility::translateOpaqueConfig(
+      proto_config.typed_config(), ProtobufMessage::getNullValidationVisitor(), config));
+  MessageUtil::validate(config, factory_context.messageValidationVisitor());
+  return std::make_shared<ThreadPoolPrivateKeyMethodProvider>(config, factory_context);
+}
+
+REGISTER_FACTORY(ThreadPoolPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
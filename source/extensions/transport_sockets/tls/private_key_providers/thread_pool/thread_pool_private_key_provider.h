@@ -0,0 +1,209 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/transport_sockets/tls/private_key_providers/thread_pool/v3/thread_pool.pb.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/stats/stats_macros.h"
+#include "envoy/thread/thread.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+
+#define ALL_THREAD_POOL_PRIVATE_KEY_STATS(COUNTER, HISTOGRAM)                                      \
+  COUNTER(operations)                                                                              \
+  COUNTER(failed_operations)                                                                       \
+  COUNTER(canceled_operations)                                                                     \
+  HISTOGRAM(batch_size, Unspecified)
+
+/**
+ * Thread pool private key provider stats. @see stats_macros.h
+ */
+struct ThreadPoolPrivateKeyStats {
+  ALL_THREAD_POOL_PRIVATE_KEY_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
+};
+
+/**
+ * A private key operation of a connection. The inputs are set by the worker before the operation
+ * is handed to the pool, and the outputs by the thread of the pool running it before it is handed
+ * back to the worker.
+ */
+struct Operation {
+  enum class Type { Sign, Decrypt };
+
+  Operation(Type type, Ssl::PrivateKeyConnectionCallbacks& cb, size_t max_out)
+      : type_(type), cb_(cb), max_out_(max_out) {}
+
+  // Runs the operation on the thread of the pool.
+  void run(EVP_PKEY* pkey);
+
+  const Type type_;
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  const size_t max_out_;
+  uint16_t signature_algorithm_{};
+  std::vector<uint8_t> in_;
+
+  std::vector<uint8_t> out_;
+  bool success_{};
+  // Whether the operation was handed back to the worker.
+  bool done_{};
+  // Set by the worker when the connection is closed, so that the pool skips the operation.
+  std::atomic<bool> canceled_{};
+};
+
+using OperationSharedPtr = std::shared_ptr<Operation>;
+
+class WorkerQueue;
+using WorkerQueueSharedPtr = std::shared_ptr<WorkerQueue>;
+
+/**
+ * The threads running the batches of operations of the workers. Only the provider and the workers
+ * own the pool, so that it is never destroyed by one of its threads.
+ */
+class CryptoThreadPool : public Logger::Loggable<Logger::Id::connection> {
+public:
+  CryptoThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                   bssl::UniquePtr<EVP_PKEY> pkey);
+  ~CryptoThreadPool();
+
+  // Hands a batch of operations of a worker to the pool. Thread safe.
+  void submit(WorkerQueueSharedPtr queue, std::vector<OperationSharedPtr> batch);
+
+private:
+  struct Batch {
+    WorkerQueueSharedPtr queue_;
+    std::vector<OperationSharedPtr> operations_;
+  };
+
+  void threadRoutine();
+
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  Thread::MutexBasicLockable mutex_;
+  Thread::CondVar cond_;
+  std::deque<Batch> batches_ ABSL_GUARDED_BY(mutex_);
+  bool shutdown_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+/**
+ * The operations of the connections of a worker. The operations requested during a dispatcher
+ * loop iteration are handed to the pool as batches at the end of the iteration, and the results
+ * handed back by the pool are delivered to the connections with a single post per batch.
+ */
+class WorkerQueue : public std::enable_shared_from_this<WorkerQueue>,
+                    public Logger::Loggable<Logger::Id::connection> {
+public:
+  WorkerQueue(Event::Dispatcher& dispatcher, std::weak_ptr<CryptoThreadPool> pool,
+              uint32_t max_batch_size, const ThreadPoolPrivateKeyStats& stats);
+
+  // Queues an operation, handing the queued operations to the pool once there are enough of
+  // them, or at the end of the current dispatcher loop iteration otherwise.
+  void add(OperationSharedPtr operation);
+
+  // Hands a batch of operations run by the pool back to the worker. Thread safe.
+  void onBatchComplete(std::vector<OperationSharedPtr> batch);
+
+  // Stops delivering the operations handed back by the pool, before the worker is destroyed.
+  void detach();
+
+private:
+  void flush();
+  void deliverCompleted();
+
+  Event::Dispatcher& dispatcher_;
+  // The queue can outlive the provider, as the thread local data is destroyed asynchronously.
+  const std::weak_ptr<CryptoThreadPool> pool_;
+  const uint32_t max_batch_size_;
+  const ThreadPoolPrivateKeyStats stats_;
+  Event::SchedulableCallbackPtr flush_callback_;
+  std::vector<OperationSharedPtr> pending_;
+
+  Thread::MutexBasicLockable mutex_;
+  std::vector<OperationSharedPtr> completed_ ABSL_GUARDED_BY(mutex_);
+  bool detached_ ABSL_GUARDED_BY(mutex_){};
+};
+
+/**
+ * The state of a connection registered to the provider.
+ */
+class ThreadPoolPrivateKeyConnection {
+public:
+  ThreadPoolPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb, WorkerQueue& queue,
+                                 int key_type)
+      : cb_(cb), queue_(queue), key_type_(key_type) {}
+  ~ThreadPoolPrivateKeyConnection();
+
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  WorkerQueue& queue_;
+  // The EVP_PKEY type of the private key.
+  const int key_type_;
+  // The operation in flight, if any.
+  OperationSharedPtr operation_;
+};
+
+/**
+ * A private key provider running the private key operations of the connections on a pool of
+ * threads, keeping the workers free for proxying during handshake storms.
+ */
+class ThreadPoolPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                           public Logger::Loggable<Logger::Id::connection> {
+public:
+  ThreadPoolPrivateKeyMethodProvider(
+      const envoy::extensions::transport_sockets::tls::private_key_providers::thread_pool::v3::
+          ThreadPoolPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  // Thread local data containing a single queue per worker thread.
+  struct ThreadLocalData : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalData(WorkerQueueSharedPtr queue) : queue_(std::move(queue)) {}
+    ~ThreadLocalData() override { queue_->detach(); }
+
+    const WorkerQueueSharedPtr queue_;
+  };
+
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  ThreadPoolPrivateKeyStats stats_;
+  std::shared_ptr<CryptoThreadPool> pool_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalData> tls_;
+};
+
+class ThreadPoolPrivateKeyMethodFactory : public Ssl::PrivateKeyMethodProviderInstanceFactory {
+public:
+  // Ssl::PrivateKeyMethodProviderInstanceFactory
+  Ssl::PrivateKeyMethodProviderSharedPtr createPrivateKeyMethodProviderInstance(
+      const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& config,
+      Server::Configuration::TransportSocketFactoryContext& factory_context) override;
+  std::string name() const override { return "thread_pool"; }
+};
+
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -5,7 +5,10 @@
 #include "envoy/registry/registry.h"
 
 #ifdef ENVOY_ENABLE_QUIC
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/quic/udp_gso_batch_writer.h"
+#include "source/common/quic/udp_sendmmsg_batch_writer.h"
 #endif
 
 #if UDP_GSO_BATCH_WRITER_COMPILETIME_SUPPORT
@@ -17,8 +20,18 @@ class UdpGsoBatchWriterFactoryFactory : public Network::UdpPacketWriterFactoryFa
 public:
   std::string name() const override { return "envoy.udp_packet_writer.gso"; }
   Network::UdpPacketWriterFactoryPtr
-  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+  createUdpPacketWriterFactory(
+      const envoy::config::core::v3::TypedExtensionConfig& config) override {
 #ifdef ENVOY_ENABLE_QUIC
+    envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory proto_config;
+    if (config.has_typed_config()) {
+      MessageUtil::anyConvertAndValidate(config.typed_config(), proto_config,
+                                         ProtobufMessage::getStrictValidationVisitor());
+    }
+    if (proto_config.has_cross_connection_batching()) {
+      return std::make_unique<UdpSendmmsgBatchWriterFactory>(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          proto_config.cross_connection_batching(), max_buffered_packets, 64));
+    }
     return std::make_unique<UdpGsoBatchWriterFactory>();
 #else
     return {};
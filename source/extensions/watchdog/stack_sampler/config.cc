@@ -0,0 +1,31 @@
+#include "source/extensions/watchdog/stack_sampler/config.h"
+
+#include "envoy/registry/registry.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/extensions/watchdog/stack_sampler/stack_sampler_action.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+
+Server::Configuration::GuardDogActionPtr StackSamplerActionFactory::createGuardDogActionFromProto(
+    const envoy::config::bootstrap::v3::Watchdog::WatchdogAction& config,
+    Server::Configuration::GuardDogActionFactoryContext& context) {
+  auto message = createEmptyConfigProto();
+  THROW_IF_NOT_OK(Config::Utility::translateOpaqueConfig(
+      config.config().typed_config(), ProtobufMessage::getStrictValidationVisitor(), *message));
+  return std::make_unique<StackSamplerAction>(dynamic_cast<StackSamplerConfig&>(*message), context);
+}
+
+/**
+ * Static registration for the StackSamplerAction factory. @see RegistryFactory.
+ */
+REGISTER_FACTORY(StackSamplerActionFactory, Server::Configuration::GuardDogActionFactory);
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
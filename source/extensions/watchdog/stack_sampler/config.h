@@ -0,0 +1,34 @@
+#pragma once
+
+#include "envoy/extensions/watchdog/stack_sampler/v3/stack_sampler.pb.h"
+#include "envoy/server/guarddog_config.h"
+
+#include "source/common/protobuf/protobuf.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+
+class StackSamplerActionFactory : public Server::Configuration::GuardDogActionFactory {
+public:
+  StackSamplerActionFactory() = default;
+
+  Server::Configuration::GuardDogActionPtr createGuardDogActionFromProto(
+      const envoy::config::bootstrap::v3::Watchdog::WatchdogAction& config,
+      Server::Configuration::GuardDogActionFactoryContext& context) override;
+
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<StackSamplerConfig>();
+  }
+
+  std::string name() const override { return "envoy.watchdog.stack_sampler"; }
+
+private:
+  using StackSamplerConfig = envoy::extensions::watchdog::stack_sampler::v3::StackSamplerConfig;
+};
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,254 @@
+#include "source/extensions/watchdog/stack_sampler/stack_sampler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <map>
+#include <thread>
+
+#include "source/common/common/logger.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/utility.h"
+
+#include "absl/debugging/stacktrace.h"
+#include "absl/debugging/symbolize.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+
+#ifdef __linux__
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+
+namespace {
+
+struct SharedSamplers {
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::pair<int64_t, uint32_t>, std::weak_ptr<StackSampler>>
+      samplers_ ABSL_GUARDED_BY(mutex_);
+};
+
+SharedSamplers& sharedSamplers() { MUTABLE_CONSTRUCT_ON_FIRST_USE(SharedSamplers); }
+
+#ifdef __linux__
+// A real time signal, so as not to interfere with the SIGPROF of the CPU profiler.
+int sampleSignal() { return SIGRTMIN + 3; }
+#endif
+
+} // namespace
+
+/**
+ * The last samples of a thread. Only written by the signal handler on that thread, and read
+ * concurrently with a sequence number per slot, which is odd while the slot is being written.
+ */
+class StackSampler::Ring {
+public:
+  explicit Ring(uint32_t capacity) : capacity_(capacity), slots_(new Slot[capacity]) {}
+
+#ifdef __linux__
+  static void onSignal(int, siginfo_t* info, void*) {
+    if (info->si_code != SI_TIMER) {
+      return;
+    }
+    Ring* ring = static_cast<Ring*>(info->si_value.sival_ptr);
+    const int saved_errno = errno;
+    ring->busy_.store(true);
+    if (ring->active_.load()) {
+      ring->record();
+    }
+    ring->busy_.store(false);
+    errno = saved_errno;
+  }
+#endif
+
+  void copy(MonotonicTime since, std::vector<Sample>& samples) const {
+    const uint64_t next = next_.load(std::memory_order_acquire);
+    for (uint64_t index = next > capacity_ ? next - capacity_ : 0; index < next; ++index) {
+      const Slot& slot = slots_[index % capacity_];
+      if (slot.sequence_.load(std::memory_order_acquire) != 2 * index + 2) {
+        continue;
+      }
+      const MonotonicTime time = slot.time_;
+      const int depth = std::clamp<int>(slot.depth_, 0, MaxFrames);
+      std::vector<void*> frames(slot.frames_, slot.frames_ + depth);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      // Skip the slots overwritten while they were copied.
+      if (slot.sequence_.load(std::memory_order_relaxed) != 2 * index + 2 || time < since) {
+        continue;
+      }
+      samples.push_back({time, std::move(frames)});
+    }
+  }
+
+  std::atomic<bool> active_{true};
+  // Set while the signal handler runs with the ring.
+  std::atomic<bool> busy_{false};
+#ifdef __linux__
+  timer_t timer_{};
+#endif
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence_{0};
+    MonotonicTime time_;
+    int depth_{0};
+    void* frames_[MaxFrames];
+  };
+
+  void record() {
+    const uint64_t index = next_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index % capacity_];
+    slot.sequence_.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.time_ = std::chrono::steady_clock::now();
+    // Skip the frames of the signal handler.
+    slot.depth_ = absl::GetStackTrace(slot.frames_, MaxFrames, 2);
+    slot.sequence_.store(2 * index + 2, std::memory_order_release);
+    next_.store(index + 1, std::memory_order_release);
+  }
+
+  const uint32_t capacity_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> next_{0};
+};
+
+StackSampler::StackSampler(std::chrono::milliseconds interval, uint32_t capacity)
+    : interval_(interval), capacity_(std::max<uint32_t>(capacity, 1)) {}
+
+StackSampler::~StackSampler() {
+  absl::MutexLock lock(mutex_);
+  for (auto& [thread_id, ring] : active_rings_) {
+    ring->active_.store(false);
+#ifdef __linux__
+    timer_delete(ring->timer_);
+#endif
+  }
+  for (const RingPtr& ring : rings_) {
+    while (ring->busy_.load()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+StackSamplerSharedPtr StackSampler::getShared(std::chrono::milliseconds interval,
+                                              uint32_t capacity) {
+  SharedSamplers& shared_samplers = sharedSamplers();
+  absl::MutexLock lock(shared_samplers.mutex_);
+  std::weak_ptr<StackSampler>& weak_sampler =
+      shared_samplers.samplers_[std::make_pair(interval.count(), capacity)];
+  StackSamplerSharedPtr sampler = weak_sampler.lock();
+  if (sampler == nullptr) {
+    sampler = std::make_shared<StackSampler>(interval, capacity);
+    weak_sampler = sampler;
+  }
+  return sampler;
+}
+
+bool StackSampler::start(const Thread::ThreadId& thread_id) {
+#ifdef __linux__
+  static const bool handler_installed = []() {
+    struct sigaction action {};
+    action.sa_sigaction = Ring::onSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    return sigaction(sampleSignal(), &action, nullptr) == 0;
+  }();
+  if (!handler_installed) {
+    return false;
+  }
+
+  absl::MutexLock lock(mutex_);
+  if (active_rings_.contains(thread_id.getId())) {
+    return true;
+  }
+  auto ring = std::make_unique<Ring>(capacity_);
+  sigevent event{};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = sampleSignal();
+  event.sigev_value.sival_ptr = ring.get();
+  event.sigev_notify_thread_id = static_cast<pid_t>(thread_id.getId());
+  if (timer_create(CLOCK_MONOTONIC, &event, &ring->timer_) != 0) {
+    ENVOY_LOG_MISC(warn, "Stack sampler failed to create the timer of thread {}: {}",
+                   thread_id.debugString(), errorDetails(errno));
+    return false;
+  }
+  itimerspec spec{};
+  spec.it_interval.tv_sec = interval_.count() / 1000;
+  spec.it_interval.tv_nsec = (interval_.count() % 1000) * 1000000;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(ring->timer_, 0, &spec, nullptr) != 0) {
+    ENVOY_LOG_MISC(warn, "Stack sampler failed to arm the timer of thread {}: {}",
+                   thread_id.debugString(), errorDetails(errno));
+    timer_delete(ring->timer_);
+    return false;
+  }
+  active_rings_[thread_id.getId()] = ring.get();
+  rings_.push_back(std::move(ring));
+  return true;
+#else
+  UNREFERENCED_PARAMETER(thread_id);
+  return false;
+#endif
+}
+
+void StackSampler::stop(const Thread::ThreadId& thread_id) {
+  absl::MutexLock lock(mutex_);
+  auto it = active_rings_.find(thread_id.getId());
+  if (it == active_rings_.end()) {
+    return;
+  }
+  it->second->active_.store(false);
+#ifdef __linux__
+  timer_delete(it->second->timer_);
+#endif
+  active_rings_.erase(it);
+}
+
+std::vector<StackSampler::Sample> StackSampler::samples(const Thread::ThreadId& thread_id,
+                                                        MonotonicTime since) {
+  std::vector<Sample> samples;
+  absl::MutexLock lock(mutex_);
+  auto it = active_rings_.find(thread_id.getId());
+  if (it != active_rings_.end()) {
+    it->second->copy(since, samples);
+  }
+  return samples;
+}
+
+std::string StackSampler::foldedStacks(const std::vector<Sample>& samples) {
+  absl::flat_hash_map<void*, std::string> symbols;
+  std::map<std::string, uint64_t> stacks;
+  for (const Sample& sample : samples) {
+    std::vector<absl::string_view> names;
+    names.reserve(sample.frames_.size());
+    for (auto frame = sample.frames_.rbegin(); frame != sample.frames_.rend(); ++frame) {
+      auto [symbol, inserted] = symbols.try_emplace(*frame);
+      if (inserted) {
+        char name[1024];
+        symbol->second =
+            absl::Symbolize(*frame, name, sizeof(name)) ? name : absl::StrFormat("%p", *frame);
+      }
+      names.push_back(symbol->second);
+    }
+    ++stacks[absl::StrJoin(names, ";")];
+  }
+
+  std::string folded;
+  for (const auto& [stack, count] : stacks) {
+    absl::StrAppend(&folded, stack, " ", count, "\n");
+  }
+  return folded;
+}
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+
+/**
+ * Samples the stacks of threads at a fixed wall clock interval, keeping their last samples in a
+ * ring buffer per thread. Each sampled thread has a POSIX timer delivering a signal to it, whose
+ * handler records its stack without locking or allocating. Only supported on Linux: elsewhere
+ * start() fails.
+ */
+class StackSampler : NonCopyable {
+public:
+  static constexpr uint32_t MaxFrames = 64;
+
+  struct Sample {
+    MonotonicTime time_;
+    // The innermost frame first.
+    std::vector<void*> frames_;
+  };
+
+  /**
+   * @param interval the interval between two samples of a thread.
+   * @param capacity the number of samples kept per thread.
+   */
+  StackSampler(std::chrono::milliseconds interval, uint32_t capacity);
+  ~StackSampler();
+
+  /**
+   * @return the sampler shared by the actions with the same interval and capacity, so that a
+   *         thread is only sampled once by them. The sampler is destroyed with its last user.
+   */
+  static std::shared_ptr<StackSampler> getShared(std::chrono::milliseconds interval,
+                                                 uint32_t capacity);
+
+  /**
+   * Starts sampling a thread, if not already.
+   * @return whether the thread is sampled.
+   */
+  bool start(const Thread::ThreadId& thread_id);
+
+  /**
+   * Stops sampling a thread.
+   */
+  void stop(const Thread::ThreadId& thread_id);
+
+  /**
+   * @return the kept samples of a thread taken since a time, the oldest first.
+   */
+  std::vector<Sample> samples(const Thread::ThreadId& thread_id, MonotonicTime since);
+
+  /**
+   * @return the samples as symbolized folded stacks, as used to draw flame graphs: one line per
+   *         distinct stack, with its frames from the outermost separated by semicolons, followed by
+   *         its number of samples.
+   */
+  static std::string foldedStacks(const std::vector<Sample>& samples);
+
+private:
+  class Ring;
+  using RingPtr = std::unique_ptr<Ring>;
+
+  const std::chrono::milliseconds interval_;
+  const uint32_t capacity_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<int64_t, Ring*> active_rings_ ABSL_GUARDED_BY(mutex_);
+  // The rings of the stopped threads are only freed with the sampler, as a signal raised before
+  // their timer was deleted may still be handled with them.
+  std::vector<RingPtr> rings_ ABSL_GUARDED_BY(mutex_);
+};
+
+using StackSamplerSharedPtr = std::shared_ptr<StackSampler>;
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,120 @@
+#include "source/extensions/watchdog/stack_sampler/stack_sampler_action.h"
+
+#include <chrono>
+
+#include "envoy/filesystem/filesystem.h"
+
+#include "source/common/common/utility.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/stats/symbol_table.h"
+
+#include "absl/strings/str_format.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+namespace {
+
+constexpr uint64_t DefaultSamplingIntervalMs = 10;
+constexpr uint64_t DefaultWindowMs = 5000;
+constexpr uint64_t DefaultMaxDumps = 10;
+
+std::string generateDumpFilePath(const std::string& directory, const Thread::ThreadId& thread_id,
+                                 TimeSource& time_source) {
+  const uint64_t timestamp = DateUtil::nowToSeconds(time_source);
+  return absl::StrFormat("%s%sStackSampler.%s.%d", directory,
+                         absl::EndsWith(directory, "/") ? "" : "/", thread_id.debugString(),
+                         timestamp);
+}
+
+} // namespace
+
+StackSamplerAction::StackSamplerAction(
+    const envoy::extensions::watchdog::stack_sampler::v3::StackSamplerConfig& config,
+    Server::Configuration::GuardDogActionFactoryContext& context)
+    : path_(config.output_path()),
+      window_(PROTOBUF_GET_MS_OR_DEFAULT(config, window, DefaultWindowMs)),
+      max_dumps_(config.max_dumps() == 0 ? DefaultMaxDumps : config.max_dumps()),
+      sampler_([&config, this]() {
+        const std::chrono::milliseconds interval(
+            PROTOBUF_GET_MS_OR_DEFAULT(config, sampling_interval, DefaultSamplingIntervalMs));
+        return StackSampler::getShared(interval, window_ / interval + 1);
+      }()),
+      dumps_attempted_(context.stats_.counterFromStatName(
+          Stats::StatNameManagedStorage(
+              absl::StrCat(context.guarddog_name_, ".stack_sampler.attempted"),
+              context.stats_.symbolTable())
+              .statName())),
+      dumps_written_(context.stats_.counterFromStatName(
+          Stats::StatNameManagedStorage(
+              absl::StrCat(context.guarddog_name_, ".stack_sampler.successfully_written"),
+              context.stats_.symbolTable())
+              .statName())),
+      context_(context) {}
+
+void StackSamplerAction::onWatchStarted(const Thread::ThreadId& thread_id) {
+  if (!sampler_->start(thread_id)) {
+    ENVOY_LOG_MISC(warn, "Stack Sampler Action: Unable to sample thread {}.",
+                   thread_id.debugString());
+  }
+}
+
+void StackSamplerAction::onWatchStopped(const Thread::ThreadId& thread_id) {
+  sampler_->stop(thread_id);
+}
+
+void StackSamplerAction::run(
+    envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent /*event*/,
+    const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
+    MonotonicTime now) {
+  auto& fs = context_.api_.fileSystem();
+  for (const auto& [thread_id, last_checkin] : thread_last_checkin_pairs) {
+    dumps_attempted_.inc();
+    if (dumps_started_ >= max_dumps_) {
+      ENVOY_LOG_MISC(warn, "Stack Sampler Action: Unable to dump: already wrote {} dumps.",
+                     dumps_started_);
+      return;
+    }
+    if (!fs.directoryExists(path_)) {
+      ENVOY_LOG_MISC(error, "Stack Sampler Action: Directory path {} doesn't exist.", path_);
+      return;
+    }
+
+    const std::vector<StackSampler::Sample> samples = sampler_->samples(thread_id, now - window_);
+    if (samples.empty()) {
+      ENVOY_LOG_MISC(warn, "Stack Sampler Action: No samples of thread {}.",
+                     thread_id.debugString());
+      continue;
+    }
+    ++dumps_started_;
+    const std::string filename =
+        generateDumpFilePath(path_, thread_id, context_.api_.timeSource());
+    static constexpr Filesystem::FlagSet Flags{1 << Filesystem::File::Operation::Write |
+                                               1 << Filesystem::File::Operation::Create};
+    Filesystem::FilePtr file = fs.createFile({Filesystem::DestinationType::File, filename});
+    if (file == nullptr || !file->open(Flags).return_value_) {
+      ENVOY_LOG_MISC(error, "Stack Sampler Action: Unable to open {}.", filename);
+      continue;
+    }
+    const Api::IoCallSizeResult result = file->write(StackSampler::foldedStacks(samples));
+    file->close();
+    if (!result.ok()) {
+      ENVOY_LOG_MISC(error, "Stack Sampler Action: Unable to write {}.", filename);
+      continue;
+    }
+    ENVOY_LOG_MISC(info,
+                   "Stack Sampler Action: Wrote {} stack samples of thread {}, which last checked "
+                   "in {} ms ago, to {}.",
+                   samples.size(), thread_id.debugString(),
+                   std::chrono::duration_cast<std::chrono::milliseconds>(now - last_checkin)
+                       .count(),
+                   filename);
+    dumps_written_.inc();
+  }
+}
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+
+#include "envoy/extensions/watchdog/stack_sampler/v3/stack_sampler.pb.h"
+#include "envoy/server/guarddog_config.h"
+#include "envoy/stats/stats.h"
+#include "envoy/thread/thread.h"
+
+#include "source/extensions/watchdog/stack_sampler/stack_sampler.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+
+/**
+ * A GuardDogAction that samples the stacks of the watched threads, and writes the last samples of
+ * the threads an event concerns.
+ */
+class StackSamplerAction : public Server::Configuration::GuardDogAction {
+public:
+  StackSamplerAction(
+      const envoy::extensions::watchdog::stack_sampler::v3::StackSamplerConfig& config,
+      Server::Configuration::GuardDogActionFactoryContext& context);
+
+  void run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent event,
+           const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
+           MonotonicTime now) override;
+  void onWatchStarted(const Thread::ThreadId& thread_id) override;
+  void onWatchStopped(const Thread::ThreadId& thread_id) override;
+
+private:
+  const std::string path_;
+  const std::chrono::milliseconds window_;
+  const uint64_t max_dumps_;
+  const StackSamplerSharedPtr sampler_;
+  Stats::Counter& dumps_attempted_;
+  Stats::Counter& dumps_written_;
+  uint64_t dumps_started_ = 0;
+  Server::Configuration::GuardDogActionFactoryContext& context_;
+};
+
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -34,11 +34,29 @@ void ActiveUdpListenerBase::post(Network::UdpRecvData&& data) {
   ASSERT(!udp_listener_->dispatcher().isThreadSafe(),
          "Shouldn't be posting if thread safe; use onWorkerData() instead.");
 
+  {
+    absl::MutexLock lock(forwarded_datagrams_->mutex_);
+    const bool posted = !forwarded_datagrams_->datagrams_.empty();
+    forwarded_datagrams_->datagrams_.push_back(std::move(data));
+    if (posted) {
+      // The datagram is delivered by the callback draining the previous ones.
+      return;
+    }
+  }
+
   auto address = listen_socket_.connectionInfoProvider().localAddress();
-  udp_listener_->dispatcher().post([data = std::move(data), tag = config_->listenerTag(),
-                                    &parent = parent_, address]() mutable {
+  udp_listener_->dispatcher().post([forwarded_datagrams = forwarded_datagrams_,
+                                    tag = config_->listenerTag(), &parent = parent_, address]() {
+    std::vector<Network::UdpRecvData> datagrams;
+    {
+      absl::MutexLock lock(forwarded_datagrams->mutex_);
+      datagrams.swap(forwarded_datagrams->datagrams_);
+    }
     Network::UdpListenerCallbacksOptRef listener = parent.getUdpListenerCallbacks(tag, *address);
-    if (listener.has_value()) {
+    if (!listener.has_value()) {
+      return;
+    }
+    for (Network::UdpRecvData& data : datagrams) {
       listener->get().onDataWorker(std::move(data));
     }
   });
@@ -56,6 +74,7 @@ void ActiveUdpListenerBase::onData(Network::UdpRecvData&& data) {
   if (dest == worker_index_) {
     onDataWorker(std::move(data));
   } else {
+    udp_stats_.downstream_rx_datagram_forwarded_.inc();
     udp_listener_worker_router_.deliver(dest, std::move(data));
   }
 }
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "envoy/network/connection_handler.h"
 #include "envoy/network/filter.h"
@@ -12,10 +13,16 @@
 #include "source/common/network/utility.h"
 #include "source/server/active_listener_base.h"
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Server {
 
-#define ALL_UDP_LISTENER_STATS(COUNTER) COUNTER(downstream_rx_datagram_dropped)
+#define ALL_UDP_LISTENER_STATS(COUNTER)                                                            \
+  COUNTER(downstream_rx_datagram_dropped)                                                          \
+  COUNTER(downstream_rx_datagram_forwarded)                                                        \
+  COUNTER(downstream_rx_datagram_misrouted)
 
 /**
  * Wrapper struct for UDP listener stats. @see stats_macros.h
@@ -56,6 +63,19 @@ protected:
   Network::UdpListenerPtr udp_listener_;
   UdpListenerStats udp_stats_;
   Network::UdpListenerWorkerRouter& udp_listener_worker_router_;
+
+private:
+  // The datagrams forwarded to the worker by the other workers. Only the first datagram forwarded
+  // since the worker last drained them posts to the dispatcher, so that a burst of forwarded
+  // datagrams costs the worker a single wakeup. Shared with the posted callbacks, which can run
+  // after the listener is destroyed.
+  struct ForwardedDatagrams {
+    absl::Mutex mutex_;
+    std::vector<Network::UdpRecvData> datagrams_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  const std::shared_ptr<ForwardedDatagrams> forwarded_datagrams_{
+      std::make_shared<ForwardedDatagrams>()};
 };
 
 /**
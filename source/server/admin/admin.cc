@@ -132,9 +132,9 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                       MAKE_ADMIN_HANDLER(clusters_handler_.handlerClusters), false, false,
                       {{Admin::ParamDescriptor::Type::String, "filter",
                         "Regular expression (Google re2) for filtering clusters by name"}}),
-          makeHandler(
-              "/config_dump", "dump current Envoy configs (experimental)",
-              MAKE_ADMIN_HANDLER(config_dump_handler_.handlerConfigDump), false, false,
+          makeStreamingHandler(
+              "/config_dump", "dump current Envoy configs (experimental)", config_dump_handler_,
+              false, false,
               {{Admin::ParamDescriptor::Type::String, "resource", "The resource to dump"},
                {Admin::ParamDescriptor::Type::String, "mask",
                 "The mask to apply. When both resource and mask are specified, "
@@ -160,6 +160,19 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
                         "enable",
                         "enables the CPU profiler",
                         {"y", "n"}}}),
+          makeHandler("/dispatcherprofiler", "enable/disable the dispatcher callback profiler",
+                      MAKE_ADMIN_HANDLER(profiling_handler_.handlerDispatcherProfiler), false, true,
+                      {{Admin::ParamDescriptor::Type::Enum,
+                        "enable",
+                        "enable/disable the dispatcher callback profiler",
+                        {"y", "n"}},
+                       {Admin::ParamDescriptor::Type::String, "sample_period",
+                        "Time one in sample_period dispatcher callbacks. Defaults to 1000"}}),
+          makeHandler("/dispatcher_profile",
+                      "print the sources using the most dispatcher callback time (if enabled)",
+                      MAKE_ADMIN_HANDLER(profiling_handler_.handlerDispatcherProfile), false, false,
+                      {{Admin::ParamDescriptor::Type::String, "limit",
+                        "The number of sources to print. Defaults to 20"}}),
           makeHandler("/heapprofiler", "enable/disable the heap profiler",
                       MAKE_ADMIN_HANDLER(profiling_handler_.handlerHeapProfiler), false, true,
                       {{Admin::ParamDescriptor::Type::Enum,
@@ -169,6 +182,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/heap_dump", "dump current Envoy heap (if supported)",
                       MAKE_ADMIN_HANDLER(tcmalloc_profiling_handler_.handlerHeapDump), false,
                       false),
+          makeHandler("/heap_subsystems",
+                      "print the current Envoy heap by subsystem (if supported)",
+                      MAKE_ADMIN_HANDLER(tcmalloc_profiling_handler_.handlerHeapBySubsystem),
+                      false, false),
           makeHandler("/allocprofiler", "enable/disable the allocation profiler (if supported)",
                       MAKE_ADMIN_HANDLER(tcmalloc_profiling_handler_.handlerAllocationProfiler),
                       false, true,
@@ -206,6 +223,10 @@ AdminImpl::AdminImpl(const std::string& profile_path, Server::Instance& server,
           makeHandler("/memory/tcmalloc", "print TCMalloc stats",
                       MAKE_ADMIN_HANDLER(server_info_handler_.handleMemoryTcmallocStats), false,
                       false),
+          makeHandler("/memory/clusters", "print per-cluster stats memory usage",
+                      MAKE_ADMIN_HANDLER(clusters_handler_.handlerClustersMemory), false, false,
+                      {{Admin::ParamDescriptor::Type::String, "filter",
+                        "Regular expression (Google re2) for filtering clusters by name"}}),
           makeHandler("/quitquitquit", "exit the server",
                       MAKE_ADMIN_HANDLER(server_cmd_handler_.handlerQuitQuitQuit), false, true),
           makeHandler("/reset_counters", "reset all counters to zero",
@@ -38,6 +38,29 @@ void addCircuitBreakerSettingsAsJson(const envoy::config::core::v3::RoutingPrior
   thresholds.mutable_max_retries()->set_value(resource_manager.retries().max());
 }
 
+// Parses the optional cluster name filter of a request. Returns false if the filter is invalid.
+bool parseFilter(AdminStream& admin_stream, absl::optional<const re2::RE2>& re2_filter) {
+  const auto filter_value = admin_stream.queryParams().getFirstValue("filter");
+  if (filter_value.has_value() && !filter_value.value().empty()) {
+    re2::RE2::Options options;
+    options.set_log_errors(false);
+    re2_filter.emplace(filter_value.value(), options);
+    return re2_filter->ok();
+  }
+  return true;
+}
+
+// Counts the stats held in a cluster's scope, and the bytes of their encoded names.
+template <class StatType>
+void addStatsMemory(const Stats::Scope& scope, uint64_t& count, uint64_t& name_bytes) {
+  scope.iterate(Stats::IterateFn<StatType>(
+      [&count, &name_bytes](const Stats::RefcountPtr<StatType>& stat) -> bool {
+        ++count;
+        name_bytes += stat->statName().size() + stat->tagExtractedStatName().size();
+        return true;
+      }));
+}
+
 } // namespace
 
 ClustersHandler::ClustersHandler(Server::Instance& server) : HandlerContextBase(server) {}
@@ -45,17 +68,11 @@ ClustersHandler::ClustersHandler(Server::Instance& server) : HandlerContextBase(
 Http::Code ClustersHandler::handlerClusters(Http::ResponseHeaderMap& response_headers,
                                             Buffer::Instance& response, AdminStream& admin_stream) {
   const auto format_value = Utility::formatParam(admin_stream.queryParams());
-  const auto filter_value = admin_stream.queryParams().getFirstValue("filter");
 
   absl::optional<const re2::RE2> re2_filter;
-  if (filter_value.has_value() && !filter_value.value().empty()) {
-    re2::RE2::Options options;
-    options.set_log_errors(false);
-    re2_filter.emplace(filter_value.value(), options);
-    if (!re2_filter->ok()) {
-      response.add("Invalid re2 regex");
-      return Http::Code::BadRequest;
-    }
+  if (!parseFilter(admin_stream, re2_filter)) {
+    response.add("Invalid re2 regex");
+    return Http::Code::BadRequest;
   }
 
   if (format_value.has_value() && format_value.value() == "json") {
@@ -68,6 +85,43 @@ Http::Code ClustersHandler::handlerClusters(Http::ResponseHeaderMap& response_he
   return Http::Code::OK;
 }
 
+Http::Code ClustersHandler::handlerClustersMemory(Http::ResponseHeaderMap&,
+                                                  Buffer::Instance& response,
+                                                  AdminStream& admin_stream) {
+  absl::optional<const re2::RE2> re2_filter;
+  if (!parseFilter(admin_stream, re2_filter)) {
+    response.add("Invalid re2 regex");
+    return Http::Code::BadRequest;
+  }
+
+  auto all_clusters = server_.clusterManager().clusters();
+  for (const auto& [name, cluster_ref] : all_clusters.active_clusters_) {
+    UNREFERENCED_PARAMETER(name);
+    const Upstream::ClusterInfoConstSharedPtr& cluster_info = cluster_ref.get().info();
+    const std::string& cluster_name = cluster_info->name();
+    if (!shouldIncludeCluster(cluster_name, re2_filter)) {
+      continue;
+    }
+
+    const Stats::Scope& scope = cluster_info->statsScope();
+    uint64_t name_bytes = 0;
+    uint64_t counters = 0, gauges = 0, histograms = 0, text_readouts = 0;
+    addStatsMemory<Stats::Counter>(scope, counters, name_bytes);
+    addStatsMemory<Stats::Gauge>(scope, gauges, name_bytes);
+    addStatsMemory<Stats::Histogram>(scope, histograms, name_bytes);
+    addStatsMemory<Stats::TextReadout>(scope, text_readouts, name_bytes);
+
+    response.add(fmt::format("{}::counters::{}\n", cluster_name, counters));
+    response.add(fmt::format("{}::gauges::{}\n", cluster_name, gauges));
+    response.add(fmt::format("{}::histograms::{}\n", cluster_name, histograms));
+    response.add(fmt::format("{}::text_readouts::{}\n", cluster_name, text_readouts));
+    response.add(fmt::format("{}::stat_name_bytes::{}\n", cluster_name, name_bytes));
+    response.add(fmt::format("{}::traffic_stats_allocated::{}\n", cluster_name,
+                             cluster_info->trafficStats().isPresent()));
+  }
+  return Http::Code::OK;
+}
+
 // Helper method that ensures that we've setting flags based on all the health flag values on the
 // host.
 void setHealthFlag(Upstream::Host::HealthFlag flag, const Upstream::Host& host,
@@ -33,6 +33,13 @@ public:
   Http::Code handlerClusters(Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
                              AdminStream&);
 
+  /**
+   * Reports, for each cluster, the number of stats in the cluster's scope, the bytes of their
+   * encoded names, and whether the cluster's deferred traffic stats have been allocated.
+   */
+  Http::Code handlerClustersMemory(Http::ResponseHeaderMap& response_headers,
+                                   Buffer::Instance& response, AdminStream&);
+
 private:
   void addOutlierInfo(const std::string& cluster_name,
                       const Upstream::Outlier::Detector* outlier_detector,
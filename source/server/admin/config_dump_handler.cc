@@ -3,6 +3,7 @@
 #include "envoy/config/core/v3/health_check.pb.h"
 #include "envoy/config/endpoint/v3/endpoint.pb.h"
 
+#include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
 #include "source/common/common/regex.h"
 #include "source/common/common/statusor.h"
@@ -11,6 +12,9 @@
 #include "source/common/network/utility.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -144,108 +148,171 @@ buildNameMatcher(const Http::Utility::QueryParamsMulti& params, Regex::Engine& e
                                                  regex_or_error.status().message()));
 }
 
-} // namespace
+// Appends the JSON of a config, indented as an element of the configs of a pretty-printed
+// ConfigDump.
+void addConfigJson(Buffer::Instance& response, const Protobuf::Any& config) {
+  const std::string json = MessageUtil::getJsonStringFromMessageOrError(config, true);
+  bool first_line = true;
+  for (absl::string_view line : absl::StrSplit(absl::StripSuffix(json, "\n"), '\n')) {
+    response.add(first_line ? "  " : "\n  ");
+    response.add(line);
+    first_line = false;
+  }
+}
 
-ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
-    : HandlerContextBase(server), config_tracker_(config_tracker) {}
+} // namespace
 
-Http::Code ConfigDumpHandler::handlerConfigDump(Http::ResponseHeaderMap& response_headers,
-                                                Buffer::Instance& response,
-                                                AdminStream& admin_stream) const {
-  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
-  const absl::optional<std::string> resource =
-      Utility::nonEmptyQueryParam(query_params, "resource");
-  const absl::optional<std::string> mask = Utility::nonEmptyQueryParam(query_params, "mask");
-  const bool include_eds = shouldIncludeEdsInDump(query_params);
-  const absl::StatusOr<Matchers::StringMatcherPtr> name_matcher =
-      buildNameMatcher(query_params, server_.regexEngine());
+ConfigDumpRequest::ConfigDumpRequest(ConfigTracker::CbsMap callbacks_map,
+                                     const Http::Utility::QueryParamsMulti& query_params,
+                                     Regex::Engine& engine)
+    : callbacks_map_(std::move(callbacks_map)), next_callback_(callbacks_map_.begin()),
+      resource_(Utility::nonEmptyQueryParam(query_params, "resource")),
+      mask_(Utility::nonEmptyQueryParam(query_params, "mask")) {
+  absl::StatusOr<Matchers::StringMatcherPtr> name_matcher =
+      buildNameMatcher(query_params, engine);
   if (!name_matcher.ok()) {
-    response.add(name_matcher.status().ToString());
-    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
-    return Http::Code::BadRequest;
+    error_ = std::make_pair(Http::Code::BadRequest, name_matcher.status().ToString());
+    return;
   }
+  name_matcher_ = std::move(*name_matcher);
+  if (mask_.has_value()) {
+    ProtobufUtil::FieldMaskUtil::FromString(mask_.value(), &field_mask_);
+  }
+}
 
-  envoy::admin::v3::ConfigDump dump;
-
-  absl::optional<std::pair<Http::Code, std::string>> err;
-  if (resource.has_value()) {
-    err = addResourceToDump(dump, mask, resource.value(), **name_matcher, include_eds);
-  } else {
-    err = addAllConfigToDump(dump, mask, **name_matcher, include_eds);
+Http::Code ConfigDumpRequest::start(Http::ResponseHeaderMap& response_headers) {
+  if (error_.has_value()) {
+    response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
+    return error_->first;
   }
-  if (err.has_value()) {
+  // Errors are reported by the first config at the latest, before any output.
+  error_ = advance();
+  if (error_.has_value()) {
     response_headers.addReference(Http::Headers::get().XContentTypeOptions,
                                   Http::Headers::get().XContentTypeOptionValues.Nosniff);
     response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Text);
-    response.add(err.value().second);
-    return err.value().first;
+    return error_->first;
   }
-  MessageUtil::redact(dump);
-
   response_headers.setReferenceContentType(Http::Headers::get().ContentTypeValues.Json);
-  response.add(MessageUtil::getJsonStringFromMessageOrError(dump, true)); // pretty-print
   return Http::Code::OK;
 }
 
-absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addResourceToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
-    const std::string& resource, const Matchers::StringMatcher& name_matcher,
-    bool include_eds) const {
-  Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
-  if (include_eds) {
-    // TODO(mattklein123): Add ability to see warming clusters in admin output.
-    if (server_.clusterManager().hasActiveClusters()) {
-      callbacks_map.emplace("endpoint", [this](const Matchers::StringMatcher& name_matcher) {
-        return dumpEndpointConfigs(name_matcher);
-      });
+bool ConfigDumpRequest::nextChunk(Buffer::Instance& response) {
+  if (error_.has_value()) {
+    response.add(error_->second);
+    return false;
+  }
+  if (!started_output_) {
+    started_output_ = true;
+    if (!next_config_.has_value()) {
+      response.add(MessageUtil::getJsonStringFromMessageOrError(envoy::admin::v3::ConfigDump(),
+                                                                true)); // pretty-print
+      return false;
     }
+    response.add("{\n \"configs\": [\n");
+  } else {
+    response.add(",\n");
   }
+  while (true) {
+    addConfigJson(response, next_config_.value());
+    const absl::optional<Error> error = advance();
+    if (error.has_value()) {
+      // Too late to change the response code, so the configs written so far are kept.
+      ENVOY_LOG_MISC(error, "config dump ended early: {}", error->second);
+      break;
+    }
+    if (!next_config_.has_value()) {
+      break;
+    }
+    if (response.length() >= chunk_size_) {
+      return true;
+    }
+    response.add(",\n");
+  }
+  response.add("\n ]\n}\n");
+  return false;
+}
 
-  for (const auto& [name, callback] : callbacks_map) {
-    UNREFERENCED_PARAMETER(name);
-    ProtobufTypes::MessagePtr message = callback(name_matcher);
+absl::optional<ConfigDumpRequest::Error> ConfigDumpRequest::advance() {
+  next_config_.reset();
+  return resource_.has_value() ? advanceToNextResource() : advanceToNextConfig();
+}
+
+absl::optional<ConfigDumpRequest::Error> ConfigDumpRequest::advanceToNextConfig() {
+  while (next_callback_ != callbacks_map_.end()) {
+    ProtobufTypes::MessagePtr message = (next_callback_++)->second(*name_matcher_);
     ASSERT(message);
 
-    auto field_descriptor = message->GetDescriptor()->FindFieldByName(resource);
-    const Protobuf::Reflection* reflection = message->GetReflection();
+    // We don't use trimMessage() above here since masks don't support
+    // indexing through repeated fields. We don't return error on failure
+    // because different callback return types will have different valid
+    // field masks.
+    if (mask_.has_value() && !checkFieldMaskAndTrimMessage(field_mask_, *message)) {
+      continue;
+    }
+    MessageUtil::redact(*message);
+    next_config_.emplace().PackFrom(*message);
+    ++configs_;
+    return absl::nullopt;
+  }
+  if (configs_ == 0 && mask_.has_value()) {
+    return std::make_pair(Http::Code::BadRequest,
+                          absl::StrCat("FieldMask ", *mask_,
+                                       " could not be successfully applied to any configs."));
+  }
+  return absl::nullopt;
+}
+
+absl::optional<ConfigDumpRequest::Error> ConfigDumpRequest::advanceToNextResource() {
+  while (resource_message_ == nullptr) {
+    if (next_callback_ == callbacks_map_.end()) {
+      return std::make_pair(Http::Code::NotFound,
+                            fmt::format("{} not found in config dump", *resource_));
+    }
+    ProtobufTypes::MessagePtr message = (next_callback_++)->second(*name_matcher_);
+    ASSERT(message);
+
+    const Protobuf::FieldDescriptor* field_descriptor =
+        message->GetDescriptor()->FindFieldByName(*resource_);
     if (!field_descriptor) {
       continue;
     } else if (!field_descriptor->is_repeated()) {
-      return absl::optional<std::pair<Http::Code, std::string>>{std::make_pair(
+      return std::make_pair(
           Http::Code::BadRequest,
           fmt::format("{} is not a repeated field. Use ?mask={} to get only this field",
-                      field_descriptor->name(), field_descriptor->name()))};
+                      field_descriptor->name(), field_descriptor->name()));
     }
-
-    auto repeated = reflection->GetRepeatedPtrField<Protobuf::Message>(*message, field_descriptor);
-    for (Protobuf::Message& msg : repeated) {
-      if (mask.has_value()) {
-        Protobuf::FieldMask field_mask;
-        ProtobufUtil::FieldMaskUtil::FromString(mask.value(), &field_mask);
-        if (!trimResourceMessage(field_mask, msg)) {
-          return absl::optional<std::pair<Http::Code, std::string>>{std::make_pair(
-              Http::Code::BadRequest, absl::StrCat("FieldMask ", field_mask.DebugString(),
-                                                   " could not be successfully used."))};
-        }
-      }
-      auto* config = dump.add_configs();
-      config->PackFrom(msg);
-    }
-
     // We found the desired resource so there is no need to continue iterating over
     // the other keys.
-    return absl::nullopt;
+    resource_message_ = std::move(message);
+    resource_field_ = field_descriptor;
   }
 
-  return absl::optional<std::pair<Http::Code, std::string>>{
-      std::make_pair(Http::Code::NotFound, fmt::format("{} not found in config dump", resource))};
+  const Protobuf::Reflection* reflection = resource_message_->GetReflection();
+  if (next_resource_ == reflection->FieldSize(*resource_message_, resource_field_)) {
+    return absl::nullopt;
+  }
+  Protobuf::Message& msg =
+      *reflection->MutableRepeatedMessage(resource_message_.get(), resource_field_,
+                                          next_resource_++);
+  if (mask_.has_value() && !trimResourceMessage(field_mask_, msg)) {
+    return std::make_pair(Http::Code::BadRequest,
+                          absl::StrCat("FieldMask ", field_mask_.DebugString(),
+                                       " could not be successfully used."));
+  }
+  MessageUtil::redact(msg);
+  next_config_.emplace().PackFrom(msg);
+  ++configs_;
+  return absl::nullopt;
 }
 
-absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConfigToDump(
-    envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
-    const Matchers::StringMatcher& name_matcher, bool include_eds) const {
+ConfigDumpHandler::ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server)
+    : HandlerContextBase(server), config_tracker_(config_tracker) {}
+
+Admin::RequestPtr ConfigDumpHandler::makeRequest(AdminStream& admin_stream) const {
+  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
   Envoy::Server::ConfigTracker::CbsMap callbacks_map = config_tracker_.getCallbacksMap();
-  if (include_eds) {
+  if (shouldIncludeEdsInDump(query_params)) {
     // TODO(mattklein123): Add ability to see warming clusters in admin output.
     if (server_.clusterManager().hasActiveClusters()) {
       callbacks_map.emplace("endpoint", [this](const Matchers::StringMatcher& name_matcher) {
@@ -253,33 +320,8 @@ absl::optional<std::pair<Http::Code, std::string>> ConfigDumpHandler::addAllConf
       });
     }
   }
-
-  for (const auto& [name, callback] : callbacks_map) {
-    UNREFERENCED_PARAMETER(name);
-    ProtobufTypes::MessagePtr message = callback(name_matcher);
-    ASSERT(message);
-
-    if (mask.has_value()) {
-      Protobuf::FieldMask field_mask;
-      ProtobufUtil::FieldMaskUtil::FromString(mask.value(), &field_mask);
-      // We don't use trimMessage() above here since masks don't support
-      // indexing through repeated fields. We don't return error on failure
-      // because different callback return types will have different valid
-      // field masks.
-      if (!checkFieldMaskAndTrimMessage(field_mask, *message)) {
-        continue;
-      }
-    }
-
-    auto* config = dump.add_configs();
-    config->PackFrom(*message);
-  }
-  if (dump.configs().empty() && mask.has_value()) {
-    return absl::optional<std::pair<Http::Code, std::string>>{std::make_pair(
-        Http::Code::BadRequest,
-        absl::StrCat("FieldMask ", *mask, " could not be successfully applied to any configs."))};
-  }
-  return absl::nullopt;
+  return std::make_unique<ConfigDumpRequest>(std::move(callbacks_map), query_params,
+                                             server_.regexEngine());
 }
 
 ProtobufTypes::MessagePtr
@@ -1,43 +1,84 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <utility>
+
 #include "envoy/admin/v3/config_dump.pb.h"
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/regex.h"
 #include "envoy/config/endpoint/v3/endpoint_components.pb.h"
 #include "envoy/http/codes.h"
 #include "envoy/http/header_map.h"
 #include "envoy/server/admin.h"
 #include "envoy/server/instance.h"
 
+#include "source/common/common/matchers.h"
+#include "source/common/http/utility.h"
 #include "source/server/admin/config_tracker_impl.h"
 #include "source/server/admin/handler_ctx.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Server {
 
-class ConfigDumpHandler : public HandlerContextBase {
-
+/**
+ * A config dump streamed one config at a time. Each config is materialized, masked, redacted and
+ * serialized only once the previous ones were written, and the JSON is written in chunks of about
+ * the chunk size. With `resource`, each element of the repeated field is a config of its own.
+ */
+class ConfigDumpRequest : public Admin::Request {
 public:
-  ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server);
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
 
-  Http::Code handlerConfigDump(Http::ResponseHeaderMap& response_headers,
-                               Buffer::Instance& response, AdminStream&) const;
+  ConfigDumpRequest(ConfigTracker::CbsMap callbacks_map,
+                    const Http::Utility::QueryParamsMulti& query_params, Regex::Engine& engine);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
 
 private:
-  absl::optional<std::pair<Http::Code, std::string>>
-  addAllConfigToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
-                     const Matchers::StringMatcher& name_matcher, bool include_eds) const;
+  // The Http::Code and the error message of the admin response.
+  using Error = std::pair<Http::Code, std::string>;
+
   /**
-   * Add the config matching the passed resource to the passed config dump.
-   * @return absl::nullopt on success, else the Http::Code and an error message that should be added
-   * to the admin response.
+   * Moves next_config_ to the next config of the dump, or to absl::nullopt once there are no more.
+   * @return absl::nullopt on success, else the error of the request.
    */
-  absl::optional<std::pair<Http::Code, std::string>>
-  addResourceToDump(envoy::admin::v3::ConfigDump& dump, const absl::optional<std::string>& mask,
-                    const std::string& resource, const Matchers::StringMatcher& name_matcher,
-                    bool include_eds) const;
+  absl::optional<Error> advance();
+  absl::optional<Error> advanceToNextConfig();
+  absl::optional<Error> advanceToNextResource();
+
+  const ConfigTracker::CbsMap callbacks_map_;
+  ConfigTracker::CbsMap::const_iterator next_callback_;
+  const absl::optional<std::string> resource_;
+  const absl::optional<std::string> mask_;
+  Protobuf::FieldMask field_mask_;
+  Matchers::StringMatcherPtr name_matcher_;
+  absl::optional<Error> error_;
+  // The message and the repeated field of the dumped resource.
+  ProtobufTypes::MessagePtr resource_message_;
+  const Protobuf::FieldDescriptor* resource_field_{};
+  int next_resource_{0};
+  absl::optional<Protobuf::Any> next_config_;
+  uint64_t configs_{0};
+  bool started_output_{false};
+  uint64_t chunk_size_{DefaultChunkSize};
+};
+
+class ConfigDumpHandler : public HandlerContextBase {
+
+public:
+  ConfigDumpHandler(ConfigTracker& config_tracker, Server::Instance& server);
 
+  Admin::RequestPtr makeRequest(AdminStream& admin_stream) const;
+
+private:
   /**
    * Helper methods to add endpoints config
    */
@@ -1,8 +1,11 @@
 #include "source/server/admin/profiling_handler.h"
 
+#include "source/common/event/callback_profiler.h"
 #include "source/common/profiler/profiler.h"
 #include "source/server/admin/utils.h"
 
+#include "absl/strings/numbers.h"
+
 namespace Envoy {
 namespace Server {
 
@@ -34,6 +37,64 @@ Http::Code ProfilingHandler::handlerCpuProfiler(Http::ResponseHeaderMap&,
   return Http::Code::OK;
 }
 
+Http::Code ProfilingHandler::handlerDispatcherProfiler(Http::ResponseHeaderMap&,
+                                                       Buffer::Instance& response,
+                                                       AdminStream& admin_stream) {
+  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
+  const auto enable_val = query_params.getFirstValue("enable");
+  const auto sample_period_val = query_params.getFirstValue("sample_period");
+  uint32_t sample_period = DefaultDispatcherSamplePeriod;
+  const bool valid_sample_period =
+      !sample_period_val.has_value() ||
+      (absl::SimpleAtoi(sample_period_val.value(), &sample_period) && sample_period != 0);
+  if (!enable_val.has_value() || (enable_val.value() != "y" && enable_val.value() != "n") ||
+      !valid_sample_period || (sample_period_val.has_value() && enable_val.value() != "y")) {
+    response.add("?enable=<y|n>&sample_period=<period>\n");
+    return Http::Code::BadRequest;
+  }
+
+  if (enable_val.value() == "y") {
+    // Only keep the profile of the last enablement.
+    if (Event::CallbackProfiler::samplePeriod() == 0) {
+      Event::CallbackProfiler::reset();
+    }
+    Event::CallbackProfiler::setSamplePeriod(sample_period);
+  } else {
+    Event::CallbackProfiler::setSamplePeriod(0);
+  }
+
+  response.add("OK\n");
+  return Http::Code::OK;
+}
+
+Http::Code ProfilingHandler::handlerDispatcherProfile(Http::ResponseHeaderMap&,
+                                                      Buffer::Instance& response,
+                                                      AdminStream& admin_stream) {
+  Http::Utility::QueryParamsMulti query_params = admin_stream.queryParams();
+  const auto limit_val = query_params.getFirstValue("limit");
+  uint32_t limit = DefaultDispatcherProfileLimit;
+  if (limit_val.has_value() && !absl::SimpleAtoi(limit_val.value(), &limit)) {
+    response.add("?limit=<number of sources>\n");
+    return Http::Code::BadRequest;
+  }
+
+  const auto sources = Event::CallbackProfiler::topSources(limit);
+  if (sources.empty() && Event::CallbackProfiler::samplePeriod() == 0) {
+    response.add("The dispatcher callback profiler is not enabled. To enable, use "
+                 "/dispatcherprofiler?enable=y.\n");
+    return Http::Code::OK;
+  }
+  for (const auto& [source, stats] : sources) {
+    response.add(fmt::format(
+        "{}: samples={} total_us={} mean_us={} max_us={}\n", source, stats.samples_,
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.total_).count(),
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.total_ / stats.samples_)
+            .count(),
+        std::chrono::duration_cast<std::chrono::microseconds>(stats.max_).count()));
+  }
+  return Http::Code::OK;
+}
+
 Http::Code ProfilingHandler::handlerHeapProfiler(Http::ResponseHeaderMap&,
                                                  Buffer::Instance& response,
                                                  AdminStream& admin_stream) {
@@ -122,5 +183,20 @@ Http::Code TcmallocProfilingHandler::handlerAllocationProfiler(Http::ResponseHea
   return Http::Code::OK;
 }
 
+Http::Code TcmallocProfilingHandler::handlerHeapBySubsystem(Http::ResponseHeaderMap&,
+                                                            Buffer::Instance& response,
+                                                            AdminStream&) {
+  const auto usage = Profiler::TcmallocProfiler::tcmallocHeapBySubsystem();
+  if (!usage.ok()) {
+    response.add(usage.status().message());
+    return Http::Code::NotImplemented;
+  }
+  for (const auto& subsystem_usage : usage.value()) {
+    response.add(fmt::format("{}: bytes={} allocations={}\n", subsystem_usage.subsystem_,
+                             subsystem_usage.bytes_, subsystem_usage.allocations_));
+  }
+  return Http::Code::OK;
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -21,6 +21,17 @@ public:
   Http::Code handlerHeapProfiler(Http::ResponseHeaderMap& response_headers,
                                  Buffer::Instance& response, AdminStream&);
 
+  Http::Code handlerDispatcherProfiler(Http::ResponseHeaderMap& response_headers,
+                                       Buffer::Instance& response, AdminStream&);
+
+  Http::Code handlerDispatcherProfile(Http::ResponseHeaderMap& response_headers,
+                                      Buffer::Instance& response, AdminStream&);
+
+  // The default sample period of the dispatcher callback profiler.
+  static constexpr uint32_t DefaultDispatcherSamplePeriod = 1000;
+  // The default number of sources reported by the dispatcher callback profiler.
+  static constexpr uint32_t DefaultDispatcherProfileLimit = 20;
+
 private:
   const std::string profile_path_;
 };
@@ -34,6 +45,9 @@ public:
 
   Http::Code handlerAllocationProfiler(Http::ResponseHeaderMap& response_headers,
                                        Buffer::Instance& response, AdminStream&);
+
+  Http::Code handlerHeapBySubsystem(Http::ResponseHeaderMap& response_headers,
+                                    Buffer::Instance& response, AdminStream&);
 };
 
 } // namespace Server
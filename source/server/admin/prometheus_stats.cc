@@ -1,6 +1,8 @@
 #include "source/server/admin/prometheus_stats.h"
 
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <map>
 #include <set>
 
@@ -11,6 +13,7 @@
 #include "source/common/stats/histogram_impl.h"
 #include "source/common/upstream/host_utility.h"
 
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "io/prometheus/client/metrics.pb.h"
@@ -31,7 +34,20 @@ std::string sanitizeName(const absl::string_view name) {
   // The name must match the regex [a-zA-Z_][a-zA-Z0-9_]* as required by
   // prometheus. Refer to https://prometheus.io/docs/concepts/data_model/.
   // The initial [a-zA-Z_] constraint is always satisfied by the namespace prefix.
-  return promRegex().replaceAll(name, "_");
+  //
+  // This runs for every tag of every series, so ASCII names, which are all names in practice, are
+  // sanitized without the regex. The regex replaces each multi-byte UTF-8 character with a single
+  // '_', so it is still used for other names.
+  std::string sanitized(name);
+  for (char& c : sanitized) {
+    if (!absl::ascii_isascii(c)) {
+      return promRegex().replaceAll(name, "_");
+    }
+    if (!absl::ascii_isalnum(c) && c != '_') {
+      c = '_';
+    }
+  }
+  return sanitized;
 }
 
 /**
@@ -43,6 +59,9 @@ std::string sanitizeValue(const absl::string_view value) {
   // text serialization issues. This matches the prometheus text formatting code:
   // https://github.com/prometheus/common/blob/88f1636b699ae4fb949d292ffb904c205bf542c9/expfmt/text_create.go#L419-L420.
   // The goal is to replace '\' with "\\", newline with "\n", and '"' with "\"".
+  if (value.find_first_of("\\\n\"") == absl::string_view::npos) {
+    return std::string(value);
+  }
   return absl::StrReplaceAll(value, {
                                         {R"(\)", R"(\\)"},
                                         {"\n", R"(\n)"},
@@ -634,24 +653,25 @@ private:
   uint32_t native_histogram_max_buckets_{kDefaultMaxNativeHistogramBuckets};
 };
 
+using GroupFns = std::vector<std::function<void(Buffer::Instance&)>>;
+
 /**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
+ * Groups the metrics of a stat type (counter, gauge, histogram) by tag-extracted metric name, in
+ * the sorted order in which they are output. Each group is added as a function to `groups` that
+ * sorts its metrics and outputs them, so that the output can be spread over several chunks.
  *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
+ * @param groups receives a function per metric name that outputs the metrics with that name.
+ * @param params The request parameters, filtering which stats to output.
  * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+ *        to be included in the same output, and must outlive the added functions.
+ * @param output_format The format generating the output for a group.
+ * @param custom_namespaces The namespaces whose metric names are not prefixed with "envoy_".
  */
 template <class StatType>
-uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
-                        const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-                        const PrometheusStatsFormatter::OutputFormat& output_format,
-                        const Stats::CustomStatNamespaces& custom_namespaces) {
+void addStatTypeGroups(GroupFns& groups, const StatsParams& params,
+                       const std::vector<Stats::RefcountPtr<StatType>>& metrics,
+                       const PrometheusStatsFormatter::OutputFormat& output_format,
+                       const Stats::CustomStatNamespaces& custom_namespaces) {
 
   /*
    * From
@@ -672,7 +692,7 @@ uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
 
   // Return early to avoid crashing when getting the symbol table from the first metric.
   if (metrics.empty()) {
-    return 0;
+    return;
   }
 
   // There should only be one symbol table for all of the stats in the admin
@@ -683,7 +703,7 @@ uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
 
   // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
   // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
+  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> sorted_groups(
       global_symbol_table);
 
   for (const auto& metric : metrics) {
@@ -691,85 +711,65 @@ uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
     if (!params.shouldShowMetric(*metric)) {
       continue;
     }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
+    sorted_groups[metric->tagExtractedStatName()].push_back(metric.get());
   }
 
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
+  for (auto& group : sorted_groups) {
+    absl::optional<std::string> prefixed_tag_extracted_name =
         PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
                                              custom_namespaces);
     if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
       continue;
     }
 
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
-
-    output_format.generateOutput(response, group.second, prefixed_tag_extracted_name.value());
+    groups.push_back([&output_format, name = std::move(prefixed_tag_extracted_name.value()),
+                      group_metrics = std::move(group.second)](Buffer::Instance& response) mutable {
+      // Sort before producing the final output to satisfy the "preferred" ordering from the
+      // prometheus spec: metrics will be sorted by their tags' textual representation, which will
+      // be consistent across calls.
+      std::sort(group_metrics.begin(), group_metrics.end(), MetricLessThan());
+      output_format.generateOutput(response, group_metrics, name);
+    });
   }
-  return result;
 }
 
-template <class StatType, class OutputFormat>
-uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
-                                 const std::vector<StatType>& metrics,
-                                 const OutputFormat& output_format,
-                                 const Stats::CustomStatNamespaces& custom_namespaces) {
-
-  /*
-   * From
-   * https:*github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
-   *
-   * All lines for a given metric must be provided as one single group, with the optional HELP and
-   * TYPE lines first (in no particular order). Beyond that, reproducible sorting in repeated
-   * expositions is preferred but not required, i.e. do not sort if the computational cost is
-   * prohibitive.
-   */
-
-  // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
-  // be sorted before producing the final output to satisfy the "preferred" ordering from the
-  // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
-  // consistent across calls.
+template <class StatType>
+void addPrimitiveStatTypeGroups(GroupFns& groups, const StatsParams& params,
+                                const std::vector<StatType>& metrics,
+                                const PrometheusStatsFormatter::OutputFormat& output_format,
+                                const Stats::CustomStatNamespaces& custom_namespaces) {
+  // See addStatTypeGroups for the grouping and sorting requirements.
   using StatTypeUnsortedCollection = std::vector<const StatType*>;
 
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
-  }
-
   // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
   // of the exposition format.
-  std::map<std::string, StatTypeUnsortedCollection> groups;
+  std::map<std::string, StatTypeUnsortedCollection> sorted_groups;
 
   for (const auto& metric : metrics) {
     if (!params.shouldShowMetric(metric)) {
       continue;
     }
-    groups[metric.tagExtractedName()].push_back(&metric);
+    sorted_groups[metric.tagExtractedName()].push_back(&metric);
   }
 
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
+  for (auto& group : sorted_groups) {
+    absl::optional<std::string> prefixed_tag_extracted_name =
         PrometheusStatsFormatter::metricName(group.first, custom_namespaces);
     if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
       continue;
     }
 
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), PrimitiveMetricSnapshotLessThan());
-
-    output_format.generateOutput(response, group.second, prefixed_tag_extracted_name.value());
+    groups.push_back([&output_format, name = std::move(prefixed_tag_extracted_name.value()),
+                      group_metrics = std::move(group.second)](Buffer::Instance& response) mutable {
+      std::sort(group_metrics.begin(), group_metrics.end(), PrimitiveMetricSnapshotLessThan());
+      output_format.generateOutput(response, group_metrics, name);
+    });
   }
-  return result;
+}
+
+absl::string_view protobufContentType() {
+  return "application/vnd.google.protobuf; "
+         "proto=io.prometheus.client.MetricFamily; encoding=delimited";
 }
 
 // Determine the format based on Accept header, using first-match priority.
@@ -820,12 +820,12 @@ bool useProtobufFormat(const StatsParams& params, const Http::RequestHeaderMap&
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
-  std::vector<std::string> buf;
-  buf.reserve(tags.size());
+  std::string formatted;
   for (const Stats::Tag& tag : tags) {
-    buf.push_back(fmt::format("{}=\"{}\"", sanitizeName(tag.name_), sanitizeValue(tag.value_)));
+    absl::StrAppend(&formatted, formatted.empty() ? "" : ",", sanitizeName(tag.name_), "=\"",
+                    sanitizeValue(tag.value_), "\"");
   }
-  return absl::StrJoin(buf, ",");
+  return formatted;
 }
 
 absl::Status PrometheusStatsFormatter::validateParams(const StatsParams& params,
@@ -879,14 +879,13 @@ PrometheusStatsFormatter::metricName(const std::string& extracted_name,
   return absl::StrCat("envoy_", sanitizeName(extracted_name));
 }
 
-uint64_t PrometheusStatsFormatter::generateWithOutputFormat(
+PrometheusStatsFormatter::ChunkedRenderer::ChunkedRenderer(
     const std::vector<Stats::CounterSharedPtr>& counters,
     const std::vector<Stats::GaugeSharedPtr>& gauges,
     const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
     const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
-    const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
-    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces,
-    OutputFormat& output_format) {
+    const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+    const Stats::CustomStatNamespaces& custom_namespaces, OutputFormat& output_format) {
 
   OutputFormat::HistogramType hist_type;
 
@@ -913,37 +912,63 @@ uint64_t PrometheusStatsFormatter::generateWithOutputFormat(
 
   output_format.setHistogramType(hist_type);
 
-  uint64_t metric_name_count = 0;
-  metric_name_count +=
-      outputStatType<Stats::Counter>(response, params, counters, output_format, custom_namespaces);
-
-  metric_name_count +=
-      outputStatType<Stats::Gauge>(response, params, gauges, output_format, custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::TextReadout>(response, params, text_readouts,
-                                                          output_format, custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::ParentHistogram>(response, params, histograms,
-                                                              output_format, custom_namespaces);
+  addStatTypeGroups<Stats::Counter>(groups_, params, counters, output_format, custom_namespaces);
+  addStatTypeGroups<Stats::Gauge>(groups_, params, gauges, output_format, custom_namespaces);
+  addStatTypeGroups<Stats::TextReadout>(groups_, params, text_readouts, output_format,
+                                        custom_namespaces);
+  addStatTypeGroups<Stats::ParentHistogram>(groups_, params, histograms, output_format,
+                                            custom_namespaces);
 
   // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
   // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
   // with the above counter/gauge calls so that stats can be properly grouped.
-  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
-  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
       [&](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters.emplace_back(std::move(metric));
+        host_counters_.emplace_back(std::move(metric));
       },
-      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) {
+        host_gauges_.emplace_back(std::move(metric));
+      });
+
+  addPrimitiveStatTypeGroups(groups_, params, host_counters_, output_format, custom_namespaces);
+  addPrimitiveStatTypeGroups(groups_, params, host_gauges_, output_format, custom_namespaces);
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, output_format, custom_namespaces);
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, output_format, custom_namespaces);
+bool PrometheusStatsFormatter::ChunkedRenderer::nextChunk(Buffer::Instance& response,
+                                                          uint64_t chunk_size) {
+  const uint64_t starting_length = response.length();
+  while (next_group_ < groups_.size() && response.length() - starting_length < chunk_size) {
+    groups_[next_group_](response);
+    // Release the group's metric pointers as soon as they are rendered.
+    groups_[next_group_++] = nullptr;
+  }
+  return next_group_ < groups_.size();
+}
 
-  return metric_name_count;
+std::unique_ptr<PrometheusStatsFormatter::OutputFormat>
+PrometheusStatsFormatter::makeOutputFormat(const StatsParams& params,
+                                           const Http::RequestHeaderMap& headers,
+                                           Http::ResponseHeaderMap& response_headers) {
+  if (!useProtobufFormat(params, headers)) {
+    return std::make_unique<TextFormat>();
+  }
+  response_headers.setReferenceContentType(protobufContentType());
+  return std::make_unique<ProtobufFormat>(params.native_histogram_max_buckets_);
+}
+
+uint64_t PrometheusStatsFormatter::generateWithOutputFormat(
+    const std::vector<Stats::CounterSharedPtr>& counters,
+    const std::vector<Stats::GaugeSharedPtr>& gauges,
+    const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
+    const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
+    const Upstream::ClusterManager& cluster_manager, Buffer::Instance& response,
+    const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces,
+    OutputFormat& output_format) {
+  ChunkedRenderer renderer(counters, gauges, histograms, text_readouts, cluster_manager, params,
+                           custom_namespaces, output_format);
+  renderer.nextChunk(response, std::numeric_limits<uint64_t>::max());
+  return renderer.metricNameCount();
 }
 
 uint64_t PrometheusStatsFormatter::statsAsPrometheusText(
@@ -968,9 +993,7 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheusProtobuf(
     Buffer::Instance& response, const StatsParams& params,
     const Stats::CustomStatNamespaces& custom_namespaces) {
 
-  response_headers.setReferenceContentType(
-      "application/vnd.google.protobuf; "
-      "proto=io.prometheus.client.MetricFamily; encoding=delimited");
+  response_headers.setReferenceContentType(protobufContentType());
 
   ProtobufFormat output_format(params.native_histogram_max_buckets_);
   return generateWithOutputFormat(counters, gauges, histograms, text_readouts, cluster_manager,
@@ -986,12 +1009,10 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
     Http::ResponseHeaderMap& response_headers, Buffer::Instance& response,
     const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces) {
 
-  return useProtobufFormat(params, request_headers)
-             ? statsAsPrometheusProtobuf(counters, gauges, histograms, text_readouts,
-                                         cluster_manager, response_headers, response, params,
-                                         custom_namespaces)
-             : statsAsPrometheusText(counters, gauges, histograms, text_readouts, cluster_manager,
-                                     response, params, custom_namespaces);
+  std::unique_ptr<OutputFormat> output_format =
+      makeOutputFormat(params, request_headers, response_headers);
+  return generateWithOutputFormat(counters, gauges, histograms, text_readouts, cluster_manager,
+                                  response, params, custom_namespaces, *output_format);
 }
 
 } // namespace Server
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/stats/custom_stat_namespaces.h"
@@ -68,6 +71,51 @@ public:
     HistogramType histogram_type_;
   };
 
+  /**
+   * Renders the prometheus output for a set of stats in pieces, so that a large response can be
+   * streamed in bounded-size chunks rather than being buffered in full. Stats are grouped by
+   * metric name on construction, and the groups are rendered in order by nextChunk(). The stat
+   * vectors, params, custom namespaces and output format must outlive the renderer.
+   */
+  class ChunkedRenderer {
+  public:
+    ChunkedRenderer(const std::vector<Stats::CounterSharedPtr>& counters,
+                    const std::vector<Stats::GaugeSharedPtr>& gauges,
+                    const std::vector<Stats::ParentHistogramSharedPtr>& histograms,
+                    const std::vector<Stats::TextReadoutSharedPtr>& text_readouts,
+                    const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+                    const Stats::CustomStatNamespaces& custom_namespaces,
+                    OutputFormat& output_format);
+
+    /**
+     * Renders metric groups into response until chunk_size bytes have been added or all groups
+     * are rendered. Groups are not split, so a chunk may exceed chunk_size by up to one group.
+     * @return true if there are more groups to render.
+     */
+    bool nextChunk(Buffer::Instance& response, uint64_t chunk_size);
+
+    /**
+     * @return uint64_t total number of metric types rendered once all chunks are done.
+     */
+    uint64_t metricNameCount() const { return groups_.size(); }
+
+  private:
+    using GroupFn = std::function<void(Buffer::Instance&)>;
+
+    std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
+    std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges_;
+    std::vector<GroupFn> groups_;
+    size_t next_group_{0};
+  };
+
+  /**
+   * Creates the output format for a request, setting the content type in response_headers if it
+   * is not the text format.
+   */
+  static std::unique_ptr<OutputFormat> makeOutputFormat(const StatsParams& params,
+                                                        const Http::RequestHeaderMap& headers,
+                                                        Http::ResponseHeaderMap& response_headers);
+
   /**
    * Extracts counters and gauges and relevant tags, appending them to
    * the response buffer after sanitizing the metric / label names.
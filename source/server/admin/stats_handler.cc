@@ -21,29 +21,47 @@ namespace Server {
 const uint64_t RecentLookupsCapacity = 100;
 
 namespace {
-// Implements a chunked request for Prometheus stats.
+// Implements a chunked request for Prometheus stats. The stats are collected and grouped by
+// metric name when the request starts, and each call to nextChunk() renders the next groups.
 class PrometheusRequest : public Admin::Request {
 public:
-  PrometheusRequest(StatsHandler& handler, const StatsParams& params, AdminStream& admin_stream)
-      : handler_(handler), params_(params), admin_stream_(admin_stream) {}
+  PrometheusRequest(Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+                    const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+                    const Http::RequestHeaderMap& request_headers)
+      : stats_(stats), custom_namespaces_(custom_namespaces), cluster_manager_(cluster_manager),
+        params_(params), request_headers_(request_headers) {}
 
   Http::Code start(Http::ResponseHeaderMap& response_headers) override {
-    code_ = handler_.prometheusFlushAndRender(params_, admin_stream_.getRequestHeaders(),
-                                              response_headers, response_);
-    return code_;
+    output_format_ =
+        PrometheusStatsFormatter::makeOutputFormat(params_, request_headers_, response_headers);
+    counters_ = stats_.counters();
+    gauges_ = stats_.gauges();
+    histograms_ = stats_.histograms();
+    if (params_.prometheus_text_readouts_) {
+      text_readouts_ = stats_.textReadouts();
+    }
+    renderer_ = std::make_unique<PrometheusStatsFormatter::ChunkedRenderer>(
+        counters_, gauges_, histograms_, text_readouts_, cluster_manager_, params_,
+        custom_namespaces_, *output_format_);
+    return Http::Code::OK;
   }
 
   bool nextChunk(Buffer::Instance& response) override {
-    response.move(response_);
-    return false;
+    return renderer_->nextChunk(response, StatsRequest::DefaultChunkSize);
   }
 
 private:
-  StatsHandler& handler_;
+  Stats::Store& stats_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  const Upstream::ClusterManager& cluster_manager_;
   const StatsParams params_;
-  AdminStream& admin_stream_;
-  Buffer::OwnedImpl response_;
-  Http::Code code_{Http::Code::OK};
+  const Http::RequestHeaderMap& request_headers_;
+  std::vector<Stats::CounterSharedPtr> counters_;
+  std::vector<Stats::GaugeSharedPtr> gauges_;
+  std::vector<Stats::ParentHistogramSharedPtr> histograms_;
+  std::vector<Stats::TextReadoutSharedPtr> text_readouts_;
+  std::unique_ptr<PrometheusStatsFormatter::OutputFormat> output_format_;
+  std::unique_ptr<PrometheusStatsFormatter::ChunkedRenderer> renderer_;
 };
 } // namespace
 
@@ -107,14 +125,17 @@ Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   }
 
   if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    return std::make_unique<PrometheusRequest>(*this, params, admin_stream);
+    const absl::Status status =
+        PrometheusStatsFormatter::validateParams(params, admin_stream.getRequestHeaders());
+    if (!status.ok()) {
+      return Admin::makeStaticTextRequest(status.message(), Http::Code::BadRequest);
+    }
+    if (server_.statsConfig().flushOnAdmin()) {
+      server_.flushStats();
+    }
+    return makePrometheusRequest(server_.stats(), server_.api().customStatNamespaces(),
+                                 server_.clusterManager(), params,
+                                 admin_stream.getRequestHeaders());
   }
 
   if (params.histogram_buckets_mode_ == Utility::HistogramBucketsMode::PrometheusNative) {
@@ -143,6 +164,15 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params, cluster_manager, url_handler_fn);
 }
 
+Admin::RequestPtr
+StatsHandler::makePrometheusRequest(Stats::Store& stats,
+                                    const Stats::CustomStatNamespaces& custom_namespaces,
+                                    const Upstream::ClusterManager& cm, const StatsParams& params,
+                                    const Http::RequestHeaderMap& request_headers) {
+  return std::make_unique<PrometheusRequest>(stats, custom_namespaces, cm, params,
+                                             request_headers);
+}
+
 Http::Code StatsHandler::handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
                                                 Buffer::Instance& response,
                                                 AdminStream& admin_stream) {
@@ -96,6 +96,22 @@ public:
                                        const Upstream::ClusterManager& cm,
                                        StatsRequest::UrlHandlerFn url_handler_fn = nullptr);
   Admin::RequestPtr makeRequest(AdminStream&);
+
+  /**
+   * Makes a request streaming the stats as prometheus in chunks. The
+   * parameters must already be validated, and the arguments must outlive the
+   * request.
+   *
+   * @param stats the stats store to read
+   * @param custom_namespaces namespace mappings used for prometheus
+   * @param cm the cluster manager providing the per-endpoint stats
+   * @param params the already-parsed parameters
+   * @param request_headers the request headers, selecting the output format
+   */
+  static Admin::RequestPtr
+  makePrometheusRequest(Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+                        const Upstream::ClusterManager& cm, const StatsParams& params,
+                        const Http::RequestHeaderMap& request_headers);
 };
 
 } // namespace Server
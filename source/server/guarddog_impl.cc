@@ -201,12 +201,22 @@ WatchDogSharedPtr GuardDogImpl::createWatchDog(Thread::ThreadId thread_id,
     Thread::LockGuard guard(wd_lock_);
     watched_dogs_.push_back(std::move(watched_dog));
   }
+  for (auto& event_actions : events_to_actions_) {
+    for (auto& action : event_actions.second) {
+      action->onWatchStarted(new_watchdog->threadId());
+    }
+  }
   dispatcher.registerWatchdog(new_watchdog, wd_interval);
   new_watchdog->touch();
   return new_watchdog;
 }
 
 void GuardDogImpl::stopWatching(WatchDogSharedPtr wd) {
+  for (auto& event_actions : events_to_actions_) {
+    for (auto& action : event_actions.second) {
+      action->onWatchStopped(wd->threadId());
+    }
+  }
   Thread::LockGuard guard(wd_lock_);
   auto found_wd = std::find_if(watched_dogs_.begin(), watched_dogs_.end(),
                                [&wd](const WatchedDogPtr& d) -> bool { return d->dog_ == wd; });
@@ -71,6 +71,29 @@ void RpcStream::bindDomainSocket(uint64_t id, const std::string& role,
 
 bool RpcStream::sendHotRestartMessage(sockaddr_un& address, const HotRestartMessage& proto,
                                       bool allow_failure) {
+  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, 0) != -1,
+                 fmt::format("Set domain socket blocking failed, errno = {}", errno));
+  if (!sendHotRestartMessageBlocking(address, proto, allow_failure)) {
+    return false;
+  }
+  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, O_NONBLOCK) != -1,
+                 fmt::format("Set domain socket nonblocking failed, errno = {}", errno));
+  return true;
+}
+
+void RpcStream::sendHotRestartMessages(sockaddr_un& address,
+                                       const std::vector<HotRestartMessage>& protos) {
+  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, 0) != -1,
+                 fmt::format("Set domain socket blocking failed, errno = {}", errno));
+  for (const HotRestartMessage& proto : protos) {
+    sendHotRestartMessageBlocking(address, proto, false);
+  }
+  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, O_NONBLOCK) != -1,
+                 fmt::format("Set domain socket nonblocking failed, errno = {}", errno));
+}
+
+bool RpcStream::sendHotRestartMessageBlocking(sockaddr_un& address, const HotRestartMessage& proto,
+                                              bool allow_failure) {
   Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
   const uint64_t serialized_size = proto.ByteSizeLong();
   const uint64_t total_size = sizeof(uint64_t) + serialized_size;
@@ -81,9 +104,6 @@ bool RpcStream::sendHotRestartMessage(sockaddr_un& address, const HotRestartMess
   RELEASE_ASSERT(proto.SerializeWithCachedSizesToArray(send_buf.data() + sizeof(uint64_t)),
                  "failed to serialize a HotRestartMessage");
 
-  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, 0) != -1,
-                 fmt::format("Set domain socket blocking failed, errno = {}", errno));
-
   uint8_t* next_byte_to_send = send_buf.data();
   uint64_t sent = 0;
   while (sent < total_size) {
@@ -147,9 +167,6 @@ bool RpcStream::sendHotRestartMessage(sockaddr_un& address, const HotRestartMess
                                         saved_errno));
     }
   }
-
-  RELEASE_ASSERT(fcntl(domain_socket_, F_SETFL, O_NONBLOCK) != -1,
-                 fmt::format("Set domain socket nonblocking failed, errno = {}", errno));
   return true;
 }
 
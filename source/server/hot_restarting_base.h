@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "envoy/common/platform.h"
 #include "envoy/server/hot_restart.h"
@@ -48,6 +49,10 @@ public:
   // all exchanges, and blocks until a reply is received, so there is implicit pairing.
   bool sendHotRestartMessage(sockaddr_un& address, const envoy::HotRestartMessage& proto,
                              bool allow_failure = false);
+  // Sends several messages as sendHotRestartMessage() does, with the domain socket made blocking
+  // only once for all of them.
+  void sendHotRestartMessages(sockaddr_un& address,
+                              const std::vector<envoy::HotRestartMessage>& protos);
 
   // Receive data, possibly enough to build one of our protocol messages.
   // If block is true, blocks until a full protocol message is available.
@@ -61,6 +66,9 @@ public:
   int domain_socket_{-1};
 
 private:
+  // Sends a message on the domain socket, which must be blocking.
+  bool sendHotRestartMessageBlocking(sockaddr_un& address, const envoy::HotRestartMessage& proto,
+                                     bool allow_failure);
   void getPassedFdIfPresent(envoy::HotRestartMessage* out, msghdr* message);
   std::unique_ptr<envoy::HotRestartMessage> parseProtoAndResetState();
   void initRecvBufIfNewMessage();
@@ -28,9 +28,25 @@ HotRestartingParent::HotRestartingParent(int base_id, int restart_epoch,
 
 void HotRestartingParent::sendHotRestartMessage(envoy::HotRestartMessage&& msg) {
   ASSERT(dispatcher_.has_value());
-  dispatcher_->post([this, msg = std::move(msg)]() {
-    udp_forwarding_rpc_stream_.sendHotRestartMessage(child_address_udp_forwarding_, std::move(msg));
-  });
+  bool first_pending;
+  {
+    Thread::LockGuard lock(udp_forwarding_mutex_);
+    first_pending = pending_udp_forwarding_messages_.empty();
+    pending_udp_forwarding_messages_.push_back(std::move(msg));
+  }
+  // The messages queued until the main thread runs are sent along with this one.
+  if (first_pending) {
+    dispatcher_->post([this]() { sendPendingUdpForwardingMessages(); });
+  }
+}
+
+void HotRestartingParent::sendPendingUdpForwardingMessages() {
+  std::vector<envoy::HotRestartMessage> messages;
+  {
+    Thread::LockGuard lock(udp_forwarding_mutex_);
+    messages.swap(pending_udp_forwarding_messages_);
+  }
+  udp_forwarding_rpc_stream_.sendHotRestartMessages(child_address_udp_forwarding_, messages);
 }
 
 // Network::NonDispatchedUdpPacketHandler
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <vector>
+
 #include "source/common/common/hash.h"
+#include "source/common/common/thread.h"
 #include "source/server/hot_restarting_base.h"
 
 namespace Envoy {
@@ -51,6 +54,7 @@ public:
 
 private:
   void onSocketEvent();
+  void sendPendingUdpForwardingMessages();
 
   const int restart_epoch_;
   sockaddr_un child_address_;
@@ -58,6 +62,11 @@ private:
   Event::FileEventPtr socket_event_;
   OptRef<Event::Dispatcher> dispatcher_;
   std::unique_ptr<Internal> internal_;
+  // The forwarded UDP packets of the workers, sent to the child in batches by the main thread so
+  // that a burst of packets is neither posted nor sent one at a time.
+  Thread::MutexBasicLockable udp_forwarding_mutex_;
+  std::vector<envoy::HotRestartMessage>
+      pending_udp_forwarding_messages_ ABSL_GUARDED_BY(udp_forwarding_mutex_);
 };
 
 } // namespace Server
@@ -0,0 +1,94 @@
+#include "source/server/numa_topology.h"
+
+#include <algorithm>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+
+namespace Envoy {
+namespace Server {
+
+namespace {
+
+constexpr absl::string_view SysfsNodePath = "/sys/devices/system/node";
+
+} // namespace
+
+std::vector<NumaTopology::Node>
+NumaTopology::discover(Filesystem::Instance& file_system,
+                       const std::vector<uint32_t>& allowed_cpus) {
+  std::vector<Node> nodes;
+  const absl::StatusOr<std::string> online =
+      file_system.fileReadToEnd(absl::StrCat(SysfsNodePath, "/online"));
+  if (!online.ok()) {
+    return nodes;
+  }
+  const absl::StatusOr<std::vector<uint32_t>> node_ids = parseList(online.value());
+  if (!node_ids.ok()) {
+    return nodes;
+  }
+  const absl::flat_hash_set<uint32_t> allowed(allowed_cpus.begin(), allowed_cpus.end());
+  for (const uint32_t id : node_ids.value()) {
+    const absl::StatusOr<std::string> cpu_list =
+        file_system.fileReadToEnd(absl::StrCat(SysfsNodePath, "/node", id, "/cpulist"));
+    if (!cpu_list.ok()) {
+      continue;
+    }
+    absl::StatusOr<std::vector<uint32_t>> cpus = parseList(cpu_list.value());
+    if (!cpus.ok()) {
+      continue;
+    }
+    Node node{id, {}};
+    for (const uint32_t cpu : cpus.value()) {
+      if (allowed.contains(cpu)) {
+        node.cpus_.push_back(cpu);
+      }
+    }
+    if (!node.cpus_.empty()) {
+      std::sort(node.cpus_.begin(), node.cpus_.end());
+      nodes.push_back(std::move(node));
+    }
+  }
+  std::sort(nodes.begin(), nodes.end(), [](const Node& a, const Node& b) { return a.id_ < b.id_; });
+  return nodes;
+}
+
+const NumaTopology::Node* NumaTopology::nodeForWorker(const std::vector<Node>& nodes,
+                                                      uint32_t worker_index) {
+  if (nodes.empty()) {
+    return nullptr;
+  }
+  return &nodes[worker_index % nodes.size()];
+}
+
+absl::StatusOr<std::vector<uint32_t>> NumaTopology::parseList(absl::string_view list) {
+  std::vector<uint32_t> ids;
+  list = absl::StripAsciiWhitespace(list);
+  if (list.empty()) {
+    return ids;
+  }
+  for (const absl::string_view range : absl::StrSplit(list, ',')) {
+    const std::pair<absl::string_view, absl::string_view> bounds =
+        absl::StrSplit(range, absl::MaxSplits('-', 1));
+    uint32_t first;
+    uint32_t last;
+    if (!absl::SimpleAtoi(bounds.first, &first)) {
+      return absl::InvalidArgumentError(absl::StrCat("invalid list: ", list));
+    }
+    if (bounds.second.empty()) {
+      last = first;
+    } else if (!absl::SimpleAtoi(bounds.second, &last) || last < first) {
+      return absl::InvalidArgumentError(absl::StrCat("invalid list: ", list));
+    }
+    for (uint32_t id = first; id <= last; ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+} // namespace Server
+} // namespace Envoy
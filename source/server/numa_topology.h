@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/filesystem/filesystem.h"
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Server {
+
+/**
+ * The NUMA nodes of the host, as described by sysfs, used to place each worker thread and the
+ * memory it allocates on the same node. Only meaningful on Linux.
+ */
+class NumaTopology {
+public:
+  struct Node {
+    uint32_t id_;
+    // The CPUs of the node the process may run on, in increasing order.
+    std::vector<uint32_t> cpus_;
+  };
+
+  /**
+   * @return the nodes with at least one of the allowed CPUs, in increasing id order, or an empty
+   * vector if the topology is unknown.
+   * @param file_system the file system to read sysfs from.
+   * @param allowed_cpus the CPUs the process may run on.
+   */
+  static std::vector<Node> discover(Filesystem::Instance& file_system,
+                                    const std::vector<uint32_t>& allowed_cpus);
+
+  /**
+   * @return the node to run the worker with the given index on: workers are spread round robin
+   * over the nodes, so that they are balanced whatever the concurrency. nullptr if there are no
+   * nodes.
+   */
+  static const Node* nodeForWorker(const std::vector<Node>& nodes, uint32_t worker_index);
+
+  /**
+   * Parses a sysfs list of CPUs or nodes, e.g. "0-3,8,10-11".
+   * @return the listed ids, in the order of the list.
+   */
+  static absl::StatusOr<std::vector<uint32_t>> parseList(absl::string_view list);
+};
+
+} // namespace Server
+} // namespace Envoy
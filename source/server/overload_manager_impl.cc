@@ -605,6 +605,10 @@ void OverloadManagerImpl::start() {
 
   time_resources_last_measured_ = time_source_.monotonicTime();
   timer_->enableTimer(refresh_interval_);
+
+  for (auto& resource : resources_) {
+    resource.second.enableRefresh();
+  }
 }
 
 void OverloadManagerImpl::stop() {
@@ -666,6 +670,27 @@ Event::ScaledRangeTimerManagerPtr OverloadManagerImpl::createScaledRangeTimerMan
 
 void OverloadManagerImpl::updateResourcePressure(const std::string& resource, double pressure,
                                                  FlushEpochId flush_epoch) {
+  applyResourcePressure(resource, pressure);
+
+  // Eagerly flush updates if this is the last call to updateResourcePressure expected for the
+  // current epoch. This assert is always valid because flush_awaiting_updates_ is initialized
+  // before each batch of updates, and even if a resource monitor performs a double update, or a
+  // previous update callback is late, the logic in OverloadManager::Resource::update() will prevent
+  // unexpected calls to this function.
+  ASSERT(flush_awaiting_updates_ > 0);
+  --flush_awaiting_updates_;
+  if (flush_epoch == flush_epoch_ && flush_awaiting_updates_ == 0) {
+    flushResourceUpdates();
+  }
+}
+
+void OverloadManagerImpl::refreshResourcePressure(const std::string& resource, double pressure) {
+  applyResourcePressure(resource, pressure);
+  // This also flushes the updates of the current epoch received so far, which are as recent.
+  flushResourceUpdates();
+}
+
+void OverloadManagerImpl::applyResourcePressure(const std::string& resource, double pressure) {
   auto [start, end] = resource_to_actions_.equal_range(resource);
 
   std::for_each(start, end, [&](ResourceToActionMap::value_type& entry) {
@@ -699,17 +724,6 @@ void OverloadManagerImpl::updateResourcePressure(const std::string& resource, do
   for (auto& loadshed_point : loadshed_points_) {
     loadshed_point.second->updateResource(resource, pressure);
   }
-
-  // Eagerly flush updates if this is the last call to updateResourcePressure expected for the
-  // current epoch. This assert is always valid because flush_awaiting_updates_ is initialized
-  // before each batch of updates, and even if a resource monitor performs a double update, or a
-  // previous update callback is late, the logic in OverloadManager::Resource::update() will prevent
-  // unexpected calls to this function.
-  ASSERT(flush_awaiting_updates_ > 0);
-  --flush_awaiting_updates_;
-  if (flush_epoch == flush_epoch_ && flush_awaiting_updates_ == 0) {
-    flushResourceUpdates();
-  }
 }
 
 void OverloadManagerImpl::flushResourceUpdates() {
@@ -751,14 +765,34 @@ void OverloadManagerImpl::Resource::update(FlushEpochId flush_epoch) {
   skipped_updates_counter_.inc();
 }
 
+void OverloadManagerImpl::Resource::enableRefresh() {
+  monitor_->setRefreshCallback([this]() { refresh(); });
+}
+
+void OverloadManagerImpl::Resource::refresh() {
+  if (pending_update_) {
+    // The pending update reports the current pressure soon enough.
+    return;
+  }
+  pending_update_ = true;
+  refreshing_ = true;
+  monitor_->updateResourceUsage(*this);
+}
+
 void OverloadManagerImpl::Resource::onSuccess(const ResourceUsage& usage) {
   pending_update_ = false;
-  manager_.updateResourcePressure(name_, usage.resource_pressure_, flush_epoch_);
+  if (refreshing_) {
+    refreshing_ = false;
+    manager_.refreshResourcePressure(name_, usage.resource_pressure_);
+  } else {
+    manager_.updateResourcePressure(name_, usage.resource_pressure_, flush_epoch_);
+  }
   pressure_gauge_.set(usage.resource_pressure_ * 100); // convert to percent
 }
 
 void OverloadManagerImpl::Resource::onFailure(const EnvoyException& error) {
   pending_update_ = false;
+  refreshing_ = false;
   ENVOY_LOG(info, "Failed to update resource {}: {}", name_, error.what());
   failed_updates_counter_.inc();
 }
@@ -192,12 +192,18 @@ private:
     void onFailure(const EnvoyException& error) override;
 
     void update(FlushEpochId flush_epoch);
+    // Lets the monitor request updates between two refresh intervals.
+    void enableRefresh();
 
   private:
+    void refresh();
+
     const std::string name_;
     ResourceMonitorPtr monitor_;
     OverloadManagerImpl& manager_;
     bool pending_update_{false};
+    // Whether the pending update was requested by the monitor rather than by the refresh loop.
+    bool refreshing_{false};
     FlushEpochId flush_epoch_;
     Stats::Gauge& pressure_gauge_;
     Stats::Counter& failed_updates_counter_;
@@ -213,6 +219,10 @@ private:
 
   void updateResourcePressure(const std::string& resource, double pressure,
                               FlushEpochId flush_epoch);
+  // Applies a pressure update requested by a monitor, outside of any flush epoch, and flushes it
+  // right away.
+  void refreshResourcePressure(const std::string& resource, double pressure);
+  void applyResourcePressure(const std::string& resource, double pressure);
   // Flushes any enqueued action state updates to all worker threads.
   void flushResourceUpdates();
 
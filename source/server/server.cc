@@ -26,6 +26,7 @@
 
 #include "source/common/api/api_impl.h"
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/mutex_tracer_impl.h"
 #include "source/common/common/notification.h"
@@ -45,6 +46,7 @@
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/runtime/runtime_keys.h"
 #include "source/common/signal/fatal_error_handler.h"
+#include "source/common/stats/counter_shards.h"
 #include "source/common/stats/stats_matcher_impl.h"
 #include "source/common/stats/tag_producer_impl.h"
 #include "source/common/stats/thread_local_store.h"
@@ -170,43 +172,66 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
+                                       TimeSource& time_source, bool delta)
+    : delta_(delta) {
+  // Delta snapshots don't reserve for all metrics, as usually only a small fraction has changed.
   store.forEachSinkedCounter(
       [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
+        if (!delta_) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        }
       },
       [this](Stats::Counter& counter) {
+        const uint64_t latched = counter.latch();
+        if (delta_ && latched == 0) {
+          return;
+        }
         snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
+        counters_.push_back({latched, counter});
       });
 
   store.forEachSinkedGauge(
       [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
+        if (!delta_) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        }
       },
       [this](Stats::Gauge& gauge) {
+        if (delta_ && !gauge.latchChanged()) {
+          return;
+        }
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
       });
 
   store.forEachSinkedHistogram(
       [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+        if (!delta_) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
       [this](Stats::ParentHistogram& histogram) {
+        if (delta_ && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
 
   store.forEachSinkedTextReadout(
       [this](std::size_t size) {
-        snapped_text_readouts_.reserve(size);
-        text_readouts_.reserve(size);
+        if (!delta_) {
+          snapped_text_readouts_.reserve(size);
+          text_readouts_.reserve(size);
+        }
       },
       [this](Stats::TextReadout& text_readout) {
+        if (delta_ && !text_readout.latchChanged()) {
+          return;
+        }
         snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
         text_readouts_.push_back(text_readout);
       });
@@ -214,6 +239,9 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
       [this](Stats::PrimitiveCounterSnapshot&& metric) {
+        if (delta_ && metric.delta() == 0) {
+          return;
+        }
         host_counters_.emplace_back(std::move(metric));
       },
       [this](Stats::PrimitiveGaugeSnapshot&& metric) {
@@ -229,7 +257,16 @@ void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, S
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  //
+  // The snapshot only contains changed metrics if no sink asks for all of them. Every sink is
+  // asked, as sinks may count flushes to decide when they need the full state.
+  bool delta = true;
+  for (const auto& sink : sinks) {
+    if (sink->needsFullSnapshot()) {
+      delta = false;
+    }
+  }
+  MetricSnapshotImpl snapshot(store, cm, time_source, delta);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -722,6 +759,12 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   }
 
   // Workers get created first so they register for thread local updates.
+  worker_factory_.setPinWorkerThreads(bootstrap_.pin_worker_threads());
+  worker_factory_.setPinWorkerThreadsToNumaNodes(bootstrap_.pin_worker_threads_to_numa_nodes());
+  if (bootstrap_.has_worker_busy_poll_duration()) {
+    worker_factory_.setBusyPollDuration(std::chrono::microseconds(
+        Protobuf::util::TimeUtil::DurationToMicroseconds(bootstrap_.worker_busy_poll_duration())));
+  }
   listener_manager_ = listener_manager_factory->createListenerManager(
       *this, nullptr, worker_factory_, bootstrap_.enable_dispatcher_stats(), quic_stat_names_);
 
@@ -760,6 +803,18 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   InstanceUtil::raiseFileLimits();
 #endif
 
+  // The slice storage free list is configured before workers are started so every thread observes
+  // the same setting for the lifetime of the process.
+  if (Runtime::runtimeFeatureEnabled("envoy.restart_features.buffer_slice_free_list")) {
+    Buffer::SliceStorageFreeList::setMaxEntries(Buffer::SliceStorageFreeList::DefaultMaxEntries);
+  }
+
+  // Counters created from here on, which include the cluster, listener and connection manager
+  // counters incremented by the workers, are sharded per thread.
+  if (Runtime::runtimeFeatureEnabled("envoy.restart_features.sharded_counters")) {
+    Stats::CounterShards::setEnabled(true);
+  }
+
   if (!runtime().snapshot().getBoolean("envoy.disallow_global_stats", false)) {
     assert_action_registration_ = Assert::addDebugAssertionFailureRecordAction(
         [this](const char*) { server_stats_->debug_assertion_failures_.inc(); });
@@ -471,9 +471,9 @@ private:
 class MetricSnapshotImpl : public Stats::MetricSnapshot {
 public:
   // MetricSnapshotImpl captures a snapshot of metrics by latching the delta usage, and optionally
-  // marking the stats as used.
+  // marking the stats as used. Counters are latched even if they are left out of a delta snapshot.
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source, bool delta = false);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -491,6 +491,7 @@ public:
   }
   const std::vector<Stats::PrimitiveGaugeSnapshot>& hostGauges() override { return host_gauges_; }
   SystemTime snapshotTime() const override { return snapshot_time_; }
+  bool isDelta() const override { return delta_; }
 
 private:
   std::vector<Stats::CounterSharedPtr> snapped_counters_;
@@ -504,6 +505,7 @@ private:
   std::vector<Stats::PrimitiveCounterSnapshot> host_counters_;
   std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges_;
   SystemTime snapshot_time_;
+  const bool delta_;
 };
 
 } // namespace Server
@@ -10,8 +10,19 @@
 #include "envoy/thread_local/thread_local.h"
 
 #include "source/common/config/utility.h"
+#include "source/common/network/reuse_port_cpu_steering.h"
 #include "source/server/listener_manager_factory.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Server {
 namespace {
@@ -37,18 +48,44 @@ WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overl
                                           const std::string& worker_name) {
   Event::DispatcherPtr dispatcher(
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
+  if (busy_poll_duration_ > std::chrono::microseconds::zero()) {
+    // Root the stats with the other dispatcher stats of the worker in the listener manager scope.
+    dispatcher->enableBusyPoll(busy_poll_duration_, api_.rootScope(),
+                               absl::StrCat("listener_manager.", worker_name, "."));
+  }
   auto conn_handler = getHandler(*dispatcher, index, overload_manager, null_overload_manager);
+  WorkerPlacement placement;
+  if (pin_worker_threads_to_numa_nodes_) {
+    if (!numa_nodes_.has_value()) {
+      numa_nodes_ = NumaTopology::discover(api_.fileSystem(),
+                                           Network::ReusePortCpuSteering::allowedCpus());
+      if (numa_nodes_->empty()) {
+        ENVOY_LOG(warn, "unable to discover the NUMA nodes, worker threads are not pinned");
+      }
+    }
+    const NumaTopology::Node* node = NumaTopology::nodeForWorker(*numa_nodes_, index);
+    if (node != nullptr) {
+      placement.cpus_ = node->cpus_;
+      placement.numa_node_ = node->id_;
+    }
+  } else if (pin_worker_threads_) {
+    const absl::optional<uint32_t> cpu = Network::ReusePortCpuSteering::cpuForWorker(index);
+    if (cpu.has_value()) {
+      placement.cpus_.push_back(cpu.value());
+    }
+  }
   return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+                                      overload_manager, api_, stat_names_, std::move(placement));
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, WorkerPlacement placement)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      placement_(std::move(placement)) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -142,7 +179,46 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener,
   });
 }
 
+void WorkerImpl::placeThread() {
+#ifdef __linux__
+  if (!placement_.cpus_.empty()) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (const uint32_t cpu : placement_.cpus_) {
+      CPU_SET(cpu, &mask);
+    }
+    const Api::SysCallIntResult result =
+        Api::LinuxOsSysCallsSingleton::get().sched_setaffinity(0, sizeof(cpu_set_t), &mask);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(warn, "unable to pin worker thread to CPUs {}: errno={}",
+                absl::StrJoin(placement_.cpus_, ","), result.errno_);
+    } else {
+      ENVOY_LOG(debug, "worker thread pinned to CPUs {}", absl::StrJoin(placement_.cpus_, ","));
+    }
+  }
+  if (placement_.numa_node_.has_value()) {
+    // The pages the thread faults in from now on, e.g. those of the connections and buffers it
+    // allocates, come from its node while the node has free memory. The policy only applies to
+    // this thread.
+    const uint32_t node = placement_.numa_node_.value();
+    constexpr size_t BitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> node_mask(node / BitsPerWord + 1, 0);
+    node_mask[node / BitsPerWord] = 1UL << (node % BitsPerWord);
+    // The kernel only reads the first maxnode - 1 bits of the mask, as libnuma expects.
+    const Api::SysCallIntResult result = Api::LinuxOsSysCallsSingleton::get().set_mempolicy(
+        MPOL_PREFERRED, node_mask.data(), node_mask.size() * BitsPerWord + 1);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(warn, "unable to prefer the memory of NUMA node {}: errno={}", node,
+                result.errno_);
+    } else {
+      ENVOY_LOG(debug, "worker thread prefers the memory of NUMA node {}", node);
+    }
+  }
+#endif
+}
+
 void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) {
+  placeThread();
   ENVOY_LOG(debug, "worker entering dispatch loop");
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
   // as this is when TLS stat scopes start working.
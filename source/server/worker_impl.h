@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/api/api.h"
 #include "envoy/network/connection_handler.h"
@@ -12,6 +13,9 @@
 
 #include "source/common/common/logger.h"
 #include "source/server/listener_hooks.h"
+#include "source/server/numa_topology.h"
+
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Server {
@@ -26,6 +30,16 @@ struct WorkerStatNames {
   Stats::StatName reset_high_memory_stream_;
 };
 
+/**
+ * Where a worker thread runs and allocates memory.
+ */
+struct WorkerPlacement {
+  // The CPUs the worker thread is pinned to, if not empty.
+  std::vector<uint32_t> cpus_;
+  // The NUMA node the worker thread preferably allocates memory from, if any.
+  absl::optional<uint32_t> numa_node_;
+};
+
 class ProdWorkerFactory : public WorkerFactory, Logger::Loggable<Logger::Id::main> {
 public:
   ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
@@ -36,11 +50,30 @@ public:
                          OverloadManager& null_overload_manager,
                          const std::string& worker_name) override;
 
+  // Pin the threads of workers created from now on to CPUs.
+  void setPinWorkerThreads(bool pin_worker_threads) { pin_worker_threads_ = pin_worker_threads; }
+
+  // Pin the threads of workers created from now on to the CPUs of a NUMA node, and make them
+  // prefer the memory of that node. Takes precedence over setPinWorkerThreads().
+  void setPinWorkerThreadsToNumaNodes(bool pin_worker_threads_to_numa_nodes) {
+    pin_worker_threads_to_numa_nodes_ = pin_worker_threads_to_numa_nodes;
+  }
+
+  // Busy poll the dispatchers of workers created from now on, if the duration is not zero.
+  void setBusyPollDuration(std::chrono::microseconds busy_poll_duration) {
+    busy_poll_duration_ = busy_poll_duration;
+  }
+
 private:
   ThreadLocal::Instance& tls_;
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  bool pin_worker_threads_{false};
+  bool pin_worker_threads_to_numa_nodes_{false};
+  // The NUMA nodes of the host, discovered when the first worker is created.
+  absl::optional<std::vector<NumaTopology::Node>> numa_nodes_;
+  std::chrono::microseconds busy_poll_duration_{0};
 };
 
 /**
@@ -50,7 +83,8 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names,
+             WorkerPlacement placement = {});
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -71,6 +105,7 @@ public:
 
 private:
   void threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb);
+  void placeThread();
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
@@ -83,6 +118,7 @@ private:
   Stats::Counter& reset_streams_counter_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
+  const WorkerPlacement placement_;
 };
 
 } // namespace Server
@@ -1,5 +1,7 @@
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -12,6 +14,9 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -171,8 +176,8 @@ TEST_F(AccessLogManagerImplTest, FlushToLogFileOnDemand) {
   EXPECT_EQ(0UL, store_.counter("filesystem.flushed_by_timer").value());
 
   // The first write to a given file will start the flush thread. Because AccessManagerImpl::write
-  // holds the write_lock_ when the thread is started, the thread will flush on its first loop, once
-  // it obtains the write_lock_. Perform a write to get all that out of the way.
+  // starts the thread once the data is buffered, the thread will flush on its first loop. Perform
+  // a write to get all that out of the way.
   EXPECT_CALL(*file_, write_(_))
       .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
         return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
@@ -445,6 +450,55 @@ TEST_F(AccessLogManagerImplTest, BigDataChunkShouldBeFlushedWithoutTimer) {
   EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST_F(AccessLogManagerImplTest, ConcurrentWritesKeepTheLinesOfEachThreadInOrder) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      access_log_manager_
+          .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+
+  Thread::MutexBasicLockable written_lock;
+  std::string written;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        Thread::LockGuard lock(written_lock);
+        written.append(data.data(), data.size());
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  constexpr int num_threads = 4;
+  constexpr int num_lines = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.push_back(thread_factory_.createThread([&log_file, t]() {
+      for (int i = 0; i < num_lines; i++) {
+        log_file->write(absl::StrCat(t, ":", i, "\n"));
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  Thread::LockGuard lock(written_lock);
+  std::vector<int> next_line(num_threads, 0);
+  int lines = 0;
+  for (absl::string_view line : absl::StrSplit(written, '\n', absl::SkipEmpty())) {
+    const std::pair<absl::string_view, absl::string_view> parts = absl::StrSplit(line, ':');
+    int t;
+    int i;
+    ASSERT_TRUE(absl::SimpleAtoi(parts.first, &t));
+    ASSERT_TRUE(absl::SimpleAtoi(parts.second, &i));
+    EXPECT_EQ(next_line[t]++, i);
+    lines++;
+  }
+  EXPECT_EQ(num_threads * num_lines, lines);
+  EXPECT_EQ(num_threads * num_lines, store_.counter("filesystem.write_buffered").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
   EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
 
@@ -680,6 +680,42 @@ TEST(WatermarkBufferFactoryTest,
   }
 }
 
+// Tests that when only part of the streams of a bucket can be reset, the
+// largest ones are reset first.
+TEST(WatermarkBufferFactoryTest, ShouldResetTheLargestStreamsOfABucketFirst) {
+  TrackedWatermarkBufferFactory factory(absl::bit_width(kMinimumBalanceToTrack));
+
+  std::vector<AccountWithResetHandlerPtr> smaller_accounts;
+  std::vector<AccountWithResetHandlerPtr> larger_accounts;
+  for (int i = 0; i < kMaxStreamsResetPerCall; ++i) {
+    smaller_accounts.push_back(std::make_unique<AccountWithResetHandler>(factory));
+    smaller_accounts.back()->account_->charge(kThresholdForFinalBucket);
+    larger_accounts.push_back(std::make_unique<AccountWithResetHandler>(factory));
+    larger_accounts.back()->account_->charge(4 * kThresholdForFinalBucket);
+    larger_accounts.back()->expectResetStream();
+  }
+
+  // All the accounts are in the final bucket.
+  factory.inspectMemoryClasses([](MemoryClassesToAccountsSet& memory_classes_to_account) {
+    ASSERT_EQ(memory_classes_to_account[BufferMemoryAccountImpl::NUM_MEMORY_CLASSES_ - 1].size(),
+              2 * kMaxStreamsResetPerCall);
+  });
+
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), kMaxStreamsResetPerCall);
+  for (int i = 0; i < kMaxStreamsResetPerCall; ++i) {
+    EXPECT_TRUE(larger_accounts[i]->reset_handler_invoked_);
+    EXPECT_FALSE(smaller_accounts[i]->reset_handler_invoked_);
+  }
+
+  for (int i = 0; i < kMaxStreamsResetPerCall; ++i) {
+    smaller_accounts[i]->expectResetStream();
+  }
+  EXPECT_EQ(factory.resetAccountsGivenPressure(1.0), kMaxStreamsResetPerCall);
+  for (int i = 0; i < kMaxStreamsResetPerCall; ++i) {
+    EXPECT_TRUE(smaller_accounts[i]->reset_handler_invoked_);
+  }
+}
+
 } // namespace
 } // namespace Buffer
 } // namespace Envoy
@@ -109,6 +109,88 @@ BENCHMARK(bufferAccountUse)
     ->Args({16 * 1024, 1024, 0})
     ->Args({16 * 1024, 1024, 1});
 
+// Allocate and free default sized slices, as happens when a buffer grows and is fully drained.
+// The range arguments are: number of buffers that are alive at the same time, whether buffers
+// are bound to an account, and whether the thread local slice storage free list is enabled.
+static void bufferSliceAllocFreeChurn(benchmark::State& state) {
+  const uint64_t live_buffers = state.range(0);
+  const bool enable_accounts = (state.range(1) != 0);
+  const bool enable_free_list = (state.range(2) != 0);
+  const std::string data(Buffer::Slice::default_slice_size_, 'a');
+
+  auto config = envoy::config::overload::v3::BufferFactoryConfig();
+  config.set_minimum_account_to_track_power_of_two(2);
+  Buffer::WatermarkBufferFactory buffer_factory(config);
+  FakeStreamResetHandler reset_handler;
+  auto account = buffer_factory.createAccount(reset_handler);
+  RELEASE_ASSERT(account != nullptr, "");
+
+  Buffer::SliceStorageFreeList::setMaxEntries(
+      enable_free_list ? Buffer::SliceStorageFreeList::DefaultMaxEntries : 0);
+  std::vector<std::unique_ptr<Buffer::OwnedImpl>> buffers(live_buffers);
+  for (auto& buffer : buffers) {
+    buffer = std::make_unique<Buffer::OwnedImpl>();
+    if (enable_accounts) {
+      buffer->bindAccount(account);
+    }
+  }
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (auto& buffer : buffers) {
+      buffer->add(data);
+    }
+    for (auto& buffer : buffers) {
+      buffer->drain(buffer->length());
+    }
+  }
+  buffers.clear();
+  account->clearDownstream();
+  Buffer::SliceStorageFreeList::setMaxEntries(0);
+  Buffer::SliceStorageFreeList::clearForTest();
+}
+BENCHMARK(bufferSliceAllocFreeChurn)
+    ->Args({1, 0, 0})
+    ->Args({1, 0, 1})
+    ->Args({1, 1, 0})
+    ->Args({1, 1, 1})
+    ->Args({32, 0, 0})
+    ->Args({32, 0, 1})
+    ->Args({32, 1, 0})
+    ->Args({32, 1, 1})
+    ->Args({256, 0, 0})
+    ->Args({256, 0, 1});
+
+// Read into a buffer through a reservation and hand the data to another buffer, which is drained
+// afterwards, mimicking the read/write path of a proxied connection. The range arguments are: the
+// number of bytes committed per read, and whether the slice storage free list is enabled.
+static void bufferReadWriteChurn(benchmark::State& state) {
+  const uint64_t read_size = state.range(0);
+  const bool enable_free_list = (state.range(1) != 0);
+
+  Buffer::SliceStorageFreeList::setMaxEntries(
+      enable_free_list ? Buffer::SliceStorageFreeList::DefaultMaxEntries : 0);
+  Buffer::OwnedImpl read_buffer;
+  Buffer::OwnedImpl write_buffer;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    {
+      auto reservation = read_buffer.reserveForRead();
+      reservation.commit(std::min<uint64_t>(read_size, reservation.length()));
+    }
+    write_buffer.move(read_buffer);
+    write_buffer.drain(write_buffer.length());
+  }
+  Buffer::SliceStorageFreeList::setMaxEntries(0);
+  Buffer::SliceStorageFreeList::clearForTest();
+}
+BENCHMARK(bufferReadWriteChurn)
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Args({16384, 0})
+    ->Args({16384, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
 // Test the creation of an OwnedImpl with varying amounts of content.
 static void bufferCreate(benchmark::State& state) {
   const std::string data(state.range(0), 'a');
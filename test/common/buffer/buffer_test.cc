@@ -291,6 +291,113 @@ TEST_F(OwnedSliceTest, Drain) {
   EXPECT_EQ(original_size, slice.reservableSize());
 }
 
+class SliceStorageFreeListTest : public testing::Test {
+protected:
+  SliceStorageFreeListTest() {
+    SliceStorageFreeList::clearForTest();
+    SliceStorageFreeList::setMaxEntries(2);
+  }
+  ~SliceStorageFreeListTest() override {
+    SliceStorageFreeList::setMaxEntries(0);
+    SliceStorageFreeList::clearForTest();
+  }
+};
+
+// Default sized slice storage is recycled through the free list of the current thread.
+TEST_F(SliceStorageFreeListTest, RecyclesDefaultSizedStorage) {
+  const uint8_t* first_storage;
+  {
+    Slice slice{Slice::default_slice_size_, nullptr};
+    first_storage = slice.data();
+    EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+  }
+  EXPECT_EQ(1, SliceStorageFreeList::sizeForTest());
+
+  Slice slice{Slice::default_slice_size_, nullptr};
+  EXPECT_EQ(first_storage, slice.data());
+  EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+}
+
+// Storage of other sizes and unowned slices never enter the free list.
+TEST_F(SliceStorageFreeListTest, IgnoresOtherSizes) {
+  { Slice slice{4096, nullptr}; }
+  { Slice slice{Slice::default_slice_size_ + 1, nullptr}; }
+  {
+    constexpr char input[] = "hello world";
+    BufferFragmentImpl fragment(input, sizeof(input) - 1, nullptr);
+    Slice slice{fragment};
+  }
+  EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+}
+
+// The free list is bounded and excess storage is freed.
+TEST_F(SliceStorageFreeListTest, Bounded) {
+  {
+    Slice slice1{Slice::default_slice_size_, nullptr};
+    Slice slice2{Slice::default_slice_size_, nullptr};
+    Slice slice3{Slice::default_slice_size_, nullptr};
+  }
+  EXPECT_EQ(2, SliceStorageFreeList::sizeForTest());
+}
+
+// Move assignment releases the storage of the overwritten slice to the free list.
+TEST_F(SliceStorageFreeListTest, MoveAssignmentReleasesStorage) {
+  Slice slice1{Slice::default_slice_size_, nullptr};
+  Slice slice2{Slice::default_slice_size_, nullptr};
+  slice1 = std::move(slice2);
+  EXPECT_EQ(1, SliceStorageFreeList::sizeForTest());
+}
+
+// Recycled storage is still charged to and credited from the owning account.
+TEST_F(SliceStorageFreeListTest, AccountChargesPreserved) {
+  struct CountingAccount : public BufferMemoryAccount {
+    void charge(uint64_t amount) override { charged_ += amount; }
+    void credit(uint64_t amount) override { credited_ += amount; }
+    void clearDownstream() override {}
+    void resetDownstream() override {}
+
+    uint64_t charged_{};
+    uint64_t credited_{};
+  };
+  auto account = std::make_shared<CountingAccount>();
+  BufferMemoryAccountSharedPtr shared_account = account;
+  { Slice slice{Slice::default_slice_size_, shared_account}; }
+  {
+    Slice slice{Slice::default_slice_size_, shared_account};
+    EXPECT_EQ(2 * Slice::default_slice_size_, account->charged_);
+    EXPECT_EQ(Slice::default_slice_size_, account->credited_);
+  }
+  EXPECT_EQ(2 * Slice::default_slice_size_, account->credited_);
+  EXPECT_EQ(1, SliceStorageFreeList::sizeForTest());
+}
+
+// Disabling the free list stops caching released storage.
+TEST_F(SliceStorageFreeListTest, Disabled) {
+  SliceStorageFreeList::setMaxEntries(0);
+  { Slice slice{Slice::default_slice_size_, nullptr}; }
+  EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+}
+
+// Reservations backed by the free list return unused storage to it.
+TEST_F(SliceStorageFreeListTest, OwnedImplReservation) {
+  SliceStorageFreeList::setMaxEntries(Buffer::Reservation::MAX_SLICES_);
+  {
+    OwnedImpl buffer;
+    auto reservation = buffer.reserveForRead();
+    EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+  }
+  EXPECT_EQ(Buffer::Reservation::MAX_SLICES_, SliceStorageFreeList::sizeForTest());
+  {
+    OwnedImpl buffer;
+    auto reservation = buffer.reserveForRead();
+    EXPECT_EQ(0, SliceStorageFreeList::sizeForTest());
+    reservation.commit(Slice::default_slice_size_);
+    // The committed storage is now owned by the buffer, the rest was returned to the free list.
+    EXPECT_EQ(Buffer::Reservation::MAX_SLICES_ - 1, SliceStorageFreeList::sizeForTest());
+  }
+  EXPECT_EQ(Buffer::Reservation::MAX_SLICES_, SliceStorageFreeList::sizeForTest());
+}
+
 TEST(UnownedSliceTest, CreateDelete) {
   constexpr char input[] = "hello world";
   bool release_callback_called = false;
@@ -77,6 +77,27 @@ TEST_F(OwnedImplTest, AddBufferFragmentWithCleanup) {
   EXPECT_TRUE(release_callback_called_);
 }
 
+TEST_F(OwnedImplTest, MakeSlicesMutable) {
+  std::string input("hello world");
+  BufferFragmentImpl frag(
+      input.c_str(), input.size(),
+      [this](const void*, size_t, const BufferFragmentImpl*) { release_callback_called_ = true; });
+  Buffer::OwnedImpl buffer("abc");
+  buffer.addBufferFragment(frag);
+  EXPECT_EQ(2, buffer.getRawSlices().size());
+
+  // The fragment is copied into a slice of the buffer, and released.
+  buffer.makeSlicesMutable();
+  EXPECT_TRUE(release_callback_called_);
+  EXPECT_EQ("abchello world", buffer.toString());
+  RawSliceVector slices = buffer.getRawSlices();
+  ASSERT_EQ(2, slices.size());
+  EXPECT_NE(input.c_str(), slices[1].mem_);
+  static_cast<char*>(slices[1].mem_)[0] = 'H';
+  EXPECT_EQ("abcHello world", buffer.toString());
+  EXPECT_EQ("hello world", input);
+}
+
 TEST_F(OwnedImplTest, MoveBufferFragment) {
   Buffer::OwnedImpl buffer1;
   testing::MockFunction<void(const void*, size_t, const BufferFragmentImpl*)>
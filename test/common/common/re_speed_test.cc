@@ -1,13 +1,18 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from
 // a quiescent system with disabled cstate power management.
 
+#include <memory>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 // NOLINT(namespace-envoy)
 
@@ -126,3 +131,53 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+static std::vector<std::string> routeRePatterns(int64_t count) {
+  std::vector<std::string> patterns;
+  for (int64_t i = 0; i < count; ++i) {
+    patterns.push_back(absl::StrCat("/shelves/[^/]+/route_", i));
+  }
+  return patterns;
+}
+
+// Finds the first of `count` route regexes fully matching a path that only matches the last one,
+// evaluating them in turn.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_FullMatchEach(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& pattern : routeRePatterns(state.range(0))) {
+    regexes.push_back(std::make_unique<re2::RE2>(pattern));
+  }
+  const std::string path = absl::StrCat("/shelves/shelf/route_", state.range(0) - 1);
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const auto& regex : regexes) {
+      if (re2::RE2::FullMatch(path, *regex)) {
+        ++passes;
+        break;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_FullMatchEach)->RangeMultiplier(4)->Range(4, 1024);
+
+// The same lookup as BM_RE2_FullMatchEach with all the regexes in a single RE2::Set.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_Set(benchmark::State& state) {
+  re2::RE2::Set set(re2::RE2::DefaultOptions, re2::RE2::ANCHOR_BOTH);
+  for (const std::string& pattern : routeRePatterns(state.range(0))) {
+    RELEASE_ASSERT(set.Add(pattern, nullptr) >= 0, "");
+  }
+  RELEASE_ASSERT(set.Compile(), "");
+  const std::string path = absl::StrCat("/shelves/shelf/route_", state.range(0) - 1);
+  uint32_t passes = 0;
+  std::vector<int> matches;
+  for (auto _ : state) { // NOLINT
+    if (set.Match(path, &matches)) {
+      ++passes;
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_Set)->RangeMultiplier(4)->Range(4, 1024);
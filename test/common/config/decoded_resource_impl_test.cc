@@ -5,7 +5,9 @@
 
 #include "gtest/gtest.h"
 
+using ::testing::_;
 using ::testing::InvokeWithoutArgs;
+using ::testing::NiceMock;
 using ::testing::Return;
 
 namespace Envoy {
@@ -147,9 +149,44 @@ TEST(DecodedResourceImplTest, All) {
     EXPECT_EQ("foo", decoded_resource.version());
     EXPECT_THAT(decoded_resource.resource(), ProtoEq(Protobuf::Empty()));
     EXPECT_TRUE(decoded_resource.hasResource());
+    EXPECT_FALSE(decoded_resource.contentHash().has_value());
   }
 }
 
+// The content hash is computed from the serialized resource when it is decoded, with or without
+// the Resource wrapper, and carried to its other versions.
+TEST(DecodedResourceImplTest, ContentHash) {
+  NiceMock<MockOpaqueResourceDecoder> resource_decoder;
+  ON_CALL(resource_decoder, decodeResource(_))
+      .WillByDefault(InvokeWithoutArgs(
+          []() -> ProtobufTypes::MessagePtr { return std::make_unique<Protobuf::Empty>(); }));
+  Protobuf::Any some_opaque_resource;
+  some_opaque_resource.set_type_url("some_type_url");
+  some_opaque_resource.set_value("some_value");
+  const uint64_t hash = DecodedResourceImpl::contentHashOf(some_opaque_resource);
+
+  auto decoded_resource =
+      *DecodedResourceImpl::fromResource(resource_decoder, some_opaque_resource, "foo");
+  EXPECT_EQ(hash, decoded_resource->contentHash());
+  EXPECT_EQ(hash, decoded_resource->withVersion("bar")->contentHash());
+  EXPECT_EQ(1, decoded_resource->withVersion("bar", 1)->contentHash());
+
+  envoy::service::discovery::v3::Resource resource_wrapper;
+  resource_wrapper.set_name("real_name");
+  resource_wrapper.set_version("foo");
+  resource_wrapper.mutable_resource()->MergeFrom(some_opaque_resource);
+  EXPECT_EQ(hash, DecodedResourceImpl(resource_decoder, resource_wrapper).contentHash());
+
+  some_opaque_resource.set_value("other_value");
+  EXPECT_NE(hash,
+            (*DecodedResourceImpl::fromResource(resource_decoder, some_opaque_resource, "foo"))
+                ->contentHash());
+
+  // A removed resource has no content.
+  resource_wrapper.clear_resource();
+  EXPECT_FALSE(DecodedResourceImpl(resource_decoder, resource_wrapper).contentHash().has_value());
+}
+
 } // namespace
 } // namespace Config
 } // namespace Envoy
@@ -272,6 +272,35 @@ TEST_F(ConnPoolImplBaseTest, BasicPreconnect) {
   pool_.destructAllConnections();
 }
 
+TEST(AdaptivePreconnectEstimatorTest, AnticipatedStreams) {
+  AdaptivePreconnectEstimator estimator;
+  MonotonicTime now;
+  EXPECT_EQ(0, estimator.anticipatedStreams());
+
+  // Nothing is anticipated until a connect latency is known.
+  estimator.onStream(now);
+  now += std::chrono::milliseconds(10);
+  estimator.onStream(now);
+  EXPECT_EQ(0, estimator.anticipatedStreams());
+
+  // A stream every 10ms and a 50ms connect latency anticipate 5 streams.
+  estimator.onConnected(std::chrono::milliseconds(50));
+  EXPECT_DOUBLE_EQ(5, estimator.anticipatedStreams());
+
+  // A 110ms gap moves the average interval to 20ms.
+  now += std::chrono::milliseconds(110);
+  estimator.onStream(now);
+  EXPECT_DOUBLE_EQ(2.5, estimator.anticipatedStreams());
+
+  // A 150ms connect latency moves the average latency to 60ms.
+  estimator.onConnected(std::chrono::milliseconds(150));
+  EXPECT_DOUBLE_EQ(3, estimator.anticipatedStreams());
+
+  // Streams arriving at the same time are counted as one microsecond apart.
+  estimator.onStream(now);
+  EXPECT_DOUBLE_EQ(60000 / (20000 + 0.1 * (1 - 20000)), estimator.anticipatedStreams());
+}
+
 TEST_F(ConnPoolImplBaseTest, PreconnectOnDisconnect) {
   testing::InSequence s;
 
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <thread>
+
+#include "source/common/event/callback_profiler.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class CallbackProfilerTest : public testing::Test {
+public:
+  CallbackProfilerTest() {
+    // Sample the next callback of the thread whatever the previous sample period.
+    CallbackProfiler::setSamplePeriod(1);
+    runCallbacks(100);
+    CallbackProfiler::setSamplePeriod(0);
+    CallbackProfiler::reset();
+  }
+  ~CallbackProfilerTest() override {
+    CallbackProfiler::setSamplePeriod(0);
+    CallbackProfiler::reset();
+  }
+
+  static void runCallbacks(uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      CallbackProfiler::CallbackScope callback("test.callback");
+    }
+  }
+
+  static uint64_t samples(absl::string_view source) {
+    for (const auto& [name, stats] : CallbackProfiler::topSources(SIZE_MAX)) {
+      if (name == source) {
+        return stats.samples_;
+      }
+    }
+    return 0;
+  }
+};
+
+TEST_F(CallbackProfilerTest, DisabledByDefault) {
+  EXPECT_EQ(0, CallbackProfiler::samplePeriod());
+  {
+    CallbackProfiler::CallbackScope callback("test.callback");
+    CallbackProfiler::SourceScope source("test.source");
+  }
+  EXPECT_TRUE(CallbackProfiler::topSources(10).empty());
+}
+
+TEST_F(CallbackProfilerTest, SamplesOneInSamplePeriodCallbacks) {
+  CallbackProfiler::setSamplePeriod(10);
+  runCallbacks(1);
+  EXPECT_EQ(1, samples("test.callback"));
+  runCallbacks(100);
+  EXPECT_EQ(11, samples("test.callback"));
+
+  CallbackProfiler::setSamplePeriod(0);
+  runCallbacks(100);
+  EXPECT_EQ(11, samples("test.callback"));
+}
+
+TEST_F(CallbackProfilerTest, SourcesOutsideOfCallbacksAreNotTimed) {
+  CallbackProfiler::setSamplePeriod(1);
+  { CallbackProfiler::SourceScope source("test.source"); }
+  EXPECT_EQ(0, samples("test.source"));
+}
+
+// The time of nested scopes is only attributed to the innermost one.
+TEST_F(CallbackProfilerTest, AttributesTimeToInnermostSource) {
+  CallbackProfiler::setSamplePeriod(1);
+  {
+    CallbackProfiler::CallbackScope callback("test.callback");
+    {
+      CallbackProfiler::SourceScope outer("test.outer");
+      CallbackProfiler::SourceScope inner("test.inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    // Callbacks run by a sampled callback are always timed.
+    CallbackProfiler::CallbackScope nested("test.nested");
+  }
+
+  const auto sources = CallbackProfiler::topSources(10);
+  ASSERT_EQ(4, sources.size());
+  EXPECT_EQ("test.inner", sources[0].first);
+  EXPECT_EQ(1, sources[0].second.samples_);
+  EXPECT_GE(sources[0].second.total_, std::chrono::milliseconds(20));
+  EXPECT_EQ(sources[0].second.total_, sources[0].second.max_);
+  for (size_t i = 1; i < sources.size(); ++i) {
+    EXPECT_EQ(1, sources[i].second.samples_);
+    EXPECT_LT(sources[i].second.total_, sources[0].second.total_);
+  }
+  EXPECT_EQ(1, samples("test.outer"));
+  EXPECT_EQ(1, samples("test.nested"));
+}
+
+TEST_F(CallbackProfilerTest, TopSourcesLimitAndReset) {
+  CallbackProfiler::setSamplePeriod(1);
+  for (int i = 0; i < 3; ++i) {
+    CallbackProfiler::CallbackScope callback("test.callback");
+    CallbackProfiler::SourceScope source(i == 0 ? "test.first" : "test.second");
+  }
+  EXPECT_EQ(2, CallbackProfiler::topSources(2).size());
+  EXPECT_EQ(3, CallbackProfiler::topSources(10).size());
+  EXPECT_EQ(2, samples("test.second"));
+
+  CallbackProfiler::reset();
+  EXPECT_TRUE(CallbackProfiler::topSources(10).empty());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -1,4 +1,5 @@
 #include <functional>
+#include <numeric>
 
 #include "envoy/common/scope_tracker.h"
 #include "envoy/thread/thread.h"
@@ -21,8 +22,11 @@
 #include "test/test_common/network_utility.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -468,6 +472,39 @@ TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
   }
 }
 
+// The callbacks posted from many threads to a dispatcher with a lock free post queue all run, in
+// the order each thread posted them.
+TEST(LockFreePostQueueDispatcherTest, PostFromManyThreads) {
+  Api::ApiPtr api = Api::createApiForTest();
+  GlobalTimeSystem time_system;
+  DispatcherImpl dispatcher(
+      "test_thread", api->threadFactory(), api->timeSource(), api->fileSystem(), time_system,
+      [](Dispatcher&) { return std::make_unique<NiceMock<MockScaledRangeTimerManager>>(); },
+      nullptr, true);
+
+  constexpr int Threads = 8;
+  constexpr int PostsPerThread = 1000;
+  std::vector<std::vector<int>> runs(Threads);
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < Threads; ++i) {
+    threads.push_back(api->threadFactory().createThread([&dispatcher, &runs, i]() {
+      for (int j = 0; j < PostsPerThread; ++j) {
+        dispatcher.post([&runs, i, j]() { runs[i].push_back(j); });
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  dispatcher.run(Dispatcher::RunType::NonBlock);
+
+  std::vector<int> expected(PostsPerThread);
+  std::iota(expected.begin(), expected.end(), 0);
+  for (int i = 0; i < Threads; ++i) {
+    EXPECT_EQ(expected, runs[i]);
+  }
+}
+
 TEST_F(DispatcherImplTest, DispatcherThreadDeleted) {
   dispatcher_->deleteInDispatcherThread(std::make_unique<TestDispatcherThreadDeletable>(
       [this, id = api_->threadFactory().currentThreadId()]() {
@@ -757,6 +794,65 @@ TEST_F(DispatcherImplTest, OnlyRunsFatalActionsIfRunningOnSameThread) {
   EXPECT_EQ(action->getNumTimesRan(), 1);
 }
 
+class DispatcherBusyPollTest : public testing::Test {
+protected:
+  DispatcherBusyPollTest()
+      : api_(Api::createApiForTest(store_, time_system_)),
+        dispatcher_(api_->allocateDispatcher("test_thread")) {}
+
+  ~DispatcherBusyPollTest() override {
+    dispatcher_->exit();
+    dispatcher_thread_->join();
+  }
+
+  void start(std::chrono::microseconds max_spin_duration) {
+    dispatcher_->enableBusyPoll(max_spin_duration, *store_.rootScope(), "test.");
+    dispatcher_thread_ = api_->threadFactory().createThread(
+        [this]() { dispatcher_->run(Dispatcher::RunType::RunUntilExit); });
+  }
+
+  void runOnDispatcher() {
+    absl::Notification ran;
+    dispatcher_->post([&ran]() { ran.Notify(); });
+    ran.WaitForNotification();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  Event::TestRealTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  Thread::ThreadPtr dispatcher_thread_;
+};
+
+// Events arriving while the dispatcher spins are processed without blocking.
+TEST_F(DispatcherBusyPollTest, SpinAvoidsWakeups) {
+  start(std::chrono::seconds(10));
+  // The first callback may run before the event loop starts.
+  runOnDispatcher();
+  runOnDispatcher();
+  runOnDispatcher();
+  EXPECT_TRUE(TestUtility::waitForCounterGe(store_, "test.dispatcher.busy_poll_wakeups_avoided",
+                                            2, time_system_));
+  EXPECT_EQ(0, TestUtility::findCounter(store_, "test.dispatcher.busy_poll_sleeps")->value());
+}
+
+// The dispatcher blocks once it spun for the spin duration, and accounts for the spin time.
+TEST_F(DispatcherBusyPollTest, SleepsAfterSpinDuration) {
+  start(std::chrono::milliseconds(1));
+  EXPECT_TRUE(TestUtility::waitForCounterGe(store_, "test.dispatcher.busy_poll_sleeps", 1,
+                                            time_system_));
+  EXPECT_GE(TestUtility::findCounter(store_, "test.dispatcher.busy_poll_spin_us")->value(), 1000);
+
+  // The dispatcher still processes events and exits while blocking.
+  runOnDispatcher();
+}
+
+// A dispatcher running until exit returns when it spins.
+TEST_F(DispatcherBusyPollTest, ExitWhileSpinning) {
+  start(std::chrono::seconds(10));
+  runOnDispatcher();
+}
+
 class NotStartedDispatcherImplTest : public testing::Test {
 protected:
   NotStartedDispatcherImplTest()
@@ -0,0 +1,75 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "source/common/buffer/watermark_buffer.h"
+#include "source/common/common/assert.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/scaled_range_timer_manager_impl.h"
+
+#include "test/test_common/test_time.h"
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+
+// Posts from many producer threads to a dispatcher running on its own thread, with the mutex
+// guarded post queue (range 0 is 0) or the lock free one (range 0 is 1). Range 1 is the number of
+// producers.
+static void bmPostFromManyThreads(benchmark::State& state) {
+  const bool lock_free = state.range(0) != 0;
+  const int producers = state.range(1);
+  constexpr int PostsPerProducer = 10000;
+
+  Api::ApiPtr api = Api::createApiForTest();
+  GlobalTimeSystem time_system;
+  DispatcherImpl dispatcher(
+      "benchmark", api->threadFactory(), api->timeSource(), api->fileSystem(), time_system,
+      [](Dispatcher& dispatcher) {
+        return std::make_unique<ScaledRangeTimerManagerImpl>(dispatcher);
+      },
+      std::make_shared<Buffer::WatermarkBufferFactory>(
+          envoy::config::overload::v3::BufferFactoryConfig()),
+      lock_free);
+  Thread::ThreadPtr dispatcher_thread = api->threadFactory().createThread(
+      [&dispatcher]() { dispatcher.run(Dispatcher::RunType::RunUntilExit); });
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    std::atomic<int> remaining{producers * PostsPerProducer};
+    absl::Notification done;
+    std::vector<Thread::ThreadPtr> threads;
+    for (int i = 0; i < producers; ++i) {
+      threads.push_back(api->threadFactory().createThread([&dispatcher, &remaining, &done]() {
+        for (int j = 0; j < PostsPerProducer; ++j) {
+          dispatcher.post([&remaining, &done]() {
+            if (--remaining == 0) {
+              done.Notify();
+            }
+          });
+        }
+      }));
+    }
+    for (Thread::ThreadPtr& thread : threads) {
+      thread->join();
+    }
+    done.WaitForNotification();
+  }
+
+  dispatcher.exit();
+  dispatcher_thread->join();
+  state.SetItemsProcessed(state.iterations() * producers * PostsPerProducer);
+}
+BENCHMARK(bmPostFromManyThreads)
+    ->ArgsProduct({{0, 1}, {1, 8, 64}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,50 @@
+#include <string>
+#include <vector>
+
+#include "source/common/event/lock_free_post_queue.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+// The callbacks are taken in push order, and only the push to an empty queue asks for a wakeup.
+TEST(LockFreePostQueueTest, TakesCallbacksInPushOrder) {
+  LockFreePostQueue queue;
+  std::vector<std::string> calls;
+  EXPECT_TRUE(queue.push([&calls]() { calls.push_back("first"); }));
+  EXPECT_FALSE(queue.push([&calls]() { calls.push_back("second"); }));
+  EXPECT_FALSE(queue.push([&calls]() { calls.push_back("third"); }));
+  EXPECT_EQ(3, queue.size());
+
+  LockFreePostQueue::Callbacks callbacks = queue.takeAll();
+  EXPECT_EQ(0, queue.size());
+  // The queue is empty again, so the next push wakes up the consumer.
+  EXPECT_TRUE(queue.push([&calls]() { calls.push_back("fourth"); }));
+  while (!callbacks.empty()) {
+    callbacks.front()();
+    callbacks.pop_front();
+  }
+  EXPECT_EQ(std::vector<std::string>({"first", "second", "third"}), calls);
+  EXPECT_FALSE(queue.takeAll().empty());
+  EXPECT_TRUE(queue.takeAll().empty());
+}
+
+// The callbacks left in the queue or in taken callbacks are destroyed without running.
+TEST(LockFreePostQueueTest, DestroysRemainingCallbacks) {
+  auto token = std::make_shared<int>(0);
+  {
+    LockFreePostQueue queue;
+    queue.push([token]() { FAIL(); });
+    queue.push([token]() { FAIL(); });
+    LockFreePostQueue::Callbacks callbacks = queue.takeAll();
+    queue.push([token]() { FAIL(); });
+    EXPECT_EQ(4, token.use_count());
+  }
+  EXPECT_EQ(1, token.use_count());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,182 @@
+#include <chrono>
+
+#include "envoy/event/timer.h"
+
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::InSequence;
+using testing::MockFunction;
+
+class TimerWheelTest : public testing::Test, public TestUsingSimulatedTime {
+public:
+  TimerWheelTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        wheel_(*dispatcher_, std::chrono::milliseconds(10)) {}
+
+  void advance(std::chrono::milliseconds duration) {
+    simTime().advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  TimerWheel wheel_;
+};
+
+TEST_F(TimerWheelTest, CreateAndDestroyTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, EnableTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(1));
+  EXPECT_TRUE(timer->enabled());
+  EXPECT_EQ(1, wheel_.size());
+
+  advance(std::chrono::milliseconds(999));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel_.size());
+}
+
+TEST_F(TimerWheelTest, ExpirationRoundedUpToTick) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+
+  timer->enableHRTimer(std::chrono::microseconds(1000500));
+  advance(std::chrono::milliseconds(1009));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_FALSE(timer->enabled());
+}
+
+TEST_F(TimerWheelTest, DisableTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(1));
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  EXPECT_EQ(0, wheel_.size());
+  // Disabling a disabled timer is a no-op.
+  timer->disableTimer();
+
+  advance(std::chrono::seconds(2));
+}
+
+TEST_F(TimerWheelTest, ReenableTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+
+  timer->enableTimer(std::chrono::seconds(1));
+  advance(std::chrono::milliseconds(500));
+  timer->enableTimer(std::chrono::seconds(1));
+  EXPECT_EQ(1, wheel_.size());
+
+  advance(std::chrono::milliseconds(990));
+  EXPECT_TRUE(timer->enabled());
+
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(10));
+}
+
+TEST_F(TimerWheelTest, DestroyEnabledTimer) {
+  MockFunction<TimerCb> callback;
+  auto timer = wheel_.createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::seconds(1));
+
+  timer.reset();
+  EXPECT_EQ(0, wheel_.size());
+  advance(std::chrono::seconds(2));
+}
+
+// Timers in the higher levels of the wheel, or out of its range, move down until they expire.
+TEST_F(TimerWheelTest, LongDelays) {
+  const std::vector<std::chrono::milliseconds> delays{
+      std::chrono::seconds(1), std::chrono::minutes(5), std::chrono::hours(10),
+      std::chrono::hours(24 * 30)};
+  std::vector<std::unique_ptr<MockFunction<TimerCb>>> callbacks;
+  std::vector<TimerPtr> timers;
+  for (const auto delay : delays) {
+    callbacks.push_back(std::make_unique<MockFunction<TimerCb>>());
+    timers.push_back(wheel_.createTimer(callbacks.back()->AsStdFunction()));
+    timers.back()->enableTimer(delay);
+  }
+  EXPECT_EQ(4, wheel_.size());
+
+  std::chrono::milliseconds elapsed{0};
+  for (size_t i = 0; i < delays.size(); ++i) {
+    advance(delays[i] - elapsed - std::chrono::milliseconds(10));
+    EXPECT_TRUE(timers[i]->enabled());
+
+    EXPECT_CALL(*callbacks[i], Call());
+    advance(std::chrono::milliseconds(10));
+    EXPECT_FALSE(timers[i]->enabled());
+    elapsed = delays[i];
+    EXPECT_EQ(delays.size() - i - 1, wheel_.size());
+  }
+}
+
+TEST_F(TimerWheelTest, TimersExpireInOrder) {
+  InSequence s;
+  MockFunction<void(int)> callback;
+  std::vector<TimerPtr> timers;
+  for (int i = 0; i < 3; ++i) {
+    timers.push_back(wheel_.createTimer([&callback, i]() { callback.Call(i); }));
+  }
+  timers[2]->enableTimer(std::chrono::seconds(3));
+  timers[0]->enableTimer(std::chrono::seconds(1));
+  timers[1]->enableTimer(std::chrono::seconds(2));
+
+  EXPECT_CALL(callback, Call(0));
+  EXPECT_CALL(callback, Call(1));
+  EXPECT_CALL(callback, Call(2));
+  advance(std::chrono::seconds(3));
+}
+
+TEST_F(TimerWheelTest, CallbacksEnableAndDisableTimers) {
+  MockFunction<TimerCb> callback1;
+  MockFunction<TimerCb> callback2;
+  auto timer1 = wheel_.createTimer(callback1.AsStdFunction());
+  auto timer2 = wheel_.createTimer(callback2.AsStdFunction());
+
+  // Both timers expire at the same tick, and the first one disables the second one.
+  timer1->enableTimer(std::chrono::seconds(1));
+  timer2->enableTimer(std::chrono::seconds(1));
+  EXPECT_CALL(callback1, Call()).WillOnce([&]() {
+    timer2->disableTimer();
+    timer1->enableTimer(std::chrono::milliseconds(0));
+  });
+  EXPECT_CALL(callback2, Call()).Times(0);
+  advance(std::chrono::seconds(1));
+
+  // A timer enabled by a callback without delay expires at the next tick.
+  EXPECT_TRUE(timer1->enabled());
+  EXPECT_CALL(callback1, Call());
+  advance(std::chrono::milliseconds(10));
+  EXPECT_EQ(0, wheel_.size());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
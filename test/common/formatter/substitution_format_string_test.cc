@@ -80,6 +80,52 @@ TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigJson) {
   EXPECT_TRUE(TestUtility::jsonStringEqual(out_json, expected));
 }
 
+TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigBinary) {
+  const std::string yaml = R"EOF(
+  binary_format:
+    fields:
+    - number: 1
+      format: "%RESPONSE_CODE%"
+    - number: 2
+      format: "%REQ(:path)%"
+    - number: 3
+      format: "code=%RESPONSE_CODE%"
+    - number: 4
+      format: "%REQ(x-missing)%"
+    - number: 5
+      format: "a%REQ(x-missing)%"
+)EOF";
+  TestUtility::loadFromYaml(yaml, config_);
+
+  auto formatter = *SubstitutionFormatStringUtils::fromProtoConfig(config_, context_);
+  // The length of the message, then the varint field 1, the string fields 2, 3 and 5, without
+  // field 4 which has no value.
+  const std::string expected = absl::StrCat("\x1b", "\x08\xc8\x01", "\x12\x08/bar/foo",
+                                            "\x1a\x08", "code=200", "\x2a\x02", "a-");
+  EXPECT_EQ(expected, formatter->format(formatter_context_, stream_info_));
+
+  config_.set_omit_empty_values(true);
+  formatter = *SubstitutionFormatStringUtils::fromProtoConfig(config_, context_);
+  const std::string expected_without_empty_values = absl::StrCat(
+      "\x1a", "\x08\xc8\x01", "\x12\x08/bar/foo", "\x1a\x08", "code=200", "\x2a\x01", "a");
+  EXPECT_EQ(expected_without_empty_values, formatter->format(formatter_context_, stream_info_));
+}
+
+TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigBinaryDuplicateNumber) {
+  const std::string yaml = R"EOF(
+  binary_format:
+    fields:
+    - number: 1
+      format: "%RESPONSE_CODE%"
+    - number: 1
+      format: "%REQ(:path)%"
+)EOF";
+  TestUtility::loadFromYaml(yaml, config_);
+
+  EXPECT_EQ(SubstitutionFormatStringUtils::fromProtoConfig(config_, context_).status().message(),
+            "Duplicate field number in binary format: 1");
+}
+
 TEST_F(SubstitutionFormatStringUtilsTest, TestFromProtoConfigFormatterExtension) {
   TestCommandFactory factory;
   Registry::InjectFactory<CommandParserFactory> command_register(factory);
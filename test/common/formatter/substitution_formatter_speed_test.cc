@@ -36,6 +36,15 @@ std::unique_ptr<Envoy::TestStreamInfo> makeStreamInfo(TimeSource& time_source) {
   return stream_info;
 }
 
+Http::TestRequestHeaderMapImpl makeRequestHeaders() {
+  return {{":method", "GET"},
+          {":authority", "www.example.com"},
+          {":path", "/api/v1/items/1234?expand=true"},
+          {"x-forwarded-proto", "https"},
+          {"referer", "https://www.example.com/index.html"},
+          {"user-agent", "Mozilla/5.0 (X11; Linux x86_64; rv:109.0) Gecko/20100101 Firefox/115.0"}};
+}
+
 } // namespace
 
 // Test measures how fast Formatters are constructed from
@@ -125,6 +134,51 @@ static void BM_JsonAccessLogFormatter(benchmark::State& state) {
 }
 BENCHMARK(BM_JsonAccessLogFormatter);
 
+// Formats a text log line for a request whose headers are all present, as in production.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AccessLogFormatterWithHeaders(benchmark::State& state) {
+  testing::NiceMock<MockTimeSystem> time_system;
+
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  Http::TestRequestHeaderMapImpl request_headers = makeRequestHeaders();
+  Formatter::Context context;
+  context.setRequestHeaders(request_headers);
+  static const char* LogFormat =
+      "%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT% %START_TIME(%Y/%m/%dT%H:%M:%S%z %s)% "
+      "%REQ(:METHOD)% "
+      "%REQ(X-FORWARDED-PROTO)%://%REQ(:AUTHORITY)%%REQ(X-ENVOY-ORIGINAL-PATH?:PATH)% %PROTOCOL% "
+      "s%RESPONSE_CODE% %BYTES_SENT% %DURATION% %REQ(REFERER)% \"%REQ(USER-AGENT)%\" - - -\n";
+
+  std::unique_ptr<Envoy::Formatter::FormatterImpl> formatter =
+      *Envoy::Formatter::FormatterImpl::create(LogFormat, false);
+
+  size_t output_bytes = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes += formatter->format(context, *stream_info).length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_AccessLogFormatterWithHeaders);
+
+// Formats a JSON log line for a request whose headers are all present, as in production.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_JsonAccessLogFormatterWithHeaders(benchmark::State& state) {
+  testing::NiceMock<MockTimeSystem> time_system;
+
+  std::unique_ptr<Envoy::TestStreamInfo> stream_info = makeStreamInfo(time_system);
+  Http::TestRequestHeaderMapImpl request_headers = makeRequestHeaders();
+  Formatter::Context context;
+  context.setRequestHeaders(request_headers);
+  std::unique_ptr<Envoy::Formatter::JsonFormatterImpl> json_formatter = makeJsonFormatter();
+
+  size_t output_bytes = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    output_bytes += json_formatter->format(context, *stream_info).length();
+  }
+  benchmark::DoNotOptimize(output_bytes);
+}
+BENCHMARK(BM_JsonAccessLogFormatterWithHeaders);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_FormatterCommandParsing(benchmark::State& state) {
   const std::string token = "Listener:namespace:key";
@@ -4614,6 +4614,104 @@ TEST(SubstitutionFormatterTest, JsonFormatterWithOrderedPropertiesTest) {
   EXPECT_EQ(out_json, expected);
 }
 
+// FormatterOutput that records the appended values as the text and typed values they stand for.
+class TestFormatterOutput : public FormatterOutput {
+public:
+  void addString(absl::string_view value) override {
+    text_.append(value);
+    value_ = ValueUtil::stringValue(std::string(value));
+  }
+  void addInteger(int64_t value) override {
+    absl::StrAppend(&text_, value);
+    value_ = ValueUtil::numberValue(value);
+  }
+  void addUnsignedInteger(uint64_t value) override {
+    absl::StrAppend(&text_, value);
+    value_ = ValueUtil::numberValue(value);
+  }
+
+  std::string text_;
+  Protobuf::Value value_{ValueUtil::nullValue()};
+};
+
+TEST(SubstitutionFormatterTest, FormatToMatchesFormat) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_header{{":method", "GET"}, {":path", "/a\"b"}};
+  Http::TestResponseHeaderMapImpl response_header{{"content-type", "text/plain"}};
+  Http::TestResponseTrailerMapImpl response_trailer{{"grpc-status", "0"}};
+  Context formatter_context;
+  formatter_context.setRequestHeaders(request_header)
+      .setResponseHeaders(response_header)
+      .setResponseTrailers(response_trailer);
+
+  absl::optional<Http::Protocol> protocol = Http::Protocol::Http11;
+  EXPECT_CALL(stream_info, protocol()).WillRepeatedly(Return(protocol));
+  stream_info.response_code_ = 200;
+  stream_info.bytes_received_ = 1000;
+  MockTimeSystem time_system;
+  EXPECT_CALL(time_system, monotonicTime)
+      .WillOnce(Return(MonotonicTime(std::chrono::nanoseconds(5000000))));
+  stream_info.downstream_timing_.onLastDownstreamRxByteReceived(time_system);
+
+  for (const std::string command : {
+           "plain text",
+           "%PROTOCOL%",
+           "%RESPONSE_CODE%",
+           "%BYTES_RECEIVED%",
+           "%REQUEST_DURATION%",
+           "%RESPONSE_DURATION%",
+           "%DOWNSTREAM_REMOTE_ADDRESS%",
+           "%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT%",
+           "%DOWNSTREAM_DIRECT_REMOTE_ADDRESS_WITHOUT_PORT%",
+           "%DOWNSTREAM_LOCAL_ADDRESS_WITHOUT_PORT(16)%",
+           "%DOWNSTREAM_LOCAL_PORT%",
+           "%UPSTREAM_HOST%",
+           "%REQ(:path)%",
+           "%REQ(:path):2%",
+           "%REQ(missing?:method)%",
+           "%REQ(missing)%",
+           "%RESP(content-type)%",
+           "%TRAILER(grpc-status)%",
+           "%COMMON_DURATION(DS_RX_BEG:DS_RX_END:ms)%",
+           "%DYNAMIC_METADATA(com.test:test_key)%",
+       }) {
+    SCOPED_TRACE(command);
+    auto providers = *SubstitutionFormatParser::parse(command);
+    ASSERT_EQ(1, providers.size());
+
+    TestFormatterOutput output;
+    const absl::optional<std::string> expected =
+        providers[0]->format(formatter_context, stream_info);
+    EXPECT_EQ(expected.has_value(),
+              providers[0]->formatTo(formatter_context, stream_info, output));
+    EXPECT_EQ(expected.value_or(""), output.text_);
+    if (providers[0]->typedFormatTo()) {
+      EXPECT_THAT(output.value_,
+                  ProtoEq(providers[0]->formatValue(formatter_context, stream_info)));
+    }
+  }
+
+  // The typed values are written to JSON logs as formatValue() would have them serialized.
+  Protobuf::Struct key_mapping;
+  TestUtility::loadFromYaml(R"EOF(
+    bytes: '%BYTES_RECEIVED%'
+    code: '%RESPONSE_CODE%'
+    missing: '%REQ(missing)%'
+    path: '%REQ(:path)%'
+    remote: '%DOWNSTREAM_REMOTE_ADDRESS_WITHOUT_PORT%'
+    text: '%PROTOCOL% %RESPONSE_CODE% %REQ(:path)%'
+  )EOF",
+                            key_mapping);
+  JsonFormatterImpl formatter(key_mapping, false);
+  EXPECT_EQ("{\"bytes\":1000,\"code\":200,\"missing\":null,\"path\":\"/a\\\"b\","
+            "\"remote\":\"127.0.0.1\",\"text\":\"HTTP/1.1 200 /a\\\"b\"}\n",
+            formatter.format(formatter_context, stream_info));
+
+  FormatterPtr text_formatter =
+      *FormatterImpl::create("%PROTOCOL% %BYTES_RECEIVED% %REQ(missing)% %REQ(:path)%", false);
+  EXPECT_EQ("HTTP/1.1 1000 - /a\"b", text_formatter->format(formatter_context, stream_info));
+}
+
 TEST(SubstitutionFormatterTest, CompositeFormatterSuccess) {
   Http::TestRequestHeaderMapImpl request_header{{"first", "GET"}, {":path", "/"}};
   Http::TestResponseHeaderMapImpl response_header{{"second", "PUT"}, {"test", "test"}};
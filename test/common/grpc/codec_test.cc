@@ -155,6 +155,8 @@ TEST(GrpcCodecTest, DecodeValidFrameWithInvalidFrameAfterward) {
   // Only part of the buffer represented a valid frame. Thus, the frame length should not equal the
   // buffer length.
   EXPECT_NE(size, frames[0].length_);
+  // The data of the valid frame is copied.
+  EXPECT_EQ(request.SerializeAsString(), frames[0].data_->toString());
 }
 
 TEST(GrpcCodecTest, decodeEmptyFrame) {
@@ -193,6 +195,40 @@ TEST(GrpcCodecTest, decodeSingleFrame) {
   EXPECT_EQ("hello", result.name());
 }
 
+// Checks that the slices of the input holding only frame data are moved to the frames.
+TEST(GrpcCodecTest, decodeMovesDataSlices) {
+  helloworld::HelloRequest request;
+  request.set_name(std::string(64 * 1024, 'a'));
+  const std::string serialized = request.SerializeAsString();
+
+  Buffer::OwnedImpl buffer;
+  std::array<uint8_t, 5> header;
+  Encoder encoder;
+  for (int i = 0; i < 2; i++) {
+    encoder.newFrame(GRPC_FH_DEFAULT, serialized.size(), header);
+    buffer.add(header.data(), 5);
+    Buffer::OwnedImpl data(serialized);
+    buffer.move(data);
+  }
+  std::vector<const void*> data_slices;
+  for (const Buffer::RawSlice& slice : buffer.getRawSlices()) {
+    if (slice.len_ == serialized.size()) {
+      data_slices.push_back(slice.mem_);
+    }
+  }
+  ASSERT_EQ(data_slices.size(), 2);
+
+  std::vector<Frame> frames;
+  Decoder decoder;
+  EXPECT_TRUE(decoder.decode(buffer, frames).ok());
+  EXPECT_EQ(0, buffer.length());
+  ASSERT_EQ(frames.size(), 2);
+  for (size_t i = 0; i < frames.size(); i++) {
+    EXPECT_EQ(frames[i].data_->frontSlice().mem_, data_slices[i]);
+    EXPECT_EQ(frames[i].data_->toString(), serialized);
+  }
+}
+
 TEST(GrpcCodecTest, decodeMultipleFrame) {
   helloworld::HelloRequest request;
   request.set_name("hello");
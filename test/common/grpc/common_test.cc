@@ -350,5 +350,23 @@ TEST(GrpcContextTest, PrependGrpcFrameHeader) {
   EXPECT_EQ(buffer->toString(), header_string + "test");
 }
 
+// Ensure that the gRPC header of a serialized message is prepended in the slice of the message.
+TEST(GrpcContextTest, SerializeMessageThenPrependGrpcFrameHeader) {
+  helloworld::HelloRequest request;
+  request.set_name("test");
+  Buffer::InstancePtr buffer = Common::serializeMessage(request);
+  EXPECT_EQ(buffer->toString(), request.SerializeAsString());
+
+  Common::prependGrpcFrameHeader(*buffer);
+  EXPECT_EQ(buffer->getRawSlices().size(), 1);
+  EXPECT_EQ(buffer->toString(), Common::serializeToGrpcFrame(request)->toString());
+
+  // An empty message is framed as well.
+  Buffer::InstancePtr empty_buffer = Common::serializeMessage(helloworld::HelloRequest());
+  EXPECT_EQ(empty_buffer->length(), 0);
+  Common::prependGrpcFrameHeader(*empty_buffer);
+  EXPECT_EQ(empty_buffer->toString(), std::string(5, '\0'));
+}
+
 } // namespace Grpc
 } // namespace Envoy
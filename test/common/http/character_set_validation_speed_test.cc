@@ -0,0 +1,80 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <algorithm>
+#include <string>
+
+#include "source/common/http/character_set_validation.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+
+// Builds a header value resembling a cookie or JWT of the requested length.
+static std::string makeHeaderValue(size_t length) {
+  static constexpr absl::string_view Pattern =
+      "session=eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9.eyJzdWIiOiIxMjM0NTY3ODkwIn0; Path=/; ";
+  std::string value;
+  value.reserve(length);
+  while (value.size() < length) {
+    value.append(Pattern.data(), std::min(Pattern.size(), length - value.size()));
+  }
+  return value;
+}
+
+// Validates a header value with the scalar table lookup.
+static void headerValueScalar(benchmark::State& state) {
+  const std::string value = makeHeaderValue(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(allCharsInTable(kGenericHeaderValueCharTable, value));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * value.size());
+}
+BENCHMARK(headerValueScalar)->Arg(16)->Arg(64)->Arg(512)->Arg(4096)->Arg(16384);
+
+// Validates a header value with the vectorized implementation.
+static void headerValueVectorized(benchmark::State& state) {
+  const std::string value = makeHeaderValue(state.range(0));
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(headerValueCharsValid(value));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * value.size());
+}
+BENCHMARK(headerValueVectorized)->Arg(16)->Arg(64)->Arg(512)->Arg(4096)->Arg(16384);
+
+static constexpr absl::string_view HeaderNames[] = {
+    "host",
+    "user-agent",
+    "accept-encoding",
+    "x-forwarded-for",
+    "x-forwarded-proto",
+    "x-envoy-expected-rq-timeout-ms",
+    "x-request-id",
+    "content-type",
+    "authorization",
+    "x-b3-traceid",
+};
+
+// Validates typical header names with the scalar table lookup.
+static void headerNamesScalar(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (const absl::string_view name : HeaderNames) {
+      benchmark::DoNotOptimize(allCharsInTable(kGenericHeaderNameCharTable, name));
+    }
+  }
+}
+BENCHMARK(headerNamesScalar);
+
+// Validates typical header names with the vectorized implementation.
+static void headerNamesVectorized(benchmark::State& state) {
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    for (const absl::string_view name : HeaderNames) {
+      benchmark::DoNotOptimize(headerNameCharsValid(name));
+    }
+  }
+}
+BENCHMARK(headerNamesVectorized);
+
+} // namespace Http
+} // namespace Envoy
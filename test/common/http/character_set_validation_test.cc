@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,73 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+// Every character at every position of a string spanning several vector blocks and a tail must
+// produce the same result as the scalar table lookup.
+TEST(CharacterSetValidationTest, HeaderValueCharsValidMatchesTable) {
+  for (const size_t length : {1, 15, 16, 17, 31, 32, 33, 100}) {
+    for (size_t position = 0; position < length; ++position) {
+      for (unsigned c = 0; c < 256; ++c) {
+        std::string value(length, 'a');
+        value[position] = static_cast<char>(c);
+        ASSERT_EQ(allCharsInTable(kGenericHeaderValueCharTable, value),
+                  headerValueCharsValid(value))
+            << "length " << length << " position " << position << " char " << c;
+      }
+    }
+  }
+  EXPECT_TRUE(headerValueCharsValid(""));
+  EXPECT_TRUE(headerValueCharsValid("text/html; charset=utf-8\tq=0.9 \x80\xff"));
+  EXPECT_FALSE(headerValueCharsValid(std::string(64, 'a') + "\r\n"));
+  EXPECT_FALSE(headerValueCharsValid(std::string("a\0b", 3)));
+}
+
+TEST(CharacterSetValidationTest, HeaderNameCharsValidMatchesTable) {
+  for (const size_t length : {1, 15, 16, 17, 31, 32, 33, 100}) {
+    for (size_t position = 0; position < length; ++position) {
+      for (unsigned c = 0; c < 256; ++c) {
+        std::string name(length, 'a');
+        name[position] = static_cast<char>(c);
+        ASSERT_EQ(allCharsInTable(kGenericHeaderNameCharTable, name), headerNameCharsValid(name))
+            << "length " << length << " position " << position << " char " << c;
+      }
+    }
+  }
+  EXPECT_TRUE(headerNameCharsValid(""));
+  EXPECT_TRUE(headerNameCharsValid("x-envoy-upstream-service-time"));
+  EXPECT_TRUE(headerNameCharsValid("X-Custom_Header!#$%&'*+.^`|~"));
+  EXPECT_FALSE(headerNameCharsValid("x-envoy-upstream-service-time:"));
+  EXPECT_FALSE(headerNameCharsValid("x-envoy upstream"));
+}
+
+TEST(CharacterSetValidationTest, CommonHeaderNameCharsPrefix) {
+  EXPECT_EQ(0, commonHeaderNameCharsPrefix(""));
+  EXPECT_EQ(0, commonHeaderNameCharsPrefix("x-forwarded"));
+  // The prefix only covers whole vector blocks of common characters.
+  const std::string name = "x-forwarded-proto-version-2_custom";
+  const size_t prefix = commonHeaderNameCharsPrefix(name);
+  EXPECT_EQ(kCharacterValidationVectorWidth, prefix);
+  EXPECT_EQ(absl::string_view::npos, absl::string_view(name).substr(0, prefix).find('_'));
+  EXPECT_EQ(2 * kCharacterValidationVectorWidth,
+            commonHeaderNameCharsPrefix(std::string(2 * kCharacterValidationVectorWidth, '-')));
+  EXPECT_EQ(0, commonHeaderNameCharsPrefix(std::string(2 * kCharacterValidationVectorWidth, 'A')));
+}
+
+TEST(CharacterSetValidationTest, FindCrOrLf) {
+  for (const size_t length : {1, 15, 16, 17, 31, 32, 33, 47, 48, 49, 100}) {
+    EXPECT_EQ(absl::string_view::npos, findCrOrLf(std::string(length, 'a')));
+    for (size_t position = 0; position < length; ++position) {
+      for (const char delimiter : {'\r', '\n'}) {
+        std::string str(length, 'a');
+        str[position] = delimiter;
+        // A later delimiter must not be reported instead of the first one.
+        str[length - 1] = '\n';
+        ASSERT_EQ(position, findCrOrLf(str)) << "length " << length << " position " << position;
+      }
+    }
+  }
+  EXPECT_EQ(absl::string_view::npos, findCrOrLf(""));
+  EXPECT_EQ(absl::string_view::npos, findCrOrLf("\x8d\x8a\t\x0b\x0c"));
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -760,6 +760,40 @@ TEST_F(HttpConnectionManagerImplTest, RouteShouldUseSantizedPath) {
   filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// With the route resolution cache, streams of a connection that share host and path reuse the
+// route resolved for the first of them.
+TEST_F(HttpConnectionManagerImplTest, RouteResolutionCacheReusesRoute) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.connection_route_resolution_cache", "true"}});
+  setup();
+  ON_CALL(*route_config_provider_.route_config_, routeResolutionCacheable())
+      .WillByDefault(Return(true));
+
+  NiceMock<MockResponseEncoder> encoders[3];
+  EXPECT_CALL(*codec_, dispatch(_)).WillOnce(Invoke([&](Buffer::Instance&) -> Http::Status {
+    for (int i = 0; i < 3; ++i) {
+      RequestDecoder* decoder = &conn_manager_->newStream(encoders[i]);
+      RequestHeaderMapPtr headers{
+          new TestRequestHeaderMapImpl{{":authority", "host"},
+                                       {":path", absl::StrCat("/foo?request=", i)},
+                                       {":method", "GET"}}};
+      decoder->decodeHeaders(std::move(headers), true);
+    }
+    return Http::okStatus();
+  }));
+
+  EXPECT_CALL(*route_config_provider_.route_config_, route(_, _, _, _));
+  EXPECT_CALL(filter_factory_, createFilterChain(_)).Times(3).WillRepeatedly(Return(false));
+
+  // Kick off the incoming data.
+  Buffer::OwnedImpl fake_input("1234");
+  conn_manager_->onData(fake_input, false);
+
+  // Clean up.
+  filter_callbacks_.connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
+}
+
 // Paths with escaped slashes rejected with 400 when configured.
 TEST_F(HttpConnectionManagerImplTest, PathWithEscapedSlashesRejected) {
   path_with_escaped_slashes_action_ = envoy::extensions::filters::network::http_connection_manager::
@@ -462,6 +462,22 @@ TEST_F(ConnectionManagerUtilityTest, SchemeIsRespected) {
   EXPECT_EQ("https", headers.getSchemeValue());
 }
 
+TEST_F(ConnectionManagerUtilityTest, SchemeIsLowerCased) {
+  ON_CALL(config_, useRemoteAddress()).WillByDefault(Return(true));
+  connection_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+      std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1"));
+  Network::Address::Ipv4Instance local_address("10.3.2.1");
+  ON_CALL(config_, localAddress()).WillByDefault(ReturnRef(local_address));
+
+  TestRequestHeaderMapImpl headers{{":scheme", "HtTpS"}};
+  callMutateRequestHeaders(headers, Protocol::Http2);
+  EXPECT_EQ("https", headers.getSchemeValue());
+
+  TestRequestHeaderMapImpl lower_case_headers{{":scheme", "https"}};
+  callMutateRequestHeaders(lower_case_headers, Protocol::Http2);
+  EXPECT_EQ("https", lower_case_headers.getSchemeValue());
+}
+
 TEST_F(ConnectionManagerUtilityTest, SchemeOverwrite) {
   ON_CALL(config_, useRemoteAddress()).WillByDefault(Return(true));
   ON_CALL(config_, xffNumTrustedHops()).WillByDefault(Return(0));
@@ -1453,6 +1453,48 @@ TEST_F(ConnectivityGridTest, SuccessWithAltSvc) {
   EXPECT_FALSE(grid_->isHttp3Broken());
 }
 
+// Test that preconnecting is disabled without the runtime guard.
+TEST_F(ConnectivityGridTest, PreconnectDisabled) {
+  initialize();
+  addHttp3AlternateProtocol();
+
+  EXPECT_FALSE(grid_->maybePreconnect(1.5));
+  EXPECT_EQ(grid_->http3Pool(), nullptr);
+  EXPECT_EQ(grid_->http2Pool(), nullptr);
+}
+
+// Test that preconnecting warms HTTP/3 connections when HTTP/3 is advertised.
+TEST_F(ConnectivityGridTest, PreconnectHttp3) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.connectivity_grid_preconnect", "true"}});
+  initialize();
+  addHttp3AlternateProtocol();
+  grid_->getOrCreateHttp3Pool();
+
+  EXPECT_CALL(*grid_->http3Pool(), maybePreconnect(1.5)).WillOnce(Return(true));
+  EXPECT_TRUE(grid_->maybePreconnect(1.5));
+  EXPECT_EQ(grid_->http2Pool(), nullptr);
+
+  // After a recent HTTP/3 failure, TCP connections are warmed instead.
+  grid_->getOrCreateHttp2Pool();
+  grid_->markHttp3Broken();
+  EXPECT_CALL(*grid_->http3Pool(), maybePreconnect(_)).Times(0);
+  EXPECT_CALL(*grid_->http2Pool(), maybePreconnect(1.5)).WillOnce(Return(false));
+  EXPECT_FALSE(grid_->maybePreconnect(1.5));
+}
+
+// Test that preconnecting warms TCP connections when HTTP/3 is not advertised.
+TEST_F(ConnectivityGridTest, PreconnectWithoutHttp3) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.connectivity_grid_preconnect", "true"}});
+  initialize();
+  grid_->getOrCreateHttp2Pool();
+
+  EXPECT_CALL(*grid_->http2Pool(), maybePreconnect(1.5)).WillOnce(Return(true));
+  EXPECT_TRUE(grid_->maybePreconnect(1.5));
+  EXPECT_EQ(grid_->http3Pool(), nullptr);
+}
+
 // Test that when HTTP/3 is not available then the HTTP/3 pool is skipped.
 TEST_F(ConnectivityGridTest, SuccessWithoutHttp3) {
   initialize();
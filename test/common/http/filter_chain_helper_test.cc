@@ -30,6 +30,7 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabled) {
     // If no filter is disabled explicitly by route, all filters should be added.
     EXPECT_CALL(callbacks, filterDisabled(_)).Times(3).WillRepeatedly(Return(absl::nullopt));
     EXPECT_CALL(callbacks, setFilterConfigName(_)).Times(3);
+    EXPECT_CALL(callbacks, reserveFilters(3));
     FilterChainUtility::createFilterChainForFactories(callbacks, filter_factories);
     EXPECT_EQ(added_filters.size(), 3);
   }
@@ -13,11 +13,14 @@
 #include "source/common/stream_info/filter_state_impl.h"
 #include "source/common/stream_info/stream_info_impl.h"
 
+#include "test/mocks/buffer/mocks.h"
 #include "test/mocks/event/mocks.h"
 #include "test/mocks/http/mocks.h"
+#include "test/mocks/http/stream_reset_handler.h"
 #include "test/mocks/local_reply/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/overload_manager.h"
+#include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
 
 #include "gtest/gtest.h"
@@ -32,9 +35,9 @@ namespace {
 using Protobuf::util::MessageDifferencer;
 class FilterManagerTest : public testing::Test {
 public:
-  void initialize() {
+  void initialize(Buffer::BufferMemoryAccountSharedPtr account = nullptr) {
     filter_manager_ = std::make_unique<DownstreamFilterManager>(
-        filter_manager_callbacks_, dispatcher_, connection_, 0, nullptr, true, 10000,
+        filter_manager_callbacks_, dispatcher_, connection_, 0, std::move(account), true, 10000,
         filter_factory_, local_reply_, protocol_, time_source_, filter_state_, overload_manager_);
   }
 
@@ -141,6 +144,69 @@ TEST_F(FilterManagerTest, RequestHeadersOrResponseHeadersAccess) {
   filter_manager_->destroyFilters();
 }
 
+// The buffer memory account of the stream is charged for its headers and the bodies buffered by its
+// filters.
+TEST_F(FilterManagerTest, AccountChargedForHeadersAndBufferedBodies) {
+  Buffer::WatermarkBufferFactory buffer_factory{envoy::config::overload::v3::BufferFactoryConfig()};
+  NiceMock<MockStreamResetHandler> reset_handler;
+  Buffer::BufferMemoryAccountSharedPtr account = buffer_factory.createAccount(reset_handler);
+  const auto balance = [&account]() {
+    return static_cast<Buffer::BufferMemoryAccountImpl&>(*account).balance();
+  };
+  initialize(account);
+
+  auto filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainFactoryCallbacks& callbacks) -> bool {
+        createDecoderFilterFactoryCb(filter)(callbacks);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  RequestHeaderMapPtr headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "POST"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*headers)));
+  EXPECT_CALL(*filter, decodeHeaders(_, false)).WillOnce(Return(FilterHeadersStatus::Continue));
+  filter_manager_->decodeHeaders(*headers, false);
+  EXPECT_EQ(headers->byteSize(), balance());
+
+  EXPECT_CALL(*filter, decodeData(_, false))
+      .WillOnce(Return(FilterDataStatus::StopIterationAndBuffer));
+  Buffer::OwnedImpl body("body");
+  filter_manager_->decodeData(body, false);
+  EXPECT_GT(balance(), headers->byteSize());
+
+  filter_manager_->destroyFilters();
+  filter_manager_.reset();
+  EXPECT_EQ(0, balance());
+  account->clearDownstream();
+}
+
+TEST_F(FilterManagerTest, AccountNotChargedForHeadersWhenDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.account_stream_headers_and_filter_buffers", "false"}});
+  Buffer::WatermarkBufferFactory buffer_factory{envoy::config::overload::v3::BufferFactoryConfig()};
+  NiceMock<MockStreamResetHandler> reset_handler;
+  Buffer::BufferMemoryAccountSharedPtr account = buffer_factory.createAccount(reset_handler);
+  initialize(account);
+
+  EXPECT_CALL(filter_factory_, createFilterChain(_)).WillOnce(Return(true));
+  filter_manager_->createDownstreamFilterChain();
+
+  RequestHeaderMapPtr headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*headers)));
+  filter_manager_->decodeHeaders(*headers, true);
+  EXPECT_EQ(0, static_cast<Buffer::BufferMemoryAccountImpl&>(*account).balance());
+
+  filter_manager_->destroyFilters();
+  filter_manager_.reset();
+  account->clearDownstream();
+}
+
 // Verifies that the local reply persists the gRPC classification even if the request headers are
 // modified.
 TEST_F(FilterManagerTest, SendLocalReplyDuringDecodingGrpcClassiciation) {
@@ -791,6 +857,185 @@ TEST_F(FilterManagerTest, IdleTimerResets) {
   filter_1->decoder_callbacks_->encodeTrailers(std::move(basic_resp_trailers));
   filter_manager_->destroyFilters();
 }
+
+TEST_F(FilterManagerTest, SkipBodyAndTrailers) {
+  initialize();
+
+  std::shared_ptr<MockStreamFilter> filter_1(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamFilter> filter_2(new NiceMock<MockStreamFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainFactoryCallbacks& callbacks) -> bool {
+        auto factory = createStreamFilterFactoryCb(filter_1);
+        callbacks.setFilterConfigName("configName1");
+        factory(callbacks);
+        factory = createStreamFilterFactoryCb(filter_2);
+        callbacks.setFilterConfigName("configName2");
+        factory(callbacks);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  // filter_1 does not need the request body and trailers, which only reach filter_2.
+  EXPECT_CALL(*filter_1, decodeHeaders(_, false)).WillOnce([&]() {
+    filter_1->decoder_callbacks_->skipDecodingBodyAndTrailers();
+    return FilterHeadersStatus::Continue;
+  });
+  EXPECT_CALL(*filter_2, decodeHeaders(_, false));
+  filter_manager_->decodeHeaders(*basic_headers, false);
+
+  Buffer::OwnedImpl data("absee");
+  EXPECT_CALL(*filter_1, decodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_2, decodeData(BufferStringEqual("absee"), false));
+  filter_manager_->decodeData(data, false);
+
+  RequestTrailerMapPtr basic_trailers{new TestRequestTrailerMapImpl{{"x", "y"}}};
+  EXPECT_CALL(*filter_1, decodeTrailers(_)).Times(0);
+  EXPECT_CALL(*filter_1, decodeComplete());
+  EXPECT_CALL(*filter_2, decodeTrailers(_));
+  EXPECT_CALL(*filter_2, decodeComplete());
+  filter_manager_->decodeTrailers(*basic_trailers);
+
+  // filter_2 does not need the response body and trailers, which only reach filter_1.
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  ON_CALL(filter_manager_callbacks_, responseHeaders())
+      .WillByDefault(Return(makeOptRef(*response_headers)));
+  EXPECT_CALL(*filter_2, encodeHeaders(_, false)).WillOnce([&]() {
+    filter_2->encoder_callbacks_->skipEncodingBodyAndTrailers();
+    return FilterHeadersStatus::Continue;
+  });
+  EXPECT_CALL(*filter_1, encodeHeaders(_, false));
+  filter_2->decoder_callbacks_->encodeHeaders(
+      std::make_unique<TestResponseHeaderMapImpl>(*response_headers), false, "");
+
+  EXPECT_CALL(*filter_2, encodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_1, encodeData(BufferStringEqual("absee"), false));
+  EXPECT_CALL(filter_manager_callbacks_, encodeData(BufferStringEqual("absee"), false));
+  filter_2->decoder_callbacks_->encodeData(data, false);
+
+  ResponseTrailerMapPtr basic_resp_trailers{new TestResponseTrailerMapImpl{{"x", "y"}}};
+  EXPECT_CALL(*filter_2, encodeTrailers(_)).Times(0);
+  EXPECT_CALL(*filter_2, encodeComplete());
+  EXPECT_CALL(*filter_1, encodeTrailers(_));
+  EXPECT_CALL(*filter_1, encodeComplete());
+  filter_2->decoder_callbacks_->encodeTrailers(std::move(basic_resp_trailers));
+
+  filter_manager_->destroyFilters();
+}
+
+TEST_F(FilterManagerTest, SkipBodyOfStreamedRequest) {
+  initialize();
+
+  std::shared_ptr<MockStreamDecoderFilter> filter_1(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> filter_2(new NiceMock<MockStreamDecoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillRepeatedly(Invoke([&](FilterChainFactoryCallbacks& callbacks) -> bool {
+        auto factory = createDecoderFilterFactoryCb(filter_1);
+        callbacks.setFilterConfigName("configName1");
+        factory(callbacks);
+        factory = createDecoderFilterFactoryCb(filter_2);
+        callbacks.setFilterConfigName("configName2");
+        factory(callbacks);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "POST"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  EXPECT_CALL(*filter_1, decodeHeaders(_, false)).WillOnce([&]() {
+    filter_1->callbacks_->skipDecodingBodyAndTrailers();
+    return FilterHeadersStatus::Continue;
+  });
+  filter_manager_->decodeHeaders(*basic_headers, false);
+
+  EXPECT_CALL(*filter_1, decodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_1, decodeComplete()).Times(0);
+  EXPECT_CALL(*filter_2, decodeData(BufferStringEqual("chunk"), false)).Times(2);
+  Buffer::OwnedImpl data("chunk");
+  filter_manager_->decodeData(data, false);
+  filter_manager_->decodeData(data, false);
+  testing::Mock::VerifyAndClearExpectations(filter_1.get());
+
+  // The last chunk still completes the decoding of the filter skipping the body.
+  EXPECT_CALL(*filter_1, decodeData(_, _)).Times(0);
+  EXPECT_CALL(*filter_1, decodeComplete());
+  EXPECT_CALL(*filter_2, decodeData(BufferStringEqual("chunk"), true));
+  EXPECT_CALL(*filter_2, decodeComplete());
+  filter_manager_->decodeData(data, true);
+
+  filter_manager_->destroyFilters();
+}
+
+// The filters of an instrumented stream are timed in their callbacks and while they stop the
+// iteration, until the stream completes.
+TEST_F(FilterManagerTest, InstrumentedFilterTimings) {
+  Event::SimulatedTimeSystem time_system;
+  initialize();
+  filter_manager_->instrumentFilters();
+
+  std::shared_ptr<MockStreamDecoderFilter> filter_1(new NiceMock<MockStreamDecoderFilter>());
+  std::shared_ptr<MockStreamDecoderFilter> filter_2(new NiceMock<MockStreamDecoderFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainFactoryCallbacks& callbacks) -> bool {
+        callbacks.setFilterConfigName("configName1");
+        createDecoderFilterFactoryCb(filter_1)(callbacks);
+        callbacks.setFilterConfigName("configName2");
+        createDecoderFilterFactoryCb(filter_2)(callbacks);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  RequestHeaderMapPtr basic_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*basic_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  EXPECT_CALL(*filter_1, decodeHeaders(_, true)).WillOnce([&]() {
+    time_system.advanceTimeWait(std::chrono::milliseconds(5));
+    return FilterHeadersStatus::StopIteration;
+  });
+  filter_manager_->decodeHeaders(*basic_headers, true);
+
+  time_system.advanceTimeWait(std::chrono::milliseconds(20));
+  EXPECT_CALL(*filter_2, decodeHeaders(_, true)).WillOnce([&]() {
+    time_system.advanceTimeWait(std::chrono::milliseconds(2));
+    return FilterHeadersStatus::StopIteration;
+  });
+  filter_1->decoder_callbacks_->continueDecoding();
+
+  // filter_2 still stops the iteration when the stream completes.
+  time_system.advanceTimeWait(std::chrono::milliseconds(3));
+  filter_manager_->onStreamComplete();
+
+  std::vector<std::string> timings;
+  filter_manager_->forEachFilterTimings(
+      [&](absl::string_view name, bool encoder, const FilterTimings& filter_timings) {
+        EXPECT_FALSE(encoder);
+        timings.push_back(absl::StrCat(name, ":", filter_timings.callback_time_.count(), ":",
+                                       filter_timings.stopped_time_.count()));
+      });
+  EXPECT_THAT(timings, testing::ElementsAre("configName1:5000000:20000000",
+                                            "configName2:2000000:3000000"));
+
+  const auto* filter_state_timings =
+      filter_manager_->streamInfo().filterState()->getDataReadOnlyGeneric(
+          FilterManager::FilterTimingsKey);
+  ASSERT_NE(nullptr, filter_state_timings);
+  EXPECT_EQ("configName1:decode:5000:20000,configName2:decode:2000:3000",
+            filter_state_timings->serializeAsString());
+
+  filter_manager_->destroyFilters();
+}
 } // namespace
 } // namespace Http
 } // namespace Envoy
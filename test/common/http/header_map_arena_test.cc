@@ -0,0 +1,94 @@
+#include <list>
+#include <string>
+
+#include "source/common/http/header_map_arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+struct TestEntry {
+  explicit TestEntry(int value) : value_(value) {}
+
+  int value_;
+  char payload_[200];
+};
+
+using TestEntryList = std::list<TestEntry, HeaderMapArenaAllocator<TestEntry>>;
+
+TEST(HeaderMapArenaTest, AllocatesNodesInBlocks) {
+  HeaderMapArena arena(true);
+  {
+    TestEntryList list{HeaderMapArenaAllocator<TestEntry>(arena)};
+    for (int i = 0; i < 40; ++i) {
+      list.emplace_back(i);
+    }
+    // Blocks of 4, 8, 16 and 32 nodes.
+    EXPECT_EQ(4, arena.blocksForTest());
+    int expected = 0;
+    for (const TestEntry& entry : list) {
+      EXPECT_EQ(expected++, entry.value_);
+    }
+  }
+  EXPECT_EQ(4, arena.blocksForTest());
+}
+
+TEST(HeaderMapArenaTest, ReusesErasedNodes) {
+  HeaderMapArena arena(true);
+  TestEntryList list{HeaderMapArenaAllocator<TestEntry>(arena)};
+  for (int i = 0; i < 4; ++i) {
+    list.emplace_back(i);
+  }
+  EXPECT_EQ(1, arena.blocksForTest());
+  const TestEntry* front = &list.front();
+  list.pop_front();
+  list.emplace_back(4);
+  // The erased node is recycled instead of starting a new block.
+  EXPECT_EQ(1, arena.blocksForTest());
+  EXPECT_EQ(front, &list.back());
+
+  list.clear();
+  for (int i = 0; i < 4; ++i) {
+    list.emplace_back(i);
+  }
+  EXPECT_EQ(1, arena.blocksForTest());
+}
+
+TEST(HeaderMapArenaTest, Disabled) {
+  HeaderMapArena arena(false);
+  EXPECT_FALSE(arena.enabled());
+  TestEntryList list{HeaderMapArenaAllocator<TestEntry>(arena)};
+  for (int i = 0; i < 10; ++i) {
+    list.emplace_back(i);
+  }
+  EXPECT_EQ(0, arena.blocksForTest());
+  EXPECT_EQ(10, list.size());
+}
+
+TEST(HeaderMapArenaTest, OtherSizesUseGeneralAllocator) {
+  HeaderMapArena arena(true);
+  void* node = arena.allocate(64);
+  EXPECT_EQ(1, arena.blocksForTest());
+  void* other = arena.allocate(1024);
+  EXPECT_EQ(1, arena.blocksForTest());
+  arena.deallocate(other, 1024);
+  arena.deallocate(node, 64);
+  EXPECT_EQ(node, arena.allocate(64));
+}
+
+TEST(HeaderMapArenaTest, AllocatorEquality) {
+  HeaderMapArena arena1(true);
+  HeaderMapArena arena2(true);
+  HeaderMapArenaAllocator<TestEntry> allocator1(arena1);
+  HeaderMapArenaAllocator<int> allocator1_int(allocator1);
+  HeaderMapArenaAllocator<TestEntry> allocator2(arena2);
+  EXPECT_TRUE(allocator1 == allocator1_int);
+  EXPECT_FALSE(allocator1 != allocator1_int);
+  EXPECT_TRUE(allocator1 != allocator2);
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -1,5 +1,6 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/headers.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "test/test_common/utility.h"
 
@@ -297,6 +298,47 @@ static void headerMapImplRemovePrefix(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplRemovePrefix)->Arg(0)->Arg(1)->Arg(5)->Arg(10)->Arg(50);
 
+/**
+ * Measure the speed of building, walking and destroying a request header map with a varying
+ * number of non-inline headers, with header map entries allocated from the general purpose
+ * allocator (second arg 0) or from the per header map arena (second arg 1).
+ */
+static void headerMapImplCreatePopulateDestroy(benchmark::State& state) {
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_entry_arena",
+                                state.range(1) != 0);
+  const size_t num_headers = state.range(0);
+  std::vector<LowerCaseString> keys;
+  keys.reserve(num_headers);
+  for (size_t i = 0; i < num_headers; i++) {
+    keys.emplace_back("dummy-key-" + std::to_string(i));
+  }
+  uint64_t total_len = 0;
+  for (auto _ : state) { // NOLINT
+    auto headers = Http::RequestHeaderMapImpl::create();
+    headers->setReferenceMethod(Http::Headers::get().MethodValues.Get);
+    headers->setReferencePath("/");
+    headers->setReferenceHost("example.com");
+    for (const LowerCaseString& key : keys) {
+      headers->addReference(key, "abcd");
+    }
+    headers->iterate([&total_len](const HeaderEntry& header) -> HeaderMap::Iterate {
+      total_len += header.key().size() + header.value().size();
+      return HeaderMap::Iterate::Continue;
+    });
+  }
+  benchmark::DoNotOptimize(total_len);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.header_map_entry_arena", false);
+}
+BENCHMARK(headerMapImplCreatePopulateDestroy)
+    ->Args({5, 0})
+    ->Args({5, 1})
+    ->Args({10, 0})
+    ->Args({10, 1})
+    ->Args({40, 0})
+    ->Args({40, 1})
+    ->Args({100, 0})
+    ->Args({100, 1});
+
 class StaticLookupBenchmarker {
 public:
   explicit StaticLookupBenchmarker(std::unique_ptr<HeaderMapImpl> impl)
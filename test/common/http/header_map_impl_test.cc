@@ -233,6 +233,43 @@ TEST(HeaderMapImplTest, Remove) {
   EXPECT_EQ(0UL, headers.remove(Headers::get().ContentLength));
 }
 
+// Exercise insertion, removal, reuse of erased entries and pseudo header ordering with the
+// header map entries allocated from the per header map arena.
+TEST(HeaderMapImplTest, EntryArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.header_map_entry_arena", "true"}});
+
+  TestRequestHeaderMapImpl headers;
+  for (int i = 0; i < 50; i++) {
+    headers.addCopy(LowerCaseString(absl::StrCat("key-", i)), absl::StrCat("value-", i));
+  }
+  headers.setPath("/");
+  EXPECT_EQ(51UL, headers.size());
+  EXPECT_EQ(":path", headers.begin()->key().getStringView());
+
+  for (int i = 0; i < 50; i += 2) {
+    EXPECT_EQ(1UL, headers.remove(LowerCaseString(absl::StrCat("key-", i))));
+  }
+  EXPECT_EQ(26UL, headers.size());
+  for (int i = 0; i < 50; i += 2) {
+    headers.addCopy(LowerCaseString(absl::StrCat("new-key-", i)), "new-value");
+  }
+  EXPECT_EQ(51UL, headers.size());
+  for (int i = 1; i < 50; i += 2) {
+    EXPECT_EQ(absl::StrCat("value-", i),
+              headers.get(LowerCaseString(absl::StrCat("key-", i)))[0]->value().getStringView());
+  }
+  EXPECT_EQ("new-value", headers.get_("new-key-48"));
+
+  TestRequestHeaderMapImpl copy(headers);
+  EXPECT_EQ(headers, copy);
+
+  headers.clear();
+  EXPECT_TRUE(headers.empty());
+  headers.addCopy(LowerCaseString("hello"), "world");
+  EXPECT_EQ("world", headers.get_("hello"));
+}
+
 TEST(HeaderMapImplTest, RemoveHost) {
   TestRequestHeaderMapImpl headers;
   headers.setHost("foo");
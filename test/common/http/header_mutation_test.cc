@@ -317,6 +317,34 @@ TEST(HeaderMutationsTest, BasicOrder) {
   }
 }
 
+TEST(HeaderMutationsTest, LiteralAndEscapedValues) {
+  Server::Configuration::MockServerFactoryContext context;
+
+  ProtoHeaderMutatons proto_mutations;
+  auto append = proto_mutations.Add()->mutable_append();
+  append->mutable_header()->set_key("literal-header");
+  append->mutable_header()->set_value("literal-value");
+  append->set_append_action(ProtoHeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD);
+  append = proto_mutations.Add()->mutable_append();
+  append->mutable_header()->set_key("escaped-header");
+  append->mutable_header()->set_value("100%%");
+  append->set_append_action(ProtoHeaderValueOption::APPEND_IF_EXISTS_OR_ADD);
+
+  auto mutations = HeaderMutations::create(proto_mutations, context).value();
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+
+  for (int i = 0; i < 2; ++i) {
+    Envoy::Http::TestRequestHeaderMapImpl headers = {
+        {"literal-header", "original-value"},
+        {":method", "GET"},
+    };
+
+    mutations->evaluateHeaders(headers, {&headers}, stream_info);
+    EXPECT_EQ("literal-value", headers.get_("literal-header"));
+    EXPECT_EQ("100%", headers.get_("escaped-header"));
+  }
+}
+
 TEST(HeaderMutationTest, Death) {
   Server::Configuration::MockServerFactoryContext context;
 
@@ -0,0 +1,108 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/http/http1/balsa_parser.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+// Parser callbacks that only account for the parsed bytes, so that the benchmarks measure the
+// parser rather than header map construction.
+class CountingParserCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char*, size_t length) override {
+    bytes_ += length;
+    return CallbackResult::Success;
+  }
+  CallbackResult onStatus(const char*, size_t length) override {
+    bytes_ += length;
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeaderField(const char*, size_t length) override {
+    bytes_ += length;
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeaderValue(const char*, size_t length) override {
+    bytes_ += length;
+    return CallbackResult::Success;
+  }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t length) override { bytes_ += length; }
+  CallbackResult onMessageComplete() override {
+    ++messages_;
+    return CallbackResult::Success;
+  }
+  void onChunkHeader(bool) override {}
+
+  uint64_t bytes_{};
+  uint64_t messages_{};
+};
+
+// Parses `input` as a stream of requests handed to the parser in one slice, and checks that
+// `expected_messages` requests were parsed.
+static void parseRequests(benchmark::State& state, const std::string& input,
+                          uint64_t expected_messages) {
+  CountingParserCallbacks callbacks;
+  for (auto _ : state) { // NOLINT
+    BalsaParser parser(MessageType::Request, &callbacks, 80 * 1024, /*enable_trailers=*/false,
+                       /*allow_custom_methods=*/false);
+    callbacks.messages_ = 0;
+    absl::string_view remaining = input;
+    while (!remaining.empty()) {
+      const size_t consumed = parser.execute(remaining.data(), remaining.size());
+      if (parser.getStatus() == ParserStatus::Error || consumed == 0) {
+        state.SkipWithError("parse error");
+        return;
+      }
+      remaining.remove_prefix(consumed);
+    }
+    if (callbacks.messages_ != expected_messages) {
+      state.SkipWithError("unexpected number of messages");
+      return;
+    }
+  }
+  benchmark::DoNotOptimize(callbacks.bytes_);
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+// Pipelined small GET requests of the kind sent by API clients, all delivered in one read.
+static void balsaParserPipelinedSmallRequests(benchmark::State& state) {
+  const uint64_t num_requests = state.range(0);
+  std::string input;
+  for (uint64_t i = 0; i < num_requests; ++i) {
+    absl::StrAppend(&input, "GET /api/v1/items/", i,
+                    " HTTP/1.1\r\n"
+                    "host: api.example.com\r\n"
+                    "user-agent: client/1.0\r\n"
+                    "accept: application/json\r\n"
+                    "x-request-id: 4f6b2a0e-5d2c-4c8e-9a41-0d7c9e2b3f11\r\n"
+                    "\r\n");
+  }
+  parseRequests(state, input, num_requests);
+}
+BENCHMARK(balsaParserPipelinedSmallRequests)->Arg(1)->Arg(16)->Arg(128);
+
+// A single request carrying `state.range(0)` headers with long values, such as cookies and
+// tokens, as seen by browser facing proxies.
+static void balsaParserBigHeaders(benchmark::State& state) {
+  const uint64_t num_headers = state.range(0);
+  const std::string value(state.range(1), 'v');
+  std::string input = "GET /index.html?query=value HTTP/1.1\r\nhost: www.example.com\r\n";
+  for (uint64_t i = 0; i < num_headers; ++i) {
+    absl::StrAppend(&input, "x-custom-header-", i, ": ", value, "\r\n");
+  }
+  absl::StrAppend(&input, "\r\n");
+  parseRequests(state, input, 1);
+}
+BENCHMARK(balsaParserBigHeaders)->Args({10, 64})->Args({40, 128})->Args({20, 2048});
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
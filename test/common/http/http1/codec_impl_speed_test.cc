@@ -0,0 +1,94 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+#include "source/common/http/http1/codec_impl.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+
+// Encodes a response with `state.range(0)` headers followed by a chunk encoded body of
+// `state.range(1)` chunks of `state.range(2)` bytes each, through a server codec whose
+// connection discards everything written to it.
+static void http1EncodeResponse(benchmark::State& state) {
+  const uint64_t num_headers = state.range(0);
+  const uint64_t num_chunks = state.range(1);
+  const std::string chunk(state.range(2), 'a');
+
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<MockServerConnectionCallbacks> callbacks;
+  NiceMock<MockRequestDecoder> decoder;
+  NiceMock<Http1Settings> codec_settings;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  Stats::TestUtil::TestStore store;
+  CodecStats::AtomicPtr codec_stats;
+  ServerConnectionImpl codec(
+      connection, CodecStats::atomicGet(codec_stats, *store.rootScope()), callbacks,
+      codec_settings, Http::DEFAULT_MAX_REQUEST_HEADERS_KB, Http::DEFAULT_MAX_HEADERS_COUNT,
+      envoy::config::core::v3::HttpProtocolOptions::ALLOW, overload_manager);
+
+  uint64_t bytes_written = 0;
+  ON_CALL(connection, write(_, _)).WillByDefault(Invoke([&](Buffer::Instance& data, bool) {
+    bytes_written += data.length();
+    data.drain(data.length());
+  }));
+  ResponseEncoder* response_encoder = nullptr;
+  ON_CALL(callbacks, newStream(_, _))
+      .WillByDefault(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  TestResponseHeaderMapImpl headers{{":status", "200"}, {"content-type", "text/html"}};
+  for (uint64_t i = 0; i < num_headers; ++i) {
+    headers.addCopy(absl::StrCat("x-response-header-", i),
+                    "a6b5c4d3-e2f1-4a0b-9c8d-7e6f5a4b3c2d; max-age=86400");
+  }
+
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    Buffer::OwnedImpl request("GET / HTTP/1.1\r\nhost: www.example.com\r\n\r\n");
+    if (!codec.dispatch(request).ok()) {
+      state.SkipWithError("dispatch failed");
+      break;
+    }
+    state.ResumeTiming();
+
+    response_encoder->encodeHeaders(headers, num_chunks == 0);
+    for (uint64_t i = 0; i < num_chunks; ++i) {
+      Buffer::OwnedImpl data(chunk);
+      response_encoder->encodeData(data, i + 1 == num_chunks);
+    }
+
+    state.PauseTiming();
+    connection.dispatcher_.to_delete_.clear();
+    state.ResumeTiming();
+  }
+  benchmark::DoNotOptimize(bytes_written);
+}
+BENCHMARK(http1EncodeResponse)
+    ->Args({5, 0, 0})
+    ->Args({50, 0, 0})
+    ->Args({5, 16, 1024})
+    ->Args({5, 64, 16384});
+
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
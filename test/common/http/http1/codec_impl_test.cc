@@ -1901,6 +1901,39 @@ TEST_F(Http1ServerConnectionImplTest, ChunkedResponse) {
             output);
 }
 
+TEST_F(Http1ServerConnectionImplTest, ChunkSizeEncoding) {
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "200"}};
+  response_encoder->encodeHeaders(headers, false);
+  output.clear();
+
+  for (const size_t length : {1, 15, 16, 255, 4096, 65537}) {
+    Buffer::OwnedImpl data(std::string(length, 'a'));
+    response_encoder->encodeData(data, false);
+    EXPECT_EQ(absl::StrCat(absl::Hex(length), "\r\n", std::string(length, 'a'), "\r\n"), output);
+    output.clear();
+  }
+  Buffer::OwnedImpl empty;
+  response_encoder->encodeData(empty, true);
+  EXPECT_EQ("0\r\n\r\n", output);
+}
+
 TEST_F(Http1ServerConnectionImplTest, VerifyRequestHeaderTrailerMapMaxLimits) {
   initialize();
   InSequence sequence;
@@ -1195,6 +1195,37 @@ TEST_P(Http2CodecImplTest, TrailingHeadersLargeClientBody) {
   driveToCompletion();
 }
 
+// With DATA frames aligned to slice boundaries, a body made of slices that do not divide the
+// maximum frame size evenly must still arrive intact and in order.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToSlices) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_align_data_frames_to_slices", "true"}});
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, false));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, false).ok());
+  driveToCompletion();
+
+  std::string expected_body;
+  Buffer::OwnedImpl body;
+  for (const size_t slice_size : {100, 10000, 10000, 20000, 3, 16384, 40000, 7}) {
+    const std::string slice(slice_size, static_cast<char>('a' + expected_body.size() % 26));
+    body.appendSliceForTest(slice);
+    expected_body.append(slice);
+  }
+
+  std::string received_body;
+  EXPECT_CALL(request_decoder_, decodeData(_, _))
+      .WillRepeatedly(Invoke([&received_body](Buffer::Instance& data, bool) {
+        received_body.append(data.toString());
+      }));
+  request_encoder_->encodeData(body, true);
+  driveToCompletion();
+  EXPECT_EQ(expected_body, received_body);
+}
+
 TEST_P(Http2CodecImplTest, SmallMetadataVecTest) {
   allow_metadata_ = true;
   initialize();
@@ -1,4 +1,6 @@
 #include <limits>
+#include <string>
+#include <vector>
 
 #include "source/common/http/sse/sse_parser.h"
 
@@ -576,6 +578,50 @@ TEST_F(SseParserTest, ParseEventRetryZero) {
   EXPECT_EQ(parsed.retry.value(), 0);
 }
 
+// Test EventFinder finds the same events as findEventEnd when the stream is received a byte at a
+// time, including a BOM and CRLF line endings split across the chunks.
+TEST_F(SseParserTest, EventFinderByteByByte) {
+  const std::string stream = "\xEF\xBB\xBF"
+                             "data: first\r\n"
+                             ": comment\r\n"
+                             "\r\n"
+                             "event: ping\rdata: second\r\r"
+                             "data: third\n"
+                             "data: more\n\n";
+  SseParser::EventFinder finder;
+  std::vector<std::string> events;
+  size_t buffer_start = 0;
+  for (size_t received = 1; received <= stream.size(); ++received) {
+    while (true) {
+      const absl::string_view buffer(stream.data() + buffer_start, received - buffer_start);
+      const auto expected = SseParser::findEventEnd(buffer, false);
+      const auto result = finder.findEventEnd(buffer, false);
+      EXPECT_EQ(expected.event_start, result.event_start);
+      EXPECT_EQ(expected.event_end, result.event_end);
+      EXPECT_EQ(expected.next_start, result.next_start);
+      if (result.event_start == absl::string_view::npos) {
+        break;
+      }
+      events.emplace_back(buffer.substr(result.event_start, result.event_end - result.event_start));
+      buffer_start += result.next_start;
+    }
+  }
+  EXPECT_EQ((std::vector<std::string>{"data: first\r\n: comment\r\n",
+                                      "event: ping\rdata: second\r", "data: third\ndata: more\n"}),
+            events);
+}
+
+// Test EventFinder scans the buffer from the start again after reset().
+TEST_F(SseParserTest, EventFinderReset) {
+  SseParser::EventFinder finder;
+  EXPECT_EQ(finder.findEventEnd("data: discarded\n", false).event_start, absl::string_view::npos);
+  finder.reset();
+  const auto result = finder.findEventEnd("data: test\n\n", false);
+  EXPECT_EQ(result.event_start, 0);
+  EXPECT_EQ(result.event_end, 11);
+  EXPECT_EQ(result.next_start, 12);
+}
+
 } // namespace
 } // namespace Sse
 } // namespace Http
@@ -0,0 +1,147 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Compares reading the data of a stream socket into a buffer with a read system call after each
+// readiness event, with a readv io_uring operation per read and with a single multishot recv
+// io_uring operation receiving into provided buffers.
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/io/io_uring_impl.h"
+
+#include "test/mocks/io/mocks.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+constexpr uint32_t ReadBufferSize = 16384;
+
+class SocketPair {
+public:
+  SocketPair() { RELEASE_ASSERT(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) == 0, ""); }
+  ~SocketPair() {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  os_fd_t reader() const { return fds_[0]; }
+  void send(const std::string& data) const {
+    RELEASE_ASSERT(write(fds_[1], data.data(), data.size()) == static_cast<ssize_t>(data.size()),
+                   "");
+  }
+
+private:
+  os_fd_t fds_[2];
+};
+
+class BenchmarkRequest : public Request {
+public:
+  BenchmarkRequest() : Request(RequestType::Read, socket_) {}
+
+  testing::NiceMock<MockIoUringSocket> socket_;
+};
+
+// Spins until the next completion of the ring.
+void waitForCompletion(IoUring& io_uring, const CompletionCb& cb) {
+  bool completed = false;
+  while (!completed) {
+    io_uring.forEveryCompletion([&](Request* req, int32_t result, bool injected) {
+      completed = true;
+      cb(req, result, injected);
+    });
+  }
+}
+
+void readSyscall(benchmark::State& state) {
+  const std::string data(state.range(0), 'a');
+  SocketPair sockets;
+  Buffer::OwnedImpl buffer;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    sockets.send(data);
+    Buffer::Reservation reservation = buffer.reserveForRead();
+    const ssize_t result = readv(sockets.reader(), reinterpret_cast<iovec*>(reservation.slices()),
+                                 reservation.numSlices());
+    RELEASE_ASSERT(result > 0, "");
+    reservation.commit(result);
+    buffer.drain(buffer.length());
+  }
+}
+BENCHMARK(readSyscall)->Arg(64)->Arg(4096)->Arg(16384);
+
+void ioUringReadv(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  const std::string data(state.range(0), 'a');
+  SocketPair sockets;
+  IoUringImpl io_uring(64, false);
+  io_uring.registerEventfd();
+  BenchmarkRequest req;
+  Buffer::OwnedImpl buffer;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    sockets.send(data);
+    // Like the io_uring worker, allocate a buffer for each read and hand it to the connection.
+    auto read_buf = std::make_unique<uint8_t[]>(ReadBufferSize);
+    iovec iov{read_buf.get(), ReadBufferSize};
+    io_uring.prepareReadv(sockets.reader(), &iov, 1, 0, &req);
+    io_uring.submit();
+    waitForCompletion(io_uring, [&](Request*, int32_t result, bool) {
+      RELEASE_ASSERT(result > 0, "");
+      buffer.addBufferFragment(*new Buffer::BufferFragmentImpl(
+          read_buf.release(), result,
+          [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+            delete[] static_cast<const uint8_t*>(data);
+            delete this_fragment;
+          }));
+    });
+    buffer.drain(buffer.length());
+  }
+}
+BENCHMARK(ioUringReadv)->Arg(64)->Arg(4096)->Arg(16384);
+
+void ioUringRecvMultishot(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  const std::string data(state.range(0), 'a');
+  SocketPair sockets;
+  IoUringImpl io_uring(64, false);
+  io_uring.registerEventfd();
+  if (!io_uring.setupProvidedBuffers(256, ReadBufferSize)) {
+    state.SkipWithError("provided buffer rings are not supported");
+    return;
+  }
+  BenchmarkRequest req;
+  Buffer::OwnedImpl buffer;
+  io_uring.prepareRecvMultishot(sockets.reader(), &req);
+  io_uring.submit();
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    sockets.send(data);
+    waitForCompletion(io_uring, [&](Request* completed_req, int32_t result, bool) {
+      RELEASE_ASSERT(result > 0 && completed_req->hasMoreCompletions(), "");
+      buffer.addBufferFragment(
+          *io_uring.takeProvidedBuffer(completed_req->providedBuffer().value(), result));
+    });
+    buffer.drain(buffer.length());
+  }
+}
+BENCHMARK(ioUringRecvMultishot)->Arg(64)->Arg(4096)->Arg(16384);
+
+} // namespace
+} // namespace Io
+} // namespace Envoy
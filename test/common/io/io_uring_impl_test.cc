@@ -1,5 +1,8 @@
+#include <sys/socket.h>
+
 #include <functional>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/io/io_uring_impl.h"
 #include "source/common/network/address_impl.h"
 
@@ -401,6 +404,62 @@ TEST_F(IoUringImplTest, PrepareReadvQueueOverflow) {
   EXPECT_EQ(static_cast<char*>(iov3.iov_base)[1], 'f');
 }
 
+TEST_F(IoUringImplTest, PrepareRecvMultishot) {
+  if (!io_uring_->setupProvidedBuffers(2, 16)) {
+    GTEST_SKIP() << "provided buffer rings are not supported";
+  }
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+
+  auto dispatcher = api_->allocateDispatcher("test_thread");
+
+  os_fd_t event_fd = io_uring_->registerEventfd();
+  const Event::FileTriggerType trigger = Event::PlatformDefaultTriggerType;
+  int data = 0;
+  TestRequest request(data);
+  Buffer::OwnedImpl received;
+  int32_t completions_nr = 0;
+  bool more_completions = true;
+  auto file_event = dispatcher->createFileEvent(
+      event_fd,
+      [this, &completions_nr, &more_completions, &received](uint32_t) {
+        io_uring_->forEveryCompletion([this, &completions_nr, &more_completions,
+                                       &received](Request* req, int32_t res, bool) {
+          completions_nr++;
+          more_completions = req->hasMoreCompletions();
+          if (res > 0) {
+            ASSERT_TRUE(req->providedBuffer().has_value());
+            received.addBufferFragment(
+                *io_uring_->takeProvidedBuffer(req->providedBuffer().value(), res));
+          }
+        });
+        return absl::OkStatus();
+      },
+      trigger, Event::FileReadyType::Read);
+
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->prepareRecvMultishot(fds[0], &request));
+  EXPECT_EQ(IoUringResult::Ok, io_uring_->submit());
+
+  // A single request completes for every write.
+  ASSERT_EQ(5, write(fds[1], "hello", 5));
+  waitForCondition(*dispatcher, [&received]() { return received.length() == 5; });
+  ASSERT_EQ(6, write(fds[1], " world", 6));
+  waitForCondition(*dispatcher, [&received]() { return received.length() == 11; });
+  EXPECT_EQ("hello world", received.toString());
+  EXPECT_TRUE(more_completions);
+
+  // Both buffers are in use until the received data is drained, which gives them back.
+  received.drain(received.length());
+  ASSERT_EQ(1, write(fds[1], "!", 1));
+  waitForCondition(*dispatcher, [&received]() { return received.length() == 1; });
+
+  // The request terminates when the peer closes the connection.
+  close(fds[1]);
+  waitForCondition(*dispatcher, [&more_completions]() { return !more_completions; });
+  EXPECT_EQ(4, completions_nr);
+  close(fds[0]);
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
@@ -33,8 +33,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t provided_buffer_count = 0, uint32_t zero_copy_send_threshold = 0)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher,
+                          provided_buffer_count, zero_copy_send_threshold) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -335,6 +337,200 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_EQ(0, worker.getSockets().size());
 }
 
+TEST(IoUringWorkerImplTest, ServerSocketMultishotRecv) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, setupProvidedBuffers(16, 8192)).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 16);
+  EXPECT_TRUE(worker.multishotRecvEnabled());
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  // A read enabled server socket submits a multishot recv request.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  IoUringSocket* socket = nullptr;
+  std::string read_data;
+  socket = &worker.addServerSocket(
+      fd,
+      [&socket, &read_data](uint32_t events) {
+        EXPECT_EQ(events, Event::FileReadyType::Read);
+        Buffer::Instance& buf = socket->getReadParam()->buf_;
+        read_data += buf.toString();
+        buf.drain(buf.length());
+        return absl::OkStatus();
+      },
+      false);
+
+  // The received data is handed over in the provided buffer, which is given back once drained.
+  char data[] = "hello";
+  bool released = false;
+  EXPECT_CALL(mock_io_uring, takeProvidedBuffer(3, 5))
+      .WillOnce(Invoke([&data, &released](uint16_t, uint32_t length) {
+        return new Buffer::BufferFragmentImpl(
+            data, length,
+            [&released](const void*, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+              released = true;
+              delete this_fragment;
+            });
+      }));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionDetails(true, 3);
+        cb(read_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", read_data);
+  EXPECT_TRUE(released);
+
+  // Running out of provided buffers ends the multishot recv request and falls back to a readv
+  // request, instead of an error.
+  Request* readv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&readv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) {
+        read_req->setCompletionDetails(false, absl::nullopt);
+        cb(read_req, -ENOBUFS, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", read_data);
+
+  // Close the socket, which cancels the readv request.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(readv_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&readv_req, &cancel_req](const CompletionCb& cb) {
+        cb(readv_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
+TEST(IoUringWorkerImplTest, ServerSocketZeroCopyWrite) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  EXPECT_CALL(mock_io_uring, isZeroCopySendSupported()).WillOnce(Return(true));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, 4);
+  EXPECT_EQ(4, worker.zeroCopySendThreshold());
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  auto& io_uring_socket =
+      worker.addServerSocket(fd, [](uint32_t) { return absl::OkStatus(); }, false);
+
+  // A write of at least the threshold is sent with zero copy.
+  Buffer::OwnedImpl buf("Hello");
+  Request* write_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareSendmsgZeroCopy(fd, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.write(buf);
+  EXPECT_EQ("Hello", static_cast<ZeroCopyWriteRequest*>(write_req)->data_.toString());
+
+  // On a short send, the unsent data is written again, which is below the threshold.
+  const struct iovec* iovecs = nullptr;
+  Request* writev_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareWritev(fd, _, 1, _, _))
+      .WillOnce(DoAll(SaveArg<1>(&iovecs), SaveArg<4>(&writev_req),
+                      Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&write_req](const CompletionCb& cb) {
+        write_req->setCompletionDetails(true, absl::nullopt);
+        cb(write_req, 3, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("lo", absl::string_view(static_cast<const char*>(iovecs[0].iov_base),
+                                    iovecs[0].iov_len));
+  // The sent data is kept until the notification.
+  EXPECT_EQ("Hello", static_cast<ZeroCopyWriteRequest*>(write_req)->data_.toString());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&write_req, &writev_req](const CompletionCb& cb) {
+        write_req->setCompletionDetails(false, absl::nullopt, true);
+        cb(write_req, 0, false);
+        cb(writev_req, 2, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  io_uring_socket.close(false);
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req, &cancel_req](const CompletionCb& cb) {
+        cb(read_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareClose(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_EQ(0, worker.getSockets().size());
+}
+
 TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
   Event::MockDispatcher dispatcher;
   IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
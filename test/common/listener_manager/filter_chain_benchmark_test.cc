@@ -8,6 +8,7 @@
 #include "envoy/protobuf/message_validator.h"
 
 #include "source/common/listener_manager/filter_chain_manager_impl.h"
+#include "source/common/memory/stats.h"
 #include "source/common/network/socket_impl.h"
 
 #include "test/benchmark/main.h"
@@ -211,6 +212,33 @@ public:
     filter_chains_ = listener_config_.filter_chains();
   }
 
+  // A filter chain per few server names, and a filter chain matching many server names.
+  void initializeServerNames(::benchmark::State& state) {
+    int64_t input_size = state.range(0);
+    listener_yaml_config_ = TestEnvironment::substitute(
+        absl::StrCat(YamlHeader, YamlSingleServer), Network::Address::IpVersion::v4);
+    TestUtility::loadFromYaml(listener_yaml_config_, listener_config_);
+    const envoy::config::listener::v3::FilterChain server_chain = listener_config_.filter_chains(1);
+    listener_config_.mutable_filter_chains()->RemoveLast();
+    for (int i = 0; i < input_size; i++) {
+      auto* filter_chain = listener_config_.add_filter_chains();
+      *filter_chain = server_chain;
+      filter_chain->mutable_filter_chain_match()->clear_server_names();
+      for (int j = 0; j < 4; j++) {
+        filter_chain->mutable_filter_chain_match()->add_server_names(
+            absl::StrCat("server", i, "-", j, ".example.com"));
+      }
+    }
+    auto* shared_chain = listener_config_.add_filter_chains();
+    *shared_chain = server_chain;
+    shared_chain->mutable_filter_chain_match()->clear_server_names();
+    for (int i = 0; i < input_size; i++) {
+      shared_chain->mutable_filter_chain_match()->add_server_names(
+          absl::StrCat("shared", i, ".example.com"));
+    }
+    filter_chains_ = listener_config_.filter_chains();
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   Logger::Context logging_state_{spdlog::level::warn, Logger::Logger::DEFAULT_LOG_FORMAT, lock_,
                                  false};
@@ -270,6 +298,60 @@ BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainFindTest)
     }
   }
 }
+// NOLINTNEXTLINE(readability-redundant-member-init)
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainServerNamesBuildTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+    FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+    THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                         dummy_builder_, filter_chain_manager));
+    state.counters["memory"] = Memory::Stats::totalCurrentlyAllocated() - start_mem;
+  }
+}
+
+BENCHMARK_DEFINE_F(FilterChainBenchmarkFixture, FilterChainServerNamesFindTest)
+(::benchmark::State& state) {
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 64) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  initializeServerNames(state);
+  std::vector<MockConnectionSocket> sockets;
+  sockets.reserve(state.range(0));
+  for (int i = 0; i < state.range(0); i++) {
+    const std::string server_name = i % 2 == 0 ? absl::StrCat("server", i, "-0.example.com")
+                                               : absl::StrCat("shared", i, ".example.com");
+    sockets.push_back(std::move(*MockConnectionSocket::createMockConnectionSocket(
+        1234, "127.0.0.1", server_name, "", "tls", {}, "8.8.8.8", 111)));
+  }
+  NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  addresses.emplace_back(std::make_shared<Network::Address::Ipv4Instance>("127.0.0.1", 1234));
+  FilterChainManagerImpl filter_chain_manager{addresses, factory_context, init_manager_};
+
+  THROW_IF_NOT_OK(filter_chain_manager.addFilterChains(nullptr, filter_chains_, nullptr,
+                                                       dummy_builder_, filter_chain_manager));
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (int i = 0; i < state.range(0); i++) {
+      filter_chain_manager.findFilterChain(sockets[i], stream_info);
+    }
+  }
+}
+
 BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainManagerBuildTest)
     ->Ranges({
         // scale of the chains
@@ -282,6 +364,18 @@ BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainFindTest)
         {1, 4096},
     })
     ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainServerNamesBuildTest)
+    ->Ranges({
+        // scale of the server names
+        {16, 4096},
+    })
+    ->Unit(::benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(FilterChainBenchmarkFixture, FilterChainServerNamesFindTest)
+    ->Ranges({
+        // scale of the server names
+        {16, 4096},
+    })
+    ->Unit(::benchmark::kMillisecond);
 
 /*
 clang-format off
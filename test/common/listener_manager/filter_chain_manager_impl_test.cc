@@ -351,6 +351,80 @@ TEST_P(FilterChainManagerImplTest, DuplicateFilterChainMatchFails) {
   );
 }
 
+// A filter chain matching many server names shares a single subtree between them, which must not
+// be shared with the server names whose subtrees differ.
+TEST_P(FilterChainManagerImplTest, ManyServerNamesShareSubtrees) {
+  envoy::config::listener::v3::FilterChain tls_filter_chain = filter_chain_template_;
+  tls_filter_chain.set_name("tls");
+  tls_filter_chain.mutable_filter_chain_match()->set_transport_protocol("tls");
+  for (int i = 0; i < 100; i++) {
+    tls_filter_chain.mutable_filter_chain_match()->add_server_names(
+        absl::StrCat("server", i, ".example.com"));
+  }
+  envoy::config::listener::v3::FilterChain raw_filter_chain = filter_chain_template_;
+  raw_filter_chain.set_name("raw");
+  raw_filter_chain.mutable_filter_chain_match()->set_transport_protocol("raw_buffer");
+  raw_filter_chain.mutable_filter_chain_match()->add_server_names("server0.example.com");
+
+  auto tls_chain = std::make_shared<Network::MockFilterChain>();
+  auto raw_chain = std::make_shared<Network::MockFilterChain>();
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _, _))
+      .WillOnce(Return(tls_chain))
+      .WillOnce(Return(raw_chain));
+  EXPECT_TRUE(filter_chain_manager_
+                  ->addFilterChains(nullptr,
+                                    std::vector<const envoy::config::listener::v3::FilterChain*>{
+                                        &tls_filter_chain, &raw_filter_chain},
+                                    nullptr, filter_chain_factory_builder_, *filter_chain_manager_)
+                  .ok());
+
+  EXPECT_EQ(tls_chain.get(), findFilterChainHelper(10000, "127.0.0.1", "server0.example.com", "tls",
+                                                   {}, "8.8.8.8", 111));
+  EXPECT_EQ(tls_chain.get(), findFilterChainHelper(10000, "127.0.0.1", "server99.example.com",
+                                                   "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(raw_chain.get(), findFilterChainHelper(10000, "127.0.0.1", "server0.example.com",
+                                                   "raw_buffer", {}, "8.8.8.8", 111));
+  EXPECT_EQ(nullptr, findFilterChainHelper(10000, "127.0.0.1", "server1.example.com",
+                                           "raw_buffer", {}, "8.8.8.8", 111));
+  EXPECT_EQ(nullptr, findFilterChainHelper(10000, "127.0.0.1", "server100.example.com", "tls", {},
+                                           "8.8.8.8", 111));
+}
+
+// Filter chains without IP requirements match every address, including non IP addresses, whether
+// or not the other filter chains have IP requirements.
+TEST_P(FilterChainManagerImplTest, CatchAllIpsMatchEveryAddress) {
+  envoy::config::listener::v3::FilterChain any_filter_chain = filter_chain_template_;
+  any_filter_chain.set_name("any");
+  any_filter_chain.mutable_filter_chain_match()->clear_destination_port();
+  envoy::config::listener::v3::FilterChain source_filter_chain = any_filter_chain;
+  source_filter_chain.set_name("source");
+  source_filter_chain.mutable_filter_chain_match()->add_server_names("source.example.com");
+  auto* source_range = source_filter_chain.mutable_filter_chain_match()->add_source_prefix_ranges();
+  source_range->set_address_prefix("10.0.0.0");
+  source_range->mutable_prefix_len()->set_value(8);
+
+  auto any_chain = std::make_shared<Network::MockFilterChain>();
+  auto source_chain = std::make_shared<Network::MockFilterChain>();
+  EXPECT_CALL(filter_chain_factory_builder_, buildFilterChain(_, _, _))
+      .WillOnce(Return(any_chain))
+      .WillOnce(Return(source_chain));
+  EXPECT_TRUE(filter_chain_manager_
+                  ->addFilterChains(nullptr,
+                                    std::vector<const envoy::config::listener::v3::FilterChain*>{
+                                        &any_filter_chain, &source_filter_chain},
+                                    nullptr, filter_chain_factory_builder_, *filter_chain_manager_)
+                  .ok());
+
+  EXPECT_EQ(any_chain.get(),
+            findFilterChainHelper(10000, "127.0.0.1", "", "tls", {}, "8.8.8.8", 111));
+  EXPECT_EQ(any_chain.get(), findFilterChainHelper(0, "/tmp/test.sock", "", "tls", {},
+                                                   "/tmp/test.sock", 0));
+  EXPECT_EQ(source_chain.get(), findFilterChainHelper(10000, "127.0.0.1", "source.example.com",
+                                                      "tls", {}, "10.1.2.3", 111));
+  EXPECT_EQ(nullptr, findFilterChainHelper(10000, "127.0.0.1", "source.example.com", "tls", {},
+                                           "8.8.8.8", 111));
+}
+
 INSTANTIATE_TEST_SUITE_P(Matcher, FilterChainManagerImplTest, ::testing::Values(true, false));
 
 } // namespace Server
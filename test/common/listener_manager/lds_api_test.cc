@@ -4,6 +4,7 @@
 #include "envoy/config/listener/v3/listener.pb.h"
 #include "envoy/service/discovery/v3/discovery.pb.h"
 
+#include "source/common/config/decoded_resource_impl.h"
 #include "source/common/listener_manager/lds_api.h"
 #include "source/common/protobuf/utility.h"
 
@@ -212,6 +213,47 @@ TEST_F(LdsApiTest, ValidateDuplicateListeners) {
             "listener duplicate_listener found\n");
 }
 
+// Validate that a listener unchanged on the wire since it was last applied is skipped while it
+// exists.
+TEST_F(LdsApiTest, SkipUnchangedListener) {
+  InSequence s;
+
+  setup();
+
+  auto update = [this](uint64_t content_hash, const std::string& version) {
+    Protobuf::Any resource;
+    resource.PackFrom(buildListener("listener_0"));
+    TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::listener::v3::Listener> decoder(
+        "name");
+    Config::DecodedResourcesWrapper decoded_resources;
+    decoded_resources.pushBack((*Config::DecodedResourceImpl::fromResource(decoder, resource, ""))
+                                   ->withVersion(version, content_hash));
+    EXPECT_TRUE(lds_callbacks_->onConfigUpdate(decoded_resources.refvec_, {}, version).ok());
+  };
+
+  EXPECT_CALL(listener_manager_, beginListenerUpdate());
+  expectAdd("listener_0", "1", true);
+  EXPECT_CALL(listener_manager_, endListenerUpdate(_));
+  EXPECT_CALL(init_watcher_, ready());
+  update(1, "1");
+
+  NiceMock<Network::MockListenerConfig> listener;
+  listener.name_ = "listener_0";
+  std::vector<std::reference_wrapper<Network::ListenerConfig>> existing_listeners{listener};
+  EXPECT_CALL(listener_manager_, beginListenerUpdate());
+  EXPECT_CALL(listener_manager_, listeners(ListenerManager::WARMING | ListenerManager::ACTIVE))
+      .WillOnce(Return(existing_listeners));
+  EXPECT_CALL(listener_manager_, endListenerUpdate(_));
+  update(1, "2");
+
+  EXPECT_CALL(listener_manager_, beginListenerUpdate());
+  EXPECT_CALL(listener_manager_, listeners(ListenerManager::WARMING | ListenerManager::ACTIVE))
+      .WillOnce(Return(std::vector<std::reference_wrapper<Network::ListenerConfig>>{}));
+  expectAdd("listener_0", "3", true);
+  EXPECT_CALL(listener_manager_, endListenerUpdate(_));
+  update(1, "3");
+}
+
 TEST_F(LdsApiTest, Basic) {
   InSequence s;
 
@@ -275,7 +317,7 @@ TEST_F(LdsApiTest, Basic) {
 
   makeListenersAndExpectCall({"listener1", "listener2"});
   EXPECT_CALL(listener_manager_, removeListener("listener2")).WillOnce(Return(true));
-  expectAdd("listener1", "1", false);
+  // listener1 is unchanged on the wire, so is skipped without the listener manager hashing it.
   expectAdd("listener3", "1", true);
   EXPECT_CALL(listener_manager_, endListenerUpdate(_));
   const auto decoded_resources_2 =
@@ -484,7 +526,7 @@ TEST_F(LdsApiTest, ReplacingListenerWithSameAddress) {
 
   makeListenersAndExpectCall({"listener1", "listener2"});
   EXPECT_CALL(listener_manager_, removeListener("listener2")).WillOnce(Return(true));
-  expectAdd("listener1", "1", false);
+  // listener1 is unchanged on the wire, so is skipped without the listener manager hashing it.
   expectAdd("listener3", "1", true);
   EXPECT_CALL(listener_manager_, endListenerUpdate(_));
   const auto decoded_resources_2 =
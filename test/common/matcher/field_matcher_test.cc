@@ -117,5 +117,55 @@ TEST_F(FieldMatcherTest, NotMatcher) {
       MatchResult::InsufficientData);
 }
 
+// A DataInput counting its extractions.
+struct CountingInput : public DataInput<TestData> {
+  explicit CountingInput(uint32_t& count) : count_(count) {}
+  DataInputGetResult get(const TestData&) const override {
+    count_++;
+    return {DataInputGetResult::DataAvailability::AllDataAvailable, std::string("foo")};
+  }
+  uint32_t& count_;
+};
+
+TEST_F(FieldMatcherTest, SharedInputs) {
+  auto shared_inputs = std::make_shared<SharedMatchInputs>();
+  const uint32_t index = shared_inputs->add("foo");
+  EXPECT_EQ(shared_inputs->add("foo"), index);
+  const uint32_t other_index = shared_inputs->add("bar");
+  EXPECT_TRUE(shared_inputs->anyShared());
+  EXPECT_EQ(shared_inputs->slot(other_index), SharedMatchInputs::NoSlot);
+
+  uint32_t count = 0;
+  auto first = SingleFieldMatcher<TestData>::create(std::make_unique<CountingInput>(count),
+                                                    std::make_unique<BoolMatcher>(true),
+                                                    shared_inputs, shared_inputs->slot(index))
+                   .value();
+  auto second = SingleFieldMatcher<TestData>::create(std::make_unique<CountingInput>(count),
+                                                     std::make_unique<BoolMatcher>(true),
+                                                     shared_inputs, shared_inputs->slot(index))
+                    .value();
+
+  // The input is extracted once per evaluation of the tree.
+  {
+    MatchInputCache cache(*shared_inputs);
+    EXPECT_EQ(first->match(TestData()), MatchResult::Matched);
+    EXPECT_EQ(second->match(TestData()), MatchResult::Matched);
+    EXPECT_EQ(count, 1);
+  }
+  {
+    MatchInputCache cache(*shared_inputs);
+    EXPECT_EQ(second->match(TestData()), MatchResult::Matched);
+    EXPECT_EQ(count, 2);
+  }
+
+  // And on every match outside of an evaluation, or during the evaluation of another tree.
+  EXPECT_EQ(first->match(TestData()), MatchResult::Matched);
+  EXPECT_EQ(count, 3);
+  SharedMatchInputs other_inputs;
+  MatchInputCache cache(other_inputs);
+  EXPECT_EQ(first->match(TestData()), MatchResult::Matched);
+  EXPECT_EQ(count, 4);
+}
+
 } // namespace Matcher
 } // namespace Envoy
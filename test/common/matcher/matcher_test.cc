@@ -1143,6 +1143,77 @@ TEST_P(MatcherAmbiguousTest, KeepMatchingWithFailingNestedMatcher) {
   EXPECT_THAT(skipped_results, ElementsAre(IsStringAction("match")));
 }
 
+// Returns a list of exact matches of the string input, with an action per value.
+std::string exactMatchListYaml(const std::vector<std::string>& values) {
+  std::string yaml = R"EOF(
+    matcher_list:
+      matchers:)EOF";
+  for (const std::string& value : values) {
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+      - on_match:
+          action:
+            name: test_action
+            typed_config:
+              "@type": type.googleapis.com/google.protobuf.StringValue
+              value: {0}
+        predicate:
+          single_predicate:
+            input:
+              name: input
+              typed_config:
+                "@type": type.googleapis.com/google.protobuf.StringValue
+            value_match:
+              exact: {0})EOF",
+                                       value));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+    on_no_match:
+      action:
+        name: test_action
+        typed_config:
+          "@type": type.googleapis.com/google.protobuf.StringValue
+          value: no-match
+      )EOF");
+  return yaml;
+}
+
+TEST_P(MatcherAmbiguousTest, ExactMatchListRewrittenIntoMap) {
+  auto input_factory = TestDataInputStringFactory("foo");
+
+  // The input of the map is created and validated once.
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.StringValue"));
+  auto matcher = createMatcherFromYaml(exactMatchListYaml({"a", "b", "foo", "c"}))();
+  EXPECT_NE(dynamic_cast<ListExactMapMatcher<TestData>*>(matcher.get()), nullptr);
+  EXPECT_THAT(evaluateMatch(*matcher, TestData()), HasStringAction("foo"));
+
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.StringValue"));
+  matcher = createMatcherFromYaml(exactMatchListYaml({"a", "b", "c", "d"}))();
+  EXPECT_THAT(evaluateMatch(*matcher, TestData()), HasStringAction("no-match"));
+}
+
+TEST_P(MatcherAmbiguousTest, ExactMatchListNotRewrittenIntoMap) {
+  auto input_factory = TestDataInputStringFactory("foo");
+
+  // The first match of a duplicated value wins in a list.
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.StringValue"))
+      .Times(4);
+  auto matcher = createMatcherFromYaml(exactMatchListYaml({"a", "foo", "b", "foo"}))();
+  EXPECT_EQ(dynamic_cast<ListExactMapMatcher<TestData>*>(matcher.get()), nullptr);
+  EXPECT_THAT(evaluateMatch(*matcher, TestData()), HasStringAction("foo"));
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.optimize_match_trees", "false"}});
+  EXPECT_CALL(validation_visitor_,
+              performDataInputValidation(_, "type.googleapis.com/google.protobuf.StringValue"))
+      .Times(4);
+  matcher = createMatcherFromYaml(exactMatchListYaml({"a", "b", "foo", "c"}))();
+  EXPECT_EQ(dynamic_cast<ListExactMapMatcher<TestData>*>(matcher.get()), nullptr);
+  EXPECT_THAT(evaluateMatch(*matcher, TestData()), HasStringAction("foo"));
+}
+
 TEST(MatchResultTest, toString) {
   EXPECT_EQ(MatchResultToString(Matcher::MatchResult::NoMatch), "no match");
   EXPECT_EQ(MatchResultToString(Matcher::MatchResult::InsufficientData), "insufficient data");
@@ -138,6 +138,51 @@ TEST_F(MemoryReleaseTest, ReleaseRateAboveZeroCustomIntervalMemoryReleased) {
 #endif
 }
 
+TEST(AllocatorManagerTest, AdaptiveBytesToRelease) {
+  // Nothing is released while the free bytes stay below the retained ones.
+  EXPECT_EQ(0, AllocatorManager::adaptiveBytesToRelease(4 * MB, 8 * MB, 10, 0));
+  EXPECT_EQ(0, AllocatorManager::adaptiveBytesToRelease(8 * MB, 8 * MB, 10, 0));
+  // A share of the free bytes above the retained ones, bounded if requested.
+  EXPECT_EQ(2 * MB, AllocatorManager::adaptiveBytesToRelease(28 * MB, 8 * MB, 10, 0));
+  EXPECT_EQ(MB, AllocatorManager::adaptiveBytesToRelease(28 * MB, 8 * MB, 10, MB));
+  EXPECT_EQ(20 * MB, AllocatorManager::adaptiveBytesToRelease(28 * MB, 8 * MB, 100, 0));
+}
+
+TEST_F(MemoryReleaseTest, AdaptiveReleaseMemoryReleased) {
+  size_t initial_allocated_bytes = Stats::totalCurrentlyAllocated();
+  auto a = std::make_unique<uint32_t[]>(40 * MB);
+  if (Stats::totalCurrentlyAllocated() <= initial_allocated_bytes) {
+    GTEST_SKIP() << "Skipping test, cannot measure memory usage precisely on this platform.";
+  }
+  const auto proto_config =
+      TestUtility::parseYaml<envoy::config::bootstrap::v3::MemoryAllocatorManager>(R"EOF(
+  memory_release_interval: 1s
+  adaptive_release:
+    release_percent:
+      value: 50
+)EOF");
+#if defined(GPERFTOOLS_TCMALLOC)
+  EXPECT_LOG_CONTAINS("error",
+                      "Memory releasing is not supported for gperf tcmalloc, no memory releasing "
+                      "will be configured.",
+                      allocator_manager_ = std::make_unique<Memory::AllocatorManager>(
+                          *api_, scope_, proto_config));
+#elif defined(TCMALLOC)
+  auto initial_unmapped_bytes = Stats::totalPageHeapUnmapped();
+  EXPECT_LOG_CONTAINS(
+      "info",
+      "Configured tcmalloc with adaptive background release: 50% of the free bytes above 0 bytes "
+      "per 1000 milliseconds",
+      allocator_manager_ =
+          std::make_unique<Memory::AllocatorManager>(*api_, scope_, proto_config));
+  a.reset();
+  step(std::chrono::milliseconds(1000));
+  EXPECT_TRUE(TestUtility::waitForCounterEq(
+      stats_, "memory_release_test.tcmalloc.released_by_timer", 1UL, time_system_));
+  EXPECT_LT(initial_unmapped_bytes, Stats::totalPageHeapUnmapped());
+#endif
+}
+
 } // namespace
 } // namespace Memory
 } // namespace Envoy
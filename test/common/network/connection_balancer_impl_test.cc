@@ -0,0 +1,102 @@
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  explicit TestBalancedConnectionHandler(uint64_t num_connections)
+      : num_connections_(num_connections) {}
+
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool,
+                      const absl::optional<std::string>&) override {}
+
+  uint64_t num_connections_;
+};
+
+class LoadAwareConnectionBalancerImplTest : public testing::Test {
+protected:
+  LoadAwareConnectionBalancerImplTest()
+      : timer_(new NiceMock<Event::MockTimer>(&tls_.dispatcher_)),
+        balancer_(tls_, random_, std::chrono::milliseconds(100)) {}
+
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  Event::MockTimer* timer_;
+  LoadAwareConnectionBalancerImpl balancer_;
+};
+
+TEST_F(LoadAwareConnectionBalancerImplTest, NoHandlers) {
+  TestBalancedConnectionHandler current(0);
+  EXPECT_EQ(&current, &balancer_.pickTargetHandler(current));
+  EXPECT_EQ(1, current.num_connections_);
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, PicksLessLoadedOfTwo) {
+  TestBalancedConnectionHandler handler0(5);
+  TestBalancedConnectionHandler handler1(2);
+  TestBalancedConnectionHandler handler2(9);
+  balancer_.registerHandler(handler0);
+  balancer_.registerHandler(handler1);
+  balancer_.registerHandler(handler2);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(&handler1, &balancer_.pickTargetHandler(handler0));
+  EXPECT_EQ(3, handler1.num_connections_);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(2)).WillOnce(Return(3));
+  EXPECT_EQ(&handler0, &balancer_.pickTargetHandler(handler2));
+  EXPECT_EQ(6, handler0.num_connections_);
+  EXPECT_EQ(9, handler2.num_connections_);
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, UnregisteredHandlers) {
+  TestBalancedConnectionHandler handler0(5);
+  TestBalancedConnectionHandler handler1(2);
+  balancer_.registerHandler(handler0);
+  balancer_.registerHandler(handler1);
+  balancer_.unregisterHandler(handler1);
+
+  // The unregistered handler is never picked.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(&handler0, &balancer_.pickTargetHandler(handler0));
+  EXPECT_EQ(6, handler0.num_connections_);
+
+  // Without any registered handler picked, the connection stays on the current handler.
+  balancer_.unregisterHandler(handler0);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(&handler1, &balancer_.pickTargetHandler(handler1));
+  EXPECT_EQ(3, handler1.num_connections_);
+
+  // The slot of an unregistered handler is reused.
+  TestBalancedConnectionHandler handler2(0);
+  balancer_.registerHandler(handler2);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(&handler2, &balancer_.pickTargetHandler(handler1));
+  EXPECT_EQ(1, handler2.num_connections_);
+}
+
+TEST_F(LoadAwareConnectionBalancerImplTest, ProbeRearmsTimer) {
+  EXPECT_CALL(*timer_, enableTimer(std::chrono::milliseconds(100), _));
+  timer_->invokeCallback();
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -1,4 +1,5 @@
 #include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
 #include "source/common/network/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -50,6 +51,31 @@ struct CidrInputs {
       tag_data_minimal_;
 };
 
+struct LargeCidrInputs {
+  LargeCidrInputs() {
+    // Construct 131,072 /24 prefixes in 10.0.0.0/8 and 11.0.0.0/8 with a tag each, the size of
+    // the feeds of geo or threat intelligence ranges, and addresses spread over them.
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 256; j++) {
+        for (int k = 0; k < 256; k++) {
+          tag_data_.emplace_back(
+              std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>(
+                  {fmt::format("tag_{}_{}", i, j),
+                   {*Envoy::Network::Address::CidrRange::create(
+                       fmt::format("{}.{}.{}.0/24", 10 + i, j, k))}}));
+        }
+      }
+    }
+    for (int i = 0; i < 1024; i++) {
+      addresses_.push_back(Envoy::Network::Utility::parseInternetAddressNoThrow(
+          fmt::format("{}.{}.{}.1", 10 + i % 3, (i * 37) % 256, (i * 101) % 256)));
+    }
+  }
+
+  std::vector<std::pair<std::string, std::vector<Envoy::Network::Address::CidrRange>>> tag_data_;
+  std::vector<Envoy::Network::Address::InstanceConstSharedPtr> addresses_;
+};
+
 } // namespace
 
 namespace Envoy {
@@ -153,4 +179,122 @@ static void lcTrieLookupMinimal(benchmark::State& state) {
 
 BENCHMARK(lcTrieLookupMinimal);
 
+static void lcTrieLookupLarge(benchmark::State& state) {
+  LargeCidrInputs inputs;
+  std::unique_ptr<Envoy::Network::LcTrie::LcTrie<std::string>> lc_trie =
+      std::make_unique<Envoy::Network::LcTrie::LcTrie<std::string>>(inputs.tag_data_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += lc_trie->getData(inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(lcTrieLookupLarge);
+
+static void poptrieConstruct(benchmark::State& state) {
+  CidrInputs inputs;
+
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> trie;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    trie = std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(inputs.tag_data_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(poptrieConstruct);
+
+static void poptrieConstructNested(benchmark::State& state) {
+  CidrInputs inputs;
+
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> trie;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    trie = std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(
+        inputs.tag_data_nested_prefixes_);
+  }
+  benchmark::DoNotOptimize(trie);
+}
+
+BENCHMARK(poptrieConstructNested);
+
+static void poptrieLookup(benchmark::State& state) {
+  CidrInputs cidr_inputs;
+  AddressInputs address_inputs;
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> poptrie =
+      std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(cidr_inputs.tag_data_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= address_inputs.addresses_.size();
+    output_tags += poptrie->getData(address_inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(poptrieLookup);
+
+static void poptrieLookupWithNestedPrefixes(benchmark::State& state) {
+  CidrInputs cidr_inputs;
+  AddressInputs address_inputs;
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> poptrie_nested_prefixes =
+      std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(
+          cidr_inputs.tag_data_nested_prefixes_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= address_inputs.addresses_.size();
+    output_tags += poptrie_nested_prefixes->getData(address_inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(poptrieLookupWithNestedPrefixes);
+
+static void poptrieLookupLarge(benchmark::State& state) {
+  LargeCidrInputs inputs;
+  std::unique_ptr<Envoy::Network::Poptrie::Poptrie<std::string>> poptrie =
+      std::make_unique<Envoy::Network::Poptrie::Poptrie<std::string>>(inputs.tag_data_);
+
+  static size_t i = 0;
+  size_t output_tags = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    i++;
+    i %= inputs.addresses_.size();
+    output_tags += poptrie->getData(inputs.addresses_[i]).size();
+  }
+  benchmark::DoNotOptimize(output_tags);
+}
+
+BENCHMARK(poptrieLookupLarge);
+
+// Adds and removes a /24 prefix of a large set, which only rebuilds the sub-trie of its /16.
+static void poptrieUpdateLarge(benchmark::State& state) {
+  LargeCidrInputs inputs;
+  Envoy::Network::Poptrie::Poptrie<std::string> poptrie(inputs.tag_data_);
+  const Envoy::Network::Address::CidrRange range =
+      *Envoy::Network::Address::CidrRange::create("12.0.0.0/24");
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    poptrie.insert(range, "tag_update");
+    poptrie.remove(range, "tag_update");
+  }
+}
+
+BENCHMARK(poptrieUpdateLarge);
+
 } // namespace Envoy
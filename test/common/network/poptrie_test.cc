@@ -0,0 +1,219 @@
+#include <memory>
+
+#include "source/common/common/utility.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/cidr_range.h"
+#include "source/common/network/lc_trie.h"
+#include "source/common/network/poptrie.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace Poptrie {
+
+using TagData = std::vector<std::pair<std::string, std::vector<Address::CidrRange>>>;
+
+class PoptrieTest : public testing::Test {
+public:
+  // Builds both a Poptrie and an LcTrie, whose results are expected to match.
+  void setup(const std::vector<std::vector<std::string>>& cidr_range_strings,
+             bool exclusive = false) {
+    TagData output;
+    for (size_t i = 0; i < cidr_range_strings.size(); i++) {
+      std::pair<std::string, std::vector<Address::CidrRange>> ip_tags;
+      ip_tags.first = fmt::format("tag_{0}", i);
+      for (const auto& j : cidr_range_strings[i]) {
+        ip_tags.second.push_back(*Address::CidrRange::create(j));
+      }
+      output.push_back(ip_tags);
+    }
+    trie_ = std::make_unique<Poptrie<std::string>>(output, exclusive);
+    lc_trie_ = std::make_unique<LcTrie::LcTrie<std::string>>(output, exclusive);
+  }
+
+  static std::vector<std::string> sorted(std::vector<std::string> tags) {
+    std::sort(tags.begin(), tags.end());
+    return tags;
+  }
+
+  void expectIPAndTags(
+      const std::vector<std::pair<std::string, std::vector<std::string>>>& test_output) {
+    for (const auto& kv : test_output) {
+      const auto address = Utility::parseInternetAddressNoThrow(kv.first);
+      EXPECT_EQ(sorted(kv.second), sorted(trie_->getData(address))) << kv.first;
+      if (lc_trie_ != nullptr) {
+        EXPECT_EQ(sorted(kv.second), sorted(lc_trie_->getData(address))) << kv.first;
+      }
+    }
+  }
+
+  std::unique_ptr<Poptrie<std::string>> trie_;
+  std::unique_ptr<LcTrie::LcTrie<std::string>> lc_trie_;
+};
+
+TEST_F(PoptrieTest, IPv4) {
+  const std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/4"},     // tag_0
+      {"16.0.0.0/4"},    // tag_1
+      {"40.0.0.0/5"},    // tag_2
+      {"232.0.0.0/8"},   // tag_3
+      {"233.0.0.0/8"},   // tag_4
+      {"10.1.0.0/16"},   // tag_5
+      {"10.2.3.0/24"},   // tag_6
+      {"10.2.3.64/26"},  // tag_7
+      {"10.2.3.65/32"},  // tag_8
+      {"10.2.3.128/25"}, // tag_9
+  };
+  setup(cidr_range_strings);
+
+  const std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"0.0.0.0", {"tag_0"}},
+      {"16.0.0.1", {"tag_1"}},
+      {"40.0.0.255", {"tag_2"}},
+      {"232.0.0.1", {"tag_3"}},
+      {"233.255.255.255", {"tag_4"}},
+      {"234.0.0.0", {}},
+      {"10.1.255.255", {"tag_5"}},
+      {"10.2.3.1", {"tag_6"}},
+      {"10.2.3.64", {"tag_6", "tag_7"}},
+      {"10.2.3.65", {"tag_6", "tag_7", "tag_8"}},
+      {"10.2.3.127", {"tag_6", "tag_7"}},
+      {"10.2.3.128", {"tag_6", "tag_9"}},
+      {"10.2.4.0", {}},
+      {"255.255.255.255", {}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, IPv6) {
+  const std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"2406:da00:2000::/40", "::1/128"}, // tag_0
+      {"2001:abcd:ef01:2345::/64"},       // tag_1
+      {"::/128"},                         // tag_2
+      {"ffff::/16"},                      // tag_3
+  };
+  setup(cidr_range_strings);
+
+  const std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"2400:ffff:ff00::", {}},
+      {"2406:da00:2000::1", {"tag_0"}},
+      {"2001:abcd:ef01:2345::1", {"tag_1"}},
+      {"2001:abcd:ef01:2346::1", {}},
+      {"::1", {"tag_0"}},
+      {"::", {"tag_2"}},
+      {"::2", {}},
+      {"ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", {"tag_3"}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, NestedPrefixesWithCatchAll) {
+  const std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},                          // tag_0
+      {"203.0.113.0/24"},                     // tag_1
+      {"203.0.113.128/25"},                   // tag_2
+      {"198.51.100.0/24"},                    // tag_3
+      {"::0/0"},                              // tag_4
+      {"2001:db8::/96", "2001:db8::8000/97"}, // tag_5
+      {"2001:db8::ffff/128"},                 // tag_6
+      {"2001:db8:1::/48"},                    // tag_7
+      {"203.0.113.0/24"}                      // tag_8 (same subnet as tag_1)
+  };
+  setup(cidr_range_strings);
+
+  const std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"203.0.0.0", {"tag_0"}},
+      {"203.0.113.0", {"tag_0", "tag_1", "tag_8"}},
+      {"203.0.113.192", {"tag_0", "tag_1", "tag_2", "tag_8"}},
+      {"203.0.113.255", {"tag_0", "tag_1", "tag_2", "tag_8"}},
+      {"198.51.100.1", {"tag_0", "tag_3"}},
+      {"2001:db8::ffff", {"tag_4", "tag_5", "tag_6"}},
+      {"2001:db8:1::ffff", {"tag_4", "tag_7"}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, ExclusiveNestedPrefixesWithCatchAll) {
+  const std::vector<std::vector<std::string>> cidr_range_strings = {
+      {"0.0.0.0/0"},                          // tag_0
+      {"203.0.113.0/24"},                     // tag_1
+      {"203.0.113.128/25"},                   // tag_2
+      {"198.51.100.0/24"},                    // tag_3
+      {"::0/0"},                              // tag_4
+      {"2001:db8::/96", "2001:db8::8000/97"}, // tag_5
+      {"2001:db8::ffff/128"},                 // tag_6
+      {"2001:db8:1::/48"},                    // tag_7
+      {"203.0.113.0/24"}                      // tag_8 (same subnet as tag_1)
+  };
+  setup(cidr_range_strings, true);
+
+  const std::vector<std::pair<std::string, std::vector<std::string>>> test_case = {
+      {"203.0.0.0", {"tag_0"}},       {"203.0.113.0", {"tag_1", "tag_8"}},
+      {"203.0.113.192", {"tag_2"}},   {"203.0.113.255", {"tag_2"}},
+      {"198.51.100.1", {"tag_3"}},    {"2001:db8::ffff", {"tag_6"}},
+      {"2001:db8:1::ffff", {"tag_7"}}};
+  expectIPAndTags(test_case);
+}
+
+TEST_F(PoptrieTest, Empty) {
+  setup({});
+
+  expectIPAndTags({{"10.0.0.1", {}}, {"2001:db8::1", {}}});
+}
+
+// Ranges can be added and removed after construction, updating the data of their nested ranges.
+TEST_F(PoptrieTest, InsertAndRemove) {
+  setup({{"10.0.0.0/8"}, {"10.1.2.0/24"}});
+  lc_trie_.reset();
+
+  trie_->insert(*Address::CidrRange::create("10.1.2.128/25"), "tag_2");
+  trie_->insert(*Address::CidrRange::create("10.1.2.0/24"), "tag_2");
+  trie_->insert(*Address::CidrRange::create("0.0.0.0/1"), "tag_3");
+  trie_->insert(*Address::CidrRange::create("2001:db8::/32"), "tag_4");
+  expectIPAndTags({{"10.1.2.1", {"tag_0", "tag_1", "tag_2", "tag_3"}},
+                   {"10.1.2.129", {"tag_0", "tag_1", "tag_2", "tag_3"}},
+                   {"10.1.3.1", {"tag_0", "tag_3"}},
+                   {"11.0.0.1", {"tag_3"}},
+                   {"128.0.0.1", {}},
+                   {"2001:db8::1", {"tag_4"}}});
+
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("10.0.0.0/8"), "tag_0"));
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("10.1.2.0/24"), "tag_2"));
+  EXPECT_FALSE(trie_->remove(*Address::CidrRange::create("10.1.2.0/24"), "tag_2"));
+  EXPECT_FALSE(trie_->remove(*Address::CidrRange::create("10.1.0.0/16"), "tag_1"));
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("2001:db8::/32"), "tag_4"));
+  expectIPAndTags({{"10.1.2.1", {"tag_1", "tag_3"}},
+                   {"10.1.2.129", {"tag_1", "tag_2", "tag_3"}},
+                   {"10.1.3.1", {"tag_3"}},
+                   {"2001:db8::1", {}}});
+
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("0.0.0.0/1"), "tag_3"));
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("10.1.2.0/24"), "tag_1"));
+  EXPECT_TRUE(trie_->remove(*Address::CidrRange::create("10.1.2.128/25"), "tag_2"));
+  expectIPAndTags({{"10.1.2.1", {}}, {"10.1.2.129", {}}});
+}
+
+// The number of CIDR ranges is not limited like for an LcTrie.
+TEST_F(PoptrieTest, MoreRangesThanLcTrie) {
+  TagData tag_data;
+  for (size_t i = 0; i < 8; i++) {
+    std::vector<Address::CidrRange> prefixes;
+    for (size_t j = 0; j < 256; j++) {
+      for (size_t k = 0; k < 256; k++) {
+        prefixes.push_back(*Address::CidrRange::create(fmt::format("10.{}.{}.{}/32", i, j, k)));
+      }
+    }
+    tag_data.emplace_back(fmt::format("tag_{}", i), std::move(prefixes));
+  }
+  EXPECT_THROW(LcTrie::LcTrie<std::string>{tag_data}, EnvoyException);
+
+  trie_ = std::make_unique<Poptrie<std::string>>(tag_data);
+  expectIPAndTags({{"10.0.0.0", {"tag_0"}},
+                   {"10.3.128.77", {"tag_3"}},
+                   {"10.7.255.255", {"tag_7"}},
+                   {"10.8.0.0", {}}});
+}
+
+} // namespace Poptrie
+} // namespace Network
+} // namespace Envoy
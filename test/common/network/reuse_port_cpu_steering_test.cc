@@ -0,0 +1,114 @@
+#include <sched.h>
+
+#include <linux/filter.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#include "source/common/network/reuse_port_cpu_steering.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::NiceMock;
+using testing::Return;
+using testing::SetArgPointee;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class ReusePortCpuSteeringTest : public testing::Test {
+protected:
+  ReusePortCpuSteeringTest() {
+    CPU_ZERO(&cpus_);
+    CPU_SET(1, &cpus_);
+    CPU_SET(3, &cpus_);
+  }
+
+  void expectAffinity() {
+    EXPECT_CALL(linux_os_sys_calls_, sched_getaffinity(_, _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(cpus_), Return(Api::SysCallIntResult{0, 0})));
+  }
+
+  // Runs a program built by buildProgram() on the given CPU.
+  static uint32_t run(const std::vector<sock_filter>& program, uint32_t cpu) {
+    uint32_t a = 0;
+    for (size_t pc = 0; pc < program.size(); ++pc) {
+      const sock_filter& insn = program[pc];
+      switch (insn.code) {
+      case BPF_LD | BPF_W | BPF_ABS:
+        EXPECT_EQ(SKF_AD_OFF + SKF_AD_CPU, insn.k);
+        a = cpu;
+        break;
+      case BPF_JMP | BPF_JEQ | BPF_K:
+        pc += a == insn.k ? insn.jt : insn.jf;
+        break;
+      case BPF_RET | BPF_K:
+        return insn.k;
+      default:
+        ADD_FAILURE() << "unexpected instruction " << insn.code;
+        return 0;
+      }
+    }
+    ADD_FAILURE() << "program does not return";
+    return 0;
+  }
+
+  cpu_set_t cpus_;
+  Api::MockLinuxOsSysCalls linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+};
+
+TEST_F(ReusePortCpuSteeringTest, AllowedCpus) {
+  expectAffinity();
+  EXPECT_EQ(std::vector<uint32_t>({1, 3}), ReusePortCpuSteering::allowedCpus());
+  EXPECT_EQ(1, ReusePortCpuSteering::cpuForWorker(0));
+  EXPECT_EQ(3, ReusePortCpuSteering::cpuForWorker(1));
+  EXPECT_EQ(1, ReusePortCpuSteering::cpuForWorker(2));
+}
+
+TEST_F(ReusePortCpuSteeringTest, UnknownCpus) {
+  EXPECT_CALL(linux_os_sys_calls_, sched_getaffinity(_, _, _))
+      .WillRepeatedly(Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_TRUE(ReusePortCpuSteering::allowedCpus().empty());
+  EXPECT_EQ(absl::nullopt, ReusePortCpuSteering::cpuForWorker(0));
+
+  NiceMock<MockListenSocket> socket;
+  EXPECT_CALL(socket, setSocketOption(_, _, _, _)).Times(0);
+  EXPECT_FALSE(ReusePortCpuSteering::attach(socket, 2).ok());
+}
+
+TEST_F(ReusePortCpuSteeringTest, Program) {
+  const std::vector<sock_filter> program = ReusePortCpuSteering::buildProgram({1, 3, 4}, 2);
+  EXPECT_EQ(0, run(program, 1));
+  EXPECT_EQ(1, run(program, 3));
+  EXPECT_EQ(0, run(program, 4));
+  // CPUs without a worker fall back to hashing.
+  EXPECT_EQ(2, run(program, 0));
+  EXPECT_EQ(2, run(program, 5));
+}
+
+TEST_F(ReusePortCpuSteeringTest, Attach) {
+  expectAffinity();
+  NiceMock<MockListenSocket> socket;
+  EXPECT_CALL(socket, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, sizeof(sock_fprog)))
+      .WillOnce([](int, int, const void* optval, socklen_t) {
+        const auto* fprog = static_cast<const sock_fprog*>(optval);
+        EXPECT_EQ(6, fprog->len);
+        return Api::SysCallIntResult{0, 0};
+      });
+  EXPECT_TRUE(ReusePortCpuSteering::attach(socket, 2).ok());
+
+  EXPECT_CALL(socket, setSocketOption(SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EINVAL}));
+  EXPECT_FALSE(ReusePortCpuSteering::attach(socket, 2).ok());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -326,6 +326,32 @@ TEST_F(SocketOptionFactoryTest, TestBuildBindAddressNoPortOptions) {
   EXPECT_EQ(expected_value, option_details->value_);
 }
 
+#if defined(SO_BUSY_POLL) && defined(SO_PREFER_BUSY_POLL)
+TEST_F(SocketOptionFactoryTest, TestBuildBusyPollOptions) {
+  auto socket_options = SocketOptionFactory::buildBusyPollOptions(std::chrono::microseconds(50));
+  ASSERT_EQ(2, socket_options->size());
+
+  int busy_poll = 50;
+  auto option_details = socket_options->at(0)->getOptionDetails(
+      socket_mock_, envoy::config::core::v3::SocketOption::STATE_PREBIND);
+  ASSERT_TRUE(option_details.has_value());
+  EXPECT_EQ(SOL_SOCKET, option_details->name_.level());
+  EXPECT_EQ(SO_BUSY_POLL, option_details->name_.option());
+  EXPECT_EQ(absl::string_view(reinterpret_cast<char*>(&busy_poll), sizeof(busy_poll)),
+            option_details->value_);
+
+  int prefer_busy_poll = 1;
+  option_details = socket_options->at(1)->getOptionDetails(
+      socket_mock_, envoy::config::core::v3::SocketOption::STATE_PREBIND);
+  ASSERT_TRUE(option_details.has_value());
+  EXPECT_EQ(SOL_SOCKET, option_details->name_.level());
+  EXPECT_EQ(SO_PREFER_BUSY_POLL, option_details->name_.option());
+  EXPECT_EQ(absl::string_view(reinterpret_cast<char*>(&prefer_busy_poll),
+                              sizeof(prefer_busy_poll)),
+            option_details->value_);
+}
+#endif
+
 } // namespace
 } // namespace Network
 } // namespace Envoy
@@ -514,5 +514,19 @@ TEST(HashTest, ValidateRepeatedAnyMismatchingType) {
   EXPECT_NE(hash(a1), hash(a2));
 }
 
+TEST(HashTest, HashIgnoringFieldMatchesHashWithFieldCleared) {
+  deterministichashtest::RepeatedFields fields1, fields2;
+  fields1.add_strings("foo");
+  fields1.add_messages()->set_index(1);
+  fields2.add_strings("foo");
+  fields2.add_messages()->set_index(2);
+  EXPECT_NE(hash(fields1), hash(fields2));
+  EXPECT_EQ(hashIgnoringField(fields1, 11), hashIgnoringField(fields2, 11));
+  EXPECT_NE(hashIgnoringField(fields1, 2), hashIgnoringField(fields2, 2));
+
+  fields1.clear_messages();
+  EXPECT_EQ(hash(fields1), hashIgnoringField(fields2, 11));
+}
+
 } // namespace DeterministicProtoHash
 } // namespace Envoy
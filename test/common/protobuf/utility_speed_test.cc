@@ -1,6 +1,7 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from a
 // quiescent system with disabled cstate power management.
 
+#include "source/common/json/json_loader.h"
 #include "source/common/protobuf/utility.h"
 
 #include "test/common/protobuf/deterministic_hash_test.pb.h"
@@ -65,4 +66,40 @@ BENCHMARK_CAPTURE(bmHashByDeterministicHash, map, testProtoWithMaps());
 BENCHMARK_CAPTURE(bmHashByDeterministicHash, recursion, testProtoWithRecursion());
 BENCHMARK_CAPTURE(bmHashByDeterministicHash, repeatedFields, testProtoWithRepeatedFields());
 
+#ifdef ENVOY_ENABLE_YAML
+static std::string testJson(std::unique_ptr<Protobuf::Message> msg) {
+  return MessageUtil::getJsonStringFromMessageOrError(*msg, false, true);
+}
+
+// Parses JSON documents into Json::Objects, as for the ext_authz HTTP responses and the
+// json_to_metadata filter.
+static void bmJsonFactoryLoadFromString(benchmark::State& state, std::string json) {
+  uint64_t fields = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Json::ObjectSharedPtr object = Json::Factory::loadFromString(json).value();
+    fields += object->empty() ? 0 : 1;
+  }
+  benchmark::DoNotOptimize(fields);
+}
+BENCHMARK_CAPTURE(bmJsonFactoryLoadFromString, map, testJson(testProtoWithMaps()));
+BENCHMARK_CAPTURE(bmJsonFactoryLoadFromString, recursion, testJson(testProtoWithRecursion()));
+BENCHMARK_CAPTURE(bmJsonFactoryLoadFromString, repeatedFields,
+                  testJson(testProtoWithRepeatedFields()));
+
+// Parses JSON documents into protos, as for the JSON bootstraps.
+static void bmLoadFromJson(benchmark::State& state, std::unique_ptr<Protobuf::Message> msg) {
+  std::unique_ptr<Protobuf::Message> dest(msg->New());
+  const std::string json = testJson(std::move(msg));
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    MessageUtil::loadFromJson(json, *dest, ProtobufMessage::getNullValidationVisitor());
+  }
+  benchmark::DoNotOptimize(dest->ByteSizeLong());
+}
+BENCHMARK_CAPTURE(bmLoadFromJson, map, testProtoWithMaps());
+BENCHMARK_CAPTURE(bmLoadFromJson, recursion, testProtoWithRecursion());
+BENCHMARK_CAPTURE(bmLoadFromJson, repeatedFields, testProtoWithRepeatedFields());
+#endif
+
 } // namespace Envoy
@@ -18,10 +18,12 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/match.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "quiche/quic/core/crypto/null_encrypter.h"
 #include "quiche/quic/core/deterministic_connection_id_generator.h"
+#include "quiche/quic/core/quic_data_writer.h"
 #include "quiche/quic/test_tools/quic_connection_peer.h"
 #include "quiche/quic/test_tools/quic_session_peer.h"
 
@@ -305,6 +307,52 @@ TEST_F(EnvoyQuicServerStreamTest, PostRequestAndResponseWithMemSliceReleasor) {
   quic_stream_->encodeTrailers(response_trailers_);
 }
 
+TEST_F(EnvoyQuicServerStreamTest, EncodeDataFromSharedSendBuffer) {
+  receiveRequest(request_body_, true, request_body_.size() * 2);
+  quic_stream_->encodeHeaders(response_headers_, /*end_stream=*/false);
+
+  // Serialize the stream data written, as the QUIC connection would upon sending it.
+  std::string sent;
+  EXPECT_CALL(quic_session_, WritevData(_, _, _, _, _, _))
+      .WillRepeatedly(Invoke([this, &sent](quic::QuicStreamId, size_t write_length,
+                                            quic::QuicStreamOffset offset,
+                                            quic::StreamSendingState state, bool,
+                                            absl::optional<quic::EncryptionLevel>) {
+        std::string data(write_length, '\0');
+        quic::QuicDataWriter writer(write_length, data.data());
+        EXPECT_TRUE(quic_stream_->WriteStreamData(offset, write_length, &writer));
+        sent += data;
+        return quic::QuicConsumedData{write_length, state != quic::NO_FIN};
+      }));
+
+  const std::string first_body = std::string(16 * 1024, 'a') + std::string(100, 'b');
+  Buffer::OwnedImpl first_buffer(std::string(16 * 1024, 'a'));
+  first_buffer.add(std::string(100, 'b'));
+  quic_stream_->encodeData(first_buffer, false);
+  EXPECT_EQ(0, first_buffer.length());
+
+  // The small slice is copied into the last slice of the body already sent, and the fragment is
+  // referenced in place.
+  auto* fragment_data = new std::string(1000, 'd');
+  bool fragment_released = false;
+  Buffer::OwnedImpl second_buffer(std::string(100, 'c'));
+  second_buffer.addBufferFragment(*new Buffer::BufferFragmentImpl(
+      fragment_data->data(), fragment_data->size(),
+      [fragment_data, &fragment_released](const void*, size_t,
+                                          const Buffer::BufferFragmentImpl* fragment) {
+        fragment_released = true;
+        delete fragment_data;
+        delete fragment;
+      }));
+  quic_stream_->encodeData(second_buffer, false);
+  EXPECT_EQ(0, second_buffer.length());
+  EXPECT_FALSE(fragment_released);
+
+  EXPECT_TRUE(absl::StrContains(sent, first_body));
+  EXPECT_TRUE(absl::StrContains(sent, std::string(100, 'c') + std::string(1000, 'd')));
+  quic_stream_->encodeTrailers(response_trailers_);
+}
+
 TEST_F(EnvoyQuicServerStreamTest, EncodeHeaderOnClosedStream) {
   receiveRequest(request_body_, true, request_body_.size() * 2);
 
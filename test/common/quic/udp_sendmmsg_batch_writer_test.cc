@@ -0,0 +1,253 @@
+#include <netinet/in.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/quic/udp_sendmmsg_batch_writer.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#if UDP_SENDMMSG_BATCH_WRITER_COMPILETIME_SUPPORT
+
+using testing::_;
+using testing::Return;
+
+namespace Envoy {
+namespace Quic {
+namespace {
+
+// A datagram passed to sendmmsg.
+struct SentDatagram {
+  std::string peer_;
+  std::string payload_;
+  // 0 without a UDP_SEGMENT control message.
+  uint16_t segment_size_;
+  bool has_pktinfo_;
+};
+
+class UdpSendmmsgBatchWriterTest : public testing::Test {
+public:
+  UdpSendmmsgBatchWriterTest()
+      : peer_a_(std::make_shared<Network::Address::Ipv4Instance>("10.0.0.1", 443)),
+        peer_b_(std::make_shared<Network::Address::Ipv4Instance>("10.0.0.2", 443)),
+        self_("127.0.0.1", 443) {
+    ON_CALL(io_handle_, fdDoNotUse()).WillByDefault(Return(10));
+  }
+
+  void createWriter(uint32_t max_buffered_packets, bool gso) {
+    send_callback_ = new testing::NiceMock<Event::MockSchedulableCallback>(&dispatcher_);
+    writer_ = std::make_unique<UdpSendmmsgBatchWriter>(io_handle_, *store_.rootScope(), dispatcher_,
+                                                       max_buffered_packets, gso);
+  }
+
+  Api::IoCallUint64Result write(const std::string& payload,
+                                const Network::Address::Instance& peer) {
+    Buffer::OwnedImpl buffer(payload);
+    return writer_->writePacket(buffer, self_.ip(), peer);
+  }
+
+  uint64_t bufferedBytes() {
+    return store_.gaugeFromString("internal_buffer_size", Stats::Gauge::ImportMode::NeverImport)
+        .value();
+  }
+
+  // Expects a sendmmsg call, saving the datagrams it is passed, and returning a result.
+  void expectSendmmsg(std::vector<SentDatagram>& sent, Api::SysCallIntResult result) {
+    EXPECT_CALL(os_sys_calls_, sendmmsg(10, _, _, 0))
+        .WillOnce([&sent, result](os_fd_t, mmsghdr* msgvec, unsigned int vlen, int) {
+          for (unsigned int i = 0; i < vlen; i++) {
+            msghdr& hdr = msgvec[i].msg_hdr;
+            SentDatagram datagram{};
+            datagram.peer_ = (*Network::Address::addressFromSockAddr(
+                                  *reinterpret_cast<sockaddr_storage*>(hdr.msg_name),
+                                  hdr.msg_namelen, /*v6only=*/false))
+                                 ->asString();
+            EXPECT_EQ(1, hdr.msg_iovlen);
+            datagram.payload_ = std::string(static_cast<char*>(hdr.msg_iov[0].iov_base),
+                                            hdr.msg_iov[0].iov_len);
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr;
+                 cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+              if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_SEGMENT) {
+                memcpy(&datagram.segment_size_, CMSG_DATA(cmsg), sizeof(uint16_t));
+              } else if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                datagram.has_pktinfo_ = true;
+              }
+            }
+            sent.push_back(datagram);
+          }
+          return result;
+        })
+        .RetiresOnSaturation();
+  }
+
+protected:
+  testing::NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  testing::NiceMock<Network::MockIoHandle> io_handle_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  Stats::IsolatedStoreImpl store_;
+  Network::Address::InstanceConstSharedPtr peer_a_;
+  Network::Address::InstanceConstSharedPtr peer_b_;
+  Network::Address::Ipv4Instance self_;
+  Event::MockSchedulableCallback* send_callback_{};
+  std::unique_ptr<UdpSendmmsgBatchWriter> writer_;
+};
+
+TEST_F(UdpSendmmsgBatchWriterTest, SendsPacketsOfLoopIterationTogether) {
+  createWriter(64, /*gso=*/true);
+  EXPECT_CALL(os_sys_calls_, sendmmsg(_, _, _, _)).Times(0);
+  EXPECT_EQ(100, write(std::string(100, 'a'), *peer_a_).return_value_);
+  EXPECT_EQ(100, write(std::string(100, 'b'), *peer_a_).return_value_);
+  // A shorter packet is the last segment of the datagram.
+  EXPECT_EQ(50, write(std::string(50, 'c'), *peer_a_).return_value_);
+  EXPECT_EQ(100, write(std::string(100, 'd'), *peer_a_).return_value_);
+  EXPECT_EQ(80, write(std::string(80, 'e'), *peer_b_).return_value_);
+  EXPECT_EQ(80, write(std::string(80, 'f'), *peer_b_).return_value_);
+  EXPECT_TRUE(writer_->flush().ok());
+  EXPECT_EQ(510, bufferedBytes());
+  testing::Mock::VerifyAndClearExpectations(&os_sys_calls_);
+
+  std::vector<SentDatagram> sent;
+  expectSendmmsg(sent, {3, 0});
+  send_callback_->invokeCallback();
+  ASSERT_EQ(3, sent.size());
+  EXPECT_EQ(peer_a_->asString(), sent[0].peer_);
+  EXPECT_EQ(std::string(100, 'a') + std::string(100, 'b') + std::string(50, 'c'),
+            sent[0].payload_);
+  EXPECT_EQ(100, sent[0].segment_size_);
+  EXPECT_TRUE(sent[0].has_pktinfo_);
+  EXPECT_EQ(std::string(100, 'd'), sent[1].payload_);
+  EXPECT_EQ(0, sent[1].segment_size_);
+  EXPECT_EQ(peer_b_->asString(), sent[2].peer_);
+  EXPECT_EQ(std::string(80, 'e') + std::string(80, 'f'), sent[2].payload_);
+  EXPECT_EQ(80, sent[2].segment_size_);
+  EXPECT_EQ(510, store_.counterFromString("total_bytes_sent").value());
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, WithoutGso) {
+  createWriter(64, /*gso=*/false);
+  write(std::string(100, 'a'), *peer_a_);
+  write(std::string(100, 'b'), *peer_a_);
+
+  std::vector<SentDatagram> sent;
+  expectSendmmsg(sent, {2, 0});
+  send_callback_->invokeCallback();
+  ASSERT_EQ(2, sent.size());
+  EXPECT_EQ(std::string(100, 'a'), sent[0].payload_);
+  EXPECT_EQ(0, sent[0].segment_size_);
+  EXPECT_EQ(std::string(100, 'b'), sent[1].payload_);
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, SendsWhenFull) {
+  createWriter(2, /*gso=*/true);
+  write(std::string(100, 'a'), *peer_a_);
+  write(std::string(100, 'b'), *peer_b_);
+  EXPECT_EQ(nullptr, writer_->getNextWriteLocation(self_.ip(), *peer_a_).buffer_);
+
+  std::vector<SentDatagram> sent;
+  expectSendmmsg(sent, {2, 0});
+  EXPECT_EQ(100, write(std::string(100, 'c'), *peer_a_).return_value_);
+  EXPECT_EQ(2, sent.size());
+
+  sent.clear();
+  expectSendmmsg(sent, {1, 0});
+  send_callback_->invokeCallback();
+  ASSERT_EQ(1, sent.size());
+  EXPECT_EQ(std::string(100, 'c'), sent[0].payload_);
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, WriteInPlace) {
+  createWriter(64, /*gso=*/true);
+  Network::UdpPacketWriterBuffer location = writer_->getNextWriteLocation(self_.ip(), *peer_a_);
+  ASSERT_NE(nullptr, location.buffer_);
+  EXPECT_EQ(Network::UdpMaxOutgoingPacketSize, location.length_);
+  memset(location.buffer_, 'a', 100);
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(*new Buffer::BufferFragmentImpl(
+      location.buffer_, 100,
+      [](const void*, size_t, const Buffer::BufferFragmentImpl* fragment) { delete fragment; }));
+  EXPECT_EQ(100, writer_->writePacket(buffer, self_.ip(), *peer_a_).return_value_);
+
+  std::vector<SentDatagram> sent;
+  expectSendmmsg(sent, {1, 0});
+  send_callback_->invokeCallback();
+  ASSERT_EQ(1, sent.size());
+  EXPECT_EQ(std::string(100, 'a'), sent[0].payload_);
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, BlockedKeepsPacketsNotSent) {
+  createWriter(64, /*gso=*/true);
+  write(std::string(100, 'a'), *peer_a_);
+  write(std::string(100, 'b'), *peer_b_);
+
+  std::vector<SentDatagram> sent;
+  {
+    testing::InSequence s;
+    expectSendmmsg(sent, {1, 0});
+    expectSendmmsg(sent, {-1, SOCKET_ERROR_AGAIN});
+  }
+  send_callback_->invokeCallback();
+  EXPECT_TRUE(writer_->isWriteBlocked());
+  EXPECT_EQ(100, bufferedBytes());
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again,
+            write(std::string(100, 'c'), *peer_a_).err_->getErrorCode());
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, writer_->flush().err_->getErrorCode());
+  EXPECT_EQ(nullptr, writer_->getNextWriteLocation(self_.ip(), *peer_a_).buffer_);
+
+  EXPECT_CALL(*send_callback_, scheduleCallbackCurrentIteration());
+  writer_->setWritable();
+  EXPECT_FALSE(writer_->isWriteBlocked());
+  sent.clear();
+  expectSendmmsg(sent, {1, 0});
+  send_callback_->invokeCallback();
+  ASSERT_EQ(1, sent.size());
+  EXPECT_EQ(peer_b_->asString(), sent[0].peer_);
+  EXPECT_EQ(std::string(100, 'b'), sent[0].payload_);
+  EXPECT_EQ(200, store_.counterFromString("total_bytes_sent").value());
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, DropsDatagramOnError) {
+  createWriter(64, /*gso=*/true);
+  write(std::string(100, 'a'), *peer_a_);
+  write(std::string(100, 'b'), *peer_a_);
+  write(std::string(100, 'c'), *peer_b_);
+
+  std::vector<SentDatagram> sent;
+  {
+    testing::InSequence s;
+    expectSendmmsg(sent, {-1, EMSGSIZE});
+    expectSendmmsg(sent, {1, 0});
+  }
+  send_callback_->invokeCallback();
+  EXPECT_FALSE(writer_->isWriteBlocked());
+  EXPECT_EQ(2, store_.counterFromString("dropped_packets").value());
+  EXPECT_EQ(100, store_.counterFromString("total_bytes_sent").value());
+  EXPECT_EQ(0, bufferedBytes());
+}
+
+TEST_F(UdpSendmmsgBatchWriterTest, SendsPacketsLeftOnDestruction) {
+  createWriter(64, /*gso=*/true);
+  write(std::string(100, 'a'), *peer_a_);
+
+  std::vector<SentDatagram> sent;
+  expectSendmmsg(sent, {1, 0});
+  writer_.reset();
+  EXPECT_EQ(1, sent.size());
+}
+
+} // namespace
+} // namespace Quic
+} // namespace Envoy
+
+#endif
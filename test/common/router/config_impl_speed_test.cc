@@ -3,6 +3,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/router/config_impl.h"
+#include "source/common/runtime/runtime_features.h"
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
@@ -59,7 +60,7 @@ static RouteConfiguration genRouteConfig(benchmark::State& state,
       break;
     }
     case RouteMatch::PathSpecifierCase::kPath: {
-      match->set_prefix(absl::StrCat("/shelves/shelf_", i, "/route_", i));
+      match->set_path(absl::StrCat("/shelves/shelf_", i, "/route_", i));
       break;
     }
     case RouteMatch::PathSpecifierCase::kSafeRegex: {
@@ -202,9 +203,10 @@ static RouteConfiguration genPrefixMatcherTreeRouteConfig(benchmark::State& stat
  * We construct the first `n - 1` items in the route table so they are not
  * matched by the incoming request. Only the last route will be matched.
  * We then time how long it takes for the request to be matched against the
- * last route.
+ * last route. `path_index` controls whether the virtual host indexes its routes by path.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             bool path_index = true) {
   // Setup router for benchmarking.
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
@@ -212,9 +214,11 @@ static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierC
   ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
 
   // Create router config.
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.vhost_route_path_index", path_index);
   std::shared_ptr<ConfigImpl> config =
       *ConfigImpl::create(genRouteConfig(state, match_type), factory_context,
                           ProtobufMessage::getNullValidationVisitor(), true);
+  Runtime::maybeSetRuntimeGuard("envoy.reloadable_features.vhost_route_path_index", true);
 
   for (auto _ : state) { // NOLINT
     // Do the actual timing here.
@@ -244,6 +248,17 @@ static void bmRouteTableSizeWithExactPathMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath);
 }
 
+/**
+ * The prefix and exact path benchmarks above with linear route matching, for comparison.
+ */
+static void bmRouteTableSizeWithPathPrefixMatchLinear(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix, false);
+}
+
+static void bmRouteTableSizeWithExactPathMatchLinear(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath, false);
+}
+
 /**
  * Benchmark a route table with regex path matchers in the form of:
  * - /shelves/{shelf_id}/route_1
@@ -256,6 +271,13 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * The regex benchmark above evaluating every regex in turn instead of a single RE2::Set.
+ */
+static void bmRouteTableSizeWithRegexMatchLinear(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex, false);
+}
+
 /**
  * Benchmark matcher tree route matching performance with exact path matchers in the form of:
  * - /shelves/shelf_1/route_1
@@ -314,6 +336,9 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithPathPrefixMatchLinear)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithExactPathMatchLinear)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithRegexMatchLinear)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
@@ -360,6 +360,51 @@ class RouteMatcherTest : public testing::Test,
                          public ConfigImplTestBase,
                          public TestScopedRuntime {};
 
+TEST_F(RouteMatcherTest, ShareUnchangedVirtualHosts) {
+  const fmt::format_string<const std::string&, const std::string&> yaml = R"EOF(
+virtual_hosts:
+- name: foo
+  domains: ["foo.com"]
+  routes:
+  - match: {{ prefix: "/" }}
+    route: {{ cluster: foo }}
+- name: bar
+  domains: ["bar.com"]
+  routes:
+  - match: {{ prefix: "/" }}
+    route: {{ cluster: {} }}
+{}
+)EOF";
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  auto create = [&](const std::string& bar_cluster, const std::string& extra,
+                    const ConfigImpl* previous) {
+    return *ConfigImpl::createUpdate(
+        parseRouteConfigurationFromYaml(fmt::format(yaml, bar_cluster, extra)), previous,
+        factory_context_, ProtobufMessage::getNullValidationVisitor(), false);
+  };
+
+  auto config1 = create("bar", "", nullptr);
+  auto config2 = create("baz", "", config1.get());
+  EXPECT_EQ(config1->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route,
+            config2->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route);
+  EXPECT_EQ("baz", config2->route(genHeaders("bar.com", "/", "GET"), stream_info, 0)
+                       ->routeEntry()
+                       ->clusterName());
+
+  // The virtual hosts are not shared once the rest of the route configuration changes.
+  auto config3 = create("baz", "most_specific_header_mutations_wins: true", config2.get());
+  EXPECT_NE(config2->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route,
+            config3->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route);
+  EXPECT_TRUE(config3->mostSpecificHeaderMutationsWins());
+
+  // Nor when the clusters are validated.
+  factory_context_.cluster_manager_.initializeClusters({"foo", "baz"}, {});
+  auto config4 = create("baz", "most_specific_header_mutations_wins: true\nvalidate_clusters: true",
+                        config3.get());
+  EXPECT_NE(config3->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route,
+            config4->route(genHeaders("foo.com", "/", "GET"), stream_info, 0).route);
+}
+
 TEST_F(RouteMatcherTest, TestConnectRoutes) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -1330,6 +1375,227 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Large virtual hosts use a RoutePathIndex to find candidate routes. Route selection must be the
+// same as when walking all routes in order.
+TEST_F(RouteMatcherTest, RoutePathIndexPreservesFirstMatch) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+- name: large
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/svc1/", headers: [{ name: "x-canary", string_match: { exact: "true" } }] }
+    route: { cluster: "canary" }
+  - match: { safe_regex: { regex: "/svc[0-9]+/regex" } }
+    route: { cluster: "regex" }
+  - match: { prefix: "/SVC2/", case_sensitive: false }
+    route: { cluster: "case_insensitive" }
+)EOF";
+  for (int i = 0; i < 40; i++) {
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+  - match: {{ path: "/svc{0}/health" }}
+    route: {{ cluster: "health{0}" }}
+  - match: {{ prefix: "/svc{0}/" }}
+    route: {{ cluster: "svc{0}" }}
+  - match: {{ prefix: "/svc{0}/v2/" }}
+    route: {{ cluster: "shadowed{0}" }}
+)EOF",
+                                       i));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+  - match: { prefix: "/" }
+    route: { cluster: "default" }
+)EOF");
+
+  const std::vector<std::string> paths = {"/",
+                                           "/svc1/a",
+                                           "/svc1/health",
+                                           "/svc1/health?q=1",
+                                           "/svc1/regex",
+                                           "/svc2/a",
+                                           "/SvC2/a",
+                                           "/svc3/v2/x",
+                                           "/svc39/health",
+                                           "/svc39/health/x",
+                                           "/svc40/a",
+                                           "/svc1",
+                                           "/svc10/health#frag",
+                                           "/other",
+                                           ""};
+
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  auto route_clusters = [&](bool with_index) {
+    mergeValues(
+        {{"envoy.reloadable_features.vhost_route_path_index", with_index ? "true" : "false"}});
+    TestConfigImpl config(proto_config, factory_context_, false, creation_status_);
+    std::vector<std::string> clusters;
+    for (const std::string& path : paths) {
+      for (const bool canary : {false, true}) {
+        Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", path, "GET");
+        if (canary) {
+          headers.addCopy("x-canary", "true");
+        }
+        const auto route = config.route(headers, 0);
+        clusters.push_back(route != nullptr ? route->routeEntry()->clusterName() : "none");
+      }
+    }
+    return clusters;
+  };
+
+  const std::vector<std::string> expected = route_clusters(false);
+  EXPECT_EQ(expected, route_clusters(true));
+  // Spot check the expectations themselves.
+  EXPECT_EQ("svc1", expected[2]);
+  EXPECT_EQ("canary", expected[3]);
+  EXPECT_EQ("health1", expected[4]);
+  EXPECT_EQ("health1", expected[6]);
+  EXPECT_EQ("regex", expected[8]);
+  EXPECT_EQ("case_insensitive", expected[12]);
+  EXPECT_EQ("svc3", expected[14]);
+  EXPECT_EQ("health39", expected[16]);
+  EXPECT_EQ("svc39", expected[18]);
+  EXPECT_EQ("default", expected[20]);
+}
+
+TEST_F(RouteMatcherTest, RoutePathIndexRegexSetPreservesFirstMatch) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+- name: regexes
+  domains: ["*"]
+  routes:
+  - match:
+      safe_regex: { regex: "/svc1/.*" }
+      headers: [{ name: "x-canary", present_match: true }]
+    route: { cluster: "canary" }
+)EOF";
+  for (int i = 0; i < 20; i++) {
+    absl::StrAppend(&yaml, fmt::format(R"EOF(
+  - match: {{ safe_regex: {{ regex: "/svc{0}/[0-9]+" }} }}
+    route: {{ cluster: "id{0}" }}
+  - match: {{ prefix: "/svc{0}/" }}
+    route: {{ cluster: "svc{0}" }}
+  - match: {{ safe_regex: {{ regex: "/svc{0}/[a-z]+" }} }}
+    route: {{ cluster: "shadowed{0}" }}
+)EOF",
+                                       i));
+  }
+  absl::StrAppend(&yaml, R"EOF(
+  - match: { safe_regex: { regex: "/[a-z]+/[a-z]+" } }
+    route: { cluster: "words" }
+)EOF");
+
+  const std::vector<std::string> paths = {"/svc1/42",  "/svc1/42?q=1", "/svc1/abc", "/svc19/7",
+                                           "/svc19/7/", "/foo/bar",     "/svc20/42", "/"};
+
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+  auto route_clusters = [&](bool with_regex_set) {
+    mergeValues({{"envoy.reloadable_features.vhost_route_regex_set",
+                  with_regex_set ? "true" : "false"}});
+    TestConfigImpl config(proto_config, factory_context_, false, creation_status_);
+    std::vector<std::string> clusters;
+    for (const std::string& path : paths) {
+      for (const bool canary : {false, true}) {
+        Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", path, "GET");
+        if (canary) {
+          headers.addCopy("x-canary", "true");
+        }
+        const auto route = config.route(headers, 0);
+        clusters.push_back(route != nullptr ? route->routeEntry()->clusterName() : "none");
+      }
+    }
+    return clusters;
+  };
+
+  const std::vector<std::string> expected = route_clusters(false);
+  EXPECT_EQ(expected, route_clusters(true));
+  // Spot check the expectations themselves.
+  EXPECT_EQ("id1", expected[0]);
+  EXPECT_EQ("canary", expected[1]);
+  EXPECT_EQ("id1", expected[2]);
+  EXPECT_EQ("svc1", expected[4]);
+  EXPECT_EQ("id19", expected[6]);
+  EXPECT_EQ("svc19", expected[8]);
+  EXPECT_EQ("words", expected[10]);
+  EXPECT_EQ("none", expected[12]);
+  EXPECT_EQ("none", expected[14]);
+}
+
+// Only configurations that select routes by host, x-forwarded-proto and path alone allow caching
+// route resolution results.
+TEST_F(RouteMatcherTest, RouteResolutionCacheable) {
+  const std::string base = R"EOF(
+virtual_hosts:
+- name: api
+  domains: ["api.example.com"]
+  require_tls: ALL
+  routes:
+  - match: { path: "/health" }
+    direct_response: { status: 200 }
+  - match: { safe_regex: { regex: "/v[0-9]+/items" } }
+    route: { cluster: "items" }
+  - match: { path_separated_prefix: "/users" }
+    route: { cluster: "users" }
+  - match: { prefix: "/" }
+    redirect: { path_redirect: "/" }
+)EOF";
+  auto cacheable = [&](absl::string_view extra) {
+    TestConfigImpl config(parseRouteConfigurationFromYaml(absl::StrCat(base, extra)),
+                          factory_context_, false, creation_status_);
+    EXPECT_TRUE(creation_status_.ok()) << creation_status_;
+    return config.routeResolutionCacheable();
+  };
+
+  EXPECT_TRUE(cacheable(""));
+  EXPECT_FALSE(cacheable(R"EOF(
+vhost_header: x-vhost
+)EOF"));
+  EXPECT_FALSE(cacheable(R"EOF(
+- name: internal
+  domains: ["*"]
+  require_tls: EXTERNAL_ONLY
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: "default" }
+)EOF"));
+
+  for (const absl::string_view route : {
+           R"EOF({ prefix: "/", headers: [{ name: "x-canary", present_match: true }] })EOF",
+           R"EOF({ prefix: "/", query_parameters: [{ name: "debug", present_match: true }] })EOF",
+           R"EOF({ prefix: "/", grpc: {} })EOF",
+           R"EOF({ prefix: "/", runtime_fraction: { default_value: { numerator: 50 } } })EOF",
+           R"EOF({ prefix: "/", tls_context: { presented: true } })EOF",
+           R"EOF({ connect_matcher: {} })EOF",
+       }) {
+    EXPECT_FALSE(cacheable(fmt::format(R"EOF(
+- name: other
+  domains: ["*"]
+  routes:
+  - match: {}
+    route: {{ cluster: "default" }}
+)EOF",
+                                       route)))
+        << route;
+  }
+
+  EXPECT_FALSE(cacheable(R"EOF(
+- name: other
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster_header: "x-cluster" }
+)EOF"));
+  EXPECT_FALSE(cacheable(R"EOF(
+- name: other
+  domains: ["*"]
+  routes:
+  - match: { prefix: "/" }
+    route:
+      weighted_clusters:
+        clusters:
+        - { name: "a", weight: 50 }
+        - { name: "b", weight: 50 }
+)EOF"));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -5503,6 +5769,52 @@ virtual_hosts:
   EXPECT_EQ(100, ProtobufPercentHelper::fractionalPercentDenominatorToInt(percent.denominator()));
 }
 
+TEST_F(RouteMatcherTest, HedgeOnLatency) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- domains: [www.lyft.com]
+  name: www
+  routes:
+  - match: {prefix: /foo}
+    route:
+      cluster: www
+      hedge_policy:
+        hedge_on_latency:
+          latency_percentile: {value: 95}
+          budget_percent: {value: 5}
+  - match: {prefix: /bar}
+    route:
+      cluster: www
+      hedge_policy:
+        hedge_on_latency:
+          latency_percentile: {value: 99}
+  - match: {prefix: /}
+    route: {cluster: www}
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters({"www"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  const HedgePolicy& foo = config.route(genHeaders("www.lyft.com", "/foo", "GET"), 0)
+                               ->routeEntry()
+                               ->hedgePolicy();
+  EXPECT_EQ(95, foo.hedgeLatencyPercentile());
+  EXPECT_DOUBLE_EQ(0.05, foo.hedgeBudgetRatio());
+
+  const HedgePolicy& bar = config.route(genHeaders("www.lyft.com", "/bar", "GET"), 0)
+                               ->routeEntry()
+                               ->hedgePolicy();
+  EXPECT_EQ(99, bar.hedgeLatencyPercentile());
+  EXPECT_DOUBLE_EQ(0.1, bar.hedgeBudgetRatio());
+
+  EXPECT_FALSE(config.route(genHeaders("www.lyft.com", "/", "GET"), 0)
+                   ->routeEntry()
+                   ->hedgePolicy()
+                   .hedgeLatencyPercentile()
+                   .has_value());
+}
+
 TEST_F(RouteMatcherTest, HedgeVirtualHostLevel) {
   const std::string yaml = R"EOF(
 virtual_hosts:
@@ -31,9 +31,9 @@ static void bmEvaluateHeaders(benchmark::State& state) {
       header_value_option->set_append_action(HeaderValueOption::OVERWRITE_IF_EXISTS_OR_ADD);
     }
     mutable_header->set_key(fmt::format("test{}", i));
-    // The value of the header to add is a static string. HeaderParser::configure will allocate a
-    // simple formatter which does no real formatting and returns the same string.
-    mutable_header->set_value("TEST");
+    // The value of the header to add is either a static string, which HeaderParser recognizes as a
+    // literal and adds without running its formatter, or a value with a substitution command.
+    mutable_header->set_value(state.range(1) == 0 ? "TEST" : "%PROTOCOL%");
   }
 
   // Instantiate HeaderParser
@@ -44,7 +44,7 @@ static void bmEvaluateHeaders(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bmEvaluateHeaders)->DenseRange(2, 20, 2);
+BENCHMARK(bmEvaluateHeaders)->ArgsProduct({benchmark::CreateDenseRange(2, 20, 2), {0, 1}});
 
 } // namespace Router
 } // namespace Envoy
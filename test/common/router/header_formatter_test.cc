@@ -553,6 +553,41 @@ request_headers_to_add:
   EXPECT_EQ("static-value", header_map.get_("static-header"));
 }
 
+// Values without substitution commands are added as is, while an escaped '%' still needs the
+// formatter.
+TEST(HeaderParserTest, EvaluateLiteralAndEscapedHeaders) {
+  const std::string yaml = R"EOF(
+match: { prefix: "/new_endpoint" }
+route:
+  cluster: "www2"
+response_headers_to_add:
+  - header:
+      key: "literal-header"
+      value: "max-age=86400, public"
+    append_action: APPEND_IF_EXISTS_OR_ADD
+  - header:
+      key: "escaped-header"
+      value: "100%%"
+    append_action: OVERWRITE_IF_EXISTS_OR_ADD
+)EOF";
+
+  HeaderParserPtr resp_header_parser =
+      HeaderParser::configure(parseRouteFromV3Yaml(yaml).response_headers_to_add()).value();
+  Http::TestResponseHeaderMapImpl header_map{{":status", "200"}, {"literal-header", "first"}};
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  resp_header_parser->evaluateHeaders(header_map, stream_info);
+  const auto literal_headers = header_map.get(Http::LowerCaseString("literal-header"));
+  ASSERT_EQ(2, literal_headers.size());
+  EXPECT_EQ("max-age=86400, public", literal_headers[1]->value().getStringView());
+  EXPECT_EQ("100%", header_map.get_("escaped-header"));
+
+  Http::HeaderTransforms transforms = resp_header_parser->getHeaderTransforms(stream_info);
+  ASSERT_EQ(1, transforms.headers_to_append_or_add.size());
+  EXPECT_EQ("max-age=86400, public", transforms.headers_to_append_or_add[0].second);
+  ASSERT_EQ(1, transforms.headers_to_overwrite_or_add.size());
+  EXPECT_EQ("100%", transforms.headers_to_overwrite_or_add[0].second);
+}
+
 TEST(HeaderParserTest, EvaluateCompoundHeaders) {
   const std::string yaml = R"EOF(
 match: { prefix: "/new_endpoint" }
@@ -0,0 +1,93 @@
+#include "source/common/router/route_path_index.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using Candidates = RoutePathIndex::Candidates;
+
+Candidates findCandidates(const RoutePathIndex& index, absl::string_view path) {
+  Candidates candidates;
+  index.findCandidates(path, candidates);
+  return candidates;
+}
+
+TEST(RoutePathIndexTest, Empty) {
+  RoutePathIndex index;
+  EXPECT_EQ(0, index.indexedRoutes());
+  EXPECT_TRUE(findCandidates(index, "/").empty());
+}
+
+TEST(RoutePathIndexTest, ExactPaths) {
+  RoutePathIndex index;
+  index.addExact("/foo", 0);
+  index.addExact("/foo/bar", 1);
+  index.addExact("/foo", 2);
+  EXPECT_EQ(3, index.indexedRoutes());
+
+  EXPECT_EQ((Candidates{0, 2}), findCandidates(index, "/foo"));
+  EXPECT_EQ((Candidates{1}), findCandidates(index, "/foo/bar"));
+  EXPECT_TRUE(findCandidates(index, "/foo/").empty());
+  EXPECT_TRUE(findCandidates(index, "/FOO").empty());
+}
+
+TEST(RoutePathIndexTest, Prefixes) {
+  RoutePathIndex index;
+  index.addPrefix("/api/", 0);
+  index.addPrefix("/api/v1/", 1);
+  index.addPrefix("/api/", 2);
+  index.addPrefix("", 3);
+  EXPECT_EQ(4, index.indexedRoutes());
+
+  EXPECT_EQ((Candidates{0, 1, 2, 3}), findCandidates(index, "/api/v1/users"));
+  EXPECT_EQ((Candidates{0, 2, 3}), findCandidates(index, "/api/v2"));
+  EXPECT_EQ((Candidates{3}), findCandidates(index, "/api"));
+}
+
+// Candidates from exact paths, prefixes and unindexed routes are merged in route order.
+TEST(RoutePathIndexTest, CandidatesInRouteOrder) {
+  RoutePathIndex index;
+  index.addPrefix("/api/", 0);
+  index.addExact("/api/v1/users", 1);
+  index.addUnindexed(2);
+  index.addPrefix("/api/v1/", 3);
+  index.addExact("/static/index.html", 4);
+  index.addUnindexed(5);
+  index.addPrefix("/", 6);
+  EXPECT_EQ(5, index.indexedRoutes());
+
+  EXPECT_EQ((Candidates{0, 1, 2, 3, 5, 6}), findCandidates(index, "/api/v1/users"));
+  EXPECT_EQ((Candidates{2, 4, 5, 6}), findCandidates(index, "/static/index.html"));
+  EXPECT_EQ((Candidates{2, 5}), findCandidates(index, "static"));
+
+  // Existing candidates are replaced.
+  Candidates candidates{42};
+  index.findCandidates("/api/v2", candidates);
+  EXPECT_EQ((Candidates{0, 2, 5, 6}), candidates);
+}
+
+// Regex routes are candidates for the paths fully matched by their regex.
+TEST(RoutePathIndexTest, Regexes) {
+  RoutePathIndex index;
+  EXPECT_TRUE(index.addRegex("/users/[0-9]+", 0));
+  index.addPrefix("/users/", 1);
+  EXPECT_TRUE(index.addRegex("/users/[0-9]+/posts", 2));
+  index.addUnindexed(3);
+  EXPECT_TRUE(index.addRegex(".*", 4));
+  EXPECT_FALSE(index.addRegex("(", 5));
+  index.addUnindexed(5);
+  index.finalize();
+  EXPECT_EQ(4, index.indexedRoutes());
+
+  EXPECT_EQ((Candidates{0, 1, 3, 4, 5}), findCandidates(index, "/users/42"));
+  EXPECT_EQ((Candidates{1, 2, 3, 4, 5}), findCandidates(index, "/users/42/posts"));
+  // The regexes are anchored at both ends.
+  EXPECT_EQ((Candidates{1, 3, 4, 5}), findCandidates(index, "/users/42/"));
+  EXPECT_EQ((Candidates{3, 4, 5}), findCandidates(index, "/api/users/42"));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
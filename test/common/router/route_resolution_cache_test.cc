@@ -0,0 +1,125 @@
+#include "source/common/router/route_resolution_cache.h"
+
+#include "test/mocks/router/mocks.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+class RouteResolutionCacheTest : public testing::Test {
+public:
+  RouteResolutionCacheTest() {
+    ON_CALL(*config_, routeResolutionCacheable()).WillByDefault(Return(true));
+  }
+
+  VirtualHostRoute route(const Http::RequestHeaderMap& headers) {
+    return cache_.route(config_, headers, stream_info_, 0);
+  }
+
+  static Http::TestRequestHeaderMapImpl requestHeaders(absl::string_view host,
+                                                       absl::string_view path) {
+    return Http::TestRequestHeaderMapImpl{
+        {":authority", std::string(host)}, {":path", std::string(path)},
+        {":method", "GET"},                {"x-forwarded-proto", "http"}};
+  }
+
+  std::shared_ptr<NiceMock<MockConfig>> config_{std::make_shared<NiceMock<MockConfig>>()};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  RouteResolutionCache cache_{4};
+};
+
+TEST_F(RouteResolutionCacheTest, ReusesResultForSameHostPathAndScheme) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(1);
+  const VirtualHostRoute first = route(requestHeaders("example.com", "/foo"));
+  const VirtualHostRoute second = route(requestHeaders("example.com", "/foo"));
+  EXPECT_EQ(config_->route_, first.route);
+  EXPECT_EQ(first.route, second.route);
+  EXPECT_EQ(first.vhost, second.vhost);
+
+  // The query string and fragment do not take part in route selection.
+  route(requestHeaders("example.com", "/foo?bar=baz"));
+  route(requestHeaders("example.com", "/foo#bar"));
+  EXPECT_EQ(1, cache_.size());
+}
+
+TEST_F(RouteResolutionCacheTest, DistinguishesHostPathAndScheme) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(4);
+  route(requestHeaders("example.com", "/foo"));
+  route(requestHeaders("example.com", "/bar"));
+  route(requestHeaders("example.org", "/foo"));
+  Http::TestRequestHeaderMapImpl https_headers = requestHeaders("example.com", "/foo");
+  https_headers.setForwardedProto("https");
+  route(https_headers);
+  EXPECT_EQ(4, cache_.size());
+
+  route(requestHeaders("example.com", "/bar"));
+  route(https_headers);
+}
+
+TEST_F(RouteResolutionCacheTest, CachesMissingRoutes) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).WillOnce(Return(VirtualHostRoute{}));
+  EXPECT_EQ(nullptr, route(requestHeaders("example.com", "/foo")).route);
+  EXPECT_EQ(nullptr, route(requestHeaders("example.com", "/foo")).route);
+}
+
+TEST_F(RouteResolutionCacheTest, NotCacheable) {
+  EXPECT_CALL(*config_, routeResolutionCacheable()).WillRepeatedly(Return(false));
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(2);
+  route(requestHeaders("example.com", "/foo"));
+  route(requestHeaders("example.com", "/foo"));
+  EXPECT_EQ(0, cache_.size());
+}
+
+TEST_F(RouteResolutionCacheTest, MissingHostOrPath) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(4);
+  Http::TestRequestHeaderMapImpl no_host{{":path", "/foo"}, {"x-forwarded-proto", "http"}};
+  Http::TestRequestHeaderMapImpl no_path{{":authority", "example.com"},
+                                         {"x-forwarded-proto", "http"}};
+  route(no_host);
+  route(no_host);
+  route(no_path);
+  route(no_path);
+  EXPECT_EQ(0, cache_.size());
+}
+
+// A new route configuration, e.g. from an RDS update, invalidates all cached results.
+TEST_F(RouteResolutionCacheTest, ClearedOnConfigChange) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(2);
+  route(requestHeaders("example.com", "/foo"));
+  route(requestHeaders("example.com", "/bar"));
+  EXPECT_EQ(2, cache_.size());
+
+  auto new_config = std::make_shared<NiceMock<MockConfig>>();
+  ON_CALL(*new_config, routeResolutionCacheable()).WillByDefault(Return(true));
+  EXPECT_CALL(*new_config, route(_, _, _, _)).Times(1);
+  const VirtualHostRoute result =
+      cache_.route(new_config, requestHeaders("example.com", "/foo"), stream_info_, 0);
+  EXPECT_EQ(new_config->route_, result.route);
+  EXPECT_EQ(1, cache_.size());
+}
+
+TEST_F(RouteResolutionCacheTest, ClearedWhenFull) {
+  EXPECT_CALL(*config_, route(_, _, _, _)).Times(6);
+  for (int i = 0; i < 4; ++i) {
+    route(requestHeaders("example.com", absl::StrCat("/", i)));
+  }
+  EXPECT_EQ(4, cache_.size());
+  route(requestHeaders("example.com", "/4"));
+  EXPECT_EQ(1, cache_.size());
+  route(requestHeaders("example.com", "/4"));
+  route(requestHeaders("example.com", "/0"));
+  EXPECT_EQ(2, cache_.size());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -32,6 +32,7 @@
 #include "source/common/stream_info/uint32_accessor_impl.h"
 #include "source/common/stream_info/utility.h"
 #include "source/common/tracing/http_tracer_impl.h"
+#include "source/common/upstream/request_latency_tracker_impl.h"
 #include "source/common/upstream/upstream_impl.h"
 
 #include "test/common/http/common.h"
@@ -2546,6 +2547,100 @@ TEST_F(RouterTest, HedgedPerTryTimeoutFirstRequestSucceeds) {
   // TODO: Verify hedge stats here once they are implemented.
 }
 
+// Tests that a hedged request is sent when the first try takes longer than the percentile of the
+// recent latencies of the cluster, and that the hedged request is not hedged again.
+TEST_F(RouterTest, HedgedOnLatencySecondRequestSucceeds) {
+  callbacks_.route_->route_entry_.hedge_policy_.hedge_latency_percentile_ = 95;
+  callbacks_.route_->route_entry_.hedge_policy_.hedge_budget_ratio_ = 1;
+  Upstream::RequestLatencyTrackerImpl& latency_tracker =
+      cm_.thread_local_cluster_.request_latency_tracker_;
+  for (uint64_t i = 0; i < Upstream::RequestLatencyTrackerImpl::MinLatencies; ++i) {
+    latency_tracker.onRequest();
+    latency_tracker.recordLatency(std::chrono::milliseconds(10));
+  }
+
+  NiceMock<Http::MockRequestEncoder> encoder1;
+  Http::ResponseDecoder* response_decoder1 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder1, &response_decoder1, Http::Protocol::Http10);
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putResult(Upstream::Outlier::Result::LocalOriginConnectSuccess,
+                        absl::optional<uint64_t>(absl::nullopt)))
+      .Times(2);
+  Event::MockTimer* hedge_timeout = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*hedge_timeout, enableTimer(std::chrono::milliseconds(11), _));
+  EXPECT_CALL(*hedge_timeout, disableTimer()).Times(testing::AnyNumber());
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+  EXPECT_EQ(1U, router_->upstreamRequests().size());
+
+  // The first try is neither reset nor counted as a timeout.
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putResult(Upstream::Outlier::Result::LocalOriginTimeout, _))
+      .Times(0);
+  EXPECT_CALL(encoder1.stream_, resetStream(_)).Times(0);
+  router_->retry_state_->expectHedgedPerTryTimeoutRetry();
+  hedge_timeout->invokeCallback();
+  EXPECT_EQ(1U, router_->stats().rq_hedged_on_latency_.value());
+
+  // The hedged request has no hedge timer.
+  NiceMock<Http::MockRequestEncoder> encoder2;
+  Http::ResponseDecoder* response_decoder2 = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder2, &response_decoder2, Http::Protocol::Http10);
+  router_->retry_state_->callback_();
+  EXPECT_EQ(2U, router_->upstreamRequests().size());
+
+  // The response of the hedged request is used, and the first try is reset.
+  EXPECT_CALL(*router_->retry_state_, shouldRetryHeaders(_, _, _))
+      .WillOnce(Return(RetryStatus::No));
+  EXPECT_CALL(cm_.thread_local_cluster_.conn_pool_.host_->outlier_detector_,
+              putResult(_, absl::optional<uint64_t>(200)));
+  EXPECT_CALL(encoder1.stream_, resetStream(_));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  ASSERT(response_decoder2);
+  response_decoder2->decodeHeaders(std::move(response_headers), true);
+  EXPECT_EQ(0U, router_->upstreamRequests().size());
+}
+
+// Tests that the requests are not hedged on their latency past the hedging budget.
+TEST_F(RouterTest, HedgedOnLatencyBudgetExceeded) {
+  callbacks_.route_->route_entry_.hedge_policy_.hedge_latency_percentile_ = 95;
+  callbacks_.route_->route_entry_.hedge_policy_.hedge_budget_ratio_ = 0;
+  Upstream::RequestLatencyTrackerImpl& latency_tracker =
+      cm_.thread_local_cluster_.request_latency_tracker_;
+  for (uint64_t i = 0; i < Upstream::RequestLatencyTrackerImpl::MinLatencies; ++i) {
+    latency_tracker.recordLatency(std::chrono::milliseconds(10));
+  }
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  Event::MockTimer* hedge_timeout = new Event::MockTimer(&callbacks_.dispatcher_);
+  EXPECT_CALL(*hedge_timeout, enableTimer(std::chrono::milliseconds(11), _));
+  EXPECT_CALL(*hedge_timeout, disableTimer()).Times(testing::AnyNumber());
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  router_->decodeHeaders(headers, true);
+
+  EXPECT_CALL(*router_->retry_state_, shouldHedgeRetryPerTryTimeout(_)).Times(0);
+  hedge_timeout->invokeCallback();
+  EXPECT_EQ(0U, router_->stats().rq_hedged_on_latency_.value());
+  EXPECT_EQ(1U, router_->stats().rq_hedge_budget_exceeded_.value());
+
+  EXPECT_CALL(*router_->retry_state_, shouldRetryHeaders(_, _, _))
+      .WillOnce(Return(RetryStatus::No));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, true));
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+}
+
 // Tests that an upstream request is reset even if it can't be retried as long as there is
 // another in-flight request we're waiting on.
 // Sequence:
@@ -5420,7 +5515,7 @@ makeShadowPolicy(std::string cluster = "", std::string cluster_header = "",
                  bool trace_sampled = true,
                  std::vector<envoy::config::common::mutation_rules::v3::HeaderMutation>
                      request_headers_mutations = {},
-                 std::string host_rewrite_literal = "") {
+                 std::string host_rewrite_literal = "", bool abandon_on_backpressure = false) {
   envoy::config::route::v3::RouteAction::RequestMirrorPolicy policy;
   policy.set_cluster(cluster);
   policy.set_cluster_header(cluster_header);
@@ -5440,6 +5535,7 @@ makeShadowPolicy(std::string cluster = "", std::string cluster_header = "",
   if (!host_rewrite_literal.empty()) {
     policy.set_host_rewrite_literal(host_rewrite_literal);
   }
+  policy.set_abandon_on_backpressure(abandon_on_backpressure);
 
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   return THROW_OR_RETURN_VALUE(ShadowPolicyImpl::create(policy, factory_context),
@@ -5673,6 +5769,62 @@ TEST_P(RouterShadowingTest, ShadowRequestCarriesParentContext) {
   router_->onDestroy();
 }
 
+// A shadow stream abandoned on backpressure is cancelled once over its high watermark, without
+// pushing back on the downstream, while the other shadow streams keep going.
+TEST_P(RouterShadowingTest, StreamingShadowAbandonedOnBackpressure) {
+  ShadowPolicyPtr policy =
+      makeShadowPolicy("foo", "", absl::nullopt, absl::nullopt, true, {}, "", true);
+  callbacks_.route_->route_entry_.shadow_policies_.push_back(policy);
+  policy = makeShadowPolicy("fizz");
+  callbacks_.route_->route_entry_.shadow_policies_.push_back(policy);
+  EXPECT_CALL(runtime_.snapshot_,
+              featureEnabled(_, testing::Matcher<const envoy::type::v3::FractionalPercent&>(_), _))
+      .WillRepeatedly(Return(true));
+
+  NiceMock<Http::MockRequestEncoder> encoder;
+  Http::ResponseDecoder* response_decoder = nullptr;
+  expectNewStreamWithImmediateEncoder(encoder, &response_decoder, Http::Protocol::Http10);
+  expectResponseTimerCreate();
+
+  Http::TestRequestHeaderMapImpl headers;
+  HttpTestUtility::addDefaultHeaders(headers);
+  NiceMock<Http::MockAsyncClient> foo_client;
+  NiceMock<Http::MockAsyncClientOngoingRequest> foo_request(&foo_client);
+  Http::SidestreamWatermarkCallbacks* foo_watermark_callbacks = nullptr;
+  EXPECT_CALL(*shadow_writer_, streamingShadow_("foo", _, _)).WillOnce(Return(&foo_request));
+  EXPECT_CALL(foo_request, setWatermarkCallbacks(_))
+      .WillOnce(Invoke([&](Http::SidestreamWatermarkCallbacks& callbacks) {
+        foo_watermark_callbacks = &callbacks;
+      }));
+  NiceMock<Http::MockAsyncClient> fizz_client;
+  NiceMock<Http::MockAsyncClientOngoingRequest> fizz_request(&fizz_client);
+  EXPECT_CALL(*shadow_writer_, streamingShadow_("fizz", _, _)).WillOnce(Return(&fizz_request));
+  router_->decodeHeaders(headers, false);
+  ASSERT_NE(nullptr, foo_watermark_callbacks);
+
+  Buffer::OwnedImpl first_data("hello");
+  EXPECT_CALL(foo_request, sendData(BufferStringEqual("hello"), false));
+  EXPECT_CALL(fizz_request, sendData(BufferStringEqual("hello"), false));
+  router_->decodeData(first_data, false);
+
+  EXPECT_CALL(callbacks_, onDecoderFilterAboveWriteBufferHighWatermark()).Times(0);
+  foo_watermark_callbacks->onSidestreamAboveHighWatermark();
+
+  Buffer::OwnedImpl last_data("world");
+  EXPECT_CALL(foo_request, removeWatermarkCallbacks());
+  EXPECT_CALL(foo_request, cancel());
+  EXPECT_CALL(foo_request, sendData(_, _)).Times(0);
+  EXPECT_CALL(fizz_request, sendData(BufferStringEqual("world"), true));
+  router_->decodeData(last_data, true);
+  EXPECT_EQ(1U, cm_.thread_local_cluster_.cluster_.info_->stats_store_
+                    .counter("retry_or_shadow_abandoned")
+                    .value());
+
+  Http::ResponseHeaderMapPtr response_headers(
+      new Http::TestResponseHeaderMapImpl{{":status", "200"}});
+  response_decoder->decodeHeaders(std::move(response_headers), true);
+}
+
 TEST_P(RouterShadowingTest, ShadowWithHeaderManipulation) {
   const std::vector<std::string> mutation_yamls = {
       R"EOF(
@@ -791,6 +791,55 @@ TEST_F(StaticLoaderImplTest, ProtoParsingRuntimeFeaturePrefixLegacy) {
   EXPECT_EQ(5, loader_->snapshot().getInteger(Http::MaxResponseHeadersSizeOverrideKey, 0));
 }
 
+TEST_F(StaticLoaderImplTest, ResolvedKeys) {
+  base_ = TestUtility::parseYaml<Protobuf::Struct>(R"EOF(
+    integer: 2
+    double: 2.5
+    boolean: true
+    fraction:
+      numerator: 0
+      denominator: HUNDRED
+  )EOF");
+  setup();
+
+  // The keys resolved together are loaded in a single snapshot.
+  Event::PostCb load_resolved_keys;
+  EXPECT_CALL(dispatcher_, post(_)).WillOnce([&load_resolved_keys](Event::PostCb cb) {
+    load_resolved_keys = std::move(cb);
+  });
+  const ResolvedKey integer = loader_->resolveKey("integer");
+  const ResolvedKey double_key = loader_->resolveKey("double");
+  const ResolvedKey boolean = loader_->resolveKey("boolean");
+  const ResolvedKey fraction = loader_->resolveKey("fraction");
+  const ResolvedKey missing = loader_->resolveKey("missing");
+  EXPECT_EQ(integer.index(), loader_->resolveKey("integer").index());
+  EXPECT_NE(integer.index(), double_key.index());
+  EXPECT_EQ("integer", integer.key());
+
+  envoy::type::v3::FractionalPercent always;
+  always.set_numerator(100);
+  EXPECT_CALL(generator_, random()).WillRepeatedly(Return(0));
+  const auto expect_values = [&]() {
+    const Snapshot& snapshot = loader_->snapshot();
+    EXPECT_EQ(2UL, snapshot.getInteger(integer, 1));
+    EXPECT_EQ(2.5, snapshot.getDouble(double_key, 1.5));
+    EXPECT_TRUE(snapshot.getBoolean(boolean, false));
+    EXPECT_FALSE(snapshot.featureEnabled(fraction, always));
+    EXPECT_EQ(1UL, snapshot.getInteger(missing, 1));
+    EXPECT_TRUE(snapshot.featureEnabled(missing, always));
+  };
+  // Looked up by key until the snapshot resolving them is loaded.
+  expect_values();
+  load_resolved_keys();
+  expect_values();
+
+  // Resolved in the snapshots loaded later.
+  ASSERT_TRUE(loader_->mergeValues({{"integer", "3"}, {"missing", "4"}}).ok());
+  EXPECT_EQ(3UL, loader_->snapshot().getInteger(integer, 1));
+  EXPECT_EQ(4UL, loader_->snapshot().getInteger(missing, 1));
+  EXPECT_EQ(2.5, loader_->snapshot().getDouble(double_key, 1.5));
+}
+
 TEST_F(StaticLoaderImplTest, InvalidNumerator) {
   base_ = TestUtility::parseYaml<Protobuf::Struct>(R"EOF(
     invalid_numerator:
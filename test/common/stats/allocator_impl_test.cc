@@ -5,6 +5,7 @@
 #include "envoy/stats/sink.h"
 
 #include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/counter_shards.h"
 
 #include "test/common/stats/stat_test_utility.h"
 #include "test/test_common/logging.h"
@@ -137,6 +138,110 @@ TEST_F(AllocatorImplTest, RefCountDecAllocRaceSynchronized) {
   EXPECT_FALSE(alloc_.isMutexLockedForTest());
 }
 
+// Sharded counters behave as regular counters, including when incremented from several threads.
+TEST_F(AllocatorImplTest, CounterLatchAndReset) {
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  EXPECT_FALSE(counter->used());
+  counter->add(5);
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+
+  // Increments pending at a reset are still latched.
+  counter->add(3);
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  counter->inc();
+  EXPECT_EQ(1, counter->value());
+  EXPECT_EQ(4, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+
+  counter->markUnused();
+  EXPECT_FALSE(counter->used());
+  counter->inc();
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(2, counter->value());
+  EXPECT_EQ(1, counter->latch());
+}
+
+TEST_F(AllocatorImplTest, ShardedCounters) {
+  CounterShards::setEnabled(true);
+  StatName counter_name = makeStat("counter.name");
+  CounterSharedPtr counter = alloc_.makeCounter(counter_name, StatName(), {});
+  CounterShards::setEnabled(false);
+  EXPECT_FALSE(counter->used());
+
+  counter->add(5);
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  const uint32_t num_threads = 12;
+  const uint32_t iters = 10000;
+  std::vector<Thread::ThreadPtr> threads;
+  absl::Notification go;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([&]() {
+      go.WaitForNotification();
+      for (uint32_t i = 0; i < iters; ++i) {
+        counter->inc();
+      }
+    }));
+  }
+  go.Notify();
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads[i]->join();
+  }
+  // The counts of exited threads are kept.
+  EXPECT_EQ(5 + num_threads * iters, counter->value());
+  EXPECT_EQ(num_threads * iters, counter->latch());
+
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  counter->inc();
+  EXPECT_EQ(1, counter->value());
+  EXPECT_EQ(1, counter->latch());
+
+  // A counter that reuses the slot of a deleted one starts from zero.
+  counter.reset();
+  CounterShards::setEnabled(true);
+  counter = alloc_.makeCounter(counter_name, StatName(), {});
+  CounterShards::setEnabled(false);
+  EXPECT_EQ(0, counter->value());
+  EXPECT_EQ(0, counter->latch());
+}
+
+TEST_F(AllocatorImplTest, LatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  gauge->set(5);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  gauge->sub(1);
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->add(1);
+  EXPECT_TRUE(gauge->latchChanged());
+  gauge->setParentValue(2);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+  // Eviction doesn't clear pending changes.
+  gauge->inc();
+  gauge->markUnused();
+  EXPECT_TRUE(gauge->latchChanged());
+
+  TextReadoutSharedPtr text_readout = alloc_.makeTextReadout(makeStat("text"), StatName(), {});
+  EXPECT_TRUE(text_readout->latchChanged());
+  EXPECT_FALSE(text_readout->latchChanged());
+  text_readout->set("value");
+  EXPECT_TRUE(text_readout->latchChanged());
+  EXPECT_FALSE(text_readout->latchChanged());
+}
+
 TEST_F(AllocatorImplTest, HiddenGauge) {
   GaugeSharedPtr hidden_gauge =
       alloc_.makeGauge(makeStat("hidden"), StatName(), {}, Gauge::ImportMode::HiddenAccumulate);
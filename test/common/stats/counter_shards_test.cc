@@ -0,0 +1,71 @@
+#include <vector>
+
+#include "source/common/stats/counter_shards.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+TEST(CounterShardsTest, SumsThreadSlots) {
+  const uint32_t slot = CounterShards::allocateSlot().value();
+  const uint32_t other_slot = CounterShards::allocateSlot().value();
+  EXPECT_NE(slot, other_slot);
+  EXPECT_EQ(0, CounterShards::sum(slot));
+
+  CounterShards::add(slot, 3);
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < 4; ++i) {
+    threads.push_back(thread_factory.createThread([slot]() { CounterShards::add(slot, 10); }));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ(43, CounterShards::sum(slot));
+  EXPECT_EQ(0, CounterShards::sum(other_slot));
+
+  // Threads started later reuse the tables of exited threads, and add to their counts.
+  threads.clear();
+  threads.push_back(thread_factory.createThread([slot]() { CounterShards::add(slot, 1); }));
+  threads[0]->join();
+  EXPECT_EQ(44, CounterShards::sum(slot));
+
+  CounterShards::releaseSlot(other_slot);
+  CounterShards::releaseSlot(slot);
+  const uint32_t reused_slot = CounterShards::allocateSlot().value();
+  EXPECT_EQ(slot, reused_slot);
+  EXPECT_EQ(0, CounterShards::sum(reused_slot));
+  CounterShards::releaseSlot(reused_slot);
+}
+
+TEST(CounterShardsTest, LocalValues) {
+  const uint32_t slot = CounterShards::allocateSlot().value();
+  EXPECT_EQ(0, CounterShards::local(slot));
+  EXPECT_EQ(5, CounterShards::add(slot, 5));
+  // Adding the two's complement subtracts.
+  EXPECT_EQ(3, CounterShards::add(slot, ~uint64_t(2) + 1));
+
+  uint64_t other_local = 1;
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread(
+      [slot, &other_local]() { other_local = CounterShards::local(slot); });
+  thread->join();
+  EXPECT_EQ(0, other_local);
+  EXPECT_EQ(3, CounterShards::local(slot));
+  CounterShards::releaseSlot(slot);
+}
+
+TEST(CounterShardsTest, Enabled) {
+  EXPECT_FALSE(CounterShards::enabled());
+  CounterShards::setEnabled(true);
+  EXPECT_TRUE(CounterShards::enabled());
+  CounterShards::setEnabled(false);
+  EXPECT_FALSE(CounterShards::enabled());
+}
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
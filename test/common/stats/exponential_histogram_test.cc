@@ -0,0 +1,81 @@
+#include <vector>
+
+#include "source/common/stats/exponential_histogram.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+using testing::ElementsAre;
+
+using Buckets = std::vector<ParentHistogram::Bucket>;
+
+TEST(ExponentialHistogramBucketsTest, Empty) {
+  const auto buckets = ExponentialHistogramBuckets::fromDetailedBuckets({}, 160, 0.5);
+  EXPECT_EQ(ExponentialHistogramBuckets::DefaultMaxScale, buckets.scale_);
+  EXPECT_EQ(0, buckets.zero_count_);
+  EXPECT_TRUE(buckets.counts_.empty());
+  EXPECT_EQ(0, buckets.totalCount());
+}
+
+TEST(ExponentialHistogramBucketsTest, MaxScale) {
+  // At scale 4, 1.05 falls into bucket 1 and 1.55 into bucket 10.
+  const auto buckets = ExponentialHistogramBuckets::fromDetailedBuckets(
+      Buckets{{0, 0, 3}, {1, 0.1, 1}, {1.5, 0.1, 2}, {4, 1, 0}}, 160, 0.5);
+  EXPECT_EQ(4, buckets.scale_);
+  EXPECT_EQ(3, buckets.zero_count_);
+  EXPECT_EQ(1, buckets.offset_);
+  EXPECT_THAT(buckets.counts_, ElementsAre(1, 0, 0, 0, 0, 0, 0, 0, 0, 2));
+  EXPECT_EQ(6, buckets.totalCount());
+}
+
+TEST(ExponentialHistogramBucketsTest, Downscale) {
+  const auto buckets = ExponentialHistogramBuckets::fromDetailedBuckets(
+      Buckets{{0, 0, 3}, {1, 0.1, 2}, {2, 0.1, 5}, {100, 1, 1}, {1e6, 1e4, 4}}, 4, 0.5);
+  EXPECT_EQ(-3, buckets.scale_);
+  EXPECT_EQ(3, buckets.zero_count_);
+  EXPECT_EQ(0, buckets.offset_);
+  EXPECT_THAT(buckets.counts_, ElementsAre(8, 0, 4));
+}
+
+TEST(ExponentialHistogramBucketsTest, MinScale) {
+  const auto buckets = ExponentialHistogramBuckets::fromDetailedBuckets(
+      Buckets{{1, 0.1, 1}, {1e300, 1e298, 1}}, 1, 0.5);
+  EXPECT_EQ(ExponentialHistogramBuckets::MinScale, buckets.scale_);
+  EXPECT_EQ(2, buckets.totalCount());
+}
+
+TEST(ExponentialHistogramBucketsTest, Merge) {
+  auto merged = ExponentialHistogramBuckets::fromDetailedBuckets(
+      Buckets{{0, 0, 3}, {1, 0.1, 2}, {2, 0.1, 5}, {100, 1, 1}, {1e6, 1e4, 4}}, 4, 0.5);
+  const auto other = ExponentialHistogramBuckets::fromDetailedBuckets(
+      Buckets{{1, 0.1, 1}, {1.5, 0.1, 1}}, 160, 0.5);
+  EXPECT_EQ(4, other.scale_);
+  merged.merge(other, 4);
+  EXPECT_EQ(-3, merged.scale_);
+  EXPECT_EQ(3, merged.zero_count_);
+  EXPECT_EQ(0, merged.offset_);
+  EXPECT_THAT(merged.counts_, ElementsAre(10, 0, 4));
+
+  ExponentialHistogramBuckets empty;
+  empty.merge(other, 160);
+  EXPECT_EQ(other.scale_, empty.scale_);
+  EXPECT_EQ(other.offset_, empty.offset_);
+  EXPECT_EQ(other.counts_, empty.counts_);
+}
+
+TEST(ExponentialHistogramBucketsTest, MergeDownscalesToFit) {
+  auto low = ExponentialHistogramBuckets::fromDetailedBuckets(Buckets{{1, 0.1, 1}}, 4, 0.5);
+  const auto high = ExponentialHistogramBuckets::fromDetailedBuckets(Buckets{{7, 1, 1}}, 4, 0.5);
+  low.merge(high, 4);
+  EXPECT_EQ(0, low.scale_);
+  EXPECT_EQ(0, low.offset_);
+  EXPECT_THAT(low.counts_, ElementsAre(1, 0, 1));
+}
+
+} // namespace
+} // namespace Stats
+} // namespace Envoy
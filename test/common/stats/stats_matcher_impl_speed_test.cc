@@ -89,3 +89,29 @@ static void BM_Exclusion(benchmark::State& state) {
   }
 }
 BENCHMARK(BM_Exclusion);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_ManyExclusionPrefixes(benchmark::State& state) {
+  // Create matcher with 400 token prefixes, as used to keep per-endpoint stats out of memory.
+  Envoy::Stats::StatsMatcherPerf context;
+  for (auto idx = 0; idx < 400; ++idx) {
+    context.exclusionList()->set_prefix(absl::StrCat("cluster.cluster_", idx, ".endpoint."));
+  }
+  context.initMatcher();
+  std::vector<Envoy::Stats::StatName> stat_names;
+  stat_names.reserve(10);
+  for (auto idx = 0; idx < 10; ++idx) {
+    stat_names.push_back(
+        context.pool_.add(absl::StrCat("cluster.cluster_", idx * 50, ".upstream_rq_total")));
+  }
+
+  for (auto _ : state) { // NOLINT
+    for (auto idx = 0; idx < 1000; ++idx) {
+      const Envoy::Stats::StatName stat_name = stat_names[idx % 10];
+      const Envoy::Stats::StatsMatcher::FastResult fast_result =
+          context.stats_matcher_impl_->fastRejects(stat_name);
+      context.stats_matcher_impl_->slowRejects(fast_result, stat_name);
+    }
+  }
+}
+BENCHMARK(BM_ManyExclusionPrefixes);
@@ -6,6 +6,7 @@
 #include "test/mocks/server/server_factory_context.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -333,6 +334,56 @@ TEST_F(StatsMatcherTest, CheckMultipleAssortedExclusionMatchersWithPrefix) {
   EXPECT_FALSE(stats_matcher_impl_->rejectsAll());
 }
 
+TEST_F(StatsMatcherTest, CheckManyExcludeExactAndPrefix) {
+  for (int i = 0; i < 400; ++i) {
+    exclusionList()->set_prefix(absl::StrCat("cluster.cluster_", i, "."));
+    exclusionList()->set_exact(absl::StrCat("listener.listener_", i, ".downstream_cx_total"));
+  }
+  initMatcher();
+  expectAccepted({"cluster.cluster_400.upstream_rq_total", "cluster.cluster_1",
+                  "listener.listener_1.downstream_cx_active", "listener.listener_1",
+                  "listener.listener_1.downstream_cx_total.foo", "cluster_1.upstream_rq_total"});
+  expectDenied({"cluster.cluster_0.upstream_rq_total", "cluster.cluster_399.foo.bar",
+                "listener.listener_0.downstream_cx_total",
+                "listener.listener_399.downstream_cx_total"});
+
+  // Exact and prefix matches are decided without the slow path.
+  StatName stat_name = pool_.add("cluster.cluster_7.upstream_rq_total");
+  EXPECT_EQ(StatsMatcher::FastResult::Rejects, stats_matcher_impl_->fastRejects(stat_name));
+  stat_name = pool_.add("listener.listener_7.downstream_cx_active");
+  EXPECT_EQ(StatsMatcher::FastResult::NoMatch, stats_matcher_impl_->fastRejects(stat_name));
+  EXPECT_FALSE(stats_matcher_impl_->slowRejects(StatsMatcher::FastResult::NoMatch, stat_name));
+}
+
+TEST_F(StatsMatcherTest, CheckExcludeExactAndPrefixDynamic) {
+  exclusionList()->set_prefix("cluster.foo.");
+  exclusionList()->set_exact("listener.bar.downstream_cx_total");
+  initMatcher();
+
+  // Names with dynamic components are matched as strings.
+  StatNameDynamicPool dynamic_pool(symbol_table_);
+  for (const absl::string_view name :
+       {"cluster.foo.upstream_rq_total", "listener.bar.downstream_cx_total"}) {
+    StatName stat_name = dynamic_pool.add(name);
+    EXPECT_TRUE(stats_matcher_impl_->rejects(stat_name)) << name;
+  }
+  for (const absl::string_view name :
+       {"cluster.bar.upstream_rq_total", "listener.bar.downstream_cx_active"}) {
+    StatName stat_name = dynamic_pool.add(name);
+    EXPECT_FALSE(stats_matcher_impl_->rejects(stat_name)) << name;
+  }
+}
+
+TEST_F(StatsMatcherTest, CheckIncludeExactDynamic) {
+  inclusionList()->set_exact("listener.bar.downstream_cx_total");
+  initMatcher();
+  StatNameDynamicPool dynamic_pool(symbol_table_);
+  EXPECT_FALSE(stats_matcher_impl_->rejects(dynamic_pool.add("listener.bar.downstream_cx_total")));
+  EXPECT_TRUE(stats_matcher_impl_->rejects(dynamic_pool.add("listener.bar.downstream_cx_active")));
+  expectAccepted({"listener.bar.downstream_cx_total"});
+  expectDenied({"listener.bar.downstream_cx_active", "listener.bar"});
+}
+
 TEST_F(StatsMatcherTest, SkipSlowRejectsOnFastReject) {
   inclusionList()->set_suffix("xyz");
   initMatcher();
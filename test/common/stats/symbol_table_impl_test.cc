@@ -624,6 +624,37 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   }
 }
 
+// Decoding doesn't take the table lock, so it must be safe while other threads
+// add symbols, growing the decode index, and free unrelated ones.
+TEST_F(StatNameTest, DecodeWhileAddingSymbols) {
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  const StatName held = makeStat("held.stat.name");
+
+  constexpr int num_threads = 8;
+  std::atomic<bool> done{false};
+  std::vector<Thread::ThreadPtr> threads;
+  threads.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([this, held, &done]() {
+      while (!done.load()) {
+        EXPECT_EQ("held.stat.name", table_.toString(held));
+      }
+    }));
+  }
+
+  for (int i = 0; i < 50 * 1000; ++i) {
+    makeStat(absl::StrCat("added_", i));
+    StatNameStorage transient(absl::StrCat("transient_", i), table_);
+    transient.free(table_);
+  }
+  done = true;
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  EXPECT_EQ("held.stat.name", table_.toString(held));
+  EXPECT_EQ("added_49999", encodeDecode("added_49999"));
+}
+
 TEST_F(StatNameTest, SharedStatNameStorageSetInsertAndFind) {
   StatNameStorageSet set;
   const int iters = 10;
@@ -139,6 +139,35 @@ static void bmCompareElements(benchmark::State& state) {
 }
 BENCHMARK(bmCompareElements);
 
+// Decodes stat names from many threads at once, as admin handlers and stats
+// sinks do while workers keep running. Decoding takes no table lock, so this
+// should scale with the number of threads.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmDecodeContended(benchmark::State& state) {
+  static Envoy::Stats::SymbolTableImpl* symbol_table;
+  static Envoy::Stats::StatNamePool* pool;
+  static std::vector<Envoy::Stats::StatName>* names;
+  if (state.thread_index() == 0) {
+    symbol_table = new Envoy::Stats::SymbolTableImpl;
+    pool = new Envoy::Stats::StatNamePool(*symbol_table);
+    names = new std::vector<Envoy::Stats::StatName>(prepareNames(*pool, 1000));
+  }
+
+  uint32_t index = state.thread_index();
+  size_t total_length = 0;
+  for (auto _ : state) { // NOLINT
+    total_length += symbol_table->toString((*names)[index++ % names->size()]).size();
+  }
+  benchmark::DoNotOptimize(total_length);
+
+  if (state.thread_index() == 0) {
+    delete names;
+    delete pool;
+    delete symbol_table;
+  }
+}
+BENCHMARK(bmDecodeContended)->ThreadRange(1, 16)->UseRealTime();
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmSortByStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
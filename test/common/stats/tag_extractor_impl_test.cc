@@ -46,6 +46,30 @@ TEST(TagExtractorTest, RE2Variants) {
   EXPECT_EQ("cluster_name", tags.at(0).name_);
 }
 
+TEST(TagExtractorTest, RE2Prefilter) {
+  TagExtractorRe2Impl cluster_extractor("cluster_name", "^cluster\\.(([^\\.]+)\\.).*");
+  TagExtractorRe2Impl listener_extractor("listener_port", "^listener\\.((\\d+)\\.)");
+  re2::RE2::Set prefilter(re2::RE2::DefaultOptions, re2::RE2::UNANCHORED);
+  cluster_extractor.addToPrefilter(prefilter);
+  listener_extractor.addToPrefilter(prefilter);
+  ASSERT_TRUE(prefilter.Compile());
+
+  std::string name = "cluster.test_cluster.upstream_cx_total";
+  TagVector tags;
+  IntervalSetImpl<size_t> remove_characters;
+  TagExtractionContext tag_extraction_context(name, &prefilter);
+  EXPECT_FALSE(listener_extractor.extractTag(tag_extraction_context, tags, remove_characters));
+  ASSERT_TRUE(cluster_extractor.extractTag(tag_extraction_context, tags, remove_characters));
+  EXPECT_EQ("cluster.upstream_cx_total", StringUtil::removeCharacters(name, remove_characters));
+  ASSERT_EQ(1, tags.size());
+  EXPECT_EQ("test_cluster", tags.at(0).value_);
+
+  // Without a prefilter in the context, every regex may match.
+  TagExtractionContext no_prefilter_context(name);
+  EXPECT_TRUE(no_prefilter_context.mayMatch(0));
+  EXPECT_TRUE(no_prefilter_context.mayMatch(1));
+}
+
 TEST(TagExtractorTest, SingleSubexpression) {
   TagExtractorStdRegexImpl tag_extractor("listner_port", "^listener\\.(\\d+?\\.)");
   std::string name = "listener.80.downstream_cx_total";
@@ -7,6 +7,7 @@
 #include "source/common/common/thread.h"
 #include "source/common/event/dispatcher_impl.h"
 #include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/counter_shards.h"
 #include "source/common/stats/stats_matcher_impl.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/tag_producer_impl.h"
@@ -138,5 +139,36 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
+// Tests the multi-threaded performance of incrementing a single counter from all benchmark
+// threads, as workers do with counters such as downstream_rq_total. The counter is sharded per
+// thread if `state.range(0)` is non-zero.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_CounterIncContended(benchmark::State& state) {
+  static std::unique_ptr<Envoy::Stats::SymbolTableImpl> symbol_table;
+  static std::unique_ptr<Envoy::Stats::AllocatorImpl> alloc;
+  static Envoy::Stats::CounterSharedPtr counter;
+  if (state.thread_index() == 0) {
+    Envoy::Stats::CounterShards::setEnabled(state.range(0) != 0);
+    symbol_table = std::make_unique<Envoy::Stats::SymbolTableImpl>();
+    alloc = std::make_unique<Envoy::Stats::AllocatorImpl>(*symbol_table);
+    Envoy::Stats::StatNameManagedStorage name("http.ingress.downstream_rq_total", *symbol_table);
+    counter = alloc->makeCounter(name.statName(), Envoy::Stats::StatName(), {});
+    Envoy::Stats::CounterShards::setEnabled(false);
+  }
+
+  // All threads start the loop once the counter is created and finish it before it is destroyed.
+  for (auto _ : state) { // NOLINT
+    counter->inc();
+  }
+
+  if (state.thread_index() == 0) {
+    benchmark::DoNotOptimize(counter->value());
+    counter.reset();
+    alloc.reset();
+    symbol_table.reset();
+  }
+}
+BENCHMARK(BM_CounterIncContended)->Arg(0)->Arg(1)->ThreadRange(1, 16)->UseRealTime();
+
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
 // looks up stats in multiple threads to try to trigger contention issues.
@@ -27,6 +27,7 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_split.h"
@@ -1899,6 +1900,31 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Same as MultiHistogramMultipleMerges, with the TLS histograms merged in parallel.
+TEST_F(HistogramTest, MultiHistogramMultipleParallelMerges) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.parallel_histogram_merge", "true"}});
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+  Histogram& h2 = scope_.histogramFromString("h2", Histogram::Unit::Unspecified);
+
+  expectCallAndAccumulate(h1, 1);
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h2, 1);
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h1, 2);
+  expectCallAndAccumulate(h2, 3);
+  EXPECT_EQ(2, validateMerge());
+
+  // Intervals without values leave the cumulative values alone.
+  EXPECT_EQ(2, validateMerge());
+  EXPECT_EQ(2, validateMerge());
+
+  expectCallAndAccumulate(h2, 2);
+  EXPECT_EQ(2, validateMerge());
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -2363,6 +2389,34 @@ TEST_F(HistogramThreadTest, MakeHistogramsAndRecordValues) {
               HasSubstr(absl::StrCat(" B25(0,0) B50(", NumThreads, ",", NumThreads, ") ")));
 }
 
+TEST_F(HistogramThreadTest, ParallelMerge) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.parallel_histogram_merge", "true"}});
+  foreachThread([this]() {
+    for (uint32_t i = 0; i < 200; ++i) {
+      Histogram& histogram =
+          scope_.histogramFromString(absl::StrCat("my_hist", i), Histogram::Unit::Unspecified);
+      histogram.recordValue(42);
+    }
+  });
+
+  mergeHistograms();
+
+  auto histograms = store_->histograms();
+  ASSERT_EQ(200, histograms.size());
+  for (const ParentHistogramSharedPtr& hist : histograms) {
+    EXPECT_THAT(hist->bucketSummary(),
+                HasSubstr(absl::StrCat(" B25(0,0) B50(", NumThreads, ",", NumThreads, ") ")));
+  }
+
+  // Only the cumulative histograms keep the values after an interval without values.
+  mergeHistograms();
+  for (const ParentHistogramSharedPtr& hist : histograms) {
+    EXPECT_THAT(hist->bucketSummary(),
+                HasSubstr(absl::StrCat(" B25(0,0) B50(0,", NumThreads, ") ")));
+  }
+}
+
 TEST_F(HistogramThreadTest, ScopeOverlap) {
   // Creating two scopes with the same name gets you two distinct scope objects.
   ScopeSharedPtr scope1 = store_->createScope("scope.");
@@ -327,6 +327,42 @@ TEST_F(FilterStateImplTest, LifeSpanInitFromGrandparent) {
   EXPECT_EQ(6, new_filter_state.getDataMutable<SimpleType>("test_6")->access());
 }
 
+TEST_F(FilterStateImplTest, LifeSpanInitFromGrandparentCreatesParentLazily) {
+  auto connection_state = std::make_shared<FilterStateImpl>(FilterState::LifeSpan::Connection);
+  connection_state->setData("test_1", std::make_unique<SimpleType>(1),
+                            FilterState::StateType::Mutable, FilterState::LifeSpan::Connection);
+
+  FilterStateImpl new_filter_state(connection_state, FilterState::LifeSpan::FilterChain);
+  // The data of the grandparent is found without creating the parent.
+  EXPECT_TRUE(new_filter_state.hasDataWithName("test_1"));
+  EXPECT_EQ(1, new_filter_state.getDataReadOnly<SimpleType>("test_1")->access());
+  EXPECT_TRUE(new_filter_state.hasDataAtOrAboveLifeSpan(FilterState::LifeSpan::Request));
+  EXPECT_TRUE(new_filter_state.objectsSharedWithUpstreamConnection()->empty());
+
+  new_filter_state.setData("test_2", std::make_unique<SimpleType>(2),
+                           FilterState::StateType::Mutable, FilterState::LifeSpan::Request);
+  ASSERT_NE(nullptr, new_filter_state.parent());
+  EXPECT_EQ(FilterState::LifeSpan::Request, new_filter_state.parent()->lifeSpan());
+  EXPECT_EQ(connection_state, new_filter_state.parent()->parent());
+  EXPECT_TRUE(new_filter_state.parent()->hasDataWithName("test_2"));
+  EXPECT_EQ(1, new_filter_state.getDataMutable<SimpleType>("test_1")->access());
+  EXPECT_FALSE(connection_state->hasDataWithName("test_2"));
+}
+
+TEST_F(FilterStateImplTest, LifeSpanInitFromGrandparentParentAccessor) {
+  auto connection_state = std::make_shared<FilterStateImpl>(FilterState::LifeSpan::Connection);
+  FilterStateImpl new_filter_state(connection_state, FilterState::LifeSpan::FilterChain);
+
+  // Asking for the parent creates it, so that data can be set in it.
+  FilterStateSharedPtr parent = new_filter_state.parent();
+  ASSERT_NE(nullptr, parent);
+  EXPECT_EQ(parent, new_filter_state.parent());
+  EXPECT_EQ(connection_state, parent->parent());
+  parent->setData("test_1", std::make_unique<SimpleType>(1), FilterState::StateType::ReadOnly,
+                  FilterState::LifeSpan::Request);
+  EXPECT_TRUE(new_filter_state.hasDataWithName("test_1"));
+}
+
 TEST_F(FilterStateImplTest, LifeSpanInitFromNonParent) {
   filterState().setData("test_1", std::make_unique<SimpleType>(1), FilterState::StateType::ReadOnly,
                         FilterState::LifeSpan::FilterChain);
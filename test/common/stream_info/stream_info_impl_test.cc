@@ -136,6 +136,23 @@ TEST_F(StreamInfoImplTest, BytesTest) {
   EXPECT_EQ(bytes_received, stream_info.bytesReceived());
 }
 
+TEST_F(StreamInfoImplTest, UpstreamBytesMeter) {
+  StreamInfoImpl stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr,
+                             FilterState::LifeSpan::FilterChain);
+  auto upstream_bytes_meter = std::make_shared<BytesMeter>();
+  stream_info.setUpstreamBytesMeter(upstream_bytes_meter);
+  EXPECT_EQ(upstream_bytes_meter, stream_info.getUpstreamBytesMeter());
+
+  // Without an upstream stream setting its meter, one is created when first asked for, and the
+  // bytes it accumulated are carried over to the meter set later.
+  StreamInfoImpl other_stream_info(Http::Protocol::Http2, test_time_.timeSystem(), nullptr,
+                                   FilterState::LifeSpan::FilterChain);
+  ASSERT_NE(nullptr, other_stream_info.getUpstreamBytesMeter());
+  other_stream_info.getUpstreamBytesMeter()->addWireBytesSent(10);
+  other_stream_info.setUpstreamBytesMeter(upstream_bytes_meter);
+  EXPECT_EQ(10, other_stream_info.getUpstreamBytesMeter()->wireBytesSent());
+}
+
 // This is used to ensure the new extendable response flags are compatible with the legacy one
 // and the legacyResponseFlags() method works as expected.
 // TODO(wbpcode): remove this class and related test after the legacyResponseFlags() method is
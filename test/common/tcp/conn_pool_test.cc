@@ -116,6 +116,12 @@ public:
     return conn_pool_->newConnection(callbacks);
   }
   Upstream::HostDescriptionConstSharedPtr host() const override { return conn_pool_->host(); }
+  void idleConnectionsLastUsed(std::vector<MonotonicTime>& last_used) const override {
+    conn_pool_->idleConnectionsLastUsed(last_used);
+  }
+  uint32_t closeIdleConnections(MonotonicTime last_used_cutoff, uint32_t limit) override {
+    return conn_pool_->closeIdleConnections(last_used_cutoff, limit);
+  }
 
   MOCK_METHOD(void, onConnReleasedForTest, ());
   MOCK_METHOD(void, onConnDestroyedForTest, ());
@@ -463,6 +469,53 @@ TEST_F(TcpConnPoolImplTest, IdleTimerCloseConnections) {
   EXPECT_EQ(1U, cluster_->traffic_stats_->upstream_cx_idle_timeout_.value());
 }
 
+/**
+ * Verify that the least recently used idle connections are closed first, up to the limit.
+ */
+TEST_F(TcpConnPoolImplTest, CloseLeastRecentlyUsedIdleConnections) {
+  initialize();
+  cluster_->resetResourceManager(3, 1024, 1024, 1, 1);
+
+  ActiveTestConn c1(*this, 0, ActiveTestConn::Type::CreateConnection);
+  ActiveTestConn c2(*this, 1, ActiveTestConn::Type::CreateConnection);
+  ActiveTestConn c3(*this, 2, ActiveTestConn::Type::CreateConnection);
+
+  EXPECT_CALL(*conn_pool_, onConnReleasedForTest()).Times(2);
+  c2.releaseConn();
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  c1.releaseConn();
+  const MonotonicTime now = simTime().monotonicTime();
+
+  // c3 still has its connection attached so only c1 and c2 are idle.
+  std::vector<MonotonicTime> last_used;
+  conn_pool_->idleConnectionsLastUsed(last_used);
+  ASSERT_EQ(2, last_used.size());
+  EXPECT_EQ(std::chrono::seconds(1), std::max(last_used[0], last_used[1]) -
+                                         std::min(last_used[0], last_used[1]));
+
+  // Connections used after the cutoff are kept.
+  EXPECT_EQ(0, conn_pool_->closeIdleConnections(now - std::chrono::seconds(2), 2));
+
+  {
+    EXPECT_CALL(*conn_pool_->test_conns_[1].connection_, close(_));
+    EXPECT_CALL(*conn_pool_, onConnDestroyedForTest());
+    EXPECT_EQ(1, conn_pool_->closeIdleConnections(now, 1));
+    dispatcher_.clearDeferredDeleteList();
+  }
+  {
+    EXPECT_CALL(*conn_pool_->test_conns_[0].connection_, close(_));
+    EXPECT_CALL(*conn_pool_, onConnDestroyedForTest());
+    EXPECT_EQ(1, conn_pool_->closeIdleConnections(now, 2));
+    dispatcher_.clearDeferredDeleteList();
+  }
+
+  EXPECT_CALL(*conn_pool_, onConnReleasedForTest());
+  EXPECT_CALL(*conn_pool_, onConnDestroyedForTest());
+  c3.releaseConn();
+  conn_pool_->drainConnections(Envoy::ConnectionPool::DrainBehavior::DrainExistingConnections);
+  dispatcher_.clearDeferredDeleteList();
+}
+
 /**
  * Verify idle timer is disable by remote close.
  */
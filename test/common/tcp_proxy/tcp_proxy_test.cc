@@ -266,6 +266,60 @@ TEST_P(TcpProxyTest, HalfCloseProxy) {
   upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+// Tests that a clean downstream half-close returns the upstream connection to the pool instead of
+// being proxied.
+TEST_P(TcpProxyTest, ReuseUpstreamConnectionOnDownstreamHalfClose) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_reuse_upstream_connections(true);
+  setup(1, config);
+
+  bool released = false;
+  upstream_connection_data_.at(0)->release_callback_ = [&released]() { released = true; };
+  ON_CALL(*upstream_connections_.at(0), readEnabled()).WillByDefault(Return(true));
+  EXPECT_CALL(*upstream_connections_.at(0), close(_, _)).Times(0);
+  raiseEventUpstreamConnected(0);
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), false));
+  upstream_callbacks_->onUpstreamData(response, false);
+
+  EXPECT_CALL(*upstream_connections_.at(0), write(_, true)).Times(0);
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::FlushWrite));
+  Buffer::OwnedImpl end_stream;
+  EXPECT_EQ(Network::FilterStatus::StopIteration, filter_->onData(end_stream, true));
+  EXPECT_TRUE(released);
+  EXPECT_EQ(1U, config_->stats().upstream_cx_released_for_reuse_.value());
+}
+
+// Tests that the upstream connection is not reused once the upstream has half-closed.
+TEST_P(TcpProxyTest, ReuseUpstreamConnectionNotAfterUpstreamHalfClose) {
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy config = defaultConfig();
+  config.set_reuse_upstream_connections(true);
+  setup(1, config);
+
+  bool released = false;
+  upstream_connection_data_.at(0)->release_callback_ = [&released]() { released = true; };
+  ON_CALL(*upstream_connections_.at(0), readEnabled()).WillByDefault(Return(true));
+  raiseEventUpstreamConnected(0);
+
+  Buffer::OwnedImpl response("world");
+  EXPECT_CALL(filter_callbacks_.connection_, write(BufferEqual(&response), true));
+  upstream_callbacks_->onUpstreamData(response, true);
+
+  EXPECT_CALL(*upstream_connections_.at(0), write(_, true));
+  Buffer::OwnedImpl end_stream;
+  filter_->onData(end_stream, true);
+  EXPECT_FALSE(released);
+  EXPECT_EQ(0U, config_->stats().upstream_cx_released_for_reuse_.value());
+
+  EXPECT_CALL(filter_callbacks_.connection_, close(_));
+  upstream_callbacks_->onEvent(Network::ConnectionEvent::RemoteClose);
+}
+
 // Test with an explicitly configured upstream.
 TEST_P(TcpProxyTest, ExplicitFactory) {
   // Explicitly configure an HTTP upstream, to test factory creation.
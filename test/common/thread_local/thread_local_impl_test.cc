@@ -297,6 +297,62 @@ TEST_F(ThreadLocalInstanceImplTest, RunOnAllThreads) {
   tls_.shutdownThread();
 }
 
+// The worker part of the updates of a batch reaches the worker in a single post once the outermost
+// batch is destroyed, and their completions run in a single main thread post.
+TEST_F(ThreadLocalInstanceImplTest, BatchedUpdates) {
+  TypedSlotPtr<> slot1 = TypedSlot<>::makeUnique(tls_);
+  TestThreadLocalObject& object1 = setObject(*slot1);
+  TypedSlotPtr<> slot2 = TypedSlot<>::makeUnique(tls_);
+  TestThreadLocalObject& object2 = setObject(*slot2);
+
+  std::vector<std::string> calls;
+  auto update = [&calls](std::string name) {
+    return [&calls, name](OptRef<ThreadLocalObject>) { calls.push_back(name); };
+  };
+  auto complete = [&calls](std::string name) {
+    return [&calls, name]() { calls.push_back(name); };
+  };
+  {
+    UpdateBatchPtr batch = tls_.batchUpdates();
+    UpdateBatchPtr nested_batch = tls_.batchUpdates();
+    EXPECT_CALL(thread_dispatcher_, post(_)).Times(0);
+    slot1->runOnAllThreads(update("update1"), complete("complete1"));
+    slot2->runOnAllThreads(update("update2"));
+    slot1->runOnAllThreads(update("update3"), complete("complete3"));
+    nested_batch.reset();
+    // Only the main thread ran the updates so far.
+    EXPECT_EQ(std::vector<std::string>({"update1", "update2", "update3"}), calls);
+
+    EXPECT_CALL(thread_dispatcher_, post(_));
+    EXPECT_CALL(main_dispatcher_, post(_));
+  }
+  EXPECT_EQ(std::vector<std::string>({"update1", "update2", "update3", "update1", "update2",
+                                      "update3", "complete1", "complete3"}),
+            calls);
+
+  // Setting a slot delivers the queued updates first.
+  calls.clear();
+  TypedSlotPtr<> slot3 = TypedSlot<>::makeUnique(tls_);
+  {
+    UpdateBatchPtr batch = tls_.batchUpdates();
+    slot2->runOnAllThreads(update("update4"));
+    EXPECT_CALL(thread_dispatcher_, post(_)).Times(2);
+    slot3->set([&calls](Event::Dispatcher&) -> ThreadLocalObjectSharedPtr {
+      calls.push_back("set");
+      return nullptr;
+    });
+  }
+  EXPECT_EQ(std::vector<std::string>({"update4", "update4", "set", "set"}), calls);
+
+  tls_.shutdownGlobalThreading();
+  slot1.reset();
+  slot2.reset();
+  slot3.reset();
+  EXPECT_CALL(object1, onDestroy());
+  EXPECT_CALL(object2, onDestroy());
+  tls_.shutdownThread();
+}
+
 // Validate ThreadLocal::InstanceImpl's dispatcher() behavior.
 TEST(ThreadLocalInstanceImplDispatcherTest, Dispatcher) {
   InstanceImpl tls;
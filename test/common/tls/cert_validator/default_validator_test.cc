@@ -9,6 +9,7 @@
 #include "test/mocks/server/server_factory_context.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -680,6 +681,143 @@ TEST(DefaultCertValidatorTest, WithVerifyDepth) {
   EXPECT_EQ(X509_STORE_CTX_get_error(store_ctx.get()), X509_V_OK);
 }
 
+TEST(DefaultCertValidatorTest, VerifiedChainCache) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  TestCertificateValidationContextConfig config(
+      typed_conf, false, {},
+      TestEnvironment::readFileToStringForTest(
+          TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")));
+  config.setVerifiedChainCache({16, std::chrono::hours(1)});
+  DefaultCertValidator default_validator(&config, stats, context);
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  ASSERT_TRUE(default_validator.initializeSslContexts({ssl_ctx.get()}, false,
+                                                      *test_store.rootScope())
+                  .ok());
+
+  bssl::UniquePtr<STACK_OF(X509)> cert_chain(sk_X509_new_null());
+  ASSERT_TRUE(bssl::PushToStack(cert_chain.get(), readCertFromFile(TestEnvironment::substitute(
+                                                   "{{ test_rundir }}/test/common/tls/test_data/"
+                                                   "san_dns_cert.pem"))));
+  for (int i = 0; i < 2; i++) {
+    ValidationResults results = default_validator.doVerifyCertChain(
+        *cert_chain, /*callback=*/nullptr, /*transport_socket_options=*/nullptr, *ssl_ctx, {},
+        false, "");
+    EXPECT_EQ(ValidationResults::ValidationStatus::Successful, results.status);
+    EXPECT_EQ(Ssl::ClientValidationStatus::Validated, results.detailed_status);
+  }
+  EXPECT_EQ(1, stats.verified_chain_cache_miss_.value());
+  EXPECT_EQ(1, stats.verified_chain_cache_hit_.value());
+
+  // Chains failing verification aren't cached.
+  bssl::UniquePtr<STACK_OF(X509)> untrusted_chain(sk_X509_new_null());
+  ASSERT_TRUE(bssl::PushToStack(untrusted_chain.get(), readCertFromFile(TestEnvironment::substitute(
+                                                   "{{ test_rundir }}/test/common/tls/test_data/"
+                                                   "fake_ca_cert.pem"))));
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(ValidationResults::ValidationStatus::Failed,
+              default_validator
+                  .doVerifyCertChain(*untrusted_chain, /*callback=*/nullptr,
+                                     /*transport_socket_options=*/nullptr, *ssl_ctx, {}, false, "")
+                  .status);
+  }
+  EXPECT_EQ(3, stats.verified_chain_cache_miss_.value());
+  EXPECT_EQ(1, stats.verified_chain_cache_hit_.value());
+}
+
+class TestValidateResultCallback : public Ssl::ValidateResultCallback {
+public:
+  struct Result {
+    bool succeeded_{};
+    Ssl::ClientValidationStatus detailed_status_{};
+    std::string error_details_;
+  };
+
+  TestValidateResultCallback(Event::Dispatcher& dispatcher, absl::optional<Result>& result)
+      : dispatcher_(dispatcher), result_(result) {}
+
+  // Ssl::ValidateResultCallback
+  Event::Dispatcher& dispatcher() override { return dispatcher_; }
+  void onCertValidationResult(bool succeeded, Ssl::ClientValidationStatus detailed_status,
+                              const std::string& error_details, uint8_t) override {
+    EXPECT_TRUE(dispatcher_.isThreadSafe());
+    result_ = Result{succeeded, detailed_status, error_details};
+    dispatcher_.exit();
+  }
+
+private:
+  Event::Dispatcher& dispatcher_;
+  absl::optional<Result>& result_;
+};
+
+TEST(DefaultCertValidatorTest, OffloadTrustChainVerification) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  ON_CALL(context.api_, threadFactory())
+      .WillByDefault(testing::ReturnRef(Thread::threadFactoryForTest()));
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Stats::TestUtil::TestStore test_store;
+  SslStats stats = generateSslStats(*test_store.rootScope());
+  envoy::config::core::v3::TypedExtensionConfig typed_conf;
+  TestCertificateValidationContextConfig config(
+      typed_conf, false, {},
+      TestEnvironment::readFileToStringForTest(
+          TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem")));
+  config.setTrustChainVerificationOffloadThreads(2);
+  auto default_validator = std::make_unique<DefaultCertValidator>(&config, stats, context);
+  SSLContextPtr ssl_ctx = SSL_CTX_new(TLS_method());
+  ASSERT_TRUE(default_validator
+                  ->initializeSslContexts({ssl_ctx.get()}, false, *test_store.rootScope())
+                  .ok());
+
+  bssl::UniquePtr<STACK_OF(X509)> cert_chain(sk_X509_new_null());
+  ASSERT_TRUE(bssl::PushToStack(cert_chain.get(), readCertFromFile(TestEnvironment::substitute(
+                                                   "{{ test_rundir }}/test/common/tls/test_data/"
+                                                   "san_dns_cert.pem"))));
+  absl::optional<TestValidateResultCallback::Result> result;
+  auto verify_async = [&](STACK_OF(X509)& chain) {
+    auto callback = std::make_unique<TestValidateResultCallback>(*dispatcher, result);
+    return default_validator
+        ->doVerifyCertChain(chain, std::move(callback), /*transport_socket_options=*/nullptr,
+                            *ssl_ctx, {}, false, "")
+        .status;
+  };
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending, verify_async(*cert_chain));
+  dispatcher->run(Event::Dispatcher::RunType::RunUntilExit);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_TRUE(result->succeeded_);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Validated, result->detailed_status_);
+
+  bssl::UniquePtr<STACK_OF(X509)> untrusted_chain(sk_X509_new_null());
+  ASSERT_TRUE(bssl::PushToStack(untrusted_chain.get(), readCertFromFile(TestEnvironment::substitute(
+                                                   "{{ test_rundir }}/test/common/tls/test_data/"
+                                                   "fake_ca_cert.pem"))));
+  result.reset();
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending, verify_async(*untrusted_chain));
+  dispatcher->run(Event::Dispatcher::RunType::RunUntilExit);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_FALSE(result->succeeded_);
+  EXPECT_EQ(Ssl::ClientValidationStatus::Failed, result->detailed_status_);
+  EXPECT_THAT(result->error_details_, testing::HasSubstr("verify cert failed"));
+  EXPECT_EQ(1, stats.fail_verify_error_.value());
+
+  // Without a callback, the chain is verified synchronously.
+  EXPECT_EQ(ValidationResults::ValidationStatus::Successful,
+            default_validator
+                ->doVerifyCertChain(*cert_chain, /*callback=*/nullptr,
+                                    /*transport_socket_options=*/nullptr, *ssl_ctx, {}, false, "")
+                .status);
+
+  // The results of the verifications are dropped once the validator is destroyed.
+  result.reset();
+  EXPECT_EQ(ValidationResults::ValidationStatus::Pending, verify_async(*cert_chain));
+  default_validator.reset();
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_FALSE(result.has_value());
+}
+
 class MockCertificateValidationContextConfig : public Ssl::CertificateValidationContextConfig {
 public:
   MockCertificateValidationContextConfig() : MockCertificateValidationContextConfig("") {}
@@ -711,12 +849,19 @@ public:
   MOCK_METHOD(Api::Api&, api, (), (const override));
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  const absl::optional<VerifiedChainCacheConfig>& verifiedChainCache() const override {
+    return verified_chain_cache_;
+  }
+  absl::optional<uint32_t> trustChainVerificationOffloadThreads() const override {
+    return absl::nullopt;
+  }
   bool autoSniSanMatch() const override { return false; }
 
 private:
   std::string s_;
   std::vector<std::string> strs_;
   std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher> matchers_;
+  absl::optional<VerifiedChainCacheConfig> verified_chain_cache_;
 };
 
 TEST(DefaultCertValidatorTest, TestUnexpectedSanMatcherType) {
@@ -787,6 +932,12 @@ public:
   Api::Api& api() const override { return *api_; }
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
   absl::optional<uint32_t> maxVerifyDepth() const override { return absl::nullopt; }
+  const absl::optional<VerifiedChainCacheConfig>& verifiedChainCache() const override {
+    return verified_chain_cache_;
+  }
+  absl::optional<uint32_t> trustChainVerificationOffloadThreads() const override {
+    return absl::nullopt;
+  }
   bool autoSniSanMatch() const override { return false; }
 
 private:
@@ -795,6 +946,7 @@ private:
   std::vector<std::string> empty_strs_;
   std::vector<envoy::extensions::transport_sockets::tls::v3::SubjectAltNameMatcher> empty_matchers_;
   absl::optional<envoy::config::core::v3::TypedExtensionConfig> custom_config_;
+  absl::optional<VerifiedChainCacheConfig> verified_chain_cache_;
   Api::ApiPtr api_ = Api::createApiForTest();
 };
 
@@ -113,6 +113,18 @@ public:
   bool onlyVerifyLeafCertificateCrl() const override { return false; }
 
   absl::optional<uint32_t> maxVerifyDepth() const override { return max_verify_depth_; }
+  const absl::optional<VerifiedChainCacheConfig>& verifiedChainCache() const override {
+    return verified_chain_cache_;
+  }
+  void setVerifiedChainCache(const VerifiedChainCacheConfig& config) {
+    verified_chain_cache_ = config;
+  }
+  absl::optional<uint32_t> trustChainVerificationOffloadThreads() const override {
+    return trust_chain_verification_offload_threads_;
+  }
+  void setTrustChainVerificationOffloadThreads(uint32_t threads) {
+    trust_chain_verification_offload_threads_ = threads;
+  }
   bool autoSniSanMatch() const override { return auto_sni_san_match_; }
 
 private:
@@ -125,6 +137,8 @@ private:
   const std::string ca_cert_path_{"TEST_CA_CERT_PATH"};
   const std::string ca_cert_name_{"TEST_CA_CERT_NAME"};
   const absl::optional<uint32_t> max_verify_depth_{absl::nullopt};
+  absl::optional<VerifiedChainCacheConfig> verified_chain_cache_;
+  absl::optional<uint32_t> trust_chain_verification_offload_threads_;
   const bool auto_sni_san_match_{false};
 };
 
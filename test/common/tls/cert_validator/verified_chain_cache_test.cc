@@ -0,0 +1,94 @@
+#include <chrono>
+
+#include "source/common/tls/cert_validator/verified_chain_cache.h"
+
+#include "test/common/tls/ssl_test_utility.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+bssl::UniquePtr<STACK_OF(X509)> readChain(const std::vector<std::string>& names) {
+  bssl::UniquePtr<STACK_OF(X509)> chain(sk_X509_new_null());
+  for (const std::string& name : names) {
+    EXPECT_TRUE(bssl::PushToStack(
+        chain.get(), readCertFromFile(TestEnvironment::substitute(
+                         absl::StrCat("{{ test_rundir }}/test/common/tls/test_data/", name)))));
+  }
+  return chain;
+}
+
+class VerifiedChainCacheTest : public testing::Test {
+protected:
+  Event::SimulatedTimeSystem time_system_;
+};
+
+TEST_F(VerifiedChainCacheTest, Key) {
+  auto leaf = readChain({"san_dns_cert.pem"});
+  auto other_leaf = readChain({"san_uri_cert.pem"});
+  auto chain =
+      readChain({"spiffe_san_signed_by_intermediate_cert.pem", "intermediate_ca_cert.pem"});
+  auto leaf_only = readChain({"spiffe_san_signed_by_intermediate_cert.pem"});
+
+  EXPECT_EQ(VerifiedChainCache::key(*leaf, true), VerifiedChainCache::key(*leaf, true));
+  EXPECT_NE(VerifiedChainCache::key(*leaf, true), VerifiedChainCache::key(*leaf, false));
+  EXPECT_NE(VerifiedChainCache::key(*leaf, true), VerifiedChainCache::key(*other_leaf, true));
+  // The intermediates are part of the key.
+  EXPECT_NE(VerifiedChainCache::key(*chain, true), VerifiedChainCache::key(*leaf_only, true));
+}
+
+TEST_F(VerifiedChainCacheTest, Expiration) {
+  VerifiedChainCache cache(16, std::chrono::minutes(10), time_system_);
+  const SystemTime now = time_system_.systemTime();
+  cache.insert("a", now + std::chrono::hours(1));
+  cache.insert("b", now + std::chrono::minutes(1));
+  // Already expired verifications aren't cached.
+  cache.insert("c", now);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_TRUE(cache.contains("b"));
+  EXPECT_FALSE(cache.contains("c"));
+
+  time_system_.advanceTimeWait(std::chrono::minutes(1));
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_FALSE(cache.contains("b"));
+  EXPECT_EQ(1, cache.size());
+
+  // The max TTL caps later expirations.
+  time_system_.advanceTimeWait(std::chrono::minutes(9));
+  EXPECT_FALSE(cache.contains("a"));
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(VerifiedChainCacheTest, EvictLeastRecentlyUsed) {
+  VerifiedChainCache cache(2, std::chrono::minutes(10), time_system_);
+  const SystemTime expires_at = time_system_.systemTime() + std::chrono::hours(1);
+  cache.insert("a", expires_at);
+  cache.insert("b", expires_at);
+  EXPECT_TRUE(cache.contains("a"));
+  cache.insert("c", expires_at);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_FALSE(cache.contains("b"));
+  EXPECT_TRUE(cache.contains("c"));
+
+  // Inserting a cached key refreshes it.
+  cache.insert("a", expires_at);
+  cache.insert("d", expires_at);
+  EXPECT_TRUE(cache.contains("a"));
+  EXPECT_FALSE(cache.contains("c"));
+  EXPECT_TRUE(cache.contains("d"));
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -9,8 +9,10 @@
 #include "source/common/common/base64.h"
 #include "source/common/crypto/utility.h"
 #include "source/common/json/json_loader.h"
+#include "source/common/network/utility.h"
 #include "source/common/secret/sds_api.h"
 #include "source/common/stats/isolated_store_impl.h"
+#include "source/common/tls/client_context_impl.h"
 #include "source/common/tls/context_config_impl.h"
 #include "source/common/tls/context_impl.h"
 #include "source/common/tls/server_context_config_impl.h"
@@ -28,6 +30,7 @@
 #include "test/mocks/secret/mocks.h"
 #include "test/mocks/server/server_factory_context.h"
 #include "test/mocks/ssl/mocks.h"
+#include "test/mocks/upstream/host.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
@@ -1392,6 +1395,37 @@ TEST_F(ClientContextConfigImplTest, EmptyServerNameIndication) {
             "SNI names containing NULL-byte are not allowed");
 }
 
+// Validate that sessions are only offered to the upstream host they were stored for when the
+// session cache is keyed by host.
+TEST_F(ClientContextConfigImplTest, HostKeyedSessionCache) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.tls_host_keyed_session_cache", "true"}});
+
+  envoy::extensions::transport_sockets::tls::v3::UpstreamTlsContext tls_context;
+  tls_context.mutable_max_session_keys()->set_value(2);
+  auto cfg = *ClientContextConfigImpl::create(tls_context, factory_context_);
+  Envoy::Ssl::ClientContextSharedPtr context(
+      *manager_.createSslClientContext(*store_.rootScope(), *cfg));
+  auto cleanup = cleanUpHelper(context);
+  auto& client_context = dynamic_cast<ClientContextImpl&>(*context);
+
+  auto host1 = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  auto host2 = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  const auto address2 = *Network::Utility::resolveUrl("tcp://10.0.0.2:443");
+  ON_CALL(*host2, address()).WillByDefault(Return(address2));
+
+  bssl::UniquePtr<SSL> ssl = *client_context.newSsl(nullptr, host1);
+  EXPECT_EQ(nullptr, SSL_get_session(ssl.get()));
+  SSL_CTX* ctx = SSL_get_SSL_CTX(ssl.get());
+  SSL_SESSION* session = SSL_SESSION_new(ctx);
+  // The context takes ownership of the session.
+  EXPECT_EQ(1, SSL_CTX_sess_get_new_cb(ctx)(ssl.get(), session));
+
+  EXPECT_EQ(session, SSL_get_session((*client_context.newSsl(nullptr, host1)).get()));
+  EXPECT_EQ(nullptr, SSL_get_session((*client_context.newSsl(nullptr, host2)).get()));
+}
+
 // Validate that it is an error configure `auto_sni_san_validation` without configuring
 // a validation context.
 TEST_F(ClientContextConfigImplTest, AutoSniSanValidationWithoutValidationContext) {
@@ -0,0 +1,39 @@
+#include <string>
+
+#include "source/common/tls/ktls.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace Ktls {
+namespace {
+
+std::string handshakeMessage(uint8_t type, absl::string_view body) {
+  std::string message{static_cast<char>(type), 0, 0, static_cast<char>(body.size())};
+  return message + std::string(body);
+}
+
+TEST(KtlsTest, OnlySessionTickets) {
+  EXPECT_TRUE(onlySessionTickets(handshakeMessage(4, "ticket")));
+  EXPECT_TRUE(onlySessionTickets(handshakeMessage(4, "") + handshakeMessage(4, "ticket")));
+}
+
+TEST(KtlsTest, NotOnlySessionTickets) {
+  EXPECT_FALSE(onlySessionTickets(""));
+  // KeyUpdate.
+  EXPECT_FALSE(onlySessionTickets(handshakeMessage(24, "\x01")));
+  EXPECT_FALSE(onlySessionTickets(handshakeMessage(4, "ticket") + handshakeMessage(24, "\x01")));
+  // Truncated header and body.
+  EXPECT_FALSE(onlySessionTickets(std::string("\x04\x00\x00", 3)));
+  EXPECT_FALSE(onlySessionTickets(handshakeMessage(4, "ticket").substr(0, 6)));
+}
+
+} // namespace
+} // namespace Ktls
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -4404,6 +4404,82 @@ TEST_P(SslSocketTest, TicketSessionResumptionRotateKey) {
                               version_);
 }
 
+// With a rotation schedule that has ended, tickets are encrypted with the last key.
+TEST_P(SslSocketTest, TicketSessionResumptionRotationScheduleEnded) {
+  const std::string server_ctx_yaml1 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  session_ticket_keys:
+    keys:
+    - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_a"
+    - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_b"
+    rotation:
+      start_time: "1970-01-01T00:00:00Z"
+      interval: 1s
+)EOF";
+
+  const std::string server_ctx_yaml2 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  session_ticket_keys:
+    keys:
+      filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_b"
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml1, {}, server_ctx_yaml2, {}, client_ctx_yaml, true,
+                              version_);
+}
+
+// With a rotation schedule that hasn't started, tickets are encrypted with the first key.
+TEST_P(SslSocketTest, TicketSessionResumptionRotationScheduleNotStarted) {
+  const std::string server_ctx_yaml1 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  session_ticket_keys:
+    keys:
+    - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_a"
+    - filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_b"
+    rotation:
+      start_time: "2100-01-01T00:00:00Z"
+      interval: 1s
+)EOF";
+
+  const std::string server_ctx_yaml2 = R"EOF(
+  common_tls_context:
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  session_ticket_keys:
+    keys:
+      filename: "{{ test_rundir }}/test/common/tls/test_data/ticket_key_b"
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml1, {}, server_ctx_yaml2, {}, client_ctx_yaml, false,
+                              version_);
+}
+
 TEST_P(SslSocketTest, TicketSessionResumptionWrongKey) {
   const std::string server_ctx_yaml1 = R"EOF(
   common_tls_context:
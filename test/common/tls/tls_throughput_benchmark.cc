@@ -1,4 +1,10 @@
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tls/ktls.h"
 
 #include "test/test_common/environment.h"
 
@@ -174,6 +180,118 @@ static void testThroughput(benchmark::State& state) {
   ::close(sockets[1]);
 }
 
+// Writes full-sized slices on a TCP loopback connection with its record layer offloaded to kernel
+// TLS, with the kernel encrypting the slices written by the socket without linearizing them.
+static void testKernelTlsThroughput(benchmark::State& state) {
+  std::string error;
+  std::unique_ptr<bazel::tools::cpp::runfiles::Runfiles> runfiles(
+      bazel::tools::cpp::runfiles::Runfiles::Create("tls_throughput_benchmark", &error));
+  Envoy::TestEnvironment::setRunfiles(runfiles.get());
+
+  // The kernel TLS upper layer protocol is only available on TCP sockets.
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(::bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len) == 0, "bind");
+  RELEASE_ASSERT(::listen(listener, 1) == 0, "listen");
+  RELEASE_ASSERT(::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) == 0,
+                 "getsockname");
+  const int client_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(::connect(client_fd, reinterpret_cast<sockaddr*>(&addr), addr_len) == 0,
+                 "connect");
+  const int server_fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK);
+  RELEASE_ASSERT(server_fd >= 0, "accept");
+  ::close(listener);
+  RELEASE_ASSERT(::fcntl(client_fd, F_SETFL, O_NONBLOCK) == 0, "fcntl");
+  Network::IoSocketHandleImpl client_handle(client_fd);
+  Network::IoSocketHandleImpl server_handle(server_fd);
+
+  bssl::UniquePtr<SSL_CTX> server_ctx(SSL_CTX_new(TLS_method()));
+  bssl::UniquePtr<SSL_CTX> client_ctx(SSL_CTX_new(TLS_method()));
+  std::string cert_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_cert.pem");
+  std::string key_path =
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/san_dns_key.pem");
+  auto err = SSL_CTX_use_certificate_file(server_ctx.get(), cert_path.c_str(), SSL_FILETYPE_PEM);
+  drainErrorQueue();
+  RELEASE_ASSERT(err > 0, "SSL_CTX_use_certificate_file");
+  err = SSL_CTX_use_PrivateKey_file(server_ctx.get(), key_path.c_str(), SSL_FILETYPE_PEM);
+  RELEASE_ASSERT(err > 0, "SSL_CTX_use_PrivateKey_file");
+  // Session tickets would be left for the offloaded client to read.
+  SSL_CTX_set_options(server_ctx.get(), SSL_OP_NO_TICKET);
+
+  bssl::UniquePtr<SSL> server_ssl(SSL_new(server_ctx.get()));
+  SSL_set_fd(server_ssl.get(), server_fd);
+  SSL_set_accept_state(server_ssl.get());
+
+  bssl::UniquePtr<SSL> client_ssl(SSL_new(client_ctx.get()));
+  SSL_set_fd(client_ssl.get(), client_fd);
+  SSL_set_connect_state(client_ssl.get());
+
+  bool handshake_success = false;
+  for (int i = 0; i < 50; i++) {
+    int client_err = SSL_do_handshake(client_ssl.get());
+    int server_err = SSL_do_handshake(server_ssl.get());
+    if (client_err == 1 && server_err == 1) {
+      handshake_success = true;
+      break;
+    }
+    handleSslError(client_ssl.get(), client_err, false);
+    handleSslError(server_ssl.get(), server_err, true);
+  }
+
+  RELEASE_ASSERT(handshake_success, "handshake completed successfully");
+
+  const absl::Status tx_status =
+      Ktls::installKeys(client_ssl.get(), client_handle, Ktls::Direction::Tx);
+  const absl::Status rx_status =
+      Ktls::installKeys(server_ssl.get(), server_handle, Ktls::Direction::Rx);
+  if (!tx_status.ok() || !rx_status.ok()) {
+    state.SkipWithError(
+        absl::StrCat("kernel TLS unavailable: ", tx_status.message(), rx_status.message()));
+    return;
+  }
+
+  static uint8_t read_buf[1024 * 1024];
+
+  const unsigned move_slices = state.range(0);
+
+  uint64_t bytes_written = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    state.PauseTiming();
+
+    // Empty out the read side to make space for the writes.
+    while (::read(server_fd, read_buf, sizeof(read_buf)) > 0) {
+    }
+
+    Buffer::OwnedImpl write_buf;
+    addFullSlices(write_buf, 10, move_slices);
+    bytes_written += write_buf.length();
+
+    state.ResumeTiming();
+    uint32_t num_writes = 0;
+    while (write_buf.length() > 0) {
+      Api::IoCallUint64Result result = client_handle.write(write_buf);
+      if (!result.ok()) {
+        RELEASE_ASSERT(result.err_->getErrorCode() == Api::IoError::IoErrorCode::Again,
+                       absl::StrCat("write failed: ", result.err_->getErrorDetails()));
+        // The socket buffers are full, make space for the remaining writes.
+        while (::read(server_fd, read_buf, sizeof(read_buf)) > 0) {
+        }
+      }
+      num_writes++;
+    }
+
+    state.counters["writes_per_iteration"] = num_writes;
+  }
+  state.counters["throughput"] = benchmark::Counter(bytes_written, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(testKernelTlsThroughput)->Unit(::benchmark::kMicrosecond)->Arg(false)->Arg(true);
+
 static void testParams(benchmark::internal::Benchmark* b) {
   for (auto move_slices : {false, true}) {
     for (auto align_to_16kb : {false, true}) {
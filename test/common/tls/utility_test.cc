@@ -12,8 +12,10 @@
 #include "test/common/tls/test_data/san_dns_cert_info.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/time/time.h"
 #include "gtest/gtest.h"
 #include "openssl/ssl.h"
@@ -343,6 +345,31 @@ TEST(UtilityTest, TestMapX509Stack) {
   EXPECT_EQ(std::vector<std::string>{""}, Utility::mapX509Stack(*fake_cert_chain, func));
 }
 
+TEST(UtilityTest, ReadPemX509Infos) {
+  const std::string ca_cert = TestEnvironment::readFileToStringForTest(
+      TestEnvironment::substitute("{{ test_rundir }}/test/common/tls/test_data/ca_cert.pem"));
+  // Large enough to be read on several threads.
+  constexpr int certs = 1000;
+  std::string bundle;
+  for (int i = 0; i < certs; ++i) {
+    absl::StrAppend(&bundle, "# Certificate ", i, "\n", ca_cert);
+  }
+
+  bssl::UniquePtr<STACK_OF(X509_INFO)> items =
+      Utility::readPemX509Infos(bundle, Thread::threadFactoryForTest());
+  ASSERT_NE(items, nullptr);
+  ASSERT_EQ(sk_X509_INFO_num(items.get()), certs);
+  for (const X509_INFO* item : items.get()) {
+    ASSERT_NE(item->x509, nullptr);
+    EXPECT_EQ(Utility::getSubjectFromCertificate(*item->x509),
+              Utility::getSubjectFromCertificate(*sk_X509_INFO_value(items.get(), 0)->x509));
+  }
+
+  // A malformed block fails the whole bundle, wherever it is.
+  absl::StrAppend(&bundle, "-----BEGIN CERTIFICATE-----\ninvalid\n-----END CERTIFICATE-----\n");
+  EXPECT_EQ(Utility::readPemX509Infos(bundle, Thread::threadFactoryForTest()), nullptr);
+}
+
 } // namespace
 } // namespace Tls
 } // namespace TransportSockets
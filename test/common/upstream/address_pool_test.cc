@@ -0,0 +1,53 @@
+#include "envoy/config/core/v3/address.pb.h"
+
+#include "source/common/network/address_impl.h"
+#include "source/common/upstream/address_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+envoy::config::core::v3::Address makeConfig(uint32_t port) {
+  envoy::config::core::v3::Address config;
+  config.mutable_socket_address()->set_address("10.0.0.1");
+  config.mutable_socket_address()->set_port_value(port);
+  return config;
+}
+
+TEST(AddressPoolTest, FindInserted) {
+  AddressPool pool;
+  EXPECT_EQ(nullptr, pool.find(makeConfig(80)));
+
+  auto address = std::make_shared<const Network::Address::Ipv4Instance>("10.0.0.1", 80);
+  pool.insert(makeConfig(80), address);
+  EXPECT_EQ(address, pool.find(makeConfig(80)));
+  EXPECT_EQ(nullptr, pool.find(makeConfig(81)));
+
+  // The pool does not keep the address alive.
+  address.reset();
+  EXPECT_EQ(nullptr, pool.find(makeConfig(80)));
+}
+
+TEST(AddressPoolTest, PurgeExpired) {
+  AddressPool pool;
+  auto kept = std::make_shared<const Network::Address::Ipv4Instance>("10.0.0.1", 0);
+  pool.insert(makeConfig(0), kept);
+  for (uint32_t port = 1; port < AddressPool::MinPurgeThreshold - 1; ++port) {
+    pool.insert(makeConfig(port),
+                std::make_shared<const Network::Address::Ipv4Instance>("10.0.0.1", port));
+  }
+  EXPECT_EQ(AddressPool::MinPurgeThreshold - 1, pool.size());
+
+  // Reaching the threshold purges all freed addresses.
+  auto added = std::make_shared<const Network::Address::Ipv4Instance>("10.0.0.1", 1);
+  pool.insert(makeConfig(AddressPool::MinPurgeThreshold), added);
+  EXPECT_EQ(2UL, pool.size());
+  EXPECT_EQ(kept, pool.find(makeConfig(0)));
+  EXPECT_EQ(added, pool.find(makeConfig(AddressPool::MinPurgeThreshold)));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,159 @@
+#include "source/common/common/random_generator.h"
+#include "source/common/upstream/alias_scheduler.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// Returns the random number that picks `bucket` of a table of `size` buckets, from the bucket's own
+// entry if `own` is set or from its alias otherwise.
+uint64_t randomForBucket(uint32_t bucket, uint32_t size, bool own) {
+  // The upper half selects bucket floor(upper * size / 2^32).
+  const uint64_t upper = ((uint64_t(bucket) << 32) + size - 1) / size;
+  return (upper << 32) | (own ? 0 : 0xffffffff);
+}
+
+TEST(AliasSchedulerTest, Empty) {
+  NiceMock<Random::MockRandomGenerator> random;
+  AliasScheduler<uint32_t> sched(random);
+  EXPECT_TRUE(sched.empty());
+  EXPECT_EQ(nullptr, sched.peekAgain([](const uint32_t&) { return 1; }));
+  EXPECT_EQ(nullptr, sched.pickAndAdd([](const uint32_t&) { return 1; }));
+}
+
+// Validate that each bucket picks its own entry when all weights are the same.
+TEST(AliasSchedulerTest, Unweighted) {
+  Random::MockRandomGenerator random;
+  AliasScheduler<uint32_t> sched(random);
+  constexpr uint32_t num_entries = 16;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+  EXPECT_FALSE(sched.empty());
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(i, num_entries, false)));
+    EXPECT_EQ(i, *sched.pickAndAdd([](const uint32_t&) { return 1; }));
+  }
+}
+
+// Validate the alias table with weights 1 and 3: the bucket of the light entry picks the heavy
+// entry with probability 1/2, which gives the heavy entry a probability of 3/4 overall.
+TEST(AliasSchedulerTest, Weighted) {
+  Random::MockRandomGenerator random;
+  AliasScheduler<uint32_t> sched(random);
+  auto light = std::make_shared<uint32_t>(0);
+  auto heavy = std::make_shared<uint32_t>(1);
+  sched.add(1, light);
+  sched.add(3, heavy);
+
+  const auto weight = [](const uint32_t& x) { return x == 0 ? 1 : 3; };
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, true)));
+  EXPECT_EQ(light, sched.pickAndAdd(weight));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, false)));
+  EXPECT_EQ(heavy, sched.pickAndAdd(weight));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, true) | 0x7fffffff));
+  EXPECT_EQ(light, sched.pickAndAdd(weight));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, true) | 0x80000000));
+  EXPECT_EQ(heavy, sched.pickAndAdd(weight));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(1, 2, true)));
+  EXPECT_EQ(heavy, sched.pickAndAdd(weight));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(1, 2, false)));
+  EXPECT_EQ(heavy, sched.pickAndAdd(weight));
+}
+
+// Validate that the pick frequencies converge to the weights.
+TEST(AliasSchedulerTest, ProbabilityVerification) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<uint32_t> sched(random);
+  constexpr uint32_t num_entries = 8;
+  constexpr uint32_t picks_per_weight = 10000;
+  std::shared_ptr<uint32_t> entries[num_entries];
+  uint32_t pick_count[num_entries] = {};
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(i + 1, entries[i]);
+  }
+
+  const uint32_t weight_sum = num_entries * (num_entries + 1) / 2;
+  for (uint32_t i = 0; i < weight_sum * picks_per_weight; ++i) {
+    ++pick_count[*sched.pickAndAdd([](const uint32_t& x) { return x + 1; })];
+  }
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    EXPECT_NEAR(static_cast<double>(pick_count[i]) / picks_per_weight, i + 1, 0.1 * (i + 1));
+  }
+}
+
+// Validate that peeked entries are returned by the following picks.
+TEST(AliasSchedulerTest, PeekThenPick) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<uint32_t> sched(random);
+  constexpr uint32_t num_entries = 8;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(i + 1, entries[i]);
+  }
+
+  const auto weight = [](const uint32_t& x) { return x + 1; };
+  std::vector<std::shared_ptr<uint32_t>> peeked;
+  for (uint32_t i = 0; i < 4; ++i) {
+    peeked.push_back(sched.peekAgain(weight));
+  }
+  for (uint32_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(peeked[i], sched.pickAndAdd(weight));
+  }
+}
+
+// Validate that expired entries are never picked.
+TEST(AliasSchedulerTest, Expired) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<uint32_t> sched(random);
+
+  auto second_entry = std::make_shared<uint32_t>(42);
+  {
+    auto first_entry = std::make_shared<uint32_t>(37);
+    sched.add(2, first_entry);
+    sched.add(1, second_entry);
+    EXPECT_NE(nullptr, sched.pickAndAdd({}));
+  }
+
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(42, *sched.pickAndAdd({}));
+  }
+}
+
+// Validate that a changed weight takes effect on the following picks.
+TEST(AliasSchedulerTest, WeightChange) {
+  Random::MockRandomGenerator random;
+  AliasScheduler<uint32_t> sched(random);
+  auto first = std::make_shared<uint32_t>(0);
+  auto second = std::make_shared<uint32_t>(1);
+  sched.add(1, first);
+  sched.add(1, second);
+
+  // The first entry's weight drops to zero when it is picked, so its bucket picks the second
+  // entry from then on.
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, true)));
+  EXPECT_EQ(first, sched.pickAndAdd([](const uint32_t& x) { return x == 0 ? 0 : 1; }));
+  EXPECT_CALL(random, random()).WillOnce(Return(randomForBucket(0, 2, true)));
+  EXPECT_EQ(second, sched.pickAndAdd([](const uint32_t& x) { return x == 0 ? 0 : 1; }));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -8,6 +8,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/config/decoded_resource_impl.h"
 #include "source/common/config/utility.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/upstream/cds_api_impl.h"
@@ -233,6 +234,54 @@ TEST_F(CdsApiImplTest, DeltaConfigUpdate) {
   }
 }
 
+// Validate that a cluster unchanged on the wire since it was last applied is skipped.
+TEST_F(CdsApiImplTest, SkipUnchangedCluster) {
+  {
+    InSequence s;
+    setup();
+  }
+  EXPECT_CALL(initialized_, ready());
+
+  auto update = [this](uint64_t content_hash, const std::string& version,
+                       const Protobuf::RepeatedPtrField<std::string>& removed = {}) {
+    envoy::config::cluster::v3::Cluster cluster;
+    cluster.set_name("cluster_1");
+    Protobuf::Any resource;
+    resource.PackFrom(cluster);
+    TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::cluster::v3::Cluster> decoder(
+        "name");
+    Config::DecodedResourcesWrapper decoded_resources;
+    decoded_resources.pushBack((*Config::DecodedResourceImpl::fromResource(decoder, resource, ""))
+                                   ->withVersion(version, content_hash));
+    EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, removed, version).ok());
+  };
+
+  expectAdd("cluster_1", "v1");
+  update(1, "v1");
+
+  EXPECT_CALL(cm_, hasCluster("cluster_1")).WillOnce(Return(true));
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _)).Times(0);
+  update(1, "v2");
+  testing::Mock::VerifyAndClearExpectations(&cm_);
+
+  // A changed cluster, or one which is no longer in the cluster manager, is applied.
+  expectAdd("cluster_1", "v3");
+  update(2, "v3");
+  EXPECT_CALL(cm_, hasCluster("cluster_1")).WillOnce(Return(false));
+  expectAdd("cluster_1", "v4");
+  update(2, "v4");
+
+  // So is a cluster which was removed since.
+  Protobuf::RepeatedPtrField<std::string> removed;
+  *removed.Add() = "cluster_1";
+  expectAdd("cluster_1", "v5");
+  EXPECT_CALL(cm_, removeCluster(StrEq("cluster_1"), false)).WillOnce(Return(true));
+  update(3, "v5", removed);
+  EXPECT_CALL(cm_, hasCluster(_)).Times(0);
+  expectAdd("cluster_1", "v6");
+  update(3, "v6");
+}
+
 TEST_F(CdsApiImplTest, ConfigUpdateAddsSecondClusterEvenIfFirstThrows) {
   {
     InSequence s;
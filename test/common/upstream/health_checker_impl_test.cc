@@ -1,3 +1,4 @@
+#include <array>
 #include <chrono>
 #include <memory>
 #include <ostream>
@@ -899,6 +900,53 @@ TEST_F(HttpHealthCheckerImplTest, Success) {
             cluster_->prioritySet().getMockHostSet(0)->hosts_[0]->coarseHealth());
 }
 
+// Verify that a cluster with the same health check and endpoint as another cluster applies the
+// results of the other cluster's probes instead of probing the endpoint itself.
+TEST_F(HttpHealthCheckerImplTest, SharedProbesAcrossClusters) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.health_check_shared_probes", "true"}});
+  const std::string yaml = R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    http_health_check:
+      path: /healthcheck
+    )EOF";
+  allocHealthChecker(yaml);
+  addCompletionCallback();
+  EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Changed));
+
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80")};
+  expectSessionCreate();
+  expectStreamCreate(0);
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  std::shared_ptr<MockClusterMockPrioritySet> other_cluster =
+      std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  other_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(other_cluster->info_, "tcp://127.0.0.1:80")};
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  new NiceMock<Event::MockTimer>(&dispatcher_);
+  auto other_health_checker = std::make_shared<TestHttpHealthCheckerImpl>(
+      *other_cluster, parseHealthCheckFromV3Yaml(yaml), context_, nullptr);
+  EXPECT_CALL(*other_health_checker, createCodecClient_(_)).Times(0);
+  other_health_checker->start();
+
+  EXPECT_CALL(*test_sessions_[0]->interval_timer_, enableTimer(_, _));
+  EXPECT_CALL(*test_sessions_[0]->timeout_timer_, disableTimer());
+  respond(0, "503", false);
+  for (const auto& cluster : {cluster_, other_cluster}) {
+    EXPECT_TRUE(cluster->prioritySet().getMockHostSet(0)->hosts_[0]->healthFlagGet(
+        Host::HealthFlag::FAILED_ACTIVE_HC));
+    EXPECT_EQ(1UL, cluster->info_->stats_store_.counter("health_check.failure").value());
+  }
+  EXPECT_EQ(1UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+  EXPECT_EQ(0UL, other_cluster->info_->stats_store_.counter("health_check.attempt").value());
+}
+
 TEST_F(HttpHealthCheckerImplTest, Degraded) {
   setupNoServiceValidationHC();
   EXPECT_CALL(*this, onHostStatus(_, HealthTransition::Changed)).Times(2);
@@ -4364,6 +4412,56 @@ TEST_F(TcpHealthCheckerImplTest, Success) {
   read_filter_->onData(response, false);
 }
 
+// Tests that the intervals of all sessions are run from a single timer when the shared interval
+// timer is enabled.
+TEST_F(TcpHealthCheckerImplTest, SharedIntervalTimer) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.health_check_shared_interval_timer", "true"}});
+  InSequence s;
+
+  Event::MockTimer* scheduler_timer = new Event::MockTimer(&dispatcher_);
+  setupData();
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80"),
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:81")};
+
+  // Sessions only create a timeout timer.
+  std::array<Event::MockTimer*, 2> timeout_timers;
+  std::array<NiceMock<Network::MockClientConnection>*, 2> connections;
+  std::array<Network::ReadFilterSharedPtr, 2> read_filters;
+  for (size_t i = 0; i < 2; ++i) {
+    timeout_timers[i] = new Event::MockTimer(&dispatcher_);
+    connections[i] = new NiceMock<Network::MockClientConnection>();
+    EXPECT_CALL(dispatcher_, createClientConnection_(_, _, _, _)).WillOnce(Return(connections[i]));
+    EXPECT_CALL(*connections[i], addReadFilter(_)).WillOnce(SaveArg<0>(&read_filters[i]));
+    EXPECT_CALL(*connections[i], write(_, _));
+    EXPECT_CALL(*timeout_timers[i], enableTimer(_, _));
+  }
+  health_checker_->start();
+
+  // Both intervals end in the same bucket, which arms the shared timer once.
+  EXPECT_CALL(*timeout_timers[0], disableTimer());
+  EXPECT_CALL(*scheduler_timer, enableTimer(_, _));
+  EXPECT_CALL(*timeout_timers[1], disableTimer());
+  for (size_t i = 0; i < 2; ++i) {
+    connections[i]->raiseEvent(Network::ConnectionEvent::Connected);
+    Buffer::OwnedImpl response;
+    addUint8(response, 2);
+    read_filters[i]->onData(response, false);
+  }
+
+  // The next check of both hosts runs from the shared timer on the existing connections.
+  EXPECT_CALL(*connections[0], write(_, _));
+  EXPECT_CALL(*timeout_timers[0], enableTimer(_, _));
+  EXPECT_CALL(*connections[1], write(_, _));
+  EXPECT_CALL(*timeout_timers[1], enableTimer(_, _));
+  simTime().advanceTimeWait(std::chrono::seconds(60));
+  scheduler_timer->invokeCallback();
+  EXPECT_EQ(2UL, cluster_->info_->stats_store_.counter("health_check.success").value());
+  EXPECT_EQ(4UL, cluster_->info_->stats_store_.counter("health_check.attempt").value());
+}
+
 // Tests that a successful healthcheck will disconnect the client when reuse_connection is false.
 TEST_F(TcpHealthCheckerImplTest, DataWithoutReusingConnection) {
   InSequence s;
@@ -146,6 +146,34 @@ TEST(HostUtilityTest, CreateOverrideHostStatus) {
   }
 }
 
+TEST(HostUtilityTest, IsWorkerHost) {
+  auto cluster = std::make_shared<NiceMock<MockClusterInfo>>();
+  constexpr uint32_t concurrency = 8;
+  constexpr uint32_t workers_per_host = 3;
+  std::vector<uint32_t> hosts_per_worker(concurrency);
+  for (uint32_t port = 1; port <= 100; ++port) {
+    HostSharedPtr host = makeTestHost(cluster, absl::StrCat("tcp://127.0.0.1:", port));
+    uint32_t workers = 0;
+    for (uint32_t worker = 0; worker < concurrency; ++worker) {
+      if (HostUtility::isWorkerHost(*host, worker, concurrency, workers_per_host)) {
+        ++workers;
+        ++hosts_per_worker[worker];
+      }
+    }
+    EXPECT_EQ(workers_per_host, workers);
+  }
+  // Every worker serves some hosts.
+  for (uint32_t hosts : hosts_per_worker) {
+    EXPECT_GT(hosts, 0);
+  }
+
+  // All workers serve all hosts if there are as many workers per host as workers.
+  HostSharedPtr host = makeTestHost(cluster, "tcp://127.0.0.1:80");
+  for (uint32_t worker = 0; worker < concurrency; ++worker) {
+    EXPECT_TRUE(HostUtility::isWorkerHost(*host, worker, concurrency, concurrency));
+  }
+}
+
 TEST(HostUtilityTest, SelectOverrideHostTest) {
   constexpr auto expect_helper = [](std::pair<HostConstSharedPtr, bool> expected_result,
                                     HostConstSharedPtr host, bool strict_mode) {
@@ -23,6 +23,8 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/host_set.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "absl/types/optional.h"
@@ -2760,6 +2762,40 @@ TEST(OutlierUtility, SRThreshold) {
   EXPECT_EQ(52.0, success_rate_nums.ejection_threshold_);   //  ejection threshold
 }
 
+// Verify that sharded success rate counts of all threads are merged at each bucket swap, and only
+// count towards the interval they were made in.
+TEST(SuccessRateMonitorTest, Sharded) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.outlier_detection_sharded_success_rate", "true"}});
+  SuccessRateMonitor monitor(envoy::data::cluster::v3::SUCCESS_RATE);
+
+  auto count = [&monitor](uint32_t requests, uint32_t successes) {
+    for (uint32_t i = 0; i < requests; ++i) {
+      monitor.incTotalReqCounter();
+      if (i < successes) {
+        monitor.incSuccessReqCounter();
+      }
+    }
+  };
+  count(10, 10);
+  Thread::ThreadPtr worker =
+      Thread::threadFactoryForTest().createThread([&count]() { count(10, 5); });
+  worker->join();
+
+  monitor.updateCurrentSuccessRateBucket();
+  EXPECT_EQ(std::make_pair(75.0, uint64_t(20)),
+            monitor.successRateAccumulator().getSuccessRateAndVolume().value());
+
+  count(4, 1);
+  monitor.updateCurrentSuccessRateBucket();
+  EXPECT_EQ(std::make_pair(25.0, uint64_t(4)),
+            monitor.successRateAccumulator().getSuccessRateAndVolume().value());
+
+  monitor.updateCurrentSuccessRateBucket();
+  EXPECT_FALSE(monitor.successRateAccumulator().getSuccessRateAndVolume().has_value());
+}
+
 } // namespace
 } // namespace Outlier
 } // namespace Upstream
@@ -0,0 +1,83 @@
+#include <chrono>
+
+#include "source/common/upstream/request_latency_tracker_impl.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+using std::chrono::milliseconds;
+
+TEST(RequestLatencyTrackerImplTest, Buckets) {
+  EXPECT_EQ(0, RequestLatencyTrackerImpl::bucketIndex(milliseconds(0)));
+  EXPECT_EQ(0, RequestLatencyTrackerImpl::bucketIndex(milliseconds(1)));
+  EXPECT_EQ(4, RequestLatencyTrackerImpl::bucketIndex(milliseconds(2)));
+  EXPECT_EQ(40, RequestLatencyTrackerImpl::bucketIndex(milliseconds(1024)));
+  EXPECT_EQ(41, RequestLatencyTrackerImpl::bucketIndex(milliseconds(1025)));
+  EXPECT_EQ(RequestLatencyTrackerImpl::NumBuckets - 1,
+            RequestLatencyTrackerImpl::bucketIndex(std::chrono::hours(1)));
+
+  // The upper bounds hold all the latencies of their bucket.
+  for (uint64_t latency = 1; latency < 50000; ++latency) {
+    const size_t index = RequestLatencyTrackerImpl::bucketIndex(milliseconds(latency));
+    EXPECT_LE(latency, RequestLatencyTrackerImpl::bucketUpperBound(index).count());
+    if (index > 0) {
+      EXPECT_GT(latency, RequestLatencyTrackerImpl::bucketUpperBound(index - 1).count());
+    }
+  }
+}
+
+TEST(RequestLatencyTrackerImplTest, Percentiles) {
+  RequestLatencyTrackerImpl tracker;
+  for (uint64_t latency = 1; latency < RequestLatencyTrackerImpl::MinLatencies; ++latency) {
+    tracker.recordLatency(milliseconds(latency));
+  }
+  // Not enough latencies yet.
+  EXPECT_FALSE(tracker.latencyPercentile(95).has_value());
+
+  tracker.recordLatency(milliseconds(100));
+  // The percentiles are upper bounds, at most 19% above the exact ones.
+  EXPECT_EQ(milliseconds(1), tracker.latencyPercentile(0));
+  EXPECT_EQ(milliseconds(53), tracker.latencyPercentile(50));
+  EXPECT_EQ(milliseconds(107), tracker.latencyPercentile(95));
+  EXPECT_EQ(milliseconds(107), tracker.latencyPercentile(100));
+}
+
+// The older latencies weigh less and less, so the percentiles follow the recent ones.
+TEST(RequestLatencyTrackerImplTest, Decay) {
+  RequestLatencyTrackerImpl tracker;
+  for (uint64_t i = 0; i < RequestLatencyTrackerImpl::DecayInterval; ++i) {
+    tracker.recordLatency(milliseconds(10));
+  }
+  EXPECT_EQ(milliseconds(11), tracker.latencyPercentile(95));
+
+  for (uint64_t i = 0; i < 4 * RequestLatencyTrackerImpl::DecayInterval; ++i) {
+    tracker.recordLatency(milliseconds(100));
+  }
+  EXPECT_EQ(milliseconds(107), tracker.latencyPercentile(5));
+}
+
+TEST(RequestLatencyTrackerImplTest, HedgeBudget) {
+  RequestLatencyTrackerImpl tracker;
+  EXPECT_FALSE(tracker.tryHedge(0.1));
+  for (int i = 0; i < 20; ++i) {
+    tracker.onRequest();
+  }
+  EXPECT_TRUE(tracker.tryHedge(0.1));
+  EXPECT_TRUE(tracker.tryHedge(0.1));
+  EXPECT_FALSE(tracker.tryHedge(0.1));
+  EXPECT_FALSE(tracker.tryHedge(0));
+
+  // The budget grows with the requests.
+  for (int i = 0; i < 10; ++i) {
+    tracker.onRequest();
+  }
+  EXPECT_TRUE(tracker.tryHedge(0.1));
+  EXPECT_FALSE(tracker.tryHedge(0.1));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
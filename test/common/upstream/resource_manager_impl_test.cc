@@ -5,6 +5,7 @@
 
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -166,6 +167,58 @@ TEST(ResourceManagerImplTest, RetryBudgetOverrideGauge) {
   EXPECT_EQ(100u, rm.maxConnectionsPerHost());
   rm.retries().dec();
 }
+
+TEST(ResourceManagerImplTest, ShardedAccounting) {
+  NiceMock<Runtime::MockLoader> runtime;
+  Stats::IsolatedStoreImpl store;
+
+  auto stats = clusterCircuitBreakersStats(store);
+  // A maximum of 2560 requests gives batches of 10.
+  ResourceManagerImpl rm(runtime, "circuit_breakers.runtime_resource_manager_test.default.", 4,
+                         2560, 2560, 0, 3, 100, stats, absl::nullopt, absl::nullopt, true);
+  ASSERT_TRUE(rm.requests().canCreate());
+
+  // Changes below the batch are only visible to the thread that made them.
+  auto other_thread_count = [&rm]() {
+    uint64_t count = 0;
+    Thread::ThreadPtr thread =
+        Thread::threadFactoryForTest().createThread([&]() { count = rm.requests().count(); });
+    thread->join();
+    return count;
+  };
+  for (int i = 0; i < 9; ++i) {
+    rm.requests().inc();
+  }
+  EXPECT_EQ(9U, rm.requests().count());
+  EXPECT_EQ(0U, other_thread_count());
+  EXPECT_EQ(2560U, stats.remaining_rq_.value());
+
+  // The batch is added to the shared count and the gauges.
+  rm.requests().inc();
+  EXPECT_EQ(10U, rm.requests().count());
+  EXPECT_EQ(10U, other_thread_count());
+  EXPECT_EQ(2550U, stats.remaining_rq_.value());
+
+  // Releases by another thread are batched as well, the count never goes below zero.
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([&rm]() {
+    rm.requests().decBy(10);
+    EXPECT_EQ(0U, rm.requests().count());
+  });
+  thread->join();
+  EXPECT_EQ(0U, rm.requests().count());
+  EXPECT_EQ(2560U, stats.remaining_rq_.value());
+
+  // Small limits are exact.
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(rm.connections().canCreate());
+    rm.connections().inc();
+  }
+  EXPECT_FALSE(rm.connections().canCreate());
+  EXPECT_EQ(1U, stats.cx_open_.value());
+  EXPECT_EQ(4U, rm.connections().count());
+  rm.connections().decBy(4);
+  EXPECT_EQ(0U, stats.cx_open_.value());
+}
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -4,6 +4,7 @@
 #include <random>
 
 #include "source/common/common/random_generator.h"
+#include "source/common/upstream/alias_scheduler.h"
 #include "source/common/upstream/edf_scheduler.h"
 #include "source/common/upstream/wrsq_scheduler.h"
 
@@ -159,6 +160,46 @@ void uniqueWeightPickWRSQ(::benchmark::State& state) {
                             });
 }
 
+void splitWeightAddAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupSplitWeights(alias, num_objs, state);
+  }
+}
+
+void uniqueWeightAddAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    SchedulerTester::setupUniqueWeights(alias, num_objs, state);
+  }
+}
+
+void splitWeightPickAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupSplitWeights(sched, num_objs, state);
+                            });
+}
+
+void uniqueWeightPickAlias(::benchmark::State& state) {
+  Random::RandomGeneratorImpl random;
+  AliasScheduler<SchedulerTester::ObjInfo> alias(random);
+  const size_t num_objs = state.range(0);
+
+  SchedulerTester::pickTest(alias, state,
+                            [num_objs, &state](Scheduler<SchedulerTester::ObjInfo>& sched) {
+                              return SchedulerTester::setupUniqueWeights(sched, num_objs, state);
+                            });
+}
+
 BENCHMARK(splitWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -167,8 +208,13 @@ BENCHMARK(splitWeightAddWRSQ)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
     ->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightAddAlias)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
 BENCHMARK(splitWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(splitWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(splitWeightPickAlias)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightAddEdf)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
@@ -177,8 +223,13 @@ BENCHMARK(uniqueWeightAddWRSQ)
     ->Unit(::benchmark::kMicrosecond)
     ->RangeMultiplier(8)
     ->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightAddAlias)
+    ->Unit(::benchmark::kMicrosecond)
+    ->RangeMultiplier(8)
+    ->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickEdf)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 BENCHMARK(uniqueWeightPickWRSQ)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
+BENCHMARK(uniqueWeightPickAlias)->RangeMultiplier(8)->Range(1 << 6, 1 << 14);
 
 } // namespace
 } // namespace Upstream
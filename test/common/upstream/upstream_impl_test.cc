@@ -2345,6 +2345,51 @@ TEST_F(StaticClusterImplTest, InitialHosts) {
   EXPECT_FALSE(cluster->info()->addedViaApi());
 }
 
+// Clusters targeting the same endpoints share their addresses, but not their hosts.
+TEST_F(StaticClusterImplTest, SharedEndpointAddresses) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.share_endpoint_addresses", "true"}});
+  const std::string yaml = R"EOF(
+    name: staticcluster
+    connect_timeout: 0.25s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    load_assignment:
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 443
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.2
+                    port_value: 443
+  )EOF";
+
+  envoy::config::cluster::v3::Cluster cluster_config = parseClusterFromV3Yaml(yaml);
+  Envoy::Upstream::ClusterFactoryContextImpl factory_context(server_context_, nullptr, nullptr,
+                                                             false);
+  std::shared_ptr<StaticClusterImpl> cluster1 = createCluster(cluster_config, factory_context);
+  cluster_config.set_name("staticcluster2");
+  std::shared_ptr<StaticClusterImpl> cluster2 = createCluster(cluster_config, factory_context);
+  cluster1->initialize([] { return absl::OkStatus(); });
+  cluster2->initialize([] { return absl::OkStatus(); });
+
+  const auto& hosts1 = cluster1->prioritySet().hostSetsPerPriority()[0]->hosts();
+  const auto& hosts2 = cluster2->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(2UL, hosts1.size());
+  ASSERT_EQ(2UL, hosts2.size());
+  for (size_t i = 0; i < hosts1.size(); ++i) {
+    EXPECT_NE(hosts1[i], hosts2[i]);
+    EXPECT_EQ(hosts1[i]->address().get(), hosts2[i]->address().get());
+  }
+  EXPECT_NE(hosts1[0]->address().get(), hosts1[1]->address().get());
+  EXPECT_EQ(2UL, AddressPool::get(server_context_.singletonManager())->size());
+}
+
 TEST_F(StaticClusterImplTest, LoadAssignmentEmptyHostname) {
   const std::string yaml = R"EOF(
     name: staticcluster
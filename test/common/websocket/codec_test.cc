@@ -481,6 +481,67 @@ TEST(WebSocketCodecTest, DecodeFrameSpansOverTwoSlices) {
                                                  makeBuffer("\x1f\xfa\x4f\x5a\x12\xe2")}));
 } // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
 
+TEST(WebSocketCodecTest, DecodeMaskedFrameSpansOverTwoSlicesUnmasked) {
+  Buffer::OwnedImpl buffer;
+  Buffer::addSeq(buffer, {0x81, 0x85, 0x37, 0xfa, 0x21, 0x3d, 0x7f, 0x9f, 0x4d});
+  Buffer::addSeq(buffer, {0x51, 0x58});
+
+  Decoder decoder(kDefaultPayloadBufferLength, true);
+  absl::optional<std::vector<Frame>> frames = decoder.decode(buffer);
+
+  ASSERT_TRUE(frames.has_value());
+  EXPECT_EQ(1, frames->size());
+  EXPECT_TRUE(areFramesEqual(frames.value()[0],
+                             {true, kFrameOpcodeText, 0x37fa213d, 5, makeBuffer("Hello")}));
+} // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+
+TEST(WebSocketCodecTest, DecodeUnmaskedFrameWithUnmaskPayload) {
+  Buffer::OwnedImpl buffer;
+  Buffer::addSeq(buffer, {0x81, 0x05, 0x48, 0x65, 0x6c, 0x6c, 0x6f});
+
+  Decoder decoder(kDefaultPayloadBufferLength, true);
+  absl::optional<std::vector<Frame>> frames = decoder.decode(buffer);
+  EXPECT_TRUE(areFramesEqual(frames.value()[0],
+                             {true, kFrameOpcodeText, absl::nullopt, 5, makeBuffer("Hello")}));
+} // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+
+// The unmasked payload of a frame truncated to the max payload buffer length.
+TEST(WebSocketCodecTest, DecodeMaskedFrameUnmaskedWhenMaxPayloadBufferLengthSet) {
+  Buffer::OwnedImpl buffer;
+  Buffer::addSeq(buffer, {0x81, 0x85, 0x37, 0xfa, 0x21, 0x3d, 0x7f, 0x9f, 0x4d});
+  Buffer::addSeq(buffer, {0x51, 0x58});
+
+  Decoder decoder(4, true);
+  absl::optional<std::vector<Frame>> frames = decoder.decode(buffer);
+
+  ASSERT_TRUE(frames.has_value());
+  EXPECT_EQ(1, frames->size());
+  EXPECT_TRUE(areFramesEqual(frames.value()[0],
+                             {true, kFrameOpcodeText, 0x37fa213d, 5, makeBuffer("Hell")}));
+} // NOLINT(clang-analyzer-cplusplus.NewDeleteLeaks)
+
+TEST(WebSocketCodecTest, UnmaskPayload) {
+  const uint32_t masking_key = 0x37fa213d;
+  const std::array<uint8_t, kMaskingKeyLength> key_bytes = {0x37, 0xfa, 0x21, 0x3d};
+  std::vector<uint8_t> input(37);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<uint8_t>(i * 7);
+  }
+  for (uint64_t offset = 0; offset < 8; ++offset) {
+    for (size_t length = 0; length <= input.size(); ++length) {
+      std::vector<uint8_t> output(length);
+      unmaskPayload(masking_key, offset, input.data(), output.data(), length);
+      for (size_t i = 0; i < length; ++i) {
+        EXPECT_EQ(input[i] ^ key_bytes[(offset + i) % kMaskingKeyLength], output[i]);
+      }
+      // In place.
+      std::vector<uint8_t> in_place(input.begin(), input.begin() + length);
+      unmaskPayload(masking_key, offset, in_place.data(), in_place.data(), length);
+      EXPECT_EQ(output, in_place);
+    }
+  }
+}
+
 // A complete frame and an incomplete frame present
 TEST(WebSocketCodecTest, DecodeFrameCompleteAndIncompleteFrame) {
   Buffer::OwnedImpl buffer;
@@ -225,6 +225,47 @@ TEST_F(FileAccessLogTest, LogFormatJsonWithCustomCommands) {
   }
 }
 
+TEST_F(FileAccessLogTest, LoggersWithTheSameFormatShareTheLine) {
+  auto create_logger = [this](const std::string& path, const std::string& format,
+                              std::shared_ptr<AccessLog::MockAccessLogFile> file) {
+    envoy::extensions::access_loggers::file::v3::FileAccessLog fal_config;
+    fal_config.set_path(path);
+    fal_config.mutable_log_format()->mutable_text_format_source()->set_inline_string(format);
+    envoy::config::accesslog::v3::AccessLog config;
+    config.mutable_typed_config()->PackFrom(fal_config);
+    EXPECT_CALL(context_.server_factory_context_.access_log_manager_,
+                createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File,
+                                                            path}))
+        .WillOnce(Return(file));
+    return AccessLog::AccessLogFactory::fromProto(config, context_);
+  };
+  auto foo_file = std::make_shared<AccessLog::MockAccessLogFile>();
+  auto bar_file = std::make_shared<AccessLog::MockAccessLogFile>();
+  auto baz_file = std::make_shared<AccessLog::MockAccessLogFile>();
+  AccessLog::InstanceSharedPtr foo_logger = create_logger("/foo", "%REQ(:path)%", foo_file);
+  AccessLog::InstanceSharedPtr bar_logger = create_logger("/bar", "%REQ(:path)%", bar_file);
+  AccessLog::InstanceSharedPtr baz_logger = create_logger("/baz", "path=%REQ(:path)%", baz_file);
+
+  Formatter::FormattedLines formatted_lines;
+  Formatter::Context log_context{&request_headers_, &response_headers_, &response_trailers_};
+  log_context.setFormattedLines(formatted_lines);
+
+  EXPECT_CALL(*foo_file, write(absl::string_view("/bar/foo")));
+  foo_logger->log(log_context, stream_info_);
+  // The line formatted by the first logger is written by the logger using the same format, but
+  // not by the other one.
+  request_headers_.setPath("/baz");
+  EXPECT_CALL(*bar_file, write(absl::string_view("/bar/foo")));
+  bar_logger->log(log_context, stream_info_);
+  EXPECT_CALL(*baz_file, write(absl::string_view("path=/baz")));
+  baz_logger->log(log_context, stream_info_);
+  EXPECT_EQ(2, formatted_lines.size());
+
+  // Without shared lines, each logger formats its line.
+  EXPECT_CALL(*bar_file, write(absl::string_view("/baz")));
+  bar_logger->log({&request_headers_, &response_headers_, &response_trailers_}, stream_info_);
+}
+
 } // namespace
 } // namespace File
 } // namespace AccessLoggers
@@ -39,6 +39,9 @@ TEST(OtlpLogUtilsTest, PackUnpackBody) {
 
   auto unpacked = unpackBody(packed);
   EXPECT_EQ("test body content", unpacked.string_value());
+
+  auto moved = unpackBody(std::move(packed));
+  EXPECT_EQ("test body content", moved.string_value());
 }
 
 TEST(OtlpLogUtilsTest, GetOtlpUserAgentHeader) {
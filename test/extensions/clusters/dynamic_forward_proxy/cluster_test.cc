@@ -274,6 +274,60 @@ TEST_F(ClusterTest, BasicFlow) {
   EXPECT_EQ(nullptr, lb_->chooseHost(setHostAndReturnContext("host1:0")).host);
 }
 
+// The hosts added and removed in the same main thread event loop iteration are propagated with a
+// single priority set update.
+TEST_F(ClusterTest, BatchedHostUpdates) {
+  initialize(default_yaml_config_, false);
+  makeTestHost("host1:0", "1.2.3.4");
+  makeTestHost("host2:0", "1.2.3.5");
+  makeTestHost("host3:0", "1.2.3.6");
+
+  Event::PostCb flush;
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&](Event::PostCb cb) {
+    flush = std::move(cb);
+  });
+  EXPECT_CALL(*this, onMemberUpdateCb(_, _)).Times(0);
+  EXPECT_TRUE(update_callbacks_->onDnsHostAddOrUpdate("host1:0", host_map_["host1:0"]).ok());
+  EXPECT_TRUE(update_callbacks_->onDnsHostAddOrUpdate("host2:0", host_map_["host2:0"]).ok());
+  EXPECT_TRUE(update_callbacks_->onDnsHostAddOrUpdate("host3:0", host_map_["host3:0"]).ok());
+  update_callbacks_->onDnsHostRemove("host3:0");
+  EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+
+  // The hosts can be selected before the update.
+  EXPECT_CALL(*host_map_["host1:0"], touch());
+  EXPECT_EQ("1.2.3.4:0",
+            lb_->chooseHost(setHostAndReturnContext("host1:0")).host->address()->asString());
+
+  testing::Mock::VerifyAndClearExpectations(this);
+  EXPECT_CALL(*this, onMemberUpdateCb(SizeIs(2), SizeIs(0)));
+  flush();
+  EXPECT_EQ(2UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+
+  // The removals are batched as well.
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).WillOnce([&](Event::PostCb cb) {
+    flush = std::move(cb);
+  });
+  update_callbacks_->onDnsHostRemove("host1:0");
+  update_callbacks_->onDnsHostRemove("host2:0");
+  EXPECT_CALL(*this, onMemberUpdateCb(SizeIs(0), SizeIs(2)));
+  flush();
+  EXPECT_EQ(0UL, cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size());
+}
+
+TEST_F(ClusterTest, UnbatchedHostUpdates) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.dfp_cluster_batch_host_updates", "false"}});
+  initialize(default_yaml_config_, false);
+  makeTestHost("host1:0", "1.2.3.4");
+
+  EXPECT_CALL(server_context_.dispatcher_, post(_)).Times(0);
+  EXPECT_CALL(*this, onMemberUpdateCb(SizeIs(1), SizeIs(0)));
+  EXPECT_TRUE(update_callbacks_->onDnsHostAddOrUpdate("host1:0", host_map_["host1:0"]).ok());
+  EXPECT_CALL(*this, onMemberUpdateCb(SizeIs(0), SizeIs(1)));
+  update_callbacks_->onDnsHostRemove("host1:0");
+}
+
 // Outlier detection
 TEST_F(ClusterTest, OutlierDetection) {
   initialize(default_yaml_config_, false);
@@ -43,7 +43,7 @@ namespace Upstream {
 
 class EdsSpeedTest {
 public:
-  EdsSpeedTest(State& state, bool use_unified_mux)
+  EdsSpeedTest(State& state, bool use_unified_mux, bool coalesce_updates = false)
       : state_(state), use_unified_mux_(use_unified_mux),
         type_url_("type.googleapis.com/envoy.config.endpoint.v3.ClusterLoadAssignment"),
         subscription_stats_(Config::Utility::generateStats(scope_)),
@@ -74,18 +74,27 @@ public:
     } else {
       grpc_mux_ = std::make_shared<Config::GrpcMuxImpl>(grpc_mux_context);
     }
-    resetCluster(R"EOF(
+    // Keep the last timer created, which right after creating the cluster is its coalescing timer.
+    ON_CALL(server_context_.dispatcher_, createTimer_(_))
+        .WillByDefault(testing::Invoke([this](Event::TimerCb cb) {
+          last_timer_ = new NiceMock<Event::MockTimer>();
+          last_timer_->callback_ = cb;
+          return last_timer_;
+        }));
+    resetCluster(fmt::format(R"EOF(
       name: name
       connect_timeout: 0.25s
       type: EDS
       eds_cluster_config:
         service_name: fare
+        {}
         eds_config:
           api_config_source:
             cluster_names:
             - eds
             refresh_delay: 1s
     )EOF",
+                             coalesce_updates ? "update_coalescing_window: 1s" : ""),
                  Envoy::Upstream::Cluster::InitializePhase::Secondary);
 
     EXPECT_CALL(*server_context_.cluster_manager_.subscription_factory_.subscription_, start(_));
@@ -105,6 +114,9 @@ public:
                                                                false);
 
     cluster_ = *EdsClusterImpl::create(eds_cluster_, factory_context);
+    if (eds_cluster_.eds_cluster_config().has_update_coalescing_window()) {
+      coalescing_timer_ = last_timer_;
+    }
     EXPECT_EQ(initialize_phase, cluster_->initializePhase());
     eds_callbacks_ = server_context_.cluster_manager_.subscription_factory_.callbacks_;
     subscription_ = std::make_unique<Config::GrpcSubscriptionImpl>(
@@ -116,7 +128,7 @@ public:
   // Set up an EDS config with multiple priorities, localities, weights and make sure
   // they are loaded as expected.
   void priorityAndLocalityWeightedHelper(bool ignore_unknown_dynamic_fields, size_t num_hosts,
-                                         bool healthy) {
+                                         bool healthy, bool expect_applied = true) {
     state_.PauseTiming();
 
     envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
@@ -163,8 +175,16 @@ public:
           .grpcStreamForTest()
           .onReceiveMessage(std::move(response));
     }
-    ASSERT(cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
-           num_hosts);
+    ASSERT(!expect_applied ||
+           cluster_->prioritySet().hostSetsPerPriority()[1]->hostsPerLocality().get()[0].size() ==
+               num_hosts);
+  }
+
+  // Ends the coalescing window, applying the last update received during it.
+  void endCoalescingWindow() {
+    if (coalescing_timer_ != nullptr && coalescing_timer_->enabled_) {
+      coalescing_timer_->invokeCallback();
+    }
   }
 
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
@@ -192,6 +212,8 @@ public:
   Config::GrpcMuxSharedPtr grpc_mux_;
   Config::GrpcSubscriptionImplPtr subscription_;
   NiceMock<AccessLog::MockAccessLogManager> access_log_manager_;
+  Event::MockTimer* last_timer_{};
+  Event::MockTimer* coalescing_timer_{};
 };
 
 } // namespace Upstream
@@ -244,3 +266,25 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Applies a burst of updates that flip the health of all hosts, without and with a coalescing
+// window, which applies the first and the last update of the burst only.
+static void burstUpdate(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    const bool coalesce_updates = state.range(1);
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false, coalesce_updates);
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    const uint32_t burst_size = 20;
+    for (uint32_t i = 0; i < burst_size; ++i) {
+      speed_test.priorityAndLocalityWeightedHelper(true, endpoints, i % 2 == 0,
+                                                   !coalesce_updates || i == 0);
+    }
+    speed_test.endCoalescingWindow();
+  }
+}
+
+BENCHMARK(burstUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
@@ -2970,6 +2970,111 @@ TEST_F(EdsAssignmentTimeoutTest, AssignmentLeaseUpdateDisablesTimer) {
   doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
 }
 
+class EdsCoalescingTest : public EdsTest {
+public:
+  EdsCoalescingTest() {
+    EXPECT_CALL(server_context_.dispatcher_, createTimer_(_))
+        .WillOnce(Invoke([](Event::TimerCb) { return new Event::MockTimer(); }))
+        .WillOnce(Invoke([this](Event::TimerCb cb) {
+          EXPECT_EQ(nullptr, coalescing_timer_);
+          coalescing_timer_ = new Event::MockTimer();
+          coalescing_timer_->callback_ = cb;
+          return coalescing_timer_;
+        }))
+        .WillRepeatedly(Invoke([](Event::TimerCb) { return new Event::MockTimer(); }));
+
+    resetCluster(R"EOF(
+      name: name
+      connect_timeout: 0.25s
+      type: EDS
+      lb_policy: ROUND_ROBIN
+      eds_cluster_config:
+        service_name: fare
+        update_coalescing_window: 1s
+        eds_config:
+          api_config_source:
+            api_type: REST
+            cluster_names:
+            - eds
+            refresh_delay: 1s
+    )EOF",
+                 Cluster::InitializePhase::Secondary);
+  }
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment
+  clusterLoadAssignment(const std::vector<uint32_t>& ports) {
+    envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+    cluster_load_assignment.set_cluster_name("fare");
+    auto* endpoints = cluster_load_assignment.add_endpoints();
+    for (const uint32_t port : ports) {
+      auto* socket_address = endpoints->add_lb_endpoints()
+                                 ->mutable_endpoint()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+      socket_address->set_address("1.2.3.4");
+      socket_address->set_port_value(port);
+    }
+    return cluster_load_assignment;
+  }
+
+  size_t numHosts() { return cluster_->prioritySet().hostSetsPerPriority()[0]->hosts().size(); }
+
+  uint64_t coalescedUpdates() {
+    return stats_.findCounterByString("cluster.name.update_coalesced").value().get().value();
+  }
+
+  Event::MockTimer* coalescing_timer_{nullptr};
+};
+
+// Updates received within the coalescing window are held, and only the last one is applied when
+// the window ends.
+TEST_F(EdsCoalescingTest, CoalescesUpdatesWithinWindow) {
+  initialize();
+
+  // The first update is applied immediately and completes warming.
+  EXPECT_CALL(*coalescing_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  doOnConfigUpdateVerifyNoThrow(clusterLoadAssignment({80}));
+  EXPECT_TRUE(initialized_);
+  EXPECT_EQ(1, numHosts());
+
+  doOnConfigUpdateVerifyNoThrow(clusterLoadAssignment({80, 81}));
+  doOnConfigUpdateVerifyNoThrow(clusterLoadAssignment({82, 83, 84}));
+  EXPECT_EQ(1, numHosts());
+  EXPECT_EQ(1, coalescedUpdates());
+
+  // The latest update is applied when the window ends, which starts a new window.
+  EXPECT_CALL(*coalescing_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  coalescing_timer_->invokeCallback();
+  EXPECT_EQ(3, numHosts());
+
+  // A window without updates ends without applying anything, and the next update is applied
+  // immediately.
+  EXPECT_CALL(*coalescing_timer_, enableTimer(_, _)).Times(0);
+  coalescing_timer_->invokeCallback();
+  EXPECT_CALL(*coalescing_timer_, enableTimer(std::chrono::milliseconds(1000), _));
+  doOnConfigUpdateVerifyNoThrow(clusterLoadAssignment({85}));
+  EXPECT_EQ(1, numHosts());
+  EXPECT_EQ(1, coalescedUpdates());
+}
+
+// Invalid updates are rejected when they are received during the coalescing window.
+TEST_F(EdsCoalescingTest, RejectsInvalidUpdateWithinWindow) {
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(clusterLoadAssignment({80}));
+
+  auto cluster_load_assignment = clusterLoadAssignment({81});
+  cluster_load_assignment.mutable_policy()->add_drop_overloads();
+  cluster_load_assignment.mutable_policy()->add_drop_overloads();
+  const auto decoded_resources =
+      TestUtility::decodeResources({cluster_load_assignment}, "cluster_name");
+  EXPECT_EQ(eds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").message(),
+            "Cluster drop_overloads config has 2 categories. Envoy only support one.");
+  EXPECT_EQ(0, coalescedUpdates());
+
+  coalescing_timer_->invokeCallback();
+  EXPECT_EQ(1, numHosts());
+}
+
 // Validate that onConfigUpdate() with a config that contains both LEDS config
 // source and explicit list of endpoints is rejected.
 TEST_F(EdsTest, OnConfigUpdateLedsAndEndpoints) {
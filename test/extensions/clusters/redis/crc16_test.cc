@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/extensions/clusters/redis/crc16.h"
 
 #include "gtest/gtest.h"
@@ -13,6 +15,13 @@ TEST(Hash, crc16) {
   EXPECT_EQ(53222, Crc16::crc16("lyft"));
   EXPECT_EQ(0, Crc16::crc16(""));
 }
+
+TEST(Hash, crc16LongKeys) {
+  // The keys of 8 bytes or more are hashed 8 bytes at a time, then the remaining bytes one at a
+  // time.
+  EXPECT_EQ(0x31C3, Crc16::crc16("123456789"));
+  EXPECT_EQ(39151, Crc16::crc16(std::string(1000, 'a')));
+}
 } // namespace Redis
 } // namespace Clusters
 } // namespace Extensions
@@ -277,6 +277,51 @@ TEST_F(AsyncFileHandleTest, OpenExistingReadOnlyCanRead) {
   close(handle);
 }
 
+TEST_F(AsyncFileHandleTest, MapReadReferencesFileContentsUpToItsEnd) {
+  auto handle = createAnonymousFile();
+  absl::StatusOr<size_t> write_status;
+  Buffer::OwnedImpl buf("hello world");
+  ASSERT_OK(handle->write(dispatcher_.get(), buf, 0, [&](absl::StatusOr<size_t> status) {
+    write_status = std::move(status);
+  }));
+  resolveFileActions();
+  EXPECT_THAT(write_status, IsOkAndHolds(11U));
+  absl::StatusOr<Buffer::InstancePtr> read_status, past_end_status;
+  // An offset not multiple of the page size, and a length past the end of the file.
+  ASSERT_OK(handle->mapRead(dispatcher_.get(), 6, 100,
+                            [&](absl::StatusOr<Buffer::InstancePtr> status) {
+                              read_status = std::move(status);
+                            }));
+  resolveFileActions();
+  ASSERT_OK(read_status);
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("world"));
+  ASSERT_OK(handle->mapRead(dispatcher_.get(), 20, 5,
+                            [&](absl::StatusOr<Buffer::InstancePtr> status) {
+                              past_end_status = std::move(status);
+                            }));
+  resolveFileActions();
+  ASSERT_OK(past_end_status);
+  EXPECT_EQ(0, past_end_status.value()->length());
+  close(handle);
+  // The mapping outlives the file descriptor.
+  EXPECT_THAT(*read_status.value(), BufferStringEqual("world"));
+}
+
+TEST_F(AsyncFileHandleTest, OpenExistingWriteOnlyFailsOnMapRead) {
+  // tmpfile is initialized to contain "hello".
+  TestTmpFile tmpfile(tmpdir_);
+
+  auto handle = openExistingFile(tmpfile.name(), AsyncFileManager::Mode::WriteOnly);
+  absl::StatusOr<Buffer::InstancePtr> read_status;
+  EXPECT_OK(
+      handle->mapRead(dispatcher_.get(), 0, 5, [&](absl::StatusOr<Buffer::InstancePtr> status) {
+        read_status = std::move(status);
+      }));
+  resolveFileActions();
+  EXPECT_FALSE(read_status.ok());
+  close(handle);
+}
+
 TEST_F(AsyncFileHandleTest, OpenExistingReadWriteCanReadAndWrite) {
   // tmpfile is initialized to contain "hello".
   TestTmpFile tmpfile(tmpdir_);
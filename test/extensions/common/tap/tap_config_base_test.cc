@@ -5,8 +5,12 @@
 #include "envoy/data/tap/v3/wrapper.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/protobuf/protobuf.h"
 #include "source/extensions/common/tap/tap_config_base.h"
 
+#include "test/test_common/environment.h"
+#include "test/test_common/thread_factory_for_test.h"
+
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -192,6 +196,53 @@ TEST(TrimSlice, All) {
   }
 }
 
+// The traces of each tap, written to its file by the worker or by the writer thread.
+TEST(FilePerTapSink, WritesTraces) {
+  for (const bool writer_thread : {false, true}) {
+    envoy::config::tap::v3::FilePerTapSink config;
+    config.set_path_prefix(TestEnvironment::temporaryPath(
+        fmt::format("file_per_tap_sink_{}", writer_thread ? "writer_thread" : "worker")));
+    if (writer_thread) {
+      config.mutable_max_pending_traces()->set_value(16);
+    }
+
+    {
+      FilePerTapSink sink(config, Thread::threadFactoryForTest());
+      for (uint64_t trace_id : {1, 2}) {
+        PerTapSinkHandlePtr handle = sink.createPerTapSinkHandle(
+            trace_id, envoy::config::tap::v3::OutputSink::OutputSinkTypeCase::kFilePerTap);
+        for (const std::string& body : {"hello", "world"}) {
+          auto trace = std::make_unique<envoy::data::tap::v3::TraceWrapper>();
+          trace->mutable_http_streamed_trace_segment()->set_trace_id(trace_id);
+          trace->mutable_http_streamed_trace_segment()->mutable_request_body_chunk()->set_as_bytes(
+              body);
+          handle->submitTrace(std::move(trace),
+                              envoy::config::tap::v3::OutputSink::PROTO_BINARY_LENGTH_DELIMITED);
+        }
+      }
+      // The sink is destroyed with the traces possibly still pending on the writer thread.
+    }
+
+    for (uint64_t trace_id : {1, 2}) {
+      const std::string output = TestEnvironment::readFileToStringForTest(
+          fmt::format("{}_{}.pb_length_delimited", config.path_prefix(), trace_id));
+      Protobuf::io::CodedInputStream coded_stream(reinterpret_cast<const uint8_t*>(output.data()),
+                                                  output.size());
+      std::vector<std::string> bodies;
+      uint32_t message_size;
+      while (coded_stream.ReadVarint32(&message_size)) {
+        envoy::data::tap::v3::TraceWrapper trace;
+        const auto limit = coded_stream.PushLimit(message_size);
+        ASSERT_TRUE(trace.ParseFromCodedStream(&coded_stream));
+        coded_stream.PopLimit(limit);
+        EXPECT_EQ(trace_id, trace.http_streamed_trace_segment().trace_id());
+        bodies.push_back(trace.http_streamed_trace_segment().request_body_chunk().as_bytes());
+      }
+      EXPECT_EQ((std::vector<std::string>{"hello", "world"}), bodies);
+    }
+  }
+}
+
 } // namespace
 } // namespace Tap
 } // namespace Common
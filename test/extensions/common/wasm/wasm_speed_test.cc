@@ -63,6 +63,57 @@ void bmWasmSpeedTest(benchmark::State& state) {
 
 BENCHMARK(bmWasmSpeedTest);
 
+// Loads the code of a module in a base VM and clones it in per-worker VMs, which is what each
+// config load or hot restart pays. Clones of VMs which support it reuse the compiled module of the
+// base VM, while a base VM compiles the module unless it embeds precompiled code, see
+// allow_precompiled and test/tools/wee8_compile.
+void bmWasmLoad(benchmark::State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::Logger::Registry::getLog(Envoy::Logger::Id::wasm).set_level(spdlog::level::off);
+  const std::string runtime = "envoy.wasm.runtime.v8";
+  if (!Envoy::Extensions::Common::Wasm::isWasmEngineAvailable(runtime)) {
+    state.SkipWithError("Wasm runtime v8 is not available");
+    return;
+  }
+  const std::string path = Envoy::TestEnvironment::substitute(
+      "{{ test_rundir }}/test/extensions/common/wasm/test_data/test_cpp.wasm");
+  Envoy::Stats::IsolatedStoreImpl stats_store;
+  Envoy::Api::ApiPtr api = Envoy::Api::createApiForTest(stats_store);
+  if (!api->fileSystem().fileExists(path)) {
+    state.SkipWithError("Wasm test module is not available");
+    return;
+  }
+  const std::string code = Envoy::TestEnvironment::readFileToStringForTest(path);
+  Envoy::Upstream::MockClusterManager cluster_manager;
+  Envoy::Event::DispatcherPtr dispatcher(api->allocateDispatcher("wasm_test"));
+  auto scope = Envoy::Stats::ScopeSharedPtr(stats_store.createScope("wasm."));
+
+  envoy::extensions::wasm::v3::PluginConfig plugin_config;
+  *plugin_config.mutable_vm_config()->mutable_runtime() = runtime;
+  auto config = Envoy::Extensions::Common::Wasm::WasmConfig(plugin_config);
+  const bool clone = state.range(0) != 0;
+  int n_workers = 8;
+
+  for (__attribute__((unused)) auto _ : state) {
+    auto wasm = std::make_shared<Envoy::Extensions::Common::Wasm::Wasm>(
+        config, "", scope, *api, cluster_manager, *dispatcher);
+    auto wasm_handle = std::make_shared<Envoy::Extensions::Common::Wasm::WasmHandle>(wasm);
+    RELEASE_ASSERT(wasm->load(code, false), "failed to load the Wasm module");
+    if (clone) {
+      for (int i = 0; i < n_workers; ++i) {
+        auto thread_local_wasm =
+            std::make_shared<Envoy::Extensions::Common::Wasm::Wasm>(wasm_handle, *dispatcher);
+        benchmark::DoNotOptimize(thread_local_wasm->wasm_vm());
+      }
+    }
+  }
+}
+
+// The argument is whether the base VM is cloned in per-worker VMs.
+BENCHMARK(bmWasmLoad)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
 } // namespace Envoy
 
 int main(int argc, char** argv) {
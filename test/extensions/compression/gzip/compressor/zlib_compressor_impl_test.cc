@@ -3,6 +3,7 @@
 #include "source/extensions/compression/gzip/compressor/config.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "absl/container/fixed_array.h"
@@ -150,8 +151,9 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
                        strategy, compression_level);
   }
   TestUtility::loadFromJson(json, gzip);
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
   Envoy::Compression::Compressor::CompressorPtr compressor =
-      GzipCompressorFactory(gzip).createCompressor();
+      GzipCompressorFactory(gzip, tls).createCompressor();
   // Check the created compressor produces valid output.
   TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
   compressor->compress(buffer, Envoy::Compression::Compressor::State::Flush);
@@ -159,6 +161,58 @@ TEST_P(ZlibCompressorImplFactoryTest, CreateCompressorTest) {
   drainBuffer(buffer);
 }
 
+std::string compressWithFactory(GzipCompressorFactory& factory, const Buffer::OwnedImpl& input) {
+  Buffer::OwnedImpl buffer;
+  buffer.add(input);
+  Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+  compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  return buffer.toString();
+}
+
+// A compressor reusing the pooled stream of an earlier one produces the same output as a new one.
+TEST(ZlibCompressorPoolTest, ReusedStreamCompressesLikeNewOne) {
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  TestUtility::loadFromJson(R"EOF({
+    "compression_level": "BEST_SPEED",
+    "memory_level": 5,
+    "window_bits": 12,
+    "max_pooled_streams_per_worker": 1
+  })EOF",
+                            gzip);
+  Buffer::OwnedImpl input;
+  TestUtility::feedBufferWithRandomCharacters(input, 4096);
+
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  GzipCompressorFactory pooling_factory(gzip, tls);
+  const std::string first = compressWithFactory(pooling_factory, input);
+  expectValidFinishedBuffer(Buffer::OwnedImpl(first), input.length());
+  EXPECT_EQ(first, compressWithFactory(pooling_factory, input));
+
+  // Keeping two compressors at once overflows the pool, which frees the second stream.
+  Envoy::Compression::Compressor::CompressorPtr compressor1 = pooling_factory.createCompressor();
+  Envoy::Compression::Compressor::CompressorPtr compressor2 = pooling_factory.createCompressor();
+  compressor1.reset();
+  compressor2.reset();
+  EXPECT_EQ(first, compressWithFactory(pooling_factory, input));
+
+  gzip.clear_max_pooled_streams_per_worker();
+  GzipCompressorFactory factory(gzip, tls);
+  EXPECT_EQ(first, compressWithFactory(factory, input));
+}
+
+// Streams are not pooled on the threads without a pool.
+TEST(ZlibCompressorPoolTest, UnregisteredThreadDoesNotPool) {
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  gzip.mutable_max_pooled_streams_per_worker()->set_value(4);
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  tls.registered_ = false;
+  GzipCompressorFactory factory(gzip, tls);
+  Buffer::OwnedImpl input;
+  TestUtility::feedBufferWithRandomCharacters(input, 1024);
+  const std::string first = compressWithFactory(factory, input);
+  EXPECT_EQ(first, compressWithFactory(factory, input));
+}
+
 // Exercises death by passing bad initialization params or by calling
 // compress before init.
 TEST_F(ZlibCompressorImplDeathTest, CompressorDeathTest) {
@@ -2,8 +2,10 @@
 #include "source/common/common/hex.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/compression/gzip/compressor/zlib_compressor_impl.h"
+#include "source/extensions/compression/gzip/decompressor/config.h"
 #include "source/extensions/compression/gzip/decompressor/zlib_decompressor_impl.h"
 
+#include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/utility.h"
 
 #include "gtest/gtest.h"
@@ -334,6 +336,43 @@ TEST_F(ZlibDecompressorImplTest, CompressDecompressOfMultipleSlices) {
   EXPECT_EQ(original_text, decompressed_text);
 }
 
+// Decompressors reusing the pooled streams of earlier ones, including of failed ones, decompress
+// like new ones.
+TEST_F(ZlibDecompressorImplTest, PooledStreamsDecompress) {
+  Buffer::OwnedImpl buffer;
+  TestUtility::feedBufferWithRandomCharacters(buffer, 4096);
+  const std::string original_text{buffer.toString()};
+  Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl compressor;
+  compressor.init(
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionLevel::Standard,
+      Extensions::Compression::Gzip::Compressor::ZlibCompressorImpl::CompressionStrategy::Standard,
+      gzip_window_bits, memory_level);
+  compressor.compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  const std::string compressed_text{buffer.toString()};
+
+  envoy::extensions::compression::gzip::decompressor::v3::Gzip gzip;
+  gzip.mutable_max_pooled_streams_per_worker()->set_value(1);
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  GzipDecompressorFactory factory(gzip, stats_scope_, tls);
+
+  const auto decompress = [&factory](absl::string_view input) {
+    Buffer::OwnedImpl input_buffer(input);
+    Buffer::OwnedImpl output_buffer;
+    Envoy::Compression::Decompressor::DecompressorPtr decompressor =
+        factory.createDecompressor("test.");
+    decompressor->decompress(input_buffer, output_buffer);
+    return output_buffer.toString();
+  };
+  EXPECT_EQ(original_text, decompress(compressed_text));
+  EXPECT_EQ(original_text, decompress(compressed_text));
+
+  // Stops in the middle of the data, with a corrupted byte.
+  std::string corrupted_text = compressed_text.substr(0, compressed_text.size() / 2);
+  corrupted_text[20] ^= 0xff;
+  decompress(corrupted_text);
+  EXPECT_EQ(original_text, decompress(compressed_text));
+}
+
 class ZlibDecompressorStatsTest : public testing::Test {
 protected:
   void chargeErrorStats(const int result) { decompressor_.chargeErrorStats(result); }
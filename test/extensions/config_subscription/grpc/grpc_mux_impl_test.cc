@@ -81,7 +81,7 @@ public:
         /*rate_limit_settings_=*/custom_rate_limit_settings,
         /*scope_=*/*stats_.rootScope(),
         /*config_validators_=*/std::move(config_validators_),
-        /*xds_resources_delegate_=*/XdsResourcesDelegateOptRef(),
+        /*xds_resources_delegate_=*/xds_resources_delegate_,
         /*xds_config_tracker_=*/XdsConfigTrackerOptRef(),
         /*backoff_strategy_=*/
         std::make_unique<JitteredExponentialBackOffStrategy>(
@@ -137,6 +137,7 @@ public:
   Envoy::Config::RateLimitSettings rate_limit_settings_;
   Stats::Gauge& control_plane_connected_state_;
   Stats::Gauge& control_plane_pending_requests_;
+  XdsResourcesDelegateOptRef xds_resources_delegate_;
   MockEdsResourcesCache* eds_resources_cache_{nullptr};
 };
 
@@ -674,6 +675,152 @@ TEST_P(GrpcMuxImplTest, WildcardWatch) {
   }
 }
 
+// Validate that the resources unchanged since the last response are not decoded again.
+TEST_P(GrpcMuxImplTest, ReuseUnchangedDecodedResources) {
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TestTypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_x;
+  load_assignment_x.set_cluster_name("x");
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_y;
+  load_assignment_y.set_cluster_name("y");
+  const Protobuf::Message* decoded_x = nullptr;
+  const Protobuf::Message* decoded_y = nullptr;
+  absl::optional<uint64_t> hash_x;
+  absl::optional<uint64_t> hash_y;
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("1");
+    response->add_resources()->PackFrom(load_assignment_x);
+    response->add_resources()->PackFrom(load_assignment_y);
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+        .WillOnce(Invoke([&](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+          EXPECT_EQ(2, resources.size());
+          decoded_x = &resources[0].get().resource();
+          decoded_y = &resources[1].get().resource();
+          hash_x = resources[0].get().contentHash();
+          hash_y = resources[1].get().contentHash();
+          EXPECT_TRUE(hash_x.has_value());
+          EXPECT_NE(hash_x, hash_y);
+          return absl::OkStatus();
+        }));
+    expectSendMessage(type_url, {}, "1");
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+
+  // The unchanged resource is at the version of the new response, but shares its decoded message.
+  load_assignment_y.mutable_policy()->set_weighted_priority_health(true);
+  {
+    auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+    response->set_type_url(type_url);
+    response->set_version_info("2");
+    response->add_resources()->PackFrom(load_assignment_x);
+    response->add_resources()->PackFrom(load_assignment_y);
+    EXPECT_CALL(callbacks_, onConfigUpdate(_, "2"))
+        .WillOnce(Invoke([&](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+          EXPECT_EQ(2, resources.size());
+          EXPECT_EQ(decoded_x, &resources[0].get().resource());
+          EXPECT_EQ("2", resources[0].get().version());
+          EXPECT_EQ(hash_x, resources[0].get().contentHash());
+          EXPECT_NE(hash_y, resources[1].get().contentHash());
+          EXPECT_NE(decoded_y, &resources[1].get().resource());
+          EXPECT_TRUE(TestUtility::protoEqual(resources[1].get().resource(), load_assignment_y));
+          return absl::OkStatus();
+        }));
+    expectSendMessage(type_url, {}, "2");
+    grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+  }
+}
+
+// A delegate returning the same persisted resources for every load.
+class TestXdsResourcesDelegate : public XdsResourcesDelegate {
+public:
+  std::vector<envoy::service::discovery::v3::Resource>
+  getResources(const XdsSourceId&, const absl::flat_hash_set<std::string>&) const override {
+    return resources_;
+  }
+  void onConfigUpdated(const XdsSourceId&, const std::vector<DecodedResourceRef>&) override {}
+  void onResourceLoadFailed(const XdsSourceId&, const std::string&,
+                            const absl::optional<EnvoyException>&) override {}
+
+  std::vector<envoy::service::discovery::v3::Resource> resources_;
+};
+
+// Validate that the resources loaded from the delegate are not decoded again once the xDS server
+// sends them.
+TEST_P(GrpcMuxImplTest, ReuseDecodedResourcesLoadedFromDelegate) {
+  envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment;
+  load_assignment.set_cluster_name("x");
+  TestXdsResourcesDelegate delegate;
+  envoy::service::discovery::v3::Resource& persisted = delegate.resources_.emplace_back();
+  persisted.set_name("x");
+  persisted.set_version("1");
+  persisted.mutable_resource()->PackFrom(load_assignment);
+  xds_resources_delegate_ = delegate;
+
+  Event::MockTimer* grpc_stream_retry_timer{new Event::MockTimer()};
+  Event::MockTimer* ttl_mgr_timer{new NiceMock<Event::MockTimer>()};
+  Event::TimerCb grpc_stream_retry_timer_cb;
+  EXPECT_CALL(dispatcher_, createTimer_(_))
+      .WillOnce(
+          testing::DoAll(SaveArg<0>(&grpc_stream_retry_timer_cb), Return(grpc_stream_retry_timer)))
+      .WillRepeatedly(Return(ttl_mgr_timer));
+  setup();
+
+  InSequence s;
+  const std::string& type_url = Config::TestTypeUrl::get().ClusterLoadAssignment;
+  OpaqueResourceDecoderSharedPtr resource_decoder(
+      std::make_shared<TestUtility::TestOpaqueResourceDecoderImpl<
+          envoy::config::endpoint::v3::ClusterLoadAssignment>>("cluster_name"));
+  auto foo_sub = grpc_mux_->addWatch(type_url, {}, callbacks_, resource_decoder, {});
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "", true);
+  grpc_mux_->start();
+
+  // The xDS server is unreachable, so the persisted resources are loaded.
+  const Protobuf::Message* decoded = nullptr;
+  absl::optional<uint64_t> hash;
+  EXPECT_CALL(callbacks_,
+              onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason::ConnectionFailure, _));
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "1"))
+      .WillOnce(Invoke([&](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+        EXPECT_EQ(1, resources.size());
+        decoded = &resources[0].get().resource();
+        hash = resources[0].get().contentHash();
+        EXPECT_TRUE(hash.has_value());
+        return absl::OkStatus();
+      }));
+  EXPECT_CALL(*grpc_stream_retry_timer, enableTimer(_, _))
+      .WillOnce(Invoke(grpc_stream_retry_timer_cb));
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(&async_stream_));
+  expectSendMessage(type_url, {}, "1", true);
+  grpc_mux_->grpcStreamForTest().onRemoteClose(Grpc::Status::WellKnownGrpcStatus::Canceled, "");
+
+  auto response = std::make_unique<envoy::service::discovery::v3::DiscoveryResponse>();
+  response->set_type_url(type_url);
+  response->set_version_info("2");
+  response->add_resources()->PackFrom(load_assignment);
+  EXPECT_CALL(callbacks_, onConfigUpdate(_, "2"))
+      .WillOnce(Invoke([&](const std::vector<DecodedResourceRef>& resources, const std::string&) {
+        EXPECT_EQ(1, resources.size());
+        EXPECT_EQ(decoded, &resources[0].get().resource());
+        EXPECT_EQ(hash, resources[0].get().contentHash());
+        return absl::OkStatus();
+      }));
+  expectSendMessage(type_url, {}, "2");
+  grpc_mux_->grpcStreamForTest().onReceiveMessage(std::move(response));
+}
+
 // Validate behavior when watches specify resources (potentially overlapping).
 TEST_P(GrpcMuxImplTest, WatchDemux) {
   setup();
@@ -8,6 +8,7 @@
 
 #include "source/extensions/config_subscription/grpc/watch_map.h"
 
+#include "test/common/memory/memory_test_utility.h"
 #include "test/mocks/config/custom_config_validators.h"
 #include "test/mocks/config/eds_resources_cache.h"
 #include "test/mocks/config/mocks.h"
@@ -771,6 +772,31 @@ TEST(WatchMapTest, OnConfigUpdateUsingNamespaces) {
   }
 }
 
+// Measures the memory of the bookkeeping of the subscribed resources, which stays in place as long
+// as the subscription. See the test logs for the bytes per subscribed resource.
+TEST(WatchMapTest, MemoryPerSubscribedResource) {
+  MockSubscriptionCallbacks callbacks;
+  TestUtility::TestOpaqueResourceDecoderImpl<envoy::config::endpoint::v3::ClusterLoadAssignment>
+      resource_decoder("cluster_name");
+  NiceMock<MockCustomConfigValidators> config_validators;
+  WatchMap watch_map(false, "ClusterLoadAssignmentType", &config_validators, {});
+  Watch* watch = watch_map.addWatch(callbacks, resource_decoder);
+
+  constexpr size_t resources = 10000;
+  absl::flat_hash_set<std::string> names;
+  for (size_t i = 0; i < resources; ++i) {
+    names.insert(absl::StrCat("resource_", i));
+  }
+
+  Memory::TestUtil::MemoryTest memory_test;
+  watch_map.updateWatchInterest(watch, names);
+  const size_t consumed_bytes = memory_test.consumedBytes();
+  ENVOY_LOG_MISC(info, "{} bytes per subscribed resource", consumed_bytes / resources);
+  // About 130 bytes: the names are in the map of the watches interested in each, and in the
+  // names of the watch.
+  EXPECT_MEMORY_LE(consumed_bytes, 160 * resources);
+}
+
 // TODO(adip): Add tests that use the eds cache.
 // Needs to test the following function onConfigUpdate (sotw&delta) and
 // updateWatchInterest
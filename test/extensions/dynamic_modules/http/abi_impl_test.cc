@@ -6,6 +6,7 @@
 
 #include "envoy/registry/registry.h"
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/router/string_accessor_impl.h"
 #include "source/extensions/filters/http/dynamic_modules/filter.h"
 #include "source/extensions/filters/http/dynamic_modules/filter_config.h"
@@ -1379,6 +1380,44 @@ TEST(ABIImpl, RequestBody) {
       &filter, envoy_dynamic_module_type_http_body_type_ReceivedRequestBody, {nullptr, 0}));
 }
 
+TEST(ABIImpl, MutableRequestBody) {
+  Stats::SymbolTableImpl symbol_table;
+  DynamicModuleHttpFilter filter{nullptr, symbol_table, 0};
+  EXPECT_FALSE(envoy_dynamic_module_callback_http_get_mutable_body_chunks(
+      &filter, envoy_dynamic_module_type_http_body_type_ReceivedRequestBody, nullptr));
+
+  // A body backed by a read-only fragment.
+  const std::string data = "foo";
+  bool released = false;
+  Buffer::BufferFragmentImpl fragment(
+      data.data(), data.size(),
+      [&released](const void*, size_t, const Buffer::BufferFragmentImpl*) { released = true; });
+  Buffer::OwnedImpl buffer;
+  buffer.addBufferFragment(fragment);
+  filter.current_request_body_ = &buffer;
+
+  // The read-only view points into the fragment.
+  ASSERT_EQ(envoy_dynamic_module_callback_http_get_body_chunks_size(
+                &filter, envoy_dynamic_module_type_http_body_type_ReceivedRequestBody),
+            1);
+  auto result_buffer_vector = std::vector<envoy_dynamic_module_type_envoy_buffer>(1);
+  EXPECT_TRUE(envoy_dynamic_module_callback_http_get_body_chunks(
+      &filter, envoy_dynamic_module_type_http_body_type_ReceivedRequestBody,
+      result_buffer_vector.data()));
+  EXPECT_EQ(result_buffer_vector[0].ptr, data.data());
+
+  // The mutable view is a copy of the fragment, which can be modified in place.
+  EXPECT_TRUE(envoy_dynamic_module_callback_http_get_mutable_body_chunks(
+      &filter, envoy_dynamic_module_type_http_body_type_ReceivedRequestBody,
+      result_buffer_vector.data()));
+  EXPECT_TRUE(released);
+  EXPECT_NE(result_buffer_vector[0].ptr, data.data());
+  EXPECT_EQ(bufferVectorToString(result_buffer_vector), data);
+  const_cast<char*>(result_buffer_vector[0].ptr)[0] = 'F';
+  EXPECT_EQ(buffer.toString(), "Foo");
+  EXPECT_EQ(data, "foo");
+}
+
 TEST(ABIImpl, BufferedRequestBody) {
   Stats::SymbolTableImpl symbol_table;
   DynamicModuleHttpFilter filter{nullptr, symbol_table, 0};
@@ -1,6 +1,7 @@
 #include "source/extensions/filters/common/expr/evaluator.h"
 
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/time/time.h"
@@ -54,6 +55,83 @@ TEST(Evaluator, Activation) {
   EXPECT_TRUE(activation->FindValue("upstream_filter_state", &arena).has_value());
 }
 
+// request.path == "/foo"
+cel::expr::Expr pathEquals(const std::string& path) {
+  cel::expr::Expr expr;
+  auto* call = expr.mutable_call_expr();
+  call->set_function("_==_");
+  auto* select = call->add_args()->mutable_select_expr();
+  select->mutable_operand()->mutable_ident_expr()->set_name("request");
+  select->set_field("path");
+  call->add_args()->mutable_const_expr()->set_string_value(path);
+  return expr;
+}
+
+TEST(Evaluator, SharesCompiledPrograms) {
+  auto builder = std::make_shared<BuilderInstance>(createBuilder());
+  auto foo = builder->compile(pathEquals("/foo"));
+  ASSERT_TRUE(foo.ok());
+  auto foo_again = builder->compile(pathEquals("/foo"));
+  ASSERT_TRUE(foo_again.ok());
+  EXPECT_EQ(foo.value(), foo_again.value());
+  auto bar = builder->compile(pathEquals("/bar"));
+  ASSERT_TRUE(bar.ok());
+  EXPECT_NE(foo.value(), bar.value());
+
+  // A released program is compiled again.
+  bar.value().reset();
+  auto bar_again = builder->compile(pathEquals("/bar"));
+  ASSERT_TRUE(bar_again.ok());
+  EXPECT_NE(bar_again.value(), nullptr);
+}
+
+TEST(Evaluator, SharedStreamActivation) {
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl request_headers{{":path", "/foo"}};
+  Http::TestResponseHeaderMapImpl response_headers;
+  Protobuf::Arena arena;
+
+  const SharedStreamActivation& activation =
+      SharedStreamActivation::get(nullptr, info, &request_headers, nullptr, nullptr);
+  const auto request = activation.FindValue("request", &arena);
+  ASSERT_TRUE(request.has_value());
+  EXPECT_EQ(&SharedStreamActivation::get(nullptr, info, &request_headers, nullptr, nullptr),
+            &activation);
+  // The wrappers are memoized by the activation of the stream.
+  EXPECT_EQ(activation.FindValue("request", &arena)->MapOrDie(), request->MapOrDie());
+  EXPECT_TRUE(activation.FindValue("filter_state", &arena).has_value());
+
+  // Other headers replace the activation.
+  const SharedStreamActivation& response_activation =
+      SharedStreamActivation::get(nullptr, info, &request_headers, &response_headers, nullptr);
+  const auto response = response_activation.FindValue("response", &arena);
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(response_activation.FindValue("response", &arena)->MapOrDie(), response->MapOrDie());
+}
+
+TEST(Evaluator, EvaluateWithSharedStreamActivation) {
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl request_headers{{":path", "/foo"}};
+  auto builder = std::make_shared<BuilderInstance>(createBuilder());
+  auto foo = CompiledExpression::Create(builder, pathEquals("/foo"));
+  ASSERT_TRUE(foo.ok());
+  auto bar = CompiledExpression::Create(builder, pathEquals("/bar"));
+  ASSERT_TRUE(bar.ok());
+
+  for (const std::string& enabled : {"true", "false"}) {
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.cel_shared_stream_activation", enabled}});
+    EXPECT_TRUE(foo.value().matches(info, request_headers));
+    EXPECT_FALSE(bar.value().matches(info, request_headers));
+    // The memoized wrappers read the current headers of the stream.
+    request_headers.setPath("/bar");
+    EXPECT_FALSE(foo.value().matches(info, request_headers));
+    EXPECT_TRUE(bar.value().matches(info, request_headers));
+    request_headers.setPath("/foo");
+  }
+}
+
 } // namespace
 } // namespace Expr
 } // namespace Common
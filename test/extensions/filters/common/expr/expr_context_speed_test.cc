@@ -3,6 +3,7 @@
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/router/string_accessor_impl.h"
 #include "source/extensions/filters/common/expr/context.h"
+#include "source/extensions/filters/common/expr/evaluator.h"
 
 #include "test/mocks/local_info/mocks.h"
 #include "test/mocks/ssl/mocks.h"
@@ -177,6 +178,81 @@ BENCHMARK(bmResponseAttributes)
 
 BENCHMARK(bmFilterState)->Unit(::benchmark::kMicrosecond)->RangeMultiplier(100)->Range(10, 100000);
 
+// request.path == "/meow"
+cel::expr::Expr pathEquals() {
+  cel::expr::Expr expr;
+  auto* call = expr.mutable_call_expr();
+  call->set_function("_==_");
+  auto* select = call->add_args()->mutable_select_expr();
+  select->mutable_operand()->mutable_ident_expr()->set_name("request");
+  select->set_field("path");
+  call->add_args()->mutable_const_expr()->set_string_value("/meow");
+  return expr;
+}
+
+// request.size < 2 * 5
+cel::expr::Expr sizeBelowConstant() {
+  cel::expr::Expr expr;
+  auto* call = expr.mutable_call_expr();
+  call->set_function("_<_");
+  auto* select = call->add_args()->mutable_select_expr();
+  select->mutable_operand()->mutable_ident_expr()->set_name("request");
+  select->set_field("size");
+  auto* product = call->add_args()->mutable_call_expr();
+  product->set_function("_*_");
+  product->add_args()->mutable_const_expr()->set_int64_value(2);
+  product->add_args()->mutable_const_expr()->set_int64_value(5);
+  return expr;
+}
+
+// Evaluates the given number of expressions for a request, as the filters of its chain do, with
+// an activation shared by all the evaluations when the second argument is set.
+static void bmEvaluateExpressions(::benchmark::State& state) {
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/meow"}};
+  auto builder = std::make_shared<BuilderInstance>(createBuilder());
+  std::vector<CompiledExpression> expressions;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    expressions.push_back(CompiledExpression::Create(builder, pathEquals()).value());
+  }
+  const bool shared = state.range(1) != 0;
+
+  for (auto _ : state) { // NOLINT
+    for (const CompiledExpression& expression : expressions) {
+      Protobuf::Arena arena;
+      if (shared) {
+        benchmark::DoNotOptimize(expression.evaluate(
+            SharedStreamActivation::get(nullptr, info, &headers, nullptr, nullptr), &arena));
+      } else {
+        const StreamActivation activation(nullptr, info, &headers, nullptr, nullptr);
+        benchmark::DoNotOptimize(expression.evaluate(activation, &arena));
+      }
+    }
+  }
+}
+
+BENCHMARK(bmEvaluateExpressions)->ArgsProduct({{1, 10}, {0, 1}});
+
+// Evaluates an expression with a constant sub-expression, folded when the argument is set.
+static void bmConstantFolding(::benchmark::State& state) {
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  Http::TestRequestHeaderMapImpl headers{{":method", "GET"}, {":path", "/meow"}};
+  auto constant_arena = std::make_unique<Protobuf::Arena>();
+  auto builder = std::make_shared<BuilderInstance>(
+      createBuilder({}, state.range(0) != 0 ? constant_arena.get() : nullptr), nullptr,
+      std::move(constant_arena));
+  const CompiledExpression expression =
+      CompiledExpression::Create(builder, sizeBelowConstant()).value();
+  const StreamActivation activation(nullptr, info, &headers, nullptr, nullptr);
+
+  for (auto _ : state) { // NOLINT
+    Protobuf::Arena arena;
+    benchmark::DoNotOptimize(expression.evaluate(activation, &arena));
+  }
+}
+
+BENCHMARK(bmConstantFolding)->Arg(0)->Arg(1);
+
 } // namespace Expr
 } // namespace Common
 } // namespace Filters
@@ -0,0 +1,76 @@
+#include <memory>
+#include <vector>
+
+#include "source/extensions/filters/common/local_ratelimit/local_ratelimit_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Filters {
+namespace Common {
+namespace LocalRateLimit {
+
+namespace {
+
+// A limit high enough to let all the requests through, so that only the contention is measured.
+constexpr uint64_t MaxTokens = 1000000000;
+
+std::shared_ptr<LocalRateLimiterImpl> rate_limiter;
+
+Event::MockDispatcher& dispatcher() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Event::MockDispatcher); }
+
+} // namespace
+
+// Consumes the default token bucket shared by all the threads, which are sharded when the argument
+// is set.
+static void bmSharedTokenBucket(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    const Protobuf::RepeatedPtrField<
+        envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+        descriptors;
+    const TokenBucketSharding sharding =
+        state.range(0) != 0 ? TokenBucketSharding{static_cast<uint32_t>(state.threads()), 64}
+                            : TokenBucketSharding{};
+    rate_limiter = std::make_shared<LocalRateLimiterImpl>(std::chrono::milliseconds(50), MaxTokens,
+                                                          MaxTokens, dispatcher(), descriptors,
+                                                          true, nullptr, 20, sharding);
+  }
+
+  const std::vector<RateLimit::Descriptor> request_descriptors;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(rate_limiter->requestAllowed(request_descriptors));
+  }
+}
+BENCHMARK(bmSharedTokenBucket)->Arg(0)->Arg(1)->Threads(1)->Threads(64)->UseRealTime();
+
+// Looks up a request descriptor among the given number of wildcard descriptors with distinct keys.
+static void bmWildcardDescriptorLookup(benchmark::State& state) {
+  Protobuf::RepeatedPtrField<envoy::extensions::common::ratelimit::v3::LocalRateLimitDescriptor>
+      descriptors;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    auto* descriptor = descriptors.Add();
+    descriptor->add_entries()->set_key(absl::StrCat("key_", i));
+    descriptor->mutable_token_bucket()->set_max_tokens(MaxTokens);
+    descriptor->mutable_token_bucket()->mutable_fill_interval()->set_seconds(1);
+  }
+  LocalRateLimiterImpl limiter(std::chrono::milliseconds(0), 0, 0, dispatcher(), descriptors);
+  const std::vector<RateLimit::Descriptor> request_descriptors{
+      {{{absl::StrCat("key_", state.range(0) - 1), "value"}}}};
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    benchmark::DoNotOptimize(limiter.requestAllowed(request_descriptors));
+  }
+}
+BENCHMARK(bmWildcardDescriptorLookup)->Arg(1)->Arg(16)->Arg(256);
+
+} // namespace LocalRateLimit
+} // namespace Common
+} // namespace Filters
+} // namespace Extensions
+} // namespace Envoy
@@ -706,6 +706,81 @@ TEST_F(LocalRateLimiterDescriptorImplTest, NullDefaultTokenBucket) {
   EXPECT_FALSE(no_match_result.token_bucket_context);
 }
 
+// Verify that the wildcard descriptors with the same keys are told apart by their values.
+TEST_F(LocalRateLimiterDescriptorImplTest, DynamicTokenBucketsSameKeys) {
+  TestUtility::loadFromYaml(fmt::format(multiple_wildcard_descriptor_config_yaml, 1, 1, "60s"),
+                            *descriptors_.Add());
+  auto* other_org = descriptors_.Add();
+  TestUtility::loadFromYaml(fmt::format(multiple_wildcard_descriptor_config_yaml, 2, 2, "60s"),
+                            *other_org);
+  other_org->mutable_entries(1)->set_value("other");
+  initializeWithAtomicTokenBucketDescriptor(std::chrono::milliseconds(60000), 20, 20);
+
+  std::vector<RateLimit::Descriptor> test_org{{{{"user", "A"}, {"org", "test"}}}};
+  EXPECT_TRUE(rate_limiter_->requestAllowed(test_org).allowed);
+  EXPECT_FALSE(rate_limiter_->requestAllowed(test_org).allowed);
+
+  std::vector<RateLimit::Descriptor> other_org_descriptor{{{{"user", "A"}, {"org", "other"}}}};
+  EXPECT_TRUE(rate_limiter_->requestAllowed(other_org_descriptor).allowed);
+  EXPECT_TRUE(rate_limiter_->requestAllowed(other_org_descriptor).allowed);
+  EXPECT_FALSE(rate_limiter_->requestAllowed(other_org_descriptor).allowed);
+
+  // Handled by the default token bucket.
+  std::vector<RateLimit::Descriptor> no_org{{{{"user", "A"}, {"org", "none"}}}};
+  EXPECT_EQ(rate_limiter_->requestAllowed(no_org).token_bucket_context->maxTokens(), 20);
+}
+
+// Verify that the workers consume the tokens of their shard, replenished from the shared token
+// bucket a batch at a time.
+TEST_F(LocalRateLimiterImplTest, ShardedTokenBucket) {
+  rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
+      std::chrono::milliseconds(200), 5, 5, dispatcher_, descriptors_, true, nullptr, 20,
+      TokenBucketSharding{2, 2});
+
+  // 5 -> 3 shared tokens, 2 -> 1 shard tokens.
+  auto result = rate_limiter_->requestAllowed(route_descriptors_);
+  EXPECT_TRUE(result.allowed);
+  EXPECT_EQ(result.token_bucket_context->maxTokens(), 5);
+  EXPECT_EQ(result.token_bucket_context->remainingTokens(), 4);
+  // 1 -> 0 shard tokens.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+  // 3 -> 1 shared tokens, 2 -> 0 shard tokens.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+  // 1 -> 0 shared tokens, which is less than a batch but enough for the request.
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+  EXPECT_FALSE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+
+  // 0 -> 5 shared tokens.
+  dispatcher_.globalTimeSystem().advanceTimeWait(std::chrono::milliseconds(200));
+  EXPECT_TRUE(rate_limiter_->requestAllowed(route_descriptors_).allowed);
+}
+
+// Verify that the workers never consume more tokens than the shared token bucket holds. The shards
+// are left with at most the rest of a batch per worker.
+TEST_F(LocalRateLimiterImplTest, ShardedTokenBucketConcurrentWorkers) {
+  rate_limiter_ = std::make_shared<LocalRateLimiterImpl>(
+      std::chrono::milliseconds(60000), 100, 1, dispatcher_, descriptors_, true, nullptr, 20,
+      TokenBucketSharding{4, 3});
+
+  std::atomic<uint32_t> allowed{0};
+  std::vector<Thread::ThreadPtr> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&]() {
+      for (int j = 0; j < 100; j++) {
+        if (rate_limiter_->requestAllowed(route_descriptors_).allowed) {
+          allowed++;
+        }
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  EXPECT_LE(allowed.load(), 100);
+  EXPECT_GE(allowed.load(), 100 - 8 * 2);
+}
+
 } // Namespace LocalRateLimit
 } // namespace Common
 } // namespace Filters
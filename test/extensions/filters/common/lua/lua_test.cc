@@ -178,6 +178,59 @@ TEST_F(LuaTest, MarkDead) {
   lua_gc(cr1->luaState(), LUA_GCCOLLECT, 0);
 }
 
+// The threads of the coroutines that finished successfully are reused, and the others are not.
+TEST_F(LuaTest, CoroutineReuse) {
+  const std::string SCRIPT{R"EOF(
+    function callMe(fail)
+      if fail then
+        error("failed")
+      end
+      return "done"
+    end
+
+    function yieldMe()
+      coroutine.yield()
+    end
+  )EOF"};
+
+  setup(SCRIPT);
+  const int call_me = state_->getGlobalRef(state_->registerGlobal("callMe", initializers_));
+  const int yield_me = state_->getGlobalRef(state_->registerGlobal("yieldMe", initializers_));
+
+  CoroutinePtr cr1(state_->createCoroutine());
+  lua_State* thread = cr1->luaState();
+  lua_pushboolean(thread, false);
+  cr1->start(call_me, 1, yield_callback_);
+  EXPECT_EQ(cr1->state(), Coroutine::State::Finished);
+  EXPECT_EQ("done", getStringViewFromLuaString(thread, -1));
+  cr1.reset();
+
+  // The thread is reused with an empty stack, and raises an error.
+  CoroutinePtr cr2(state_->createCoroutine());
+  EXPECT_EQ(thread, cr2->luaState());
+  EXPECT_EQ(0, lua_gettop(thread));
+  lua_pushboolean(thread, true);
+  EXPECT_THROW_WITH_REGEX(cr2->start(call_me, 1, yield_callback_), LuaException, "failed");
+  // Keeps the thread referenced, so that a new thread does not get its address.
+  lua_pushthread(thread);
+  LuaRef<lua_State> failed_thread({thread, thread}, false);
+  cr2.reset();
+
+  // So it is not reused, nor is the thread of a yielded coroutine.
+  CoroutinePtr cr3(state_->createCoroutine());
+  EXPECT_NE(thread, cr3->luaState());
+  thread = cr3->luaState();
+  EXPECT_CALL(on_yield_, ready());
+  cr3->start(yield_me, 0, yield_callback_);
+  EXPECT_EQ(cr3->state(), Coroutine::State::Yielded);
+  lua_pushthread(thread);
+  LuaRef<lua_State> yielded_thread({thread, thread}, false);
+  cr3.reset();
+
+  CoroutinePtr cr4(state_->createCoroutine());
+  EXPECT_NE(thread, cr4->luaState());
+}
+
 class ThreadSafeTest : public testing::Test {
 public:
   ThreadSafeTest()
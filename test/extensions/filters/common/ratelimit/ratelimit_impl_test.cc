@@ -48,6 +48,7 @@ public:
                const Http::ResponseHeaderMap* response_headers_to_add,
                const Http::RequestHeaderMap* request_headers_to_add,
                const std::string& response_body, const Protobuf::Struct* dynamic_metadata));
+  MOCK_METHOD(void, onQuota, (const envoy::service::ratelimit::v3::RateLimitResponse::Quota&));
 };
 
 class RateLimitGrpcClientTest : public testing::Test {
@@ -156,6 +157,23 @@ TEST_F(RateLimitGrpcClientTest, Basic) {
   }
 }
 
+TEST_F(RateLimitGrpcClientTest, ResponseQuota) {
+  EXPECT_CALL(*async_client_, sendRaw(_, _, _, _, _, _)).WillOnce(Return(&async_request_));
+  client_.limit(request_callbacks_, "foo", {{{{"foo", "bar"}}}}, Tracing::NullSpan::instance(),
+                stream_info_);
+
+  auto response = std::make_unique<envoy::service::ratelimit::v3::RateLimitResponse>();
+  response->set_overall_code(envoy::service::ratelimit::v3::RateLimitResponse::OK);
+  response->mutable_quota()->set_requests(10);
+  testing::InSequence s;
+  EXPECT_CALL(request_callbacks_, onQuota(_))
+      .WillOnce(Invoke([](const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) {
+        EXPECT_EQ(quota.requests(), 10);
+      }));
+  EXPECT_CALL(request_callbacks_, complete_(LimitStatus::OK, _, _, _, _, _));
+  client_.onSuccess(std::move(response), span_);
+}
+
 TEST_F(RateLimitGrpcClientTest, Cancel) {
   std::unique_ptr<envoy::service::ratelimit::v3::RateLimitResponse> response;
 
@@ -1844,6 +1844,104 @@ TEST(PrincipalMatcher, MetadataCreation) {
                Envoy::Http::TestRequestHeaderMapImpl(), info);
 }
 
+envoy::config::rbac::v3::Principal directRemoteIpPrincipal(const std::string& address,
+                                                           uint32_t prefix_len) {
+  envoy::config::rbac::v3::Principal principal;
+  principal.mutable_direct_remote_ip()->set_address_prefix(address);
+  principal.mutable_direct_remote_ip()->mutable_prefix_len()->set_value(prefix_len);
+  return principal;
+}
+
+TEST(SharedMatchers, SharesIdenticalMatchers) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  SharedMatchers shared_matchers;
+  envoy::config::rbac::v3::Permission permission;
+  auto* header = permission.mutable_and_rules()->add_rules()->mutable_header();
+  header->set_name("foo");
+  header->mutable_string_match()->set_exact("bar");
+  permission.mutable_and_rules()->add_rules()->set_destination_port(123);
+  permission.mutable_and_rules()->add_rules()->set_any(true);
+
+  const MatcherConstPtr first = Matcher::create(
+      permission, ProtobufMessage::getStrictValidationVisitor(), factory_context, &shared_matchers);
+  const MatcherConstPtr second = Matcher::create(
+      permission, ProtobufMessage::getStrictValidationVisitor(), factory_context, &shared_matchers);
+  // The and_rules, header and port matchers are shared, but not the any matcher.
+  EXPECT_EQ(shared_matchers.size(), 3);
+  shared_matchers.finalize();
+
+  Envoy::Network::MockConnection conn;
+  Envoy::Http::TestRequestHeaderMapImpl headers{{"foo", "bar"}};
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  info.downstream_connection_info_provider_->setLocalAddress(
+      Envoy::Network::Utility::parseInternetAddressNoThrow("1.2.3.4", 123, false));
+  {
+    SharedMatchers::Evaluation evaluation(shared_matchers);
+    checkMatcher(*first, true, conn, headers, info);
+    // The result of the shared matcher is memoized for the evaluation.
+    headers.setCopy(Envoy::Http::LowerCaseString("foo"), "baz");
+    checkMatcher(*second, true, conn, headers, info);
+  }
+
+  // Outside an evaluation, it is evaluated on every call.
+  checkMatcher(*second, false, conn, headers, info);
+  {
+    SharedMatchers::Evaluation evaluation(shared_matchers);
+    checkMatcher(*first, false, conn, headers, info);
+  }
+}
+
+TEST(SharedMatchers, IndexesIpMatchers) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  SharedMatchers shared_matchers;
+  const MatcherConstPtr wide =
+      Matcher::create(directRemoteIpPrincipal("10.0.0.0", 8), factory_context, &shared_matchers);
+  const MatcherConstPtr narrow =
+      Matcher::create(directRemoteIpPrincipal("10.1.0.0", 16), factory_context, &shared_matchers);
+  const MatcherConstPtr other = Matcher::create(directRemoteIpPrincipal("192.168.0.0", 16),
+                                                factory_context, &shared_matchers);
+  const MatcherConstPtr ipv6 =
+      Matcher::create(directRemoteIpPrincipal("2001:db8::", 32), factory_context, &shared_matchers);
+  // The only IP matcher of its type of address is not indexed.
+  envoy::config::rbac::v3::Principal remote_ip;
+  remote_ip.mutable_remote_ip()->set_address_prefix("10.0.0.0");
+  remote_ip.mutable_remote_ip()->mutable_prefix_len()->set_value(8);
+  const MatcherConstPtr remote = Matcher::create(remote_ip, factory_context, &shared_matchers);
+  shared_matchers.finalize();
+
+  NiceMock<Envoy::Network::MockConnection> conn;
+  Envoy::Http::TestRequestHeaderMapImpl headers;
+  NiceMock<StreamInfo::MockStreamInfo> info;
+  auto addr = Envoy::Network::Utility::parseInternetAddressNoThrow("10.1.2.3", 123, false);
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(addr);
+  info.downstream_connection_info_provider_->setRemoteAddress(addr);
+  {
+    SharedMatchers::Evaluation evaluation(shared_matchers);
+    checkMatcher(*other, false, conn, headers, info);
+    checkMatcher(*wide, true, conn, headers, info);
+    checkMatcher(*narrow, true, conn, headers, info);
+    checkMatcher(*ipv6, false, conn, headers, info);
+    checkMatcher(*remote, true, conn, headers, info);
+  }
+
+  addr = Envoy::Network::Utility::parseInternetAddressNoThrow("2001:db8::1", 123, false);
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(addr);
+  {
+    SharedMatchers::Evaluation evaluation(shared_matchers);
+    checkMatcher(*ipv6, true, conn, headers, info);
+    checkMatcher(*wide, false, conn, headers, info);
+  }
+
+  // Non-IP addresses match none of the indexed ranges.
+  info.downstream_connection_info_provider_->setDirectRemoteAddressForTest(
+      *Envoy::Network::Address::PipeInstance::create("test"));
+  {
+    SharedMatchers::Evaluation evaluation(shared_matchers);
+    checkMatcher(*wide, false, conn, headers, info);
+    checkMatcher(*ipv6, false, conn, headers, info);
+  }
+}
+
 } // namespace
 } // namespace RBAC
 } // namespace Common
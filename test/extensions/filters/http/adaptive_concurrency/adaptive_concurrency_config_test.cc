@@ -1,6 +1,7 @@
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.validate.h"
 
+#include "source/extensions/filters/http/adaptive_concurrency/adaptive_concurrency_filter.h"
 #include "source/extensions/filters/http/adaptive_concurrency/config.h"
 
 #include "test/mocks/http/mocks.h"
@@ -71,6 +72,50 @@ enabled:
   cb(filter_callback);
 }
 
+// The routes with the same stat prefix and controller configuration share their controller, also
+// across route configuration updates, while the others get their own.
+TEST(AdaptiveConcurrencyConfigTest, RouteControllers) {
+  const std::string yaml = R"EOF(
+gradient_controller_config:
+  concurrency_limit_params:
+    concurrency_update_interval: 0.1s
+  min_rtt_calc_params:
+    interval: 30s
+stat_prefix: route_a
+)EOF";
+  envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrencyPerRoute
+      proto_config;
+  TestUtility::loadFromYamlAndValidate(yaml, proto_config);
+
+  AdaptiveConcurrencyFilterFactory factory;
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  const auto route_controller = [&]() {
+    auto route_config =
+        factory
+            .createRouteSpecificFilterConfig(proto_config, context,
+                                             ProtobufMessage::getNullValidationVisitor())
+            .value();
+    return dynamic_cast<const AdaptiveConcurrencyRouteConfig&>(*route_config).controller();
+  };
+
+  const ConcurrencyControllerSharedPtr controller = route_controller();
+  EXPECT_EQ(controller, route_controller());
+  // The limit is pinned to the default min_concurrency while measuring the minRTT.
+  EXPECT_EQ(3, context.store_
+                   .gauge("adaptive_concurrency.route_a.gradient_controller.concurrency_limit",
+                          Stats::Gauge::ImportMode::NeverImport)
+                   .value());
+
+  proto_config.set_stat_prefix("route_b");
+  EXPECT_NE(controller, route_controller());
+  proto_config.set_stat_prefix("route_a");
+  proto_config.mutable_gradient_controller_config()
+      ->mutable_min_rtt_calc_params()
+      ->mutable_fixed_value()
+      ->set_seconds(1);
+  EXPECT_NE(controller, route_controller());
+}
+
 } // namespace
 } // namespace AdaptiveConcurrency
 } // namespace HttpFilters
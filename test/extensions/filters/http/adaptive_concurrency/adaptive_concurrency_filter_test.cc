@@ -254,6 +254,25 @@ TEST_F(AdaptiveConcurrencyFilterTest, DecodeHeadersTestBlock) {
             filter_->decodeHeaders(request_headers, true));
 }
 
+// The requests of a route with a per-route configuration are limited and sampled by the controller
+// of the route only.
+TEST_F(AdaptiveConcurrencyFilterTest, RouteController) {
+  auto route_controller = std::make_shared<MockConcurrencyController>();
+  AdaptiveConcurrencyRouteConfig route_config(route_controller);
+  EXPECT_CALL(*decoder_callbacks_.route_, mostSpecificPerFilterConfig(_))
+      .WillOnce(Return(&route_config));
+
+  EXPECT_CALL(*controller_, forwardingDecision()).Times(0);
+  EXPECT_CALL(*route_controller, forwardingDecision())
+      .WillOnce(Return(RequestForwardingAction::Forward));
+  Http::TestRequestHeaderMapImpl request_headers;
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+
+  EXPECT_CALL(*controller_, recordLatencySample(_)).Times(0);
+  EXPECT_CALL(*route_controller, recordLatencySample(_));
+  filter_->encodeComplete();
+}
+
 TEST_F(AdaptiveConcurrencyFilterTest, RecordSampleInDestructor) {
   // Verify that the request latency is always sampled even if encodeComplete() is never called.
   EXPECT_CALL(*controller_, forwardingDecision())
@@ -129,6 +129,34 @@ TEST_F(ThreadLocalControllerTest, AverageRps) {
   EXPECT_EQ(0, tlc_.averageRps());
 }
 
+// The controllers sharing their counts merge those of the other workers each time they roll over
+// into a new entry of their history, and forget the workers that did not publish within the window.
+TEST_F(ThreadLocalControllerTest, AggregateAcrossWorkers) {
+  auto worker_counts = std::make_shared<WorkerRequestCounts>(window_);
+  ThreadLocalControllerImpl worker_a(time_system_, window_, worker_counts);
+  ThreadLocalControllerImpl worker_b(time_system_, window_, worker_counts);
+
+  worker_a.recordSuccess();
+  worker_a.recordSuccess();
+  worker_a.recordFailure();
+  worker_b.recordSuccess();
+  EXPECT_EQ(RequestData(3, 2), worker_a.requestCounts());
+  EXPECT_EQ(RequestData(1, 1), worker_b.requestCounts());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(RequestData(3, 2), worker_a.requestCounts());
+  EXPECT_EQ(RequestData(4, 3), worker_b.requestCounts());
+  // The counts of worker b are only merged into worker a on its next roll over.
+  EXPECT_EQ(RequestData(3, 2), worker_a.requestCounts());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(RequestData(4, 3), worker_a.requestCounts());
+
+  // Worker a goes idle, so its counts expire from the view of worker b.
+  time_system_.advanceTimeWait(window_);
+  EXPECT_EQ(RequestData(0, 0), worker_b.requestCounts());
+}
+
 } // namespace
 } // namespace AdmissionControl
 } // namespace HttpFilters
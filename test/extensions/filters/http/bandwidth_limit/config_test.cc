@@ -134,6 +134,23 @@ TEST(Factory, PerRouteConfigNoLimits) {
       *proto_config, context, ProtobufMessage::getNullValidationVisitor());
   EXPECT_EQ(result.status().message(), "limit must be set for per route filter config");
 }
+
+TEST(Factory, TenantHeaderNoTenantLimit) {
+  const std::string config_yaml = R"(
+  stat_prefix: test
+  limit_kbps: 10
+  tenant_header: x-tenant
+  )";
+
+  BandwidthLimitFilterConfig factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyRouteConfigProto();
+  TestUtility::loadFromYaml(config_yaml, *proto_config);
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  const auto result = factory.createRouteSpecificFilterConfig(
+      *proto_config, context, ProtobufMessage::getNullValidationVisitor());
+  EXPECT_EQ(result.status().message(), "tenant_limit_kbps must be set with tenant_header");
+}
 } // namespace BandwidthLimitFilter
 } // namespace HttpFilters
 } // namespace Extensions
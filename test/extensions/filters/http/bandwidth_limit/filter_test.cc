@@ -630,6 +630,76 @@ TEST_F(FilterTest, WithTrailersNoEndStream) {
   EXPECT_EQ("50", response_trailers_.get_("bandwidth-response-filter-delay-ms"));
 }
 
+// Each tenant is limited by its own bucket and, with the requests without a tenant, by the bucket
+// of the config.
+TEST_F(FilterTest, TenantLimits) {
+  constexpr absl::string_view config_yaml = R"(
+  stat_prefix: test
+  enable_mode: REQUEST_AND_RESPONSE
+  limit_kbps: 3
+  fill_interval: 1s
+  tenant_header: x-tenant
+  tenant_limit_kbps: 1
+  )";
+  setup(std::string(config_yaml));
+
+  std::shared_ptr<TokenBucket> tenant_a =
+      config_->tokenBucket(Http::TestRequestHeaderMapImpl{{"x-tenant", "a"}});
+  std::shared_ptr<TokenBucket> other_tenant_a =
+      config_->tokenBucket(Http::TestRequestHeaderMapImpl{{"x-tenant", "a"}});
+  std::shared_ptr<TokenBucket> tenant_b =
+      config_->tokenBucket(Http::TestRequestHeaderMapImpl{{"x-tenant", "b"}});
+  EXPECT_EQ(config_->tokenBucket(), config_->tokenBucket(request_headers_));
+
+  EXPECT_EQ(1024, tenant_a->consume(2000, true));
+  EXPECT_EQ(0, other_tenant_a->consume(1, true));
+  EXPECT_EQ(1024, tenant_b->consume(2000, true));
+  EXPECT_EQ(1024, config_->tokenBucket(request_headers_)->consume(2000, true));
+  // The shared bucket is exhausted.
+  EXPECT_EQ(0, config_->tokenBucket(Http::TestRequestHeaderMapImpl{{"x-tenant", "c"}})
+                   ->consume(1, true));
+  EXPECT_LT(0, tenant_a->nextTokenAvailable().count());
+
+  time_system_.advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(1024, other_tenant_a->consume(2000, true));
+
+  // A tenant with no stream left starts over.
+  tenant_a.reset();
+  other_tenant_a.reset();
+  EXPECT_EQ(1024, config_->tokenBucket(Http::TestRequestHeaderMapImpl{{"x-tenant", "a"}})
+                      ->consume(2000, true));
+}
+
+// The tenant bucket selected from the request headers also limits the response.
+TEST_F(FilterTest, TenantLimitOnEncode) {
+  constexpr absl::string_view config_yaml = R"(
+  stat_prefix: test
+  enable_mode: RESPONSE
+  limit_kbps: 10
+  tenant_header: x-tenant
+  tenant_limit_kbps: 1
+  )";
+  setup(std::string(config_yaml));
+
+  ON_CALL(encoder_filter_callbacks_, bufferLimit()).WillByDefault(Return(1100));
+  Event::MockTimer* token_timer =
+      new NiceMock<Event::MockTimer>(&encoder_filter_callbacks_.dispatcher_);
+  request_headers_.addCopy("x-tenant", "a");
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, true));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers_, false));
+
+  // One fill interval of the tenant's 1 KiB/s limit, rather than of the 10 KiB/s of the config.
+  Buffer::OwnedImpl data(std::string(100, 'e'));
+  EXPECT_CALL(*token_timer, enableTimer(std::chrono::milliseconds(0), _));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(data, false));
+  EXPECT_CALL(*token_timer, enableTimer(std::chrono::milliseconds(50), _));
+  EXPECT_CALL(encoder_filter_callbacks_,
+              injectEncodedDataToFilterChain(BufferStringEqual(std::string(51, 'e')), false));
+  token_timer->invokeCallback();
+  EXPECT_EQ(1U, findCounter("test.http_bandwidth_limit.response_enforced"));
+  filter_->onDestroy();
+}
+
 } // namespace BandwidthLimitFilter
 } // namespace HttpFilters
 } // namespace Extensions
@@ -20,6 +20,9 @@ TEST(Coverage, CacheEntryStatusString) {
   EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::FailedValidation), "FailedValidation");
   EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::FoundNotModified), "FoundNotModified");
   EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::LookupError), "LookupError");
+  EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::FollowerTimeout), "FollowerTimeout");
+  EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::StaleWhileRevalidate),
+            "StaleWhileRevalidate");
   EXPECT_EQ(cacheEntryStatusString(CacheEntryStatus::UpstreamReset), "UpstreamReset");
   EXPECT_ENVOY_BUG(cacheEntryStatusString(static_cast<CacheEntryStatus>(99)),
                    "Unexpected CacheEntryStatus");
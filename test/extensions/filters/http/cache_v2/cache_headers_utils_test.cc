@@ -172,20 +172,24 @@ TEST(RequestCacheControl, StreamingTest) {
 TEST(ResponseCacheControl, StreamingTest) {
   std::ostringstream os;
   ResponseCacheControl response_cache_control(
-      "no-cache, must-revalidate, no-store, no-transform, max-age=0, public");
+      "no-cache, must-revalidate, no-store, no-transform, max-age=0, public, "
+      "stale-while-revalidate=30");
   os << response_cache_control;
-  EXPECT_EQ(os.str(), "{must_validate, no_store, no_transform, no_stale, public, max-age=0}");
+  EXPECT_EQ(os.str(), "{must_validate, no_store, no_transform, no_stale, public, max-age=0, "
+                      "stale-while-revalidate=30}");
 }
 
 struct TestResponseCacheControl : public ResponseCacheControl {
   TestResponseCacheControl(bool must_validate, bool no_store, bool no_transform, bool no_stale,
-                           bool is_public, OptionalDuration max_age) {
+                           bool is_public, OptionalDuration max_age,
+                           OptionalDuration stale_while_revalidate = absl::nullopt) {
     must_validate_ = must_validate;
     no_store_ = no_store;
     no_transform_ = no_transform;
     no_stale_ = no_stale;
     is_public_ = is_public;
     max_age_ = max_age;
+    stale_while_revalidate_ = stale_while_revalidate;
   }
 };
 
@@ -231,6 +235,18 @@ public:
           // {must_validate_, no_store_, no_transform_, no_stale_, is_public_, max_age_}
           {false, false, false, false, true, Seconds(0)}
         },
+        {
+          "max-age=60, stale-while-revalidate=30",
+          // {must_validate_, no_store_, no_transform_, no_stale_, is_public_, max_age_,
+          //  stale_while_revalidate_}
+          {false, false, false, false, false, Seconds(60), Seconds(30)}
+        },
+        {
+          "max-age=60, stale-while-revalidate=\"30\"",
+          // {must_validate_, no_store_, no_transform_, no_stale_, is_public_, max_age_,
+          //  stale_while_revalidate_}
+          {false, false, false, false, false, Seconds(60), Seconds(30)}
+        },
         // Quoted arguments are interpreted correctly
         {
           "s-maxage=\"20\", max-age=\"10\", public",
@@ -294,6 +310,11 @@ public:
           // {must_validate_, no_store_, no_transform_, no_stale_, is_public_, max_age_}
           {false, false, false, false, false, absl::nullopt}
         },
+        {
+          "max-age=10, stale-while-revalidate=later",
+          // {must_validate_, no_store_, no_transform_, no_stale_, is_public_, max_age_}
+          {false, false, false, false, false, Seconds(10)}
+        },
         // Invalid parts of the header are ignored
         {
           "no-cache, ,,,fjfwioen3298, max-age=20",
@@ -708,6 +729,16 @@ TEST(HasVary, NotEmpty) {
   EXPECT_TRUE(VaryHeaderUtils::hasVary(headers));
 }
 
+TEST(VariesOnlyOnAcceptEncoding, AcceptEncodingAlone) {
+  EXPECT_TRUE(VaryHeaderUtils::variesOnlyOnAcceptEncoding(
+      Http::TestResponseHeaderMapImpl{{"vary", "Accept-Encoding"}}));
+  EXPECT_FALSE(VaryHeaderUtils::variesOnlyOnAcceptEncoding(
+      Http::TestResponseHeaderMapImpl{{"vary", "accept-encoding, origin"}}));
+  EXPECT_FALSE(VaryHeaderUtils::variesOnlyOnAcceptEncoding(
+      Http::TestResponseHeaderMapImpl{{"vary", "accept"}}));
+  EXPECT_FALSE(VaryHeaderUtils::variesOnlyOnAcceptEncoding(Http::TestResponseHeaderMapImpl{}));
+}
+
 TEST(CreateVaryIdentifier, EmptyVaryEntry) {
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   Http::TestRequestHeaderMapImpl request_headers{{"accept", "image/*"}};
@@ -924,6 +955,45 @@ TEST(InjectValidationHeaders, InjectsIfModifiedSince) {
   EXPECT_THAT(request_headers, ContainsHeader("if-modified-since", mod_time));
 }
 
+struct NegotiateContentEncodingTestCase {
+  std::string accept_encoding;
+  std::string expected_content_encoding;
+};
+
+class NegotiateContentEncodingTest
+    : public testing::TestWithParam<NegotiateContentEncodingTestCase> {};
+
+INSTANTIATE_TEST_SUITE_P(NegotiateContentEncodingTest, NegotiateContentEncodingTest,
+                         testing::ValuesIn(std::vector<NegotiateContentEncodingTestCase>{
+                             {"", ""},
+                             {"gzip", "gzip"},
+                             {"GZIP", "gzip"},
+                             {"deflate", ""},
+                             // The first configured coding wins ties.
+                             {"gzip, br", "br"},
+                             {"gzip, br;q=0.5", "gzip"},
+                             {"br;q=0, gzip;q=0.1", "gzip"},
+                             {"gzip; q=0.8, zstd;Q=0.9", "zstd"},
+                             {"*", "br"},
+                             {"br;q=0, *", "zstd"},
+                             {"*;q=0", ""},
+                             {"gzip;q=high", ""},
+                         }));
+
+TEST_P(NegotiateContentEncodingTest, NegotiateContentEncoding) {
+  Http::TestRequestHeaderMapImpl request_headers;
+  if (!GetParam().accept_encoding.empty()) {
+    request_headers.addCopy("accept-encoding", GetParam().accept_encoding);
+  }
+  EXPECT_EQ(CacheHeadersUtils::negotiateContentEncoding(request_headers, {"br", "zstd", "gzip"}),
+            GetParam().expected_content_encoding);
+}
+
+TEST(NegotiateContentEncoding, NoCodingsConfigured) {
+  Http::TestRequestHeaderMapImpl request_headers{{"accept-encoding", "gzip"}};
+  EXPECT_EQ(CacheHeadersUtils::negotiateContentEncoding(request_headers, {}), "");
+}
+
 TEST(ShouldUpdateCachedEntry, ComparesEtags) {
   Http::TestResponseHeaderMapImpl old_headers, new_headers;
   old_headers.setStatus(304);
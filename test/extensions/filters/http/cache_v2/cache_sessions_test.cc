@@ -129,10 +129,14 @@ protected:
         {"host", "test_host"}, {":path", std::string{path}}, {":scheme", "https"}};
   }
 
-  ActiveLookupRequestPtr testLookupRequest(Http::RequestHeaderMap& headers) {
+  ActiveLookupRequestPtr testLookupRequest(
+      Http::RequestHeaderMap& headers,
+      std::chrono::milliseconds max_follower_wait = std::chrono::milliseconds::zero(),
+      const std::vector<std::string>& content_encoding_variants = {}) {
     return std::make_unique<ActiveLookupRequest>(
         headers, mockUpstreamFactory(), "test_cluster", *dispatcher_,
-        api_->timeSource().systemTime(), mock_cacheable_response_checker_, cache_sessions_, false);
+        api_->timeSource().systemTime(), mock_cacheable_response_checker_, cache_sessions_, false,
+        max_follower_wait, content_encoding_variants);
   }
 
   ActiveLookupRequestPtr testLookupRequest(absl::string_view path) {
@@ -151,6 +155,29 @@ protected:
     headers.addCopy("cache-control", "no-cache");
     return testLookupRequest(headers);
   }
+
+  // Completes the latest cache lookup with an entry stored at response_time.
+  void completeCacheLookup(const Http::ResponseHeaderMap& response_headers,
+                           SystemTime response_time) {
+    ResponseMetadata metadata;
+    metadata.response_time_ = response_time;
+    consumeCallback(captured_lookup_callbacks_.back())(LookupResult{
+        std::make_unique<MockCacheReader>(),
+        Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers),
+        nullptr,
+        std::move(metadata),
+        0,
+    });
+    pumpDispatcher();
+  }
+
+  Http::ResponseHeaderMapPtr notModifiedResponseHeaders(absl::string_view etag) {
+    static const DateFormatter formatter{"%a, %d %b %Y %H:%M:%S GMT"};
+    return Http::createHeaderMap<Http::ResponseHeaderMapImpl>(
+        {{Http::Headers::get().Status, "304"},
+         {Http::LowerCaseString("etag"), std::string{etag}},
+         {Http::Headers::get().Date, formatter.fromTime(time_system_.systemTime())}});
+  }
 };
 
 Http::ResponseHeaderMapPtr uncacheableResponseHeaders() {
@@ -415,6 +442,89 @@ TEST_F(CacheSessionsTest, CacheMissWithCacheableResponseProvokesSharedInsertStre
   EXPECT_THAT(end_stream, Eq(EndStream::End));
 }
 
+TEST_F(CacheSessionsTest, ResponseVaryingOnAcceptEncodingIsCachedPerNegotiatedCoding) {
+  const std::vector<std::string> variants{"br", "gzip"};
+  auto headers = requestHeaders("/a");
+  headers.addCopy("accept-encoding", "gzip, deflate");
+  ActiveLookupRequestPtr gzip_lookup =
+      testLookupRequest(headers, std::chrono::milliseconds::zero(), variants);
+  EXPECT_THAT(gzip_lookup->key().content_encoding(), Eq("gzip"));
+  auto identity_headers = requestHeaders("/a");
+  identity_headers.addCopy("accept-encoding", "deflate");
+  ActiveLookupRequestPtr identity_lookup =
+      testLookupRequest(identity_headers, std::chrono::milliseconds::zero(), variants);
+  EXPECT_THAT(identity_lookup->key().content_encoding(), Eq(""));
+  EXPECT_THAT(identity_lookup->requestHeaders(), HasHeader("accept-encoding", "identity"));
+
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasKey(Property("content_encoding",
+                                                              &Key::content_encoding, "gzip")),
+                                        _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _));
+  ActiveLookupResultPtr result;
+  cache_sessions_->lookup(std::move(gzip_lookup),
+                          [&result](ActiveLookupResultPtr r) { result = std::move(r); });
+  pumpDispatcher();
+  consumeCallback(captured_lookup_callbacks_[0])(LookupResult{});
+  pumpDispatcher();
+  // Upstream is only asked for the negotiated coding.
+  ASSERT_THAT(fake_upstreams_.size(), Eq(1));
+  EXPECT_THAT(fake_upstream_sent_headers_[0], Pointee(HasHeader("accept-encoding", "gzip")));
+  auto response_headers = cacheableResponseHeaders();
+  response_headers->addCopy("vary", "accept-encoding");
+  response_headers->addCopy("content-encoding", "gzip");
+  std::shared_ptr<CacheProgressReceiver> progress;
+  EXPECT_CALL(*mock_http_cache_, insert(_, KeyHasPath("/a"), _, _, IsNull(), _))
+      .WillOnce([&](Event::Dispatcher&, Key, Http::ResponseHeaderMapPtr, ResponseMetadata,
+                    HttpSourcePtr,
+                    std::shared_ptr<CacheProgressReceiver> receiver) { progress = receiver; });
+  consumeCallback(fake_upstream_get_headers_callbacks_[0])(
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*response_headers), EndStream::End);
+  pumpDispatcher();
+  ASSERT_THAT(progress, NotNull());
+  progress->onHeadersInserted(std::make_unique<MockCacheReader>(),
+                              Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*response_headers),
+                              true);
+  pumpDispatcher();
+  ASSERT_THAT(result, NotNull());
+  EXPECT_THAT(result->status_, Eq(CacheEntryStatus::Miss));
+}
+
+TEST_F(CacheSessionsTest, FollowerWaitingTooLongGoesUpstreamByItself) {
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(AnyNumber());
+  ActiveLookupResultPtr result1, result2, result3;
+  auto headers = requestHeaders("/a");
+  cache_sessions_->lookup(testLookupRequest(headers, std::chrono::milliseconds(100)),
+                          [&result1](ActiveLookupResultPtr r) { result1 = std::move(r); });
+  cache_sessions_->lookup(testLookupRequest(headers, std::chrono::milliseconds(100)),
+                          [&result2](ActiveLookupResultPtr r) { result2 = std::move(r); });
+  cache_sessions_->lookup(testLookupRequest(headers, std::chrono::milliseconds(200)),
+                          [&result3](ActiveLookupResultPtr r) { result3 = std::move(r); });
+  pumpDispatcher();
+  // Cache miss.
+  consumeCallback(captured_lookup_callbacks_[0])(LookupResult{});
+  pumpDispatcher();
+  ASSERT_THAT(fake_upstreams_.size(), Eq(1));
+  time_system_.advanceTimeAndRun(std::chrono::milliseconds(100), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  pumpDispatcher();
+  // The second request stopped waiting for the response fetched for the first one.
+  EXPECT_THAT(result1, IsNull());
+  ASSERT_THAT(result2, NotNull());
+  EXPECT_THAT(result2->status_, Eq(CacheEntryStatus::FollowerTimeout));
+  ASSERT_THAT(fake_upstreams_.size(), Eq(2));
+  EXPECT_THAT(fake_upstream_sent_headers_[1],
+              Pointee(IsSupersetOfHeaders(Http::TestRequestHeaderMapImpl{{":path", "/a"}})));
+  EXPECT_THAT(result3, IsNull());
+  // The first request never times out this way.
+  time_system_.advanceTimeAndRun(std::chrono::milliseconds(1000), *dispatcher_,
+                                 Event::Dispatcher::RunType::NonBlock);
+  pumpDispatcher();
+  EXPECT_THAT(result1, IsNull());
+  ASSERT_THAT(result3, NotNull());
+  EXPECT_THAT(result3->status_, Eq(CacheEntryStatus::FollowerTimeout));
+}
+
 TEST_F(CacheSessionsTest,
        CacheMissWithCacheableResponseProvokesSharedInsertStreamWithBodyAndTrailers) {
   EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
@@ -581,6 +691,130 @@ TEST_F(CacheSessionsTest, CacheHitGoesDirectlyToCachedResponses) {
   pumpDispatcher();
 }
 
+Http::ResponseHeaderMapPtr staleWhileRevalidateResponseHeaders() {
+  auto h = cacheableResponseHeaders();
+  h->setCopy(Http::LowerCaseString("cache-control"), "max-age=1, stale-while-revalidate=60");
+  h->addCopy("etag", "\"v1\"");
+  return h;
+}
+
+TEST_F(CacheSessionsTest, StaleWhileRevalidateServesStaleEntryAndValidatesInTheBackground) {
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(4);
+  auto response_headers = staleWhileRevalidateResponseHeaders();
+  ActiveLookupResultPtr result1, result2, result3, result4;
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result1](ActiveLookupResultPtr r) { result1 = std::move(r); });
+  pumpDispatcher();
+  completeCacheLookup(*response_headers, api_->timeSource().systemTime());
+  ASSERT_THAT(result1, NotNull());
+  EXPECT_THAT(result1->status_, Eq(CacheEntryStatus::Hit));
+  // Stale, but within the stale-while-revalidate window.
+  advanceTime(std::chrono::seconds(10));
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result2](ActiveLookupResultPtr r) { result2 = std::move(r); });
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result3](ActiveLookupResultPtr r) { result3 = std::move(r); });
+  pumpDispatcher();
+  // Both requests are served the stale entry without waiting for the single validation.
+  ASSERT_THAT(result2, NotNull());
+  EXPECT_THAT(result2->status_, Eq(CacheEntryStatus::StaleWhileRevalidate));
+  ASSERT_THAT(result3, NotNull());
+  EXPECT_THAT(result3->status_, Eq(CacheEntryStatus::StaleWhileRevalidate));
+  ASSERT_THAT(fake_upstreams_.size(), Eq(1));
+  EXPECT_THAT(fake_upstream_sent_headers_[0],
+              Pointee(IsSupersetOfHeaders(
+                  Http::TestRequestHeaderMapImpl{{":path", "/a"}, {"if-none-match", "\"v1\""}})));
+  EXPECT_CALL(*mock_http_cache_, updateHeaders(_, KeyHasPath("/a"), _, _));
+  consumeCallback(fake_upstream_get_headers_callbacks_[0])(notModifiedResponseHeaders("\"v1\""),
+                                                           EndStream::End);
+  pumpDispatcher();
+  // The validated entry is fresh again.
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result4](ActiveLookupResultPtr r) { result4 = std::move(r); });
+  pumpDispatcher();
+  ASSERT_THAT(result4, NotNull());
+  EXPECT_THAT(result4->status_, Eq(CacheEntryStatus::Hit));
+  EXPECT_THAT(fake_upstreams_.size(), Eq(1));
+}
+
+TEST_F(CacheSessionsTest, StaleWhileRevalidateAppliesToEntriesLookedUpStale) {
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(2);
+  auto response_headers = staleWhileRevalidateResponseHeaders();
+  ActiveLookupResultPtr result1, result2;
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result1](ActiveLookupResultPtr r) { result1 = std::move(r); });
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result2](ActiveLookupResultPtr r) { result2 = std::move(r); });
+  pumpDispatcher();
+  const SystemTime response_time = api_->timeSource().systemTime();
+  advanceTime(std::chrono::seconds(10));
+  completeCacheLookup(*response_headers, response_time);
+  ASSERT_THAT(result1, NotNull());
+  EXPECT_THAT(result1->status_, Eq(CacheEntryStatus::StaleWhileRevalidate));
+  ASSERT_THAT(result2, NotNull());
+  EXPECT_THAT(result2->status_, Eq(CacheEntryStatus::StaleWhileRevalidate));
+  EXPECT_THAT(fake_upstreams_.size(), Eq(1));
+}
+
+TEST_F(CacheSessionsTest, FailedBackgroundValidationMakesNextRequestValidateFirst) {
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(3);
+  auto response_headers = staleWhileRevalidateResponseHeaders();
+  ActiveLookupResultPtr result1, result2, result3;
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result1](ActiveLookupResultPtr r) { result1 = std::move(r); });
+  pumpDispatcher();
+  completeCacheLookup(*response_headers, api_->timeSource().systemTime());
+  advanceTime(std::chrono::seconds(10));
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result2](ActiveLookupResultPtr r) { result2 = std::move(r); });
+  pumpDispatcher();
+  ASSERT_THAT(result2, NotNull());
+  EXPECT_THAT(result2->status_, Eq(CacheEntryStatus::StaleWhileRevalidate));
+  ASSERT_THAT(fake_upstreams_.size(), Eq(1));
+  // The resource changed upstream.
+  consumeCallback(fake_upstream_get_headers_callbacks_[0])(cacheableResponseHeaders(),
+                                                           EndStream::End);
+  pumpDispatcher();
+  // The next request waits for the entry to be validated again.
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result3](ActiveLookupResultPtr r) { result3 = std::move(r); });
+  pumpDispatcher();
+  EXPECT_THAT(result3, IsNull());
+  ASSERT_THAT(fake_upstreams_.size(), Eq(2));
+  EXPECT_CALL(*mock_http_cache_, updateHeaders(_, KeyHasPath("/a"), _, _));
+  consumeCallback(fake_upstream_get_headers_callbacks_[1])(notModifiedResponseHeaders("\"v1\""),
+                                                           EndStream::End);
+  pumpDispatcher();
+  ASSERT_THAT(result3, NotNull());
+  EXPECT_THAT(result3->status_, Eq(CacheEntryStatus::Validated));
+}
+
+TEST_F(CacheSessionsTest, EntryStaleBeyondStaleWhileRevalidateIsValidatedBeforeServing) {
+  EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
+  EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(2);
+  auto response_headers = staleWhileRevalidateResponseHeaders();
+  ActiveLookupResultPtr result1, result2;
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result1](ActiveLookupResultPtr r) { result1 = std::move(r); });
+  pumpDispatcher();
+  completeCacheLookup(*response_headers, api_->timeSource().systemTime());
+  advanceTime(std::chrono::seconds(100));
+  cache_sessions_->lookup(testLookupRequest("/a"),
+                          [&result2](ActiveLookupResultPtr r) { result2 = std::move(r); });
+  pumpDispatcher();
+  EXPECT_THAT(result2, IsNull());
+  ASSERT_THAT(fake_upstreams_.size(), Eq(1));
+  EXPECT_CALL(*mock_http_cache_, updateHeaders(_, KeyHasPath("/a"), _, _));
+  consumeCallback(fake_upstream_get_headers_callbacks_[0])(notModifiedResponseHeaders("\"v1\""),
+                                                           EndStream::End);
+  pumpDispatcher();
+  ASSERT_THAT(result2, NotNull());
+  EXPECT_THAT(result2->status_, Eq(CacheEntryStatus::Validated));
+}
+
 TEST_F(CacheSessionsTest, CacheInsertFailurePassesThroughLookupsAndWillLookupAgain) {
   EXPECT_CALL(*mock_http_cache_, lookup(LookupHasPath("/a"), _));
   EXPECT_CALL(*mock_http_cache_, touch(KeyHasPath("/a"), _)).Times(2);
@@ -87,6 +87,16 @@ TEST_F(CacheStatsTest, StatsAreConstructedCorrectly) {
       "cache.event.cache_label.fake_cache.event_type.lookup_error");
   EXPECT_THAT(lookup_errors, OptCounterIs("cache.event", 1));
 
+  stats_->incForStatus(CacheEntryStatus::FollowerTimeout);
+  Stats::CounterOptConstRef follower_timeouts = context_.store_.findCounterByString(
+      "cache.event.cache_label.fake_cache.event_type.follower_timeout");
+  EXPECT_THAT(follower_timeouts, OptCounterIs("cache.event", 1));
+
+  stats_->incForStatus(CacheEntryStatus::StaleWhileRevalidate);
+  Stats::CounterOptConstRef stale_while_revalidates = context_.store_.findCounterByString(
+      "cache.event.cache_label.fake_cache.event_type.stale_while_revalidate");
+  EXPECT_THAT(stale_while_revalidates, OptCounterIs("cache.event", 1));
+
   stats_->incCacheSessionsEntries();
   stats_->incCacheSessionsEntries();
   stats_->incCacheSessionsEntries();
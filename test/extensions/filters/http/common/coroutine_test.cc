@@ -0,0 +1,129 @@
+#include <chrono>
+
+#include "source/common/http/message_impl.h"
+#include "source/extensions/filters/http/common/coroutine.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/http/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Common {
+namespace {
+
+using testing::_;
+using testing::Invoke;
+
+FilterTask sleepTwice(Event::Dispatcher& dispatcher, int& steps, bool& suspended) {
+  co_await Sleep(dispatcher, std::chrono::milliseconds(0));
+  ++steps;
+  co_await Sleep(dispatcher, std::chrono::milliseconds(100));
+  ++steps;
+  suspended = co_await FilterTask::hasSuspended();
+}
+
+// A task runs until it awaits an operation which has not completed, and is resumed by it.
+TEST(FilterTaskTest, ResumedByTimer) {
+  testing::NiceMock<Event::MockDispatcher> dispatcher;
+  auto* timer = new Event::MockTimer(&dispatcher);
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(100), _));
+  int steps = 0;
+  bool suspended = false;
+
+  FilterTask task = sleepTwice(dispatcher, steps, suspended);
+  EXPECT_FALSE(task.done());
+  EXPECT_EQ(1, steps);
+
+  timer->invokeCallback();
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(2, steps);
+  EXPECT_TRUE(suspended);
+}
+
+FilterTask sleepNoTime(Event::Dispatcher& dispatcher, bool& suspended) {
+  co_await Sleep(dispatcher, std::chrono::milliseconds(0));
+  suspended = co_await FilterTask::hasSuspended();
+}
+
+TEST(FilterTaskTest, CompletesInline) {
+  testing::NiceMock<Event::MockDispatcher> dispatcher;
+  bool suspended = true;
+  FilterTask task = sleepNoTime(dispatcher, suspended);
+  EXPECT_TRUE(task.done());
+  EXPECT_FALSE(suspended);
+  EXPECT_TRUE(FilterTask().done());
+}
+
+FilterTask send(Http::AsyncClient& client, AsyncRequest::Result& result) {
+  result = co_await AsyncRequest(client, std::make_unique<Http::RequestMessageImpl>(),
+                                 Http::AsyncClient::RequestOptions());
+}
+
+TEST(FilterTaskTest, AsyncRequest) {
+  Http::MockAsyncClient client;
+  Http::MockAsyncClientRequest request(&client);
+  Http::AsyncClient::Callbacks* callbacks = nullptr;
+  EXPECT_CALL(client, send_(_, _, _))
+      .WillOnce(Invoke([&](Http::RequestMessagePtr&, Http::AsyncClient::Callbacks& cb,
+                           const Http::AsyncClient::RequestOptions&) {
+        callbacks = &cb;
+        return &request;
+      }));
+  AsyncRequest::Result result;
+
+  FilterTask task = send(client, result);
+  ASSERT_NE(nullptr, callbacks);
+  EXPECT_FALSE(task.done());
+
+  Http::ResponseMessagePtr response(new Http::ResponseMessageImpl(
+      Http::ResponseHeaderMapPtr{new Http::TestResponseHeaderMapImpl{{":status", "200"}}}));
+  callbacks->onSuccess(request, std::move(response));
+  EXPECT_TRUE(task.done());
+  ASSERT_NE(nullptr, result.response_);
+  EXPECT_EQ("200", result.response_->headers().getStatusValue());
+  EXPECT_CALL(client, onRequestDestroy());
+}
+
+TEST(FilterTaskTest, AsyncRequestFailedInline) {
+  Http::MockAsyncClient client;
+  Http::MockAsyncClientRequest request(&client);
+  EXPECT_CALL(client, send_(_, _, _))
+      .WillOnce(Invoke([&](Http::RequestMessagePtr&, Http::AsyncClient::Callbacks& callbacks,
+                           const Http::AsyncClient::RequestOptions&)
+                           -> Http::AsyncClient::Request* {
+        callbacks.onFailure(request, Http::AsyncClient::FailureReason::ExceedResponseBufferLimit);
+        return nullptr;
+      }));
+  AsyncRequest::Result result;
+
+  FilterTask task = send(client, result);
+  EXPECT_TRUE(task.done());
+  EXPECT_EQ(nullptr, result.response_);
+  EXPECT_EQ(Http::AsyncClient::FailureReason::ExceedResponseBufferLimit, result.failure_reason_);
+  EXPECT_CALL(client, onRequestDestroy());
+}
+
+// Destroying a suspended task cancels the operation it awaits.
+TEST(FilterTaskTest, DestroyCancelsRequest) {
+  Http::MockAsyncClient client;
+  Http::MockAsyncClientRequest request(&client);
+  EXPECT_CALL(client, send_(_, _, _)).WillOnce(testing::Return(&request));
+  AsyncRequest::Result result;
+
+  FilterTask task = send(client, result);
+  EXPECT_CALL(request, cancel());
+  task.reset();
+  EXPECT_TRUE(task.done());
+  EXPECT_CALL(client, onRequestDestroy());
+}
+
+} // namespace
+} // namespace Common
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,130 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/http/compressor/compression_thread_pool.h"
+
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Compressor {
+namespace {
+
+// Appends "." to flushed chunks and "!" to finished ones.
+class TestCompressor : public Envoy::Compression::Compressor::Compressor {
+public:
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override {
+    buffer.add(state == Envoy::Compression::Compressor::State::Finish ? "!" : ".");
+    compress_calls_++;
+  }
+
+  std::atomic<uint32_t> compress_calls_{0};
+};
+
+// Blocks the thread compressing a chunk until released.
+class BlockingCompressor : public TestCompressor {
+public:
+  void compress(Buffer::Instance& buffer, Envoy::Compression::Compressor::State state) override {
+    started_.Notify();
+    released_.WaitForNotification();
+    TestCompressor::compress(buffer, state);
+  }
+
+  absl::Notification started_;
+  absl::Notification released_;
+};
+
+class CompressionThreadPoolTest : public testing::Test {
+protected:
+  CompressionThreadPool::HandlePtr compress(Envoy::Compression::Compressor::Compressor& compressor,
+                                            absl::string_view data, bool end_stream) {
+    Buffer::OwnedImpl buffer(data);
+    CompressionThreadPool::HandlePtr handle = pool_->compress(
+        compressor, buffer, end_stream, *dispatcher_,
+        [this](Buffer::Instance& compressed, bool end) {
+          compressed_.push_back(absl::StrCat(compressed.toString(), end ? "|end" : ""));
+          if (compressed_.size() == expected_compressed_) {
+            dispatcher_->exit();
+          }
+        });
+    EXPECT_EQ(handle == nullptr ? data.size() : 0, buffer.length());
+    return handle;
+  }
+
+  void waitForCompressed(size_t count) {
+    expected_compressed_ = count;
+    if (compressed_.size() < count) {
+      dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit);
+    }
+  }
+
+  Api::ApiPtr api_{Api::createApiForTest()};
+  Event::DispatcherPtr dispatcher_{api_->allocateDispatcher("test_thread")};
+  CompressionThreadPoolPtr pool_{
+      std::make_unique<CompressionThreadPool>(api_->threadFactory(), 1, 1)};
+  std::vector<std::string> compressed_;
+  size_t expected_compressed_{};
+};
+
+TEST_F(CompressionThreadPoolTest, CallsBackOnDispatcherInOrder) {
+  TestCompressor compressor;
+  CompressionThreadPool::HandlePtr first = compress(compressor, "a", false);
+  ASSERT_NE(nullptr, first);
+  waitForCompressed(1);
+  CompressionThreadPool::HandlePtr second = compress(compressor, "b", true);
+  ASSERT_NE(nullptr, second);
+  waitForCompressed(2);
+  EXPECT_EQ((std::vector<std::string>{"a.", "b!|end"}), compressed_);
+}
+
+TEST_F(CompressionThreadPoolTest, LeavesDataAsIsIfQueueIsFull) {
+  BlockingCompressor blocking_compressor;
+  TestCompressor compressor;
+  CompressionThreadPool::HandlePtr compressing = compress(blocking_compressor, "a", false);
+  blocking_compressor.started_.WaitForNotification();
+  CompressionThreadPool::HandlePtr queued = compress(compressor, "b", false);
+  ASSERT_NE(nullptr, queued);
+  EXPECT_EQ(nullptr, compress(compressor, "c", false));
+
+  blocking_compressor.released_.Notify();
+  waitForCompressed(2);
+  EXPECT_EQ((std::vector<std::string>{"a.", "b."}), compressed_);
+}
+
+TEST_F(CompressionThreadPoolTest, DestroyingHandleCancelsQueuedChunk) {
+  BlockingCompressor blocking_compressor;
+  TestCompressor compressor;
+  CompressionThreadPool::HandlePtr compressing = compress(blocking_compressor, "a", false);
+  blocking_compressor.started_.WaitForNotification();
+  compress(compressor, "b", false).reset();
+
+  blocking_compressor.released_.Notify();
+  waitForCompressed(1);
+  // Waits for the threads to be done with the queue.
+  pool_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(0, compressor.compress_calls_.load());
+  EXPECT_EQ((std::vector<std::string>{"a."}), compressed_);
+}
+
+TEST_F(CompressionThreadPoolTest, DestroyedHandleIsNotCalledBack) {
+  TestCompressor compressor;
+  CompressionThreadPool::HandlePtr handle = compress(compressor, "a", false);
+  // Waits for the threads to be done with the queue, the chunk being compressed or cancelled.
+  pool_.reset();
+  handle.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_TRUE(compressed_.empty());
+}
+
+} // namespace
+} // namespace Compressor
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
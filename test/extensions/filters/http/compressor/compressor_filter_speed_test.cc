@@ -11,6 +11,7 @@
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 
 #include "benchmark/benchmark.h"
 #include "gmock/gmock.h"
@@ -432,6 +433,28 @@ BENCHMARK(compressChunks1024WithGzip)
     ->UseManualTime()
     ->Unit(benchmark::kMillisecond);
 
+// Compresses small responses each with a new compressor, with the zlib streams pooled or not, to
+// measure the cost of the zlib initialization.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void compressSmallResponsesWithGzip(benchmark::State& state) {
+  const bool pooled = state.range(0) != 0;
+  envoy::extensions::compression::gzip::compressor::v3::Gzip gzip;
+  if (pooled) {
+    gzip.mutable_max_pooled_streams_per_worker()->set_value(1);
+  }
+  testing::NiceMock<ThreadLocal::MockInstance> tls;
+  Compression::Gzip::Compressor::GzipCompressorFactory factory(gzip, tls);
+  const std::string data = testData().toString().substr(0, 1024);
+
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Buffer::OwnedImpl buffer(data);
+    Envoy::Compression::Compressor::CompressorPtr compressor = factory.createCompressor();
+    compressor->compress(buffer, Envoy::Compression::Compressor::State::Finish);
+  }
+}
+BENCHMARK(compressSmallResponsesWithGzip)->Arg(0)->Arg(1);
+
 static constexpr CompressionParams zstd_compression_params[] = {
     // level1 + default
     {1, 0, 0, 0},
@@ -11,9 +11,11 @@
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
 #include "gtest/gtest.h"
 
 namespace Envoy {
@@ -2418,6 +2420,134 @@ TEST_F(CompressorPerRouteLibraryTest, GetCompressorFactoryUsesPerRoute) {
   EXPECT_EQ(per_route_factory.contentEncoding(), "test");
 }
 
+// Compresses the response data chunks of at least 100 bytes in a thread pool.
+class CompressorFilterOffloadTest : public CompressorFilterTest {
+protected:
+  void SetUp() override {
+    ON_CALL(encoder_callbacks_.dispatcher_, post(_)).WillByDefault([this](Event::PostCb cb) {
+      absl::MutexLock lock(mu_);
+      posted_.push_back(std::move(cb));
+    });
+    envoy::extensions::filters::http::compressor::v3::Compressor compressor;
+    TestUtility::loadFromJson(R"EOF(
+{
+  "response_direction_config": {
+    "compression_offload": {
+      "min_chunk_size": 100
+    }
+  },
+  "compressor_library": {
+     "name": "test",
+     "typed_config": {
+       "@type": "type.googleapis.com/envoy.extensions.compression.gzip.compressor.v3.Gzip"
+     }
+  }
+}
+)EOF",
+                              compressor);
+    auto compressor_factory = std::make_unique<TestCompressorFactory>("test");
+    compressor_factory_ = compressor_factory.get();
+    config_ = std::make_shared<CompressorFilterConfig>(
+        compressor, "test.", *stats_.rootScope(), runtime_, std::move(compressor_factory),
+        std::make_unique<CompressionThreadPool>(Thread::threadFactoryForTest(), 1, 16));
+    filter_ = std::make_unique<CompressorFilter>(config_);
+    filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+    response_stats_prefix_ = "response.";
+  }
+
+  void encodeHeaders() {
+    Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"accept-encoding", "test"}};
+    filter_->decodeHeaders(request_headers, true);
+    Http::TestResponseHeaderMapImpl response_headers{
+        {":status", "200"}, {"content-length", "200"}, {"content-type", "text/plain"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->encodeHeaders(response_headers, false));
+    EXPECT_EQ("test", response_headers.get_("content-encoding"));
+  }
+
+  // Waits for the thread pool to post a callback, and runs it.
+  void runPostedCallback() {
+    Event::PostCb cb;
+    {
+      absl::MutexLock lock(mu_);
+      const auto posted = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) { return !posted_.empty(); };
+      mu_.Await(absl::Condition(&posted));
+      cb = std::move(posted_.front());
+      posted_.erase(posted_.begin());
+    }
+    cb();
+  }
+
+  uint64_t responseCounter(absl::string_view name) {
+    return stats_.counter(absl::StrCat("test.compressor.test.test.response.", name)).value();
+  }
+
+  absl::Mutex mu_;
+  std::vector<Event::PostCb> posted_ ABSL_GUARDED_BY(mu_);
+};
+
+TEST_F(CompressorFilterOffloadTest, CompressesLargeChunksInThreadPool) {
+  compressor_factory_->setExpectedCompressCalls(2);
+  encodeHeaders();
+  Buffer::OwnedImpl small_chunk(std::string(50, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_->encodeData(small_chunk, false));
+  EXPECT_EQ(50, small_chunk.length());
+
+  Buffer::OwnedImpl large_chunk(std::string(150, 'b'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(large_chunk, true));
+  EXPECT_EQ(0, large_chunk.length());
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, true))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(std::string(150, 'b'), data.toString());
+      }));
+  runPostedCallback();
+  EXPECT_EQ(1, responseCounter("offloaded_chunks"));
+  EXPECT_EQ(200, responseCounter("total_uncompressed_bytes"));
+  EXPECT_EQ(200, responseCounter("total_compressed_bytes"));
+}
+
+TEST_F(CompressorFilterOffloadTest, KeepsOrderOfDataAndTrailersBehindOffloadedChunk) {
+  compressor_factory_->setExpectedCompressCalls(3);
+  encodeHeaders();
+  ON_CALL(encoder_callbacks_, bufferLimit()).WillByDefault(Return(40));
+  Buffer::OwnedImpl large_chunk(std::string(150, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(large_chunk, false));
+  Buffer::OwnedImpl small_chunk(std::string(50, 'b'));
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterAboveWriteBufferHighWatermark());
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(small_chunk, false));
+  Http::TestResponseTrailerMapImpl trailers;
+  EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_->encodeTrailers(trailers));
+
+  testing::InSequence s;
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(std::string(150, 'a'), data.toString());
+      }));
+  EXPECT_CALL(encoder_callbacks_, onEncoderFilterBelowWriteBufferLowWatermark());
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false))
+      .WillOnce(Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(std::string(50, 'b'), data.toString());
+      }));
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, false));
+  EXPECT_CALL(encoder_callbacks_, continueEncoding());
+  runPostedCallback();
+}
+
+TEST_F(CompressorFilterOffloadTest, DestroyedFilterIsNotCalledBack) {
+  encodeHeaders();
+  Buffer::OwnedImpl large_chunk(std::string(150, 'a'));
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_->encodeData(large_chunk, true));
+  EXPECT_CALL(encoder_callbacks_, injectEncodedDataToFilterChain(_, _)).Times(0);
+  {
+    // Waits for the chunk to be compressed.
+    absl::MutexLock lock(mu_);
+    const auto posted = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) { return !posted_.empty(); };
+    mu_.Await(absl::Condition(&posted));
+  }
+  filter_->onDestroy();
+  runPostedCallback();
+}
+
 } // namespace
 } // namespace Compressor
 } // namespace HttpFilters
@@ -181,6 +181,8 @@ TEST_F(CorsFilterTest, RequestWithOrigin) {
   Http::TestRequestHeaderMapImpl request_headers{{":method", "get"}, {"origin", "localhost"}};
 
   EXPECT_CALL(decoder_callbacks_, encodeHeaders_(_, false)).Times(0);
+  EXPECT_CALL(decoder_callbacks_, skipDecodingBodyAndTrailers());
+  EXPECT_CALL(encoder_callbacks_, skipEncodingBodyAndTrailers());
   EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
   EXPECT_EQ(true, isCorsRequest());
   EXPECT_EQ(0, stats_.counter("test.cors.origin_invalid").value());
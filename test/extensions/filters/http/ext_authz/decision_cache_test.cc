@@ -0,0 +1,129 @@
+#include <chrono>
+#include <string>
+
+#include "envoy/extensions/filters/http/ext_authz/v3/ext_authz.pb.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/ext_authz/decision_cache.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExtAuthz {
+namespace {
+
+using Filters::Common::ExtAuthz::CheckStatus;
+using Filters::Common::ExtAuthz::Response;
+
+DecisionCacheConfig makeConfig(const std::string& yaml) {
+  envoy::extensions::filters::http::ext_authz::v3::DecisionCache proto_config;
+  TestUtility::loadFromYaml(yaml, proto_config);
+  return DecisionCacheConfig(proto_config);
+}
+
+Response makeResponse(CheckStatus status) {
+  Response response{};
+  response.status = status;
+  return response;
+}
+
+TEST(DecisionCacheConfigTest, Key) {
+  const DecisionCacheConfig config = makeConfig(R"EOF(
+  key_headers: ["x-api-key", "x-tenant"]
+  )EOF");
+  EXPECT_EQ(config.maxEntries(), 10000);
+
+  Http::TestRequestHeaderMapImpl headers{{"x-api-key", "key"}, {"x-tenant", "tenant"}};
+  const absl::optional<std::string> key = config.key(headers, "route");
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(config.key(headers, "route"), key);
+  EXPECT_NE(config.key(headers, "other_route"), key);
+
+  // The values are length prefixed, so moving characters between headers changes the key.
+  Http::TestRequestHeaderMapImpl shifted_headers{{"x-api-key", "keyt"}, {"x-tenant", "enant"}};
+  EXPECT_NE(config.key(shifted_headers, "route"), key);
+
+  // The requests missing a key header are not cached.
+  Http::TestRequestHeaderMapImpl partial_headers{{"x-api-key", "key"}};
+  EXPECT_FALSE(config.key(partial_headers, "route").has_value());
+}
+
+TEST(DecisionCacheConfigTest, Ttl) {
+  const DecisionCacheConfig config = makeConfig(R"EOF(
+  key_headers: ["x-api-key"]
+  allowed_ttl: 10s
+  denied_ttl: 2s
+  ttl_metadata_key: ttl
+  )EOF");
+
+  EXPECT_EQ(config.ttl(makeResponse(CheckStatus::OK)), std::chrono::seconds(10));
+  EXPECT_EQ(config.ttl(makeResponse(CheckStatus::Denied)), std::chrono::seconds(2));
+  EXPECT_EQ(config.ttl(makeResponse(CheckStatus::Error)), std::chrono::milliseconds(0));
+
+  Response invalid_response = makeResponse(CheckStatus::OK);
+  invalid_response.saw_invalid_append_actions = true;
+  EXPECT_EQ(config.ttl(invalid_response), std::chrono::milliseconds(0));
+
+  // The TTL of the authorization server overrides the configured one.
+  Response response = makeResponse(CheckStatus::OK);
+  (*response.dynamic_metadata.mutable_fields())["ttl"] = ValueUtil::numberValue(1.5);
+  EXPECT_EQ(config.ttl(response), std::chrono::milliseconds(1500));
+  (*response.dynamic_metadata.mutable_fields())["ttl"] = ValueUtil::numberValue(0);
+  EXPECT_EQ(config.ttl(response), std::chrono::milliseconds(0));
+  (*response.dynamic_metadata.mutable_fields())["ttl"] = ValueUtil::stringValue("5");
+  EXPECT_EQ(config.ttl(response), std::chrono::seconds(10));
+}
+
+TEST(DecisionCacheConfigTest, DeniedNotCachedByDefault) {
+  const DecisionCacheConfig config = makeConfig(R"EOF(
+  key_headers: ["x-api-key"]
+  )EOF");
+  EXPECT_EQ(config.ttl(makeResponse(CheckStatus::OK)), std::chrono::seconds(60));
+  EXPECT_EQ(config.ttl(makeResponse(CheckStatus::Denied)), std::chrono::milliseconds(0));
+}
+
+TEST(DecisionCacheTest, Expiry) {
+  DecisionCache cache(10);
+  const MonotonicTime now;
+  EXPECT_EQ(cache.lookup("a", now), nullptr);
+
+  EXPECT_FALSE(cache.insert("a", makeResponse(CheckStatus::Denied), now + std::chrono::seconds(1)));
+  const Response* response = cache.lookup("a", now);
+  ASSERT_NE(response, nullptr);
+  EXPECT_EQ(response->status, CheckStatus::Denied);
+
+  // Replacing a decision does not evict it.
+  EXPECT_FALSE(cache.insert("a", makeResponse(CheckStatus::OK), now + std::chrono::seconds(1)));
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.lookup("a", now)->status, CheckStatus::OK);
+
+  // Expired decisions are removed.
+  EXPECT_EQ(cache.lookup("a", now + std::chrono::seconds(1)), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(DecisionCacheTest, EvictsLeastRecentlyUsed) {
+  DecisionCache cache(2);
+  const MonotonicTime now;
+  const MonotonicTime expiry = now + std::chrono::seconds(1);
+  EXPECT_FALSE(cache.insert("a", makeResponse(CheckStatus::OK), expiry));
+  EXPECT_FALSE(cache.insert("b", makeResponse(CheckStatus::OK), expiry));
+
+  // Looking up "a" makes "b" the least recently used decision.
+  EXPECT_NE(cache.lookup("a", now), nullptr);
+  EXPECT_TRUE(cache.insert("c", makeResponse(CheckStatus::OK), expiry));
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_NE(cache.lookup("a", now), nullptr);
+  EXPECT_EQ(cache.lookup("b", now), nullptr);
+  EXPECT_NE(cache.lookup("c", now), nullptr);
+}
+
+} // namespace
+} // namespace ExtAuthz
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -6522,6 +6522,107 @@ TEST_F(HttpFilterTest, MultipleSetCookieHeadersOnSuccess) {
   EXPECT_EQ(1U, config_->stats().ok_.value());
 }
 
+class DecisionCacheFilterTest : public HttpFilterTest {
+public:
+  void initializeWithDecisionCache() {
+    initialize(R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: "ext_authz_server"
+    decision_cache:
+      key_headers: ["x-api-key"]
+      denied_ttl: 10s
+    )EOF");
+    request_headers_.addCopy("x-api-key", "key");
+    prepareCheck();
+  }
+
+  // Starts another request of the same config.
+  void resetFilter() {
+    client_ = new NiceMock<Filters::Common::ExtAuthz::MockClient>();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::ExtAuthz::ClientPtr{client_},
+                                       factory_context_);
+    filter_->setDecoderFilterCallbacks(decoder_filter_callbacks_);
+    filter_->setEncoderFilterCallbacks(encoder_filter_callbacks_);
+  }
+
+  void expectCheckResponse(const Filters::Common::ExtAuthz::Response& response) {
+    EXPECT_CALL(*client_, check(_, _, _, _))
+        .WillOnce(Invoke([response](Filters::Common::ExtAuthz::RequestCallbacks& callbacks,
+                                    const envoy::service::auth::v3::CheckRequest&, Tracing::Span&,
+                                    const StreamInfo::StreamInfo&) -> void {
+          callbacks.onComplete(std::make_unique<Filters::Common::ExtAuthz::Response>(response));
+        }));
+  }
+};
+
+// Test that the requests of the same key use the cached decision of the first one.
+TEST_F(DecisionCacheFilterTest, CachedAllowedDecision) {
+  initializeWithDecisionCache();
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::OK;
+  response.headers_to_set = {{"x-user", "user"}};
+  expectCheckResponse(response);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, true));
+  EXPECT_EQ(1U, config_->stats().decision_cache_misses_.value());
+
+  resetFilter();
+  Http::TestRequestHeaderMapImpl request_headers{{"x-api-key", "key"}};
+  EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  EXPECT_EQ(request_headers.get_("x-user"), "user");
+  EXPECT_EQ(1U, config_->stats().decision_cache_hits_.value());
+  EXPECT_EQ(2U, config_->stats().ok_.value());
+
+  // Another key is checked by the authorization server.
+  resetFilter();
+  Http::TestRequestHeaderMapImpl other_request_headers{{"x-api-key", "other"}};
+  expectCheckResponse(response);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue,
+            filter_->decodeHeaders(other_request_headers, true));
+  EXPECT_EQ(2U, config_->stats().decision_cache_misses_.value());
+}
+
+// Test that a cached denial is replied to without calling the authorization server.
+TEST_F(DecisionCacheFilterTest, CachedDeniedDecision) {
+  initializeWithDecisionCache();
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::Denied;
+  response.status_code = Http::Code::Forbidden;
+  expectCheckResponse(response);
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, true));
+
+  resetFilter();
+  EXPECT_CALL(*client_, check(_, _, _, _)).Times(0);
+  EXPECT_CALL(decoder_filter_callbacks_, encodeHeaders_(_, _))
+      .WillOnce(Invoke([&](const Http::ResponseHeaderMap& headers, bool) {
+        EXPECT_EQ(headers.getStatusValue(), "403");
+      }));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopAllIterationAndWatermark,
+            filter_->decodeHeaders(request_headers_, true));
+  EXPECT_EQ(1U, config_->stats().decision_cache_hits_.value());
+  EXPECT_EQ(2U, config_->stats().denied_.value());
+}
+
+// Test that the errors of the authorization server are not cached.
+TEST_F(DecisionCacheFilterTest, ErrorNotCached) {
+  initializeWithDecisionCache();
+
+  Filters::Common::ExtAuthz::Response response{};
+  response.status = Filters::Common::ExtAuthz::CheckStatus::Error;
+  expectCheckResponse(response);
+  filter_->decodeHeaders(request_headers_, true);
+
+  resetFilter();
+  expectCheckResponse(response);
+  filter_->decodeHeaders(request_headers_, true);
+  EXPECT_EQ(0U, config_->stats().decision_cache_hits_.value());
+  EXPECT_EQ(2U, config_->stats().decision_cache_misses_.value());
+}
+
 } // namespace
 } // namespace ExtAuthz
 } // namespace HttpFilters
@@ -190,6 +190,34 @@ TEST_F(BenchmarkTest, AddRequestHeaderAndClose) {
   measureHttpGets("add-request-header-close");
 }
 
+// Add a request header over a gRPC stream shared by all the requests, to compare the overhead per
+// request with the stream per request of AddRequestHeaderAndClose.
+TEST_F(BenchmarkTest, AddRequestHeaderMultiplexed) {
+  proto_config_.mutable_processing_mode()->set_response_header_mode(ProcessingMode::SKIP);
+  proto_config_.mutable_grpc_stream_multiplexing();
+  test_processor_.start(
+      ipVersion(), [](grpc::ServerReaderWriter<ProcessingResponse, ProcessingRequest>* stream) {
+        ProcessingRequest header_req;
+        while (stream->Read(&header_req)) {
+          ASSERT_TRUE(header_req.has_request_headers());
+          ProcessingResponse header_resp;
+          header_resp.set_stream_id(header_req.stream_id());
+          auto* new_hdr = header_resp.mutable_request_headers()
+                              ->mutable_response()
+                              ->mutable_header_mutation()
+                              ->add_set_headers();
+          new_hdr->mutable_append()->set_value(false);
+          new_hdr->mutable_header()->set_key("x-envoy-benchmark");
+          new_hdr->mutable_header()->set_raw_value("true");
+          stream->Write(header_resp);
+        }
+      });
+  initialize();
+  measureHttpGets("add-request-header-multiplexed");
+  // Closes the shared stream, which the processor would otherwise wait for when shut down.
+  test_server_.reset();
+}
+
 // Add a response header, then close.
 TEST_F(BenchmarkTest, AddResponseHeaderAndClose) {
   test_processor_.start(
@@ -2093,6 +2093,72 @@ TEST_F(HttpFilterTest, PostStreamingBodies) {
                         false);
 }
 
+// Using a configuration with streaming set for the request body and its chunks aggregated, ensure
+// that the small chunks are sent together once enough of them arrive, or once they were held long
+// enough.
+TEST_F(HttpFilterTest, PostStreamingBodyAggregated) {
+  initialize(R"EOF(
+  grpc_service:
+    envoy_grpc:
+      cluster_name: "ext_proc_server"
+  processing_mode:
+    request_header_mode: "SKIP"
+    request_body_mode: "STREAMED"
+    response_header_mode: "SKIP"
+  streamed_body_aggregation:
+    min_bytes: 150
+    max_delay: 1s
+  )EOF");
+
+  HttpTestUtility::addDefaultHeaders(request_headers_);
+  request_headers_.setMethod("POST");
+  EXPECT_EQ(FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+
+  Buffer::OwnedImpl got_request_body;
+  EXPECT_CALL(decoder_callbacks_, injectDecodedDataToFilterChain(_, _))
+      .WillRepeatedly(Invoke(
+          [&got_request_body](Buffer::Instance& data, Unused) { got_request_body.move(data); }));
+
+  // The first chunk is held.
+  auto* aggregation_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  Buffer::OwnedImpl chunk_1(std::string(100, 'a'));
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(chunk_1, false));
+  EXPECT_EQ(0, chunk_1.length());
+  EXPECT_TRUE(aggregation_timer->enabled_);
+  EXPECT_EQ(0, config_->stats().stream_msgs_sent_.value());
+
+  // The second one reaches the min bytes, so both are sent in a single message.
+  Buffer::OwnedImpl chunk_2(std::string(100, 'b'));
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(chunk_2, false));
+  EXPECT_EQ(0, chunk_2.length());
+  EXPECT_FALSE(aggregation_timer->enabled_);
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(std::string(100, 'a') + std::string(100, 'b'), last_request_.request_body().body());
+  processRequestBody(absl::nullopt, false);
+
+  // The third one is sent once the timer fires.
+  Buffer::OwnedImpl chunk_3(std::string(50, 'c'));
+  EXPECT_EQ(FilterDataStatus::Continue, filter_->decodeData(chunk_3, false));
+  EXPECT_EQ(1, config_->stats().stream_msgs_sent_.value());
+  aggregation_timer->invokeCallback();
+  EXPECT_EQ(2, config_->stats().stream_msgs_sent_.value());
+  EXPECT_EQ(std::string(50, 'c'), last_request_.request_body().body());
+  processRequestBody(absl::nullopt, false);
+
+  // The end of the body is never held.
+  Buffer::OwnedImpl chunk_4(std::string(10, 'd'));
+  EXPECT_EQ(FilterDataStatus::StopIterationNoBuffer, filter_->decodeData(chunk_4, true));
+  EXPECT_EQ(3, config_->stats().stream_msgs_sent_.value());
+  EXPECT_TRUE(last_request_.request_body().end_of_stream());
+  processRequestBody(absl::nullopt);
+
+  EXPECT_EQ(std::string(100, 'a') + std::string(100, 'b') + std::string(50, 'c') +
+                std::string(10, 'd'),
+            got_request_body.toString());
+  filter_->onDestroy();
+  EXPECT_EQ(3, config_->stats().stream_msgs_received_.value());
+}
+
 // Using a configuration with streaming set for the request and
 // response bodies, ensure that the chunks are delivered to the processor and
 // that the processor gets them correctly when some data comes in before the
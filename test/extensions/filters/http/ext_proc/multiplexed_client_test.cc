@@ -0,0 +1,226 @@
+#include <array>
+#include <memory>
+#include <string>
+
+#include "envoy/config/core/v3/grpc_service.pb.h"
+
+#include "source/common/grpc/common.h"
+#include "source/extensions/filters/http/ext_proc/multiplexed_client_impl.h"
+
+#include "test/mocks/grpc/mocks.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/stats/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using envoy::service::ext_proc::v3::ProcessingRequest;
+using envoy::service::ext_proc::v3::ProcessingResponse;
+
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+using testing::Unused;
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace ExternalProcessing {
+namespace {
+
+// The callbacks of the processing of an HTTP request.
+class TestCallbacks : public ExternalProcessorCallbacks {
+public:
+  void onReceiveMessage(std::unique_ptr<ProcessingResponse>&& response) override {
+    last_response_ = std::move(response);
+  }
+  void onGrpcError(Grpc::Status::GrpcStatus status, const std::string&) override {
+    grpc_status_ = status;
+  }
+  void onGrpcClose() override { grpc_closed_ = true; }
+  void logStreamInfo() override {}
+  void onComplete(ProcessingResponse&) override {}
+  void onError() override {}
+
+  std::unique_ptr<ProcessingResponse> last_response_;
+  Grpc::Status::GrpcStatus grpc_status_ = Grpc::Status::WellKnownGrpcStatus::Ok;
+  bool grpc_closed_ = false;
+};
+
+class MultiplexedClientTest : public testing::Test {
+protected:
+  void SetUp() override {
+    grpc_service_.mutable_envoy_grpc()->set_cluster_name("test");
+    config_with_hash_key_.setConfig(grpc_service_);
+    ON_CALL(client_manager_, getOrCreateRawAsyncClientWithHashKey(_, _, _))
+        .WillByDefault(Return(async_client_));
+    ON_CALL(*async_client_,
+            startRaw("envoy.service.ext_proc.v3.ExternalProcessor", "Process", _, _))
+        .WillByDefault(Invoke(this, &MultiplexedClientTest::doStartRaw));
+    watermark_callbacks_.setDecoderFilterCallbacks(&decoder_callbacks_);
+    watermark_callbacks_.setEncoderFilterCallbacks(&encoder_callbacks_);
+  }
+
+  void initialize(uint32_t max_shared_streams) {
+    shared_streams_ = std::make_unique<SharedProcessorStreams>(
+        client_manager_, *stats_store_.rootScope(), max_shared_streams);
+    client_ = std::make_unique<MultiplexedProcessorClient>(*shared_streams_);
+  }
+
+  Grpc::RawAsyncStream* doStartRaw(Unused, Unused, Grpc::RawAsyncStreamCallbacks& callbacks,
+                                   const Http::AsyncClient::StreamOptions&) {
+    stream_callbacks_[started_streams_] = &callbacks;
+    return &streams_[started_streams_++];
+  }
+
+  ExternalProcessorStreamPtr start(TestCallbacks& callbacks) {
+    Http::AsyncClient::StreamOptions options;
+    return client_->start(callbacks, config_with_hash_key_, options, watermark_callbacks_);
+  }
+
+  // Expects a request to be sent on a gRPC stream, and returns its stream_id.
+  void expectSend(uint32_t stream_index, uint64_t& stream_id) {
+    EXPECT_CALL(streams_[stream_index], sendMessageRaw_(_, false))
+        .WillOnce(Invoke([&stream_id](Buffer::InstancePtr& request, bool) {
+          ProcessingRequest message;
+          ASSERT_TRUE(message.ParseFromString(request->toString()));
+          stream_id = message.stream_id();
+        }));
+  }
+
+  void respond(uint32_t stream_index, uint64_t stream_id) {
+    ProcessingResponse response;
+    response.mutable_request_headers();
+    response.set_stream_id(stream_id);
+    EXPECT_TRUE(stream_callbacks_[stream_index]->onReceiveMessageRaw(
+        Grpc::Common::serializeMessage(response)));
+  }
+
+  envoy::config::core::v3::GrpcService grpc_service_;
+  Grpc::GrpcServiceConfigWithHashKey config_with_hash_key_;
+  testing::NiceMock<Grpc::MockAsyncClientManager> client_manager_;
+  std::shared_ptr<testing::NiceMock<Grpc::MockAsyncClient>> async_client_{
+      std::make_shared<testing::NiceMock<Grpc::MockAsyncClient>>()};
+  std::array<testing::NiceMock<Grpc::MockAsyncStream>, 3> streams_;
+  std::array<Grpc::RawAsyncStreamCallbacks*, 3> stream_callbacks_{};
+  uint32_t started_streams_{0};
+  testing::NiceMock<Http::MockStreamDecoderFilterCallbacks> decoder_callbacks_;
+  testing::NiceMock<Http::MockStreamEncoderFilterCallbacks> encoder_callbacks_;
+  Http::StreamFilterSidestreamWatermarkCallbacks watermark_callbacks_;
+  testing::NiceMock<Stats::MockStore> stats_store_;
+  std::unique_ptr<SharedProcessorStreams> shared_streams_;
+  ExternalProcessorClientPtr client_;
+};
+
+TEST_F(MultiplexedClientTest, SharesGrpcStreamBetweenRequests) {
+  initialize(1);
+  TestCallbacks callbacks_1;
+  TestCallbacks callbacks_2;
+  auto stream_1 = start(callbacks_1);
+  auto stream_2 = start(callbacks_2);
+  EXPECT_EQ(started_streams_, 1);
+
+  uint64_t stream_id_1 = 0;
+  uint64_t stream_id_2 = 0;
+  expectSend(0, stream_id_1);
+  stream_1->send(ProcessingRequest(), false);
+  expectSend(0, stream_id_2);
+  stream_2->send(ProcessingRequest(), true);
+  EXPECT_NE(stream_id_1, 0);
+  EXPECT_NE(stream_id_2, 0);
+  EXPECT_NE(stream_id_1, stream_id_2);
+
+  // Responses are dispatched by stream_id, and those of unknown streams are ignored.
+  respond(0, stream_id_2);
+  EXPECT_FALSE(callbacks_1.last_response_);
+  ASSERT_TRUE(callbacks_2.last_response_);
+  EXPECT_EQ(callbacks_2.last_response_->stream_id(), stream_id_2);
+  respond(0, 1000);
+  EXPECT_FALSE(callbacks_1.last_response_);
+
+  // Closing a request leaves the gRPC stream open for the others.
+  EXPECT_CALL(streams_[0], closeStream()).Times(0);
+  EXPECT_CALL(streams_[0], resetStream()).Times(0);
+  EXPECT_TRUE(stream_2->close());
+  EXPECT_FALSE(stream_2->close());
+  callbacks_2.last_response_.reset();
+  respond(0, stream_id_2);
+  EXPECT_FALSE(callbacks_2.last_response_);
+  respond(0, stream_id_1);
+  EXPECT_TRUE(callbacks_1.last_response_);
+  testing::Mock::VerifyAndClearExpectations(&streams_[0]);
+
+  // The gRPC stream is closed once unused by both the client and the requests.
+  stream_1.reset();
+  stream_2.reset();
+  EXPECT_CALL(streams_[0], closeStream());
+  EXPECT_CALL(streams_[0], resetStream());
+  shared_streams_.reset();
+}
+
+TEST_F(MultiplexedClientTest, SpreadsRequestsOverSharedStreams) {
+  initialize(2);
+  TestCallbacks callbacks_1;
+  TestCallbacks callbacks_2;
+  TestCallbacks callbacks_3;
+  auto stream_1 = start(callbacks_1);
+  auto stream_2 = start(callbacks_2);
+  EXPECT_EQ(started_streams_, 2);
+
+  // Picks the gRPC stream with the fewest requests.
+  stream_1->close();
+  auto stream_3 = start(callbacks_3);
+  EXPECT_EQ(started_streams_, 2);
+  uint64_t stream_id = 0;
+  expectSend(0, stream_id);
+  stream_3->send(ProcessingRequest(), false);
+  respond(0, stream_id);
+  EXPECT_TRUE(callbacks_3.last_response_);
+}
+
+TEST_F(MultiplexedClientTest, SharedStreamCloseEndsAllRequests) {
+  initialize(1);
+  TestCallbacks callbacks_1;
+  TestCallbacks callbacks_2;
+  auto stream_1 = start(callbacks_1);
+  auto stream_2 = start(callbacks_2);
+
+  stream_callbacks_[0]->onRemoteClose(Grpc::Status::WellKnownGrpcStatus::Unavailable,
+                                      "unavailable");
+  EXPECT_EQ(callbacks_1.grpc_status_, Grpc::Status::WellKnownGrpcStatus::Unavailable);
+  EXPECT_EQ(callbacks_2.grpc_status_, Grpc::Status::WellKnownGrpcStatus::Unavailable);
+  EXPECT_FALSE(stream_1->close());
+
+  // Requests of a destroyed filter are not called back.
+  TestCallbacks callbacks_3;
+  auto stream_3 = start(callbacks_3);
+  EXPECT_EQ(started_streams_, 2);
+  stream_3->notifyFilterDestroy();
+  stream_callbacks_[1]->onRemoteClose(Grpc::Status::WellKnownGrpcStatus::Ok, "");
+  EXPECT_FALSE(callbacks_3.grpc_closed_);
+
+  // A closed request sends nothing.
+  EXPECT_CALL(streams_[1], sendMessageRaw_(_, _)).Times(0);
+  stream_3->send(ProcessingRequest(), false);
+}
+
+TEST_F(MultiplexedClientTest, ClientStartError) {
+  initialize(1);
+  EXPECT_CALL(client_manager_, getOrCreateRawAsyncClientWithHashKey(_, _, _))
+      .WillOnce(Return(absl::InvalidArgumentError("error")));
+  TestCallbacks callbacks;
+  EXPECT_EQ(start(callbacks), nullptr);
+
+  EXPECT_CALL(*async_client_, startRaw(_, _, _, _)).WillOnce(Return(nullptr));
+  EXPECT_EQ(start(callbacks), nullptr);
+
+  // The next request retries opening a gRPC stream.
+  EXPECT_NE(start(callbacks), nullptr);
+  EXPECT_EQ(started_streams_, 1);
+}
+
+} // namespace
+} // namespace ExternalProcessing
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1612,6 +1612,73 @@ TEST_F(GrpcJsonTranscoderFilterReportCollisionTest, CreateShelfBodyWildcard) {
   EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer, filter_.decodeData(request_data, true));
 }
 
+class GrpcJsonTranscoderFilterUnaryResponseStreamingTest : public GrpcJsonTranscoderFilterTest {
+public:
+  GrpcJsonTranscoderFilterUnaryResponseStreamingTest()
+      : GrpcJsonTranscoderFilterTest(makeProtoConfig()) {}
+
+protected:
+  void sendRequest() {
+    Http::TestRequestHeaderMapImpl request_headers{
+        {"content-type", "application/json"}, {":method", "POST"}, {":path", "/shelf"}};
+    EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_.decodeHeaders(request_headers, false));
+    Buffer::OwnedImpl request_data{"{\"theme\": \"Children\"}"};
+    EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.decodeData(request_data, true));
+  }
+
+  Http::TestResponseHeaderMapImpl response_headers_{{"content-type", "application/grpc"},
+                                                    {":status", "200"}};
+
+private:
+  static const envoy::extensions::filters::http::grpc_json_transcoder::v3::GrpcJsonTranscoder
+  makeProtoConfig() {
+    auto proto_config = bookstoreProtoConfig();
+    proto_config.mutable_unary_response_streaming_window()->set_value(16);
+    return proto_config;
+  }
+};
+
+// The JSON of a unary response larger than the window is sent without waiting for the trailers.
+TEST_F(GrpcJsonTranscoderFilterUnaryResponseStreamingTest, StreamsLargeResponse) {
+  sendRequest();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_.encodeHeaders(response_headers_, false));
+
+  bookstore::Shelf response;
+  response.set_id(20);
+  response.set_theme("Children");
+  auto response_data = Grpc::Common::serializeToGrpcFrame(response);
+  EXPECT_EQ(Http::FilterDataStatus::Continue, filter_.encodeData(*response_data, false));
+  EXPECT_EQ(R"({"id":"20","theme":"Children"})", response_data->toString());
+
+  // The trailers are passed through, as the headers were already sent.
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, _)).Times(0);
+  Http::TestResponseTrailerMapImpl response_trailers{{"grpc-status", "0"}};
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_.encodeTrailers(response_trailers));
+  EXPECT_EQ("200", response_headers_.get_(":status"));
+  EXPECT_FALSE(response_headers_.has("content-length"));
+}
+
+// The JSON of a unary response within the window is buffered until the trailers.
+TEST_F(GrpcJsonTranscoderFilterUnaryResponseStreamingTest, BuffersSmallResponse) {
+  sendRequest();
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_.encodeHeaders(response_headers_, false));
+
+  bookstore::Shelf response;
+  response.set_id(20);
+  auto response_data = Grpc::Common::serializeToGrpcFrame(response);
+  EXPECT_EQ(Http::FilterDataStatus::StopIterationNoBuffer,
+            filter_.encodeData(*response_data, false));
+
+  EXPECT_CALL(encoder_callbacks_, addEncodedData(_, true))
+      .WillOnce(testing::Invoke([](Buffer::Instance& data, bool) {
+        EXPECT_EQ(R"({"id":"20"})", data.toString());
+      }));
+  Http::TestResponseTrailerMapImpl response_trailers{{"grpc-status", "0"}};
+  EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_.encodeTrailers(response_trailers));
+}
+
 bookstore::EchoStructReqResp createDeepStruct(int level) {
   bookstore::EchoStructReqResp msg;
   auto* field_map = msg.mutable_content()->mutable_fields();
@@ -1,3 +1,4 @@
+#include <fstream>
 #include <memory>
 
 #include "envoy/extensions/filters/http/ip_tagging/v3/ip_tagging.pb.h"
@@ -9,13 +10,16 @@
 
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/runtime/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/test_common/environment.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::Return;
+using testing::ReturnRef;
 
 namespace Envoy {
 namespace Extensions {
@@ -44,7 +48,7 @@ ip_tags:
     envoy::extensions::filters::http::ip_tagging::v3::IPTagging config;
     TestUtility::loadFromYaml(yaml, config);
     auto config_or =
-        IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), runtime_);
+        IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), context_);
     if (expected_error.has_value()) {
       EXPECT_FALSE(config_or.ok());
       EXPECT_EQ(expected_error.value(), absl::StrCat(config_or.status()));
@@ -67,7 +71,8 @@ ip_tags:
   std::unique_ptr<IpTaggingFilter> filter_;
   NiceMock<Http::MockStreamDecoderFilterCallbacks> filter_callbacks_;
   Buffer::OwnedImpl data_;
-  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  NiceMock<Runtime::MockLoader>& runtime_{context_.runtime_loader_};
 };
 
 TEST_F(IpTaggingFilterTest, InternalRequest) {
@@ -416,6 +421,39 @@ ip_tags:
   EXPECT_EQ(Http::FilterTrailersStatus::Continue, filter_->decodeTrailers(request_trailers));
 }
 
+// The tags of a large set of CIDR ranges are looked up in a Poptrie.
+TEST_F(IpTaggingFilterTest, LargeIpTagSet) {
+  envoy::extensions::filters::http::ip_tagging::v3::IPTagging config;
+  for (size_t i = 0; i < 2; i++) {
+    auto* ip_tag = config.add_ip_tags();
+    ip_tag->set_ip_tag_name(absl::StrCat("large_", i));
+    for (size_t j = 0; j < PoptrieMinCidrRanges / 2; j++) {
+      auto* cidr_range = ip_tag->add_ip_list();
+      cidr_range->set_address_prefix(absl::StrCat("10.", i, ".", j / 256, ".", j % 256));
+      cidr_range->mutable_prefix_len()->set_value(32);
+    }
+  }
+  auto* ip_tag = config.add_ip_tags();
+  ip_tag->set_ip_tag_name("wide");
+  auto* cidr_range = ip_tag->add_ip_list();
+  cidr_range->set_address_prefix("10.0.0.0");
+  cidr_range->mutable_prefix_len()->set_value(8);
+  auto config_or = IpTaggingFilterConfig::create(config, "prefix.", *stats_.rootScope(), context_);
+  ASSERT_TRUE(config_or.ok());
+  config_ = std::move(config_or.value());
+
+  auto sorted_tags = [this](const std::string& address) {
+    std::vector<std::string> tags =
+        config_->ipTags()->lookup(Network::Utility::parseInternetAddressNoThrow(address));
+    std::sort(tags.begin(), tags.end());
+    return tags;
+  };
+  EXPECT_EQ(std::vector<std::string>({"large_0", "wide"}), sorted_tags("10.0.127.255"));
+  EXPECT_EQ(std::vector<std::string>({"large_1", "wide"}), sorted_tags("10.1.0.1"));
+  EXPECT_EQ(std::vector<std::string>({"wide"}), sorted_tags("10.0.128.0"));
+  EXPECT_TRUE(sorted_tags("11.0.0.1").empty());
+}
+
 TEST_F(IpTaggingFilterTest, RuntimeDisabled) {
   initializeFilter(internal_request_yaml);
   Http::TestRequestHeaderMapImpl request_headers{{"x-envoy-internal", "true"}};
@@ -454,7 +492,97 @@ TEST_F(IpTaggingFilterTest, EmptyIpTags) {
 request_type: external
 )EOF";
   initializeFilter(external_request_yaml,
-                   "INVALID_ARGUMENT: HTTP IP Tagging Filter requires ip_tags to be specified.");
+                   "INVALID_ARGUMENT: HTTP IP Tagging Filter requires one of ip_tags or "
+                   "ip_tags_datasource to be specified.");
+}
+
+TEST_F(IpTaggingFilterTest, IpTagsAndDatasource) {
+  const std::string yaml = R"EOF(
+ip_tags:
+  - ip_tag_name: internal_request
+    ip_list:
+      - {address_prefix: 1.2.3.5, prefix_len: 32}
+ip_tags_datasource:
+  inline_string: "ip_tags: []"
+)EOF";
+  initializeFilter(yaml, "INVALID_ARGUMENT: HTTP IP Tagging Filter requires one of ip_tags or "
+                         "ip_tags_datasource to be specified.");
+}
+
+TEST_F(IpTaggingFilterTest, InlineDatasource) {
+  const std::string yaml = R"EOF(
+ip_tags_datasource:
+  inline_string: |
+    ip_tags:
+      - ip_tag_name: inline_request
+        ip_list:
+          - {address_prefix: 1.2.3.0, prefix_len: 24}
+)EOF";
+  initializeFilter(yaml);
+  Http::TestRequestHeaderMapImpl request_headers;
+  filter_callbacks_.stream_info_.downstream_connection_info_provider_->setRemoteAddress(
+      Network::Utility::parseInternetAddressNoThrow("1.2.3.4"));
+
+  EXPECT_CALL(stats_, counter("prefix.ip_tagging.inline_request.hit"));
+  EXPECT_CALL(stats_, counter("prefix.ip_tagging.total"));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, false));
+  EXPECT_EQ("inline_request", request_headers.get_(Http::Headers::get().EnvoyIpTags));
+}
+
+TEST_F(IpTaggingFilterTest, InvalidDatasource) {
+  const std::string yaml = R"EOF(
+ip_tags_datasource:
+  inline_string: |
+    ip_tags:
+      - ip_tag_name: inline_request
+        ip_list:
+          - {address_prefix: 1.2.3, prefix_len: 24}
+)EOF";
+  initializeFilter(yaml, "INVALID_ARGUMENT: invalid ip/mask combo '1.2.3/24' (format is <ip>/<# "
+                         "mask bits>)");
+}
+
+// The IP tags of a file are reloaded when it is modified, keeping the previous ones if the new
+// content is invalid.
+TEST_F(IpTaggingFilterTest, FileDatasourceReload) {
+  const std::string filename = TestEnvironment::temporaryPath("ip_tags.yaml");
+  auto write_file = [&filename](const std::string& content) {
+    std::ofstream file(filename);
+    file << content;
+  };
+  write_file(R"EOF(
+ip_tags:
+  - ip_tag_name: first
+    ip_list:
+      - {address_prefix: 1.2.3.0, prefix_len: 24}
+)EOF");
+
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  ON_CALL(context_, api()).WillByDefault(ReturnRef(*api));
+  ON_CALL(context_, mainThreadDispatcher()).WillByDefault(ReturnRef(*dispatcher));
+  initializeFilter(fmt::format("ip_tags_datasource: {{filename: \"{}\"}}", filename));
+
+  const auto address = Network::Utility::parseInternetAddressNoThrow("1.2.3.4");
+  EXPECT_EQ(std::vector<std::string>({"first"}), config_->ipTags()->lookup(address));
+
+  write_file(R"EOF(
+ip_tags:
+  - ip_tag_name: second
+    ip_list:
+      - {address_prefix: 1.2.0.0, prefix_len: 16}
+)EOF");
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(std::vector<std::string>({"second"}), config_->ipTags()->lookup(address));
+
+  write_file("ip_tags: [{ip_tag_name: third, ip_list: [{address_prefix: 1.2, prefix_len: 16}]}]");
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(std::vector<std::string>({"second"}), config_->ipTags()->lookup(address));
+
+  // The config owns the file watch, which is deleted on the dispatcher.
+  filter_.reset();
+  config_.reset();
+  dispatcher->run(Event::Dispatcher::RunType::NonBlock);
 }
 
 TEST_F(IpTaggingFilterTest, InvalidCidr) {
@@ -1132,12 +1132,27 @@ public:
 TEST_F(AuthenticatorJwtCacheTest, TestNonProvider) {
   createAuthenticator(absl::nullopt);
 
-  // For invalid provider, jwt_cache is not called.
-  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, lookup(_)).Times(0);
-  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _)).Times(0);
+  // Without a provider, the jwt_cache of the provider found by issuer is used.
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, lookup(_)).WillOnce(Return(nullptr));
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(GoodToken, _));
+
+  Http::TestRequestHeaderMapImpl headers{{"Authorization", "Bearer " + std::string(GoodToken)}};
+  expectVerifyStatus(Status::Ok, headers);
+}
+
+TEST_F(AuthenticatorJwtCacheTest, TestNonProviderCacheHit) {
+  createAuthenticator(absl::nullopt);
+
+  JwtVerify::Jwt cached_jwt;
+  cached_jwt.parseFromString(GoodToken);
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, lookup(_)).WillOnce(Return(&cached_jwt));
+  // Neither the signature is verified, nor the jwt inserted again.
+  EXPECT_CALL(jwks_cache_.jwks_data_, getJwksObj()).Times(0);
+  EXPECT_CALL(jwks_cache_.jwks_data_.jwt_cache_, insert(_, _)).Times(0);
 
   Http::TestRequestHeaderMapImpl headers{{"Authorization", "Bearer " + std::string(GoodToken)}};
   expectVerifyStatus(Status::Ok, headers);
+  EXPECT_EQ(1U, jwks_cache_.stats_.jwt_cache_hit_.value());
 }
 
 TEST_F(AuthenticatorJwtCacheTest, TestCacheMissGoodToken) {
@@ -307,6 +307,33 @@ local_rate_limit_per_downstream_connection: true
       "true");
 }
 
+TEST(Factory, WorkerTokenBatchSizeAndLocalRateLimitPerDownstreamConnection) {
+  const std::string config_yaml = R"(
+stat_prefix: test
+token_bucket:
+  max_tokens: 1
+  tokens_per_fill: 1
+  fill_interval: 1000s
+worker_token_batch_size: 10
+local_rate_limit_per_downstream_connection: true
+)";
+
+  LocalRateLimitFilterConfig factory;
+  ProtobufTypes::MessagePtr proto_config = factory.createEmptyRouteConfigProto();
+  TestUtility::loadFromYaml(config_yaml, *proto_config);
+
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+
+  EXPECT_THROW_WITH_MESSAGE(
+      factory
+          .createRouteSpecificFilterConfig(*proto_config, context,
+                                           ProtobufMessage::getNullValidationVisitor())
+          .value(),
+      EnvoyException,
+      "worker_token_batch_size is set and local_rate_limit_per_downstream_connection is set to "
+      "true");
+}
+
 TEST(Factory, LocalClusterRateLimitAndWithoutLocalClusterName) {
   const std::string config_yaml = R"(
 stat_prefix: test
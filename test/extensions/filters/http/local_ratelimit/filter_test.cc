@@ -180,6 +180,34 @@ TEST_F(FilterTest, RequestOkPerConnection) {
   EXPECT_EQ(0U, findCounter("test.http_local_rate_limit.rate_limited"));
 }
 
+TEST_F(FilterTest, RequestRateLimitedWorkerTokenBatch) {
+  factory_context_.options_.concurrency_ = 2;
+  setup(R"(
+stat_prefix: test
+token_bucket:
+  max_tokens: 2
+  tokens_per_fill: 1
+  fill_interval: 1000s
+filter_enabled:
+  runtime_key: test_enabled
+  default_value:
+    numerator: 100
+    denominator: HUNDRED
+filter_enforced:
+  runtime_key: test_enforced
+  default_value:
+    numerator: 100
+    denominator: HUNDRED
+worker_token_batch_size: 1
+)");
+  auto headers = Http::TestRequestHeaderMapImpl();
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(headers, false));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_2_->decodeHeaders(headers, false));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration, filter_->decodeHeaders(headers, false));
+  EXPECT_EQ(2U, findCounter("test.http_local_rate_limit.ok"));
+  EXPECT_EQ(1U, findCounter("test.http_local_rate_limit.rate_limited"));
+}
+
 TEST_F(FilterTest, RequestRateLimited) {
   setup(fmt::format(config_yaml, "false", "1", "false", "\"OFF\""));
 
@@ -2024,6 +2024,44 @@ TEST_F(OAuth2Test, CookieValidatorSame) {
   EXPECT_FALSE(cookie_validator->isValid());
 }
 
+// The cookies validated before are only valid with the same secret and cookie values.
+TEST_F(OAuth2Test, CookieValidatorValidatedBefore) {
+  test_time_.setSystemTime(SystemTime(std::chrono::seconds(0)));
+  auto cookie_names = CookieNames{"BearerToken",  "OauthHMAC",  "OauthExpires", "IdToken",
+                                  "RefreshToken", "OauthNonce", "CodeVerifier"};
+  const auto expires_at_s = DateUtil::nowToSeconds(test_time_.timeSystem()) + 5;
+  const auto request_headers = [&](absl::string_view access_token) {
+    return Http::TestRequestHeaderMapImpl{
+        {Http::Headers::get().Host.get(), "traffic.example.com:101"},
+        {Http::Headers::get().Path.get(), "/anypath"},
+        {Http::Headers::get().Method.get(), Http::Headers::get().MethodValues.Get},
+        {Http::Headers::get().Cookie.get(),
+         fmt::format("{}={}", cookie_names.oauth_expires_, expires_at_s)},
+        {Http::Headers::get().Cookie.get(),
+         absl::StrCat(cookie_names.bearer_token_, "=", access_token)},
+        {Http::Headers::get().Cookie.get(),
+         absl::StrCat(cookie_names.oauth_hmac_, "=eYef0itomg0CAjYygAfCLwmS2s1DaiL+N1Ql5V48o4o=")},
+    };
+  };
+
+  auto cookie_validator = std::make_shared<OAuth2CookieValidator>(test_time_, cookie_names, "");
+  for (int i = 0; i < 2; ++i) {
+    cookie_validator->setParams(request_headers(TEST_ENCRYPTED_ACCESS_TOKEN), TEST_HMAC_SECRET);
+    EXPECT_TRUE(cookie_validator->hmacIsValid());
+  }
+
+  cookie_validator->setParams(request_headers(TEST_ENCRYPTED_ACCESS_TOKEN), "another_secret");
+  EXPECT_FALSE(cookie_validator->hmacIsValid());
+  cookie_validator->setParams(request_headers("another_token"), TEST_HMAC_SECRET);
+  EXPECT_FALSE(cookie_validator->hmacIsValid());
+
+  // The expiry is still checked.
+  cookie_validator->setParams(request_headers(TEST_ENCRYPTED_ACCESS_TOKEN), TEST_HMAC_SECRET);
+  test_time_.advanceTimeWait(std::chrono::seconds(6));
+  EXPECT_TRUE(cookie_validator->hmacIsValid());
+  EXPECT_FALSE(cookie_validator->isValid());
+}
+
 // Validates the behavior of the cookie validator when the expires_at value is not a valid integer.
 TEST_F(OAuth2Test, CookieValidatorInvalidExpiresAt) {
   Http::TestRequestHeaderMapImpl request_headers{
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "source/extensions/filters/http/ratelimit/quota_cache.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace RateLimitFilter {
+namespace {
+
+using Filters::Common::RateLimit::LimitStatus;
+
+TEST(QuotaCacheTest, Key) {
+  const std::vector<RateLimit::Descriptor> descriptors{{{{"key", "value"}}}};
+  const absl::optional<std::string> key = QuotaCache::key("domain", descriptors);
+  ASSERT_TRUE(key.has_value());
+  EXPECT_EQ(QuotaCache::key("domain", descriptors), key);
+  EXPECT_NE(QuotaCache::key("other_domain", descriptors), key);
+
+  // The values are length prefixed, so moving characters between entries changes the key.
+  EXPECT_NE(QuotaCache::key("domain", {{{{"keyv", "alue"}}}}), key);
+  // The descriptors are delimited, so moving entries between them changes the key.
+  EXPECT_NE(QuotaCache::key("domain", {{{{"a", "1"}, {"b", "2"}}}}),
+            QuotaCache::key("domain", {{{{"a", "1"}}}, {{{"b", "2"}}}}));
+
+  // The limit override is part of the key.
+  EXPECT_NE(QuotaCache::key("domain", {{{{"key", "value"}},
+                                        {{42, envoy::type::v3::RateLimitUnit::MINUTE}}}}),
+            key);
+
+  // The requests with descriptors of their own hits addend are not cached.
+  RateLimit::Descriptor descriptor{{{"key", "value"}}};
+  descriptor.hits_addend_ = 2;
+  EXPECT_FALSE(QuotaCache::key("domain", {descriptor}).has_value());
+}
+
+TEST(QuotaCacheTest, Consume) {
+  QuotaCache cache(10);
+  const SystemTime now{std::chrono::seconds(1000)};
+  EXPECT_EQ(cache.consume("key", 1, now), absl::nullopt);
+
+  cache.insert("key", 3, now + std::chrono::seconds(10));
+  EXPECT_EQ(cache.consume("key", 2, now), LimitStatus::OK);
+  EXPECT_EQ(cache.consume("key", 2, now), LimitStatus::OverLimit);
+  EXPECT_EQ(cache.consume("key", 1, now), LimitStatus::OK);
+  EXPECT_EQ(cache.consume("key", 1, now), LimitStatus::OverLimit);
+
+  // A new quota replaces the previous one.
+  cache.insert("key", 1, now + std::chrono::seconds(10));
+  EXPECT_EQ(cache.consume("key", 1, now), LimitStatus::OK);
+  EXPECT_EQ(cache.size(), 1);
+
+  // An expired quota is removed.
+  EXPECT_EQ(cache.consume("key", 1, now + std::chrono::seconds(10)), absl::nullopt);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(QuotaCacheTest, EvictsLeastRecentlyUsed) {
+  QuotaCache cache(2);
+  const SystemTime now{std::chrono::seconds(1000)};
+  const SystemTime expiry = now + std::chrono::seconds(10);
+  cache.insert("a", 5, expiry);
+  cache.insert("b", 5, expiry);
+  EXPECT_EQ(cache.consume("a", 1, now), LimitStatus::OK);
+
+  cache.insert("c", 5, expiry);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.consume("b", 1, now), absl::nullopt);
+  EXPECT_EQ(cache.consume("a", 1, now), LimitStatus::OK);
+  EXPECT_EQ(cache.consume("c", 1, now), LimitStatus::OK);
+}
+
+} // namespace
+} // namespace RateLimitFilter
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -198,6 +198,7 @@ public:
   Stats::StatName ratelimit_error_{pool_.add("ratelimit.error")};
   Stats::StatName ratelimit_failure_mode_allowed_{pool_.add("ratelimit.failure_mode_allowed")};
   Stats::StatName ratelimit_over_limit_{pool_.add("ratelimit.over_limit")};
+  Stats::StatName ratelimit_quota_cache_hit_{pool_.add("ratelimit.quota_cache_hit")};
   Stats::StatName upstream_rq_4xx_{pool_.add("upstream_rq_4xx")};
   Stats::StatName upstream_rq_429_{pool_.add("upstream_rq_429")};
   Stats::StatName upstream_rq_5xx_{pool_.add("upstream_rq_5xx")};
@@ -2385,6 +2386,112 @@ TEST_F(HttpRateLimitFilterTest, InlinedRateLimitActionOnStreamDone) {
       filter_callbacks_.clusterInfo()->statsScope().counterFromStatName(upstream_rq_429_).value());
 }
 
+class QuotaCacheFilterTest : public HttpRateLimitFilterTest {
+public:
+  void initializeWithQuotaCache() {
+    setUpTest(R"EOF(
+    domain: foo
+    quota_cache:
+      max_entries: 10
+    )EOF");
+    ON_CALL(route_rate_limit_, populateDescriptors(_, _, _, _))
+        .WillByDefault(SetArgReferee<0>(descriptor_));
+  }
+
+  // Starts another request of the same config.
+  void resetFilter() {
+    client_ = new Filters::Common::RateLimit::MockClient();
+    filter_ = std::make_unique<Filter>(config_, Filters::Common::RateLimit::ClientPtr{client_});
+    filter_->setDecoderFilterCallbacks(filter_callbacks_);
+  }
+
+  // The quota of the given requests, valid for the given time from now.
+  envoy::service::ratelimit::v3::RateLimitResponse::Quota
+  quota(uint32_t requests, absl::optional<std::chrono::seconds> valid_for) {
+    envoy::service::ratelimit::v3::RateLimitResponse::Quota quota;
+    quota.set_requests(requests);
+    if (valid_for.has_value()) {
+      const SystemTime valid_until =
+          filter_callbacks_.dispatcher_.timeSource().systemTime() + valid_for.value();
+      *quota.mutable_valid_until() = Protobuf::util::TimeUtil::MillisecondsToTimestamp(
+          std::chrono::duration_cast<std::chrono::milliseconds>(valid_until.time_since_epoch())
+              .count());
+    }
+    return quota;
+  }
+
+  void expectOkResponseWithQuota(
+      const envoy::service::ratelimit::v3::RateLimitResponse::Quota& quota) {
+    EXPECT_CALL(*client_, limit(_, "foo", _, _, _, 0))
+        .WillOnce(WithArgs<0>(
+            Invoke([quota](Filters::Common::RateLimit::RequestCallbacks& callbacks) -> void {
+              callbacks.onQuota(quota);
+              callbacks.complete(Filters::Common::RateLimit::LimitStatus::OK, nullptr, nullptr,
+                                 nullptr, "", nullptr);
+            })));
+  }
+
+  uint64_t counter(Stats::StatName name) {
+    return filter_callbacks_.clusterInfo()->statsScope().counterFromStatName(name).value();
+  }
+};
+
+// Test that the requests with the same descriptors are served from the quota granted to the first
+// one until it runs out.
+TEST_F(QuotaCacheFilterTest, CachedQuota) {
+  initializeWithQuotaCache();
+
+  expectOkResponseWithQuota(quota(2, std::chrono::seconds(60)));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+
+  // The first request consumed a hit of the quota, which has one left.
+  resetFilter();
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(filter_callbacks_, continueDecoding()).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ(1U, counter(ratelimit_quota_cache_hit_));
+  EXPECT_EQ(2U, counter(ratelimit_ok_));
+
+  // The quota ran out, so the next request is limited until it expires.
+  resetFilter();
+  EXPECT_CALL(*client_, limit(_, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(filter_callbacks_.stream_info_,
+              setResponseFlag(StreamInfo::CoreResponseFlag::RateLimited));
+  Http::TestResponseHeaderMapImpl response_headers{
+      {":status", "429"},
+      {"x-envoy-ratelimited", Http::Headers::get().EnvoyRateLimitedValues.True}};
+  EXPECT_CALL(filter_callbacks_, encodeHeaders_(HeaderMapEqualRef(&response_headers), true));
+  EXPECT_EQ(Http::FilterHeadersStatus::StopIteration,
+            filter_->decodeHeaders(request_headers_, false));
+  EXPECT_EQ(2U, counter(ratelimit_quota_cache_hit_));
+  EXPECT_EQ(1U, counter(ratelimit_over_limit_));
+
+  // Other descriptors are checked by the service.
+  resetFilter();
+  EXPECT_CALL(route_rate_limit_, populateDescriptors(_, _, _, _))
+      .WillOnce(SetArgReferee<0>(descriptor_two_));
+  expectOkResponseWithQuota(quota(2, std::chrono::seconds(60)));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers_, false));
+}
+
+// Test that the expired quotas and those without an expiration are not used.
+TEST_F(QuotaCacheFilterTest, QuotaNotCached) {
+  initializeWithQuotaCache();
+
+  expectOkResponseWithQuota(quota(10, absl::nullopt));
+  filter_->decodeHeaders(request_headers_, false);
+
+  resetFilter();
+  expectOkResponseWithQuota(quota(10, std::chrono::seconds(-1)));
+  filter_->decodeHeaders(request_headers_, false);
+
+  resetFilter();
+  expectOkResponseWithQuota(quota(10, std::chrono::seconds(60)));
+  filter_->decodeHeaders(request_headers_, false);
+  EXPECT_EQ(0U, counter(ratelimit_quota_cache_hit_));
+  EXPECT_EQ(3U, counter(ratelimit_ok_));
+}
+
 } // namespace
 } // namespace RateLimitFilter
 } // namespace HttpFilters
@@ -1577,6 +1577,64 @@ TEST_P(ProxyProtocolTest, V2ExtractTlvOfInterestAndEmitWithSpecifiedMetadataName
   EXPECT_EQ(stats_store_.counter("proxy_proto.versions.v2.found").value(), 1);
 }
 
+// The TLVs are stored in the metadata namespaces of their rules, the TLVs of a namespace not being
+// contiguous.
+TEST_P(ProxyProtocolTest, V2ExtractTlvsOfInterestToSeveralMetadataNamespaces) {
+  // A well-formed ipv4/tcp with three TLV extensions is accepted
+  constexpr uint8_t buffer[] = {0x0d, 0x0a, 0x0d, 0x0a, 0x00, 0x0d, 0x0a, 0x51, 0x55, 0x49,
+                                0x54, 0x0a, 0x21, 0x11, 0x00, 0x22, 0x01, 0x02, 0x03, 0x04,
+                                0x00, 0x01, 0x01, 0x02, 0x03, 0x05, 0x00, 0x02};
+  constexpr uint8_t tlv_type_authority[] = {0x02, 0x00, 0x07, 0x66, 0x6f,
+                                            0x6f, 0x2e, 0x63, 0x6f, 0x6d};
+  constexpr uint8_t tlv_type_netns[] = {0x30, 0x00, 0x03, 0x6e, 0x73, 0x31};
+  constexpr uint8_t tlv_vpc_id[] = {0xea, 0x00, 0x03, 0x76, 0x70, 0x63};
+  constexpr uint8_t data[] = {'D', 'A', 'T', 'A'};
+
+  envoy::extensions::filters::listener::proxy_protocol::v3::ProxyProtocol proto_config;
+  auto rule_type_authority = proto_config.add_rules();
+  rule_type_authority->set_tlv_type(0x02);
+  rule_type_authority->mutable_on_tlv_present()->set_key("PP2 type authority");
+  rule_type_authority->mutable_on_tlv_present()->set_metadata_namespace("custom");
+  auto rule_type_netns = proto_config.add_rules();
+  rule_type_netns->set_tlv_type(0x30);
+  rule_type_netns->mutable_on_tlv_present()->set_key("PP2 type netns");
+  auto rule_vpc_id = proto_config.add_rules();
+  rule_vpc_id->set_tlv_type(0xea);
+  rule_vpc_id->mutable_on_tlv_present()->set_key("PP2 vpc id");
+  rule_vpc_id->mutable_on_tlv_present()->set_metadata_namespace("custom");
+
+  connect(true, &proto_config);
+  write(buffer, sizeof(buffer));
+  write(tlv_type_authority, sizeof(tlv_type_authority));
+  write(tlv_type_netns, sizeof(tlv_type_netns));
+  write(tlv_vpc_id, sizeof(tlv_vpc_id));
+  write(data, sizeof(data));
+  expectData("DATA");
+
+  auto metadata = server_connection_->streamInfo().dynamicMetadata().filter_metadata();
+  EXPECT_EQ(2, metadata.size());
+  auto custom_fields = metadata.at("custom").fields();
+  EXPECT_EQ(2, custom_fields.size());
+  EXPECT_EQ("foo.com", custom_fields.at("PP2 type authority").string_value());
+  EXPECT_EQ("vpc", custom_fields.at("PP2 vpc id").string_value());
+  auto default_fields = metadata.at(ProxyProtocol).fields();
+  EXPECT_EQ(1, default_fields.size());
+  EXPECT_EQ("ns1", default_fields.at("PP2 type netns").string_value());
+
+  auto typed_metadata = server_connection_->streamInfo().dynamicMetadata().typed_filter_metadata();
+  EXPECT_EQ(2, typed_metadata.size());
+  envoy::data::core::v3::TlvsMetadata tlvs_metadata;
+  EXPECT_EQ(absl::OkStatus(), MessageUtil::unpackTo(typed_metadata["custom"], tlvs_metadata));
+  EXPECT_EQ(2, tlvs_metadata.typed_metadata().size());
+  EXPECT_EQ("foo.com", tlvs_metadata.typed_metadata().at("PP2 type authority"));
+  EXPECT_EQ("vpc", tlvs_metadata.typed_metadata().at("PP2 vpc id"));
+  EXPECT_EQ(absl::OkStatus(), MessageUtil::unpackTo(typed_metadata[ProxyProtocol], tlvs_metadata));
+  EXPECT_EQ(1, tlvs_metadata.typed_metadata().size());
+  EXPECT_EQ("ns1", tlvs_metadata.typed_metadata().at("PP2 type netns"));
+  disconnect();
+  EXPECT_EQ(stats_store_.counter("proxy_proto.versions.v2.found").value(), 1);
+}
+
 TEST_P(ProxyProtocolTest, V2ExtractMultipleTlvsOfInterestAndSanitiseNonUtf8) {
   // A well-formed ipv4/tcp with a pair of TLV extensions is accepted.
   constexpr uint8_t buffer[] = {0x0d, 0x0a, 0x0d, 0x0a, 0x00, 0x0d, 0x0a, 0x51, 0x55, 0x49,
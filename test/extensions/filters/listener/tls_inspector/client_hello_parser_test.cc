@@ -0,0 +1,189 @@
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/extensions/filters/listener/tls_inspector/client_hello_parser.h"
+#include "source/extensions/filters/listener/tls_inspector/ja4_fingerprint.h"
+
+#include "test/extensions/filters/listener/tls_inspector/tls_utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+#include "openssl/bytestring.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace ListenerFilters {
+namespace TlsInspector {
+namespace {
+
+struct BoringSslClientHello {
+  std::string ja4_;
+  std::string server_name_;
+};
+
+// What the TLS inspector gets from BoringSSL for a ClientHello, if it gets to its callback.
+absl::optional<BoringSslClientHello> parseWithBoringSsl(const std::vector<uint8_t>& data) {
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_with_buffers_method()));
+  SSL_CTX_set_select_certificate_cb(
+      ctx.get(), [](const SSL_CLIENT_HELLO* client_hello) -> ssl_select_cert_result_t {
+        auto* result =
+            static_cast<absl::optional<BoringSslClientHello>*>(SSL_get_app_data(client_hello->ssl));
+        *result = BoringSslClientHello{
+            JA4Fingerprinter::create(client_hello),
+            std::string(absl::NullSafeStringView(
+                SSL_get_servername(client_hello->ssl, TLSEXT_NAMETYPE_host_name)))};
+        return ssl_select_cert_error;
+      });
+  absl::optional<BoringSslClientHello> result;
+  bssl::UniquePtr<SSL> ssl(SSL_new(ctx.get()));
+  SSL_set_app_data(ssl.get(), &result);
+  SSL_set_accept_state(ssl.get());
+  bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(data.data(), data.size()));
+  BIO_set_mem_eof_return(bio.get(), -1);
+  SSL_set0_rbio(ssl.get(), bssl::UpRef(bio).release());
+  SSL_do_handshake(ssl.get());
+  return result;
+}
+
+// A ClientHello record with the given extensions, as type and data pairs.
+std::vector<uint8_t>
+clientHelloWithExtensions(const std::vector<std::pair<uint16_t, std::string>>& extensions) {
+  bssl::ScopedCBB cbb;
+  CBB record, message, session_id, cipher_suites, compression_methods, extension_list;
+  const uint8_t random[SSL3_RANDOM_SIZE] = {};
+  RELEASE_ASSERT(CBB_init(cbb.get(), 512) && CBB_add_u8(cbb.get(), SSL3_RT_HANDSHAKE) &&
+                     CBB_add_u16(cbb.get(), TLS1_VERSION) &&
+                     CBB_add_u16_length_prefixed(cbb.get(), &record) &&
+                     CBB_add_u8(&record, SSL3_MT_CLIENT_HELLO) &&
+                     CBB_add_u24_length_prefixed(&record, &message) &&
+                     CBB_add_u16(&message, TLS1_2_VERSION) &&
+                     CBB_add_bytes(&message, random, sizeof(random)) &&
+                     CBB_add_u8_length_prefixed(&message, &session_id) &&
+                     CBB_add_u16_length_prefixed(&message, &cipher_suites) &&
+                     CBB_add_u16(&cipher_suites, 0xc02f) &&
+                     CBB_add_u8_length_prefixed(&message, &compression_methods) &&
+                     CBB_add_u8(&compression_methods, 0) &&
+                     CBB_add_u16_length_prefixed(&message, &extension_list),
+                 "");
+  for (const auto& [type, data] : extensions) {
+    CBB extension;
+    RELEASE_ASSERT(CBB_add_u16(&extension_list, type) &&
+                       CBB_add_u16_length_prefixed(&extension_list, &extension) &&
+                       CBB_add_bytes(&extension, reinterpret_cast<const uint8_t*>(data.data()),
+                                     data.size()),
+                   "");
+  }
+  uint8_t* out;
+  size_t out_len;
+  RELEASE_ASSERT(CBB_finish(cbb.get(), &out, &out_len), "");
+  std::vector<uint8_t> client_hello(out, out + out_len);
+  OPENSSL_free(out);
+  return client_hello;
+}
+
+// The server name extension of a name of the given type.
+std::string serverNameExtension(uint8_t name_type, absl::string_view name) {
+  std::string extension;
+  extension.push_back(static_cast<char>((name.size() + 3) >> 8));
+  extension.push_back(static_cast<char>((name.size() + 3) & 0xff));
+  extension.push_back(static_cast<char>(name_type));
+  extension.push_back(static_cast<char>(name.size() >> 8));
+  extension.push_back(static_cast<char>(name.size() & 0xff));
+  absl::StrAppend(&extension, name);
+  return extension;
+}
+
+class ClientHelloParserTest : public testing::TestWithParam<std::tuple<uint16_t, uint16_t>> {};
+
+INSTANTIATE_TEST_SUITE_P(TlsProtocolVersions, ClientHelloParserTest,
+                         testing::Values(std::make_tuple(TLS1_VERSION, TLS1_3_VERSION),
+                                         std::make_tuple(TLS1_VERSION, TLS1_VERSION),
+                                         std::make_tuple(TLS1_1_VERSION, TLS1_1_VERSION),
+                                         std::make_tuple(TLS1_2_VERSION, TLS1_2_VERSION),
+                                         std::make_tuple(TLS1_3_VERSION, TLS1_3_VERSION)));
+
+// The parsed ClientHellos are those BoringSSL passes to the callbacks of the TLS inspector.
+TEST_P(ClientHelloParserTest, MatchesBoringSsl) {
+  for (const std::string& server_name : {"", "example.com"}) {
+    for (const std::string& alpn : {"", "\x02h2\x08http/1.1"}) {
+      const std::vector<uint8_t> data = Tls::Test::generateClientHello(
+          std::get<0>(GetParam()), std::get<1>(GetParam()), server_name, alpn);
+      const absl::optional<BoringSslClientHello> expected = parseWithBoringSsl(data);
+      ASSERT_TRUE(expected.has_value());
+
+      ClientHelloParser parser;
+      ASSERT_EQ(ClientHelloParser::Result::Parsed, parser.parse(data));
+      EXPECT_EQ(expected->server_name_, parser.serverName());
+      EXPECT_EQ(expected->ja4_, JA4Fingerprinter::create(&parser.clientHello()));
+      EXPECT_EQ(data.size(), parser.bytesProcessed());
+    }
+  }
+}
+
+TEST_P(ClientHelloParserTest, NeedMoreData) {
+  const std::vector<uint8_t> data = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), "example.com", "\x02h2");
+  for (size_t len = 0; len < data.size(); ++len) {
+    ClientHelloParser parser;
+    EXPECT_EQ(ClientHelloParser::Result::NeedMoreData, parser.parse({data.data(), len}));
+  }
+}
+
+TEST(ClientHelloParser, NotTls) {
+  const std::string http_request = "GET / HTTP/1.1\r\nHost: example.com\r\n\r\n";
+  ClientHelloParser parser;
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported,
+            parser.parse({reinterpret_cast<const uint8_t*>(http_request.data()), 1}));
+  const std::vector<uint8_t> zeroes(100);
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported, parser.parse(zeroes));
+}
+
+// The ClientHellos spanning several records are left to BoringSSL.
+TEST(ClientHelloParser, SeveralRecords) {
+  const std::vector<uint8_t> data =
+      Tls::Test::generateClientHello(TLS1_VERSION, TLS1_3_VERSION, "example.com", "");
+  constexpr size_t FirstRecordLength = 100;
+  std::vector<uint8_t> records(data.begin(), data.begin() + 5 + FirstRecordLength);
+  records[3] = 0;
+  records[4] = FirstRecordLength;
+  const std::vector<uint8_t> second_record_header = {
+      data[0], data[1], data[2], static_cast<uint8_t>((data.size() - 5 - FirstRecordLength) >> 8),
+      static_cast<uint8_t>((data.size() - 5 - FirstRecordLength) & 0xff)};
+  records.insert(records.end(), second_record_header.begin(), second_record_header.end());
+  records.insert(records.end(), data.begin() + 5 + FirstRecordLength, data.end());
+  ASSERT_TRUE(parseWithBoringSsl(records).has_value());
+
+  ClientHelloParser parser;
+  EXPECT_EQ(ClientHelloParser::Result::Unsupported, parser.parse(records));
+}
+
+// The ClientHellos BoringSSL rejects before its callbacks are left to it.
+TEST(ClientHelloParser, RejectedByBoringSsl) {
+  ClientHelloParser parser;
+  const std::vector<uint8_t> valid =
+      clientHelloWithExtensions({{TLSEXT_TYPE_server_name, serverNameExtension(0, "example.com")}});
+  ASSERT_TRUE(parseWithBoringSsl(valid).has_value());
+  ASSERT_EQ(ClientHelloParser::Result::Parsed, parser.parse(valid));
+  EXPECT_EQ("example.com", parser.serverName());
+
+  for (const std::vector<uint8_t>& invalid : {
+           clientHelloWithExtensions({{TLSEXT_TYPE_server_name, serverNameExtension(1, "a")}}),
+           clientHelloWithExtensions({{TLSEXT_TYPE_server_name, serverNameExtension(0, "")}}),
+           clientHelloWithExtensions(
+               {{TLSEXT_TYPE_server_name, serverNameExtension(0, std::string("a\0b", 3))}}),
+           clientHelloWithExtensions({{TLSEXT_TYPE_server_name, serverNameExtension(0, "a")},
+                                      {TLSEXT_TYPE_server_name, serverNameExtension(0, "a")}}),
+       }) {
+    EXPECT_FALSE(parseWithBoringSsl(invalid).has_value());
+    EXPECT_EQ(ClientHelloParser::Result::Unsupported, parser.parse(invalid));
+  }
+}
+
+} // namespace
+} // namespace TlsInspector
+} // namespace ListenerFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -65,6 +65,7 @@ public:
   const std::vector<uint8_t> client_hello_;
 };
 
+// Range 0 is 1 to parse the ClientHellos with the lightweight parser rather than with BoringSSL.
 static void bmTlsInspector(benchmark::State& state) {
   NiceMock<FastMockOsSysCalls> os_sys_calls(Tls::Test::generateClientHello(
       Config::TLS_MIN_SUPPORTED_VERSION, Config::TLS_MAX_SUPPORTED_VERSION, "example.com",
@@ -72,6 +73,7 @@ static void bmTlsInspector(benchmark::State& state) {
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls};
   NiceMock<Stats::MockStore> store;
   envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector proto_config;
+  proto_config.mutable_enable_lightweight_client_hello_parser()->set_value(state.range(0) != 0);
   ConfigSharedPtr cfg(std::make_shared<Config>(*store.rootScope(), proto_config));
   Network::IoHandlePtr io_handle = std::make_unique<Network::IoSocketHandleImpl>();
   Network::ConnectionSocketImpl socket(std::move(io_handle), nullptr, nullptr);
@@ -100,7 +102,7 @@ static void bmTlsInspector(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bmTlsInspector)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bmTlsInspector)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
 
 } // namespace TlsInspector
 } // namespace ListenerFilters
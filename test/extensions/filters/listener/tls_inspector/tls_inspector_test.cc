@@ -60,6 +60,13 @@ public:
     filter_->onAccept(cb_);
   }
 
+  void initWithLightweightParser() {
+    envoy::extensions::filters::listener::tls_inspector::v3::TlsInspector proto_config;
+    proto_config.mutable_enable_lightweight_client_hello_parser()->set_value(true);
+    cfg_ = std::make_shared<Config>(*store_.rootScope(), proto_config);
+    init();
+  }
+
   void mockSysCallForPeek(std::vector<uint8_t>& client_hello, bool windows_recv = false) {
 #ifdef WIN32
     // In some cases the syscall used for windows is recv, not readv.
@@ -493,6 +500,60 @@ TEST_P(TlsInspectorTest, NotSsl) {
       cb_.streamInfo().downstreamTransportFailureReason());
 }
 
+// Test that the lightweight parser registers the same names as BoringSSL.
+TEST_P(TlsInspectorTest, LightweightParserSniAndAlpnRegistered) {
+  initWithLightweightParser();
+  const auto alpn_protos = std::vector<absl::string_view>{Http::Utility::AlpnNames::get().Http2,
+                                                          Http::Utility::AlpnNames::get().Http11};
+  const std::string servername("example.com");
+  std::vector<uint8_t> client_hello = Tls::Test::generateClientHello(
+      std::get<0>(GetParam()), std::get<1>(GetParam()), servername, "\x02h2\x08http/1.1");
+  mockSysCallForPeek(client_hello);
+  EXPECT_CALL(socket_, setRequestedServerName(Eq(servername)));
+  EXPECT_CALL(socket_, setRequestedApplicationProtocols(alpn_protos));
+  EXPECT_CALL(socket_, setDetectedTransportProtocol(absl::string_view("tls")));
+  EXPECT_CALL(socket_, detectedTransportProtocol()).Times(::testing::AnyNumber());
+  EXPECT_TRUE(file_event_callback_(Event::FileReadyType::Read).ok());
+  auto state = filter_->onData(*buffer_);
+
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_found_.value());
+  EXPECT_EQ(1, cfg_->stats().sni_found_.value());
+  EXPECT_EQ(1, cfg_->stats().alpn_found_.value());
+  const std::vector<uint64_t> bytes_processed =
+      store_.histogramValues("tls_inspector.bytes_processed", false);
+  ASSERT_EQ(1, bytes_processed.size());
+  EXPECT_EQ(client_hello.size(), bytes_processed[0]);
+}
+
+// Test that the lightweight parser leaves plaintext to BoringSSL, which reports the same errors.
+TEST_P(TlsInspectorTest, LightweightParserNotSsl) {
+  initWithLightweightParser();
+  std::vector<uint8_t> data;
+
+  // Use 100 bytes of zeroes. This is not valid as a ClientHello.
+  data.resize(100);
+  mockSysCallForPeek(data);
+  EXPECT_TRUE(file_event_callback_(Event::FileReadyType::Read).ok());
+
+  Protobuf::Struct expected_metadata;
+  auto& fields = *expected_metadata.mutable_fields();
+  fields[Filter::failureReasonKey()].set_string_value(
+      Filter::failureReasonClientHelloNotDetected());
+  EXPECT_CALL(cb_, setDynamicMetadata(Filter::dynamicMetadataKey(), ProtoEq(expected_metadata)));
+
+  auto state = filter_->onData(*buffer_);
+  EXPECT_EQ(Network::FilterStatus::Continue, state);
+  EXPECT_EQ(1, cfg_->stats().tls_not_found_.value());
+  const std::vector<uint64_t> bytes_processed =
+      store_.histogramValues("tls_inspector.bytes_processed", false);
+  ASSERT_EQ(1, bytes_processed.size());
+  EXPECT_EQ(5, bytes_processed[0]);
+  EXPECT_EQ(
+      "TLS_error|error:100000f7:SSL routines:OPENSSL_internal:WRONG_VERSION_NUMBER:TLS_error_end",
+      cb_.streamInfo().downstreamTransportFailureReason());
+}
+
 TEST_P(TlsInspectorTest, NotSslCloseConnection) {
   std::vector<uint8_t> data;
 
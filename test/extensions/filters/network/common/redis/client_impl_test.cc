@@ -13,6 +13,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/upstream/host.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -288,6 +289,50 @@ TEST_F(RedisClientImplTest, BatchWithTimerCancelledByBufferFlush) {
   client_->close();
 }
 
+TEST_F(RedisClientImplTest, BatchWithZeroBufferCoalescedWrites) {
+  // With the default buffer size (0) and coalesced writes, the requests of an event loop iteration
+  // are written together at its end.
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.redis_coalesce_upstream_writes", "true"}});
+  auto* coalesced_flush_cb = new Event::MockSchedulableCallback(&dispatcher_);
+
+  setup();
+
+  Common::Redis::RespValue request1;
+  MockClientCallbacks callbacks1;
+  EXPECT_CALL(*encoder_, encode(Ref(request1), _));
+  EXPECT_CALL(*coalesced_flush_cb, scheduleCallbackCurrentIteration());
+  EXPECT_CALL(*upstream_connection_, write(_, _)).Times(0);
+  EXPECT_NE(nullptr, client_->makeRequest(request1, callbacks1));
+
+  // The second request is written with the first one.
+  Common::Redis::RespValue request2;
+  MockClientCallbacks callbacks2;
+  EXPECT_CALL(*encoder_, encode(Ref(request2), _));
+  EXPECT_NE(nullptr, client_->makeRequest(request2, callbacks2));
+  testing::Mock::VerifyAndClearExpectations(upstream_connection_);
+
+  EXPECT_CALL(*flush_timer_, enabled()).WillOnce(Return(false));
+  EXPECT_CALL(*upstream_connection_, write(_, false));
+  coalesced_flush_cb->invokeCallback();
+
+  // A request after the flush schedules it again, and the close cancels it.
+  Common::Redis::RespValue request3;
+  MockClientCallbacks callbacks3;
+  EXPECT_CALL(*encoder_, encode(Ref(request3), _));
+  EXPECT_CALL(*coalesced_flush_cb, scheduleCallbackCurrentIteration());
+  EXPECT_NE(nullptr, client_->makeRequest(request3, callbacks3));
+  EXPECT_TRUE(coalesced_flush_cb->enabled_);
+
+  EXPECT_CALL(callbacks1, onFailure());
+  EXPECT_CALL(callbacks2, onFailure());
+  EXPECT_CALL(callbacks3, onFailure());
+  EXPECT_CALL(*connect_or_op_timer_, disableTimer());
+  upstream_connection_->raiseEvent(Network::ConnectionEvent::RemoteClose);
+  EXPECT_FALSE(coalesced_flush_cb->enabled_);
+}
+
 TEST_F(RedisClientImplTest, Basic) {
   InSequence s;
 
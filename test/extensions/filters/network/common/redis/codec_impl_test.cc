@@ -222,11 +222,13 @@ public:
   void onRespValue(RespValuePtr&& value) override {
     decoded_values_.emplace_back(std::move(value));
   }
+  void onPushValue(RespValuePtr&& value) override { pushed_values_.emplace_back(std::move(value)); }
 
   EncoderImpl encoder_;
   DecoderImpl decoder_;
   Buffer::OwnedImpl buffer_;
   std::vector<RespValuePtr> decoded_values_;
+  std::vector<RespValuePtr> pushed_values_;
 };
 
 TEST_F(RedisEncoderDecoderImplTest, Null) {
@@ -396,6 +398,44 @@ TEST_F(RedisEncoderDecoderImplTest, NestedArray) {
   EXPECT_EQ(value, *decoded_values_[0]);
 }
 
+TEST_F(RedisEncoderDecoderImplTest, OwnedArrayWithLargeBulkString) {
+  std::vector<RespValue> values(3);
+  values[0].type(RespType::BulkString);
+  values[0].asString() = "hello";
+  values[1].type(RespType::BulkString);
+  values[1].asString() = std::string(64 * 1024, 'v');
+  values[2].type(RespType::Null);
+
+  auto value = std::make_unique<RespValue>();
+  value->type(RespType::Array);
+  value->asArray().swap(values);
+  const RespValue copy = *value;
+  encoder_.encode(copy, buffer_);
+  const std::string expected = buffer_.toString();
+  buffer_.drain(buffer_.length());
+
+  // The owned value is encoded the same, with the large bulk string moved to the buffer.
+  encoder_.encodeOwned(std::move(value), buffer_);
+  EXPECT_EQ(expected, buffer_.toString());
+
+  // A bulk string spanning many slices is decoded whole.
+  Buffer::OwnedImpl sliced;
+  for (uint64_t i = 0; i < expected.size(); i += 1000) {
+    sliced.appendSliceForTest(expected.substr(i, 1000));
+  }
+  decoder_.decode(sliced);
+  EXPECT_EQ(copy, *decoded_values_[0]);
+  EXPECT_EQ(0UL, sliced.length());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, BulkStringLengthLargerThanReceived) {
+  // The declared length of a bulk string is not reserved beyond the bytes received.
+  buffer_.add("$1000000000\r\nfoo");
+  decoder_.decode(buffer_);
+  EXPECT_TRUE(decoded_values_.empty());
+  EXPECT_EQ(0UL, buffer_.length());
+}
+
 TEST_F(RedisEncoderDecoderImplTest, NullArray) {
   buffer_.add("*-1\r\n");
   decoder_.decode(buffer_);
@@ -845,6 +885,39 @@ TEST_F(RedisEncoderDecoderImplTest, InvalidInterjectedInlineCommand) {
   EXPECT_THROW(decoder_.decode(buffer_), ProtocolError);
 }
 
+TEST_F(RedisEncoderDecoderImplTest, Resp3TypesRequireResp3) {
+  for (const std::string& value : {"_\r\n", "%0\r\n", ">0\r\n"}) {
+    DecoderImpl decoder(*this);
+    buffer_.add(value);
+    EXPECT_THROW(decoder.decode(buffer_), ProtocolError);
+    buffer_.drain(buffer_.length());
+  }
+}
+
+TEST_F(RedisEncoderDecoderImplTest, Resp3Values) {
+  decoder_.enableResp3();
+  // A null, a map decoded as the array of its keys and values, then a push between two responses.
+  buffer_.add("_\r\n%1\r\n+proto\r\n:3\r\n");
+  buffer_.add(">2\r\n$10\r\ninvalidate\r\n*1\r\n$3\r\nfoo\r\n");
+  buffer_.add("$3\r\nbar\r\n>2\r\n$10\r\ninvalidate\r\n_\r\n");
+  decoder_.decode(buffer_);
+  EXPECT_EQ(0UL, buffer_.length());
+
+  ASSERT_EQ(3UL, decoded_values_.size());
+  EXPECT_EQ(RespType::Null, decoded_values_[0]->type());
+  EXPECT_EQ("[\"proto\", 3]", decoded_values_[1]->toString());
+  EXPECT_EQ("\"bar\"", decoded_values_[2]->toString());
+  ASSERT_EQ(2UL, pushed_values_.size());
+  EXPECT_EQ("[\"invalidate\", [\"foo\"]]", pushed_values_[0]->toString());
+  EXPECT_EQ("[\"invalidate\", null]", pushed_values_[1]->toString());
+}
+
+TEST_F(RedisEncoderDecoderImplTest, Resp3NestedPush) {
+  decoder_.enableResp3();
+  buffer_.add("*1\r\n>0\r\n");
+  EXPECT_THROW(decoder_.decode(buffer_), ProtocolError);
+}
+
 } // namespace Redis
 } // namespace Common
 } // namespace NetworkFilters
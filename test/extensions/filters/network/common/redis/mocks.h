@@ -88,6 +88,7 @@ public:
   MOCK_METHOD(PoolRequest*, makeRequest_,
               (const Common::Redis::RespValue& request, ClientCallbacks& callbacks));
   MOCK_METHOD(void, initialize, (const std::string& username, const std::string& password));
+  MOCK_METHOD(void, enableTracking, (PushCallbacks & push_callbacks, ClientCallbacks& callbacks));
   MOCK_METHOD(void, sendAwsIamAuth,
               (const std::string& auth_username,
                const envoy::extensions::filters::network::redis_proxy::v3::AwsIam& aws_iam_config));
@@ -123,6 +123,23 @@ TEST(DubboRequestTest, OneWayDubboRequestTest) {
   }
 }
 
+TEST(DubboRequestTest, SetStreamId) {
+  DubboRequest request(createDubboRequst(true));
+  request.setStreamId(42);
+
+  EXPECT_EQ(request.frameFlags().streamId(), 42);
+  EXPECT_EQ(request.frameFlags().oneWayStream(), true);
+  EXPECT_EQ(request.inner_metadata_->requestId(), 42);
+
+  DubboResponse response(
+      createDubboResponse(request, ResponseStatus::Ok, RpcResponseType::ResponseWithValue));
+  EXPECT_EQ(response.frameFlags().streamId(), 42);
+  response.setStreamId(123456);
+  EXPECT_EQ(response.frameFlags().streamId(), 123456);
+  EXPECT_EQ(response.frameFlags().endStream(), true);
+  EXPECT_EQ(response.inner_metadata_->requestId(), 123456);
+}
+
 TEST(DubboResponseTest, DubboResponseTest) {
   DubboRequest request(createDubboRequst(false));
 
@@ -571,6 +588,7 @@ TEST(DubboCodecFactoryTest, DubboCodecFactoryTest) {
 
   EXPECT_NE(nullptr, factory.createClientCodec().get());
   EXPECT_NE(nullptr, factory.createServerCodec().get());
+  EXPECT_TRUE(factory.supportsStreamIdRewrite());
 }
 
 TEST(DubboCodecFactoryConfigTest, DubboCodecFactoryConfigTest) {
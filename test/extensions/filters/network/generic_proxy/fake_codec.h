@@ -32,6 +32,10 @@ public:
 
   // StreamFrame
   FrameFlags frameFlags() const override { return stream_frame_flags_; }
+  void setStreamId(uint64_t stream_id) override {
+    stream_frame_flags_ =
+        FrameFlags(stream_id, stream_frame_flags_.rawFlags(), stream_frame_flags_.frameTags());
+  }
 
   FrameFlags stream_frame_flags_;
 
@@ -79,6 +79,7 @@ public:
 
   MOCK_METHOD(ServerCodecPtr, createServerCodec, (), (const));
   MOCK_METHOD(ClientCodecPtr, createClientCodec, (), (const));
+  MOCK_METHOD(bool, supportsStreamIdRewrite, (), (const));
 };
 
 class MockProxyFactory : public ProxyFactory {
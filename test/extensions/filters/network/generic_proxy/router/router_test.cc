@@ -49,6 +49,7 @@ public:
   MOCK_METHOD(ClientCodec&, clientCodec, ());
   MOCK_METHOD(OptRef<Network::Connection>, upstreamConnection, ());
   MOCK_METHOD(void, cleanUp, (bool close_connection));
+  MOCK_METHOD(absl::optional<uint64_t>, allocateStreamId, ());
 
   std::shared_ptr<Upstream::MockHostDescription> host_description_ =
       std::make_shared<NiceMock<Upstream::MockHostDescription>>();
@@ -63,6 +64,10 @@ public:
               (Upstream::ThreadLocalCluster&, Upstream::LoadBalancerContext*, Network::Connection&,
                const CodecFactory&, bool),
               (const));
+  MOCK_METHOD(GenericUpstreamSharedPtr, createMultiplexedGenericUpstream,
+              (Upstream::ThreadLocalCluster&, Upstream::LoadBalancerContext*,
+               const CodecFactory&, MultiplexedGenericUpstreams&),
+              (const));
 };
 
 class RouterFilterTest : public testing::Test {
@@ -85,10 +90,15 @@ public:
             StreamInfo::FilterState::LifeSpan::Connection);
   }
 
-  void setup(FrameFlags frame_flags = FrameFlags{}, bool bound_upstream_connection = false) {
+  void setup(FrameFlags frame_flags = FrameFlags{}, bool bound_upstream_connection = false,
+             bool multiplex_upstream_connections = false) {
     envoy::extensions::filters::network::generic_proxy::router::v3::Router router_config;
     router_config.set_bind_upstream_connection(bound_upstream_connection);
-    config_ = std::make_shared<Router::RouterConfig>(router_config);
+    if (multiplex_upstream_connections) {
+      router_config.mutable_multiplex_upstream_connections();
+    }
+    config_ = std::make_shared<Router::RouterConfig>(
+        router_config, factory_context_.server_factory_context_.thread_local_);
 
     filter_ =
         std::make_shared<Router::RouterFilter>(config_, factory_context_, &mock_upstream_factory_);
@@ -650,6 +660,78 @@ TEST_F(RouterFilterTest, UpstreamRequestPoolReadyAndResponse) {
   mock_downstream_connection_.raiseEvent(Network::ConnectionEvent::RemoteClose);
 }
 
+TEST_F(RouterFilterTest, MultiplexedUpstreamRewritesStreamIds) {
+  setup(FrameFlags(7), false, true);
+  ON_CALL(mock_codec_factory_, supportsStreamIdRewrite()).WillByDefault(Return(true));
+
+  EXPECT_CALL(mock_filter_callback_, tracingConfig())
+      .WillOnce(Return(OptRef<const Tracing::Config>{}));
+  EXPECT_CALL(mock_upstream_factory_, createMultiplexedGenericUpstream(_, _, _, _))
+      .WillOnce(Return(mock_generic_upstream_));
+  EXPECT_CALL(*mock_generic_upstream_, allocateStreamId()).WillOnce(Return(100));
+  EXPECT_CALL(*mock_generic_upstream_, appendUpstreamRequest(100, _));
+  EXPECT_EQ(filter_->decodeHeaderFrame(*request_), HeaderFilterStatus::StopIteration);
+
+  // The request is sent with the stream id of the upstream, which is then restored.
+  EXPECT_CALL(mock_generic_upstream_->mock_client_codec_, encode(_, _))
+      .WillOnce(Invoke([](const StreamFrame& frame, EncodingContext&) -> EncodingResult {
+        EXPECT_EQ(100, frame.frameFlags().streamId());
+        return 0;
+      }));
+  notifyUpstreamSuccess();
+  EXPECT_EQ(7, request_->frameFlags().streamId());
+
+  // The response is sent to the downstream with the stream id of the request.
+  EXPECT_CALL(mock_filter_callback_, onResponseHeaderFrame(_))
+      .WillOnce(Invoke([](ResponsePtr response) {
+        EXPECT_EQ(7, response->frameFlags().streamId());
+      }));
+  EXPECT_CALL(*mock_generic_upstream_, removeUpstreamRequest(100));
+  EXPECT_CALL(*mock_generic_upstream_, cleanUp(false));
+  auto response = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+  response->stream_frame_flags_ = FrameFlags(100);
+  notifyDecodingSuccess(std::move(response), {});
+
+  cleanUp();
+}
+
+TEST_F(RouterFilterTest, MultiplexedUpstreamLocalResetKeepsConnection) {
+  setup(FrameFlags(7), false, true);
+  ON_CALL(mock_codec_factory_, supportsStreamIdRewrite()).WillByDefault(Return(true));
+
+  EXPECT_CALL(mock_upstream_factory_, createMultiplexedGenericUpstream(_, _, _, _))
+      .WillOnce(Return(mock_generic_upstream_));
+  EXPECT_CALL(*mock_generic_upstream_, allocateStreamId()).WillOnce(Return(100));
+  EXPECT_EQ(filter_->decodeHeaderFrame(*request_), HeaderFilterStatus::StopIteration);
+
+  // The connection is shared with other downstream connections and is not closed.
+  EXPECT_CALL(*mock_generic_upstream_, removeUpstreamRequest(100));
+  EXPECT_CALL(*mock_generic_upstream_, cleanUp(false));
+  cleanUp();
+}
+
+TEST_F(RouterFilterTest, MultiplexedUpstreamWithoutStreamIdRewrite) {
+  setup(FrameFlags(7), false, true);
+  ON_CALL(mock_codec_factory_, supportsStreamIdRewrite()).WillByDefault(Return(false));
+
+  // Falls back to an upstream connection per request.
+  EXPECT_CALL(mock_upstream_factory_, createMultiplexedGenericUpstream(_, _, _, _)).Times(0);
+  kickOffNewUpstreamRequest(false);
+
+  EXPECT_CALL(*mock_generic_upstream_, cleanUp(true));
+  cleanUp();
+}
+
+TEST_F(RouterFilterTest, BindAndMultiplexUpstreamConnections) {
+  envoy::extensions::filters::network::generic_proxy::router::v3::Router router_config;
+  router_config.set_bind_upstream_connection(true);
+  router_config.mutable_multiplex_upstream_connections();
+  EXPECT_THROW_WITH_MESSAGE(
+      RouterConfig(router_config, factory_context_.server_factory_context_.thread_local_),
+      EnvoyException,
+      "bind_upstream_connection and multiplex_upstream_connections cannot be set together");
+}
+
 TEST_F(RouterFilterTest, UpstreamRequestPoolReadyButDecodeFailureAfterResponse) {
   setup();
   kickOffNewUpstreamRequest(false);
@@ -122,6 +122,12 @@ public:
       return std::dynamic_pointer_cast<BoundGenericUpstream>(result);
     }
   }
+  std::shared_ptr<MultiplexedGenericUpstream>
+  createMultiplexedGenericUpstream(MultiplexedGenericUpstreams& upstreams) {
+    auto result = DefaultGenericUpstreamFactory::get().createMultiplexedGenericUpstream(
+        thread_local_cluster_, nullptr, mock_codec_factory_, upstreams);
+    return std::dynamic_pointer_cast<MultiplexedGenericUpstream>(result);
+  }
   std::shared_ptr<OwnedGenericUpstream> createOwnedGenericUpstream() {
     auto result = DefaultGenericUpstreamFactory::get().createGenericUpstream(
         thread_local_cluster_, nullptr, mock_downstream_connection_1_, mock_codec_factory_, false);
@@ -935,6 +941,107 @@ TEST_F(UpstreamTest, OwnedGenericUpstreamUpstreamConnectionClose) {
   EXPECT_EQ(0, generic_upstream->waitingResponseRequestsSize());
 }
 
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamsPick) {
+  MultiplexedGenericUpstreams upstreams(2);
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+
+  EXPECT_CALL(thread_local_cluster_, tcpConnPool(_, _)).Times(4);
+  auto generic_upstream1 = createMultiplexedGenericUpstream(upstreams);
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream1->appendUpstreamRequest(generic_upstream1->allocateStreamId().value(),
+                                           &mock_upstream_request_callbacks_1);
+
+  // New connections are created up to the max connections per host, and then the connection
+  // with the fewest active requests is picked.
+  auto generic_upstream2 = createMultiplexedGenericUpstream(upstreams);
+  EXPECT_NE(generic_upstream1, generic_upstream2);
+  EXPECT_EQ(generic_upstream2, createMultiplexedGenericUpstream(upstreams));
+
+  // Draining connections are no longer picked.
+  generic_upstream2->cleanUp(true);
+  EXPECT_FALSE(generic_upstream2->available());
+  auto generic_upstream3 = createMultiplexedGenericUpstream(upstreams);
+  EXPECT_NE(generic_upstream1, generic_upstream3);
+  EXPECT_NE(generic_upstream2, generic_upstream3);
+
+  EXPECT_CALL(thread_local_cluster_, tcpConnPool(_, _)).WillOnce(Return(absl::nullopt));
+  EXPECT_EQ(nullptr, createMultiplexedGenericUpstream(upstreams));
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamDecodingSuccess) {
+  MultiplexedGenericUpstreams upstreams(1);
+  EXPECT_CALL(thread_local_cluster_, tcpConnPool(_, _)).Times(2);
+  auto generic_upstream = createMultiplexedGenericUpstream(upstreams);
+
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_2;
+
+  const uint64_t stream_id_1 = generic_upstream->allocateStreamId().value();
+  const uint64_t stream_id_2 = generic_upstream->allocateStreamId().value();
+  EXPECT_NE(stream_id_1, stream_id_2);
+
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream->appendUpstreamRequest(stream_id_1, &mock_upstream_request_callbacks_1);
+  generic_upstream->appendUpstreamRequest(stream_id_2, &mock_upstream_request_callbacks_2);
+  EXPECT_EQ(2, generic_upstream->waitingUpstreamRequestsSize());
+
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onUpstreamSuccess());
+  EXPECT_CALL(mock_upstream_request_callbacks_2, onUpstreamSuccess());
+  EXPECT_CALL(*thread_local_cluster_.tcp_conn_pool_.connection_data_, addUpstreamCallbacks(_))
+      .WillOnce(testing::Invoke([&](Tcp::ConnectionPool::UpstreamCallbacks& cb) {
+        mock_upstream_connection_.addConnectionCallbacks(cb);
+      }));
+  thread_local_cluster_.tcp_conn_pool_.poolReady(mock_upstream_connection_);
+  EXPECT_EQ(0, generic_upstream->waitingUpstreamRequestsSize());
+  EXPECT_EQ(2, generic_upstream->waitingResponseRequestsSize());
+
+  // The connection is shared by the new requests.
+  EXPECT_EQ(generic_upstream, createMultiplexedGenericUpstream(upstreams));
+
+  auto response_2 = std::make_unique<FakeStreamCodecFactory::FakeResponse>();
+  response_2->stream_frame_flags_ = FrameFlags(stream_id_2);
+  EXPECT_CALL(*mock_client_codec_raw_, decode(_, _))
+      .WillOnce(testing::Invoke([&](Buffer::Instance&, bool) {
+        EXPECT_CALL(mock_upstream_request_callbacks_2, onDecodingSuccess(_, _));
+        cocec_callbacks_->onDecodingSuccess(std::move(response_2), {});
+      }));
+  Buffer::OwnedImpl fake_buffer;
+  fake_buffer.add("fake data");
+  generic_upstream->onUpstreamData(fake_buffer, false);
+  EXPECT_EQ(1, generic_upstream->waitingResponseRequestsSize());
+
+  // The connection is kept open for the remaining request, even if it is drained.
+  EXPECT_CALL(mock_upstream_connection_, close(_)).Times(0);
+  generic_upstream->cleanUp(true);
+  EXPECT_FALSE(generic_upstream->available());
+  testing::Mock::VerifyAndClearExpectations(&mock_upstream_connection_);
+
+  // And closed after the last request completes.
+  EXPECT_CALL(mock_upstream_connection_, close(_));
+  generic_upstream->removeUpstreamRequest(stream_id_1);
+  generic_upstream->cleanUp(false);
+}
+
+TEST_F(UpstreamTest, MultiplexedGenericUpstreamOnPoolFailure) {
+  MultiplexedGenericUpstreams upstreams(1);
+  EXPECT_CALL(thread_local_cluster_, tcpConnPool(_, _)).Times(2);
+  auto generic_upstream = createMultiplexedGenericUpstream(upstreams);
+
+  NiceMock<MockUpstreamRequestCallbacks> mock_upstream_request_callbacks_1;
+  EXPECT_CALL(thread_local_cluster_.tcp_conn_pool_, newConnection(_));
+  generic_upstream->appendUpstreamRequest(generic_upstream->allocateStreamId().value(),
+                                          &mock_upstream_request_callbacks_1);
+
+  EXPECT_CALL(mock_upstream_request_callbacks_1, onUpstreamFailure(_, _));
+  thread_local_cluster_.tcp_conn_pool_.poolFailure(
+      ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+  EXPECT_EQ(0, generic_upstream->waitingUpstreamRequestsSize());
+  EXPECT_FALSE(generic_upstream->available());
+
+  // A new connection is created for the next request.
+  EXPECT_NE(generic_upstream, createMultiplexedGenericUpstream(upstreams));
+}
+
 } // namespace
 } // namespace Router
 } // namespace GenericProxy
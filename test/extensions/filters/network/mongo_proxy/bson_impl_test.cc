@@ -101,6 +101,130 @@ TEST(BsonImplTest, StringSizeObserved) {
   EXPECT_TRUE(BufferHelper::removeString(buffer) == hello);
 }
 
+DocumentSharedPtr allTypesDocument() {
+  return DocumentImpl::create()
+      ->addString("string", "string")
+      ->addSymbol("symbol", "symbol")
+      ->addDouble("double", 2.1)
+      ->addDocument("document", DocumentImpl::create()->addString("hello", "world"))
+      ->addArray("array", DocumentImpl::create()->addString("0", "foo"))
+      ->addBinary("binary", "binary_value")
+      ->addObjectId("object_id", Field::ObjectId())
+      ->addBoolean("true", true)
+      ->addDatetime("datetime", 1)
+      ->addNull("null")
+      ->addRegex("regex", {"hello", "i"})
+      ->addInt32("int32", 1)
+      ->addTimestamp("timestamp", 1000)
+      ->addInt64("int64", 2)
+      ->addInt32("int32", 3);
+}
+
+TEST(LazyDocumentImplTest, FindWithoutDecoding) {
+  DocumentSharedPtr doc = allTypesDocument();
+  Buffer::OwnedImpl buffer;
+  doc->encode(buffer);
+  BufferHelper::writeInt32(buffer, 1234);
+  DocumentSharedPtr lazy_doc = LazyDocumentImpl::create(buffer);
+  EXPECT_EQ(buffer.length(), sizeof(int32_t));
+  const auto& lazy = dynamic_cast<const LazyDocumentImpl&>(*lazy_doc);
+
+  EXPECT_EQ(lazy_doc->byteSize(), doc->byteSize());
+  Buffer::OwnedImpl encoded;
+  lazy_doc->encode(encoded);
+  Buffer::OwnedImpl expected;
+  doc->encode(expected);
+  EXPECT_EQ(encoded.toString(), expected.toString());
+
+  for (const FieldPtr& field : doc->values()) {
+    const Field* lazy_field = lazy_doc->find(field->key(), field->type());
+    ASSERT_NE(lazy_field, nullptr);
+    EXPECT_TRUE(*lazy_field == *doc->find(field->key(), field->type()));
+  }
+  EXPECT_EQ(lazy_doc->find("int32")->asInt32(), 1);
+  EXPECT_EQ(lazy_doc->find("regex")->asRegex().options_, "i");
+  EXPECT_EQ(lazy_doc->find("document")->asDocument().find("hello")->asString(), "world");
+  EXPECT_EQ(lazy_doc->find("missing"), nullptr);
+  EXPECT_EQ(lazy_doc->find("string", Field::Type::Int32), nullptr);
+  EXPECT_FALSE(lazy.decoded());
+
+  EXPECT_EQ(lazy_doc->toString(), doc->toString());
+  EXPECT_TRUE(lazy.decoded());
+  EXPECT_TRUE(*lazy_doc == *doc);
+  EXPECT_TRUE(*doc == *lazy_doc);
+  EXPECT_EQ(lazy_doc->find("int64")->asInt64(), 2);
+}
+
+TEST(LazyDocumentImplTest, Add) {
+  Buffer::OwnedImpl buffer;
+  allTypesDocument()->encode(buffer);
+  DocumentSharedPtr lazy_doc = LazyDocumentImpl::create(buffer);
+  EXPECT_EQ(lazy_doc->find("int32")->asInt32(), 1);
+
+  DocumentSharedPtr expected = allTypesDocument()->addString("added", "value");
+  EXPECT_EQ(lazy_doc->addString("added", "value"), lazy_doc);
+  EXPECT_EQ(lazy_doc->byteSize(), expected->byteSize());
+  EXPECT_EQ(lazy_doc->find("added")->asString(), "value");
+
+  Buffer::OwnedImpl encoded;
+  lazy_doc->encode(encoded);
+  Buffer::OwnedImpl expected_encoded;
+  expected->encode(expected_encoded);
+  EXPECT_EQ(encoded.toString(), expected_encoded.toString());
+}
+
+TEST(LazyDocumentImplTest, InvalidDocument) {
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 100);
+    EXPECT_THROW(LazyDocumentImpl::create(buffer), EnvoyException);
+  }
+
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 4);
+    EXPECT_THROW(LazyDocumentImpl::create(buffer), EnvoyException);
+  }
+
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 5);
+    uint8_t invalid_document_end = 0x1;
+    buffer.add(&invalid_document_end, sizeof(invalid_document_end));
+    EXPECT_THROW(LazyDocumentImpl::create(buffer), EnvoyException);
+  }
+
+  // The fields are only validated once they are looked up.
+  {
+    Buffer::OwnedImpl buffer;
+    std::string key_name("hello");
+    BufferHelper::writeInt32(buffer, 4 + 1 + key_name.size() + 1 + 1);
+    uint8_t invalid_element_type = 0x20;
+    buffer.add(&invalid_element_type, sizeof(invalid_element_type));
+    BufferHelper::writeCString(buffer, key_name);
+    uint8_t done = 0;
+    buffer.add(&done, sizeof(done));
+    DocumentSharedPtr doc = LazyDocumentImpl::create(buffer);
+    EXPECT_EQ(doc->byteSize(), 12);
+    EXPECT_THROW(doc->find(key_name), EnvoyException);
+    EXPECT_THROW(doc->values(), EnvoyException);
+  }
+
+  // A string overflowing the document.
+  {
+    Buffer::OwnedImpl buffer;
+    BufferHelper::writeInt32(buffer, 4 + 1 + 2 + 4 + 1);
+    uint8_t string_type = static_cast<uint8_t>(Field::Type::String);
+    buffer.add(&string_type, sizeof(string_type));
+    BufferHelper::writeCString(buffer, "a");
+    BufferHelper::writeInt32(buffer, 100);
+    uint8_t done = 0;
+    buffer.add(&done, sizeof(done));
+    DocumentSharedPtr doc = LazyDocumentImpl::create(buffer);
+    EXPECT_THROW(doc->find("a"), EnvoyException);
+  }
+}
+
 } // namespace Bson
 } // namespace MongoProxy
 } // namespace NetworkFilters
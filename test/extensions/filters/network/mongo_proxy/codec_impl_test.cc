@@ -6,11 +6,14 @@
 #include "source/extensions/filters/network/mongo_proxy/codec_impl.h"
 
 #include "test/test_common/printers.h"
+#include "test/test_common/test_runtime.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::Eq;
+using testing::Invoke;
 using testing::NiceMock;
 using testing::Pointee;
 
@@ -165,6 +168,33 @@ TEST_F(MongoCodecImplTest, Reply) {
   decoder_.onData(output_);
 }
 
+TEST_F(MongoCodecImplTest, ReplyLazyDocuments) {
+  ReplyMessageImpl reply(2, 2);
+  reply.numberReturned(1);
+  reply.documents().push_back(Bson::DocumentImpl::create()->addString("hello", "world"));
+
+  // The documents are decoded on demand, keeping their size.
+  encoder_.encodeReply(reply);
+  EXPECT_CALL(callbacks_, decodeReply_(_)).WillOnce(Invoke([](ReplyMessagePtr& message) {
+    const auto& document =
+        dynamic_cast<const Bson::LazyDocumentImpl&>(*message->documents().front());
+    EXPECT_EQ(document.byteSize(), 22);
+    EXPECT_FALSE(document.decoded());
+  }));
+  decoder_.onData(output_);
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.mongo_proxy_lazy_bson_documents", "false"}});
+  DecoderImpl decoder{callbacks_};
+  encoder_.encodeReply(reply);
+  EXPECT_CALL(callbacks_, decodeReply_(_)).WillOnce(Invoke([](ReplyMessagePtr& message) {
+    EXPECT_NE(dynamic_cast<const Bson::DocumentImpl*>(message->documents().front().get()),
+              nullptr);
+  }));
+  decoder.onData(output_);
+}
+
 TEST_F(MongoCodecImplTest, GetMoreEqual) {
   {
     GetMoreMessageImpl g1(0, 0);
@@ -5,9 +5,11 @@
 #include <string>
 #include <vector>
 
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/fmt.h"
 #include "source/common/stats/isolated_store_impl.h"
 #include "source/extensions/filters/network/common/redis/client_impl.h"
+#include "source/extensions/filters/network/common/redis/codec_impl.h"
 #include "source/extensions/filters/network/common/redis/supported_commands.h"
 #include "source/extensions/filters/network/redis_proxy/command_splitter_impl.h"
 #include "source/extensions/filters/network/redis_proxy/router_impl.h"
@@ -82,6 +84,37 @@ public:
       single_mset.asArray()[2].asString() = request->asArray()[i + 1].asString();
     }
   }
+
+  // Encodes the single sets of a request as the upstream client does, writing them to the
+  // connection one at a time or all together.
+  // @return the number of writes.
+  uint64_t encodeAndWrite(Common::Redis::RespValueSharedPtr& request, bool coalesce) {
+    uint64_t writes = 0;
+    for (uint64_t i = 1; i < request->asArray().size(); i += 2) {
+      Common::Redis::RespValue single_set(request, Common::Redis::Utility::SetRequest::instance(),
+                                          i, i + 1);
+      encoder_.encode(single_set, encoder_buffer_);
+      if (!coalesce) {
+        write();
+        writes++;
+      }
+    }
+    if (coalesce) {
+      write();
+      writes++;
+    }
+    return writes;
+  }
+
+private:
+  void write() {
+    connection_buffer_.move(encoder_buffer_);
+    connection_buffer_.drain(connection_buffer_.length());
+  }
+
+  Common::Redis::EncoderImpl encoder_;
+  Buffer::OwnedImpl encoder_buffer_;
+  Buffer::OwnedImpl connection_buffer_;
 };
 } // namespace RedisProxy
 } // namespace NetworkFilters
@@ -133,3 +166,22 @@ static void bmSplitCreateVariant(benchmark::State& state) {
   state.counters["use_count"] = request.use_count();
 }
 BENCHMARK(bmSplitCreateVariant)->Ranges({{1, 100}, {64, 8 << 14}});
+
+// Compares writing the commands sent to an upstream connection one at a time and coalesced within
+// an event loop iteration.
+static void bmEncodeAndWrite(benchmark::State& state) {
+  Envoy::Extensions::NetworkFilters::RedisProxy::CommandSplitSpeedTest context;
+  Envoy::Extensions::NetworkFilters::Common::Redis::RespValueSharedPtr request =
+      context.makeSharedBulkStringArray(state.range(0), 36, state.range(1));
+  const bool coalesce = state.range(2) != 0;
+  uint64_t writes = 0;
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    writes += context.encodeAndWrite(request, coalesce);
+  }
+  state.counters["commands"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * state.range(0)), benchmark::Counter::kIsRate);
+  state.counters["writes"] =
+      benchmark::Counter(static_cast<double>(writes), benchmark::Counter::kIsRate);
+}
+BENCHMARK(bmEncodeAndWrite)->Ranges({{1, 100}, {64, 8 << 14}, {0, 1}});
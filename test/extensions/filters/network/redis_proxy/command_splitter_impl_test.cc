@@ -19,6 +19,7 @@
 #include "test/test_common/simulated_time_system.h"
 
 using testing::_;
+using testing::ByMove;
 using testing::DoAll;
 using testing::InSequence;
 using testing::NiceMock;
@@ -754,6 +755,28 @@ TEST_F(RedisSingleServerRequestTest, CustomCommand) {
   respond();
 }
 
+TEST_F(RedisSingleServerRequestTest, CachedRead) {
+  setupMirrorPolicy();
+
+  Common::Redis::RespValuePtr request{new Common::Redis::RespValue()};
+  makeBulkStringArray(*request, {"get", "foo"});
+  Common::Redis::RespValue cached;
+  cached.type(Common::Redis::RespType::BulkString);
+  cached.asString() = "bar";
+
+  // The cached response is answered right away, without sending nor mirroring the request.
+  EXPECT_CALL(callbacks_, connectionAllowed()).WillOnce(Return(true));
+  EXPECT_CALL(*conn_pool_, cachedRead("foo", _))
+      .WillOnce(Return(ByMove(std::make_unique<Common::Redis::RespValue>(cached))));
+  EXPECT_CALL(*conn_pool_, makeRequest_(_, _, _)).Times(0);
+  EXPECT_CALL(*mirror_conn_pool_, makeRequest_(_, _, _)).Times(0);
+  EXPECT_CALL(callbacks_, onResponse_(PointeesEq(&cached)));
+  handle_ = splitter_.makeRequest(std::move(request), callbacks_, dispatcher_, stream_info_);
+  EXPECT_EQ(nullptr, handle_);
+
+  EXPECT_EQ(1UL, store_.counter("redis.foo.command.get.success").value());
+}
+
 MATCHER_P(CompositeArrayEq, rhs, "CompositeArray should be equal") {
   const ConnPool::RespVariant& obj = arg;
   const auto& lhs = absl::get<const Common::Redis::RespValue>(obj);
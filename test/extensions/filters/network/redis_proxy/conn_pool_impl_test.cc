@@ -94,12 +94,14 @@ public:
         std::make_shared<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>();
     auto redis_command_stats =
         Common::Redis::RedisCommandStats::createRedisCommandStats(store_.symbolTable());
+    auto settings = Common::Redis::Client::createConnPoolSettings(
+        20, hashtagging, true, max_unknown_conns, read_policy_, redis_cx_rate_limit_per_sec);
+    if (read_cache_) {
+      settings.mutable_read_cache();
+    }
     std::shared_ptr<InstanceImpl> conn_pool_impl = std::make_shared<InstanceImpl>(
-        cluster_name_, cm_, *this, tls_,
-        Common::Redis::Client::createConnPoolSettings(20, hashtagging, true, max_unknown_conns,
-                                                      read_policy_, redis_cx_rate_limit_per_sec),
-        api_, store_.rootScope(), redis_command_stats, cluster_refresh_manager_, dns_cache,
-        absl::nullopt, absl::nullopt);
+        cluster_name_, cm_, *this, tls_, settings, api_, store_.rootScope(), redis_command_stats,
+        cluster_refresh_manager_, dns_cache, absl::nullopt, absl::nullopt);
     conn_pool_impl->init();
     // Set the authentication password for this connection pool.
     conn_pool_impl->tls_->getTyped<InstanceImpl::ThreadLocalPool>().auth_username_ = auth_username_;
@@ -336,6 +338,7 @@ public:
   std::shared_ptr<NiceMock<Extensions::Common::Redis::MockClusterRefreshManager>>
       cluster_refresh_manager_;
   Common::Redis::Client::NoOpTransaction transaction_;
+  bool read_cache_{false};
 };
 
 TEST_F(RedisConnPoolImplTest, Basic) {
@@ -369,6 +372,68 @@ TEST_F(RedisConnPoolImplTest, Basic) {
   tls_.shutdownThread();
 };
 
+TEST_F(RedisConnPoolImplTest, ReadCache) {
+  read_cache_ = true;
+  setup();
+
+  auto makeValue = [](std::vector<std::string> strings) {
+    Common::Redis::RespValue value;
+    value.type(Common::Redis::RespType::Array);
+    for (const std::string& string : strings) {
+      Common::Redis::RespValue element;
+      element.type(Common::Redis::RespType::BulkString);
+      element.asString() = string;
+      value.asArray().push_back(std::move(element));
+    }
+    return value;
+  };
+  Common::Redis::RespValueSharedPtr value =
+      std::make_shared<Common::Redis::RespValue>(makeValue({"get", "foo"}));
+  Common::Redis::Client::MockPoolRequest active_request;
+  MockPoolCallbacks callbacks;
+  Common::Redis::Client::MockClient* client = new NiceMock<Common::Redis::Client::MockClient>();
+  Common::Redis::Client::PushCallbacks* push_callbacks{};
+  Common::Redis::Client::ClientCallbacks* tracking_callbacks{};
+
+  // The GET commands are sent on a tracking client.
+  EXPECT_EQ(nullptr, conn_pool_->cachedRead("foo", *value));
+  EXPECT_CALL(cm_.thread_local_cluster_.lb_, chooseHost(_))
+      .WillOnce(Return(cm_.thread_local_cluster_.lb_.host_));
+  EXPECT_CALL(*this, create_(_)).WillOnce(Return(client));
+  EXPECT_CALL(*client, enableTracking(_, _))
+      .WillOnce(Invoke([&](Common::Redis::Client::PushCallbacks& push,
+                           Common::Redis::Client::ClientCallbacks& tracking) {
+        push_callbacks = &push;
+        tracking_callbacks = &tracking;
+      }));
+  EXPECT_CALL(*client, makeRequest_(Ref(*value), _)).WillOnce(Return(&active_request));
+  EXPECT_NE(nullptr, conn_pool_->makeRequest("foo", value, callbacks, transaction_));
+  ASSERT_NE(nullptr, push_callbacks);
+
+  Common::Redis::RespValuePtr ok{new Common::Redis::RespValue()};
+  ok->type(Common::Redis::RespType::SimpleString);
+  ok->asString() = "OK";
+  tracking_callbacks->onResponse(std::move(ok));
+  Common::Redis::RespValuePtr response{new Common::Redis::RespValue()};
+  response->type(Common::Redis::RespType::BulkString);
+  response->asString() = "bar";
+  EXPECT_CALL(callbacks, onResponse_(_));
+  client->client_callbacks_.back()->onResponse(std::move(response));
+
+  Common::Redis::RespValuePtr cached = conn_pool_->cachedRead("foo", *value);
+  ASSERT_NE(nullptr, cached);
+  EXPECT_EQ("bar", cached->asString());
+
+  // The host pushes the invalidation of the key.
+  Common::Redis::RespValue invalidate = makeValue({"invalidate", "foo"});
+  invalidate.asArray()[1] = makeValue({"foo"});
+  push_callbacks->onPush(std::make_unique<Common::Redis::RespValue>(invalidate));
+  EXPECT_EQ(nullptr, conn_pool_->cachedRead("foo", *value));
+
+  EXPECT_CALL(*client, close());
+  tls_.shutdownThread();
+}
+
 TEST_F(RedisConnPoolImplTest, ShardSize) {
   InSequence s;
 
@@ -100,6 +100,8 @@ public:
     return makeRequestToShard_(shard_index, request, callbacks);
   }
 
+  MOCK_METHOD(Common::Redis::RespValuePtr, cachedRead,
+              (const std::string& hash_key, const Common::Redis::RespValue& request));
   MOCK_METHOD(uint16_t, shardSize_, ());
   MOCK_METHOD(Common::Redis::Client::PoolRequest*, makeRequest_,
               (const std::string& hash_key, RespVariant& request, PoolCallbacks& callbacks));
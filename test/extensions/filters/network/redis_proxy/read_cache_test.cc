@@ -0,0 +1,116 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/filters/network/redis_proxy/v3/redis_proxy.pb.h"
+
+#include "source/extensions/filters/network/redis_proxy/read_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace NetworkFilters {
+namespace RedisProxy {
+namespace ConnPool {
+namespace {
+
+Common::Redis::RespValue makeBulkString(const std::string& string) {
+  Common::Redis::RespValue value;
+  value.type(Common::Redis::RespType::BulkString);
+  value.asString() = string;
+  return value;
+}
+
+Common::Redis::RespValue makeArray(std::vector<Common::Redis::RespValue> values) {
+  Common::Redis::RespValue value;
+  value.type(Common::Redis::RespType::Array);
+  value.asArray().swap(values);
+  return value;
+}
+
+class RedisReadCacheTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  void initialize(const std::string& yaml) {
+    envoy::extensions::filters::network::redis_proxy::v3::RedisProxy::ReadCache config;
+    TestUtility::loadFromYaml(yaml, config);
+    cache_ = std::make_unique<ReadCache>(config, simTime());
+  }
+
+  ReadCachePtr cache_;
+};
+
+TEST(RedisReadCacheCommandTest, IsCacheableRead) {
+  EXPECT_TRUE(ReadCache::isCacheableRead(makeArray({makeBulkString("GET"), makeBulkString("a")})));
+  EXPECT_TRUE(ReadCache::isCacheableRead(makeArray({makeBulkString("get"), makeBulkString("a")})));
+  EXPECT_FALSE(ReadCache::isCacheableRead(
+      makeArray({makeBulkString("set"), makeBulkString("a"), makeBulkString("b")})));
+  EXPECT_FALSE(
+      ReadCache::isCacheableRead(makeArray({makeBulkString("getdel"), makeBulkString("a")})));
+  EXPECT_FALSE(ReadCache::isCacheableRead(makeBulkString("get")));
+}
+
+TEST_F(RedisReadCacheTest, LookupAndExpiry) {
+  initialize("ttl: 1s");
+  EXPECT_EQ(cache_->lookup("a"), nullptr);
+  cache_->insert("a", makeBulkString("value"));
+  Common::Redis::RespValuePtr response = cache_->lookup("a");
+  ASSERT_NE(response, nullptr);
+  EXPECT_EQ(*response, makeBulkString("value"));
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  EXPECT_EQ(cache_->lookup("a"), nullptr);
+  EXPECT_EQ(cache_->size(), 0);
+}
+
+TEST_F(RedisReadCacheTest, OnlyCachesSmallBulkStrings) {
+  initialize("max_value_bytes: 4");
+  cache_->insert("a", makeBulkString("1234"));
+  EXPECT_NE(cache_->lookup("a"), nullptr);
+
+  // A value that is no longer cacheable evicts the previous one.
+  cache_->insert("a", makeBulkString("12345"));
+  EXPECT_EQ(cache_->lookup("a"), nullptr);
+  cache_->insert("b", Common::Redis::RespValue());
+  EXPECT_EQ(cache_->size(), 0);
+}
+
+TEST_F(RedisReadCacheTest, EvictsLeastRecentlyUsed) {
+  initialize("max_entries: 2");
+  cache_->insert("a", makeBulkString("1"));
+  cache_->insert("b", makeBulkString("2"));
+  EXPECT_NE(cache_->lookup("a"), nullptr);
+  cache_->insert("c", makeBulkString("3"));
+  EXPECT_EQ(cache_->size(), 2);
+  EXPECT_NE(cache_->lookup("a"), nullptr);
+  EXPECT_EQ(cache_->lookup("b"), nullptr);
+  EXPECT_NE(cache_->lookup("c"), nullptr);
+}
+
+TEST_F(RedisReadCacheTest, Invalidate) {
+  initialize("{}");
+  cache_->insert("a", makeBulkString("1"));
+  cache_->insert("b", makeBulkString("2"));
+  cache_->insert("c", makeBulkString("3"));
+
+  EXPECT_EQ(cache_->invalidate(makeArray({makeBulkString("message"), makeBulkString("a")})), 0);
+  const Common::Redis::RespValue keys = makeArray({makeBulkString("a"), makeBulkString("d")});
+  EXPECT_EQ(cache_->invalidate(makeArray({makeBulkString("invalidate"), keys})), 1);
+  EXPECT_EQ(cache_->lookup("a"), nullptr);
+  EXPECT_NE(cache_->lookup("b"), nullptr);
+
+  // The host flushed its databases.
+  const Common::Redis::RespValue null_keys;
+  EXPECT_EQ(cache_->invalidate(makeArray({makeBulkString("invalidate"), null_keys})), 2);
+  EXPECT_EQ(cache_->size(), 0);
+}
+
+} // namespace
+} // namespace ConnPool
+} // namespace RedisProxy
+} // namespace NetworkFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -1502,6 +1502,84 @@ TEST_F(CompactProtocolTest, WriteBinary) {
             buffer.toString());
 }
 
+TEST_F(CompactProtocolTest, PeekStructLength) {
+  CompactProtocolImpl proto;
+  Buffer::OwnedImpl buffer;
+  proto.writeStructBegin(buffer, "");
+  proto.writeFieldBegin(buffer, "", FieldType::I32, 1);
+  proto.writeInt32(buffer, 100);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::Bool, 2);
+  proto.writeBool(buffer, true);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::String, 3);
+  proto.writeString(buffer, "abc");
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::List, 4);
+  proto.writeListBegin(buffer, FieldType::I64, 2);
+  proto.writeInt64(buffer, 1);
+  proto.writeInt64(buffer, -1);
+  proto.writeListEnd(buffer);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::Map, 5);
+  proto.writeMapBegin(buffer, FieldType::Bool, FieldType::Struct, 1);
+  proto.writeBool(buffer, false);
+  proto.writeStructBegin(buffer, "");
+  proto.writeFieldBegin(buffer, "", FieldType::Double, 1);
+  proto.writeDouble(buffer, 1.0);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::Stop, 0);
+  proto.writeStructEnd(buffer);
+  proto.writeMapEnd(buffer);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::Map, 6);
+  proto.writeMapBegin(buffer, FieldType::I16, FieldType::I16, 0);
+  proto.writeMapEnd(buffer);
+  proto.writeFieldEnd(buffer);
+  proto.writeFieldBegin(buffer, "", FieldType::Stop, 0);
+  proto.writeStructEnd(buffer);
+  const uint64_t struct_length = buffer.length();
+
+  // The bytes following the struct are not part of it.
+  buffer.writeByte(0);
+  uint64_t length = 0;
+  EXPECT_TRUE(proto.peekStructLength(buffer, length));
+  EXPECT_EQ(struct_length, length);
+  EXPECT_EQ(struct_length + 1, buffer.length());
+
+  // Every truncated struct needs more data.
+  for (uint64_t i = 0; i < struct_length; i++) {
+    Buffer::OwnedImpl truncated(buffer.toString().substr(0, i));
+    EXPECT_FALSE(proto.peekStructLength(truncated, length)) << i;
+    EXPECT_EQ(i, truncated.length());
+  }
+}
+
+TEST_F(CompactProtocolTest, PeekStructLengthErrors) {
+  CompactProtocolImpl proto;
+  uint64_t length;
+
+  // Negative string length.
+  {
+    Buffer::OwnedImpl buffer;
+    proto.writeFieldBegin(buffer, "", FieldType::String, 1);
+    addSeq(buffer, {0xFF, 0xFF, 0xFF, 0xFF, 0x0F}); // -1
+    EXPECT_THROW_WITH_REGEX(proto.peekStructLength(buffer, length), EnvoyException,
+                            "negative .* string/binary length");
+  }
+
+  // Nesting too deep.
+  {
+    Buffer::OwnedImpl buffer;
+    for (uint32_t i = 0; i <= Protocol::MaxPeekDepth; i++) {
+      proto.writeStructBegin(buffer, "");
+      proto.writeFieldBegin(buffer, "", FieldType::Struct, 1);
+    }
+    EXPECT_THROW_WITH_REGEX(proto.peekStructLength(buffer, length), EnvoyException,
+                            "exceeds the nesting limit");
+  }
+}
+
 } // namespace ThriftProxy
 } // namespace NetworkFilters
 } // namespace Extensions
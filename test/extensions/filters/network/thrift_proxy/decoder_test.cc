@@ -1339,6 +1339,53 @@ TEST(DecoderTest, OnDataPassthroughResumes) {
   EXPECT_FALSE(underflow); // buffer.length() == 1
 }
 
+// Without a frame size, the length of the payload is peeked from the protocol.
+TEST(DecoderTest, OnDataPassthroughUnframed) {
+  NiceMock<MockTransport> transport;
+  NiceMock<MockProtocol> proto;
+  NiceMock<MockDecoderCallbacks> callbacks;
+  NiceMock<MockDecoderEventHandler> handler;
+  ON_CALL(callbacks, newDecoderEventHandler()).WillByDefault(ReturnRef(handler));
+
+  InSequence dummy;
+
+  Decoder decoder(transport, proto, callbacks);
+  Buffer::OwnedImpl buffer(std::string(10, 'a'));
+
+  EXPECT_CALL(transport, decodeFrameStart(Ref(buffer), _)).WillOnce(Return(true));
+  EXPECT_CALL(proto, readMessageBegin(_, _))
+      .WillOnce(Invoke([&](Buffer::Instance&, MessageMetadata& metadata) -> bool {
+        metadata.setMethodName("name");
+        metadata.setMessageType(MessageType::Call);
+        metadata.setSequenceId(100);
+        return true;
+      }));
+  EXPECT_CALL(callbacks, passthroughEnabled()).WillOnce(Return(true));
+  EXPECT_CALL(proto, peekStructLength(Ref(buffer), _)).WillOnce(Return(false));
+  EXPECT_CALL(handler, passthroughData(_)).Times(0);
+
+  bool underflow = false;
+  EXPECT_EQ(FilterStatus::Continue, decoder.onData(buffer, underflow));
+  EXPECT_TRUE(underflow);
+
+  buffer.add(std::string(90, 'a'));
+  EXPECT_CALL(proto, peekStructLength(Ref(buffer), _))
+      .WillOnce(Invoke([&](Buffer::Instance&, uint64_t& length) -> bool {
+        length = 60;
+        return true;
+      }));
+  EXPECT_CALL(handler, passthroughData(_))
+      .WillOnce(Invoke([&](Buffer::Instance& data) -> FilterStatus {
+        EXPECT_EQ(60, data.length());
+        return FilterStatus::Continue;
+      }));
+  EXPECT_CALL(proto, readMessageEnd(_)).WillOnce(Return(true));
+  EXPECT_CALL(transport, decodeFrameEnd(_)).WillOnce(Return(true));
+
+  EXPECT_EQ(FilterStatus::Continue, decoder.onData(buffer, underflow));
+  EXPECT_EQ(40, buffer.length());
+}
+
 TEST(DecoderTest, OnDataPassthroughResumesTransportFrameStart) {
   StrictMock<MockTransport> transport;
   StrictMock<MockProtocol> proto;
@@ -67,6 +67,7 @@ public:
   MOCK_METHOD(bool, readMessageBegin, (Buffer::Instance & buffer, MessageMetadata& metadata));
   MOCK_METHOD(bool, readMessageEnd, (Buffer::Instance & buffer));
   MOCK_METHOD(bool, peekReplyPayload, (Buffer::Instance & buffer, ReplyType& reply_type));
+  MOCK_METHOD(bool, peekStructLength, (Buffer::Instance & buffer, uint64_t& length));
   MOCK_METHOD(bool, readStructBegin, (Buffer::Instance & buffer, std::string& name));
   MOCK_METHOD(bool, readStructEnd, (Buffer::Instance & buffer));
   MOCK_METHOD(bool, readFieldBegin,
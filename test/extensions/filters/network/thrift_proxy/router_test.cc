@@ -705,6 +705,60 @@ class ThriftRouterPassthroughTest
           std::tuple<TransportType, ProtocolType, TransportType, ProtocolType>>,
       public ThriftRouterTestBase {
 public:
+  void testPassthroughEnable(bool unframed_passthrough) {
+    TransportType downstream_transport_type;
+    ProtocolType downstream_protocol_type;
+    TransportType upstream_transport_type;
+    ProtocolType upstream_protocol_type;
+
+    TestScopedRuntime scoped_runtime;
+    scoped_runtime.mergeValues(
+        {{"envoy.reloadable_features.thrift_unframed_payload_passthrough",
+          unframed_passthrough ? "true" : "false"}});
+
+    std::tie(downstream_transport_type, downstream_protocol_type, upstream_transport_type,
+             upstream_protocol_type) = GetParam();
+
+    constexpr absl::string_view yaml_string = R"EOF(
+    transport: {}
+    protocol: {}
+    )EOF";
+
+    envoy::extensions::filters::network::thrift_proxy::v3::ThriftProtocolOptions configuration;
+    TestUtility::loadFromYaml(fmt::format(yaml_string,
+                                          TransportNames::get().fromType(upstream_transport_type),
+                                          ProtocolNames::get().fromType(upstream_protocol_type)),
+                              configuration);
+
+    const auto protocol_option = std::make_shared<ProtocolOptionsConfigImpl>(configuration);
+    EXPECT_CALL(
+        *context_.server_factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_,
+        extensionProtocolOptions(_))
+        .WillRepeatedly(Return(protocol_option));
+
+    initializeRouter();
+    startRequest(MessageType::Call, "method", false, downstream_transport_type,
+                 downstream_protocol_type);
+
+    bool passthroughSupported = false;
+    if ((unframed_passthrough || (downstream_transport_type == TransportType::Framed &&
+                                  upstream_transport_type == TransportType::Framed)) &&
+        downstream_protocol_type == upstream_protocol_type &&
+        downstream_protocol_type != ProtocolType::Twitter) {
+      passthroughSupported = true;
+    }
+    ASSERT_EQ(passthroughSupported, router_->passthroughSupported());
+
+    EXPECT_CALL(callbacks_, sendLocalReply(_, _))
+        .WillOnce(Invoke([&](const DirectResponse& response, bool end_stream) -> void {
+          auto& app_ex = dynamic_cast<const AppException&>(response);
+          EXPECT_EQ(AppExceptionType::InternalError, app_ex.type_);
+          EXPECT_THAT(app_ex.what(), ContainsRegex(".*connection failure.*"));
+          EXPECT_TRUE(end_stream);
+        }));
+    context_.server_factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_
+        .poolFailure(ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+  }
 };
 
 static std::string downstreamUpstreamTypesToString(
@@ -1839,54 +1893,10 @@ TEST_P(ThriftRouterContainerTest, DecoderFilterCallbacks) {
   destroyRouter();
 }
 
-TEST_P(ThriftRouterPassthroughTest, PassthroughEnable) {
-  TransportType downstream_transport_type;
-  ProtocolType downstream_protocol_type;
-  TransportType upstream_transport_type;
-  ProtocolType upstream_protocol_type;
-
-  std::tie(downstream_transport_type, downstream_protocol_type, upstream_transport_type,
-           upstream_protocol_type) = GetParam();
+TEST_P(ThriftRouterPassthroughTest, PassthroughEnable) { testPassthroughEnable(true); }
 
-  constexpr absl::string_view yaml_string = R"EOF(
-  transport: {}
-  protocol: {}
-  )EOF";
-
-  envoy::extensions::filters::network::thrift_proxy::v3::ThriftProtocolOptions configuration;
-  TestUtility::loadFromYaml(fmt::format(yaml_string,
-                                        TransportNames::get().fromType(upstream_transport_type),
-                                        ProtocolNames::get().fromType(upstream_protocol_type)),
-                            configuration);
-
-  const auto protocol_option = std::make_shared<ProtocolOptionsConfigImpl>(configuration);
-  EXPECT_CALL(
-      *context_.server_factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_,
-      extensionProtocolOptions(_))
-      .WillRepeatedly(Return(protocol_option));
-
-  initializeRouter();
-  startRequest(MessageType::Call, "method", false, downstream_transport_type,
-               downstream_protocol_type);
-
-  bool passthroughSupported = false;
-  if (downstream_transport_type == upstream_transport_type &&
-      downstream_transport_type == TransportType::Framed &&
-      downstream_protocol_type == upstream_protocol_type &&
-      downstream_protocol_type != ProtocolType::Twitter) {
-    passthroughSupported = true;
-  }
-  ASSERT_EQ(passthroughSupported, router_->passthroughSupported());
-
-  EXPECT_CALL(callbacks_, sendLocalReply(_, _))
-      .WillOnce(Invoke([&](const DirectResponse& response, bool end_stream) -> void {
-        auto& app_ex = dynamic_cast<const AppException&>(response);
-        EXPECT_EQ(AppExceptionType::InternalError, app_ex.type_);
-        EXPECT_THAT(app_ex.what(), ContainsRegex(".*connection failure.*"));
-        EXPECT_TRUE(end_stream);
-      }));
-  context_.server_factory_context_.cluster_manager_.thread_local_cluster_.tcp_conn_pool_
-      .poolFailure(ConnectionPool::PoolFailureReason::RemoteConnectionFailure);
+TEST_P(ThriftRouterPassthroughTest, PassthroughEnableUnframedDisabled) {
+  testPassthroughEnable(false);
 }
 
 TEST_F(ThriftRouterTest, RequestResponseSize) {
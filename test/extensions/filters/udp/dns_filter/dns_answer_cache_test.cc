@@ -0,0 +1,68 @@
+#include "source/common/buffer/buffer_impl.h"
+#include "source/extensions/filters/udp/dns_filter/dns_answer_cache.h"
+
+#include "test/test_common/simulated_time_system.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace UdpFilters {
+namespace DnsFilter {
+namespace {
+
+class DnsAnswerCacheTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  static std::string lookup(DnsAnswerCache& cache, absl::string_view query, uint16_t query_id) {
+    Buffer::OwnedImpl response;
+    if (!cache.lookup(DnsAnswerCache::key(Buffer::OwnedImpl(query)), query_id, response)) {
+      return "";
+    }
+    return response.toString();
+  }
+
+  static void insert(DnsAnswerCache& cache, absl::string_view query, absl::string_view response,
+                     std::chrono::seconds ttl) {
+    cache.insert(DnsAnswerCache::key(Buffer::OwnedImpl(query)), Buffer::OwnedImpl(response), ttl);
+  }
+};
+
+// The queries differing only by their ID share the response, which is returned with their ID.
+TEST_F(DnsAnswerCacheTest, KeyIgnoresQueryId) {
+  DnsAnswerCache cache(16, simTime());
+  EXPECT_EQ("", DnsAnswerCache::key(Buffer::OwnedImpl("\x01\x02")));
+
+  insert(cache, "\x01\x02query", "\x01\x02response", std::chrono::seconds(10));
+  EXPECT_EQ("\x03\x04response", lookup(cache, "\x05\x06query", 0x0304));
+  EXPECT_EQ("", lookup(cache, "\x01\x02other", 0x0102));
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ("", lookup(cache, "\x01\x02query", 0x0102));
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(DnsAnswerCacheTest, ZeroTtlNotCached) {
+  DnsAnswerCache cache(16, simTime());
+  insert(cache, "\x01\x02query", "\x01\x02response", std::chrono::seconds(10));
+  insert(cache, "\x01\x02query", "\x01\x02response", std::chrono::seconds(0));
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(DnsAnswerCacheTest, EvictsLeastRecentlyUsedResponses) {
+  DnsAnswerCache cache(2, simTime());
+  insert(cache, "\x01\x02one", "\x01\x02primary", std::chrono::seconds(10));
+  insert(cache, "\x01\x02two", "\x01\x02second", std::chrono::seconds(10));
+  EXPECT_EQ("\x01\x02primary", lookup(cache, "\x01\x02one", 0x0102));
+  insert(cache, "\x01\x02three", "\x01\x02third", std::chrono::seconds(10));
+
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ("\x01\x02primary", lookup(cache, "\x01\x02one", 0x0102));
+  EXPECT_EQ("", lookup(cache, "\x01\x02two", 0x0102));
+  EXPECT_EQ("\x01\x02third", lookup(cache, "\x01\x02three", 0x0102));
+}
+
+} // namespace
+} // namespace DnsFilter
+} // namespace UdpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -977,6 +977,127 @@ TEST_F(DnsFilterTest, ExternalResolutionTimeout) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
 }
 
+TEST_F(DnsFilterTest, AnswerCacheServesRepeatedQueries) {
+  InSequence s;
+
+  setup(forward_query_off_config + "answer_cache: {}\n");
+
+  const std::string domain("www.foo3.com");
+  sendQueryFromClient("10.0.0.1:1000", Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A,
+                                                                 DNS_RECORD_CLASS_IN, 1));
+  EXPECT_EQ(1, config_->stats().answer_cache_misses_.value());
+
+  // The cached response is returned with the ID of the new query.
+  sendQueryFromClient("10.0.0.2:1000", Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A,
+                                                                 DNS_RECORD_CLASS_IN, 2));
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(2, response_ctx_->id_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  ASSERT_EQ(1, response_ctx_->answers_.size());
+  Utils::verifyAddress({"10.0.3.1"}, response_ctx_->answers_.find(domain)->second);
+
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(1, config_->stats().answer_cache_misses_.value());
+  EXPECT_EQ(2, config_->stats().downstream_rx_queries_.value());
+  EXPECT_EQ(2, config_->stats().downstream_tx_responses_.value());
+  EXPECT_EQ(1, config_->stats().a_record_queries_.value());
+
+  // The response is cached for the TTL of its records.
+  simTime().advanceTimeWait(std::chrono::seconds(300));
+  sendQueryFromClient("10.0.0.1:1000", Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A,
+                                                                 DNS_RECORD_CLASS_IN, 3));
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().answer_cache_misses_.value());
+  EXPECT_EQ(2, config_->stats().a_record_queries_.value());
+}
+
+TEST_F(DnsFilterTest, AnswerCacheNegativeResponses) {
+  InSequence s;
+
+  setup(forward_query_off_config + "answer_cache:\n  negative_ttl: 10s\n");
+
+  const std::string query = Utils::buildQueryForDomain("www.api.foo3.com", DNS_RECORD_TYPE_A,
+                                                       DNS_RECORD_CLASS_IN);
+  sendQueryFromClient("10.0.0.1:1000", query);
+  sendQueryFromClient("10.0.0.1:1000", query);
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NAME_ERROR, response_ctx_->getQueryResponseCode());
+  EXPECT_EQ(0, response_ctx_->answers_.size());
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().answer_cache_misses_.value());
+}
+
+// The responses resolved upstream are cached for the lowest TTL of the upstream records.
+TEST_F(DnsFilterTest, AnswerCacheExternalResolution) {
+  InSequence s;
+
+  auto timeout_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*timeout_timer, enableTimer(_, _));
+
+  const std::string expected_address("130.207.244.251");
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_on_config + "answer_cache: {}\n");
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+
+  Network::DnsResolver::ResolveCb resolve_cb;
+  EXPECT_CALL(*resolver_, resolve(domain, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&resolve_cb), Return(&resolver_->active_query_)));
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  EXPECT_CALL(*timeout_timer, disableTimer()).Times(AnyNumber());
+  resolve_cb(Network::DnsResolver::ResolutionStatus::Completed, "",
+             TestUtility::makeDnsResponse({expected_address}, std::chrono::seconds(30)));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+
+  // The resolver is not called again while the response is cached.
+  simTime().advanceTimeWait(std::chrono::seconds(29));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  response_ctx_ = ResponseValidator::createResponseContext(udp_response_, counters_);
+  EXPECT_TRUE(response_ctx_->parse_status_);
+  EXPECT_EQ(DNS_RESPONSE_CODE_NO_ERROR, response_ctx_->getQueryResponseCode());
+  ASSERT_EQ(1, response_ctx_->answers_.size());
+  Utils::verifyAddress({expected_address}, response_ctx_->answers_.begin()->second);
+
+  EXPECT_EQ(1, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(1, config_->stats().external_a_record_queries_.value());
+}
+
+// The queries that timed out upstream are not cached.
+TEST_F(DnsFilterTest, AnswerCacheSkipsTimeouts) {
+  InSequence s;
+
+  auto timeout_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*timeout_timer, enableTimer(_, _));
+
+  const std::string domain("www.foobaz.com");
+  setup(forward_query_on_config + "answer_cache: {}\n");
+
+  const std::string query =
+      Utils::buildQueryForDomain(domain, DNS_RECORD_TYPE_A, DNS_RECORD_CLASS_IN);
+
+  EXPECT_CALL(*resolver_, resolve(domain, _, _)).WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", query);
+  simTime().advanceTimeWait(std::chrono::milliseconds(1500));
+  timeout_timer->invokeCallback();
+
+  auto second_timeout_timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+  EXPECT_CALL(*second_timeout_timer, enableTimer(_, _));
+  EXPECT_CALL(*resolver_, resolve(domain, _, _)).WillOnce(Return(&resolver_->active_query_));
+  sendQueryFromClient("10.0.0.1:1000", query);
+
+  EXPECT_EQ(0, config_->stats().answer_cache_hits_.value());
+  EXPECT_EQ(2, config_->stats().answer_cache_misses_.value());
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(resolver_.get()));
+}
+
 TEST_F(DnsFilterTest, ExternalResolutionTimeout2) {
   InSequence s;
 
@@ -2,6 +2,7 @@
 #include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.h"
 #include "envoy/extensions/filters/udp/udp_proxy/v3/udp_proxy.pb.validate.h"
+#include "envoy/extensions/udp_packet_writer/v3/udp_gso_batch_writer_factory.pb.h"
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/hash.h"
@@ -19,6 +20,7 @@
 #include "test/extensions/filters/udp/udp_proxy/session_filters/psc_setter.pb.h"
 #include "test/mocks/api/mocks.h"
 #include "test/mocks/http/stream_encoder.h"
+#include "test/mocks/network/mocks.h"
 #include "test/mocks/network/socket.h"
 #include "test/mocks/server/factory_context.h"
 #include "test/mocks/server/listener_factory_context.h"
@@ -28,6 +30,8 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/thread_local_cluster.h"
+#include "test/test_common/registry.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/threadsafe_singleton_injector.h"
 
 #include "gmock/gmock.h"
@@ -38,9 +42,11 @@ using testing::ByMove;
 using testing::DoAll;
 using testing::DoDefault;
 using testing::InSequence;
+using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::Return;
 using testing::ReturnNew;
+using testing::ReturnPointee;
 using testing::ReturnRef;
 using testing::SaveArg;
 using testing::Throw;
@@ -62,7 +68,7 @@ public:
 
     std::shared_ptr<TunnelingActiveSession> tunneling_session =
         std::make_shared<TunnelingActiveSession>(*this, std::move(addresses));
-    sessions_.emplace(tunneling_session);
+    sessions_.emplace(tunneling_session->sessionKey(), tunneling_session);
     config_->stats().downstream_sess_active_.inc();
 
     return tunneling_session;
@@ -143,7 +149,9 @@ public:
     void expectWriteToUpstream(const std::string& data, int sys_errno = 0,
                                const Network::Address::Ip* local_ip = nullptr,
                                bool expect_connect = false, int connect_sys_errno = 0) {
-      EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
+      if (idle_timer_ != nullptr) {
+        EXPECT_CALL(*idle_timer_, enableTimer(parent_.config_->sessionTimeout(), nullptr));
+      }
       if (expect_connect) {
         EXPECT_CALL(*socket_->io_handle_, connect(_))
             .WillOnce(Invoke([connect_sys_errno]() -> Api::SysCallIntResult {
@@ -319,7 +327,9 @@ public:
                            bool is_cluster_available = true) {
     test_sessions_.emplace_back(*this, address, is_cluster_available);
     TestSession& new_session = test_sessions_.back();
-    new_session.idle_timer_ = new Event::MockTimer(&callbacks_.udp_listener_.dispatcher_);
+    if (!idle_timer_wheel_) {
+      new_session.idle_timer_ = new Event::MockTimer(&callbacks_.udp_listener_.dispatcher_);
+    }
     if (!is_cluster_available) {
       return;
     }
@@ -447,6 +457,8 @@ use_original_src_ip: true
   StringViewSaver access_log_data_;
   std::vector<std::string> output_;
   bool expect_gro_{};
+  // Set when sessions expire from the filter's idle timer wheel rather than their own timer.
+  bool idle_timer_wheel_{};
   const Network::Address::InstanceConstSharedPtr upstream_address_;
   const Network::Address::InstanceConstSharedPtr peer_address_;
   const std::vector<Network::SocketOptionName> transparent_options_{ENVOY_SOCKET_IP_TRANSPARENT,
@@ -672,6 +684,68 @@ matcher:
   EXPECT_EQ(output_.front(), "2 1");
 }
 
+// Idle timeout flow with the idle timer wheel.
+TEST_F(UdpProxyFilterTest, IdleTimerWheel) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.udp_proxy_idle_timer_wheel", "true"}});
+  MonotonicTime now;
+  ON_CALL(callbacks_.udp_listener_.dispatcher_, approximateMonotonicTime())
+      .WillByDefault(ReturnPointee(&now));
+  auto* wheel_timer = new NiceMock<Event::MockTimer>(&callbacks_.udp_listener_.dispatcher_);
+  idle_timer_wheel_ = true;
+
+  // The default 60s timeout makes 1875ms wide buckets.
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+  )EOF"));
+  factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_.cluster_.info_
+      ->resetResourceManager(2, 0, 0, 0, 0);
+
+  expectSessionCreate(upstream_address_);
+  test_sessions_[0].expectWriteToUpstream("hello", 0, nullptr, true);
+  EXPECT_CALL(*wheel_timer, enableTimer(std::chrono::milliseconds(60000), nullptr));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+
+  // Activity only updates the time stamp of the session.
+  now += std::chrono::seconds(30);
+  test_sessions_[0].expectWriteToUpstream("hello2");
+  EXPECT_CALL(*wheel_timer, enableTimer(_, _)).Times(0);
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+
+  // The session was active, so it moves to the bucket of its new deadline.
+  now += std::chrono::seconds(30);
+  EXPECT_CALL(*wheel_timer, enableTimer(std::chrono::milliseconds(30000), nullptr));
+  wheel_timer->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(0, config_->stats().idle_timeout_.value());
+
+  // A second session is scheduled without moving the timer to its later bucket.
+  now += std::chrono::seconds(10);
+  expectSessionCreate(upstream_address_);
+  test_sessions_[1].expectWriteToUpstream("hello", 0, nullptr, true);
+  recvDataFromDownstream("10.0.0.3:1000", "10.0.0.2:80", "hello");
+  EXPECT_EQ(2, config_->stats().downstream_sess_active_.value());
+
+  now += std::chrono::seconds(20);
+  EXPECT_CALL(*wheel_timer, enableTimer(std::chrono::milliseconds(41250), nullptr));
+  wheel_timer->invokeCallback();
+  EXPECT_EQ(1, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(1, config_->stats().idle_timeout_.value());
+
+  // A removed session is not expired again.
+  filter_.reset();
+  EXPECT_EQ(0, config_->stats().downstream_sess_active_.value());
+  EXPECT_EQ(1, config_->stats().idle_timeout_.value());
+}
+
 // Verify downstream send and receive error handling.
 TEST_F(UdpProxyFilterTest, SendReceiveErrorHandling) {
   InSequence s;
@@ -742,6 +816,93 @@ matcher:
   EXPECT_EQ(output_.front(), "fake_cluster 0 10 1 0 2");
 }
 
+// Creates the writers of upstream sockets from writers set by tests.
+class TestUdpPacketWriterFactoryFactory : public Network::UdpPacketWriterFactoryFactory {
+public:
+  class WriterFactory : public Network::UdpPacketWriterFactory {
+  public:
+    explicit WriterFactory(TestUdpPacketWriterFactoryFactory& parent) : parent_(parent) {}
+
+    Network::UdpPacketWriterPtr createUdpPacketWriter(Network::IoHandle&, Stats::Scope&,
+                                                      Event::Dispatcher&,
+                                                      absl::AnyInvocable<void() &&>) override {
+      EXPECT_NE(nullptr, parent_.next_writer_);
+      return std::move(parent_.next_writer_);
+    }
+
+  private:
+    TestUdpPacketWriterFactoryFactory& parent_;
+  };
+
+  std::string name() const override { return "envoy.udp_packet_writer.test"; }
+  Network::UdpPacketWriterFactoryPtr
+  createUdpPacketWriterFactory(const envoy::config::core::v3::TypedExtensionConfig&) override {
+    return std::make_unique<WriterFactory>(*this);
+  }
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory>();
+  }
+
+  std::unique_ptr<NiceMock<Network::MockUdpPacketWriter>> next_writer_;
+};
+
+// Verify that datagrams written upstream by a batch writer are flushed at the end of the event
+// loop iteration.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWrites) {
+  TestUdpPacketWriterFactoryFactory writer_factory;
+  Registry::InjectFactory<Network::UdpPacketWriterFactoryFactory> registration(writer_factory);
+
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+upstream_packet_writer_config:
+  name: envoy.udp_packet_writer.test
+  typed_config:
+    '@type': type.googleapis.com/envoy.extensions.udp_packet_writer.v3.UdpGsoBatchWriterFactory
+  )EOF"));
+
+  writer_factory.next_writer_ = std::make_unique<NiceMock<Network::MockUdpPacketWriter>>();
+  Network::MockUdpPacketWriter* writer = writer_factory.next_writer_.get();
+  ON_CALL(*writer, isBatchMode()).WillByDefault(Return(true));
+  auto* flush_cb =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+
+  expectSessionCreate(upstream_address_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, _)).Times(2);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*writer, writePacket(_, nullptr, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([this](const Buffer::Instance& buffer, const Network::Address::Ip*,
+                                    const Network::Address::Instance& peer_address) {
+        EXPECT_EQ(peer_address, *upstream_address_);
+        return makeNoError(buffer.length());
+      }));
+  // The flush is scheduled once for both datagrams.
+  EXPECT_CALL(*flush_cb, scheduleCallbackCurrentIteration()).WillOnce(Invoke([flush_cb]() {
+    EXPECT_CALL(*flush_cb, enabled()).WillRepeatedly(Return(true));
+  }));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello2");
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+
+  EXPECT_CALL(*writer, flush()).WillOnce(Return(ByMove(makeNoError(11))));
+  flush_cb->invokeCallback();
+
+  // Buffered datagrams are also flushed when the session is destroyed.
+  EXPECT_CALL(*writer, flush()).WillOnce(Return(ByMove(makeNoError(0))));
+  filter_.reset();
+}
+
 // Verify upstream connect error handling.
 TEST_F(UdpProxyFilterTest, ConnectErrorHandling) {
   InSequence s;
@@ -764,6 +764,125 @@ TEST_F(GeoipProviderTest, DbEpochGaugeUpdatesWhenReloadedOnMmdbFileUpdate) {
   TestEnvironment::renameFile(city_db_path + "1", city_db_path);
 }
 
+TEST_F(GeoipProviderTest, LookupCacheReusesResultsOfAnAddress) {
+  const std::string config_yaml = R"EOF(
+    common_provider_config:
+      geo_field_keys:
+        country: "x-geo-country"
+        region: "x-geo-region"
+        city: "x-geo-city"
+    city_db_path: "{{ test_rundir }}/test/extensions/geoip_providers/maxmind/test_data/GeoLite2-City-Test.mmdb"
+    lookup_cache: {}
+  )EOF";
+  initializeProvider(config_yaml, cb_added_nullopt);
+  testing::MockFunction<void(Geolocation::LookupResult&&)> lookup_cb;
+  EXPECT_CALL(lookup_cb, Call(_)).WillRepeatedly(SaveArg<0>(&captured_lookup_response_));
+  for (const char* address : {"81.2.69.144", "81.2.69.144", "81.2.69.160"}) {
+    captured_lookup_response_.clear();
+    provider_->lookup(
+        Geolocation::LookupRequest{Network::Utility::parseInternetAddressNoThrow(address)},
+        lookup_cb.AsStdFunction());
+    EXPECT_EQ(3, captured_lookup_response_.size());
+    EXPECT_EQ("London", captured_lookup_response_["x-geo-city"]);
+  }
+  expectStats("city_db", 2, 2);
+  auto& provider_scope = GeoipProviderPeer::providerScope(provider_);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache.hit").value());
+  EXPECT_EQ(2, provider_scope.counterFromString("lookup_cache.miss").value());
+}
+
+TEST_F(GeoipProviderTest, LookupCacheReusesResultsOfAPrefix) {
+  const std::string config_yaml = R"EOF(
+    common_provider_config:
+      geo_field_keys:
+        city: "x-geo-city"
+    city_db_path: "{{ test_rundir }}/test/extensions/geoip_providers/maxmind/test_data/GeoLite2-City-Test.mmdb"
+    lookup_cache:
+      ipv4_prefix_len: 24
+      ipv6_prefix_len: 48
+  )EOF";
+  initializeProvider(config_yaml, cb_added_nullopt);
+  testing::MockFunction<void(Geolocation::LookupResult&&)> lookup_cb;
+  EXPECT_CALL(lookup_cb, Call(_)).WillRepeatedly(SaveArg<0>(&captured_lookup_response_));
+  for (const char* address : {"81.2.69.144", "81.2.69.160", "81.2.70.1", "2001:db8::1",
+                                    "2001:db8:0:1::1", "2001:db8:1::1"}) {
+    provider_->lookup(
+        Geolocation::LookupRequest{Network::Utility::parseInternetAddressNoThrow(address)},
+        lookup_cb.AsStdFunction());
+  }
+  auto& provider_scope = GeoipProviderPeer::providerScope(provider_);
+  EXPECT_EQ(2, provider_scope.counterFromString("lookup_cache.hit").value());
+  EXPECT_EQ(4, provider_scope.counterFromString("lookup_cache.miss").value());
+}
+
+TEST_F(GeoipProviderTest, LookupCacheDroppedOnMmdbFileUpdate) {
+  constexpr absl::string_view config_yaml = R"EOF(
+    common_provider_config:
+      geo_field_keys:
+        city: "x-geo-city"
+    city_db_path: {}
+    lookup_cache: {{}}
+  )EOF";
+  std::string city_db_path = TestEnvironment::substitute(default_city_db_path);
+  std::string reloaded_city_db_path = TestEnvironment::substitute(default_updated_city_db_path);
+  const std::string formatted_config = fmt::format(config_yaml, city_db_path);
+  auto cb_added_opt = absl::make_optional<ConditionalInitializer>();
+  initializeProvider(formatted_config, cb_added_opt);
+  testing::MockFunction<void(Geolocation::LookupResult&&)> lookup_cb;
+  EXPECT_CALL(lookup_cb, Call(_)).WillRepeatedly(SaveArg<0>(&captured_lookup_response_));
+  const auto lookup = [&] {
+    captured_lookup_response_.clear();
+    provider_->lookup(
+        Geolocation::LookupRequest{Network::Utility::parseInternetAddressNoThrow("81.2.69.144")},
+        lookup_cb.AsStdFunction());
+  };
+  lookup();
+  lookup();
+  EXPECT_EQ("London", captured_lookup_response_["x-geo-city"]);
+  TestEnvironment::renameFile(city_db_path, city_db_path + "1");
+  TestEnvironment::renameFile(reloaded_city_db_path, city_db_path);
+  cb_added_opt.value().waitReady();
+  {
+    absl::ReaderMutexLock guard(mutex_);
+    EXPECT_TRUE(on_changed_cbs_[0](Filesystem::Watcher::Events::MovedTo).ok());
+  }
+  expectReloadStats("city_db", 1, 0);
+  lookup();
+  EXPECT_EQ("BoxfordImaginary", captured_lookup_response_["x-geo-city"]);
+  auto& provider_scope = GeoipProviderPeer::providerScope(provider_);
+  EXPECT_EQ(1, provider_scope.counterFromString("lookup_cache.hit").value());
+  EXPECT_EQ(2, provider_scope.counterFromString("lookup_cache.miss").value());
+  // Clean up modifications to mmdb file names.
+  TestEnvironment::renameFile(city_db_path, reloaded_city_db_path);
+  TestEnvironment::renameFile(city_db_path + "1", city_db_path);
+}
+
+TEST(LookupResultCacheTest, EvictsLeastRecentlyUsedResults) {
+  LookupResultCache cache(2);
+  const Geolocation::LookupResult result{{"x-geo-city", "London"}};
+  const auto key = [](const std::string& address, uint32_t ipv4_prefix_len = 32) {
+    return LookupResultCache::key(*Network::Utility::parseInternetAddressNoThrow(address)->ip(),
+                                  ipv4_prefix_len, 128);
+  };
+  EXPECT_EQ(key("10.0.0.1", 24), key("10.0.0.2", 24));
+  EXPECT_NE(key("10.0.0.1", 24), key("10.0.1.1", 24));
+  EXPECT_EQ(key("10.0.0.1", 0), key("192.168.0.1", 0));
+  EXPECT_NE(key("0.0.0.1"), key("::1"));
+
+  cache.insert(key("10.0.0.1"), result, 0);
+  cache.insert(key("10.0.0.2"), result, 0);
+  ASSERT_NE(nullptr, cache.lookup(key("10.0.0.1"), 0));
+  EXPECT_EQ(result, *cache.lookup(key("10.0.0.1"), 0));
+  cache.insert(key("10.0.0.3"), result, 0);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(nullptr, cache.lookup(key("10.0.0.2"), 0));
+  EXPECT_NE(nullptr, cache.lookup(key("10.0.0.3"), 0));
+
+  // Another generation of the databases drops all the results.
+  EXPECT_EQ(nullptr, cache.lookup(key("10.0.0.1"), 1));
+  EXPECT_EQ(0, cache.size());
+}
+
 // Country DB specific tests.
 TEST_F(GeoipProviderTest, ValidConfigCountryDbSuccessfulLookup) {
   const std::string config_yaml = R"EOF(
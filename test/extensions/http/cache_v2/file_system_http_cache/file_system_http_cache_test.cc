@@ -41,6 +41,7 @@ using StatusHelpers::IsOkAndHolds;
 using ::testing::HasSubstr;
 using ::testing::IsNull;
 using ::testing::NiceMock;
+using ::testing::Pointee;
 using ::testing::Return;
 using ::testing::StrictMock;
 
@@ -570,6 +571,29 @@ TEST_F(FileSystemHttpCacheTestWithMockFiles, IncompleteReadOfBodyProvokesReset)
   EXPECT_EQ(got_end_stream, EndStream::Reset);
 }
 
+TEST_F(FileSystemHttpCacheTestWithMockFiles, MapBodyReadsReadsBodyIntoMappings) {
+  cache_.reset();
+  ConfigProto cfg = testConfig();
+  cfg.set_map_body_reads(true);
+  cache_ = *http_cache_factory_->getCache(cacheConfig(cfg), context_);
+  setBodySize(10);
+  absl::StatusOr<LookupResult> lookup_result;
+  testSuccessfulLookup(&lookup_result);
+  EXPECT_CALL(*mock_async_file_handle_, mapRead(_, testHeaderBlock().offsetToBody() + 2, 8, _));
+  Buffer::InstancePtr got_body;
+  EndStream got_end_stream = EndStream::Reset;
+  lookup_result.value().cache_reader_->getBody(*dispatcher_, AdjustedByteRange(2, 10),
+                                               [&](Buffer::InstancePtr body, EndStream end_stream) {
+                                                 got_body = std::move(body);
+                                                 got_end_stream = end_stream;
+                                               });
+  mock_async_file_manager_->nextActionCompletes(
+      absl::StatusOr<Buffer::InstancePtr>(std::make_unique<Buffer::OwnedImpl>("cdefghij")));
+  pumpDispatcher();
+  EXPECT_THAT(got_body, Pointee(BufferStringEqual("cdefghij")));
+  EXPECT_EQ(got_end_stream, EndStream::More);
+}
+
 TEST_F(FileSystemHttpCacheTestWithMockFiles, FailedReadOfTrailersReturnsError) {
   setTrailers({{"fruit", "banana"}});
   EXPECT_CALL(*mock_async_file_manager_, openExistingFile);
@@ -2,6 +2,7 @@
 #include "envoy/registry/registry.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
 #include "source/extensions/filters/http/cache_v2/cache_entry_utils.h"
 #include "source/extensions/filters/http/cache_v2/cache_headers_utils.h"
 #include "source/extensions/filters/http/cache_v2/cache_sessions.h"
@@ -35,6 +36,24 @@ INSTANTIATE_TEST_SUITE_P(SimpleHttpCacheTest, HttpCacheImplementationTest,
                            return "SimpleHttpCache";
                          });
 
+TEST(SimpleHttpCacheEntryTest, BodyReferencesTheInsertedChunks) {
+  auto entry = std::make_shared<SimpleHttpCache::Entry>(
+      Http::ResponseHeaderMapImpl::create(), ResponseMetadata{});
+  entry->appendBody(std::make_unique<Buffer::OwnedImpl>("hello "));
+  entry->appendBody(std::make_unique<Buffer::OwnedImpl>());
+  entry->appendBody(std::make_unique<Buffer::OwnedImpl>("world"));
+  EXPECT_EQ(11, entry->bodySize());
+
+  Buffer::InstancePtr body = entry->body(AdjustedByteRange(3, 9));
+  Buffer::InstancePtr tail = entry->body(AdjustedByteRange(6, 20));
+  EXPECT_EQ(2, body->getRawSlices().size());
+  EXPECT_EQ(0, entry->body(AdjustedByteRange(11, 20))->length());
+  // The buffers keep the chunks they reference alive.
+  entry.reset();
+  EXPECT_EQ("lo wor", body->toString());
+  EXPECT_EQ("world", tail->toString());
+}
+
 TEST(Registration, GetFactory) {
   HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
       "envoy.extensions.http.cache_v2.simple_http_cache.v3.SimpleHttpCacheV2Config");
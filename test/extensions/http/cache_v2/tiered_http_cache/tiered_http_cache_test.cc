@@ -0,0 +1,252 @@
+#include <memory>
+#include <string>
+
+#include "envoy/extensions/http/cache_v2/simple_http_cache/v3/config.pb.h"
+#include "envoy/extensions/http/cache_v2/tiered_http_cache/v3/tiered_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/http/header_map_impl.h"
+#include "source/extensions/filters/http/cache_v2/cache_sessions.h"
+#include "source/extensions/http/cache_v2/tiered_http_cache/tiered_http_cache.h"
+
+#include "test/extensions/filters/http/cache_v2/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace CacheV2 {
+namespace TieredHttpCache {
+namespace {
+
+using ::testing::Eq;
+using ::testing::Optional;
+using ::testing::Pair;
+
+constexpr absl::string_view TieredConfigType =
+    "envoy.extensions.http.cache_v2.tiered_http_cache.v3.TieredHttpCacheV2Config";
+
+envoy::extensions::filters::http::cache_v2::v3::CacheV2Config filterConfig(ConfigProto config) {
+  if (!config.has_next_tier()) {
+    config.mutable_next_tier()->PackFrom(
+        envoy::extensions::http::cache_v2::simple_http_cache::v3::SimpleHttpCacheV2Config());
+  }
+  envoy::extensions::filters::http::cache_v2::v3::CacheV2Config filter_config;
+  filter_config.mutable_typed_config()->PackFrom(config);
+  return filter_config;
+}
+
+HttpCacheFactory& tieredCacheFactory() {
+  HttpCacheFactory* factory =
+      Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(TieredConfigType);
+  RELEASE_ASSERT(factory != nullptr, "tiered cache factory is not registered");
+  return *factory;
+}
+
+// A tiered cache in front of a simple cache.
+class TieredHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  explicit TieredHttpCacheTestDelegate(const ConfigProto& config)
+      : cache_sessions_(*tieredCacheFactory().getCache(filterConfig(config), context_)) {}
+
+  HttpCache& cache() override { return cache_sessions_->cache(); }
+
+private:
+  testing::NiceMock<Server::Configuration::MockFactoryContext> context_;
+  std::shared_ptr<CacheSessions> cache_sessions_;
+};
+
+std::unique_ptr<HttpCacheTestDelegate> admitAllDelegate() {
+  ConfigProto config;
+  config.mutable_min_lookups_to_admit()->set_value(0);
+  return std::make_unique<TieredHttpCacheTestDelegate>(config);
+}
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(admitAllDelegate),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "TieredHttpCache";
+                         });
+
+class TieredHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  const TieredHttpCacheStats& stats() const {
+    return dynamic_cast<const TieredHttpCache&>(cache()).stats();
+  }
+
+  Http::TestResponseHeaderMapImpl responseHeaders() {
+    return {{":status", "200"},
+            {"date", formatter_.fromTime(time_system_.systemTime())},
+            {"cache-control", "public,max-age=3600"}};
+  }
+
+  // Looks up a key often enough for its entry to be admitted in the memory tier.
+  void lookupUntilAdmitted(absl::string_view request_path) {
+    lookup(request_path);
+    lookup(request_path);
+  }
+};
+
+// The memory tier holds two entries of 400 bytes, with the default admission.
+std::unique_ptr<HttpCacheTestDelegate> smallMemoryTierDelegate() {
+  ConfigProto config;
+  config.mutable_max_memory_size_bytes()->set_value(1024);
+  config.mutable_max_memory_entry_size_bytes()->set_value(512);
+  return std::make_unique<TieredHttpCacheTestDelegate>(config);
+}
+
+INSTANTIATE_TEST_SUITE_P(TieredHttpCacheTest, TieredHttpCacheTest,
+                         testing::Values(smallMemoryTierDelegate),
+                         [](const testing::TestParamInfo<TieredHttpCacheTest::ParamType>&) {
+                           return "SmallMemoryTier";
+                         });
+
+TEST_P(TieredHttpCacheTest, PromotesEntryOnceReadWholeAfterEnoughLookups) {
+  insert("/name", responseHeaders(), "Value");
+  EXPECT_EQ(0, stats().write_throughs_.value());
+
+  // Not looked up often enough yet.
+  LookupResult lookup_result = lookup("/name");
+  EXPECT_THAT(lookup_result.body_length_, Optional(5));
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 0, 5), Pair("Value", EndStream::More));
+  EXPECT_EQ(0, stats().promotions_.value());
+
+  // Promoted once the whole body is read, in order.
+  lookup_result = lookup("/name");
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 0, 3), Pair("Val", EndStream::More));
+  EXPECT_EQ(0, stats().promotions_.value());
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 3, 5), Pair("ue", EndStream::More));
+  EXPECT_EQ(1, stats().promotions_.value());
+  EXPECT_EQ(2, stats().next_tier_hits_.value());
+  EXPECT_EQ(0, stats().memory_hits_.value());
+
+  lookup_result = lookup("/name");
+  EXPECT_EQ(1, stats().memory_hits_.value());
+  Http::TestResponseHeaderMapImpl response_headers = responseHeaders();
+  EXPECT_THAT(lookup_result.response_headers_, HeaderMapEqualIgnoreOrder(&response_headers));
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 1, 4), Pair("alu", EndStream::More));
+}
+
+TEST_P(TieredHttpCacheTest, WritesThroughInsertionsOfKeysLookedUpEnough) {
+  lookupUntilAdmitted("/name");
+  EXPECT_EQ(2, stats().next_tier_misses_.value());
+  Http::TestResponseTrailerMapImpl response_trailers{{"x-trailer", "hello"}};
+  insert("/name", responseHeaders(), "Value", response_trailers);
+  EXPECT_EQ(1, stats().write_throughs_.value());
+  EXPECT_EQ(1, stats().memory_entries_.value());
+
+  LookupResult lookup_result = lookup("/name");
+  EXPECT_EQ(1, stats().memory_hits_.value());
+  EXPECT_THAT(lookup_result.body_length_, Optional(5));
+  EXPECT_THAT(lookup_result.response_trailers_, HeaderMapEqualIgnoreOrder(&response_trailers));
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 0, 5), Pair("Value", EndStream::More));
+}
+
+TEST_P(TieredHttpCacheTest, EvictsLeastRecentlyUsedEntries) {
+  const Http::TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  const std::string body(400, 'x');
+  lookupUntilAdmitted("/a");
+  insert("/a", response_headers, body);
+  lookupUntilAdmitted("/b");
+  insert("/b", response_headers, body);
+  EXPECT_EQ(2, stats().memory_entries_.value());
+
+  // Makes /b the least recently used entry.
+  lookup("/a");
+  EXPECT_EQ(1, stats().memory_hits_.value());
+  lookupUntilAdmitted("/c");
+  insert("/c", response_headers, body);
+  EXPECT_EQ(1, stats().memory_evictions_.value());
+  EXPECT_EQ(2, stats().memory_entries_.value());
+
+  // The evicted entry is still served by the next tier.
+  LookupResult lookup_result = lookup("/b");
+  EXPECT_EQ(1, stats().memory_hits_.value());
+  EXPECT_THAT(lookup_result.body_length_, Optional(400));
+  lookup("/a");
+  lookup("/c");
+  EXPECT_EQ(3, stats().memory_hits_.value());
+
+  // Entries above the entry size limit are not kept in memory.
+  lookupUntilAdmitted("/d");
+  insert("/d", response_headers, std::string(600, 'x'));
+  EXPECT_EQ(3, stats().write_throughs_.value());
+  EXPECT_EQ(2, stats().memory_entries_.value());
+  EXPECT_EQ(1, stats().memory_evictions_.value());
+}
+
+TEST_P(TieredHttpCacheTest, EvictRemovesFromBothTiers) {
+  lookupUntilAdmitted("/name");
+  insert("/name", responseHeaders(), "Value");
+  EXPECT_EQ(1, stats().memory_entries_.value());
+  evict("/name");
+  EXPECT_EQ(0, stats().memory_entries_.value());
+  EXPECT_THAT(lookup("/name").body_length_, Eq(absl::nullopt));
+}
+
+TEST_P(TieredHttpCacheTest, UpdateHeadersUpdatesMemoryTier) {
+  lookupUntilAdmitted("/name");
+  insert("/name", responseHeaders(), "Value");
+  time_system_.advanceTimeWait(std::chrono::seconds(3601));
+  Http::TestResponseHeaderMapImpl updated_headers = responseHeaders();
+  updated_headers.addCopy("etag", "\"foo\"");
+  updateHeaders("/name", updated_headers, {time_system_.systemTime()});
+
+  LookupResult lookup_result = lookup("/name");
+  EXPECT_EQ(1, stats().memory_hits_.value());
+  EXPECT_THAT(lookup_result.response_headers_, HeaderMapEqualIgnoreOrder(&updated_headers));
+  EXPECT_THAT(lookup_result.response_metadata_.response_time_, Eq(time_system_.systemTime()));
+  EXPECT_THAT(getBody(*lookup_result.cache_reader_, 0, 5), Pair("Value", EndStream::More));
+}
+
+TEST(FrequencySketchTest, HalvesCountsAfterSampleOfIncrements) {
+  // 16 counters, halved every 160 increments.
+  FrequencySketch sketch(10);
+  for (int i = 0; i < 159; i++) {
+    sketch.increment(1);
+  }
+  EXPECT_EQ(159, sketch.estimate(1));
+  sketch.increment(1);
+  EXPECT_EQ(80, sketch.estimate(1));
+  // Uses other counters than the key above.
+  EXPECT_EQ(0, sketch.estimate(0x100000008));
+}
+
+TEST(FrequencySketchTest, SaturatesCounts) {
+  FrequencySketch sketch(1 << 20);
+  for (int i = 0; i < 300; i++) {
+    sketch.increment(1);
+  }
+  EXPECT_EQ(255, sketch.estimate(1));
+}
+
+TEST(Registration, GetFactory) {
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  auto cache = tieredCacheFactory().getCache(filterConfig(ConfigProto()), factory_context);
+  ASSERT_OK(cache);
+  EXPECT_EQ((*cache)->cacheInfo().name_, "envoy.extensions.http.cache_v2.tiered_http_cache");
+  // Equivalent configs share the cache.
+  auto same_cache = tieredCacheFactory().getCache(filterConfig(ConfigProto()), factory_context);
+  ASSERT_OK(same_cache);
+  EXPECT_EQ(cache->get(), same_cache->get());
+}
+
+TEST(Registration, UnknownNextTierIsAnError) {
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  ConfigProto config;
+  config.mutable_next_tier()->PackFrom(ProtobufWkt::StringValue());
+  EXPECT_THAT(tieredCacheFactory().getCache(filterConfig(config), factory_context).status(),
+              StatusHelpers::HasStatusCode(absl::StatusCode::kInvalidArgument));
+}
+
+} // namespace
+} // namespace TieredHttpCache
+} // namespace CacheV2
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
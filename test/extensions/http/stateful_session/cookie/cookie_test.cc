@@ -158,6 +158,46 @@ TEST(CookieBasedSessionStateFactoryTest, SessionStateProtoCookie) {
   EXPECT_EQ("blahblah", session_state->upstreamAddress());
 }
 
+// The cookies decoded by previous requests are checked for expiry again, and are looked up
+// by the other factories, possibly with other cookie names, too.
+TEST(CookieBasedSessionStateFactoryTest, SessionStateRepeatedCookie) {
+  Event::SimulatedTimeSystem time_simulator;
+  time_simulator.setMonotonicTime(std::chrono::seconds(1000));
+  CookieBasedSessionStateProto config;
+  config.mutable_cookie()->set_name("override_host");
+  CookieBasedSessionStateFactory factory(config, time_simulator);
+  config.mutable_cookie()->set_name("other_override_host");
+  CookieBasedSessionStateFactory other_factory(config, time_simulator);
+
+  std::string cookie_content;
+  envoy::Cookie cookie;
+  cookie.set_address("1.2.3.4:80");
+  cookie.set_expires(1005);
+  cookie.SerializeToString(&cookie_content);
+  const std::string cookie_value =
+      Envoy::Base64::encode(cookie_content.c_str(), cookie_content.length());
+  Envoy::Http::TestRequestHeaderMapImpl request_headers = {
+      {":path", "/"}, {"cookie", "override_host=" + cookie_value}};
+  Envoy::Http::TestRequestHeaderMapImpl other_request_headers = {
+      {":path", "/"}, {"cookie", "other_override_host=" + cookie_value}};
+
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("1.2.3.4:80", factory.create(request_headers)->upstreamAddress().value());
+    EXPECT_EQ("1.2.3.4:80", other_factory.create(other_request_headers)->upstreamAddress().value());
+  }
+
+  time_simulator.setMonotonicTime(std::chrono::seconds(1006));
+  EXPECT_EQ(absl::nullopt, factory.create(request_headers)->upstreamAddress());
+  EXPECT_EQ(absl::nullopt, other_factory.create(other_request_headers)->upstreamAddress());
+
+  // The old style cookies are cached as well.
+  request_headers = {{":path", "/"},
+                     {"cookie", "override_host=" + Envoy::Base64::encode("2.3.4.5:80", 10)}};
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("2.3.4.5:80", factory.create(request_headers)->upstreamAddress().value());
+  }
+}
+
 TEST(CookieBasedSessionStateFactoryTest, SessionStatePathMatchTest) {
   Event::SimulatedTimeSystem time_simulator;
   {
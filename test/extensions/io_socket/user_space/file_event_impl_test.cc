@@ -8,6 +8,7 @@
 
 #include "test/mocks/common.h"
 #include "test/test_common/environment.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -496,6 +497,67 @@ TEST_F(FileEventImplTest, NotImplementedEmulatedEdge) {
   user_file_event_->registerEventIfEmulatedEdge(0);
   user_file_event_->unregisterEventIfEmulatedEdge(0);
 }
+
+// The events notified by the peer while the dispatcher runs are delivered in the same iteration,
+// until a callback is deferred to the next iteration after consecutive ones.
+TEST_F(FileEventImplTest, ActivateIfEnabledInCurrentIteration) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.user_space_io_handle_current_iteration_events", "true"}});
+  // IO is neither readable nor writable.
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_,
+      [this](uint32_t arg) {
+        ready_cb_.called(arg);
+        // Notifies the next event, as a peer writing again would.
+        user_file_event_->activateIfEnabled(Event::FileReadyType::Read);
+        return absl::OkStatus();
+      },
+      event_all, io_source_);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+
+  auto peer_write = dispatcher_->createSchedulableCallback(
+      [this]() { user_file_event_->activateIfEnabled(Event::FileReadyType::Read); });
+  peer_write->scheduleCallbackCurrentIteration();
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read)).Times(8);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&ready_cb_);
+
+  // The deferred callback resets the count.
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read)).Times(9);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&ready_cb_);
+
+  user_file_event_->setEnabled(0);
+  EXPECT_CALL(ready_cb_, called(_)).Times(0);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
+// Without the runtime feature, the events notified by the peer are delivered in the next
+// iteration.
+TEST_F(FileEventImplTest, ActivateIfEnabledInNextIteration) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.user_space_io_handle_current_iteration_events", "false"}});
+  user_file_event_ = std::make_unique<FileEventImpl>(
+      *dispatcher_,
+      [this](uint32_t arg) {
+        ready_cb_.called(arg);
+        return absl::OkStatus();
+      },
+      event_all, io_source_);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+
+  auto peer_write = dispatcher_->createSchedulableCallback(
+      [this]() { user_file_event_->activateIfEnabled(Event::FileReadyType::Read); });
+  peer_write->scheduleCallbackCurrentIteration();
+  EXPECT_CALL(ready_cb_, called(_)).Times(0);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  testing::Mock::VerifyAndClearExpectations(&ready_cb_);
+
+  EXPECT_CALL(ready_cb_, called(Event::FileReadyType::Read));
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
 } // namespace
 } // namespace UserSpace
 } // namespace IoSocket
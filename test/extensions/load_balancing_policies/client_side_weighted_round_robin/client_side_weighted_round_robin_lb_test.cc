@@ -8,6 +8,7 @@
 
 #include "test/extensions/load_balancing_policies/common/load_balancer_impl_base_test.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 
 #include "gmock/gmock.h"
 
@@ -384,6 +385,41 @@ TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, ProcessOrcaLoadReport_Updat
   EXPECT_EQ(client_side_data->weight_.load(), 42);
 }
 
+TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, ProcessOrcaLoadReport_Coalesced) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.wrr_coalesce_orca_reports", "true"}});
+  init(false);
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::seconds(30)));
+
+  xds::data::orca::v3::OrcaLoadReport orca_load_report;
+  orca_load_report.set_rps_fractional(1000);
+  orca_load_report.set_application_utilization(0.5);
+
+  auto client_side_data =
+      std::make_shared<ClientSideWeightedRoundRobinLoadBalancer::ClientSideHostLbPolicyData>(
+          lb_->orcaLoadReportHandler());
+  EXPECT_EQ(lb_->updateClientSideDataFromOrcaLoadReport(orca_load_report, *client_side_data),
+            absl::OkStatus());
+  EXPECT_EQ(client_side_data->weight_.load(), 2000);
+
+  // Reports within the weight update period of the stored one are dropped.
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::milliseconds(30500)));
+  orca_load_report.set_application_utilization(0.25);
+  EXPECT_EQ(lb_->updateClientSideDataFromOrcaLoadReport(orca_load_report, *client_side_data),
+            absl::OkStatus());
+  EXPECT_EQ(client_side_data->last_update_time_.load(), MonotonicTime(std::chrono::seconds(30)));
+  EXPECT_EQ(client_side_data->weight_.load(), 2000);
+
+  // The first report after the period is stored.
+  simTime().setMonotonicTime(MonotonicTime(std::chrono::seconds(31)));
+  EXPECT_EQ(lb_->updateClientSideDataFromOrcaLoadReport(orca_load_report, *client_side_data),
+            absl::OkStatus());
+  EXPECT_EQ(client_side_data->last_update_time_.load(), MonotonicTime(std::chrono::seconds(31)));
+  EXPECT_EQ(client_side_data->weight_.load(), 4000);
+  // The first report time is kept.
+  EXPECT_EQ(client_side_data->non_empty_since_.load(), MonotonicTime(std::chrono::seconds(30)));
+}
+
 TEST_P(ClientSideWeightedRoundRobinLoadBalancerTest, SlowStartConfig_RampUp) {
   // Configure slow start via overrides.
   auto* slow = lb_config_.round_robin_overrides_.mutable_slow_start_config();
@@ -77,6 +77,37 @@ BENCHMARK(benchmarkMaglevLoadBalancerBuildTable)
     ->Arg(500)
     ->Unit(::benchmark::kMillisecond);
 
+// Looks up random hashes in `state.range(0)` tables of `state.range(1)` hosts each, which
+// approximates host selection on a process with many maglev clusters whose tables do not all fit
+// in the CPU caches.
+void benchmarkMaglevTableChooseHostManyClusters(::benchmark::State& state) {
+  const uint64_t num_tables = state.range(0);
+  const uint64_t num_hosts = state.range(1);
+  MaglevTester tester(num_hosts);
+  MaglevLoadBalancerStats stats = MaglevLoadBalancer::generateStats(tester.stats_scope_);
+  NormalizedHostWeightVector normalized_host_weights;
+  for (const auto& host : tester.priority_set_.hostSetsPerPriority()[0]->hosts()) {
+    normalized_host_weights.push_back({host, 1.0 / num_hosts});
+  }
+  std::vector<MaglevTableSharedPtr> tables;
+  tables.reserve(num_tables);
+  for (uint64_t i = 0; i < num_tables; i++) {
+    tables.push_back(std::make_shared<CompactMaglevTable>(
+        normalized_host_weights, 1.0 / num_hosts, MaglevTable::DefaultTableSize, false, stats));
+  }
+
+  uint64_t hash = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    hash = hashInt(hash);
+    benchmark::DoNotOptimize(tables[hash % num_tables]->chooseHost(hash >> 16, 0).host);
+  }
+}
+BENCHMARK(benchmarkMaglevTableChooseHostManyClusters)
+    ->Args({1, 100})
+    ->Args({100, 100})
+    ->Args({1000, 100})
+    ->Args({1000, 1000});
+
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     const uint64_t num_hosts = state.range(0);
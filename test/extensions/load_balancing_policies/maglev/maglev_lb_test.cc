@@ -1,4 +1,5 @@
 #include <memory>
+#include <thread>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
@@ -14,6 +15,7 @@
 #include "test/mocks/upstream/priority_set.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/thread_factory_for_test.h"
 
 #include "absl/types/optional.h"
 
@@ -81,7 +83,8 @@ public:
 
     lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, *stats_store_.rootScope(),
                                                context_.runtime_loader_, context_.api_.random_, 50,
-                                               typed_config.lb_config_, typed_config.hash_policy_);
+                                               typed_config.lb_config_, typed_config.hash_policy_,
+                                               thread_factory_);
   }
 
   void init(uint64_t table_size, bool locality_weighted_balancing = false) {
@@ -107,6 +110,7 @@ public:
   ClusterLbStats stats_;
   envoy::extensions::load_balancing_policies::maglev::v3::Maglev config_;
   NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+  Thread::ThreadFactory* thread_factory_{};
 
   std::unique_ptr<MaglevLoadBalancer> lb_;
 };
@@ -178,6 +182,44 @@ TEST_F(MaglevLoadBalancerTest, Basic) {
   }
 }
 
+// Tables are rebuilt on a background thread once the load balancer is initialized, and worker
+// load balancers created before the rebuild pick up the new table.
+TEST_F(MaglevLoadBalancerTest, BackgroundTableBuild) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.hash_lb_background_table_builds", "true"}});
+  thread_factory_ = &Thread::threadFactoryForTest();
+
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:90")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  init(7);
+
+  // The initial build is synchronous.
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+  TestLoadBalancerContext context(0);
+  EXPECT_EQ(host_set_.hosts_[0], lb->chooseHost(&context).host);
+
+  // Replace the host a few times, the intermediate updates may be collapsed.
+  for (uint32_t port = 91; port <= 95; ++port) {
+    const HostVector old_hosts = host_set_.hosts_;
+    host_set_.hosts_ = {makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", port))};
+    host_set_.healthy_hosts_ = host_set_.hosts_;
+    host_set_.runCallbacks(host_set_.hosts_, old_hosts);
+  }
+  while (lb->chooseHost(&context).host != host_set_.hosts_[0]) {
+    std::this_thread::yield();
+  }
+  for (uint64_t i = 0; i < 7; ++i) {
+    TestLoadBalancerContext hash_context(i);
+    EXPECT_EQ(host_set_.hosts_[0], lb->chooseHost(&hash_context).host);
+  }
+  EXPECT_EQ(7, lb_->stats().min_entries_per_host_.value());
+
+  // Load balancers created from now on use the new table as well.
+  EXPECT_EQ(host_set_.hosts_[0], lb_->factory()->create(lb_params_)->chooseHost(&context).host);
+}
+
 // Test bounded load. This test only ensures that the
 // hash balancer factory won't break the normal load balancer process.
 TEST_F(MaglevLoadBalancerTest, BasicWithBoundedLoad) {
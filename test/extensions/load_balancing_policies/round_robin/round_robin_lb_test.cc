@@ -439,6 +439,34 @@ TEST_P(RoundRobinLoadBalancerTest, Weighted) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
 }
 
+// Validate that hosts are picked from the alias table when configured.
+TEST_P(RoundRobinLoadBalancerTest, WeightedAliasScheduler) {
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 3)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  round_robin_lb_config_.set_weighted_scheduler(
+      envoy::extensions::load_balancing_policies::round_robin::v3::RoundRobin::ALIAS);
+  init(false);
+
+  // The upper half of the random number selects the bucket of the first host, whose own host is
+  // picked with probability 1/2 and the second host otherwise.
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0xffffffff));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->peekAnotherHost(nullptr));
+  // The bucket of the second host always picks it.
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(uint64_t(1) << 63));
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+
+  // A weight change takes effect after the host is next picked.
+  hostSet().healthy_hosts_[0]->weight(3);
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(0xffffffff));
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+}
+
 // Validate that the RNG seed influences pick order when weighted RR.
 TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
@@ -886,6 +914,150 @@ TEST_P(RoundRobinLoadBalancerTest, ZoneAwareResidualsMismatched) {
   // At sampled value 5418, we loop back to the beginning of the vector and select zone C again
 }
 
+TEST_P(RoundRobinLoadBalancerTest, ZoneAwareResidualsLocalityChoiceTable) {
+  if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
+    return;
+  }
+
+  // Setup is:
+  // L = local envoy
+  // U = upstream host
+  //
+  //                | expected  | legacy    |
+  //                | residuals | residuals |
+  // ----------------------------------------
+  // Zone A: 2L, 1U | 0%        | 0%        |
+  // Zone B: 2L, 0U | N/A       | N/A       |
+  // Zone C: 1L, 3U | 20.83%    | 4.16%     |
+  // Zone D: 1L, 3U | 20.83%    | 20.83%    |
+  // Zone E: 0L, 1U | 12.50%    | 0%        |
+  // ----------------------------------------
+  // Totals: 6L, 8U | 54.18%    | 25%       |
+  //
+  // Same as ZoneAwareResidualsMismatched, but the locality is chosen from the precomputed table
+  // with a single random number.
+  //
+  // Idea is for the local cluster to be A, and for there to be residual from A.
+  // The number of local and upstream zones must be the same for zone routing to be enabled.
+  // Then we ensure that there are two different zones with different residuals.
+  // Finally we add a zone with local hosts but no upstream hosts just after the local zone to
+  // create a mismatch between the local percentages and upstream percentages vectors when
+  // performing residual calculations.
+
+  envoy::config::core::v3::Locality zone_a;
+  zone_a.set_zone("A");
+  envoy::config::core::v3::Locality zone_b;
+  zone_b.set_zone("B");
+  envoy::config::core::v3::Locality zone_c;
+  zone_c.set_zone("C");
+  envoy::config::core::v3::Locality zone_d;
+  zone_d.set_zone("D");
+  envoy::config::core::v3::Locality zone_e;
+  zone_e.set_zone("E");
+
+  HostVectorSharedPtr hosts(new HostVector({makeTestHost(info_, "tcp://127.0.0.1:80", zone_a),
+                                            makeTestHost(info_, "tcp://127.0.0.1:81", zone_c),
+                                            makeTestHost(info_, "tcp://127.0.0.1:82", zone_c),
+                                            makeTestHost(info_, "tcp://127.0.0.1:83", zone_c),
+                                            makeTestHost(info_, "tcp://127.0.0.1:84", zone_d),
+                                            makeTestHost(info_, "tcp://127.0.0.1:85", zone_d),
+                                            makeTestHost(info_, "tcp://127.0.0.1:86", zone_d),
+                                            makeTestHost(info_, "tcp://127.0.0.1:87", zone_e)}));
+  HostVectorSharedPtr local_hosts(
+      new HostVector({makeTestHost(info_, "tcp://127.0.0.1:0", zone_a),
+                      makeTestHost(info_, "tcp://127.0.0.1:1", zone_a),
+                      makeTestHost(info_, "tcp://127.0.0.1:2", zone_b),
+                      makeTestHost(info_, "tcp://127.0.0.1:3", zone_b),
+                      makeTestHost(info_, "tcp://127.0.0.1:4", zone_c),
+                      makeTestHost(info_, "tcp://127.0.0.1:5", zone_d)}));
+
+  // Local zone is zone A
+  HostsPerLocalitySharedPtr upstream_hosts_per_locality =
+      makeHostsPerLocality({{// Zone A
+                             makeTestHost(info_, "tcp://127.0.0.1:80", zone_a)},
+                            {// Zone C
+                             makeTestHost(info_, "tcp://127.0.0.1:81", zone_c),
+                             makeTestHost(info_, "tcp://127.0.0.1:82", zone_c),
+                             makeTestHost(info_, "tcp://127.0.0.1:83", zone_c)},
+                            {// Zone D
+                             makeTestHost(info_, "tcp://127.0.0.1:84", zone_d),
+                             makeTestHost(info_, "tcp://127.0.0.1:85", zone_d),
+                             makeTestHost(info_, "tcp://127.0.0.1:86", zone_d)},
+                            {// Zone E
+                             makeTestHost(info_, "tcp://127.0.0.1:87", zone_e)}});
+
+  HostsPerLocalitySharedPtr local_hosts_per_locality =
+      makeHostsPerLocality({{// Zone A
+                             makeTestHost(info_, "tcp://127.0.0.1:0", zone_a),
+                             makeTestHost(info_, "tcp://127.0.0.1:1", zone_a)},
+                            {// Zone B
+                             makeTestHost(info_, "tcp://127.0.0.1:2", zone_b),
+                             makeTestHost(info_, "tcp://127.0.0.1:3", zone_b)},
+                            {// Zone C
+                             makeTestHost(info_, "tcp://127.0.0.1:4", zone_c)},
+                            {// Zone D
+                             makeTestHost(info_, "tcp://127.0.0.1:5", zone_d)}});
+
+  hostSet().healthy_hosts_ = *hosts;
+  hostSet().hosts_ = *hosts;
+  hostSet().healthy_hosts_per_locality_ = upstream_hosts_per_locality;
+  common_config_.mutable_healthy_panic_threshold()->set_value(50);
+  round_robin_lb_config_.mutable_locality_lb_config()
+      ->mutable_zone_aware_lb_config()
+      ->mutable_routing_enabled()
+      ->set_value(100);
+  round_robin_lb_config_.mutable_locality_lb_config()
+      ->mutable_zone_aware_lb_config()
+      ->mutable_min_cluster_size()
+      ->set_value(6);
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.zone_aware_locality_choice_table", "true"}});
+  init(true);
+  updateHosts(local_hosts, local_hosts_per_locality);
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.healthy_panic_threshold", 50))
+      .WillRepeatedly(Return(50));
+  EXPECT_CALL(runtime_.snapshot_, featureEnabled("upstream.zone_routing.enabled", 100))
+      .WillRepeatedly(Return(true));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.force_local_zone.min_size", 0))
+      .WillRepeatedly(Return(0));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("upstream.zone_routing.min_cluster_size", 6))
+      .WillRepeatedly(Return(6));
+
+  // The table weighs the localities by 10000 times their share of the traffic. Zone A directly
+  // gets 37.5% of it: sampled value 0-20317499.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(1U, stats_.lb_zone_routing_sampled_.value());
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(20317499));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[0][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(2U, stats_.lb_zone_routing_sampled_.value());
+
+  // Zone C: sampled value 20317500-33342499.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(20317500));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(1U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(33342499));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[1][1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(2U, stats_.lb_zone_routing_cross_zone_.value());
+  // Zone D: sampled value 33342500-46367499.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(33342500));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(3U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(46367499));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[2][1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(4U, stats_.lb_zone_routing_cross_zone_.value());
+  // Zone E: sampled value 46367500-54179999.
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(46367500));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(5U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(54179999));
+  EXPECT_EQ(hostSet().healthy_hosts_per_locality_->get()[3][0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(6U, stats_.lb_zone_routing_cross_zone_.value());
+  EXPECT_EQ(2U, stats_.lb_zone_routing_sampled_.value());
+}
+
 TEST_P(RoundRobinLoadBalancerTest, ZoneAwareDifferentZoneSize) {
   if (&hostSet() == &failover_host_set_) { // P = 1 does not support zone-aware routing.
     return;
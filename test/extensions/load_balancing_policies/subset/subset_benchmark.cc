@@ -31,7 +31,7 @@ namespace {
 
 class SubsetLbTester : public Upstream::BaseTester {
 public:
-  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset)
+  SubsetLbTester(uint64_t num_hosts, bool single_host_per_subset, bool lazy_subsets)
       : BaseTester(num_hosts, 0, 0, true /* attach metadata */) {
     envoy::extensions::load_balancing_policies::subset::v3::Subset subset_config_proto{};
     subset_config_proto.set_fallback_policy(
@@ -39,6 +39,9 @@ public:
     auto* selector_proto = subset_config_proto.mutable_subset_selectors()->Add();
     selector_proto->set_single_host_per_subset(single_host_per_subset);
     *selector_proto->mutable_keys()->Add() = std::string(metadata_key);
+    if (lazy_subsets) {
+      subset_config_proto.mutable_lazy_subsets();
+    }
 
     auto* child_lb = subset_config_proto.mutable_subset_lb_policy()->mutable_policies()->Add();
     child_lb->mutable_typed_extension_config()->set_name("envoy.load_balancing_policies.random");
@@ -87,6 +90,7 @@ public:
 void benchmarkSubsetLoadBalancerCreate(::benchmark::State& state) {
   const bool single_host_per_subset = state.range(0);
   const uint64_t num_hosts = state.range(1);
+  const bool lazy_subsets = state.range(2);
 
   if (benchmark::skipExpensiveBenchmarks() && num_hosts > 100) {
     state.SkipWithError("Skipping expensive benchmark");
@@ -94,30 +98,31 @@ void benchmarkSubsetLoadBalancerCreate(::benchmark::State& state) {
   }
 
   for (auto _ : state) { // NOLINT: Silences warning about dead store
-    SubsetLbTester tester(num_hosts, single_host_per_subset);
+    SubsetLbTester tester(num_hosts, single_host_per_subset, lazy_subsets);
   }
 }
 
 BENCHMARK(benchmarkSubsetLoadBalancerCreate)
-    ->Ranges({{false, true}, {50, 2500}})
+    ->Ranges({{false, true}, {50, 2500}, {false, true}})
     ->Unit(::benchmark::kMillisecond);
 
 void benchmarkSubsetLoadBalancerUpdate(::benchmark::State& state) {
   const bool single_host_per_subset = state.range(0);
   const uint64_t num_hosts = state.range(1);
+  const bool lazy_subsets = state.range(2);
   if (benchmark::skipExpensiveBenchmarks() && num_hosts > 100) {
     state.SkipWithError("Skipping expensive benchmark");
     return;
   }
 
-  SubsetLbTester tester(num_hosts, single_host_per_subset);
+  SubsetLbTester tester(num_hosts, single_host_per_subset, lazy_subsets);
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     tester.update();
   }
 }
 
 BENCHMARK(benchmarkSubsetLoadBalancerUpdate)
-    ->Ranges({{false, true}, {50, 2500}})
+    ->Ranges({{false, true}, {50, 2500}, {false, true}})
     ->Unit(::benchmark::kMillisecond);
 
 } // namespace
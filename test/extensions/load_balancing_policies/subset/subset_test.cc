@@ -60,6 +60,7 @@ public:
   MOCK_METHOD(bool, panicModeAny, (), (const));
   MOCK_METHOD(bool, listAsAny, (), (const));
   MOCK_METHOD(bool, allowRedundantKeys, (), (const));
+  MOCK_METHOD(absl::optional<std::chrono::milliseconds>, lazySubsetIdleTimeout, (), (const));
 
   std::vector<SubsetSelectorPtr> subset_selectors_;
 };
@@ -976,6 +977,135 @@ TEST_P(SubsetLoadBalancerTest, BalancesSubsetAfterUpdate) {
   EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
 }
 
+TEST_P(SubsetLoadBalancerTest, LazySubsetsCreatedOnFirstUse) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsetIdleTimeout())
+      .WillRepeatedly(Return(std::chrono::milliseconds(1000)));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:82", {{"version", "1.1"}}},
+      {"tcp://127.0.0.1:83", {{"version", "1.1"}}},
+  });
+
+  EXPECT_EQ(0U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(0U, stats_.lb_subsets_created_.value());
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_created_.value());
+
+  // No host has the value, so no subset is created.
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_created_.value());
+
+  modifyHosts({makeHost("tcp://127.0.0.1:8000", {{"version", "1.2"}}),
+               makeHost("tcp://127.0.0.1:8001", {{"version", "1.0"}})},
+              {host_set_.hosts_[1], host_set_.hosts_[2]});
+
+  // The existing subset is updated with the new hosts.
+  const HostConstSharedPtr first = lb_->chooseHost(&context_10).host;
+  const HostConstSharedPtr second = lb_->chooseHost(&context_10).host;
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(first == host_set_.hosts_[0] || first == host_set_.hosts_[3]);
+  EXPECT_TRUE(second == host_set_.hosts_[0] || second == host_set_.hosts_[3]);
+  EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(&context_12).host);
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+  EXPECT_EQ(0U, stats_.lb_subsets_removed_.value());
+}
+
+TEST_P(SubsetLoadBalancerTest, LazySubsetRemovedWhenEmpty) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsetIdleTimeout())
+      .WillRepeatedly(Return(std::chrono::milliseconds(1000)));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+  });
+
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+
+  const HostSharedPtr removed = host_set_.hosts_[1];
+  modifyHosts({}, {removed});
+
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(0U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+
+  modifyHosts({removed}, {});
+
+  EXPECT_EQ(removed, lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(2U, stats_.lb_subsets_created_.value());
+}
+
+TEST_P(SubsetLoadBalancerTest, LazySubsetsEvictedWhenIdle) {
+  EXPECT_CALL(subset_info_, fallbackPolicy())
+      .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
+  EXPECT_CALL(subset_info_, lazySubsetIdleTimeout())
+      .WillRepeatedly(Return(std::chrono::milliseconds(1000)));
+
+  std::vector<SubsetSelectorPtr> subset_selectors = {makeSelector(
+      {"version"},
+      envoy::config::cluster::v3::Cluster::LbSubsetConfig::LbSubsetSelector::NOT_DEFINED)};
+
+  EXPECT_CALL(subset_info_, subsetSelectors()).WillRepeatedly(ReturnRef(subset_selectors));
+
+  init({
+      {"tcp://127.0.0.1:80", {{"version", "1.0"}}},
+      {"tcp://127.0.0.1:81", {{"version", "1.1"}}},
+  });
+
+  TestLoadBalancerContext context_10({{"version", "1.0"}});
+  TestLoadBalancerContext context_11({{"version", "1.1"}});
+  TestLoadBalancerContext context_12({{"version", "1.2"}});
+
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10).host);
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+
+  // Both subsets were used since the previous sweep, so they are kept.
+  simTime().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12).host);
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+
+  // Only the 1.0 subset is used before the next sweep, which releases the 1.1 subset.
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(&context_10).host);
+  simTime().advanceTimeWait(std::chrono::milliseconds(1000));
+  EXPECT_EQ(nullptr, lb_->chooseHost(&context_12).host);
+  EXPECT_EQ(1U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(1U, stats_.lb_subsets_removed_.value());
+
+  // The released subset is created again when selected.
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(&context_11).host);
+  EXPECT_EQ(2U, stats_.lb_subsets_active_.value());
+  EXPECT_EQ(3U, stats_.lb_subsets_created_.value());
+}
+
 TEST_P(SubsetLoadBalancerTest, ListAsAnyEnabled) {
   EXPECT_CALL(subset_info_, fallbackPolicy())
       .WillRepeatedly(Return(envoy::config::cluster::v3::Cluster::LbSubsetConfig::NO_FALLBACK));
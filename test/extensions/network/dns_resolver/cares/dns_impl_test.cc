@@ -741,6 +741,10 @@ public:
     // Enable `reinit_channel_on_timeout` if requested by the test case.
     cares.set_reinit_channel_on_timeout(reinitOnTimeout());
 
+    if (cacheResponses()) {
+      cares.mutable_response_cache();
+    }
+
     // Copy over the dns_resolver_options_.
     cares.mutable_dns_resolver_options()->MergeFrom(dns_resolver_options);
     // setup the typed config
@@ -998,6 +1002,7 @@ protected:
   virtual bool setRotateNameservers() const { return false; }
   virtual Protobuf::UInt32Value* udpMaxQueries() const { return nullptr; }
   virtual uint32_t getEdns0MaxPayloadSize() const { return 0; }
+  virtual bool cacheResponses() const { return false; }
   Stats::TestUtil::TestStore stats_store_;
   NiceMock<Runtime::MockLoader> runtime_;
   std::unique_ptr<TestDnsServer> server_;
@@ -2367,5 +2372,140 @@ TEST_P(DnsImplEdns0Test, Edns0ConfigurationApplied) {
   ares_destroy_options(&opts);
 }
 
+class DnsImplResponseCacheTest : public DnsImplTest {
+protected:
+  bool cacheResponses() const override { return true; }
+
+  uint64_t counter(const std::string& name) {
+    return stats_store_.counter(absl::StrCat("dns.cares.", name)).value();
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(IpVersions, DnsImplResponseCacheTest,
+                         testing::ValuesIn(TestEnvironment::getIpVersionsForTest()),
+                         TestUtility::ipTestParamsToString);
+
+// A cached response is returned synchronously, without querying the server again.
+TEST_P(DnsImplResponseCacheTest, CachedResponse) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, std::chrono::seconds(300)));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(1, counter("cache_hits"));
+  EXPECT_EQ(1, counter("cache_misses"));
+
+  // The responses are cached per lookup family.
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Preferred,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(2, counter("cache_misses"));
+
+  // Resetting the networking drops the cached responses.
+  resolver_->resetNetworking();
+  resetChannel();
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(1, counter("cache_hits"));
+  EXPECT_EQ(3, counter("cache_misses"));
+}
+
+// The responses without TTL are not cached.
+TEST_P(DnsImplResponseCacheTest, ZeroTtlNotCached) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+
+  for (int i = 0; i < 2; i++) {
+    EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                               DnsResolver::ResolutionStatus::Completed,
+                                               {"201.134.56.7"}, {}, absl::nullopt));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+  EXPECT_EQ(0, counter("cache_hits"));
+  EXPECT_EQ(2, counter("cache_misses"));
+}
+
+// The responses without records are cached for the negative TTL.
+TEST_P(DnsImplResponseCacheTest, NegativeResponseCached) {
+  EXPECT_NE(nullptr, resolveWithNoRecordsExpectation("some.bad.domain", DnsLookupFamily::V4Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  EXPECT_EQ(nullptr, resolveWithNoRecordsExpectation("some.bad.domain", DnsLookupFamily::V4Only));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 1 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(1, counter("cache_hits"));
+}
+
+// Concurrent queries for the same name and lookup family are answered by a single resolution.
+TEST_P(DnsImplResponseCacheTest, ConcurrentQueriesCoalesced) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+
+  std::vector<std::string> coalesced_results;
+  const auto coalesced_callback = [&](DnsResolver::ResolutionStatus status, absl::string_view,
+                                      std::list<DnsResponse>&& results) {
+    EXPECT_EQ(DnsResolver::ResolutionStatus::Completed, status);
+    for (const std::string& address : getAddressAsStringList(results)) {
+      coalesced_results.push_back(address);
+    }
+  };
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  EXPECT_NE(nullptr,
+            resolver_->resolve("some.good.domain", DnsLookupFamily::V4Only, coalesced_callback));
+  ActiveDnsQuery* cancelled_query =
+      resolveWithUnreferencedParameters("some.good.domain", DnsLookupFamily::V4Only, false);
+  ASSERT_NE(nullptr, cancelled_query);
+  cancelled_query->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  EXPECT_THAT(coalesced_results, testing::ElementsAre("201.134.56.7"));
+  checkStats(1 /*resolve_total*/, 0 /*pending_resolutions*/, 0 /*not_found*/,
+             0 /*get_addr_failure*/, 0 /*timeouts*/, 0 /*reinitializations*/);
+  EXPECT_EQ(2, counter("coalesced_queries"));
+  EXPECT_EQ(3, counter("cache_misses"));
+}
+
+// The resolvers with the same configuration share their cached responses.
+TEST_P(DnsImplResponseCacheTest, CacheSharedByResolvers) {
+  server_->addHosts("some.good.domain", {"201.134.56.7"}, RecordType::A);
+  server_->setRecordTtl(std::chrono::seconds(300));
+  EXPECT_NE(nullptr, resolveWithExpectations("some.good.domain", DnsLookupFamily::V4Only,
+                                             DnsResolver::ResolutionStatus::Completed,
+                                             {"201.134.56.7"}, {}, absl::nullopt));
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+
+  envoy::config::core::v3::TypedExtensionConfig typed_dns_resolver_config =
+      getTypedDnsResolverConfig({}, dns_resolver_options_);
+  DnsResolverSharedPtr other_resolver =
+      createDnsResolverFactoryFromTypedConfig(typed_dns_resolver_config)
+          .createDnsResolver(*dispatcher_, *api_, typed_dns_resolver_config)
+          .value();
+  bool resolved = false;
+  EXPECT_EQ(nullptr, other_resolver->resolve(
+                         "some.good.domain", DnsLookupFamily::V4Only,
+                         [&](DnsResolver::ResolutionStatus status, absl::string_view details,
+                             std::list<DnsResponse>&& results) {
+                           EXPECT_EQ(DnsResolver::ResolutionStatus::Completed, status);
+                           EXPECT_EQ("cares_cache_hit", details);
+                           EXPECT_THAT(getAddressAsStringList(results),
+                                       testing::ElementsAre("201.134.56.7"));
+                           resolved = true;
+                         }));
+  EXPECT_TRUE(resolved);
+  EXPECT_EQ(1, counter("cache_hits"));
+}
+
 } // namespace Network
 } // namespace Envoy
@@ -0,0 +1,126 @@
+#include <chrono>
+#include <list>
+
+#include "source/common/network/utility.h"
+#include "source/extensions/network/dns_resolver/cares/response_cache.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+using ResponseCacheConfig = envoy::extensions::network::dns_resolver::cares::v3::ResponseCache;
+
+std::list<DnsResponse> records(std::chrono::seconds ttl) {
+  std::list<DnsResponse> records;
+  records.emplace_back(Utility::parseInternetAddressNoThrow("10.0.0.1"), ttl);
+  records.emplace_back(Utility::parseInternetAddressNoThrow("10.0.0.2"), 2 * ttl);
+  return records;
+}
+
+class DnsResponseCacheTest : public testing::Test {
+public:
+  const DnsResponseCache::Key key_{"some.good.domain", DnsLookupFamily::V4Only};
+  const MonotonicTime now_{std::chrono::hours(1)};
+};
+
+// The responses are cached for the lowest TTL of their records, which is reduced to the remaining
+// time to live on lookup.
+TEST_F(DnsResponseCacheTest, TtlHonored) {
+  DnsResponseCache cache{ResponseCacheConfig()};
+  cache.insert(key_, records(std::chrono::seconds(60)), now_);
+
+  auto response = cache.lookup(key_, now_ + std::chrono::milliseconds(20500));
+  ASSERT_TRUE(response.has_value());
+  ASSERT_EQ(2, response->records_.size());
+  for (const DnsResponse& record : response->records_) {
+    EXPECT_EQ(std::chrono::seconds(40), record.addrInfo().ttl_);
+  }
+  EXPECT_EQ("10.0.0.1", response->records_.front().addrInfo().address_->ip()->addressAsString());
+  EXPECT_FALSE(response->prefetch_);
+
+  EXPECT_FALSE(cache.lookup(key_, now_ + std::chrono::seconds(60)).has_value());
+  EXPECT_EQ(0, cache.size());
+}
+
+// The responses with a TTL of 0 are not cached, and replace any previous one.
+TEST_F(DnsResponseCacheTest, ZeroTtlNotCached) {
+  DnsResponseCache cache{ResponseCacheConfig()};
+  cache.insert(key_, records(std::chrono::seconds(60)), now_);
+  cache.insert(key_, records(std::chrono::seconds(0)), now_);
+  EXPECT_FALSE(cache.lookup(key_, now_).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, NegativeTtl) {
+  ResponseCacheConfig config;
+  DnsResponseCache default_cache{config};
+  default_cache.insert(key_, {}, now_);
+  auto response = default_cache.lookup(key_, now_ + std::chrono::seconds(4));
+  ASSERT_TRUE(response.has_value());
+  EXPECT_TRUE(response->records_.empty());
+  EXPECT_FALSE(default_cache.lookup(key_, now_ + std::chrono::seconds(5)).has_value());
+
+  config.mutable_negative_ttl()->set_seconds(0);
+  DnsResponseCache cache{config};
+  cache.insert(key_, {}, now_);
+  EXPECT_FALSE(cache.lookup(key_, now_).has_value());
+}
+
+TEST_F(DnsResponseCacheTest, EvictsLeastRecentlyUsedResponses) {
+  ResponseCacheConfig config;
+  config.mutable_max_entries()->set_value(2);
+  DnsResponseCache cache{config};
+  const DnsResponseCache::Key other_key{"some.good.domain", DnsLookupFamily::V6Only};
+  const DnsResponseCache::Key another_key{"other.good.domain", DnsLookupFamily::V4Only};
+
+  cache.insert(key_, records(std::chrono::seconds(60)), now_);
+  cache.insert(other_key, records(std::chrono::seconds(60)), now_);
+  EXPECT_TRUE(cache.lookup(key_, now_).has_value());
+  cache.insert(another_key, records(std::chrono::seconds(60)), now_);
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.lookup(key_, now_).has_value());
+  EXPECT_FALSE(cache.lookup(other_key, now_).has_value());
+  EXPECT_TRUE(cache.lookup(another_key, now_).has_value());
+
+  cache.clear();
+  EXPECT_EQ(0, cache.size());
+}
+
+// A single lookup in the last tenth of the TTL of a response is asked to refresh it.
+TEST_F(DnsResponseCacheTest, Prefetch) {
+  ResponseCacheConfig config;
+  config.set_prefetch(true);
+  DnsResponseCache cache{config};
+  cache.insert(key_, records(std::chrono::seconds(100)), now_);
+
+  EXPECT_FALSE(cache.lookup(key_, now_ + std::chrono::seconds(89))->prefetch_);
+  EXPECT_TRUE(cache.lookup(key_, now_ + std::chrono::seconds(90))->prefetch_);
+  EXPECT_FALSE(cache.lookup(key_, now_ + std::chrono::seconds(91))->prefetch_);
+
+  // The refreshed response is prefetched again.
+  cache.insert(key_, records(std::chrono::seconds(100)), now_ + std::chrono::seconds(91));
+  EXPECT_TRUE(cache.lookup(key_, now_ + std::chrono::seconds(181))->prefetch_);
+
+  // The negatively cached names are not prefetched.
+  cache.insert(key_, {}, now_);
+  EXPECT_FALSE(cache.lookup(key_, now_ + std::chrono::milliseconds(4900))->prefetch_);
+}
+
+TEST_F(DnsResponseCacheTest, SharedByConfiguration) {
+  const ResponseCacheConfig config;
+  DnsResponseCacheSharedPtr cache = DnsResponseCache::getShared(1, config);
+  EXPECT_EQ(cache, DnsResponseCache::getShared(1, config));
+  EXPECT_NE(cache, DnsResponseCache::getShared(2, config));
+
+  cache->insert(key_, records(std::chrono::seconds(60)), now_);
+  cache.reset();
+  // The cache of a configuration is destroyed with its last user.
+  EXPECT_EQ(0, DnsResponseCache::getShared(1, config)->size());
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
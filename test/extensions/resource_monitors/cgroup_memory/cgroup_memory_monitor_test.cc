@@ -9,6 +9,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+using testing::_;
 using testing::NiceMock;
 using testing::Return;
 
@@ -244,6 +245,31 @@ TEST(CgroupMemoryMonitorTest, HandlesErrorScenarios) {
   }
 }
 
+// Test that the monitor requests a refresh whenever the cgroup v2 memory events change
+TEST(CgroupMemoryMonitorTest, RefreshesOnMemoryEvents) {
+  envoy::extensions::resource_monitors::cgroup_memory::v3::CgroupMemoryConfig config;
+  config.set_refresh_on_memory_events(true);
+
+  testing::NiceMock<Filesystem::MockInstance> mock_fs;
+  ON_CALL(mock_fs, fileExists).WillByDefault(Return(false));
+  EXPECT_CALL(mock_fs, fileExists(CgroupPaths::V2::getUsagePath())).WillRepeatedly(Return(true));
+  EXPECT_CALL(mock_fs, fileExists(CgroupPaths::V2::getLimitPath())).WillRepeatedly(Return(true));
+
+  auto watcher = std::make_unique<Filesystem::MockWatcher>();
+  Filesystem::Watcher::OnChangedCb on_changed;
+  EXPECT_CALL(*watcher, addWatch(CgroupPaths::V2::getEventsPath(),
+                                 Filesystem::Watcher::Events::Modified, _))
+      .WillOnce(testing::DoAll(testing::SaveArg<2>(&on_changed), Return(absl::OkStatus())));
+
+  auto monitor = std::make_unique<CgroupMemoryMonitor>(config, mock_fs, std::move(watcher));
+  int refreshes = 0;
+  monitor->setRefreshCallback([&refreshes]() { ++refreshes; });
+
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::Modified).ok());
+  EXPECT_TRUE(on_changed(Filesystem::Watcher::Events::Modified).ok());
+  EXPECT_EQ(2, refreshes);
+}
+
 } // namespace
 } // namespace CgroupMemory
 } // namespace ResourceMonitors
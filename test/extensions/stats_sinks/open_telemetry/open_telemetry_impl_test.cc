@@ -606,6 +606,40 @@ TEST_F(OtlpMetricsFlusherTests, DeltaHistogramMetric) {
                   getTagExtractedName("test_histogram2"), true);
 }
 
+TEST_F(OtlpMetricsFlusherTests, ExponentialHistogramMetric) {
+  SinkConfig sink_config;
+  sink_config.mutable_exponential_histogram()->mutable_max_buckets()->set_value(8);
+  OtlpMetricsFlusherImpl flusher(std::make_shared<OtlpOptions>(
+      sink_config, Tracers::OpenTelemetry::Resource(), server_factory_context_));
+
+  addHistogramToSnapshot("test_histogram");
+  // Bucket midpoints are 0.05, 1.05 and 7.5, which only fit in 8 buckets at scale 1.
+  ON_CALL(*histogram_storage_.back(), detailedTotalBuckets())
+      .WillByDefault(Return(std::vector<Stats::ParentHistogram::Bucket>{
+          {0, 0.1, 2}, {1, 0.1, 3}, {7, 1, 1}}));
+
+  MetricsExportRequestSharedPtr metrics =
+      flusher.flush(snapshot_, delta_start_time_ns_, cumulative_start_time_ns_);
+  expectMetricsCount(metrics, 1);
+  const auto& metric = metricAt(0, metrics);
+  EXPECT_EQ(getTagExtractedName("test_histogram"), metric.name());
+  ASSERT_TRUE(metric.has_exponential_histogram());
+  EXPECT_EQ(AggregationTemporality::AGGREGATION_TEMPORALITY_CUMULATIVE,
+            metric.exponential_histogram().aggregation_temporality());
+  ASSERT_EQ(1, metric.exponential_histogram().data_points().size());
+
+  const auto& data_point = metric.exponential_histogram().data_points()[0];
+  EXPECT_EQ(expected_time_ns_, data_point.time_unix_nano());
+  EXPECT_EQ(cumulative_start_time_ns_, data_point.start_time_unix_nano());
+  EXPECT_EQ(6, data_point.count());
+  EXPECT_EQ(hist_stats_.back()->sampleSum(), data_point.sum());
+  EXPECT_EQ(0.5, data_point.zero_threshold());
+  EXPECT_EQ(2, data_point.zero_count());
+  EXPECT_EQ(1, data_point.scale());
+  EXPECT_EQ(0, data_point.positive().offset());
+  EXPECT_THAT(data_point.positive().bucket_counts(), testing::ElementsAre(3, 0, 0, 0, 0, 1));
+}
+
 using OtlpMetricsFlusherAggregationTests = OtlpMetricsFlusherTests;
 
 TEST_F(OtlpMetricsFlusherAggregationTests, MetricsWithLabelsAggregationCounter) {
@@ -354,6 +354,100 @@ TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithBuffer) {
   EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
 }
 
+// Verifies each export has the resource and only the spans finished since the previous export.
+TEST_F(OpenTelemetryDriverTest, ExportOTLPSpansOfEachFlush) {
+  setupValidDriver();
+  Tracing::TestTraceContextImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .Times(2)
+      .WillRepeatedly(Return(1));
+  std::vector<opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest> requests;
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&requests](absl::string_view, absl::string_view, Buffer::InstancePtr&& request,
+                             Grpc::RawAsyncRequestCallbacks&, Tracing::Span&,
+                             const Http::AsyncClient::RequestOptions&) -> Grpc::AsyncRequest* {
+            requests.emplace_back();
+            EXPECT_TRUE(requests.back().ParseFromString(request->toString()));
+            return nullptr;
+          }));
+
+  Tracing::SpanPtr first_span = driver_->startSpan(mock_tracing_config_, request_headers,
+                                                   stream_info_, "first",
+                                                   {Tracing::Reason::Sampling, true});
+  first_span->setTag("first_tag_name", "first_tag_value");
+  first_span->finishSpan();
+  Tracing::SpanPtr second_span = driver_->startSpan(mock_tracing_config_, request_headers,
+                                                    stream_info_, "second",
+                                                    {Tracing::Reason::Sampling, true});
+  second_span->finishSpan();
+
+  ASSERT_EQ(2, requests.size());
+  for (const auto& request : requests) {
+    ASSERT_EQ(1, request.resource_spans_size());
+    EXPECT_EQ(requests[0].resource_spans(0).resource().DebugString(),
+              request.resource_spans(0).resource().DebugString());
+    ASSERT_EQ(1, request.resource_spans(0).scope_spans_size());
+    EXPECT_EQ("envoy", request.resource_spans(0).scope_spans(0).scope().name());
+    ASSERT_EQ(1, request.resource_spans(0).scope_spans(0).spans_size());
+  }
+  EXPECT_FALSE(requests[0].resource_spans(0).resource().attributes().empty());
+  const auto& second_exported_span = requests[1].resource_spans(0).scope_spans(0).spans(0);
+  EXPECT_EQ("second", second_exported_span.name());
+  EXPECT_TRUE(second_exported_span.attributes().empty());
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
+// Verifies the spans which were not sampled are exported if they fail or are slow.
+TEST_F(OpenTelemetryDriverTest, ExportTailSampledSpans) {
+  const std::string yaml_string = R"EOF(
+    grpc_service:
+      envoy_grpc:
+        cluster_name: fake-cluster
+      timeout: 0.250s
+    tail_sampling:
+      keep_errors: true
+      min_duration: 1s
+    )EOF";
+  envoy::config::trace::v3::OpenTelemetryConfig opentelemetry_config;
+  TestUtility::loadFromYaml(yaml_string, opentelemetry_config);
+  setup(opentelemetry_config);
+  Tracing::TestTraceContextImpl request_headers{
+      {":authority", "test.com"}, {":path", "/"}, {":method", "GET"}};
+  ON_CALL(stream_info_, startTime()).WillByDefault(Return(time_system_.systemTime()));
+  EXPECT_CALL(runtime_.snapshot_, getInteger("tracing.opentelemetry.min_flush_spans", 5U))
+      .WillRepeatedly(Return(1));
+
+  // A fast and successful span is not exported.
+  Tracing::SpanPtr span = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_,
+                                             operation_name_, {Tracing::Reason::Sampling, false});
+  span->setTag(Tracing::Tags::get().HttpStatusCode, "200");
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _)).Times(0);
+  span->finishSpan();
+  testing::Mock::VerifyAndClearExpectations(mock_client_);
+
+  // A failed span is exported.
+  span = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_, operation_name_,
+                            {Tracing::Reason::Sampling, false});
+  span->setTag(Tracing::Tags::get().HttpStatusCode, "503");
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _));
+  span->finishSpan();
+  testing::Mock::VerifyAndClearExpectations(mock_client_);
+
+  // A slow span is exported.
+  span = driver_->startSpan(mock_tracing_config_, request_headers, stream_info_, operation_name_,
+                            {Tracing::Reason::Sampling, false});
+  time_system_.advanceTimeWait(std::chrono::seconds(2));
+  EXPECT_CALL(*mock_client_, sendRaw(_, _, _, _, _, _));
+  span->finishSpan();
+
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_tail_sampled").value());
+  EXPECT_EQ(2U, stats_.counter("tracing.opentelemetry.spans_sent").value());
+}
+
 // Verifies that spans beyond max_cache_size are discarded
 TEST_F(OpenTelemetryDriverTest, ExportOTLPSpanWithMaxCacheSize) {
   // Set up driver with custom max_cache_size = 2
@@ -1,5 +1,6 @@
 #include "source/common/tracing/http_tracer_impl.h"
 #include "source/extensions/tracers/opentelemetry/span_context_extractor.h"
+#include "source/extensions/tracers/opentelemetry/trace_parent.h"
 
 #include "test/test_common/status_utility.h"
 #include "test/test_common/utility.h"
@@ -189,6 +190,41 @@ TEST(SpanContextExtractorTest, ExtractSpanContextWithMultipleTracestateEntries)
   EXPECT_EQ(span_context->tracestate(), "sample-tracestate,sample-tracestate-2");
 }
 
+TEST(TraceParentTest, ParseAndSerialize) {
+  const std::string header_value = "00-0123456789ABCDEF0123456789abcdef-fedcba9876543210-01";
+  absl::StatusOr<TraceParent> trace_parent = TraceParent::parse(header_value);
+
+  ASSERT_OK(trace_parent);
+  EXPECT_EQ(0, trace_parent->version());
+  EXPECT_EQ(0x01, trace_parent->traceId()[0]);
+  EXPECT_EQ(0xef, trace_parent->traceId()[15]);
+  EXPECT_EQ(0xfe, trace_parent->spanId()[0]);
+  EXPECT_EQ(0x10, trace_parent->spanId()[7]);
+  EXPECT_TRUE(trace_parent->sampled());
+
+  const TraceParent::HeaderValue serialized = trace_parent->headerValue();
+  EXPECT_EQ("00-0123456789abcdef0123456789abcdef-fedcba9876543210-01",
+            absl::string_view(serialized.data(), serialized.size()));
+}
+
+TEST(TraceParentTest, FromBytes) {
+  const TraceParent::HeaderValue serialized =
+      TraceParent::fromBytes(0, std::string(15, '\x01') + '\xff', "\x02", false).headerValue();
+  EXPECT_EQ("00-010101010101010101010101010101ff-0200000000000000-00",
+            absl::string_view(serialized.data(), serialized.size()));
+}
+
+TEST(TraceParentTest, ParseErrors) {
+  EXPECT_THAT(TraceParent::parse("00-0123456789abcdef0123456789abcdef-fedcba9876543210-0"),
+              HasStatusMessage("Invalid traceparent header length"));
+  EXPECT_THAT(TraceParent::parse("00-0123456789abcdef0123456789abcdef-fedcba9876543210001"),
+              HasStatusMessage("Invalid traceparent hyphenation"));
+  EXPECT_THAT(TraceParent::parse("000-123456789abcdef0123456789abcdef-fedcba9876543210-01"),
+              HasStatusMessage("Invalid traceparent field sizes"));
+  EXPECT_THAT(TraceParent::parse("00-0123456789abcdef0123456789abcdeg-fedcba9876543210-01"),
+              HasStatusMessage("Invalid header hex"));
+}
+
 } // namespace
 } // namespace OpenTelemetry
 } // namespace Tracers
@@ -29,7 +29,8 @@ namespace {
 
 class TcpStatsTest : public testing::Test {
 public:
-  void initialize(bool enable_periodic) {
+  void initialize(bool enable_periodic,
+                  absl::optional<uint32_t> max_connections_per_update = absl::nullopt) {
     // Reset the C struct tcp_info_ members.
     memset(&tcp_info_, 0, sizeof(tcp_info_));
     envoy::extensions::transport_sockets::tcp_stats::v3::Config proto_config;
@@ -37,6 +38,10 @@ public:
       proto_config.mutable_update_period()->MergeFrom(
           ProtobufUtil::TimeUtil::MillisecondsToDuration(1000));
     }
+    if (max_connections_per_update.has_value()) {
+      proto_config.mutable_max_connections_per_update()->set_value(
+          max_connections_per_update.value());
+    }
     config_ = std::make_shared<Config>(proto_config, *store_.rootScope());
     ON_CALL(transport_callbacks_, ioHandle()).WillByDefault(ReturnRef(io_handle_));
     ON_CALL(io_handle_, getOption(IPPROTO_TCP, TCP_INFO, _, _))
@@ -45,7 +50,14 @@ public:
           memcpy(optval, &tcp_info_, sizeof(tcp_info_));
           return Api::SysCallIntResult{0, 0};
         }));
-    createTcpStatsSocket(enable_periodic, timer_, inner_socket_, tcp_stats_socket_);
+    if (max_connections_per_update.has_value()) {
+      // The connections share the timer of the sampler of their worker.
+      timer_ = new NiceMock<Event::MockTimer>(&transport_callbacks_.connection_.dispatcher_);
+      EXPECT_CALL(*timer_, enableTimer(std::chrono::milliseconds(1000), _)).Times(AtLeast(1));
+      createTcpStatsSocket(false, timer_, inner_socket_, tcp_stats_socket_);
+    } else {
+      createTcpStatsSocket(enable_periodic, timer_, inner_socket_, tcp_stats_socket_);
+    }
   }
 
   void createTcpStatsSocket(bool enable_periodic, NiceMock<Event::MockTimer>*& timer,
@@ -124,6 +136,40 @@ TEST_F(TcpStatsTest, CloseSocket) {
   EXPECT_EQ(0, gaugeValue("cx_tx_unacked_segments"));
 }
 
+// With max_connections_per_update, the connections of a worker are updated in turn by the timer of
+// its sampler.
+TEST_F(TcpStatsTest, MaxConnectionsPerUpdate) {
+  initialize(true, 1);
+  NiceMock<Network::MockTransportSocket>* other_inner_socket;
+  std::unique_ptr<TcpStatsSocket> other_tcp_stats_socket;
+  createTcpStatsSocket(false, timer_, other_inner_socket, other_tcp_stats_socket);
+  tcp_info_.tcpi_segs_out = 10;
+
+  EXPECT_CALL(io_handle_, getOption(IPPROTO_TCP, TCP_INFO, _, _));
+  timer_->invokeCallback();
+  EXPECT_EQ(10, counterValue("cx_tx_segments"));
+  EXPECT_TRUE(timer_->enabled());
+
+  EXPECT_CALL(io_handle_, getOption(IPPROTO_TCP, TCP_INFO, _, _));
+  timer_->invokeCallback();
+  EXPECT_EQ(20, counterValue("cx_tx_segments"));
+
+  // Back to the first connection, which has not sent anything since.
+  timer_->invokeCallback();
+  EXPECT_EQ(20, counterValue("cx_tx_segments"));
+
+  other_tcp_stats_socket->closeSocket(Network::ConnectionEvent::RemoteClose);
+  tcp_info_.tcpi_segs_out = 15;
+  timer_->invokeCallback();
+  EXPECT_EQ(25, counterValue("cx_tx_segments"));
+
+  // The sampler and its timer are destroyed with the last connection.
+  bool timer_destroyed = false;
+  timer_->timer_destroyed_ = &timer_destroyed;
+  tcp_stats_socket_->closeSocket(Network::ConnectionEvent::RemoteClose);
+  EXPECT_TRUE(timer_destroyed);
+}
+
 TEST_F(TcpStatsTest, SyscallFailureReturnCode) {
   initialize(true);
   tcp_info_.tcpi_notsent_bytes = 42;
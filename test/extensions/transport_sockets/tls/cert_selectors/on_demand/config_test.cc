@@ -1,4 +1,5 @@
 #include "envoy/extensions/transport_sockets/tls/cert_mappers/filter_state_override/v3/config.pb.h"
+#include "envoy/extensions/transport_sockets/tls/cert_mappers/server_name_index/v3/config.pb.h"
 #include "envoy/extensions/transport_sockets/tls/cert_mappers/sni/v3/config.pb.h"
 #include "envoy/extensions/transport_sockets/tls/cert_mappers/static_name/v3/config.pb.h"
 #include "envoy/extensions/transport_sockets/tls/cert_selectors/on_demand_secret/v3/config.pb.h"
@@ -7,6 +8,7 @@
 #include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/router/string_accessor_impl.h"
 #include "source/common/tls/context_impl.h"
+#include "source/extensions/transport_sockets/tls/cert_mappers/server_name_index/config.h"
 #include "source/extensions/transport_sockets/tls/cert_selectors/on_demand/config.h"
 
 #include "test/mocks/server/server_factory_context.h"
@@ -121,6 +123,95 @@ TEST(FilterStateMapper, Derivation) {
   EXPECT_EQ("new_value", mapper->deriveFromServerHello(*ssl, transport_socket_options));
 }
 
+TEST(ServerNameTrie, Find) {
+  CertificateMappers::ServerNameIndex::ServerNameTrie trie;
+  EXPECT_OK(trie.add("www.Example.com", "www"));
+  EXPECT_OK(trie.add("*.example.com", "wildcard"));
+  EXPECT_OK(trie.add("example.com", "apex"));
+  EXPECT_OK(trie.add("example.org", "apex"));
+  // Adding a server name again with the same secret is allowed.
+  EXPECT_OK(trie.add("*.example.com", "wildcard"));
+
+  EXPECT_EQ("www", *trie.find("www.example.com"));
+  EXPECT_EQ("wildcard", *trie.find("api.example.com"));
+  EXPECT_EQ("apex", *trie.find("example.com"));
+  EXPECT_EQ("apex", *trie.find("example.org"));
+  // Wildcard domain names only match a single label.
+  EXPECT_EQ(nullptr, trie.find("a.www.example.com"));
+  EXPECT_EQ(nullptr, trie.find(".example.com"));
+  EXPECT_EQ(nullptr, trie.find("com"));
+  EXPECT_EQ(nullptr, trie.find("example.net"));
+  EXPECT_EQ(nullptr, trie.find(""));
+}
+
+TEST(ServerNameTrie, InvalidServerNames) {
+  CertificateMappers::ServerNameIndex::ServerNameTrie trie;
+  EXPECT_THAT(trie.add("", "secret"), StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(trie.add("*.", "secret"), StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(trie.add("a..com", "secret"), StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(trie.add("www.*.com", "secret"), StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(trie.add("*www.example.com", "secret"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_OK(trie.add("www.example.com", "secret"));
+  EXPECT_THAT(trie.add("WWW.example.com", "other"), StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ServerNameIndexMapper, Derivation) {
+  NiceMock<Server::Configuration::MockGenericFactoryContext> factory_context;
+  Ssl::TlsCertificateMapperConfigFactory& mapper_factory =
+      Config::Utility::getAndCheckFactoryByName<Ssl::TlsCertificateMapperConfigFactory>(
+          "envoy.tls.certificate_mappers.server_name_index");
+  envoy::extensions::transport_sockets::tls::cert_mappers::server_name_index::v3::ServerNameIndex
+      config;
+  TestUtility::loadFromYaml(R"EOF(
+    certificates:
+    - secret_name: example
+      server_names: ["example.com", "*.example.com"]
+    - secret_name: www
+      server_names: ["www.example.com"]
+    default_value: default
+  )EOF",
+                            config);
+  auto mapper_status = mapper_factory.createTlsCertificateMapperFactory(config, factory_context);
+  ASSERT_OK(mapper_status);
+  auto mapper = mapper_status.value()();
+
+  bssl::UniquePtr<SSL_CTX> ctx(SSL_CTX_new(TLS_method()));
+  bssl::UniquePtr<SSL> ssl(SSL_new(ctx.get()));
+  SSL_CLIENT_HELLO client_hello{};
+  client_hello.ssl = ssl.get();
+  EXPECT_EQ("default", mapper->deriveFromClientHello(client_hello));
+  for (const auto& [sni, secret_name] : std::vector<std::pair<std::string, std::string>>{
+           {"example.com", "example"},
+           {"API.example.com", "example"},
+           {"www.example.com", "www"},
+           {"a.www.example.com", "default"},
+           {"example.org", "default"}}) {
+    SSL_set_tlsext_host_name(ssl.get(), sni.c_str());
+    EXPECT_EQ(secret_name, mapper->deriveFromClientHello(client_hello)) << sni;
+  }
+}
+
+TEST(ServerNameIndexMapper, ConflictingServerNames) {
+  NiceMock<Server::Configuration::MockGenericFactoryContext> factory_context;
+  Ssl::TlsCertificateMapperConfigFactory& mapper_factory =
+      Config::Utility::getAndCheckFactoryByName<Ssl::TlsCertificateMapperConfigFactory>(
+          "envoy.tls.certificate_mappers.server_name_index");
+  envoy::extensions::transport_sockets::tls::cert_mappers::server_name_index::v3::ServerNameIndex
+      config;
+  TestUtility::loadFromYaml(R"EOF(
+    certificates:
+    - secret_name: a
+      server_names: ["*.example.com"]
+    - secret_name: b
+      server_names: ["*.example.com"]
+    default_value: default
+  )EOF",
+                            config);
+  EXPECT_THAT(mapper_factory.createTlsCertificateMapperFactory(config, factory_context),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 } // namespace
 } // namespace OnDemand
 } // namespace CertificateSelectors
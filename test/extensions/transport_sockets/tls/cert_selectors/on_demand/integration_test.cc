@@ -390,6 +390,38 @@ TEST_P(OnDemandIntegrationTest, BasicSuccessMixed) {
   EXPECT_EQ(2, test_server_->gauge(onDemandStat("cert_active"))->value());
 }
 
+TEST_P(OnDemandIntegrationTest, EvictLeastRecentlyUsed) {
+  setup(R"EOF(
+  certificate_mapper:
+    name: static-name
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.transport_sockets.tls.cert_mappers.static_name.v3.StaticName
+      name: server
+  prefetch_secret_names:
+  - server2
+  max_active_certificates: 1
+  )EOF");
+
+  createXdsConnection();
+  waitSendSdsResponse("server2");
+  test_server_->waitForCounterEq("sds.server2.update_success", 1);
+  // Requesting a second certificate unloads the unused prefetched one.
+  auto conn = createClientConnection();
+  if (upstream_selector_) {
+    conn->waitForUpstreamConnection();
+  }
+  waitCertsRequested(2);
+  test_server_->waitForCounterEq(onDemandStat("cert_evicted"), 1);
+  waitSendSdsResponse("server");
+  if (!upstream_selector_) {
+    conn->waitForUpstreamConnection();
+  }
+  conn->sendAndReceiveTlsData("hello", "world");
+  conn.reset();
+  test_server_->waitForCounterEq("sds.server.update_success", 1);
+  EXPECT_EQ(1, test_server_->gauge(onDemandStat("cert_active"))->value());
+}
+
 TEST_P(OnDemandIntegrationTest, BasicFail) {
   setup();
   auto conn = createClientConnection();
@@ -0,0 +1,168 @@
+#include <memory>
+#include <vector>
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/transport_sockets/tls/private_key_providers/thread_pool/thread_pool_private_key_provider.h"
+
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/ec_key.h"
+#include "openssl/evp.h"
+#include "openssl/nid.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace ThreadPool {
+namespace {
+
+class MockPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  MOCK_METHOD(void, onPrivateKeyMethodComplete, (), (override));
+};
+
+bssl::UniquePtr<EVP_PKEY> generateEcdsaKey() {
+  bssl::UniquePtr<EC_KEY> ec_key(EC_KEY_new_by_curve_name(NID_X9_62_prime256v1));
+  RELEASE_ASSERT(EC_KEY_generate_key(ec_key.get()), "");
+  bssl::UniquePtr<EVP_PKEY> pkey(EVP_PKEY_new());
+  RELEASE_ASSERT(EVP_PKEY_assign_EC_KEY(pkey.get(), ec_key.release()), "");
+  return pkey;
+}
+
+class ThreadPoolPrivateKeyProviderTest : public testing::Test {
+public:
+  ThreadPoolPrivateKeyProviderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        pkey_(generateEcdsaKey()),
+        stats_{ALL_THREAD_POOL_PRIVATE_KEY_STATS(
+            POOL_COUNTER_PREFIX(*store_.rootScope(), "thread_pool_private_key"),
+            POOL_HISTOGRAM_PREFIX(*store_.rootScope(), "thread_pool_private_key"))} {}
+
+  void createQueue(uint32_t max_batch_size) {
+    pool_ = std::make_shared<CryptoThreadPool>(api_->threadFactory(), 2, bssl::UpRef(pkey_));
+    queue_ = std::make_shared<WorkerQueue>(*dispatcher_, pool_, max_batch_size, stats_);
+  }
+
+  OperationSharedPtr sign(Ssl::PrivateKeyConnectionCallbacks& cb, uint16_t signature_algorithm) {
+    auto operation = std::make_shared<Operation>(Operation::Type::Sign, cb, 256);
+    operation->signature_algorithm_ = signature_algorithm;
+    operation->in_.assign(message_.begin(), message_.end());
+    return operation;
+  }
+
+  bool verify(const Operation& operation) {
+    bssl::ScopedEVP_MD_CTX ctx;
+    return EVP_DigestVerifyInit(ctx.get(), nullptr, EVP_sha256(), nullptr, pkey_.get()) &&
+           EVP_DigestVerify(ctx.get(), operation.out_.data(), operation.out_.size(),
+                            reinterpret_cast<const uint8_t*>(message_.data()), message_.size());
+  }
+
+  void run() { dispatcher_->run(Event::Dispatcher::RunType::RunUntilExit); }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  Stats::IsolatedStoreImpl store_;
+  ThreadPoolPrivateKeyStats stats_;
+  const std::string message_{"message to sign"};
+  std::shared_ptr<CryptoThreadPool> pool_;
+  WorkerQueueSharedPtr queue_;
+};
+
+// The operations requested during a loop iteration are run as a batch, and delivered back to the
+// worker.
+TEST_F(ThreadPoolPrivateKeyProviderTest, BatchedOperations) {
+  createQueue(8);
+  std::vector<MockPrivateKeyConnectionCallbacks> callbacks(3);
+  std::vector<OperationSharedPtr> operations;
+  uint32_t completed = 0;
+  for (auto& cb : callbacks) {
+    operations.push_back(sign(cb, SSL_SIGN_ECDSA_SECP256R1_SHA256));
+    EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([&]() {
+      if (++completed == callbacks.size()) {
+        dispatcher_->exit();
+      }
+    });
+    queue_->add(operations.back());
+  }
+  run();
+
+  for (const OperationSharedPtr& operation : operations) {
+    EXPECT_TRUE(operation->done_);
+    EXPECT_TRUE(operation->success_);
+    EXPECT_TRUE(verify(*operation));
+  }
+  EXPECT_EQ(3, TestUtility::findCounter(store_, "thread_pool_private_key.operations")->value());
+  EXPECT_EQ(0,
+            TestUtility::findCounter(store_, "thread_pool_private_key.failed_operations")->value());
+}
+
+// A full batch is handed to the pool without waiting for the end of the loop iteration.
+TEST_F(ThreadPoolPrivateKeyProviderTest, FullBatch) {
+  createQueue(1);
+  MockPrivateKeyConnectionCallbacks cb;
+  OperationSharedPtr operation = sign(cb, SSL_SIGN_ECDSA_SECP256R1_SHA256);
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([&]() { dispatcher_->exit(); });
+  queue_->add(operation);
+  run();
+  EXPECT_TRUE(verify(*operation));
+}
+
+TEST_F(ThreadPoolPrivateKeyProviderTest, FailedOperation) {
+  createQueue(8);
+  MockPrivateKeyConnectionCallbacks cb;
+  // An RSA signature algorithm can't be used with an ECDSA key.
+  OperationSharedPtr operation = sign(cb, SSL_SIGN_RSA_PSS_RSAE_SHA256);
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce([&]() { dispatcher_->exit(); });
+  queue_->add(operation);
+  run();
+  EXPECT_TRUE(operation->done_);
+  EXPECT_FALSE(operation->success_);
+  EXPECT_EQ(1,
+            TestUtility::findCounter(store_, "thread_pool_private_key.failed_operations")->value());
+}
+
+// The operations of the connections closed before running them are skipped, and the operations of
+// the connections closed by the callbacks of the preceding operations aren't delivered.
+TEST_F(ThreadPoolPrivateKeyProviderTest, CanceledOperations) {
+  createQueue(8);
+  MockPrivateKeyConnectionCallbacks cb1;
+  MockPrivateKeyConnectionCallbacks cb2;
+  MockPrivateKeyConnectionCallbacks cb3;
+  OperationSharedPtr operation1 = sign(cb1, SSL_SIGN_ECDSA_SECP256R1_SHA256);
+  OperationSharedPtr operation2 = sign(cb2, SSL_SIGN_ECDSA_SECP256R1_SHA256);
+  OperationSharedPtr operation3 = sign(cb3, SSL_SIGN_ECDSA_SECP256R1_SHA256);
+  queue_->add(operation1);
+  queue_->add(operation2);
+  queue_->add(operation3);
+  operation1->canceled_ = true;
+  EXPECT_CALL(cb1, onPrivateKeyMethodComplete()).Times(0);
+  EXPECT_CALL(cb2, onPrivateKeyMethodComplete()).WillOnce([&]() {
+    operation3->canceled_ = true;
+    dispatcher_->exit();
+  });
+  EXPECT_CALL(cb3, onPrivateKeyMethodComplete()).Times(0);
+  run();
+  EXPECT_EQ(
+      2, TestUtility::findCounter(store_, "thread_pool_private_key.canceled_operations")->value());
+}
+
+// A detached queue drops the operations handed back by the pool.
+TEST_F(ThreadPoolPrivateKeyProviderTest, DetachedQueue) {
+  createQueue(1);
+  MockPrivateKeyConnectionCallbacks cb;
+  EXPECT_CALL(cb, onPrivateKeyMethodComplete()).Times(0);
+  queue_->add(sign(cb, SSL_SIGN_ECDSA_SECP256R1_SHA256));
+  queue_->detach();
+  pool_.reset();
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+}
+
+} // namespace
+} // namespace ThreadPool
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -29,6 +29,25 @@ TEST(FactoryTest, CreateUdpPacketWriterFactory) {
   EXPECT_TRUE(factory.createUdpPacketWriterFactory(config) != nullptr);
 }
 
+TEST(FactoryTest, CreateCrossConnectionBatchingWriterFactory) {
+  UdpGsoBatchWriterFactoryFactory factory;
+  envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory writer_config;
+  writer_config.mutable_cross_connection_batching()->mutable_max_buffered_packets()->set_value(16);
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(writer_config);
+  Network::UdpPacketWriterFactoryPtr writer_factory = factory.createUdpPacketWriterFactory(config);
+  EXPECT_NE(nullptr, dynamic_cast<UdpSendmmsgBatchWriterFactory*>(writer_factory.get()));
+}
+
+TEST(FactoryTest, InvalidCrossConnectionBatchingConfig) {
+  UdpGsoBatchWriterFactoryFactory factory;
+  envoy::extensions::udp_packet_writer::v3::UdpGsoBatchWriterFactory writer_config;
+  writer_config.mutable_cross_connection_batching()->mutable_max_buffered_packets()->set_value(0);
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.mutable_typed_config()->PackFrom(writer_config);
+  EXPECT_THROW(factory.createUdpPacketWriterFactory(config), EnvoyException);
+}
+
 } // namespace Quic
 } // namespace Envoy
 
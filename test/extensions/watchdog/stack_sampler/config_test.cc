@@ -0,0 +1,60 @@
+#include "envoy/extensions/watchdog/stack_sampler/v3/stack_sampler.pb.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/guarddog_config.h"
+
+#include "source/extensions/watchdog/stack_sampler/config.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+namespace {
+
+TEST(StackSamplerActionFactoryTest, CanCreateAction) {
+  auto factory =
+      Registry::FactoryRegistry<Server::Configuration::GuardDogActionFactory>::getFactory(
+          "envoy.watchdog.stack_sampler");
+  ASSERT_NE(factory, nullptr);
+
+  // Create config and mock context
+  envoy::config::bootstrap::v3::Watchdog::WatchdogAction config;
+  TestUtility::loadFromJson(
+      R"EOF(
+        {
+          "config": {
+            "name": "envoy.watchdog.stack_sampler",
+            "typed_config": {
+              "@type": "type.googleapis.com/xds.type.v3.TypedStruct",
+              "type_url": "type.googleapis.com/envoy.extensions.watchdog.stack_sampler.v3.StackSamplerConfig",
+              "value": {
+                "sampling_interval": "0.005s",
+                "window": "2s",
+                "output_path": "/tmp/envoy/",
+                "max_dumps": "20"
+              }
+            }
+          },
+        }
+      )EOF",
+      config);
+
+  Stats::TestUtil::TestStore stats;
+  Event::MockDispatcher dispatcher;
+  Api::ApiPtr api = Api::createApiForTest(stats);
+  Server::Configuration::GuardDogActionFactoryContext context{*api, dispatcher, *stats.rootScope(),
+                                                              "test"};
+
+  EXPECT_NE(factory->createGuardDogActionFromProto(config, context), nullptr);
+}
+
+} // namespace
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,136 @@
+#include <chrono>
+#include <memory>
+
+#include "envoy/config/bootstrap/v3/bootstrap.pb.h"
+#include "envoy/extensions/watchdog/stack_sampler/v3/stack_sampler.pb.h"
+#include "envoy/thread/thread.h"
+
+#include "source/common/filesystem/directory.h"
+#include "source/extensions/watchdog/stack_sampler/stack_sampler.h"
+#include "source/extensions/watchdog/stack_sampler/stack_sampler_action.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_split.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Watchdog {
+namespace StackSampler {
+namespace {
+
+TEST(StackSamplerTest, FoldedStacks) {
+  void* const outer = reinterpret_cast<void*>(0x10);
+  void* const inner = reinterpret_cast<void*>(0x20);
+  const MonotonicTime now = std::chrono::steady_clock::now();
+  EXPECT_EQ("0x10 1\n0x10;0x20 2\n",
+            StackSampler::foldedStacks(
+                {{now, {inner, outer}}, {now, {outer}}, {now, {inner, outer}}}));
+  EXPECT_EQ("", StackSampler::foldedStacks({}));
+}
+
+TEST(StackSamplerTest, SharedByConfiguration) {
+  StackSamplerSharedPtr sampler = StackSampler::getShared(std::chrono::milliseconds(10), 100);
+  EXPECT_EQ(sampler, StackSampler::getShared(std::chrono::milliseconds(10), 100));
+  EXPECT_NE(sampler, StackSampler::getShared(std::chrono::milliseconds(20), 100));
+}
+
+#ifdef __linux__
+class StackSamplerActionTest : public testing::Test {
+protected:
+  StackSamplerActionTest()
+      : api_(Api::createApiForTest(stats_)),
+        context_({*api_, dispatcher_, *stats_.rootScope(), "test"}),
+        test_path_(TestEnvironment::temporaryPath(
+            testing::UnitTest::GetInstance()->current_test_info()->name())),
+        thread_id_(api_->threadFactory().currentThreadId()) {
+    TestEnvironment::createPath(test_path_);
+  }
+
+  // Keeps the current thread busy until it got some samples.
+  void spin(StackSampler& sampler, MonotonicTime since) {
+    const MonotonicTime deadline = since + std::chrono::seconds(10);
+    while (sampler.samples(thread_id_, since).size() < 5) {
+      ASSERT_LT(std::chrono::steady_clock::now(), deadline);
+    }
+  }
+
+  Stats::TestUtil::TestStore stats_;
+  Api::ApiPtr api_;
+  Event::MockDispatcher dispatcher_;
+  Server::Configuration::GuardDogActionFactoryContext context_;
+  const std::string test_path_;
+  const Thread::ThreadId thread_id_;
+};
+
+// The samples of a thread are kept while it is sampled, up to the capacity of the sampler.
+TEST_F(StackSamplerActionTest, SamplesThread) {
+  StackSampler sampler(std::chrono::milliseconds(1), 10);
+  const MonotonicTime start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(sampler.samples(thread_id_, start).empty());
+  ASSERT_TRUE(sampler.start(thread_id_));
+  EXPECT_TRUE(sampler.start(thread_id_));
+  spin(sampler, start);
+
+  const std::vector<StackSampler::Sample> samples = sampler.samples(thread_id_, start);
+  EXPECT_LE(samples.size(), 10);
+  for (const StackSampler::Sample& sample : samples) {
+    EXPECT_GE(sample.time_, start);
+    EXPECT_FALSE(sample.frames_.empty());
+  }
+  EXPECT_TRUE(sampler.samples(thread_id_, std::chrono::steady_clock::now()).empty());
+
+  sampler.stop(thread_id_);
+  EXPECT_TRUE(sampler.samples(thread_id_, start).empty());
+}
+
+// The action samples the watched threads and writes the last samples of those of an event.
+TEST_F(StackSamplerActionTest, WritesSamplesOnEvent) {
+  envoy::extensions::watchdog::stack_sampler::v3::StackSamplerConfig config;
+  config.set_output_path(test_path_);
+  config.mutable_sampling_interval()->set_nanos(1000000);
+  config.set_max_dumps(1);
+  StackSamplerAction action(config, context_);
+
+  const MonotonicTime start = std::chrono::steady_clock::now();
+  action.onWatchStarted(thread_id_);
+  spin(*StackSampler::getShared(std::chrono::milliseconds(1), 5001), start);
+  const MonotonicTime now = std::chrono::steady_clock::now();
+  action.run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::MISS, {{thread_id_, start}},
+             now);
+  // The dumps are limited.
+  action.run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::MISS, {{thread_id_, start}},
+             now);
+  action.onWatchStopped(thread_id_);
+  EXPECT_EQ(2, TestUtility::findCounter(stats_, "test.stack_sampler.attempted")->value());
+  EXPECT_EQ(1,
+            TestUtility::findCounter(stats_, "test.stack_sampler.successfully_written")->value());
+
+  int dumps = 0;
+  for (const Filesystem::DirectoryEntry& entry : Filesystem::Directory(test_path_)) {
+    if (entry.type_ != Filesystem::FileType::Regular) {
+      continue;
+    }
+    ++dumps;
+    EXPECT_TRUE(absl::StartsWith(entry.name_, "StackSampler."));
+    const std::string contents = TestEnvironment::readFileToStringForTest(
+        absl::StrCat(test_path_, "/", entry.name_));
+    for (absl::string_view line : absl::StrSplit(contents, '\n', absl::SkipEmpty())) {
+      const std::vector<absl::string_view> stack_and_count = absl::StrSplit(line, ' ');
+      uint64_t count;
+      EXPECT_TRUE(absl::SimpleAtoi(stack_and_count.back(), &count)) << line;
+    }
+  }
+  EXPECT_EQ(1, dumps);
+}
+#endif
+
+} // namespace
+} // namespace StackSampler
+} // namespace Watchdog
+} // namespace Extensions
+} // namespace Envoy
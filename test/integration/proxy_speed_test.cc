@@ -0,0 +1,140 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+//
+// Benchmarks of the full proxy path of a real server built from a bootstrap, from its listener
+// through the HTTP connection manager and the router to an autonomous upstream, over loopback.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/assert.h"
+#include "source/common/memory/stats.h"
+
+#include "test/integration/autonomous_upstream.h"
+#include "test/integration/http_integration.h"
+#include "test/test_common/environment.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace {
+
+// The filters a typical edge HCM runs before the router, configured not to alter the requests.
+constexpr absl::string_view CorsFilter = R"EOF(
+name: envoy.filters.http.cors
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.filters.http.cors.v3.Cors
+)EOF";
+
+constexpr absl::string_view FaultFilter = R"EOF(
+name: envoy.filters.http.fault
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.filters.http.fault.v3.HTTPFault
+)EOF";
+
+constexpr absl::string_view LocalRateLimitFilter = R"EOF(
+name: envoy.filters.http.local_ratelimit
+typed_config:
+  "@type": type.googleapis.com/envoy.extensions.filters.http.local_ratelimit.v3.LocalRateLimit
+  stat_prefix: http_local_rate_limiter
+  token_bucket:
+    max_tokens: 1000000000
+    tokens_per_fill: 1000000000
+    fill_interval: 1s
+  filter_enabled:
+    default_value:
+      numerator: 100
+      denominator: HUNDRED
+  filter_enforced:
+    default_value:
+      numerator: 100
+      denominator: HUNDRED
+)EOF";
+
+} // namespace
+
+class ProxyBenchmark : public HttpIntegrationTest {
+public:
+  ProxyBenchmark(Http::CodecType downstream_protocol, bool representative_filters)
+      : HttpIntegrationTest(downstream_protocol, TestEnvironment::getIpVersionsForTest().front()) {
+    autonomous_upstream_ = true;
+    setUpstreamProtocol(downstream_protocol == Http::CodecType::HTTP1 ? Http::CodecType::HTTP1
+                                                                      : Http::CodecType::HTTP2);
+    if (representative_filters) {
+      // Prepended, so the filters run in the reverse order.
+      config_helper_.prependFilter(std::string(LocalRateLimitFilter));
+      config_helper_.prependFilter(std::string(FaultFilter));
+      config_helper_.prependFilter(std::string(CorsFilter));
+      useAccessLog("%REQ(:METHOD)% %REQ(:PATH)% %RESPONSE_CODE% %DURATION%");
+    }
+  }
+
+  // Sends the requests of the benchmark one after the other on a single connection, and reports
+  // their rate, latency percentiles and the heap they retain.
+  void run(benchmark::State& state) {
+    initialize();
+    codec_client_ = makeHttpConnection(lookupPort("http"));
+    Http::TestRequestHeaderMapImpl request_headers = default_request_headers_;
+    request_headers.addCopy(AutonomousStream::RESPONSE_SIZE_BYTES, "1024");
+    // Warms up the connection pools and the caches before measuring.
+    sendRequest(request_headers);
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    const uint64_t allocated_before = Memory::Stats::totalCurrentlyAllocated();
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      const MonotonicTime start = timeSystem().monotonicTime();
+      sendRequest(request_headers);
+      latencies.push_back(timeSystem().monotonicTime() - start);
+    }
+    const uint64_t allocated_after = Memory::Stats::totalCurrentlyAllocated();
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](size_t percent) {
+      return std::chrono::duration<double, std::micro>(
+                 latencies[std::min(latencies.size() - 1, latencies.size() * percent / 100)])
+          .count();
+    };
+    state.counters["rps"] = benchmark::Counter(latencies.size(), benchmark::Counter::kIsRate);
+    state.counters["p50_us"] = percentile(50);
+    state.counters["p99_us"] = percentile(99);
+    // The heap retained across the requests, e.g. by leaks or unbounded caches. Memory::Stats does
+    // not count the allocations themselves.
+    state.counters["retained_bytes_per_request"] =
+        allocated_after > allocated_before
+            ? static_cast<double>(allocated_after - allocated_before) / latencies.size()
+            : 0;
+
+    codec_client_->close();
+  }
+
+private:
+  void sendRequest(const Http::TestRequestHeaderMapImpl& request_headers) {
+    IntegrationStreamDecoderPtr response = codec_client_->makeHeaderOnlyRequest(request_headers);
+    RELEASE_ASSERT(response->waitForEndStream(), "timed out waiting for the response");
+    RELEASE_ASSERT(response->headers().getStatusValue() == "200", "unexpected response status");
+  }
+};
+
+// Range 0 is the downstream protocol, as an Http::CodecType, proxied to an HTTP/1 upstream for
+// HTTP/1 and to an HTTP/2 one otherwise. Range 1 is 0 for the router alone, or 1 for it with
+// representative filters and an access log.
+static void bmProxyRequests(benchmark::State& state) {
+  ProxyBenchmark proxy(static_cast<Http::CodecType>(state.range(0)), state.range(1) != 0);
+  proxy.run(state);
+}
+BENCHMARK(bmProxyRequests)
+    ->ArgsProduct({{static_cast<int64_t>(Http::CodecType::HTTP1),
+                    static_cast<int64_t>(Http::CodecType::HTTP2),
+#ifdef ENVOY_ENABLE_QUIC
+                    static_cast<int64_t>(Http::CodecType::HTTP3)
+#endif
+                   },
+                   {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace Envoy
@@ -91,9 +91,12 @@ public:
   MOCK_METHOD(SysCallIntResult, recvmmsg,
               (os_fd_t socket, struct mmsghdr* msgvec, unsigned int vlen, int flags,
                struct timespec* timeout));
+  MOCK_METHOD(SysCallIntResult, sendmmsg,
+              (os_fd_t socket, struct mmsghdr* msgvec, unsigned int vlen, int flags));
   MOCK_METHOD(SysCallIntResult, ftruncate, (int fd, off_t length));
   MOCK_METHOD(SysCallPtrResult, mmap,
               (void* addr, size_t length, int prot, int flags, int fd, off_t offset));
+  MOCK_METHOD(SysCallIntResult, munmap, (void* addr, size_t length));
   MOCK_METHOD(SysCallIntResult, stat, (const char* name, struct stat* stat));
   MOCK_METHOD(SysCallIntResult, fstat, (os_fd_t fd, struct stat* stat));
   MOCK_METHOD(SysCallIntResult, chmod, (const std::string& name, mode_t mode));
@@ -144,6 +147,10 @@ class MockLinuxOsSysCalls : public LinuxOsSysCallsImpl {
 public:
   // Api::LinuxOsSysCalls
   MOCK_METHOD(SysCallIntResult, sched_getaffinity, (pid_t pid, size_t cpusetsize, cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, sched_setaffinity,
+              (pid_t pid, size_t cpusetsize, const cpu_set_t* mask));
+  MOCK_METHOD(SysCallIntResult, set_mempolicy,
+              (int mode, const unsigned long* nodemask, unsigned long maxnode));
   MOCK_METHOD(SysCallIntResult, setns, (int fd, int nstype), (const));
 };
 #endif
@@ -31,6 +31,11 @@ public:
     impl_.initializeStats(scope, prefix);
   }
 
+  void enableBusyPoll(std::chrono::microseconds max_spin_duration, Stats::Scope& scope,
+                      const absl::optional<std::string>& prefix) override {
+    impl_.enableBusyPoll(max_spin_duration, scope, prefix);
+  }
+
   void clearDeferredDeleteList() override { impl_.clearDeferredDeleteList(); }
 
   Network::ServerConnectionPtr
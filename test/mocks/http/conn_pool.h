@@ -37,6 +37,8 @@ public:
               (ResponseDecoder & response_decoder, Callbacks& callbacks,
                const Instance::StreamOptions&));
   MOCK_METHOD(bool, maybePreconnect, (float));
+  MOCK_METHOD(void, idleConnectionsLastUsed, (std::vector<MonotonicTime> & last_used), (const));
+  MOCK_METHOD(uint32_t, closeIdleConnections, (MonotonicTime last_used_cutoff, uint32_t limit));
   MOCK_METHOD(Upstream::HostDescriptionConstSharedPtr, host, (), (const));
   MOCK_METHOD(absl::string_view, protocolDescription, (), (const));
 
@@ -187,6 +187,7 @@ public:
   MockFilterChainFactoryCallbacks();
   ~MockFilterChainFactoryCallbacks() override;
 
+  MOCK_METHOD(void, reserveFilters, (uint32_t filter_count));
   MOCK_METHOD(void, addStreamDecoderFilter, (Http::StreamDecoderFilterSharedPtr filter));
   MOCK_METHOD(void, addStreamEncoderFilter, (Http::StreamEncoderFilterSharedPtr filter));
   MOCK_METHOD(void, addStreamFilter, (Http::StreamFilterSharedPtr filter));
@@ -312,6 +313,7 @@ public:
   }
 
   MOCK_METHOD(void, continueDecoding, ());
+  MOCK_METHOD(void, skipDecodingBodyAndTrailers, ());
   MOCK_METHOD(void, addDecodedData, (Buffer::Instance & data, bool streaming));
   MOCK_METHOD(void, injectDecodedDataToFilterChain, (Buffer::Instance & data, bool end_stream));
   MOCK_METHOD(RequestTrailerMap&, addDecodedTrailers, ());
@@ -389,6 +391,7 @@ public:
   MOCK_METHOD(ResponseTrailerMap&, addEncodedTrailers, ());
   MOCK_METHOD(void, addEncodedMetadata, (Http::MetadataMapPtr&&));
   MOCK_METHOD(void, continueEncoding, ());
+  MOCK_METHOD(void, skipEncodingBodyAndTrailers, ());
   MOCK_METHOD(const Buffer::Instance*, encodingBuffer, ());
   MOCK_METHOD(void, modifyEncodingBuffer, (std::function<void(Buffer::Instance&)>));
   MOCK_METHOD(void, sendLocalReply,
@@ -19,12 +19,19 @@ public:
   MOCK_METHOD(IoUringResult, prepareConnect,
               (os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                Request* user_data));
+  MOCK_METHOD(bool, setupProvidedBuffers, (uint32_t count, uint32_t size));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot, (os_fd_t fd, Request* user_data));
+  MOCK_METHOD(Buffer::BufferFragment*, takeProvidedBuffer, (uint16_t buffer_id, uint32_t length));
+  MOCK_METHOD(void, returnProvidedBuffer, (uint16_t buffer_id));
   MOCK_METHOD(IoUringResult, prepareReadv,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
   MOCK_METHOD(IoUringResult, prepareWritev,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
+  MOCK_METHOD(bool, isZeroCopySendSupported, ());
+  MOCK_METHOD(IoUringResult, prepareSendmsgZeroCopy,
+              (os_fd_t fd, const struct msghdr* msg, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareClose, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareCancel, (Request * cancelling_user_data, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareShutdown, (os_fd_t fd, int how, Request* user_data));
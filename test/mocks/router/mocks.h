@@ -118,10 +118,16 @@ public:
     return additional_request_chance_;
   }
   bool hedgeOnPerTryTimeout() const override { return hedge_on_per_try_timeout_; }
+  absl::optional<double> hedgeLatencyPercentile() const override {
+    return hedge_latency_percentile_;
+  }
+  double hedgeBudgetRatio() const override { return hedge_budget_ratio_; }
 
   uint32_t initial_requests_{};
   envoy::type::v3::FractionalPercent additional_request_chance_;
   bool hedge_on_per_try_timeout_{};
+  absl::optional<double> hedge_latency_percentile_;
+  double hedge_budget_ratio_{};
 };
 
 class TestRetryPolicy : public RetryPolicy {
@@ -629,6 +635,7 @@ public:
               (const RouteCallback& cb, const Http::RequestHeaderMap&,
                const Envoy::StreamInfo::StreamInfo&, uint64_t random_value),
               (const));
+  MOCK_METHOD(bool, routeResolutionCacheable, (), (const));
 
   MOCK_METHOD(const std::vector<Http::LowerCaseString>&, internalOnlyHeaders, (), (const));
   MOCK_METHOD(const std::string&, name, (), (const));
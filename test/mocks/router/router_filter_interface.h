@@ -34,6 +34,7 @@ public:
               (Upstream::HostDescriptionConstSharedPtr host, bool success));
   MOCK_METHOD(void, onPerTryTimeout, (UpstreamRequest & upstream_request));
   MOCK_METHOD(void, onPerTryIdleTimeout, (UpstreamRequest & upstream_request));
+  MOCK_METHOD(void, onHedgeTimeout, (UpstreamRequest & upstream_request));
   MOCK_METHOD(void, onStreamMaxDurationReached, (UpstreamRequest & upstream_request));
   MOCK_METHOD(void, setupRouteTimeoutForWebsocketUpgrade, ());
   MOCK_METHOD(void, disableRouteTimeoutForWebsocketUpgrade, ());
@@ -122,6 +122,8 @@ public:
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(bool, kernelTlsTx, (), (const));
+  MOCK_METHOD(bool, kernelTlsRx, (), (const));
   MOCK_METHOD(absl::optional<
                   envoy::extensions::transport_sockets::tls::v3::TlsParameters::CompliancePolicy>,
               compliancePolicy, (), (const));
@@ -164,12 +166,16 @@ public:
   MOCK_METHOD(bool, requireClientCertificate, (), (const));
   MOCK_METHOD(OcspStaplePolicy, ocspStaplePolicy, (), (const));
   MOCK_METHOD(const std::vector<SessionTicketKey>&, sessionTicketKeys, (), (const));
+  MOCK_METHOD(const absl::optional<SessionTicketKeyRotation>&, sessionTicketKeyRotation, (),
+              (const));
   MOCK_METHOD(bool, disableStatelessSessionResumption, (), (const));
   MOCK_METHOD(bool, disableStatefulSessionResumption, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogLocal, (), (const));
   MOCK_METHOD(const Network::Address::IpList&, tlsKeyLogRemote, (), (const));
   MOCK_METHOD(const std::string&, tlsKeyLogPath, (), (const));
   MOCK_METHOD(AccessLog::AccessLogManager&, accessLogManager, (), (const));
+  MOCK_METHOD(bool, kernelTlsTx, (), (const));
+  MOCK_METHOD(bool, kernelTlsRx, (), (const));
   MOCK_METHOD(bool, fullScanCertsOnSNIMismatch, (), (const));
   MOCK_METHOD(absl::optional<
                   envoy::extensions::transport_sockets::tls::v3::TlsParameters::CompliancePolicy>,
@@ -226,6 +232,8 @@ public:
               trustChainVerification, (), (const));
   MOCK_METHOD(bool, onlyVerifyLeafCertificateCrl, (), (const));
   MOCK_METHOD(absl::optional<uint32_t>, maxVerifyDepth, (), (const));
+  MOCK_METHOD(const absl::optional<VerifiedChainCacheConfig>&, verifiedChainCache, (), (const));
+  MOCK_METHOD(absl::optional<uint32_t>, trustChainVerificationOffloadThreads, (), (const));
   MOCK_METHOD(bool, autoSniSanMatch, (), (const));
 };
 
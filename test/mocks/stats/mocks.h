@@ -170,6 +170,7 @@ public:
   MOCK_METHOD(uint64_t, value, (), (const));
   MOCK_METHOD(absl::optional<bool>, cachedShouldImport, (), (const));
   MOCK_METHOD(ImportMode, importMode, (), (const));
+  MOCK_METHOD(bool, latchChanged, ());
 
   bool used_;
   bool hidden_;
@@ -244,6 +245,7 @@ public:
   MOCK_METHOD(bool, used, (), (const, override));
   MOCK_METHOD(bool, hidden, (), (const));
   MOCK_METHOD(std::string, value, (), (const, override));
+  MOCK_METHOD(bool, latchChanged, (), (override));
 
   bool used_;
   bool hidden_;
@@ -65,6 +65,8 @@ public:
   MOCK_METHOD(void, closeConnections, ());
   MOCK_METHOD(Cancellable*, newConnection, (Tcp::ConnectionPool::Callbacks & callbacks));
   MOCK_METHOD(bool, maybePreconnect, (float), ());
+  MOCK_METHOD(void, idleConnectionsLastUsed, (std::vector<MonotonicTime> & last_used), (const));
+  MOCK_METHOD(uint32_t, closeIdleConnections, (MonotonicTime last_used_cutoff, uint32_t limit));
   MOCK_METHOD(Upstream::HostDescriptionConstSharedPtr, host, (), (const));
 
   Envoy::ConnectionPool::MockCancellable* newConnectionImpl(Callbacks& cb);
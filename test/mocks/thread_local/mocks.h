@@ -26,6 +26,8 @@ public:
   void shutdownGlobalThreading() override { shutdown_ = true; }
   MOCK_METHOD(void, shutdownThread, ());
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
+  // The updates run on all threads immediately, so there is nothing to batch.
+  UpdateBatchPtr batchUpdates() override { return std::make_unique<UpdateBatch>(); }
   bool isShutdown() const override { return shutdown_; }
 
   SlotPtr allocateSlotMock() { return SlotPtr{new SlotImpl(*this, current_slot_++)}; }
@@ -29,6 +29,7 @@ MockThreadLocalCluster::MockThreadLocalCluster() {
       .WillByDefault(Invoke([this](absl::string_view drop_category) -> void {
         cluster_.drop_category_ = drop_category;
       }));
+  ON_CALL(*this, requestLatencyTracker()).WillByDefault(ReturnRef(request_latency_tracker_));
 }
 
 MockThreadLocalCluster::~MockThreadLocalCluster() = default;
@@ -2,6 +2,8 @@
 
 #include "envoy/upstream/thread_local_cluster.h"
 
+#include "source/common/upstream/request_latency_tracker_impl.h"
+
 #include "test/mocks/http/conn_pool.h"
 #include "test/mocks/http/mocks.h"
 #include "test/mocks/tcp/mocks.h"
@@ -46,12 +48,14 @@ public:
   MOCK_METHOD(const std::string&, dropCategory, (), (const));
   MOCK_METHOD(void, setDropOverload, (UnitFloat));
   MOCK_METHOD(void, setDropCategory, (absl::string_view));
+  MOCK_METHOD(RequestLatencyTracker&, requestLatencyTracker, ());
 
   NiceMock<MockClusterMockPrioritySet> cluster_;
   NiceMock<MockLoadBalancer> lb_;
   NiceMock<Http::ConnectionPool::MockInstance> conn_pool_;
   NiceMock<Http::MockAsyncClient> async_client_;
   NiceMock<Tcp::ConnectionPool::MockInstance> tcp_conn_pool_;
+  RequestLatencyTrackerImpl request_latency_tracker_;
 };
 
 } // namespace Upstream
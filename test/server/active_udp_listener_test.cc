@@ -11,6 +11,7 @@
 #include "test/mocks/network/mocks.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/network_utility.h"
+#include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -195,6 +196,49 @@ TEST_P(ActiveUdpListenerTest, MultipleFiltersOnReceiveErrorStopIteration) {
   active_listener_->onReceiveError(Api::IoError::IoErrorCode::UnknownError);
 }
 
+TEST_P(ActiveUdpListenerTest, ForwardedDatagramsDeliveredInBatches) {
+  setup(/*concurrency=*/2);
+
+  auto* test_filter = new NiceMock<Network::MockUdpListenerReadFilter>(cb_);
+  active_listener_->addReadFilter(Network::UdpListenerReadFilterPtr{test_filter});
+  ON_CALL(conn_handler_, getUdpListenerCallbacks(_, _))
+      .WillByDefault(Return(Network::UdpListenerCallbacksOptRef(*active_listener_)));
+
+  // Forwarded datagrams are posted by the other workers.
+  ON_CALL(dispatcher_, isThreadSafe()).WillByDefault(Return(false));
+  std::vector<Event::PostCb> posted;
+  EXPECT_CALL(dispatcher_, post(_)).Times(2).WillRepeatedly(Invoke([&](Event::PostCb cb) {
+    posted.push_back(std::move(cb));
+  }));
+
+  // A single callback delivers the datagrams forwarded before it runs.
+  for (int i = 0; i < 3; i++) {
+    active_listener_->post(Network::UdpRecvData{});
+  }
+  ASSERT_EQ(1, posted.size());
+  EXPECT_CALL(*test_filter, onData(_)).Times(3);
+  posted[0]();
+  testing::Mock::VerifyAndClearExpectations(test_filter);
+
+  active_listener_->post(Network::UdpRecvData{});
+  ASSERT_EQ(2, posted.size());
+  EXPECT_CALL(*test_filter, onData(_));
+  posted[1]();
+}
+
+TEST_P(ActiveUdpListenerTest, ForwardedDatagramsStat) {
+  setup(/*concurrency=*/2);
+
+  Network::UdpRecvData data;
+  active_listener_->onData(std::move(data));
+  EXPECT_EQ(0, TestUtility::findCounter(store_, "udp.downstream_rx_datagram_forwarded")->value());
+
+  // The other worker isn't registered, so the datagram is dropped by the router.
+  active_listener_->destination_ = 1;
+  active_listener_->onData(Network::UdpRecvData{});
+  EXPECT_EQ(1, TestUtility::findCounter(store_, "udp.downstream_rx_datagram_forwarded")->value());
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
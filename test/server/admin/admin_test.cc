@@ -155,6 +155,11 @@ TEST_P(AdminInstanceTest, Help) {
   /contention: dump current Envoy mutex contention stats (if enabled)
   /cpuprofiler (POST): enable/disable the CPU profiler
       enable: enables the CPU profiler; One of (y, n)
+  /dispatcher_profile: print the sources using the most dispatcher callback time (if enabled)
+      limit: The number of sources to print. Defaults to 20
+  /dispatcherprofiler (POST): enable/disable the dispatcher callback profiler
+      enable: enable/disable the dispatcher callback profiler; One of (y, n)
+      sample_period: Time one in sample_period dispatcher callbacks. Defaults to 1000
   /drain_listeners (POST): drain listeners
       graceful: When draining listeners, enter a graceful drain period prior to closing listeners. This behaviour and duration is configurable via server options or CLI
       skip_exit: When draining listeners, do not exit after the drain period. This must be used with graceful
@@ -162,6 +167,7 @@ TEST_P(AdminInstanceTest, Help) {
   /healthcheck/fail (POST): cause the server to fail health checks
   /healthcheck/ok (POST): cause the server to pass health checks
   /heap_dump: dump current Envoy heap (if supported)
+  /heap_subsystems: print the current Envoy heap by subsystem (if supported)
   /heapprofiler (POST): enable/disable the heap profiler
       enable: enable/disable the heap profiler; One of (y, n)
   /help: print out list of admin commands
@@ -174,6 +180,8 @@ TEST_P(AdminInstanceTest, Help) {
       paths: Change multiple logging levels by setting to <logger_name1>:<desired_level1>,<logger_name2>:<desired_level2>. If fine grain logging is enabled, use __FILE__ or a glob experision as the logger name. For example, source/common*:warning
       level: desired logging level, this will change all loggers's level; One of (, trace, debug, info, warning, error, critical, off)
   /memory: print current allocation/heap usage
+  /memory/clusters: print per-cluster stats memory usage
+      filter: Regular expression (Google re2) for filtering clusters by name
   /memory/tcmalloc: print TCMalloc stats
   /quitquitquit (POST): exit the server
   /ready: print server state, return 200 if LIVE, otherwise return 503
@@ -323,6 +323,44 @@ TEST_P(AdminInstanceTest, TestClusterFilter) {
   EXPECT_THAT(output_text, testing::Not(testing::HasSubstr("test-bar-4")));
 }
 
+TEST_P(AdminInstanceTest, ClustersMemory) {
+  Upstream::ClusterManager::ClusterInfoMaps cluster_maps;
+  ON_CALL(server_.cluster_manager_, clusters()).WillByDefault(ReturnPointee(&cluster_maps));
+
+  auto createCluster = [&](const std::string& name) {
+    auto cluster = std::make_unique<NiceMock<Upstream::MockClusterMockPrioritySet>>();
+    ON_CALL(*cluster->info_, name()).WillByDefault(testing::ReturnRefOfCopy(name));
+    cluster_maps.active_clusters_.emplace(name, *cluster);
+    return cluster;
+  };
+  auto cluster1 = createCluster("test-bar-1");
+  auto cluster2 = createCluster("test-foo-2");
+  cluster1->info_->stats_store_.counterFromString("extra_counter");
+  cluster1->info_->stats_store_.textReadoutFromString("extra_text_readout");
+
+  uint64_t counters = 0;
+  cluster1->info_->stats_store_.iterate(
+      Stats::IterateFn<Stats::Counter>([&counters](const Stats::CounterSharedPtr&) -> bool {
+        ++counters;
+        return true;
+      }));
+
+  Buffer::OwnedImpl response;
+  Http::TestResponseHeaderMapImpl header_map;
+  EXPECT_EQ(Http::Code::OK,
+            getCallback("/memory/clusters?filter=^test-bar-1$", header_map, response));
+  const std::string output = response.toString();
+  EXPECT_THAT(output, testing::HasSubstr(fmt::format("test-bar-1::counters::{}\n", counters)));
+  EXPECT_THAT(output, testing::HasSubstr("test-bar-1::text_readouts::1\n"));
+  EXPECT_THAT(output, testing::HasSubstr("test-bar-1::stat_name_bytes::"));
+  EXPECT_THAT(output, testing::HasSubstr("test-bar-1::traffic_stats_allocated::true\n"));
+  EXPECT_THAT(output, testing::Not(testing::HasSubstr("test-foo-2")));
+  response.drain(response.length());
+
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/memory/clusters?filter=(", header_map, response));
+  EXPECT_EQ("Invalid re2 regex", response.toString());
+}
+
 TEST_P(AdminInstanceTest, TestSetHealthFlag) {
   std::shared_ptr<Upstream::MockClusterInfo> cluster{new NiceMock<Upstream::MockClusterInfo>()};
   Event::MockDispatcher dispatcher;
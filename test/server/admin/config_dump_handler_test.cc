@@ -1,3 +1,6 @@
+#include "source/common/common/regex.h"
+#include "source/server/admin/config_dump_handler.h"
+
 #include "test/integration/filters/test_listener_filter.pb.h"
 #include "test/integration/filters/test_network_filter.pb.h"
 #include "test/server/admin/admin_instance.h"
@@ -932,5 +935,38 @@ TEST_P(AdminInstanceTest, ConfigDumpEcdsByResourceAndMask) {
   EXPECT_EQ(expected_json, output);
 }
 
+// Test that the configs are written in chunks, and that the chunks make up the whole dump.
+TEST_P(AdminInstanceTest, ConfigDumpStreamedInChunks) {
+  auto ecds_config = admin_.getConfigTracker().add("ecds", testDumpEcdsConfig);
+  auto foo_entry = admin_.getConfigTracker().add("foo", [](const Matchers::StringMatcher&) {
+    auto msg = std::make_unique<Protobuf::StringValue>();
+    msg->set_value("bar");
+    return msg;
+  });
+  Regex::GoogleReEngine engine;
+  for (const absl::string_view path : {"/config_dump", "/config_dump?resource=ecds_filters"}) {
+    Buffer::OwnedImpl buffered_response;
+    Http::TestResponseHeaderMapImpl header_map;
+    EXPECT_EQ(Http::Code::OK, getCallback(path, header_map, buffered_response));
+
+    ConfigDumpRequest request(admin_.getConfigTracker().getCallbacksMap(),
+                              Http::Utility::QueryParamsMulti::parseAndDecodeQueryString(path),
+                              engine);
+    request.setChunkSize(1);
+    EXPECT_EQ(Http::Code::OK, request.start(header_map));
+    std::string streamed_response;
+    uint32_t chunks = 0;
+    bool more_data;
+    do {
+      Buffer::OwnedImpl chunk;
+      more_data = request.nextChunk(chunk);
+      streamed_response += chunk.toString();
+      ++chunks;
+    } while (more_data);
+    EXPECT_EQ(2, chunks);
+    EXPECT_EQ(buffered_response.toString(), streamed_response);
+  }
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -1,8 +1,11 @@
+#include "source/common/event/callback_profiler.h"
 #include "source/common/profiler/profiler.h"
 
 #include "test/server/admin/admin_instance.h"
 #include "test/test_common/logging.h"
 
+using testing::HasSubstr;
+
 namespace Envoy {
 namespace Server {
 
@@ -29,6 +32,56 @@ TEST_P(AdminInstanceTest, AdminCpuProfiler) {
   EXPECT_FALSE(Profiler::Cpu::profilerEnabled());
 }
 
+TEST_P(AdminInstanceTest, AdminDispatcherProfiler) {
+  Buffer::OwnedImpl data;
+  Http::TestResponseHeaderMapImpl header_map;
+
+  EXPECT_EQ(Http::Code::OK, getCallback("/dispatcher_profile", header_map, data));
+  EXPECT_THAT(data.toString(), HasSubstr("profiler is not enabled"));
+  data.drain(data.length());
+
+  EXPECT_EQ(Http::Code::OK, postCallback("/dispatcherprofiler?enable=y", header_map, data));
+  EXPECT_EQ(1000, Event::CallbackProfiler::samplePeriod());
+  EXPECT_EQ(Http::Code::OK,
+            postCallback("/dispatcherprofiler?enable=y&sample_period=1", header_map, data));
+  EXPECT_EQ(1, Event::CallbackProfiler::samplePeriod());
+  {
+    Event::CallbackProfiler::CallbackScope callback("test.callback");
+    Event::CallbackProfiler::SourceScope source("test.source");
+  }
+  data.drain(data.length());
+  EXPECT_EQ(Http::Code::OK, getCallback("/dispatcher_profile", header_map, data));
+  EXPECT_THAT(data.toString(), HasSubstr("test.callback: samples=1 "));
+  EXPECT_THAT(data.toString(), HasSubstr("test.source: samples=1 "));
+  data.drain(data.length());
+
+  // The profile is kept when the profiler is disabled.
+  EXPECT_EQ(Http::Code::OK, postCallback("/dispatcherprofiler?enable=n", header_map, data));
+  EXPECT_EQ(0, Event::CallbackProfiler::samplePeriod());
+  data.drain(data.length());
+  EXPECT_EQ(Http::Code::OK, getCallback("/dispatcher_profile?limit=1", header_map, data));
+  const std::string profile = data.toString();
+  EXPECT_EQ(1, std::count(profile.begin(), profile.end(), '\n'));
+  Event::CallbackProfiler::reset();
+}
+
+TEST_P(AdminInstanceTest, AdminDispatcherProfilerBadRequest) {
+  Buffer::OwnedImpl data;
+  Http::TestResponseHeaderMapImpl header_map;
+
+  EXPECT_EQ(Http::Code::BadRequest, postCallback("/dispatcherprofiler", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/dispatcherprofiler?enable=yes", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/dispatcherprofiler?enable=y&sample_period=0", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/dispatcherprofiler?enable=y&sample_period=x", header_map, data));
+  EXPECT_EQ(Http::Code::BadRequest,
+            postCallback("/dispatcherprofiler?enable=n&sample_period=10", header_map, data));
+  EXPECT_EQ(0, Event::CallbackProfiler::samplePeriod());
+  EXPECT_EQ(Http::Code::BadRequest, getCallback("/dispatcher_profile?limit=x", header_map, data));
+}
+
 TEST_P(AdminInstanceTest, AdminHeapProfilerOnRepeatedRequest) {
   Buffer::OwnedImpl data;
   Http::TestResponseHeaderMapImpl header_map;
@@ -88,6 +141,33 @@ TEST_P(AdminInstanceTest, AdminHeapDump) {
 #endif
 }
 
+TEST_P(AdminInstanceTest, AdminHeapBySubsystem) {
+  Buffer::OwnedImpl data;
+  Http::TestResponseHeaderMapImpl header_map;
+
+#ifdef TCMALLOC
+  EXPECT_EQ(Http::Code::OK, getCallback("/heap_subsystems", header_map, data));
+#else
+  EXPECT_EQ(Http::Code::NotImplemented, getCallback("/heap_subsystems", header_map, data));
+#endif
+}
+
+TEST(TcmallocProfilerTest, SubsystemOfFunction) {
+  EXPECT_EQ("buffers", Profiler::TcmallocProfiler::subsystemOfFunction(
+                           "Envoy::Buffer::OwnedImpl::addImpl()"));
+  EXPECT_EQ("headers", Profiler::TcmallocProfiler::subsystemOfFunction(
+                           "Envoy::Http::HeaderString::setCopy()"));
+  EXPECT_EQ("headers", Profiler::TcmallocProfiler::subsystemOfFunction(
+                           "Envoy::Http::TypedHeaderMapImpl<>::addCopy()"));
+  EXPECT_EQ("stats", Profiler::TcmallocProfiler::subsystemOfFunction(
+                         "Envoy::Stats::SymbolTable::encode()"));
+  EXPECT_EQ("config", Profiler::TcmallocProfiler::subsystemOfFunction(
+                          "google::protobuf::Arena::AllocateAligned()"));
+  EXPECT_EQ("", Profiler::TcmallocProfiler::subsystemOfFunction(
+                    "Envoy::Http::ConnectionManagerImpl::newStream()"));
+  EXPECT_EQ("", Profiler::TcmallocProfiler::subsystemOfFunction("operator new()"));
+}
+
 TEST_P(AdminInstanceTest, AdminAllocationDump) {
   Buffer::OwnedImpl data;
   Http::TestResponseHeaderMapImpl header_map;
@@ -816,6 +816,46 @@ envoy_cluster_upstream_rq_time_count{cluster="ccc"} 7
   EXPECT_EQ(expected_output, response.toString());
 }
 
+TEST_F(PrometheusStatsFormatterTest, ChunkedRendererMatchesFullOutput) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  for (const char* cluster : {"ccc", "aaa", "bbb"}) {
+    const Stats::StatNameTagVector tags{{makeStat("cluster"), makeStat(cluster)}};
+    addCounter("cluster.upstream_cx_total", tags);
+    addCounter("cluster.upstream_cx_connect_fail", tags);
+    addGauge("cluster.upstream_cx_active", tags);
+    addGauge("cluster.upstream_rq_active", tags);
+  }
+
+  Buffer::OwnedImpl full;
+  const uint64_t size = PrometheusStatsFormatter::statsAsPrometheusText(
+      counters_, gauges_, histograms_, textReadouts_, endpoints_helper_->cm_, full, StatsParams(),
+      custom_namespaces);
+  EXPECT_EQ(4UL, size);
+
+  Http::TestRequestHeaderMapImpl request_headers;
+  Http::TestResponseHeaderMapImpl response_headers;
+  const StatsParams params;
+  std::unique_ptr<PrometheusStatsFormatter::OutputFormat> output_format =
+      PrometheusStatsFormatter::makeOutputFormat(params, request_headers, response_headers);
+  PrometheusStatsFormatter::ChunkedRenderer renderer(counters_, gauges_, histograms_,
+                                                     textReadouts_, endpoints_helper_->cm_,
+                                                     params, custom_namespaces, *output_format);
+  EXPECT_EQ(4UL, renderer.metricNameCount());
+
+  // With a one byte chunk size, every metric name is rendered in its own chunk.
+  std::string chunked;
+  uint32_t num_chunks = 0;
+  bool more = true;
+  while (more) {
+    Buffer::OwnedImpl chunk;
+    more = renderer.nextChunk(chunk, 1);
+    chunked += chunk.toString();
+    ++num_chunks;
+  }
+  EXPECT_EQ(4, num_chunks);
+  EXPECT_EQ(full.toString(), chunked);
+}
+
 TEST_F(PrometheusStatsFormatterTest, OutputWithUsedOnly) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
   addCounter("cluster.test_1.upstream_cx_total",
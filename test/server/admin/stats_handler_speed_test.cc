@@ -191,18 +191,18 @@ public:
   }
 
   /**
-   * Issues an admin request against the stats saved in store_.
+   * Issues an admin request against the stats saved in store_, draining each
+   * chunk as the admin filter would.
    */
   uint64_t handlerStats(const StatsParams& params) {
     Buffer::OwnedImpl data;
     auto request_headers = Http::RequestHeaderMapImpl::create();
     auto response_headers = Http::ResponseHeaderMapImpl::create();
-    if (params.format_ == StatsFormat::Prometheus) {
-      StatsHandler::prometheusRender(*store_, custom_namespaces_, cm_, params, *request_headers,
-                                     *response_headers, data);
-      return data.length();
-    }
-    Admin::RequestPtr request = StatsHandler::makeRequest(*store_, params, cm_);
+    Admin::RequestPtr request =
+        params.format_ == StatsFormat::Prometheus
+            ? StatsHandler::makePrometheusRequest(*store_, custom_namespaces_, cm_, params,
+                                                  *request_headers)
+            : StatsHandler::makeRequest(*store_, params, cm_);
     request->start(*response_headers);
     uint64_t count = 0;
     bool more = true;
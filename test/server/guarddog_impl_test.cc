@@ -427,12 +427,13 @@ TEST_P(GuardDogTestBase, AtomicIsAtomicTest) {
 
 // A GuardDogAction used for testing the GuardDog.
 // It's primary use is dumping string of the format EVENT_TYPE : tid1,.., tidN to
-// the events vector passed to it.
+// the events vector passed to it, and STARTED : tid or STOPPED : tid to the watches vector.
 // Instances of this class will be registered for GuardDogEvent through
 // TestGuardDogActionFactory.
 class RecordGuardDogAction : public Configuration::GuardDogAction {
 public:
-  RecordGuardDogAction(std::vector<std::string>& events) : events_(events) {}
+  RecordGuardDogAction(std::vector<std::string>& events, std::vector<std::string>& watches)
+      : events_(events), watches_(watches) {}
 
   void run(envoy::config::bootstrap::v3::Watchdog::WatchdogAction::WatchdogEvent event,
            const std::vector<std::pair<Thread::ThreadId, MonotonicTime>>& thread_last_checkin_pairs,
@@ -451,8 +452,17 @@ public:
     events_.push_back(event_string);
   }
 
+  void onWatchStarted(const Thread::ThreadId& thread_id) override {
+    watches_.push_back(absl::StrCat("STARTED : ", thread_id.debugString()));
+  }
+
+  void onWatchStopped(const Thread::ThreadId& thread_id) override {
+    watches_.push_back(absl::StrCat("STOPPED : ", thread_id.debugString()));
+  }
+
 protected:
-  std::vector<std::string>& events_; // not owned
+  std::vector<std::string>& events_;  // not owned
+  std::vector<std::string>& watches_; // not owned
 };
 
 // A GuardDogAction that raises the specified signal.
@@ -472,14 +482,15 @@ public:
 template <class ConfigType>
 class RecordGuardDogActionFactory : public Configuration::GuardDogActionFactory {
 public:
-  RecordGuardDogActionFactory(const std::string& name, std::vector<std::string>& events)
-      : name_(name), events_(events) {}
+  RecordGuardDogActionFactory(const std::string& name, std::vector<std::string>& events,
+                              std::vector<std::string>& watches)
+      : name_(name), events_(events), watches_(watches) {}
 
   Configuration::GuardDogActionPtr createGuardDogActionFromProto(
       const envoy::config::bootstrap::v3::Watchdog::WatchdogAction& /*config*/,
       Configuration::GuardDogActionFactoryContext& /*context*/) override {
     // Return different actions depending on the config.
-    return std::make_unique<RecordGuardDogAction>(events_);
+    return std::make_unique<RecordGuardDogAction>(events_, watches_);
   }
 
   ProtobufTypes::MessagePtr createEmptyConfigProto() override {
@@ -489,7 +500,8 @@ public:
   std::string name() const override { return name_; }
 
   const std::string name_;
-  std::vector<std::string>& events_; // not owned
+  std::vector<std::string>& events_;  // not owned
+  std::vector<std::string>& watches_; // not owned
 };
 
 // Test factory for consuming Watchdog configs and creating GuardDogActions.
@@ -520,7 +532,7 @@ public:
 class GuardDogActionsTest : public GuardDogTestBase {
 protected:
   GuardDogActionsTest()
-      : log_factory_("LogFactory", events_), register_log_factory_(log_factory_),
+      : log_factory_("LogFactory", events_, watches_), register_log_factory_(log_factory_),
         assert_factory_("AssertFactory"), register_assert_factory_(assert_factory_) {}
 
   std::vector<std::string> getActionsConfig() {
@@ -579,6 +591,7 @@ protected:
 
   std::vector<std::string> actions_;
   std::vector<std::string> events_;
+  std::vector<std::string> watches_;
   RecordGuardDogActionFactory<Envoy::Protobuf::Struct> log_factory_;
   Registry::InjectFactory<Configuration::GuardDogActionFactory> register_log_factory_;
   AssertGuardDogActionFactory<Envoy::Protobuf::Empty> assert_factory_;
@@ -799,6 +812,19 @@ TEST_P(GuardDogActionsTest, KillShouldTriggerGuardDogActions) {
   EXPECT_DEATH(die_function(), "ASSERT_GUARDDOG_ACTION");
 }
 
+// The actions are told about the threads being watched, before any event about them.
+TEST_P(GuardDogActionsTest, ShouldNotifyWatchedThreads) {
+  const NiceMock<Configuration::MockWatchdog> config(100, DISABLE_MEGAMISS, DISABLE_KILL,
+                                                     DISABLE_MULTIKILL, 0, getActionsConfig());
+  setupFirstDog(config, Thread::ThreadId(10));
+  // Both the MISS and MEGAMISS actions are told.
+  EXPECT_THAT(watches_, ElementsAre("STARTED : 10", "STARTED : 10"));
+
+  guard_dog_->stopWatching(first_dog_);
+  EXPECT_THAT(watches_,
+              ElementsAre("STARTED : 10", "STARTED : 10", "STOPPED : 10", "STOPPED : 10"));
+}
+
 // Disabled for coverage per #18229
 #if !defined(ENVOY_CONFIG_COVERAGE)
 TEST_P(GuardDogActionsTest, MultikillShouldTriggerGuardDogActions) {
@@ -20,6 +20,9 @@ public:
   void sendMessage(sockaddr_un& address, const envoy::HotRestartMessage& message) {
     main_rpc_stream_.sendHotRestartMessage(address, message);
   }
+  void sendMessages(sockaddr_un& address, const std::vector<envoy::HotRestartMessage>& messages) {
+    main_rpc_stream_.sendHotRestartMessages(address, messages);
+  }
 };
 
 class HotRestartingBaseTest : public testing::Test {
@@ -79,6 +82,39 @@ TEST_F(HotRestartingBaseTest, SendMsgRetrySucceedsEventually) {
   EXPECT_TRUE(retried);
 }
 
+TEST_F(HotRestartingBaseTest, SendMsgsSendsEachMessageInItsOwnDatagrams) {
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+
+  std::vector<std::string> datagrams;
+  EXPECT_CALL(os_sys_calls, sendmsg(_, _, _))
+      .Times(2)
+      .WillRepeatedly(Invoke([&](os_fd_t, const msghdr* message, int) {
+        datagrams.emplace_back(static_cast<const char*>(message->msg_iov[0].iov_base),
+                               message->msg_iov[0].iov_len);
+        return Api::SysCallSizeResult{static_cast<ssize_t>(message->msg_iov[0].iov_len), 0};
+      }));
+
+  std::string dst_path = "/tmp/dst";
+  sockaddr_un sun;
+  sun.sun_family = AF_UNIX;
+  StringUtil::strlcpy(&sun.sun_path[1], dst_path.data(), dst_path.size());
+  sun.sun_path[0] = '\0';
+
+  std::vector<HotRestartMessage> messages(2);
+  messages[0].mutable_request()->mutable_forwarded_udp_packet()->set_payload("a");
+  messages[1].mutable_request()->mutable_forwarded_udp_packet()->set_payload("bc");
+  base_.sendMessages(sun, messages);
+
+  ASSERT_EQ(2, datagrams.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    HotRestartMessage sent;
+    ASSERT_TRUE(sent.ParseFromString(datagrams[i].substr(sizeof(uint64_t))));
+    EXPECT_EQ(messages[i].request().forwarded_udp_packet().payload(),
+              sent.request().forwarded_udp_packet().payload());
+  }
+}
+
 } // namespace
 } // namespace Server
 } // namespace Envoy
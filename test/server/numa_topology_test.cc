@@ -0,0 +1,61 @@
+#include "source/server/numa_topology.h"
+
+#include "test/mocks/filesystem/mocks.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Server {
+namespace {
+
+TEST(NumaTopologyTest, ParseList) {
+  EXPECT_EQ(std::vector<uint32_t>({0, 1, 2, 3, 8, 10, 11}),
+            NumaTopology::parseList("0-3,8,10-11\n").value());
+  EXPECT_EQ(std::vector<uint32_t>({5}), NumaTopology::parseList("5").value());
+  EXPECT_TRUE(NumaTopology::parseList("\n").value().empty());
+  EXPECT_FALSE(NumaTopology::parseList("a-3").ok());
+  EXPECT_FALSE(NumaTopology::parseList("3-1").ok());
+  EXPECT_FALSE(NumaTopology::parseList("1,,2").ok());
+}
+
+// Only the allowed CPUs of each node are kept, and the nodes without any are skipped.
+TEST(NumaTopologyTest, Discover) {
+  NiceMock<Filesystem::MockInstance> file_system;
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(std::string("0-2\n")));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/node0/cpulist"))
+      .WillOnce(Return(std::string("0-3\n")));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/node1/cpulist"))
+      .WillOnce(Return(std::string("4-7\n")));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/node2/cpulist"))
+      .WillOnce(Return(std::string("8-11\n")));
+
+  const std::vector<NumaTopology::Node> nodes =
+      NumaTopology::discover(file_system, {1, 2, 9, 10, 11});
+  ASSERT_EQ(2, nodes.size());
+  EXPECT_EQ(0, nodes[0].id_);
+  EXPECT_EQ(std::vector<uint32_t>({1, 2}), nodes[0].cpus_);
+  EXPECT_EQ(2, nodes[1].id_);
+  EXPECT_EQ(std::vector<uint32_t>({9, 10, 11}), nodes[1].cpus_);
+
+  EXPECT_EQ(&nodes[0], NumaTopology::nodeForWorker(nodes, 0));
+  EXPECT_EQ(&nodes[1], NumaTopology::nodeForWorker(nodes, 1));
+  EXPECT_EQ(&nodes[0], NumaTopology::nodeForWorker(nodes, 2));
+}
+
+TEST(NumaTopologyTest, UnknownTopology) {
+  NiceMock<Filesystem::MockInstance> file_system;
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(absl::NotFoundError("no such file")));
+  const std::vector<NumaTopology::Node> nodes = NumaTopology::discover(file_system, {0, 1});
+  EXPECT_TRUE(nodes.empty());
+  EXPECT_EQ(nullptr, NumaTopology::nodeForWorker(nodes, 0));
+}
+
+} // namespace
+} // namespace Server
+} // namespace Envoy
@@ -74,6 +74,16 @@ public:
     }
   }
 
+  void setRefreshCallback(std::function<void()> callback) override {
+    refresh_callback_ = std::move(callback);
+  }
+
+  // Requests an update between two refresh intervals, like on a notification of the kernel.
+  void refresh() {
+    ASSERT(refresh_callback_ != nullptr);
+    refresh_callback_();
+  }
+
 private:
   void publishUpdate(ResourceUpdateCallbacks& callbacks) {
     if (absl::holds_alternative<double>(response_)) {
@@ -90,6 +100,7 @@ private:
   absl::variant<double, EnvoyException> response_;
   bool update_async_ = false;
   absl::optional<std::reference_wrapper<ResourceUpdateCallbacks>> callbacks_;
+  std::function<void()> refresh_callback_;
 };
 
 class FakeProactiveResourceMonitor : public ProactiveResourceMonitor {
@@ -549,6 +560,42 @@ TEST_F(OverloadManagerImplTest, FlushesUpdatesEvenWithOneUnresponsive) {
   EXPECT_TRUE(action_state.isSaturated());
 }
 
+// The updates requested by a monitor are flushed right away, along with the updates of the current
+// refresh received so far.
+TEST_F(OverloadManagerImplTest, RefreshedUpdatesAreFlushedImmediately) {
+  setDispatcherExpectation();
+  auto manager(createOverloadManager(kRegularStateConfig));
+  manager->start();
+  Stats::Counter& skipped_updates =
+      stats_.counter("overload.envoy.resource_monitors.fake_resource1.skipped_updates");
+
+  const OverloadActionState& action_state = manager->getThreadLocalOverloadState().getState(
+      "envoy.overload_actions.stop_accepting_requests");
+
+  factory1_.monitor_->setPressure(0.95);
+  factory1_.monitor_->refresh();
+  EXPECT_TRUE(action_state.isSaturated());
+
+  // A refresh while an update is pending is left to that update.
+  factory1_.monitor_->setUpdateAsync(true);
+  factory1_.monitor_->setPressure(0.5);
+  timer_cb_();
+  factory1_.monitor_->refresh();
+  factory1_.monitor_->publishUpdate();
+  EXPECT_FALSE(action_state.isSaturated());
+  EXPECT_EQ(0, skipped_updates.value());
+
+  // A periodic update while a refresh is pending is skipped, and the refresh flushes the updates
+  // of the other monitors.
+  factory1_.monitor_->refresh();
+  factory2_.monitor_->setPressure(1.0);
+  timer_cb_();
+  EXPECT_EQ(1, skipped_updates.value());
+  EXPECT_FALSE(action_state.isSaturated());
+  factory1_.monitor_->publishUpdate();
+  EXPECT_TRUE(action_state.isSaturated());
+}
+
 TEST_F(OverloadManagerImplTest, SkippedUpdates) {
   setDispatcherExpectation();
 
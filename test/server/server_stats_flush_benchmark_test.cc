@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -42,6 +43,12 @@ private:
   size_t num_histograms_ = 0;
 };
 
+// Sink that only needs the metrics that changed since the previous flush.
+class DeltaSink : public testing::NiceMock<Stats::MockSink> {
+public:
+  bool needsFullSnapshot() override { return false; }
+};
+
 class StatsSinkFlushSpeedTest {
 public:
   StatsSinkFlushSpeedTest(size_t const num_stats, bool set_sink_predicates = false)
@@ -54,14 +61,15 @@ public:
     // Create counters
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("counter.", idx));
-      stats_store_.rootScope()->counterFromStatName(stat_name).inc();
+      counters_.push_back(&stats_store_.rootScope()->counterFromStatName(stat_name));
+      counters_.back()->inc();
     }
     // Create gauges
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("gauge.", idx));
-      stats_store_.rootScope()
-          ->gaugeFromStatName(stat_name, Stats::Gauge::ImportMode::NeverImport)
-          .set(idx);
+      gauges_.push_back(&stats_store_.rootScope()->gaugeFromStatName(
+          stat_name, Stats::Gauge::ImportMode::NeverImport));
+      gauges_.back()->set(idx);
     }
 
     // Create text readouts
@@ -87,11 +95,32 @@ public:
     }
   }
 
+  // Flushes to a sink that only needs changed metrics, updating one in `1 / change_ratio`
+  // counters and gauges between flushes.
+  void testDelta(::benchmark::State& state, uint64_t change_ratio) {
+    std::list<Stats::SinkPtr> sinks;
+    sinks.emplace_back(new DeltaSink());
+    // The first delta snapshot includes all gauges and text readouts, as they are new.
+    Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, cm_, time_system_);
+    uint64_t offset = 0;
+    for (auto _ : state) { // NOLINT
+      state.PauseTiming();
+      for (uint64_t idx = offset++ % change_ratio; idx < counters_.size(); idx += change_ratio) {
+        counters_[idx]->inc();
+        gauges_[idx]->inc();
+      }
+      state.ResumeTiming();
+      Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, cm_, time_system_);
+    }
+  }
+
 private:
   Stats::SymbolTableImpl symbol_table_;
   Stats::StatNamePool pool_;
   Stats::AllocatorImpl stats_allocator_;
   Stats::ThreadLocalStoreImpl stats_store_;
+  std::vector<Stats::Counter*> counters_;
+  std::vector<Stats::Gauge*> gauges_;
   Event::SimulatedTimeSystem time_system_;
   FastMockClusterManager cm_;
 };
@@ -118,10 +147,26 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+static void bmFlushDeltaToSinks(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  // One in 20 metrics changes between flushes.
+  StatsSinkFlushSpeedTest speed_test(state.range(0));
+  speed_test.testDelta(state, 20);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmFlushDeltaToSinks)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000000);
 
 } // namespace Envoy
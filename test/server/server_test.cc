@@ -118,6 +118,78 @@ TEST(ServerInstanceUtil, flushHelper) {
   InstanceUtil::flushMetricsToSinks(sinks, mock_store, cm, time_system);
 }
 
+class DeltaStatsSink : public Stats::Sink {
+public:
+  // Stats::Sink
+  void flush(Stats::MetricSnapshot& snapshot) override { flush_(snapshot); }
+  void onHistogramComplete(const Stats::Histogram&, uint64_t) override {}
+  bool needsFullSnapshot() override { return needs_full_snapshot_; }
+
+  std::function<void(Stats::MetricSnapshot&)> flush_;
+  bool needs_full_snapshot_{false};
+};
+
+TEST(ServerInstanceUtil, flushDeltaSnapshot) {
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& changed_counter = store.counter("changed_counter");
+  store.counter("idle_counter");
+  Stats::Gauge& changed_gauge = store.gauge("changed_gauge", Stats::Gauge::ImportMode::Accumulate);
+  store.gauge("idle_gauge", Stats::Gauge::ImportMode::Accumulate);
+  Stats::TextReadout& changed_text = store.textReadout("changed_text");
+  store.textReadout("idle_text");
+
+  auto* sink = new DeltaStatsSink();
+  std::list<Stats::SinkPtr> sinks;
+  sinks.emplace_back(sink);
+
+  // Newly created gauges and text readouts are reported once.
+  sink->flush_ = [](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.isDelta());
+    EXPECT_TRUE(snapshot.counters().empty());
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.textReadouts().size(), 2);
+  };
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  changed_counter.add(3);
+  changed_gauge.set(7);
+  changed_text.set("new value");
+  sink->flush_ = [](Stats::MetricSnapshot& snapshot) {
+    EXPECT_TRUE(snapshot.isDelta());
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "changed_counter");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 3);
+    ASSERT_EQ(snapshot.gauges().size(), 1);
+    EXPECT_EQ(snapshot.gauges()[0].get().name(), "changed_gauge");
+    EXPECT_EQ(snapshot.gauges()[0].get().value(), 7);
+    ASSERT_EQ(snapshot.textReadouts().size(), 1);
+    EXPECT_EQ(snapshot.textReadouts()[0].get().value(), "new value");
+  };
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  // A sink can ask for the full state.
+  sink->needs_full_snapshot_ = true;
+  sink->flush_ = [](Stats::MetricSnapshot& snapshot) {
+    EXPECT_FALSE(snapshot.isDelta());
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.textReadouts().size(), 2);
+  };
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  // Any sink that needs the full state gets it, also for the other sinks.
+  sink->needs_full_snapshot_ = false;
+  Stats::MockSink* full_sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(full_sink);
+  EXPECT_CALL(*full_sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_FALSE(snapshot.isDelta());
+    EXPECT_EQ(snapshot.counters().size(), 2);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+}
+
 TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InSequence s;
 
@@ -4,12 +4,21 @@
 #include "source/common/event/dispatcher_impl.h"
 #include "source/server/worker_impl.h"
 
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/server/guard_dog.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/overload_manager.h"
 #include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/synchronization/notification.h"
@@ -159,6 +168,39 @@ TEST_F(WorkerImplTest, WorkerInvokesProvidedCallback) {
   worker_.stop();
 }
 
+#ifdef __linux__
+// The worker thread is pinned to the CPUs of its placement and prefers the memory of its node.
+TEST_F(WorkerImplTest, PlacesThread) {
+  NiceMock<Api::MockLinuxOsSysCalls> linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  Event::DispatcherPtr dispatcher = api_->allocateDispatcher("placed_worker_test");
+  Event::TimerPtr no_exit_timer = dispatcher->createTimer([]() -> void {});
+  no_exit_timer->enableTimer(std::chrono::hours(1));
+  WorkerImpl worker(tls_, hooks_, std::move(dispatcher),
+                    std::make_unique<NiceMock<Network::MockConnectionHandler>>(),
+                    overload_manager_, *api_, stat_names_, WorkerPlacement{{2, 3}, 1});
+
+  EXPECT_CALL(linux_os_sys_calls, sched_setaffinity(0, sizeof(cpu_set_t), _))
+      .WillOnce(Invoke([](pid_t, size_t, const cpu_set_t* mask) {
+        EXPECT_EQ(2, CPU_COUNT(mask));
+        EXPECT_TRUE(CPU_ISSET(2, mask));
+        EXPECT_TRUE(CPU_ISSET(3, mask));
+        return Api::SysCallIntResult{0, 0};
+      }));
+  EXPECT_CALL(linux_os_sys_calls, set_mempolicy(MPOL_PREFERRED, _, 8 * sizeof(unsigned long) + 1))
+      .WillOnce(Invoke([](int, const unsigned long* nodemask, unsigned long) {
+        EXPECT_EQ(1UL << 1, nodemask[0]);
+        return Api::SysCallIntResult{0, 0};
+      }));
+  absl::Notification callback_ran;
+  worker.start(guard_dog_, [&callback_ran]() { callback_ran.Notify(); });
+  callback_ran.WaitForNotification();
+  worker.stop();
+  // The timer must not outlive the dispatcher owned by the worker.
+  no_exit_timer.reset();
+}
+#endif
+
 } // namespace
 } // namespace Server
 } // namespace Envoy